@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License")
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# This script sweeps the template parameters of hls designs and collects
+# their QoR into a CSV summary.
+#
+# The sweep file is JSON, mapping each design directory under hls/ to the
+# values of its parameter macros, for example
+#     { "unittests/ArbiterTop": { "NUM_INPUTS": [4, 8, 16] } }
+# Every combination of values is a point. Each point runs nvhls_exec.tcl in a
+# copy of the design directory under the output directory, with the values
+# passed as SWEEP_FLAGS defines and SCVerify disabled. Points run in parallel.
+#
+# Area and slack come from the rtl.rpt of the last Catapult solution of the
+# point, and the achieved II is the largest initiation interval reported in
+# its catapult.log. The summary has one row per point.
+
+import argparse
+import csv
+import itertools
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+
+area_re = re.compile(r'Total Area Score\s*:?\s*(.*)')
+slack_re = re.compile(r'\bSlack\b\s*:?\s*(-?[0-9]+\.?[0-9]*)')
+ii_re = re.compile(r'(?:\bII\s*=\s*|[Ii]nitiation [Ii]nterval (?:of |= ?)?)([0-9]+)')
+number_re = re.compile(r'-?[0-9]+\.?[0-9]*')
+
+
+def points(spec):
+    for design, params in spec.items():
+        names = list(params.keys())
+        for values in itertools.product(*[params[n] for n in names]):
+            yield design, list(zip(names, [str(v) for v in values]))
+
+
+def point_dir(out, design, params):
+    tag = '_'.join('%s%s' % (n, v) for n, v in params) or 'default'
+    # nvhls_exec.tcl takes TOP_NAME from the directory name
+    return Path(out) / design / tag / Path(design).name
+
+
+def prepare(root, design, work):
+    src = Path(root) / 'hls' / design
+    if work.exists():
+        shutil.rmtree(str(work))
+    work.mkdir(parents=True)
+    for f in src.iterdir():
+        if f.is_file():
+            shutil.copy(str(f), str(work / f.name))
+    # Relative paths of the design directory no longer hold in the copy
+    makefile = work / 'Makefile'
+    text = re.sub(r'^ROOT\s*:?=.*$', 'ROOT            := %s' % root, makefile.read_text(), flags=re.M)
+    makefile.write_text(text)
+    tcl = work / 'go_hls.tcl'
+    text = re.sub(r'^source\s+\S*nvhls_exec.tcl', 'source $env(ROOT)/hls/nvhls_exec.tcl', tcl.read_text(), flags=re.M)
+    tcl.write_text(text)
+
+
+def parse(work):
+    result = {'area': None, 'slack': None, 'ii': None}
+    reports = sorted(work.glob('Catapult*/**/rtl.rpt'), key=lambda p: p.stat().st_mtime)
+    if reports:
+        text = reports[-1].read_text(errors='replace')
+        m = area_re.search(text)
+        if m:
+            # the last column is the area after assignment
+            nums = number_re.findall(m.group(1))
+            if nums:
+                result['area'] = float(nums[-1])
+        slacks = [float(s) for s in slack_re.findall(text)]
+        if slacks:
+            result['slack'] = min(slacks)
+    log = work / 'catapult.log'
+    if log.exists():
+        iis = [int(i) for i in ii_re.findall(log.read_text(errors='replace'))]
+        if iis:
+            result['ii'] = max(iis)
+    return result
+
+
+def run_point(args, design, params):
+    work = point_dir(args.out, design, params)
+    prepare(args.root, design, work)
+    flags = ' '.join('%s=%s' % (n, v) for n, v in params)
+    cmd = ['make', 'hls', 'SWEEP_FLAGS=%s' % flags, 'RUN_SCVERIFY=0']
+    with open(str(work / 'sweep.log'), 'w') as log:
+        status = subprocess.call(cmd, cwd=str(work), stdout=log, stderr=subprocess.STDOUT)
+    row = {'design': design, 'params': flags, 'status': 'PASS' if status == 0 else 'FAIL', 'work_dir': str(work)}
+    row.update(dict(params))
+    row.update(parse(work))
+    print('%-40s %-40s %s area=%s slack=%s ii=%s' % (design, flags, row['status'], row['area'], row['slack'], row['ii']))
+    sys.stdout.flush()
+    return row
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Sweep the parameters of hls designs')
+    parser.add_argument('--sweep', required=True, help='JSON file of design parameters')
+    parser.add_argument('--design', action='append', help='only sweep this design (repeatable)')
+    parser.add_argument('--out', default='sweep', help='work directory of the points')
+    parser.add_argument('--csv', default='QoRSweep.csv', help='summary file')
+    parser.add_argument('-j', '--jobs', type=int, default=4, help='points run in parallel')
+    parser.add_argument('--root', default=str(Path(__file__).resolve().parent.parent),
+                        help='matchlib root directory')
+    parser.add_argument('--parse-only', action='store_true', help='only collect the reports of a previous sweep')
+    args = parser.parse_args()
+    args.out = os.path.abspath(args.out)
+
+    with open(args.sweep) as f:
+        spec = json.load(f)
+    if args.design:
+        spec = {d: p for d, p in spec.items() if d in args.design}
+    todo = list(points(spec))
+
+    if args.parse_only:
+        rows = []
+        for design, params in todo:
+            work = point_dir(args.out, design, params)
+            row = {'design': design, 'params': ' '.join('%s=%s' % p for p in params), 'status': '', 'work_dir': str(work)}
+            row.update(dict(params))
+            row.update(parse(work))
+            rows.append(row)
+    else:
+        with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+            rows = list(pool.map(lambda p: run_point(args, p[0], p[1]), todo))
+
+    names = []
+    for design, params in todo:
+        for n, v in params:
+            if n not in names:
+                names.append(n)
+    fields = ['design', 'params'] + names + ['area', 'slack', 'ii', 'status', 'work_dir']
+    with open(args.csv, 'w', newline='') as f:
+        writer = csv.DictWriter(f, fieldnames=fields)
+        writer.writeheader()
+        for row in rows:
+            writer.writerow(row)
+    return 0 if all(r['status'] != 'FAIL' for r in rows) else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License")
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# This script closes the loop between HLS results and the C model channel
+# annotations of nvhls::annotate_design (cmod/include/nvhls_annotate.h).
+#
+#   perf_annotate.py annotate --template BASE.output.json --blocks FILE
+#                             [--out BASE.input.json]
+#       Reads the channel list that annotate_design writes on a first run,
+#       and writes the input file that annotates the next run. The blocks
+#       file is JSON, mapping C model instance names to either the work
+#       directory of their HLS run or explicit numbers, for example
+#           { "tb.dut.stage0": { "hls": "sweep/unittests/Stage0/default/Stage0" },
+#             "tb.dut.stage1": { "latency": 3, "ii": 1 } }
+#       Latency comes from the rtl.rpt of the last Catapult solution and II
+#       from catapult.log, as in hls_sweep.py. A channel driven from inside a
+#       block gets the block's latency, and a capacity of ceil(latency / II),
+#       the messages the block can have in flight.
+#
+#   perf_annotate.py depths --template BASE.output.json --profile depth.json
+#                           [--out BASE.input.json]
+#       Reads the match::DepthProfile dump of a run with NVHLS_DEPTH_PROFILE
+#       set, and gives every channel whose src_name or dest_name is a profiled
+#       buffered port, or a port of a profiled Buffer, the extra capacity that
+#       brings it to the recommended depth.
+#
+#   perf_annotate.py report --stats stats.json [--top N] [--csv FILE]
+#       Reads the match::StatsJSON dump of the annotated run and prints the
+#       utilization (transfers per sampled cycle), stall fraction, mean
+#       occupancy and mean latency of every registered buffered port, then
+#       the N ports with the most stall cycles, which bound the throughput.
+
+import argparse
+import csv
+import json
+import math
+import re
+import sys
+from pathlib import Path
+
+from hls_sweep import ii_re
+
+latency_re = re.compile(r'\bLatency\b(?:\s*\(?[Cc]ycles\)?)?\s*[:=]?\s*([0-9]+)')
+
+
+def hls_numbers(work):
+    work = Path(work)
+    result = {'latency': None, 'ii': None}
+    reports = sorted(work.glob('Catapult*/**/rtl.rpt'), key=lambda p: p.stat().st_mtime)
+    if reports:
+        latencies = [int(l) for l in latency_re.findall(reports[-1].read_text(errors='replace'))]
+        if latencies:
+            result['latency'] = max(latencies)
+    log = work / 'catapult.log'
+    if log.exists():
+        text = log.read_text(errors='replace')
+        iis = [int(i) for i in ii_re.findall(text)]
+        if iis:
+            result['ii'] = max(iis)
+        if result['latency'] is None:
+            latencies = [int(l) for l in latency_re.findall(text)]
+            if latencies:
+                result['latency'] = max(latencies)
+    return result
+
+
+def load_blocks(filename):
+    with open(filename) as f:
+        spec = json.load(f)
+    blocks = {}
+    for name, entry in spec.items():
+        numbers = {'latency': entry.get('latency'), 'ii': entry.get('ii')}
+        if 'hls' in entry:
+            parsed = hls_numbers(entry['hls'])
+            for key in numbers:
+                if numbers[key] is None:
+                    numbers[key] = parsed[key]
+        if numbers['latency'] is None:
+            print('warning: no latency for block %s' % name, file=sys.stderr)
+            continue
+        blocks[name] = numbers
+    return blocks
+
+
+def channels(node, path=''):
+    # Channel entries are the objects that hold a latency
+    if isinstance(node, dict):
+        if 'latency' in node:
+            yield path, node
+        else:
+            for key, value in node.items():
+                for c in channels(value, key):
+                    yield c
+
+
+def owner(name, blocks):
+    # Innermost block whose instance name prefixes name
+    best = None
+    for block in blocks:
+        if name == block or name.startswith(block + '.'):
+            if best is None or len(block) > len(best):
+                best = block
+    return best
+
+
+def annotate(args):
+    with open(args.template) as f:
+        design = json.load(f)
+    blocks = load_blocks(args.blocks)
+
+    print('%-50s %-30s %8s %8s' % ('channel', 'block', 'latency', 'capacity'))
+    for name, chan in channels(design):
+        block = owner(chan.get('src_name', name), blocks)
+        if block is None:
+            continue
+        b = blocks[block]
+        ii = b['ii'] if b['ii'] else 1
+        chan['latency'] = b['latency']
+        chan['capacity'] = max(chan.get('capacity', 0), int(math.ceil(float(b['latency']) / ii)))
+        print('%-50s %-30s %8d %8d' % (name, block, chan['latency'], chan['capacity']))
+
+    write_design(design, args)
+    return 0
+
+
+def write_design(design, args):
+    out = args.out or re.sub(r'output\.json$', 'input.json', args.template)
+    if out == args.template:
+        out = args.template + '.input.json'
+    with open(out, 'w') as f:
+        json.dump(design, f, indent=2)
+    print('wrote %s' % out)
+
+
+def depths(args):
+    with open(args.template) as f:
+        design = json.load(f)
+    with open(args.profile) as f:
+        profile = json.load(f)
+
+    print('%-50s %-40s %6s %6s %8s' % ('channel', 'buffer', 'depth', 'full', 'capacity'))
+    for name, chan in channels(design):
+        for end in ('src_name', 'dest_name'):
+            # A buffered port, or the enq/deq port of a Buffer channel
+            port = chan.get(end, '')
+            buf = profile.get(port) or profile.get(port.rsplit('.', 1)[0])
+            if buf is None:
+                continue
+            chan['capacity'] = max(chan.get('capacity', 0), buf['capacity'])
+            print('%-50s %-40s %6d %6d %8d' % (name, port, buf['depth'], buf['full_cycles'], chan['capacity']))
+    write_design(design, args)
+    return 0
+
+
+def ports(module):
+    for port, stats in module.get('ports', {}).items():
+        yield module['name'] + '.' + port, stats
+    for child in module.get('children', []):
+        for p in ports(child):
+            yield p
+
+
+def ratio(num, den):
+    return float(num) / den if den else 0.0
+
+
+def report(args):
+    with open(args.stats) as f:
+        stats = json.load(f)
+
+    rows = []
+    for name, p in ports(stats['top']):
+        occupancy = p.get('occupancy', [])
+        samples = sum(occupancy)
+        rows.append({
+            'port': name,
+            'cycles': p['cycles'],
+            'transfers': p['transfers'],
+            'utilization': round(ratio(p['transfers'], p['cycles']), 4),
+            'stall_cycles': p['stall_cycles'],
+            'stall_fraction': round(ratio(p['stall_cycles'], p['cycles']), 4),
+            'mean_occupancy': round(ratio(sum(i * n for i, n in enumerate(occupancy)), samples), 3),
+            'mean_latency': round(ratio(p.get('latency_sum', 0), p.get('latency_count', 0)), 3),
+        })
+
+    print('sim_time_ps %d' % stats.get('sim_time_ps', 0))
+    print('%-50s %10s %10s %7s %10s %7s %9s %9s' % ('port', 'cycles', 'transfers', 'util', 'stalls',
+                                                  'stall', 'mean_occ', 'mean_lat'))
+    for r in rows:
+        print('%-50s %10d %10d %7.3f %10d %7.3f %9.3f %9.3f' % (
+            r['port'], r['cycles'], r['transfers'], r['utilization'], r['stall_cycles'],
+            r['stall_fraction'], r['mean_occupancy'], r['mean_latency']))
+
+    critical = sorted([r for r in rows if r['stall_cycles'] > 0], key=lambda r: -r['stall_cycles'])[:args.top]
+    if critical:
+        print('\nmost stalled ports:')
+        for r in critical:
+            print('  %-50s %10d stall cycles (%.1f%%)' % (r['port'], r['stall_cycles'], 100 * r['stall_fraction']))
+
+    if args.csv:
+        with open(args.csv, 'w', newline='') as f:
+            writer = csv.DictWriter(f, fieldnames=list(rows[0].keys()) if rows else ['port'])
+            writer.writeheader()
+            for r in rows:
+                writer.writerow(r)
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Annotate C model channels from HLS results and report port performance')
+    sub = parser.add_subparsers(dest='command')
+    p = sub.add_parser('annotate')
+    p.add_argument('--template', required=True, help='BASE.output.json written by annotate_design')
+    p.add_argument('--blocks', required=True, help='JSON file of the HLS blocks')
+    p.add_argument('--out', help='input file to write (default: BASE.input.json)')
+    p = sub.add_parser('depths')
+    p.add_argument('--template', required=True, help='BASE.output.json written by annotate_design')
+    p.add_argument('--profile', required=True, help='match::DepthProfile dump')
+    p.add_argument('--out', help='input file to write (default: BASE.input.json)')
+    p = sub.add_parser('report')
+    p.add_argument('--stats', required=True, help='match::StatsJSON dump')
+    p.add_argument('--top', type=int, default=5, help='number of most stalled ports listed')
+    p.add_argument('--csv', help='also write the table as CSV')
+    args = parser.parse_args()
+    if args.command == 'annotate':
+        return annotate(args)
+    if args.command == 'depths':
+        return depths(args)
+    if args.command == 'report':
+        return report(args)
+    parser.print_help()
+    return 2
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License")
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# This script times the simulations of cmod/regress_Makefile and compares
+# them against a baseline.
+#
+#   regress_timing.py run --name DESIGN --out DIR -- CMD...
+#       Runs CMD with NVHLS_SIM_STATS set, passes its output through, and
+#       writes DIR/<DESIGN>.json with the pass/fail status, the wall-clock
+#       time and the simulated time and cycles that the testbench reports
+#       (see cmod/include/testbench/nvhls_sim_stats.h).
+#
+#   regress_timing.py summarize --dir DIR --summary FILE
+#                               [--baseline FILE] [--tolerance T]
+#       Collects the results into a JSON summary and prints a table. With a
+#       baseline, a design whose cycles per second (or, without cycles, whose
+#       wall-clock time) is more than T (a fraction) worse than the baseline is
+#       a regression. Exits with 1 on any failure or regression.
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+stats_re = re.compile(r'NVHLS_SIM_STATS sim_time_ns=([0-9.]+) clock_period_ns=([0-9.]+) cycles=([0-9]+)')
+
+
+def result_file(out_dir, name):
+    return Path(out_dir) / (name.strip('/').replace('/', '__') + '.json')
+
+
+def run(args):
+    cmd = args.cmd[1:] if args.cmd and args.cmd[0] == '--' else args.cmd
+    env = dict(os.environ, NVHLS_SIM_STATS='1')
+    start = time.time()
+    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            env=env, universal_newlines=True)
+    stats = None
+    for line in proc.stdout:
+        sys.stdout.write(line)
+        m = stats_re.search(line)
+        if m:
+            stats = m
+    status = proc.wait()
+    wall = time.time() - start
+
+    result = {'design': args.name, 'passed': status == 0, 'wall_seconds': round(wall, 3),
+              'sim_time_ns': None, 'cycles': None, 'cycles_per_second': None}
+    if stats:
+        result['sim_time_ns'] = float(stats.group(1))
+        cycles = int(stats.group(3))
+        if cycles > 0:
+            result['cycles'] = cycles
+            result['cycles_per_second'] = round(cycles / wall, 1) if wall > 0 else None
+    Path(args.out).mkdir(parents=True, exist_ok=True)
+    with open(str(result_file(args.out, args.name)), 'w') as f:
+        json.dump(result, f, indent=2)
+    return status
+
+
+def compare(result, base):
+    # Returns the speed ratio against the baseline (> 1 is faster), or None
+    if base is None or not result['passed']:
+        return None
+    if result['cycles_per_second'] and base.get('cycles_per_second'):
+        return result['cycles_per_second'] / base['cycles_per_second']
+    if result['wall_seconds'] > 0 and base.get('wall_seconds'):
+        return base['wall_seconds'] / result['wall_seconds']
+    return None
+
+
+def summarize(args):
+    results = []
+    for filename in sorted(Path(args.dir).glob('*.json')):
+        with open(str(filename)) as f:
+            results.append(json.load(f))
+
+    baseline = {}
+    if args.baseline and os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = {r['design']: r for r in json.load(f)['results']}
+
+    failed = False
+    print('%-50s %6s %10s %14s %14s %8s' % ('design', 'status', 'wall_s', 'cycles', 'cycles_per_s', 'vs_base'))
+    for r in results:
+        ratio = compare(r, baseline.get(r['design']))
+        r['baseline_ratio'] = round(ratio, 3) if ratio is not None else None
+        r['regressed'] = ratio is not None and ratio < 1.0 - args.tolerance
+        failed = failed or not r['passed'] or r['regressed']
+        status = 'PASS' if r['passed'] else 'FAIL'
+        if r['regressed']:
+            status = 'SLOW'
+        print('%-50s %6s %10.2f %14s %14s %8s' % (
+            r['design'], status, r['wall_seconds'],
+            r['cycles'] if r['cycles'] is not None else '-',
+            r['cycles_per_second'] if r['cycles_per_second'] is not None else '-',
+            '%.2f' % ratio if ratio is not None else '-'))
+
+    summary = {'tolerance': args.tolerance, 'baseline': args.baseline, 'results': results}
+    with open(args.summary, 'w') as f:
+        json.dump(summary, f, indent=2)
+    return 1 if failed else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Time regression simulations')
+    sub = parser.add_subparsers(dest='command')
+    p = sub.add_parser('run')
+    p.add_argument('--name', required=True)
+    p.add_argument('--out', required=True)
+    p.add_argument('cmd', nargs=argparse.REMAINDER)
+    p = sub.add_parser('summarize')
+    p.add_argument('--dir', required=True)
+    p.add_argument('--summary', required=True)
+    p.add_argument('--baseline')
+    p.add_argument('--tolerance', type=float, default=0.25)
+    args = parser.parse_args()
+    if args.command == 'run':
+        return run(args)
+    if args.command == 'summarize':
+        return summarize(args)
+    parser.print_help()
+    return 2
+
+
+if __name__ == '__main__':
+    sys.exit(main())
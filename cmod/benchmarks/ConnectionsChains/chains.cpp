@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <testbench/nvhls_rand.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+// End-to-end simulation speed of a chain of Connections stages:
+//   sim_bench <buffer|pipeline|forward> <length> <cycles>
+// A producer pushes a message every cycle it can into the chain, and a
+// consumer pops one every cycle and checks the order.
+
+typedef NVUINTW(64) Word_t;
+
+#if defined(CONNECTIONS_FAST_SIM)
+static const char* sim_mode = "fast";
+#elif defined(CONNECTIONS_ACCURATE_SIM)
+static const char* sim_mode = "accurate";
+#else
+static const char* sim_mode = "syn";
+#endif
+
+// A stage of a process that moves one message per cycle, with a register
+template <typename T>
+class Forward : public sc_module {
+  SC_HAS_PROCESS(Forward);
+
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<T> enq;
+  Connections::Out<T> deq;
+
+  Forward(sc_module_name name) : sc_module(name), clk("clk"), rst("rst"), enq("enq"), deq("deq") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void run() {
+    enq.Reset();
+    deq.Reset();
+    bool full = false;
+    T reg;
+    wait();
+    while (1) {
+      if (full && deq.PushNB(reg)) {
+        full = false;
+      }
+      if (!full) {
+        full = enq.PopNB(reg);
+      }
+      wait();
+    }
+  }
+};
+
+class Ends : public sc_module {
+  SC_HAS_PROCESS(Ends);
+
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::Out<Word_t> out;
+  Connections::In<Word_t> in;
+  unsigned long long received;
+
+  Ends(sc_module_name name) : sc_module(name), clk("clk"), rst("rst"), out("out"), in("in"), received(0) {
+    SC_THREAD(produce);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(consume);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void produce() {
+    out.Reset();
+    Word_t next = 0;
+    wait();
+    while (1) {
+      if (out.PushNB(next)) {
+        next++;
+      }
+      wait();
+    }
+  }
+
+  void consume() {
+    in.Reset();
+    received = 0;
+    wait();
+    while (1) {
+      Word_t m;
+      if (in.PopNB(m)) {
+        NVHLS_ASSERT_MSG(m == received, "Chain reordered or lost a message");
+        received++;
+      }
+      wait();
+    }
+  }
+};
+
+template <typename Stage>
+void Build(int length, sc_clock& clk, sc_signal<bool>& rst, Ends& ends) {
+  std::vector<Connections::Combinational<Word_t>*> chans;
+  for (int i = 0; i <= length; i++) {
+    std::ostringstream name;
+    name << "chan_" << i;
+    chans.push_back(new Connections::Combinational<Word_t>(name.str().c_str()));
+  }
+  ends.out(*chans[0]);
+  for (int i = 0; i < length; i++) {
+    std::ostringstream name;
+    name << "stage_" << i;
+    Stage* stage = new Stage(name.str().c_str());
+    stage->clk(clk);
+    stage->rst(rst);
+    stage->enq(*chans[i]);
+    stage->deq(*chans[i + 1]);
+  }
+  ends.in(*chans[length]);
+}
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  const char* kind = (argc > 1) ? argv[1] : "buffer";
+  int length = (argc > 2) ? std::atoi(argv[2]) : 8;
+  unsigned long long cycles = (argc > 3) ? std::strtoull(argv[3], NULL, 10) : 200000;
+
+  sc_clock clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true);
+  sc_signal<bool> rst("rst");
+  Connections::set_sim_clk(&clk);
+  Ends ends("ends");
+  ends.clk(clk);
+  ends.rst(rst);
+
+  if (std::strcmp(kind, "buffer") == 0) {
+    Build<Connections::Buffer<Word_t, 2> >(length, clk, rst, ends);
+  } else if (std::strcmp(kind, "pipeline") == 0) {
+    Build<Connections::Pipeline<Word_t> >(length, clk, rst, ends);
+  } else if (std::strcmp(kind, "forward") == 0) {
+    Build<Forward<Word_t> >(length, clk, rst, ends);
+  } else {
+    std::printf("Unknown chain %s, expected buffer, pipeline or forward\n", kind);
+    return 1;
+  }
+
+  rst = 0;
+  sc_start(5, SC_NS);
+  rst = 1;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  sc_start(static_cast<double>(cycles), SC_NS);
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  NVHLS_ASSERT_MSG(ends.received > 0, "Chain delivered nothing");
+  std::printf("chain=%s length=%d sim_mode=%s cycles=%llu messages=%llu wall_s=%.3f cycles_per_s=%.0f "
+              "messages_per_cycle=%.3f\n",
+              kind, length, sim_mode, cycles, ends.received, seconds, cycles / seconds,
+              static_cast<double>(ends.received) / cycles);
+  return 0;
+}
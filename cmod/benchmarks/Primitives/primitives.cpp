@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_message.h>
+#include <TypeToBits.h>
+#include <fifo.h>
+#include <Arbiter.h>
+#include <crossbar.h>
+#include <mem_array.h>
+#include <ReorderBuf.h>
+#include <axi/axi4.h>
+#include <testbench/nvhls_rand.h>
+#include <bench.h>
+
+using nvhls::bench::State;
+using nvhls::bench::DoNotOptimize;
+
+// Random inputs are drawn ahead of time so that only the operation is timed
+static const unsigned int NumInputs = 256;
+
+template <int W>
+struct Inputs {
+  NVUINTW(W) v[NumInputs];
+  Inputs() {
+    for (unsigned i = 0; i < NumInputs; i++) {
+      v[i] = nvhls::get_rand<W>();
+    }
+  }
+  const NVUINTW(W) & operator[](unsigned i) const { return v[i % NumInputs]; }
+};
+
+// Message without NVHLS_PACKED_MESSAGE, marshalled bit by bit
+class Unpacked : public nvhls_message {
+ public:
+  NVUINTW(20) a;
+  NVUINTW(40) b;
+  bool c;
+  static const unsigned int width = 61;
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m& a;
+    m& b;
+    m& c;
+  }
+};
+
+//------------------------------------------------------------------------
+// FIFO
+//------------------------------------------------------------------------
+
+template <int W, unsigned int Depth>
+void BM_FifoPushPop(State& state) {
+  Inputs<W> in;
+  FIFO<NVUINTW(W), Depth> fifo;
+  unsigned i = 0;
+  while (state.KeepRunning()) {
+    fifo.push(in[i++]);
+    DoNotOptimize(fifo.pop());
+  }
+  state.SetItemsProcessed(state.iterations);
+}
+NVHLS_BENCHMARK("FIFO<32,16>::push+pop", BM_FifoPushPop<32, 16>);
+NVHLS_BENCHMARK("FIFO<512,16>::push+pop", BM_FifoPushPop<512, 16>);
+
+//------------------------------------------------------------------------
+// Arbiter
+//------------------------------------------------------------------------
+
+template <unsigned int N>
+void BM_ArbiterPick(State& state) {
+  Inputs<N> in;
+  Arbiter<N> arbiter;
+  unsigned i = 0;
+  while (state.KeepRunning()) {
+    DoNotOptimize(arbiter.pick(in[i++]));
+  }
+  state.SetItemsProcessed(state.iterations);
+}
+NVHLS_BENCHMARK("Arbiter<8>::pick", BM_ArbiterPick<8>);
+NVHLS_BENCHMARK("Arbiter<64>::pick", BM_ArbiterPick<64>);
+
+//------------------------------------------------------------------------
+// crossbar
+//------------------------------------------------------------------------
+
+template <int W, unsigned int N>
+void BM_Crossbar(State& state) {
+  typedef NVUINTW(nvhls::index_width<N>::val) Source;
+  NVUINTW(W) data_in[N], data_out[N];
+  Source source[NumInputs][N];
+  for (unsigned i = 0; i < N; i++) {
+    data_in[i] = nvhls::get_rand<W>();
+  }
+  for (unsigned i = 0; i < NumInputs; i++) {
+    for (unsigned o = 0; o < N; o++) {
+      source[i][o] = rand() % N;
+    }
+  }
+  unsigned i = 0;
+  while (state.KeepRunning()) {
+    crossbar<NVUINTW(W), N, N>(data_in, source[i++ % NumInputs], data_out);
+    DoNotOptimize(data_out);
+  }
+  state.SetItemsProcessed(state.iterations * N);
+}
+NVHLS_BENCHMARK("crossbar<32,8x8>", BM_Crossbar<32, 8>);
+NVHLS_BENCHMARK("crossbar<64,32x32>", BM_Crossbar<64, 32>);
+
+//------------------------------------------------------------------------
+// mem_array_sep
+//------------------------------------------------------------------------
+
+template <int W, int Entries, int Banks>
+void BM_MemArrayWriteRead(State& state) {
+  typedef mem_array_sep<NVUINTW(W), Entries, Banks> Mem;
+  Inputs<W> in;
+  Mem mem;
+  unsigned i = 0;
+  while (state.KeepRunning()) {
+    typename Mem::LocalIndex idx = (i * 7) % Mem::NumEntriesPerBank;
+    typename Mem::BankIndex bank = i % Banks;
+    mem.write(idx, bank, in[i]);
+    DoNotOptimize(mem.read(idx, bank));
+    i++;
+  }
+  state.SetItemsProcessed(state.iterations);
+}
+NVHLS_BENCHMARK("mem_array_sep<32,1024,4>::write+read", BM_MemArrayWriteRead<32, 1024, 4>);
+NVHLS_BENCHMARK("mem_array_sep<512,4096,8>::write+read", BM_MemArrayWriteRead<512, 4096, 8>);
+
+//------------------------------------------------------------------------
+// TypeToBits / BitsToType and Marshaller
+//------------------------------------------------------------------------
+
+template <typename T>
+void BM_TypeToBitsRoundTrip(State& state) {
+  static const unsigned int W = Wrapped<T>::width;
+  Inputs<W> in;
+  unsigned i = 0;
+  while (state.KeepRunning()) {
+    T t = BitsToType<T>(TypeToBits<NVUINTW(W)>(in[i++]));
+    DoNotOptimize(TypeToBits<T>(t));
+  }
+  state.SetItemsProcessed(state.iterations);
+}
+NVHLS_BENCHMARK("TypeToBits+BitsToType<NVUINT64>", BM_TypeToBitsRoundTrip<NVUINTW(64)>);
+NVHLS_BENCHMARK("TypeToBits+BitsToType<NVUINT512>", BM_TypeToBitsRoundTrip<NVUINTW(512)>);
+NVHLS_BENCHMARK("TypeToBits+BitsToType<AddrPayload>",
+                BM_TypeToBitsRoundTrip<axi::axi4<axi::cfg::standard>::AddrPayload>);
+NVHLS_BENCHMARK("TypeToBits+BitsToType<Unpacked>", BM_TypeToBitsRoundTrip<Unpacked>);
+
+template <typename T>
+void BM_Marshaller(State& state) {
+  static const unsigned int W = Wrapped<T>::width;
+  Inputs<W> in;
+  unsigned i = 0;
+  while (state.KeepRunning()) {
+    T t = NVUINTToType<T>(in[i++]);
+    Marshaller<W> m;
+    Wrapped<T> wm(t);
+    wm.Marshall(m);
+    DoNotOptimize(m.GetResult());
+  }
+  state.SetItemsProcessed(state.iterations);
+}
+NVHLS_BENCHMARK("Marshaller<AddrPayload>", BM_Marshaller<axi::axi4<axi::cfg::standard>::AddrPayload>);
+NVHLS_BENCHMARK("Marshaller<WritePayload>", BM_Marshaller<axi::axi4<axi::cfg::standard>::WritePayload>);
+NVHLS_BENCHMARK("Marshaller<Unpacked>", BM_Marshaller<Unpacked>);
+
+//------------------------------------------------------------------------
+// leading_ones
+//------------------------------------------------------------------------
+
+template <int W>
+void BM_LeadingOnes(State& state) {
+  Inputs<W> in;
+  unsigned i = 0;
+  while (state.KeepRunning()) {
+    DoNotOptimize(nvhls::leading_ones<W, NVUINTW(W), NVUINTW(nvhls::index_width<W>::val)>(in[i++]));
+  }
+  state.SetItemsProcessed(state.iterations);
+}
+NVHLS_BENCHMARK("leading_ones<32>", BM_LeadingOnes<32>);
+NVHLS_BENCHMARK("leading_ones<256>", BM_LeadingOnes<256>);
+
+//------------------------------------------------------------------------
+// ReorderBuf
+//------------------------------------------------------------------------
+
+template <int W, unsigned int Depth>
+void BM_ReorderBuf(State& state) {
+  typedef ReorderBuf<NVUINTW(W), Depth, Depth> Rob;
+  Inputs<W> in;
+  Rob rob;
+  typename Rob::Id ids[Depth];
+  unsigned i = 0;
+  // Keep the buffer half full, and answer the requests in reverse order
+  while (state.KeepRunning()) {
+    for (unsigned r = 0; r < Depth / 2; r++) {
+      ids[r] = rob.addRequest();
+    }
+    for (int r = Depth / 2 - 1; r >= 0; r--) {
+      rob.addResponse(ids[r], in[i++]);
+    }
+    while (rob.topResponseReady()) {
+      DoNotOptimize(rob.popResponse());
+    }
+  }
+  state.SetItemsProcessed(state.iterations * (Depth / 2));
+}
+NVHLS_BENCHMARK("ReorderBuf<32,16>::request+response", BM_ReorderBuf<32, 16>);
+NVHLS_BENCHMARK("ReorderBuf<128,64>::request+response", BM_ReorderBuf<128, 64>);
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  return nvhls::bench::RunBenchmarks(argc, argv);
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NVHLS_BENCH_H
+#define NVHLS_BENCH_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Microbenchmark harness of the C-simulation benchmarks
+ * \ingroup Benchmarks
+ *
+ * \par Overview
+ * A small harness with the shape of google-benchmark. A benchmark is a
+ * function of a State that runs its operation once per KeepRunning(). The
+ * harness doubles the iteration count until a run takes at least the minimum
+ * time, and reports the time per iteration. Items processed turn into a rate.
+ * - RunBenchmarks(argc, argv) runs the registered benchmarks whose name
+ *   contains argv[1], if given, and prints one line per benchmark.
+ * - NVHLS_BENCH_MIN_TIME sets the minimum time in seconds (default 0.2).
+ * - NVHLS_BENCH_CSV names a file that the results are appended to, as
+ *   name,iterations,ns_per_iter,items_per_second.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <bench.h>
+ *
+ *      template <int W>
+ *      void BM_LeadingOnes(nvhls::bench::State& state) {
+ *        NVUINTW(W) x = 1;
+ *        while (state.KeepRunning()) {
+ *          nvhls::bench::DoNotOptimize(nvhls::leading_ones<W, NVUINTW(W), NVUINTW(8)>(x));
+ *          x = x * 3 + 1;
+ *        }
+ *      }
+ *      NVHLS_BENCHMARK("leading_ones/64", BM_LeadingOnes<64>);
+ *
+ *      int sc_main(int argc, char *argv[]) { return nvhls::bench::RunBenchmarks(argc, argv); }
+ * \endcode
+ * \par
+ *
+ */
+
+namespace nvhls {
+namespace bench {
+
+/** \brief Keeps the compiler from optimizing a value away. */
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+/** \brief Keeps the compiler from optimizing memory writes away. */
+inline void ClobberMemory() { asm volatile("" : : : "memory"); }
+
+class State {
+ public:
+  explicit State(unsigned long long iterations_) : iterations(iterations_), remaining(iterations_), items(0) {}
+
+  bool KeepRunning() {
+    if (remaining == 0) {
+      return false;
+    }
+    remaining--;
+    return true;
+  }
+
+  void SetItemsProcessed(unsigned long long n) { items = n; }
+  void SetLabel(const std::string& l) { label = l; }
+
+  const unsigned long long iterations;
+  unsigned long long remaining;
+  unsigned long long items;
+  std::string label;
+};
+
+typedef void (*Function)(State&);
+
+struct Benchmark {
+  const char* name;
+  Function fn;
+};
+
+inline std::vector<Benchmark>& Registry() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+struct Registrar {
+  Registrar(const char* name, Function fn) {
+    Benchmark b = {name, fn};
+    Registry().push_back(b);
+  }
+};
+
+#define NVHLS_BENCH_CONCAT2(a, b) a##b
+#define NVHLS_BENCH_CONCAT(a, b) NVHLS_BENCH_CONCAT2(a, b)
+
+/** \brief Registers fn under name. */
+#define NVHLS_BENCHMARK(name, ...) \
+  static nvhls::bench::Registrar NVHLS_BENCH_CONCAT(nvhls_bench_registrar_, __LINE__)(name, __VA_ARGS__)
+
+inline int RunBenchmarks(int argc, char* argv[]) {
+  const char* filter = (argc > 1) ? argv[1] : "";
+  const char* min_time_env = std::getenv("NVHLS_BENCH_MIN_TIME");
+  double min_time = min_time_env ? std::atof(min_time_env) : 0.2;
+  const char* csv_name = std::getenv("NVHLS_BENCH_CSV");
+  FILE* csv = csv_name ? std::fopen(csv_name, "a") : NULL;
+
+  std::printf("%-44s %12s %14s %16s\n", "benchmark", "iterations", "ns/iter", "items/s");
+  for (unsigned i = 0; i < Registry().size(); i++) {
+    const Benchmark& b = Registry()[i];
+    if (std::strstr(b.name, filter) == NULL) {
+      continue;
+    }
+    unsigned long long n = 1;
+    double seconds = 0;
+    State* state = NULL;
+    while (1) {
+      delete state;
+      state = new State(n);
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      b.fn(*state);
+      seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      if (seconds >= min_time || n >= (1ULL << 40)) {
+        break;
+      }
+      // Aim straight for the minimum time once the run is long enough to time
+      n = (seconds > min_time / 100) ? static_cast<unsigned long long>(n * 1.4 * min_time / seconds) + 1 : n * 10;
+    }
+    double ns = seconds * 1e9 / n;
+    double rate = state->items ? state->items / seconds : 0;
+    std::printf("%-44s %12llu %14.1f %16.4g %s\n", b.name, n, ns, rate, state->label.c_str());
+    if (csv) {
+      std::fprintf(csv, "%s,%llu,%.3f,%.6g\n", b.name, n, ns, rate);
+    }
+    delete state;
+  }
+  if (csv) {
+    std::fclose(csv);
+  }
+  return 0;
+}
+
+}  // namespace bench
+}  // namespace nvhls
+
+#endif  // NVHLS_BENCH_H
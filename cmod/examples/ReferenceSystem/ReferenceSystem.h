@@ -0,0 +1,621 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef REFERENCE_SYSTEM_H
+#define REFERENCE_SYSTEM_H
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <nvhls_connections.h>
+#include <nvhls_array.h>
+#include <nvhls_assert.h>
+#include <ArbitratedScratchpad.h>
+#include <WHVCNoC.h>
+#include <axi/axi4.h>
+#include <axi/AxiArbiter.h>
+#include <axi/AxiDma.h>
+#include <axi/AxiNoCInterface.h>
+#include <axi/testbench/LatencySubordinate.h>
+
+#ifndef __SYNTHESIS__
+#include <deque>
+#include <vector>
+#endif
+
+// Size of the system: a REFSYS_MESH_X x REFSYS_MESH_Y mesh whose last
+// REFSYS_MEM_NODES nodes hold a DRAM, and REFSYS_TILES_PER_NODE tiles at
+// each of the other nodes
+#ifndef REFSYS_MESH_X
+#define REFSYS_MESH_X 2
+#endif
+
+#ifndef REFSYS_MESH_Y
+#define REFSYS_MESH_Y 2
+#endif
+
+#ifndef REFSYS_MEM_NODES
+#define REFSYS_MEM_NODES 2
+#endif
+
+#ifndef REFSYS_TILES_PER_NODE
+#define REFSYS_TILES_PER_NODE 2
+#endif
+
+// Workload of each tile: REFSYS_BLOCKS products C = A * B of an M x K and a
+// K x N block, computed with REFSYS_LANES MACs per cycle
+#ifndef REFSYS_TILE_M
+#define REFSYS_TILE_M 8
+#endif
+
+#ifndef REFSYS_TILE_N
+#define REFSYS_TILE_N 8
+#endif
+
+#ifndef REFSYS_TILE_K
+#define REFSYS_TILE_K 8
+#endif
+
+#ifndef REFSYS_LANES
+#define REFSYS_LANES 2
+#endif
+
+#ifndef REFSYS_BLOCKS
+#define REFSYS_BLOCKS 16
+#endif
+
+#ifndef REFSYS_CLOCK_NS
+#define REFSYS_CLOCK_NS 1
+#endif
+
+// AXI config of the tiles: 32-bit words, bursts of up to 4 beats, and an ID
+// for each of the 4 bursts a DMA keeps in flight
+struct TileAxiCfg {
+  enum {
+    dataWidth = 32,
+    useVariableBeatSize = 0,
+    useMisalignedAddresses = 0,
+    useLast = 1,
+    useWriteStrobes = 1,
+    useBurst = 1, useFixedBurst = 0, useWrapBurst = 0, maxBurstSize = 4,
+    useQoS = 0, useLock = 0, useProt = 0, useCache = 0, useRegion = 0,
+    aUserWidth = 0, wUserWidth = 0, bUserWidth = 0, rUserWidth = 0,
+    addrWidth = 32,
+    idWidth = 2,
+    useWriteResponses = 1,
+  };
+};
+
+// Timing of each DRAM
+struct DramCfg {
+  enum {
+    fixedLatency = 20,
+    randomLatency = 4,
+    numBanks = 8,
+    rowBytes = 2048,
+    rowHitLatency = 4,
+    rowMissLatency = 20,
+    maxOutstanding = 16,
+    outOfOrder = 1,
+    seed = 0,
+  };
+};
+
+/**
+ * \brief A GEMM tile: a DMA engine, two scratchpads and an AXI writer
+ *
+ * \par Overview
+ * The tile computes REFSYS_BLOCKS products C = A * B. Block b of the tile
+ * sits at base + b * kBlockBytes in memory, as A (M x K words, row major),
+ * B (K x N) and room for C (M x N).
+ * - AxiDma fetches A and B of a block with one descriptor, and run() stores
+ *   the words into one of two ArbitratedScratchpads while the block before it
+ *   is computed out of the other one, so fetches overlap compute.
+ * - Each cycle, run() loads A[i][k] and B[k][j .. j + Lanes - 1] on the
+ *   inputs of the compute scratchpad, and adds Lanes products once all of
+ *   them have been loaded. Loads that lose bank arbitration are retried.
+ * - The finished C words go to write_results(), which writes them back in
+ *   bursts of maxBurstSize beats, and done is set once every B response has
+ *   arrived.
+ * .
+ * Outside of synthesis the tile records the cycles from each descriptor to
+ * the last word of its block, and from each write request to its response.
+ *
+ */
+SC_MODULE(Tile) {
+ public:
+  typedef axi::axi4<TileAxiCfg> axi4_;
+  typedef AxiDma<TileAxiCfg, 4, 16> Dma;
+  typedef axi4_::Addr Addr;
+  typedef axi4_::Data Word;
+
+  enum {
+    M = REFSYS_TILE_M,
+    N = REFSYS_TILE_N,
+    K = REFSYS_TILE_K,
+    Lanes = REFSYS_LANES,
+    Blocks = REFSYS_BLOCKS,
+    kBurst = TileAxiCfg::maxBurstSize,
+    kBytesPerWord = Dma::bytesPerWord,
+    kOperandWords = M * K + K * N,       // A and B, fetched by one descriptor
+    kBlockWords = kOperandWords + M * N,
+    kBlockBytes = kBlockWords * kBytesPerWord,
+    kTileBytes = Blocks * kBlockBytes,
+    kBlockBursts = M * N / kBurst,
+    kBursts = Blocks * kBlockBursts,
+    kSpadBanks = 4,
+  };
+  static_assert(N % Lanes == 0 && Lanes <= kSpadBanks,
+                "Lanes must divide N and be at most the number of scratchpad banks");
+  // Keeps every block and C burst aligned to the burst size
+  static_assert(K % kBurst == 0 && N % kBurst == 0,
+                "K and N must be multiples of the burst length");
+
+  // Input 0 loads A and stores the fetched words, inputs 1 to Lanes load B
+  typedef ArbitratedScratchpad<Word, kOperandWords, Lanes + 1, kSpadBanks, 0> Spad;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+  sc_in<Addr> base;
+  sc_out<bool> done;
+
+  typename axi4_::read::template manager<> if_rd;
+  typename axi4_::write::template manager<> if_wr;
+
+  Dma dma;
+  Connections::Combinational<Dma::Descriptor> desc;
+  Connections::Combinational<Dma::StreamBeat> stream;
+  Connections::Combinational<Word> results;
+
+  Spad spad[2];
+
+#ifndef __SYNTHESIS__
+  std::vector<uint64> fetch_latency;  // Cycles from each descriptor to the last word of its block
+  std::vector<uint64> write_latency;  // Cycles from each AW to its B
+  uint64 macs;
+  uint64 finish_cycle;
+
+  static uint64 Cycle() {
+    return static_cast<uint64>(sc_time_stamp() / sc_time(REFSYS_CLOCK_NS, SC_NS));
+  }
+#endif
+
+  SC_CTOR(Tile)
+      : clk("clk"),
+        reset_bar("reset_bar"),
+        base("base"),
+        done("done"),
+        if_rd("if_rd"),
+        if_wr("if_wr"),
+        dma("dma"),
+        desc("desc"),
+        stream("stream"),
+        results("results") {
+#ifndef __SYNTHESIS__
+    macs = 0;
+    finish_cycle = 0;
+#endif
+    dma.clk(clk);
+    dma.reset_bar(reset_bar);
+    dma.desc_in(desc);
+    dma.stream_out(stream);
+    dma.if_rd(if_rd);
+
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(write_results);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(write_responses);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ protected:
+#ifndef __SYNTHESIS__
+  std::deque<uint64> fetch_start;
+  std::deque<uint64> write_start;
+#endif
+
+  void run() {
+    desc.ResetWrite();
+    stream.ResetRead();
+    results.ResetWrite();
+    spad[0].reset();
+    spad[1].reset();
+
+    unsigned desc_block = 0;     // Next block to fetch
+    unsigned fill_block = 0;     // Block whose words are being stored
+    unsigned fill_count = 0;
+    unsigned compute_block = 0;  // Block being computed
+    unsigned ci = 0, cj = 0, ck = 0;
+    bool store_valid = false;
+    Word store_data = 0;
+    bool loaded[Lanes + 1];
+    Word a = 0;
+    Word b[Lanes];
+    Word acc[Lanes];
+    Word out[Lanes];
+    unsigned out_count = 0;
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < Lanes + 1; i++) {
+      loaded[i] = false;
+    }
+#pragma hls_unroll yes
+    for (unsigned l = 0; l < Lanes; l++) {
+      acc[l] = 0;
+    }
+    wait();
+
+#pragma hls_pipeline_init_interval 1
+#pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      // A block is fetched into a scratchpad once the block two before it
+      // has been computed out of it
+      if (desc_block < Blocks && desc_block <= compute_block + 1) {
+        Dma::Descriptor d;
+        d.addr = base.read() + Addr(desc_block) * kBlockBytes;
+        d.x_words = kOperandWords;
+        d.y_count = 1;
+        d.y_stride = 0;
+        d.z_count = 1;
+        d.z_stride = 0;
+        if (desc.PushNB(d)) {
+#ifndef __SYNTHESIS__
+          fetch_start.push_back(Cycle());
+#endif
+          desc_block++;
+        }
+      }
+
+      // Store the fetched words, one per cycle
+      Dma::StreamBeat beat;
+      if (!store_valid && stream.PopNB(beat)) {
+        store_valid = true;
+        store_data = beat.data;
+      }
+      if (store_valid) {
+        typename Spad::req_t req;
+        typename Spad::rsp_t rsp;
+        bool ready[Lanes + 1];
+        req.type.val = CLITYPE_T::STORE;
+#pragma hls_unroll yes
+        for (unsigned i = 0; i < Lanes + 1; i++) {
+          req.valids[i] = (i == 0);
+        }
+        req.addr[0] = fill_count;
+        req.data[0] = store_data;
+        spad[fill_block & 1].load_store(req, rsp, ready);
+        if (ready[0]) {
+          store_valid = false;
+          if (fill_count == kOperandWords - 1) {
+            fill_count = 0;
+            fill_block++;
+#ifndef __SYNTHESIS__
+            fetch_latency.push_back(Cycle() - fetch_start.front());
+            fetch_start.pop_front();
+#endif
+          } else {
+            fill_count++;
+          }
+        }
+      }
+
+      // Send the C words of the last finished row segment
+      if (out_count != 0 && results.PushNB(out[Lanes - out_count])) {
+        out_count--;
+      }
+
+      // Lanes MACs of C[ci][cj .. cj + Lanes - 1] at step ck
+      if (compute_block < fill_block) {
+        typename Spad::req_t req;
+        typename Spad::rsp_t rsp;
+        bool ready[Lanes + 1];
+        bool any = false;
+        req.type.val = CLITYPE_T::LOAD;
+        req.valids[0] = !loaded[0];
+        req.addr[0] = ci * K + ck;
+#pragma hls_unroll yes
+        for (unsigned l = 0; l < Lanes; l++) {
+          req.valids[l + 1] = !loaded[l + 1];
+          req.addr[l + 1] = M * K + ck * N + cj + l;
+        }
+#pragma hls_unroll yes
+        for (unsigned i = 0; i < Lanes + 1; i++) {
+          any = any || req.valids[i];
+        }
+        if (any) {
+          spad[compute_block & 1].load_store(req, rsp, ready);
+          if (req.valids[0] && rsp.valids[0]) {
+            a = rsp.data[0];
+            loaded[0] = true;
+          }
+#pragma hls_unroll yes
+          for (unsigned l = 0; l < Lanes; l++) {
+            if (req.valids[l + 1] && rsp.valids[l + 1]) {
+              b[l] = rsp.data[l + 1];
+              loaded[l + 1] = true;
+            }
+          }
+        }
+
+        bool all = true;
+#pragma hls_unroll yes
+        for (unsigned i = 0; i < Lanes + 1; i++) {
+          all = all && loaded[i];
+        }
+        // The last step waits for the previous segment to be sent
+        if (all && (ck != K - 1 || out_count == 0)) {
+#pragma hls_unroll yes
+          for (unsigned l = 0; l < Lanes; l++) {
+            acc[l] = acc[l] + a * b[l];
+          }
+#pragma hls_unroll yes
+          for (unsigned i = 0; i < Lanes + 1; i++) {
+            loaded[i] = false;
+          }
+#ifndef __SYNTHESIS__
+          macs += Lanes;
+#endif
+          if (ck == K - 1) {
+#pragma hls_unroll yes
+            for (unsigned l = 0; l < Lanes; l++) {
+              out[l] = acc[l];
+              acc[l] = 0;
+            }
+            out_count = Lanes;
+            ck = 0;
+            if (cj == N - Lanes) {
+              cj = 0;
+              if (ci == M - 1) {
+                ci = 0;
+                compute_block++;
+              } else {
+                ci++;
+              }
+            } else {
+              cj += Lanes;
+            }
+          } else {
+            ck++;
+          }
+        }
+      }
+    }
+  }
+
+  // Writes C back in row-major bursts
+  void write_results() {
+    if_wr.aw.Reset();
+    if_wr.w.Reset();
+    results.ResetRead();
+    unsigned burst = 0;
+    wait();
+
+    while (1) {
+      Word data[kBurst];
+      for (unsigned i = 0; i < kBurst; i++) {
+        data[i] = results.Pop();
+      }
+      unsigned block = burst / kBlockBursts;
+      unsigned offset = kOperandWords + (burst % kBlockBursts) * kBurst;
+      typename axi4_::AddrPayload aw;
+      aw.id = 0;
+      aw.addr = base.read() + Addr(block) * kBlockBytes + Addr(offset) * kBytesPerWord;
+      aw.len = kBurst - 1;
+      if_wr.aw.Push(aw);
+#ifndef __SYNTHESIS__
+      write_start.push_back(Cycle());
+#endif
+      for (unsigned i = 0; i < kBurst; i++) {
+        typename axi4_::WritePayload w;
+        w.data = data[i];
+        w.wstrb = ~0;
+        w.last = (i == kBurst - 1);
+        if_wr.w.Push(w);
+      }
+      burst++;
+    }
+  }
+
+  void write_responses() {
+    if_wr.b.Reset();
+    done.write(false);
+    unsigned count = 0;
+    wait();
+
+    while (1) {
+      typename axi4_::WRespPayload resp = if_wr.b.Pop();
+      NVHLS_ASSERT_MSG(resp.resp == axi4_::Enc::XRESP::OKAY, "Write of C failed");
+#ifndef __SYNTHESIS__
+      write_latency.push_back(Cycle() - write_start.front());
+      write_start.pop_front();
+#endif
+      count++;
+      if (count == kBursts) {
+#ifndef __SYNTHESIS__
+        finish_cycle = Cycle();
+#endif
+        done.write(true);
+      }
+    }
+  }
+};
+
+/**
+ * \brief Reference system: GEMM tiles, a WHVC mesh and latency-modeling DRAMs
+ *
+ * \par Overview
+ * Nodes 0 to numTileNodes - 1 of a MeshNoC each hold tilesPerNode Tiles,
+ * whose AXI ports an AxiArbiter with remapped IDs merges onto an
+ * AxiNoCManagerNI. The last numMemNodes nodes each hold an
+ * AxiNoCSubordinateNI and a LatencySubordinate DRAM, which serves the
+ * kRegionBytes of address space from m * kRegionBytes. Tile t keeps its
+ * blocks in the DRAM t % numMemNodes, at TileBase(t).
+ *
+ */
+SC_MODULE(ReferenceSystem) {
+ public:
+  enum {
+    numNodes = REFSYS_MESH_X * REFSYS_MESH_Y,
+    numMemNodes = REFSYS_MEM_NODES,
+    numTileNodes = numNodes - numMemNodes,
+    tilesPerNode = REFSYS_TILES_PER_NODE,
+    numTiles = numTileNodes * tilesPerNode,
+    maxWrites = 4,
+    kRegionBytes = 1 << 24,
+  };
+  static_assert(numMemNodes >= 1 && numTileNodes >= 1,
+                "The mesh needs both tile and memory nodes");
+  static_assert(tilesPerNode >= 2, "The AxiArbiter of a node needs two tiles or more");
+  static_assert((numTiles + numMemNodes - 1) / numMemNodes * static_cast<long long>(Tile::kTileBytes)
+                    <= kRegionBytes,
+                "The blocks of the tiles must fit in the DRAM regions");
+
+  typedef Tile::axi4_ tileAxi_;
+  typedef AxiArbiter<TileAxiCfg, tilesPerNode, 8, Roundrobin, true> Arbiter;
+  typedef Arbiter::subordinateCfg NodeAxiCfg;
+  typedef axi::axi4<NodeAxiCfg> nodeAxi_;
+
+  // Two VCs for requests and responses, variable-length packets
+  typedef MeshNoC<REFSYS_MESH_X, REFSYS_MESH_Y, 2, 4, 64, 256, 1, true> NoC_t;
+  typedef NoC_t::Packet_t Packet_t;
+  typedef AxiNoCManagerNI<NodeAxiCfg, Packet_t, numMemNodes, maxWrites> ManagerNI;
+  typedef AxiNoCSubordinateNI<NodeAxiCfg, Packet_t, maxWrites> SubordinateNI;
+  typedef ManagerNI::Node Node;
+  typedef LatencySubordinate<NodeAxiCfg, DramCfg> Dram;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  nvhls::nv_array<Tile, numTiles> tile;
+  nvhls::nv_array<Arbiter, numTileNodes> arbiter;
+  NoC_t noc;
+  nvhls::nv_array<ManagerNI, numTileNodes> manager_ni;
+  nvhls::nv_array<SubordinateNI, numMemNodes> subordinate_ni;
+  nvhls::nv_array<Dram, numMemNodes> dram;
+
+  nvhls::nv_array<typename tileAxi_::read::template chan<>, numTiles> tile_read;
+  nvhls::nv_array<typename tileAxi_::write::template chan<>, numTiles> tile_write;
+  nvhls::nv_array<typename nodeAxi_::read::template chan<>, numTileNodes> node_read;
+  nvhls::nv_array<typename nodeAxi_::write::template chan<>, numTileNodes> node_write;
+  nvhls::nv_array<typename nodeAxi_::read::template chan<>, numMemNodes> dram_read;
+  nvhls::nv_array<typename nodeAxi_::write::template chan<>, numMemNodes> dram_write;
+
+  Connections::Combinational<Packet_t> noc_in[numNodes];
+  Connections::Combinational<Packet_t> noc_out[numNodes];
+
+  sc_signal<Tile::Addr> tile_base[numTiles];
+  sc_signal<bool> tile_done[numTiles];
+  sc_signal<Node> ni_node[numTileNodes];
+  sc_signal<NVUINTW(NodeAxiCfg::addrWidth)> addrBound[numMemNodes][2];
+  sc_signal<Node> regionNode[numMemNodes];
+
+  static unsigned long long TileBase(int t) {
+    return static_cast<unsigned long long>(t % numMemNodes) * kRegionBytes +
+           static_cast<unsigned long long>(t / numMemNodes) * Tile::kTileBytes;
+  }
+
+  SC_HAS_PROCESS(ReferenceSystem);
+
+  ReferenceSystem(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        tile("tile"),
+        arbiter("arbiter"),
+        noc("noc"),
+        manager_ni("manager_ni"),
+        subordinate_ni("subordinate_ni"),
+        dram("dram"),
+        tile_read("tile_read"),
+        tile_write("tile_write"),
+        node_read("node_read"),
+        node_write("node_write"),
+        dram_read("dram_read"),
+        dram_write("dram_write") {
+    noc.clk(clk);
+    noc.rst(reset_bar);
+    for (int n = 0; n < numNodes; n++) {
+      noc.in_packet[n](noc_in[n]);
+      noc.out_packet[n](noc_out[n]);
+    }
+
+    for (int m = 0; m < numMemNodes; m++) {
+      addrBound[m][0].write(NVUINTW(NodeAxiCfg::addrWidth)(
+          static_cast<unsigned long long>(m) * kRegionBytes));
+      addrBound[m][1].write(NVUINTW(NodeAxiCfg::addrWidth)(
+          static_cast<unsigned long long>(m + 1) * kRegionBytes - 1));
+      regionNode[m].write(Node(NoC_t::endpoint_dest(numTileNodes + m)));
+    }
+
+    for (int t = 0; t < numTiles; t++) {
+      int n = t / tilesPerNode;
+      int i = t % tilesPerNode;
+      tile[t].clk(clk);
+      tile[t].reset_bar(reset_bar);
+      tile[t].base(tile_base[t]);
+      tile[t].done(tile_done[t]);
+      tile[t].if_rd(tile_read[t]);
+      tile[t].if_wr(tile_write[t]);
+      tile_base[t].write(Tile::Addr(TileBase(t)));
+      arbiter[n].axi_rd_m_ar[i](tile_read[t].ar);
+      arbiter[n].axi_rd_m_r[i](tile_read[t].r);
+      arbiter[n].axi_wr_m_aw[i](tile_write[t].aw);
+      arbiter[n].axi_wr_m_w[i](tile_write[t].w);
+      arbiter[n].axi_wr_m_b[i](tile_write[t].b);
+    }
+
+    for (int n = 0; n < numTileNodes; n++) {
+      arbiter[n].clk(clk);
+      arbiter[n].reset_bar(reset_bar);
+      arbiter[n].axi_rd_s(node_read[n]);
+      arbiter[n].axi_wr_s(node_write[n]);
+      manager_ni[n].clk(clk);
+      manager_ni[n].reset_bar(reset_bar);
+      manager_ni[n].axi_read(node_read[n]);
+      manager_ni[n].axi_write(node_write[n]);
+      manager_ni[n].out_packet(noc_in[n]);
+      manager_ni[n].in_packet(noc_out[n]);
+      manager_ni[n].node(ni_node[n]);
+      ni_node[n].write(Node(NoC_t::endpoint_dest(n)));
+      for (int m = 0; m < numMemNodes; m++) {
+        manager_ni[n].addrBound[m][0](addrBound[m][0]);
+        manager_ni[n].addrBound[m][1](addrBound[m][1]);
+        manager_ni[n].regionNode[m](regionNode[m]);
+      }
+    }
+
+    for (int m = 0; m < numMemNodes; m++) {
+      int n = numTileNodes + m;
+      subordinate_ni[m].clk(clk);
+      subordinate_ni[m].reset_bar(reset_bar);
+      subordinate_ni[m].axi_read(dram_read[m]);
+      subordinate_ni[m].axi_write(dram_write[m]);
+      subordinate_ni[m].out_packet(noc_in[n]);
+      subordinate_ni[m].in_packet(noc_out[n]);
+      dram[m].clk(clk);
+      dram[m].reset_bar(reset_bar);
+      dram[m].if_rd(dram_read[m]);
+      dram[m].if_wr(dram_write[m]);
+    }
+  }
+};
+
+#endif  // REFERENCE_SYSTEM_H
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <mc_scverify.h>
+#include <testbench/nvhls_rand.h>
+#include "ReferenceSystem.h"
+
+// Fails the run when the workload takes more cycles than this (0: no bound)
+#ifndef REFSYS_MAX_CYCLES
+#define REFSYS_MAX_CYCLES 0
+#endif
+
+// Runs REFSYS_BLOCKS block products on every tile of the reference system,
+// checks C in the DRAMs and reports the bandwidth, the latencies and the
+// simulation speed
+SC_MODULE(testbench) {
+  typedef ReferenceSystem::Dram Dram;
+  typedef Dram::axi4_ axi4_;
+
+  enum {
+    numTiles = ReferenceSystem::numTiles,
+    numMemNodes = ReferenceSystem::numMemNodes,
+  };
+
+  ReferenceSystem sys;
+
+  sc_clock clk;
+  sc_signal<bool> reset_bar;
+
+  uint64 start_cycle;
+  uint64 end_cycle;
+
+  SC_CTOR(testbench)
+      : sys("sys"),
+        clk("clk", REFSYS_CLOCK_NS, SC_NS, 0.5, 0, SC_NS, true),
+        reset_bar("reset_bar"),
+        start_cycle(0),
+        end_cycle(0) {
+    Connections::set_sim_clk(&clk);
+    sys.clk(clk);
+    sys.reset_bar(reset_bar);
+    preload();
+
+    SC_THREAD(run);
+  }
+
+  static axi4_::Addr Address(int t, int block, int word) {
+    return axi4_::Addr(ReferenceSystem::TileBase(t) +
+                       static_cast<unsigned long long>(block) * Tile::kBlockBytes +
+                       static_cast<unsigned long long>(word) * Tile::kBytesPerWord);
+  }
+
+  // Random A and B blocks, written through the DRAM backdoors
+  void preload() {
+    for (int t = 0; t < numTiles; t++) {
+      Dram& mem = sys.dram[t % numMemNodes];
+      for (int b = 0; b < Tile::Blocks; b++) {
+        for (int w = 0; w < Tile::kOperandWords; w++) {
+          axi4_::Addr addr = Address(t, b, w);
+          mem.localMem[addr] = axi4_::Data(rand());
+          mem.localMem_wstrb[addr] = ~0;
+        }
+      }
+    }
+  }
+
+  static unsigned Load(Dram& mem, const axi4_::Addr& addr) {
+    NVHLS_ASSERT_MSG(mem.localMem.count(addr) != 0, "Word was never written");
+    return mem.localMem[addr].to_uint();
+  }
+
+  // C = A * B of every block, modulo 2^32
+  bool check() {
+    for (int t = 0; t < numTiles; t++) {
+      Dram& mem = sys.dram[t % numMemNodes];
+      for (int b = 0; b < Tile::Blocks; b++) {
+        for (int i = 0; i < Tile::M; i++) {
+          for (int j = 0; j < Tile::N; j++) {
+            unsigned c = 0;
+            for (int k = 0; k < Tile::K; k++) {
+              c += Load(mem, Address(t, b, i * Tile::K + k)) *
+                   Load(mem, Address(t, b, Tile::M * Tile::K + k * Tile::N + j));
+            }
+            int offset = Tile::kOperandWords + i * Tile::N + j;
+            if (mem.localMem.count(Address(t, b, offset)) == 0 ||
+                Load(mem, Address(t, b, offset)) != c) {
+              std::printf("tile %d block %d: wrong C[%d][%d]\n", t, b, i, j);
+              return false;
+            }
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  // Nearest-rank percentile
+  static uint64 Percentile(std::vector<uint64> values, double p) {
+    if (values.empty()) {
+      return 0;
+    }
+    std::sort(values.begin(), values.end());
+    unsigned rank = static_cast<unsigned>(p * values.size() + 0.999999);
+    return values[rank == 0 ? 0 : rank - 1];
+  }
+
+  static void PrintLatency(const char* name, const std::vector<uint64>& values) {
+    std::printf("REFSYS %s_latency count=%u p50=%llu p90=%llu p99=%llu max=%llu\n", name,
+                static_cast<unsigned>(values.size()),
+                static_cast<unsigned long long>(Percentile(values, 0.50)),
+                static_cast<unsigned long long>(Percentile(values, 0.90)),
+                static_cast<unsigned long long>(Percentile(values, 0.99)),
+                static_cast<unsigned long long>(Percentile(values, 1.0)));
+  }
+
+  void report(double seconds) {
+    uint64 cycles = end_cycle - start_cycle;
+    std::vector<uint64> fetch;
+    std::vector<uint64> write;
+    uint64 macs = 0;
+    for (int t = 0; t < numTiles; t++) {
+      fetch.insert(fetch.end(), sys.tile[t].fetch_latency.begin(), sys.tile[t].fetch_latency.end());
+      write.insert(write.end(), sys.tile[t].write_latency.begin(), sys.tile[t].write_latency.end());
+      macs += sys.tile[t].macs;
+    }
+    double read_bytes = static_cast<double>(numTiles) * Tile::Blocks * Tile::kOperandWords *
+                        Tile::kBytesPerWord;
+    double write_bytes = static_cast<double>(numTiles) * Tile::Blocks * Tile::M * Tile::N *
+                         Tile::kBytesPerWord;
+    double sim_cycles = sc_time_stamp() / sc_time(REFSYS_CLOCK_NS, SC_NS);
+
+    std::printf("REFSYS config mesh=%dx%d mem_nodes=%d tiles=%d block=%dx%dx%d lanes=%d blocks=%d\n",
+                REFSYS_MESH_X, REFSYS_MESH_Y, numMemNodes, numTiles, Tile::M, Tile::N, Tile::K,
+                Tile::Lanes, Tile::Blocks);
+    std::printf("REFSYS workload cycles=%llu macs_per_cycle=%.3f peak_macs_per_cycle=%d\n",
+                static_cast<unsigned long long>(cycles), static_cast<double>(macs) / cycles,
+                numTiles * Tile::Lanes);
+    std::printf("REFSYS bandwidth read_bytes_per_cycle=%.3f write_bytes_per_cycle=%.3f "
+                "total_bytes_per_cycle=%.3f\n",
+                read_bytes / cycles, write_bytes / cycles, (read_bytes + write_bytes) / cycles);
+    PrintLatency("fetch", fetch);
+    PrintLatency("write", write);
+    for (int m = 0; m < numMemNodes; m++) {
+      Dram& mem = sys.dram[m];
+      uint64 accesses = mem.numRowHits + mem.numRowMisses;
+      std::printf("REFSYS dram%d read_bursts=%llu avg_read_latency=%.1f row_hit_rate=%.3f\n", m,
+                  static_cast<unsigned long long>(mem.numReadBursts),
+                  mem.numReadBursts ? static_cast<double>(mem.readLatency) / mem.numReadBursts : 0.0,
+                  accesses ? static_cast<double>(mem.numRowHits) / accesses : 0.0);
+    }
+    std::printf("REFSYS simulation cycles=%.0f wall_s=%.3f cycles_per_s=%.0f\n", sim_cycles,
+                seconds, seconds > 0 ? sim_cycles / seconds : 0.0);
+  }
+
+  void run() {
+    reset_bar = 1;
+    wait(2, SC_NS);
+    reset_bar = 0;
+    wait(2, SC_NS);
+    reset_bar = 1;
+    start_cycle = Tile::Cycle();
+
+    while (1) {
+      wait(REFSYS_CLOCK_NS, SC_NS);
+      int done = 0;
+      for (int t = 0; t < numTiles; t++) {
+        if (sys.tile_done[t].read()) {
+          done++;
+        }
+      }
+      if (done == numTiles) {
+        end_cycle = Tile::Cycle();
+        sc_stop();
+      }
+    }
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  sc_start();
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (!tb.check()) {
+    rc = true;
+  }
+  tb.report(seconds);
+  if (REFSYS_MAX_CYCLES != 0 && tb.end_cycle - tb.start_cycle > REFSYS_MAX_CYCLES) {
+    std::printf("Workload took more than REFSYS_MAX_CYCLES=%d cycles\n", REFSYS_MAX_CYCLES);
+    rc = true;
+  }
+  if (rc)
+    DCOUT("TESTBENCH FAIL" << endl);
+  else
+    DCOUT("TESTBENCH PASS" << endl);
+  return rc;
+};
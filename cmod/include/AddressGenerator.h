@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __ADDRESSGENERATOR_H__
+#define __ADDRESSGENERATOR_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_message.h>
+#include <nvhls_module.h>
+#include <nvhls_types.h>
+#include <nvhls_int.h>
+#include <nvhls_mem_req.h>
+#include <hls_globals.h>
+
+/**
+ * \brief Nested-loop address generator that issues N-lane memory requests at one per cycle.
+ * \ingroup AddressGenerator
+ *
+ * \tparam T                Word type of the requests
+ * \tparam AddrWidth        Width of a word address
+ * \tparam N                Number of lanes
+ * \tparam NumDims          Number of nested loops (default: 4)
+ * \tparam CountWidth       Width of the loop counts (default: 16)
+ *
+ * \par Overview
+ * Each Descriptor read from desc_in describes a loop nest of NumDims loops,
+ * dimension 0 innermost, iterating count[d] times with addresses stride[d]
+ * words apart; set count[d] to 1 for unused outer dimensions. The addresses
+ * are issued as nvhls::mem_req_t on req_out, one request per cycle:
+ * - Each request holds N consecutive iterations of dimension 0 in its lanes.
+ *   A row of dimension 0 starts a new request, so its last request has
+ *   count[0] % N valid lanes when N does not divide count[0].
+ * - The first pad[d] iterations of dimension d, and those after the next
+ *   size[d], are padding: their lanes are not valid, but keep their place, so
+ *   that a consumer substitutes them, e.g. with zeros. base is the address
+ *   of the first iteration, padding or not. Without padding, pad[d] is 0 and
+ *   size[d] is count[d].
+ * - Addresses and strides wrap modulo 2^AddrWidth, so a negative stride is
+ *   its two's complement.
+ * - Lane addresses are the sum of a row address and a per-lane offset
+ *   computed once per descriptor, so no address takes a multiplier, and the
+ *   next descriptor starts the cycle after the last request of the current
+ *   one.
+ * - data is left to the consumer of store requests (is_store set).
+ *
+ * The requests go to ScratchpadClass::load_store() or
+ * ArbitratedScratchpad::load_store() directly, or through to_cli_req() as
+ * their cli_req_t.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <AddressGenerator.h>
+ *      ...
+ *      typedef AddressGenerator<Word_t, 16, 4, 2> Agu;
+ *      Agu::Descriptor desc;     // an 8x8 tile of a 64-word wide image,
+ *      desc.base = 0x100 - 65;   // padded by 1 word on every side
+ *      desc.count[0] = 10; desc.stride[0] = 1;  desc.pad[0] = 1; desc.size[0] = 8;
+ *      desc.count[1] = 10; desc.stride[1] = 64; desc.pad[1] = 1; desc.size[1] = 8;
+ *      desc_in.Push(desc);
+ *      for (int i = 0; i < 10 * 3; i++) {
+ *        Agu::Req req = req_out.Pop();
+ *        ...
+ *      }
+ * \endcode
+ * \par
+ *
+ */
+template <typename T, unsigned int AddrWidth, unsigned int N, unsigned int NumDims = 4,
+          unsigned int CountWidth = 16>
+class AddressGenerator : public match::Module {
+ public:
+  static const int kDebugLevel = 4;
+  typedef NVUINTW(AddrWidth) Addr;
+  typedef NVUINTW(CountWidth) Count;
+  // One more bit for the sums of counts
+  typedef NVUINTW(CountWidth + 1) Pos;
+  typedef nvhls::mem_req_t<T, AddrWidth, N> Req;
+
+  static_assert(NumDims >= 1, "At least one dimension is needed");
+  static_assert(N <= (1u << CountWidth), "N cannot exceed the largest count");
+
+  struct Descriptor : public nvhls_message {
+    NVUINT1 is_store;
+    Addr base;             // Address of the first iteration
+    Count count[NumDims];  // Iterations of each loop, dimension 0 innermost
+    Addr stride[NumDims];  // Words from one iteration to the next
+    Count pad[NumDims];    // Leading iterations that are padding
+    Count size[NumDims];   // Iterations after the leading padding that are not
+
+    static const unsigned int width = 1 + (NumDims + 1) * AddrWidth + 3 * NumDims * CountWidth;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m& is_store;
+      m& base;
+      #pragma hls_unroll yes
+      for (unsigned int d = 0; d < NumDims; d++) m& count[d];
+      #pragma hls_unroll yes
+      for (unsigned int d = 0; d < NumDims; d++) m& stride[d];
+      #pragma hls_unroll yes
+      for (unsigned int d = 0; d < NumDims; d++) m& pad[d];
+      #pragma hls_unroll yes
+      for (unsigned int d = 0; d < NumDims; d++) m& size[d];
+    }
+  };
+
+  Connections::In<Descriptor> desc_in;
+  Connections::Out<Req> req_out;
+
+ protected:
+  match::StatHandle descriptors_stat;
+  match::StatHandle requests_stat;
+  match::StatHandle padded_stat;
+
+ public:
+  SC_HAS_PROCESS(AddressGenerator);
+  AddressGenerator(sc_module_name name_)
+      : match::Module(name_), desc_in("desc_in"), req_out("req_out") {
+    descriptors_stat = this->RegisterStat("descriptors");
+    requests_stat = this->RegisterStat("requests");
+    padded_stat = this->RegisterStat("padded_requests");
+
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+ protected:
+  static bool in_window(Pos pos, Count pad, Count size) {
+    return pos >= pad && pos < Pos(pad) + size;
+  }
+
+  void run() {
+    desc_in.Reset();
+    req_out.Reset();
+
+    Descriptor desc;
+    Count idx[NumDims];
+    // Address of the current iteration of dimension d and the first
+    // iterations of the dimensions inside it
+    Addr start[NumDims];
+    Addr lane_offset[N];
+    Addr step = 0;
+    bool active = false;
+
+    #pragma hls_unroll yes
+    for (unsigned int d = 0; d < NumDims; d++) {
+      idx[d] = 0;
+      start[d] = 0;
+    }
+    #pragma hls_unroll yes
+    for (unsigned int j = 0; j < N; j++) {
+      lane_offset[j] = 0;
+    }
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (active) {
+        bool outer_valid = true;
+        #pragma hls_unroll yes
+        for (unsigned int d = 1; d < NumDims; d++) {
+          outer_valid = outer_valid && in_window(idx[d], desc.pad[d], desc.size[d]);
+        }
+        Req req;
+        req.is_store = desc.is_store;
+        #pragma hls_unroll yes
+        for (unsigned int j = 0; j < N; j++) {
+          Pos pos = Pos(idx[0]) + j;
+          bool valid = outer_valid && pos < desc.count[0] &&
+                       in_window(pos, desc.pad[0], desc.size[0]);
+          req.valids[j] = valid;
+          req.addr[j] = start[0] + lane_offset[j];
+        }
+
+        if (req_out.PushNB(req)) {
+          this->IncrStat(requests_stat);
+          if (req.valids == 0) {
+            this->IncrStat(padded_stat);
+          }
+          CDCOUT(sc_time_stamp() << " " << name() << " request:"
+                        << " addr=" << hex << req.addr[0]
+                        << " valids=" << req.valids
+                        << endl, kDebugLevel);
+
+          // The innermost dimension that does not wrap advances, and the ones
+          // inside it restart at its new address
+          bool carry = true;
+          unsigned int level = NumDims;
+          Addr next = 0;
+          #pragma hls_unroll yes
+          for (unsigned int d = 0; d < NumDims; d++) {
+            Pos inc = (d == 0) ? Pos(N) : Pos(1);
+            Pos pos = Pos(idx[d]) + inc;
+            bool wrap = pos >= desc.count[d];
+            if (carry) {
+              if (wrap) {
+                idx[d] = 0;
+              } else {
+                idx[d] = pos;
+                next = start[d] + ((d == 0) ? step : desc.stride[d]);
+                level = d;
+              }
+            }
+            carry = carry && wrap;
+          }
+          #pragma hls_unroll yes
+          for (unsigned int d = 0; d < NumDims; d++) {
+            if (d <= level) {
+              start[d] = next;
+            }
+          }
+          active = !carry;
+        }
+      }
+
+      if (!active && desc_in.PopNB(desc)) {
+        Addr offset = 0;
+        #pragma hls_unroll yes
+        for (unsigned int j = 0; j < N; j++) {
+          lane_offset[j] = offset;
+          offset += desc.stride[0];
+        }
+        step = offset;
+        active = true;
+        #pragma hls_unroll yes
+        for (unsigned int d = 0; d < NumDims; d++) {
+          idx[d] = 0;
+          start[d] = desc.base;
+          active = active && desc.count[d] != 0;
+        }
+        this->IncrStat(descriptors_stat);
+      }
+    }
+  }
+};
+
+#endif
@@ -21,8 +21,9 @@
 #include <systemc.h>
 #include <nvhls_int.h>
 #include <nvhls_assert.h>
+#include <nvhls_activity_stats.h>
 
-enum arbiter_type { Static, Roundrobin };
+enum arbiter_type { Static, Roundrobin, RoundrobinPrefix, Matrix, WeightedRoundrobin };
 
 
 /**
@@ -30,7 +31,7 @@ enum arbiter_type { Static, Roundrobin };
  * \ingroup Arbiter
  *
  * \tparam size_            Number of elements to be arbitrated.
- * \tparam ArbiterType      Selecting arbitration method. Current class implements Roundrobin, and a dedicated [class] (class_arbiter_3_01size___00_01_static_01_4.html) implements Static. (default: Roundrobin).
+ * \tparam ArbiterType      Selecting arbitration method. Current class implements Roundrobin, and dedicated specializations implement Static, RoundrobinPrefix, Matrix and WeightedRoundrobin. (default: Roundrobin).
  *
  * \par Overview
  * - Given a vector indicating which elements are currently valid for selection, and previous selection, a new selection will be made.
@@ -74,11 +75,17 @@ class Arbiter {
         Mask next;
 
     public:
+        static const int width = size_;
+
         Arbiter() { reset(); };
 
         // reset the state
         inline void reset() { next = ~static_cast<Mask>(0); }
 
+        // the arbitration state, e.g. for checkpoints
+        template <unsigned int Size>
+        void Marshall(Marshaller<Size>& m) { m & next; }
+
         // picks the next element
         // input : valid mask
         // output : select mask
@@ -126,8 +133,15 @@ class Arbiter {
             }
             // assert valid!=0  =>  (valid&choice)!=0
             //NVHLS_ASSERT_MSG(valid!=0, "Arbiter input is zero and output is non-zero");
+            activity_.Grant(choice, size_);
             return choice;
         }
+
+        // Grants per element; counted once registered with match::Module::RegisterActivityStats()
+        match::ActivityStats& Stats() { return activity_; }
+
+    protected:
+        match::ActivityStats activity_;
 };
 
 /**
@@ -148,11 +162,18 @@ class Arbiter<1, Roundrobin> {
         // picks the next element
         Mask pick(const Mask& valid) {
             if (valid !=0) {
+                activity_.Grant(valid, 1);
                 return static_cast<Mask>(1);
             } else {
                 return static_cast<Mask>(0); 
             }
         }
+
+        // Grants per element; counted once registered with match::Module::RegisterActivityStats()
+        match::ActivityStats& Stats() { return activity_; }
+
+    protected:
+        match::ActivityStats activity_;
 };
 
 
@@ -184,9 +205,395 @@ class Arbiter<size_, Static> {
                     nvhls::leading_ones<size_, Mask, NVUINTW(log_size)>(valid);
                 select[first_one_idx] = 1;
             }
+            activity_.Grant(select, size_);
             return select;
         }
+
+        // Grants per element; counted once registered with match::Module::RegisterActivityStats()
+        match::ActivityStats& Stats() { return activity_; }
+
+    protected:
+        match::ActivityStats activity_;
 };
 
+/**
+ * \brief Roundrobin arbitration built from parallel-prefix networks. Usage identical to generic Arbiter class.
+ * \ingroup Arbiter
+ *
+ * \tparam size_            Number of elements to be arbitrated.
+ *
+ * \par Overview
+ * Grants in the same order as the Roundrobin arbiter, but without its serial
+ * state update chain, so logic depth is O(log size_) rather than O(size_).
+ * Preferable for large port counts (e.g. 32 or 64 input crossbars).
+ * - next holds the positions below the last grant, which have priority.
+ * - Both valid & next and valid go through a Kogge-Stone prefix-OR from the
+ *   MSB down; the highest set bit of the first non-zero one is granted.
+ * - The thermometer of the grant, shifted down by one, is the new next.
+ **/
+template <unsigned int size_>
+class Arbiter<size_, RoundrobinPrefix> {
+    public:
+        typedef NVUINTW(size_) Mask;
+
+    protected:
+        Mask next;
+
+        // t[i] = x[i] | x[i+1] | ... | x[size_-1]
+        static Mask prefix_or(const Mask& x) {
+            Mask t = x;
+#pragma hls_unroll yes
+            for (unsigned s = 1; s < size_; s <<= 1) {
+                t |= (t >> s);
+            }
+            return t;
+        }
+
+    public:
+        static const int width = size_;
+
+        Arbiter() { reset(); };
+
+        // reset the state
+        inline void reset() { next = ~static_cast<Mask>(0); }
+
+        // the arbitration state, e.g. for checkpoints
+        template <unsigned int Size>
+        void Marshall(Marshaller<Size>& m) { m & next; }
+
+        // picks the next element
+        // input : valid mask
+        // output : select mask
+        // side effect : updates internal state of next select
+        Mask pick(const Mask& valid) {
+            Mask choice = peek(valid);
+            if (choice != 0) {
+              accept(choice);
+            }
+            return choice;
+        }
+
+        // The element pick() would select, without updating the state
+        Mask peek(const Mask& valid) const {
+            Mask priority = valid & next;
+            Mask therm_priority = prefix_or(priority);
+            Mask therm_valid = prefix_or(valid);
+            Mask therm = (priority != 0) ? therm_priority : therm_valid;
+            return therm & ~(therm >> 1);
+        }
+
+        // Update the state as if the one-hot choice had been picked; used by
+        // allocators that only commit some of the peek() results (e.g. iSLIP)
+        inline void accept(const Mask& choice) {
+            next = prefix_or(choice) >> 1;
+            activity_.Grant(choice, size_);
+        }
+
+        // Grants per element; counted once registered with match::Module::RegisterActivityStats()
+        match::ActivityStats& Stats() { return activity_; }
+
+    protected:
+        match::ActivityStats activity_;
+};
+/**
+ * \brief Matrix (least-recently-granted) arbitration specialization. Usage identical to generic Arbiter class.
+ * \ingroup Arbiter
+ *
+ * \tparam size_            Number of elements to be arbitrated.
+ *
+ * \par Overview
+ * - prio[i][j] set means element i has priority over element j. Initially
+ *   higher indices have priority, as in the Static arbiter.
+ * - An element is granted when it beats every other valid element; only one
+ *   can, so the grant is one-hot and takes one level of AND-OR logic.
+ * - The granted element then loses priority to every other element, so the
+ *   element granted least recently always wins.
+ **/
+template <unsigned int size_>
+class Arbiter<size_, Matrix> {
+    public:
+        typedef NVUINTW(size_) Mask;
+
+    protected:
+        Mask prio[size_];
+
+    public:
+        static const int width = size_ * size_;
+
+        Arbiter() { reset(); };
+
+        // the arbitration state, e.g. for checkpoints
+        template <unsigned int Size>
+        void Marshall(Marshaller<Size>& m) {
+            for (unsigned i = 0; i < size_; i++) {
+                m & prio[i];
+            }
+        }
+
+        // reset the state
+        inline void reset() {
+#pragma hls_unroll yes
+            for (unsigned i = 0; i < size_; i++) {
+                Mask row = static_cast<Mask>(0);
+#pragma hls_unroll yes
+                for (unsigned j = 0; j < i; j++) {
+                    row[j] = 1;
+                }
+                prio[i] = row;
+            }
+        }
+
+        // picks the next element
+        // input : valid mask
+        // output : select mask
+        // side effect : updates internal state of next select
+        Mask pick(const Mask& valid) {
+            Mask choice = static_cast<Mask>(0);
+#pragma hls_unroll yes
+            for (unsigned i = 0; i < size_; i++) {
+                Mask blockers = valid & ~prio[i];
+                blockers[i] = 0;
+                choice[i] = (valid[i] == 1) && (blockers == 0);
+            }
+#pragma hls_unroll yes
+            for (unsigned i = 0; i < size_; i++) {
+                prio[i] = (choice[i] == 1) ? static_cast<Mask>(0) : static_cast<Mask>(prio[i] | choice);
+            }
+            activity_.Grant(choice, size_);
+            return choice;
+        }
+
+        // Grants per element; counted once registered with match::Module::RegisterActivityStats()
+        match::ActivityStats& Stats() { return activity_; }
+
+    protected:
+        match::ActivityStats activity_;
+};
+
+/**
+ * \brief Weighted roundrobin arbitration specialization. Usage similar to generic Arbiter class.
+ * \ingroup Arbiter
+ *
+ * \tparam size_            Number of elements to be arbitrated.
+ *
+ * \par Overview
+ * - Element i may keep the grant for up to weight[i] consecutive picks while
+ *   it stays valid; then, or as soon as it drops its request, the grant moves
+ *   on in Roundrobin order.
+ * - Weights default to 1, which is plain Roundrobin, and are programmed with
+ *   set_weight(). A weight of 0 counts as 1. reset() clears the arbitration
+ *   state but keeps the weights.
+ * - The roundrobin decision uses the RoundrobinPrefix arbiter, so one grant
+ *   per cycle is kept for large sizes.
+ *
+ * \par A Simple Example
+ * \code
+ *      Arbiter<4, WeightedRoundrobin> arbiter;
+ *      arbiter.set_weight(0, 3); // element 0 gets up to 3 grants in a row
+ *      ...
+ *      Arbiter<4, WeightedRoundrobin>::Mask select = arbiter.pick(active);
+ * \endcode
+ **/
+template <unsigned int size_>
+class Arbiter<size_, WeightedRoundrobin> {
+    public:
+        typedef NVUINTW(size_) Mask;
+        enum { weight_width = 8 };
+        typedef NVUINTW(weight_width) Weight;
+        typedef NVUINTW(nvhls::index_width<size_>::val) Index;
+
+    protected:
+        Arbiter<size_, RoundrobinPrefix> rr;
+        Weight weight[size_];
+        Weight credit;  // picks left for last
+        Mask last;
+
+    public:
+        Arbiter() {
+#pragma hls_unroll yes
+            for (unsigned i = 0; i < size_; i++) {
+                weight[i] = 1;
+            }
+            reset();
+        };
+
+        // reset the state
+        inline void reset() {
+            rr.reset();
+            credit = 0;
+            last = 0;
+        }
+
+        inline void set_weight(const Index& idx, const Weight& w) {
+            NVHLS_ASSERT_MSG(idx < size_, "Arbiter weight index out of bounds");
+            weight[idx] = w;
+        }
+
+        inline Weight get_weight(const Index& idx) const { return weight[idx]; }
+
+        static const int width = Arbiter<size_, RoundrobinPrefix>::width + (size_ + 1) * weight_width + size_;
+
+        // the arbitration state and weights, e.g. for checkpoints
+        template <unsigned int Size>
+        void Marshall(Marshaller<Size>& m) {
+            rr.Marshall(m);
+            for (unsigned i = 0; i < size_; i++) {
+                m & weight[i];
+            }
+            m & credit;
+            m & last;
+        }
+
+        // picks the next element
+        // input : valid mask
+        // output : select mask
+        // side effect : updates internal state of next select
+        Mask pick(const Mask& valid) {
+            if (valid == 0) {
+              return 0;
+            }
+            if ((valid & last) != 0 && credit != 0) {
+                credit--;
+                activity_.Grant(last, size_);
+                return last;
+            }
+            Mask choice = rr.pick(valid);
+            Weight w = 0;
+#pragma hls_unroll yes
+            for (unsigned i = 0; i < size_; i++) {
+                if (choice[i] == 1) {
+                    w = weight[i];
+                }
+            }
+            credit = (w == 0) ? static_cast<Weight>(0) : static_cast<Weight>(w - 1);
+            last = choice;
+            activity_.Grant(choice, size_);
+            return choice;
+        }
+
+        // Grants per element; counted once registered with match::Module::RegisterActivityStats()
+        match::ActivityStats& Stats() { return activity_; }
+
+    protected:
+        match::ActivityStats activity_;
+};
+/**
+ * \brief Roundrobin arbiter that grants up to NumGrants elements per pick.
+ * \ingroup Arbiter
+ *
+ * \tparam size_            Number of elements to be arbitrated.
+ * \tparam NumGrants        Maximum number of grants per pick.
+ *
+ * \par Overview
+ * - Grants the first NumGrants valid elements in roundrobin order, as if the
+ *   Roundrobin arbiter had been picked NumGrants times with the winners
+ *   removed from valid, and returns them as one K-hot mask.
+ * - The next pick continues after the last element granted, so every
+ *   requester gets the same share of grants.
+ * - The grants are found by a chain of NumGrants parallel-prefix stages as
+ *   in RoundrobinPrefix, so there are no conflicts to fix up afterwards.
+ *
+ * \par A Simple Example
+ * \code
+ *      MultiGrantArbiter<8, 2> arbiter;  // e.g. a two-ported bank
+ *      MultiGrantArbiter<8, 2>::Mask select = arbiter.pick(requests);
+ *      // or as indices
+ *      MultiGrantArbiter<8, 2>::Index idx[2];
+ *      bool idx_valid[2];
+ *      arbiter.pick(requests, idx, idx_valid);
+ * \endcode
+ **/
+template <unsigned int size_, unsigned int NumGrants>
+class MultiGrantArbiter {
+    public:
+        typedef NVUINTW(size_) Mask;
+        typedef NVUINTW(nvhls::index_width<size_>::val) Index;
+
+    protected:
+        Mask next;
+
+        // t[i] = x[i] | x[i+1] | ... | x[size_-1]
+        static Mask prefix_or(const Mask& x) {
+            Mask t = x;
+#pragma hls_unroll yes
+            for (unsigned s = 1; s < size_; s <<= 1) {
+                t |= (t >> s);
+            }
+            return t;
+        }
+
+        // One roundrobin stage: grants the next element of remaining
+        static Mask grant_one(Mask& remaining, Mask& next_local) {
+            Mask priority = remaining & next_local;
+            Mask therm = (priority != 0) ? prefix_or(priority) : prefix_or(remaining);
+            Mask choice = therm & ~(therm >> 1);
+            next_local = therm >> 1;
+            remaining &= ~choice;
+            return choice;
+        }
+
+    public:
+        static const int width = size_;
+
+        MultiGrantArbiter() { reset(); };
+
+        // reset the state
+        inline void reset() { next = ~static_cast<Mask>(0); }
+
+        // the arbitration state, e.g. for checkpoints
+        template <unsigned int Size>
+        void Marshall(Marshaller<Size>& m) { m & next; }
+
+        // picks up to NumGrants elements
+        // input : valid mask
+        // output : select mask with at most NumGrants bits set
+        // side effect : updates internal state of next select
+        Mask pick(const Mask& valid) {
+            Mask remaining = valid;
+            Mask select = static_cast<Mask>(0);
+            Mask next_local = next;
+#pragma hls_unroll yes
+            for (unsigned k = 0; k < NumGrants; k++) {
+                if (remaining != 0) {
+                    select |= grant_one(remaining, next_local);
+                }
+            }
+            next = next_local;
+            activity_.Grant(select, size_);
+            return select;
+        }
+
+        // picks up to NumGrants elements and returns them as indices, in
+        // grant order; idx_valid[k] is false once there are no more grants
+        Mask pick(const Mask& valid, Index idx[NumGrants], bool idx_valid[NumGrants]) {
+            Mask select = static_cast<Mask>(0);
+            Mask remaining = valid;
+            Mask next_local = next;
+#pragma hls_unroll yes
+            for (unsigned k = 0; k < NumGrants; k++) {
+                idx[k] = 0;
+                idx_valid[k] = (remaining != 0);
+                if (remaining != 0) {
+                    Mask choice = grant_one(remaining, next_local);
+                    select |= choice;
+#pragma hls_unroll yes
+                    for (unsigned i = 0; i < size_; i++) {
+                        if (choice[i] == 1) {
+                            idx[k] = i;
+                        }
+                    }
+                }
+            }
+            next = next_local;
+            activity_.Grant(select, size_);
+            return select;
+        }
+
+        // Grants per element; counted once registered with match::Module::RegisterActivityStats()
+        match::ActivityStats& Stats() { return activity_; }
+
+    protected:
+        match::ActivityStats activity_;
+};
 
 #endif  // __ARBITER_H__
@@ -25,6 +25,8 @@
 #include <arbitrated_crossbar.h>
 #include <ArbitratedScratchpad/ArbitratedScratchpadTypes.h>
 #include <crossbar.h>
+#include <bank_mapping.h>
+#include <nvhls_sampling.h>
 /**
  * \brief Scratchpad Memories with arbitration and queuing 
  * \ingroup ArbitratedScratchpad
@@ -35,6 +37,41 @@
  * \tparam NumBanks         Number of Banks 
  * \tparam LenInputBuffer   Length of Input Buffer 
  * \tparam LenOutputBuffer  Length of Output Buffer 
+ * \tparam BankMap          Address to bank mapping policy (see BankMapLowBits)
+ * \tparam CoalesceReads    Serve loads of the same address with one bank read
+ * \tparam Atomics          Take cli_atomic_req_t requests, with atomics executed at the banks
+ *
+ * \par Overview
+ * Each bank serves one request per cycle; the request crossbar arbitrates
+ * between inputs that target the same bank and, with InputQueueLen > 0,
+ * queues the losers. In the functional mode of nvhls::Sampling, every valid
+ * input is served in the same call instead, once the queues are empty.
+ *
+ * With CoalesceReads, a load is merged into the lowest input that loads the
+ * same address in the same cycle. Only that input's request goes through
+ * the request crossbar, carrying a mask of the merged inputs; the bank read
+ * is fanned out to all of them by the response crossbar, in the same cycle.
+ * A merged input is ready exactly when the input it was merged into is.
+ * This costs NumInputs*(NumInputs-1)/2 address comparators and NumInputs
+ * bits per queued request.
+ *
+ * With Atomics, req_t is a cli_atomic_req_t, whose opcode (CLIATOMIC_T) may
+ * ask for fetch-and-add, min, max, swap or compare-and-swap instead of a
+ * load or store. The request travels the request crossbar like a store, and
+ * the winning bank runs the read-modify-write beside the bank, so an atomic
+ * takes one request and one response, and each bank completes one per
+ * cycle. The old value is returned in rsp_t like load data.
+ * - The new value is written one cycle later, from a write-back register
+ *   per bank that stores also go through, so a bank takes one read and one
+ *   write per cycle. A request for the same address in the next cycle reads
+ *   the write-back register instead of the bank, so back-to-back atomics to
+ *   one address need neither a stall nor a lock.
+ * - Atomics of different inputs to one address meet at its bank, which
+ *   serves them one at a time in arbitration order.
+ * - Atomic requests are never coalesced.
+ * .
+ * load_store() also takes the common nvhls::mem_req_t and mem_rsp_t of
+ * nvhls_mem_req.h, which convert to req_t and rsp_t without any logic.
  *
  * \par A Simple Example
  * \code
@@ -46,6 +83,12 @@
  *      ...
  *      dut.load_store(curr_cli_req, curr_cli_rsp, ready);
  *      ...
+ *      // fetch-and-add, with Atomics
+ *      ArbitratedScratchpad<DataType, ScratchpadCapacity, NumInputs, NumBanks, InputQueueLength,
+ *                           BankMapLowBits, false, true> counters;
+ *      curr_atomic_req.op.val = CLIATOMIC_T::ADD;
+ *      counters.load_store(curr_atomic_req, curr_cli_rsp, ready);
+ *      ...
  *
  * \endcode
  * \par
@@ -54,7 +97,8 @@
 
 template <typename DataType, unsigned int CapacityInBytes,
           unsigned int NumInputs, unsigned int NumBanks,
-          unsigned int InputQueueLen>
+          unsigned int InputQueueLen, typename BankMap = BankMapLowBits,
+          bool CoalesceReads = false, bool Atomics = false>
 class ArbitratedScratchpad {
 
  public:
@@ -73,12 +117,19 @@ class ArbitratedScratchpad {
   typedef NVUINTW(bank_addr_width) bank_addr_t;   // address within bank
   typedef NVUINTW(log2_inputs) input_sel_t;       // index of input
 
+  // Inputs whose loads were merged into a request (CoalesceReads only)
+  static const int follower_width = CoalesceReads ? NumInputs : 1;
+  typedef NVUINTW(follower_width) follower_mask_t;
+  typedef atomic_fields_t<DataType, Atomics> atomic_t;
+
   struct bank_req_t : public nvhls_message {
     NVUINT1 do_store;
     bank_addr_t addr;
     DataType    wdata;
     input_sel_t input_chan;
-    static const int width = 1 + bank_addr_width + Wrapped<DataType>::width + log2_inputs;
+    follower_mask_t followers;
+    atomic_t atomic;
+    static const int width = 1 + bank_addr_width + Wrapped<DataType>::width + log2_inputs + follower_width + atomic_t::width;
 
     template <unsigned int Size>
     void Marshall(Marshaller<Size>& m) {
@@ -86,6 +137,8 @@ class ArbitratedScratchpad {
       m& addr;
       m& wdata;
       m& input_chan;
+      m& followers;
+      m& atomic;
     }
   };
   struct bank_rsp_t : public nvhls_message {
@@ -100,7 +153,9 @@ class ArbitratedScratchpad {
     }
   };
 
-  typedef cli_req_t<DataType, addr_width, NumInputs> req_t; // request input type
+  typedef cli_req_t<DataType, addr_width, NumInputs> plain_req_t;
+  typedef cli_atomic_req_t<DataType, addr_width, NumInputs> atomic_req_t;
+  typedef typename std::conditional<Atomics, atomic_req_t, plain_req_t>::type req_t; // request input type
   typedef cli_rsp_t<DataType, NumInputs> rsp_t;             // response output type
 
   //------------Local Variables Here---------------------
@@ -111,6 +166,16 @@ class ArbitratedScratchpad {
   ArbitratedCrossbar<bank_req_t, NumInputs, NumBanks, InputQueueLen, 0>
       request_xbar;
 
+  // Write-back register of the atomics of each bank (Atomics only)
+  bool        wb_valid[NumBanks];
+  bank_addr_t wb_addr[NumBanks];
+  DataType    wb_data[NumBanks];
+
+  static sc_uint<3> atomic_op(const plain_req_t& req) { return CLIATOMIC_T::NONE; }
+  static sc_uint<3> atomic_op(const atomic_req_t& req) { return req.op.val; }
+  static DataType atomic_cmp(const plain_req_t& req, unsigned i) { return DataType(); }
+  static DataType atomic_cmp(const atomic_req_t& req, unsigned i) { return req.cmp[i]; }
+
   void compute_bank_request(req_t &curr_cli_req, bank_req_t bank_req[NumInputs],
                             bank_sel_t bank_sel[NumInputs],
                             bool bank_req_valid[NumInputs]) {
@@ -123,27 +188,22 @@ class ArbitratedScratchpad {
       if (NumInputs == 1) {
         bank_sel[in_chan] = 0;
       } else {
-        if (is_nbanks_power_of_2) {
-          bank_sel[in_chan] = nvhls::get_slc<log2_nbanks>(curr_cli_req.addr[in_chan], 0);
-        } else {
-          bank_sel[in_chan] = curr_cli_req.addr[in_chan] % NumBanks;
-        }
+        bank_sel[in_chan] = BankMap::template bank<NumBanks, addr_width>(curr_cli_req.addr[in_chan]);
       }
-      // Compile the bank request
+      // Compile the bank request; an atomic is neither a load nor a store
+      sc_uint<3> op = Atomics ? atomic_op(curr_cli_req) : sc_uint<3>(CLIATOMIC_T::NONE);
       bank_req[in_chan].do_store = (curr_cli_req.valids[in_chan] == true) &&
-                                   (curr_cli_req.type.val == CLITYPE_T::STORE);
+                                   (curr_cli_req.type.val == CLITYPE_T::STORE) &&
+                                   (op == CLIATOMIC_T::NONE);
+      bank_req[in_chan].atomic.set(op, atomic_cmp(curr_cli_req, in_chan));
 
       if (NumInputs == 1) {
         bank_req[in_chan].addr = curr_cli_req.addr[in_chan];
       } else {
-        if (is_nbanks_power_of_2) {
-          bank_req[in_chan].addr = nvhls::get_slc<addr_width - log2_nbanks>(curr_cli_req.addr[in_chan], log2_nbanks);
-        } else {
-          bank_req[in_chan].addr = curr_cli_req.addr[in_chan] / NumBanks;
-        }
+        bank_req[in_chan].addr = BankMap::template index<NumBanks, addr_width>(curr_cli_req.addr[in_chan]);
       }
 
-      if (bank_req[in_chan].do_store) {
+      if (bank_req[in_chan].do_store || (op != CLIATOMIC_T::NONE)) {
         bank_req[in_chan].wdata = curr_cli_req.data[in_chan];
       }
 
@@ -156,12 +216,48 @@ class ArbitratedScratchpad {
     }
   }
 
+  // Merges each load into the lowest input loading the same address; a
+  // merged input is dropped from the request crossbar and recorded in the
+  // followers of the input it was merged into
+  void coalesce_reads(bank_req_t bank_req[NumInputs],
+                      bank_sel_t bank_sel[NumInputs],
+                      bool bank_req_valid[NumInputs],
+                      bool merged[NumInputs],
+                      input_sel_t leader[NumInputs]) {
+    #pragma hls_unroll yes
+    for (unsigned i = 0; i < NumInputs; i++) {
+      merged[i] = false;
+      leader[i] = i;
+      #pragma hls_unroll yes
+      for (unsigned j = 0; j < i; j++) {
+        if (!merged[i] && bank_req_valid[i] && bank_req_valid[j] &&
+            !bank_req[i].do_store && !bank_req[j].do_store &&
+            (bank_req[i].atomic.get_op() == CLIATOMIC_T::NONE) &&
+            (bank_req[j].atomic.get_op() == CLIATOMIC_T::NONE) &&
+            (bank_sel[i] == bank_sel[j]) && (bank_req[i].addr == bank_req[j].addr)) {
+          merged[i] = true;
+          leader[i] = j;
+        }
+      }
+    }
+
+    #pragma hls_unroll yes
+    for (unsigned i = 0; i < NumInputs; i++) {
+      if (merged[i]) {
+        bank_req[leader[i]].followers[i] = 1;
+        bank_req_valid[i] = false;
+      }
+    }
+  }
+
   void banks_load_store(bank_req_t bank_req[NumBanks],
                         bool bank_req_valid[NumBanks],
                         bank_rsp_t bank_rsp[NumBanks]) {
     #pragma hls_unroll yes
     for (unsigned bank = 0; bank < NumBanks; bank++) {
-      if (bank_req_valid[bank] == true) {
+      if (Atomics) {
+        atomic_load_store(bank, bank_req[bank], bank_req_valid[bank], bank_rsp[bank]);
+      } else if (bank_req_valid[bank] == true) {
         if (!bank_req[bank].do_store) {
           bank_rsp[bank].valid = true;
           bank_rsp[bank].rdata = banks.read(bank_req[bank].addr, bank);
@@ -175,10 +271,80 @@ class ArbitratedScratchpad {
     }
   }
 
+  // One bank with Atomics: the write of the previous cycle is written from
+  // the write-back register, which also serves a read of the same address,
+  // so the bank takes one read and one write per cycle
+  void atomic_load_store(unsigned bank, const bank_req_t& req, bool req_valid,
+                         bank_rsp_t& rsp) {
+    sc_uint<3> op = req.atomic.get_op();
+    bool hit = wb_valid[bank] && (wb_addr[bank] == req.addr);
+    DataType old = wb_data[bank];
+    if (req_valid && !req.do_store && !hit) {
+      old = banks.read(req.addr, bank);
+    }
+    if (wb_valid[bank]) {
+      banks.write(wb_addr[bank], bank, wb_data[bank]);
+    }
+    wb_valid[bank] = false;
+    rsp.valid = false;
+    if (req_valid) {
+      if (req.do_store) {
+        wb_valid[bank] = true;
+        wb_addr[bank] = req.addr;
+        wb_data[bank] = req.wdata;
+      } else {
+        rsp.valid = true;
+        rsp.rdata = old;
+        if (op != CLIATOMIC_T::NONE) {
+          wb_valid[bank] = true;
+          wb_addr[bank] = req.addr;
+          wb_data[bank] = atomic_update<DataType>(op, old, req.wdata, req.atomic.get_cmp());
+        }
+      }
+    }
+  }
+
+  // Writes back the pending writes of all banks
+  void flush_atomics() {
+    #pragma hls_unroll yes
+    for (unsigned bank = 0; bank < NumBanks; bank++) {
+      if (wb_valid[bank]) {
+        banks.write(wb_addr[bank], bank, wb_data[bank]);
+      }
+      wb_valid[bank] = false;
+    }
+  }
+
  public:
   ArbitratedScratchpad() { reset(); }
 
-  void reset() { request_xbar.reset(); }
+  void reset() {
+    request_xbar.reset();
+    #pragma hls_unroll yes
+    for (unsigned bank = 0; bank < NumBanks; bank++) {
+      wb_valid[bank] = false;
+    }
+  }
+
+  // The common nvhls::mem_req_t interface, converted in place
+  template <unsigned int MemAddrWidth>
+  void load_store(const nvhls::mem_req_t<DataType, MemAddrWidth, NumInputs>& req,
+                  nvhls::mem_rsp_t<DataType, NumInputs>& load_rsp,
+                  bool input_ready[NumInputs]) {
+    req_t cli_req;
+    rsp_t cli_rsp;
+    to_cli_req(req, cli_req);
+  #ifndef HLS_ALGORITHMICC
+    bank_req_t bank_req[NumInputs];
+    bank_sel_t bank_sel[NumInputs];
+    bool bank_req_valid[NumInputs];
+    compute_bank_request(cli_req, bank_req, bank_sel, bank_req_valid);
+    load_store(bank_req, bank_sel, bank_req_valid, cli_rsp, input_ready);
+  #else
+    load_store(cli_req, cli_rsp, input_ready);
+  #endif
+    to_mem_rsp(cli_rsp, load_rsp);
+  }
 
   #ifdef HLS_ALGORITHMICC
   void load_store(req_t &curr_cli_req, rsp_t &load_rsp,
@@ -194,6 +360,34 @@ class ArbitratedScratchpad {
 		  bool       bank_req_valid[NumInputs],
 		  rsp_t &load_rsp, bool input_ready[NumInputs]) {
   #endif
+#ifndef __SYNTHESIS__
+    // Functional fast-forward of sampled simulation: once the request queues
+    // are empty, every valid input is served in input order
+    if (nvhls::Sampling::Functional() && request_xbar.isAllInputEmpty()) {
+      if (Atomics) {
+        flush_atomics();
+      }
+      for (unsigned i = 0; i < NumInputs; i++) {
+        input_ready[i] = true;
+        load_rsp.valids[i] = false;
+        if (bank_req_valid[i]) {
+          if (bank_req[i].do_store) {
+            banks.write(bank_req[i].addr, bank_sel[i], bank_req[i].wdata);
+          } else {
+            load_rsp.data[i] = banks.read(bank_req[i].addr, bank_sel[i]);
+            load_rsp.valids[i] = true;
+            sc_uint<3> op = bank_req[i].atomic.get_op();
+            if (op != CLIATOMIC_T::NONE) {
+              banks.write(bank_req[i].addr, bank_sel[i],
+                          atomic_update<DataType>(op, load_rsp.data[i], bank_req[i].wdata,
+                                                  bank_req[i].atomic.get_cmp()));
+            }
+          }
+        }
+      }
+      return;
+    }
+#endif
     CDCOUT("\tinputs:" << endl, kDebugLevel);
     for (unsigned i = 0; i < NumInputs; ++i) {
       CDCOUT("\t" << i << " :"
@@ -207,11 +401,33 @@ class ArbitratedScratchpad {
     }
     CDCOUT("\t------" << endl, kDebugLevel);
 
+    bool xbar_req_valid[NumInputs];
+    bool merged[NumInputs];
+    input_sel_t leader[NumInputs];
+    #pragma hls_unroll yes
+    for (unsigned i = 0; i < NumInputs; i++) {
+      xbar_req_valid[i] = bank_req_valid[i];
+      merged[i] = false;
+      bank_req[i].followers = 0;
+    }
+    if (CoalesceReads) {
+      coalesce_reads(bank_req, bank_sel, xbar_req_valid, merged, leader);
+    }
+
     bank_req_t bank_req_winner[NumBanks];
     bool bank_req_winner_valid[NumBanks];
-    request_xbar.run(bank_req, bank_sel, bank_req_valid, bank_req_winner,
+    request_xbar.run(bank_req, bank_sel, xbar_req_valid, bank_req_winner,
                      bank_req_winner_valid, input_ready);
 
+    if (CoalesceReads) {
+      #pragma hls_unroll yes
+      for (unsigned i = 0; i < NumInputs; i++) {
+        if (merged[i]) {
+          input_ready[i] = input_ready[leader[i]];
+        }
+      }
+    }
+
     CDCOUT("\t\tbank winner transactions:" << endl, kDebugLevel);
     for (unsigned i = 0; i < NumBanks; ++i) {
       CDCOUT("\t\t" << i << " :"
@@ -252,6 +468,15 @@ class ArbitratedScratchpad {
       if (bank_rsp[bank].valid) {
         source[bank_req_winner[bank].input_chan]    = bank;
         valid_src[bank_req_winner[bank].input_chan] = true;
+        if (CoalesceReads) {
+          #pragma hls_unroll yes
+          for (unsigned out = 0; out < NumInputs; out++) {
+            if (bank_req_winner[bank].followers[out]) {
+              source[out]    = bank;
+              valid_src[out] = true;
+            }
+          }
+        }
       }
     }
 
@@ -20,6 +20,7 @@
 #include <nvhls_types.h>
 #include <nvhls_message.h>
 #include <comptrees.h>
+#include <nvhls_mem_req.h>
 
 // Declare client input and output interfaces as structs
 class CLITYPE_T : public nvhls_message {
@@ -59,6 +60,94 @@ class cli_req_t : public nvhls_message {
   }
 };
 
+// Atomic opcodes of cli_atomic_req_t, executed beside the banks of an
+// ArbitratedScratchpad with Atomics set
+class CLIATOMIC_T : public nvhls_message {
+ public:
+  enum { NONE, ADD, MIN, MAX, SWAP, CAS };
+  sc_uint<3> val;
+  static const int width = 3;
+
+  CLIATOMIC_T() : val(NONE) {}
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m& val;
+  }
+};
+
+// A cli_req_t with an atomic opcode for all of its inputs. With op NONE it
+// is a load or a store as given by type; otherwise data holds the operand,
+// cmp the compare value of CAS, and every input gets the old value back.
+template <typename T, unsigned int AddrWidth, unsigned int N>
+class cli_atomic_req_t : public cli_req_t<T, AddrWidth, N> {
+ public:
+  typedef cli_req_t<T, AddrWidth, N> base_t;
+  CLIATOMIC_T op;
+  T cmp[N];
+  static const int width = base_t::width + CLIATOMIC_T::width + N * base_t::type_width;
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    base_t::Marshall(m);
+    m& op;
+    for(unsigned i=0; i<N; i++) {
+      m& cmp[i];
+    }
+  }
+};
+
+// The opcode and compare value that travel with a bank request. Without
+// atomics they take no bits and read as CLIATOMIC_T::NONE.
+template <typename T, bool Enable>
+class atomic_fields_t : public nvhls_message {
+ public:
+  sc_uint<3> op;
+  T cmp;
+  static const int width = 3 + Wrapped<T>::width;
+
+  sc_uint<3> get_op() const { return op; }
+  T get_cmp() const { return cmp; }
+  void set(const sc_uint<3>& op_, const T& cmp_) {
+    op = op_;
+    cmp = cmp_;
+  }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m& op;
+    m& cmp;
+  }
+};
+
+template <typename T>
+class atomic_fields_t<T, false> : public nvhls_message {
+ public:
+  static const int width = 0;
+
+  sc_uint<3> get_op() const { return CLIATOMIC_T::NONE; }
+  T get_cmp() const { return T(); }
+  void set(const sc_uint<3>& op_, const T& cmp_) {}
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {}
+};
+
+// New value of an atomic read-modify-write
+template <typename T>
+T atomic_update(const sc_uint<3>& op, const T& old, const T& operand, const T& cmp) {
+  T result = old;
+  switch (op) {
+    case CLIATOMIC_T::ADD:  result = old + operand; break;
+    case CLIATOMIC_T::MIN:  result = (operand < old) ? operand : old; break;
+    case CLIATOMIC_T::MAX:  result = (old < operand) ? operand : old; break;
+    case CLIATOMIC_T::SWAP: result = operand; break;
+    case CLIATOMIC_T::CAS:  result = (old == cmp) ? operand : old; break;
+    default: break;
+  }
+  return result;
+}
+
 template <typename T, unsigned int N>
 class cli_rsp_t : public nvhls_message {
  public:
@@ -78,4 +167,46 @@ class cli_rsp_t : public nvhls_message {
   }
 };
 
+// Zero-latency conversions between cli_req_t/cli_rsp_t and the common
+// nvhls::mem_req_t/mem_rsp_t; addresses are resized to the destination width
+template <typename T, unsigned int AddrWidth, unsigned int MemAddrWidth, unsigned int N>
+void to_cli_req(const nvhls::mem_req_t<T, MemAddrWidth, N>& in, cli_req_t<T, AddrWidth, N>& out) {
+  out.type.val = (in.is_store == 1) ? CLITYPE_T::STORE : CLITYPE_T::LOAD;
+  #pragma hls_unroll yes
+  for (unsigned int i = 0; i < N; i++) {
+    out.valids[i] = (in.valids[i] == 1);
+    out.addr[i] = in.addr[i];
+    out.data[i] = in.data[i];
+  }
+}
+
+template <typename T, unsigned int AddrWidth, unsigned int MemAddrWidth, unsigned int N>
+void to_mem_req(const cli_req_t<T, AddrWidth, N>& in, nvhls::mem_req_t<T, MemAddrWidth, N>& out) {
+  out.is_store = (in.type.val == CLITYPE_T::STORE);
+  #pragma hls_unroll yes
+  for (unsigned int i = 0; i < N; i++) {
+    out.valids[i] = in.valids[i];
+    out.addr[i] = in.addr[i];
+    out.data[i] = in.data[i];
+  }
+}
+
+template <typename T, unsigned int N>
+void to_cli_rsp(const nvhls::mem_rsp_t<T, N>& in, cli_rsp_t<T, N>& out) {
+  #pragma hls_unroll yes
+  for (unsigned int i = 0; i < N; i++) {
+    out.valids[i] = (in.valids[i] == 1);
+    out.data[i] = in.data[i];
+  }
+}
+
+template <typename T, unsigned int N>
+void to_mem_rsp(const cli_rsp_t<T, N>& in, nvhls::mem_rsp_t<T, N>& out) {
+  #pragma hls_unroll yes
+  for (unsigned int i = 0; i < N; i++) {
+    out.valids[i] = in.valids[i];
+    out.data[i] = in.data[i];
+  }
+}
+
 #endif
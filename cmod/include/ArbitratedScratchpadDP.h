@@ -23,6 +23,7 @@
 #include <nvhls_message.h>
 #include <arbitrated_crossbar.h>
 #include <crossbar.h>
+#include <bank_mapping.h>
 #include <hls_globals.h>
 
 /**
@@ -36,6 +37,24 @@
  * \tparam WordType         WordType of entry in memory 
  * \tparam isSF             Is Store-Forward enabled for simultaneous read and write to same address 
  * \tparam IsSPRAM          Is memory mapped to single-port RAM. Either read or write is allowed per cycle 
+ * \tparam BankMap          Address to bank mapping policy (see BankMapLowBits)
+ * \tparam kNumByteEnables  Number of independently writable slices of a word
+ * \tparam WriteCombine     Put a write-combining buffer in front of each bank
+ *
+ * \par Overview
+ * Reads and writes are arbitrated per bank by two ArbitratedCrossbars; each
+ * bank serves one read and one write per cycle (one of the two if IsSPRAM).
+ * The run() overloads that take write_mask write only the word slices whose
+ * mask bit is set, as mem_array_sep does with NumByteEnables.
+ *
+ * With WriteCombine, each bank has a one-word buffer in front of it. A
+ * granted write merges its slices into the buffer if the buffer holds the
+ * same word; otherwise the buffer is written to the bank, with its
+ * accumulated mask, and takes the new write. Reads see the bank overlaid
+ * with the buffer (and, if isSF, with the write of the same cycle), and do
+ * not access the bank at all if those cover every slice. With IsSPRAM, only
+ * a write that evicts the buffer blocks the bank's read. Call flush() before
+ * accessing the banks other than through run().
  *
  * \par A Simple Example
  * \code
@@ -55,7 +74,8 @@
  */
 
 template<unsigned int kNumBanks, unsigned int kNumReadPorts,unsigned int
-kNumWritePorts, unsigned int kEntriesPerBank, typename WordType, bool isSF=true, bool IsSPRAM=false>
+kNumWritePorts, unsigned int kEntriesPerBank, typename WordType, bool isSF=true, bool IsSPRAM=false,
+typename BankMap=BankMapLowBits, unsigned int kNumByteEnables=1, bool WriteCombine=false>
 class ArbitratedScratchpadDP {
 
   static const unsigned int kReadPortIndexSize = nvhls::index_width<kNumReadPorts>::val;
@@ -70,6 +90,7 @@ class ArbitratedScratchpadDP {
   typedef NVUINTW(kAddressSize) Address;
   typedef NVUINTW(kNumReadPorts) ReadPortBitVector;
   typedef NVUINTW(kNumWritePorts) WritePortBitVector;
+  typedef NVUINTW(kNumByteEnables) WriteMask;
   typedef bool Ack;
 
 
@@ -77,11 +98,13 @@ class ArbitratedScratchpadDP {
    public:
     LocalIndex localindex;
     WordType data;
-    static const int width = WordType::width + LocalIndex::width;
+    WriteMask mask;
+    static const int width = WordType::width + LocalIndex::width + WriteMask::width;
     template <unsigned int Size>
     void Marshall(Marshaller<Size>& m) {
       m& localindex;
       m& data;
+      m& mask;
     }
   };
 
@@ -110,10 +133,29 @@ class ArbitratedScratchpadDP {
   };
 
   // Local state
-  mem_array_sep <WordType, kNumBanks * kEntriesPerBank, kNumBanks> banks;
+  mem_array_sep <WordType, kNumBanks * kEntriesPerBank, kNumBanks, kNumByteEnables> banks;
   ArbitratedCrossbar<bankread_req_t, kNumReadPorts, kNumBanks, 0, 0> read_arbxbar;
   ArbitratedCrossbar<bankwrite_req_t, kNumWritePorts, kNumBanks, 0, 0> write_arbxbar;
 
+  // Write-combining buffer of each bank (WriteCombine only)
+  bool       wcb_valid[kNumBanks];
+  LocalIndex wcb_index[kNumBanks];
+  WordType   wcb_data[kNumBanks];
+  WriteMask  wcb_mask[kNumBanks];
+
+  // Slices of update selected by mask, over base
+  static WordType merge_slices(WordType base, WordType update, WriteMask mask) {
+    static const unsigned int kSliceWidth = WordType::width / kNumByteEnables;
+    WordType merged = base;
+    #pragma hls_unroll yes
+    for (unsigned i = 0; i < kNumByteEnables; i++) {
+      if (mask[i]) {
+        merged = nvhls::set_slc(merged, nvhls::get_slc<kSliceWidth>(update, i * kSliceWidth), i * kSliceWidth);
+      }
+    }
+    return merged;
+  }
+
   void compute_bankread_request(Address read_address[kNumReadPorts], bool read_req_valid[kNumReadPorts], 
                             bankread_req_t bankread_req[kNumReadPorts],
                             BankIndex bankread_sel[kNumReadPorts],
@@ -130,6 +172,7 @@ class ArbitratedScratchpadDP {
 
   void compute_bankwrite_request(Address write_address[kNumWritePorts], bool write_req_valid[kNumWritePorts], 
                             WordType write_data[kNumWritePorts],  
+                            WriteMask write_mask[kNumWritePorts],
                             bankwrite_req_t bankwrite_req[kNumWritePorts],
                             BankIndex bankwrite_sel[kNumWritePorts],
                             bool bankwrite_req_valid[kNumWritePorts]) {
@@ -140,6 +183,7 @@ class ArbitratedScratchpadDP {
       bankwrite_sel[in_chan] = GetBankIndex(write_address[in_chan]);
       bankwrite_req[in_chan].localindex = GetLocalIndex(write_address[in_chan]);
       bankwrite_req[in_chan].data = write_data[in_chan];
+      bankwrite_req[in_chan].mask = write_mask[in_chan];
       bankwrite_req_valid[in_chan] = (write_req_valid[in_chan] == true);
     }
   }
@@ -159,7 +203,15 @@ class ArbitratedScratchpadDP {
           bankread_rsp[bank].valid = true;
           // Check for data forwarding
           if (isSF && (bankwrite_req_valid[bank] == true) && (bankread_req[bank].localindex == bankwrite_req[bank].localindex)) {
-            bankread_rsp[bank].rdata = bankwrite_req[bank].data;
+            if (kNumByteEnables == 1) {
+              bankread_rsp[bank].rdata = bankwrite_req[bank].data;
+            } else {
+              WordType rdata = 0;
+              if (valid_entry[bank][bankread_req[bank].localindex]) {
+                rdata = banks.read(bankread_req[bank].localindex, bank);
+              }
+              bankread_rsp[bank].rdata = merge_slices(rdata, bankwrite_req[bank].data, bankwrite_req[bank].mask);
+            }
           } else if (valid_entry[bank][bankread_req[bank].localindex]) {
             bankread_rsp[bank].rdata = banks.read(bankread_req[bank].localindex, bank);
           } else {
@@ -170,7 +222,7 @@ class ArbitratedScratchpadDP {
           bankread_rsp[bank].valid = false;
         } 
         if (bankwrite_req_valid[bank] == true) {
-          banks.write(bankwrite_req[bank].localindex, bank, bankwrite_req[bank].data);
+          banks.write(bankwrite_req[bank].localindex, bank, bankwrite_req[bank].data, bankwrite_req[bank].mask);
         }
       } else {
         //if (bankread_req_valid[bank] == true) {
@@ -192,7 +244,7 @@ class ArbitratedScratchpadDP {
         //}
 
         if (bankwrite_req_valid[bank] == true) {
-          banks.write(bankwrite_req[bank].localindex, bank, bankwrite_req[bank].data);
+          banks.write(bankwrite_req[bank].localindex, bank, bankwrite_req[bank].data, bankwrite_req[bank].mask);
           NVHLS_ASSERT_MSG(bankread_req_valid[bank] == false, "Bank read and write valid cannot be true simultaneously for single-port RAM");
           bankread_rsp[bank].rdata = 0;
           bankread_rsp[bank].valid = false;
@@ -220,23 +272,76 @@ class ArbitratedScratchpadDP {
     }
   }
 
+  void banks_load_store_wc(bankread_req_t bankread_req[kNumBanks],
+                           bool bankread_req_valid[kNumBanks],
+                           bankwrite_req_t bankwrite_req[kNumBanks],
+                           bool bankwrite_req_valid[kNumBanks],
+                           bankread_rsp_t bankread_rsp[kNumBanks],
+                           NVUINTW(kEntriesPerBank) valid_entry[kNumBanks]
+                    ) {
+    const WriteMask kFullMask = ~static_cast<WriteMask>(0);
+    #pragma hls_unroll yes
+    for (unsigned bank = 0; bank < kNumBanks; bank++) {
+      LocalIndex rd_index = bankread_req[bank].localindex;
+      LocalIndex wr_index = bankwrite_req[bank].localindex;
+
+      // Read: bank, then buffer, then (isSF) the write of this cycle
+      if (bankread_req_valid[bank] == true) {
+        bool wcb_hit = wcb_valid[bank] && (wcb_index[bank] == rd_index);
+        bool wr_hit = isSF && (bankwrite_req_valid[bank] == true) && (wr_index == rd_index);
+        bool covered = (wcb_hit && (wcb_mask[bank] == kFullMask)) ||
+                       (wr_hit && (bankwrite_req[bank].mask == kFullMask));
+        WordType rdata = 0;
+        if (!covered && valid_entry[bank][rd_index]) {
+          rdata = banks.read(rd_index, bank);
+        }
+        if (wcb_hit) {
+          rdata = merge_slices(rdata, wcb_data[bank], wcb_mask[bank]);
+        }
+        if (wr_hit) {
+          rdata = merge_slices(rdata, bankwrite_req[bank].data, bankwrite_req[bank].mask);
+        }
+        bankread_rsp[bank].valid = true;
+        bankread_rsp[bank].rdata = rdata;
+      } else {
+        bankread_rsp[bank].rdata = 0;
+        bankread_rsp[bank].valid = false;
+      }
+
+      // Write: merge into the buffer, or evict it to the bank
+      if (bankwrite_req_valid[bank] == true) {
+        if (wcb_valid[bank] && (wcb_index[bank] == wr_index)) {
+          wcb_data[bank] = merge_slices(wcb_data[bank], bankwrite_req[bank].data, bankwrite_req[bank].mask);
+          wcb_mask[bank] = wcb_mask[bank] | bankwrite_req[bank].mask;
+        } else {
+          if (wcb_valid[bank]) {
+            banks.write(wcb_index[bank], bank, wcb_data[bank], wcb_mask[bank]);
+          }
+          wcb_valid[bank] = true;
+          wcb_index[bank] = wr_index;
+          wcb_data[bank] = bankwrite_req[bank].data;
+          wcb_mask[bank] = bankwrite_req[bank].mask;
+        }
+      }
+    }
+  }
+
   public:
 
+  ArbitratedScratchpadDP() {
+    #pragma hls_unroll yes
+    for (unsigned bank = 0; bank < kNumBanks; bank++) {
+      wcb_valid[bank] = false;
+    }
+  }
+
   // Helper Functions
   BankIndex GetBankIndex(Address a) {
-    if (kNumBanks == 1) {
-      return 0;
-    } else {
-      return nvhls::get_slc(a, kBankIndexSize - 1, 0);
-    }
+    return BankMap::template bank<kNumBanks, kAddressSize>(a);
   }
 
   LocalIndex GetLocalIndex(Address a) {
-    if (kNumBanks == 1) {
-      return a;
-    } else {
-      return nvhls::get_slc(a, kAddressSize - 1, kBankIndexSize);
-    }
+    return BankMap::template index<kNumBanks, kAddressSize>(a);
   }
   
   void clear() {
@@ -245,11 +350,26 @@ class ArbitratedScratchpadDP {
      "CTC SKIP";
    #endif
     banks.reset();
+    #pragma hls_unroll yes
+    for (unsigned bank = 0; bank < kNumBanks; bank++) {
+      wcb_valid[bank] = false;
+    }
    #ifdef COV_ENABLE
      "CTC ENDSKIP";
    #endif
   }
 
+  // Write the write-combining buffers back to the banks
+  void flush() {
+    #pragma hls_unroll yes
+    for (unsigned bank = 0; bank < kNumBanks; bank++) {
+      if (wcb_valid[bank]) {
+        banks.write(wcb_index[bank], bank, wcb_data[bank], wcb_mask[bank]);
+        wcb_valid[bank] = false;
+      }
+    }
+  }
+
   void run(Address read_address[kNumReadPorts], bool read_req_valid[kNumReadPorts],
                     Address write_address[kNumWritePorts], bool write_req_valid[kNumWritePorts], 
                     WordType write_data[kNumWritePorts], 
@@ -278,6 +398,48 @@ class ArbitratedScratchpadDP {
                     WordType port_read_out[kNumReadPorts], bool port_read_out_valid[kNumReadPorts],
                     NVUINTW(kEntriesPerBank) valid_entry[kNumBanks]  
 ) {
+    WriteMask write_mask[kNumWritePorts];
+    #pragma hls_unroll yes
+    for (unsigned i = 0; i < kNumWritePorts; i++) {
+      write_mask[i] = ~static_cast<WriteMask>(0);
+    }
+    run(read_address, read_req_valid,
+                    write_address, write_req_valid, 
+                    write_data, write_mask,
+                    read_ack, write_ack,
+                    read_ready, 
+                    port_read_out, port_read_out_valid, valid_entry); 
+  }
+
+  // Partial writes: only the slices of write_data[i] set in write_mask[i]
+  void run(Address read_address[kNumReadPorts], bool read_req_valid[kNumReadPorts],
+                    Address write_address[kNumWritePorts], bool write_req_valid[kNumWritePorts], 
+                    WordType write_data[kNumWritePorts], WriteMask write_mask[kNumWritePorts],
+                    Ack read_ack[kNumReadPorts], Ack write_ack[kNumWritePorts],
+                    bool read_ready[kNumReadPorts], 
+                    WordType port_read_out[kNumReadPorts], bool port_read_out_valid[kNumReadPorts]
+) {
+    NVUINTW(kEntriesPerBank) valid_entry[kNumBanks];
+    #pragma hls_unroll yes
+    for (unsigned i = 0; i < kNumBanks; i++) {
+      valid_entry[i] = ~0;
+    }
+    run(read_address, read_req_valid,
+                    write_address, write_req_valid, 
+                    write_data, write_mask,
+                    read_ack, write_ack,
+                    read_ready, 
+                    port_read_out, port_read_out_valid, valid_entry); 
+  }
+
+  void run(Address read_address[kNumReadPorts], bool read_req_valid[kNumReadPorts],
+                    Address write_address[kNumWritePorts], bool write_req_valid[kNumWritePorts], 
+                    WordType write_data[kNumWritePorts], WriteMask write_mask[kNumWritePorts],
+                    Ack read_ack[kNumReadPorts], Ack write_ack[kNumWritePorts],
+                    bool read_ready[kNumReadPorts], 
+                    WordType port_read_out[kNumReadPorts], bool port_read_out_valid[kNumReadPorts],
+                    NVUINTW(kEntriesPerBank) valid_entry[kNumBanks]  
+) {
 
     bankread_req_t bankread_req[kNumReadPorts];
     BankIndex bankread_sel[kNumReadPorts];
@@ -288,7 +450,7 @@ class ArbitratedScratchpadDP {
     bankwrite_req_t bankwrite_req[kNumWritePorts];
     BankIndex bankwrite_sel[kNumWritePorts];
     bool bankwrite_req_valid[kNumWritePorts];
-    compute_bankwrite_request(write_address, write_req_valid, write_data, 
+    compute_bankwrite_request(write_address, write_req_valid, write_data, write_mask,
                             bankwrite_req, bankwrite_sel,
                             bankwrite_req_valid);
 
@@ -320,18 +482,32 @@ class ArbitratedScratchpadDP {
     if (IsSPRAM) {
     #pragma hls_unroll yes
     for (unsigned bank = 0; bank < kNumBanks; bank++) {
-      if (bankread_req_winner_valid[bank] && bankwrite_req_winner_valid[bank]) {
+      // A write merged into the write-combining buffer leaves the bank free
+      bool bank_write = bankwrite_req_winner_valid[bank];
+      if (WriteCombine) {
+        bank_write = bank_write && wcb_valid[bank] &&
+                     (wcb_index[bank] != bankwrite_req_winner[bank].localindex);
+      }
+      if (bankread_req_winner_valid[bank] && bank_write) {
         bankread_req_winner_valid[bank] = false;
         read_ack[read_source[bank]] = false;
       }
     }
     }
     bankread_rsp_t bankread_rsp[kNumBanks];
-    banks_load_store(bankread_req_winner, 
-                     bankread_req_winner_valid,
-                     bankwrite_req_winner,
-                     bankwrite_req_winner_valid,
-                     bankread_rsp, valid_entry); 
+    if (WriteCombine) {
+      banks_load_store_wc(bankread_req_winner,
+                          bankread_req_winner_valid,
+                          bankwrite_req_winner,
+                          bankwrite_req_winner_valid,
+                          bankread_rsp, valid_entry);
+    } else {
+      banks_load_store(bankread_req_winner, 
+                       bankread_req_winner_valid,
+                       bankwrite_req_winner,
+                       bankwrite_req_winner_valid,
+                       bankread_rsp, valid_entry); 
+    }
 
     // Prepare the inputs for response crossbar
     WordType   bank_read_out[kNumBanks];
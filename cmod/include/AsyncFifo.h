@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __ASYNCFIFO_H__
+#define __ASYNCFIFO_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_marshaller.h>
+#include <TypeToBits.h>
+
+/**
+ * \brief An asynchronous FIFO between two clock domains, with Gray-coded pointers.
+ * \ingroup AsyncFifo
+ *
+ * \tparam T            Message type.
+ * \tparam Depth        Number of entries, a power of 2 of at least 2.
+ *
+ * \par Overview
+ * AsyncFifo moves messages from enq, in the enq_clk domain, to deq, in the
+ * deq_clk domain. The enqueue thread owns the storage and the write pointer,
+ * the dequeue thread the read pointer. Each pointer crosses to the other
+ * domain in Gray code, through a two-stage synchronizer of the receiving
+ * thread, so that a pointer sampled in the middle of a change is off by at
+ * most one entry, on the safe side: the writer may see the FIFO full and the
+ * reader empty for two cycles longer than necessary, but never the reverse.
+ * - Each domain has its own active-low reset.
+ * - A message takes two to three deq_clk cycles to cross. To stream at the
+ *   rate of the slower clock, Depth must cover the round trip of the two
+ *   pointers, about three cycles of each clock; 8 entries are enough for
+ *   clock ratios of up to 2:1.
+ * - In C++ simulation the two threads run on their own sc_clock, and the
+ *   pointers and storage are sc_signals, so both the synchronizer delay and
+ *   the ordering of the two clocks are modeled.
+ *
+ * For HLS, AsyncFifo is a separate block per domain pair; the synchronizer
+ * stages must be constrained as such in the downstream flow.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <AsyncFifo.h>
+ *
+ *      AsyncFifo<Flit_t, 8> cdc;
+ *      cdc.enq_clk(noc_clk);
+ *      cdc.enq_rst(noc_rst);
+ *      cdc.deq_clk(tile_clk);
+ *      cdc.deq_rst(tile_rst);
+ *      cdc.enq(noc_to_tile);    // Combinational channel driven in noc_clk
+ *      cdc.deq(tile_in);        // Combinational channel read in tile_clk
+ * \endcode
+ * \par
+ *
+ */
+template <typename T, unsigned int Depth>
+class AsyncFifo : public sc_module {
+  SC_HAS_PROCESS(AsyncFifo);
+
+ public:
+  static const int kDebugLevel = 4;
+  static const unsigned int Width = Wrapped<T>::width;
+  static const unsigned int AddrWidth = nvhls::log2_ceil<Depth>::val;
+  static const unsigned int PtrWidth = AddrWidth + 1;
+
+  static_assert(Depth >= 2 && (1u << AddrWidth) == Depth, "AsyncFifo depth must be a power of 2 of at least 2");
+
+  typedef NVUINTW(PtrWidth) Ptr;
+
+  sc_in_clk enq_clk;
+  sc_in<bool> enq_rst;
+  sc_in_clk deq_clk;
+  sc_in<bool> deq_rst;
+
+  Connections::In<T> enq;
+  Connections::Out<T> deq;
+
+  AsyncFifo(sc_module_name name)
+      : sc_module(name),
+        enq_clk("enq_clk"),
+        enq_rst("enq_rst"),
+        deq_clk("deq_clk"),
+        deq_rst("deq_rst"),
+        enq("enq"),
+        deq("deq"),
+        wr_ptr_gray("wr_ptr_gray"),
+        rd_ptr_gray("rd_ptr_gray") {
+    SC_THREAD(EnqThread);
+    sensitive << enq_clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(enq_rst);
+
+    SC_THREAD(DeqThread);
+    sensitive << deq_clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(deq_rst);
+  }
+
+  static Ptr ToGray(Ptr bin) { return bin ^ (bin >> 1); }
+
+  // Pointers of a full FIFO differ in their two most significant Gray bits
+  static bool IsFull(Ptr wr_gray, Ptr rd_gray) {
+    Ptr top = Ptr(3) << (PtrWidth - 2);
+    return wr_gray == (rd_gray ^ top);
+  }
+
+ protected:
+  sc_signal<Ptr> wr_ptr_gray;
+  sc_signal<Ptr> rd_ptr_gray;
+  sc_signal<sc_lv<Width> > storage[Depth];
+
+  void EnqThread() {
+    enq.Reset();
+    Ptr wr_ptr = 0;
+    Ptr rd_sync0 = 0;
+    Ptr rd_sync1 = 0;
+    wr_ptr_gray.write(0);
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+      // Two-stage synchronizer of the read pointer
+      rd_sync1 = rd_sync0;
+      rd_sync0 = rd_ptr_gray.read();
+
+      if (!IsFull(ToGray(wr_ptr), rd_sync1)) {
+        T msg;
+        if (enq.PopNB(msg)) {
+          storage[wr_ptr.to_uint() & (Depth - 1)].write(TypeToBits<T>(msg));
+          wr_ptr++;
+          wr_ptr_gray.write(ToGray(wr_ptr));
+        }
+      }
+    }
+  }
+
+  void DeqThread() {
+    deq.Reset();
+    Ptr rd_ptr = 0;
+    Ptr wr_sync0 = 0;
+    Ptr wr_sync1 = 0;
+    T msg;
+    bool held = false;
+    rd_ptr_gray.write(0);
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+      // Two-stage synchronizer of the write pointer
+      wr_sync1 = wr_sync0;
+      wr_sync0 = wr_ptr_gray.read();
+
+      if (!held && ToGray(rd_ptr) != wr_sync1) {
+        msg = BitsToType<T>(storage[rd_ptr.to_uint() & (Depth - 1)].read());
+        rd_ptr++;
+        rd_ptr_gray.write(ToGray(rd_ptr));
+        held = true;
+      }
+      if (held) {
+        held = !deq.PushNB(msg);
+      }
+    }
+  }
+};
+
+/**
+ * \brief A Connections channel between two clock domains.
+ * \ingroup AsyncFifo
+ *
+ * \tparam T            Message type.
+ * \tparam Depth        Number of entries of the AsyncFifo, a power of 2 of at least 2.
+ *
+ * \par Overview
+ * AsyncChannel wraps an AsyncFifo between two Combinational channels, so that
+ * an Out<T> port whose thread runs on one clock and an In<T> port whose thread
+ * runs on another are connected the same way as through any other channel:
+ * bind the Out port to the channel's in, the In port to its out, and the four
+ * clock and reset ports to the two domains.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <AsyncFifo.h>
+ *
+ *      AsyncChannel<Flit_t, 8> noc_to_tile;
+ *      noc_to_tile.enq_clk(noc_clk);
+ *      noc_to_tile.enq_rst(noc_rst);
+ *      noc_to_tile.deq_clk(tile_clk);
+ *      noc_to_tile.deq_rst(tile_rst);
+ *      router.out_port[0](noc_to_tile.in);
+ *      tile.in_port(noc_to_tile.out);
+ * \endcode
+ * \par
+ *
+ */
+template <typename T, unsigned int Depth>
+class AsyncChannel : public sc_module {
+ public:
+  sc_in_clk enq_clk;
+  sc_in<bool> enq_rst;
+  sc_in_clk deq_clk;
+  sc_in<bool> deq_rst;
+
+  Connections::Combinational<T> in;
+  Connections::Combinational<T> out;
+
+  AsyncChannel(sc_module_name name)
+      : sc_module(name),
+        enq_clk("enq_clk"),
+        enq_rst("enq_rst"),
+        deq_clk("deq_clk"),
+        deq_rst("deq_rst"),
+        in("in"),
+        out("out"),
+        fifo("fifo") {
+    fifo.enq_clk(enq_clk);
+    fifo.enq_rst(enq_rst);
+    fifo.deq_clk(deq_clk);
+    fifo.deq_rst(deq_rst);
+    fifo.enq(in);
+    fifo.deq(out);
+  }
+
+ private:
+  AsyncFifo<T, Depth> fifo;
+};
+
+#endif
@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef CAM_H
+#define CAM_H
+
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <TypeToBits.h>
+#include <comptrees.h>
+#ifndef __SYNTHESIS__
+#include <unordered_map>
+#endif
+
+/**
+ * \brief CAM_NO_SIM_MAP define: Use the comparator array in C simulation.
+ * \ingroup CAM
+ *
+ * In C simulation a binary CAM whose keys have at most 64 bits finds keys
+ * through a hash map, and tracks LRU order with timestamps, instead of
+ * comparing every entry. Defining CAM_NO_SIM_MAP selects the synthesis view,
+ * for example to check it in C simulation.
+ */
+#if !defined(__SYNTHESIS__) && !defined(CAM_NO_SIM_MAP)
+#define CAM_SIM_MAP
+#endif
+
+/**
+ * \brief Content-addressable memory with optional ternary masks and LRU replacement
+ * \ingroup CAM
+ *
+ * \tparam KeyT             Key type
+ * \tparam ValT             Value type
+ * \tparam Entries          Number of entries
+ * \tparam Ternary          Store a care mask with each key (TCAM)
+ *
+ * \par Overview
+ * Every entry holds a key, a value and a valid bit. find() compares the key
+ * against all entries in parallel and PriEnc picks the lowest matching entry,
+ * so a lookup takes one cycle.
+ * - With Ternary, an entry matches a key when they agree on every bit set in
+ *   the entry's care mask; the lowest entry matching has priority, as in a
+ *   TCAM.
+ * - insert() overwrites the entry that holds the same key (and care mask),
+ *   else fills the lowest free entry, else evicts the least recently used
+ *   one. lookup() and insert() update the LRU order, find() does not. An
+ *   entry written with write() replaces any other entry with the same key,
+ *   so keys stay unique.
+ * - LRU order is a per-entry age counter: touching an entry zeroes its age
+ *   and ages every younger entry, and the victim is the one of age
+ *   Entries-1.
+ * - In C simulation, binary CAMs with keys of up to 64 bits look keys up in a
+ *   hash map (see CAM_NO_SIM_MAP). The results are the same.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <CAM.h>
+ *      ...
+ *      CAM<Addr_t, MshrIdx_t, 16> mshr_map;
+ *      ...
+ *      MshrIdx_t mshr;
+ *      if (!mshr_map.lookup(line_addr, mshr)) {
+ *        mshr_map.insert(line_addr, alloc_mshr());
+ *      }
+ *
+ *      // Longest prefix first: route entries ordered by priority
+ *      CAM<NVUINTW(32), Port_t, 8, true> routes;
+ *      routes.write(0, 0x0a000100, 0xffffff00, 1);   // 10.0.1.0/24
+ *      routes.write(1, 0x0a000000, 0xff000000, 2);   // 10.0.0.0/8
+ * \endcode
+ * \par
+ *
+ */
+template <typename KeyT, typename ValT, unsigned int Entries, bool Ternary = false>
+class CAM {
+ public:
+  static const unsigned int KeyWidth = Wrapped<KeyT>::width;
+  typedef NVUINTW(KeyWidth) KeyBits;
+  typedef NVUINTW(nvhls::index_width<Entries>::val) Index;
+  typedef NVUINTW(Entries) Mask;
+
+  CAM() { reset(); }
+
+  void reset() {
+    valid = 0;
+    #pragma hls_unroll yes
+    for (unsigned int i = 0; i < Entries; i++) {
+      age[i] = i;
+    }
+#ifdef CAM_SIM_MAP
+    sim_map.clear();
+    sim_tick = 0;
+    for (unsigned int i = 0; i < Entries; i++) {
+      sim_last_use[i] = 0;
+    }
+#endif
+  }
+
+  // Bit i is set when entry i matches key
+  Mask match(const KeyT& key) const {
+    KeyBits k = TypeToNVUINT<KeyT>(key);
+    Mask hits = 0;
+    #pragma hls_unroll yes
+    for (unsigned int i = 0; i < Entries; i++) {
+      KeyBits diff = keys[i] ^ k;
+      if (Ternary) {
+        diff = diff & care[i];
+      }
+      hits[i] = (valid[i] == 1) && (diff == 0);
+    }
+    return hits;
+  }
+
+  // Lowest entry matching key, without touching the LRU order
+  bool find(const KeyT& key, Index& idx) const {
+#ifdef CAM_SIM_MAP
+    if (kSimMap) {
+      typename SimMap::const_iterator it = sim_map.find(TypeToNVUINT<KeyT>(key).to_uint64());
+      if (it == sim_map.end()) {
+        return false;
+      }
+      idx = it->second;
+      return true;
+    }
+#endif
+    Mask hits = match(key);
+    if (hits == 0) {
+      return false;
+    }
+    idx = PriEnc<Mask, bool, Index, Entries>::val(hits, 1);
+    return true;
+  }
+
+  bool lookup(const KeyT& key, ValT& val, Index& idx) {
+    if (!find(key, idx)) {
+      return false;
+    }
+    touch(idx);
+    val = vals[idx];
+    return true;
+  }
+
+  bool lookup(const KeyT& key, ValT& val) {
+    Index idx;
+    return lookup(key, val, idx);
+  }
+
+  // Entry insert() fills next: the lowest free one, else the least recently used
+  Index victim() const {
+    Mask free = ~valid;
+    if (free != 0) {
+      return PriEnc<Mask, bool, Index, Entries>::val(free, 1);
+    }
+#ifdef CAM_SIM_MAP
+    if (kSimMap) {
+      unsigned int lru = 0;
+      for (unsigned int i = 1; i < Entries; i++) {
+        if (sim_last_use[i] < sim_last_use[lru]) {
+          lru = i;
+        }
+      }
+      return lru;
+    }
+#endif
+    Mask oldest = 0;
+    #pragma hls_unroll yes
+    for (unsigned int i = 0; i < Entries; i++) {
+      oldest[i] = (age[i] == Entries - 1);
+    }
+    return PriEnc<Mask, bool, Index, Entries>::val(oldest, 1);
+  }
+
+  Index insert(const KeyT& key, const ValT& val) { return insert(key, AllCare(), val); }
+
+  Index insert(const KeyT& key, const KeyBits& care_mask, const ValT& val) {
+    Index idx;
+    if (!find_exact(TypeToNVUINT<KeyT>(key), care_mask, idx)) {
+      idx = victim();
+    }
+    write(idx, key, care_mask, val);
+    return idx;
+  }
+
+  void write(Index idx, const KeyT& key, const ValT& val) { write(idx, key, AllCare(), val); }
+
+  // care_mask is ignored unless Ternary
+  void write(Index idx, const KeyT& key, const KeyBits& care_mask, const ValT& val) {
+    NVHLS_ASSERT_MSG(idx < Entries, "CAM index out of bounds");
+    KeyBits k = TypeToNVUINT<KeyT>(key);
+    KeyBits c = Ternary ? care_mask : AllCare();
+#ifdef CAM_SIM_MAP
+    if (kSimMap) {
+      unsigned long long hash_key = k.to_uint64();
+      typename SimMap::iterator it = sim_map.find(hash_key);
+      if (it != sim_map.end() && it->second != idx) {
+        valid[it->second] = 0;
+      }
+      if (valid[idx] == 1) {
+        sim_map.erase(keys[idx].to_uint64());
+      }
+      sim_map[hash_key] = idx;
+    }
+#endif
+    if (!kSimMap) {
+      #pragma hls_unroll yes
+      for (unsigned int i = 0; i < Entries; i++) {
+        if (valid[i] == 1 && keys[i] == k && care[i] == c) {
+          valid[i] = 0;
+        }
+      }
+    }
+    keys[idx] = k;
+    care[idx] = c;
+    vals[idx] = val;
+    valid[idx] = 1;
+    touch(idx);
+  }
+
+  bool remove(const KeyT& key) { return remove(key, AllCare()); }
+
+  bool remove(const KeyT& key, const KeyBits& care_mask) {
+    Index idx;
+    if (!find_exact(TypeToNVUINT<KeyT>(key), Ternary ? care_mask : AllCare(), idx)) {
+      return false;
+    }
+    invalidate(idx);
+    return true;
+  }
+
+  void invalidate(Index idx) {
+    NVHLS_ASSERT_MSG(idx < Entries, "CAM index out of bounds");
+#ifdef CAM_SIM_MAP
+    if (kSimMap && valid[idx] == 1) {
+      sim_map.erase(keys[idx].to_uint64());
+    }
+#endif
+    valid[idx] = 0;
+  }
+
+  bool is_valid(Index idx) const { return valid[idx] == 1; }
+  KeyT key_at(Index idx) const { return NVUINTToType<KeyT>(keys[idx]); }
+  KeyBits care_at(Index idx) const { return care[idx]; }
+  ValT value_at(Index idx) const { return vals[idx]; }
+  bool is_full() const { return valid == static_cast<Mask>(~Mask(0)); }
+
+ protected:
+  KeyBits keys[Entries];
+  KeyBits care[Entries];
+  ValT vals[Entries];
+  Mask valid;
+  Index age[Entries];
+
+#ifdef CAM_SIM_MAP
+  static const bool kSimMap = !Ternary && (KeyWidth <= 64);
+  typedef std::unordered_map<unsigned long long, unsigned int> SimMap;
+  SimMap sim_map;
+  unsigned long long sim_tick;
+  unsigned long long sim_last_use[Entries];
+#else
+  static const bool kSimMap = false;
+#endif
+
+  static KeyBits AllCare() {
+    KeyBits c = ~KeyBits(0);
+    return c;
+  }
+
+  // The entry holding exactly this key and care mask
+  bool find_exact(const KeyBits& k, const KeyBits& c, Index& idx) const {
+#ifdef CAM_SIM_MAP
+    if (kSimMap) {
+      typename SimMap::const_iterator it = sim_map.find(k.to_uint64());
+      if (it == sim_map.end()) {
+        return false;
+      }
+      idx = it->second;
+      return true;
+    }
+#endif
+    Mask hits = 0;
+    #pragma hls_unroll yes
+    for (unsigned int i = 0; i < Entries; i++) {
+      hits[i] = (valid[i] == 1) && (keys[i] == k) && (!Ternary || care[i] == c);
+    }
+    if (hits == 0) {
+      return false;
+    }
+    idx = PriEnc<Mask, bool, Index, Entries>::val(hits, 1);
+    return true;
+  }
+
+  void touch(Index idx) {
+#ifdef CAM_SIM_MAP
+    if (kSimMap) {
+      sim_last_use[idx] = ++sim_tick;
+      return;
+    }
+#endif
+    Index a = age[idx];
+    #pragma hls_unroll yes
+    for (unsigned int i = 0; i < Entries; i++) {
+      if (age[i] < a) {
+        age[i] = age[i] + 1;
+      }
+    }
+    age[idx] = 0;
+  }
+};
+
+#endif  // CAM_H
@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __COLLECTIVETREE_H__
+#define __COLLECTIVETREE_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_message.h>
+#include <nvhls_packed_marshaller.h>
+#include <nvhls_types.h>
+#include <nvhls_array.h>
+#include <nvhls_assert.h>
+#include <hls_globals.h>
+
+/**
+ * \brief Message of a collective operation on a CollectiveTree
+ * \ingroup CollectiveTree
+ *
+ * \tparam DataType         Type of the operand and of the result
+ *
+ * \par Overview
+ * Every tile sends one message per collective and receives the result in a
+ * message with the same op:
+ * - kBarrier: data is ignored; the result arrives once all tiles joined.
+ * - kSum, kMin, kMax: the sum (wrapping to DataType), minimum or maximum of
+ *   the data of all tiles.
+ * - kBroadcast: the bitwise OR of the data of all tiles. The source tile
+ *   sends its value and all other tiles send zero.
+ */
+template <typename DataType>
+class CollectiveMsg : public nvhls_message {
+ public:
+  enum {
+    kBarrier = 0,
+    kSum = 1,
+    kMin = 2,
+    kMax = 3,
+    kBroadcast = 4,
+    op_width = 3,
+    width = Wrapped<DataType>::width + op_width
+  };
+
+  DataType data;
+  NVUINTW(op_width) op;
+
+  CollectiveMsg() : data(0), op(kBarrier) {}
+  CollectiveMsg(const DataType& data_, unsigned int op_) : data(data_), op(op_) {}
+
+  /* Combines the operands of two tiles that joined the same collective. */
+  static DataType Combine(unsigned int op, const DataType& a, const DataType& b) {
+    DataType result;
+    switch (op) {
+      case kSum: result = a + b; break;
+      case kMin: result = (b < a) ? b : a; break;
+      case kMax: result = (a < b) ? b : a; break;
+      case kBroadcast: result = a | b; break;
+      default: result = 0; break;
+    }
+    return result;
+  }
+
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
+    m& data;
+    m& op;
+  }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    MarshallFields(m);
+  }
+};
+
+/**
+ * \brief Combining node of a CollectiveTree
+ * \ingroup CollectiveTree
+ *
+ * \tparam DataType         Type of the operand and of the result
+ * \tparam NumChildren      Number of child nodes or tiles
+ *
+ * \par Overview
+ * On the way up, the node waits for one message from each child, combines
+ * their operands with CollectiveMsg::Combine() and sends the partial result
+ * to its parent. On the way down, it forwards every result from the parent to
+ * all children, to each as soon as it has room, and takes the next result
+ * once all children took it. Both directions move one message per cycle, so
+ * collectives pipeline through the tree in order.
+ * - All children must join the same collective: a node asserts if their ops
+ *   differ.
+ * - The root of a tree has its out_up bound to its own in_down, which turns
+ *   the combined result around.
+ */
+template <typename DataType, int NumChildren>
+class CollectiveNode : public sc_module {
+ public:
+  typedef CollectiveMsg<DataType> Msg_t;
+  typedef NVUINTW(NumChildren) Mask;
+  static_assert(NumChildren >= 2, "A combining node needs at least 2 children");
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::In<Msg_t> in_up[NumChildren];
+  Connections::Out<Msg_t> out_up;
+  Connections::In<Msg_t> in_down;
+  Connections::Out<Msg_t> out_down[NumChildren];
+
+  SC_HAS_PROCESS(CollectiveNode);
+  CollectiveNode(sc_module_name name_)
+      : sc_module(name_), clk("clk"), rst("rst"), out_up("out_up"), in_down("in_down") {
+    SC_THREAD(process);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+ protected:
+  void process() {
+    #pragma hls_unroll yes
+    for (int i = 0; i < NumChildren; i++) {
+      in_up[i].Reset();
+      out_down[i].Reset();
+    }
+    out_up.Reset();
+    in_down.Reset();
+
+    Msg_t child_msg[NumChildren];
+    Mask joined = 0;
+    Msg_t up_msg;
+    bool up_valid = false;
+    Msg_t down_msg;
+    bool down_valid = false;
+    Mask sent = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      // Up: one message from every child, then a partial result
+      #pragma hls_unroll yes
+      for (int i = 0; i < NumChildren; i++) {
+        if (joined[i] == 0 && in_up[i].PopNB(child_msg[i])) {
+          joined[i] = 1;
+        }
+      }
+      if (!up_valid && joined == static_cast<Mask>(~Mask(0))) {
+        up_msg = child_msg[0];
+        #pragma hls_unroll yes
+        for (int i = 1; i < NumChildren; i++) {
+          NVHLS_ASSERT_MSG(child_msg[i].op == child_msg[0].op,
+                           "Children joined different collectives");
+          up_msg.data = Msg_t::Combine(up_msg.op, up_msg.data, child_msg[i].data);
+        }
+        up_valid = true;
+        joined = 0;
+      }
+      if (up_valid && out_up.PushNB(up_msg)) {
+        up_valid = false;
+      }
+
+      // Down: fork every result to all children
+      if (!down_valid) {
+        down_valid = in_down.PopNB(down_msg);
+        sent = 0;
+      }
+      if (down_valid) {
+        #pragma hls_unroll yes
+        for (int i = 0; i < NumChildren; i++) {
+          if (sent[i] == 0 && out_down[i].PushNB(down_msg)) {
+            sent[i] = 1;
+          }
+        }
+        if (sent == static_cast<Mask>(~Mask(0))) {
+          down_valid = false;
+        }
+      }
+    }
+  }
+};
+
+/**
+ * \brief Side-band network for barriers, reductions and broadcasts
+ * \ingroup CollectiveTree
+ *
+ * \tparam DataType         Type of the operand and of the result
+ * \tparam Radix            Children per CollectiveNode
+ * \tparam Levels           Levels of nodes, for Radix^Levels tiles
+ *
+ * \par Overview
+ * A CollectiveTree connects each tile of a NoC to a tree of CollectiveNodes
+ * next to the data network. A tile joins a collective by pushing a
+ * CollectiveMsg to in[tile] and receives the result from out[tile]:
+ * - Operands are combined at every node on the way to the root, and the
+ *   result is forked at every node on the way back, so a collective takes
+ *   about 2 * Levels + 1 cycles once the last tile joined, instead of a round
+ *   trip of polling messages per tile over the NoC.
+ * - Tiles may join the next collective before the result of the previous
+ *   one arrives; results come back in order.
+ * - A tile must pop its results, or the whole tree stalls.
+ * .
+ * Data that only one tile sends to many, without the other tiles joining, is
+ * a multicast, e.g. over WHVCMulticastRouter.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <CollectiveTree.h>
+ *
+ *      ...
+ *        typedef CollectiveTree<NVUINT32, 4, 2> Tree_t;   // 16 tiles
+ *        typedef Tree_t::Msg_t Msg_t;
+ *        Tree_t tree;
+ *        Connections::Combinational<Msg_t> in_chan[Tree_t::num_tiles];
+ *        Connections::Combinational<Msg_t> out_chan[Tree_t::num_tiles];
+ *
+ *        tree.clk(clk);
+ *        tree.rst(rst);
+ *        for (int t = 0; t < Tree_t::num_tiles; t++) {
+ *          tree.in[t](in_chan[t]);
+ *          tree.out[t](out_chan[t]);
+ *        }
+ *        ...
+ *        // In every tile: the maximum over all tiles
+ *        in_chan[tile].Push(Msg_t(value, Msg_t::kMax));
+ *        NVUINT32 max = out_chan[tile].Pop().data;
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename DataType, int Radix, int Levels>
+class CollectiveTree : public sc_module {
+  template <int L, int Dummy = 0>
+  struct Tiles {
+    enum { val = Radix * Tiles<L - 1>::val };
+  };
+  template <int Dummy>
+  struct Tiles<0, Dummy> {
+    enum { val = 1 };
+  };
+
+ public:
+  enum {
+    radix = Radix,
+    levels = Levels,
+    num_tiles = Tiles<Levels>::val,
+    // Nodes in heap order: the children of node n are n * Radix + 1 to
+    // n * Radix + Radix, and the last num_tiles / Radix nodes hold the tiles
+    num_nodes = (num_tiles - 1) / (Radix - 1),
+    first_leaf = num_nodes - num_tiles / Radix
+  };
+  static_assert(Radix >= 2, "A combining node needs at least 2 children");
+  static_assert(Levels >= 1, "A tree needs at least one level of nodes");
+
+  typedef CollectiveMsg<DataType> Msg_t;
+  typedef CollectiveNode<DataType, Radix> Node_t;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::In<Msg_t> in[num_tiles];
+  Connections::Out<Msg_t> out[num_tiles];
+
+  nvhls::nv_array<Node_t, num_nodes> node;
+
+  // Links between node n and its parent; up_chan[0] turns the root around
+  Connections::Combinational<Msg_t> up_chan[num_nodes];
+  Connections::Combinational<Msg_t> down_chan[num_nodes];
+
+  SC_HAS_PROCESS(CollectiveTree);
+  CollectiveTree(sc_module_name name_)
+      : sc_module(name_), clk("clk"), rst("rst"), node("node") {
+    for (int n = 0; n < num_nodes; n++) {
+      node[n].clk(clk);
+      node[n].rst(rst);
+      node[n].out_up(up_chan[n]);
+      node[n].in_down(n == 0 ? up_chan[0] : down_chan[n]);
+      for (int c = 0; c < Radix; c++) {
+        if (n < first_leaf) {
+          int child = n * Radix + 1 + c;
+          node[n].in_up[c](up_chan[child]);
+          node[n].out_down[c](down_chan[child]);
+        } else {
+          int tile = (n - first_leaf) * Radix + c;
+          node[n].in_up[c](in[tile]);
+          node[n].out_down[c](out[tile]);
+        }
+      }
+    }
+  }
+};
+
+#endif
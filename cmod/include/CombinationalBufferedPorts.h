@@ -22,26 +22,35 @@
 #define COMBINATIONAL_BUFFERED_PORTS_H_
 
 #include <nvhls_connections.h>
+#include <nvhls_port_stats.h>
 
 namespace Connections {
 
   template <typename Message, int BufferSizeRead = 1, int BufferSizeWrite = 1>
   class CombinationalBufferedPorts : public Combinational<Message> {
     typedef NVUINTW(nvhls::index_width<BufferSizeWrite+1>::val) AddressPlusOne;
+    typedef NVUINTW(nvhls::index_width<BufferSizeRead>::val) ReadAddress;
+    typedef NVUINTW(nvhls::index_width<BufferSizeRead+1>::val) ReadAddressPlusOne;
     FIFO<Message, BufferSizeRead> fifo_read;
     FIFO<Message, BufferSizeWrite> fifo_write;
+    match::PortStats stats_read;
+    match::PortStats stats_write;
 
   public:
     CombinationalBufferedPorts()
       : Combinational<Message>(),
       fifo_read(),
-      fifo_write()
+      fifo_write(),
+      stats_read(BufferSizeRead),
+      stats_write(BufferSizeWrite)
     {}
     
     explicit CombinationalBufferedPorts(const char* name)
       : Combinational<Message>(name),
       fifo_read(),
-      fifo_write()
+      fifo_write(),
+      stats_read(BufferSizeRead, (std::string(name) + "_read").c_str()),
+      stats_write(BufferSizeWrite, (std::string(name) + "_write").c_str())
     {}
     
     void ResetRead() {
@@ -63,13 +72,34 @@ namespace Connections {
 
     Message PeekRead() { return fifo_read.peek(); }
 
+    // Entry offset places behind the head, without popping (PeekRead(0) == PeekRead())
+    Message PeekRead(ReadAddress offset) { return fifo_read.peek_at(offset); }
+
+    ReadAddressPlusOne NumFilledRead() { return fifo_read.NumFilled(); }
+
+    // Pop num <= MaxN buffered messages into msgs[0..num-1] in one call
+    template <unsigned int MaxN>
+    void PopN(Message (&msgs)[MaxN], unsigned int num) { fifo_read.pop_n(msgs, num); }
+
+    // Read-side transfer statistics; see match::PortStats
+    match::PortStats& StatsRead() { return stats_read; }
+
     void TransferNBRead() {
-      if (!fifo_read.isFull()) {
+      bool full = fifo_read.isFull();
+      bool transferred = false;
+      if (!full) {
 	Message msg;
 	if (Combinational<Message>::PopNB(msg)) {
 	  fifo_read.push(msg);
+	  transferred = true;
 	}
       }
+#ifndef __SYNTHESIS__
+      if (stats_read.IsEnabled()) {
+	stats_read.Sample(fifo_read.NumFilled().to_uint(), transferred, full);
+	if (transferred) stats_read.Arrive();
+      }
+#endif
     }
     
     // Full
@@ -81,13 +111,29 @@ namespace Connections {
 
     void Push(const Message& msg) { fifo_write.push(msg); }
 
+    // Push msgs[0..num-1] in one call; num <= NumAvailableWrite()
+    template <unsigned int MaxN>
+    void PushN(const Message (&msgs)[MaxN], unsigned int num) { fifo_write.push_n(msgs, num); }
+
+    // Write-side transfer statistics; see match::PortStats
+    match::PortStats& StatsWrite() { return stats_write; }
+
     void TransferNBWrite() {
-      if (!fifo_write.isEmpty()) {
+      bool offered = !fifo_write.isEmpty();
+      bool transferred = false;
+      if (offered) {
 	Message msg = fifo_write.peek();
 	if (Combinational<Message>::PushNB(msg)) {
 	  fifo_write.pop();
+	  transferred = true;
 	}
       }
+#ifndef __SYNTHESIS__
+      if (stats_write.IsEnabled()) {
+	stats_write.Sample(fifo_write.NumFilled().to_uint(), transferred, offered && !transferred);
+	if (transferred) stats_write.Depart();
+      }
+#endif
     }
 
     // Overload these so we don't accidently call them
@@ -98,17 +144,22 @@ namespace Connections {
 
   template <typename Message, int BufferSizeRead>
   class CombinationalBufferedPorts <Message,BufferSizeRead,0> : public Combinational<Message> {
+    typedef NVUINTW(nvhls::index_width<BufferSizeRead>::val) ReadAddress;
+    typedef NVUINTW(nvhls::index_width<BufferSizeRead+1>::val) ReadAddressPlusOne;
     FIFO<Message, BufferSizeRead> fifo_read;
+    match::PortStats stats_read;
 
   public:
     CombinationalBufferedPorts()
       : Combinational<Message>(),
-      fifo_read()
+      fifo_read(),
+      stats_read(BufferSizeRead)
     {}
     
     explicit CombinationalBufferedPorts(const char* name)
       : Combinational<Message>(name),
-      fifo_read()
+      fifo_read(),
+      stats_read(BufferSizeRead, (std::string(name) + "_read").c_str())
     {}
 
     void ResetRead() {
@@ -125,13 +176,34 @@ namespace Connections {
 
     Message PeekRead() { return fifo_read.peek(); }
 
+    // Entry offset places behind the head, without popping (PeekRead(0) == PeekRead())
+    Message PeekRead(ReadAddress offset) { return fifo_read.peek_at(offset); }
+
+    ReadAddressPlusOne NumFilledRead() { return fifo_read.NumFilled(); }
+
+    // Pop num <= MaxN buffered messages into msgs[0..num-1] in one call
+    template <unsigned int MaxN>
+    void PopN(Message (&msgs)[MaxN], unsigned int num) { fifo_read.pop_n(msgs, num); }
+
+    // Read-side transfer statistics; see match::PortStats
+    match::PortStats& StatsRead() { return stats_read; }
+
     void TransferNBRead() {
-      if (!fifo_read.isFull()) {
+      bool full = fifo_read.isFull();
+      bool transferred = false;
+      if (!full) {
 	Message msg;
 	if (Combinational<Message>::PopNB(msg)) {
 	  fifo_read.push(msg);
+	  transferred = true;
 	}
       }
+#ifndef __SYNTHESIS__
+      if (stats_read.IsEnabled()) {
+	stats_read.Sample(fifo_read.NumFilled().to_uint(), transferred, full);
+	if (transferred) stats_read.Arrive();
+      }
+#endif
     }
     
     // Overload these so we don't accidently call them
@@ -142,16 +214,19 @@ namespace Connections {
   class CombinationalBufferedPorts<Message,0,BufferSizeWrite> : public Combinational<Message> {
     typedef NVUINTW(nvhls::index_width<BufferSizeWrite+1>::val) AddressPlusOne;
     FIFO<Message, BufferSizeWrite> fifo_write;
+    match::PortStats stats_write;
 
   public:
     CombinationalBufferedPorts()
       : Combinational<Message>(),
-      fifo_write()
+      fifo_write(),
+      stats_write(BufferSizeWrite)
     {}
     
     explicit CombinationalBufferedPorts(const char* name)
       : Combinational<Message>(name),
-      fifo_write()
+      fifo_write(),
+      stats_write(BufferSizeWrite, (std::string(name) + "_write").c_str())
     {}
 
     void ResetWrite() {
@@ -168,13 +243,29 @@ namespace Connections {
 
     void Push(const Message& msg) { fifo_write.push(msg); }
 
+    // Push msgs[0..num-1] in one call; num <= NumAvailableWrite()
+    template <unsigned int MaxN>
+    void PushN(const Message (&msgs)[MaxN], unsigned int num) { fifo_write.push_n(msgs, num); }
+
+    // Write-side transfer statistics; see match::PortStats
+    match::PortStats& StatsWrite() { return stats_write; }
+
     void TransferNBWrite() {
-      if (!fifo_write.isEmpty()) {
+      bool offered = !fifo_write.isEmpty();
+      bool transferred = false;
+      if (offered) {
 	Message msg = fifo_write.peek();
 	if (Combinational<Message>::PushNB(msg)) {
 	  fifo_write.pop();
+	  transferred = true;
 	}
       }
+#ifndef __SYNTHESIS__
+      if (stats_write.IsEnabled()) {
+	stats_write.Sample(fifo_write.NumFilled().to_uint(), transferred, offered && !transferred);
+	if (transferred) stats_write.Depart();
+      }
+#endif
     }
 
     // Overload these so we don't accidently call them
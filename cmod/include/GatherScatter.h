@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __GATHERSCATTER_H__
+#define __GATHERSCATTER_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_message.h>
+#include <nvhls_assert.h>
+#include <hls_globals.h>
+#include <fifo.h>
+#include <mem_array.h>
+#include <ReorderBuf.h>
+#include <ArbitratedScratchpad.h>
+
+/**
+ * \brief Gather and scatter of index vectors over an ArbitratedScratchpad
+ * \ingroup GatherScatter
+ *
+ * \tparam DataType         DataType of an entry
+ * \tparam CapacityInBytes  Capacity of the scratchpad
+ * \tparam NumLanes         Addresses per vector, the inputs of the scratchpad
+ * \tparam NumBanks         Number of banks of the scratchpad
+ * \tparam InputQueueLen    Length of the input queues of the scratchpad
+ * \tparam InFlight         Gathers in flight
+ * \tparam LaneQueueLen     Length of the issue queue of each lane (default: InFlight)
+ *
+ * \par Overview
+ * Takes a stream of index vectors, one cli_req_t each, on req_in: a LOAD
+ * gathers the entries of its valid lanes and a STORE scatters the data of
+ * its valid lanes. Every gather gets one cli_rsp_t on rsp_out, in the order
+ * of the gathers, with the valids of its request. Scatters get no response.
+ * - The lanes of an accepted vector go to an issue queue per lane, each of
+ *   which offers its head to its input of the scratchpad every cycle. A lane
+ *   that loses arbitration at a bank only holds back its own lane, so the
+ *   lanes of up to LaneQueueLen vectors are at the scratchpad at once and
+ *   bank conflicts are hidden behind the other requests.
+ * - A gather takes an id of a ReorderBuf. The lanes remember the id of
+ *   each load at the scratchpad, which answers the loads of a lane in
+ *   order. Once all lanes of a gather are back, one per cycle, its vector
+ *   moves to the ReorderBuf, which releases the vectors in order.
+ * - A vector of the other type than the vectors in the queues waits until
+ *   the queues and the scratchpad are empty. A gather thus sees all earlier
+ *   scatters, and a scatter never overtakes an earlier gather. Scatters of
+ *   one lane land in order; scatters of different lanes to one address in
+ *   flight at once land in any order.
+ * .
+ * A vector waits for room in the issue queues of its valid lanes, and a
+ * gather also for a free id.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <GatherScatter.h>
+ *
+ *      ...
+ *      typedef GatherScatter<NVUINT32, 4096, 8, 16, 4, 16> Engine;
+ *      Engine engine;
+ *      Connections::Combinational<Engine::req_t> req;
+ *      Connections::Combinational<Engine::rsp_t> rsp;
+ *
+ *      engine.clk(clk);
+ *      engine.rst(rst);
+ *      engine.req_in(req);
+ *      engine.rsp_out(rsp);
+ *      ...
+ *      // gather the entries at idx[0..7]
+ *      Engine::req_t vec;
+ *      vec.type.val = CLITYPE_T::LOAD;
+ *      for (int i = 0; i < 8; i++) {
+ *        vec.valids[i] = true;
+ *        vec.addr[i] = idx[i];
+ *      }
+ *      req.Push(vec);
+ *      ...
+ *      Engine::rsp_t vals = rsp.Pop();
+ * \endcode
+ * \par
+ *
+ */
+template <typename DataType, unsigned int CapacityInBytes,
+          unsigned int NumLanes, unsigned int NumBanks,
+          unsigned int InputQueueLen, unsigned int InFlight,
+          unsigned int LaneQueueLen = InFlight>
+class GatherScatter : public sc_module {
+ public:
+  typedef ArbitratedScratchpad<DataType, CapacityInBytes, NumLanes, NumBanks, InputQueueLen> Scratchpad;
+  typedef typename Scratchpad::req_t req_t;
+  typedef typename Scratchpad::rsp_t rsp_t;
+  typedef ReorderBuf<rsp_t, InFlight, InFlight> Rob;
+  typedef typename Rob::Id Id;
+  typedef NVUINTW(NumLanes) LaneMask;
+  typedef NVUINTW(InFlight) IdMask;
+  static const int addr_width = Scratchpad::addr_width;
+
+  // A lane of a vector waiting for the scratchpad
+  struct issue_t : public nvhls_message {
+    NVUINTW(addr_width) addr;
+    DataType data;
+    Id id;
+    static const int width = addr_width + Wrapped<DataType>::width + nvhls::index_width<InFlight>::val;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m& addr;
+      m& data;
+      m& id;
+    }
+  };
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::In<req_t> req_in;
+  Connections::Out<rsp_t> rsp_out;
+
+  SC_HAS_PROCESS(GatherScatter);
+  GatherScatter(sc_module_name name_)
+      : sc_module(name_),
+        clk("clk"),
+        rst("rst"),
+        req_in("req_in"),
+        rsp_out("rsp_out") {
+    SC_THREAD(process);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+ protected:
+  Scratchpad scratchpad;
+  Rob rob;
+  FIFO<issue_t, LaneQueueLen, NumLanes> issue_q;
+  // Ids of the loads of each lane at the scratchpad, oldest first
+  FIFO<Id, InFlight, NumLanes> load_ids;
+  // Gathered entries, bank = lane
+  typedef mem_array_sep<DataType, InFlight * NumLanes, NumLanes> Gathered;
+  Gathered gathered;
+
+  void process() {
+    req_in.Reset();
+    rsp_out.Reset();
+
+    scratchpad.reset();
+    rob.reset();
+    issue_q.reset();
+    load_ids.reset();
+    LaneMask lanes[InFlight];
+    LaneMask pending[InFlight];
+    #pragma hls_unroll yes
+    for (unsigned i = 0; i < InFlight; i++) {
+      lanes[i] = 0;
+      pending[i] = 0;
+    }
+    IdMask done = 0;
+    bool is_load = true;
+    req_t in_reg;
+    rsp_t out_reg;
+    bool in_valid = false;
+    bool out_valid = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      // One completed gather per cycle moves to the ReorderBuf
+      if (done != 0) {
+        Id id = nvhls::leading_ones<InFlight, IdMask, Id>(done);
+        rsp_t vec;
+        #pragma hls_unroll yes
+        for (unsigned l = 0; l < NumLanes; l++) {
+          vec.valids[l] = (lanes[id][l] == 1);
+          vec.data[l] = gathered.read(static_cast<typename Gathered::LocalIndex>(id), l);
+        }
+        rob.addResponse(id, vec);
+        done[static_cast<int>(id)] = 0;
+      }
+
+      if (!out_valid && rob.topResponseReady()) {
+        out_reg = rob.popResponse();
+        out_valid = true;
+      }
+      if (out_valid) {
+        out_valid = !rsp_out.PushNB(out_reg);
+      }
+
+      // The head of every issue queue goes to the scratchpad
+      req_t req;
+      req.type.val = is_load ? CLITYPE_T::LOAD : CLITYPE_T::STORE;
+      #pragma hls_unroll yes
+      for (unsigned l = 0; l < NumLanes; l++) {
+        req.valids[l] = !issue_q.isEmpty(l);
+        if (req.valids[l]) {
+          issue_t head = issue_q.peek(l);
+          req.addr[l] = head.addr;
+          req.data[l] = head.data;
+        }
+      }
+      rsp_t load_rsp;
+      bool ready[NumLanes];
+    #ifndef HLS_ALGORITHMICC
+      typename Scratchpad::bank_req_t bank_req[NumLanes];
+      typename Scratchpad::bank_sel_t bank_sel[NumLanes];
+      bool bank_req_valid[NumLanes];
+      scratchpad.compute_bank_request(req, bank_req, bank_sel, bank_req_valid);
+      scratchpad.load_store(bank_req, bank_sel, bank_req_valid, load_rsp, ready);
+    #else
+      scratchpad.load_store(req, load_rsp, ready);
+    #endif
+
+      #pragma hls_unroll yes
+      for (unsigned l = 0; l < NumLanes; l++) {
+        if (req.valids[l] && ready[l]) {
+          issue_t head = issue_q.pop(l);
+          if (is_load) {
+            load_ids.push(head.id, l);
+          }
+        }
+      }
+      // A load may be answered in the cycle it is accepted
+      #pragma hls_unroll yes
+      for (unsigned l = 0; l < NumLanes; l++) {
+        if (load_rsp.valids[l]) {
+          Id id = load_ids.pop(l);
+          gathered.write(static_cast<typename Gathered::LocalIndex>(id), l, load_rsp.data[l]);
+          pending[id][l] = 0;
+          if (pending[id] == 0) {
+            done[static_cast<int>(id)] = 1;
+          }
+        }
+      }
+
+      if (!in_valid) {
+        in_valid = req_in.PopNB(in_reg);
+      }
+      if (in_valid) {
+        bool in_load = (in_reg.type.val == CLITYPE_T::LOAD);
+        bool idle = scratchpad.request_xbar.isAllInputEmpty();
+        bool room = true;
+        #pragma hls_unroll yes
+        for (unsigned l = 0; l < NumLanes; l++) {
+          if (!issue_q.isEmpty(l)) {
+            idle = false;
+          }
+          if (in_reg.valids[l] && issue_q.isFull(l)) {
+            room = false;
+          }
+        }
+        if ((in_load == is_load || idle) && room && (!in_load || rob.canAcceptRequest())) {
+          is_load = in_load;
+          Id id = 0;
+          LaneMask valids = 0;
+          #pragma hls_unroll yes
+          for (unsigned l = 0; l < NumLanes; l++) {
+            valids[l] = in_reg.valids[l];
+          }
+          if (in_load) {
+            id = rob.addRequest();
+            lanes[id] = valids;
+            pending[id] = valids;
+            if (valids == 0) {
+              done[static_cast<int>(id)] = 1;
+            }
+          }
+          #pragma hls_unroll yes
+          for (unsigned l = 0; l < NumLanes; l++) {
+            if (in_reg.valids[l]) {
+              issue_t entry;
+              entry.addr = in_reg.addr[l];
+              entry.data = in_reg.data[l];
+              entry.id = id;
+              issue_q.push(entry, l);
+            }
+          }
+          in_valid = false;
+        }
+      }
+    }
+  }
+};
+
+#endif
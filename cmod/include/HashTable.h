@@ -0,0 +1,485 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __HASHTABLE_H__
+#define __HASHTABLE_H__
+
+#include <systemc.h>
+#include <hls_globals.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_module.h>
+#include <nvhls_connections.h>
+#include <nvhls_message.h>
+#include <nvhls_assert.h>
+#include <mem_array.h>
+
+/**
+ * \brief Exact-match hash table with d-ary cuckoo hashing and a stash
+ * \ingroup HashTable
+ *
+ * \tparam KeyWidth         Bitwidth of the keys
+ * \tparam ValWidth         Bitwidth of the values
+ * \tparam SetsPerBank      Entries per bank (power of two)
+ * \tparam NumHashes        Hash functions, one bank each (at least 2)
+ * \tparam StashEntries     Entries of the fully associative stash
+ * \tparam MaxKicks         Displacements before an entry goes to the stash
+ *
+ * \par Overview
+ * Every key k has one candidate entry in each of NumHashes banks of a
+ * mem_array_sep, at index h_b(k) of bank b, so all candidates are read in
+ * the same cycle. h_b folds the key to 32 bits with an H3 hash, the XOR of
+ * a fixed pseudo-random column for every key bit that is set, and keeps the
+ * upper bits of the fold times an odd constant. A small stash holds entries that
+ * found no room in the banks. Each Request on req_in gets one Response on
+ * rsp_out, in order, and requests are taken at one per cycle.
+ * - kLookup returns the value of the key, with hit set when it is present.
+ * - kInsert stores the value, replacing the value of the key when it is
+ *   present (hit set). A new key goes to a free candidate entry; if there is
+ *   none it takes the candidate of a pseudo-random bank, and the entry it
+ *   displaces is handed to the eviction engine. While the engine is busy
+ *   new keys with no free candidate go to the stash, and when the stash is
+ *   full they wait for the engine.
+ * - kErase removes the key, with hit set when it was present.
+ * - The eviction engine moves its entry to a free candidate, or else
+ *   displaces the candidate of another bank and carries on with that one,
+ *   in the cycles without a request. After MaxKicks displacements the entry
+ *   goes to the stash; if the stash is full the table is full, and inserts
+ *   of new keys with no free candidate fail (stored cleared) until a key is
+ *   erased. An erase also lets the engine move a stash entry back into the
+ *   banks.
+ * - Lookups also search the stash and the entry held by the engine, so
+ *   every key stored is found while it moves.
+ * - Stats through match::Module: lookups, lookup_hits, inserts,
+ *   insert_failures, stash_inserts and kicks; lookup_probe_<b> counts the
+ *   hits in bank b (NumHashes for the stash and the engine), kick_chain_<n>
+ *   the displacement chains of n kicks, and occupancy_<e> the requests that
+ *   found the table e/8 full.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <HashTable.h>
+ *
+ *      ...
+ *      typedef HashTable<48, 16, 1024, 4> FlowTable;   // 4096 entries
+ *      FlowTable flows;
+ *      ...
+ *      FlowTable::Request req;
+ *      req.op = FlowTable::kInsert;
+ *      req.key = flow_id;
+ *      req.val = queue;
+ *      req_in.Push(req);
+ *      stored &= rsp_out.Pop().stored;
+ *      ...
+ *      req.op = FlowTable::kLookup;
+ *      req.key = flow_id;
+ *      req_in.Push(req);
+ *      FlowTable::Response rsp = rsp_out.Pop();      // rsp.hit, rsp.val
+ * \endcode
+ * \par
+ *
+ */
+template <int KeyWidth, int ValWidth, int SetsPerBank, int NumHashes = 4,
+          int StashEntries = 4, int MaxKicks = 32>
+class HashTable : public match::Module {
+ public:
+  static const int kDebugLevel = 3;
+
+  static_assert((SetsPerBank & (SetsPerBank - 1)) == 0 && SetsPerBank >= 2,
+                "SetsPerBank must be a power of two");
+  static_assert(NumHashes >= 2, "Cuckoo hashing needs at least two hash functions");
+  static_assert(StashEntries >= 1, "The stash needs at least one entry");
+
+  enum { kLookup = 0, kInsert = 1, kErase = 2 };
+  static const int kCapacity = SetsPerBank * NumHashes + StashEntries;
+
+  typedef NVUINTW(KeyWidth) Key;
+  typedef NVUINTW(ValWidth) Val;
+  typedef NVUINTW(nvhls::index_width<kCapacity + 2>::val) Count;
+
+  struct Request : public nvhls_message {
+    NVUINTW(2) op;
+    Key key;
+    Val val;  // kInsert only
+    static const unsigned int width = 2 + KeyWidth + ValWidth;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m & op;
+      m & key;
+      m & val;
+    }
+  };
+
+  struct Response : public nvhls_message {
+    bool hit;     // The key was present
+    bool stored;  // kInsert: the value is in the table
+    Val val;      // kLookup: the value of the key
+    static const unsigned int width = 2 + ValWidth;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m & hit;
+      m & stored;
+      m & val;
+    }
+  };
+
+  Connections::In<Request> req_in;
+  Connections::Out<Response> rsp_out;
+
+ protected:
+  enum {
+    kIdxBits = nvhls::log2_ceil<SetsPerBank>::val,
+    kKickBins = MaxKicks + 1,
+    kOccupancyBins = 9,
+  };
+
+  // Entry: bit 0 valid, key above, value at the top
+  typedef NVUINTW(1 + KeyWidth + ValWidth) Entry;
+  typedef mem_array_sep<Entry, SetsPerBank * NumHashes, NumHashes> Table;
+  typedef NVUINTW(kIdxBits) Index;
+  typedef NVUINTW(32) Fold;
+  typedef NVUINTW(NumHashes) BankMask;
+  // NumHashes stands for no bank
+  typedef NVUINTW(nvhls::index_width<NumHashes + 1>::val) BankIdx;
+  typedef NVUINTW(StashEntries) StashMask;
+  typedef NVUINTW(nvhls::index_width<StashEntries>::val) StashIdx;
+  typedef NVUINTW(nvhls::index_width<MaxKicks + 1>::val) Kicks;
+
+  Table table;
+  Entry stash[StashEntries];
+
+  // Eviction engine
+  Entry ev_entry;
+  bool ev_valid;
+  bool ev_parked;  // Out of kicks with the stash full
+  BankIdx ev_bank;
+  Kicks ev_kicks;
+  bool stash_retry;
+  NVUINT16 lfsr;
+  Count occupancy;
+
+  match::StatHandle lookups_stat;
+  match::StatHandle lookup_hits_stat;
+  match::StatHandle inserts_stat;
+  match::StatHandle insert_failures_stat;
+  match::StatHandle stash_inserts_stat;
+  match::StatHandle kicks_stat;
+  match::StatHandle lookup_probe_stat;
+  match::StatHandle kick_chain_stat;
+  match::StatHandle occupancy_stat;
+
+ public:
+  SC_HAS_PROCESS(HashTable);
+  HashTable(sc_module_name name_)
+      : match::Module(name_),
+        req_in("req_in"),
+        rsp_out("rsp_out") {
+    lookups_stat = this->RegisterStat("lookups");
+    lookup_hits_stat = this->RegisterStat("lookup_hits");
+    inserts_stat = this->RegisterStat("inserts");
+    insert_failures_stat = this->RegisterStat("insert_failures");
+    stash_inserts_stat = this->RegisterStat("stash_inserts");
+    kicks_stat = this->RegisterStat("kicks");
+    lookup_probe_stat = this->RegisterStatIndexed("lookup_probe", NumHashes + 1);
+    kick_chain_stat = this->RegisterStatIndexed("kick_chain", kKickBins);
+    occupancy_stat = this->RegisterStatIndexed("occupancy", kOccupancyBins);
+
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  // Hash of bank b: an H3 fold of the key to 32 bits, then the upper bits of
+  // its product with an odd constant. The product mixes the fold, which is
+  // linear and so spreads dense key sets such as counters poorly.
+  static Index hash(unsigned b, const Key& key) {
+    Fold h = 0;
+    #pragma hls_unroll yes
+    for (int i = 0; i < KeyWidth; i++) {
+      if (key[i] == 1) {
+        h ^= static_cast<Fold>(hash_column(b, i) & 0xffffffffULL);
+      }
+    }
+    Fold prod = h * static_cast<Fold>((hash_column(b, KeyWidth) & 0xffffffffULL) | 1);
+    return nvhls::get_slc<kIdxBits>(prod, 32 - kIdxBits);
+  }
+
+ protected:
+  // Columns of the H3 matrices, from the splitmix64 finalizer
+  static constexpr unsigned long long mix3(unsigned long long z) { return z ^ (z >> 31); }
+  static constexpr unsigned long long mix2(unsigned long long z) {
+    return mix3((z ^ (z >> 27)) * 0x94d049bb133111ebULL);
+  }
+  static constexpr unsigned long long mix1(unsigned long long z) {
+    return mix2((z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL);
+  }
+  static constexpr unsigned long long hash_column(unsigned b, unsigned i) {
+    return mix1((b * KeyWidth + i + 1) * 0x9e3779b97f4a7c15ULL);
+  }
+
+  static Entry make_entry(const Key& key, const Val& val) {
+    Entry entry = 0;
+    entry[0] = 1;
+    entry = nvhls::set_slc(entry, key, 1);
+    return nvhls::set_slc(entry, val, 1 + KeyWidth);
+  }
+  static bool entry_valid(const Entry& entry) { return entry[0] == 1; }
+  static Key entry_key(const Entry& entry) { return nvhls::get_slc<KeyWidth>(entry, 1); }
+  static Val entry_val(const Entry& entry) { return nvhls::get_slc<ValWidth>(entry, 1 + KeyWidth); }
+  static bool entry_holds(const Entry& entry, const Key& key) {
+    return entry_valid(entry) && entry_key(entry) == key;
+  }
+
+  void reset_state() {
+    ev_entry = 0;
+    ev_valid = false;
+    ev_parked = false;
+    ev_bank = NumHashes;
+    ev_kicks = 0;
+    stash_retry = false;
+    lfsr = 0xACE1;
+    occupancy = 0;
+    #pragma hls_unroll yes
+    for (int s = 0; s < StashEntries; s++) {
+      stash[s] = 0;
+    }
+    for (int i = 0; i < SetsPerBank; i++) {
+      #pragma hls_unroll yes
+      for (int b = 0; b < NumHashes; b++) {
+        table.write(i, b, 0);
+      }
+    }
+  }
+
+  // Reads the candidates of key: the index and entry in every bank, then
+  // which of them are free and which holds the key
+  void probe(const Key& key, Index idx[NumHashes], Entry cand[NumHashes],
+             BankMask& free, BankMask& match) {
+    free = 0;
+    match = 0;
+    #pragma hls_unroll yes
+    for (int b = 0; b < NumHashes; b++) {
+      idx[b] = hash(b, key);
+      cand[b] = table.read(idx[b], b);
+      free[b] = !entry_valid(cand[b]);
+      match[b] = entry_holds(cand[b], key);
+    }
+  }
+
+  static BankIdx lowest(const BankMask& mask) {
+    BankIdx bank = 0;
+    #pragma hls_unroll yes
+    for (int b = NumHashes - 1; b >= 0; b--) {
+      if (mask[b] == 1) {
+        bank = b;
+      }
+    }
+    return bank;
+  }
+
+  static StashIdx lowest_slot(const StashMask& mask) {
+    StashIdx slot = 0;
+    #pragma hls_unroll yes
+    for (int s = StashEntries - 1; s >= 0; s--) {
+      if (mask[s] == 1) {
+        slot = s;
+      }
+    }
+    return slot;
+  }
+
+  // A pseudo-random bank other than avoid
+  BankIdx kick_bank(const BankIdx& avoid) {
+    BankIdx bank = lfsr % NumHashes;
+    if (bank == avoid) {
+      bank = (bank == NumHashes - 1) ? BankIdx(0) : BankIdx(bank + 1);
+    }
+    return bank;
+  }
+
+  // Ends a displacement chain of ev_kicks kicks
+  void end_chain(bool& req_wait) {
+    this->IncrStatIndexed(kick_chain_stat, ev_kicks);
+    ev_valid = false;
+    ev_parked = false;
+    req_wait = false;
+  }
+
+  void run() {
+    req_in.Reset();
+    rsp_out.Reset();
+    reset_state();
+
+    Request req;
+    bool req_valid = false;
+    bool req_wait = false;  // An insert waiting for the engine
+    Response rsp;
+    bool rsp_valid = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (rsp_valid && rsp_out.PushNB(rsp)) {
+        rsp_valid = false;
+      }
+      if (!req_valid) {
+        req_valid = req_in.PopNB(req);
+      }
+
+      // The stash, the engine's entry and the candidates of the request
+      // key, or else of the key the engine moves
+      bool try_req = req_valid && !rsp_valid && !req_wait;
+      Key key = try_req ? req.key : entry_key(ev_entry);
+      StashMask stash_free = 0;
+      StashMask stash_match = 0;
+      #pragma hls_unroll yes
+      for (int s = 0; s < StashEntries; s++) {
+        stash_free[s] = !entry_valid(stash[s]);
+        stash_match[s] = entry_holds(stash[s], key);
+      }
+      bool ev_match = ev_valid && entry_holds(ev_entry, key);
+      Index idx[NumHashes];
+      Entry cand[NumHashes];
+      BankMask free, match;
+      probe(key, idx, cand, free, match);
+
+      if (try_req) {
+        bool found = (match != 0) || (stash_match != 0) || ev_match;
+        BankIdx hit_bank = lowest(match);
+        StashIdx hit_slot = lowest_slot(stash_match);
+        Entry hit_entry = (match != 0) ? cand[hit_bank]
+                          : (stash_match != 0) ? stash[hit_slot] : ev_entry;
+        rsp.hit = found;
+        rsp.stored = false;
+        rsp.val = found ? entry_val(hit_entry) : Val(0);
+        bool served = true;
+
+        if (req.op == kLookup) {
+          this->IncrStat(lookups_stat);
+          if (found) {
+            this->IncrStat(lookup_hits_stat);
+            this->IncrStatIndexed(lookup_probe_stat, (match != 0) ? unsigned(hit_bank)
+                                                                  : unsigned(NumHashes));
+          }
+        } else if (req.op == kInsert) {
+          Entry entry = make_entry(req.key, req.val);
+          rsp.stored = true;
+          if (match != 0) {
+            table.write(idx[hit_bank], hit_bank, entry);
+          } else if (stash_match != 0) {
+            stash[hit_slot] = entry;
+          } else if (ev_match) {
+            ev_entry = entry;
+          } else if (free != 0) {
+            BankIdx bank = lowest(free);
+            table.write(idx[bank], bank, entry);
+            occupancy++;
+          } else if (!ev_valid) {
+            // Take the candidate of a random bank; its entry moves on
+            BankIdx bank = kick_bank(NumHashes);
+            table.write(idx[bank], bank, entry);
+            ev_entry = cand[bank];
+            ev_valid = true;
+            ev_bank = bank;
+            ev_kicks = 0;
+            occupancy++;
+          } else if (stash_free != 0) {
+            stash[lowest_slot(stash_free)] = entry;
+            this->IncrStat(stash_inserts_stat);
+            occupancy++;
+          } else if (ev_parked) {
+            rsp.stored = false;
+            this->IncrStat(insert_failures_stat);
+          } else {
+            // Wait for the engine to place its entry
+            served = false;
+            req_wait = true;
+          }
+          if (served) {
+            this->IncrStat(inserts_stat);
+          }
+        } else {
+          if (match != 0) {
+            table.write(idx[hit_bank], hit_bank, 0);
+          } else if (stash_match != 0) {
+            stash[hit_slot] = 0;
+          } else if (ev_match) {
+            end_chain(req_wait);
+          }
+          if (found) {
+            occupancy--;
+            stash_retry = true;
+            ev_parked = false;
+          }
+        }
+
+        if (served) {
+          this->IncrStatIndexed(occupancy_stat,
+                                (static_cast<unsigned>(occupancy) * 8) / kCapacity);
+          rsp_valid = true;
+          req_valid = false;
+        }
+      }
+
+      // Eviction engine, in the cycles without a request
+      if (!try_req) {
+        if (ev_valid && !ev_parked) {
+          if (free != 0) {
+            BankIdx bank = lowest(free);
+            table.write(idx[bank], bank, ev_entry);
+            end_chain(req_wait);
+          } else if (ev_kicks == MaxKicks) {
+            if (stash_free != 0) {
+              stash[lowest_slot(stash_free)] = ev_entry;
+              this->IncrStat(stash_inserts_stat);
+              end_chain(req_wait);
+            } else {
+              ev_parked = true;
+              req_wait = false;
+            }
+          } else {
+            BankIdx bank = kick_bank(ev_bank);
+            table.write(idx[bank], bank, ev_entry);
+            ev_entry = cand[bank];
+            ev_bank = bank;
+            ev_kicks++;
+            this->IncrStat(kicks_stat);
+          }
+        } else if (!ev_valid && stash_retry) {
+          // Give a stash entry another chance after an erase
+          stash_retry = false;
+          StashMask stash_used = ~stash_free;
+          if (stash_used != 0) {
+            StashIdx slot = lowest_slot(stash_used);
+            ev_entry = stash[slot];
+            stash[slot] = 0;
+            ev_valid = true;
+            ev_bank = NumHashes;
+            ev_kicks = 0;
+          }
+        }
+      }
+
+      lfsr = (lfsr >> 1) ^ (lfsr[0] ? NVUINT16(0xB400) : NVUINT16(0));
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __PACKETREORDER_H__
+#define __PACKETREORDER_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_packet.h>
+#include <nvhls_assert.h>
+#include <nvhls_flow_control.h>
+#include <hls_globals.h>
+#include <ReorderBuf.h>
+
+/**
+ * \brief Fields of packet_id used by PacketSequencer and PacketReorder
+ * \ingroup PacketReorder
+ *
+ * \tparam Packet_t         Packet type with a packet_id
+ * \tparam NumNodes         Number of endpoint codes
+ * \tparam Window           Packets in flight from each source to each destination
+ * \tparam IdLsb            packet_id bits below the fields, left to the NoC (default: 0)
+ *
+ * \par Overview
+ * The packet_id holds, from bit IdLsb up, the sequence number of the packet
+ * and then the code of its source. The IdLsb bits below, such as the VC of
+ * WHVCNoC, and the bits above are not touched.
+ */
+template <typename Packet_t, int NumNodes, int Window, int IdLsb = 0>
+struct PacketOrderId {
+  enum {
+    node_width = nvhls::index_width<NumNodes>::val,
+    seq_width = nvhls::index_width<Window>::val,
+    seq_lsb = IdLsb,
+    node_lsb = IdLsb + seq_width,
+  };
+  static_assert(Packet_t::packet_id_width >= node_lsb + node_width,
+                "packet_id must hold the sequence number and the source");
+  typedef NVUINTW(node_width) Node;
+  typedef NVUINTW(seq_width) Seq;
+  typedef NVUINTW(Packet_t::packet_id_width) PacketId;
+
+  static PacketId set(const PacketId& id, const Node& src, const Seq& seq) {
+    PacketId result = nvhls::set_slc(id, seq, seq_lsb);
+    return nvhls::set_slc(result, src, node_lsb);
+  }
+  static Node src(const PacketId& id) {
+    return nvhls::get_slc<node_width>(id, node_lsb);
+  }
+  static Seq seq(const PacketId& id) {
+    return nvhls::get_slc<seq_width>(id, seq_lsb);
+  }
+};
+
+/**
+ * \brief Numbers the packets of a source per destination, for PacketReorder
+ * \ingroup PacketReorder
+ *
+ * \tparam Packet_t         Packet type with a packet_id
+ * \tparam NumNodes         Number of endpoint codes
+ * \tparam Window           Packets in flight to each destination
+ * \tparam IdLsb            packet_id bits below the fields, left to the NoC (default: 0)
+ *
+ * \par Overview
+ * Sits between a source and its NoC input. Each packet gets the code of
+ * this node and the next sequence number of its destination in packet_id,
+ * see PacketOrderId. The destination is the dest field of the packet, the
+ * endpoint code the NoC is given, which must be below NumNodes.
+ * - At most Window packets to one destination are in flight: a packet
+ *   consumes a credit of its destination, and waits while there is none.
+ *   It also holds back the packets behind it.
+ * - The PacketReorder of the destination returns the credit once it has
+ *   delivered the packet, as the code of the destination on credit_in.
+ *   Credits must return on a path that does not wait for the packets, such
+ *   as a sideband or another network.
+ */
+template <typename Packet_t, int NumNodes, int Window, int IdLsb = 0>
+class PacketSequencer : public sc_module {
+ public:
+  typedef PacketOrderId<Packet_t, NumNodes, Window, IdLsb> Format;
+  typedef typename Format::Node Node;
+  typedef typename Format::Seq Seq;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  sc_in<Node> node;
+
+  Connections::In<Packet_t> in_packet;
+  Connections::Out<Packet_t> out_packet;
+  Connections::In<Node> credit_in;
+
+  SC_HAS_PROCESS(PacketSequencer);
+  PacketSequencer(sc_module_name name_)
+      : sc_module(name_),
+        clk("clk"),
+        rst("rst"),
+        node("node"),
+        in_packet("in_packet"),
+        out_packet("out_packet"),
+        credit_in("credit_in") {
+    SC_THREAD(process);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+ protected:
+  void process() {
+    in_packet.Reset();
+    out_packet.Reset();
+    credit_in.Reset();
+
+    CreditCounter<Window> credits[NumNodes];
+    Seq next_seq[NumNodes];
+    #pragma hls_unroll yes
+    for (int i = 0; i < NumNodes; i++) {
+      credits[i].reset();
+      next_seq[i] = 0;
+    }
+    Packet_t in_reg, out_reg;
+    bool in_valid = false;
+    bool out_valid = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      Node credit;
+      if (credit_in.PopNB(credit)) {
+        NVHLS_ASSERT_MSG(credit < NumNodes, "Credit from an unknown node");
+        credits[credit].release();
+      }
+
+      if (in_valid && !out_valid) {
+        NVHLS_ASSERT_MSG(in_reg.dest < NumNodes, "Destination out of range");
+        Node dst = in_reg.dest;
+        if (credits[dst].has()) {
+          credits[dst].consume();
+          out_reg = in_reg;
+          out_reg.packet_id = Format::set(in_reg.packet_id, node.read(), next_seq[dst]);
+          next_seq[dst] = (next_seq[dst] == Window - 1) ? Seq(0) : Seq(next_seq[dst] + 1);
+          out_valid = true;
+          in_valid = false;
+        }
+      }
+
+      if (out_valid) {
+        out_valid = !out_packet.PushNB(out_reg);
+      }
+      if (!in_valid) {
+        in_valid = in_packet.PopNB(in_reg);
+      }
+    }
+  }
+};
+
+/**
+ * \brief Puts the packets arriving at an endpoint back in order per source
+ * \ingroup PacketReorder
+ *
+ * \tparam Packet_t         Packet type with a packet_id
+ * \tparam NumNodes         Number of endpoint codes
+ * \tparam Window           Packets in flight from each source
+ * \tparam IdLsb            packet_id bits below the fields, left to the NoC (default: 0)
+ *
+ * \par Overview
+ * Sits between the NoC output of an endpoint and its sink, on a NoC whose
+ * sources go through a PacketSequencer. With adaptive routing, or packets
+ * of one source on several VCs, the packets of a source may overtake each
+ * other on the way; PacketReorder delivers them in the order the source
+ * sent them, with ReorderBufBySource.
+ * - Every source has Window entries, which the credits of PacketSequencer
+ *   keep from overflowing, so arriving packets never wait for room and the
+ *   NoC never backs up behind a missing packet.
+ * - Delivery picks round-robin among the sources whose next packet is
+ *   there, and sends the code of the source on credit_out at the same time.
+ *   A packet whose predecessors are all there is delivered the cycle after
+ *   it arrives.
+ * - Packets are delivered as they arrived, packet_id included.
+ *
+ * \par A Simple Example
+ * \code
+ *      typedef MeshNoC<4, 4, 2, 4, 64, 128, 8> NoC_t;
+ *      typedef NoC_t::Packet_t Packet_t;
+ *      // 16 nodes, 4 packets in flight per pair, above the VC bit
+ *      PacketSequencer<Packet_t, 16, 4, 1> sequencer[16];
+ *      PacketReorder<Packet_t, 16, 4, 1> reorder[16];
+ *      ...
+ *      sequencer[i].out_packet(noc_in[i]);
+ *      noc.in_packet[i](noc_in[i]);
+ *      noc.out_packet[i](noc_out[i]);
+ *      reorder[i].in_packet(noc_out[i]);
+ *      ...
+ *      // credits of reorder[i].credit_out go back to sequencer[src].credit_in as i
+ * \endcode
+ * \par
+ *
+ */
+template <typename Packet_t, int NumNodes, int Window, int IdLsb = 0>
+class PacketReorder : public sc_module {
+ public:
+  typedef PacketOrderId<Packet_t, NumNodes, Window, IdLsb> Format;
+  typedef typename Format::Node Node;
+  typedef ReorderBufBySource<Packet_t, NumNodes, Window> Rob;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::In<Packet_t> in_packet;
+  Connections::Out<Packet_t> out_packet;
+  Connections::Out<Node> credit_out;
+
+  SC_HAS_PROCESS(PacketReorder);
+  PacketReorder(sc_module_name name_)
+      : sc_module(name_),
+        clk("clk"),
+        rst("rst"),
+        in_packet("in_packet"),
+        out_packet("out_packet"),
+        credit_out("credit_out") {
+    SC_THREAD(process);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+ protected:
+  Rob rob;
+
+  void process() {
+    in_packet.Reset();
+    out_packet.Reset();
+    credit_out.Reset();
+
+    rob.reset();
+    Packet_t out_reg;
+    Node credit_reg = 0;
+    bool out_valid = false;
+    bool credit_valid = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!out_valid && !credit_valid && rob.topResponseReady()) {
+        typename Rob::Source src;
+        out_reg = rob.popResponse(src);
+        credit_reg = src;
+        out_valid = true;
+        credit_valid = true;
+      }
+
+      if (out_valid) {
+        out_valid = !out_packet.PushNB(out_reg);
+      }
+      if (credit_valid) {
+        credit_valid = !credit_out.PushNB(credit_reg);
+      }
+
+      // The window of a source has room for every packet it may send
+      Packet_t packet;
+      if (in_packet.PopNB(packet)) {
+        Node src = Format::src(packet.packet_id);
+        NVHLS_ASSERT_MSG(src < NumNodes, "Source out of range");
+        rob.addResponse(src, Format::seq(packet.packet_id), packet);
+      }
+    }
+  }
+};
+
+#endif
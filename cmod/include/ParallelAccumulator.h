@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __PARALLELACCUMULATOR_H__
+#define __PARALLELACCUMULATOR_H__
+
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <mem_array.h>
+#include <Arbiter.h>
+#include <one_hot_to_bin.h>
+
+/**
+ * \brief Histogram or accumulator bins updated by several lanes per cycle
+ * \ingroup ParallelAccumulator
+ *
+ * \tparam BinT             Type of a bin and of an increment
+ * \tparam Bins             Number of bins
+ * \tparam Lanes            Updates per cycle
+ * \tparam Copies           Private copies of the bins, a divisor of Lanes (default: Lanes)
+ *
+ * \par Overview
+ * The bins are kept in Copies sub-histograms, one bank of mem_array_sep
+ * each, and lane l updates copy l % Copies. read() returns the sum of a bin
+ * over all copies.
+ * - With Copies == Lanes every lane has its own copy, so update() takes all
+ *   lanes in every cycle and ready is always set.
+ * - With fewer copies, the lanes of one copy are merged: an Arbiter picks
+ *   the bin of one of them round-robin, and every lane updating that bin
+ *   is added in, in the same cycle. Lanes with other bins are not ready and
+ *   retry, so updates that agree on a bin cost nothing, and Copies trades
+ *   memory for throughput on spread-out bins.
+ * - Each copy does one read-modify-write per cycle. Its new value is
+ *   written one cycle later from a write-back register, which also serves
+ *   the next cycle's read of the same bin: back-to-back updates of one bin
+ *   never stall.
+ * .
+ * Each cycle either calls update(), or read() and clear(), which use the
+ * same bank ports. clear() zeroes one bin of every copy. Like any
+ * mem_array_sep, the bins are not initialized: clear them, one per cycle,
+ * before the first update.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <ParallelAccumulator.h>
+ *
+ *      ...
+ *      // 256 bins of 16 bits, 4 updates per cycle into 2 copies
+ *      typedef ParallelAccumulator<NVUINT16, 256, 4, 2> Hist;
+ *      Hist hist;
+ *      Hist::Bin bin[4];
+ *      NVUINT16 inc[4];
+ *      bool valid[4], ready[4];
+ *      ...
+ *      hist.update(bin, inc, valid, ready);
+ *      ...
+ *      NVUINT16 count = hist.read(5);
+ *      hist.clear(5);
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename BinT, unsigned int Bins, unsigned int Lanes,
+          unsigned int Copies = Lanes>
+class ParallelAccumulator {
+ public:
+  static_assert(Copies >= 1 && Lanes % Copies == 0,
+                "Copies must divide Lanes");
+  static const unsigned int LanesPerCopy = Lanes / Copies;
+
+  typedef NVUINTW(nvhls::index_width<Bins>::val) Bin;
+
+ protected:
+  typedef NVUINTW(LanesPerCopy) LaneMask;
+  typedef NVUINTW(nvhls::index_width<LanesPerCopy>::val) LaneIdx;
+  typedef typename mem_array_sep<BinT, Bins * Copies, Copies>::LocalIndex BinIdx;
+
+  mem_array_sep<BinT, Bins * Copies, Copies> copies;
+  Arbiter<LanesPerCopy> arbiter[Copies];
+
+  // Write-back register of each copy
+  bool wb_valid[Copies];
+  Bin  wb_bin[Copies];
+  BinT wb_data[Copies];
+
+  // The bin of a copy, from its write-back register when it is there
+  BinT read_copy(unsigned c, const Bin& bin) {
+    if (wb_valid[c] && (wb_bin[c] == bin)) {
+      return wb_data[c];
+    }
+    return copies.read(static_cast<BinIdx>(bin), c);
+  }
+
+  // Writes back the previous write of a copy and holds the new one
+  void write_copy(unsigned c, const Bin& bin, const BinT& data) {
+    if (wb_valid[c]) {
+      copies.write(static_cast<BinIdx>(wb_bin[c]), c, wb_data[c]);
+    }
+    wb_valid[c] = true;
+    wb_bin[c] = bin;
+    wb_data[c] = data;
+  }
+
+ public:
+  ParallelAccumulator() { reset(); }
+
+  // Clears the arbiters and drops pending writes; the bins keep their values
+  void reset() {
+    #pragma hls_unroll yes
+    for (unsigned c = 0; c < Copies; c++) {
+      arbiter[c].reset();
+      wb_valid[c] = false;
+    }
+  }
+
+  void update(const Bin bin[Lanes], const BinT inc[Lanes],
+              const bool valid[Lanes], bool ready[Lanes]) {
+    #pragma hls_unroll yes
+    for (unsigned c = 0; c < Copies; c++) {
+      LaneMask requests = 0;
+      #pragma hls_unroll yes
+      for (unsigned k = 0; k < LanesPerCopy; k++) {
+        NVHLS_ASSERT_MSG(!valid[c + k * Copies] || bin[c + k * Copies] < Bins,
+                         "Bin out of range");
+        requests[k] = valid[c + k * Copies];
+      }
+
+      // The bin of the picked lane, and every lane of the copy with it
+      LaneIdx pick = 0;
+      if (LanesPerCopy > 1 && requests != 0) {
+        LaneMask select = arbiter[c].pick(requests);
+        one_hot_to_bin<LanesPerCopy, nvhls::index_width<LanesPerCopy>::val>(select, pick);
+      }
+      Bin target = bin[c + pick.to_uint() * Copies];
+      BinT sum = 0;
+      #pragma hls_unroll yes
+      for (unsigned k = 0; k < LanesPerCopy; k++) {
+        unsigned lane = c + k * Copies;
+        ready[lane] = !valid[lane] || (bin[lane] == target);
+        if (valid[lane] && (bin[lane] == target)) {
+          sum = sum + inc[lane];
+        }
+      }
+
+      if (requests != 0) {
+        write_copy(c, target, read_copy(c, target) + sum);
+      }
+    }
+  }
+
+  // Sum of a bin over all copies
+  BinT read(const Bin& bin) {
+    NVHLS_ASSERT_MSG(bin < Bins, "Bin out of range");
+    BinT total = 0;
+    #pragma hls_unroll yes
+    for (unsigned c = 0; c < Copies; c++) {
+      total = total + read_copy(c, bin);
+    }
+    return total;
+  }
+
+  void clear(const Bin& bin) {
+    NVHLS_ASSERT_MSG(bin < Bins, "Bin out of range");
+    #pragma hls_unroll yes
+    for (unsigned c = 0; c < Copies; c++) {
+      write_copy(c, bin, 0);
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PINGPONG_BUFFER_H
+#define PINGPONG_BUFFER_H
+
+#include <systemc.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_message.h>
+#include <nvhls_module.h>
+#include <nvhls_connections.h>
+#include <mem_array.h>
+
+/**
+ * \brief Double (or N-) buffered memory between a producer and a consumer
+ * \ingroup PingPongBuffer
+ *
+ * \tparam T                Datatype of an entry
+ * \tparam Entries          Entries per buffer, across all banks
+ * \tparam Banks            Banks per buffer; a request moves one entry of every bank
+ * \tparam NumBuffers       Number of buffers: 2 for ping-pong, 3 for triple buffering
+ *
+ * \par Overview
+ * The buffers form a ring. The producer fills one buffer with wr_req while
+ * the consumer drains an earlier one with rd_req, each at one request per
+ * cycle, so that loading the next tile overlaps with computing on the
+ * current one at the full bandwidth of the banks.
+ * - The request of a side with last set is its swap handshake: the write
+ *   commits the buffer to the consumer, and the read returns it to the
+ *   producer. Each side then moves on to the next buffer of the ring.
+ * - wr_req is not accepted while every buffer is committed, nor rd_req while
+ *   none is, so either side simply waits for the other.
+ * - A write stores data[b] in bank b where bank_en[b] is set; a write with no
+ *   bank enabled only commits. A read returns every bank of an address, in
+ *   request order, with last echoed.
+ * - The producer and consumer never share a buffer, and each buffer has its
+ *   own banks, so the two sides never conflict.
+ *
+ * The module registers its PortStats as "buffers": occupancy_N counts the
+ * cycles with N committed buffers, transfers the commits, and stall_cycles
+ * the cycles the producer had no buffer to fill.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <PingPongBuffer.h>
+ *      ...
+ *      typedef PingPongBuffer<Elem_t, 256, 4> Buffer_t;  // 64 rows of 4 banks
+ *      Buffer_t tile_buf;
+ *      Connections::Combinational<Buffer_t::WriteReq> wr_req;
+ *      Connections::Combinational<Buffer_t::ReadReq> rd_req;
+ *      Connections::Combinational<Buffer_t::ReadRsp> rd_rsp;
+ *      ...
+ *      // DMA thread: one row per cycle, last row swaps
+ *      Buffer_t::WriteReq w;
+ *      w.addr = row;
+ *      w.bank_en = ~Buffer_t::BankMask(0);
+ *      w.last = (row == Buffer_t::EntriesPerBank - 1);
+ *      wr_req.Push(w);
+ * \endcode
+ * \par
+ *
+ */
+template <typename T, int Entries, int Banks = 1, int NumBuffers = 2>
+class PingPongBuffer : public match::Module {
+  SC_HAS_PROCESS(PingPongBuffer);
+
+ public:
+  static const int EntriesPerBank = Entries / Banks;
+  static const int AddrWidth = nvhls::index_width<EntriesPerBank>::val;
+  typedef NVUINTW(AddrWidth) Index;
+  typedef NVUINTW(Banks) BankMask;
+  typedef NVUINTW(nvhls::index_width<NumBuffers>::val) BufferIndex;
+  typedef NVUINTW(nvhls::index_width<NumBuffers + 1>::val) BufferCount;
+
+  class WriteReq : public nvhls_message {
+   public:
+    Index addr;
+    BankMask bank_en;
+    T data[Banks];
+    bool last;
+
+    static const unsigned int width = AddrWidth + Banks + Banks * Wrapped<T>::width + 1;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m & addr;
+      m & bank_en;
+      #pragma hls_unroll yes
+      for (unsigned int i = 0; i < Banks; i++) m & data[i];
+      m & last;
+    }
+  };
+
+  class ReadReq : public nvhls_message {
+   public:
+    Index addr;
+    bool last;
+
+    static const unsigned int width = AddrWidth + 1;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m & addr;
+      m & last;
+    }
+  };
+
+  class ReadRsp : public nvhls_message {
+   public:
+    T data[Banks];
+    bool last;
+
+    static const unsigned int width = Banks * Wrapped<T>::width + 1;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      #pragma hls_unroll yes
+      for (unsigned int i = 0; i < Banks; i++) m & data[i];
+      m & last;
+    }
+  };
+
+  Connections::In<WriteReq> wr_req;
+  Connections::In<ReadReq> rd_req;
+  Connections::Out<ReadRsp> rd_rsp;
+
+  PingPongBuffer(sc_module_name name)
+      : match::Module(name), wr_req("wr_req"), rd_req("rd_req"), rd_rsp("rd_rsp"),
+        stats_(NumBuffers) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    RegisterPortStats("buffers", stats_);
+  }
+
+  match::PortStats& Stats() { return stats_; }
+
+ protected:
+  // Bank b of buffer i is bank i * Banks + b
+  mem_array_sep<T, NumBuffers * Entries, NumBuffers * Banks> mem;
+  match::PortStats stats_;
+
+  static BufferIndex Next(BufferIndex i) { return (i == NumBuffers - 1) ? BufferIndex(0) : BufferIndex(i + 1); }
+
+  void run() {
+    wr_req.Reset();
+    rd_req.Reset();
+    rd_rsp.Reset();
+    BufferIndex prod = 0;
+    BufferIndex cons = 0;
+    BufferCount filled = 0;
+    ReadRsp rsp;
+    bool rsp_valid = false;
+
+    #pragma hls_pipeline_init_interval 1
+    while (1) {
+      wait();
+      bool can_write = (filled < NumBuffers);
+      bool can_read = (filled > 0) && !rsp_valid;
+
+      ReadReq r;
+      bool read = can_read && rd_req.PopNB(r);
+      if (read) {
+        #pragma hls_unroll yes
+        for (int b = 0; b < Banks; b++) {
+          rsp.data[b] = mem.read(r.addr, cons * Banks + b);
+        }
+        rsp.last = r.last;
+        rsp_valid = true;
+      }
+
+      WriteReq w;
+      bool wrote = can_write && wr_req.PopNB(w);
+      if (wrote) {
+        #pragma hls_unroll yes
+        for (int b = 0; b < Banks; b++) {
+          if (w.bank_en[b] == 1) {
+            mem.write(w.addr, prod * Banks + b, w.data[b]);
+          }
+        }
+      }
+
+      if (rsp_valid && rd_rsp.PushNB(rsp)) {
+        rsp_valid = false;
+      }
+
+      bool commit = wrote && w.last;
+      bool release = read && r.last;
+#ifndef __SYNTHESIS__
+      if (stats_.IsEnabled()) {
+        stats_.Sample(filled.to_uint(), commit, !can_write);
+      }
+#endif
+      if (commit) {
+        prod = Next(prod);
+      }
+      if (release) {
+        cons = Next(cons);
+      }
+      if (commit && !release) {
+        filled++;
+      } else if (release && !commit) {
+        filled--;
+      }
+    }
+  }
+};
+
+#endif  // PINGPONG_BUFFER_H
@@ -19,8 +19,11 @@
 
 #include <fifo.h>
 #include <nvhls_types.h>
+#include <nvhls_int.h>
 #include <mem_array.h>
 #include <nvhls_assert.h>
+#include <Arbiter.h>
+#include <one_hot_to_bin.h>
 
 /**
  * \brief Reorder Buffer that allows out-of-order writes to queue and in-order reads 
@@ -30,6 +33,12 @@
  * \tparam Depth            Depth of queue 
  * \tparam InFlight         Number of inflight entries
  *
+ * \par Overview
+ * Responses are released in the order of their requests. An id is free again
+ * as soon as its response arrives; free ids are found with a priority encoder
+ * (nvhls::leading_ones) over the id bitmap rather than a scan. See
+ * ReorderBufById for ordering within an AXI ID only.
+ *
  * \par A Simple Example
  * \code
  *      #include <ReorderBuf.h>
@@ -86,20 +95,30 @@ protected:
 
     typedef mem_array_sep<EntryNum, InFlight,1> Id2Entry;
     Id2Entry id2entry;
-    
+
+public:
+    static const int width = mem_array_sep<Data, Depth, 1>::width + VBits::width + InFlight + Id2Entry::width;
+
+    // All of the buffer state, e.g. for checkpoints
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+        m & storage;
+        m & vbits;
+        m & idrep;
+        m & id2entry;
+    }
+
+protected:
     bool get_next_avail_id(Id& id, IdRepository& id_repository)
     {
-        #pragma hls_unroll yes
-        for (int i=0; i<static_cast<int>(InFlight); ++i)
+        IdRepository free_ids = ~id_repository;
+        if (free_ids == 0)
         {
-            if (id_repository[i]==0) 
-            {
-                id = i;
-                id_repository[i]=1;
-                return true;
-            }
+            return false;
         }
-        return false;
+        id = nvhls::leading_ones<InFlight, IdRepository, Id>(free_ids);
+        id_repository[static_cast<int>(id)]=1;
+        return true;
     }
 
 public:
@@ -161,4 +180,564 @@ public:
     
 };
 
+
+/**
+ * \brief Reorder Buffer that releases responses in order within each AXI ID
+ * \ingroup ReorderBuffer
+ *
+ * \tparam Data             DataType
+ * \tparam Depth            Depth of queue
+ * \tparam InFlight         Number of inflight entries
+ * \tparam NumAxiIds        Number of AXI IDs
+ *
+ * \par Overview
+ * Same interface as ReorderBuf, except that addRequest() takes the AXI ID
+ * of the request and popResponse() may release any response whose older
+ * requests with the same AXI ID have been released. A slow response then
+ * only holds back the responses behind it on its own AXI ID.
+ * - Entries are allocated from a free bitmap and linked into one list per
+ *   AXI ID, so Depth entries are shared by all AXI IDs.
+ * - Among the AXI IDs whose oldest response is ready, popResponse() picks
+ *   one round-robin, and can return the AXI ID it picked.
+ * - Free ids and entries are found with a priority encoder.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <ReorderBuf.h>
+ *
+ *      ...
+ *      ReorderBufById<Data, 8, 4, 2> rob;
+ *      ReorderBufById<Data, 8, 4, 2>::AxiId axi_id;
+ *      if (rob.canAcceptRequest()) {
+ *        id = rob.addRequest(axi_id_of_request);
+ *      }
+ *      ...
+ *      rob.addResponse(id, data);
+ *      ...
+ *      if (rob.topResponseReady()) {
+ *        data = rob.popResponse(axi_id);
+ *      }
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+
+template <typename Data, unsigned int Depth, unsigned int InFlight,
+          unsigned int NumAxiIds>
+class ReorderBufById {
+
+public:
+    ReorderBufById() { reset(); }
+
+    typedef sc_uint<nvhls::index_width<InFlight>::val> Id;
+    typedef NVUINTW(nvhls::index_width<NumAxiIds>::val) AxiId;
+
+protected:
+    typedef NVUINTW(nvhls::index_width<Depth>::val) EntryNum;
+    typedef NVUINTW(InFlight) IdRepository;
+    typedef NVUINTW(Depth) EntryMask;
+    typedef NVUINTW(NumAxiIds) AxiIdMask;
+
+    mem_array_sep<Data, Depth, 1> storage;
+
+    IdRepository idrep;
+    EntryNum id2entry[InFlight];
+
+    // Entries in use, and those whose response has arrived
+    EntryMask used;
+    EntryMask ready;
+
+    // Per AXI ID list of entries, oldest first
+    EntryNum next_entry[Depth];
+    EntryNum head[NumAxiIds];
+    EntryNum tail[NumAxiIds];
+    AxiIdMask nonempty;
+
+    Arbiter<NumAxiIds> arbiter;
+
+    bool get_next_avail_id(Id& id, IdRepository& id_repository)
+    {
+        IdRepository free_ids = ~id_repository;
+        if (free_ids == 0)
+        {
+            return false;
+        }
+        id = nvhls::leading_ones<InFlight, IdRepository, Id>(free_ids);
+        id_repository[static_cast<int>(id)]=1;
+        return true;
+    }
+
+    // AXI IDs whose oldest response has arrived
+    AxiIdMask readyHeads()
+    {
+        AxiIdMask heads = 0;
+        #pragma hls_unroll yes
+        for (int i=0; i<static_cast<int>(NumAxiIds); ++i)
+        {
+            heads[i] = nonempty[i] && ready[static_cast<int>(head[i])];
+        }
+        return heads;
+    }
+
+public:
+    bool canAcceptRequest()
+    {
+        return ((idrep != static_cast<IdRepository>(~0)) &&
+                (used != static_cast<EntryMask>(~0)));
+    }
+
+    Id addRequest(const AxiId& axi_id)
+    {
+        Id id;
+        bool success = get_next_avail_id(id, idrep);
+        NVHLS_ASSERT_MSG(success, "get_next_avail_id unsuccessful");
+        NVHLS_ASSERT_MSG(axi_id < NumAxiIds, "AXI ID out of range");
+
+        EntryMask free_entries = ~used;
+        NVHLS_ASSERT_MSG(free_entries != 0, "No free entry");
+        EntryNum entry =
+            nvhls::leading_ones<Depth, EntryMask, EntryNum>(free_entries);
+        used[static_cast<int>(entry)] = 1;
+        ready[static_cast<int>(entry)] = 0;
+        id2entry[static_cast<int>(id)] = entry;
+
+        if (nonempty[static_cast<int>(axi_id)])
+        {
+            next_entry[static_cast<int>(tail[axi_id])] = entry;
+        } else {
+            head[axi_id] = entry;
+        }
+        tail[axi_id] = entry;
+        nonempty[static_cast<int>(axi_id)] = 1;
+
+        return id;
+    }
+
+    bool topResponseReady()
+    {
+        return (readyHeads() != 0);
+    }
+
+    void addResponse(const Id& id, const Data& data)
+    {
+        NVHLS_ASSERT_MSG(idrep[static_cast<int>(id)] == 1, "idrep[id]!=1");
+        EntryNum entry = id2entry[static_cast<int>(id)];
+        storage.write(entry, 0, data);
+        ready[static_cast<int>(entry)] = 1;
+        idrep[static_cast<int>(id)]=0;
+    }
+
+    Data popResponse(AxiId& axi_id)
+    {
+        AxiIdMask heads = readyHeads();
+        NVHLS_ASSERT_MSG(heads != 0, "topResponseNotReady");
+
+        AxiIdMask select = arbiter.pick(heads);
+        if (NumAxiIds > 1) {
+            one_hot_to_bin<NumAxiIds, nvhls::index_width<NumAxiIds>::val>(select, axi_id);
+        } else {
+            axi_id = 0;
+        }
+
+        EntryNum entry = head[axi_id];
+        Data result = storage.read(entry, 0);
+        used[static_cast<int>(entry)] = 0;
+        ready[static_cast<int>(entry)] = 0;
+        if (entry == tail[axi_id])
+        {
+            nonempty[static_cast<int>(axi_id)] = 0;
+        } else {
+            head[axi_id] = next_entry[static_cast<int>(entry)];
+        }
+
+        return result;
+    }
+
+    Data popResponse()
+    {
+        AxiId axi_id;
+        return popResponse(axi_id);
+    }
+
+    void reset()
+    {
+        idrep = 0;
+        used = 0;
+        ready = 0;
+        nonempty = 0;
+        arbiter.reset();
+    }
+
+    bool isEmpty()
+    {
+        return (used == 0);
+    }
+
+};
+
+
+/**
+ * \brief Reorder Buffer that takes and releases up to K responses per cycle
+ * \ingroup ReorderBuffer
+ *
+ * \tparam Data             DataType
+ * \tparam Depth            Depth of queue, a multiple of K
+ * \tparam InFlight         Number of inflight entries
+ * \tparam K                Responses written and read per call
+ *
+ * \par Overview
+ * Same ordering as ReorderBuf, but addResponses() writes up to K responses,
+ * one per response lane, and popResponses() drains up to K ready entries in
+ * request order in one call. Storage is split into K x K single-port banks:
+ * - Response lane w writes entry e into bank (w, e % K), so the lanes never
+ *   compete for a bank whatever ids they carry.
+ * - The K entries drained together are consecutive, hence in K different
+ *   banks e % K. The lane that wrote each entry is kept next to its valid
+ *   bit and selects the bank it is read from.
+ * .
+ * This costs K copies of the Depth entries of storage, instead of the K
+ * write ports per bank that arbitrary responses would otherwise need.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <ReorderBuf.h>
+ *
+ *      ...
+ *      typedef BankedReorderBuf<Data, 16, 8, 4> Rob;
+ *      Rob rob;
+ *      ...
+ *      if (rob.canAcceptRequest()) {
+ *        id = rob.addRequest();
+ *      }
+ *      ...
+ *      // up to 4 responses, one per lane
+ *      rob.addResponses(resp_ids, resp_data, resp_valid);
+ *      ...
+ *      Rob::Count n = rob.topResponsesReady();
+ *      rob.popResponses(out_data, n);
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+
+template <typename Data, unsigned int Depth, unsigned int InFlight,
+          unsigned int K>
+class BankedReorderBuf {
+
+public:
+    BankedReorderBuf() { reset(); }
+
+    typedef sc_uint<nvhls::index_width<InFlight>::val> Id;
+    typedef NVUINTW(K) LaneMask;
+    typedef NVUINTW(nvhls::index_width<K + 1>::val) Count;
+
+    static_assert(K >= 1 && Depth % K == 0, "Depth must be a multiple of K");
+
+protected:
+    typedef NVUINTW(nvhls::index_width<Depth>::val) EntryNum;
+    typedef NVUINTW(nvhls::index_width<Depth + 1>::val) EntryCount;
+    typedef NVUINTW(nvhls::index_width<K>::val) Lane;
+    typedef NVUINTW(InFlight) IdRepository;
+    typedef NVUINTW(Depth) EntryMask;
+
+    // Bank w * K + b holds the entries e with e % K == b written by lane w,
+    // at row e / K
+    typedef mem_array_sep<Data, Depth * K, K * K> Storage;
+    Storage storage;
+
+    IdRepository idrep;
+    EntryNum id2entry[InFlight];
+
+    // Response arrived, and the lane that wrote it
+    EntryMask valid;
+    Lane lane[Depth];
+
+    // Entries in use form a ring from head
+    EntryNum head;
+    EntryNum tail;
+    EntryCount count;
+
+    bool get_next_avail_id(Id& id, IdRepository& id_repository)
+    {
+        IdRepository free_ids = ~id_repository;
+        if (free_ids == 0)
+        {
+            return false;
+        }
+        id = nvhls::leading_ones<InFlight, IdRepository, Id>(free_ids);
+        id_repository[static_cast<int>(id)]=1;
+        return true;
+    }
+
+    static EntryNum entryAt(EntryNum entry, unsigned int offset)
+    {
+        unsigned int e = entry.to_uint() + offset;
+        return (e >= Depth) ? (e - Depth) : e;
+    }
+
+public:
+    bool canAcceptRequest()
+    {
+        return ((idrep != static_cast<IdRepository>(~0)) && (count != Depth));
+    }
+
+    Id addRequest()
+    {
+        Id id;
+        bool success = get_next_avail_id(id, idrep);
+        NVHLS_ASSERT_MSG(success, "get_next_avail_id unsuccessful");
+        NVHLS_ASSERT_MSG(count != Depth, "Reorder buffer is full");
+
+        id2entry[static_cast<int>(id)] = tail;
+        valid[static_cast<int>(tail)] = 0;
+        tail = entryAt(tail, 1);
+        count++;
+
+        return id;
+    }
+
+    // Response lane w carries id[w] and data[w] if mask[w] is set; the ids
+    // must be distinct
+    void addResponses(const Id id[K], const Data data[K], LaneMask mask)
+    {
+        #pragma hls_unroll yes
+        for (int w=0; w<static_cast<int>(K); ++w)
+        {
+            if (mask[w])
+            {
+                NVHLS_ASSERT_MSG(idrep[static_cast<int>(id[w])] == 1, "idrep[id]!=1");
+                EntryNum entry = id2entry[static_cast<int>(id[w])];
+                storage.write(entry / K, w * K + entry % K, data[w]);
+                valid[static_cast<int>(entry)] = 1;
+                lane[static_cast<int>(entry)] = w;
+                idrep[static_cast<int>(id[w])] = 0;
+            }
+        }
+    }
+
+    void addResponse(const Id& id, const Data& data)
+    {
+        Id ids[K];
+        Data datas[K];
+        ids[0] = id;
+        datas[0] = data;
+        addResponses(ids, datas, 1);
+    }
+
+    // Number of ready entries at the head, up to K
+    Count topResponsesReady()
+    {
+        Count ready = 0;
+        bool stop = false;
+        #pragma hls_unroll yes
+        for (int j=0; j<static_cast<int>(K); ++j)
+        {
+            EntryNum entry = entryAt(head, j);
+            if (!stop && j < count && valid[static_cast<int>(entry)])
+            {
+                ready = j + 1;
+            } else {
+                stop = true;
+            }
+        }
+        return ready;
+    }
+
+    bool topResponseReady()
+    {
+        return (topResponsesReady() != 0);
+    }
+
+    // Drain the n oldest entries into data[0] .. data[n-1]
+    void popResponses(Data data[K], Count n)
+    {
+        NVHLS_ASSERT_MSG(n <= topResponsesReady(), "topResponsesNotReady");
+        #pragma hls_unroll yes
+        for (int j=0; j<static_cast<int>(K); ++j)
+        {
+            if (j < n)
+            {
+                EntryNum entry = entryAt(head, j);
+                data[j] = storage.read(entry / K,
+                                       lane[static_cast<int>(entry)] * K + entry % K);
+                valid[static_cast<int>(entry)] = 0;
+            }
+        }
+        head = entryAt(head, n);
+        count -= n;
+    }
+
+    Data popResponse()
+    {
+        Data data[K];
+        popResponses(data, 1);
+        return data[0];
+    }
+
+    void reset()
+    {
+        idrep = 0;
+        valid = 0;
+        head = 0;
+        tail = 0;
+        count = 0;
+    }
+
+    bool isEmpty()
+    {
+        return (count == 0);
+    }
+
+};
+
+
+/**
+ * \brief Reorder Buffer that releases responses in sequence order within each source
+ * \ingroup ReorderBuffer
+ *
+ * \tparam Data             DataType
+ * \tparam NumSources       Number of sources
+ * \tparam Window           Sequence numbers in flight per source
+ *
+ * \par Overview
+ * Unlike ReorderBuf, the ids are not handed out by this buffer: each source
+ * numbers its responses 0, 1, ..., Window-1, 0, ... by itself, and
+ * addResponse() files a response under its source and sequence number.
+ * popResponse() releases the responses of each source in sequence order.
+ * - Every source has Window entries, indexed by sequence number, so a
+ *   source must not have more than Window responses in flight, i.e. it may
+ *   send sequence number n + Window only once n has been popped.
+ * - Among the sources whose next response has arrived, popResponse() picks
+ *   one round-robin, and can return the source it picked.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <ReorderBuf.h>
+ *
+ *      ...
+ *      ReorderBufBySource<Data, 4, 8> rob;
+ *      ReorderBufBySource<Data, 4, 8>::Source src;
+ *      ...
+ *      rob.addResponse(src_of_response, seq_of_response, data);
+ *      ...
+ *      if (rob.topResponseReady()) {
+ *        data = rob.popResponse(src);
+ *      }
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+
+template <typename Data, unsigned int NumSources, unsigned int Window>
+class ReorderBufBySource {
+
+public:
+    ReorderBufBySource() { reset(); }
+
+    typedef NVUINTW(nvhls::index_width<NumSources>::val) Source;
+    typedef NVUINTW(nvhls::index_width<Window>::val) Seq;
+
+protected:
+    static const unsigned int Depth = NumSources * Window;
+    typedef NVUINTW(Depth) EntryMask;
+    typedef NVUINTW(NumSources) SourceMask;
+    typedef typename mem_array_sep<Data, Depth, 1>::LocalIndex EntryNum;
+
+    mem_array_sep<Data, Depth, 1> storage;
+
+    // Entries whose response has arrived, and the next sequence number of
+    // each source
+    EntryMask valid;
+    Seq expected[NumSources];
+
+    Arbiter<NumSources> arbiter;
+
+    static EntryNum entryOf(const Source& src, const Seq& seq)
+    {
+        return static_cast<EntryNum>(src * Window + seq);
+    }
+
+    // Sources whose next response has arrived
+    SourceMask readyHeads()
+    {
+        SourceMask heads = 0;
+        #pragma hls_unroll yes
+        for (int i=0; i<static_cast<int>(NumSources); ++i)
+        {
+            heads[i] = valid[static_cast<int>(entryOf(i, expected[i]))];
+        }
+        return heads;
+    }
+
+public:
+    bool canAcceptResponse(const Source& src, const Seq& seq)
+    {
+        return (valid[static_cast<int>(entryOf(src, seq))] == 0);
+    }
+
+    void addResponse(const Source& src, const Seq& seq, const Data& data)
+    {
+        NVHLS_ASSERT_MSG(src < NumSources, "Source out of range");
+        NVHLS_ASSERT_MSG(seq < Window, "Sequence number out of range");
+        NVHLS_ASSERT_MSG(canAcceptResponse(src, seq), "Sequence number already in flight");
+        EntryNum entry = entryOf(src, seq);
+        storage.write(entry, 0, data);
+        valid[static_cast<int>(entry)] = 1;
+    }
+
+    bool topResponseReady()
+    {
+        return (readyHeads() != 0);
+    }
+
+    Data popResponse(Source& src)
+    {
+        SourceMask heads = readyHeads();
+        NVHLS_ASSERT_MSG(heads != 0, "topResponseNotReady");
+
+        SourceMask select = arbiter.pick(heads);
+        if (NumSources > 1) {
+            one_hot_to_bin<NumSources, nvhls::index_width<NumSources>::val>(select, src);
+        } else {
+            src = 0;
+        }
+
+        EntryNum entry = entryOf(src, expected[src]);
+        Data result = storage.read(entry, 0);
+        valid[static_cast<int>(entry)] = 0;
+        expected[src] = (expected[src] == Window - 1) ? Seq(0) : Seq(expected[src] + 1);
+
+        return result;
+    }
+
+    Data popResponse()
+    {
+        Source src;
+        return popResponse(src);
+    }
+
+    void reset()
+    {
+        valid = 0;
+        #pragma hls_unroll yes
+        for (int i=0; i<static_cast<int>(NumSources); ++i)
+        {
+            expected[i] = 0;
+        }
+        arbiter.reset();
+    }
+
+    bool isEmpty()
+    {
+        return (valid == 0);
+    }
+
+};
+
 #endif
@@ -0,0 +1,447 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __RINGNOC_H__
+#define __RINGNOC_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_packet.h>
+#include <nvhls_serdes.h>
+#include <nvhls_array.h>
+#include <nvhls_assert.h>
+#include <nvhls_flow_control.h>
+#include <hls_globals.h>
+#include <fifo.h>
+#include <Arbiter.h>
+
+/**
+ * \brief Router of one stop of a unidirectional wormhole ring
+ * \ingroup RingNoC
+ *
+ * \tparam Flit_t           WormHole flit type with a packet_id
+ * \tparam NumStops         Number of stops on the ring
+ * \tparam BufferSize       Entries of the ring input buffer
+ * \tparam MaxPacketFlits   Most flits of a packet, header included
+ *
+ * \par Overview
+ * A ring stop has a ring input and output, and a local inject and eject
+ * port. The header flit holds the number of the destination stop in the
+ * LSBs of its data, as the WormHole serializer places a packet's dest.
+ * - A flit that enters the stop is forwarded or ejected in the same cycle
+ *   if its output is free, so a hop takes one cycle. Flits wait in the ring
+ *   input buffer only while their output is busy.
+ * - Ring traffic has priority over injection: a new packet is injected only
+ *   when no ring packet is waiting for the output. Once a packet has the
+ *   output, its flits stay together until its tail.
+ * - The ring output is credit flow controlled against the input buffer of
+ *   the next stop. A new packet is injected only when the next stop has room
+ *   for all of it plus one more flit, the bubble of bubble flow control:
+ *   injection can never fill the ring, and forwarding needs only one credit,
+ *   so the ring keeps moving and is free of deadlock as long as every eject
+ *   port keeps draining.
+ */
+template <typename Flit_t, int NumStops, int BufferSize, int MaxPacketFlits>
+class RingStop : public sc_module {
+ public:
+  enum {
+    num_stops = NumStops,
+    stop_width = nvhls::index_width<NumStops>::val,
+  };
+  static_assert(BufferSize >= MaxPacketFlits + 1,
+                "The ring buffer must hold a packet and a bubble");
+  typedef NVUINTW(stop_width) Stop_t;
+  typedef NVUINTW(1) Credit_ret_t;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  sc_in<Stop_t> stop_id;
+
+  Connections::In<Flit_t> in_ring;
+  Connections::Out<Flit_t> out_ring;
+  Connections::In<Credit_ret_t> in_credit;
+  Connections::Out<Credit_ret_t> out_credit;
+
+  Connections::In<Flit_t> in_local;
+  Connections::Out<Flit_t> out_local;
+
+  SC_HAS_PROCESS(RingStop);
+  RingStop(sc_module_name name_)
+      : sc_module(name_),
+        clk("clk"),
+        rst("rst"),
+        stop_id("stop_id"),
+        in_ring("in_ring"),
+        out_ring("out_ring"),
+        in_credit("in_credit"),
+        out_credit("out_credit"),
+        in_local("in_local"),
+        out_local("out_local") {
+    SC_THREAD(process);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  static Stop_t dest(const Flit_t& flit) { return nvhls::get_slc<stop_width>(flit.data, 0); }
+
+ protected:
+  enum { kFree = 0, kRing = 1, kLocal = 2 };
+
+  void process() {
+    in_ring.Reset();
+    out_ring.Reset();
+    in_credit.Reset();
+    out_credit.Reset();
+    in_local.Reset();
+    out_local.Reset();
+
+    FIFO<Flit_t, BufferSize> ring_fifo;
+    CreditCounter<BufferSize> credits;
+    NVUINTW(nvhls::index_width<BufferSize + 1>::val) credit_send = 0;
+    NVUINTW(2) owner = kFree;   // Packet holding the ring output
+    bool ejecting = false;      // The packet at the buffer head is ejected
+    Flit_t local_flit;
+    bool local_valid = false;
+    ring_fifo.reset();
+    credits.reset();
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      Credit_ret_t credit_in;
+      if (in_credit.PopNB(credit_in)) {
+        credits.release();
+      }
+
+      // The upstream stop only sends with a credit, so there is room
+      Flit_t flit_in;
+      if (in_ring.PopNB(flit_in)) {
+        NVHLS_ASSERT_MSG(!ring_fifo.isFull(), "Ring flit without a credit");
+        ring_fifo.push(flit_in);
+      }
+      if (!local_valid) {
+        local_valid = in_local.PopNB(local_flit);
+      }
+
+      bool ring_head = !ring_fifo.isEmpty();
+      Flit_t head;
+      bool eject = false;
+      if (ring_head) {
+        head = ring_fifo.peek();
+        eject = head.flit_id.isHeader() ? (dest(head) == stop_id.read()) : ejecting;
+      }
+      bool forward = ring_head && !eject;
+
+      // One flit on the ring output: the ring packet, or the local one
+      // when no ring packet waits, with room for it and a bubble
+      bool send_ring = forward && owner != kLocal && credits.has();
+      bool send_local = local_valid &&
+                        ((owner == kLocal && credits.has()) ||
+                         (owner == kFree && !forward && local_flit.flit_id.isHeader() &&
+                          credits.has(MaxPacketFlits + 1)));
+      if (send_ring || send_local) {
+        Flit_t flit_out = send_ring ? head : local_flit;
+        if (out_ring.PushNB(flit_out)) {
+          credits.consume();
+          owner = flit_out.flit_id.isTail() ? kFree : (send_ring ? kRing : kLocal);
+          if (send_ring) {
+            ring_fifo.incrHead();
+            credit_send++;
+          } else {
+            local_valid = false;
+          }
+        }
+      }
+
+      if (ring_head && eject) {
+        if (out_local.PushNB(head)) {
+          ring_fifo.incrHead();
+          credit_send++;
+          ejecting = !head.flit_id.isTail();
+        }
+      }
+
+      if (credit_send > 0) {
+        if (out_credit.PushNB(1)) {
+          credit_send--;
+        }
+      }
+    }
+  }
+};
+
+/**
+ * \brief Endpoint of a RingNoC stop
+ * \ingroup RingNoC
+ *
+ * \tparam Packet_t         Packet type of the NoC
+ * \tparam Flit_t           Flit type of the NoC
+ * \tparam NumStops         Number of stops
+ * \tparam NumRings         1 for a unidirectional ring, 2 for a bidirectional one
+ *
+ * \par Overview
+ * Serializes the packets of the endpoint onto the ring with the shorter way
+ * to their destination stop, ring 1 running opposite to ring 0 and taken on
+ * a tie only when it is shorter, and deserializes the packets ejected from
+ * each ring, merging them round-robin.
+ */
+template <typename Packet_t, typename Flit_t, int NumStops, int NumRings>
+class RingNoCEndpoint : public sc_module {
+ public:
+  enum { stop_width = nvhls::index_width<NumStops>::val };
+  typedef NVUINTW(stop_width) Stop_t;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  sc_in<Stop_t> stop_id;
+
+  Connections::In<Packet_t> in_packet;
+  Connections::Out<Packet_t> out_packet;
+  Connections::Out<Flit_t> out_flit[NumRings];
+  Connections::In<Flit_t> in_flit[NumRings];
+
+  nvhls::nv_array<serializer<Packet_t, Flit_t, WormHole>, NumRings> ser;
+  nvhls::nv_array<deserializer<Packet_t, Flit_t, 0, WormHole>, NumRings> deser;
+  Connections::Combinational<Packet_t> ser_in[NumRings];
+  Connections::Combinational<Packet_t> deser_out[NumRings];
+
+  SC_HAS_PROCESS(RingNoCEndpoint);
+  RingNoCEndpoint(sc_module_name name_)
+      : sc_module(name_),
+        clk("clk"),
+        rst("rst"),
+        stop_id("stop_id"),
+        in_packet("in_packet"),
+        out_packet("out_packet"),
+        ser("ser"),
+        deser("deser") {
+    for (int r = 0; r < NumRings; r++) {
+      ser[r].clk(clk);
+      ser[r].rst(rst);
+      ser[r].in_packet(ser_in[r]);
+      ser[r].out_flit(out_flit[r]);
+      deser[r].clk(clk);
+      deser[r].rst(rst);
+      deser[r].in_flit(in_flit[r]);
+      deser[r].out_packet(deser_out[r]);
+    }
+
+    SC_THREAD(dispatch);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+
+    SC_THREAD(merge);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  // Ring of the shorter way from stop src to stop dst
+  static int ring_of(unsigned src, unsigned dst) {
+    unsigned ahead = (dst + NumStops - src) % NumStops;
+    return (NumRings > 1 && 2 * ahead > NumStops) ? 1 : 0;
+  }
+
+ protected:
+  void dispatch() {
+    in_packet.Reset();
+#pragma hls_unroll yes
+    for (int r = 0; r < NumRings; r++) {
+      ser_in[r].ResetWrite();
+    }
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+      Packet_t packet;
+      if (in_packet.PopNB(packet)) {
+        unsigned dst = nvhls::get_slc<stop_width>(packet.dest, 0).to_uint();
+        int r = ring_of(stop_id.read().to_uint(), dst);
+        if (r == 0) {
+          ser_in[0].Push(packet);
+        } else {
+          ser_in[NumRings - 1].Push(packet);
+        }
+      }
+    }
+  }
+
+  void merge() {
+    out_packet.Reset();
+#pragma hls_unroll yes
+    for (int r = 0; r < NumRings; r++) {
+      deser_out[r].ResetRead();
+    }
+    Packet_t held[NumRings];
+    NVUINTW(NumRings) valid = 0;
+    Arbiter<NumRings> arb;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+#pragma hls_unroll yes
+      for (int r = 0; r < NumRings; r++) {
+        if (valid[r] == 0) {
+          valid[r] = deser_out[r].PopNB(held[r]);
+        }
+      }
+      if (valid != 0) {
+        NVUINTW(NumRings) select = arb.pick(valid);
+        int r = (NumRings > 1 && select[NumRings - 1] == 1) ? NumRings - 1 : 0;
+        if (out_packet.PushNB(held[r])) {
+          valid[r] = 0;
+        }
+      }
+    }
+  }
+};
+
+/**
+ * \brief Unidirectional or bidirectional ring NoC of RingStop routers
+ * \ingroup RingNoC
+ *
+ * \tparam NumStops         Number of stops
+ * \tparam BufferSize       Ring input buffer of every stop, in flits
+ * \tparam FlitDataWidth    Data width of a flit
+ * \tparam PacketDataWidth  Data width of a packet
+ * \tparam PacketIdWidth    Width of the packet_id
+ * \tparam Bidirectional    Add a second ring running the other way
+ *
+ * \par Overview
+ * Stop n of ring 0 sends to stop n + 1, stop n of ring 1 to stop n - 1. The
+ * dest field of a packet is the number of the destination stop, and is
+ * delivered unchanged. Packets from one endpoint to another arrive in order.
+ * A flit takes one cycle per hop on an idle ring, and each ring stop has a
+ * single input buffer instead of the per-VC buffers and crossbar of a
+ * WHVCRouter. Every endpoint must keep draining out_packet, since ejected
+ * flits wait on the ring.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <RingNoC.h>
+ *
+ *      ...
+ *        typedef RingNoC<8, 8, 64, 128, 4, true> NoC_t;
+ *        NoC_t noc;
+ *        Connections::Combinational<NoC_t::Packet_t> in_chan[NoC_t::num_stops];
+ *        Connections::Combinational<NoC_t::Packet_t> out_chan[NoC_t::num_stops];
+ *
+ *        noc.clk(clk);
+ *        noc.rst(rst);
+ *        for (int n = 0; n < NoC_t::num_stops; n++) {
+ *          noc.in_packet[n](in_chan[n]);
+ *          noc.out_packet[n](out_chan[n]);
+ *        }
+ *        ...
+ *        NoC_t::Packet_t packet;
+ *        packet.dest = dest_stop;
+ *        in_chan[src].Push(packet);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <int NumStops, int BufferSize, int FlitDataWidth, int PacketDataWidth,
+          int PacketIdWidth, bool Bidirectional = false>
+class RingNoC : public sc_module {
+ public:
+  enum {
+    num_stops = NumStops,
+    num_rings = Bidirectional ? 2 : 1,
+    stop_width = nvhls::index_width<NumStops>::val,
+  };
+  static_assert(NumStops >= 2, "A ring needs at least 2 stops");
+
+  typedef Packet<PacketDataWidth, stop_width, 1, PacketIdWidth> Packet_t;
+  typedef Flit<FlitDataWidth, 0, 0, PacketIdWidth, FlitId2bit, WormHole> Flit_t;
+  static_assert(PacketIdWidth > 0, "The serializer needs a packet_id");
+  static_assert(FlitDataWidth > Packet_t::dest_width,
+                "Header flit must hold the destination and some packet data");
+
+  typedef serializer<Packet_t, Flit_t, WormHole> Serializer_t;
+  enum { max_packet_flits = Serializer_t::num_flits + 1 };
+  typedef RingStop<Flit_t, NumStops, BufferSize, max_packet_flits> Stop_t;
+  typedef RingNoCEndpoint<Packet_t, Flit_t, NumStops, num_rings> Endpoint_t;
+  typedef typename Stop_t::Credit_ret_t Credit_ret_t;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::In<Packet_t> in_packet[NumStops];
+  Connections::Out<Packet_t> out_packet[NumStops];
+
+  // Stop n of ring r is stop[r * NumStops + n]
+  nvhls::nv_array<Stop_t, NumStops * num_rings> stop;
+  nvhls::nv_array<Endpoint_t, NumStops> endpoint;
+
+  sc_signal<typename Stop_t::Stop_t> stop_id[NumStops];
+
+  // Link leaving stop n of ring r, and the credits returned on it
+  Connections::Combinational<Flit_t> link_flit[NumStops * num_rings];
+  Connections::Combinational<Credit_ret_t> link_credit[NumStops * num_rings];
+  Connections::Combinational<Flit_t> inject_flit[NumStops * num_rings];
+  Connections::Combinational<Flit_t> eject_flit[NumStops * num_rings];
+
+  // Next stop of stop n on ring r
+  static int next(int n, int r) {
+    return (r == 0) ? (n + 1) % NumStops : (n + NumStops - 1) % NumStops;
+  }
+
+  SC_HAS_PROCESS(RingNoC);
+  RingNoC(sc_module_name name_)
+      : sc_module(name_),
+        clk("clk"),
+        rst("rst"),
+        stop("stop"),
+        endpoint("endpoint") {
+    for (int n = 0; n < NumStops; n++) {
+      endpoint[n].clk(clk);
+      endpoint[n].rst(rst);
+      endpoint[n].stop_id(stop_id[n]);
+      endpoint[n].in_packet(in_packet[n]);
+      endpoint[n].out_packet(out_packet[n]);
+      for (int r = 0; r < num_rings; r++) {
+        int s = r * NumStops + n;
+        int m = r * NumStops + next(n, r);
+        stop[s].clk(clk);
+        stop[s].rst(rst);
+        stop[s].stop_id(stop_id[n]);
+        stop[s].in_local(inject_flit[s]);
+        stop[s].out_local(eject_flit[s]);
+        endpoint[n].out_flit[r](inject_flit[s]);
+        endpoint[n].in_flit[r](eject_flit[s]);
+        // The input side of this stop is bound from the previous stop's loop
+        stop[s].out_ring(link_flit[s]);
+        stop[m].in_ring(link_flit[s]);
+        stop[s].in_credit(link_credit[s]);
+        stop[m].out_credit(link_credit[s]);
+      }
+    }
+
+    SC_METHOD(tie_stop_ids);
+  }
+
+  // Runs once at initialization
+  void tie_stop_ids() {
+    for (int n = 0; n < NumStops; n++) {
+      stop_id[n].write(n);
+    }
+  }
+};
+
+#endif
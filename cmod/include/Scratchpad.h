@@ -25,8 +25,12 @@
 #include <nvhls_connections.h>
 #include <crossbar.h>
 #include <mem_array.h>
+#include <bank_mapping.h>
+#include <mem_array_pipelined.h>
+#include <fifo.h>
 
 #include <Scratchpad/ScratchpadTypes.h>
+#include <nvhls_sampling.h>
 
 /**
  * \brief Parameterized banked scratchpad memory implemented as a C++ class (i.e. not a SystemC module)
@@ -35,17 +39,31 @@
  * \tparam T                   EntryType
  * \tparam N                   Number of requests
  * \tparam CAPACITY_IN_WORDS   Total number of words of type T in memory
+ * \tparam BankMap             Address to bank mapping policy (see BankMapLowBits)
  *
  * \par Overview
  *   -Assumptions:  All N requests are guaranteed conflict-free.
  *    An assertion message will be emitted if there are any bank conflicts.
  *
+ *   -load_store_partial() lifts this: it serves the lowest pending lane of
+ *    each bank and returns the lanes it served. The caller replays the
+ *    request with the remaining lanes until none are left, so lanes that
+ *    store to the same address take effect in lane order. Outside synthesis,
+ *    the calls are counted in stats (see ConflictRate()). In the functional
+ *    mode of nvhls::Sampling it serves every pending lane in one call.
+ *
  *
  * \par Available Member Functions
  * \code
  *    void store(req_t req);  // Stores (ie writes) N request to banked memory
  *
  *    rsp_t load(req_t req);  // Loads (ie reads) N requests from banked memory
+ *
+ *    // Serves a conflict-free subset of the pending lanes of req
+ *    lane_mask_t load_store_partial(req_t req, lane_mask_t pending, rsp_t& rsp);
+ *
+ *    // The common vector request of nvhls_mem_req.h
+ *    void load_store(nvhls::mem_req_t<T, W, N> req, nvhls::mem_rsp_t<T, N>& rsp);
  * \endcode
  *
  * \par A Simple Example
@@ -97,7 +115,7 @@
  * \par
  *
  */
-template <typename T, int N, int CAPACITY_IN_WORDS>
+template <typename T, int N, int CAPACITY_IN_WORDS, typename BankMap = BankMapLowBits>
 class ScratchpadClass  {
  public:
 
@@ -115,6 +133,7 @@ class ScratchpadClass  {
   };
   typedef cli_req_t<T, ADDR_WIDTH, N> req_t;
   typedef cli_rsp_t<T, N> rsp_t;
+  typedef NVUINTW(N) lane_mask_t;
 
   //------------Local Variables Here---------------------
   mem_array_sep<T, CAPACITY_IN_WORDS, N> banks;
@@ -129,6 +148,26 @@ class ScratchpadClass  {
   bank_sel_t bank_src_lane[N];
   bank_sel_t bank_dst_lane[N];
 
+#ifndef __SYNTHESIS__
+  // load_store_partial() stats: requests started, calls, calls that left
+  // lanes pending, and lanes left pending summed over calls
+  unsigned long stat_requests;
+  unsigned long stat_cycles;
+  unsigned long stat_conflict_cycles;
+  unsigned long stat_deferred_lanes;
+
+  ScratchpadClass() { ResetStats(); }
+
+  void ResetStats() {
+    stat_requests = stat_cycles = stat_conflict_cycles = stat_deferred_lanes = 0;
+  }
+
+  // Fraction of load_store_partial() calls that hit a bank conflict
+  double ConflictRate() const {
+    return (stat_cycles == 0) ? 0.0 : double(stat_conflict_cycles) / stat_cycles;
+  }
+#endif
+
   void store(req_t req) {
     rsp_t load_rsp;
     req.opcode = STORE;
@@ -153,7 +192,7 @@ class ScratchpadClass  {
       // For each request, figure out the target bank and update its bank_req
       // fields
       bank_sel_t bank_sel;
-      bank_sel = nvhls::get_slc<NBANKS_LOG2>(curr_cli_req.addr[i], 0);
+      bank_sel = BankMap::template bank<N, ADDR_WIDTH>(curr_cli_req.addr[i]);
       bank_src_lane[bank_sel] = i;
 
       // Save the lane->bank mapping for the response xbar
@@ -171,8 +210,7 @@ class ScratchpadClass  {
 
       // Convert from curr_cli_req to internal format
       input_reqs_valid[i] = (curr_cli_req.valids[i] == true);
-      input_reqs[i].addr = nvhls::get_slc<ADDR_WIDTH - NBANKS_LOG2>(
-          curr_cli_req.addr[i], NBANKS_LOG2);
+      input_reqs[i].addr = BankMap::template index<N, ADDR_WIDTH>(curr_cli_req.addr[i]);
       if (!is_load)
         input_reqs[i].wdata = curr_cli_req.data[i];
     }
@@ -203,6 +241,113 @@ class ScratchpadClass  {
       load_rsp.valids[i] = load_rsps_valid[i];  // sc_lv to bool conversion
     }
   }
+
+  // The common nvhls::mem_req_t interface; lanes must be conflict-free as
+  // for load_store()
+  template <unsigned int MemAddrWidth>
+  void load_store(const nvhls::mem_req_t<T, MemAddrWidth, N>& req, nvhls::mem_rsp_t<T, N>& rsp) {
+    req_t cli_req;
+    rsp_t cli_rsp;
+    to_cli_req(req, cli_req);
+    load_store(cli_req, cli_rsp);
+    to_mem_rsp(cli_rsp, rsp);
+  }
+
+  // Serves, for each bank, the lowest lane of pending that targets it.
+  // Returns the lanes served; load_rsp is valid on the served lanes of a load.
+  lane_mask_t load_store_partial(req_t curr_cli_req, lane_mask_t pending,
+                                 rsp_t& load_rsp) {
+    bool is_load;
+    bool bank_busy[N];
+    lane_mask_t served = 0;
+
+    is_load = (curr_cli_req.opcode == LOAD);
+
+#ifndef __SYNTHESIS__
+    // Functional fast-forward of sampled simulation: no bank conflicts, and
+    // no stats
+    if (nvhls::Sampling::Functional()) {
+      for (int i = 0; i < N; i++) {
+        load_rsp.valids[i] = false;
+        if (pending[i]) {
+          bank_sel_t bank_sel = BankMap::template bank<N, ADDR_WIDTH>(curr_cli_req.addr[i]);
+          bank_addr_t addr = BankMap::template index<N, ADDR_WIDTH>(curr_cli_req.addr[i]);
+          if (is_load) {
+            load_rsp.data[i] = banks.read(addr, bank_sel);
+            load_rsp.valids[i] = true;
+          } else {
+            banks.write(addr, bank_sel, curr_cli_req.data[i]);
+          }
+        }
+      }
+      return pending;
+    }
+#endif
+
+    #pragma hls_unroll yes
+    for (int i = 0; i < N; i++) {
+      bank_busy[i] = false;
+    }
+
+    // Grant each bank to its first pending lane
+    #pragma hls_unroll yes
+    for (int i = 0; i < N; i++) {
+      bank_sel_t bank_sel;
+      bank_sel = BankMap::template bank<N, ADDR_WIDTH>(curr_cli_req.addr[i]);
+      bank_dst_lane[i] = bank_sel;
+
+      if (pending[i] && !bank_busy[bank_sel]) {
+        bank_busy[bank_sel] = true;
+        bank_src_lane[bank_sel] = i;
+        served[i] = 1;
+      }
+
+      input_reqs_valid[i] = served[i];
+      input_reqs[i].addr = BankMap::template index<N, ADDR_WIDTH>(curr_cli_req.addr[i]);
+      if (!is_load)
+        input_reqs[i].wdata = curr_cli_req.data[i];
+    }
+
+#ifndef __SYNTHESIS__
+    lane_mask_t valids = 0;
+    for (int i = 0; i < N; i++) {
+      valids[i] = (curr_cli_req.valids[i] == true);
+    }
+    if (pending == valids) stat_requests++;
+    stat_cycles++;
+    if (served != pending) stat_conflict_cycles++;
+    for (int i = 0; i < N; i++) {
+      if (pending[i] && !served[i]) stat_deferred_lanes++;
+    }
+#endif
+
+    // Bank request crossbar
+    crossbar<bank_req_t, N, N>(input_reqs, input_reqs_valid, bank_src_lane,
+                               bank_busy, bank_reqs, bank_reqs_valid);
+
+    #pragma hls_unroll yes
+    for (int i = 0; i < N; i++) {
+      if ((bank_reqs_valid[i] == true) && is_load) {
+        bank_rsps_valid[i] = true;
+        bank_rsps_data[i] = banks.read(bank_reqs[i].addr, i);
+      } else if ((bank_reqs_valid[i] == true) && !is_load) {
+        banks.write(bank_reqs[i].addr, i, bank_reqs[i].wdata);
+        bank_rsps_valid[i] = false;
+      } else {
+        bank_rsps_valid[i] = false;
+      }
+    }
+
+    // Bank response crossbar; a lane that lost its bank sees that bank's
+    // response and must drop it
+    crossbar<T, N, N>(bank_rsps_data, bank_rsps_valid, bank_dst_lane,
+                      load_rsp.data, load_rsps_valid);
+    #pragma hls_unroll yes
+    for (int i = 0; i < N; i++) {
+      load_rsp.valids[i] = load_rsps_valid[i] && served[i];
+    }
+    return served;
+  }
 };
 
 /**
@@ -212,11 +357,20 @@ class ScratchpadClass  {
  * \tparam T                   EntryType
  * \tparam N                   Number of requests
  * \tparam CAPACITY_IN_WORDS   Total number of words of type T in memory
+ * \tparam QUEUE_CONFLICTS     Serve conflicting requests over several cycles
+ * \tparam BankMap             Address to bank mapping policy (see BankMapLowBits)
  *
  * \par Overview
  *   -Assumptions:  All N requests are guaranteed conflict-free.
  *    An assertion message will be emitted if there are any bank conflicts.
  *
+ *   -With QUEUE_CONFLICTS, conflicting requests are allowed. A request is
+ *    held and replayed through ScratchpadClass::load_store_partial(), one
+ *    lane per bank per cycle, until all its lanes are served; cli_req is not
+ *    ready for the next request meanwhile. The response of a load is sent
+ *    once all lanes are served. A conflict-free request still takes one
+ *    cycle.
+ *
  *   Ports:
  *     1 input port for requests (load OR store) from client
  *     1 output port for responses (load only) back to client
@@ -255,7 +409,8 @@ class ScratchpadClass  {
  * \par
  *
  */
-template <typename T, int N, int CAPACITY_IN_WORDS>
+template <typename T, int N, int CAPACITY_IN_WORDS, bool QUEUE_CONFLICTS = false,
+          typename BankMap = BankMapLowBits>
 class Scratchpad : public sc_module {
  public:
   static const int ADDR_WIDTH = nvhls::nbits<CAPACITY_IN_WORDS - 1>::val;
@@ -277,15 +432,20 @@ class Scratchpad : public sc_module {
   };
   typedef cli_req_t<T, ADDR_WIDTH, N> req_t;
   typedef cli_rsp_t<T, N> rsp_t;
+  typedef NVUINTW(N) lane_mask_t;
 
-  ScratchpadClass<T, N, CAPACITY_IN_WORDS> scratchpad_class;
+  ScratchpadClass<T, N, CAPACITY_IN_WORDS, BankMap> scratchpad_class;
 
   //----------- Constructor -----------------------------
   //   -Allocate and declare sub-modules
   //   -Declare all SC_METHODs and SC_THREADs
   SC_HAS_PROCESS(Scratchpad);
   Scratchpad(sc_module_name name_) : sc_module(name_) {
-    SC_THREAD(run);
+    if (QUEUE_CONFLICTS) {
+      SC_THREAD(run_queued);
+    } else {
+      SC_THREAD(run);
+    }
     sensitive << clk.pos();
     NVHLS_NEG_RESET_SIGNAL_IS(rst);
     //DCOUT("Capacity (words): " << CAPACITY_IN_WORDS << ", banks: " << N
@@ -326,6 +486,247 @@ class Scratchpad : public sc_module {
       wait();
     }
   }
+
+  void run_queued() {
+
+    // Reset behavior
+    cli_req.Reset();
+    cli_rsp.Reset();
+
+    req_t curr_cli_req;
+    rsp_t load_rsp;
+    lane_mask_t pending = 0;
+    wait();
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (true) {
+
+      // Take a new request once the current one is done
+      if (pending == 0) {
+        curr_cli_req = cli_req.Pop();
+        #pragma hls_unroll yes
+        for (int i = 0; i < N; i++) {
+          pending[i] = (curr_cli_req.valids[i] == true);
+          load_rsp.valids[i] = false;
+        }
+      }
+
+      rsp_t part_rsp;
+      lane_mask_t served =
+          scratchpad_class.load_store_partial(curr_cli_req, pending, part_rsp);
+
+      #pragma hls_unroll yes
+      for (int i = 0; i < N; i++) {
+        if (served[i]) {
+          load_rsp.data[i] = part_rsp.data[i];
+          load_rsp.valids[i] = part_rsp.valids[i];
+        }
+      }
+      pending &= ~served;
+
+      // Write client responses
+      if ((pending == 0) && (curr_cli_req.opcode == LOAD)) {
+        cli_rsp.Push(load_rsp);
+      }
+
+      wait();
+    }
+  }
+};
+
+/**
+ * \brief Scratchpad module whose banks have a multi-cycle read latency
+ * \ingroup Scratchpad
+ *
+ * \tparam T                   EntryType
+ * \tparam N                   Number of requests
+ * \tparam CAPACITY_IN_WORDS   Total number of words of type T in memory
+ * \tparam READ_LATENCY        Cycles from a bank read to its data
+ * \tparam MAX_OUTSTANDING     Loads in flight or waiting for cli_rsp
+ * \tparam BankMap             Address to bank mapping policy (see BankMapLowBits)
+ *
+ * \par Overview
+ *   Same ports and request format as Scratchpad, with the banks built on
+ *   mem_array_pipelined. A load is issued to its banks in the cycle it is
+ *   popped, and its response is pushed to cli_rsp READ_LATENCY cycles later.
+ *   -Assumptions:  All N requests are guaranteed conflict-free.
+ *    An assertion message will be emitted if there are any bank conflicts.
+ *   -One request is taken per cycle while fewer than MAX_OUTSTANDING loads
+ *    are waiting for their response; stores complete when they are taken.
+ *    With the default MAX_OUTSTANDING of READ_LATENCY + 1, loads stream at
+ *    one per cycle as long as cli_rsp does not stall.
+ *   -Responses leave in request order.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <Scratchpad.h>
+ *
+ *      ...
+ *      PipelinedScratchpad<data32_t, SCRATCHPAD_BANKS, CAPACITY_IN_WORDS, 2> myscratchpad;
+ *      ...
+ *        myscratchpad.clk(clk);
+ *        myscratchpad.rst(rst);
+ *        myscratchpad.cli_req(cli_req);
+ *        myscratchpad.cli_rsp(cli_rsp);
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename T, int N, int CAPACITY_IN_WORDS, unsigned int READ_LATENCY,
+          unsigned int MAX_OUTSTANDING = READ_LATENCY + 1,
+          typename BankMap = BankMapLowBits>
+class PipelinedScratchpad : public sc_module {
+ public:
+  static const int ADDR_WIDTH = nvhls::nbits<CAPACITY_IN_WORDS - 1>::val;
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<cli_req_t<T, ADDR_WIDTH, N> > cli_req;
+  Connections::Out<cli_rsp_t<T, N> > cli_rsp;
+
+  //------------Constants Here---------------------------
+  // Derived parameters
+  static const int NBANKS_LOG2 = nvhls::nbits<N - 1>::val;
+
+  //------------Local typedefs---------------------------
+  typedef NVUINTW(NBANKS_LOG2) bank_sel_t;
+  typedef cli_req_t<T, ADDR_WIDTH, N> req_t;
+  typedef cli_rsp_t<T, N> rsp_t;
+  typedef mem_array_pipelined<T, CAPACITY_IN_WORDS, N, READ_LATENCY, MAX_OUTSTANDING> mem_t;
+
+  // Lane to bank mapping of a load waiting for its data
+  struct load_info_t : public nvhls_message {
+    bank_sel_t bank_dst_lane[N];
+    NVUINTW(N) valids;
+    static const int width = N * NBANKS_LOG2 + N;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      #pragma hls_unroll yes
+      for (int i = 0; i < N; i++) m & bank_dst_lane[i];
+      m & valids;
+    }
+  };
+
+  mem_t banks;
+  FIFO<load_info_t, MAX_OUTSTANDING> load_info;
+
+  //----------- Constructor -----------------------------
+  SC_HAS_PROCESS(PipelinedScratchpad);
+  PipelinedScratchpad(sc_module_name name_) : sc_module(name_) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void run() {
+
+    // Reset behavior
+    cli_req.Reset();
+    cli_rsp.Reset();
+    banks.reset();
+    load_info.reset();
+    wait();
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (true) {
+
+      // Respond to the oldest load once all of its banks returned data
+      if (!load_info.isEmpty()) {
+        load_info_t info = load_info.peek();
+        bool bank_used[N];
+        #pragma hls_unroll yes
+        for (int i = 0; i < N; i++) {
+          bank_used[i] = false;
+        }
+        #pragma hls_unroll yes
+        for (int i = 0; i < N; i++) {
+          if (info.valids[i]) {
+            bank_used[info.bank_dst_lane[i]] = true;
+          }
+        }
+
+        bool all_arrived = true;
+        T bank_rsps_data[N];
+        #pragma hls_unroll yes
+        for (int i = 0; i < N; i++) {
+          bank_rsps_data[i] = 0;
+          if (bank_used[i]) {
+            if (banks.rsp_valid(i)) {
+              bank_rsps_data[i] = banks.rsp_peek(i);
+            } else {
+              all_arrived = false;
+            }
+          }
+        }
+
+        if (all_arrived) {
+          rsp_t load_rsp;
+          bool load_rsps_valid[N];
+          crossbar<T, N, N>(bank_rsps_data, bank_used, info.bank_dst_lane,
+                            load_rsp.data, load_rsps_valid);
+          #pragma hls_unroll yes
+          for (int i = 0; i < N; i++) {
+            load_rsp.valids[i] = load_rsps_valid[i] && info.valids[i];
+          }
+          if (cli_rsp.PushNB(load_rsp)) {
+            #pragma hls_unroll yes
+            for (int i = 0; i < N; i++) {
+              if (bank_used[i]) {
+                banks.rsp_pop(i);
+              }
+            }
+            load_info.pop();
+          }
+        }
+      }
+
+      // Take a new request while every bank can take a read
+      bool can_issue = !load_info.isFull();
+      #pragma hls_unroll yes
+      for (int i = 0; i < N; i++) {
+        can_issue = can_issue && banks.read_ready(i);
+      }
+
+      req_t curr_cli_req;
+      if (can_issue && cli_req.PopNB(curr_cli_req)) {
+        bool is_load = (curr_cli_req.opcode == LOAD);
+        load_info_t info;
+
+        #pragma hls_unroll yes
+        for (int i = 0; i < N; i++) {
+          bank_sel_t bank_sel = BankMap::template bank<N, ADDR_WIDTH>(curr_cli_req.addr[i]);
+          typename mem_t::LocalIndex bank_addr = BankMap::template index<N, ADDR_WIDTH>(curr_cli_req.addr[i]);
+          bool valid = (curr_cli_req.valids[i] == true);
+          info.bank_dst_lane[i] = bank_sel;
+          info.valids[i] = valid;
+
+#ifndef __SYNTHESIS__
+          for (int j = 0; j < i; j++) {
+            NVHLS_ASSERT_MSG(!valid || !info.valids[j] || (info.bank_dst_lane[j] != bank_sel),
+                             "conflicting bank requests");
+          }
+#endif
+
+          if (valid && is_load) {
+            banks.read(bank_addr, bank_sel);
+          } else if (valid) {
+            banks.write(bank_addr, bank_sel, curr_cli_req.data[i]);
+          }
+        }
+
+        if (is_load) {
+          load_info.push(info);
+        }
+      }
+
+      banks.tick();
+      wait();
+    }
+  }
 };
 
 /**
@@ -335,6 +736,7 @@ class Scratchpad : public sc_module {
  * \tparam T                   EntryType
  * \tparam N                   Number of requests
  * \tparam CAPACITY_IN_WORDS   Total number of words of type T in memory
+ * \tparam BANK_MAP            Address to bank mapping policy (see BankMapLowBits)
  *
  * \par Overview
  *    This traits class provides a clean way to access all types and constants that might be
@@ -347,8 +749,8 @@ class Scratchpad : public sc_module {
  *    static const int capacity_in_words = CAPACITY_IN_WORDS;
  *    static const int num_inputs = num_banks; // Note: for Scratchpad num_banks must equal num_inputs
  *    static const int words_per_bank = capacity_in_words / num_banks;
- *    typedef ScratchpadClass<word_type, num_banks, capacity_in_words> mem_class_t;
- *    typedef Scratchpad<word_type, num_banks, capacity_in_words> mem_module_t;
+ *    typedef ScratchpadClass<word_type, num_banks, capacity_in_words, BANK_MAP> mem_class_t;
+ *    typedef Scratchpad<word_type, num_banks, capacity_in_words, false, BANK_MAP> mem_module_t;
  *    typedef typename mem_class_t::req_t base_req_t;
  *    typedef typename mem_class_t::rsp_t base_rsp_t;
  *    static const int addr_width = mem_class_t::ADDR_WIDTH;
@@ -392,7 +794,8 @@ class Scratchpad : public sc_module {
  *
  *
  */
-template <typename WORD_TYPE, int NUM_BANKS, int CAPACITY_IN_WORDS>
+template <typename WORD_TYPE, int NUM_BANKS, int CAPACITY_IN_WORDS,
+          typename BANK_MAP = BankMapLowBits>
 struct ScratchpadTraits {
   typedef WORD_TYPE word_type;
   static const int num_banks = NUM_BANKS;
@@ -402,8 +805,8 @@ struct ScratchpadTraits {
   static const int words_per_bank = capacity_in_words / num_banks;
 
 
-  typedef ScratchpadClass<word_type, num_banks, capacity_in_words> mem_class_t;
-  typedef Scratchpad<word_type, num_banks, capacity_in_words> mem_module_t;
+  typedef ScratchpadClass<word_type, num_banks, capacity_in_words, BANK_MAP> mem_class_t;
+  typedef Scratchpad<word_type, num_banks, capacity_in_words, false, BANK_MAP> mem_module_t;
 
   typedef typename mem_class_t::req_t base_req_t;
   typedef typename mem_class_t::rsp_t base_rsp_t;
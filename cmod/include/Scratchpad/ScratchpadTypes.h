@@ -20,6 +20,7 @@
 #include <nvhls_types.h>
 #include <nvhls_message.h>
 #include <comptrees.h>
+#include <nvhls_mem_req.h>
 
 
 // Define enums for request type
@@ -68,4 +69,46 @@ public:
   
 };
 
+// Zero-latency conversions between cli_req_t/cli_rsp_t and the common
+// nvhls::mem_req_t/mem_rsp_t; addresses are resized to the destination width
+template <typename T, unsigned int AddrWidth, unsigned int MemAddrWidth, unsigned int N>
+void to_cli_req(const nvhls::mem_req_t<T, MemAddrWidth, N>& in, cli_req_t<T, AddrWidth, N>& out) {
+  out.opcode = (in.is_store == 1) ? STORE : LOAD;
+  #pragma hls_unroll yes
+  for (unsigned int i = 0; i < N; i++) {
+    out.valids[i] = (in.valids[i] == 1);
+    out.addr[i] = in.addr[i];
+    out.data[i] = in.data[i];
+  }
+}
+
+template <typename T, unsigned int AddrWidth, unsigned int MemAddrWidth, unsigned int N>
+void to_mem_req(const cli_req_t<T, AddrWidth, N>& in, nvhls::mem_req_t<T, MemAddrWidth, N>& out) {
+  out.is_store = (in.opcode == STORE);
+  #pragma hls_unroll yes
+  for (unsigned int i = 0; i < N; i++) {
+    out.valids[i] = in.valids[i].to_bool();
+    out.addr[i] = in.addr[i];
+    out.data[i] = in.data[i];
+  }
+}
+
+template <typename T, unsigned int N>
+void to_cli_rsp(const nvhls::mem_rsp_t<T, N>& in, cli_rsp_t<T, N>& out) {
+  #pragma hls_unroll yes
+  for (unsigned int i = 0; i < N; i++) {
+    out.valids[i] = (in.valids[i] == 1);
+    out.data[i] = in.data[i];
+  }
+}
+
+template <typename T, unsigned int N>
+void to_mem_rsp(const cli_rsp_t<T, N>& in, nvhls::mem_rsp_t<T, N>& out) {
+  #pragma hls_unroll yes
+  for (unsigned int i = 0; i < N; i++) {
+    out.valids[i] = in.valids[i].to_bool();
+    out.data[i] = in.data[i];
+  }
+}
+
 #endif
@@ -0,0 +1,444 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __STREAMCODEC_H__
+#define __STREAMCODEC_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_message.h>
+#include <nvhls_types.h>
+#include <nvhls_int.h>
+#include <nvhls_assert.h>
+#include <hls_globals.h>
+
+/**
+ * \brief Beat of a compressed stream
+ * \ingroup StreamCodec
+ *
+ * \tparam BeatWidth        Bitwidth of the beat
+ *
+ * \par Overview
+ * Compressed blocks take a whole number of beats, and last is set on the
+ * final beat of each block, e.g. to end an AXI burst there. With BeatWidth
+ * set to the AXI data width, the fields are those of AxiDma::StreamBeat, so
+ * the beats of a block read by one DMA descriptor go straight to a
+ * StreamDecoder, and encoded beats are written as one burst per block, e.g.
+ * to an AxiSubordinateToMem.
+ */
+template <int BeatWidth>
+class CodecBeat : public nvhls_message {
+ public:
+  enum { width = BeatWidth + 1 };
+
+  NVUINTW(BeatWidth) data;
+  bool last;
+
+  CodecBeat() : data(0), last(false) {}
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m& data;
+    m& last;
+  }
+};
+
+/**
+ * \brief Zero-value compression codec for StreamEncoder and StreamDecoder
+ * \ingroup StreamCodec
+ *
+ * \tparam WordWidth        Bitwidth of the uncompressed words
+ *
+ * \par Overview
+ * Every word takes one bit of the zero bitmap, followed by the word itself
+ * when it is nonzero: 1 bit for a zero word and WordWidth+1 bits for any
+ * other. The bitmap bits are interleaved with the words, so the code of a
+ * word is known as soon as the word arrives.
+ */
+template <int WordWidth>
+class ZeroValueCodec {
+ public:
+  enum { word_width = WordWidth, max_code_width = WordWidth + 1 };
+  typedef NVUINTW(WordWidth) Word;
+  typedef NVUINTW(max_code_width) Code;
+  typedef NVUINTW(nvhls::index_width<max_code_width + 1>::val) Len;
+
+  void reset() {}
+
+  /* Code of a word; first and end mark the first and last word of a block.
+   * Returns false when the word adds no code yet. */
+  bool Encode(const Word& word, bool first, bool end, Code& code, Len& len) {
+    if (word == 0) {
+      code = 0;
+      len = 1;
+    } else {
+      code = (static_cast<Code>(word) << 1) | 1;
+      len = max_code_width;
+    }
+    return true;
+  }
+
+  /* Length of the code at the bottom of the bits. */
+  template <typename Bits>
+  Len Length(const Bits& bits, bool first) const {
+    return (bits[0] == 1) ? Len(max_code_width) : Len(1);
+  }
+
+  /* Next word of the code at the bottom of the bits, and the code bits it
+   * used up. */
+  template <typename Bits>
+  Word Decode(const Bits& bits, bool first, Len& used) {
+    used = Length(bits, first);
+    return (bits[0] == 1) ? nvhls::get_slc<WordWidth>(bits, 1) : Word(0);
+  }
+};
+
+/**
+ * \brief Zero run-length codec for StreamEncoder and StreamDecoder
+ * \ingroup StreamCodec
+ *
+ * \tparam WordWidth        Bitwidth of the uncompressed words
+ * \tparam RunWidth         Bitwidth of the run length
+ *
+ * \par Overview
+ * Each code holds a run of up to 2^RunWidth-1 zero words, in its RunWidth
+ * LSBs, and the word that follows the run. A run ends at the first nonzero
+ * word, at the end of a block, or when it is full, in which case the next
+ * zero word is the one sent after it.
+ */
+template <int WordWidth, int RunWidth>
+class RunLengthCodec {
+ public:
+  enum { word_width = WordWidth, max_code_width = RunWidth + WordWidth, max_run = (1 << RunWidth) - 1 };
+  typedef NVUINTW(WordWidth) Word;
+  typedef NVUINTW(max_code_width) Code;
+  typedef NVUINTW(nvhls::index_width<max_code_width + 1>::val) Len;
+  typedef NVUINTW(RunWidth) Run;
+  static_assert(RunWidth >= 1, "RunWidth must be at least 1");
+
+  RunLengthCodec() { reset(); }
+
+  void reset() {
+    run = 0;
+    left = 0;
+    active = false;
+  }
+
+  bool Encode(const Word& word, bool first, bool end, Code& code, Len& len) {
+    if (word == 0 && !end && run != max_run) {
+      run++;
+      return false;
+    }
+    code = (static_cast<Code>(word) << RunWidth) | run;
+    len = max_code_width;
+    run = 0;
+    return true;
+  }
+
+  template <typename Bits>
+  Len Length(const Bits& bits, bool first) const {
+    return max_code_width;
+  }
+
+  /* The zeros of the run, one per call, then the word that ends it. */
+  template <typename Bits>
+  Word Decode(const Bits& bits, bool first, Len& used) {
+    if (!active) {
+      left = nvhls::get_slc<RunWidth>(bits, 0);
+      active = true;
+    }
+    if (left != 0) {
+      left--;
+      used = 0;
+      return 0;
+    }
+    active = false;
+    used = max_code_width;
+    return nvhls::get_slc<WordWidth>(bits, RunWidth);
+  }
+
+ private:
+  Run run;
+  Run left;
+  bool active;
+};
+
+/**
+ * \brief Base-delta codec for StreamEncoder and StreamDecoder
+ * \ingroup StreamCodec
+ *
+ * \tparam WordWidth        Bitwidth of the uncompressed words
+ * \tparam DeltaWidth       Bitwidth of the signed deltas
+ *
+ * \par Overview
+ * The first word of a block is sent as is and is the base of the block. Each
+ * later word whose difference to the base fits in a signed DeltaWidth
+ * integer takes a 1 flag bit and the delta, and any other word a 0 flag bit
+ * and the word itself.
+ */
+template <int WordWidth, int DeltaWidth>
+class BaseDeltaCodec {
+ public:
+  enum { word_width = WordWidth, max_code_width = WordWidth + 1 };
+  typedef NVUINTW(WordWidth) Word;
+  typedef NVUINTW(max_code_width) Code;
+  typedef NVUINTW(nvhls::index_width<max_code_width + 1>::val) Len;
+  typedef NVINTW(DeltaWidth) Delta;
+  static_assert(DeltaWidth >= 1 && DeltaWidth < WordWidth,
+                "DeltaWidth must be narrower than WordWidth");
+
+  BaseDeltaCodec() { reset(); }
+
+  void reset() { base = 0; }
+
+  bool Encode(const Word& word, bool first, bool end, Code& code, Len& len) {
+    if (first) {
+      base = word;
+      code = word;
+      len = WordWidth;
+      return true;
+    }
+    Word diff = word - base;
+    Delta delta = nvhls::get_slc<DeltaWidth>(diff, 0);
+    if (static_cast<Word>(delta) == diff) {
+      code = (static_cast<Code>(nvhls::get_slc<DeltaWidth>(diff, 0)) << 1) | 1;
+      len = DeltaWidth + 1;
+    } else {
+      code = static_cast<Code>(word) << 1;
+      len = max_code_width;
+    }
+    return true;
+  }
+
+  template <typename Bits>
+  Len Length(const Bits& bits, bool first) const {
+    if (first) return WordWidth;
+    return (bits[0] == 1) ? Len(DeltaWidth + 1) : Len(max_code_width);
+  }
+
+  template <typename Bits>
+  Word Decode(const Bits& bits, bool first, Len& used) {
+    used = Length(bits, first);
+    if (first) {
+      base = nvhls::get_slc<WordWidth>(bits, 0);
+      return base;
+    }
+    if (bits[0] == 1) {
+      Delta delta = nvhls::get_slc<DeltaWidth>(bits, 1);
+      return base + static_cast<Word>(delta);
+    }
+    return nvhls::get_slc<WordWidth>(bits, 1);
+  }
+
+ private:
+  Word base;
+};
+
+/**
+ * \brief Compresses a stream of words into fixed-width beats
+ * \ingroup StreamCodec
+ *
+ * \tparam Codec            ZeroValueCodec, RunLengthCodec or BaseDeltaCodec
+ * \tparam BeatWidth        Bitwidth of the compressed beats
+ * \tparam BlockWords       Number of words per block
+ *
+ * \par Overview
+ * The words are compressed in blocks of BlockWords words, e.g. the words of
+ * one DMA descriptor or of one memory page. The codes of a block are packed
+ * LSB first into beats of BeatWidth bits, and the last beat of the block is
+ * padded with zeros, so each block can be fetched and decompressed on its
+ * own.
+ * - One word is taken per cycle. When the last word of a block leaves more
+ *   than one beat of bits, the encoder takes one more cycle to send the
+ *   padded beat.
+ * - The longest code must fit in a beat, so at most one beat is sent per
+ *   cycle.
+ * - Most of the beats are full: a block of n bits of codes takes ceil(n /
+ *   BeatWidth) beats.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <StreamCodec.h>
+ *      ...
+ *      typedef ZeroValueCodec<32> Codec;
+ *      StreamEncoder<Codec, 64, 256> encoder;   // 1kB blocks on 64-bit beats
+ *      StreamDecoder<Codec, 64, 256> decoder;
+ *      Connections::Combinational<Codec::Word> words_in, words_out;
+ *      Connections::Combinational<CodecBeat<64> > beats;
+ *      ...
+ *      encoder.in(words_in);
+ *      encoder.out(beats);
+ *      decoder.in(beats);
+ *      decoder.out(words_out);
+ * \endcode
+ * \par
+ *
+ */
+template <typename Codec, int BeatWidth, int BlockWords>
+class StreamEncoder : public sc_module {
+ public:
+  typedef typename Codec::Word Word;
+  typedef CodecBeat<BeatWidth> Beat;
+  typedef NVUINTW(2 * BeatWidth) Bits;
+  typedef NVUINTW(nvhls::index_width<2 * BeatWidth + 1>::val) BitCount;
+  typedef NVUINTW(nvhls::index_width<BlockWords>::val) WordCount;
+  static_assert(static_cast<int>(Codec::max_code_width) <= BeatWidth,
+                "The longest code must fit in a beat");
+  static_assert(BlockWords >= 1, "A block needs at least 1 word");
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::In<Word> in;
+  Connections::Out<Beat> out;
+
+  SC_HAS_PROCESS(StreamEncoder);
+  StreamEncoder(sc_module_name name_)
+      : sc_module(name_), clk("clk"), rst("rst"), in("in"), out("out") {
+    SC_THREAD(process);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+ protected:
+  void process() {
+    in.Reset();
+    out.Reset();
+    Codec codec;
+    Bits bits = 0;
+    BitCount count = 0;
+    WordCount words = 0;
+    bool flush = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+      Word word;
+      if (!flush && in.PopNB(word)) {
+        bool end = (words == BlockWords - 1);
+        typename Codec::Code code;
+        typename Codec::Len len;
+        if (codec.Encode(word, words == 0, end, code, len)) {
+          bits |= static_cast<Bits>(code) << count;
+          count += len;
+        }
+        words = end ? WordCount(0) : WordCount(words + 1);
+        flush = end;
+      }
+
+      if (count >= BeatWidth || (flush && count != 0)) {
+        Beat beat;
+        beat.data = nvhls::get_slc<BeatWidth>(bits, 0);
+        beat.last = flush && count <= BeatWidth;
+        out.Push(beat);
+        if (beat.last) {
+          bits = 0;
+          count = 0;
+          flush = false;
+          codec.reset();
+        } else {
+          bits >>= BeatWidth;
+          count -= BeatWidth;
+        }
+      }
+    }
+  }
+};
+
+/**
+ * \brief Decompresses the beats of a StreamEncoder into words
+ * \ingroup StreamCodec
+ *
+ * \tparam Codec            The codec of the StreamEncoder
+ * \tparam BeatWidth        Bitwidth of the compressed beats
+ * \tparam BlockWords       Number of words per block
+ *
+ * \par Overview
+ * Beats are buffered up to two at a time, and one word is sent per cycle as
+ * long as the beats arrive in time. After the last word of a block, the
+ * padding of its last beat is dropped; the decoder asserts that the beat had
+ * last set.
+ */
+template <typename Codec, int BeatWidth, int BlockWords>
+class StreamDecoder : public sc_module {
+ public:
+  typedef typename Codec::Word Word;
+  typedef CodecBeat<BeatWidth> Beat;
+  typedef NVUINTW(2 * BeatWidth) Bits;
+  typedef NVUINTW(nvhls::index_width<2 * BeatWidth + 1>::val) BitCount;
+  typedef NVUINTW(nvhls::index_width<BlockWords>::val) WordCount;
+  static_assert(static_cast<int>(Codec::max_code_width) <= BeatWidth,
+                "The longest code must fit in a beat");
+  static_assert(BlockWords >= 1, "A block needs at least 1 word");
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::In<Beat> in;
+  Connections::Out<Word> out;
+
+  SC_HAS_PROCESS(StreamDecoder);
+  StreamDecoder(sc_module_name name_)
+      : sc_module(name_), clk("clk"), rst("rst"), in("in"), out("out") {
+    SC_THREAD(process);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+ protected:
+  void process() {
+    in.Reset();
+    out.Reset();
+    Codec codec;
+    Bits bits = 0;
+    BitCount count = 0;
+    WordCount words = 0;
+    bool got_last = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+      // The beats of the next block wait until this one is done
+      Beat beat;
+      if (!got_last && count <= BeatWidth && in.PopNB(beat)) {
+        bits |= static_cast<Bits>(beat.data) << count;
+        count += BeatWidth;
+        got_last = beat.last;
+      }
+
+      if (count != 0 && count >= codec.Length(bits, words == 0)) {
+        typename Codec::Len used;
+        Word word = codec.Decode(bits, words == 0, used);
+        out.Push(word);
+        bits >>= used;
+        count -= used;
+        if (words == BlockWords - 1) {
+          NVHLS_ASSERT_MSG(got_last, "Compressed block does not end with a last beat");
+          bits = 0;
+          count = 0;
+          words = 0;
+          got_last = false;
+          codec.reset();
+        } else {
+          words++;
+        }
+      }
+    }
+  }
+};
+
+#endif  // __STREAMCODEC_H__
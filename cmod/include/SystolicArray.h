@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SYSTOLIC_ARRAY_H
+#define SYSTOLIC_ARRAY_H
+
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <nvhls_vector.h>
+#include <mem_array.h>
+#include <nvhls_sampling.h>
+
+/**
+ * \brief Weight-stationary systolic array of M x N multiply-accumulate PEs
+ * \ingroup SystolicArray
+ *
+ * \tparam M                Rows, the length of an input vector
+ * \tparam N                Columns, the length of an output vector
+ * \tparam InT              Type of inputs and weights
+ * \tparam AccT             Type of the partial sums and outputs
+ *
+ * \par Overview
+ * Computes out[n] = sum over m of in[m] * W[m][n] for a stream of input
+ * vectors, one per call of run(), which models one cycle.
+ * - PE (m, n) holds W[m][n]. Inputs move right along the rows and partial
+ *   sums move down the columns, one PE per cycle, with the PEs of a row
+ *   updated by one nvhls::vector_mac.
+ * - Row m of the input is delayed by m cycles on the way in and column n
+ *   of the output by N-1-n cycles on the way out, so vectors go in and
+ *   come out whole. An output leaves Latency = M+N-1 calls after its
+ *   input, and the array takes a vector in every call.
+ * - The weights are double-buffered, in a mem_array_sep with one bank of
+ *   two entries per PE. load_weights() writes a row of the shadow copy
+ *   while the array runs; swap_weights() makes it active from the next
+ *   input on, and the inputs already in the array finish with the old
+ *   weights. The old copy may be loaded again once can_load() is true,
+ *   Latency calls after the swap at most.
+ * - In the functional mode of nvhls::Sampling, an input is computed in
+ *   the call it enters, with out valid in the same call, once the inputs
+ *   already in the array are out. This skips the PE registers for fast
+ *   exploration of array sizes; the detailed mode is what synthesizes.
+ * .
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <SystolicArray.h>
+ *
+ *      ...
+ *      typedef SystolicArray<16, 16, NVINT8, NVINT32> Array;
+ *      Array array;
+ *      Array::WeightRow w;
+ *      Array::InVec in;
+ *      Array::OutVec out;
+ *      ...
+ *      for (int m = 0; m < 16; m++) {
+ *        array.load_weights(m, w);   // one row per cycle
+ *      }
+ *      array.swap_weights();
+ *      ...
+ *      // every cycle
+ *      bool out_valid = array.run(in_valid, in, out);
+ * \endcode
+ * \par
+ *
+ */
+template <unsigned int M, unsigned int N, typename InT, typename AccT>
+class SystolicArray {
+ public:
+  static const unsigned int Latency = M + N - 1;
+  typedef nvhls::nv_scvector<InT, M> InVec;
+  typedef nvhls::nv_scvector<AccT, N> OutVec;
+  typedef nvhls::nv_scvector<InT, N> WeightRow;
+  typedef NVUINTW(nvhls::index_width<M>::val) RowIndex;
+  typedef NVUINTW(N) ColMask;
+
+ protected:
+  typedef nvhls::nv_scvector<AccT, N> SumRow;
+  // Two copies of the weight of every PE, bank = m * N + n
+  typedef mem_array_sep<InT, 2 * M * N, M * N> Weights;
+  Weights weights;
+  // The copy that new inputs use
+  bool sel;
+
+  // Input skew: row m waits m cycles, skew[m][0] is the newest
+  InT skew[M][M];
+  bool skew_valid[M][M];
+  bool skew_sel[M][M];
+
+  // PE registers: the input passed right and the partial sum passed down
+  WeightRow act[M];
+  SumRow psum[M];
+  ColMask act_valid[M];
+  ColMask act_sel[M];
+
+  // Output deskew: column n waits N-1-n cycles, drain[n][0] is the newest
+  AccT drain[N][N];
+  bool drain_valid[N][N];
+
+ public:
+  SystolicArray() { reset(); }
+
+  void reset() {
+    sel = false;
+    #pragma hls_unroll yes
+    for (unsigned m = 0; m < M; m++) {
+      act_valid[m] = 0;
+      act_sel[m] = 0;
+      #pragma hls_unroll yes
+      for (unsigned d = 0; d < M; d++) {
+        skew_valid[m][d] = false;
+        skew_sel[m][d] = false;
+      }
+    }
+    #pragma hls_unroll yes
+    for (unsigned n = 0; n < N; n++) {
+      #pragma hls_unroll yes
+      for (unsigned d = 0; d < N; d++) {
+        drain_valid[n][d] = false;
+      }
+    }
+  }
+
+  // Writes row m of the weights that the next swap_weights() makes active
+  void load_weights(RowIndex m, const WeightRow& row) {
+    NVHLS_ASSERT_MSG(m < M, "weight row out of bounds");
+    NVHLS_ASSERT_MSG(can_load(), "inputs in the array still use the shadow weights");
+    #pragma hls_unroll yes
+    for (unsigned n = 0; n < N; n++) {
+      weights.write(!sel, m * N + n, row[n]);
+    }
+  }
+
+  void swap_weights() { sel = !sel; }
+
+  // True when no input in the array uses the shadow weights
+  bool can_load() {
+    bool busy = false;
+    #pragma hls_unroll yes
+    for (unsigned m = 0; m < M; m++) {
+      #pragma hls_unroll yes
+      for (unsigned d = 0; d < M; d++) {
+        if (d < m && skew_valid[m][d] && skew_sel[m][d] != sel) {
+          busy = true;
+        }
+      }
+      #pragma hls_unroll yes
+      for (unsigned n = 0; n < N; n++) {
+        if (act_valid[m][n] && (act_sel[m][n] == 1) != sel) {
+          busy = true;
+        }
+      }
+    }
+    return !busy;
+  }
+
+  // True when no input is in the array
+  bool is_empty() {
+    bool empty = true;
+    #pragma hls_unroll yes
+    for (unsigned m = 0; m < M; m++) {
+      if (act_valid[m] != 0) {
+        empty = false;
+      }
+      #pragma hls_unroll yes
+      for (unsigned d = 0; d < M; d++) {
+        if (d < m && skew_valid[m][d]) {
+          empty = false;
+        }
+      }
+    }
+    #pragma hls_unroll yes
+    for (unsigned n = 0; n < N; n++) {
+      #pragma hls_unroll yes
+      for (unsigned d = 0; d < N; d++) {
+        if (d + n + 1 < N && drain_valid[n][d]) {
+          empty = false;
+        }
+      }
+    }
+    return empty;
+  }
+
+  // One cycle: takes in when in_valid, returns whether out holds an output
+  bool run(bool in_valid, const InVec& in, OutVec& out) {
+#ifndef __SYNTHESIS__
+    if (nvhls::Sampling::Functional() && is_empty()) {
+      if (in_valid) {
+        run_functional(in, out);
+      }
+      return in_valid;
+    }
+#endif
+    // The old end of every deskew chain, or the bottom PE when it has none
+    bool out_valid = (act_valid[M - 1][N - 1] == 1);
+    #pragma hls_unroll yes
+    for (unsigned n = 0; n < N; n++) {
+      if (n == N - 1) {
+        out[n] = psum[M - 1][n];
+      } else {
+        out[n] = drain[n][N - 2 - n];
+      }
+    }
+
+    // Columns enter their deskew chains from the bottom row
+    #pragma hls_unroll yes
+    for (unsigned n = 0; n < N; n++) {
+      #pragma hls_unroll yes
+      for (int d = N - 1; d > 0; d--) {
+        drain[n][d] = drain[n][d - 1];
+        drain_valid[n][d] = drain_valid[n][d - 1];
+      }
+      drain[n][0] = psum[M - 1][n];
+      drain_valid[n][0] = (act_valid[M - 1][n] == 1);
+    }
+
+    // Bottom row first, so that every row reads the old registers above it
+    #pragma hls_unroll yes
+    for (int m = M - 1; m >= 0; m--) {
+      WeightRow a;
+      WeightRow w;
+      SumRow p_in;
+      bool v[N];
+      bool s[N];
+      #pragma hls_unroll yes
+      for (unsigned n = 0; n < N; n++) {
+        if (n > 0) {
+          a[n] = act[m][n - 1];
+          v[n] = (act_valid[m][n - 1] == 1);
+          s[n] = (act_sel[m][n - 1] == 1);
+        } else if (m > 0) {
+          a[n] = skew[m][m - 1];
+          v[n] = skew_valid[m][m - 1];
+          s[n] = skew_sel[m][m - 1];
+        } else {
+          a[n] = in[0];
+          v[n] = in_valid;
+          s[n] = sel;
+        }
+        w[n] = weights.read(s[n], m * N + n);
+        p_in[n] = (m == 0) ? AccT(0) : psum[m - 1][n];
+      }
+      nvhls::vector_mac<InT, InT, AccT, AccT, N, true>(a, w, p_in, psum[m]);
+      act[m] = a;
+      #pragma hls_unroll yes
+      for (unsigned n = 0; n < N; n++) {
+        act_valid[m][n] = v[n];
+        act_sel[m][n] = s[n];
+      }
+    }
+
+    // Row m of the input enters its skew chain
+    #pragma hls_unroll yes
+    for (unsigned m = 1; m < M; m++) {
+      #pragma hls_unroll yes
+      for (int d = M - 1; d > 0; d--) {
+        skew[m][d] = skew[m][d - 1];
+        skew_valid[m][d] = skew_valid[m][d - 1];
+        skew_sel[m][d] = skew_sel[m][d - 1];
+      }
+      skew[m][0] = in[m];
+      skew_valid[m][0] = in_valid;
+      skew_sel[m][0] = sel;
+    }
+    return out_valid;
+  }
+
+ protected:
+  void run_functional(const InVec& in, OutVec& out) {
+    SumRow acc;
+    #pragma hls_unroll yes
+    for (unsigned n = 0; n < N; n++) {
+      acc[n] = 0;
+    }
+    for (unsigned m = 0; m < M; m++) {
+      WeightRow a, w;
+      for (unsigned n = 0; n < N; n++) {
+        a[n] = in[m];
+        w[n] = weights.read(sel, m * N + n);
+      }
+      nvhls::vector_mac_inplace<InT, InT, AccT, N, true>(a, w, acc);
+    }
+    out = acc;
+  }
+};
+
+#endif  // SYSTOLIC_ARRAY_H
@@ -20,6 +20,7 @@
 #include <nvhls_int.h>
 #include <nvhls_types.h>
 #include <nvhls_marshaller.h>
+#include <nvhls_packed_marshaller.h>
 
 /**
  * \brief Convert Type to logic vector 
@@ -41,12 +42,19 @@
  *
  * \endcode
  * \par
+ * In C simulation, types declared with NVHLS_PACKED_MESSAGE are packed with
+ * nvhls::PackedMarshaller instead of Marshaller; the bits are identical.
  *
  */
 
 template <typename T>
 sc_lv<Wrapped<T>::width> TypeToBits(T in)
 {
+#ifndef __SYNTHESIS__
+  if (nvhls::is_packed_message<T>::value) {
+    return nvhls::packed_bits<T>::ToBits(in);
+  }
+#endif
   Marshaller<Wrapped<T>::width> marshaller;
   Wrapped<T> wm(in);
   wm.Marshall(marshaller);
@@ -80,6 +88,11 @@ sc_lv<Wrapped<T>::width> TypeToBits(T in)
 template <typename T>
 T BitsToType(sc_lv<Wrapped<T>::width> mbits)
 {
+#ifndef __SYNTHESIS__
+  if (nvhls::is_packed_message<T>::value) {
+    return nvhls::packed_bits<T>::FromBits(mbits);
+  }
+#endif
   Marshaller<Wrapped<T>::width> marshaller(mbits);
   Wrapped<T> result;
   result.Marshall(marshaller);
@@ -114,6 +127,11 @@ T BitsToType(sc_lv<Wrapped<T>::width> mbits)
 template <typename T>
 NVUINTW(Wrapped<T>::width) TypeToNVUINT(T in)
 {
+#ifndef __SYNTHESIS__
+  if (nvhls::is_packed_message<T>::value) {
+    return nvhls::packed_bits<T>::ToNVUINT(in);
+  }
+#endif
   return BitsToType<NVUINTW(Wrapped<T>::width)>(TypeToBits(in));
 }
 
@@ -143,6 +161,11 @@ NVUINTW(Wrapped<T>::width) TypeToNVUINT(T in)
 template <typename T>
 T NVUINTToType(const NVUINTW(Wrapped<T>::width) & uintbits)
 {
+#ifndef __SYNTHESIS__
+  if (nvhls::is_packed_message<T>::value) {
+    return nvhls::packed_bits<T>::FromNVUINT(uintbits);
+  }
+#endif
   return BitsToType<T>(TypeToBits(uintbits));
 }
 
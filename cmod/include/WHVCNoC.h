@@ -0,0 +1,723 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __WHVCNOC_H__
+#define __WHVCNOC_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_packet.h>
+#include <nvhls_serdes.h>
+#include <nvhls_array.h>
+#include <nvhls_assert.h>
+#include <hls_globals.h>
+#include <WHVCRouter.h>
+
+/**
+ * \brief Injection network interface of WHVCNoC
+ * \ingroup WHVCNoC
+ *
+ * \tparam Packet_t         Packet type of the NoC
+ * \tparam Flit_t           Flit type of the NoC
+ * \tparam MeshX            Number of routers along X
+ * \tparam MeshY            Number of routers along Y
+ * \tparam NumVchannels     Number of virtual channels
+ * \tparam BufferSize       Input buffer size of the routers, per VC
+ * \tparam Torus            Routes may use the wraparound links
+ * \tparam VariableLength   Drop trailing all-zero flits, see serializer
+ * \tparam Express          Span of the express links, 0 if there are none
+ *
+ * \par Overview
+ * Replaces the destination <Dest Y> <Dest X> in the dest field of each
+ * packet with the source route from (node_x, node_y), serializes the packet
+ * with serializer, and sends the flits to the local port of the router under
+ * per-VC credit flow control.
+ * - Routes are dimension order, X then Y. On a torus each dimension takes
+ *   the shorter way around, east or north on a tie.
+ * - With express links, each dimension first takes as many express hops of
+ *   Express routers as fit, then single hops for the rest of the way.
+ * - On a mesh the packet travels on the VC in the LSBs of packet_id. On a
+ *   torus the VC is set to 1 if the route crosses the X wraparound link plus
+ *   2 if it crosses the Y one: every VC then uses either no wraparound link
+ *   or only minimal routes through one, neither of which closes a cycle
+ *   around a ring.
+ */
+template <typename Packet_t, typename Flit_t, int MeshX, int MeshY,
+          int NumVchannels, int BufferSize, bool Torus,
+          bool VariableLength = false, int Express = 0>
+class WHVCNoCInjector : public sc_module {
+ public:
+  enum {
+    num_lports = 1,
+    num_rports = Express > 0 ? 8 : 4,
+    x_width = nvhls::index_width<MeshX>::val,
+    y_width = nvhls::index_width<MeshY>::val,
+    log_num_vchannels = nvhls::index_width<NumVchannels>::val,
+    dest_width_per_hop = nvhls::index_width<num_rports>::val + num_lports,
+    max_hops = Packet_t::dest_width / dest_width_per_hop,
+    port_east = 0,
+    port_west = 1,
+    port_north = 2,
+    port_south = 3,
+    // Express ports are the single-hop ports plus port_express
+    port_express = 4,
+    express_span = Express > 0 ? Express : 1
+  };
+  static_assert(!Torus || Express == 0, "Express links are only for a mesh");
+  static_assert(Packet_t::packet_id_width >= log_num_vchannels,
+                "packet_id must hold the VC");
+  static_assert(!Torus || NumVchannels >= 4,
+                "A torus needs 4 VCs for its wraparound links");
+  typedef NVUINTW(1) Credit_ret_t;
+  typedef NVUINTW(nvhls::index_width<BufferSize + 1>::val) Credit_t;
+  // Wide enough for a whole dimension before it is cut into express hops
+  typedef NVUINTW(nvhls::index_width<MeshX + MeshY + max_hops>::val) Hops_t;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  sc_in<NVUINTW(x_width)> node_x;
+  sc_in<NVUINTW(y_width)> node_y;
+
+  Connections::In<Packet_t> in_packet;
+  Connections::Out<Flit_t> out_flit;
+  Connections::In<Credit_ret_t> in_credit[NumVchannels];
+
+  serializer<Packet_t, Flit_t, WormHole, VariableLength> ser;
+  Connections::Combinational<Packet_t> ser_in;
+  Connections::Combinational<Flit_t> ser_out;
+  Connections::Out<Packet_t> to_ser;
+  Connections::In<Flit_t> from_ser;
+
+  SC_HAS_PROCESS(WHVCNoCInjector);
+  WHVCNoCInjector(sc_module_name name_)
+      : sc_module(name_),
+        clk("clk"),
+        rst("rst"),
+        node_x("node_x"),
+        node_y("node_y"),
+        in_packet("in_packet"),
+        out_flit("out_flit"),
+        ser("ser"),
+        ser_in("ser_in"),
+        ser_out("ser_out"),
+        to_ser("to_ser"),
+        from_ser("from_ser") {
+    ser.clk(clk);
+    ser.rst(rst);
+    ser.in_packet(ser_in);
+    ser.out_flit(ser_out);
+    to_ser(ser_in);
+    from_ser(ser_out);
+
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  // Hops and direction along one dimension, from src to dst in a ring or a
+  // line of Size routers. wrap is set if the route crosses the wraparound
+  // link.
+  template <int Size, typename Coord_t>
+  static void dimension_route(Coord_t src, Coord_t dst, Hops_t& hops,
+                              bool& positive, bool& wrap) {
+    Hops_t dist = dst - src;
+    if (dst < src) {
+      dist = Size - (src - dst);
+    }
+    if (Torus) {
+      positive = (2 * dist <= Size);
+      wrap = positive ? (dst < src) : (dst > src);
+    } else {
+      positive = (dst >= src);
+      wrap = false;
+    }
+    hops = dist;
+    if (!positive) {
+      hops = Size - dist;
+    }
+  }
+
+  // Source route: one <Remote Dst> <Local Dst> field per hop, as consumed by
+  // WHVCSourceRouting, ending with local port 0 of the destination router
+  void route(Packet_t& packet) {
+    NVUINTW(x_width) dest_x = nvhls::get_slc<x_width>(packet.dest, 0);
+    NVUINTW(y_width) dest_y = nvhls::get_slc<y_width>(packet.dest, x_width);
+    Hops_t hops_x, hops_y;
+    bool east, north, wrap_x, wrap_y;
+    dimension_route<MeshX>(node_x.read(), dest_x, hops_x, east, wrap_x);
+    dimension_route<MeshY>(node_y.read(), dest_y, hops_y, north, wrap_y);
+
+    // Express hops first, then what is left of each dimension
+    Hops_t express_x = 0, express_y = 0;
+    if (Express > 0) {
+      express_x = hops_x / express_span;
+      express_y = hops_y / express_span;
+      hops_x = express_x + hops_x % express_span;
+      hops_y = express_y + hops_y % express_span;
+    }
+
+    NVUINTW(Packet_t::dest_width) dest = 0;
+#pragma hls_unroll yes
+    for (int k = 0; k < max_hops; k++) {
+      NVUINTW(dest_width_per_hop) hop = 0;
+      if (k < express_x) {
+        hop = (port_express + (east ? port_east : port_west)) << num_lports;
+      } else if (k < hops_x) {
+        hop = (east ? port_east : port_west) << num_lports;
+      } else if (k < hops_x + express_y) {
+        hop = (port_express + (north ? port_north : port_south)) << num_lports;
+      } else if (k < hops_x + hops_y) {
+        hop = (north ? port_north : port_south) << num_lports;
+      } else if (k == hops_x + hops_y) {
+        hop = 1;
+      }
+      dest = nvhls::set_slc(dest, hop, k * dest_width_per_hop);
+    }
+    packet.dest = dest;
+
+    if (Torus) {
+      NVUINTW(log_num_vchannels) vc = (wrap_y ? 2 : 0) + (wrap_x ? 1 : 0);
+      packet.packet_id = nvhls::set_slc(packet.packet_id, vc, 0);
+    }
+  }
+
+  void run() {
+    in_packet.Reset();
+    out_flit.Reset();
+    to_ser.Reset();
+    from_ser.Reset();
+    Credit_t credit[NumVchannels];
+#pragma hls_unroll yes
+    for (int i = 0; i < NumVchannels; i++) {
+      in_credit[i].Reset();
+      credit[i] = BufferSize;
+    }
+    Packet_t packet;
+    bool packet_valid = false;
+    Flit_t flit;
+    bool flit_valid = false;
+
+    #pragma hls_pipeline_init_interval 1
+    while (1) {
+      wait();
+#pragma hls_unroll yes
+      for (int i = 0; i < NumVchannels; i++) {
+        Credit_ret_t credit_in;
+        if (in_credit[i].PopNB(credit_in)) {
+          credit[i] += credit_in;
+        }
+        NVHLS_ASSERT_MSG(credit[i] <= BufferSize, "Total credits received cannot be larger than Buffer size");
+      }
+
+      // Route, then hand the packet to the serializer
+      if (!packet_valid) {
+        packet_valid = in_packet.PopNB(packet);
+        if (packet_valid) {
+          route(packet);
+        }
+      }
+      if (packet_valid && to_ser.PushNB(packet)) {
+        packet_valid = false;
+      }
+
+      // Forward flits to the router while their VC has credits
+      if (!flit_valid) {
+        flit_valid = from_ser.PopNB(flit);
+      }
+      if (flit_valid) {
+        NVUINTW(log_num_vchannels) vc = 0;
+        if (NumVchannels > 1) {
+          vc = nvhls::get_slc<log_num_vchannels>(flit.packet_id, 0);
+        }
+        if (credit[vc] != 0 && out_flit.PushNB(flit)) {
+          credit[vc]--;
+          flit_valid = false;
+        }
+      }
+    }
+  }
+};
+
+/**
+ * \brief Ejection network interface of WHVCNoC
+ * \ingroup WHVCNoC
+ *
+ * \tparam Packet_t         Packet type of the NoC
+ * \tparam Flit_t           Flit type of the NoC
+ * \tparam NumVchannels     Number of virtual channels
+ *
+ * \par Overview
+ * Flits of different VCs may interleave at the local port of a router, so
+ * every VC has its own deserializer. Each flit taken from the router goes
+ * to the deserializer of its VC and returns one credit to the router; the
+ * deserialized packets are merged round-robin into out_packet. The dest
+ * field of an ejected packet holds what is left of the route, i.e. 0.
+ */
+template <typename Packet_t, typename Flit_t, int NumVchannels>
+class WHVCNoCEjector : public sc_module {
+ public:
+  enum {
+    log_num_vchannels = nvhls::index_width<NumVchannels>::val
+  };
+  typedef NVUINTW(1) Credit_ret_t;
+  typedef deserializer<Packet_t, Flit_t, 0, WormHole> Deserializer_t;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::In<Flit_t> in_flit;
+  Connections::Out<Credit_ret_t> out_credit[NumVchannels];
+  Connections::Out<Packet_t> out_packet;
+
+  nvhls::nv_array<Deserializer_t, NumVchannels> deser;
+  Connections::Combinational<Flit_t> deser_in[NumVchannels];
+  Connections::Combinational<Packet_t> deser_out[NumVchannels];
+  Connections::Out<Flit_t> to_deser[NumVchannels];
+  Connections::In<Packet_t> from_deser[NumVchannels];
+
+  SC_HAS_PROCESS(WHVCNoCEjector);
+  WHVCNoCEjector(sc_module_name name_)
+      : sc_module(name_),
+        clk("clk"),
+        rst("rst"),
+        in_flit("in_flit"),
+        out_packet("out_packet"),
+        deser("deser") {
+    for (int i = 0; i < NumVchannels; i++) {
+      deser[i].clk(clk);
+      deser[i].rst(rst);
+      deser[i].in_flit(deser_in[i]);
+      deser[i].out_packet(deser_out[i]);
+      to_deser[i](deser_in[i]);
+      from_deser[i](deser_out[i]);
+    }
+
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void run() {
+    in_flit.Reset();
+    out_packet.Reset();
+    bool credit_send[NumVchannels];
+#pragma hls_unroll yes
+    for (int i = 0; i < NumVchannels; i++) {
+      out_credit[i].Reset();
+      to_deser[i].Reset();
+      from_deser[i].Reset();
+      credit_send[i] = false;
+    }
+    NVUINTW(log_num_vchannels) next_vc = 0;
+    Flit_t flit;
+    bool flit_valid = false;
+    Packet_t packet;
+    bool packet_valid = false;
+
+    #pragma hls_pipeline_init_interval 1
+    while (1) {
+      wait();
+      // One credit per flit, and at most one flit per cycle
+#pragma hls_unroll yes
+      for (int i = 0; i < NumVchannels; i++) {
+        if (credit_send[i]) {
+          Credit_ret_t credit_out = 1;
+          credit_send[i] = !out_credit[i].PushNB(credit_out);
+        }
+      }
+
+      if (!flit_valid) {
+        flit_valid = in_flit.PopNB(flit);
+      }
+      if (flit_valid) {
+        NVUINTW(log_num_vchannels) vc = 0;
+        if (NumVchannels > 1) {
+          vc = nvhls::get_slc<log_num_vchannels>(flit.packet_id, 0);
+        }
+#pragma hls_unroll yes
+        for (int i = 0; i < NumVchannels; i++) {
+          if (vc == i && !credit_send[i] && to_deser[i].PushNB(flit)) {
+            credit_send[i] = true;
+            flit_valid = false;
+          }
+        }
+      }
+
+      if (!packet_valid) {
+#pragma hls_unroll yes
+        for (int k = 0; k < NumVchannels; k++) {
+          int i = (next_vc + k) % NumVchannels;
+          if (!packet_valid && from_deser[i].PopNB(packet)) {
+            packet_valid = true;
+            next_vc = (i + 1) % NumVchannels;
+          }
+        }
+      }
+      if (packet_valid && out_packet.PushNB(packet)) {
+        packet_valid = false;
+      }
+    }
+  }
+};
+
+/**
+ * \brief Tie-off for a router port on the boundary of a mesh
+ * \ingroup WHVCNoC
+ *
+ * \par Overview
+ * Owns the channels of an unconnected router port, never sends a flit or a
+ * credit, and never accepts a flit. Source routes never use the port.
+ */
+template <typename Flit_t, int NumVchannels>
+class WHVCNoCEdge : public sc_module {
+ public:
+  typedef NVUINTW(1) Credit_ret_t;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  // Channels bound to the router
+  Connections::Combinational<Flit_t> to_router;
+  Connections::Combinational<Flit_t> from_router;
+  Connections::Combinational<Credit_ret_t> credit_to_router[NumVchannels];
+  Connections::Combinational<Credit_ret_t> credit_from_router[NumVchannels];
+
+  Connections::Out<Flit_t> out_flit;
+  Connections::In<Flit_t> in_flit;
+  Connections::Out<Credit_ret_t> out_credit[NumVchannels];
+  Connections::In<Credit_ret_t> in_credit[NumVchannels];
+
+  SC_HAS_PROCESS(WHVCNoCEdge);
+  WHVCNoCEdge(sc_module_name name_)
+      : sc_module(name_),
+        clk("clk"),
+        rst("rst"),
+        to_router("to_router"),
+        from_router("from_router"),
+        out_flit("out_flit"),
+        in_flit("in_flit") {
+    out_flit(to_router);
+    in_flit(from_router);
+    for (int i = 0; i < NumVchannels; i++) {
+      out_credit[i](credit_to_router[i]);
+      in_credit[i](credit_from_router[i]);
+    }
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void run() {
+    out_flit.Reset();
+    in_flit.Reset();
+    for (int i = 0; i < NumVchannels; i++) {
+      out_credit[i].Reset();
+      in_credit[i].Reset();
+    }
+    while (1) {
+      wait();
+    }
+  }
+};
+
+/**
+ * \brief 2D mesh or torus NoC of source-routed WHVCRouters
+ * \ingroup WHVCNoC
+ *
+ * \tparam MeshX            Number of routers along X
+ * \tparam MeshY            Number of routers along Y
+ * \tparam NumVchannels     Number of virtual channels, at least 4 on a torus
+ * \tparam BufferSize       Input buffer size of the routers, per VC
+ * \tparam FlitDataWidth    Data width of a flit
+ * \tparam PacketDataWidth  Data width of a packet
+ * \tparam PacketIdWidth    Width of packet_id, at least log2(NumVchannels)
+ * \tparam Torus            Add wraparound links (default false, a mesh)
+ * \tparam VariableLength   Send each packet in as few flits as its nonzero
+ *                          data needs (default false)
+ * \tparam Express          Add express links that skip Express - 1 routers,
+ *                          on a mesh only (default 0, none)
+ *
+ * \par Overview
+ * Builds a MeshX x MeshY array of WHVCSourceRouter with one endpoint each.
+ * Endpoint n = y * MeshX + x sits at router (x, y) and has a
+ * WHVCNoCInjector on in_packet[n] and a WHVCNoCEjector on out_packet[n].
+ * - Remote ports are east (+X), west (-X), north (+Y) and south (-Y), as in
+ *   WHVCDimOrderRouting. Boundary ports of a mesh are tied off.
+ * - A packet pushed into in_packet carries its destination router in the
+ *   LSBs of dest, as <Dest Y> <Dest X>; the NoC replaces it with the source
+ *   route. The other fields arrive unchanged at out_packet of the
+ *   destination, except for the VC bits of packet_id on a torus.
+ * - Packets from one endpoint to another on the same VC arrive in order.
+ * - With Express > 0, every router also has express ports 4 to 7, in the
+ *   same directions, linked to the router Express hops away. Routes take the
+ *   express links first in each dimension, so a packet crosses a dimension of
+ *   D routers in D / Express + D % Express hops. Routes still only move
+ *   towards the destination, X before Y, and stay free of deadlock.
+ *   Credits flow on express links as on all other links; for full bandwidth
+ *   on an express link that is pipelined in the physical design, BufferSize
+ *   must cover its credit round trip.
+ * .
+ * The header flit carries the route of up to MaxX + MaxY + 1 hops, with
+ * MaxX = MeshX - 1 on a mesh and MeshX / 2 on a torus, at 3 bits per hop (4
+ * with express links), and must still have room for packet data; a 16x16
+ * mesh therefore needs flits wider than 93 bits. Express links cut MaxX to at
+ * most (MeshX - 1) / Express + Express - 1. MeshNoC and TorusNoC fix Torus.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <WHVCNoC.h>
+ *
+ *      ...
+ *        typedef MeshNoC<8, 8, 2, 4, 64, 256, 8> NoC_t;
+ *        NoC_t noc;
+ *        Connections::Combinational<NoC_t::Packet_t> in_chan[NoC_t::num_nodes];
+ *        Connections::Combinational<NoC_t::Packet_t> out_chan[NoC_t::num_nodes];
+ *
+ *        noc.clk(clk);
+ *        noc.rst(rst);
+ *        for (int n = 0; n < NoC_t::num_nodes; n++) {
+ *          noc.in_packet[n](in_chan[n]);
+ *          noc.out_packet[n](out_chan[n]);
+ *        }
+ *        ...
+ *        NoC_t::Packet_t packet;
+ *        packet.dest = (dest_y << NoC_t::x_width) | dest_x;   // or endpoint_dest()
+ *        in_chan[src].Push(packet);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <int MeshX, int MeshY, int NumVchannels, int BufferSize,
+          int FlitDataWidth, int PacketDataWidth, int PacketIdWidth,
+          bool Torus = false, bool VariableLength = false, int Express = 0>
+class WHVCNoC : public sc_module {
+ public:
+  enum {
+    mesh_x = MeshX,
+    mesh_y = MeshY,
+    num_nodes = MeshX * MeshY,
+    num_lports = 1,
+    num_rports = Express > 0 ? 8 : 4,
+    num_vchannels = NumVchannels,
+    express = Express,
+    x_width = nvhls::index_width<MeshX>::val,
+    y_width = nvhls::index_width<MeshY>::val,
+    dest_width_per_hop = nvhls::index_width<num_rports>::val + num_lports,
+    // most hops along a dimension of Size routers, taking express hops first
+    express_span = Express > 0 ? Express : 1,
+    max_hops_x = Express > 0 && (MeshX - 1) / express_span + express_span - 1 < MeshX - 1
+                     ? (MeshX - 1) / express_span + express_span - 1 : MeshX - 1,
+    max_hops_y = Express > 0 && (MeshY - 1) / express_span + express_span - 1 < MeshY - 1
+                     ? (MeshY - 1) / express_span + express_span - 1 : MeshY - 1,
+    max_hops = Torus ? (MeshX / 2 + MeshY / 2 + 1) : (max_hops_x + max_hops_y + 1),
+    // boundary ports of a mesh, plus the express ports without a router
+    // Express hops away; a torus has none but keeps one unused edge
+    express_edges_x = Express > 0 ? (Express < MeshX ? Express : MeshX) : 0,
+    express_edges_y = Express > 0 ? (Express < MeshY ? Express : MeshY) : 0,
+    num_edges = Torus ? 1 : 2 * (MeshX + MeshY) + 2 * (MeshY * express_edges_x +
+                                                       MeshX * express_edges_y)
+  };
+  static_assert(MeshX >= 2 && MeshY >= 2, "NoC needs at least 2x2 routers");
+  static_assert(Express >= 0 && (Express == 0 || Express >= 2),
+                "Express links span at least 2 routers");
+  static_assert(!Torus || Express == 0, "Express links are only for a mesh");
+  static_assert(x_width + y_width <= dest_width_per_hop * max_hops,
+                "Packet dest must hold the destination coordinates");
+
+  typedef Packet<PacketDataWidth, dest_width_per_hop, max_hops, PacketIdWidth> Packet_t;
+  typedef Flit<FlitDataWidth, 0, 0, PacketIdWidth, FlitId2bit, WormHole> Flit_t;
+  static_assert(PacketIdWidth > 0, "The serializer needs a packet_id");
+  static_assert(FlitDataWidth > Packet_t::dest_width,
+                "Header flit must hold the route and some packet data");
+  static_assert(PacketDataWidth > FlitDataWidth - Packet_t::dest_width,
+                "Packet must need a header and a tail flit");
+
+  typedef WHVCSourceRouter<num_lports, num_rports, NumVchannels, BufferSize,
+                           Flit_t, max_hops> Router_t;
+  typedef WHVCNoCInjector<Packet_t, Flit_t, MeshX, MeshY, NumVchannels,
+                          BufferSize, Torus, VariableLength, Express> Injector_t;
+  typedef WHVCNoCEjector<Packet_t, Flit_t, NumVchannels> Ejector_t;
+  typedef WHVCNoCEdge<Flit_t, NumVchannels> Edge_t;
+  typedef typename Router_t::Credit_ret_t Credit_ret_t;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::In<Packet_t> in_packet[num_nodes];
+  Connections::Out<Packet_t> out_packet[num_nodes];
+
+  nvhls::nv_array<Router_t, num_nodes> router;
+  nvhls::nv_array<Injector_t, num_nodes> injector;
+  nvhls::nv_array<Ejector_t, num_nodes> ejector;
+  nvhls::nv_array<Edge_t, num_edges> edge;
+
+  sc_signal<NVUINTW(x_width)> node_x[num_nodes];
+  sc_signal<NVUINTW(y_width)> node_y[num_nodes];
+
+  // Local port of every router
+  Connections::Combinational<Flit_t> inject_flit[num_nodes];
+  Connections::Combinational<Flit_t> eject_flit[num_nodes];
+  Connections::Combinational<Credit_ret_t> inject_credit[num_nodes * NumVchannels];
+  Connections::Combinational<Credit_ret_t> eject_credit[num_nodes * NumVchannels];
+
+  // Link leaving remote port p of router n, indexed n * num_rports + p, and
+  // the credits returned on it, indexed (n * num_rports + p) * NumVchannels
+  // + vc
+  Connections::Combinational<Flit_t> link_flit[num_nodes * num_rports];
+  Connections::Combinational<Credit_ret_t> link_credit[num_nodes * num_rports * NumVchannels];
+
+  // dest of a packet to endpoint n
+  static NVUINTW(x_width + y_width) endpoint_dest(int n) {
+    return (NVUINTW(x_width + y_width)(n / MeshX) << x_width) | (n % MeshX);
+  }
+
+  // Neighbor of router n through remote port p, or -1 on a mesh boundary.
+  // Express ports 4 to 7 reach Express routers away.
+  static int neighbor(int n, int p) {
+    int x = n % MeshX;
+    int y = n / MeshX;
+    int step = (p >= 4) ? Express : 1;
+    switch (p % 4) {
+      case 0: x += step; break;
+      case 1: x -= step; break;
+      case 2: y += step; break;
+      default: y -= step; break;
+    }
+    if (Torus) {
+      x = (x + MeshX) % MeshX;
+      y = (y + MeshY) % MeshY;
+    } else if (x < 0 || x >= MeshX || y < 0 || y >= MeshY) {
+      return -1;
+    }
+    return y * MeshX + x;
+  }
+
+  // Remote port on the other end of a link: east <-> west, north <-> south,
+  // on the same kind of link
+  static int opposite(int p) { return p ^ 1; }
+
+  SC_HAS_PROCESS(WHVCNoC);
+  WHVCNoC(sc_module_name name_)
+      : sc_module(name_),
+        clk("clk"),
+        rst("rst"),
+        router("router"),
+        injector("injector"),
+        ejector("ejector"),
+        edge("edge") {
+    static const int L = num_lports;
+    static const int V = NumVchannels;
+    for (int e = 0; e < num_edges; e++) {
+      edge[e].clk(clk);
+      edge[e].rst(rst);
+    }
+    int num_edge = 0;
+    for (int n = 0; n < num_nodes; n++) {
+      router[n].clk(clk);
+      router[n].rst(rst);
+      injector[n].clk(clk);
+      injector[n].rst(rst);
+      injector[n].node_x(node_x[n]);
+      injector[n].node_y(node_y[n]);
+      ejector[n].clk(clk);
+      ejector[n].rst(rst);
+
+      // Endpoint on local port 0
+      injector[n].in_packet(in_packet[n]);
+      injector[n].out_flit(inject_flit[n]);
+      router[n].in_port[0](inject_flit[n]);
+      router[n].out_port[0](eject_flit[n]);
+      ejector[n].in_flit(eject_flit[n]);
+      ejector[n].out_packet(out_packet[n]);
+      for (int vc = 0; vc < V; vc++) {
+        router[n].out_credit[vc](inject_credit[n * V + vc]);
+        injector[n].in_credit[vc](inject_credit[n * V + vc]);
+        ejector[n].out_credit[vc](eject_credit[n * V + vc]);
+        router[n].in_credit[vc](eject_credit[n * V + vc]);
+      }
+
+      for (int p = 0; p < num_rports; p++) {
+        int m = neighbor(n, p);
+        int link = n * num_rports + p;
+        if (m >= 0) {
+          // Output side of the link here, input side at the neighbor. The
+          // input side of this port is bound from the neighbor's loop.
+          int q = opposite(p);
+          router[n].out_port[L + p](link_flit[link]);
+          router[m].in_port[L + q](link_flit[link]);
+          for (int vc = 0; vc < V; vc++) {
+            router[n].in_credit[(L + p) * V + vc](link_credit[link * V + vc]);
+            router[m].out_credit[(L + q) * V + vc](link_credit[link * V + vc]);
+          }
+        } else {
+          Edge_t& tie = edge[num_edge++];
+          router[n].out_port[L + p](tie.from_router);
+          router[n].in_port[L + p](tie.to_router);
+          for (int vc = 0; vc < V; vc++) {
+            router[n].in_credit[(L + p) * V + vc](tie.credit_to_router[vc]);
+            router[n].out_credit[(L + p) * V + vc](tie.credit_from_router[vc]);
+          }
+        }
+      }
+    }
+    NVHLS_ASSERT_MSG(Torus || num_edge == num_edges, "Mesh boundary miscounted");
+
+    SC_METHOD(tie_coordinates);
+  }
+
+  // Runs once at initialization
+  void tie_coordinates() {
+    for (int n = 0; n < num_nodes; n++) {
+      node_x[n].write(n % MeshX);
+      node_y[n].write(n / MeshX);
+    }
+  }
+};
+
+/**
+ * \brief 2D mesh NoC, see WHVCNoC
+ * \ingroup WHVCNoC
+ */
+template <int MeshX, int MeshY, int NumVchannels, int BufferSize,
+          int FlitDataWidth, int PacketDataWidth, int PacketIdWidth,
+          bool VariableLength = false, int Express = 0>
+class MeshNoC : public WHVCNoC<MeshX, MeshY, NumVchannels, BufferSize,
+                               FlitDataWidth, PacketDataWidth, PacketIdWidth,
+                               false, VariableLength, Express> {
+ public:
+  MeshNoC(sc_module_name name_)
+      : WHVCNoC<MeshX, MeshY, NumVchannels, BufferSize, FlitDataWidth,
+                PacketDataWidth, PacketIdWidth, false, VariableLength, Express>(name_) {}
+};
+
+/**
+ * \brief 2D torus NoC, see WHVCNoC
+ * \ingroup WHVCNoC
+ */
+template <int MeshX, int MeshY, int NumVchannels, int BufferSize,
+          int FlitDataWidth, int PacketDataWidth, int PacketIdWidth,
+          bool VariableLength = false>
+class TorusNoC : public WHVCNoC<MeshX, MeshY, NumVchannels, BufferSize,
+                                FlitDataWidth, PacketDataWidth, PacketIdWidth,
+                                true, VariableLength> {
+ public:
+  TorusNoC(sc_module_name name_)
+      : WHVCNoC<MeshX, MeshY, NumVchannels, BufferSize, FlitDataWidth,
+                PacketDataWidth, PacketIdWidth, true, VariableLength>(name_) {}
+};
+
+#endif  // __WHVCNOC_H__
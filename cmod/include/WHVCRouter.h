@@ -18,11 +18,15 @@
 #define __WHVCROUTER_H__
 
 // WormHole router with virtual channel and Multicast support.
-//   -Source Routing is assumed.
+//   -Routing is a policy of WHVCRouter: source routing (WHVCSourceRouter,
+//   described below), XY/YX dimension-order routing on a 2D mesh
+//   (WHVCDimOrderRouter), minimal adaptive routing on a 2D mesh
+//   (WHVCAdaptiveRouter), tree multicast on a 2D mesh (WHVCMulticastRouter)
+//   or per-router routing tables (WHVCTableRouter).
 //   -First flit stores route information.
-//   -Multi-cast to 1 remote port and many local ports.
-//   -Changing the destination format and route computation can allow multi-cast
-//   to all ports without distinction between local and remote ports.
+//   -A flit is forked to every output port of its route, in the same or in
+//   different cycles, and leaves the input buffer once all of them took it.
+//   -Source routing: multi-cast to 1 remote port and many local ports per hop.
 //   -Port numbers: local ports are numbered 0 to L-1, remote ports are numbered
 //   L to L+R-1.
 //   -1 hot encoding for local destination - send flit to port i if dest[i]=1.
@@ -41,13 +45,30 @@
 #include <Arbiter.h>
 #include <hls_globals.h>
 #include <fifo.h>
+#include <damq.h>
 #include <one_hot_to_bin.h>
 #include <nvhls_assert.h>
 #include <crossbar.h>
+#include <nvhls_module.h>
+
+// Input buffer of WHVCRouter: one FIFO bank of BufferSize entries per input
+// VC, or with SharedPoolSize != 0 one DAMQ pool of SharedPoolSize entries
+// per input port shared by its VCs.
+template <typename T, int BufferSize, int SharedPoolSize, int NumPorts,
+          int NumVchannels>
+struct WHVCInputBuffer {
+  typedef DAMQ<T, SharedPoolSize, NumVchannels, NumPorts> type;
+};
+
+template <typename T, int BufferSize, int NumPorts, int NumVchannels>
+struct WHVCInputBuffer<T, BufferSize, 0, NumPorts, NumVchannels> {
+  typedef FIFO<T, BufferSize, NumPorts * NumVchannels> type;
+};
 
 template <int NumLPorts, int NumRports, int NumVchannels, int BufferSize,
-          typename FlitType = Flit<64, 0, 0, 0, FlitId2bit, WormHole> >
-class WHVCRouterBase : public sc_module {
+          typename FlitType = Flit<64, 0, 0, 0, FlitId2bit, WormHole>,
+          int SharedPoolSize = 0, int CreditBatch = 1, int PipelineDepth = 1>
+class WHVCRouterBase : public match::Module {
 public:
   static const int kDebugLevel = 2;
   typedef FlitType Flit_t;
@@ -63,10 +84,27 @@ public:
     log_num_ports = nvhls::index_width<num_ports>::val,
     buffersize = BufferSize,
     log_buffersize = nvhls::index_width<buffersize>::val,
-    log_buffersizeplus1 = nvhls::index_width<buffersize + 1>::val
+    log_buffersizeplus1 = nvhls::index_width<buffersize + 1>::val,
+    shared_pool_size = SharedPoolSize,
+    shared_entries = SharedPoolSize - num_vchannels * buffersize,
+    credit_batch = CreditBatch,
+    pipeline_depth = PipelineDepth,
+    // Cycles from taking a credit to getting it back from a router with the
+    // same PipelineDepth, while nothing stalls
+    credit_round_trip = PipelineDepth + 1
   };
+  static const bool shared_buffer = (SharedPoolSize != 0);
+  static_assert(SharedPoolSize == 0 || shared_entries >= 0,
+                "Shared pool must hold the reserved BufferSize of every VC");
+  static_assert(CreditBatch >= 1 && CreditBatch <= BufferSize,
+                "Credit batch must be between 1 and BufferSize");
+  static_assert(PipelineDepth >= 1 && PipelineDepth <= 3,
+                "Pipeline depth must be 1, 2 or 3");
+  static_assert(PipelineDepth == 1 || BufferSize >= credit_round_trip + CreditBatch - 1,
+                "BufferSize must cover the credit round trip of the router pipeline");
   typedef NVUINTW(log_buffersizeplus1) Credit_t;
-  typedef NVUINTW(1) Credit_ret_t;
+  typedef NVUINTW(nvhls::index_width<CreditBatch + 1>::val) Credit_ret_t;
+  typedef NVUINTW(nvhls::index_width<SharedPoolSize + 1>::val) Pool_t;
 
   // Input / Output ports
   Connections::In<Flit_t> in_port[num_ports];
@@ -78,25 +116,39 @@ public:
   // 1 credit counter per output port
   Connections::In<Credit_ret_t> in_credit[num_ports * num_vchannels];
   Connections::Out<Credit_ret_t> out_credit[num_ports * num_vchannels];
-  sc_in_clk clk;
-  sc_in<bool> rst;
 
   // Input FIFO Buffer
-  FIFO<Flit_t, buffersize, num_ports * num_vchannels> ififo;
+  typedef typename WHVCInputBuffer<Flit_t, buffersize, SharedPoolSize,
+                                   num_ports, num_vchannels>::type InputFifo;
+  InputFifo ififo;
 
   // Credit registers to store credits for both producer and consumer
   Credit_t credit_recv[num_ports * num_vchannels];
   Credit_t credit_send[num_ports * num_vchannels];
 
+  // With a shared pool: entries of the port pool committed to each input VC,
+  // i.e. buffered flits plus credits granted to the producer and not yet
+  // used by an arriving flit
+  Pool_t committed[num_ports * num_vchannels];
+
   // Variable to register outputs
   Flit_t flit_out[num_ports];
 
+  // PipelineDepth 3: flits read from in_port, written into ififo in the
+  // next cycle
+  Flit_t in_reg[num_ports];
+  NVUINTW(num_ports) in_reg_valid;
+
+  // Flits sent per output VC, as stats vc_flits_<port * num_vchannels + vc>
+  match::StatHandle vc_flits_stat;
+
   // Constructor
   SC_HAS_PROCESS(WHVCRouterBase);
-  WHVCRouterBase(sc_module_name name_) : sc_module(name_) {
+  WHVCRouterBase(sc_module_name name_) : match::Module(name_) {
     SC_THREAD(process);
     sensitive << clk.pos();
     NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    vc_flits_stat = this->RegisterStatIndexed("vc_flits", num_ports * num_vchannels);
   }
 
   // Function to receive credits from the consumers
@@ -114,14 +166,66 @@ public:
     }
   }
 
+  // An input VC released one buffer entry, by popping or by bypassing it
+  void release_credit(int idx) {
+    if (shared_buffer) {
+      committed[idx]--;
+    } else {
+      credit_send[idx]++;
+      NVHLS_ASSERT_MSG(credit_send[idx] <= buffersize, "Total credits cannot be larger than buffer size");
+    }
+  }
+
+  // Shared pool credits: every input VC keeps up to buffersize credits
+  // outstanding at its producer. A VC that has committed less than
+  // buffersize entries draws on its reserved share, beyond that on the
+  // shared_entries left in the pool of its port. Credits are therefore
+  // returned when an arriving flit can be buffered, not when one is popped.
+  void grant_credit() {
+#pragma hls_unroll yes
+    for (int i = 0; i < num_ports; i++) {
+      Pool_t shared_used = 0;
+#pragma hls_unroll yes
+      for (int j = 0; j < num_vchannels; j++) {
+        if (committed[i * num_vchannels + j] > buffersize) {
+          shared_used += committed[i * num_vchannels + j] - buffersize;
+        }
+      }
+#pragma hls_unroll yes
+      for (int j = 0; j < num_vchannels; j++) {
+        int idx = i * num_vchannels + j;
+        Pool_t outstanding = committed[idx] - ififo.NumFilled(idx);
+        bool reserved = (committed[idx] < buffersize);
+        if (outstanding < buffersize &&
+            (reserved || shared_used < shared_entries)) {
+          if (!reserved) {
+            shared_used++;
+          }
+          committed[idx]++;
+          credit_send[idx]++;
+        }
+      }
+    }
+  }
+
+  // Credits are returned credit_batch at a time, or all that are pending
+  // once the input VC has drained, so that a producer waiting for credits is
+  // never left without them
   void send_credit() {
+    if (shared_buffer) {
+      grant_credit();
+    }
+    typename InputFifo::BankMask empty = ififo.isEmpty_multi();
 #pragma hls_unroll yes
     for (int i = 0; i < num_ports * num_vchannels; i++) {
-      if (credit_send[i] > 0) {
-        Credit_ret_t credit_out = 1;
+      if (credit_send[i] >= credit_batch || (credit_send[i] > 0 && empty[i])) {
+        Credit_ret_t credit_out = credit_batch;
+        if (credit_send[i] < credit_batch) {
+          credit_out = credit_send[i];
+        }
         bool temp = out_credit[i].PushNB(credit_out);
         if (temp) {
-          credit_send[i]--;
+          credit_send[i] -= credit_out;
         }
         CDCOUT(sc_time_stamp() << ": " << name() << " Returning credit to port"
              << i << " credit_send=" << credit_send[i]
@@ -130,35 +234,69 @@ public:
     }
   }
 
+  // Next flit of input port i. With PipelineDepth 3 it is the flit read in
+  // the previous cycle; ififo always has room for it, as it holds a credit.
+  bool read_input(int i, Flit_t& flit) {
+    if (PipelineDepth < 3) {
+      return in_port[i].PopNB(flit);
+    }
+    bool valid = in_reg_valid[i];
+    flit = in_reg[i];
+    in_reg_valid[i] = in_port[i].PopNB(in_reg[i]);
+    return valid;
+  }
+
   void fill_ififo() {
-    // Read input port if data is available and fill input buffers
+    // Read input port if data is available and fill input buffers. All
+    // banks are written with one push_multi so their tails update in
+    // parallel.
     Flit_t inflit[num_ports];
+    Flit_t push_data[num_ports * num_vchannels];
+    typename InputFifo::BankMask push_mask = 0;
 #pragma hls_unroll yes
     for (int i = 0; i < num_ports; i++) {
-      if (in_port[i].PopNB(inflit[i])) {
+      if (read_input(i, inflit[i])) {
         CDCOUT(sc_time_stamp() << ": " << name() << " Read input from port-" << i
                               << endl, kDebugLevel);
+        NVUINTW(log_num_vchannels) vcin_tmp = 0;
         if (num_vchannels > 1) {
-          NVUINTW(log_num_vchannels) vcin_tmp = inflit[i].get_packet_id();
-          NVHLS_ASSERT_MSG(!ififo.isFull(i * num_vchannels + vcin_tmp), "Input fifo is full");
-          ififo.push(inflit[i], i * num_vchannels + vcin_tmp);
-        } else {
-          NVHLS_ASSERT_MSG(!ififo.isFull(i), "Input fifo is full");
-          ififo.push(inflit[i], i);
+          vcin_tmp = inflit[i].get_packet_id();
+        }
+#pragma hls_unroll yes
+        for (int j = 0; j < num_vchannels; j++) {
+          if (vcin_tmp == j) {
+            NVHLS_ASSERT_MSG(!ififo.isFull(i * num_vchannels + j), "Input fifo is full");
+            push_data[i * num_vchannels + j] = inflit[i];
+            push_mask[i * num_vchannels + j] = 1;
+          }
         }
       }
     }
+    ififo.push_multi(push_data, push_mask);
   }
 
   void peek_ififo(Flit_t flit_in[num_ports],
                   NVUINTW(log_num_vchannels) vcin[num_ports],
                   NVUINTW(num_ports) in_valid) {
+    // Peek the selected VC of every valid input in one bank-parallel read
+    Flit_t peek_data[num_ports * num_vchannels];
+    typename InputFifo::BankMask peek_mask = 0;
+#pragma hls_unroll yes
+    for (int i = 0; i < num_ports; i++) {
+#pragma hls_unroll yes
+      for (int j = 0; j < num_vchannels; j++) {
+        if (in_valid[i] && vcin[i] == j) {
+          peek_mask[i * num_vchannels + j] = 1;
+        }
+      }
+    }
+    ififo.peek_multi(peek_mask, peek_data);
 
 #pragma hls_unroll yes
     for (int i = 0; i < num_ports; i++) { // Iterating through the inputs here
       // FIFO Read
       if (in_valid[i]) {
-        flit_in[i] = ififo.peek(i * num_vchannels + vcin[i]);
+        flit_in[i] = peek_data[i * num_vchannels + vcin[i]];
         CDCOUT(sc_time_stamp()
               << ": " << name() << hex << " Read from FIFO:"
               << i * num_vchannels + vcin[i] << " Flit< " << flit_in[i].flit_id
@@ -194,12 +332,14 @@ public:
     for (int i = 0; i < num_ports * num_vchannels; i++)
       in_credit[i].Reset();
     ififo.reset();
+    in_reg_valid = 0;
     reset();
 
     // Reset credit registers
     for (int i = 0; i < num_ports * num_vchannels; i++) {
       credit_send[i] = 0;
       credit_recv[i] = buffersize;
+      committed[i] = buffersize;
     }
 
     #pragma hls_pipeline_init_interval 1
@@ -210,9 +350,408 @@ public:
   }
 };
 
-// Specialization for SourceRouting
 /**
- * \brief Wormhole Router with virtual channels 
+ * \brief Default members of a WHVCRouter routing policy
+ * \ingroup WHVCRouter
+ *
+ * \tparam NumPorts         Number of router ports
+ *
+ * \par Overview
+ * Routing policies derive from this class and override what they need:
+ * reset(), candidates() when adaptive is set, and branch() when headers must
+ * be rewritten per output port of a multicast.
+ */
+template <int NumPorts>
+class WHVCRoutingPolicy {
+ public:
+  static const bool adaptive = false;
+
+  void reset() {}
+
+  // Bitmap of the minimal output ports of a header flit, adaptive only
+  template <typename Flit_t>
+  NVUINTW(NumPorts) candidates(const Flit_t& flit) {
+    return 0;
+  }
+
+  // Rewrite the copy of a header flit that leaves through output port
+  template <typename Flit_t>
+  void branch(Flit_t& flit, int port) {}
+};
+
+/**
+ * \brief Source routing policy for WHVCRouter
+ * \ingroup WHVCRouter
+ *
+ * \tparam NumLPorts        Number of local ports
+ * \tparam NumRports        Number of remote ports
+ * \tparam MaxHops          Max. number of hops
+ *
+ * \par Overview
+ * The header flit carries one <Remote Dst> <Local Dst> field per hop (see the
+ * top of this file). Each router consumes the field at the LSBs and shifts
+ * the remaining hops down, so a header spends MaxHops * dest_width_per_hop
+ * bits on the route.
+ */
+template <int NumLPorts, int NumRports, int MaxHops>
+class WHVCSourceRouting : public WHVCRoutingPolicy<NumLPorts + NumRports> {
+ public:
+  enum {
+    num_lports = NumLPorts,
+    num_rports = NumRports,
+    num_ports = num_lports + num_rports,
+    log_num_rports = nvhls::index_width<num_rports>::val,
+    dest_width_per_hop = log_num_rports + num_lports,
+    dest_width = MaxHops * dest_width_per_hop
+  };
+  static const bool adaptive = false;
+
+  void reset() {}
+
+  // Strip this hop's destination from a header flit and return it as a
+  // bitmap of output ports
+  template <typename Flit_t>
+  NVUINTW(num_ports) route(Flit_t& flit) {
+    // Route Computation: For source routing just copy from header flit
+    NVUINTW(dest_width)
+    route = nvhls::get_slc<dest_width>(flit.data, 0);
+    NVUINTW(dest_width_per_hop)
+    out_dest_local = nvhls::get_slc<dest_width_per_hop>(route, 0);
+    NVUINTW(dest_width) next_dests_local = route >> dest_width_per_hop;
+    flit.data = nvhls::set_slc(flit.data, next_dests_local, 0);
+    NVUINTW(num_lports)
+    ldest = nvhls::get_slc<num_lports>(out_dest_local, 0);
+    NVUINTW(log_num_rports)
+    rdest = nvhls::get_slc<log_num_rports>(out_dest_local, num_lports);
+    NVUINTW(num_rports) rdest_1hot = 0;
+    if (next_dests_local != 0) {
+      rdest_1hot[rdest] = 1;
+    }
+    return (static_cast<NVUINTW(num_ports)>(rdest_1hot) << num_lports) | ldest;
+  }
+};
+
+/**
+ * \brief Dimension-order (XY or YX) routing policy for a 2D mesh
+ * \ingroup WHVCRouter
+ *
+ * \tparam NumLPorts        Number of local ports
+ * \tparam MeshX            Number of routers along X
+ * \tparam MeshY            Number of routers along Y
+ * \tparam YFirst           Route along Y before X (YX) instead of XY
+ *
+ * \par Overview
+ * Remote ports are, in order, east (+X), west (-X), north (+Y) and south
+ * (-Y). The header flit carries the destination router and its local ports:
+ * \code
+ *   <Dest Y> <Dest X> <Local Dst>
+ * \endcode
+ * with the local destination 1 hot as in source routing. The header is not
+ * modified on the way, so the route costs dest_width bits whatever the
+ * distance. The router coordinates x and y are set by WHVCDimOrderRouter.
+ */
+template <int NumLPorts, int MeshX, int MeshY, bool YFirst = false>
+class WHVCDimOrderRouting : public WHVCRoutingPolicy<NumLPorts + 4> {
+ public:
+  enum {
+    num_lports = NumLPorts,
+    num_rports = 4,
+    num_ports = num_lports + num_rports,
+    x_width = nvhls::index_width<MeshX>::val,
+    y_width = nvhls::index_width<MeshY>::val,
+    dest_width = num_lports + x_width + y_width,
+    port_east = num_lports,
+    port_west = num_lports + 1,
+    port_north = num_lports + 2,
+    port_south = num_lports + 3
+  };
+  static const bool adaptive = false;
+
+  // Coordinates of this router
+  NVUINTW(x_width) x;
+  NVUINTW(y_width) y;
+
+  void reset() {
+    x = 0;
+    y = 0;
+  }
+
+  template <typename Flit_t>
+  NVUINTW(num_ports) route(Flit_t& flit) {
+    NVUINTW(num_lports) ldest = nvhls::get_slc<num_lports>(flit.data, 0);
+    NVUINTW(x_width) dest_x = nvhls::get_slc<x_width>(flit.data, num_lports);
+    NVUINTW(y_width)
+    dest_y = nvhls::get_slc<y_width>(flit.data, num_lports + x_width);
+    bool x_done = (dest_x == x);
+    bool y_done = (dest_y == y);
+    NVUINTW(num_ports) out_dest = 0;
+    if (x_done && y_done) {
+      out_dest = ldest;
+    } else if (!x_done && (!YFirst || y_done)) {
+      out_dest[(dest_x > x) ? port_east : port_west] = 1;
+    } else {
+      out_dest[(dest_y > y) ? port_north : port_south] = 1;
+    }
+    return out_dest;
+  }
+};
+
+/**
+ * \brief Minimal adaptive routing policy for a 2D mesh
+ * \ingroup WHVCRouter
+ *
+ * \tparam NumLPorts        Number of local ports
+ * \tparam MeshX            Number of routers along X
+ * \tparam MeshY            Number of routers along Y
+ *
+ * \par Overview
+ * Same ports and header format as WHVCDimOrderRouting. route() returns the XY
+ * port, which is the escape route; candidates() returns every minimal port,
+ * i.e. up to one X and one Y direction. WHVCRouter picks among them as
+ * described in WHVCAdaptiveRouter.
+ */
+template <int NumLPorts, int MeshX, int MeshY>
+class WHVCAdaptiveMeshRouting
+    : public WHVCDimOrderRouting<NumLPorts, MeshX, MeshY, false> {
+ public:
+  typedef WHVCDimOrderRouting<NumLPorts, MeshX, MeshY, false> BaseClass;
+  enum {
+    num_lports = BaseClass::num_lports,
+    num_ports = BaseClass::num_ports,
+    x_width = BaseClass::x_width,
+    y_width = BaseClass::y_width
+  };
+  static const bool adaptive = true;
+
+  // Bitmap of the minimal output ports of a header flit: the local
+  // destination once the packet has arrived, otherwise the productive
+  // directions
+  template <typename Flit_t>
+  NVUINTW(num_ports) candidates(const Flit_t& flit) {
+    NVUINTW(num_lports) ldest = nvhls::get_slc<num_lports>(flit.data, 0);
+    NVUINTW(x_width) dest_x = nvhls::get_slc<x_width>(flit.data, num_lports);
+    NVUINTW(y_width)
+    dest_y = nvhls::get_slc<y_width>(flit.data, num_lports + x_width);
+    bool x_done = (dest_x == this->x);
+    bool y_done = (dest_y == this->y);
+    NVUINTW(num_ports) minimal = 0;
+    if (x_done && y_done) {
+      minimal = ldest;
+    } else {
+      if (!x_done) {
+        minimal[(dest_x > this->x) ? BaseClass::port_east : BaseClass::port_west] = 1;
+      }
+      if (!y_done) {
+        minimal[(dest_y > this->y) ? BaseClass::port_north : BaseClass::port_south] = 1;
+      }
+    }
+    return minimal;
+  }
+};
+
+/**
+ * \brief Tree multicast routing policy for a 2D mesh
+ * \ingroup WHVCRouter
+ *
+ * \tparam NumLPorts        Number of local ports
+ * \tparam MeshX            Number of routers along X
+ * \tparam MeshY            Number of routers along Y
+ *
+ * \par Overview
+ * Same ports and router coordinates as WHVCDimOrderRouting, but the header
+ * flit carries a bitmask of destination routers instead of one destination:
+ * \code
+ *   <Node Mask> <Local Dst>
+ * \endcode
+ * Bit y * MeshX + x of the node mask selects router (x, y), and every selected
+ * router delivers the packet to the local ports set in the 1 hot local
+ * destination. Each destination follows its XY route, so the packet forms a
+ * tree: a router forks it to every port that one of the destinations leaves
+ * through, and branch() clears from the header of each copy the destinations
+ * served by the other ports. A unicast is a mask with one bit set. dest()
+ * builds the route field, and set_dest() writes it into the dest of a Packet,
+ * which the serializer copies into the header flit.
+ */
+template <int NumLPorts, int MeshX, int MeshY>
+class WHVCMulticastMeshRouting
+    : public WHVCDimOrderRouting<NumLPorts, MeshX, MeshY, false> {
+ public:
+  typedef WHVCDimOrderRouting<NumLPorts, MeshX, MeshY, false> BaseClass;
+  enum {
+    num_lports = BaseClass::num_lports,
+    num_ports = BaseClass::num_ports,
+    x_width = BaseClass::x_width,
+    y_width = BaseClass::y_width,
+    num_nodes = MeshX * MeshY,
+    dest_width = num_lports + num_nodes
+  };
+
+  // Route field of a header to the routers set in nodes
+  static NVUINTW(dest_width) dest(NVUINTW(num_nodes) nodes,
+                                  NVUINTW(num_lports) ldest) {
+    return (static_cast<NVUINTW(dest_width)>(nodes) << num_lports) | ldest;
+  }
+
+  // Set the dest of a packet that the serializer turns into a multicast
+  template <typename Packet_t>
+  static void set_dest(Packet_t& packet, NVUINTW(num_nodes) nodes,
+                       NVUINTW(num_lports) ldest) {
+    static_assert(Packet_t::dest_width >= dest_width,
+                  "Packet dest is too narrow for the multicast route");
+    packet.dest = dest(nodes, ldest);
+  }
+
+  // Output ports that node n is reached through from this router
+  NVUINTW(num_ports) node_ports(int n, NVUINTW(num_lports) ldest) {
+    NVUINTW(x_width) node_x = n % MeshX;
+    NVUINTW(y_width) node_y = n / MeshX;
+    NVUINTW(num_ports) ports = 0;
+    if (node_x != this->x) {
+      ports[(node_x > this->x) ? BaseClass::port_east : BaseClass::port_west] = 1;
+    } else if (node_y != this->y) {
+      ports[(node_y > this->y) ? BaseClass::port_north : BaseClass::port_south] = 1;
+    } else {
+      ports = ldest;
+    }
+    return ports;
+  }
+
+  template <typename Flit_t>
+  NVUINTW(num_ports) route(Flit_t& flit) {
+    NVUINTW(num_lports) ldest = nvhls::get_slc<num_lports>(flit.data, 0);
+    NVUINTW(num_nodes) nodes = nvhls::get_slc<num_nodes>(flit.data, num_lports);
+    NVUINTW(num_ports) out_dest = 0;
+#pragma hls_unroll yes
+    for (int n = 0; n < num_nodes; n++) {
+      if (nodes[n]) {
+        out_dest |= node_ports(n, ldest);
+      }
+    }
+    return out_dest;
+  }
+
+  // Keep in the header leaving through port only the nodes it leads to
+  template <typename Flit_t>
+  void branch(Flit_t& flit, int port) {
+    NVUINTW(num_lports) ldest = nvhls::get_slc<num_lports>(flit.data, 0);
+    NVUINTW(num_nodes) nodes = nvhls::get_slc<num_nodes>(flit.data, num_lports);
+    NVUINTW(num_nodes) kept = 0;
+#pragma hls_unroll yes
+    for (int n = 0; n < num_nodes; n++) {
+      NVUINTW(num_ports) ports = node_ports(n, ldest);
+      if (nodes[n] && ports[port]) {
+        kept[n] = 1;
+      }
+    }
+    flit.data = nvhls::set_slc(flit.data, kept, num_lports);
+  }
+};
+
+/**
+ * \brief Routing table update for WHVCTableRouter
+ * \ingroup WHVCRouter
+ *
+ * Sets the output ports (1 hot per port, several bits for multicast) of
+ * destination dest_id.
+ */
+template <int NumPorts, int NumDests>
+class WHVCRouteUpdate : public nvhls_message {
+ public:
+  enum {
+    id_width = nvhls::index_width<NumDests>::val,
+    width = id_width + NumPorts
+  };
+
+  NVUINTW(id_width) dest_id;
+  NVUINTW(NumPorts) ports;
+
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
+    m& dest_id;
+    m& ports;
+  }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    MarshallFields(m);
+  }
+};
+
+/**
+ * \brief Table routing policy for WHVCRouter
+ * \ingroup WHVCRouter
+ *
+ * \tparam NumLPorts        Number of local ports
+ * \tparam NumRports        Number of remote ports
+ * \tparam NumDests         Number of destination ids
+ *
+ * \par Overview
+ * The header flit carries a destination id in its id_width LSBs, and each
+ * router looks up the output ports of that id in its own table. The header is
+ * not modified. Tables are cleared on reset and written through
+ * WHVCTableRouter::route_update; a header whose entry is empty is an error.
+ */
+template <int NumLPorts, int NumRports, int NumDests>
+class WHVCTableRouting : public WHVCRoutingPolicy<NumLPorts + NumRports> {
+ public:
+  enum {
+    num_lports = NumLPorts,
+    num_rports = NumRports,
+    num_ports = num_lports + num_rports,
+    num_dests = NumDests,
+    id_width = nvhls::index_width<num_dests>::val
+  };
+  typedef WHVCRouteUpdate<num_ports, num_dests> Update_t;
+  static const bool adaptive = false;
+
+  NVUINTW(num_ports) table[num_dests];
+
+  void reset() {
+#pragma hls_unroll yes
+    for (int i = 0; i < num_dests; i++) {
+      table[i] = 0;
+    }
+  }
+
+  void update(const Update_t& upd) { table[upd.dest_id] = upd.ports; }
+
+  template <typename Flit_t>
+  NVUINTW(num_ports) route(Flit_t& flit) {
+    NVUINTW(id_width) dest_id = nvhls::get_slc<id_width>(flit.data, 0);
+    NVHLS_ASSERT_MSG(dest_id < num_dests, "Destination id out of range");
+    NVHLS_ASSERT_MSG(table[dest_id] != 0, "No route for destination id");
+    return table[dest_id];
+  }
+};
+
+/**
+ * \brief All VCs of a WHVCRouter in one traffic class
+ * \ingroup WHVCRouter
+ */
+struct WHVCNoPriority {
+  enum { high_vcs = 0, starve_limit = 0 };
+};
+
+/**
+ * \brief Two traffic classes for the VCs of a WHVCRouter
+ * \ingroup WHVCRouter
+ *
+ * \tparam HighVCs          VCs 0 to HighVCs - 1 carry high-priority traffic
+ * \tparam StarveLimit      Flits an output sends in a row from the high
+ *                          class while low-priority flits wait, before one
+ *                          of those goes; 0 for strict priority (default 8)
+ *
+ * \par Overview
+ * See the traffic classes of WHVCRouter.
+ */
+template <int HighVCs, int StarveLimit = 8>
+struct WHVCVCPriority {
+  enum { high_vcs = HighVCs, starve_limit = StarveLimit };
+};
+
+/**
+ * \brief Wormhole Router with virtual channels and a pluggable routing policy
  * \ingroup WHVCRouter
  *
  * \tparam NumLPorts        Number of local ingress/egress ports 
@@ -220,44 +759,149 @@ public:
  * \tparam NumVchannels     Number of virtual channels
  * \tparam BufferSize       Buffersize of input fifo 
  * \tparam FlitType         Indicates the Flit type 
- * \tparam MaxHops          Indicates Max. number of hops for SourceRouting
+ * \tparam Routing          Routing policy (WHVCSourceRouting,
+ *                          WHVCDimOrderRouting or WHVCTableRouting)
+ * \tparam Lookahead        Decode the route of a header flit when it enters
+ *                          the router rather than when it leaves the input
+ *                          buffer (default false)
+ * \tparam Bypass           Let a flit that arrives at an empty input VC skip
+ *                          the input buffer (default false)
+ * \tparam SharedPoolSize   Flits of input buffer shared by the VCs of each
+ *                          input port, or 0 for one BufferSize FIFO per VC
+ *                          (default 0)
+ * \tparam CreditBatch      Credits returned per credit message, from 1 to
+ *                          BufferSize (default 1)
+ * \tparam PipelineDepth    Register stages of the router, from 1 to 3
+ *                          (default 1)
+ * \tparam Priority         Traffic classes of the VCs, WHVCNoPriority or
+ *                          WHVCVCPriority (default WHVCNoPriority)
  *
- * \par A Simple Example
- * \code
- *      #include <WHVCRouter.h>
+ * \par Routing policies
+ * The router calls routing.route(flit) on every header flit. It returns the
+ * bitmap of output ports the packet goes to, and may rewrite the header for
+ * the next hop; routing.reset() is called on reset. WHVCSourceRouter,
+ * WHVCDimOrderRouter, WHVCTableRouter, WHVCAdaptiveRouter and
+ * WHVCMulticastRouter pair this router with each of the policies in this
+ * file, which derive from WHVCRoutingPolicy.
  *
- *      ...
- *      
- *        typedef Flit<64, 0, 0, 0, FlitId2bit, WormHole> Flit_t;
- *        WHVCRouter<kNumLPorts, kNumRPorts, kNumVChannels, kBufferSize, Flit_t, kNumMaxHops> router;
- *      
- *        Connections::In<Flit_t> in_port[kNumPorts];
- *        Connections::Out<Flit_t> out_port[kNumPorts];
- *        Connections::In<Credit_t> in_credit[kNumCredits];
- *        Connections::Out<Credit_t> out_credit[kNumCredits];
- *      
- *        for (int i = 0; i < kNumPorts; i++) {
- *          router.in_port[i](in_port[i]);
- *          router.out_port[i](out_port[i]);
- *          for (int j = 0; j < kNumVChannels; j++) {
- *            router.in_credit[i * kNumVChannels + j](
- *                in_credit[i * kNumVChannels + j]);
- *            router.out_credit[i * kNumVChannels + j](
- *                out_credit[i * kNumVChannels + j]);
- *          }
- *        }
- *      ...
+ * Policies with adaptive set also provide candidates(flit), the bitmap of all
+ * minimal output ports, and make the router choose the output port and
+ * output VC of each packet (see WHVCAdaptiveRouter). Otherwise a packet keeps
+ * its VC and the input VC is picked by static priority, VC0 first.
+ *
+ * \par Multicast
+ * A route with several bits set forks the packet to all of those outputs:
+ * - Every output arbitrates for the flit on its own and takes it as soon as
+ *   it wins and has a credit on the packet's VC. The outputs already served
+ *   are kept per input VC, and the flit leaves the input buffer, returning
+ *   one credit upstream, once the last one has taken it. Each output spends
+ *   its own credit per copy.
+ * - Every copy of a header goes through routing.branch(flit, port), which
+ *   may trim the route to the destinations behind that port.
+ * - The next flit of a multicast only moves once all branches took the
+ *   current one, so a blocked branch stalls the others. As with any
+ *   wormhole multicast, packets that fork should not wait on each other in
+ *   a cycle: give them a VC of their own or room in the downstream buffers.
+ * .
+ *
+ * \par Stats
+ * Flits sent on output VC v of port p are counted in the match::Module stat
+ * vc_flits_<p * NumVchannels + v>; adaptive routers also count the packets
+ * sent on adaptive VCs (adaptive_packets) and on the escape VC
+ * (escape_packets).
+ *
+ * \par Lookahead routing and bypass
+ * By default every flit is written into the input buffer, read back out, and
+ * a header's route is decoded after the read, in front of arbitration.
+ * - With Lookahead, a header's hop field is stripped and decoded into its
+ *   output port bitmap as soon as the flit is read from in_port. The bitmap
+ *   is buffered next to the flit (num_ports extra bits per entry), so the
+ *   buffer read feeds arbitration directly.
+ * - With Bypass, a flit that arrives at an empty input VC is sent straight to
+ *   arbitration. If it wins, it leaves through the crossbar in the same
+ *   cycle and is never written into the buffer; its credit is returned as
+ *   if it had been popped. If it loses, it is written into the buffer at the
+ *   end of the cycle and competes again from there.
+ * .
+ * Both modes produce the same flits, in the same order, as the default
+ * router. They shorten the path from in_port to out_port, so a router that
+ * would otherwise be split into buffer-write and arbitration stages can take
+ * an idle flit through in one stage.
+ *
+ * \par Shared input buffer
+ * With SharedPoolSize != 0 the input buffer of each port is a DAMQ of
+ * SharedPoolSize flits instead of one BufferSize FIFO per VC, and must be at
+ * least NumVchannels * BufferSize:
+ * - BufferSize entries per VC are reserved; the rest are shared by the VCs
+ *   of the port and go to whichever VC needs them first.
+ * - The producer of each VC still holds at most BufferSize credits, starting
+ *   from BufferSize, so routers with and without a shared pool can be
+ *   connected. A credit is returned when a flit arrives and the VC can get
+ *   another entry, from its reserved share or from the shared entries,
+ *   rather than when a flit is popped.
+ * .
+ * A blocked VC can thus hold up to SharedPoolSize - (NumVchannels - 1) *
+ * BufferSize flits while keeping its link busy, and idle VCs cost only their
+ * reserved share.
+ *
+ * \par Credit batching
+ * With CreditBatch > 1 an input VC holds back the credits it owes its
+ * producer and returns them CreditBatch at a time on out_credit, whose
+ * Credit_ret_t grows to carry the count. The credits still pending when the
+ * VC's buffer runs empty are returned at once, so a producer that ran out
+ * of credits is never kept waiting. Producers, including the routers and
+ * endpoints connected to in_port, must add the value of each credit message
+ * (WHVCRouter does). Credit messages drop by up to CreditBatch times; the
+ * link keeps full throughput as long as BufferSize covers the credit round
+ * trip plus CreditBatch.
  *
+ * \par Traffic classes
+ * With a WHVCVCPriority policy, VCs 0 to high_vcs - 1 form a high-priority
+ * class, typically for short control messages, and the other VCs a
+ * low-priority class for bulk traffic. Every output first picks the class,
+ * then round-robin among the inputs of that class, so a flit of the high
+ * class waits for no low-priority flit of another input, and its latency
+ * depends only on the high-priority load and the turns of the low class.
+ * After starve_limit high-priority flits in a row while low-priority flits
+ * wait, the output sends a low-priority one, so the low class gets at least
+ * one flit in every starve_limit + 1. Within an input the lowest occupied VC
+ * is offered, as without a policy, which also favors the high class.
+ * Adaptive routing moves packets across VCs and is not combined with
+ * traffic classes.
+ *
+ * \par Pipeline depth
+ * By default a flit is written into the input buffer, wins allocation and
+ * crosses the crossbar to out_port in one cycle. PipelineDepth adds
+ * registers to that path for routers with many ports:
+ * - 2 registers the crossbar output: allocation picks the flits of a cycle,
+ *   and they leave on out_port from flit_out in the next one. A flit takes
+ *   its output credit and ends its packet on the output VC when it is
+ *   granted, so the next allocation sees the right credits. An output whose
+ *   flit stalls takes no new flit, and one that sends takes a new flit in
+ *   the same cycle.
+ * - 3 also registers the input ports: a flit read from in_port is written
+ *   into the input buffer, or bypasses it, in the next cycle.
+ * .
+ * Each stage adds a cycle to the latency of a hop and to the credit round
+ * trip, so the pipeline still sends a flit per cycle on every output VC
+ * when BufferSize is at least credit_round_trip + CreditBatch - 1, which
+ * PipelineDepth > 1 requires.
+ *
+ * \code
+ *      WHVCSourceRouter<kNumLPorts, kNumRPorts, kNumVChannels, kBufferSize,
+ *                       Flit_t, kNumMaxHops, true, true> router;
  * \endcode
  * \par
  *
  */
 template <int NumLPorts, int NumRports, int NumVchannels, int BufferSize,
-          typename FlitType, int MaxHops>
-class WHVCSourceRouter: public WHVCRouterBase<NumLPorts, NumRports, NumVchannels, BufferSize, FlitType> {
+          typename FlitType, typename Routing, bool Lookahead = false,
+          bool Bypass = false, int SharedPoolSize = 0, int CreditBatch = 1,
+          int PipelineDepth = 1, typename Priority = WHVCNoPriority>
+class WHVCRouter: public WHVCRouterBase<NumLPorts, NumRports, NumVchannels, BufferSize, FlitType, SharedPoolSize, CreditBatch, PipelineDepth> {
 public:
   // Declare constants
-  typedef WHVCRouterBase<NumLPorts, NumRports, NumVchannels, BufferSize, FlitType> BaseClass;
+  typedef WHVCRouterBase<NumLPorts, NumRports, NumVchannels, BufferSize, FlitType, SharedPoolSize, CreditBatch, PipelineDepth> BaseClass;
   static const int kDebugLevel = 2;
   typedef FlitType Flit_t;
   enum {
@@ -268,40 +912,98 @@ public:
     log_num_rports = BaseClass::log_num_rports,
     log_num_ports = BaseClass::log_num_ports,
     log_num_vchannels = BaseClass::log_num_vchannels,
-    dest_width_per_hop = log_num_rports + num_lports,
-    dest_width = MaxHops * dest_width_per_hop,
   };
 
-  WHVCSourceRouter(sc_module_name name_): BaseClass(name_) {
+  static_assert(Priority::high_vcs >= 0 && Priority::high_vcs < NumVchannels,
+                "The high-priority class must leave a low-priority VC");
+  static_assert(Priority::high_vcs == 0 || !Routing::adaptive,
+                "Traffic classes need packets to keep their VC");
 
+  WHVCRouter(sc_module_name name_): BaseClass(name_) {
+    if (Routing::adaptive) {
+      adaptive_packets_stat = this->RegisterStat("adaptive_packets");
+      escape_packets_stat = this->RegisterStat("escape_packets");
+    }
   }
 
+  Routing routing;
+
   Arbiter<num_ports> arbiter[num_ports];
 
+  // Round-robin input VC arbitration, used by adaptive routing
+  Arbiter<num_vchannels> vc_arbiter[num_ports];
+
+  typedef typename BaseClass::InputFifo::BankMask BankMask;
+
   // Store output destination for each port per virtual channel with 1hot
   // encoding
   NVUINTW(num_ports) out_dest[num_ports][num_vchannels];
 
+  // With Lookahead: output destination of every buffered flit, pushed and
+  // popped together with ififo. Zero entries (and never accessed) otherwise.
+  typedef typename WHVCInputBuffer<NVUINTW(num_ports),
+                                   (Lookahead ? BaseClass::buffersize : 0),
+                                   (Lookahead ? SharedPoolSize : 0),
+                                   num_ports, num_vchannels>::type RouteFifo;
+  RouteFifo route_fifo;
+
+  // Outputs that already took the flit at the head of each input VC. A
+  // multicast flit is popped once every output of out_dest has taken it.
+  NVUINTW(num_ports) fork_sent[num_ports][num_vchannels];
+
   // Variable to block output port until previous push is successful
   NVUINTW(num_ports) out_stall;
 
   // Variable that indicates if the output port is available to get new packet
   bool is_get_new_packet[num_ports * num_vchannels];
 
+  // Output VC of the packet at each input VC, chosen with its header by
+  // adaptive routing. Packets keep their VC otherwise.
+  NVUINTW(log_num_vchannels) out_vc[num_ports][num_vchannels];
+
+  // VC of the flit held in flit_out, kept while the output stalls
+  NVUINTW(log_num_vchannels) vcout[num_ports];
+
+  // High-priority flits each output sent in a row while low-priority flits
+  // waited
+  typedef NVUINTW(nvhls::index_width<Priority::starve_limit + 1>::val) Starve_t;
+  Starve_t starved[num_ports];
+
+  match::StatHandle adaptive_packets_stat;
+  match::StatHandle escape_packets_stat;
+
+  NVUINTW(log_num_vchannels) output_vc(int in, NVUINTW(log_num_vchannels) vc) {
+    return Routing::adaptive ? out_vc[in][vc] : vc;
+  }
+
+  // occupied[i * num_vchannels + j] is set if VC j of input i holds a flit
   void inputvc_arbiter(NVUINTW(log_num_vchannels) vcin[num_ports],
-                       NVUINTW(num_ports) & in_valid) {
+                       NVUINTW(num_ports) & in_valid, BankMask occupied) {
 #pragma hls_unroll yes
     for (int i = 0; i < num_ports; i++) { // Iterating through the inputs here
       vcin[i] = 0;
       // Doing static arbitration across input VCs here. VC0 has
       // highest priority. We are assuming that input and output VCs
-      // are same.
-      if (num_vchannels > 1) {
+      // are same. Adaptive routing arbitrates round-robin instead.
+      if (num_vchannels > 1 && Routing::adaptive) {
+        NVUINTW(num_vchannels) vcin_valid = 0;
+#pragma hls_unroll yes
+        for (int j = 0; j < num_vchannels; j++) {
+          vcin_valid[j] = occupied[i * num_vchannels + j];
+        }
+        if (vcin_valid != 0) {
+          in_valid[i] = 1;
+          NVUINTW(num_vchannels) vcin_select = vc_arbiter[i].pick(vcin_valid);
+          NVUINTW(log_num_vchannels) vcin_local;
+          one_hot_to_bin<num_vchannels, log_num_vchannels>(vcin_select, vcin_local);
+          vcin[i] = vcin_local;
+        }
+      } else if (num_vchannels > 1) {
         NVUINTW(num_vchannels) vcin_valid = 0;
         NVUINTW(log_num_vchannels) vcin_local = 0;
 #pragma hls_unroll yes
         for (int j = 0; j < num_vchannels; j++) {
-          if ((!this->ififo.isEmpty(i * num_vchannels + j))) {
+          if (occupied[i * num_vchannels + j]) {
             vcin_valid[num_vchannels - j - 1] = 1;
             in_valid[i] = 1;
           }
@@ -313,17 +1015,20 @@ public:
           vcin[i] = num_vchannels - vcin_local - 1;
         }
       } else {
-#pragma hls_unroll yes
-        for (int i = 0; i < num_ports; i++) {
-          vcin[i] = 0;
-          if (!this->ififo.isEmpty(i)) {
-            in_valid[i] = 1;
-          }
+        if (occupied[i]) {
+          in_valid[i] = 1;
         }
       }
 
     }
   }
+
+  // Route of a header flit as a bitmap of output ports. The routing policy
+  // may rewrite the header for the next hop.
+  NVUINTW(num_ports) decode_route(Flit_t& flit) {
+    return routing.route(flit);
+  }
+
   void compute_route(Flit_t flit_in[num_ports],
                      NVUINTW(log_num_vchannels) vcin[num_ports],
                      NVUINTW(num_ports) in_valid) {
@@ -331,31 +1036,114 @@ public:
 #pragma hls_unroll yes
     for (int i = 0; i < num_ports; i++) { // Iterating through the inputs here
       if (in_valid[i]) {
-        // Route Computation: For source routing just copy from header flit
         if (flit_in[i].flit_id.isHeader()) {
-          NVUINTW(dest_width)
-          route = nvhls::get_slc<dest_width>(flit_in[i].data, 0);
-          NVUINTW(dest_width_per_hop)
-          out_dest_local = nvhls::get_slc<dest_width_per_hop>(route, 0);
-          NVUINTW(dest_width) next_dests_local = route >> dest_width_per_hop;
-          flit_in[i].data =
-              nvhls::set_slc(flit_in[i].data, next_dests_local, 0);
-          NVUINTW(num_lports)
-          ldest = nvhls::get_slc<num_lports>(out_dest_local, 0);
-          NVUINTW(log_num_rports)
-          rdest = nvhls::get_slc<log_num_rports>(out_dest_local, num_lports);
-          NVUINTW(num_rports) rdest_1hot = 0;
-          if (next_dests_local != 0) {
-            rdest_1hot[rdest] = 1;
+          out_dest[i][vcin[i]] = decode_route(flit_in[i]);
+        }
+      }
+    }
+  }
+
+  // Lookahead: headers were decoded on arrival, just latch their destination
+  void lookahead_route(Flit_t flit_in[num_ports],
+                       NVUINTW(num_ports) route_in[num_ports],
+                       NVUINTW(log_num_vchannels) vcin[num_ports],
+                       NVUINTW(num_ports) in_valid) {
+#pragma hls_unroll yes
+    for (int i = 0; i < num_ports; i++) { // Iterating through the inputs here
+      if (in_valid[i] && flit_in[i].flit_id.isHeader()) {
+        out_dest[i][vcin[i]] = route_in[i];
+      }
+    }
+  }
+
+  // Adaptive routing: pick the output port and VC of every header among its
+  // minimal ports and adaptive VCs (1 and up), preferring the free output VC
+  // with the most credits. Without one, the packet waits for the XY port on
+  // the escape VC 0, as chosen by route(). Re-evaluated every cycle until the
+  // header leaves. Packets for local ports keep their VC.
+  void adaptive_route(Flit_t flit_in[num_ports],
+                      NVUINTW(log_num_vchannels) vcin[num_ports],
+                      NVUINTW(num_ports) in_valid) {
+#pragma hls_unroll yes
+    for (int i = 0; i < num_ports; i++) { // Iterating through the inputs here
+      if (in_valid[i] && flit_in[i].flit_id.isHeader()) {
+        NVUINTW(num_ports) minimal = routing.candidates(flit_in[i]);
+        NVUINTW(num_ports) best_dest = out_dest[i][vcin[i]];
+        NVUINTW(log_num_vchannels) best_vc = 0;
+        typename BaseClass::Credit_t best_credit = 0;
+        if ((minimal >> num_lports) == 0) {
+          best_vc = vcin[i];
+        } else {
+#pragma hls_unroll yes
+          for (int k = num_lports; k < num_ports; k++) {
+#pragma hls_unroll yes
+            for (int w = 1; w < num_vchannels; w++) {
+              int out_idx = k * num_vchannels + w;
+              if (minimal[k] && is_get_new_packet[out_idx] &&
+                  this->credit_recv[out_idx] > best_credit) {
+                best_credit = this->credit_recv[out_idx];
+                best_dest = 0;
+                best_dest[k] = 1;
+                best_vc = w;
+              }
+            }
           }
-          out_dest[i][vcin[i]] =
-              (static_cast<NVUINTW(num_ports)>(rdest_1hot) << num_lports) |
-              ldest;
         }
+        out_dest[i][vcin[i]] = best_dest;
+        out_vc[i][vcin[i]] = best_vc;
+        CDCOUT(sc_time_stamp() << ": " << this->name() << " Input Port:" << i
+                  << " VC: " << vcin[i] << hex << " Minimal: " << minimal
+                  << " Dest: " << best_dest << dec << " Out VC: " << best_vc
+                  << endl, kDebugLevel);
       }
     }
   }
 
+  // Read the input ports. Flits that arrive at an empty VC are returned in
+  // bypass_mask when Bypass is set, everything else is written into ififo
+  // (and route_fifo). With Lookahead, headers are decoded here.
+  void fill_inputs(Flit_t arrived[num_ports * num_vchannels],
+                   NVUINTW(num_ports) arrived_route[num_ports * num_vchannels],
+                   BankMask& bypass_mask) {
+    BankMask empty = this->ififo.isEmpty_multi();
+    BankMask push_mask = 0;
+    bypass_mask = 0;
+#pragma hls_unroll yes
+    for (int i = 0; i < num_ports; i++) {
+      Flit_t inflit;
+      if (this->read_input(i, inflit)) {
+        CDCOUT(sc_time_stamp() << ": " << this->name() << " Read input from port-"
+                              << i << endl, kDebugLevel);
+        NVUINTW(log_num_vchannels) vcin_tmp = 0;
+        if (num_vchannels > 1) {
+          vcin_tmp = inflit.get_packet_id();
+        }
+        NVUINTW(num_ports) route = 0;
+        if (Lookahead && inflit.flit_id.isHeader()) {
+          route = decode_route(inflit);
+        }
+#pragma hls_unroll yes
+        for (int j = 0; j < num_vchannels; j++) {
+          if (vcin_tmp == j) {
+            int bank = i * num_vchannels + j;
+            NVHLS_ASSERT_MSG(!this->ififo.isFull(bank), "Input fifo is full");
+            arrived[bank] = inflit;
+            arrived_route[bank] = route;
+            if (Bypass && empty[bank]) {
+              bypass_mask[bank] = 1;
+            } else {
+              push_mask[bank] = 1;
+            }
+          }
+        }
+      }
+    }
+    this->ififo.push_multi(arrived, push_mask);
+    if (Lookahead) {
+      route_fifo.push_multi(arrived_route, push_mask);
+    }
+  }
+
   void flit_output(bool is_push[num_ports],
                    NVUINTW(log_num_vchannels) vcout[num_ports]) {
 
@@ -373,6 +1161,12 @@ public:
         else {
           out_stall[i] = 0;
           this->credit_recv[i * num_vchannels + vcout[i]]--;
+          this->IncrStatIndexed(this->vc_flits_stat, i * num_vchannels + vcout[i]);
+          if (Routing::adaptive && this->flit_out[i].flit_id.isHeader() &&
+              i >= num_lports) {
+            this->IncrStat(vcout[i] == 0 ? escape_packets_stat
+                                         : adaptive_packets_stat);
+          }
         }
         CDCOUT(sc_time_stamp()
               << ": " << this->name() << " OutPort " << i
@@ -384,6 +1178,77 @@ public:
     }
   }
 
+  // PipelineDepth > 1: send the flits held in flit_out. out_stall marks the
+  // outputs holding one, and stays set until it is sent.
+  void flit_output_registered() {
+#pragma hls_unroll yes
+    for (int i = 0; i < num_ports; i++) { // Iterating over outputs here
+      if (out_stall[i] == 1) {
+        bool temp = this->out_port[i].PushNB(this->flit_out[i]);
+        if (temp) {
+          out_stall[i] = 0;
+        }
+        CDCOUT(sc_time_stamp() << ": " << this->name() << " OutPort " << i
+              << " Push success??: " << temp << endl, kDebugLevel);
+      }
+    }
+  }
+
+  // PipelineDepth > 1: a granted flit takes its credit and closes its packet
+  // on the output VC now, and is sent from flit_out in the next cycle
+  void flit_grant(bool is_push[num_ports],
+                  NVUINTW(log_num_vchannels) vcout[num_ports]) {
+#pragma hls_unroll yes
+    for (int i = 0; i < num_ports; i++) { // Iterating over outputs here
+      if (is_push[i] == true) {
+        int out_idx = i * num_vchannels + vcout[i];
+        is_get_new_packet[out_idx] = this->flit_out[i].flit_id.isTail();
+        out_stall[i] = 1;
+        this->credit_recv[out_idx]--;
+        this->IncrStatIndexed(this->vc_flits_stat, out_idx);
+        if (Routing::adaptive && this->flit_out[i].flit_id.isHeader() &&
+            i >= num_lports) {
+          this->IncrStat(vcout[i] == 0 ? escape_packets_stat
+                                       : adaptive_packets_stat);
+        }
+        CDCOUT(sc_time_stamp() << ": " << this->name() << " OutPort " << i
+              << " Granted, credit status " << out_idx << ": "
+              << this->credit_recv[out_idx] << endl, kDebugLevel);
+      }
+    }
+  }
+
+  // Traffic classes: keep the requests of one class at every output, the
+  // high class unless the low one has waited starve_limit flits
+  void priority_mask(NVUINTW(num_ports) in_valid,
+                     NVUINTW(log_num_vchannels) vcin[num_ports],
+                     NVUINTW(num_ports) valid[num_ports]) {
+    NVUINTW(num_ports) high_in = 0;
+#pragma hls_unroll yes
+    for (int i = 0; i < num_ports; i++) { // Iterating through the inputs here
+      if (in_valid[i] && vcin[i] < Priority::high_vcs) {
+        high_in[i] = 1;
+      }
+    }
+#pragma hls_unroll yes
+    for (int k = 0; k < num_ports; k++) { // Iterating through the outputs here
+      NVUINTW(num_ports) high = valid[k] & high_in;
+      NVUINTW(num_ports) low = valid[k] & ~high_in;
+      bool low_turn = (Priority::starve_limit > 0) &&
+                      (starved[k] == Priority::starve_limit);
+      if (high != 0 && low != 0) {
+        valid[k] = low_turn ? low : high;
+        starved[k] = low_turn ? 0 : starved[k] + 1;
+      } else if (low != 0) {
+        starved[k] = 0;
+      }
+      CDCOUT(sc_time_stamp() << ": " << this->name() << hex << " Output Port:"
+                  << k << " High: " << high.to_uint64() << " Low: "
+                  << low.to_uint64() << dec << " Starved: " << starved[k]
+                  << endl, kDebugLevel);
+    }
+  }
+
   void arbitration(Flit_t flit_in[num_ports], NVUINTW(num_ports) in_valid,
                    NVUINTW(log_num_vchannels) vcin[num_ports],
                    NVUINTW(num_ports) valid[num_ports],
@@ -403,14 +1268,16 @@ public:
 #pragma hls_unroll yes
         for (int k = 0; k < num_ports;
              k++) { // Iterating through the outputs here
-          int out_idx = k * num_vchannels + vcin[i];
+          int out_idx = k * num_vchannels + output_vc(i, vcin[i]);
 
           // Set valid bit to 1 for local ports only if credits are available at
           // the output port for the virtual channel chosen
-          // also make sure that the output is requested, and that it is not
-          // head flit, or output[vc] accepts new headers
+          // also make sure that the output is requested and has not yet taken
+          // this flit of a multicast, and that it is not head flit, or
+          // output[vc] accepts new headers
           valid[k][i] =
               (((this->credit_recv[out_idx] != 0) && (out_dest[i][vcin[i]][k] == 1) &&
+                (fork_sent[i][vcin[i]][k] == 0) &&
                 (is_get_new_packet[out_idx] || not_head_flit) &&
                 (out_stall[k] == 0))
                    ? 1
@@ -426,39 +1293,9 @@ public:
       }
     }
 
-#ifdef ENABLE_MULTICAST
-    // For Multicast, supress local output valid  if remote output is invalid
-    NVUINTW((num_ports * num_vchannels))
-    is_multicast = 0; // Store if an input is unicast or multicast
-    NVUINTW(log_num_ports) remote_portid[num_ports];
-    NVUINTW(log_num_lports) local_portid[num_ports];
-
-#pragma hls_unroll yes
-    for (int i = 0; i < num_ports; i++) { // Iterating through the inputs here
-#pragma hls_unroll yes
-      for (int l = 0; l < num_lports;
-           l++) { // Iterating through the outputs here
-#pragma hls_unroll yes
-        for (int r = num_lports; r < num_ports; r++) {
-          if (out_dest[i][vcin[i]][l] && out_dest[i][vcin[i]][r]) {
-            is_multicast[i * num_vchannels + vcin[i]] = 1;
-            remote_portid[i] = r;
-            local_portid[i] = l;
-            if (!(valid[l][i] && valid[r][i])) {
-              valid[l][i] = 0;
-              valid[r][i] = 0; // valid of local port is 1 only is valid of
-                               // remote port is 1
-              CDCOUT(sc_time_stamp() << ": " << this->name() << " Input Port:" << i
-                        << " Local port: " << l << " Remote port: " << r
-                        << " VC: " << vcin[i] << " valid: "<< valid[l][i]
-                        << " Multicast: " << is_multicast[i*num_vchannels + vcin[i]]
-                        << endl, kDebugLevel);
-            }
-          }
-        }
-      }
+    if (Priority::high_vcs > 0) {
+      priority_mask(in_valid, vcin, valid);
     }
-#endif
 
 // Arbitrate for output port if it is header flit
 #pragma hls_unroll yes
@@ -467,71 +1304,61 @@ public:
       if (valid[i] != 0) { // There is an input waiting to send to output
                            // i, credits are available at output
         select[i] = arbiter[i].pick(valid[i]);
-
-        NVUINTW(num_ports) select_temp = select[i];
-        NVUINTW(log_num_ports) select_id_temp;
-        one_hot_to_bin<num_ports, log_num_ports>(select_temp, select_id_temp);
-        select_id[i] = select_id_temp;
         CDCOUT(sc_time_stamp() << ": " << this->name() << hex << " Output Port:"
                     << i << " Valid: " << valid[i].to_uint64() << " Select : "
-                    << select[i].to_int64() << dec
-#ifdef ENABLE_MULTICAST
-                    << "Multicast: " << is_multicast[(select_id[i]*num_vchannels+vcin[select_id[i]])]
-#endif
-                    << endl, kDebugLevel);
+                    << select[i].to_int64() << dec << endl, kDebugLevel);
       }
     }
 
-#ifdef ENABLE_MULTICAST
-// For Multicast, set remote select = local select
-#pragma hls_unroll yes
-    for (int i = 0; i < num_lports;
-         i++) { // Iterating through the remote outputs here
-      if (select[i] != 0 &&
-          is_multicast[(select_id[i] * num_vchannels + vcin[select_id[i]])] &&
-          valid[remote_portid[select_id[i]]][select_id[i]]) {
-        select[remote_portid[select_id[i]]] = select[i];
-        select_id[remote_portid[select_id[i]]] = select_id[i];
-        CDCOUT(sc_time_stamp() << ": " << this->name() << " Output Port:" << i
-                    << "Input port: " << select_id[i] << " Remote port: "
-                    << remote_portid[select_id[i]] << " VC: "
-                    << vcin[select_id[i]] << "Remote Select: "
-                    << select[remote_portid[select_id[i]]] << " Local Select: "
-                    << select[i] << endl, kDebugLevel);
-      }
-    }
-// For Multicast, if remote port is selected and not local port, reset remote
-// port
+    // Encode the grants of all the output ports at once
+    NVUINTW(log_num_ports) select_id_temp[num_ports];
+    one_hot_to_bin_lanes<num_ports, num_ports, log_num_ports>(select, select_id_temp);
 #pragma hls_unroll yes
-    for (int i = num_lports; i < num_ports;
-         i++) { // Iterating through the remote outputs here
-      if (select[i] != 0 &&
-          is_multicast[(select_id[i] * num_vchannels + vcin[select_id[i]])] &&
-          (valid[i][select_id[local_portid[select_id[i]]]] == 0)) {
-        select[i] = 0;
-        CDCOUT("Set Select = 0 for Output port: " << i << endl, kDebugLevel);
-        CDCOUT(sc_time_stamp() << ": " << this->name() << " Output Port:" << i
-                    << "Input port: " << select_id[i] << " Remote port: "
-                    << remote_portid[select_id[i]] << " VC: "
-                    << vcin[select_id[i]] << "Remote Select: " << select[i]
-                    << " Local Select: " << select[local_portid[select_id[i]]]
-                    << endl, kDebugLevel);
+    for (int i = 0; i < num_ports; i++) {
+      if (valid[i] != 0) {
+        select_id[i] = select_id_temp[i];
       }
     }
-#endif
+
   }
 
   void reset() {
     out_stall = 0;
+    route_fifo.reset();
+    routing.reset();
     for (int i = 0; i < num_ports * num_vchannels; i++) {
       is_get_new_packet[i] = true;
     }
+    for (int i = 0; i < num_ports; i++) {
+      vcout[i] = 0;
+      starved[i] = 0;
+      for (int j = 0; j < num_vchannels; j++) {
+        fork_sent[i][j] = 0;
+      }
+    }
   }
 
   
   void run() {
     this->receive_credit();
-    this->fill_ififo();
+
+    // PipelineDepth > 1: the flits granted in the previous cycle leave first,
+    // so an output that sends can take a new flit below
+    if (PipelineDepth > 1) {
+      flit_output_registered();
+    }
+
+    // flits read from the input ports this cycle, by input VC. With Bypass,
+    // bypass_mask marks the ones that arrived at an empty VC and were not
+    // written into ififo
+    Flit_t arrived[num_ports * num_vchannels];
+    NVUINTW(num_ports) arrived_route[num_ports * num_vchannels];
+    BankMask bypass_mask = 0;
+    if (Lookahead || Bypass) {
+      fill_inputs(arrived, arrived_route, bypass_mask);
+    } else {
+      this->fill_ififo();
+    }
 
     Flit_t flit_in[num_ports];
     NVUINTW(log_num_vchannels) vcin[num_ports];
@@ -540,17 +1367,67 @@ public:
     // pick a valid vc per input. VC0 has priority.
     // output: vcin[x] - vc selcted for in port x, in_valid - bitmap of
     // inports valid bits
-    inputvc_arbiter(vcin, in_valid);
+    BankMask occupied = ~this->ififo.isEmpty_multi();
+    occupied |= bypass_mask;
+    inputvc_arbiter(vcin, in_valid, occupied);
+
+    // inputs whose selected vc holds a bypassing flit
+    NVUINTW(num_ports) in_bypass = 0;
+#pragma hls_unroll yes
+    for (int i = 0; i < num_ports; i++) {
+      if (in_valid[i] && bypass_mask[i * num_vchannels + vcin[i]]) {
+        in_bypass[i] = 1;
+      }
+    }
+    NVUINTW(num_ports) in_buffered = in_valid & ~in_bypass;
 
     // read top flit for each selected vc per in port
     // output: flit_in[x] - top flit on selected vc on port x
-    this->peek_ififo(flit_in, vcin, in_valid);
+    this->peek_ififo(flit_in, vcin, in_buffered);
 
-    // for each selected input, in case of valid header flit only, update
-    // out_dest[i][vcin[i]]
-    // side effect updating out_dest[x][vc] for each input port x with output
-    // port bitmap
-    compute_route(flit_in, vcin, in_valid);
+    if (Lookahead) {
+      // headers were decoded on arrival: take their destination from
+      // route_fifo, or from the arriving flit when it bypasses
+      NVUINTW(num_ports) route_in[num_ports];
+      NVUINTW(num_ports) route_peek[num_ports * num_vchannels];
+      BankMask peek_mask = 0;
+#pragma hls_unroll yes
+      for (int i = 0; i < num_ports; i++) {
+        if (in_buffered[i]) {
+          peek_mask[i * num_vchannels + vcin[i]] = 1;
+        }
+      }
+      route_fifo.peek_multi(peek_mask, route_peek);
+#pragma hls_unroll yes
+      for (int i = 0; i < num_ports; i++) {
+        int bank = i * num_vchannels + vcin[i];
+        if (in_bypass[i]) {
+          flit_in[i] = arrived[bank];
+          route_in[i] = arrived_route[bank];
+        } else {
+          route_in[i] = route_peek[bank];
+        }
+      }
+      lookahead_route(flit_in, route_in, vcin, in_valid);
+      if (Routing::adaptive) {
+        adaptive_route(flit_in, vcin, in_valid);
+      }
+    } else {
+#pragma hls_unroll yes
+      for (int i = 0; i < num_ports; i++) {
+        if (in_bypass[i]) {
+          flit_in[i] = arrived[i * num_vchannels + vcin[i]];
+        }
+      }
+      // for each selected input, in case of valid header flit only, update
+      // out_dest[i][vcin[i]]
+      // side effect updating out_dest[x][vc] for each input port x with output
+      // port bitmap
+      compute_route(flit_in, vcin, in_valid);
+      if (Routing::adaptive) {
+        adaptive_route(flit_in, vcin, in_valid);
+      }
+    }
 
     // Variable to hold valid input requests. Set valid[i][j] = 1 if input j
     // is sending flit to output i
@@ -569,45 +1446,467 @@ public:
     // decide which port is going to push data out
     // side effect updating is_push[x] to indicate that output port x is going
     // to push a flit out
-    NVUINTW(num_ports) is_popfifo = 0;
+    NVUINTW(num_ports) granted[num_ports];
     bool is_push[num_ports];
+#pragma hls_unroll yes
+    for (int i = 0; i < num_ports; i++) {
+      granted[i] = 0;
+    }
 #pragma hls_unroll yes
     for (int i = 0; i < num_ports;
          i++) { // Iterating through output ports here
       is_push[i] = false;
       if (select[i] != 0) {
-        is_popfifo[select_id[i]] = 1;
+        granted[select_id[i]][i] = 1;
         is_push[i] = true;
         CDCOUT(sc_time_stamp() << ": " << this->name() << " Port:" << i << "Select: "
                  << select[i] << " select_id " << select_id[i]
-                 << " Valid:" << valid[i] << "PopFifo: " <<
-                 is_popfifo[select_id[i]] << endl, kDebugLevel);
+                 << " Valid:" << valid[i] << endl, kDebugLevel);
+      }
+    }
+
+    // an input is popped once all outputs of its route have taken the flit.
+    // Branches of a multicast may leave in different cycles; fork_sent
+    // remembers the ones already served.
+    NVUINTW(num_ports) is_popfifo = 0;
+#pragma hls_unroll yes
+    for (int i = 0; i < num_ports; i++) { // Iterating over inputs here
+      if (granted[i] != 0) {
+        NVUINTW(num_ports) taken = fork_sent[i][vcin[i]] | granted[i];
+        if ((out_dest[i][vcin[i]] & ~taken) == 0) {
+          is_popfifo[i] = 1;
+          fork_sent[i][vcin[i]] = 0;
+        } else {
+          fork_sent[i][vcin[i]] = taken;
+        }
+        CDCOUT(sc_time_stamp() << ": " << this->name() << " Input Port:" << i
+                 << " Granted: " << granted[i] << " Taken: " << taken
+                 << " PopFifo: " << is_popfifo[i] << endl, kDebugLevel);
       }
     }
 
-// pop input fifos and prepare credits to be returned to sources
+// pop input fifos and prepare credits to be returned to sources. A bypassing
+// flit that was sent returns its credit without touching the fifo; one that
+// was not sent is written into the fifo below.
+    BankMask pop_mask = 0;
+    BankMask bypass_push = bypass_mask;
 #pragma hls_unroll yes
     for (int i = 0; i < num_ports; i++) { // Iterating over inputs here
       if (is_popfifo[i] == 1) {
-        this->ififo.incrHead(i * num_vchannels + vcin[i]);
+#pragma hls_unroll yes
+        for (int j = 0; j < num_vchannels; j++) {
+          if (vcin[i] == j) {
+            if (in_bypass[i]) {
+              bypass_push[i * num_vchannels + j] = 0;
+            } else {
+              pop_mask[i * num_vchannels + j] = 1;
+            }
+          }
+        }
         CDCOUT(sc_time_stamp() << ": " << this->name() << " Popped FIFO of port-"
         << i << " VC-" << vcin[i] << endl, kDebugLevel);
-        this->credit_send[i * num_vchannels + vcin[i]]++;
-        NVHLS_ASSERT_MSG(this->credit_send[i * num_vchannels + vcin[i]] <= BaseClass::buffersize, "Total credits cannot be larger than buffer size");
+        this->release_credit(i * num_vchannels + vcin[i]);
+      }
+    }
+    this->ififo.incrHead_multi(pop_mask);
+    if (Lookahead) {
+      route_fifo.incrHead_multi(pop_mask);
+    }
+    if (Bypass) {
+      this->ififo.push_multi(arrived, bypass_push);
+      if (Lookahead) {
+        route_fifo.push_multi(arrived_route, bypass_push);
       }
     }
 
     // fill_ififo();
     this->send_credit();
-    NVUINTW(log_num_vchannels) vcout[num_ports];
 
     this->crossbar_traversal(flit_in, is_push, select_id, vcin, vcout);
+    // every copy of a multicast header keeps the part of the route that
+    // follows its output
+#pragma hls_unroll yes
+    for (int i = 0; i < num_ports; i++) { // Iterating through output ports here
+      if (is_push[i] && this->flit_out[i].flit_id.isHeader()) {
+        routing.branch(this->flit_out[i], i);
+      }
+    }
+    if (Routing::adaptive) {
+      // move the flit to its output VC, which the VC bits of packet_id carry
+#pragma hls_unroll yes
+      for (int i = 0; i < num_ports; i++) { // Iterating through output ports here
+        if (is_push[i]) {
+          vcout[i] = output_vc(select_id[i], vcin[select_id[i]]);
+          this->flit_out[i].packet_id =
+              nvhls::set_slc(this->flit_out[i].packet_id, vcout[i], 0);
+        }
+      }
+    }
 
     // sends out flits to be sent
     // side effect: updating is_get_new_packet[x] when tail goes through port
     // x
     // and out_stall when push_nb fails
-    flit_output(is_push, vcout);
+    if (PipelineDepth > 1) {
+      flit_grant(is_push, vcout);
+    } else {
+      flit_output(is_push, vcout);
+    }
+  }
+};
+
+/**
+ * \brief Source-routed wormhole router with virtual channels
+ * \ingroup WHVCRouter
+ *
+ * \tparam NumLPorts        Number of local ingress/egress ports 
+ * \tparam NumRports        Number of remote ports 
+ * \tparam NumVchannels     Number of virtual channels
+ * \tparam BufferSize       Buffersize of input fifo 
+ * \tparam FlitType         Indicates the Flit type 
+ * \tparam MaxHops          Indicates Max. number of hops for SourceRouting
+ * \tparam Lookahead        Decode the route of a header flit when it enters
+ *                          the router rather than when it leaves the input
+ *                          buffer (default false)
+ * \tparam Bypass           Let a flit that arrives at an empty input VC skip
+ *                          the input buffer (default false)
+ * \tparam SharedPoolSize   See WHVCRouter (default 0)
+ * \tparam CreditBatch      See WHVCRouter (default 1)
+ * \tparam PipelineDepth    See WHVCRouter (default 1)
+ * \tparam Priority         See WHVCRouter (default WHVCNoPriority)
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <WHVCRouter.h>
+ *
+ *      ...
+ *      
+ *        typedef Flit<64, 0, 0, 0, FlitId2bit, WormHole> Flit_t;
+ *        WHVCSourceRouter<kNumLPorts, kNumRPorts, kNumVChannels, kBufferSize, Flit_t, kNumMaxHops> router;
+ *      
+ *        Connections::In<Flit_t> in_port[kNumPorts];
+ *        Connections::Out<Flit_t> out_port[kNumPorts];
+ *        Connections::In<Credit_t> in_credit[kNumCredits];
+ *        Connections::Out<Credit_t> out_credit[kNumCredits];
+ *      
+ *        for (int i = 0; i < kNumPorts; i++) {
+ *          router.in_port[i](in_port[i]);
+ *          router.out_port[i](out_port[i]);
+ *          for (int j = 0; j < kNumVChannels; j++) {
+ *            router.in_credit[i * kNumVChannels + j](
+ *                in_credit[i * kNumVChannels + j]);
+ *            router.out_credit[i * kNumVChannels + j](
+ *                out_credit[i * kNumVChannels + j]);
+ *          }
+ *        }
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <int NumLPorts, int NumRports, int NumVchannels, int BufferSize,
+          typename FlitType, int MaxHops, bool Lookahead = false,
+          bool Bypass = false, int SharedPoolSize = 0, int CreditBatch = 1,
+          int PipelineDepth = 1, typename Priority = WHVCNoPriority>
+class WHVCSourceRouter
+    : public WHVCRouter<NumLPorts, NumRports, NumVchannels, BufferSize,
+                        FlitType,
+                        WHVCSourceRouting<NumLPorts, NumRports, MaxHops>,
+                        Lookahead, Bypass, SharedPoolSize, CreditBatch, PipelineDepth, Priority> {
+public:
+  typedef WHVCSourceRouting<NumLPorts, NumRports, MaxHops> Routing_t;
+  typedef WHVCRouter<NumLPorts, NumRports, NumVchannels, BufferSize, FlitType,
+                     Routing_t, Lookahead, Bypass, SharedPoolSize, CreditBatch, PipelineDepth, Priority> RouterClass;
+  enum {
+    dest_width_per_hop = Routing_t::dest_width_per_hop,
+    dest_width = Routing_t::dest_width
+  };
+
+  WHVCSourceRouter(sc_module_name name_): RouterClass(name_) {
+
+  }
+};
+
+/**
+ * \brief Dimension-order routed wormhole router for a 2D mesh
+ * \ingroup WHVCRouter
+ *
+ * \tparam NumLPorts        Number of local ingress/egress ports
+ * \tparam NumVchannels     Number of virtual channels
+ * \tparam BufferSize       Buffersize of input fifo
+ * \tparam FlitType         Indicates the Flit type
+ * \tparam MeshX            Number of routers along X
+ * \tparam MeshY            Number of routers along Y
+ * \tparam YFirst           YX instead of XY routing (default false)
+ * \tparam Lookahead        See WHVCRouter (default false)
+ * \tparam Bypass           See WHVCRouter (default false)
+ * \tparam SharedPoolSize   See WHVCRouter (default 0)
+ * \tparam CreditBatch      See WHVCRouter (default 1)
+ * \tparam PipelineDepth    See WHVCRouter (default 1)
+ * \tparam Priority         See WHVCRouter (default WHVCNoPriority)
+ *
+ * \par Overview
+ * Has 4 remote ports (east, west, north, south) and routes with
+ * WHVCDimOrderRouting. The position of the router in the mesh is read from
+ * router_x and router_y, which are normally tied to constants per instance.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <WHVCRouter.h>
+ *
+ *      ...
+ *        typedef Flit<64, 0, 0, 0, FlitId2bit, WormHole> Flit_t;
+ *        typedef WHVCDimOrderRouter<1, 1, 8, Flit_t, 4, 4> Router_t;
+ *        Router_t router;
+ *        sc_signal<NVUINTW(Router_t::Routing_t::x_width)> router_x;
+ *        sc_signal<NVUINTW(Router_t::Routing_t::y_width)> router_y;
+ *
+ *        router.router_x(router_x);
+ *        router.router_y(router_y);
+ *        // header flit: data = (dest_y << (1 + x_width)) | (dest_x << 1) | 1
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <int NumLPorts, int NumVchannels, int BufferSize, typename FlitType,
+          int MeshX, int MeshY, bool YFirst = false, bool Lookahead = false,
+          bool Bypass = false, int SharedPoolSize = 0, int CreditBatch = 1,
+          int PipelineDepth = 1, typename Priority = WHVCNoPriority>
+class WHVCDimOrderRouter
+    : public WHVCRouter<NumLPorts, 4, NumVchannels, BufferSize, FlitType,
+                        WHVCDimOrderRouting<NumLPorts, MeshX, MeshY, YFirst>,
+                        Lookahead, Bypass, SharedPoolSize, CreditBatch, PipelineDepth, Priority> {
+public:
+  typedef WHVCDimOrderRouting<NumLPorts, MeshX, MeshY, YFirst> Routing_t;
+  typedef WHVCRouter<NumLPorts, 4, NumVchannels, BufferSize, FlitType,
+                     Routing_t, Lookahead, Bypass, SharedPoolSize, CreditBatch, PipelineDepth, Priority> RouterClass;
+
+  sc_in<NVUINTW(Routing_t::x_width)> router_x;
+  sc_in<NVUINTW(Routing_t::y_width)> router_y;
+
+  WHVCDimOrderRouter(sc_module_name name_)
+      : RouterClass(name_), router_x("router_x"), router_y("router_y") {}
+
+  void run() {
+    this->routing.x = router_x.read();
+    this->routing.y = router_y.read();
+    RouterClass::run();
+  }
+};
+
+/**
+ * \brief Minimal adaptive wormhole router for a 2D mesh
+ * \ingroup WHVCRouter
+ *
+ * \tparam NumLPorts        Number of local ingress/egress ports
+ * \tparam NumVchannels     Number of virtual channels, at least 2
+ * \tparam BufferSize       Buffersize of input fifo
+ * \tparam FlitType         Indicates the Flit type
+ * \tparam MeshX            Number of routers along X
+ * \tparam MeshY            Number of routers along Y
+ * \tparam Lookahead        See WHVCRouter (default false)
+ * \tparam Bypass           See WHVCRouter (default false)
+ * \tparam SharedPoolSize   See WHVCRouter (default 0)
+ * \tparam CreditBatch      See WHVCRouter (default 1)
+ * \tparam PipelineDepth    See WHVCRouter (default 1)
+ * \tparam Priority         See WHVCRouter (default WHVCNoPriority)
+ *
+ * \par Overview
+ * Same ports, header format and router_x/router_y inputs as
+ * WHVCDimOrderRouter, routed with WHVCAdaptiveMeshRouting:
+ * - VC 0 is the escape VC and only carries packets along their XY route.
+ *   VCs 1 and up are adaptive.
+ * - For each header, the router picks among the minimal output ports and
+ *   adaptive VCs the free output VC with the most credits in credit_recv. If
+ *   none is free with credits, the packet waits for the XY port on the
+ *   escape VC. The choice is made again every cycle until the header leaves.
+ *   A packet can therefore always fall back to the deadlock-free XY escape
+ *   network, as in Duato's protocol.
+ * - Flits move to the chosen output VC, which is written into the VC bits
+ *   (LSBs) of packet_id. Packets for local ports keep their VC.
+ * - Input VCs are arbitrated round-robin rather than by static priority.
+ * .
+ * PacketIdWidth must be at least log2(NumVchannels) so that packet_id can
+ * hold the VC.
+ *
+ * \par
+ *
+ */
+template <int NumLPorts, int NumVchannels, int BufferSize, typename FlitType,
+          int MeshX, int MeshY, bool Lookahead = false, bool Bypass = false,
+          int SharedPoolSize = 0, int CreditBatch = 1,
+          int PipelineDepth = 1, typename Priority = WHVCNoPriority>
+class WHVCAdaptiveRouter
+    : public WHVCRouter<NumLPorts, 4, NumVchannels, BufferSize, FlitType,
+                        WHVCAdaptiveMeshRouting<NumLPorts, MeshX, MeshY>,
+                        Lookahead, Bypass, SharedPoolSize, CreditBatch, PipelineDepth, Priority> {
+public:
+  static_assert(NumVchannels >= 2, "Adaptive routing needs an escape VC and an adaptive VC");
+  typedef WHVCAdaptiveMeshRouting<NumLPorts, MeshX, MeshY> Routing_t;
+  typedef WHVCRouter<NumLPorts, 4, NumVchannels, BufferSize, FlitType,
+                     Routing_t, Lookahead, Bypass, SharedPoolSize, CreditBatch, PipelineDepth, Priority> RouterClass;
+
+  sc_in<NVUINTW(Routing_t::x_width)> router_x;
+  sc_in<NVUINTW(Routing_t::y_width)> router_y;
+
+  WHVCAdaptiveRouter(sc_module_name name_)
+      : RouterClass(name_), router_x("router_x"), router_y("router_y") {}
+
+  void run() {
+    this->routing.x = router_x.read();
+    this->routing.y = router_y.read();
+    RouterClass::run();
+  }
+};
+
+/**
+ * \brief Tree multicast wormhole router for a 2D mesh
+ * \ingroup WHVCRouter
+ *
+ * \tparam NumLPorts        Number of local ingress/egress ports
+ * \tparam NumVchannels     Number of virtual channels
+ * \tparam BufferSize       Buffersize of input fifo
+ * \tparam FlitType         Indicates the Flit type
+ * \tparam MeshX            Number of routers along X
+ * \tparam MeshY            Number of routers along Y
+ * \tparam Lookahead        See WHVCRouter (default false)
+ * \tparam Bypass           See WHVCRouter (default false)
+ * \tparam SharedPoolSize   See WHVCRouter (default 0)
+ * \tparam CreditBatch      See WHVCRouter (default 1)
+ * \tparam PipelineDepth    See WHVCRouter (default 1)
+ * \tparam Priority         See WHVCRouter (default WHVCNoPriority)
+ *
+ * \par Overview
+ * Same ports and router_x/router_y inputs as WHVCDimOrderRouter, routed with
+ * WHVCMulticastMeshRouting: the header flit carries a bitmask of destination
+ * routers and the packet is forked along the XY tree to all of them. The
+ * data width of FlitType must hold the MeshX * MeshY + NumLPorts bits of the
+ * route.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <WHVCRouter.h>
+ *
+ *      ...
+ *        typedef Flit<64, 0, 0, 0, FlitId2bit, WormHole> Flit_t;
+ *        typedef WHVCMulticastRouter<1, 1, 8, Flit_t, 4, 4> Router_t;
+ *        Router_t router;
+ *        sc_signal<NVUINTW(Router_t::Routing_t::x_width)> router_x;
+ *        sc_signal<NVUINTW(Router_t::Routing_t::y_width)> router_y;
+ *
+ *        router.router_x(router_x);
+ *        router.router_y(router_y);
+ *        // header flit to routers 0, 5 and 15, local port 0 of each:
+ *        // data = Router_t::Routing_t::dest(0x8021, 1)
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <int NumLPorts, int NumVchannels, int BufferSize, typename FlitType,
+          int MeshX, int MeshY, bool Lookahead = false, bool Bypass = false,
+          int SharedPoolSize = 0, int CreditBatch = 1,
+          int PipelineDepth = 1, typename Priority = WHVCNoPriority>
+class WHVCMulticastRouter
+    : public WHVCRouter<NumLPorts, 4, NumVchannels, BufferSize, FlitType,
+                        WHVCMulticastMeshRouting<NumLPorts, MeshX, MeshY>,
+                        Lookahead, Bypass, SharedPoolSize, CreditBatch, PipelineDepth, Priority> {
+public:
+  typedef WHVCMulticastMeshRouting<NumLPorts, MeshX, MeshY> Routing_t;
+  typedef WHVCRouter<NumLPorts, 4, NumVchannels, BufferSize, FlitType,
+                     Routing_t, Lookahead, Bypass, SharedPoolSize, CreditBatch, PipelineDepth, Priority> RouterClass;
+  static_assert(FlitType::data_width >= Routing_t::dest_width,
+                "Flit data is too narrow for the multicast route");
+
+  sc_in<NVUINTW(Routing_t::x_width)> router_x;
+  sc_in<NVUINTW(Routing_t::y_width)> router_y;
+
+  WHVCMulticastRouter(sc_module_name name_)
+      : RouterClass(name_), router_x("router_x"), router_y("router_y") {}
+
+  void run() {
+    this->routing.x = router_x.read();
+    this->routing.y = router_y.read();
+    RouterClass::run();
+  }
+};
+
+/**
+ * \brief Table routed wormhole router with virtual channels
+ * \ingroup WHVCRouter
+ *
+ * \tparam NumLPorts        Number of local ingress/egress ports
+ * \tparam NumRports        Number of remote ports
+ * \tparam NumVchannels     Number of virtual channels
+ * \tparam BufferSize       Buffersize of input fifo
+ * \tparam FlitType         Indicates the Flit type
+ * \tparam NumDests         Number of destination ids in the routing table
+ * \tparam Lookahead        See WHVCRouter (default false)
+ * \tparam Bypass           See WHVCRouter (default false)
+ * \tparam SharedPoolSize   See WHVCRouter (default 0)
+ * \tparam CreditBatch      See WHVCRouter (default 1)
+ * \tparam PipelineDepth    See WHVCRouter (default 1)
+ * \tparam Priority         See WHVCRouter (default WHVCNoPriority)
+ *
+ * \par Overview
+ * Routes with WHVCTableRouting. Every router has its own table, which is
+ * cleared on reset and programmed through route_update, one entry per
+ * message. An update takes effect for headers routed in the same cycle.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <WHVCRouter.h>
+ *
+ *      ...
+ *        typedef WHVCTableRouter<1, 4, 1, 8, Flit_t, 64> Router_t;
+ *        Router_t router;
+ *        Connections::Combinational<Router_t::Update_t> route_update;
+ *
+ *        router.route_update(route_update);
+ *        ...
+ *        Router_t::Update_t upd;
+ *        upd.dest_id = 5;
+ *        upd.ports = 1 << 2; // dest id 5 leaves through port 2
+ *        route_update.Push(upd);
+ *        // header flit: data = 5
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <int NumLPorts, int NumRports, int NumVchannels, int BufferSize,
+          typename FlitType, int NumDests, bool Lookahead = false,
+          bool Bypass = false, int SharedPoolSize = 0, int CreditBatch = 1,
+          int PipelineDepth = 1, typename Priority = WHVCNoPriority>
+class WHVCTableRouter
+    : public WHVCRouter<NumLPorts, NumRports, NumVchannels, BufferSize,
+                        FlitType,
+                        WHVCTableRouting<NumLPorts, NumRports, NumDests>,
+                        Lookahead, Bypass, SharedPoolSize, CreditBatch, PipelineDepth, Priority> {
+public:
+  typedef WHVCTableRouting<NumLPorts, NumRports, NumDests> Routing_t;
+  typedef WHVCRouter<NumLPorts, NumRports, NumVchannels, BufferSize, FlitType,
+                     Routing_t, Lookahead, Bypass, SharedPoolSize, CreditBatch, PipelineDepth, Priority> RouterClass;
+  typedef typename Routing_t::Update_t Update_t;
+
+  Connections::In<Update_t> route_update;
+
+  WHVCTableRouter(sc_module_name name_)
+      : RouterClass(name_), route_update("route_update") {}
+
+  void reset() {
+    route_update.Reset();
+    RouterClass::reset();
+  }
+
+  void run() {
+    Update_t upd;
+    if (route_update.PopNB(upd)) {
+      this->routing.update(upd);
+    }
+    RouterClass::run();
   }
 };
 
@@ -0,0 +1,571 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __WHVCTOPOLOGY_H__
+#define __WHVCTOPOLOGY_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_packet.h>
+#include <nvhls_serdes.h>
+#include <nvhls_array.h>
+#include <nvhls_assert.h>
+#include <hls_globals.h>
+#include <WHVCRouter.h>
+#include <WHVCNoC.h>
+
+/**
+ * \brief k-ary n-tree (fat tree) topology for WHVCTopologyNoC
+ * \ingroup WHVCNoC
+ *
+ * \tparam Radix            Endpoints per leaf switch and up links per switch,
+ *                          a power of 2
+ * \tparam Levels           Levels of switches, for Radix^Levels endpoints
+ *
+ * \par Overview
+ * Every level has Radix^(Levels-1) switches. Switch w of level l has down
+ * ports 0 to Radix-1 and up ports Radix to 2*Radix-1; its up port j leads to
+ * switch w of level l+1 with base-Radix digit l of w replaced by j. Endpoint
+ * e sits at local port e % Radix of leaf switch e / Radix.
+ * - A route climbs to the lowest level at which source and destination share
+ *   a subtree, then descends along the digits of the destination. Up/down
+ *   routes are free of deadlock.
+ * - Each up hop may take any of the Radix up links: the one taken at level l
+ *   is digit l of the destination XOR digit l of the path selector, the bits
+ *   of packet_id above the VC. Packets with different selectors spread over
+ *   the paths of the tree; those with the same selector stay in order.
+ */
+template <int Radix, int Levels>
+class FatTreeTopology {
+ public:
+  enum {
+    log_radix = nvhls::index_width<Radix>::val,
+    switches_per_level = 1 << (log_radix * (Levels - 1)),
+    num_routers = switches_per_level * Levels,
+    num_nodes = switches_per_level * Radix,
+    node_width = log_radix * Levels,
+    num_lports = Radix,
+    num_rports = 2 * Radix,
+    dest_width_per_hop = nvhls::index_width<num_rports>::val + num_lports,
+    max_hops = 2 * (Levels - 1) + 1,
+    // Leaf down ports, top up ports and the local ports of non-leaf switches
+    num_edges = (Levels + 1) * switches_per_level * Radix
+  };
+  static_assert(Radix >= 2 && (Radix & (Radix - 1)) == 0, "Radix must be a power of 2");
+  static_assert(Levels >= 2, "A fat tree needs at least 2 levels of switches");
+
+  // Endpoint at local port i of router r, or -1
+  static int endpoint(int r, int i) {
+    return (r < switches_per_level) ? r * Radix + i : -1;
+  }
+
+  // Router on the other end of remote port p of router r, and its remote
+  // port q, or -1 if the port is unconnected
+  static int neighbor(int r, int p, int& q) {
+    int l = r / switches_per_level;
+    int w = r % switches_per_level;
+    int d = (p < Radix) ? l - 1 : l;   // digit of w that the link changes
+    int j = (p < Radix) ? p : p - Radix;
+    if ((p < Radix && l == 0) || (p >= Radix && l == Levels - 1)) {
+      return -1;
+    }
+    int digit = (w >> (d * log_radix)) & (Radix - 1);
+    int other = w + (j - digit) * (1 << (d * log_radix));
+    q = (p < Radix) ? Radix + digit : digit;
+    return (p < Radix ? l - 1 : l + 1) * switches_per_level + other;
+  }
+
+  // Source route from endpoint src to endpoint dst
+  template <typename Dest_t, typename Node_t, typename Sel_t>
+  static Dest_t route(const Node_t& src, const Node_t& dst, const Sel_t& sel) {
+    typedef NVUINTW(log_radix) Digit_t;
+    typedef NVUINTW(dest_width_per_hop) Hop_t;
+    // Highest digit above the leaf in which src and dst differ
+    int top = 0;
+#pragma hls_unroll yes
+    for (int i = 1; i < Levels; i++) {
+      if (nvhls::get_slc<log_radix>(src, i * log_radix) !=
+          nvhls::get_slc<log_radix>(dst, i * log_radix)) {
+        top = i;
+      }
+    }
+    // Built from the last hop back: eject, down hops, then up hops
+    Digit_t local = nvhls::get_slc<log_radix>(dst, 0);
+    Dest_t dest = Hop_t(1) << local;
+#pragma hls_unroll yes
+    for (int l = 1; l < Levels; l++) {
+      if (l <= top) {
+        Hop_t hop = static_cast<Hop_t>(nvhls::get_slc<log_radix>(dst, l * log_radix))
+                    << num_lports;
+        dest = (dest << dest_width_per_hop) | hop;
+      }
+    }
+#pragma hls_unroll yes
+    for (int l = Levels - 2; l >= 0; l--) {
+      if (l < top) {
+        Digit_t up = nvhls::get_slc<log_radix>(dst, l * log_radix) ^
+                     nvhls::get_slc<log_radix>(sel, l * log_radix);
+        Hop_t hop = static_cast<Hop_t>(Radix + up) << num_lports;
+        dest = (dest << dest_width_per_hop) | hop;
+      }
+    }
+    return dest;
+  }
+};
+
+/**
+ * \brief 2D flattened butterfly topology for WHVCTopologyNoC
+ * \ingroup WHVCNoC
+ *
+ * \tparam RoutersX         Routers per row, a power of 2
+ * \tparam RoutersY         Routers per column
+ * \tparam Concentration    Endpoints per router, a power of 2 of at least 2
+ *
+ * \par Overview
+ * Every router links directly to all other routers of its row and of its
+ * column. Router r = y * RoutersX + x has remote ports 0 to RoutersX-2 to
+ * the other routers of its row, in order of x, and the next RoutersY-1
+ * ports to the other routers of its column, in order of y. Endpoint
+ * e = r * Concentration + i sits at local port i of router r.
+ * - Routes are minimal and dimension order: at most one hop along the row,
+ *   one along the column, and the eject, so they are free of deadlock.
+ */
+template <int RoutersX, int RoutersY, int Concentration>
+class FlattenedButterflyTopology {
+ public:
+  enum {
+    num_routers = RoutersX * RoutersY,
+    num_nodes = num_routers * Concentration,
+    local_width = nvhls::index_width<Concentration>::val,
+    x_width = nvhls::index_width<RoutersX>::val,
+    y_width = nvhls::index_width<RoutersY>::val,
+    node_width = local_width + x_width + y_width,
+    num_lports = Concentration,
+    num_rports = (RoutersX - 1) + (RoutersY - 1),
+    dest_width_per_hop = nvhls::index_width<num_rports>::val + num_lports,
+    max_hops = 3,
+    // every port is connected; one unused edge is kept
+    num_edges = 1
+  };
+  static_assert(RoutersX >= 2 && (RoutersX & (RoutersX - 1)) == 0,
+                "RoutersX must be a power of 2");
+  static_assert(RoutersY >= 1, "A flattened butterfly needs at least one row");
+  static_assert(Concentration >= 2 && (Concentration & (Concentration - 1)) == 0,
+                "Concentration must be a power of 2");
+
+  static int endpoint(int r, int i) { return r * Concentration + i; }
+
+  static int neighbor(int r, int p, int& q) {
+    int x = r % RoutersX;
+    int y = r / RoutersX;
+    if (p < RoutersX - 1) {
+      int x2 = (p < x) ? p : p + 1;
+      q = (x < x2) ? x : x - 1;
+      return y * RoutersX + x2;
+    }
+    int p2 = p - (RoutersX - 1);
+    int y2 = (p2 < y) ? p2 : p2 + 1;
+    q = (RoutersX - 1) + ((y < y2) ? y : y - 1);
+    return y2 * RoutersX + x;
+  }
+
+  template <typename Dest_t, typename Node_t, typename Sel_t>
+  static Dest_t route(const Node_t& src, const Node_t& dst, const Sel_t& sel) {
+    typedef NVUINTW(dest_width_per_hop) Hop_t;
+    NVUINTW(x_width) sx = nvhls::get_slc<x_width>(src, local_width);
+    NVUINTW(x_width) dx = nvhls::get_slc<x_width>(dst, local_width);
+    NVUINTW(y_width) sy = nvhls::get_slc<y_width>(src, local_width + x_width);
+    NVUINTW(y_width) dy = nvhls::get_slc<y_width>(dst, local_width + x_width);
+    // Built from the last hop back: eject, column hop, row hop
+    Dest_t dest = Hop_t(1) << nvhls::get_slc<local_width>(dst, 0);
+    if (dy != sy) {
+      Hop_t port = (RoutersX - 1) + ((dy < sy) ? dy : NVUINTW(y_width)(dy - 1));
+      dest = (dest << dest_width_per_hop) | (port << num_lports);
+    }
+    if (dx != sx) {
+      Hop_t port = (dx < sx) ? dx : NVUINTW(x_width)(dx - 1);
+      dest = (dest << dest_width_per_hop) | (port << num_lports);
+    }
+    return dest;
+  }
+};
+
+/**
+ * \brief Injection network interface of WHVCTopologyNoC
+ * \ingroup WHVCNoC
+ *
+ * \tparam Topology         Topology of the NoC, e.g. FatTreeTopology
+ * \tparam Packet_t         Packet type of the NoC
+ * \tparam Flit_t           Flit type of the NoC
+ * \tparam NumVchannels     Number of virtual channels
+ * \tparam BufferSize       Input buffer size of the routers, per VC
+ * \tparam VariableLength   Drop trailing all-zero flits, see serializer
+ *
+ * \par Overview
+ * Same as WHVCNoCInjector, except that the dest field of a packet holds the
+ * destination endpoint, and Topology::route() computes the source route
+ * from endpoint node_id. The bits of packet_id above the VC select among
+ * the paths of the topology. The packet travels on the VC in the LSBs of
+ * packet_id.
+ */
+template <typename Topology, typename Packet_t, typename Flit_t, int NumVchannels,
+          int BufferSize, bool VariableLength = false>
+class WHVCTopologyInjector : public sc_module {
+ public:
+  enum {
+    node_width = Topology::node_width,
+    log_num_vchannels = nvhls::index_width<NumVchannels>::val
+  };
+  static_assert(Packet_t::packet_id_width >= log_num_vchannels,
+                "packet_id must hold the VC");
+  typedef NVUINTW(1) Credit_ret_t;
+  typedef NVUINTW(nvhls::index_width<BufferSize + 1>::val) Credit_t;
+  typedef NVUINTW(node_width) Node_t;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  sc_in<Node_t> node_id;
+
+  Connections::In<Packet_t> in_packet;
+  Connections::Out<Flit_t> out_flit;
+  Connections::In<Credit_ret_t> in_credit[NumVchannels];
+
+  serializer<Packet_t, Flit_t, WormHole, VariableLength> ser;
+  Connections::Combinational<Packet_t> ser_in;
+  Connections::Combinational<Flit_t> ser_out;
+  Connections::Out<Packet_t> to_ser;
+  Connections::In<Flit_t> from_ser;
+
+  SC_HAS_PROCESS(WHVCTopologyInjector);
+  WHVCTopologyInjector(sc_module_name name_)
+      : sc_module(name_),
+        clk("clk"),
+        rst("rst"),
+        node_id("node_id"),
+        in_packet("in_packet"),
+        out_flit("out_flit"),
+        ser("ser"),
+        ser_in("ser_in"),
+        ser_out("ser_out"),
+        to_ser("to_ser"),
+        from_ser("from_ser") {
+    ser.clk(clk);
+    ser.rst(rst);
+    ser.in_packet(ser_in);
+    ser.out_flit(ser_out);
+    to_ser(ser_in);
+    from_ser(ser_out);
+
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void route(Packet_t& packet) {
+    Node_t dst = nvhls::get_slc<node_width>(packet.dest, 0);
+    Node_t sel = packet.packet_id >> log_num_vchannels;
+    packet.dest = Topology::template route<NVUINTW(Packet_t::dest_width)>(
+        node_id.read(), dst, sel);
+  }
+
+  void run() {
+    in_packet.Reset();
+    out_flit.Reset();
+    to_ser.Reset();
+    from_ser.Reset();
+    Credit_t credit[NumVchannels];
+#pragma hls_unroll yes
+    for (int i = 0; i < NumVchannels; i++) {
+      in_credit[i].Reset();
+      credit[i] = BufferSize;
+    }
+    Packet_t packet;
+    bool packet_valid = false;
+    Flit_t flit;
+    bool flit_valid = false;
+
+    #pragma hls_pipeline_init_interval 1
+    while (1) {
+      wait();
+#pragma hls_unroll yes
+      for (int i = 0; i < NumVchannels; i++) {
+        Credit_ret_t credit_in;
+        if (in_credit[i].PopNB(credit_in)) {
+          credit[i] += credit_in;
+        }
+        NVHLS_ASSERT_MSG(credit[i] <= BufferSize, "Total credits received cannot be larger than Buffer size");
+      }
+
+      if (!packet_valid) {
+        packet_valid = in_packet.PopNB(packet);
+        if (packet_valid) {
+          route(packet);
+        }
+      }
+      if (packet_valid && to_ser.PushNB(packet)) {
+        packet_valid = false;
+      }
+
+      if (!flit_valid) {
+        flit_valid = from_ser.PopNB(flit);
+      }
+      if (flit_valid) {
+        NVUINTW(log_num_vchannels) vc = 0;
+        if (NumVchannels > 1) {
+          vc = nvhls::get_slc<log_num_vchannels>(flit.packet_id, 0);
+        }
+        if (credit[vc] != 0 && out_flit.PushNB(flit)) {
+          credit[vc]--;
+          flit_valid = false;
+        }
+      }
+    }
+  }
+};
+
+/**
+ * \brief NoC of source-routed WHVCRouters in any topology
+ * \ingroup WHVCNoC
+ *
+ * \tparam Topology         FatTreeTopology, FlattenedButterflyTopology or a
+ *                          class with the same members
+ * \tparam NumVchannels     Number of virtual channels
+ * \tparam BufferSize       Input buffer size of the routers, per VC
+ * \tparam FlitDataWidth    Data width of a flit
+ * \tparam PacketDataWidth  Data width of a packet
+ * \tparam PacketIdWidth    Width of packet_id, at least log2(NumVchannels)
+ * \tparam VariableLength   Send each packet in as few flits as its nonzero
+ *                          data needs (default false)
+ *
+ * \par Overview
+ * Builds Topology::num_routers WHVCSourceRouters with Topology::num_lports
+ * local and Topology::num_rports remote ports, links them as
+ * Topology::neighbor() says, and puts a WHVCTopologyInjector and a
+ * WHVCNoCEjector on in_packet[n] and out_packet[n] of every endpoint n at
+ * the local port given by Topology::endpoint(). Ports without a link or an
+ * endpoint are tied off.
+ * - A packet pushed into in_packet carries its destination endpoint in the
+ *   LSBs of dest (see endpoint_dest()); the NoC replaces it with the source
+ *   route. The other fields arrive unchanged at out_packet.
+ * - Packets from one endpoint to another with the same packet_id arrive in
+ *   order.
+ * .
+ * The interface matches WHVCNoC, so the same traffic can be run on a mesh,
+ * a torus, a fat tree and a flattened butterfly. FatTreeNoC and
+ * FlattenedButterflyNoC fix Topology.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <WHVCTopology.h>
+ *
+ *      ...
+ *        typedef FatTreeNoC<4, 3, 2, 4, 64, 256, 8> NoC_t;   // 64 endpoints
+ *        NoC_t noc;
+ *        ...
+ *        NoC_t::Packet_t packet;
+ *        packet.dest = NoC_t::endpoint_dest(dst);
+ *        in_chan[src].Push(packet);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename Topology, int NumVchannels, int BufferSize, int FlitDataWidth,
+          int PacketDataWidth, int PacketIdWidth, bool VariableLength = false>
+class WHVCTopologyNoC : public sc_module {
+ public:
+  enum {
+    num_nodes = Topology::num_nodes,
+    num_routers = Topology::num_routers,
+    num_lports = Topology::num_lports,
+    num_rports = Topology::num_rports,
+    num_vchannels = NumVchannels,
+    node_width = Topology::node_width,
+    dest_width_per_hop = Topology::dest_width_per_hop,
+    max_hops = Topology::max_hops,
+    num_edges = Topology::num_edges
+  };
+  static_assert(node_width <= dest_width_per_hop * max_hops,
+                "Packet dest must hold the destination endpoint");
+
+  typedef Packet<PacketDataWidth, dest_width_per_hop, max_hops, PacketIdWidth> Packet_t;
+  typedef Flit<FlitDataWidth, 0, 0, PacketIdWidth, FlitId2bit, WormHole> Flit_t;
+  static_assert(PacketIdWidth > 0, "The serializer needs a packet_id");
+  static_assert(FlitDataWidth > Packet_t::dest_width,
+                "Header flit must hold the route and some packet data");
+  static_assert(PacketDataWidth > FlitDataWidth - Packet_t::dest_width,
+                "Packet must need a header and a tail flit");
+
+  typedef WHVCSourceRouter<num_lports, num_rports, NumVchannels, BufferSize,
+                           Flit_t, max_hops> Router_t;
+  typedef WHVCTopologyInjector<Topology, Packet_t, Flit_t, NumVchannels,
+                               BufferSize, VariableLength> Injector_t;
+  typedef WHVCNoCEjector<Packet_t, Flit_t, NumVchannels> Ejector_t;
+  typedef WHVCNoCEdge<Flit_t, NumVchannels> Edge_t;
+  typedef typename Router_t::Credit_ret_t Credit_ret_t;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::In<Packet_t> in_packet[num_nodes];
+  Connections::Out<Packet_t> out_packet[num_nodes];
+
+  nvhls::nv_array<Router_t, num_routers> router;
+  nvhls::nv_array<Injector_t, num_nodes> injector;
+  nvhls::nv_array<Ejector_t, num_nodes> ejector;
+  nvhls::nv_array<Edge_t, num_edges> edge;
+
+  sc_signal<NVUINTW(node_width)> node_id[num_nodes];
+
+  // Local port of every endpoint
+  Connections::Combinational<Flit_t> inject_flit[num_nodes];
+  Connections::Combinational<Flit_t> eject_flit[num_nodes];
+  Connections::Combinational<Credit_ret_t> inject_credit[num_nodes * NumVchannels];
+  Connections::Combinational<Credit_ret_t> eject_credit[num_nodes * NumVchannels];
+
+  // Link leaving remote port p of router r, indexed r * num_rports + p, and
+  // the credits returned on it, indexed (r * num_rports + p) * NumVchannels
+  // + vc
+  Connections::Combinational<Flit_t> link_flit[num_routers * num_rports];
+  Connections::Combinational<Credit_ret_t> link_credit[num_routers * num_rports * NumVchannels];
+
+  // dest of a packet to endpoint n
+  static NVUINTW(node_width) endpoint_dest(int n) { return n; }
+
+  SC_HAS_PROCESS(WHVCTopologyNoC);
+  WHVCTopologyNoC(sc_module_name name_)
+      : sc_module(name_),
+        clk("clk"),
+        rst("rst"),
+        router("router"),
+        injector("injector"),
+        ejector("ejector"),
+        edge("edge") {
+    static const int L = num_lports;
+    static const int V = NumVchannels;
+    for (int e = 0; e < num_edges; e++) {
+      edge[e].clk(clk);
+      edge[e].rst(rst);
+    }
+    int num_edge = 0;
+    for (int r = 0; r < num_routers; r++) {
+      router[r].clk(clk);
+      router[r].rst(rst);
+
+      for (int i = 0; i < L; i++) {
+        int n = Topology::endpoint(r, i);
+        if (n >= 0) {
+          injector[n].clk(clk);
+          injector[n].rst(rst);
+          injector[n].node_id(node_id[n]);
+          ejector[n].clk(clk);
+          ejector[n].rst(rst);
+          injector[n].in_packet(in_packet[n]);
+          injector[n].out_flit(inject_flit[n]);
+          router[r].in_port[i](inject_flit[n]);
+          router[r].out_port[i](eject_flit[n]);
+          ejector[n].in_flit(eject_flit[n]);
+          ejector[n].out_packet(out_packet[n]);
+          for (int vc = 0; vc < V; vc++) {
+            router[r].out_credit[i * V + vc](inject_credit[n * V + vc]);
+            injector[n].in_credit[vc](inject_credit[n * V + vc]);
+            ejector[n].out_credit[vc](eject_credit[n * V + vc]);
+            router[r].in_credit[i * V + vc](eject_credit[n * V + vc]);
+          }
+        } else {
+          tie_off(r, i, edge[num_edge++]);
+        }
+      }
+
+      for (int p = 0; p < num_rports; p++) {
+        int q = 0;
+        int m = Topology::neighbor(r, p, q);
+        int link = r * num_rports + p;
+        if (m >= 0) {
+          // Output side of the link here, input side at the neighbor. The
+          // input side of this port is bound from the neighbor's loop.
+          router[r].out_port[L + p](link_flit[link]);
+          router[m].in_port[L + q](link_flit[link]);
+          for (int vc = 0; vc < V; vc++) {
+            router[r].in_credit[(L + p) * V + vc](link_credit[link * V + vc]);
+            router[m].out_credit[(L + q) * V + vc](link_credit[link * V + vc]);
+          }
+        } else {
+          tie_off(r, L + p, edge[num_edge++]);
+        }
+      }
+    }
+    NVHLS_ASSERT_MSG(num_edge <= num_edges, "Too many unconnected ports");
+
+    SC_METHOD(tie_node_ids);
+  }
+
+  // Runs once at initialization
+  void tie_node_ids() {
+    for (int n = 0; n < num_nodes; n++) {
+      node_id[n].write(n);
+    }
+  }
+
+ protected:
+  // Ties off port i of router r
+  void tie_off(int r, int i, Edge_t& tie) {
+    router[r].out_port[i](tie.from_router);
+    router[r].in_port[i](tie.to_router);
+    for (int vc = 0; vc < NumVchannels; vc++) {
+      router[r].in_credit[i * NumVchannels + vc](tie.credit_to_router[vc]);
+      router[r].out_credit[i * NumVchannels + vc](tie.credit_from_router[vc]);
+    }
+  }
+};
+
+/**
+ * \brief Fat tree NoC, see WHVCTopologyNoC and FatTreeTopology
+ * \ingroup WHVCNoC
+ */
+template <int Radix, int Levels, int NumVchannels, int BufferSize,
+          int FlitDataWidth, int PacketDataWidth, int PacketIdWidth,
+          bool VariableLength = false>
+class FatTreeNoC
+    : public WHVCTopologyNoC<FatTreeTopology<Radix, Levels>, NumVchannels, BufferSize,
+                             FlitDataWidth, PacketDataWidth, PacketIdWidth,
+                             VariableLength> {
+ public:
+  FatTreeNoC(sc_module_name name_)
+      : WHVCTopologyNoC<FatTreeTopology<Radix, Levels>, NumVchannels, BufferSize,
+                        FlitDataWidth, PacketDataWidth, PacketIdWidth,
+                        VariableLength>(name_) {}
+};
+
+/**
+ * \brief Flattened butterfly NoC, see WHVCTopologyNoC and
+ * FlattenedButterflyTopology
+ * \ingroup WHVCNoC
+ */
+template <int RoutersX, int RoutersY, int Concentration, int NumVchannels,
+          int BufferSize, int FlitDataWidth, int PacketDataWidth,
+          int PacketIdWidth, bool VariableLength = false>
+class FlattenedButterflyNoC
+    : public WHVCTopologyNoC<FlattenedButterflyTopology<RoutersX, RoutersY, Concentration>,
+                             NumVchannels, BufferSize, FlitDataWidth,
+                             PacketDataWidth, PacketIdWidth, VariableLength> {
+ public:
+  FlattenedButterflyNoC(sc_module_name name_)
+      : WHVCTopologyNoC<FlattenedButterflyTopology<RoutersX, RoutersY, Concentration>,
+                        NumVchannels, BufferSize, FlitDataWidth, PacketDataWidth,
+                        PacketIdWidth, VariableLength>(name_) {}
+};
+
+#endif  // __WHVCTOPOLOGY_H__
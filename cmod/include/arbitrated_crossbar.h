@@ -18,12 +18,27 @@
 
 #include <nvhls_types.h>
 #include <fifo.h>
+#include <damq.h>
 #include <Arbiter.h>
 #include <one_hot_to_bin.h>
+#include <crossbar.h>
 #include <hls_globals.h>
 #include <nvhls_marshaller.h>
 #include <nvhls_message.h>
 
+// Output queues of ArbitratedCrossbar: a DAMQ shared by all outputs with a
+// shared pool, one FIFO per output otherwise.
+template <typename T, unsigned int LenOutputBuffer, unsigned int SharedPoolSize,
+          unsigned int NumOutputs>
+struct ArbitratedCrossbarOutputBuffer {
+  typedef DAMQ<T, SharedPoolSize, NumOutputs> type;
+};
+
+template <typename T, unsigned int LenOutputBuffer, unsigned int NumOutputs>
+struct ArbitratedCrossbarOutputBuffer<T, LenOutputBuffer, 0, NumOutputs> {
+  typedef FIFO<T, LenOutputBuffer, NumOutputs> type;
+};
+
 // Need to add in virtual output queueing at the input. Can replace the input
 // FIFOs with a Queue class which internally has multiple parallel FIFOs and
 // keeps track of where to put each new input
@@ -35,7 +50,31 @@
  * \tparam NumInputs        Number of Inputs 
  * \tparam NumOutputs       Number of Outputs 
  * \tparam LenInputBuffer   Length of Input Buffer 
- * \tparam LenOutputBuffer  Length of Output Buffer 
+ * \tparam LenOutputBuffer  Length of Output Buffer, or entries reserved for each output with a shared pool
+ * \tparam ArbiterType      Arbitration method of the output arbiters (default: Roundrobin)
+ * \tparam Pipelined        Register the arbitration result and traverse the crossbar one run() later (default: false)
+ * \tparam SharedPoolSize   Total entries of an output buffer pool shared by all outputs, 0 for private output FIFOs (default: 0)
+ *
+ * \par Pipelined mode
+ * With Pipelined set, each run() arbitrates among the input queue heads and
+ * registers the grants, and the crossbar traversal and output queue push of
+ * those grants happen in the next run(). Arbitration and traversal are then
+ * separate pipeline stages, which shortens the critical path of large
+ * crossbars. An output takes part in arbitration only if its output queue
+ * has room after the traversal of the current run(), so a registered grant
+ * always has a slot and no flit is dropped. Output queues of at least 2
+ * entries keep 1 flit/cycle/port under load. source reports the input of
+ * the flits traversing in the current run().
+ *
+ * \par Shared output buffer
+ * With SharedPoolSize set, the output queues are a DAMQ of SharedPoolSize
+ * entries instead of NumOutputs FIFOs of LenOutputBuffer entries, and
+ * LenOutputBuffer becomes the number of entries reserved for each output.
+ * An output below its reservation is always ready. Beyond it, an output
+ * draws on the SharedPoolSize - NumOutputs * LenOutputBuffer unreserved
+ * entries, which are handed out to the outputs in index order within a
+ * run(). A burst to one hot output can then fill the whole unreserved part
+ * of the pool without blocking the reserved entries of the other outputs.
  *
  * \par A Simple Example
  * \code
@@ -62,7 +101,9 @@
  */
 
 template <typename DataType, unsigned int NumInputs, unsigned int NumOutputs,
-          unsigned int LenInputBuffer, unsigned int LenOutputBuffer>
+          unsigned int LenInputBuffer, unsigned int LenOutputBuffer,
+          arbiter_type ArbiterType = Roundrobin, bool Pipelined = false,
+          unsigned int SharedPoolSize = 0>
 class ArbitratedCrossbar {
 
  public:
@@ -76,6 +117,16 @@ class ArbitratedCrossbar {
   typedef NVUINTW(Wrapped<DataType>::width + log2_outputs) DataDestType;
   #endif
 
+  static const bool has_output_queues = (LenOutputBuffer > 0) || (SharedPoolSize > 0);
+  // Entries of the shared pool beyond the reservations of all outputs
+  static const int shared_entries =
+      static_cast<int>(SharedPoolSize) - static_cast<int>(NumOutputs * LenOutputBuffer);
+  static_assert(SharedPoolSize == 0 || shared_entries >= 0,
+                "Shared pool must hold the reserved LenOutputBuffer of every output");
+  typedef typename ArbitratedCrossbarOutputBuffer<DataType, LenOutputBuffer,
+                                                  SharedPoolSize, NumOutputs>::type OutputQueues;
+  typedef NVUINTW(nvhls::index_width<SharedPoolSize + 1>::val) PoolCount;
+
  private:
   // Convenience class which stores a data and destination
   // This is what is stored in the input FIFOs
@@ -113,9 +164,14 @@ class ArbitratedCrossbar {
   #else
   FIFO<DataDestType, LenInputBuffer,  NumInputs> input_queues;
   #endif
-  FIFO<DataType, LenOutputBuffer, NumOutputs> output_queues;
+  OutputQueues output_queues;
+
+  Arbiter<NumInputs, ArbiterType> arbiters[NumOutputs];
 
-  Arbiter<NumInputs> arbiters[NumOutputs];
+  // Arbitration to traversal pipeline register, Pipelined only
+  DataType stage_data[NumOutputs];
+  bool stage_valid[NumOutputs];
+  InputIdx stage_source[NumOutputs];
 
  public:
   ArbitratedCrossbar() { reset(); }
@@ -130,9 +186,16 @@ class ArbitratedCrossbar {
     for (unsigned out = 0; out < NumOutputs; out++) {
       output_queues.reset();
       arbiters[out].reset();
+      stage_valid[out] = false;
     }
   }
 
+  // Weight of input in at output out; WeightedRoundrobin arbiters only
+  void setArbiterWeight(OutputIdx out, InputIdx in, unsigned int weight) {
+    NVHLS_ASSERT_MSG(out < NumOutputs, "Output index greater than number of outputs");
+    arbiters[out].set_weight(in, weight);
+  }
+
   // The next few functions report status of a given input or output lane
   bool isInputEmpty(InputIdx index) {
     NVHLS_ASSERT_MSG(index <= NumInputs, "Input index greater than number of inputs");
@@ -149,11 +212,29 @@ class ArbitratedCrossbar {
     return input_queues.isFull(index);
   }
 
+  // With a shared pool: full once the output used its reservation and the
+  // unreserved entries of the pool are taken
   bool isOutputFull(OutputIdx index) {
     NVHLS_ASSERT_MSG(index <= NumOutputs, "Output index greater than number of outputs");
+    if (SharedPoolSize > 0) {
+      return (output_queues.NumFilled(index) >= LenOutputBuffer) &&
+             (sharedUsed() >= shared_entries);
+    }
     return output_queues.isFull(index);
   }
 
+  // Unreserved entries of the shared pool holding output data
+  PoolCount sharedUsed() {
+    PoolCount shared_used = 0;
+#pragma hls_unroll yes
+    for (unsigned out = 0; out < NumOutputs; out++) {
+      if (output_queues.NumFilled(out) > LenOutputBuffer) {
+        shared_used += output_queues.NumFilled(out) - LenOutputBuffer;
+      }
+    }
+    return shared_used;
+  }
+
   // Add data to a specified input lane, with a specified destination lane
   void push(DataType data, InputIdx src, OutputIdx dest) {
     DataDest tmp;
@@ -371,7 +452,35 @@ class ArbitratedCrossbar {
 	for (unsigned in = 0; in < NumInputs; in++) {
       //DCOUT("DUT - Input: " << in << "\t valid: " << input_valid[in] << "\t dest: " << input_data[in].dest << "\t data: " << input_data[in].data << endl);
 	}
-    if (LenOutputBuffer > 0) {
+    // Pipelined: traverse the grants registered by the previous run() first,
+    // so that output_ready below accounts for the slots they take
+    DataType traversed_data[NumOutputs];
+    bool traversed_valid[NumOutputs];
+    if (Pipelined) {
+#pragma hls_unroll yes
+      for (unsigned out = 0; out < NumOutputs; out++) {
+        traversed_data[out] = stage_data[out];
+        traversed_valid[out] = stage_valid[out];
+        source[out] = stage_source[out];
+        if (has_output_queues && traversed_valid[out]) {
+          output_queues.push(traversed_data[out], out);
+        }
+      }
+    }
+
+    if (SharedPoolSize > 0) {
+      // Every ready output may take an entry in this run(), so an output
+      // beyond its reservation claims an unreserved entry up front
+      PoolCount shared_used = sharedUsed();
+#pragma hls_unroll yes
+      for (unsigned out = 0; out < NumOutputs; out++) {
+        bool reserved = (output_queues.NumFilled(out) < LenOutputBuffer);
+        output_ready[out] = reserved || (shared_used < shared_entries);
+        if (!reserved && output_ready[out]) {
+          shared_used++;
+        }
+      }
+    } else if (LenOutputBuffer > 0) {
 #pragma hls_unroll yes
       for (unsigned out = 0; out < NumOutputs; out++) {
         output_ready[out] = !isOutputFull(out);
@@ -384,8 +493,20 @@ class ArbitratedCrossbar {
     }
 
     // Process the XBAR and arbiters
-    xbar(input_data, input_valid, input_consumed, output_data, output_valid,
-         output_ready, source);
+    if (Pipelined) {
+      InputIdx granted_source[NumOutputs];
+      xbar(input_data, input_valid, input_consumed, output_data, output_valid,
+           output_ready, granted_source);
+#pragma hls_unroll yes
+      for (unsigned out = 0; out < NumOutputs; out++) {
+        stage_data[out] = output_data[out];
+        stage_valid[out] = output_valid[out];
+        stage_source[out] = granted_source[out];
+      }
+    } else {
+      xbar(input_data, input_valid, input_consumed, output_data, output_valid,
+           output_ready, source);
+    }
 	for (unsigned out = 0; out < NumOutputs; out++) {
       //DCOUT("DUT - Output: " << out << "\t valid: " << output_valid[out] << "\t data: " << output_data[out] << "\tReady: " << output_ready[out] << endl);
 	}
@@ -408,11 +529,11 @@ class ArbitratedCrossbar {
       }
     }
 
-    if (LenOutputBuffer > 0) {
+    if (has_output_queues) {
 // Read from each output channel if it is not empty
 #pragma hls_unroll yes
       for (unsigned out = 0; out < NumOutputs; out++) {
-        if (output_valid[out]) {
+        if (!Pipelined && output_valid[out]) {
           output_queues.push(output_data[out], out);
         }
         valid_out[out] = !isOutputEmpty(out);
@@ -431,8 +552,8 @@ class ArbitratedCrossbar {
     } else {
 #pragma hls_unroll yes
       for (unsigned out = 0; out < NumOutputs; out++) {
-        data_out[out] = output_data[out];
-        valid_out[out] = output_valid[out];
+        data_out[out] = Pipelined ? traversed_data[out] : output_data[out];
+        valid_out[out] = Pipelined ? traversed_valid[out] : output_valid[out];
       }
     }
   }  // end run() function
@@ -453,4 +574,701 @@ class ArbitratedCrossbar {
 
 };  // end ArbitratedCrossbar class
 
+/**
+ * \brief Crossbar with virtual output queues and an iSLIP allocator
+ * \ingroup ArbitratedCrossbar
+ *
+ * \tparam DataType         DataType if input and output
+ * \tparam NumInputs        Number of Inputs
+ * \tparam NumOutputs       Number of Outputs
+ * \tparam LenVOQ           Length of each virtual output queue (at least 1)
+ * \tparam LenOutputBuffer  Length of Output Buffer
+ * \tparam NumIterations    Number of iSLIP iterations per run() (default: 1)
+ *
+ * \par Overview
+ * Drop-in alternative to ArbitratedCrossbar that avoids head-of-line
+ * blocking:
+ * - Every input has one queue per output (a banked FIFO with
+ *   NumInputs * NumOutputs banks), so a message waiting for a busy output
+ *   does not block messages behind it for other outputs. Ordering is kept per
+ *   input-output pair.
+ * - Each run() computes a matching with NumIterations iterations of iSLIP:
+ *   unmatched outputs grant one requesting input, unmatched inputs accept one
+ *   granting output, both in roundrobin order. Pointers only move for grants
+ *   accepted in the first iteration, which desynchronizes the arbiters and
+ *   approaches 100% throughput under uniform and permutation traffic.
+ * - An input is ready when the queue for its destination is not full.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <arbitrated_crossbar.h>
+ *
+ *      ...
+ *      VOQCrossbar<DataType, NumInputs, NumOutputs, VOQLen, OutputQueueLen, 2> xbar;
+ *      ...
+ *      xbar.run(data_in, dest_in, valid_in, data_out, valid_out, ready, source);
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename DataType, unsigned int NumInputs, unsigned int NumOutputs,
+          unsigned int LenVOQ, unsigned int LenOutputBuffer,
+          unsigned int NumIterations = 1>
+class VOQCrossbar {
+
+ public:
+  static const int log2_inputs = nvhls::index_width<NumInputs>::val;
+  static const int log2_outputs = nvhls::index_width<NumOutputs>::val;
+  static const int log2_voqs = nvhls::index_width<NumInputs * NumOutputs>::val;
+
+  typedef NVUINTW(log2_inputs) InputIdx;
+  typedef NVUINTW(log2_outputs) OutputIdx;
+  typedef NVUINTW(log2_voqs) VOQIdx;
+  typedef NVUINTW(NumInputs) InputMask;
+  typedef NVUINTW(NumOutputs) OutputMask;
+
+ private:
+  // Queue of input in for output out is bank in * NumOutputs + out
+  FIFO<DataType, LenVOQ, NumInputs * NumOutputs> voqs;
+  FIFO<DataType, LenOutputBuffer, NumOutputs> output_queues;
+
+  Arbiter<NumInputs, RoundrobinPrefix> grant_arbiters[NumOutputs];
+  Arbiter<NumOutputs, RoundrobinPrefix> accept_arbiters[NumInputs];
+
+  static VOQIdx voq(InputIdx in, OutputIdx out) {
+    VOQIdx idx = in * NumOutputs + out;
+    return idx;
+  }
+
+ public:
+  VOQCrossbar() {
+    NVHLS_ASSERT_MSG(LenVOQ > 0, "VOQCrossbar needs at least one entry per virtual output queue");
+    reset();
+  }
+
+  void reset() {
+    voqs.reset();
+    output_queues.reset();
+#pragma hls_unroll yes
+    for (unsigned out = 0; out < NumOutputs; out++) {
+      grant_arbiters[out].reset();
+    }
+#pragma hls_unroll yes
+    for (unsigned in = 0; in < NumInputs; in++) {
+      accept_arbiters[in].reset();
+    }
+  }
+
+  bool isVOQEmpty(InputIdx in, OutputIdx out) { return voqs.isEmpty(voq(in, out)); }
+
+  bool isVOQFull(InputIdx in, OutputIdx out) { return voqs.isFull(voq(in, out)); }
+
+  bool isOutputEmpty(OutputIdx index) {
+    NVHLS_ASSERT_MSG(index < NumOutputs, "Output index greater than number of outputs");
+    return output_queues.isEmpty(index);
+  }
+
+  bool isOutputFull(OutputIdx index) {
+    NVHLS_ASSERT_MSG(index < NumOutputs, "Output index greater than number of outputs");
+    return output_queues.isFull(index);
+  }
+
+  bool isAllInputEmpty() {
+    NVUINTW(NumInputs * NumOutputs) all_empty = ~static_cast<NVUINTW(NumInputs * NumOutputs)>(0);
+    return voqs.isEmpty_multi() == all_empty;
+  }
+
+  DataType peek(OutputIdx index) { return output_queues.peek(index); }
+
+  DataType pop(OutputIdx index) { return output_queues.pop(index); }
+
+  // Pop the data from all selected output lanes, data is already got from peek
+  void pop_all_lanes(bool valid_out[NumOutputs]) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumOutputs; i++) {
+      if (valid_out[i]) {
+        output_queues.pop(i);
+      }
+    }
+  }
+
+  // iSLIP: match[in] is the one-hot output matched to input in, or 0
+  void allocate(const OutputMask requests[NumInputs], const bool output_ready[NumOutputs],
+                OutputMask match[NumInputs]) {
+    InputMask input_matched = 0;
+    OutputMask output_matched = 0;
+#pragma hls_unroll yes
+    for (unsigned in = 0; in < NumInputs; in++) {
+      match[in] = 0;
+    }
+
+#pragma hls_unroll yes
+    for (unsigned iter = 0; iter < NumIterations; iter++) {
+      // Grant: each free output picks one free input requesting it
+      OutputMask granted[NumInputs];
+#pragma hls_unroll yes
+      for (unsigned in = 0; in < NumInputs; in++) {
+        granted[in] = 0;
+      }
+#pragma hls_unroll yes
+      for (unsigned out = 0; out < NumOutputs; out++) {
+        InputMask candidates = 0;
+#pragma hls_unroll yes
+        for (unsigned in = 0; in < NumInputs; in++) {
+          candidates[in] = (requests[in][out] == 1) && (input_matched[in] == 0);
+        }
+        InputMask grant = 0;
+        if (output_ready[out] && (output_matched[out] == 0)) {
+          grant = grant_arbiters[out].peek(candidates);
+        }
+#pragma hls_unroll yes
+        for (unsigned in = 0; in < NumInputs; in++) {
+          granted[in][out] = grant[in];
+        }
+      }
+
+      // Accept: each free input picks one granting output
+#pragma hls_unroll yes
+      for (unsigned in = 0; in < NumInputs; in++) {
+        OutputMask accept = 0;
+        if (input_matched[in] == 0) {
+          accept = accept_arbiters[in].peek(granted[in]);
+        }
+        if (accept != 0) {
+          match[in] = accept;
+          input_matched[in] = 1;
+          output_matched |= accept;
+          if (iter == 0) {
+            accept_arbiters[in].accept(accept);
+            InputMask in_mask = 0;
+            in_mask[in] = 1;
+#pragma hls_unroll yes
+            for (unsigned out = 0; out < NumOutputs; out++) {
+              if (accept[out] == 1) {
+                grant_arbiters[out].accept(in_mask);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Same interface as ArbitratedCrossbar::run()
+  void run(DataType data_in[NumInputs], OutputIdx dest_in[NumInputs],
+           bool valid_in[NumInputs], DataType data_out[NumOutputs],
+           bool valid_out[NumOutputs], bool ready[NumInputs], InputIdx source[NumOutputs]) {
+    // Enqueue into the virtual output queues
+#pragma hls_unroll yes
+    for (unsigned in = 0; in < NumInputs; in++) {
+      VOQIdx idx = voq(in, dest_in[in]);
+      bool full = voqs.isFull(idx);
+      ready[in] = !full || !valid_in[in];
+      if (valid_in[in] && !full) {
+        voqs.push(data_in[in], idx);
+      }
+    }
+
+    OutputMask requests[NumInputs];
+#pragma hls_unroll yes
+    for (unsigned in = 0; in < NumInputs; in++) {
+#pragma hls_unroll yes
+      for (unsigned out = 0; out < NumOutputs; out++) {
+        requests[in][out] = !voqs.isEmpty(voq(in, out));
+      }
+    }
+
+    bool output_ready[NumOutputs];
+#pragma hls_unroll yes
+    for (unsigned out = 0; out < NumOutputs; out++) {
+      output_ready[out] = (LenOutputBuffer == 0) || !isOutputFull(out);
+    }
+
+    OutputMask match[NumInputs];
+    allocate(requests, output_ready, match);
+
+    // Switch the matched messages
+    DataType output_data[NumOutputs];
+    bool output_valid[NumOutputs];
+#pragma hls_unroll yes
+    for (unsigned out = 0; out < NumOutputs; out++) {
+      output_data[out] = BitsToType<DataType>(0);
+      output_valid[out] = false;
+    }
+#pragma hls_unroll yes
+    for (unsigned in = 0; in < NumInputs; in++) {
+      if (match[in] != 0) {
+        OutputIdx out_local;
+        one_hot_to_bin<NumOutputs, log2_outputs>(match[in], out_local);
+        output_data[out_local] = voqs.pop(voq(in, out_local));
+        output_valid[out_local] = true;
+        source[out_local] = in;
+      }
+    }
+
+    if (LenOutputBuffer > 0) {
+#pragma hls_unroll yes
+      for (unsigned out = 0; out < NumOutputs; out++) {
+        if (output_valid[out]) {
+          output_queues.push(output_data[out], out);
+        }
+        valid_out[out] = !isOutputEmpty(out);
+        if (valid_out[out]) {
+          data_out[out] = peek(out);
+        }
+      }
+    } else {
+#pragma hls_unroll yes
+      for (unsigned out = 0; out < NumOutputs; out++) {
+        data_out[out] = output_data[out];
+        valid_out[out] = output_valid[out];
+      }
+    }
+  }
+
+  void run(DataType data_in[NumInputs], OutputIdx dest_in[NumInputs],
+           bool valid_in[NumInputs], DataType data_out[NumOutputs],
+           bool valid_out[NumOutputs], bool ready[NumInputs]) {
+    InputIdx source[NumOutputs];
+    run(data_in, dest_in, valid_in, data_out, valid_out, ready, source);
+  }
+
+};  // end VOQCrossbar class
+
+/**
+ * \brief Arbitrated crossbar whose inputs carry a destination mask (multicast)
+ * \ingroup ArbitratedCrossbar
+ *
+ * \tparam DataType         DataType if input and output
+ * \tparam NumInputs        Number of Inputs
+ * \tparam NumOutputs       Number of Outputs
+ * \tparam LenInputBuffer   Length of Input Buffer (at least 1)
+ * \tparam LenOutputBuffer  Length of Output Buffer
+ * \tparam ArbiterType      Arbitration method of the output arbiters (default: Roundrobin)
+ *
+ * \par Overview
+ * Same structure as ArbitratedCrossbar, but dest_in is a mask of outputs
+ * and one input queue entry is delivered to all of them:
+ * - The head of every input queue requests each output in its mask that it
+ *   has not reached yet, and each output arbiter grants independently, so
+ *   one entry can reach several outputs in the same run().
+ * - Outputs that granted are remembered per input, and the entry is popped
+ *   only once every output in its mask has taken it. Outputs that are busy
+ *   are served in later runs, which never blocks the outputs that are free.
+ * - An entry with an empty mask is dropped.
+ * The input buffer holds the entry while it is partially delivered, so
+ * LenInputBuffer must be at least 1.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <arbitrated_crossbar.h>
+ *
+ *      ...
+ *      MulticastCrossbar<DataType, NumInputs, NumOutputs, InputQueueLen, OutputQueueLen> xbar;
+ *      OutputMask dest_in[NumInputs];  // dest_in[i] = 0xf broadcasts input i to outputs 0-3
+ *      ...
+ *      xbar.run(data_in, dest_in, valid_in, data_out, valid_out, ready, source);
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename DataType, unsigned int NumInputs, unsigned int NumOutputs,
+          unsigned int LenInputBuffer, unsigned int LenOutputBuffer,
+          arbiter_type ArbiterType = Roundrobin>
+class MulticastCrossbar {
+  static_assert(LenInputBuffer > 0, "MulticastCrossbar needs an input buffer to hold partially delivered entries");
+
+ public:
+  static const int log2_inputs = nvhls::index_width<NumInputs>::val;
+
+  typedef NVUINTW(log2_inputs) InputIdx;
+  typedef NVUINTW(NumInputs) InputMask;
+  typedef NVUINTW(NumOutputs) OutputMask;
+
+ private:
+  class DataMask : public nvhls_message {
+   public:
+    DataType data;
+    OutputMask dest;
+    static const int width = Wrapped<DataType>::width + NumOutputs;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m& data;
+      m& dest;
+    }
+  };
+
+  FIFO<DataMask, LenInputBuffer, NumInputs> input_queues;
+  FIFO<DataType, LenOutputBuffer, NumOutputs> output_queues;
+
+  Arbiter<NumInputs, ArbiterType> arbiters[NumOutputs];
+
+  // Outputs already reached by the head of each input queue
+  OutputMask delivered[NumInputs];
+
+ public:
+  MulticastCrossbar() { reset(); }
+
+  void reset() {
+    input_queues.reset();
+    output_queues.reset();
+#pragma hls_unroll yes
+    for (unsigned out = 0; out < NumOutputs; out++) {
+      arbiters[out].reset();
+    }
+#pragma hls_unroll yes
+    for (unsigned in = 0; in < NumInputs; in++) {
+      delivered[in] = 0;
+    }
+  }
+
+  bool isInputEmpty(InputIdx index) {
+    NVHLS_ASSERT_MSG(index < NumInputs, "Input index greater than number of inputs");
+    return input_queues.isEmpty(index);
+  }
+
+  bool isInputFull(InputIdx index) {
+    NVHLS_ASSERT_MSG(index < NumInputs, "Input index greater than number of inputs");
+    return input_queues.isFull(index);
+  }
+
+  bool isOutputEmpty(unsigned index) {
+    NVHLS_ASSERT_MSG(index < NumOutputs, "Output index greater than number of outputs");
+    return output_queues.isEmpty(index);
+  }
+
+  bool isOutputFull(unsigned index) {
+    NVHLS_ASSERT_MSG(index < NumOutputs, "Output index greater than number of outputs");
+    return output_queues.isFull(index);
+  }
+
+  DataType peek(unsigned index) { return output_queues.peek(index); }
+
+  DataType pop(unsigned index) { return output_queues.pop(index); }
+
+  // Pop the data from all selected output lanes, data is already got from peek
+  void pop_all_lanes(bool valid_out[NumOutputs]) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumOutputs; i++) {
+      if (valid_out[i]) {
+        output_queues.pop(i);
+      }
+    }
+  }
+
+  void run(DataType data_in[NumInputs], OutputMask dest_in[NumInputs],
+           bool valid_in[NumInputs], DataType data_out[NumOutputs],
+           bool valid_out[NumOutputs], bool ready[NumInputs], InputIdx source[NumOutputs]) {
+    DataType head_data[NumInputs];
+    OutputMask pending[NumInputs];
+#pragma hls_unroll yes
+    for (unsigned in = 0; in < NumInputs; in++) {
+      bool full = input_queues.isFull(in);
+      ready[in] = !full || !valid_in[in];
+      if (valid_in[in] && !full) {
+        DataMask tmp;
+        tmp.data = data_in[in];
+        tmp.dest = dest_in[in];
+        input_queues.push(tmp, in);
+      }
+      head_data[in] = BitsToType<DataType>(0);
+      pending[in] = 0;
+      if (!input_queues.isEmpty(in)) {
+        DataMask head = input_queues.peek(in);
+        head_data[in] = head.data;
+        pending[in] = head.dest & ~delivered[in];
+      }
+    }
+
+    // Each output grants one of the heads still waiting for it
+    InputMask grant[NumOutputs];
+#pragma hls_unroll yes
+    for (unsigned out = 0; out < NumOutputs; out++) {
+      InputMask requests = 0;
+#pragma hls_unroll yes
+      for (unsigned in = 0; in < NumInputs; in++) {
+        requests[in] = pending[in][out];
+      }
+      grant[out] = 0;
+      if ((LenOutputBuffer == 0) || !output_queues.isFull(out)) {
+        grant[out] = arbiters[out].pick(requests);
+      }
+      if (grant[out] != 0) {
+        one_hot_to_bin<NumInputs, log2_inputs>(grant[out], source[out]);
+      }
+    }
+
+    DataType output_data[NumOutputs];
+    OutputMask output_valid;
+    crossbar_onehot<DataType, NumInputs, NumOutputs>(head_data, grant, output_data, output_valid);
+
+    // Pop the heads that have now reached every output in their mask
+#pragma hls_unroll yes
+    for (unsigned in = 0; in < NumInputs; in++) {
+      OutputMask served = 0;
+#pragma hls_unroll yes
+      for (unsigned out = 0; out < NumOutputs; out++) {
+        served[out] = grant[out][in];
+      }
+      if (!input_queues.isEmpty(in)) {
+        if ((pending[in] & ~served) == 0) {
+          input_queues.incrHead(in);
+          delivered[in] = 0;
+        } else {
+          delivered[in] |= served;
+        }
+      }
+    }
+
+    if (LenOutputBuffer > 0) {
+#pragma hls_unroll yes
+      for (unsigned out = 0; out < NumOutputs; out++) {
+        if (output_valid[out] == 1) {
+          output_queues.push(output_data[out], out);
+        }
+        valid_out[out] = !isOutputEmpty(out);
+        if (valid_out[out]) {
+          data_out[out] = peek(out);
+        }
+      }
+    } else {
+#pragma hls_unroll yes
+      for (unsigned out = 0; out < NumOutputs; out++) {
+        data_out[out] = output_data[out];
+        valid_out[out] = (output_valid[out] == 1);
+      }
+    }
+  }
+
+  void run(DataType data_in[NumInputs], OutputMask dest_in[NumInputs],
+           bool valid_in[NumInputs], DataType data_out[NumOutputs],
+           bool valid_out[NumOutputs], bool ready[NumInputs]) {
+    InputIdx source[NumOutputs];
+    run(data_in, dest_in, valid_in, data_out, valid_out, ready, source);
+  }
+
+};  // end MulticastCrossbar class
+
+/**
+ * \brief Two-stage crossbar built from ArbitratedCrossbar sub-switches
+ * \ingroup ArbitratedCrossbar
+ *
+ * \tparam DataType               DataType if input and output
+ * \tparam NumInputs              Number of Inputs
+ * \tparam NumOutputs             Number of Outputs
+ * \tparam InputGroupSize         Inputs per first-stage sub-switch
+ * \tparam OutputGroupSize        Outputs per second-stage sub-switch
+ * \tparam LenInputBuffer         Length of Input Buffer
+ * \tparam LenIntermediateBuffer  Length of the buffers between the stages (at least 1)
+ * \tparam LenOutputBuffer        Length of Output Buffer
+ * \tparam ArbiterType            Arbitration method of the sub-switch arbiters (default: Roundrobin)
+ *
+ * \par Overview
+ * Drop-in alternative to ArbitratedCrossbar for high port counts, with the
+ * same run(), pop_all_lanes() and peek()/pop() interface:
+ * - Inputs are split into NumInputs/InputGroupSize groups and outputs into
+ *   NumOutputs/OutputGroupSize groups. Every input group has a first-stage
+ *   ArbitratedCrossbar with one output per output group, and every output
+ *   group a second-stage ArbitratedCrossbar with one input per input group.
+ *   A 64x64 crossbar with groups of 8 is then 16 8x8 sub-switches instead of
+ *   64 64-input arbiters and a 64x64 mux.
+ * - The output queues of the first stage, LenIntermediateBuffer deep, are
+ *   the input queues of the second, which takes their heads from the
+ *   previous run(). The two stages are therefore separate pipeline stages,
+ *   and a message takes one more run() than in ArbitratedCrossbar.
+ * - Messages from one input to one output stay in order, and source reports
+ *   the input of the message presented on each output.
+ * - Only one message per run() moves from an input group to an output
+ *   group, so traffic that concentrates on one pair of groups gets less
+ *   throughput than in a flat crossbar.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <arbitrated_crossbar.h>
+ *
+ *      ...
+ *      // 64x64 from 8x8 sub-switches, 2-entry buffers between the stages
+ *      HierarchicalCrossbar<DataType, 64, 64, 8, 8, InputQueueLen, 2, OutputQueueLen> xbar;
+ *      ...
+ *      xbar.run(data_in, dest_in, valid_in, data_out, valid_out, ready, source);
+ *      xbar.pop_all_lanes(valid_out);
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename DataType, unsigned int NumInputs, unsigned int NumOutputs,
+          unsigned int InputGroupSize, unsigned int OutputGroupSize,
+          unsigned int LenInputBuffer, unsigned int LenIntermediateBuffer,
+          unsigned int LenOutputBuffer, arbiter_type ArbiterType = Roundrobin>
+class HierarchicalCrossbar {
+  static_assert(NumInputs % InputGroupSize == 0, "NumInputs must be a multiple of InputGroupSize");
+  static_assert(NumOutputs % OutputGroupSize == 0, "NumOutputs must be a multiple of OutputGroupSize");
+  static_assert(LenIntermediateBuffer > 0, "HierarchicalCrossbar needs buffers between its stages");
+
+ public:
+  static const unsigned int NumInputGroups = NumInputs / InputGroupSize;
+  static const unsigned int NumOutputGroups = NumOutputs / OutputGroupSize;
+  static const int log2_inputs = nvhls::index_width<NumInputs>::val;
+  static const int log2_outputs = nvhls::index_width<NumOutputs>::val;
+  static const int log2_group_outputs = nvhls::index_width<OutputGroupSize>::val;
+
+  typedef NVUINTW(log2_inputs) InputIdx;
+  typedef NVUINTW(log2_outputs) OutputIdx;
+
+ private:
+  // A message between the stages: the data, its output within the output
+  // group, and its input
+  class DataSource : public nvhls_message {
+   public:
+    DataType data;
+    NVUINTW(log2_group_outputs) dest;
+    InputIdx source;
+    static const int width = Wrapped<DataType>::width + log2_group_outputs + log2_inputs;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m& data;
+      m& dest;
+      m& source;
+    }
+  };
+
+  typedef ArbitratedCrossbar<DataSource, InputGroupSize, NumOutputGroups, LenInputBuffer,
+                             LenIntermediateBuffer, ArbiterType> Stage1;
+  typedef ArbitratedCrossbar<DataSource, NumInputGroups, OutputGroupSize, 0,
+                             LenOutputBuffer, ArbiterType> Stage2;
+
+  Stage1 stage1[NumInputGroups];
+  Stage2 stage2[NumOutputGroups];
+
+ public:
+  HierarchicalCrossbar() { reset(); }
+
+  void reset() {
+#pragma hls_unroll yes
+    for (unsigned g = 0; g < NumInputGroups; g++) {
+      stage1[g].reset();
+    }
+#pragma hls_unroll yes
+    for (unsigned m = 0; m < NumOutputGroups; m++) {
+      stage2[m].reset();
+    }
+  }
+
+  bool isInputEmpty(InputIdx index) {
+    NVHLS_ASSERT_MSG(index < NumInputs, "Input index greater than number of inputs");
+    return stage1[index / InputGroupSize].isInputEmpty(index % InputGroupSize);
+  }
+
+  bool isInputFull(InputIdx index) {
+    NVHLS_ASSERT_MSG(index < NumInputs, "Input index greater than number of inputs");
+    return stage1[index / InputGroupSize].isInputFull(index % InputGroupSize);
+  }
+
+  bool isOutputEmpty(OutputIdx index) {
+    NVHLS_ASSERT_MSG(index < NumOutputs, "Output index greater than number of outputs");
+    return stage2[index / OutputGroupSize].isOutputEmpty(index % OutputGroupSize);
+  }
+
+  bool isOutputFull(OutputIdx index) {
+    NVHLS_ASSERT_MSG(index < NumOutputs, "Output index greater than number of outputs");
+    return stage2[index / OutputGroupSize].isOutputFull(index % OutputGroupSize);
+  }
+
+  DataType peek(OutputIdx index) {
+    return stage2[index / OutputGroupSize].peek(index % OutputGroupSize).data;
+  }
+
+  DataType pop(OutputIdx index) {
+    return stage2[index / OutputGroupSize].pop(index % OutputGroupSize).data;
+  }
+
+  // Pop the data from all selected output lanes, data is already got from peek
+  void pop_all_lanes(bool valid_out[NumOutputs]) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumOutputs; i++) {
+      if (valid_out[i]) {
+        stage2[i / OutputGroupSize].pop(i % OutputGroupSize);
+      }
+    }
+  }
+
+  void run(DataType data_in[NumInputs], OutputIdx dest_in[NumInputs],
+           bool valid_in[NumInputs], DataType data_out[NumOutputs],
+           bool valid_out[NumOutputs], bool ready[NumInputs], InputIdx source[NumOutputs]) {
+    // Second stage first, on the intermediate queue heads of the previous run()
+#pragma hls_unroll yes
+    for (unsigned m = 0; m < NumOutputGroups; m++) {
+      DataSource mid_in[NumInputGroups];
+      typename Stage2::OutputIdx mid_dest[NumInputGroups];
+      bool mid_valid[NumInputGroups];
+      bool mid_ready[NumInputGroups];
+#pragma hls_unroll yes
+      for (unsigned g = 0; g < NumInputGroups; g++) {
+        mid_valid[g] = !stage1[g].isOutputEmpty(m);
+        mid_in[g] = mid_valid[g] ? stage1[g].peek(m) : BitsToType<DataSource>(0);
+        mid_dest[g] = mid_in[g].dest;
+      }
+      DataSource group_out[OutputGroupSize];
+      bool group_valid[OutputGroupSize];
+      stage2[m].run(mid_in, mid_dest, mid_valid, group_out, group_valid, mid_ready);
+#pragma hls_unroll yes
+      for (unsigned g = 0; g < NumInputGroups; g++) {
+        if (mid_valid[g] && mid_ready[g]) {
+          stage1[g].pop(m);
+        }
+      }
+#pragma hls_unroll yes
+      for (unsigned o = 0; o < OutputGroupSize; o++) {
+        unsigned out = m * OutputGroupSize + o;
+        valid_out[out] = group_valid[o];
+        if (group_valid[o]) {
+          data_out[out] = group_out[o].data;
+          source[out] = group_out[o].source;
+        }
+      }
+    }
+
+    // First stage, into the intermediate queues
+#pragma hls_unroll yes
+    for (unsigned g = 0; g < NumInputGroups; g++) {
+      DataSource group_in[InputGroupSize];
+      typename Stage1::OutputIdx group_dest[InputGroupSize];
+      bool group_valid[InputGroupSize];
+      bool group_ready[InputGroupSize];
+#pragma hls_unroll yes
+      for (unsigned i = 0; i < InputGroupSize; i++) {
+        unsigned in = g * InputGroupSize + i;
+        group_in[i].data = data_in[in];
+        group_in[i].dest = dest_in[in] % OutputGroupSize;
+        group_in[i].source = in;
+        group_dest[i] = dest_in[in] / OutputGroupSize;
+        group_valid[i] = valid_in[in];
+      }
+      DataSource mid_out[NumOutputGroups];
+      bool mid_valid[NumOutputGroups];
+      stage1[g].run(group_in, group_dest, group_valid, mid_out, mid_valid, group_ready);
+#pragma hls_unroll yes
+      for (unsigned i = 0; i < InputGroupSize; i++) {
+        ready[g * InputGroupSize + i] = group_ready[i];
+      }
+    }
+  }
+
+  void run(DataType data_in[NumInputs], OutputIdx dest_in[NumInputs],
+           bool valid_in[NumInputs], DataType data_out[NumOutputs],
+           bool valid_out[NumOutputs], bool ready[NumInputs]) {
+    InputIdx source[NumOutputs];
+    run(data_in, dest_in, valid_in, data_out, valid_out, ready, source);
+  }
+
+};  // end HierarchicalCrossbar class
+
 #endif  // end ARBITRATED_CROSSBAR_H
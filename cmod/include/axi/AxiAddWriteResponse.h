@@ -21,6 +21,7 @@
 #include <nvhls_marshaller.h>
 #include <axi/axi4.h>
 #include <TypeToBits.h>
+#include <axi/AxiPostedWrites.h>
 
 /**
  * \brief A simple shim that converts between two AXI configs by adding write responses.
@@ -28,11 +29,23 @@
  *
  * \tparam CfgManager                A valid AXI config describing the manager port, with no write responses.
  * \tparam CfgSubordinate                 A valid AXI config describing the subordinate port, with write responses.
+ * \tparam maxPosted           Most writes in flight to the subordinate in posted-write mode (default: 0, unbounded and unordered).
  *
  * \par Overview
  * This block converts between an AXI manager that does not use write responses and an AXI subordinate that does use write responses.  Most signals are simply passed through from manager to subordinate.  Write responses generated by the subordinate are received and discarded.
  * - Apart from support for write responses, the two AXI configs must otherwise be the same.
  *
+ * \par Posted Writes
+ * The manager never sees the completion of its writes, so by default nothing
+ * bounds how far they run ahead of the subordinate, and a later read of the
+ * same addresses can overtake them.  With maxPosted > 0, the address ranges of
+ * the writes whose response has not come back are kept in an
+ * axi::PostedWrites tracker.  A new AW is accepted only while fewer than
+ * maxPosted writes are posted, and an AR that overlaps a posted write is held
+ * until the write responses of all the writes it overlaps are received.
+ * Reads of other addresses pass the held writes.  In this mode AR, AW and B
+ * share one thread.
+ *
  * \par Usage Guidelines
  *
  * This module sets the stall mode to flush by default to mitigate possible RTL
@@ -47,7 +60,7 @@
  * This may reduce area/power.
  * \par
  */
-template <typename CfgManager, typename CfgSubordinate>
+template <typename CfgManager, typename CfgSubordinate, int maxPosted = 0>
 class AxiAddWriteResponse : public sc_module {
   SC_HAS_PROCESS(AxiAddWriteResponse);
   // Local typedefs and derived constants
@@ -70,11 +83,13 @@ class AxiAddWriteResponse : public sc_module {
   typename axiM::WritePayload W;
   typename axiM::AddrPayload AR;
   typename axiS::ReadPayload R;
-  Connections::Sink<typename axiS::WRespPayload> B;
+  typename axiS::WRespPayload B;
   // Ideally we'd remove the B field entirely, but a stub of it still exists,
   // so we need to connect it to something
   Connections::DummySource<typename axiM::WRespPayload> dummyB;
 
+  axi::PostedWrites<CfgManager, (maxPosted > 0) ? maxPosted : 1> posted;
+
  public:
   // Constructor
   AxiAddWriteResponse(sc_module_name name)
@@ -85,30 +100,35 @@ class AxiAddWriteResponse : public sc_module {
         axiM_write("axiM_write"),
         axiS_read("axiS_read"),
         axiS_write("axiS_write"),
-        B("B"),
         dummyB("dummyB")
   {
 
-    B.clk(clk);
-    B.rst(rst);
-    B.in(axiS_write.b);
-
     dummyB.clk(clk);
     dummyB.rst(rst);
     dummyB.out(axiM_write.b);
 
-    SC_THREAD(axi_read_ar);
-    sensitive << clk.pos();
-    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    if (maxPosted > 0) {
+      SC_THREAD(axi_posted);
+      sensitive << clk.pos();
+      NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    } else {
+      SC_THREAD(axi_read_ar);
+      sensitive << clk.pos();
+      NVHLS_NEG_RESET_SIGNAL_IS(rst);
+
+      SC_THREAD(axi_write_aw);
+      sensitive << clk.pos();
+      NVHLS_NEG_RESET_SIGNAL_IS(rst);
+
+      SC_THREAD(axi_write_b);
+      sensitive << clk.pos();
+      NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    }
 
     SC_THREAD(axi_read_r);
     sensitive << clk.pos();
     NVHLS_NEG_RESET_SIGNAL_IS(rst);
 
-    SC_THREAD(axi_write_aw);
-    sensitive << clk.pos();
-    NVHLS_NEG_RESET_SIGNAL_IS(rst);
-    
     SC_THREAD(axi_write_w);
     sensitive << clk.pos();
     NVHLS_NEG_RESET_SIGNAL_IS(rst);
@@ -166,6 +186,63 @@ class AxiAddWriteResponse : public sc_module {
       }
     }
   }
+
+  void axi_write_b() {
+    axiS_write.b.Reset();
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while(1) {
+      wait();
+      axiS_write.b.PopNB(B);
+    }
+  }
+
+  void axi_posted() {
+    axiM_read.ar.Reset();
+    axiS_read.ar.Reset();
+    axiM_write.aw.Reset();
+    axiS_write.aw.Reset();
+    axiS_write.b.Reset();
+    posted.reset();
+
+    typename axiS::AddrPayload AR_out;
+    typename axiS::AddrPayload AW_out;
+    bool ar_held = false;
+    bool aw_held = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while(1) {
+      wait();
+
+      // Responses of one ID come back in order, so B completes the oldest
+      if (axiS_write.b.PopNB(B)) {
+        posted.retire(B.id.to_uint64());
+      }
+
+      if (!aw_held && !posted.full()) {
+        if (axiM_write.aw.PopNB(AW)) {
+          posted.insert(AW);
+          AW_out = BitsToType<typename axiS::AddrPayload>(TypeToBits(AW));
+          aw_held = true;
+        }
+      }
+      if (aw_held) {
+        aw_held = !axiS_write.aw.PushNB(AW_out);
+      }
+
+      // An AR accepted after an AW is checked against it
+      if (!ar_held) {
+        if (axiM_read.ar.PopNB(AR)) {
+          AR_out = BitsToType<typename axiS::AddrPayload>(TypeToBits(AR));
+          ar_held = true;
+        }
+      }
+      if (ar_held && !posted.conflict(AR)) {
+        ar_held = !axiS_read.ar.PushNB(AR_out);
+      }
+    }
+  }
 };
 
 
@@ -26,6 +26,31 @@
 #include "Arbiter.h"
 #include "TypeToBits.h"
 
+namespace axi {
+namespace arbiter {
+
+/**
+ * \brief An AXI config with idBits more ID bits than Cfg, for the subordinate
+ * port of an ID-remapping AxiArbiter.
+ */
+template <typename Cfg, int idBits>
+struct RemappedIdCfg : public Cfg {
+  enum { idWidth = Cfg::idWidth + idBits };
+};
+
+template <typename Cfg, int idBits, bool remapIds>
+struct SubordinateCfg {
+  typedef Cfg T;
+};
+
+template <typename Cfg, int idBits>
+struct SubordinateCfg<Cfg, idBits, true> {
+  typedef RemappedIdCfg<Cfg, idBits> T;
+};
+
+}  // namespace arbiter
+}  // namespace axi
+
 /**
  * \brief An n-way arbiter that connects multiple AXI manager ports to a single AXI subordinate port.
  * \ingroup AXI
@@ -33,11 +58,16 @@
  * \tparam axiCfg                   A valid AXI config.
  * \tparam numManagers               The number of managers to arbitrate between.
  * \tparam maxOutstandingRequests   The number of oustanding read or write requests that can be tracked with internal state.
+ * \tparam arbType                  The Arbiter arbitration method (default: Roundrobin).
+ * \tparam remapIds                 Prefix the manager index to the AXI ID on the subordinate port, and route responses by ID (default: false).
+ * \tparam qosPriority              Only arbitrate between the pending requests with the highest AxQOS (default: false).
  *
  * \par Overview
- * AxiArbiter connects one or more AXI managers to a single AXI subordinate.  In the case of contention, a round-robin Arbiter selects the next request to pass through.
- * - The arbiter assumes that responses are returned in the order that requests are sent.  Downstream request reordering is currently not supported. 
- * - The AXI configs of all ports must be the same.
+ * AxiArbiter connects one or more AXI managers to a single AXI subordinate.  In the case of contention, an Arbiter (round-robin unless arbType says otherwise) selects the next request to pass through.
+ * - By default the arbiter assumes that responses are returned in the order that requests are sent, and the AXI configs of all ports must be the same.
+ * - With remapIds, the subordinate port uses subordinateCfg, whose ID is numManagers_width bits wider.  Each request leaves with the index of its manager above the manager's ID bits, and each R beat and B response is routed back by those bits with the prefix removed.  Responses may then come back in any order the AXI ID rules allow, so a slow manager or a slow transaction no longer blocks responses to the others.  No response state is kept, so maxOutstandingRequests is unused.
+ * - With qosPriority, axiCfg must have useQoS set.  Each cycle the Arbiter only sees the pending requests whose AxQOS equals the highest pending AxQOS, so a higher-priority request always wins and requests of equal priority share the port in arbType order.  A manager that always has high-priority requests pending can starve the others; AxiQosRegulator can bound its bandwidth.
+ * - Write requests are granted as they arrive, without waiting for the write data of earlier requests.  The manager of each granted request is queued, up to maxOutstandingRequests deep, so that write data is forwarded in request order without gaps between bursts.
  *
  * \par Usage Guidelines
  *
@@ -54,16 +84,24 @@
  * \par
  *
  */
-template <typename axiCfg, int numManagers, int maxOutstandingRequests>
+template <typename axiCfg, int numManagers, int maxOutstandingRequests,
+          arbiter_type arbType = Roundrobin, bool remapIds = false,
+          bool qosPriority = false>
 class AxiArbiter : public sc_module {
  public:
   static const int kDebugLevel = 5;
+  static_assert(!qosPriority || axiCfg::useQoS != 0,
+                "qosPriority requires an AXI config with useQoS");
   sc_in<bool> clk;
   sc_in<bool> reset_bar;
 
   typedef typename axi::axi4<axiCfg> axi_;
   static const int numManagers_width = nvhls::log2_ceil<numManagers>::val;
 
+  typedef typename axi::arbiter::SubordinateCfg<axiCfg, numManagers_width,
+                                                 remapIds>::T subordinateCfg;
+  typedef typename axi::axi4<subordinateCfg> axiS_;
+
   typedef typename axi_::read::template subordinate<>::ARPort axi_rd_subordinate_ar;
   typedef typename axi_::read::template subordinate<>::RPort axi_rd_subordinate_r;
   typedef typename axi_::write::template subordinate<>::AWPort axi_wr_subordinate_aw;
@@ -78,16 +116,16 @@ class AxiArbiter : public sc_module {
   nvhls::nv_array<axi_wr_subordinate_aw, numManagers> axi_wr_m_aw;
   nvhls::nv_array<axi_wr_subordinate_w, numManagers> axi_wr_m_w;
   nvhls::nv_array<axi_wr_subordinate_b, numManagers> axi_wr_m_b;
-  typename axi_::read::template manager<> axi_rd_s;
-  typename axi_::write::template manager<> axi_wr_s;
+  typename axiS_::read::template manager<> axi_rd_s;
+  typename axiS_::write::template manager<> axi_wr_s;
 
   typedef NVUINTW(numManagers_width) inFlight_t;
   FIFO<inFlight_t, maxOutstandingRequests> readQ;
   Connections::Combinational<inFlight_t> read_in_flight;
   FIFO<inFlight_t, maxOutstandingRequests> writeQ;
   Connections::Combinational<inFlight_t> write_in_flight;
+  FIFO<inFlight_t, maxOutstandingRequests> writeDataQ;
   Connections::Combinational<inFlight_t> active_write_manager;
-  Connections::Combinational<NVUINT1> w_last; // true iff w item last bit is set
 
   SC_HAS_PROCESS(AxiArbiter);
 
@@ -124,6 +162,94 @@ class AxiArbiter : public sc_module {
     async_reset_signal_is(reset_bar, false);
   }
 
+  // Request as sent on the subordinate port, with the manager index prefixed
+  // to the ID if remapIds
+  static typename axiS_::AddrPayload to_subordinate(typename axi_::AddrPayload req,
+                                                    inFlight_t manager) {
+    typename axiS_::AddrPayload out;
+    if (remapIds) {
+      out.id = (static_cast<uint64>(manager) << axiCfg::idWidth) | req.id.to_uint64();
+    } else {
+      out.id = req.id;
+    }
+    out.addr = req.addr;
+    out.burst = req.burst;
+    out.len = req.len;
+    out.size = req.size;
+    out.cache = req.cache;
+    out.qos = req.qos;
+    out.auser = req.auser;
+    return out;
+  }
+
+  static typename axiS_::WritePayload to_subordinate(typename axi_::WritePayload data) {
+    typename axiS_::WritePayload out;
+    out.data = data.data;
+    out.last = data.last;
+    out.wstrb = data.wstrb;
+    out.wuser = data.wuser;
+    return out;
+  }
+
+  // The pending requests that may be arbitrated, which with qosPriority are
+  // those with the highest AxQOS
+  static NVUINTW(numManagers) arb_candidates(
+      NVUINTW(numManagers) valid_mask,
+      nvhls::nv_array<typename axi_::AddrPayload, numManagers> &req) {
+    if (!qosPriority) {
+      return valid_mask;
+    }
+    NVUINTW(axi_::Enc::AXQOS::_WIDTH) top_qos = 0;
+    #pragma hls_unroll yes
+    for (int i = 0; i < numManagers; i++) {
+      if (nvhls::get_slc<1>(valid_mask, i) == 1 && req[i].qos.to_uint64() > top_qos) {
+        top_qos = req[i].qos.to_uint64();
+      }
+    }
+    NVUINTW(numManagers) candidates = 0;
+    #pragma hls_unroll yes
+    for (int i = 0; i < numManagers; i++) {
+      if (nvhls::get_slc<1>(valid_mask, i) == 1 && req[i].qos.to_uint64() == top_qos) {
+        candidates = candidates | (1 << i);
+      }
+    }
+    return candidates;
+  }
+
+  // Manager that a remapped response ID belongs to, and its own ID bits
+  static inFlight_t manager_of(uint64 id) {
+    return static_cast<inFlight_t>(id >> axiCfg::idWidth);
+  }
+  static uint64 manager_id(uint64 id) {
+    return id & ((static_cast<uint64>(1) << axiCfg::idWidth) - 1);
+  }
+
+  static typename axi_::ReadPayload to_manager(typename axiS_::ReadPayload resp) {
+    typename axi_::ReadPayload out;
+    if (remapIds) {
+      out.id = manager_id(resp.id.to_uint64());
+    } else {
+      out.id = resp.id;
+    }
+    out.data = resp.data;
+    out.resp = resp.resp;
+    out.last = resp.last;
+    out.ruser = resp.ruser;
+    return out;
+  }
+
+  static typename axi_::WRespPayload to_manager(typename axiS_::WRespPayload resp) {
+    typename axi_::WRespPayload out;
+    if (remapIds) {
+      out.id = manager_id(resp.id.to_uint64());
+    } else {
+      out.id = resp.id;
+    }
+    out.resp = resp.resp;
+    out.buser = resp.buser;
+    return out;
+  }
+
   void run_ar() {
     #pragma hls_unroll yes
     for (int i = 0; i < numManagers; i++) {
@@ -135,7 +261,7 @@ class AxiArbiter : public sc_module {
     nvhls::nv_array<typename axi_::AddrPayload, numManagers> AR_reg;
     NVUINTW(numManagers) valid_mask = 0;
     NVUINTW(numManagers) select_mask = 0;
-    Arbiter<numManagers> arb;
+    Arbiter<numManagers, arbType> arb;
 
     #pragma hls_pipeline_init_interval 1
     #pragma pipeline_stall_mode flush
@@ -150,18 +276,20 @@ class AxiArbiter : public sc_module {
         }
       }
 
-      select_mask = arb.pick(valid_mask);
+      select_mask = arb.pick(arb_candidates(valid_mask, AR_reg));
 
       for (int i = 0; i < numManagers; i++) {
         if (nvhls::get_slc<1>(select_mask, i) == 1) {
-          axi_rd_s.ar.Push(AR_reg[i]);
+          axi_rd_s.ar.Push(to_subordinate(AR_reg[i], i));
           select_mask = 0;
           valid_mask = ~(~valid_mask | (1 << i));
           CDCOUT(sc_time_stamp() << " " << name() << " Pushed read request:"
                         << " from_port=" << i
                         << " request=[" << AR_reg[i] << "]"
                         << endl, kDebugLevel);
-          read_in_flight.Push(i);
+          if (!remapIds) {
+            read_in_flight.Push(i);
+          }
         }
       }
     }
@@ -176,7 +304,7 @@ class AxiArbiter : public sc_module {
     read_in_flight.ResetRead();
     readQ.reset();
 
-    typename axi_::ReadPayload R_reg;
+    typename axiS_::ReadPayload R_reg;
     inFlight_t inFlight_reg;
     inFlight_t inFlight_resp_reg;
 
@@ -187,26 +315,37 @@ class AxiArbiter : public sc_module {
     while (1) {
       wait();
 
-      if (!readQ.isFull()) {
-        if (read_in_flight.PopNB(inFlight_reg)) {
-          readQ.push(inFlight_reg);
-        }
-      }
-
-      if (!read_inProgress) {
-        if (!readQ.isEmpty()) {
-          inFlight_resp_reg = readQ.pop();
-          read_inProgress = 1;
-        }
-      } else {
+      if (remapIds) {
         if (axi_rd_s.r.PopNB(R_reg)) {
-          axi_rd_m_r[inFlight_resp_reg].Push(R_reg);
+          inFlight_resp_reg = manager_of(R_reg.id.to_uint64());
+          axi_rd_m_r[inFlight_resp_reg].Push(to_manager(R_reg));
           CDCOUT(sc_time_stamp() << " " << name() << " Pushed read response:"
                         << " to_port=" << inFlight_resp_reg
                         << " response=[" << R_reg << "]"
                         << endl, kDebugLevel);
-          if (R_reg.last == 1)
-            read_inProgress = 0;
+        }
+      } else {
+        if (!readQ.isFull()) {
+          if (read_in_flight.PopNB(inFlight_reg)) {
+            readQ.push(inFlight_reg);
+          }
+        }
+
+        if (!read_inProgress) {
+          if (!readQ.isEmpty()) {
+            inFlight_resp_reg = readQ.pop();
+            read_inProgress = 1;
+          }
+        } else {
+          if (axi_rd_s.r.PopNB(R_reg)) {
+            axi_rd_m_r[inFlight_resp_reg].Push(to_manager(R_reg));
+            CDCOUT(sc_time_stamp() << " " << name() << " Pushed read response:"
+                          << " to_port=" << inFlight_resp_reg
+                          << " response=[" << R_reg << "]"
+                          << endl, kDebugLevel);
+            if (R_reg.last == 1)
+              read_inProgress = 0;
+          }
         }
       }
     }
@@ -220,15 +359,14 @@ class AxiArbiter : public sc_module {
     axi_wr_s.aw.Reset();
     write_in_flight.ResetWrite();
     active_write_manager.ResetWrite();
-    w_last.ResetRead();
-
-    inFlight_t active_manager;
 
     nvhls::nv_array<typename axi_::AddrPayload, numManagers> AW_reg;
     NVUINTW(numManagers) valid_mask = 0;
     NVUINTW(numManagers) select_mask = 0;
-    Arbiter<numManagers> arb;
+    Arbiter<numManagers, arbType> arb;
 
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
     while (1) {
       wait();
 
@@ -241,53 +379,65 @@ class AxiArbiter : public sc_module {
         }
       }
 
-      select_mask = arb.pick(valid_mask);
+      select_mask = arb.pick(arb_candidates(valid_mask, AW_reg));
 
-      if (select_mask != 0) {
-        #pragma hls_unroll yes
-        for (int i = 0; i < numManagers; i++) {
-          if (nvhls::get_slc<1>(select_mask, i) == 1) {
-            active_manager = i;
+      #pragma hls_unroll yes
+      for (int i = 0; i < numManagers; i++) {
+        if (nvhls::get_slc<1>(select_mask, i) == 1) {
+          axi_wr_s.aw.Push(to_subordinate(AW_reg[i], i));
+          select_mask = 0;
+          valid_mask = ~(~valid_mask | (1 << i));
+          CDCOUT(sc_time_stamp() << " " << name() << " Pushed write request:"
+                        << " from_port=" << i
+                        << " request=[" << AW_reg[i] << "]"
+                        << endl, kDebugLevel);
+          active_write_manager.Push(i);
+          if (!remapIds) {
+            write_in_flight.Push(i);
           }
         }
-
-        axi_wr_s.aw.Push(AW_reg[active_manager]);
-        active_write_manager.Push(active_manager);
-        write_in_flight.Push(active_manager);
-
-        #pragma hls_pipeline_init_interval 1
-        #pragma pipeline_stall_mode flush
-        while (w_last.Pop() == false) {
-        }
-
-        select_mask = 0;
-        valid_mask = ~(~valid_mask | (1 << active_manager));
       }
     }
   }
 
   void run_w() {
-    typename axi_::WritePayload W_reg;
-    active_write_manager.ResetRead();
-    w_last.ResetWrite();
-    axi_wr_s.w.Reset();
     #pragma hls_unroll yes
     for (int i = 0; i < numManagers; i++) {
       axi_wr_m_w[i].Reset();
     }
+    axi_wr_s.w.Reset();
+    active_write_manager.ResetRead();
+    writeDataQ.reset();
 
-    wait();
+    typename axi_::WritePayload W_reg;
+    inFlight_t inFlight_reg;
+    inFlight_t active_manager = 0;
+    bool write_inProgress = 0;
 
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
     while (1) {
-      inFlight_t active_manager = active_write_manager.Pop();
-
-      #pragma hls_pipeline_init_interval 1
-      #pragma pipeline_stall_mode flush
-      do {
-        W_reg = axi_wr_m_w[active_manager].Pop();
-        axi_wr_s.w.Push(W_reg);
-        w_last.Push(W_reg.last.to_uint64());
-      } while (W_reg.last != 1);
+      wait();
+
+      if (!writeDataQ.isFull()) {
+        if (active_write_manager.PopNB(inFlight_reg)) {
+          writeDataQ.push(inFlight_reg);
+        }
+      }
+
+      if (!write_inProgress && !writeDataQ.isEmpty()) {
+        active_manager = writeDataQ.pop();
+        write_inProgress = 1;
+      }
+
+      if (write_inProgress) {
+        if (axi_wr_m_w[active_manager].PopNB(W_reg)) {
+          axi_wr_s.w.Push(to_subordinate(W_reg));
+          if (W_reg.last == 1) {
+            write_inProgress = 0;
+          }
+        }
+      }
     }
   }
 
@@ -300,7 +450,7 @@ class AxiArbiter : public sc_module {
     write_in_flight.ResetRead();
     writeQ.reset();
 
-    typename axi_::WRespPayload B_reg;
+    typename axiS_::WRespPayload B_reg;
     inFlight_t inFlight_reg;
     inFlight_t inFlight_resp_reg;
     bool write_inProgress = 0;
@@ -310,25 +460,33 @@ class AxiArbiter : public sc_module {
     while (1) {
       wait();
 
-      if (!writeQ.isFull()) {
-        if (write_in_flight.PopNB(inFlight_reg)) {
-          writeQ.push(inFlight_reg);
-        }
-      }
-
-      if (!write_inProgress) {
-        if (!writeQ.isEmpty()) {
-          inFlight_resp_reg = writeQ.pop();
-          write_inProgress = 1;
-        }
-      } else {
+      if (remapIds) {
         if (axiCfg::useWriteResponses) {
           if (axi_wr_s.b.PopNB(B_reg)) {
-            axi_wr_m_b[inFlight_resp_reg].Push(B_reg);
-            write_inProgress = 0;
+            axi_wr_m_b[manager_of(B_reg.id.to_uint64())].Push(to_manager(B_reg));
+          }
+        }
+      } else {
+        if (!writeQ.isFull()) {
+          if (write_in_flight.PopNB(inFlight_reg)) {
+            writeQ.push(inFlight_reg);
+          }
+        }
+
+        if (!write_inProgress) {
+          if (!writeQ.isEmpty()) {
+            inFlight_resp_reg = writeQ.pop();
+            write_inProgress = 1;
           }
         } else {
-          write_inProgress = 0;
+          if (axiCfg::useWriteResponses) {
+            if (axi_wr_s.b.PopNB(B_reg)) {
+              axi_wr_m_b[inFlight_resp_reg].Push(to_manager(B_reg));
+              write_inProgress = 0;
+            }
+          } else {
+            write_inProgress = 0;
+          }
         }
       }
     }
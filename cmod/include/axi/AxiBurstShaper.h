@@ -0,0 +1,418 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXI_BURST_SHAPER_H__
+#define __AXI_BURST_SHAPER_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <nvhls_message.h>
+#include <axi/axi4.h>
+#include <fifo.h>
+
+/**
+ * \brief Coalesces short sequential AXI bursts and splits long or 4KB-crossing ones.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg           A valid AXI config.
+ * \tparam maxBurstBeats    Maximum length in beats of the bursts sent to the subordinate (default: axiCfg::maxBurstSize).
+ * \tparam coalesceTimeout  Number of idle cycles an open burst waits for a sequential request before it is sent. With 0, only back-to-back requests are coalesced.
+ * \tparam maxOutstanding   Number of manager bursts, and of subordinate bursts, that can be tracked with internal state (default: 4). It also caps the manager read bursts coalesced into one subordinate burst, at maxOutstanding - 1.
+ *
+ * \par Overview
+ * AxiBurstShaper sits between an AXI manager and an AXI subordinate with the
+ * same config, and reshapes INCR bursts independently on the read and the
+ * write side:
+ * - A request with the same ID that starts where the open burst ends is
+ *   appended to it, so runs of single-beat or short sequential requests leave
+ *   as one long burst.
+ * - No burst sent to the subordinate is longer than maxBurstBeats or crosses a
+ *   4KB boundary; a manager burst that would is split across several.
+ * - Read data is passed through with RLAST regenerated at the manager burst
+ *   boundaries. Write data is passed through with WLAST regenerated at the
+ *   subordinate burst boundaries.
+ * - Each manager write burst gets one write response, carrying the worst BRESP
+ *   of the subordinate bursts it was sent in.
+ * - An open burst is sent when the next request cannot be appended to it, when
+ *   it is full, or after coalesceTimeout idle cycles. Write data for an open
+ *   burst waits with it, so subordinates that accept W before AW are not
+ *   needed.
+ * - Like AxiArbiter, the shaper assumes that responses are returned in the
+ *   order that requests are sent. Manager beats must use the full data width.
+ *
+ * \par Usage Guidelines
+ *
+ * This module sets the stall mode to flush by default to mitigate possible RTL
+ * bugs that can occur in the default stall mode. If you are confident that
+ * this class of bugs will not occur in your use case, you can change the stall
+ * mode via TCL directive:
+ *
+ * \code
+ * directive set /path/to/AxiBurstShaper/run_ar/while -PIPELINE_STALL_MODE stall
+ * \endcode
+ *
+ * This may reduce area/power.
+ * \par
+ *
+ */
+template <typename axiCfg, int maxBurstBeats = axiCfg::maxBurstSize,
+          int coalesceTimeout = 4, int maxOutstanding = 4>
+class AxiBurstShaper : public sc_module {
+ public:
+  static const int kDebugLevel = 5;
+  typedef typename axi::axi4<axiCfg> axi4_;
+  typedef typename axi4_::Addr Addr;
+
+  static const int bytesPerBeat = axiCfg::dataWidth >> 3;
+  static const int log2BytesPerBeat = nvhls::log2_ceil<bytesPerBeat>::val;
+  static const int log2PageBytes = 12;
+
+  static_assert(axiCfg::useBurst, "AxiBurstShaper needs a config with bursts");
+  static_assert(maxBurstBeats >= 1 && maxBurstBeats <= axiCfg::maxBurstSize,
+                "maxBurstBeats must be between 1 and axiCfg::maxBurstSize");
+  static_assert(maxBurstBeats * bytesPerBeat <= (1 << log2PageBytes),
+                "A maxBurstBeats burst must fit in 4KB");
+
+  // Beat counts of manager and subordinate bursts
+  typedef NVUINTW(nvhls::index_width<axiCfg::maxBurstSize + 1>::val) Beats;
+  typedef NVUINTW(nvhls::index_width<coalesceTimeout + 1>::val) IdleCount;
+
+  /**
+   * \brief Manager bursts that end in a subordinate write burst, and whether a
+   * manager burst continues past its end.
+   */
+  struct WriteInfo : public nvhls_message {
+    Beats ends;
+    bool tail;
+    static const int width = Beats::width + 1;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m & ends;
+      m & tail;
+    }
+  };
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axi4_::read::template subordinate<> axiM_read;
+  typename axi4_::write::template subordinate<> axiM_write;
+  typename axi4_::read::template manager<> axiS_read;
+  typename axi4_::write::template manager<> axiS_write;
+
+ private:
+  Connections::Combinational<Beats> rd_lens;   // manager read burst lengths
+  Connections::Combinational<Beats> wr_lens;   // subordinate write burst lengths
+  Connections::Combinational<WriteInfo> wr_info;
+  FIFO<Beats, maxOutstanding> rd_q;
+  FIFO<Beats, maxOutstanding> wr_q;
+  FIFO<WriteInfo, maxOutstanding> b_q;
+
+ public:
+  SC_HAS_PROCESS(AxiBurstShaper);
+
+  AxiBurstShaper(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axiM_read("axiM_read"),
+        axiM_write("axiM_write"),
+        axiS_read("axiS_read"),
+        axiS_write("axiS_write"),
+        rd_lens("rd_lens"),
+        wr_lens("wr_lens"),
+        wr_info("wr_info") {
+    SC_THREAD(run_ar);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_r);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_aw);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_w);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_b);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ private:
+  static Addr align(const Addr& addr) {
+    return (addr >> log2BytesPerBeat) << log2BytesPerBeat;
+  }
+
+  // Beats left before addr reaches the next 4KB boundary
+  static Beats beats_to_page_end(const Addr& addr) {
+    NVUINTW(log2PageBytes + 1) page_offset = nvhls::get_slc<log2PageBytes>(addr, 0);
+    NVUINTW(log2PageBytes + 1) left = (1 << log2PageBytes) - page_offset;
+    NVUINTW(log2PageBytes + 1) beats = left >> log2BytesPerBeat;
+    return (beats < maxBurstBeats) ? Beats(beats) : Beats(maxBurstBeats);
+  }
+
+  /*
+   * Request side of either direction. Manager requests are cut into pieces
+   * that are appended to an open subordinate burst, which is sent once it
+   * cannot grow any further.
+   */
+  template <typename InPort, typename OutPort>
+  void shape(InPort& in, OutPort& out, bool is_write) {
+    typename axi4_::AddrPayload req;        // current manager request
+    bool have_req = false;
+    bool started = false;                   // part of req is already in the open burst
+    Addr req_addr = 0;                      // address of the next beat of req
+    Beats req_left = 0;                     // beats of req not yet in a burst
+
+    typename axi4_::AddrPayload burst;      // open subordinate burst
+    bool open = false;
+    Addr burst_end = 0;                     // address following the open burst
+    Beats burst_beats = 0;
+    Beats burst_room = 0;                   // beats the open burst can still take
+    Beats burst_ends = 0;                   // manager bursts ending in it
+    IdleCount idle = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!have_req) {
+        if (in.PopNB(req)) {
+          have_req = true;
+          started = false;
+          req_addr = req.addr;
+          req_left = req.len + 1;
+          if (!is_write) {
+            rd_lens.Push(req_left);
+          }
+          CDCOUT(sc_time_stamp() << " " << name() << " Received request: ["
+                        << req << "]"
+                        << endl, kDebugLevel);
+        }
+      }
+
+      // Read lengths are pushed as requests arrive, so an open read burst
+      // must leave rd_q room for the next request
+      bool full = burst_room == 0 ||
+                  (!is_write && burst_ends == maxOutstanding - 1);
+      bool append = have_req && open && req.id.to_uint64() == burst.id.to_uint64() &&
+                    req_addr == burst_end && !full;
+      bool close = open && ((have_req && !append) || full ||
+                            (!have_req && idle >= coalesceTimeout));
+
+      if (close) {
+        burst.len = burst_beats - 1;
+        out.Push(burst);
+        if (is_write) {
+          wr_lens.Push(burst_beats);
+          WriteInfo info;
+          info.ends = burst_ends;
+          info.tail = started;
+          wr_info.Push(info);
+        }
+        CDCOUT(sc_time_stamp() << " " << name() << " Sent burst: ["
+                      << burst << "]"
+                      << endl, kDebugLevel);
+        open = false;
+      } else if (have_req) {
+        if (!open) {
+          // Start a new burst with the fields of this request
+          burst = req;
+          burst.addr = req_addr;
+          burst_end = align(req_addr);
+          burst_beats = 0;
+          burst_room = beats_to_page_end(burst_end);
+          burst_ends = 0;
+          open = true;
+        }
+        Beats n = (req_left < burst_room) ? req_left : burst_room;
+        burst_beats += n;
+        burst_room -= n;
+        burst_end = burst_end + (static_cast<Addr>(n) << log2BytesPerBeat);
+        req_addr = burst_end;
+        req_left -= n;
+        started = true;
+        idle = 0;
+        if (req_left == 0) {
+          burst_ends++;
+          have_req = false;
+          started = false;
+        }
+      } else if (open && idle < coalesceTimeout) {
+        idle++;
+      }
+    }
+  }
+
+  void run_ar() {
+    axiM_read.ar.Reset();
+    axiS_read.ar.Reset();
+    rd_lens.ResetWrite();
+    shape(axiM_read.ar, axiS_read.ar, false);
+  }
+
+  void run_r() {
+    axiM_read.r.Reset();
+    axiS_read.r.Reset();
+    rd_lens.ResetRead();
+    rd_q.reset();
+
+    bool active = false;
+    Beats left = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!rd_q.isFull()) {
+        Beats len;
+        if (rd_lens.PopNB(len)) {
+          rd_q.push(len);
+        }
+      }
+
+      if (!active && !rd_q.isEmpty()) {
+        left = rd_q.pop();
+        active = true;
+      }
+
+      if (active) {
+        typename axi4_::ReadPayload R;
+        if (axiS_read.r.PopNB(R)) {
+          R.last = (left == 1);
+          axiM_read.r.Push(R);
+          left--;
+          if (left == 0) {
+            active = false;
+          }
+        }
+      }
+    }
+  }
+
+  void run_aw() {
+    axiM_write.aw.Reset();
+    axiS_write.aw.Reset();
+    wr_lens.ResetWrite();
+    wr_info.ResetWrite();
+    shape(axiM_write.aw, axiS_write.aw, true);
+  }
+
+  void run_w() {
+    axiM_write.w.Reset();
+    axiS_write.w.Reset();
+    wr_lens.ResetRead();
+    wr_q.reset();
+
+    bool active = false;
+    Beats left = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!wr_q.isFull()) {
+        Beats len;
+        if (wr_lens.PopNB(len)) {
+          wr_q.push(len);
+        }
+      }
+
+      if (!active && !wr_q.isEmpty()) {
+        left = wr_q.pop();
+        active = true;
+      }
+
+      if (active) {
+        typename axi4_::WritePayload W;
+        if (axiM_write.w.PopNB(W)) {
+          W.last = (left == 1);
+          axiS_write.w.Push(W);
+          left--;
+          if (left == 0) {
+            active = false;
+          }
+        }
+      }
+    }
+  }
+
+  void run_b() {
+    axiM_write.b.Reset();
+    axiS_write.b.Reset();
+    wr_info.ResetRead();
+    b_q.reset();
+
+    bool active = false;
+    WriteInfo info;
+    typename axi4_::WRespPayload B;
+    typename axi4_::Resp resp = 0;    // response of the current subordinate burst
+    typename axi4_::Resp carry = 0;   // worst response of the manager burst in progress
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!b_q.isFull()) {
+        WriteInfo in;
+        if (wr_info.PopNB(in)) {
+          b_q.push(in);
+        }
+      }
+
+      if (axiCfg::useWriteResponses) {
+        if (!active && !b_q.isEmpty()) {
+          if (axiS_write.b.PopNB(B)) {
+            info = b_q.pop();
+            resp = B.resp;
+            if (carry > B.resp) {
+              B.resp = carry;
+            }
+            active = true;
+          }
+        }
+
+        if (active) {
+          if (info.ends == 0) {
+            carry = B.resp;
+            active = false;
+          } else if (axiM_write.b.PushNB(B)) {
+            // Later manager bursts only saw this subordinate burst
+            B.resp = resp;
+            info.ends--;
+            if (info.ends == 0) {
+              carry = info.tail ? resp : typename axi4_::Resp(0);
+              active = false;
+            }
+          }
+        }
+      }
+    }
+  }
+};
+
+#endif
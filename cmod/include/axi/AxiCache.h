@@ -0,0 +1,687 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXICACHE_H__
+#define __AXICACHE_H__
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <hls_globals.h>
+#include <nvhls_int.h>
+#include <nvhls_module.h>
+#include <axi/axi4.h>
+#include <mem_array.h>
+#include <fifo.h>
+#include <Arbiter.h>
+#include <ReorderBuf.h>
+
+/**
+ * \brief Replacement policies of AxiCache.
+ * \ingroup Cache
+ *
+ * - CacheLRU: true LRU from per-way age counters.
+ * - CachePseudoLRU: tree pseudo-LRU, NumWays-1 bits per set (NumWays must be
+ *   a power of two).
+ * - CacheRandom: a 16-bit LFSR picks the way.
+ */
+enum cache_replacement_type { CacheLRU, CachePseudoLRU, CacheRandom };
+
+/**
+ * \brief A set-associative, non-blocking cache between an AXI manager and an AXI subordinate.
+ * \ingroup Cache
+ *
+ * \tparam axiCfg       A valid AXI config; both ports use it. Bursts and write responses are required.
+ * \tparam NumSets      Number of sets (power of two).
+ * \tparam NumWays      Associativity.
+ * \tparam LineWords    Line size in AXI data words (power of two, at most maxBurstSize).
+ * \tparam Replacement  A cache_replacement_type.
+ * \tparam WriteBack    true: write-back, write-allocate. false: write-through, write-allocate.
+ * \tparam NumMSHRs     Number of misses that can be outstanding at once (at most 2^idWidth).
+ * \tparam RobDepth     Number of read beats in flight between lookup and the R channel.
+ *
+ * \par Overview
+ * AxiCache serves the AXI subordinate ports if_rd/if_wr from a tag array and
+ * a data array, each a mem_array_sep with one bank per way, and refills lines
+ * over the AXI manager ports if_mem_rd/if_mem_wr with one burst of LineWords
+ * beats.
+ * - One lookup per cycle; an Arbiter alternates between the read and the
+ *   write beat at the head of their channels. Bursts are looked up beat by
+ *   beat, so they may cross lines.
+ * - A miss allocates an MSHR (miss status holding register) and the channel
+ *   moves on: read beats wait in a ReorderBuf so R stays in request order,
+ *   and a write beat is held in its MSHR and merged into the line when the
+ *   refill arrives, so B is returned right away. An access to a line that
+ *   already has an MSHR waits until that refill completes.
+ * - MSHRs issue their refill reads through an Arbiter, using the MSHR index
+ *   as the AXI ID. A refill is only issued when no write to memory is in
+ *   flight, so it cannot overtake a writeback or write-through of the line.
+ * - The victim is an invalid way if there is one, otherwise the
+ *   Replacement choice; ways with a refill in flight are never chosen.
+ *   With WriteBack a dirty victim is written back before its way is refilled.
+ *   Without WriteBack every write also goes to memory as a full, merged word.
+ * - hits, misses, evictions, writebacks and stall cycles are counted through
+ *   match::Module and printed by DumpStats().
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <axi/AxiCache.h>
+ *
+ *      ...
+ *      AxiCache<axi::cfg::standard, 16, 4, 4, CachePseudoLRU> cache;
+ *      ...
+ *      cache.clk(clk);
+ *      cache.rst(reset_bar);
+ *      cache.if_rd(cpu_read);
+ *      cache.if_wr(cpu_write);
+ *      cache.if_mem_rd(mem_read);
+ *      cache.if_mem_wr(mem_write);
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg, int NumSets, int NumWays, int LineWords,
+          cache_replacement_type Replacement = CacheLRU, bool WriteBack = true,
+          int NumMSHRs = 4, int RobDepth = 8>
+class AxiCache : public match::Module {
+ public:
+  static const int kDebugLevel = 3;
+
+  typedef typename axi::axi4<axiCfg> axi4_;
+  static const int bytesPerWord = axiCfg::dataWidth >> 3;
+
+  static_assert(axiCfg::useBurst && axiCfg::maxBurstSize >= LineWords,
+                "Refills need bursts of LineWords beats");
+  static_assert(axiCfg::useWriteResponses, "AxiCache needs write responses");
+  static_assert(axiCfg::idWidth > 0 && (1 << axiCfg::idWidth) >= NumMSHRs,
+                "The AXI ID must be wide enough for an MSHR index");
+  static_assert((NumSets & (NumSets - 1)) == 0 && (LineWords & (LineWords - 1)) == 0,
+                "NumSets and LineWords must be powers of two");
+  static_assert(Replacement != CachePseudoLRU || (NumWays & (NumWays - 1)) == 0,
+                "Pseudo-LRU needs a power-of-two number of ways");
+
+  typename axi4_::read::template subordinate<> if_rd;
+  typename axi4_::write::template subordinate<> if_wr;
+  typename axi4_::read::template manager<> if_mem_rd;
+  typename axi4_::write::template manager<> if_mem_wr;
+
+ protected:
+  enum {
+    kByteBits = nvhls::log2_ceil<bytesPerWord>::val,
+    kWordBits = nvhls::log2_ceil<LineWords>::val,
+    kSetBits = nvhls::log2_ceil<NumSets>::val,
+    kWayBits = nvhls::log2_ceil<NumWays>::val,
+    kTagBits = axi4_::ADDR_WIDTH - kByteBits - kWordBits - kSetBits,
+    kNumByteEnables = (axi4_::WSTRB_WIDTH > 0 ? axi4_::WSTRB_WIDTH : 1),
+  };
+
+  typedef typename axi4_::Addr Addr;
+  typedef typename axi4_::Data Data;
+  typedef NVUINTW(kTagBits) Tag;
+  typedef NVUINTW(nvhls::index_width<NumSets>::val) SetIdx;
+  typedef NVUINTW(nvhls::index_width<NumWays>::val) WayIdx;
+  typedef NVUINTW(nvhls::index_width<LineWords>::val) WordIdx;
+  typedef NVUINTW(NumWays) WayMask;
+  typedef NVUINTW(NumMSHRs) MshrMask;
+  typedef NVUINTW(nvhls::index_width<NumMSHRs>::val) MshrIdx;
+  typedef NVUINTW(kNumByteEnables) ByteMask;
+
+  // Tag entry: bit 0 valid, bit 1 dirty, tag above
+  typedef NVUINTW(kTagBits + 2) TagEntry;
+  typedef mem_array_sep<TagEntry, NumSets * NumWays, NumWays> TagArray;
+  typedef mem_array_sep<Data, NumSets * NumWays * LineWords, NumWays, kNumByteEnables> DataArray;
+  typedef ReorderBuf<typename axi4_::ReadPayload, RobDepth, RobDepth> Rob;
+
+  enum MshrState { kWriteback, kIssue, kRefill };
+
+  struct WriteThrough : public nvhls_message {
+    Addr addr;
+    Data data;
+    static const int width = axi4_::ADDR_WIDTH + axi4_::DATA_WIDTH;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m & addr;
+      m & data;
+    }
+  };
+
+  TagArray tags;
+  DataArray data;
+  Rob rob;
+
+  // MSHRs, each with a single target
+  bool mshr_valid[NumMSHRs];
+  MshrState mshr_state[NumMSHRs];
+  SetIdx mshr_set[NumMSHRs];
+  WayIdx mshr_way[NumMSHRs];
+  Tag mshr_tag[NumMSHRs];
+  Tag mshr_victim_tag[NumMSHRs];
+  WordIdx mshr_beat[NumMSHRs];
+  WordIdx mshr_word[NumMSHRs];
+  bool mshr_is_write[NumMSHRs];
+  typename Rob::Id mshr_rob_id[NumMSHRs];
+  typename axi4_::ReadPayload mshr_rsp[NumMSHRs];
+  Data mshr_data[NumMSHRs];
+  ByteMask mshr_strb[NumMSHRs];
+
+  // Replacement state
+  WayIdx lru_age[NumSets][NumWays];
+  WayMask plru_bits[NumSets];
+  NVUINT16 lfsr;
+
+  Arbiter<2> lookup_arb;
+  Arbiter<NumMSHRs> issue_arb;
+
+  FIFO<WriteThrough, 4> wt_queue;
+  FIFO<typename axi4_::WRespPayload, 4> b_queue;
+
+  match::StatHandle read_hits_stat;
+  match::StatHandle read_misses_stat;
+  match::StatHandle write_hits_stat;
+  match::StatHandle write_misses_stat;
+  match::StatHandle evictions_stat;
+  match::StatHandle writebacks_stat;
+  match::StatHandle line_busy_stalls_stat;
+  match::StatHandle mshr_full_stalls_stat;
+
+ public:
+  SC_HAS_PROCESS(AxiCache);
+  AxiCache(sc_module_name name_)
+      : match::Module(name_),
+        if_rd("if_rd"),
+        if_wr("if_wr"),
+        if_mem_rd("if_mem_rd"),
+        if_mem_wr("if_mem_wr") {
+    read_hits_stat = this->RegisterStat("read_hits");
+    read_misses_stat = this->RegisterStat("read_misses");
+    write_hits_stat = this->RegisterStat("write_hits");
+    write_misses_stat = this->RegisterStat("write_misses");
+    evictions_stat = this->RegisterStat("evictions");
+    writebacks_stat = this->RegisterStat("writebacks");
+    line_busy_stalls_stat = this->RegisterStat("line_busy_stall_cycles");
+    mshr_full_stalls_stat = this->RegisterStat("mshr_full_stall_cycles");
+
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+ protected:
+  static SetIdx set_of(const Addr& addr) {
+    return nvhls::get_slc<nvhls::index_width<NumSets>::val>(
+        addr >> (kByteBits + kWordBits), 0) % NumSets;
+  }
+  static WordIdx word_of(const Addr& addr) {
+    return nvhls::get_slc<nvhls::index_width<LineWords>::val>(addr >> kByteBits, 0) %
+           LineWords;
+  }
+  static Tag tag_of(const Addr& addr) {
+    return nvhls::get_slc<kTagBits>(addr, kByteBits + kWordBits + kSetBits);
+  }
+  static Addr line_addr(const Tag& tag, const SetIdx& set) {
+    Addr addr = tag;
+    addr = (addr << kSetBits) | Addr(set);
+    return addr << (kWordBits + kByteBits);
+  }
+  static typename DataArray::LocalIndex data_idx(const SetIdx& set, const WordIdx& word) {
+    return static_cast<unsigned>(set) * LineWords + static_cast<unsigned>(word);
+  }
+  static TagEntry make_entry(const Tag& tag, bool dirty) {
+    TagEntry entry = 0;
+    entry[0] = 1;
+    entry[1] = dirty;
+    return nvhls::set_slc(entry, tag, 2);
+  }
+
+  void reset_state() {
+    rob.reset();
+    wt_queue.reset();
+    b_queue.reset();
+    lookup_arb.reset();
+    issue_arb.reset();
+    lfsr = 0xACE1;
+#pragma hls_unroll yes
+    for (int m = 0; m < NumMSHRs; m++) {
+      mshr_valid[m] = false;
+    }
+    for (int s = 0; s < NumSets; s++) {
+#pragma hls_unroll yes
+      for (int w = 0; w < NumWays; w++) {
+        tags.write(s, w, 0);
+        lru_age[s][w] = w;
+      }
+      plru_bits[s] = 0;
+    }
+  }
+
+  // Make way the most recently used way of set
+  void touch(const SetIdx& set, const WayIdx& way) {
+    if (Replacement == CacheLRU) {
+      WayIdx age = lru_age[set][way];
+#pragma hls_unroll yes
+      for (int w = 0; w < NumWays; w++) {
+        if (lru_age[set][w] < age) {
+          lru_age[set][w]++;
+        }
+      }
+      lru_age[set][way] = 0;
+    } else if (Replacement == CachePseudoLRU) {
+      // Heap-ordered tree: node n has children 2n and 2n+1, leaves are
+      // NumWays + way. Each node on the path points away from way.
+      unsigned node = NumWays + static_cast<unsigned>(way);
+#pragma hls_unroll yes
+      for (int l = 0; l < kWayBits; l++) {
+        plru_bits[set][node >> 1] = ((node & 1) == 0);
+        node >>= 1;
+      }
+    }
+  }
+
+  WayIdx policy_victim(const SetIdx& set) {
+    WayIdx victim = 0;
+    if (Replacement == CacheLRU) {
+#pragma hls_unroll yes
+      for (int w = 0; w < NumWays; w++) {
+        if (lru_age[set][w] == NumWays - 1) {
+          victim = w;
+        }
+      }
+    } else if (Replacement == CachePseudoLRU) {
+      unsigned node = 1;
+#pragma hls_unroll yes
+      for (int l = 0; l < kWayBits; l++) {
+        node = 2 * node + (plru_bits[set][node] ? 1 : 0);
+      }
+      victim = node - NumWays;
+    } else {
+      victim = lfsr % NumWays;
+    }
+    return victim;
+  }
+
+  // Pick the way to refill in set; false if every way has a refill in flight
+  bool choose_victim(const SetIdx& set, const WayMask& valid, WayIdx& victim) {
+    WayMask locked = 0;
+#pragma hls_unroll yes
+    for (int m = 0; m < NumMSHRs; m++) {
+      if (mshr_valid[m] && mshr_set[m] == set) {
+        locked[mshr_way[m]] = 1;
+      }
+    }
+    WayMask free_ways = ~valid & ~locked;
+    WayMask unlocked = ~locked;
+    if (free_ways != 0) {
+      victim = nvhls::leading_ones<NumWays, WayMask, WayIdx>(free_ways);
+      return true;
+    }
+    if (unlocked == 0) {
+      return false;
+    }
+    victim = policy_victim(set);
+    if (locked[victim]) {
+      victim = nvhls::leading_ones<NumWays, WayMask, WayIdx>(unlocked);
+    }
+    return true;
+  }
+
+  bool line_busy(const SetIdx& set, const Tag& tag) {
+    bool busy = false;
+#pragma hls_unroll yes
+    for (int m = 0; m < NumMSHRs; m++) {
+      if (mshr_valid[m] && mshr_set[m] == set && mshr_tag[m] == tag) {
+        busy = true;
+      }
+    }
+    return busy;
+  }
+
+  bool free_mshr(MshrIdx& idx) {
+    MshrMask free_mask = 0;
+#pragma hls_unroll yes
+    for (int m = 0; m < NumMSHRs; m++) {
+      free_mask[m] = !mshr_valid[m];
+    }
+    if (free_mask == 0) {
+      return false;
+    }
+    idx = nvhls::leading_ones<NumMSHRs, MshrMask, MshrIdx>(free_mask);
+    return true;
+  }
+
+  /* Look up one beat. Returns false, with nothing changed, if the beat must
+   * wait. On a hit, way is set; on a miss an MSHR is allocated and mshr is
+   * set for the caller to fill in the target. */
+  bool lookup(const Addr& addr, bool is_write, bool& hit, WayIdx& way, MshrIdx& mshr) {
+    SetIdx set = set_of(addr);
+    Tag tag = tag_of(addr);
+
+    if (line_busy(set, tag)) {
+      this->IncrStat(line_busy_stalls_stat);
+      return false;
+    }
+
+    WayMask valid = 0;
+    TagEntry entries[NumWays];
+    hit = false;
+#pragma hls_unroll yes
+    for (int w = 0; w < NumWays; w++) {
+      entries[w] = tags.read(set, w);
+      valid[w] = entries[w][0];
+      if (entries[w][0] && nvhls::get_slc<kTagBits>(entries[w], 2) == tag) {
+        hit = true;
+        way = w;
+      }
+    }
+    if (hit) {
+      this->IncrStat(is_write ? write_hits_stat : read_hits_stat);
+      touch(set, way);
+      return true;
+    }
+
+    if (!free_mshr(mshr) || !choose_victim(set, valid, way)) {
+      this->IncrStat(mshr_full_stalls_stat);
+      return false;
+    }
+    this->IncrStat(is_write ? write_misses_stat : read_misses_stat);
+    lfsr = (lfsr >> 1) ^ (lfsr[0] ? NVUINT16(0xB400) : NVUINT16(0));
+
+    bool dirty = WriteBack && entries[way][0] && entries[way][1];
+    if (entries[way][0]) {
+      this->IncrStat(evictions_stat);
+    }
+    if (dirty) {
+      this->IncrStat(writebacks_stat);
+    }
+    mshr_valid[mshr] = true;
+    mshr_state[mshr] = dirty ? kWriteback : kIssue;
+    mshr_set[mshr] = set;
+    mshr_way[mshr] = way;
+    mshr_tag[mshr] = tag;
+    mshr_victim_tag[mshr] = nvhls::get_slc<kTagBits>(entries[way], 2);
+    mshr_beat[mshr] = 0;
+    mshr_word[mshr] = word_of(addr);
+    mshr_is_write[mshr] = is_write;
+    // The victim stays readable for the writeback, but no longer hits
+    tags.write(set, way, 0);
+
+    CDCOUT(sc_time_stamp() << " " << name() << " miss addr=" << hex << addr
+                  << " mshr=" << dec << mshr << " way=" << way
+                  << (dirty ? " (writeback)" : "") << endl, kDebugLevel);
+    return true;
+  }
+
+  void run() {
+    if_rd.reset();
+    if_wr.reset();
+    if_mem_rd.reset();
+    if_mem_wr.reset();
+    reset_state();
+
+    typename axi4_::AddrPayload rd_req;
+    bool rd_active = false;
+    unsigned rd_beat = 0;
+
+    typename axi4_::AddrPayload wr_req;
+    bool wr_active = false;
+    unsigned wr_beat = 0;
+    typename axi4_::WritePayload wr_data;
+    bool wr_data_valid = false;
+
+    typename axi4_::ReadPayload r_out;
+    bool r_out_valid = false;
+
+    // Writes to memory: writebacks (WriteBack) or write-through words
+    bool mem_wr_active = false;
+    bool mem_aw_sent = false;
+    MshrIdx mem_wr_mshr = 0;
+    unsigned mem_wr_beat = 0;
+    unsigned mem_wr_outstanding = 0;
+
+    typename axi4_::AddrPayload ar_out;
+    bool ar_out_valid = false;
+    MshrIdx ar_out_mshr = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      // Upstream responses
+      if (r_out_valid && if_rd.nb_rwrite(r_out)) {
+        r_out_valid = false;
+      }
+      if (!r_out_valid && rob.topResponseReady()) {
+        r_out = rob.popResponse();
+        r_out_valid = true;
+      }
+      if (!b_queue.isEmpty() && if_wr.nb_bwrite(b_queue.peek())) {
+        b_queue.incrHead();
+      }
+
+      // Downstream write responses
+      typename axi4_::WRespPayload mem_b;
+      if (if_mem_wr.b.PopNB(mem_b)) {
+        NVHLS_ASSERT_MSG(mem_wr_outstanding != 0, "Unexpected write response from memory");
+        mem_wr_outstanding--;
+      }
+
+      // Refill beats
+      typename axi4_::ReadPayload mem_r;
+      if ((WriteBack || !wt_queue.isFull()) && if_mem_rd.r.PopNB(mem_r)) {
+        MshrIdx m = static_cast<unsigned>(mem_r.id) % NumMSHRs;
+        NVHLS_ASSERT_MSG(mshr_valid[m] && mshr_state[m] == kRefill, "Refill beat without a pending miss");
+        SetIdx set = mshr_set[m];
+        WayIdx way = mshr_way[m];
+        WordIdx beat = mshr_beat[m];
+        data.write(data_idx(set, beat), way, mem_r.data);
+        if (beat == mshr_word[m]) {
+          if (mshr_is_write[m]) {
+            data.write(data_idx(set, beat), way, mshr_data[m], mshr_strb[m]);
+            if (!WriteBack) {
+              WriteThrough wt;
+              wt.addr = line_addr(mshr_tag[m], set) + bytesPerWord * static_cast<unsigned>(beat);
+              wt.data = data.read(data_idx(set, beat), way);
+              wt_queue.push(wt);
+            }
+          } else {
+            typename axi4_::ReadPayload rsp = mshr_rsp[m];
+            rsp.data = mem_r.data;
+            rob.addResponse(mshr_rob_id[m], rsp);
+          }
+        }
+        if (beat == LineWords - 1) {
+          tags.write(set, way, make_entry(mshr_tag[m], WriteBack && mshr_is_write[m]));
+          touch(set, way);
+          mshr_valid[m] = false;
+        } else {
+          mshr_beat[m] = beat + 1;
+        }
+      }
+
+      // Writes to memory
+      if (!mem_wr_active) {
+        if (WriteBack) {
+          MshrMask wb_mask = 0;
+#pragma hls_unroll yes
+          for (int m = 0; m < NumMSHRs; m++) {
+            wb_mask[m] = mshr_valid[m] && mshr_state[m] == kWriteback;
+          }
+          if (wb_mask != 0) {
+            mem_wr_mshr = nvhls::leading_ones<NumMSHRs, MshrMask, MshrIdx>(wb_mask);
+            mem_wr_active = true;
+          }
+        } else if (!wt_queue.isEmpty()) {
+          mem_wr_active = true;
+        }
+        mem_aw_sent = false;
+        mem_wr_beat = 0;
+      }
+      if (mem_wr_active) {
+        SetIdx set = mshr_set[mem_wr_mshr];
+        WayIdx way = mshr_way[mem_wr_mshr];
+        if (!mem_aw_sent) {
+          typename axi4_::AddrPayload aw;
+          if (WriteBack) {
+            aw.id = mem_wr_mshr;
+            aw.addr = line_addr(mshr_victim_tag[mem_wr_mshr], set);
+            aw.len = LineWords - 1;
+          } else {
+            aw.addr = wt_queue.peek().addr;
+            aw.len = 0;
+          }
+          if (if_mem_wr.aw.PushNB(aw)) {
+            mem_aw_sent = true;
+            mem_wr_outstanding++;
+          }
+        } else {
+          typename axi4_::WritePayload w;
+          if (WriteBack) {
+            w.data = data.read(data_idx(set, mem_wr_beat), way);
+            w.last = (mem_wr_beat == LineWords - 1);
+          } else {
+            w.data = wt_queue.peek().data;
+            w.last = 1;
+          }
+          if (if_mem_wr.w.PushNB(w)) {
+            if (w.last) {
+              mem_wr_active = false;
+              if (WriteBack) {
+                mshr_state[mem_wr_mshr] = kIssue;
+              } else {
+                wt_queue.incrHead();
+              }
+            } else {
+              mem_wr_beat++;
+            }
+          }
+        }
+      }
+
+      // Refill requests wait for all writes to memory to complete
+      MshrMask issue_mask = 0;
+      bool writeback_pending = false;
+#pragma hls_unroll yes
+      for (int m = 0; m < NumMSHRs; m++) {
+        issue_mask[m] = mshr_valid[m] && mshr_state[m] == kIssue;
+        writeback_pending |= mshr_valid[m] && mshr_state[m] == kWriteback;
+      }
+      bool issue_blocked = mem_wr_outstanding != 0 || mem_wr_active ||
+                           writeback_pending || !wt_queue.isEmpty();
+      if (!ar_out_valid && !issue_blocked && issue_mask != 0) {
+        MshrMask choice = issue_arb.pick(issue_mask);
+        ar_out_mshr = nvhls::leading_ones<NumMSHRs, MshrMask, MshrIdx>(choice);
+        ar_out.id = ar_out_mshr;
+        ar_out.addr = line_addr(mshr_tag[ar_out_mshr], mshr_set[ar_out_mshr]);
+        ar_out.len = LineWords - 1;
+        ar_out_valid = true;
+      }
+      if (ar_out_valid && if_mem_rd.ar.PushNB(ar_out)) {
+        mshr_state[ar_out_mshr] = kRefill;
+        ar_out_valid = false;
+      }
+
+      // Upstream requests
+      if (!rd_active && if_rd.nb_aread(rd_req)) {
+        rd_active = true;
+        rd_beat = 0;
+      }
+      if (!wr_active && if_wr.aw.PopNB(wr_req)) {
+        wr_active = true;
+        wr_beat = 0;
+      }
+      if (wr_active && !wr_data_valid && if_wr.w.PopNB(wr_data)) {
+        wr_data_valid = true;
+      }
+
+      // One lookup per cycle. Writes also hold while a refill waits for
+      // memory writes to drain, so that a stream of writes cannot starve it.
+      NVUINTW(2) lookup_valid = 0;
+      lookup_valid[0] = rd_active && rob.canAcceptRequest();
+      lookup_valid[1] = wr_active && wr_data_valid && !b_queue.isFull() &&
+                        (WriteBack || !wt_queue.isFull()) &&
+                        !(issue_blocked && issue_mask != 0);
+      NVUINTW(2) lookup_sel = lookup_arb.pick(lookup_valid);
+
+      if (lookup_sel[0]) {
+        Addr addr = rd_req.addr + bytesPerWord * rd_beat;
+        bool hit;
+        WayIdx way;
+        MshrIdx m;
+        if (lookup(addr, false, hit, way, m)) {
+          typename axi4_::ReadPayload rsp;
+          rsp.id = rd_req.id;
+          rsp.resp = axi4_::Enc::XRESP::OKAY;
+          rsp.last = (rd_beat == rd_req.len);
+          typename Rob::Id rob_id = rob.addRequest();
+          if (hit) {
+            rsp.data = data.read(data_idx(set_of(addr), word_of(addr)), way);
+            rob.addResponse(rob_id, rsp);
+          } else {
+            mshr_rob_id[m] = rob_id;
+            mshr_rsp[m] = rsp;
+          }
+          if (rd_beat == rd_req.len) {
+            rd_active = false;
+          } else {
+            rd_beat++;
+          }
+        }
+      }
+
+      if (lookup_sel[1]) {
+        Addr addr = wr_req.addr + bytesPerWord * wr_beat;
+        ByteMask strb = ~static_cast<ByteMask>(0);
+        if (axi4_::WSTRB_WIDTH > 0) {
+          strb = wr_data.wstrb;
+        }
+        bool hit;
+        WayIdx way;
+        MshrIdx m;
+        if (lookup(addr, true, hit, way, m)) {
+          SetIdx set = set_of(addr);
+          if (hit) {
+            data.write(data_idx(set, word_of(addr)), way, wr_data.data, strb);
+            if (WriteBack) {
+              tags.write(set, way, make_entry(tag_of(addr), true));
+            } else {
+              WriteThrough wt;
+              wt.addr = addr;
+              wt.data = data.read(data_idx(set, word_of(addr)), way);
+              wt_queue.push(wt);
+            }
+          } else {
+            mshr_data[m] = wr_data.data;
+            mshr_strb[m] = strb;
+          }
+          wr_data_valid = false;
+          if (wr_beat == wr_req.len) {
+            NVHLS_ASSERT_MSG(wr_data.last == true, "WRLEN indicates that this should be the last beat, but WRLAST is not set");
+            typename axi4_::WRespPayload b;
+            b.id = wr_req.id;
+            b.resp = axi4_::Enc::XRESP::OKAY;
+            b_queue.push(b);
+            wr_active = false;
+          } else {
+            NVHLS_ASSERT_MSG(wr_data.last == false, "WRLEN indicates that this should not be the last beat, but WRLAST is set");
+            wr_beat++;
+          }
+        }
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXIDMA_H__
+#define __AXIDMA_H__
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <hls_globals.h>
+#include <nvhls_int.h>
+#include <nvhls_connections.h>
+#include <nvhls_message.h>
+#include <nvhls_assert.h>
+#include <axi/axi4.h>
+#include <fifo.h>
+#include <ReorderBuf.h>
+
+/**
+ * \brief A descriptor-driven DMA engine that streams 1D, 2D or 3D strided regions out of AXI memory.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg           A valid AXI config.
+ * \tparam MaxOutstanding   Number of read bursts in flight (at most 2^idWidth).
+ * \tparam RobDepth         Number of beats buffered between the R channel and stream_out.
+ * \tparam DescQueueLen     Number of queued descriptors.
+ * \tparam CountWidth       Bitwidth of the descriptor counts.
+ *
+ * \par Overview
+ * Each Descriptor read from desc_in describes z_count planes of y_count rows
+ * of x_words consecutive data words. Rows start y_stride bytes apart and
+ * planes z_stride bytes apart; set y_count and z_count to 1 for a 1D
+ * transfer. The words are sent on stream_out in address-walk order, and the
+ * last word of each descriptor has last set.
+ * - Each row is split into bursts as long as the config allows, but never
+ *   longer than RobDepth beats and never crossing a 4KB boundary.
+ * - Bursts use the AXI IDs 0 to MaxOutstanding-1, so up to MaxOutstanding
+ *   of them are in flight and the subordinate may return them out of
+ *   order. Each beat reserves a ReorderBuf entry before its burst is
+ *   issued, one per cycle, which keeps up with the R channel, and the
+ *   ReorderBuf puts the beats back in order.
+ * - The next descriptor starts as soon as the last burst of the current
+ *   one has been issued.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <axi/AxiDma.h>
+ *
+ *      ...
+ *      typedef AxiDma<axi::cfg::standard> Dma;
+ *      Dma::Descriptor desc;
+ *      desc.addr = 0x1000;     // a 16x8 tile of a 64-word wide image
+ *      desc.x_words = 16;
+ *      desc.y_count = 8;
+ *      desc.y_stride = 64 * Dma::bytesPerWord;
+ *      desc.z_count = 1;
+ *      desc.z_stride = 0;
+ *      desc_in.Push(desc);
+ *      for (int i = 0; i < 16 * 8; i++) {
+ *        Dma::StreamBeat beat = stream_out.Pop();
+ *        ...
+ *      }
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg, int MaxOutstanding = 4, int RobDepth = 16,
+          int DescQueueLen = 2, int CountWidth = 16>
+class AxiDma : public sc_module {
+ public:
+  static const int kDebugLevel = 3;
+
+  typedef typename axi::axi4<axiCfg> axi4_;
+  typedef typename axi4_::Addr Addr;
+  typedef typename axi4_::Data Data;
+  typedef NVUINTW(CountWidth) Count;
+  static const int bytesPerWord = axiCfg::dataWidth >> 3;
+
+  static_assert(axiCfg::idWidth > 0 && (1 << axiCfg::idWidth) >= MaxOutstanding,
+                "The AXI ID must be wide enough for MaxOutstanding bursts");
+
+  struct Descriptor : public nvhls_message {
+    Addr addr;      // First byte, word aligned
+    Count x_words;  // Words per row
+    Count y_count;  // Rows per plane
+    Addr y_stride;  // Bytes from one row to the next
+    Count z_count;  // Planes
+    Addr z_stride;  // Bytes from one plane to the next
+    static const unsigned int width = 3 * axi4_::ADDR_WIDTH + 3 * CountWidth;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m & addr;
+      m & x_words;
+      m & y_count;
+      m & y_stride;
+      m & z_count;
+      m & z_stride;
+    }
+  };
+
+  struct StreamBeat : public nvhls_message {
+    Data data;
+    bool last;  // Last word of the descriptor
+    static const unsigned int width = axi4_::DATA_WIDTH + 1;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m & data;
+      m & last;
+    }
+  };
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  Connections::In<Descriptor> desc_in;
+  Connections::Out<StreamBeat> stream_out;
+  typename axi4_::read::template manager<> if_rd;
+
+  SC_CTOR(AxiDma)
+      : clk("clk"),
+        reset_bar("reset_bar"),
+        desc_in("desc_in"),
+        stream_out("stream_out"),
+        if_rd("if_rd") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ protected:
+  enum {
+    kByteBits = nvhls::log2_ceil<bytesPerWord>::val,
+    kMaxBurstSize = (axiCfg::useBurst ? axiCfg::maxBurstSize : 1),
+    kMaxBurst = (kMaxBurstSize < RobDepth ? kMaxBurstSize : RobDepth),
+    kPageBytes = 4096,
+  };
+
+  typedef ReorderBuf<StreamBeat, RobDepth, RobDepth> Rob;
+  typedef NVUINTW(MaxOutstanding) SlotMask;
+  typedef NVUINTW(nvhls::index_width<MaxOutstanding>::val) SlotIdx;
+  typedef NVUINTW(nvhls::index_width<kMaxBurst + 1>::val) BurstLen;
+
+  Rob rob;
+  FIFO<Descriptor, DescQueueLen> desc_queue;
+  // ReorderBuf ids reserved for the beats of each burst in flight
+  FIFO<typename Rob::Id, kMaxBurst, MaxOutstanding> beat_ids;
+
+  void run() {
+    desc_in.Reset();
+    stream_out.Reset();
+    if_rd.reset();
+    rob.reset();
+    desc_queue.reset();
+    beat_ids.reset();
+
+    // Address walk of the current descriptor
+    Descriptor desc;
+    bool desc_valid = false;
+    Addr row_addr = 0;
+    Addr plane_addr = 0;
+    Count x_done = 0;
+    Count y_idx = 0;
+    Count z_idx = 0;
+
+    // Burst waiting for its ReorderBuf entries and AR
+    typename axi4_::AddrPayload burst;
+    bool burst_valid = false;
+    bool burst_last = false;
+    BurstLen burst_reserve = 0;
+    SlotIdx burst_slot = 0;
+
+    SlotMask slot_busy = 0;
+    bool slot_last[MaxOutstanding];
+
+    StreamBeat out;
+    bool out_valid = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      // Stream side
+      if (out_valid && stream_out.PushNB(out)) {
+        out_valid = false;
+      }
+      if (!out_valid && rob.topResponseReady()) {
+        out = rob.popResponse();
+        out_valid = true;
+      }
+
+      // Read data
+      typename axi4_::ReadPayload r;
+      if (if_rd.r.PopNB(r)) {
+        SlotIdx slot = static_cast<sc_uint<axi4_::ID_WIDTH> >(r.id);
+        NVHLS_ASSERT_MSG(slot < MaxOutstanding && slot_busy[slot], "Read data with an unknown AXI ID");
+        StreamBeat beat;
+        beat.data = r.data;
+        beat.last = (static_cast<sc_uint<1> >(r.last) == 1) && slot_last[slot];
+        rob.addResponse(beat_ids.pop(slot), beat);
+        if (static_cast<sc_uint<1> >(r.last) == 1) {
+          NVHLS_ASSERT_MSG(beat_ids.isEmpty(slot), "Read burst shorter than requested");
+          slot_busy[slot] = 0;
+        }
+      }
+
+      // Reserve one ReorderBuf entry per cycle, then send the AR
+      if (burst_valid) {
+        if (burst_reserve != 0 && rob.canAcceptRequest()) {
+          beat_ids.push(rob.addRequest(), burst_slot);
+          burst_reserve--;
+        }
+        if (burst_reserve == 0 && if_rd.ar.PushNB(burst)) {
+          CDCOUT(sc_time_stamp() << " " << name() << " Sent read request: ["
+                        << burst << "]" << endl, kDebugLevel);
+          slot_busy[burst_slot] = 1;
+          slot_last[burst_slot] = burst_last;
+          burst_valid = false;
+        }
+      }
+
+      // Next burst of the address walk
+      SlotMask free_slots = ~slot_busy;
+      if (!burst_valid && burst_slot_free(free_slots, burst_slot)) {
+        if (!desc_valid && !desc_queue.isEmpty()) {
+          desc = desc_queue.pop();
+          NVHLS_ASSERT_MSG(desc.x_words != 0 && desc.y_count != 0 && desc.z_count != 0,
+                           "Descriptor counts must be at least 1");
+          NVHLS_ASSERT_MSG(desc.addr % bytesPerWord == 0, "Descriptor address must be word aligned");
+          desc_valid = true;
+          row_addr = desc.addr;
+          plane_addr = desc.addr;
+          x_done = 0;
+          y_idx = 0;
+          z_idx = 0;
+        }
+        if (desc_valid) {
+          Addr addr = row_addr + bytesPerWord * x_done;
+          Count remaining = desc.x_words - x_done;
+          // Words left before the next 4KB boundary
+          NVUINTW(13 - kByteBits) to_page =
+              (kPageBytes - nvhls::get_slc<12>(addr, 0)) >> kByteBits;
+          unsigned len = kMaxBurst;
+          if (remaining < len) {
+            len = remaining;
+          }
+          if (axi4_::ADDR_WIDTH > 12 && to_page < len) {
+            len = to_page;
+          }
+
+          burst.id = burst_slot;
+          burst.addr = addr;
+          burst.len = len - 1;
+          burst_reserve = len;
+          burst_valid = true;
+
+          x_done += len;
+          bool row_done = (x_done == desc.x_words);
+          bool plane_done = row_done && (y_idx == desc.y_count - 1);
+          burst_last = plane_done && (z_idx == desc.z_count - 1);
+          if (burst_last) {
+            desc_valid = false;
+          } else if (plane_done) {
+            x_done = 0;
+            y_idx = 0;
+            z_idx++;
+            plane_addr += desc.z_stride;
+            row_addr = plane_addr;
+          } else if (row_done) {
+            x_done = 0;
+            y_idx++;
+            row_addr += desc.y_stride;
+          }
+        }
+      }
+
+      if (!desc_queue.isFull()) {
+        Descriptor d;
+        if (desc_in.PopNB(d)) {
+          desc_queue.push(d);
+        }
+      }
+    }
+  }
+
+  // Lowest free AXI ID, if any
+  static bool burst_slot_free(const SlotMask& free_slots, SlotIdx& slot) {
+    if (free_slots == 0) {
+      return false;
+    }
+    slot = nvhls::leading_ones<MaxOutstanding, SlotMask, SlotIdx>(free_slots);
+    return true;
+  }
+};
+
+#endif
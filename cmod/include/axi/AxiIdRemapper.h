@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __AXI_ID_REMAPPER_H__
+#define __AXI_ID_REMAPPER_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_marshaller.h>
+#include <TypeToBits.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <CAM.h>
+#include <axi/axi4.h>
+
+/**
+ * \brief Maps the wide AXI IDs of a manager onto a small pool of subordinate IDs.
+ * \ingroup AXI
+ *
+ * \tparam CfgManager          A valid AXI config describing the manager port.
+ * \tparam CfgSubordinate      A valid AXI config describing the subordinate port, with fewer ID bits.
+ * \tparam NumSlots            The number of subordinate IDs in use (default: all of them).
+ * \tparam MaxOutstanding      The most transactions in flight on one subordinate ID (default: 16).
+ *
+ * \par Overview
+ * AxiIdRemapper sits in front of logic that only handles narrow IDs, such as
+ * the subordinate port of an AxiArbiter with remapIds, whose ID grows by the
+ * manager index bits. Reads and writes each have a table of NumSlots slots,
+ * held in a CAM keyed by the manager ID, and the subordinate ID of a request
+ * is the index of its slot.
+ * - A request whose manager ID already holds a slot reuses it, so requests of
+ *   one manager ID keep their order downstream, and any number of them (up
+ *   to MaxOutstanding) can be in flight.
+ * - A request with a new manager ID takes the lowest free slot. Distinct
+ *   manager IDs never share a subordinate ID, so responses of different IDs
+ *   may still return in any order.
+ * - When every slot is taken, or its slot already has MaxOutstanding requests
+ *   in flight, a request waits until a response frees one. Later requests on
+ *   the same channel wait behind it.
+ * - The last R beat of a read, or the B response of a write, releases one
+ *   request from its slot, and restores the manager ID from the slot.
+ * - Write data passes through unchanged.
+ *
+ * Apart from idWidth, the two AXI configs must be the same. Both must have an
+ * ID and write responses.
+ *
+ * \par A Simple Example
+ * \code
+ *      // 8-bit manager IDs on 2-bit subordinate IDs
+ *      AxiIdRemapper<cfgWide, cfgNarrow, 4> remapper;
+ *      ...
+ *      remapper.clk(clk);
+ *      remapper.rst(rst);
+ *      remapper.axiM_read(axi_read_m);
+ *      remapper.axiM_write(axi_write_m);
+ *      remapper.axiS_read(axi_read_s);
+ *      remapper.axiS_write(axi_write_s);
+ * \endcode
+ *
+ * \par Usage Guidelines
+ *
+ * This module sets the stall mode to flush by default to mitigate possible RTL
+ * bugs that can occur in the default stall mode. If you are confident that
+ * this class of bugs will not occur in your use case, you can change the stall
+ * mode via TCL directive:
+ *
+ * \code
+ * directive set /path/to/AxiIdRemapper/axi_read/while -PIPELINE_STALL_MODE stall
+ * \endcode
+ *
+ * This may reduce area/power.
+ * \par
+ *
+ */
+template <typename CfgManager, typename CfgSubordinate,
+          int NumSlots = (1 << CfgSubordinate::idWidth), int MaxOutstanding = 16>
+class AxiIdRemapper : public sc_module {
+  SC_HAS_PROCESS(AxiIdRemapper);
+  // Local typedefs and derived constants
+  typedef axi::axi4<CfgManager> axiM;
+  typedef axi::axi4<CfgSubordinate> axiS;
+
+  static_assert(CfgManager::idWidth > 0 && CfgSubordinate::idWidth > 0,
+                "Both AXI configs must have an ID");
+  static_assert(NumSlots >= 1 && NumSlots <= (1 << CfgSubordinate::idWidth),
+                "NumSlots must fit in the subordinate ID");
+  static_assert(MaxOutstanding >= 1, "MaxOutstanding must be at least 1");
+  static_assert(CfgManager::useWriteResponses && CfgSubordinate::useWriteResponses,
+                "Both AXI configs must have write responses");
+  static_assert(static_cast<int>(CfgManager::dataWidth) ==
+                        static_cast<int>(CfgSubordinate::dataWidth) &&
+                    static_cast<int>(CfgManager::addrWidth) ==
+                        static_cast<int>(CfgSubordinate::addrWidth),
+                "AXI configs must only differ in idWidth");
+
+  typedef typename axiM::Id Id;
+  typedef NVUINTW(nvhls::index_width<MaxOutstanding + 1>::val) Count;
+  typedef CAM<Id, Count, NumSlots> Table;
+  typedef typename Table::Index Slot;
+
+ public:
+  static const int kDebugLevel = 5;
+  // External interface
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  typename axiM::read::template subordinate<> axiM_read;
+  typename axiM::write::template subordinate<> axiM_write;
+  typename axiS::read::template manager<> axiS_read;
+  typename axiS::write::template manager<> axiS_write;
+
+  // Constructor
+  AxiIdRemapper(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        axiM_read("axiM_read"),
+        axiM_write("axiM_write"),
+        axiS_read("axiS_read"),
+        axiS_write("axiS_write") {
+    SC_THREAD(axi_read);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+
+    SC_THREAD(axi_write);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+
+    SC_THREAD(axi_write_w);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+ private:
+  // Finds or allocates the slot of a manager ID, and counts one more request on it
+  static bool acquire(Table& table, const Id& id, Slot& slot) {
+    if (table.find(id, slot)) {
+      Count count = table.value_at(slot);
+      if (count == MaxOutstanding) return false;
+      table.write(slot, id, count + 1);
+      return true;
+    }
+    if (table.is_full()) return false;
+    slot = table.insert(id, 1);
+    return true;
+  }
+
+  // Retires one request of a slot, and frees it after the last one
+  static Id release(Table& table, const Slot& slot) {
+    NVHLS_ASSERT_MSG(table.is_valid(slot), "Response on an AXI ID with no request in flight");
+    Id id = table.key_at(slot);
+    Count count = table.value_at(slot);
+    if (count == 1) {
+      table.invalidate(slot);
+    } else {
+      table.write(slot, id, count - 1);
+    }
+    return id;
+  }
+
+  static typename axiS::AddrPayload to_subordinate(const typename axiM::AddrPayload& req,
+                                                   const Slot& slot) {
+    typename axiS::AddrPayload out;
+    out.id = slot;
+    out.addr = req.addr;
+    out.burst = req.burst;
+    out.len = req.len;
+    out.size = req.size;
+    out.cache = req.cache;
+    out.qos = req.qos;
+    out.auser = req.auser;
+    return out;
+  }
+
+  static typename axiM::ReadPayload to_manager(const typename axiS::ReadPayload& resp,
+                                               const Id& id) {
+    typename axiM::ReadPayload out;
+    out.id = id;
+    out.data = resp.data;
+    out.resp = resp.resp;
+    out.last = resp.last;
+    out.ruser = resp.ruser;
+    return out;
+  }
+
+  static typename axiM::WRespPayload to_manager(const typename axiS::WRespPayload& resp,
+                                                const Id& id) {
+    typename axiM::WRespPayload out;
+    out.id = id;
+    out.resp = resp.resp;
+    out.buser = resp.buser;
+    return out;
+  }
+
+  void axi_read() {
+    axiM_read.reset();
+    axiS_read.reset();
+    Table table;
+
+    typename axiM::AddrPayload AR;
+    typename axiS::AddrPayload AR_out;
+    typename axiS::ReadPayload R;
+    typename axiM::ReadPayload R_out;
+    bool ar_pending = false;
+    bool ar_mapped = false;
+    bool r_held = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      // Responses first, so that a slot freed this cycle can be taken below
+      if (!r_held && axiS_read.r.PopNB(R)) {
+        Slot slot = R.id;
+        Id id = (R.last == 1) ? release(table, slot) : table.key_at(slot);
+        R_out = to_manager(R, id);
+        r_held = true;
+      }
+      if (r_held) {
+        r_held = !axiM_read.r.PushNB(R_out);
+      }
+
+      if (!ar_pending && axiM_read.ar.PopNB(AR)) {
+        ar_pending = true;
+      }
+      if (ar_pending && !ar_mapped) {
+        Slot slot;
+        if (acquire(table, AR.id, slot)) {
+          AR_out = to_subordinate(AR, slot);
+          ar_mapped = true;
+          CDCOUT(sc_time_stamp() << " " << name() << " Read ID " << AR.id
+                        << " on slot " << slot << endl, kDebugLevel);
+        }
+      }
+      if (ar_mapped && axiS_read.ar.PushNB(AR_out)) {
+        ar_pending = false;
+        ar_mapped = false;
+      }
+    }
+  }
+
+  void axi_write() {
+    axiM_write.aw.Reset();
+    axiM_write.b.Reset();
+    axiS_write.aw.Reset();
+    axiS_write.b.Reset();
+    Table table;
+
+    typename axiM::AddrPayload AW;
+    typename axiS::AddrPayload AW_out;
+    typename axiS::WRespPayload B;
+    typename axiM::WRespPayload B_out;
+    bool aw_pending = false;
+    bool aw_mapped = false;
+    bool b_held = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!b_held && axiS_write.b.PopNB(B)) {
+        Slot slot = B.id;
+        B_out = to_manager(B, release(table, slot));
+        b_held = true;
+      }
+      if (b_held) {
+        b_held = !axiM_write.b.PushNB(B_out);
+      }
+
+      if (!aw_pending && axiM_write.aw.PopNB(AW)) {
+        aw_pending = true;
+      }
+      if (aw_pending && !aw_mapped) {
+        Slot slot;
+        if (acquire(table, AW.id, slot)) {
+          AW_out = to_subordinate(AW, slot);
+          aw_mapped = true;
+          CDCOUT(sc_time_stamp() << " " << name() << " Write ID " << AW.id
+                        << " on slot " << slot << endl, kDebugLevel);
+        }
+      }
+      if (aw_mapped && axiS_write.aw.PushNB(AW_out)) {
+        aw_pending = false;
+        aw_mapped = false;
+      }
+    }
+  }
+
+  void axi_write_w() {
+    axiM_write.w.Reset();
+    axiS_write.w.Reset();
+    typename axiM::WritePayload W;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+      if (axiM_write.w.PopNB(W)) {
+        axiS_write.w.Push(BitsToType<typename axiS::WritePayload>(TypeToBits(W)));
+      }
+    }
+  }
+};
+
+#endif
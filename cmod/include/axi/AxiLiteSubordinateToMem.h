@@ -29,11 +29,18 @@
  * \ingroup AXI
  *
  * \tparam capacity   The capacity in bytes of the local SRAM.
+ * \tparam banks      The number of SRAM banks, a power of 2 (default: 1).
  *
  * \par Overview
  * AxiLiteSubordinateToMem is an AXI subordinate compliant with the AXI-Lite protocol (32-bit data words, no bursts).
  * The module only handles AXI addresses within the range of its internal memory, with a base address of 0.
  * It does not support write strobes.
+ * - Consecutive words are interleaved across the banks of the SRAM.
+ * - The loop runs at an II of 1.  A read and a write to different banks are
+ *   both done in the same cycle.  When they hit the same bank, one of them
+ *   waits a cycle, and the two alternate priority so that neither starves.
+ * - The read response is sent from the iteration after the access, so that
+ *   the SRAM read is pipelined.
  *
  * \par Usage Guidelines
  *
@@ -50,16 +57,24 @@
  * \par
  *
  */
-template <int capacity>
+template <int capacity, int banks = 1>
 class AxiLiteSubordinateToMem : public sc_module {
  private:
   typedef typename axi::axi4<axi::cfg::lite_nowstrb> axi_;
 
   static const int capacity_in_bytes = capacity;
-  static const int banks = 1; // Not templated - only support 1 bank for now
+  static const int bytesPerWord = axi_::DATA_WIDTH >> 3;
+  static const int wordBits = nvhls::log2_ceil<bytesPerWord>::val;
+  static const int bankBits = nvhls::log2_ceil<banks>::val;
+  static const int words = capacity_in_bytes / bytesPerWord;
+
+  static_assert((1 << bankBits) == banks, "Number of banks must be a power of 2");
+  static_assert(words % banks == 0, "Capacity must be a multiple of the bank width times the number of banks");
 
   typedef typename axi_::Data Data;
-  typedef mem_array_sep<Data, capacity_in_bytes, banks> Memarray;
+  typedef mem_array_sep<Data, words, banks> Memarray;
+  typedef typename Memarray::LocalIndex LocalIndex;
+  typedef typename Memarray::BankIndex BankIndex;
 
   Memarray memarray;
 
@@ -78,61 +93,74 @@ class AxiLiteSubordinateToMem : public sc_module {
   }
 
  protected:
+  static BankIndex bank_of(typename axi_::Addr addr) {
+    return (banks > 1) ? static_cast<BankIndex>((addr >> wordBits) & (banks - 1)) : BankIndex(0);
+  }
+
+  static LocalIndex index_of(typename axi_::Addr addr) {
+    return static_cast<LocalIndex>(addr >> (wordBits + bankBits));
+  }
+
   void run() {
     axi_::AddrPayload rd_addr_pld;
     axi_::AddrPayload wr_addr_pld;
     axi_::ReadPayload data_pld;
     axi_::WritePayload write_pld;
     axi_::WRespPayload resp_pld;
+    bool rd_req;        // Accepted read, waiting for its bank
+    bool wr_req;        // Accepted write, waiting for its bank
     bool rd_resp_pend;
     bool wr_resp_pend;
+    bool wr_first;      // Priority on a bank conflict
 
     if_rd.reset();
     if_wr.reset();
 
+    rd_req = false;
+    wr_req = false;
     rd_resp_pend = false;
     wr_resp_pend = false;
+    wr_first = false;
+    data_pld.resp = axi_::Enc::XRESP::OKAY;
+    resp_pld.resp = axi_::Enc::XRESP::OKAY;
 
-    #pragma hls_pipeline_init_interval 4
+    #pragma hls_pipeline_init_interval 1
     #pragma pipeline_stall_mode flush
     while (1) {
       wait();
 
-      bool rd_resp_pend_local = rd_resp_pend;
-      bool wr_resp_pend_local = wr_resp_pend;
-      bool rd_mem;
-      bool wr_mem;
-
-      if (!rd_resp_pend_local) {
-        rd_mem = (if_rd.nb_aread(rd_addr_pld));
-        if (rd_mem) {
-          data_pld.resp = axi_::Enc::XRESP::OKAY;
-          rd_resp_pend_local = true;
-        }
+      // Responses of the accesses of earlier iterations
+      if (rd_resp_pend) {
+        rd_resp_pend = !(if_rd.nb_rwrite(data_pld));
       }
-
-      if (!wr_resp_pend_local) {
-        wr_mem = if_wr.nb_wread(wr_addr_pld, write_pld);
-
-        if (wr_mem) {
-          resp_pld.resp = axi_::Enc::XRESP::OKAY;
-          wr_resp_pend_local = true;
-        }
+      if (wr_resp_pend) {
+        wr_resp_pend = !(if_wr.nb_bwrite(resp_pld));
       }
 
-      if (rd_mem)
-        data_pld.data = memarray.read(rd_addr_pld.addr);
-      if (wr_mem)
-        memarray.write(wr_addr_pld.addr,0,write_pld.data);
-      if (rd_resp_pend_local) {
-        rd_resp_pend_local = !(if_rd.nb_rwrite(data_pld));
+      if (!rd_req && !rd_resp_pend) {
+        rd_req = if_rd.nb_aread(rd_addr_pld);
+      }
+      if (!wr_req && !wr_resp_pend) {
+        wr_req = if_wr.nb_wread(wr_addr_pld, write_pld);
       }
 
-      if (wr_resp_pend_local) {
-        wr_resp_pend_local = !(if_wr.nb_bwrite(resp_pld));
+      BankIndex rd_bank = bank_of(rd_addr_pld.addr);
+      BankIndex wr_bank = bank_of(wr_addr_pld.addr);
+      bool conflict = rd_req && wr_req && (rd_bank == wr_bank);
+      bool rd_mem = rd_req && !(conflict && wr_first);
+      bool wr_mem = wr_req && !(conflict && !wr_first);
+      if (conflict) wr_first = !wr_first;
+
+      if (rd_mem) {
+        data_pld.data = memarray.read(index_of(rd_addr_pld.addr), rd_bank);
+        rd_req = false;
+        rd_resp_pend = true;
+      }
+      if (wr_mem) {
+        memarray.write(index_of(wr_addr_pld.addr), wr_bank, write_pld.data);
+        wr_req = false;
+        wr_resp_pend = true;
       }
-      rd_resp_pend = rd_resp_pend_local;
-      wr_resp_pend = wr_resp_pend_local;
     }
   }
 };
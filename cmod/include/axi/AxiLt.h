@@ -0,0 +1,1022 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __AXI_LT_H__
+#define __AXI_LT_H__
+
+#include <systemc.h>
+#include <tlm.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <tlm_utils/simple_target_socket.h>
+#include <ac_reset_signal_is.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <nvhls_assert.h>
+#include <hls_globals.h>
+#include <Arbiter.h>
+#include <axi/axi4.h>
+#include <axi/AxiManagerGate/AxiManagerGateIf.h>
+
+#include <deque>
+#include <vector>
+
+/**
+ * \file AxiLt.h
+ *
+ * Loosely-timed TLM-2.0 models of the AXI building blocks, for software
+ * bring-up and architecture exploration where the cycle-level handshakes of
+ * the pin models are too slow. Every model is a functional equivalent of the
+ * pin model of the same name and takes the same template parameters, so a
+ * system can be switched between the two by changing the type. Transfers are
+ * tlm_generic_payload transactions through b_transport, with the time they
+ * would take added to the annotated delay: a fixed latency per transaction
+ * plus a time per data beat, both public and set from the clock period at
+ * construction. AxiToLt and LtToAxi bridge between the two views, so pin and
+ * LT models can be mixed in one system.
+ *
+ * These models are simulation only and are not synthesizable.
+ */
+
+namespace axi {
+namespace lt {
+
+/**
+ * \brief Conversions between AXI beats and the byte arrays of a generic payload.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg   A valid AXI config.
+ *
+ * Beats are little endian: byte i of a beat is bits [8i+7:8i] of its data.
+ */
+template <typename axiCfg>
+struct Beats {
+  typedef typename axi::axi4<axiCfg> axi4_;
+  static const unsigned int bytesPerBeat = axi4_::DATA_WIDTH >> 3;
+  static const unsigned int log2BytesPerBeat = nvhls::log2_ceil<bytesPerBeat>::val;
+
+  static unsigned int Count(unsigned int bytes) {
+    return (bytes + bytesPerBeat - 1) / bytesPerBeat;
+  }
+
+  static typename axi4_::Data ToData(const unsigned char* p, unsigned int n) {
+    typename axi4_::Data data = 0;
+    for (unsigned int i = 0; i < n; i++)
+      data = nvhls::set_slc(data, NVUINTW(8)(p[i]), 8 * i);
+    return data;
+  }
+
+  static void FromData(const typename axi4_::Data& data, unsigned char* p,
+                       unsigned int n) {
+    for (unsigned int i = 0; i < n; i++)
+      p[i] = static_cast<unsigned char>(nvhls::get_slc<8>(data, 8 * i).to_uint());
+  }
+
+  static bool Enabled(const tlm::tlm_generic_payload& trans, unsigned int i) {
+    const unsigned char* be = trans.get_byte_enable_ptr();
+    return be == 0 ||
+           be[i % trans.get_byte_enable_length()] == tlm::TLM_BYTE_ENABLED;
+  }
+
+  template <typename T>
+  static uint64 Field(T f) { return f.to_uint64(); }
+
+  // Write strobes, a no-op for configs without them
+  template <typename T>
+  static void SetStrb(T& strb, unsigned int i, bool en) {
+    strb = nvhls::set_slc(strb, NVUINTW(1)(en), i);
+  }
+  static void SetStrb(nvhls::EmptyField&, unsigned int, bool) {}
+  template <typename T>
+  static bool StrbBit(const T& strb, unsigned int i) {
+    return nvhls::get_slc<1>(strb, i) == 1;
+  }
+  static bool StrbBit(const nvhls::EmptyField&, unsigned int) { return true; }
+};
+
+}  // namespace lt
+}  // namespace axi
+
+/**
+ * \brief Loosely-timed model of AxiSubordinateToMem.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg       A valid AXI config.
+ * \tparam capacity     The capacity of the memory in bytes.
+ * \tparam fifoDepth    Unused, for compatibility with AxiSubordinateToMem.
+ * \tparam maxOutstanding Unused, for compatibility with AxiSubordinateToMem.
+ *
+ * \par Overview
+ * A byte-addressed memory behind a TLM target socket. Reads and writes honor
+ * byte enables, accesses past the capacity fail with
+ * TLM_ADDRESS_ERROR_RESPONSE, and the whole array is offered for DMI, so an
+ * initiator can bypass b_transport altogether. data() gives backdoor access.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <axi/AxiLt.h>
+ *
+ *      ...
+ *      AxiSubordinateToMemLt<axi::cfg::standard, 0x10000> mem;
+ *
+ *      manager.init(mem.tgt);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg, int capacity, int fifoDepth = 8, int maxOutstanding = fifoDepth>
+class AxiSubordinateToMemLt : public sc_module {
+ public:
+  typedef axi::lt::Beats<axiCfg> Beats;
+
+  tlm_utils::simple_target_socket<AxiSubordinateToMemLt> tgt;
+
+  sc_time latency;
+  sc_time beat_time;
+
+  AxiSubordinateToMemLt(sc_module_name name,
+                        const sc_time& clk_period = sc_time(1, SC_NS))
+      : sc_module(name),
+        tgt("tgt"),
+        latency(2 * clk_period),
+        beat_time(clk_period),
+        mem(capacity, 0) {
+    tgt.register_b_transport(this, &AxiSubordinateToMemLt::b_transport);
+    tgt.register_get_direct_mem_ptr(this, &AxiSubordinateToMemLt::get_direct_mem_ptr);
+    tgt.register_transport_dbg(this, &AxiSubordinateToMemLt::transport_dbg);
+  }
+
+  unsigned char* data() { return &mem[0]; }
+
+ protected:
+  std::vector<unsigned char> mem;
+
+  void Access(tlm::tlm_generic_payload& trans) {
+    uint64 addr = trans.get_address();
+    unsigned int len = trans.get_data_length();
+    unsigned char* p = trans.get_data_ptr();
+    if (addr >= static_cast<uint64>(capacity) || len > capacity - addr) {
+      trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+      return;
+    }
+    if (trans.get_streaming_width() < len) {
+      trans.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
+      return;
+    }
+    for (unsigned int i = 0; i < len; i++) {
+      if (!Beats::Enabled(trans, i))
+        continue;
+      if (trans.is_read())
+        p[i] = mem[addr + i];
+      else if (trans.is_write())
+        mem[addr + i] = p[i];
+    }
+    trans.set_response_status(tlm::TLM_OK_RESPONSE);
+  }
+
+  void b_transport(tlm::tlm_generic_payload& trans, sc_time& delay) {
+    Access(trans);
+    delay += latency + Beats::Count(trans.get_data_length()) * beat_time;
+    trans.set_dmi_allowed(true);
+  }
+
+  unsigned int transport_dbg(tlm::tlm_generic_payload& trans) {
+    Access(trans);
+    return trans.is_response_ok() ? trans.get_data_length() : 0;
+  }
+
+  bool get_direct_mem_ptr(tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi) {
+    dmi.allow_read_write();
+    dmi.set_dmi_ptr(&mem[0]);
+    dmi.set_start_address(0);
+    dmi.set_end_address(capacity - 1);
+    dmi.set_read_latency(latency + beat_time);
+    dmi.set_write_latency(latency + beat_time);
+    return true;
+  }
+};
+
+/**
+ * \brief Loosely-timed model of AxiSubordinateToReg.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg                 A valid AXI config.
+ * \tparam numReg                 The number of registers.
+ * \tparam numAddrBitsToInspect   The number of address bits to decode.  (Default: ADDR_WIDTH)
+ * \tparam regWidth               The width of each register in bits, a multiple of 8 no wider than the data bus.  (Default: DATA_WIDTH)
+ *
+ * \par Overview
+ * A register file behind a TLM target socket, with the same baseAddr input
+ * and regOut outputs as AxiSubordinateToReg. Register i occupies the
+ * regWidth/8 bytes at baseAddr + i*regWidth/8, byte enables are honored, and
+ * an access outside the file fails with TLM_ADDRESS_ERROR_RESPONSE. regOut
+ * is updated before b_transport returns.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <axi/AxiLt.h>
+ *
+ *      ...
+ *      AxiSubordinateToRegLt<axi::cfg::standard, 16, 16> regs;
+ *
+ *      regs.baseAddr(base_sig);
+ *      for (int i = 0; i < 16; i++)
+ *        regs.regOut[i](reg_sig[i]);
+ *      manager.init(regs.tgt);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg, int numReg, int numAddrBitsToInspect = axiCfg::addrWidth,
+          int regWidth = axiCfg::dataWidth>
+class AxiSubordinateToRegLt : public sc_module {
+ public:
+  typedef axi::lt::Beats<axiCfg> Beats;
+  static const int bytesPerReg = regWidth >> 3;
+  static_assert(regWidth % 8 == 0 && regWidth <= axiCfg::dataWidth,
+                "regWidth must be a multiple of 8 no wider than the data bus");
+
+  typedef NVUINTW(regWidth) Reg;
+
+  tlm_utils::simple_target_socket<AxiSubordinateToRegLt> tgt;
+  sc_in<NVUINTW(numAddrBitsToInspect)> baseAddr;
+  sc_out<Reg> regOut[numReg];
+
+  sc_time latency;
+  sc_time beat_time;
+
+  AxiSubordinateToRegLt(sc_module_name name,
+                        const sc_time& clk_period = sc_time(1, SC_NS))
+      : sc_module(name),
+        tgt("tgt"),
+        baseAddr("baseAddr"),
+        latency(clk_period),
+        beat_time(clk_period) {
+    tgt.register_b_transport(this, &AxiSubordinateToRegLt::b_transport);
+    for (int i = 0; i < numReg; i++) {
+      regs[i] = 0;
+      regOut[i].initialize(0);
+    }
+  }
+
+ protected:
+  Reg regs[numReg];
+
+  void b_transport(tlm::tlm_generic_payload& trans, sc_time& delay) {
+    delay += latency + Beats::Count(trans.get_data_length()) * beat_time;
+    uint64 addr = NVUINTW(numAddrBitsToInspect)(trans.get_address()).to_uint64();
+    uint64 base = baseAddr.read().to_uint64();
+    unsigned int len = trans.get_data_length();
+    unsigned char* p = trans.get_data_ptr();
+    if (addr < base || addr - base + len > static_cast<uint64>(numReg * bytesPerReg)) {
+      trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+      return;
+    }
+    uint64 offset = addr - base;
+    for (unsigned int i = 0; i < len; i++) {
+      if (!Beats::Enabled(trans, i))
+        continue;
+      unsigned int r = (offset + i) / bytesPerReg;
+      unsigned int b = (offset + i) % bytesPerReg;
+      if (trans.is_read()) {
+        p[i] = static_cast<unsigned char>(nvhls::get_slc<8>(regs[r], 8 * b).to_uint());
+      } else if (trans.is_write()) {
+        regs[r] = nvhls::set_slc(regs[r], NVUINTW(8)(p[i]), 8 * b);
+        regOut[r].write(regs[r]);
+      }
+    }
+    trans.set_response_status(tlm::TLM_OK_RESPONSE);
+  }
+};
+
+/**
+ * \brief Loosely-timed model of AxiSplitter.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg                 A valid AXI config.
+ * \tparam numSubordinates        The number of subordinates.
+ * \tparam numAddrBitsToInspect   The number of address bits to decode.  (Default: ADDR_WIDTH)
+ * \tparam default_output         If true, requests that miss every range go to the highest-indexed subordinate.  (Default: false)
+ * \tparam translate_addr         If true, requests are re-addressed relative to the base address of the receiving subordinate.  (Default: false)
+ * \tparam maxReadsPerSubordinate Unused, for compatibility with AxiSplitter.
+ * \tparam maxOutstandingWrites   Unused, for compatibility with AxiSplitter.
+ * \tparam boundWidth             The width of the addrBound inputs.  (Default: numAddrBitsToInspect)
+ *
+ * \par Overview
+ * Routes each transaction on its start address exactly like AxiSplitter: the
+ * inclusive addrBound ranges are compared after truncation to
+ * numAddrBitsToInspect bits and the lowest-indexed hit wins. A miss with
+ * default_output false fails with TLM_ADDRESS_ERROR_RESPONSE. DMI requests
+ * and invalidations are forwarded, with the region translated back and
+ * clipped to the range of the subordinate.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <axi/AxiLt.h>
+ *
+ *      ...
+ *      AxiSplitterLt<axi::cfg::standard, 2> splitter;
+ *
+ *      manager.init(splitter.tgt);
+ *      splitter.init[0](mem0.tgt);
+ *      splitter.init[1](mem1.tgt);
+ *      splitter.addrBound[0][0](base0);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg, int numSubordinates, int numAddrBitsToInspect = axiCfg::addrWidth,
+          bool default_output = false, bool translate_addr = false,
+          int maxReadsPerSubordinate = 1, int maxOutstandingWrites = 4,
+          int boundWidth = numAddrBitsToInspect>
+class AxiSplitterLt : public sc_module {
+ public:
+  tlm_utils::simple_target_socket<AxiSplitterLt> tgt;
+  tlm_utils::simple_initiator_socket_tagged<AxiSplitterLt> init[numSubordinates];
+  sc_in<NVUINTW(boundWidth)> addrBound[numSubordinates][2];
+
+  sc_time latency;
+
+  AxiSplitterLt(sc_module_name name, const sc_time& clk_period = sc_time(1, SC_NS))
+      : sc_module(name), tgt("tgt"), latency(clk_period) {
+    tgt.register_b_transport(this, &AxiSplitterLt::b_transport);
+    tgt.register_get_direct_mem_ptr(this, &AxiSplitterLt::get_direct_mem_ptr);
+    tgt.register_transport_dbg(this, &AxiSplitterLt::transport_dbg);
+    for (int i = 0; i < numSubordinates; i++)
+      init[i].register_invalidate_direct_mem_ptr(
+          this, &AxiSplitterLt::invalidate_direct_mem_ptr, i);
+  }
+
+ protected:
+  uint64 Bound(int i, int j) {
+    return NVUINTW(numAddrBitsToInspect)(addrBound[i][j].read()).to_uint64();
+  }
+
+  // numSubordinates on a miss, as in AxiSplitter
+  int Route(uint64 full_addr, bool& hit) {
+    uint64 addr = NVUINTW(numAddrBitsToInspect)(full_addr).to_uint64();
+    hit = true;
+    for (int i = 0; i < numSubordinates; i++) {
+      if (addr >= Bound(i, 0) && addr <= Bound(i, 1))
+        return i;
+    }
+    hit = false;
+    return default_output ? numSubordinates - 1 : numSubordinates;
+  }
+
+  uint64 Offset(int sub) { return translate_addr ? Bound(sub, 0) : 0; }
+
+  void b_transport(tlm::tlm_generic_payload& trans, sc_time& delay) {
+    bool hit;
+    uint64 addr = trans.get_address();
+    int sub = Route(addr, hit);
+    delay += latency;
+    if (sub == numSubordinates) {
+      trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+      return;
+    }
+    trans.set_address(addr - Offset(sub));
+    init[sub]->b_transport(trans, delay);
+    trans.set_address(addr);
+  }
+
+  unsigned int transport_dbg(tlm::tlm_generic_payload& trans) {
+    bool hit;
+    uint64 addr = trans.get_address();
+    int sub = Route(addr, hit);
+    if (sub == numSubordinates)
+      return 0;
+    trans.set_address(addr - Offset(sub));
+    unsigned int n = init[sub]->transport_dbg(trans);
+    trans.set_address(addr);
+    return n;
+  }
+
+  bool get_direct_mem_ptr(tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi) {
+    bool hit;
+    uint64 addr = trans.get_address();
+    int sub = Route(addr, hit);
+    // Only a hit has a well-defined region to clip to
+    if (!hit)
+      return false;
+    uint64 offset = Offset(sub);
+    trans.set_address(addr - offset);
+    bool ok = init[sub]->get_direct_mem_ptr(trans, dmi);
+    trans.set_address(addr);
+    if (!ok)
+      return false;
+    uint64 start = dmi.get_start_address() + offset;
+    uint64 end = dmi.get_end_address() + offset;
+    if (start < Bound(sub, 0)) {
+      dmi.set_dmi_ptr(dmi.get_dmi_ptr() + (Bound(sub, 0) - start));
+      start = Bound(sub, 0);
+    }
+    if (end > Bound(sub, 1))
+      end = Bound(sub, 1);
+    dmi.set_start_address(start);
+    dmi.set_end_address(end);
+    dmi.set_read_latency(dmi.get_read_latency() + latency);
+    dmi.set_write_latency(dmi.get_write_latency() + latency);
+    return true;
+  }
+
+  void invalidate_direct_mem_ptr(int sub, sc_dt::uint64 start, sc_dt::uint64 end) {
+    uint64 offset = Offset(sub);
+    tgt->invalidate_direct_mem_ptr(start + offset, end + offset);
+  }
+};
+
+/**
+ * \brief Loosely-timed model of AxiArbiter.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg                   A valid AXI config.
+ * \tparam numManagers              The number of managers.
+ * \tparam maxOutstandingRequests   Unused, for compatibility with AxiArbiter.
+ * \tparam arbType                  Unused, for compatibility with AxiArbiter.
+ * \tparam remapIds                 Unused, for compatibility with AxiArbiter.
+ * \tparam qosPriority              Unused, for compatibility with AxiArbiter.
+ *
+ * \par Overview
+ * Merges the tgt sockets of numManagers managers onto one init socket. The
+ * read and write data channels are each modeled as a resource that is busy
+ * for the data beats of one transaction at a time: a transaction that
+ * starts, in its own local time, before the channel is free is delayed until
+ * it is, which approximates contention without ordering the managers.
+ * Transactions then pass through with latency added. DMI requests and
+ * invalidations are forwarded.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <axi/AxiLt.h>
+ *
+ *      ...
+ *      AxiArbiterLt<axi::cfg::standard, 2, 4> arbiter;
+ *
+ *      manager0.init(arbiter.tgt[0]);
+ *      manager1.init(arbiter.tgt[1]);
+ *      arbiter.init(mem.tgt);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg, int numManagers, int maxOutstandingRequests,
+          arbiter_type arbType = Roundrobin, bool remapIds = false,
+          bool qosPriority = false>
+class AxiArbiterLt : public sc_module {
+ public:
+  typedef axi::lt::Beats<axiCfg> Beats;
+
+  tlm_utils::simple_target_socket_tagged<AxiArbiterLt> tgt[numManagers];
+  tlm_utils::simple_initiator_socket<AxiArbiterLt> init;
+
+  sc_time latency;
+  sc_time beat_time;
+
+  AxiArbiterLt(sc_module_name name, const sc_time& clk_period = sc_time(1, SC_NS))
+      : sc_module(name),
+        init("init"),
+        latency(clk_period),
+        beat_time(clk_period),
+        rd_free(SC_ZERO_TIME),
+        wr_free(SC_ZERO_TIME) {
+    for (int i = 0; i < numManagers; i++) {
+      tgt[i].register_b_transport(this, &AxiArbiterLt::b_transport, i);
+      tgt[i].register_get_direct_mem_ptr(this, &AxiArbiterLt::get_direct_mem_ptr, i);
+      tgt[i].register_transport_dbg(this, &AxiArbiterLt::transport_dbg, i);
+    }
+    init.register_invalidate_direct_mem_ptr(this, &AxiArbiterLt::invalidate_direct_mem_ptr);
+  }
+
+ protected:
+  sc_time rd_free;
+  sc_time wr_free;
+
+  void b_transport(int id, tlm::tlm_generic_payload& trans, sc_time& delay) {
+    sc_time& chan_free = trans.is_write() ? wr_free : rd_free;
+    sc_time now = sc_time_stamp();
+    sc_time start = now + delay;
+    if (start < chan_free)
+      start = chan_free;
+    chan_free = start + Beats::Count(trans.get_data_length()) * beat_time;
+    delay = start - now + latency;
+    init->b_transport(trans, delay);
+  }
+
+  unsigned int transport_dbg(int id, tlm::tlm_generic_payload& trans) {
+    return init->transport_dbg(trans);
+  }
+
+  bool get_direct_mem_ptr(int id, tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi) {
+    bool ok = init->get_direct_mem_ptr(trans, dmi);
+    if (ok) {
+      dmi.set_read_latency(dmi.get_read_latency() + latency);
+      dmi.set_write_latency(dmi.get_write_latency() + latency);
+    }
+    return ok;
+  }
+
+  void invalidate_direct_mem_ptr(sc_dt::uint64 start, sc_dt::uint64 end) {
+    for (int i = 0; i < numManagers; i++)
+      tgt[i]->invalidate_direct_mem_ptr(start, end);
+  }
+};
+
+/**
+ * \brief Loosely-timed model of AxiManagerGate.
+ * \ingroup AXI
+ *
+ * \tparam Cfg    A valid AXI config.
+ *
+ * The remaining parameters are unused, for compatibility with AxiManagerGate.
+ *
+ * \par Overview
+ * Takes the same WrRequest/RdRequest channels as AxiManagerGate and returns
+ * the same WrResp/RdResp, but issues each burst as one b_transport on its
+ * init socket instead of driving an AXI manager port. A write collects its
+ * beats up to the one with last set, then sends one WrResp; a read returns
+ * len+1 RdResp beats with last on the final one. Both wait out the
+ * annotated delay before responding, so the request side keeps its
+ * cycle-level timing. Bursts are INCR of full-width beats; size and burst
+ * are ignored. An error response maps to SLVERR.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <axi/AxiLt.h>
+ *
+ *      ...
+ *      AxiManagerGateLt<axi::cfg::standard> gate;
+ *
+ *      gate.clk(clk);
+ *      gate.reset_bar(reset_bar);
+ *      gate.wrRequestIn(wrRequestChan);
+ *      ...
+ *      gate.init(mem.tgt);
+ * \endcode
+ * \par
+ *
+ */
+template <typename Cfg, int ROBDepth = 8, int MaxInFlightTrans = 4,
+          int RdReqFifoDepth = 4, int WrReqFifoDepth = 4, bool inOrder = false>
+class AxiManagerGateLt : public sc_module {
+ public:
+  static const int kDebugLevel = 4;
+  typedef axi::axi4<Cfg> axi4_;
+  typedef axi::lt::Beats<Cfg> Beats;
+
+  sc_in<bool> reset_bar;
+  sc_in<bool> clk;
+  Connections::In<WrRequest<Cfg> > wrRequestIn;
+  Connections::Out<WrResp<Cfg> > wrRespOut;
+  Connections::In<RdRequest<Cfg> > rdRequestIn;
+  Connections::Out<RdResp<Cfg> > rdRespOut;
+  tlm_utils::simple_initiator_socket<AxiManagerGateLt> init;
+
+  SC_HAS_PROCESS(AxiManagerGateLt);
+
+  AxiManagerGateLt(sc_module_name name)
+      : sc_module(name),
+        reset_bar("reset_bar"),
+        clk("clk"),
+        wrRequestIn("wrRequestIn"),
+        wrRespOut("wrRespOut"),
+        rdRequestIn("rdRequestIn"),
+        rdRespOut("rdRespOut"),
+        init("init") {
+    SC_THREAD(run_wr);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_rd);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ protected:
+  void run_wr() {
+    wrRequestIn.Reset();
+    wrRespOut.Reset();
+    std::vector<unsigned char> buf;
+    wait();
+
+    while (1) {
+      wait();
+      WrRequest<Cfg> req = wrRequestIn.Pop();
+      uint64 addr = req.addr.to_uint64();
+      unsigned int beats = Beats::Field(req.len) + 1;
+      buf.clear();
+      while (1) {
+        buf.resize(buf.size() + Beats::bytesPerBeat);
+        Beats::FromData(req.data, &buf[buf.size() - Beats::bytesPerBeat], Beats::bytesPerBeat);
+        if (axi4_::LAST_WIDTH == 0 || Beats::Field(req.last) == 1)
+          break;
+        req = wrRequestIn.Pop();
+      }
+      NVHLS_ASSERT_MSG(Beats::Count(buf.size()) == beats, "Write burst beats do not match its len");
+
+      tlm::tlm_generic_payload trans;
+      sc_time delay = SC_ZERO_TIME;
+      trans.set_write();
+      trans.set_address(addr);
+      trans.set_data_ptr(&buf[0]);
+      trans.set_data_length(buf.size());
+      trans.set_streaming_width(buf.size());
+      trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+      init->b_transport(trans, delay);
+      wait(delay);
+
+      if (Cfg::useWriteResponses) {
+        WrResp<Cfg> resp;
+        resp.resp = trans.is_response_ok() ? axi4_::Enc::XRESP::OKAY
+                                           : axi4_::Enc::XRESP::SLVERR;
+        wrRespOut.Push(resp);
+      }
+    }
+  }
+
+  void run_rd() {
+    rdRequestIn.Reset();
+    rdRespOut.Reset();
+    std::vector<unsigned char> buf;
+    wait();
+
+    while (1) {
+      wait();
+      RdRequest<Cfg> req = rdRequestIn.Pop();
+      unsigned int beats = Beats::Field(req.len) + 1;
+      buf.assign(beats * Beats::bytesPerBeat, 0);
+
+      tlm::tlm_generic_payload trans;
+      sc_time delay = SC_ZERO_TIME;
+      trans.set_read();
+      trans.set_address(req.addr.to_uint64());
+      trans.set_data_ptr(&buf[0]);
+      trans.set_data_length(buf.size());
+      trans.set_streaming_width(buf.size());
+      trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+      init->b_transport(trans, delay);
+      wait(delay);
+
+      for (unsigned int b = 0; b < beats; b++) {
+        RdResp<Cfg> resp;
+        resp.resp = trans.is_response_ok() ? axi4_::Enc::XRESP::OKAY
+                                           : axi4_::Enc::XRESP::SLVERR;
+        resp.data = Beats::ToData(&buf[b * Beats::bytesPerBeat], Beats::bytesPerBeat);
+        resp.last = (b + 1 == beats);
+        rdRespOut.Push(resp);
+      }
+    }
+  }
+};
+
+/**
+ * \brief Bridge from a pin-level AXI manager to a loosely-timed subordinate.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg   A valid AXI config.
+ *
+ * \par Overview
+ * An AXI subordinate on its if_rd/if_wr ports that issues each burst it
+ * receives as one b_transport on its init socket, waits out the annotated
+ * delay, then returns the R beats or the B response. Write strobes become
+ * byte enables. Bursts are treated as INCR of full-width beats; an error
+ * response maps to SLVERR. Reads and writes are served by separate threads,
+ * one burst at a time each.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <axi/AxiLt.h>
+ *
+ *      ...
+ *      AxiToLt<axi::cfg::standard> bridge;
+ *
+ *      bridge.clk(clk);
+ *      bridge.reset_bar(reset_bar);
+ *      bridge.if_rd(axi_read);
+ *      bridge.if_wr(axi_write);
+ *      bridge.init(mem.tgt);
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg>
+class AxiToLt : public sc_module {
+ public:
+  static const int kDebugLevel = 4;
+  typedef typename axi::axi4<axiCfg> axi4_;
+  typedef axi::lt::Beats<axiCfg> Beats;
+
+  typename axi4_::read::template subordinate<> if_rd;
+  typename axi4_::write::template subordinate<> if_wr;
+  sc_in<bool> reset_bar;
+  sc_in<bool> clk;
+  tlm_utils::simple_initiator_socket<AxiToLt> init;
+
+  SC_HAS_PROCESS(AxiToLt);
+
+  AxiToLt(sc_module_name name)
+      : sc_module(name),
+        if_rd("if_rd"),
+        if_wr("if_wr"),
+        reset_bar("reset_bar"),
+        clk("clk"),
+        init("init") {
+    SC_THREAD(run_rd);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_wr);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ protected:
+  void run_rd() {
+    if_rd.reset();
+    std::vector<unsigned char> buf;
+    wait();
+
+    while (1) {
+      wait();
+      typename axi4_::AddrPayload ar = if_rd.ar.Pop();
+      unsigned int beats = Beats::Field(ar.len) + 1;
+      buf.assign(beats * Beats::bytesPerBeat, 0);
+
+      tlm::tlm_generic_payload trans;
+      sc_time delay = SC_ZERO_TIME;
+      trans.set_read();
+      trans.set_address(ar.addr.to_uint64());
+      trans.set_data_ptr(&buf[0]);
+      trans.set_data_length(buf.size());
+      trans.set_streaming_width(buf.size());
+      trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+      init->b_transport(trans, delay);
+      wait(delay);
+
+      for (unsigned int b = 0; b < beats; b++) {
+        typename axi4_::ReadPayload r;
+        r.id = ar.id;
+        r.resp = trans.is_response_ok() ? axi4_::Enc::XRESP::OKAY
+                                        : axi4_::Enc::XRESP::SLVERR;
+        r.data = Beats::ToData(&buf[b * Beats::bytesPerBeat], Beats::bytesPerBeat);
+        if (axi4_::LAST_WIDTH > 0)
+          r.last = (b + 1 == beats);
+        if_rd.r.Push(r);
+      }
+    }
+  }
+
+  void run_wr() {
+    if_wr.reset();
+    std::vector<unsigned char> buf;
+    std::vector<unsigned char> be;
+    wait();
+
+    while (1) {
+      wait();
+      typename axi4_::AddrPayload aw = if_wr.aw.Pop();
+      unsigned int beats = Beats::Field(aw.len) + 1;
+      buf.assign(beats * Beats::bytesPerBeat, 0);
+      be.assign(beats * Beats::bytesPerBeat, tlm::TLM_BYTE_ENABLED);
+      for (unsigned int b = 0; b < beats; b++) {
+        typename axi4_::WritePayload w = if_wr.w.Pop();
+        Beats::FromData(w.data, &buf[b * Beats::bytesPerBeat], Beats::bytesPerBeat);
+        for (unsigned int i = 0; i < Beats::bytesPerBeat; i++) {
+          if (!Beats::StrbBit(w.wstrb, i))
+            be[b * Beats::bytesPerBeat + i] = tlm::TLM_BYTE_DISABLED;
+        }
+      }
+
+      tlm::tlm_generic_payload trans;
+      sc_time delay = SC_ZERO_TIME;
+      trans.set_write();
+      trans.set_address(aw.addr.to_uint64());
+      trans.set_data_ptr(&buf[0]);
+      trans.set_data_length(buf.size());
+      trans.set_streaming_width(buf.size());
+      trans.set_byte_enable_ptr(&be[0]);
+      trans.set_byte_enable_length(be.size());
+      trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+      init->b_transport(trans, delay);
+      wait(delay);
+
+      if (axiCfg::useWriteResponses) {
+        typename axi4_::WRespPayload b;
+        b.id = aw.id;
+        b.resp = trans.is_response_ok() ? axi4_::Enc::XRESP::OKAY
+                                        : axi4_::Enc::XRESP::SLVERR;
+        if_wr.b.Push(b);
+      }
+    }
+  }
+};
+
+/**
+ * \brief Bridge from a loosely-timed manager to a pin-level AXI subordinate.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg   A valid AXI config.
+ *
+ * \par Overview
+ * A TLM target whose b_transport first waits out the annotated delay, then
+ * hands the transaction to a clocked thread that drives it onto the
+ * if_rd/if_wr manager ports and returns once the last R beat or the B
+ * response is back. A transaction is split into INCR bursts of full-width
+ * beats with id 0, at most maxBurstSize beats each and not crossing a 4KB
+ * boundary; the address must be beat aligned, and byte enables and a
+ * partial last beat become write strobes. Without write strobes, a write
+ * that needs them fails with TLM_BYTE_ENABLE_ERROR_RESPONSE. Any response
+ * other than OKAY fails the transaction with TLM_GENERIC_ERROR_RESPONSE.
+ * Transactions from several initiators are served one at a time.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <axi/AxiLt.h>
+ *
+ *      ...
+ *      LtToAxi<axi::cfg::standard> bridge;
+ *
+ *      bridge.clk(clk);
+ *      bridge.reset_bar(reset_bar);
+ *      splitter.init[1](bridge.tgt);
+ *      bridge.if_rd(axi_read);
+ *      bridge.if_wr(axi_write);
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg>
+class LtToAxi : public sc_module {
+ public:
+  static const int kDebugLevel = 4;
+  typedef typename axi::axi4<axiCfg> axi4_;
+  typedef axi::lt::Beats<axiCfg> Beats;
+
+  tlm_utils::simple_target_socket<LtToAxi> tgt;
+  typename axi4_::read::template manager<> if_rd;
+  typename axi4_::write::template manager<> if_wr;
+  sc_in<bool> reset_bar;
+  sc_in<bool> clk;
+
+  SC_HAS_PROCESS(LtToAxi);
+
+  LtToAxi(sc_module_name name)
+      : sc_module(name),
+        tgt("tgt"),
+        if_rd("if_rd"),
+        if_wr("if_wr"),
+        reset_bar("reset_bar"),
+        clk("clk") {
+    tgt.register_b_transport(this, &LtToAxi::b_transport);
+
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ protected:
+  struct Job {
+    tlm::tlm_generic_payload* trans;
+    sc_event done;
+  };
+  std::deque<Job*> jobs;
+
+  void b_transport(tlm::tlm_generic_payload& trans, sc_time& delay) {
+    wait(delay);
+    delay = SC_ZERO_TIME;
+    Job job;
+    job.trans = &trans;
+    jobs.push_back(&job);
+    wait(job.done);
+  }
+
+  // Beats of the burst starting at addr with n beats left
+  unsigned int BurstBeats(uint64 addr, unsigned int n) {
+    unsigned int to_4k = (0x1000 - (addr & 0xfff)) >> Beats::log2BytesPerBeat;
+    unsigned int beats = n < static_cast<unsigned int>(axiCfg::maxBurstSize) ? n : axiCfg::maxBurstSize;
+    return beats < to_4k ? beats : to_4k;
+  }
+
+  tlm::tlm_response_status Write(tlm::tlm_generic_payload& trans) {
+    uint64 addr = trans.get_address();
+    unsigned int len = trans.get_data_length();
+    unsigned char* p = trans.get_data_ptr();
+    unsigned int total = Beats::Count(len);
+    bool ok = true;
+    for (unsigned int beat = 0; beat < total;) {
+      unsigned int n = BurstBeats(addr + beat * Beats::bytesPerBeat, total - beat);
+      typename axi4_::AddrPayload aw;
+      aw.id = 0;
+      aw.addr = addr + beat * Beats::bytesPerBeat;
+      aw.len = n - 1;
+      aw.size = Beats::log2BytesPerBeat;
+      aw.burst = axi4_::Enc::AXBURST::INCR;
+      if_wr.aw.Push(aw);
+      for (unsigned int b = 0; b < n; b++, beat++) {
+        typename axi4_::WritePayload w;
+        unsigned int off = beat * Beats::bytesPerBeat;
+        unsigned char bytes[Beats::bytesPerBeat];
+        for (unsigned int i = 0; i < Beats::bytesPerBeat; i++) {
+          bool en = off + i < len && Beats::Enabled(trans, off + i);
+          bytes[i] = en ? p[off + i] : 0;
+          Beats::SetStrb(w.wstrb, i, en);
+        }
+        w.data = Beats::ToData(bytes, Beats::bytesPerBeat);
+        if (axi4_::LAST_WIDTH > 0)
+          w.last = (b + 1 == n);
+        if_wr.w.Push(w);
+      }
+      if (axiCfg::useWriteResponses) {
+        typename axi4_::WRespPayload resp = if_wr.b.Pop();
+        ok = ok && resp.resp == axi4_::Enc::XRESP::OKAY;
+      }
+    }
+    return ok ? tlm::TLM_OK_RESPONSE : tlm::TLM_GENERIC_ERROR_RESPONSE;
+  }
+
+  tlm::tlm_response_status Read(tlm::tlm_generic_payload& trans) {
+    uint64 addr = trans.get_address();
+    unsigned int len = trans.get_data_length();
+    unsigned char* p = trans.get_data_ptr();
+    unsigned int total = Beats::Count(len);
+    bool ok = true;
+    for (unsigned int beat = 0; beat < total;) {
+      unsigned int n = BurstBeats(addr + beat * Beats::bytesPerBeat, total - beat);
+      typename axi4_::AddrPayload ar;
+      ar.id = 0;
+      ar.addr = addr + beat * Beats::bytesPerBeat;
+      ar.len = n - 1;
+      ar.size = Beats::log2BytesPerBeat;
+      ar.burst = axi4_::Enc::AXBURST::INCR;
+      if_rd.ar.Push(ar);
+      for (unsigned int b = 0; b < n; b++, beat++) {
+        typename axi4_::ReadPayload r = if_rd.r.Pop();
+        ok = ok && r.resp == axi4_::Enc::XRESP::OKAY;
+        unsigned int off = beat * Beats::bytesPerBeat;
+        unsigned char bytes[Beats::bytesPerBeat];
+        Beats::FromData(r.data, bytes, Beats::bytesPerBeat);
+        for (unsigned int i = 0; i < Beats::bytesPerBeat && off + i < len; i++) {
+          if (Beats::Enabled(trans, off + i))
+            p[off + i] = bytes[i];
+        }
+      }
+    }
+    return ok ? tlm::TLM_OK_RESPONSE : tlm::TLM_GENERIC_ERROR_RESPONSE;
+  }
+
+  bool NeedsStrobes(tlm::tlm_generic_payload& trans) {
+    if (trans.get_data_length() % Beats::bytesPerBeat != 0)
+      return true;
+    for (unsigned int i = 0; i < trans.get_data_length(); i++) {
+      if (!Beats::Enabled(trans, i))
+        return true;
+    }
+    return false;
+  }
+
+  void run() {
+    if_rd.reset();
+    if_wr.reset();
+    wait();
+
+    while (1) {
+      wait();
+      if (jobs.empty())
+        continue;
+      Job* job = jobs.front();
+      jobs.pop_front();
+      tlm::tlm_generic_payload& trans = *job->trans;
+      if ((trans.get_address() & (Beats::bytesPerBeat - 1)) != 0 ||
+          trans.get_streaming_width() < trans.get_data_length()) {
+        trans.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
+      } else if (trans.is_write()) {
+        if (axi4_::WSTRB_WIDTH == 0 && NeedsStrobes(trans))
+          trans.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+        else
+          trans.set_response_status(Write(trans));
+      } else if (trans.is_read()) {
+        trans.set_response_status(Read(trans));
+      } else {
+        trans.set_response_status(tlm::TLM_OK_RESPONSE);
+      }
+      job->done.notify();
+    }
+  }
+};
+
+#endif
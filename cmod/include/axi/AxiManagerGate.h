@@ -35,11 +35,24 @@
  * \tparam Cfg                A valid AXI config.
  * \tparam ROBDepth           The depth of the reorder buffers.
  * \tparam MaxInFlightTrans   The number of independent AXI requests that can be in flight simultaneously.
+ * \tparam RdReqFifoDepth     The depth of the read request FIFO.  (Default: 4)
+ * \tparam WrReqFifoDepth     The depth of the write request FIFO.  (Default: 4)
+ * \tparam inOrder            If true, issue every request on AXI ID 0 and bypass the reorder buffers.  (Default: false)
  *
  * \par Overview
  * This block takes as inputs RdRequest and WrRequest Connections. The block converts the requests into
  * AXI format, sends them to AXI manager ports, and processes the responses into RdResponse and WrResponse ports.
  * ReorderBuf and ReorderBufWBeats are used to allow reordering via use of the AXI ID field.
+ * Read responses share a pool of ROBDepth beats: a read of any burst length
+ * is issued as soon as the pool has room for all of its beats, and completed
+ * reads drain at one beat per cycle.
+ *
+ * With inOrder, all requests share one AXI ID, so the subordinate returns
+ * responses in request order and they are forwarded without reordering.
+ * A read burst then no longer waits for earlier reads to drain, and the next
+ * AR is issued while previous R bursts are still returning.  MaxInFlightTrans
+ * bounds a counter of outstanding transactions instead of the number of IDs,
+ * so it is not limited by the ID width.
  *
  * \par Usage Guidelines
  *
@@ -56,7 +69,8 @@
  * \par
  *
  */
-template <typename Cfg, int ROBDepth = 8, int MaxInFlightTrans = 4>
+template <typename Cfg, int ROBDepth = 8, int MaxInFlightTrans = 4,
+          int RdReqFifoDepth = 4, int WrReqFifoDepth = 4, bool inOrder = false>
 class AxiManagerGate : public sc_module {
  private:
   typedef axi::axi4<Cfg> axi4_;
@@ -64,12 +78,14 @@ class AxiManagerGate : public sc_module {
   typedef NVUINTW(axi4_::DATA_WIDTH) Data;
 
   ReorderBuf<WrResp<Cfg>, ROBDepth, MaxInFlightTrans> wr_rob;
-  ReorderBufWBeats<RdResp<Cfg>, ROBDepth, MaxInFlightTrans> rd_rob;
+  typedef ReorderBufWBeats<RdResp<Cfg>, ROBDepth, MaxInFlightTrans> RdRob;
+  typedef typename RdRob::BeatCount RdBeatCount;
+  RdRob rd_rob;
 
-  FIFO<RdRequest<Cfg>, 4> rdReqFifo;
-  FIFO<WrRequest<Cfg>, 4> wrReqFifo;
+  FIFO<RdRequest<Cfg>, RdReqFifoDepth> rdReqFifo;
+  FIFO<WrRequest<Cfg>, WrReqFifoDepth> wrReqFifo;
 
-  static_assert(MaxInFlightTrans <= (1 << axi4_::ID_WIDTH) , "Number of inflight transactions cannot exceed number of unique IDs");
+  static_assert(inOrder || MaxInFlightTrans <= (1 << axi4_::ID_WIDTH) , "Number of inflight transactions cannot exceed number of unique IDs");
 
  public:
   static const int kDebugLevel = 2;
@@ -96,6 +112,7 @@ class AxiManagerGate : public sc_module {
 
  protected:
   typedef sc_uint<axi4_::ID_WIDTH> Id;
+  typedef NVUINTW(nvhls::index_width<MaxInFlightTrans + 1>::val) InFlightCount;
 
   void run_wr() {
 
@@ -111,6 +128,7 @@ class AxiManagerGate : public sc_module {
     Id wrRequestId;
     bool wrRequestIdValid = false;
     bool isBurstInFlight = false;
+    InFlightCount wrInFlight = 0;
 
     #pragma hls_pipeline_init_interval 1
     #pragma pipeline_stall_mode flush
@@ -119,7 +137,7 @@ class AxiManagerGate : public sc_module {
       CDCOUT("@" << sc_time_stamp() << "\t wr_rob is empty? "
            << wr_rob.isEmpty() << endl, kDebugLevel);
       // send response
-      if (wr_rob.topResponseReady()) {
+      if (!inOrder && wr_rob.topResponseReady()) {
         WrResp<Cfg> wrResp;
         wrResp = wr_rob.popResponse();
 
@@ -138,6 +156,7 @@ class AxiManagerGate : public sc_module {
       Id wrRequestId_local = wrRequestId;
       bool wrRequestIdValid_local = wrRequestIdValid;
       bool wrReqFifo_isFull = wrReqFifo.isFull();
+      InFlightCount wrInFlight_local = wrInFlight;
 
       // receive requests
       if (!wrRequestValid_local && !wrReqFifo.isEmpty()) {
@@ -160,7 +179,13 @@ class AxiManagerGate : public sc_module {
           CDCOUT("@" << sc_time_stamp() << "\t\t wr:Post response to rob"
                << "\tid = " << resp_pld.id << "\tresp = " << resp_pld.resp
                << endl, kDebugLevel);
-          wr_rob.addResponse(static_cast<sc_uint<axi4_::ID_WIDTH> >(resp_pld.id), wrResp);
+          if (inOrder) {
+            // Responses come back in request order on a single ID
+            wrRespOut.Push(wrResp);
+            wrInFlight_local--;
+          } else {
+            wr_rob.addResponse(static_cast<sc_uint<axi4_::ID_WIDTH> >(resp_pld.id), wrResp);
+          }
         }
       }
 
@@ -170,7 +195,13 @@ class AxiManagerGate : public sc_module {
             wrRequestIdValid_local || isBurstInFlight_local;
 
         // allocate a new id
-        if (!wrRequestIdValid_local && wr_rob.canAcceptRequest()) {
+        if (inOrder) {
+          if (!wrRequestIdValid_local && wrInFlight_local < MaxInFlightTrans) {
+            wrRequestId_local = 0;
+            wrRequestIdValid_local = true;
+            wrInFlight_local++;
+          }
+        } else if (!wrRequestIdValid_local && wr_rob.canAcceptRequest()) {
           wrRequestId_local = wr_rob.addRequest();
           wrRequestIdValid_local = true;
           CDCOUT("@" << sc_time_stamp()
@@ -226,6 +257,7 @@ class AxiManagerGate : public sc_module {
       wrRequestValid = wrRequestValid_local;
       wrRequestId = wrRequestId_local;
       wrRequestIdValid = wrRequestIdValid_local;
+      wrInFlight = wrInFlight_local;
 
       if (!wrReqFifo_isFull) {
         WrRequest<Cfg> wrRequest1;
@@ -250,8 +282,7 @@ class AxiManagerGate : public sc_module {
     bool rdRequestValid = false;
     Id rdRequestId;
     bool rdRequestIdValid = false;
-    bool rdBurstInFlight = false;
-    bool rdReceivingBurstBeats = false;
+    InFlightCount rdInFlight = 0;
 
     #pragma hls_pipeline_init_interval 1
     #pragma pipeline_stall_mode flush
@@ -261,7 +292,7 @@ class AxiManagerGate : public sc_module {
       CDCOUT("@" << sc_time_stamp() << "\t rd_rob is empty? "
            << rd_rob.isEmpty() << endl, kDebugLevel);
       // send response
-      if (rd_rob.topResponseReady()) {
+      if (!inOrder && rd_rob.topResponseReady()) {
         RdResp<Cfg> rdResp;
         rdResp = rd_rob.popResponse();
 
@@ -281,7 +312,7 @@ class AxiManagerGate : public sc_module {
       Id rdRequestId_local = rdRequestId;
       bool rdRequestIdValid_local = rdRequestIdValid;
       bool rdReqFifo_isFull = rdReqFifo.isFull();
-      bool rdBurstInFlight_local = rdBurstInFlight;
+      InFlightCount rdInFlight_local = rdInFlight;
 
       if (!rdRequestValid_local && !rdReqFifo.isEmpty()) {
         rdRequest_local = rdReqFifo.pop();
@@ -290,20 +321,28 @@ class AxiManagerGate : public sc_module {
         CDCOUT("@" << sc_time_stamp() << "\t\t rd:pop rdReqFifo" << endl, kDebugLevel);
       }
 
-      if (rdRequestValid_local) {
+      if (rdRequestValid_local && inOrder) {
+        // Same-ID stream: bursts need no ROB entry, so the next AR can go out
+        // while earlier bursts are still returning
+        if (rdInFlight_local < MaxInFlightTrans) {
+          typename axi4_::AddrPayload addr_pld;
+          rdRequest_local.copyToAddrPayload(addr_pld);
+          addr_pld.id = 0;
 
-        // rdRequest_local.len!=0 is a multi beat (burst) read
-        // we will wait for all previous read transactions to complete first
-        // otherwise we just need a slot in rob
+          bool pushed = if_rd.ar.PushNB(addr_pld);
+          rdRequestValid_local = !pushed;
+          if (pushed) rdInFlight_local++;
+        }
+      } else if (rdRequestValid_local) {
 
-        bool isBurst = (rdRequest_local.len != 0);
-        bool robReady =
-            (isBurst ? rd_rob.isEmpty() : rd_rob.canAcceptRequest());
+        // A read of len + 1 beats reserves that many beats of the rob, so
+        // bursts of any length share the rob and never wait for it to drain
+        RdBeatCount beats = static_cast<RdBeatCount>(rdRequest_local.len) + 1;
+        NVHLS_ASSERT_MSG(beats <= ROBDepth, "Read burst does not fit in the reorder buffer");
 
-        if (!rdRequestIdValid_local && robReady && !rdBurstInFlight_local) {
-          rdRequestId_local = rd_rob.addRequest();
+        if (!rdRequestIdValid_local && rd_rob.canAcceptRequest(beats)) {
+          rdRequestId_local = rd_rob.addRequest(beats);
           rdRequestIdValid_local = true;
-          rdBurstInFlight_local = isBurst;
           CDCOUT("@" << sc_time_stamp()
                << "\t\t rd:new id allocated = " << rdRequestId << endl, kDebugLevel);
         }
@@ -335,38 +374,31 @@ class AxiManagerGate : public sc_module {
         }
       }
 
-      {
-        bool rdReceivingBurstBeats_local = rdReceivingBurstBeats;
+      if (inOrder) {
         typename axi4_::ReadPayload data_pld;
-        // for single beat transactions rob is guaranteed to have an entry for
-        // response
-        // but for multi beat, starting from the second beat we don't know and
-        // have to check it
-        if (!rdReceivingBurstBeats_local || rd_rob.canReceiveBeats()) {
-          if (if_rd.r.PopNB(data_pld)) {
-            RdResp<Cfg> rdResp;
-            rdResp.data = data_pld.data;
-            rdResp.resp = data_pld.resp;
-            rdResp.last = data_pld.last;
-
-            if (!rdReceivingBurstBeats_local) {
-              rd_rob.addResponse(static_cast<sc_uint<axi4_::ID_WIDTH> >(data_pld.id), rdResp);
-            } else {
-              rd_rob.addBeat(rdResp);
-              if (static_cast<sc_uint<1> >(data_pld.last) == 1) {
-                // if this is the last beat, return to normal operation mode
-                rdBurstInFlight_local = false;
-              }
-            }
-
-            // subsequent beats (after the first one will have to know to use a
-            // different api to be pushed into Rob)
-            rdReceivingBurstBeats_local = rdBurstInFlight_local;
+        if (if_rd.r.PopNB(data_pld)) {
+          RdResp<Cfg> rdResp;
+          rdResp.data = data_pld.data;
+          rdResp.resp = data_pld.resp;
+          rdResp.last = data_pld.last;
+          rdRespOut.Push(rdResp);
+          if (static_cast<sc_uint<1> >(data_pld.last) == 1) {
+            rdInFlight_local--;
           }
         }
-        rdReceivingBurstBeats = rdReceivingBurstBeats_local;
+      } else {
+        typename axi4_::ReadPayload data_pld;
+        // every beat has an entry reserved by its request
+        if (if_rd.r.PopNB(data_pld)) {
+          RdResp<Cfg> rdResp;
+          rdResp.data = data_pld.data;
+          rdResp.resp = data_pld.resp;
+          rdResp.last = data_pld.last;
+          rd_rob.addBeat(static_cast<sc_uint<axi4_::ID_WIDTH> >(data_pld.id), rdResp,
+                         static_cast<sc_uint<1> >(data_pld.last) == 1);
+        }
       }
-      rdBurstInFlight = rdBurstInFlight_local;
+      rdInFlight = rdInFlight_local;
     }
   }
 };
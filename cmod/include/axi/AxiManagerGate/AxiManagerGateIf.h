@@ -28,16 +28,6 @@
 template <typename Cfg>
 struct Request : public nvhls_message {
   public:
-  Request() {};
-  Request(const Request &rhs) {
-    addr = rhs.addr;
-    burst = rhs.burst;
-    len = rhs.len;
-    size = rhs.size;
-    cache = rhs.cache;
-    auser = rhs.auser;
-  };
-  
   typedef axi::axi4<Cfg> axi4_;
 
   typename axi4_::Addr addr;
@@ -45,11 +35,13 @@ struct Request : public nvhls_message {
   typename axi4_::BeatSize size;
   typename axi4_::Burst burst;
   typename axi4_::Cache cache;
+  typename axi4_::Qos qos;
   typename axi4_::AUser auser;
 
   static const unsigned int width = axi4_::ADDR_WIDTH + axi4_::ALEN_WIDTH +
                                     axi4_::ASIZE_WIDTH + axi4_::BURST_WIDTH +
-                                    axi4_::CACHE_WIDTH + axi4_::AUSER_WIDTH;
+                                    axi4_::CACHE_WIDTH + axi4_::QOS_WIDTH +
+                                    axi4_::AUSER_WIDTH;
 
   template <unsigned int Size>
   void Marshall(Marshaller<Size>& m) {
@@ -58,6 +50,7 @@ struct Request : public nvhls_message {
     m& size;
     m& burst;
     m& cache;
+    m& qos;
     m& auser;
   }
 
@@ -67,6 +60,7 @@ struct Request : public nvhls_message {
     payload.len = len;
     payload.size = size;
     payload.cache = cache;
+    payload.qos = qos;
     payload.auser = auser;
   };
 };
@@ -87,12 +81,6 @@ struct RdRequest : public Request<Cfg> {};
 template <typename Cfg>
 struct WrRequest : public Request<Cfg> {
  public:
-  WrRequest() {};
-  WrRequest(const WrRequest &rhs) : Request<Cfg>(rhs) {
-    data = rhs.data;
-    last = rhs.last;
-    wuser = rhs.wuser;
-  };
   typename Request<Cfg>::axi4_::Data data;
   typename Request<Cfg>::axi4_::Last last;
   typename Request<Cfg>::axi4_::WUser wuser;
@@ -108,6 +96,7 @@ struct WrRequest : public Request<Cfg> {
     m& Request<Cfg>::size;
     m& Request<Cfg>::burst;
     m& Request<Cfg>::cache;
+    m& Request<Cfg>::qos;
     m& Request<Cfg>::auser;
     m& data;
     m& last;
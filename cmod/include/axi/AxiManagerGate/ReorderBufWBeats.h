@@ -17,36 +17,228 @@
 #ifndef __REORDERBUFWBEATS_H__
 #define __REORDERBUFWBEATS_H__
 
-#include <ReorderBuf.h>
+#include <fifo.h>
+#include <nvhls_types.h>
+#include <nvhls_int.h>
+#include <mem_array.h>
+#include <nvhls_assert.h>
 
 /**
- * \brief An extension of ReorderBuf that allows one entry to contain multiple beats of data.
+ * \brief Reorder buffer of multi-beat responses that share a pool of beats.
  * \ingroup ReorderBuffer
  *
- * \tparam Data             DataType
- * \tparam Depth            Depth of queue
- * \tparam InFlight         Number of inflight entries
+ * \tparam Data             DataType of one beat
+ * \tparam Depth            Number of beats in the shared pool
+ * \tparam InFlight         Number of inflight ids
+ * \tparam NumTrans         Number of transactions between addRequest() and
+ *                          the drain of their last beat (default: Depth)
+ *
+ * \par Overview
+ * Transactions are released in the order of their requests, one beat per
+ * popResponse(). Unlike ReorderBuf, which sizes each entry for one Data,
+ * beats are stored in a pool of Depth entries shared by all transactions:
+ * - addRequest(beats) reserves beats entries, so short and long bursts share
+ *   the pool and the responses of every accepted request are sure to fit.
+ *   canAcceptRequest(beats) checks for a free id, a free transaction and a
+ *   free reservation.
+ * - addBeat() takes a free entry with a priority encoder and appends it to
+ *   the linked list of its transaction. The id is free again as soon as the
+ *   last beat arrived.
+ * - popResponse() drains the oldest transaction beat by beat as the beats
+ *   arrive, and moves on to the next transaction right after the last beat,
+ *   so completed bursts drain at one beat per call with no gap between them.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <axi/AxiManagerGate/ReorderBufWBeats.h>
+ *
+ *      ...
+ *      ReorderBufWBeats<Data, 16, 4> rob;
+ *      if (rob.canAcceptRequest(len + 1)) {
+ *        id = rob.addRequest(len + 1);
+ *      }
+ *      ...
+ *      rob.addBeat(id, beat, last);
+ *      ...
+ *      if (rob.topResponseReady()) {
+ *        beat = rob.popResponse();
+ *      }
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
  */
-template <typename Data, unsigned int Depth, unsigned int InFlight>
-class ReorderBufWBeats : public ReorderBuf<Data, Depth, InFlight> {
+template <typename Data, unsigned int Depth, unsigned int InFlight,
+          unsigned int NumTrans = Depth>
+class ReorderBufWBeats {
 
  public:
-  ReorderBufWBeats() : ReorderBuf<Data, Depth, InFlight>() {}
+  ReorderBufWBeats() { reset(); }
+
+  typedef sc_uint<nvhls::index_width<InFlight>::val> Id;
+  typedef NVUINTW(nvhls::index_width<Depth + 1>::val) BeatCount;
+
+ protected:
+  typedef NVUINTW(nvhls::index_width<Depth>::val) EntryNum;
+  typedef NVUINTW(InFlight) IdRepository;
+  typedef NVUINTW(Depth) EntryMask;
+  typedef FIFO<bool, NumTrans> Order;
+  typedef typename Order::FifoIdx TransNum;
+  typedef NVUINTW(NumTrans) TransMask;
+
+  mem_array_sep<Data, Depth, 1> storage;
+
+  // Beats in use, and the last beat of each transaction
+  EntryMask used;
+  EntryMask last_beat;
+  EntryNum next_entry[Depth];
+  BeatCount reserved;
+
+  // Transactions in request order, each with its list of beats
+  Order order;
+  EntryNum head[NumTrans];
+  EntryNum tail[NumTrans];
+  TransMask nonempty;
+
+  IdRepository idrep;
+  TransNum id2trans[InFlight];
+
+  bool get_next_avail_id(Id& id, IdRepository& id_repository)
+  {
+    IdRepository free_ids = ~id_repository;
+    if (free_ids == 0)
+    {
+      return false;
+    }
+    id = nvhls::leading_ones<InFlight, IdRepository, Id>(free_ids);
+    id_repository[static_cast<int>(id)]=1;
+    return true;
+  }
+
+ public:
+  // All of the buffer state, e.g. for checkpoints
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m & storage;
+    m & used;
+    m & last_beat;
+    for (unsigned int i = 0; i < Depth; i++) m & next_entry[i];
+    m & reserved;
+    m & order;
+    for (unsigned int i = 0; i < NumTrans; i++) {
+      m & head[i];
+      m & tail[i];
+    }
+    m & nonempty;
+    m & idrep;
+    for (unsigned int i = 0; i < InFlight; i++) m & id2trans[i];
+  }
+
+  bool canAcceptRequest(const BeatCount& beats = 1)
+  {
+    return ((idrep != static_cast<IdRepository>(~0)) && !order.isFull() &&
+            (reserved <= Depth - beats));
+  }
+
+  Id addRequest(const BeatCount& beats = 1)
+  {
+    Id id;
+    bool success = get_next_avail_id(id, idrep);
+    NVHLS_ASSERT_MSG(success, "get_next_avail_id unsuccessful");
+    NVHLS_ASSERT_MSG(beats != 0 && reserved + beats <= Depth, "No room for the beats");
+
+    reserved += beats;
+    TransNum trans = order.get_tail();
+    id2trans[static_cast<int>(id)] = trans;
+    nonempty[static_cast<int>(trans)] = 0;
+    order.push(false);
 
+    return id;
+  }
+
+  // Beats always fit in the entries reserved by addRequest()
   bool canReceiveBeats()
   {
-    // Beats do not have a guaranteed space in storage
-    // since storage corresponds to vbits fifo,
-    // we can just check that vfifo is not full
-    return (!ReorderBuf<Data, Depth, InFlight>::vbits.isFull());
+    return (used != static_cast<EntryMask>(~0));
+  }
+
+  void addBeat(const Id& id, const Data& data, bool last)
+  {
+    NVHLS_ASSERT_MSG(idrep[static_cast<int>(id)] == 1, "idrep[id]!=1");
+    EntryMask free_entries = ~used;
+    NVHLS_ASSERT_MSG(free_entries != 0, "No free beat");
+    EntryNum entry =
+        nvhls::leading_ones<Depth, EntryMask, EntryNum>(free_entries);
+    storage.write(entry, 0, data);
+    used[static_cast<int>(entry)] = 1;
+    last_beat[static_cast<int>(entry)] = last;
+
+    TransNum trans = id2trans[static_cast<int>(id)];
+    if (nonempty[static_cast<int>(trans)])
+    {
+      next_entry[static_cast<int>(tail[trans])] = entry;
+    } else {
+      head[trans] = entry;
+    }
+    tail[trans] = entry;
+    nonempty[static_cast<int>(trans)] = 1;
+
+    if (last) {
+      idrep[static_cast<int>(id)]=0;
+    }
+  }
+
+  // Single-beat response, as ReorderBuf::addResponse()
+  void addResponse(const Id& id, const Data& data)
+  {
+    addBeat(id, data, true);
+  }
+
+  bool topResponseReady()
+  {
+    if (isEmpty()) {
+      return false;
+    } else {
+      return nonempty[static_cast<int>(order.get_head())];
+    }
   }
 
-  void addBeat(const Data& data) {
-    typename ReorderBuf<Data, Depth, InFlight>::EntryNum entryNum =
-        ReorderBuf<Data, Depth, InFlight>::vbits.get_tail();
-    ReorderBuf<Data, Depth, InFlight>::storage.write(entryNum, 0, data);
-    // so that response can be read out later
-    ReorderBuf<Data, Depth, InFlight>::vbits.push(true); 
+  Data popResponse()
+  {
+    NVHLS_ASSERT_MSG(topResponseReady(),"topResponseNotReady");
+
+    TransNum trans = order.get_head();
+    EntryNum entry = head[trans];
+    Data result = storage.read(entry, 0);
+    used[static_cast<int>(entry)] = 0;
+    reserved--;
+    if (entry == tail[trans])
+    {
+      nonempty[static_cast<int>(trans)] = 0;
+    } else {
+      head[trans] = next_entry[static_cast<int>(entry)];
+    }
+    if (last_beat[static_cast<int>(entry)]) {
+      order.incrHead();
+    }
+
+    return result;
+  }
+
+  void reset()
+  {
+    order.reset();
+    used = 0;
+    last_beat = 0;
+    reserved = 0;
+    nonempty = 0;
+    idrep = 0;
+  }
+
+  bool isEmpty()
+  {
+    return order.isEmpty();
   }
 };
 
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __AXI_MEM_REQ_H__
+#define __AXI_MEM_REQ_H__
+
+#include <nvhls_int.h>
+#include <nvhls_assert.h>
+#include <TypeToBits.h>
+#include <nvhls_mem_req.h>
+#include <axi/axi4.h>
+
+namespace axi {
+
+/**
+ * \brief Zero-latency conversions between AXI beats and nvhls::mem_req_t
+ * \ingroup AXI
+ *
+ * \tparam axiCfg       A valid AXI config.
+ * \tparam T            Word type of the memory. Its width must divide the AXI data width.
+ * \tparam AddrWidth    Width of the word addresses of the requests.
+ *
+ * \par Overview
+ * Each AXI data beat is one request of dataWidth / width(T) lanes, lane i
+ * holding the word at bits [i*width(T), (i+1)*width(T)) of the beat. A lane
+ * addresses word (byte address / bytes per word), so the lanes of a beat
+ * are consecutive words and a memory behind an AXI port sees the same
+ * addresses as one driven by mem_req_t directly.
+ * - Beats follow the AXI INCR burst rules. Narrow beats (AxSIZE below the
+ *   bus width) and unaligned start addresses only enable the lanes they
+ *   cover; AxSIZE must be at least one word.
+ * - With write strobes, a lane is written only when all of its bytes are
+ *   strobed. A lane with part of its bytes strobed is an assertion failure,
+ *   as mem_req_t has no byte enables.
+ * - The functions are combinational: a memory thread calls them on the
+ *   payloads it pops and pushes, with no extra cycle or buffer in between.
+ *
+ * \par A Simple Example
+ * \code
+ *      typedef axi::MemReqAdapter<axi::cfg::standard, NVUINTW(32), 16> Adapter;
+ *      ...
+ *      if (axi_read.ar.PopNB(ar)) {
+ *        Adapter::mem_rsp_t rsp;
+ *        scratchpad.load_store(Adapter::read_req(ar, beat), rsp);
+ *        axi_read.r.Push(Adapter::read_rsp(ar, rsp, beat == ar.len));
+ *      }
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg, typename T, unsigned int AddrWidth>
+class MemReqAdapter {
+ public:
+  typedef typename axi::axi4<axiCfg> axi4_;
+  static const unsigned int laneWidth = Wrapped<T>::width;
+  static const unsigned int numLanes = axiCfg::dataWidth / laneWidth;
+  static const unsigned int bytesPerLane = laneWidth >> 3;
+  static const unsigned int bytesPerWord = axiCfg::dataWidth >> 3;
+  static const unsigned int log2BytesPerLane = nvhls::log2_ceil<bytesPerLane>::val;
+  static const unsigned int log2BytesPerWord = nvhls::log2_ceil<bytesPerWord>::val;
+
+  static_assert(laneWidth % 8 == 0, "Word width must be a multiple of 8 bits");
+  static_assert(axiCfg::dataWidth % laneWidth == 0, "Word width must divide the AXI data width");
+  static_assert(bytesPerLane == (1 << log2BytesPerLane), "Word width must be a power of 2 bytes");
+
+  typedef nvhls::mem_req_t<T, AddrWidth, numLanes> mem_req_t;
+  typedef nvhls::mem_rsp_t<T, numLanes> mem_rsp_t;
+  typedef typename axi4_::Addr Addr;
+  typedef typename mem_req_t::LaneMask LaneMask;
+
+  // Load of beat beat of the read burst ar
+  static mem_req_t read_req(const typename axi4_::AddrPayload& ar, unsigned int beat) {
+    mem_req_t req;
+    req.is_store = 0;
+    set_lanes(req, ar, beat);
+    return req;
+  }
+
+  // Store of the write beat w, beat beat of the write burst aw
+  static mem_req_t write_req(const typename axi4_::AddrPayload& aw,
+                             const typename axi4_::WritePayload& w, unsigned int beat) {
+    mem_req_t req;
+    req.is_store = 1;
+    set_lanes(req, aw, beat);
+    #pragma hls_unroll yes
+    for (unsigned int i = 0; i < numLanes; i++) {
+      req.data[i] = NVUINTToType<T>(nvhls::get_slc<laneWidth>(w.data, i * laneWidth));
+      if (axi4_::WSTRB_WIDTH > 0) {
+        bool any = false;
+        bool all = true;
+        #pragma hls_unroll yes
+        for (unsigned int b = 0; b < bytesPerLane; b++) {
+          bool strb = w.wstrb[i * bytesPerLane + b];
+          any |= strb;
+          all &= strb;
+        }
+        NVHLS_ASSERT_MSG(req.valids[i] == 0 || any == all, "Write strobes cover part of a word");
+        if (!all) {
+          req.valids[i] = 0;
+        }
+      }
+    }
+    return req;
+  }
+
+  // Read data beat with the response of a read_req()
+  static typename axi4_::ReadPayload read_rsp(const typename axi4_::AddrPayload& ar,
+                                              const mem_rsp_t& rsp, bool last) {
+    typename axi4_::Data data = 0;
+    #pragma hls_unroll yes
+    for (unsigned int i = 0; i < numLanes; i++) {
+      if (rsp.valids[i] == 1) {
+        data = nvhls::set_slc(data, TypeToNVUINT(rsp.data[i]), i * laneWidth);
+      }
+    }
+    typename axi4_::ReadPayload pld;
+    pld.data = data;
+    pld.resp = axi4_::Enc::XRESP::OKAY;
+    pld.id = ar.id;
+    pld.last = last;
+    return pld;
+  }
+
+  // Write response once the last beat of aw is stored
+  static typename axi4_::WRespPayload write_rsp(const typename axi4_::AddrPayload& aw) {
+    typename axi4_::WRespPayload pld;
+    pld.resp = axi4_::Enc::XRESP::OKAY;
+    pld.id = aw.id;
+    return pld;
+  }
+
+ private:
+  static unsigned int beat_size(const typename axi4_::AddrPayload& pld) {
+    if (axi4_::ASIZE_WIDTH > 0) {
+      NVHLS_ASSERT_MSG(pld.size.to_uint64() <= log2BytesPerWord, "AxSIZE is larger than the data width");
+      NVHLS_ASSERT_MSG(pld.size.to_uint64() >= log2BytesPerLane, "AxSIZE is smaller than a word");
+      return pld.size.to_uint64();
+    }
+    return log2BytesPerWord;
+  }
+
+  // Lane addresses of the beat, enabling the lanes of the bytes it transfers
+  static void set_lanes(mem_req_t& req, const typename axi4_::AddrPayload& pld, unsigned int beat) {
+    unsigned int size = beat_size(pld);
+    Addr addr = pld.addr;
+    if (beat != 0) {
+      addr = ((pld.addr >> size) << size) + (static_cast<Addr>(beat) << size);
+    }
+    Addr beat_end = ((addr >> size) << size) + (static_cast<Addr>(1) << size);
+    Addr row = addr >> log2BytesPerWord;
+    #pragma hls_unroll yes
+    for (unsigned int i = 0; i < numLanes; i++) {
+      Addr lane_start = (row << log2BytesPerWord) + i * bytesPerLane;
+      req.addr[i] = (lane_start >> log2BytesPerLane);
+      req.valids[i] = (lane_start >= ((addr >> log2BytesPerLane) << log2BytesPerLane)) &&
+                      (lane_start < beat_end);
+    }
+  }
+};
+
+}  // namespace axi
+
+#endif
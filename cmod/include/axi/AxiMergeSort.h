@@ -0,0 +1,615 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXIMERGESORT_H__
+#define __AXIMERGESORT_H__
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <hls_globals.h>
+#include <nvhls_int.h>
+#include <nvhls_connections.h>
+#include <nvhls_message.h>
+#include <nvhls_assert.h>
+#include <axi/axi4.h>
+#include <comptrees.h>
+#include <fifo.h>
+#include <Arbiter.h>
+
+/**
+ * \brief A merge-sort engine that sorts a list of keys in AXI memory.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg           A valid AXI config.
+ * \tparam KeyWidth         Bitwidth of the keys.
+ * \tparam RunLen           Keys sorted at once by the sorting network (a power of two).
+ * \tparam Ways             Runs merged at once by the merge tree (a power of two, at least 2).
+ * \tparam StagesPerReg     Sorting network stages between registers, see SortNetworkPipelined.
+ * \tparam LeafQueueLen     Keys buffered for each run being merged.
+ * \tparam CountWidth       Bitwidth of the key count.
+ *
+ * \par Overview
+ * Each Command read from cmd_in sorts count keys, one per data word in the
+ * low KeyWidth bits, from src into ascending order at dst. The upper bits of
+ * each word are not kept. tmp must hold count words, and src, dst and tmp
+ * must not overlap. When dst is written the count is sent on done.
+ * - The first pass streams src through a SortNetwork, which writes
+ *   sorted runs of RunLen keys. A partial last block is padded with the
+ *   largest key, and the padding is dropped on the way out.
+ * - Each merge pass reads Ways runs at once, one AXI ID per run, into
+ *   per-run FIFOs. A tree of Ways-1 two-way compare nodes with 2-entry
+ *   FIFOs between them merges the runs at one key per cycle, and the merged
+ *   run is written back. Each pass multiplies the run length by Ways. The
+ *   passes alternate between tmp and dst, so the last one ends in dst.
+ * - A read burst is only sent for a run whose FIFO has room for all of its
+ *   beats, so the R channel never stalls on a full FIFO. Bursts are at
+ *   most half of LeafQueueLen so that two of them can be in flight per run,
+ *   and never cross a 4KB boundary.
+ * - A pass starts only after all writes of the previous pass have their
+ *   responses.
+ *
+ * Sorting N keys takes 1 + ceil(log_Ways(N / RunLen)) passes of about N
+ * cycles each.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <axi/AxiMergeSort.h>
+ *
+ *      ...
+ *      typedef AxiMergeSort<axi::cfg::standard, 32, 16, 4> Sorter;
+ *      Sorter::Command cmd;
+ *      cmd.src = 0x00000;
+ *      cmd.dst = 0x10000;
+ *      cmd.tmp = 0x20000;
+ *      cmd.count = 1000;
+ *      cmd_in.Push(cmd);
+ *      done.Pop();             // dst holds the 1000 sorted keys
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg, int KeyWidth, int RunLen = 16, int Ways = 4,
+          unsigned StagesPerReg = 0, int LeafQueueLen = 32, int CountWidth = 20>
+class AxiMergeSort : public sc_module {
+ public:
+  static const int kDebugLevel = 3;
+
+  typedef typename axi::axi4<axiCfg> axi4_;
+  typedef typename axi4_::Addr Addr;
+  typedef typename axi4_::Data Data;
+  typedef NVUINTW(KeyWidth) Key;
+  typedef NVUINTW(CountWidth) Count;
+  static const int bytesPerWord = axiCfg::dataWidth >> 3;
+
+  static_assert(KeyWidth <= axiCfg::dataWidth, "Keys must fit in a data word");
+  static_assert(RunLen >= 2 && (RunLen & (RunLen - 1)) == 0, "RunLen must be a power of two");
+  static_assert(Ways >= 2 && (Ways & (Ways - 1)) == 0, "Ways must be a power of two");
+  static_assert(LeafQueueLen >= 2, "LeafQueueLen must be at least 2");
+  static_assert(axiCfg::idWidth > 0 && (1 << axiCfg::idWidth) >= Ways,
+                "The AXI ID must be wide enough for Ways runs");
+
+  struct Command : public nvhls_message {
+    Addr src;     // Keys to sort, word aligned
+    Addr dst;     // Sorted keys, word aligned
+    Addr tmp;     // Scratch space for count words, word aligned
+    Count count;  // Keys to sort
+    static const unsigned int width = 3 * axi4_::ADDR_WIDTH + CountWidth;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m & src;
+      m & dst;
+      m & tmp;
+      m & count;
+    }
+  };
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  Connections::In<Command> cmd_in;
+  Connections::Out<Count> done;
+  typename axi4_::read::template manager<> if_rd;
+  typename axi4_::write::template manager<> if_wr;
+
+  SC_CTOR(AxiMergeSort)
+      : clk("clk"),
+        reset_bar("reset_bar"),
+        cmd_in("cmd_in"),
+        done("done"),
+        if_rd("if_rd"),
+        if_wr("if_wr") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ protected:
+  enum {
+    kByteBits = nvhls::log2_ceil<bytesPerWord>::val,
+    kLgRun = nvhls::log2_ceil<RunLen>::val,
+    kLgWays = nvhls::log2_ceil<Ways>::val,
+    kMaxBurstSize = (axiCfg::useBurst ? axiCfg::maxBurstSize : 1),
+    kMaxBurst = (kMaxBurstSize < LeafQueueLen / 2 ? kMaxBurstSize : LeafQueueLen / 2),
+    kMaxWrites = 8,
+    kPageBytes = 4096,
+    // Merge passes needed for 2^CountWidth keys
+    kMaxPasses = (CountWidth > kLgRun) ? (CountWidth - kLgRun + kLgWays - 1) / kLgWays : 0,
+  };
+
+  // A key on its way through the merge tree. A pad stands in for an empty
+  // run and sorts after every key.
+  struct Elem : public nvhls_message {
+    Key key;
+    bool last;  // Last key of its run
+    bool pad;
+    static const unsigned int width = KeyWidth + 2;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m & key;
+      m & last;
+      m & pad;
+    }
+  };
+
+  // A block in the sorting network
+  struct Block : public nvhls_message {
+    NVUINTW(nvhls::index_width<RunLen + 1>::val) len;
+    bool last;  // Holds the last key of the input
+    static const unsigned int width = nvhls::index_width<RunLen + 1>::val + 1;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m & len;
+      m & last;
+    }
+  };
+
+  typedef SortNetwork<Key, NVUINTW(nvhls::index_width<RunLen>::val), RunLen> Network;
+  typedef SortNetworkPipelined<Network, StagesPerReg> Sorter;
+  typedef NVUINTW(CountWidth + kLgWays + 1) Pos;
+  typedef NVUINTW(nvhls::index_width<CountWidth + kLgWays + 1>::val) Shift;
+  typedef NVUINTW(nvhls::index_width<kMaxPasses + 1>::val) Pass;
+  typedef NVUINTW(nvhls::index_width<kMaxBurst + 1>::val) BurstLen;
+  typedef NVUINTW(nvhls::index_width<LeafQueueLen + 1>::val) Credit;
+  typedef NVUINTW(nvhls::index_width<kMaxWrites + 1>::val) WriteCount;
+  typedef NVUINTW(Ways) LeafMask;
+  typedef NVUINTW(nvhls::index_width<Ways>::val) LeafIdx;
+
+  Sorter sorter;
+  FIFO<Block, Sorter::Latency + 1> blocks;
+  // Keys read for each run of the merge group
+  FIFO<Elem, LeafQueueLen, Ways> leaf_q;
+  // Output of each merge node; node 0 feeds the write side
+  FIFO<Elem, 2, Ways - 1> node_q;
+  FIFO<BurstLen, kMaxWrites> w_lens;
+  Arbiter<Ways> rd_arb;
+
+  void run() {
+    cmd_in.Reset();
+    done.Reset();
+    if_rd.reset();
+    if_wr.reset();
+    sorter.reset();
+    blocks.reset();
+    leaf_q.reset();
+    node_q.reset();
+    w_lens.reset();
+    rd_arb.reset();
+
+    Command cmd;
+    bool busy = false;
+    bool done_valid = false;
+    Pass pass = 0;
+    Pass passes = 0;
+
+    // Current pass: runs of 2^run_lg keys merged in groups of Ways
+    Addr rd_base = 0;
+    Addr wr_base = 0;
+    Shift run_lg = 0;
+    Count groups = 0;
+
+    // Read side, per run of the group
+    Count req_group[Ways];
+    Pos req_left[Ways];
+    Addr req_addr[Ways];
+    Count recv_group[Ways];
+    Pos recv_left[Ways];
+    Credit credit[Ways];
+
+    // Merge tree
+    bool side_done[Ways - 1][2];
+
+    // First pass: gathered block, sorted banks
+    Key gather[RunLen];
+    Block gather_blk;
+    bool gather_ready = false;
+    Key sorted[2][RunLen];
+    Block bank_blk[2];
+    bool bank_valid[2];
+    NVUINTW(1) fill_bank = 0;
+    NVUINTW(1) emit_bank = 0;
+    NVUINTW(nvhls::index_width<RunLen>::val) emit_idx = 0;
+
+    // Write side
+    Pos wr_left = 0;
+    Addr wr_addr = 0;
+    BurstLen w_beat = 0;
+    WriteCount b_pending = 0;
+    Count groups_left = 0;
+
+    gather_blk.len = 0;
+    gather_blk.last = false;
+    #pragma hls_unroll yes
+    for (unsigned b = 0; b < 2; b++) {
+      bank_valid[b] = false;
+    }
+    #pragma hls_unroll yes
+    for (unsigned n = 0; n < Ways - 1; n++) {
+      side_done[n][0] = false;
+      side_done[n][1] = false;
+    }
+    #pragma hls_unroll yes
+    for (unsigned k = 0; k < Ways; k++) {
+      req_group[k] = 0;
+      req_left[k] = 0;
+      req_addr[k] = 0;
+      recv_group[k] = 0;
+      recv_left[k] = 0;
+      credit[k] = LeafQueueLen;
+    }
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      // Write responses
+      typename axi4_::WRespPayload b;
+      if (if_wr.b.PopNB(b)) {
+        b_pending--;
+      }
+
+      // Write data from the root of the tree; pads are dropped
+      if (!node_q.isEmpty(0)) {
+        Elem e = node_q.peek(0);
+        if (e.pad) {
+          node_q.pop(0);
+          if (e.last) {
+            groups_left--;
+          }
+        } else if (!w_lens.isEmpty()) {
+          typename axi4_::WritePayload w;
+          w.data = e.key;
+          w.wstrb = ~0;
+          w.last = (w_beat == w_lens.peek() - 1);
+          if (if_wr.w.PushNB(w)) {
+            node_q.pop(0);
+            if (e.last) {
+              groups_left--;
+            }
+            if (w.last == 1) {
+              w_lens.pop();
+              w_beat = 0;
+            } else {
+              w_beat++;
+            }
+          }
+        }
+      }
+
+      // Write bursts for the whole pass, ahead of the data
+      if (wr_left != 0 && !w_lens.isFull() && b_pending < kMaxWrites) {
+        BurstLen len = burst_len(wr_addr, wr_left);
+        typename axi4_::AddrPayload aw;
+        aw.id = 0;
+        aw.addr = wr_addr;
+        aw.len = len - 1;
+        if (if_wr.aw.PushNB(aw)) {
+          CDCOUT(sc_time_stamp() << " " << name() << " Sent write request: ["
+                        << aw << "]" << endl, kDebugLevel);
+          w_lens.push(len);
+          b_pending++;
+          wr_left -= len;
+          wr_addr += bytesPerWord * len;
+        }
+      }
+
+      // Merge tree, root first so that a node sees the room its parent
+      // makes this cycle
+      if (busy && pass != 0) {
+        #pragma hls_unroll yes
+        for (unsigned n = 0; n < Ways - 1; n++) {
+          Elem head[2];
+          bool avail[2];
+          #pragma hls_unroll yes
+          for (unsigned s = 0; s < 2; s++) {
+            unsigned c = 2 * n + 1 + s;
+            if (c < Ways - 1) {
+              avail[s] = !node_q.isEmpty(c);
+              head[s] = node_q.peek(c);
+            } else {
+              avail[s] = !leaf_q.isEmpty(c - (Ways - 1));
+              head[s] = leaf_q.peek(c - (Ways - 1));
+            }
+          }
+
+          bool take = false;
+          unsigned sel = 0;
+          if (!side_done[n][0] && !side_done[n][1]) {
+            take = avail[0] && avail[1];
+            sel = (!head[1].pad && (head[0].pad || head[1].key < head[0].key)) ? 1 : 0;
+          } else if (!side_done[n][0]) {
+            take = avail[0];
+            sel = 0;
+          } else if (!side_done[n][1]) {
+            take = avail[1];
+            sel = 1;
+          }
+
+          Elem e = head[sel];
+          bool other_done = side_done[n][1 - sel];
+          // A pad only goes up once the other side is done, as its end marker
+          bool emit = !e.pad || other_done;
+          if (take && (!emit || !node_q.isFull(n))) {
+            unsigned c = 2 * n + 1 + sel;
+            if (c < Ways - 1) {
+              node_q.pop(c);
+            } else {
+              leaf_q.pop(c - (Ways - 1));
+              credit[c - (Ways - 1)]++;
+            }
+            if (emit) {
+              Elem out = e;
+              out.last = e.last && other_done;
+              node_q.push(out, n);
+            }
+            if (e.last) {
+              if (other_done) {
+                side_done[n][0] = false;
+                side_done[n][1] = false;
+              } else {
+                side_done[n][sel] = true;
+              }
+            }
+          }
+        }
+      }
+
+      // First pass: sorted blocks to the write side
+      if (bank_valid[emit_bank] && !node_q.isFull(0)) {
+        Block blk = bank_blk[emit_bank];
+        Elem e;
+        e.key = sorted[emit_bank][emit_idx];
+        e.pad = false;
+        e.last = blk.last && (emit_idx == blk.len - 1);
+        node_q.push(e, 0);
+        if (emit_idx == blk.len - 1) {
+          bank_valid[emit_bank] = false;
+          emit_bank ^= 1;
+          emit_idx = 0;
+        } else {
+          emit_idx++;
+        }
+      }
+
+      // The sorting network only advances while a bank is free for its
+      // output
+      if (!bank_valid[fill_bank]) {
+        Key in[RunLen];
+        #pragma hls_unroll yes
+        for (unsigned i = 0; i < RunLen; i++) {
+          in[i] = (i < gather_blk.len) ? gather[i] : static_cast<Key>(~static_cast<Key>(0));
+        }
+        Key out[RunLen];
+        typename Network::Idx out_idx[RunLen];
+        bool out_valid;
+        sorter.run(in, gather_ready, out, out_idx, out_valid);
+        if (gather_ready) {
+          blocks.push(gather_blk);
+          gather_ready = false;
+          gather_blk.len = 0;
+          gather_blk.last = false;
+        }
+        if (out_valid) {
+          #pragma hls_unroll yes
+          for (unsigned i = 0; i < RunLen; i++) {
+            sorted[fill_bank][i] = out[i];
+          }
+          bank_blk[fill_bank] = blocks.pop();
+          bank_valid[fill_bank] = true;
+          fill_bank ^= 1;
+        }
+      }
+
+      // First pass: gather a block from the single input run
+      if (busy && pass == 0 && !gather_ready && !leaf_q.isEmpty(0)) {
+        Elem e = leaf_q.pop(0);
+        credit[0]++;
+        gather[gather_blk.len] = e.key;
+        gather_blk.len++;
+        gather_blk.last = e.last;
+        gather_ready = e.last || (gather_blk.len == RunLen);
+      }
+
+      // Read data
+      typename axi4_::ReadPayload r;
+      if (if_rd.r.PopNB(r)) {
+        LeafIdx k = static_cast<sc_uint<axi4_::ID_WIDTH> >(r.id);
+        NVHLS_ASSERT_MSG(k < Ways && recv_left[k] != 0, "Read data with an unknown AXI ID");
+        Elem e;
+        e.key = nvhls::get_slc<KeyWidth>(r.data, 0);
+        e.last = (recv_left[k] == 1);
+        e.pad = false;
+        leaf_q.push(e, k);
+        recv_left[k]--;
+      }
+
+      // Next run of each leaf; an empty run becomes a pad
+      #pragma hls_unroll yes
+      for (unsigned k = 0; k < Ways; k++) {
+        if (busy && recv_left[k] == 0 && recv_group[k] != groups) {
+          Pos start;
+          Pos len = run_len(pass, recv_group[k], k, run_lg, cmd.count, start);
+          if (len != 0) {
+            recv_left[k] = len;
+            recv_group[k]++;
+          } else if (credit[k] != 0) {
+            Elem e;
+            e.key = 0;
+            e.last = true;
+            e.pad = true;
+            leaf_q.push(e, k);
+            credit[k]--;
+            recv_group[k]++;
+          }
+        }
+      }
+
+      // Read bursts, from the runs with room for them
+      LeafMask rd_ready = 0;
+      BurstLen rd_len[Ways];
+      #pragma hls_unroll yes
+      for (unsigned k = 0; k < Ways; k++) {
+        rd_len[k] = burst_len(req_addr[k], req_left[k]);
+        rd_ready[k] = (req_left[k] != 0) && (credit[k] >= rd_len[k]);
+      }
+      if (rd_ready != 0) {
+        LeafIdx k = nvhls::leading_ones<Ways, LeafMask, LeafIdx>(rd_arb.pick(rd_ready));
+        typename axi4_::AddrPayload ar;
+        ar.id = k;
+        ar.addr = req_addr[k];
+        ar.len = rd_len[k] - 1;
+        if (if_rd.ar.PushNB(ar)) {
+          CDCOUT(sc_time_stamp() << " " << name() << " Sent read request: ["
+                        << ar << "]" << endl, kDebugLevel);
+          credit[k] -= rd_len[k];
+          req_left[k] -= rd_len[k];
+          req_addr[k] += bytesPerWord * rd_len[k];
+        }
+      }
+      #pragma hls_unroll yes
+      for (unsigned k = 0; k < Ways; k++) {
+        if (busy && req_left[k] == 0 && req_group[k] != groups) {
+          Pos start;
+          req_left[k] = run_len(pass, req_group[k], k, run_lg, cmd.count, start);
+          req_addr[k] = rd_base + bytesPerWord * start;
+          req_group[k]++;
+        }
+      }
+
+      // End of a pass: every run merged and written
+      bool pass_done = busy && wr_left == 0 && w_lens.isEmpty() && b_pending == 0 &&
+                       groups_left == 0;
+      bool start = false;
+      if (pass_done) {
+        if (pass == passes) {
+          busy = false;
+          done_valid = true;
+        } else {
+          pass++;
+          start = true;
+        }
+      }
+      if (done_valid && done.PushNB(cmd.count)) {
+        done_valid = false;
+      }
+      if (!busy && !done_valid && cmd_in.PopNB(cmd)) {
+        NVHLS_ASSERT_MSG(cmd.src % bytesPerWord == 0 && cmd.dst % bytesPerWord == 0 &&
+                         cmd.tmp % bytesPerWord == 0, "Command addresses must be word aligned");
+        if (cmd.count == 0) {
+          done_valid = true;
+        } else {
+          passes = 0;
+          #pragma hls_unroll yes
+          for (unsigned m = 0; m < kMaxPasses; m++) {
+            if (((cmd.count - 1) >> (kLgRun + m * kLgWays)) != 0) {
+              passes = m + 1;
+            }
+          }
+          busy = true;
+          pass = 0;
+          start = true;
+        }
+      }
+
+      if (start) {
+        CDCOUT(sc_time_stamp() << " " << name() << " Starting pass " << pass
+                      << " of " << passes << endl, kDebugLevel);
+        // The passes alternate between tmp and dst, ending in dst
+        bool wr_tmp = ((passes - pass) & 1) == 1;
+        rd_base = (pass == 0) ? cmd.src : (wr_tmp ? cmd.dst : cmd.tmp);
+        wr_base = wr_tmp ? cmd.tmp : cmd.dst;
+        if (pass == 0) {
+          run_lg = 0;
+          groups = 1;
+        } else {
+          run_lg = kLgRun + (pass - 1) * kLgWays;
+          Shift group_lg = run_lg + kLgWays;
+          groups = cmd.count >> group_lg;
+          if ((groups << group_lg) != cmd.count) {
+            groups++;
+          }
+        }
+        groups_left = groups;
+        wr_left = cmd.count;
+        wr_addr = wr_base;
+        #pragma hls_unroll yes
+        for (unsigned k = 0; k < Ways; k++) {
+          // The first pass reads a single run
+          Count first = (pass == 0 && k != 0) ? groups : Count(0);
+          req_group[k] = first;
+          recv_group[k] = first;
+        }
+      }
+    }
+  }
+
+  // Keys in run k of merge group g, and its first key. The first pass
+  // reads all the keys as one run.
+  static Pos run_len(const Pass& pass, const Count& g, unsigned k, const Shift& run_lg,
+                     const Count& count, Pos& start) {
+    if (pass == 0) {
+      start = 0;
+      return count;
+    }
+    start = ((static_cast<Pos>(g) << kLgWays) + k) << run_lg;
+    if (start >= count) {
+      return 0;
+    }
+    Pos left = count - start;
+    Pos len = static_cast<Pos>(1) << run_lg;
+    return (left < len) ? left : len;
+  }
+
+  // Longest burst for count words from addr
+  static BurstLen burst_len(const Addr& addr, const Pos& count) {
+    // Words left before the next 4KB boundary
+    NVUINTW(13 - kByteBits) to_page =
+        (kPageBytes - nvhls::get_slc<12>(addr, 0)) >> kByteBits;
+    BurstLen len = kMaxBurst;
+    if (count < len) {
+      len = count;
+    }
+    if (axi4_::ADDR_WIDTH > 12 && to_page < len) {
+      len = to_page;
+    }
+    return len;
+  }
+};
+
+#endif
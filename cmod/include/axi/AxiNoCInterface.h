@@ -0,0 +1,576 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __AXI_NOC_INTERFACE_H__
+#define __AXI_NOC_INTERFACE_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <nvhls_packet.h>
+#include <nvhls_assert.h>
+#include <axi/axi4.h>
+#include <ReorderBuf.h>
+#include "TypeToBits.h"
+
+namespace axi {
+
+/**
+ * \brief Packet format of AXI transactions carried over a packet NoC.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg       A valid AXI config.
+ * \tparam Packet_t     The Packet type of the NoC.
+ * \tparam maxWrites    Outstanding write bursts of a manager interface.
+ * \tparam maxBeats     Most beats of a write burst (default: axiCfg::maxBurstSize).
+ *
+ * \par Overview
+ * Every packet starts with its kind, the node of its sender and a tag, at
+ * the LSBs of data, followed by an AXI payload:
+ * - AR: the AddrPayload.
+ * - AW: the AddrPayload followed by all W beats of the burst, so that the
+ *   beats of one burst can never interleave with those of another at the
+ *   subordinate. The tag is the write's entry in the manager's reorder
+ *   buffer.
+ * - R: one ReadPayload.
+ * - B: the WRespPayload, with the tag of its AW.
+ * .
+ * Unused beats are zero, so a NoC that sends packets in as few flits as their
+ * data needs only carries the beats of each burst.
+ */
+template <typename axiCfg, typename Packet_t, int maxWrites,
+          int maxBeats = axiCfg::maxBurstSize>
+struct NoCFormat {
+  typedef axi::axi4<axiCfg> axi4_;
+
+  enum Kind { AR = 0, AW = 1, R = 2, B = 3 };
+
+  enum {
+    kind_width = 2,
+    node_width = Packet_t::dest_width,
+    tag_width = nvhls::index_width<maxWrites>::val,
+    header_width = kind_width + node_width + tag_width,
+    addr_width = Wrapped<typename axi4_::AddrPayload>::width,
+    w_width = Wrapped<typename axi4_::WritePayload>::width,
+    r_width = Wrapped<typename axi4_::ReadPayload>::width,
+    b_width = Wrapped<typename axi4_::WRespPayload>::width,
+    max_beats = maxBeats,
+    aw_width = header_width + addr_width + maxBeats * w_width,
+    r_packet_width = header_width + r_width,
+  };
+  static_assert(aw_width <= Packet_t::data_width,
+                "Packet data must hold a write burst of maxBeats beats");
+  static_assert(r_packet_width <= Packet_t::data_width,
+                "Packet data must hold a read beat");
+
+  typedef NVUINTW(node_width) Node;
+  typedef NVUINTW(tag_width) Tag;
+
+  static Packet_t header(Kind kind, const Node& src, const Tag& tag,
+                         const Node& dest, int vc) {
+    Packet_t packet;
+    packet.data = 0;
+    packet.data = nvhls::set_slc(packet.data, NVUINTW(kind_width)(kind), 0);
+    packet.data = nvhls::set_slc(packet.data, src, kind_width);
+    packet.data = nvhls::set_slc(packet.data, tag, kind_width + node_width);
+    packet.dest = dest;
+    packet.packet_id = vc;
+    return packet;
+  }
+
+  static NVUINTW(kind_width) kind(const Packet_t& packet) {
+    return nvhls::get_slc<kind_width>(packet.data, 0);
+  }
+  static Node src(const Packet_t& packet) {
+    return nvhls::get_slc<node_width>(packet.data, kind_width);
+  }
+  static Tag tag(const Packet_t& packet) {
+    return nvhls::get_slc<tag_width>(packet.data, kind_width + node_width);
+  }
+
+  // Payload at bit offset of the payload area
+  template <typename T>
+  static void set(Packet_t& packet, const T& payload, int offset) {
+    packet.data = nvhls::set_slc(packet.data, TypeToNVUINT(payload), header_width + offset);
+  }
+  template <typename T>
+  static T get(const Packet_t& packet, int offset) {
+    return NVUINTToType<T>(nvhls::get_slc<Wrapped<T>::width>(packet.data, header_width + offset));
+  }
+
+  // Offset of W beat n of an AW packet
+  static int beat_offset(int n) { return addr_width + n * w_width; }
+};
+
+}  // namespace axi
+
+/**
+ * \brief Network interface between an AXI manager and a packet NoC.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg           A valid AXI config.
+ * \tparam Packet_t         The Packet type of the NoC, with a packet_id.
+ * \tparam numRegions       The number of address regions of the address map.
+ * \tparam maxWrites        Outstanding write bursts (default: 4).
+ * \tparam maxReadsPerId    Outstanding read bursts per AXI ID (default: 4).
+ * \tparam reqVC            VC of the request network (default: 0).
+ * \tparam respVC           VC of the response network (default: 1).
+ * \tparam maxBeats         Most beats of a write burst (default: axiCfg::maxBurstSize).
+ *
+ * \par Overview
+ * AxiNoCManagerNI takes the requests of an AXI manager on axi_read and
+ * axi_write, and sends them as packets (see axi::NoCFormat) on out_packet
+ * to the node that owns their address. Responses come back on in_packet.
+ * With a WHVCNoC, out_packet and in_packet connect to the in_packet and
+ * out_packet of the manager's node.
+ * - The address map is a set of inclusive [base, limit] ranges on
+ *   addrBound, each served by the node on regionNode. The lowest-indexed
+ *   range that holds the address of a burst wins, and all of the burst goes
+ *   there, as in AxiSplitter. node is the node of the interface itself.
+ * - Requests travel on VC reqVC and responses on VC respVC, so that
+ *   responses never wait behind requests. Every AXI manager must keep
+ *   accepting R and B for the network to be free of deadlock.
+ * - A write burst leaves as one packet once all of its W beats have
+ *   arrived. B responses go into a ReorderBufById, and are returned in
+ *   request order for each AXI ID, whatever node they come from.
+ * - Reads with the same ID go to one node at a time, as in AxiSplitter: a
+ *   read waits while reads with its ID are outstanding at another node.
+ *   R beats are forwarded as they arrive, so bursts of different IDs may
+ *   interleave.
+ *
+ * \par A Simple Example
+ * \code
+ *      AxiNoCManagerNI<axi::cfg::standard, NoC_t::Packet_t, 4> ni;
+ *      ...
+ *      ni.axi_read(manager_read);
+ *      ni.axi_write(manager_write);
+ *      ni.out_packet(noc_in[node]);
+ *      ni.in_packet(noc_out[node]);
+ *      ni.node(node_signal);
+ *      for (int i = 0; i < 4; i++) {
+ *        ni.addrBound[i][0](base[i]);
+ *        ni.addrBound[i][1](limit[i]);
+ *        ni.regionNode[i](region_node[i]);
+ *      }
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg, typename Packet_t, int numRegions, int maxWrites = 4,
+          int maxReadsPerId = 4, int reqVC = 0, int respVC = 1,
+          int maxBeats = axiCfg::maxBurstSize>
+class AxiNoCManagerNI : public sc_module {
+ public:
+  static const int kDebugLevel = 5;
+  typedef axi::axi4<axiCfg> axi4_;
+  typedef axi::NoCFormat<axiCfg, Packet_t, maxWrites, maxBeats> Format;
+  typedef typename Format::Node Node;
+  typedef typename Format::Tag Tag;
+
+  enum { numIds = 1 << axiCfg::idWidth };
+  typedef NVUINTW(nvhls::index_width<maxReadsPerId + 1>::val) ReadCount;
+  typedef ReorderBufById<typename axi4_::WRespPayload, maxWrites, maxWrites, numIds> Rob;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axi4_::read::template subordinate<> axi_read;
+  typename axi4_::write::template subordinate<> axi_write;
+
+  Connections::Out<Packet_t> out_packet;
+  Connections::In<Packet_t> in_packet;
+
+  sc_in<Node> node;
+  sc_in<NVUINTW(axiCfg::addrWidth)> addrBound[numRegions][2];
+  sc_in<Node> regionNode[numRegions];
+
+  SC_HAS_PROCESS(AxiNoCManagerNI);
+
+  AxiNoCManagerNI(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axi_read("axi_read"),
+        axi_write("axi_write"),
+        out_packet("out_packet"),
+        in_packet("in_packet"),
+        node("node") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+  // Node of the region that holds addr
+  Node route(const typename axi4_::Addr& addr) {
+    NVUINTW(numRegions) hit = 0;
+#pragma hls_unroll yes
+    for (int i = 0; i < numRegions; i++) {
+      if (addr >= addrBound[i][0].read() && addr <= addrBound[i][1].read()) {
+        hit[i] = 1;
+      }
+    }
+    NVHLS_ASSERT_MSG(hit != 0, "Address outside the address map");
+    Node dest = 0;
+#pragma hls_unroll yes
+    for (int i = numRegions - 1; i >= 0; i--) {
+      if (hit[i] == 1) {
+        dest = regionNode[i].read();
+      }
+    }
+    return dest;
+  }
+
+ private:
+  void run() {
+    axi_read.reset();
+    axi_write.reset();
+    out_packet.Reset();
+    in_packet.Reset();
+
+    Rob rob;
+    rob.reset();
+
+    // Outstanding reads of each ID, and the node they went to
+    ReadCount rd_count[numIds];
+    Node rd_node[numIds];
+#pragma hls_unroll yes
+    for (int i = 0; i < numIds; i++) {
+      rd_count[i] = 0;
+      rd_node[i] = 0;
+    }
+
+    typename axi4_::AddrPayload ar;
+    bool ar_valid = false;
+    Packet_t rd_packet;
+    bool rd_packet_valid = false;
+
+    // Write burst being collected into wr_packet
+    bool aw_active = false;
+    NVUINTW(nvhls::index_width<maxBeats>::val) beat = 0;
+    Packet_t wr_packet;
+    bool wr_packet_valid = false;
+
+    typename axi4_::ReadPayload r;
+    bool r_valid = false;
+    typename axi4_::WRespPayload b;
+    bool b_valid = false;
+    bool wr_first = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+      Node self = node.read();
+
+      // Responses: R beats go straight to the manager, B into the ROB
+      if (!r_valid) {
+        Packet_t resp;
+        if (in_packet.PopNB(resp)) {
+          if (Format::kind(resp) == Format::R) {
+            r = Format::template get<typename axi4_::ReadPayload>(resp, 0);
+            r_valid = true;
+          } else {
+            NVHLS_ASSERT_MSG(Format::kind(resp) == Format::B, "Request packet at a manager");
+            rob.addResponse(typename Rob::Id(Format::tag(resp).to_uint()),
+                            Format::template get<typename axi4_::WRespPayload>(resp, 0));
+          }
+        }
+      }
+      if (r_valid) {
+        if (axi_read.r.PushNB(r)) {
+          r_valid = false;
+          if (r.last == 1) {
+            rd_count[r.id.to_uint()]--;
+          }
+        }
+      }
+      if (!b_valid && rob.topResponseReady()) {
+        b = rob.popResponse();
+        b_valid = true;
+      }
+      if (b_valid) {
+        b_valid = !axi_write.b.PushNB(b);
+      }
+
+      // Reads: an ID stays on one node while it has reads outstanding
+      if (!ar_valid) {
+        ar_valid = axi_read.ar.PopNB(ar);
+      }
+      if (ar_valid && !rd_packet_valid) {
+        Node dest = route(ar.addr);
+        unsigned id = ar.id.to_uint();
+        if (rd_count[id] == 0 || (rd_node[id] == dest && rd_count[id] < maxReadsPerId)) {
+          rd_packet = Format::header(Format::AR, self, 0, dest, reqVC);
+          Format::set(rd_packet, ar, 0);
+          rd_packet_valid = true;
+          rd_count[id]++;
+          rd_node[id] = dest;
+          ar_valid = false;
+        }
+      }
+
+      // Writes: collect the burst, with its B entry reserved in the ROB
+      if (!aw_active && !wr_packet_valid && rob.canAcceptRequest()) {
+        typename axi4_::AddrPayload aw;
+        if (axi_write.aw.PopNB(aw)) {
+          Tag tag = rob.addRequest(aw.id.to_uint()).to_uint();
+          wr_packet = Format::header(Format::AW, self, tag, route(aw.addr), reqVC);
+          Format::set(wr_packet, aw, 0);
+          aw_active = true;
+          beat = 0;
+        }
+      }
+      if (aw_active) {
+        typename axi4_::WritePayload w;
+        if (axi_write.w.PopNB(w)) {
+          NVHLS_ASSERT_MSG(beat < maxBeats, "Write burst longer than maxBeats");
+          Format::set(wr_packet, w, Format::beat_offset(beat));
+          beat++;
+          if (w.last == 1) {
+            aw_active = false;
+            wr_packet_valid = true;
+          }
+        }
+      }
+
+      // One packet per cycle, alternating when both kinds wait
+      if (rd_packet_valid || wr_packet_valid) {
+        bool send_wr = wr_packet_valid && (!rd_packet_valid || wr_first);
+        if (out_packet.PushNB(send_wr ? wr_packet : rd_packet)) {
+          CDCOUT(sc_time_stamp() << " " << name() << " sent "
+                 << (send_wr ? "write" : "read") << " to node "
+                 << (send_wr ? wr_packet.dest : rd_packet.dest) << endl, kDebugLevel);
+          if (send_wr) {
+            wr_packet_valid = false;
+          } else {
+            rd_packet_valid = false;
+          }
+          wr_first = !send_wr;
+        }
+      }
+    }
+  }
+};
+
+/**
+ * \brief Network interface between a packet NoC and an AXI subordinate.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg           A valid AXI config.
+ * \tparam Packet_t         The Packet type of the NoC, with a packet_id.
+ * \tparam maxWrites        maxWrites of the AxiNoCManagerNI of the NoC (default: 4).
+ * \tparam maxOutstanding   Outstanding reads, and outstanding writes, at the
+ *                          subordinate, at most 2^idWidth (default: 2^idWidth).
+ * \tparam respVC           VC of the response network (default: 1).
+ * \tparam maxBeats         Most beats of a write burst (default: axiCfg::maxBurstSize).
+ *
+ * \par Overview
+ * AxiNoCSubordinateNI takes the request packets of AxiNoCManagerNI from
+ * in_packet, issues them to an AXI subordinate on axi_read and axi_write,
+ * and sends R and B back on out_packet to the node that sent the request.
+ * - Managers at different nodes may use the same AXI ID, so every burst is
+ *   issued with a tag of its own as its ID, one of maxOutstanding for reads
+ *   and for writes. The tag keeps the node and ID of the burst until its
+ *   response leaves, and the response carries the original ID.
+ * - A write burst is issued as its AW followed by its W beats, one per
+ *   cycle, before the next request is taken.
+ * - The subordinate must keep accepting requests and returning responses
+ *   for the network to be free of deadlock; responses never wait for
+ *   requests.
+ *
+ * \par A Simple Example
+ * \code
+ *      AxiNoCSubordinateNI<axi::cfg::standard, NoC_t::Packet_t, 4> ni;
+ *      ...
+ *      ni.axi_read(subordinate_read);
+ *      ni.axi_write(subordinate_write);
+ *      ni.out_packet(noc_in[node]);
+ *      ni.in_packet(noc_out[node]);
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg, typename Packet_t, int maxWrites = 4,
+          int maxOutstanding = (1 << axiCfg::idWidth), int respVC = 1,
+          int maxBeats = axiCfg::maxBurstSize>
+class AxiNoCSubordinateNI : public sc_module {
+ public:
+  static const int kDebugLevel = 5;
+  typedef axi::axi4<axiCfg> axi4_;
+  typedef axi::NoCFormat<axiCfg, Packet_t, maxWrites, maxBeats> Format;
+  typedef typename Format::Node Node;
+  typedef typename Format::Tag Tag;
+  static_assert(maxOutstanding >= 1 && maxOutstanding <= (1 << axiCfg::idWidth),
+                "Tags are issued as AXI IDs");
+  enum { tag_width = nvhls::index_width<maxOutstanding>::val };
+  typedef NVUINTW(maxOutstanding) TagMask;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axi4_::read::template manager<> axi_read;
+  typename axi4_::write::template manager<> axi_write;
+
+  Connections::Out<Packet_t> out_packet;
+  Connections::In<Packet_t> in_packet;
+
+  SC_HAS_PROCESS(AxiNoCSubordinateNI);
+
+  AxiNoCSubordinateNI(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axi_read("axi_read"),
+        axi_write("axi_write"),
+        out_packet("out_packet"),
+        in_packet("in_packet") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ private:
+  // Lowest free tag of mask, if any
+  static bool free_tag(const TagMask& busy, NVUINTW(tag_width)& tag) {
+    TagMask free_tags = ~busy;
+    if (free_tags == 0) {
+      return false;
+    }
+    tag = nvhls::leading_ones<maxOutstanding, TagMask, NVUINTW(tag_width)>(free_tags);
+    return true;
+  }
+
+  void run() {
+    axi_read.reset();
+    axi_write.reset();
+    out_packet.Reset();
+    in_packet.Reset();
+
+    // Node and AXI ID of every read and write tag, and the ROB tag of writes
+    TagMask rd_busy = 0;
+    Node rd_src[maxOutstanding];
+    typename axi4_::Id rd_id[maxOutstanding];
+    TagMask wr_busy = 0;
+    Node wr_src[maxOutstanding];
+    typename axi4_::BId wr_id[maxOutstanding];
+    Tag wr_rob[maxOutstanding];
+
+    Packet_t req;
+    bool req_valid = false;
+    // AW of req issued, W beats of it sent
+    bool aw_sent = false;
+    NVUINTW(nvhls::index_width<maxBeats>::val) beat = 0;
+
+    Packet_t r_packet;
+    bool r_packet_valid = false;
+    Packet_t b_packet;
+    bool b_packet_valid = false;
+    bool b_first = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      // Responses, back to the node of the request with the original ID
+      if (!r_packet_valid) {
+        typename axi4_::ReadPayload r;
+        if (axi_read.r.PopNB(r)) {
+          unsigned t = r.id.to_uint();
+          NVHLS_ASSERT_MSG(rd_busy[t] == 1, "Read response with an unknown ID");
+          r.id = rd_id[t];
+          r_packet = Format::header(Format::R, 0, 0, rd_src[t], respVC);
+          Format::set(r_packet, r, 0);
+          r_packet_valid = true;
+          if (r.last == 1) {
+            rd_busy[t] = 0;
+          }
+        }
+      }
+      if (!b_packet_valid) {
+        typename axi4_::WRespPayload b;
+        if (axi_write.b.PopNB(b)) {
+          unsigned t = b.id.to_uint();
+          NVHLS_ASSERT_MSG(wr_busy[t] == 1, "Write response with an unknown ID");
+          b.id = wr_id[t];
+          b_packet = Format::header(Format::B, 0, wr_rob[t], wr_src[t], respVC);
+          Format::set(b_packet, b, 0);
+          b_packet_valid = true;
+          wr_busy[t] = 0;
+        }
+      }
+      if (r_packet_valid || b_packet_valid) {
+        bool send_b = b_packet_valid && (!r_packet_valid || b_first);
+        if (out_packet.PushNB(send_b ? b_packet : r_packet)) {
+          if (send_b) {
+            b_packet_valid = false;
+          } else {
+            r_packet_valid = false;
+          }
+          b_first = !send_b;
+        }
+      }
+
+      // Requests, one at a time
+      if (!req_valid) {
+        req_valid = in_packet.PopNB(req);
+        aw_sent = false;
+        beat = 0;
+      }
+      if (req_valid && Format::kind(req) == Format::AR) {
+        NVUINTW(tag_width) t;
+        if (free_tag(rd_busy, t)) {
+          typename axi4_::AddrPayload ar = Format::template get<typename axi4_::AddrPayload>(req, 0);
+          typename axi4_::Id id = ar.id;
+          ar.id = t;
+          if (axi_read.ar.PushNB(ar)) {
+            rd_busy[t] = 1;
+            rd_src[t] = Format::src(req);
+            rd_id[t] = id;
+            req_valid = false;
+          }
+        }
+      } else if (req_valid) {
+        NVHLS_ASSERT_MSG(Format::kind(req) == Format::AW, "Response packet at a subordinate");
+        if (!aw_sent) {
+          NVUINTW(tag_width) t;
+          if (free_tag(wr_busy, t)) {
+            typename axi4_::AddrPayload aw = Format::template get<typename axi4_::AddrPayload>(req, 0);
+            typename axi4_::Id id = aw.id;
+            aw.id = t;
+            if (axi_write.aw.PushNB(aw)) {
+              wr_busy[t] = 1;
+              wr_src[t] = Format::src(req);
+              wr_id[t] = id;
+              wr_rob[t] = Format::tag(req);
+              aw_sent = true;
+            }
+          }
+        } else {
+          typename axi4_::WritePayload w =
+              Format::template get<typename axi4_::WritePayload>(req, Format::beat_offset(beat));
+          if (axi_write.w.PushNB(w)) {
+            beat++;
+            if (w.last == 1) {
+              req_valid = false;
+            }
+          }
+        }
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXI_PERF_MONITOR_H__
+#define __AXI_PERF_MONITOR_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <nvhls_module.h>
+#include <axi/axi4.h>
+#include <fifo.h>
+#include <mem_array.h>
+
+/**
+ * \brief An in-line AXI performance monitor with bandwidth counters and latency histograms.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg               A valid AXI config for the monitored link.
+ * \tparam numBins              The number of bins in each latency histogram (default: 16).
+ * \tparam maxOutstandingPerId  The number of requests per AXI ID whose issue time can be held (default: 4).
+ * \tparam liteCfg              The AXI config of the register port (default: axi::cfg::lite).
+ *
+ * \par Overview
+ * AxiPerfMonitor is placed on an AXI link, between manager and subordinate,
+ * and forwards all five channels with one register stage each, at one beat
+ * per channel per cycle.  A Connections channel cannot be observed without
+ * taking part in its handshake, so the monitor counts each transfer as it
+ * forwards it; latencies are therefore as seen at the monitor.
+ * - Bandwidth: read and write beats and bytes are counted over windows of
+ *   WINDOW cycles.  The counts of the last complete window are readable;
+ *   with WINDOW 0 the counts run freely.  Write bytes are the set write
+ *   strobes, read bytes are full beats.
+ * - Latency: the issue time of each AR and AW is queued per AXI ID, and
+ *   taken at the first R beat of the burst and at the B response with the
+ *   same ID.  AR-to-first-R and AW-to-B latencies are accumulated as a
+ *   count, sum and maximum, and binned into one histogram each.  Bin i holds
+ *   the latencies from i << BIN_SHIFT to ((i + 1) << BIN_SHIFT) - 1, and the
+ *   last bin also all longer ones.  The histograms are kept in a
+ *   mem_array_sep with one bank per direction.  If maxOutstandingPerId
+ *   requests of one ID are already in flight, further requests with that ID
+ *   wait.
+ * - Registers: the liteCfg port maps one 32-bit word per register, from
+ *   address 0.  Writing bit 0 of CTRL clears all statistics, which takes
+ *   numBins cycles; bit 1 of CTRL reads 1 until it is done.  Other addresses
+ *   return SLVERR.
+ *   | Word | Name | Access |
+ *   | ---- | ---- | ------ |
+ *   | 0 | CTRL | RW |
+ *   | 1 | WINDOW | RW |
+ *   | 2 | BIN_SHIFT | RW |
+ *   | 3 | NUM_BINS | RO |
+ *   | 4-7 | RD_BYTES, WR_BYTES, RD_BEATS, WR_BEATS | RO |
+ *   | 8-10 | RD_LAT_COUNT, RD_LAT_SUM, RD_LAT_MAX | RO |
+ *   | 11-13 | WR_LAT_COUNT, WR_LAT_SUM, WR_LAT_MAX | RO |
+ *   | 16 + i | RD_HIST[i] | RO |
+ *   | 16 + numBins + i | WR_HIST[i] | RO |
+ * - In C simulation the beats, bytes and histogram bins are also counted as
+ *   match::Module stats.
+ *
+ * \par Usage Guidelines
+ *
+ * This module sets the stall mode to flush by default to mitigate possible RTL
+ * bugs that can occur in the default stall mode. If you are confident that
+ * this class of bugs will not occur in your use case, you can change the stall
+ * mode via TCL directive:
+ *
+ * \code
+ * directive set /path/to/AxiPerfMonitor/run/while -PIPELINE_STALL_MODE stall
+ * \endcode
+ *
+ * This may reduce area/power.
+ * \par
+ *
+ */
+template <typename axiCfg, int numBins = 16, int maxOutstandingPerId = 4,
+          typename liteCfg = axi::cfg::lite>
+class AxiPerfMonitor : public match::Module {
+ public:
+  static const int kDebugLevel = 5;
+  typedef typename axi::axi4<axiCfg> axi4_;
+  typedef typename axi::axi4<liteCfg> lite_;
+
+  static const int counterWidth = lite_::DATA_WIDTH;
+  static const int bytesPerBeat = axi4_::DATA_WIDTH >> 3;
+  static const int numIds = 1 << axi4_::ID_WIDTH;
+  static const int idIdxWidth = (axi4_::ID_WIDTH > 0 ? axi4_::ID_WIDTH : 1);
+  static const int kNumByteEnables = (axi4_::WSTRB_WIDTH > 0 ? axi4_::WSTRB_WIDTH : 1);
+  static const int numRegs = 16 + 2 * numBins;
+  static const int regIdxWidth = nvhls::index_width<numRegs>::val;
+
+  static_assert(numBins >= 2, "numBins must be at least 2");
+  static_assert(counterWidth == 32, "The register port must be 32 bits wide");
+
+  enum {
+    kCtrl = 0,
+    kWindow,
+    kBinShift,
+    kNumBins,
+    kRdBytes,
+    kWrBytes,
+    kRdBeats,
+    kWrBeats,
+    kRdLatCount,
+    kRdLatSum,
+    kRdLatMax,
+    kWrLatCount,
+    kWrLatSum,
+    kWrLatMax,
+    kHist = 16,
+  };
+
+  typedef NVUINTW(counterWidth) Count;
+  typedef NVUINTW(idIdxWidth) IdIdx;
+  typedef NVUINTW(nvhls::index_width<numBins>::val) BinIdx;
+  typedef mem_array_sep<Count, 2 * numBins, 2> HistArray;
+
+  typename axi4_::read::template subordinate<> axiM_read;
+  typename axi4_::write::template subordinate<> axiM_write;
+  typename axi4_::read::template manager<> axiS_read;
+  typename axi4_::write::template manager<> axiS_write;
+
+  typename lite_::read::template subordinate<> if_ctrl_rd;
+  typename lite_::write::template subordinate<> if_ctrl_wr;
+
+ protected:
+  // Bank 0 holds the read histogram, bank 1 the write histogram
+  HistArray hist;
+  FIFO<Count, maxOutstandingPerId, numIds> rd_issue;
+  FIFO<Count, maxOutstandingPerId, numIds> wr_issue;
+
+  match::StatHandle rd_beats_stat;
+  match::StatHandle wr_beats_stat;
+  match::StatHandle rd_bytes_stat;
+  match::StatHandle wr_bytes_stat;
+  match::StatHandle rd_hist_stat;
+  match::StatHandle wr_hist_stat;
+
+ public:
+  SC_HAS_PROCESS(AxiPerfMonitor);
+  AxiPerfMonitor(sc_module_name name_)
+      : match::Module(name_),
+        axiM_read("axiM_read"),
+        axiM_write("axiM_write"),
+        axiS_read("axiS_read"),
+        axiS_write("axiS_write"),
+        if_ctrl_rd("if_ctrl_rd"),
+        if_ctrl_wr("if_ctrl_wr") {
+    rd_beats_stat = this->RegisterStat("read_beats");
+    wr_beats_stat = this->RegisterStat("write_beats");
+    rd_bytes_stat = this->RegisterStat("read_bytes");
+    wr_bytes_stat = this->RegisterStat("write_bytes");
+    rd_hist_stat = this->RegisterStatIndexed("read_latency_bin", numBins);
+    wr_hist_stat = this->RegisterStatIndexed("write_latency_bin", numBins);
+
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+ protected:
+  static BinIdx bin_of(Count latency, Count bin_shift) {
+    Count binned = latency >> bin_shift;
+    if (binned >= numBins - 1) {
+      return numBins - 1;
+    }
+    return binned;
+  }
+
+  static Count strobe_bytes(typename axi4_::WritePayload &w) {
+    if (axi4_::WSTRB_WIDTH == 0) {
+      return bytesPerBeat;
+    }
+    Count bytes = 0;
+    #pragma hls_unroll yes
+    for (int i = 0; i < kNumByteEnables; i++) {
+      if (w.wstrb[i] == 1) {
+        bytes++;
+      }
+    }
+    return bytes;
+  }
+
+  void run() {
+    axiM_read.reset();
+    axiM_write.reset();
+    axiS_read.reset();
+    axiS_write.reset();
+    if_ctrl_rd.reset();
+    if_ctrl_wr.reset();
+    rd_issue.reset();
+    wr_issue.reset();
+
+    typename axi4_::AddrPayload ar_reg, aw_reg;
+    typename axi4_::ReadPayload r_reg;
+    typename axi4_::WritePayload w_reg;
+    typename axi4_::WRespPayload b_reg;
+    bool ar_valid = false, r_valid = false, aw_valid = false, w_valid = false, b_valid = false;
+    // R bursts in progress, per ID
+    NVUINTW(numIds) r_in_burst = 0;
+
+    typename lite_::AddrPayload ctrl_ar, ctrl_aw;
+    typename lite_::WritePayload ctrl_w;
+    typename lite_::ReadPayload ctrl_r;
+    typename lite_::WRespPayload ctrl_b;
+    bool ctrl_r_valid = false, ctrl_b_valid = false;
+
+    Count window = 0, bin_shift = 0;
+    Count now = 0, window_count = 0;
+    Count rd_bytes = 0, wr_bytes = 0, rd_beats = 0, wr_beats = 0;
+    Count last_rd_bytes = 0, last_wr_bytes = 0, last_rd_beats = 0, last_wr_beats = 0;
+    Count rd_lat_count = 0, rd_lat_sum = 0, rd_lat_max = 0;
+    Count wr_lat_count = 0, wr_lat_sum = 0, wr_lat_max = 0;
+
+    // Statistics are cleared one histogram bin per cycle, starting at reset
+    bool clearing = true;
+    BinIdx clear_bin = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+      now++;
+
+      bool rd_done = false, wr_done = false;
+      Count rd_latency = 0, wr_latency = 0;
+
+      // Requests
+      if (ar_valid) {
+        IdIdx id = ar_reg.id.to_uint64();
+        if (!rd_issue.isFull(id) && axiS_read.ar.PushNB(ar_reg)) {
+          rd_issue.push(now, id);
+          ar_valid = false;
+        }
+      }
+      if (!ar_valid) {
+        ar_valid = axiM_read.ar.PopNB(ar_reg);
+      }
+
+      if (aw_valid) {
+        IdIdx id = aw_reg.id.to_uint64();
+        bool tracked = (axiCfg::useWriteResponses != 0);
+        if ((!tracked || !wr_issue.isFull(id)) && axiS_write.aw.PushNB(aw_reg)) {
+          if (tracked) {
+            wr_issue.push(now, id);
+          }
+          aw_valid = false;
+        }
+      }
+      if (!aw_valid) {
+        aw_valid = axiM_write.aw.PopNB(aw_reg);
+      }
+
+      // Data
+      if (w_valid) {
+        if (axiS_write.w.PushNB(w_reg)) {
+          Count bytes = strobe_bytes(w_reg);
+          wr_beats++;
+          wr_bytes += bytes;
+          this->IncrStat(wr_beats_stat);
+          this->IncrStat(wr_bytes_stat, bytes);
+          w_valid = false;
+        }
+      }
+      if (!w_valid) {
+        w_valid = axiM_write.w.PopNB(w_reg);
+      }
+
+      // Responses
+      if (r_valid) {
+        if (axiM_read.r.PushNB(r_reg)) {
+          IdIdx id = r_reg.id.to_uint64();
+          bool last = (axi4_::LAST_WIDTH == 0 || r_reg.last.to_uint64() == 1);
+          if (r_in_burst[id] == 0 && !rd_issue.isEmpty(id)) {
+            rd_latency = now - rd_issue.pop(id);
+            rd_done = true;
+          }
+          r_in_burst[id] = !last;
+          rd_beats++;
+          rd_bytes += bytesPerBeat;
+          this->IncrStat(rd_beats_stat);
+          this->IncrStat(rd_bytes_stat, bytesPerBeat);
+          r_valid = false;
+        }
+      }
+      if (!r_valid) {
+        r_valid = axiS_read.r.PopNB(r_reg);
+      }
+
+      if (b_valid) {
+        if (axiM_write.b.PushNB(b_reg)) {
+          IdIdx id = b_reg.id.to_uint64();
+          if (!wr_issue.isEmpty(id)) {
+            wr_latency = now - wr_issue.pop(id);
+            wr_done = true;
+          }
+          b_valid = false;
+        }
+      }
+      if (!b_valid) {
+        b_valid = axiS_write.b.PopNB(b_reg);
+      }
+
+      // Latency statistics
+      if (clearing) {
+        hist.write(clear_bin, 0, 0);
+        hist.write(clear_bin, 1, 0);
+        if (clear_bin == numBins - 1) {
+          clearing = false;
+          clear_bin = 0;
+        } else {
+          clear_bin++;
+        }
+        rd_bytes = 0;
+        wr_bytes = 0;
+        rd_beats = 0;
+        wr_beats = 0;
+        window_count = 0;
+        rd_lat_count = 0;
+        rd_lat_sum = 0;
+        rd_lat_max = 0;
+        wr_lat_count = 0;
+        wr_lat_sum = 0;
+        wr_lat_max = 0;
+      } else {
+        if (rd_done) {
+          BinIdx bin = bin_of(rd_latency, bin_shift);
+          hist.write(bin, 0, hist.read(bin, 0) + 1);
+          rd_lat_count++;
+          rd_lat_sum += rd_latency;
+          if (rd_latency > rd_lat_max) {
+            rd_lat_max = rd_latency;
+          }
+          this->IncrStatIndexed(rd_hist_stat, bin);
+        }
+        if (wr_done) {
+          BinIdx bin = bin_of(wr_latency, bin_shift);
+          hist.write(bin, 1, hist.read(bin, 1) + 1);
+          wr_lat_count++;
+          wr_lat_sum += wr_latency;
+          if (wr_latency > wr_lat_max) {
+            wr_lat_max = wr_latency;
+          }
+          this->IncrStatIndexed(wr_hist_stat, bin);
+        }
+      }
+
+      // Bandwidth windows
+      if (window == 0) {
+        last_rd_bytes = rd_bytes;
+        last_wr_bytes = wr_bytes;
+        last_rd_beats = rd_beats;
+        last_wr_beats = wr_beats;
+      } else if (++window_count >= window) {
+        last_rd_bytes = rd_bytes;
+        last_wr_bytes = wr_bytes;
+        last_rd_beats = rd_beats;
+        last_wr_beats = wr_beats;
+        rd_bytes = 0;
+        wr_bytes = 0;
+        rd_beats = 0;
+        wr_beats = 0;
+        window_count = 0;
+      }
+
+      // Register reads; histogram bins read 0 while they are cleared
+      if (ctrl_r_valid) {
+        ctrl_r_valid = !if_ctrl_rd.nb_rwrite(ctrl_r);
+      }
+      if (!ctrl_r_valid && if_ctrl_rd.nb_aread(ctrl_ar)) {
+        NVUINTW(regIdxWidth) idx = nvhls::get_slc<regIdxWidth>(ctrl_ar.addr, 2);
+        bool in_range = (ctrl_ar.addr >> 2) < numRegs;
+        Count data = 0;
+        if (!in_range) {
+          data = 0;
+        } else if (idx >= kHist) {
+          if (clearing) {
+            data = 0;
+          } else if (idx < kHist + numBins) {
+            data = hist.read(idx - kHist, 0);
+          } else {
+            data = hist.read(idx - kHist - numBins, 1);
+          }
+        } else if (idx == kCtrl) {
+          data = clearing ? 2 : 0;
+        } else if (idx == kWindow) {
+          data = window;
+        } else if (idx == kBinShift) {
+          data = bin_shift;
+        } else if (idx == kNumBins) {
+          data = numBins;
+        } else if (idx == kRdBytes) {
+          data = last_rd_bytes;
+        } else if (idx == kWrBytes) {
+          data = last_wr_bytes;
+        } else if (idx == kRdBeats) {
+          data = last_rd_beats;
+        } else if (idx == kWrBeats) {
+          data = last_wr_beats;
+        } else if (idx == kRdLatCount) {
+          data = rd_lat_count;
+        } else if (idx == kRdLatSum) {
+          data = rd_lat_sum;
+        } else if (idx == kRdLatMax) {
+          data = rd_lat_max;
+        } else if (idx == kWrLatCount) {
+          data = wr_lat_count;
+        } else if (idx == kWrLatSum) {
+          data = wr_lat_sum;
+        } else if (idx == kWrLatMax) {
+          data = wr_lat_max;
+        }
+        ctrl_r.id = ctrl_ar.id;
+        ctrl_r.data = data;
+        ctrl_r.resp = in_range ? lite_::Enc::XRESP::OKAY : lite_::Enc::XRESP::SLVERR;
+        ctrl_r.last = 1;
+        ctrl_r_valid = !if_ctrl_rd.nb_rwrite(ctrl_r);
+      }
+
+      // Register writes
+      if (ctrl_b_valid) {
+        ctrl_b_valid = !if_ctrl_wr.nb_bwrite(ctrl_b);
+      }
+      if (!ctrl_b_valid && if_ctrl_wr.nb_wread(ctrl_aw, ctrl_w)) {
+        NVUINTW(regIdxWidth) idx = nvhls::get_slc<regIdxWidth>(ctrl_aw.addr, 2);
+        bool writable = (ctrl_aw.addr >> 2) <= kBinShift;
+        if (writable && idx == kCtrl && ctrl_w.data[0] == 1) {
+          clearing = true;
+          clear_bin = 0;
+        } else if (writable && idx == kWindow) {
+          window = ctrl_w.data;
+          window_count = 0;
+        } else if (writable && idx == kBinShift) {
+          bin_shift = ctrl_w.data;
+        }
+        CDCOUT(sc_time_stamp() << " " << name() << " Register write:"
+                      << " reg=" << idx
+                      << " data=" << hex << ctrl_w.data
+                      << endl, kDebugLevel);
+        ctrl_b.id = ctrl_aw.id;
+        ctrl_b.resp = writable ? lite_::Enc::XRESP::OKAY : lite_::Enc::XRESP::SLVERR;
+        ctrl_b_valid = !if_ctrl_wr.nb_bwrite(ctrl_b);
+      }
+    }
+  }
+};
+
+#endif
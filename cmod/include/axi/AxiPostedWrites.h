@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __AXI_POSTED_WRITES_H__
+#define __AXI_POSTED_WRITES_H__
+
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <comptrees.h>
+#include <axi/axi4.h>
+
+namespace axi {
+
+/**
+ * \brief Address ranges of the writes that are posted but not yet complete.
+ * \ingroup AXI
+ *
+ * \tparam Cfg          A valid AXI config.
+ * \tparam Entries      Most writes tracked at once.
+ *
+ * \par Overview
+ * A small CAM of the byte range of every tracked write burst: insert() adds
+ * the range of an AW, retire() removes the oldest entry of an ID, as write
+ * responses of one ID complete in order, and retire_oldest() the oldest entry
+ * of all. conflict() compares the range of an AR against every entry in
+ * parallel, so a read can be held back until the writes it overlaps are
+ * done. Burst ranges follow the AXI INCR, FIXED and WRAP rules, using the
+ * whole bus width when the config has no AxSIZE.
+ *
+ */
+template <typename Cfg, int Entries>
+class PostedWrites {
+ public:
+  typedef typename axi::axi4<Cfg> axi4_;
+  typedef typename axi4_::Addr Addr;
+  typedef typename axi4_::AddrPayload AddrPayload;
+  static const int idWidth = (axi4_::ID_WIDTH > 0) ? axi4_::ID_WIDTH : 1;
+  static const int log2BytesPerBeat = nvhls::log2_ceil<(Cfg::dataWidth >> 3)>::val;
+  typedef NVUINTW(idWidth) Id;
+  typedef NVUINTW(Entries) Mask;
+  typedef NVUINTW(nvhls::index_width<Entries>::val) Index;
+
+  PostedWrites() { reset(); }
+
+  void reset() { valid = 0; }
+
+  bool full() const { return valid == static_cast<Mask>(~Mask(0)); }
+  bool empty() const { return valid == 0; }
+
+  void insert(AddrPayload aw) {
+    NVHLS_ASSERT_MSG(!full(), "No free posted-write entry");
+    Mask free = ~valid;
+    Index idx = PriEnc<Mask, bool, Index, Entries>::val(free, 1);
+    #pragma hls_unroll yes
+    for (int i = 0; i < Entries; i++) {
+      if (valid[i] == 1) age[i] = age[i] + 1;
+    }
+    age[idx] = 0;
+    valid[idx] = 1;
+    ids[idx] = aw.id.to_uint64();
+    range(aw, lo[idx], hi[idx]);
+  }
+
+  // The oldest entry of id completed
+  void retire(Id id) {
+    Mask hits = 0;
+    #pragma hls_unroll yes
+    for (int i = 0; i < Entries; i++) {
+      hits[i] = (valid[i] == 1) && (ids[i] == id);
+    }
+    retire_oldest(hits);
+  }
+
+  // The oldest entry of all completed
+  void retire_oldest() { retire_oldest(valid); }
+
+  // Some tracked write overlaps the bytes of ar
+  bool conflict(AddrPayload ar) const {
+    Addr ar_lo, ar_hi;
+    range(ar, ar_lo, ar_hi);
+    bool hit = false;
+    #pragma hls_unroll yes
+    for (int i = 0; i < Entries; i++) {
+      hit |= (valid[i] == 1) && (ar_lo <= hi[i]) && (lo[i] <= ar_hi);
+    }
+    return hit;
+  }
+
+  // First and last byte of a burst
+  static void range(AddrPayload pld, Addr& first, Addr& last) {
+    unsigned size = (axi4_::ASIZE_WIDTH > 0) ? static_cast<unsigned>(pld.size.to_uint64())
+                                              : static_cast<unsigned>(log2BytesPerBeat);
+    Addr beats = (axi4_::ALEN_WIDTH > 0) ? static_cast<Addr>(pld.len.to_uint64() + 1) : Addr(1);
+    Addr aligned = (pld.addr >> size) << size;
+    Addr bytes = beats << size;
+    unsigned burst = (axi4_::BURST_WIDTH > 0) ? static_cast<unsigned>(pld.burst.to_uint64())
+                                               : static_cast<unsigned>(axi4_::Enc::AXBURST::INCR);
+    if (burst == axi4_::Enc::AXBURST::FIXED) {
+      first = aligned;
+      last = aligned + (Addr(1) << size) - 1;
+    } else if (burst == axi4_::Enc::AXBURST::WRAP) {
+      // bytes is a power of two for wrapping bursts
+      first = (pld.addr / bytes) * bytes;
+      last = first + bytes - 1;
+    } else {
+      first = pld.addr;
+      last = aligned + bytes - 1;
+    }
+  }
+
+ protected:
+  Mask valid;
+  Index age[Entries];
+  Id ids[Entries];
+  Addr lo[Entries];
+  Addr hi[Entries];
+
+  void retire_oldest(Mask hits) {
+    NVHLS_ASSERT_MSG(hits != 0, "Write response without a posted write");
+    Index oldest = 0;
+    Index oldest_age = 0;
+    bool found = false;
+    #pragma hls_unroll yes
+    for (int i = 0; i < Entries; i++) {
+      if (hits[i] == 1 && (!found || age[i] > oldest_age)) {
+        oldest = i;
+        oldest_age = age[i];
+        found = true;
+      }
+    }
+    // Keep age the number of younger entries
+    #pragma hls_unroll yes
+    for (int i = 0; i < Entries; i++) {
+      if (valid[i] == 1 && age[i] > oldest_age) age[i] = age[i] - 1;
+    }
+    valid[oldest] = 0;
+  }
+};
+
+}  // namespace axi
+
+#endif
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXI_QOS_REGULATOR_H__
+#define __AXI_QOS_REGULATOR_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <axi/axi4.h>
+
+/**
+ * \brief Shapes the requests of one AXI manager with a token bucket and an outstanding-transaction cap, and sets their AxQOS.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg           A valid AXI config.
+ * \tparam maxOutstanding   The largest number of read and write transactions that can be in flight at once (default: 16).
+ * \tparam cfgWidth         The bitwidth of the configuration inputs, to match the registers that drive them (default: 32).
+ *
+ * \par Overview
+ * AxiQosRegulator sits between an AXI manager and the rest of the system,
+ * typically in front of one manager port of an AxiArbiter.  Read and write
+ * requests share one budget:
+ * - Token bucket: every cycle \p rate is added to a token count, which is
+ *   capped at \p bucket beats.  \p rate is in 1/256 beats per cycle, so
+ *   256 allows one beat per cycle.  A request is sent only while the count is
+ *   not negative, and then takes its burst length in beats from it.  The
+ *   count can go negative, so a burst longer than the bucket is delayed rather
+ *   than blocked, and over time the manager gets no more than \p rate.  With
+ *   \p rate 0 the bucket is disabled.
+ * - Outstanding cap: a request is sent only while fewer than
+ *   \p max_outstanding transactions are in flight.  A read completes with its
+ *   last R beat and a write with its B response.  With \p max_outstanding 0,
+ *   or above maxOutstanding, the cap is maxOutstanding.
+ * - AxQOS: if bit 4 of \p qos is set and axiCfg has useQoS, AxQOS of every
+ *   request is replaced by bits 3:0.  An AxiArbiter with qosPriority then
+ *   prioritizes the regulated manager accordingly.
+ * - Write data and responses are not shaped.  Reads and writes are sent in
+ *   turn when both are pending and only one can be.
+ *
+ * All configuration inputs read 0 out of reset, which leaves the manager
+ * unregulated apart from maxOutstanding, so they can be driven straight from
+ * the regOut of an AxiSubordinateToReg on an AXI-Lite configuration port.
+ *
+ * \par Usage Guidelines
+ *
+ * This module sets the stall mode to flush by default to mitigate possible RTL
+ * bugs that can occur in the default stall mode. If you are confident that
+ * this class of bugs will not occur in your use case, you can change the stall
+ * mode via TCL directive:
+ *
+ * \code
+ * directive set /path/to/AxiQosRegulator/run/while -PIPELINE_STALL_MODE stall
+ * \endcode
+ *
+ * This may reduce area/power.
+ * \par
+ *
+ */
+template <typename axiCfg, int maxOutstanding = 16, int cfgWidth = 32>
+class AxiQosRegulator : public sc_module {
+ public:
+  static const int kDebugLevel = 5;
+  typedef typename axi::axi4<axiCfg> axi4_;
+
+  static const int rateFracBits = 8;
+  static const int rateWidth = 16;
+  static const int bucketWidth = 16;
+  static_assert(cfgWidth >= rateWidth && cfgWidth >= bucketWidth,
+                "cfgWidth is too narrow for the rate and bucket inputs");
+  static_assert(maxOutstanding >= 1, "maxOutstanding must be at least 1");
+
+  typedef NVUINTW(cfgWidth) Cfg;
+  // Tokens in 1/256 beats; two maximal bursts below zero must fit as well
+  typedef NVINTW(bucketWidth + rateFracBits + 2) Tokens;
+  typedef NVUINTW(nvhls::index_width<maxOutstanding + 1>::val) Outstanding;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  sc_in<Cfg> rate;
+  sc_in<Cfg> bucket;
+  sc_in<Cfg> max_outstanding;
+  sc_in<Cfg> qos;
+
+  typename axi4_::read::template subordinate<> axiM_read;
+  typename axi4_::write::template subordinate<> axiM_write;
+  typename axi4_::read::template manager<> axiS_read;
+  typename axi4_::write::template manager<> axiS_write;
+
+  SC_HAS_PROCESS(AxiQosRegulator);
+
+  AxiQosRegulator(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        rate("rate"),
+        bucket("bucket"),
+        max_outstanding("max_outstanding"),
+        qos("qos"),
+        axiM_read("axiM_read"),
+        axiM_write("axiM_write"),
+        axiS_read("axiS_read"),
+        axiS_write("axiS_write") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_w);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ private:
+  // Burst length in 1/256 beats
+  static Tokens cost(typename axi4_::AddrPayload &req) {
+    Tokens beats = req.len.to_uint64() + 1;
+    return beats << rateFracBits;
+  }
+
+  void set_qos(typename axi4_::AddrPayload &req, Cfg qos_cfg) {
+    if (axiCfg::useQoS != 0 && qos_cfg[4] == 1) {
+      req.qos = nvhls::get_slc<axi4_::Enc::AXQOS::_WIDTH>(qos_cfg, 0);
+    }
+  }
+
+  void run() {
+    axiM_read.ar.Reset();
+    axiM_read.r.Reset();
+    axiM_write.aw.Reset();
+    axiM_write.b.Reset();
+    axiS_read.ar.Reset();
+    axiS_read.r.Reset();
+    axiS_write.aw.Reset();
+    axiS_write.b.Reset();
+
+    typename axi4_::AddrPayload ar_reg, aw_reg;
+    typename axi4_::ReadPayload r_reg;
+    typename axi4_::WRespPayload b_reg;
+    bool ar_valid = false, aw_valid = false, r_valid = false, b_valid = false;
+    Tokens tokens = 0;
+    Outstanding outstanding = 0;
+    bool write_turn = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      NVUINTW(rateWidth) rate_cfg = nvhls::get_slc<rateWidth>(rate.read(), 0);
+      NVUINTW(bucketWidth) bucket_cfg = nvhls::get_slc<bucketWidth>(bucket.read(), 0);
+      Cfg limit_cfg = max_outstanding.read();
+      Cfg qos_cfg = qos.read();
+      bool shaping = (rate_cfg != 0);
+      Outstanding limit = maxOutstanding;
+      if (limit_cfg != 0 && limit_cfg < maxOutstanding) {
+        limit = limit_cfg;
+      }
+
+      // Refill the bucket
+      Tokens bucket_tokens = static_cast<Tokens>(bucket_cfg) << rateFracBits;
+      Tokens refilled = tokens + rate_cfg;
+      if (!shaping) {
+        tokens = 0;
+      } else if (refilled > bucket_tokens) {
+        tokens = bucket_tokens;
+      } else {
+        tokens = refilled;
+      }
+
+      // Responses retire transactions
+      if (r_valid) {
+        if (axiM_read.r.PushNB(r_reg)) {
+          r_valid = false;
+          if (axi4_::LAST_WIDTH == 0 || r_reg.last.to_uint64() == 1) {
+            outstanding--;
+          }
+        }
+      }
+      if (!r_valid) {
+        r_valid = axiS_read.r.PopNB(r_reg);
+      }
+
+      if (b_valid) {
+        if (axiM_write.b.PushNB(b_reg)) {
+          b_valid = false;
+          outstanding--;
+        }
+      }
+      if (!b_valid && axiCfg::useWriteResponses != 0) {
+        b_valid = axiS_write.b.PopNB(b_reg);
+      }
+
+      // Requests, if the bucket is not empty and below the cap.  A write
+      // only counts as outstanding if it gets a response.
+      if (!ar_valid) {
+        ar_valid = axiM_read.ar.PopNB(ar_reg);
+      }
+      if (!aw_valid) {
+        aw_valid = axiM_write.aw.PopNB(aw_reg);
+      }
+
+      bool budget = !shaping || tokens >= 0;
+      bool send_ar = ar_valid && budget && outstanding < limit;
+      bool send_aw = aw_valid && budget &&
+                     (axiCfg::useWriteResponses == 0 || outstanding < limit);
+      if (send_ar && send_aw && axiCfg::useWriteResponses != 0 &&
+          outstanding + 1 >= limit) {
+        send_ar = !write_turn;
+        send_aw = write_turn;
+        write_turn = !write_turn;
+      }
+
+      if (send_ar) {
+        set_qos(ar_reg, qos_cfg);
+        if (axiS_read.ar.PushNB(ar_reg)) {
+          CDCOUT(sc_time_stamp() << " " << name() << " Sent read request:"
+                        << " tokens=" << tokens
+                        << " outstanding=" << outstanding
+                        << " request=[" << ar_reg << "]"
+                        << endl, kDebugLevel);
+          ar_valid = false;
+          outstanding++;
+          if (shaping) {
+            tokens -= cost(ar_reg);
+          }
+        }
+      }
+      if (send_aw) {
+        set_qos(aw_reg, qos_cfg);
+        if (axiS_write.aw.PushNB(aw_reg)) {
+          CDCOUT(sc_time_stamp() << " " << name() << " Sent write request:"
+                        << " tokens=" << tokens
+                        << " outstanding=" << outstanding
+                        << " request=[" << aw_reg << "]"
+                        << endl, kDebugLevel);
+          aw_valid = false;
+          if (axiCfg::useWriteResponses != 0) {
+            outstanding++;
+          }
+          if (shaping) {
+            tokens -= cost(aw_reg);
+          }
+        }
+      }
+    }
+  }
+
+  void run_w() {
+    axiM_write.w.Reset();
+    axiS_write.w.Reset();
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+      typename axi4_::WritePayload w = axiM_write.w.Pop();
+      axiS_write.w.Push(w);
+    }
+  }
+};
+
+#endif
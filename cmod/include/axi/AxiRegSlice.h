@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __AXI_REG_SLICE_H__
+#define __AXI_REG_SLICE_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_connections_buffered_ports.h>
+#include <axi/axi4.h>
+
+namespace axi {
+namespace reg_slice {
+
+/** \brief AXI channels, as bits of the AxiRegSlice ChannelMask. */
+enum Channel {
+  AR = 1 << 0,
+  R = 1 << 1,
+  AW = 1 << 2,
+  W = 1 << 3,
+  B = 1 << 4,
+  ALL = AR | R | AW | W | B,
+};
+
+/**
+ * \brief Register stage inserted on each selected channel.
+ *
+ * - FORWARD registers valid and data (Connections::Pipeline).
+ * - REVERSE registers ready, in a two-entry skid buffer (Connections::BypassBuffered).
+ * - FULL registers both, with a forward stage followed by a reverse stage.
+ * - BYPASS wires the channel straight through.
+ */
+enum Mode { BYPASS, FORWARD, REVERSE, FULL };
+
+/**
+ * \brief A combinational pass-through with the same interface as the
+ * Connections buffers.
+ */
+template <typename Message, connections_port_t port_marshall_type = AUTO_PORT>
+class Wire : public sc_module {
+  SC_HAS_PROCESS(Wire);
+
+ public:
+  // Interface
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<Message, port_marshall_type> enq;
+  Connections::Out<Message, port_marshall_type> deq;
+
+  Wire(sc_module_name name) : sc_module(name), clk("clk"), rst("rst") {
+#ifdef CONNECTIONS_SIM_ONLY
+    enq.disable_spawn();
+    deq.disable_spawn();
+#endif
+
+    SC_METHOD(EnqRdy);
+    sensitive << deq.rdy;
+
+    SC_METHOD(DeqVld);
+    sensitive << enq.vld;
+
+    SC_METHOD(DeqMsg);
+    sensitive << enq.dat;
+  }
+
+ protected:
+  void EnqRdy() { enq.rdy.write(deq.rdy.read()); }
+  void DeqVld() { deq.vld.write(enq.vld.read()); }
+  void DeqMsg() { deq.dat.write(enq.dat.read()); }
+};
+
+// Because of ports not existing in TLM_PORT and the code depending on it,
+// we remap to DIRECT_PORT here.
+template <typename Message>
+class Wire<Message, TLM_PORT> : public Wire<Message, DIRECT_PORT> {
+ public:
+  Wire(sc_module_name name) : Wire<Message, DIRECT_PORT>(name) {}
+};
+
+/**
+ * \brief The register stage of one channel.
+ */
+template <typename Message, Mode mode>
+class Stage : public sc_module {
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<Message> enq;
+  Connections::Out<Message> deq;
+
+  Stage(sc_module_name name)
+      : sc_module(name), clk("clk"), rst("rst"), enq("enq"), deq("deq"), wire("wire") {
+    wire.clk(clk);
+    wire.rst(rst);
+    wire.enq(enq);
+    wire.deq(deq);
+  }
+
+ private:
+  Wire<Message> wire;
+};
+
+template <typename Message>
+class Stage<Message, FORWARD> : public sc_module {
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<Message> enq;
+  Connections::Out<Message> deq;
+
+  Stage(sc_module_name name)
+      : sc_module(name), clk("clk"), rst("rst"), enq("enq"), deq("deq"), pipe("pipe") {
+    pipe.clk(clk);
+    pipe.rst(rst);
+    pipe.enq(enq);
+    pipe.deq(deq);
+  }
+
+ private:
+  Connections::Pipeline<Message> pipe;
+};
+
+template <typename Message>
+class Stage<Message, REVERSE> : public sc_module {
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<Message> enq;
+  Connections::Out<Message> deq;
+
+  Stage(sc_module_name name)
+      : sc_module(name), clk("clk"), rst("rst"), enq("enq"), deq("deq"), skid("skid") {
+    skid.clk(clk);
+    skid.rst(rst);
+    skid.enq(enq);
+    skid.deq(deq);
+  }
+
+ private:
+  // Two entries keep one transfer per cycle with a registered ready
+  Connections::BypassBuffered<Message, 2> skid;
+};
+
+template <typename Message>
+class Stage<Message, FULL> : public sc_module {
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<Message> enq;
+  Connections::Out<Message> deq;
+
+  Stage(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        enq("enq"),
+        deq("deq"),
+        pipe("pipe"),
+        skid("skid"),
+        mid("mid") {
+    pipe.clk(clk);
+    pipe.rst(rst);
+    skid.clk(clk);
+    skid.rst(rst);
+    pipe.enq(enq);
+    pipe.deq(mid);
+    skid.enq(mid);
+    skid.deq(deq);
+  }
+
+ private:
+  Connections::Pipeline<Message> pipe;
+  Connections::BypassBuffered<Message, 2> skid;
+  Connections::Combinational<Message> mid;
+};
+
+}  // namespace reg_slice
+}  // namespace axi
+
+/**
+ * \brief A register slice for the channels of an AXI link.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg       A valid AXI config.
+ * \tparam ChannelMask  The channels to register, as an OR of axi::reg_slice::Channel bits (default: all).
+ * \tparam mode         The axi::reg_slice::Mode of the registered channels (default: FULL).
+ *
+ * \par Overview
+ * AxiRegSlice sits between an AXI manager and an AXI subordinate with the same
+ * config, and adds a register stage to each channel selected by ChannelMask.
+ * Channels that are not selected are wired straight through.
+ * - FORWARD cuts the valid and data paths with a Connections::Pipeline, adding
+ *   one cycle of latency.
+ * - REVERSE cuts the ready path with a two-entry Connections::BypassBuffered.
+ *   It adds no latency while the channel is not stalled.
+ * - FULL cuts both, with FORWARD followed by REVERSE.
+ * - BYPASS registers nothing.
+ * Every mode keeps one transfer per cycle. To use different modes on
+ * different channels, chain two slices with complementary masks.
+ *
+ * \par A Simple Example
+ * \code
+ *      // Register valid/data of the request channels, and ready of the rest
+ *      AxiRegSlice<axi::cfg::standard, axi::reg_slice::AR | axi::reg_slice::AW | axi::reg_slice::W,
+ *                  axi::reg_slice::FORWARD> req_slice;
+ *      AxiRegSlice<axi::cfg::standard, axi::reg_slice::R | axi::reg_slice::B,
+ *                  axi::reg_slice::REVERSE> resp_slice;
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg, int ChannelMask = axi::reg_slice::ALL,
+          axi::reg_slice::Mode mode = axi::reg_slice::FULL>
+class AxiRegSlice : public sc_module {
+ public:
+  typedef typename axi::axi4<axiCfg> axi4_;
+
+  static const axi::reg_slice::Mode arMode = (ChannelMask & axi::reg_slice::AR) ? mode : axi::reg_slice::BYPASS;
+  static const axi::reg_slice::Mode rMode = (ChannelMask & axi::reg_slice::R) ? mode : axi::reg_slice::BYPASS;
+  static const axi::reg_slice::Mode awMode = (ChannelMask & axi::reg_slice::AW) ? mode : axi::reg_slice::BYPASS;
+  static const axi::reg_slice::Mode wMode = (ChannelMask & axi::reg_slice::W) ? mode : axi::reg_slice::BYPASS;
+  static const axi::reg_slice::Mode bMode = (ChannelMask & axi::reg_slice::B) ? mode : axi::reg_slice::BYPASS;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axi4_::read::template subordinate<> axiM_read;
+  typename axi4_::write::template subordinate<> axiM_write;
+  typename axi4_::read::template manager<> axiS_read;
+  typename axi4_::write::template manager<> axiS_write;
+
+ private:
+  axi::reg_slice::Stage<typename axi4_::AddrPayload, arMode> ar_stage;
+  axi::reg_slice::Stage<typename axi4_::ReadPayload, rMode> r_stage;
+  axi::reg_slice::Stage<typename axi4_::AddrPayload, awMode> aw_stage;
+  axi::reg_slice::Stage<typename axi4_::WritePayload, wMode> w_stage;
+  axi::reg_slice::Stage<typename axi4_::WRespPayload, bMode> b_stage;
+
+ public:
+  AxiRegSlice(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axiM_read("axiM_read"),
+        axiM_write("axiM_write"),
+        axiS_read("axiS_read"),
+        axiS_write("axiS_write"),
+        ar_stage("ar_stage"),
+        r_stage("r_stage"),
+        aw_stage("aw_stage"),
+        w_stage("w_stage"),
+        b_stage("b_stage") {
+    ar_stage.clk(clk);
+    ar_stage.rst(reset_bar);
+    r_stage.clk(clk);
+    r_stage.rst(reset_bar);
+    aw_stage.clk(clk);
+    aw_stage.rst(reset_bar);
+    w_stage.clk(clk);
+    w_stage.rst(reset_bar);
+    b_stage.clk(clk);
+    b_stage.rst(reset_bar);
+
+    ar_stage.enq(axiM_read.ar);
+    ar_stage.deq(axiS_read.ar);
+    r_stage.enq(axiS_read.r);
+    r_stage.deq(axiM_read.r);
+    aw_stage.enq(axiM_write.aw);
+    aw_stage.deq(axiS_write.aw);
+    w_stage.enq(axiM_write.w);
+    w_stage.deq(axiS_write.w);
+    b_stage.enq(axiS_write.b);
+    b_stage.deq(axiM_write.b);
+  }
+};
+
+#endif
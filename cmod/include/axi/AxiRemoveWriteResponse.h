@@ -23,6 +23,7 @@
 #include <axi/axi4.h>
 #include <fifo.h>
 #include <TypeToBits.h>
+#include <axi/AxiPostedWrites.h>
 
 /**
  * \brief A simple shim that converts between two AXI configs by removing write responses.
@@ -30,11 +31,24 @@
  *
  * \tparam CfgManager                A valid AXI config describing the manager port, with write responses.
  * \tparam CfgSubordinate                 A valid AXI config describing the subordinate port, with no write responses.
+ * \tparam maxInFlight         Most writes whose data is not yet forwarded.
+ * \tparam orderReads          Hold reads that overlap a write until its data is forwarded (default: false).
  *
  * \par Overview
  * This block converts between an AXI manager that uses write responses and an AXI subordinate that does not use write responses.  Most signals are simply passed through from manager to subordinate.  When a write request is received from the manager, it is passed through to the subordinate, and a write response is also sent back to the manager.
  * - Apart from support for write responses, the two AXI configs must otherwise be the same.
  *
+ * \par Posted Writes
+ * The write response is returned as soon as the AW and the last W beat of a
+ * write are accepted, without a round trip to the subordinate, and at most
+ * maxInFlight writes can be waiting for their data.  The manager may then
+ * issue a read of the addresses it just wrote before the write data has left
+ * the shim.  With orderReads, the address ranges of those writes are kept in
+ * an axi::PostedWrites tracker, and an AR that overlaps one is held until the
+ * data of every write it overlaps is forwarded.  The subordinate is expected
+ * to keep the order of the requests it accepts.  In this mode AR is handled by
+ * the write thread, at its II of 2.
+ *
  * \par Usage Guidelines
  *
  * This module sets the stall mode to flush by default to mitigate possible RTL
@@ -50,7 +64,7 @@
  * \par
  *
  */
-template <typename CfgManager, typename CfgSubordinate, int maxInFlight>
+template <typename CfgManager, typename CfgSubordinate, int maxInFlight, bool orderReads = false>
 class AxiRemoveWriteResponse : public sc_module {
   static const int kDebugLevel = 6;
   SC_HAS_PROCESS(AxiRemoveWriteResponse);
@@ -85,6 +99,8 @@ class AxiRemoveWriteResponse : public sc_module {
   FIFO<typename axiM::BId, maxInFlight> wresp_id_q;
   FIFO<typename axiM::BId, maxInFlight> wresp_id_q_out;
 
+  axi::PostedWrites<CfgManager, maxInFlight> posted;
+
  public:
   // Constructor
   AxiRemoveWriteResponse(sc_module_name name)
@@ -102,9 +118,11 @@ class AxiRemoveWriteResponse : public sc_module {
     dummyB.rst(rst);
     dummyB.in(axiS_write.b);
 
-    SC_THREAD(axi_read_ar);
-    sensitive << clk.pos();
-    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    if (!orderReads) {
+      SC_THREAD(axi_read_ar);
+      sensitive << clk.pos();
+      NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    }
 
     SC_THREAD(axi_read_r);
     sensitive << clk.pos();
@@ -150,6 +168,14 @@ class AxiRemoveWriteResponse : public sc_module {
     axiS_write.aw.Reset();
     wresp_id_q.reset();
     wresp_id_q_out.reset();
+    if (orderReads) {
+      axiM_read.ar.Reset();
+      axiS_read.ar.Reset();
+    }
+    posted.reset();
+
+    typename axiS::AddrPayload AR_out;
+    bool ar_held = false;
 
     bool wresp_id_q_full = 0;
     bool wresp_id_q_empty = 0;
@@ -170,13 +196,30 @@ class AxiRemoveWriteResponse : public sc_module {
         if (axiM_write.aw.PopNB(AW)) {
           axiS_write.aw.Push(BitsToType<typename axiS::AddrPayload>(TypeToBits(AW)));
           wresp_id_q.push(AW.id);
+          if (orderReads) posted.insert(AW);
         }
       }
 
       if (!wresp_id_q_empty && !wresp_id_q_out_full) {
         if (axiM_write.w.PopNB(W)) {
           axiS_write.w.Push(BitsToType<typename axiS::WritePayload>(TypeToBits(W)));
-          if (W.last == 1) wresp_id_q_out.push(wresp_id_q.pop());
+          if (W.last == 1) {
+            wresp_id_q_out.push(wresp_id_q.pop());
+            // W data follows the order of AW
+            if (orderReads) posted.retire_oldest();
+          }
+        }
+      }
+
+      if (orderReads) {
+        if (!ar_held) {
+          if (axiM_read.ar.PopNB(AR)) {
+            AR_out = BitsToType<typename axiS::AddrPayload>(TypeToBits(AR));
+            ar_held = true;
+          }
+        }
+        if (ar_held && !posted.conflict(AR)) {
+          ar_held = !axiS_read.ar.PushNB(AR_out);
         }
       }
 
@@ -23,6 +23,7 @@
 #include <nvhls_int.h>
 #include <nvhls_array.h>
 #include <axi/axi4.h>
+#include <fifo.h>
 #include "Arbiter.h"
 #include "TypeToBits.h"
 
@@ -35,11 +36,17 @@
  * \tparam numAddrBitsToInspect     The number of address bits to inspect when determining which subordinate to direct traffic to.  If this is less than the full address width, the routing determination will be made based on the number of address LSBs specified.  (Default: axiCfg::addrWidth)
  * \tparam default_output           If true, requests with addresses that do not fall in any of the specified address ranges will be directed to the highest-indexed subordinate port.  (Default: false)
  * \tparam translate_addr           If true, requests are re-addressed relative to the base address of the receiving subordinate when they are passed through the splitter.  (Default: false)
+ * \tparam maxReadsPerSubordinate   The number of read bursts that can be outstanding at each subordinate.  (Default: 1)
+ * \tparam maxOutstandingWrites     The number of write bursts that can be outstanding across all subordinates.  (Default: 4)
+ * \tparam boundWidth               The width of the addrBound inputs.  Bounds are truncated to numAddrBitsToInspect bits before they are compared.  (Default: numAddrBitsToInspect)
  *
  * \par Overview
  * AxiSplitter connects one or more AXI subordinates to a single AXI manager.  Requests from the manager are routed by address to the appropriate subordinate.
- * - The address ranges for each subordinate must be contiguous (except for the highest-indexed subordinate if default_output is true).  Address bounds for each subordinate are set by writing to a (numSubordinates x 2) array of sc_in.
- * - Only a single outstanding request to all subordinates is allowed; AxiSplitter blocks further requests until the response has been returned.
+ * - The address ranges for each subordinate must be contiguous (except for the highest-indexed subordinate if default_output is true).  Address bounds for each subordinate are set by writing to a (numSubordinates x 2) array of sc_in, holding the inclusive base and limit addresses.  Ranges need not be aligned or equally sized; if they overlap, the lowest-indexed subordinate wins.
+ * - The address is compared against every range in parallel, so decoding takes a single cycle regardless of numSubordinates.
+ * - The bounds can be changed at run time, for example by driving addrBound from the regOut outputs of an AxiSubordinateToReg with boundWidth set to the AXI data width (see AxiSplitterRangeTableTop in the unit tests).  They should only change while the splitter is idle.
+ * - Up to maxReadsPerSubordinate read bursts can be outstanding at each subordinate, so reads to different subordinates are pipelined.  Reads with the same ID are only sent to one subordinate at a time, which keeps their responses in order; a read whose ID is outstanding at another subordinate waits until those reads complete.  Read responses are forwarded one whole burst at a time, with subordinates arbitrated round-robin.
+ * - Up to maxOutstandingWrites write bursts can be outstanding.  Write requests are routed and sent as soon as they arrive, independently of write data; the subordinate of each accepted request is queued so that write data is streamed to the matching subordinates in request order, without gaps between bursts.  Write responses are returned in request order.
  * - As implemented, the splitter directs all writes from a burst to the destination indicated by the base address of the burst.  Guards against crossing address boundaries are not implemented.
  * - The AXI configs of all ports must be the same.
  *
@@ -58,7 +65,7 @@
  * \par
  *
  */
-template <typename axiCfg, int numSubordinates, int numAddrBitsToInspect = axiCfg::addrWidth, bool default_output = false, bool translate_addr = false>
+template <typename axiCfg, int numSubordinates, int numAddrBitsToInspect = axiCfg::addrWidth, bool default_output = false, bool translate_addr = false, int maxReadsPerSubordinate = 1, int maxOutstandingWrites = 4, int boundWidth = numAddrBitsToInspect>
 class AxiSplitter : public sc_module {
  public:
   static const int kDebugLevel = 5;
@@ -74,6 +81,12 @@ class AxiSplitter : public sc_module {
   typedef typename axi4_::write::template manager<>::BPort axi_wr_manager_b;
 
   static const unsigned int log_numSubordinates = nvhls::log2_ceil<numSubordinates>::val + 1;
+  static const int maxReads = numSubordinates * maxReadsPerSubordinate;
+
+  static_assert(maxReadsPerSubordinate >= 1, "maxReadsPerSubordinate must be at least 1");
+  static_assert(maxOutstandingWrites >= 1, "maxOutstandingWrites must be at least 1");
+
+  typedef NVUINTW(nvhls::index_width<maxReadsPerSubordinate + 1>::val) ReadCount;
 
   // [ben] Unfortunately HLS cannot handle an nv_array of the manager/subordinate wrapper classes.
   // It will work fine in C but die mysteriously in Catapult 10.1b when methods of the
@@ -86,8 +99,17 @@ class AxiSplitter : public sc_module {
   typename axi4_::read::template subordinate<> axi_rd_m;
   typename axi4_::write::template subordinate<> axi_wr_m;
 
-  sc_in<NVUINTW(numAddrBitsToInspect)> addrBound[numSubordinates][2];
+  sc_in<NVUINTW(boundWidth)> addrBound[numSubordinates][2];
 
+ private:
+  typedef NVUINTW(log_numSubordinates) route_t;
+  // Subordinates of accepted write requests, for the W and B channels
+  Connections::Combinational<route_t> w_route;
+  Connections::Combinational<route_t> b_route;
+  FIFO<route_t, maxOutstandingWrites> w_routeQ;
+  FIFO<route_t, maxOutstandingWrites> b_routeQ;
+
+ public:
   SC_HAS_PROCESS(AxiSplitter);
 
   AxiSplitter(sc_module_name name)
@@ -100,20 +122,54 @@ class AxiSplitter : public sc_module {
         axi_wr_s_w("axi_wr_s_w"),
         axi_wr_s_b("axi_wr_s_b"),
         axi_rd_m("axi_rd_m"),
-        axi_wr_m("axi_wr_m")
+        axi_wr_m("axi_wr_m"),
+        w_route("w_route"),
+        b_route("b_route")
     {
     
     SC_THREAD(run_r);
     sensitive << clk.pos();
     async_reset_signal_is(reset_bar, false);
     
+    SC_THREAD(run_aw);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
     SC_THREAD(run_w);
     sensitive << clk.pos();
     async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_b);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
   }
 
-  // As an optimization, responses with different IDs could be allowed
-  // through, since it is safe to return them out of order.
+  // Subordinate whose address range contains addr
+  NVUINTW(log_numSubordinates) route(const typename axi4_::Addr& full_addr) {
+    NVUINTW(numAddrBitsToInspect)
+        addr(static_cast<sc_uint<numAddrBitsToInspect> >(full_addr)); // Cast larger to smaller
+    // Compare against every range in parallel, then take the lowest-indexed hit
+    NVUINTW(numSubordinates) hit = 0;
+#pragma hls_unroll yes
+    for (int i=0; i<numSubordinates; i++) {
+      NVUINTW(numAddrBitsToInspect) base = addrBound[i][0].read();
+      NVUINTW(numAddrBitsToInspect) limit = addrBound[i][1].read();
+      if (addr >= base && addr <= limit) {
+        hit = hit | (1 << i);
+      }
+    }
+    NVUINTW(log_numSubordinates) pushedTo = numSubordinates;
+#pragma hls_unroll yes
+    for (int i=numSubordinates-1; i>=0; i--) {
+      if (nvhls::get_slc<1>(hit, i) == 1) {
+        pushedTo = i;
+      }
+    }
+    if (default_output && pushedTo == numSubordinates) {
+      pushedTo = numSubordinates-1;
+    }
+    return pushedTo;
+  }
 
   void run_r() {
 #pragma hls_unroll yes
@@ -125,126 +181,222 @@ class AxiSplitter : public sc_module {
     axi_rd_m.r.Reset();
 
     typename axi4_::AddrPayload AR_reg;
-    typename axi4_::ReadPayload R_reg;
-
-    bool read_inFlight = 0;
+    bool AR_valid = 0;
     NVUINTW(log_numSubordinates) pushedTo = numSubordinates;
-    
+
+    nvhls::nv_array<typename axi4_::ReadPayload, numSubordinates> R_reg;
+    NVUINTW(numSubordinates) R_valid = 0;
+    NVUINTW(numSubordinates) select_mask = 0;
+    Arbiter<numSubordinates> arb;
+    bool read_inProgress = 0;
+    NVUINTW(log_numSubordinates) pulledFrom = 0;
+
+    // Outstanding read bursts, one per valid entry
+    bool inFlight_valid[maxReads];
+    typename axi4_::Id inFlight_id[maxReads];
+    NVUINTW(log_numSubordinates) inFlight_sub[maxReads];
+    ReadCount inFlight_count[numSubordinates];
+
+#pragma hls_unroll yes
+    for (int i=0; i<maxReads; i++) {
+      inFlight_valid[i] = 0;
+    }
+#pragma hls_unroll yes
+    for (int i=0; i<numSubordinates; i++) {
+      inFlight_count[i] = 0;
+    }
+
       #pragma hls_pipeline_init_interval 1
       #pragma pipeline_stall_mode flush
     while (1) {
       wait();
 
-      switch (read_inFlight) {
-        case false:
-          if (axi_rd_m.ar.PopNB(AR_reg)) {
-            NVUINTW(numAddrBitsToInspect)
-                addr(static_cast<sc_uint<numAddrBitsToInspect> >(AR_reg.addr)); // Cast larger to smaller
-            pushedTo = numSubordinates;
-            // TODO - refactor this so it can be unrolled
-            for (int i=0; i<numSubordinates; i++) {
-              if (addr >= addrBound[i][0].read() && addr <= addrBound[i][1].read() && pushedTo == numSubordinates) {
-                pushedTo = i;
-              }
-            }
-            if (default_output && pushedTo == numSubordinates) {
-              pushedTo = numSubordinates-1;
+#pragma hls_unroll yes
+      for (int i=0; i<numSubordinates; i++) {
+        if (nvhls::get_slc<1>(R_valid, i) == 0) {
+          if (axi_rd_s_r[i].PopNB(R_reg[i])) {
+            R_valid = R_valid | (1 << i);
+          }
+        }
+      }
+
+      // Forward read responses a burst at a time
+      if (!read_inProgress) {
+        select_mask = arb.pick(R_valid);
+#pragma hls_unroll yes
+        for (int i=0; i<numSubordinates; i++) {
+          if (nvhls::get_slc<1>(select_mask, i) == 1) {
+            pulledFrom = i;
+            read_inProgress = 1;
+          }
+        }
+      }
+      if (read_inProgress && nvhls::get_slc<1>(R_valid, pulledFrom) == 1) {
+        typename axi4_::ReadPayload R = R_reg[pulledFrom];
+        axi_rd_m.r.Push(R);
+        R_valid = ~(~R_valid | (1 << pulledFrom));
+        if (R.last == 1) {
+          read_inProgress = 0;
+          bool freed = 0;
+#pragma hls_unroll yes
+          for (int i=0; i<maxReads; i++) {
+            if (!freed && inFlight_valid[i] && inFlight_sub[i] == pulledFrom &&
+                inFlight_id[i].to_uint64() == R.id.to_uint64()) {
+              inFlight_valid[i] = 0;
+              freed = 1;
             }
-            // If the address did not fall in any valid range, that's bad
-            NVHLS_ASSERT_MSG(pushedTo != numSubordinates, "Read address did not fall into any output address range, and default output is not set");
+          }
+          NVHLS_ASSERT_MSG(freed, "Read response does not match an outstanding read");
+          inFlight_count[pulledFrom]--;
+        }
+      }
 
-            if (translate_addr)
-              AR_reg.addr -= addrBound[pushedTo][0].read();
+      if (!AR_valid) {
+        if (axi_rd_m.ar.PopNB(AR_reg)) {
+          pushedTo = route(AR_reg.addr);
+          // If the address did not fall in any valid range, that's bad
+          NVHLS_ASSERT_MSG(pushedTo != numSubordinates, "Read address did not fall into any output address range, and default output is not set");
 
-            axi_rd_s_ar[pushedTo].Push(AR_reg);
-            read_inFlight = 1;
+          if (translate_addr)
+            AR_reg.addr -= NVUINTW(numAddrBitsToInspect)(addrBound[pushedTo][0].read());
+          AR_valid = 1;
+        }
+      }
+
+      if (AR_valid) {
+        // Reads with the same ID must not be outstanding at another subordinate
+        bool id_conflict = 0;
+        NVUINTW(nvhls::index_width<maxReads>::val) free_entry = 0;
+#pragma hls_unroll yes
+        for (int i=0; i<maxReads; i++) {
+          if (inFlight_valid[i] && inFlight_sub[i] != pushedTo &&
+              inFlight_id[i].to_uint64() == AR_reg.id.to_uint64()) {
+            id_conflict = 1;
           }
-          break;
-        case true:
-          if (axi_rd_s_r[pushedTo].PopNB(R_reg)) {
-            axi_rd_m.r.Push(R_reg);
-            if (R_reg.last == 1) read_inFlight = 0;
+          if (!inFlight_valid[i]) {
+            free_entry = i;
           }
-          break;
+        }
+        if (!id_conflict && inFlight_count[pushedTo] != maxReadsPerSubordinate) {
+          axi_rd_s_ar[pushedTo].Push(AR_reg);
+          inFlight_valid[free_entry] = 1;
+          inFlight_id[free_entry] = AR_reg.id;
+          inFlight_sub[free_entry] = pushedTo;
+          inFlight_count[pushedTo]++;
+          AR_valid = 0;
+        }
       }
     }
   }
 
-  void run_w() {
+  void run_aw() {
 #pragma hls_unroll yes
     for (int i=0; i<numSubordinates; i++) {
       axi_wr_s_aw[i].Reset();
-      axi_wr_s_w[i].Reset();
-      axi_wr_s_b[i].Reset();
     }
     axi_wr_m.aw.Reset();
-    axi_wr_m.w.Reset();
-    axi_wr_m.b.Reset();
+    w_route.ResetWrite();
+    b_route.ResetWrite();
 
     typename axi4_::AddrPayload AW_reg;
+    route_t pushedTo = numSubordinates;
+
+      #pragma hls_pipeline_init_interval 1
+      #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (axi_wr_m.aw.PopNB(AW_reg)) {
+        pushedTo = route(AW_reg.addr);
+        NVHLS_ASSERT_MSG(pushedTo != numSubordinates, "Write address did not fall into any output address range, and default output is not set");
+        if (translate_addr)
+          AW_reg.addr -= NVUINTW(numAddrBitsToInspect)(addrBound[pushedTo][0].read());
+
+        axi_wr_s_aw[pushedTo].Push(AW_reg);
+        w_route.Push(pushedTo);
+        if (axiCfg::useWriteResponses) {
+          b_route.Push(pushedTo);
+        }
+      }
+    }
+  }
+
+  void run_w() {
+#pragma hls_unroll yes
+    for (int i=0; i<numSubordinates; i++) {
+      axi_wr_s_w[i].Reset();
+    }
+    axi_wr_m.w.Reset();
+    w_route.ResetRead();
+    w_routeQ.reset();
+
     typename axi4_::WritePayload W_reg;
-    typename axi4_::WRespPayload B_reg;
-    
-    NVUINTW(log_numSubordinates) pushedTo = numSubordinates;
-    enum {
-      IDLE = 0,
-      WRITE_INFLIGHT = 1,
-      RESP_INFLIGHT = 2,
-    };
-    NVUINT2 s = IDLE;
-    
+    route_t route_reg;
+    route_t pushedTo = 0;
+    bool write_inProgress = 0;
+
       #pragma hls_pipeline_init_interval 1
       #pragma pipeline_stall_mode flush
     while (1) {
       wait();
 
-      switch (s) {
-        case IDLE:
-          if (axi_wr_m.aw.PopNB(AW_reg)) {
-            NVUINTW(numAddrBitsToInspect)
-                addr(static_cast<sc_uint<numAddrBitsToInspect> >(AW_reg.addr)); // Cast larger to smaller
-            pushedTo = numSubordinates;
-            // TODO - refactor this so it can be unrolled
-            for (int i=0; i<numSubordinates; i++) {
-              if (addr >= addrBound[i][0].read() && addr <= addrBound[i][1].read() && pushedTo == numSubordinates) {
-                pushedTo = i;
-              }
-            }
-            if (default_output && pushedTo == numSubordinates) {
-              pushedTo = numSubordinates-1;
-            }
-            NVHLS_ASSERT_MSG(pushedTo != numSubordinates, "Write address did not fall into any output address range, and default output is not set");
-            if (translate_addr)
-              AW_reg.addr -= addrBound[pushedTo][0].read();
+      if (!w_routeQ.isFull()) {
+        if (w_route.PopNB(route_reg)) {
+          w_routeQ.push(route_reg);
+        }
+      }
 
-            axi_wr_s_aw[pushedTo].Push(AW_reg);
-            s = WRITE_INFLIGHT;
-          }
-          break;
-        case WRITE_INFLIGHT:
-          NVHLS_ASSERT_MSG(pushedTo != numSubordinates, "Write address did not fall into any output address range, and default output is not set");
-          if (axi_wr_m.w.PopNB(W_reg)) {
-            axi_wr_s_w[pushedTo].Push(W_reg);
-            if (W_reg.last == 1) {
-              if (axiCfg::useWriteResponses) {
-                s = RESP_INFLIGHT;
-              } else {
-                s = IDLE;
-              }
-            }
-          }
-          break;
-        case RESP_INFLIGHT:
-          if (axiCfg::useWriteResponses) {
-            if (axi_wr_s_b[pushedTo].PopNB(B_reg)) {
-              axi_wr_m.b.Push(B_reg);
-              s = IDLE;
-            }
-          } 
-          else {
-            NVHLS_ASSERT_MSG(0, "Should never reach this state if write responses are disabled");
+      if (!write_inProgress && !w_routeQ.isEmpty()) {
+        pushedTo = w_routeQ.pop();
+        write_inProgress = 1;
+      }
+
+      if (write_inProgress) {
+        if (axi_wr_m.w.PopNB(W_reg)) {
+          axi_wr_s_w[pushedTo].Push(W_reg);
+          if (W_reg.last == 1) {
+            write_inProgress = 0;
           }
-          break;
+        }
+      }
+    }
+  }
+
+  void run_b() {
+#pragma hls_unroll yes
+    for (int i=0; i<numSubordinates; i++) {
+      axi_wr_s_b[i].Reset();
+    }
+    axi_wr_m.b.Reset();
+    b_route.ResetRead();
+    b_routeQ.reset();
+
+    typename axi4_::WRespPayload B_reg;
+    route_t route_reg;
+    route_t pulledFrom = 0;
+    bool resp_inProgress = 0;
+
+      #pragma hls_pipeline_init_interval 1
+      #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!b_routeQ.isFull()) {
+        if (b_route.PopNB(route_reg)) {
+          b_routeQ.push(route_reg);
+        }
+      }
+
+      if (!resp_inProgress && !b_routeQ.isEmpty()) {
+        pulledFrom = b_routeQ.pop();
+        resp_inProgress = 1;
+      }
+
+      if (resp_inProgress) {
+        if (axi_wr_s_b[pulledFrom].PopNB(B_reg)) {
+          axi_wr_m.b.Push(B_reg);
+          resp_inProgress = 0;
+        }
       }
     }
   }
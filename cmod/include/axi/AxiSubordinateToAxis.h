@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXISUBORDINATETOAXIS_H__
+#define __AXISUBORDINATETOAXIS_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <axi/axi4.h>
+#include <axi/axis.h>
+
+/**
+ * \brief An AXI subordinate that bridges AXI bursts to and from AXI-Stream packets.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg     A valid AXI config.
+ * \tparam axisCfg    A valid AXI-Stream config with the same data width as axiCfg.
+ * \tparam destLsb    The lowest write address bit that is copied into TDEST (default: 12).
+ *
+ * \par Overview
+ * Like AxiSubordinateToReadyValid, this block terminates the AXI protocol and
+ * presents the traffic as simple streams, here in AXI-Stream format:
+ * - Each AXI write burst becomes one packet on axis_out. WDATA becomes TDATA,
+ *   WSTRB becomes TKEEP, and TLAST marks the last beat of the burst. TID is
+ *   the AWID, and TDEST is taken from the write address starting at bit
+ *   destLsb, so each address window feeds a different destination. A write
+ *   response is returned once the last beat has been sent.
+ * - Each AXI read beat returns the next transfer from axis_in as RDATA. The
+ *   burst length, not TLAST, ends the read burst, so the manager has to know
+ *   the packet lengths. TKEEP and TUSER of axis_in are dropped.
+ * - Reads and writes are independent, and each moves one beat per cycle.
+ * - Without TKEEP on the stream, writes must use full write strobes.
+ *
+ * \par Usage Guidelines
+ *
+ * This module sets the stall mode to flush by default to mitigate possible RTL
+ * bugs that can occur in the default stall mode. If you are confident that
+ * this class of bugs will not occur in your use case, you can change the stall
+ * mode via TCL directive:
+ *
+ * \code
+ * directive set /path/to/AxiSubordinateToAxis/run_wr/while -PIPELINE_STALL_MODE stall
+ * \endcode
+ *
+ * This may reduce area/power.
+ * \par
+ *
+ */
+template <typename axiCfg, typename axisCfg, int destLsb = 12>
+class AxiSubordinateToAxis : public sc_module {
+  SC_HAS_PROCESS(AxiSubordinateToAxis);
+
+ public:
+  static const int kDebugLevel = 5;
+
+  typedef typename axi::axi4<axiCfg> axi4_;
+  typedef typename axi::axis<axisCfg> axis_;
+
+  static_assert(static_cast<int>(axi4_::DATA_WIDTH) == static_cast<int>(axis_::DATA_WIDTH),
+                "AXI and AXI-Stream data widths must match");
+  static_assert(destLsb + axis_::DEST_WIDTH <= axi4_::ADDR_WIDTH,
+                "TDEST bits must be within the AXI address");
+
+  static const int beatCountWidth = nvhls::index_width<axiCfg::maxBurstSize>::val;
+  typedef NVUINTW(beatCountWidth) BeatCount;
+
+  typename axi4_::read::template subordinate<> if_axi_rd;
+  typename axi4_::write::template subordinate<> if_axi_wr;
+
+  typename axis_::template manager<> axis_out;
+  typename axis_::template subordinate<> axis_in;
+
+  sc_in<bool> reset_bar;
+  sc_in<bool> clk;
+
+  AxiSubordinateToAxis(sc_module_name name)
+      : sc_module(name),
+        if_axi_rd("if_axi_rd"),
+        if_axi_wr("if_axi_wr"),
+        axis_out("axis_out"),
+        axis_in("axis_in"),
+        reset_bar("reset_bar"),
+        clk("clk") {
+    SC_THREAD(run_wr);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_rd);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ protected:
+  void run_wr() {
+    if_axi_wr.reset();
+    axis_out.reset();
+
+    typename axi4_::AddrPayload aw;
+    bool have_aw = false;
+    BeatCount count = 0;
+    typename axi4_::WritePayload w;
+    bool have_w = false;
+    typename axi4_::WRespPayload b;
+    bool b_pending = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!have_aw) {
+        have_aw = if_axi_wr.aw.PopNB(aw);
+        count = 0;
+      }
+
+      if (have_aw && !b_pending) {
+        if (!have_w) {
+          have_w = if_axi_wr.w.PopNB(w);
+        }
+        if (have_w) {
+          bool last = (count == aw.len.to_uint64());
+          NVUINTW(axis_::BYTES) keep;
+          #pragma hls_unroll yes
+          for (int i = 0; i < axis_::BYTES; i++) {
+            keep[i] = (axi4_::WSTRB_WIDTH == 0) || w.wstrb[i];
+          }
+          NVHLS_ASSERT_MSG(axis_::KEEP_WIDTH > 0 || keep.and_reduce(),
+                           "Partial write strobes need TKEEP on the stream");
+          NVUINTW((axis_::ID_WIDTH > 0 ? axis_::ID_WIDTH : 1)) id = aw.id.to_uint64();
+          NVUINTW((axis_::DEST_WIDTH > 0 ? axis_::DEST_WIDTH : 1)) dest =
+              nvhls::get_slc<(axis_::DEST_WIDTH > 0 ? axis_::DEST_WIDTH : 1)>(aw.addr, destLsb);
+
+          typename axis_::Payload beat;
+          beat.data = w.data;
+          beat.keep = keep;
+          beat.last = last;
+          beat.id = id;
+          beat.dest = dest;
+          if (axis_out.nb_twrite(beat)) {
+            CDCOUT(sc_time_stamp() << " " << name() << " Sent stream beat:"
+                          << " data=" << hex << beat.data
+                          << " last=" << last
+                          << endl, kDebugLevel);
+            have_w = false;
+            if (last) {
+              have_aw = false;
+              b.id = aw.id;
+              b.resp = axi4_::Enc::XRESP::OKAY;
+              b_pending = axiCfg::useWriteResponses;
+            } else {
+              count++;
+            }
+          }
+        }
+      }
+
+      if (b_pending) {
+        b_pending = !if_axi_wr.b.PushNB(b);
+      }
+    }
+  }
+
+  void run_rd() {
+    if_axi_rd.reset();
+    axis_in.reset();
+
+    typename axi4_::AddrPayload ar;
+    bool have_ar = false;
+    BeatCount count = 0;
+    typename axis_::Payload beat;
+    bool have_beat = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!have_ar) {
+        have_ar = if_axi_rd.nb_aread(ar);
+        count = 0;
+      }
+
+      if (have_ar) {
+        if (!have_beat) {
+          have_beat = axis_in.nb_tread(beat);
+        }
+        if (have_beat) {
+          bool last = (count == ar.len.to_uint64());
+          typename axi4_::ReadPayload r;
+          r.id = ar.id;
+          r.data = beat.data;
+          r.resp = axi4_::Enc::XRESP::OKAY;
+          r.last = last;
+          if (if_axi_rd.nb_rwrite(r)) {
+            CDCOUT(sc_time_stamp() << " " << name() << " Returned stream beat:"
+                          << " data=" << hex << r.data
+                          << " last=" << last
+                          << endl, kDebugLevel);
+            have_beat = false;
+            if (last) {
+              have_ar = false;
+            } else {
+              count++;
+            }
+          }
+        }
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXISUBORDINATETOBANKEDMEM_H__
+#define __AXISUBORDINATETOBANKEDMEM_H__
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <hls_globals.h>
+#include <nvhls_int.h>
+#include <axi/axi4.h>
+#include <mem_array.h>
+#include <fifo.h>
+
+/**
+ * \brief An AXI subordinate SRAM built from several narrow banks.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg          A valid AXI config.
+ * \tparam capacity        The capacity in bytes of the local SRAM.
+ * \tparam bankWidth       Width in bits of one SRAM bank. Must divide axiCfg::dataWidth.
+ * \tparam fifoDepth       Depth of the read data and write response FIFO queues.
+ * \tparam maxOutstanding  Number of read bursts and of write bursts that can be queued (default: fifoDepth).
+ *
+ * \par Overview
+ * AxiSubordinateToBankedMem behaves like AxiSubordinateToMem, but stores each
+ * data beat across dataWidth/bankWidth banks that are accessed in parallel, so
+ * a wide AXI port can be backed by SRAM macros of realistic width while still
+ * moving one beat per cycle. Byte address a lives in row a/bytesPerWord of bank
+ * (a%bytesPerWord)/bytesPerBank.
+ * - Each bank has one byte enable per byte, so partial writes never need a
+ *   read-modify-write.
+ * - Narrow transfers (AxSIZE below the bus width, when
+ *   axiCfg::useVariableBeatSize is set) and unaligned start addresses only
+ *   touch the byte lanes of the current beat, following the AXI INCR burst
+ *   address rules. Banks outside those lanes are neither read nor written.
+ * - Write data is further masked by WSTRB when axiCfg::useWriteStrobes is set.
+ * - Burst types other than INCR are not supported.
+ * - Reads and writes are served by separate threads, run_rd and run_wr, each
+ *   pipelined at II=1, so every bank needs one read and one write port.
+ *
+ * In C simulation the memory can be preloaded from, or saved to, a raw byte
+ * image with load_image() and dump_image().
+ *
+ * \par A Simple Example
+ * \code
+ *      // 512-bit AXI port over four 128-bit banks, 64KB total
+ *      AxiSubordinateToBankedMem<wide_cfg, 64 * 1024, 128> mem;
+ *      ...
+ *      mem.clk(clk);
+ *      mem.reset_bar(reset_bar);
+ *      mem.if_rd(axi_read);
+ *      mem.if_wr(axi_write);
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg, int capacity, int bankWidth, int fifoDepth = 8,
+          int maxOutstanding = fifoDepth>
+class AxiSubordinateToBankedMem : public sc_module {
+ public:
+  static const int kDebugLevel = 2;
+
+  typedef typename axi::axi4<axiCfg> axi4_;
+  static const int bytesPerWord = axiCfg::dataWidth >> 3;
+  static const int bytesPerBank = bankWidth >> 3;
+  static const int numBanks = axiCfg::dataWidth / bankWidth;
+  static const int numRows = capacity / bytesPerWord;
+  static const int log2BytesPerWord = nvhls::log2_ceil<bytesPerWord>::val;
+
+  static_assert(bankWidth % 8 == 0, "Bank width must be a multiple of 8 bits");
+  static_assert(axiCfg::dataWidth % bankWidth == 0, "Bank width must divide the AXI data width");
+  static_assert(numBanks == (1 << nvhls::log2_ceil<numBanks>::val), "Number of banks must be a power of 2");
+  static_assert(capacity % bytesPerWord == 0, "Capacity must be a multiple of the AXI data width");
+
+  typedef typename axi4_::Addr Addr;
+  typedef NVUINTW(axiCfg::dataWidth) Data;
+  typedef NVUINTW(bankWidth) BankData;
+  typedef NVUINTW(bytesPerWord) LaneMask;
+  typedef NVUINTW(bytesPerBank) BankMask;
+  typedef mem_array_sep<BankData, numRows * numBanks, numBanks, bytesPerBank> Memarray;
+  typedef typename Memarray::LocalIndex Row;
+
+ private:
+  Memarray memarray;
+
+ public:
+  typename axi4_::read::template subordinate<> if_rd;
+  typename axi4_::write::template subordinate<> if_wr;
+
+  sc_in<bool> reset_bar;
+  sc_in<bool> clk;
+
+  FIFO<typename axi4_::ReadPayload, fifoDepth> rd_resp;
+  FIFO<typename axi4_::AddrPayload, maxOutstanding> wr_addr;
+  FIFO<typename axi4_::AddrPayload, maxOutstanding> rd_addr;
+  FIFO<typename axi4_::WRespPayload, fifoDepth> wr_resp;
+
+  SC_CTOR(AxiSubordinateToBankedMem)
+      : if_rd("if_rd"), if_wr("if_wr"), reset_bar("reset_bar"), clk("clk") {
+    SC_THREAD(run_rd);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_wr);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+#ifndef __SYNTHESIS__
+  /**
+   * \brief Preload the memory from a raw byte image mapped at address 0 (C-sim only).
+   */
+  bool load_image(const std::string& filename) {
+    return memarray.load_image(filename, true);
+  }
+
+  /**
+   * \brief Write the memory contents to a raw byte image (C-sim only).
+   */
+  bool dump_image(const std::string& filename) const {
+    return memarray.dump_image(filename, true);
+  }
+#endif
+
+ protected:
+  // log2 of the number of bytes moved per beat
+  static unsigned beat_size(typename axi4_::AddrPayload& pld) {
+    if (axi4_::ASIZE_WIDTH > 0) {
+      NVHLS_ASSERT_MSG(pld.size.to_uint64() <= log2BytesPerWord, "AxSIZE is larger than the data width");
+      return pld.size.to_uint64();
+    }
+    return log2BytesPerWord;
+  }
+
+  // Address of beat beat_cnt of an INCR burst
+  static Addr beat_addr(const Addr& start, unsigned size,
+                        const sc_uint<axi4_::ALEN_WIDTH>& beat_cnt) {
+    if (beat_cnt == 0) {
+      return start;
+    }
+    Addr aligned = (start >> size) << size;
+    return aligned + (static_cast<Addr>(beat_cnt.to_uint()) << size);
+  }
+
+  // Byte lanes of the data bus used by the beat at addr
+  static LaneMask lane_mask(const Addr& addr, unsigned size) {
+    unsigned lo = nvhls::get_slc<log2BytesPerWord>(addr, 0).to_uint();
+    unsigned hi = nvhls::get_slc<log2BytesPerWord>((addr >> size) << size, 0).to_uint() + (1 << size);
+    LaneMask mask = 0;
+    #pragma hls_unroll yes
+    for (int i = 0; i < bytesPerWord; i++) {
+      mask[i] = (i >= lo) && (i < hi);
+    }
+    return mask;
+  }
+
+  void run_rd() {
+    if_rd.reset();
+    rd_resp.reset();
+    rd_addr.reset();
+
+    sc_uint<axi4_::ALEN_WIDTH> rd_beat_cnt = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      bool rd_resp_full = rd_resp.isFull();
+
+      if (!rd_resp.isEmpty()) {
+        typename axi4_::ReadPayload data_pld;
+        data_pld = rd_resp.peek();
+        if (if_rd.nb_rwrite(data_pld)) {
+          rd_resp.incrHead();
+        }
+      }
+
+      if (!rd_resp_full && !rd_addr.isEmpty()) {
+        typename axi4_::AddrPayload rd_addr_pld;
+        rd_addr_pld = rd_addr.peek();
+
+        CDCOUT(sc_time_stamp() << " " << name() << " Received read request: "
+                      << rd_addr_pld
+                      << endl, kDebugLevel);
+
+        unsigned size = beat_size(rd_addr_pld);
+        Addr addr = beat_addr(rd_addr_pld.addr, size, rd_beat_cnt);
+        NVHLS_ASSERT_MSG(addr < capacity, "Read address is outside the memory");
+        LaneMask lanes = lane_mask(addr, size);
+        Row row = static_cast<Row>(addr >> log2BytesPerWord);
+
+        Data data = 0;
+        #pragma hls_unroll yes
+        for (int b = 0; b < numBanks; b++) {
+          BankMask bank_lanes = nvhls::get_slc<bytesPerBank>(lanes, b * bytesPerBank);
+          if (bank_lanes != 0) {
+            data = nvhls::set_slc(data, memarray.read(row, b), b * bankWidth);
+          }
+        }
+
+        typename axi4_::ReadPayload data_pld;
+        data_pld.data = data;
+        data_pld.resp = axi4_::Enc::XRESP::OKAY;
+        data_pld.id = rd_addr_pld.id;
+
+        auto rd_beat_cnt_local = rd_beat_cnt;
+
+        if (rd_beat_cnt_local == rd_addr_pld.len) {
+          rd_beat_cnt_local = 0;
+          rd_addr.incrHead();
+          data_pld.last = 1;
+        } else {
+          data_pld.last = 0;
+          ++rd_beat_cnt_local;
+        }
+
+        rd_beat_cnt = rd_beat_cnt_local;
+        rd_resp.push(data_pld);
+      }
+
+      if (!rd_addr.isFull()) {
+        typename axi4_::AddrPayload rd_addr_pld;
+        if (if_rd.nb_aread(rd_addr_pld)) {
+          rd_addr.push(rd_addr_pld);
+        }
+      }
+    }
+  }
+
+  void run_wr() {
+    if_wr.reset();
+    wr_resp.reset();
+    wr_addr.reset();
+
+    sc_uint<axi4_::ALEN_WIDTH> wr_beat_cnt = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      bool wr_resp_full = wr_resp.isFull();
+      bool wr_addr_full = wr_addr.isFull();
+
+      if (!wr_resp.isEmpty()) {
+        typename axi4_::WRespPayload resp_pld;
+        resp_pld = wr_resp.peek();
+        if (if_wr.nb_bwrite(resp_pld)) {
+          wr_resp.incrHead();
+        }
+      }
+
+      if (!wr_resp_full && !wr_addr.isEmpty()) {
+        typename axi4_::AddrPayload wr_addr_pld;
+        wr_addr_pld = wr_addr.peek();
+
+        typename axi4_::WritePayload write_pld;
+
+        if (if_wr.w.PopNB(write_pld)) {
+          auto wr_beat_cnt_local = wr_beat_cnt;
+
+          unsigned size = beat_size(wr_addr_pld);
+          Addr addr = beat_addr(wr_addr_pld.addr, size, wr_beat_cnt_local);
+          NVHLS_ASSERT_MSG(addr < capacity, "Write address is outside the memory");
+          LaneMask lanes = lane_mask(addr, size);
+          if (axi4_::WSTRB_WIDTH > 0) {
+            #pragma hls_unroll yes
+            for (int i = 0; i < bytesPerWord; i++) {
+              bool strb = write_pld.wstrb[i];
+              if (!strb) {
+                lanes[i] = 0;
+              }
+            }
+          }
+          Row row = static_cast<Row>(addr >> log2BytesPerWord);
+          Data data = write_pld.data;
+
+          #pragma hls_unroll yes
+          for (int b = 0; b < numBanks; b++) {
+            BankMask bank_lanes = nvhls::get_slc<bytesPerBank>(lanes, b * bytesPerBank);
+            if (bank_lanes != 0) {
+              memarray.write(row, b, nvhls::get_slc<bankWidth>(data, b * bankWidth), bank_lanes);
+            }
+          }
+
+          CDCOUT(sc_time_stamp() << " " << name() << " Received write request:"
+                        << " addr=[" << wr_addr_pld << "]"
+                        << " data=[" << write_pld << "]"
+                        << " beat=" << dec << wr_beat_cnt_local
+                        << endl, kDebugLevel);
+
+          if (wr_beat_cnt_local == wr_addr_pld.len) {
+            wr_beat_cnt_local = 0;
+            NVHLS_ASSERT_MSG(write_pld.last == true, "WRLEN indicates that this should be the last beat, but WRLAST is not set");
+            wr_addr.incrHead();
+
+            // push resp
+            typename axi4_::WRespPayload resp_pld;
+            resp_pld.resp = axi4_::Enc::XRESP::OKAY;
+            resp_pld.id = wr_addr_pld.id;
+            wr_resp.push(resp_pld);
+          } else {
+            NVHLS_ASSERT_MSG(write_pld.last == false, "WRLEN indicates that this should not be the last beat, but WRLAST is set");
+            ++wr_beat_cnt_local;
+          }
+
+          wr_beat_cnt = wr_beat_cnt_local;
+        }
+      }
+
+      if (!wr_addr_full) {
+        typename axi4_::AddrPayload wr_addr_pld;
+        if (if_wr.aw.PopNB(wr_addr_pld)) {
+          wr_addr.push(wr_addr_pld);
+        }
+      }
+    }
+  }
+};
+
+#endif
@@ -30,13 +30,17 @@
  *
  * \tparam axiCfg     A valid AXI config.
  * \tparam capacity   The capacity in bytes of the local SRAM.
- * \tparam fifoDepth  Depth of the input and output FIFO queues.
+ * \tparam fifoDepth  Depth of the read data and write response FIFO queues.
+ * \tparam maxOutstanding  Number of read bursts and of write bursts that can be queued (default: fifoDepth).
  *
  * \par Overview
  * AxiSubordinateToMem is an AXI subordinate with an internal dual-ported memory used for storage.
  * The module only handles AXI addresses within the range of its internal memory, with a base address of 0.
  * It does not support write strobes.
  * It has internal queues to handle multiple simultaneous requests in flight, and can handle read and write requests independently, but it does not reorder requests.
+ * Reads and writes are served by separate threads, run_rd and run_wr, each pipelined at II=1, so both channels can move one beat per cycle.
+ * The memory must then be mapped to a RAM with one port for each thread.
+ * In C simulation the memory can be preloaded from, or saved to, a raw byte image with load_image() and dump_image().
  *
  * \par Usage Guidelines
  *
@@ -46,14 +50,15 @@
  * mode via TCL directive:
  *
  * \code
- * directive set /path/to/AxiSubordinateToMem/run/while -PIPELINE_STALL_MODE stall
+ * directive set /path/to/AxiSubordinateToMem/run_rd/while -PIPELINE_STALL_MODE stall
+ * directive set /path/to/AxiSubordinateToMem/run_wr/while -PIPELINE_STALL_MODE stall
  * \endcode
  *
  * This may reduce area/power.
  * \par
  *
  */
-template <typename axiCfg, int capacity, int fifoDepth = 8>
+template <typename axiCfg, int capacity, int fifoDepth = 8, int maxOutstanding = fifoDepth>
 class AxiSubordinateToMem : public sc_module {
  private:
   static const int capacity_in_bytes = capacity;
@@ -77,31 +82,48 @@ class AxiSubordinateToMem : public sc_module {
   sc_in<bool> clk;
 
   FIFO<typename axi4_::ReadPayload, fifoDepth> rd_resp;
-  FIFO<typename axi4_::AddrPayload, fifoDepth> wr_addr;
-  FIFO<typename axi4_::AddrPayload, fifoDepth> rd_addr;
+  FIFO<typename axi4_::AddrPayload, maxOutstanding> wr_addr;
+  FIFO<typename axi4_::AddrPayload, maxOutstanding> rd_addr;
   FIFO<typename axi4_::WRespPayload, fifoDepth> wr_resp;
 
   SC_CTOR(AxiSubordinateToMem)
       : if_rd("if_rd"), if_wr("if_wr"), reset_bar("reset_bar"), clk("clk") {
-    SC_THREAD(run);
+    SC_THREAD(run_rd);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_wr);
     sensitive << clk.pos();
     async_reset_signal_is(reset_bar, false);
   }
 
+#ifndef __SYNTHESIS__
+  /**
+   * \brief Preload the memory from a raw byte image mapped at address 0 (C-sim only).
+   */
+  bool load_image(const std::string& filename) {
+    return nvhls::mem_array_image<axiCfg::dataWidth, capacity_in_bytes, banks>::Load(
+        memarray, filename, false, bytesPerWord);
+  }
+
+  /**
+   * \brief Write the memory contents to a raw byte image (C-sim only).
+   */
+  bool dump_image(const std::string& filename) const {
+    return nvhls::mem_array_image<axiCfg::dataWidth, capacity_in_bytes, banks>::Dump(
+        memarray, filename, false, bytesPerWord);
+  }
+#endif
+
  protected:
-  void run() {
+  void run_rd() {
     if_rd.reset();
-    if_wr.reset();
-
     rd_resp.reset();
     rd_addr.reset();
-    wr_resp.reset();
-    wr_addr.reset();
 
     sc_uint<axi4_::ALEN_WIDTH> rd_beat_cnt = 0;
-    sc_uint<axi4_::ALEN_WIDTH> wr_beat_cnt = 0;
 
-    #pragma hls_pipeline_init_interval 2
+    #pragma hls_pipeline_init_interval 1
     #pragma pipeline_stall_mode flush
     while (1) {
       wait();
@@ -150,6 +172,20 @@ class AxiSubordinateToMem : public sc_module {
           rd_addr.push(rd_addr_pld);
         }
       }
+    }
+  }
+
+  void run_wr() {
+    if_wr.reset();
+    wr_resp.reset();
+    wr_addr.reset();
+
+    sc_uint<axi4_::ALEN_WIDTH> wr_beat_cnt = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
 
       bool wr_resp_full = wr_resp.isFull();
       bool wr_addr_full = wr_addr.isFull();
@@ -32,9 +32,22 @@
  *
  * \tparam axiCfg    A valid AXI config.
  * \tparam rvCfg     A config for the ready-valid interface that is the output of the subordinate. The data and strobe fields are assumed to match the widths of their AXI counterparts.
+ * \tparam maxReads  The most read beats that can wait for their ready-valid response (default: 4).
+ * \tparam ordered   Keep the beats of a burst together on the ready-valid interface (default: false).
  *
  * \par Overview
  * This block converts AXI read and write requests into a simplified format consisting of a single ready-valid interface that has address, data, and write strobe fields, as well as a read/write indicator.  Read responses are returned to the block via a second ready-valid interface (there are no write responses expected).  AxiSubordinateToReadyValid handles all of the AXI-specific protocol, generating write responses and packing/unpacking bursts as necessary.
+ * - Reads and writes are handled by separate threads, which split INCR bursts
+ *   into one ready-valid request per beat, at one beat per cycle.  A third
+ *   thread merges the two request streams onto the ready-valid interface,
+ *   round-robin.
+ * - Up to maxReads read requests can be in flight.  The ready-valid
+ *   interface must return read responses in request order.
+ * - The write response is sent once the last beat of the write has been
+ *   accepted by the ready-valid interface, so a read issued after the write
+ *   response is ordered after the write.
+ * - With ordered, the interface is not handed over to the other direction in
+ *   the middle of a burst, so that bursts stay atomic.
  *
  * \par Usage Guidelines
  *
@@ -44,14 +57,14 @@
  * mode via TCL directive:
  *
  * \code
- * directive set /path/to/AxiSubordinateToReadyValid/run/while -PIPELINE_STALL_MODE stall
+ * directive set /path/to/AxiSubordinateToReadyValid/rv_mux/while -PIPELINE_STALL_MODE stall
  * \endcode
  *
  * This may reduce area/power.
  * \par
  *
  */
-template <typename axiCfg, typename rvCfg>
+template <typename axiCfg, typename rvCfg, int maxReads = 4, bool ordered = false>
 class AxiSubordinateToReadyValid : public sc_module {
  public:
   static const int kDebugLevel = 5;
@@ -77,6 +90,47 @@ class AxiSubordinateToReadyValid : public sc_module {
   Connections::In<Read> if_rv_rd;
   Connections::Out<Write> if_rv_wr;
 
+ protected:
+  static const int bytesPerBeat = rvDataW >> 3;
+
+  // One ready-valid request, with the end of its burst and the ID of its write response
+  class Beat : public nvhls_message {
+   public:
+    Write rv;
+    NVUINT1 last;
+    typename axi4_::BId id;
+
+    static const unsigned int width = Write::width + 1 + axi4_::BID_WIDTH;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m& rv;
+      m& last;
+      m& id;
+    }
+  };
+
+  // The R fields of a read request in flight
+  class ReadTag : public nvhls_message {
+   public:
+    typename axi4_::Id id;
+    NVUINT1 last;
+
+    static const unsigned int width = axi4_::ID_WIDTH + 1;
+
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m& id;
+      m& last;
+    }
+  };
+
+  Connections::Combinational<Beat> rd_beat;
+  Connections::Combinational<Beat> wr_beat;
+  Connections::Combinational<ReadTag> rd_tag_in;
+  Connections::Combinational<ReadTag> rd_tag_out;
+  Connections::Buffer<ReadTag, maxReads> rd_tags;
+
  public:
   SC_CTOR(AxiSubordinateToReadyValid)
       : if_axi_rd("if_axi_rd"),
@@ -84,126 +138,169 @@ class AxiSubordinateToReadyValid : public sc_module {
         reset_bar("reset_bar"),
         clk("clk"),
         if_rv_rd("if_rv_rd"),
-        if_rv_wr("if_rv_wr") {
-    SC_THREAD(run);
+        if_rv_wr("if_rv_wr"),
+        rd_beat("rd_beat"),
+        wr_beat("wr_beat"),
+        rd_tag_in("rd_tag_in"),
+        rd_tag_out("rd_tag_out"),
+        rd_tags("rd_tags") {
+    rd_tags.clk(clk);
+    rd_tags.rst(reset_bar);
+    rd_tags.enq(rd_tag_in);
+    rd_tags.deq(rd_tag_out);
+
+    SC_THREAD(axi_read);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(axi_read_resp);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(axi_write);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(rv_mux);
     sensitive << clk.pos();
     async_reset_signal_is(reset_bar, false);
   }
 
  protected:
-  void run() {
-    if_axi_rd.reset();
-    if_axi_wr.reset();
-
-    if_rv_rd.Reset();
-    if_rv_wr.Reset();
+  // Splits each AR into one ready-valid read per beat
+  void axi_read() {
+    if_axi_rd.ar.Reset();
+    rd_beat.ResetWrite();
+    rd_tag_in.ResetWrite();
 
     typename axi4_::AddrPayload axi_rd_req;
-    typename axi4_::ReadPayload axi_rd_resp;
-    typename axi4_::AddrPayload axi_wr_req_addr;
-    typename axi4_::WritePayload axi_wr_req_data;
-    typename axi4_::WRespPayload axi_wr_resp;
+    Beat beat;
+    ReadTag tag;
+    NVUINTW(axi4_::ADDR_WIDTH) read_addr = 0;
+    NVUINTW(axi4_::ALEN_WIDTH) axiRdLen = 0;
+    bool active = 0;
 
-    static const int bytesPerBeat = rvDataW >> 3;
+    beat.rv.rw = 0;
+    beat.rv.data = 0;
+    beat.rv.wstrb = 0;
 
-    Write rv_wr;
-    Read rv_rd;
-    rvAddr addr_temp;
-    
-    NVUINTW(axi4_::ADDR_WIDTH) read_addr;
-    NVUINTW(axi4_::ALEN_WIDTH) axiRdLen;
-    NVUINTW(rvAddrW) write_addr;
-
-    bool read_arb_req = 0;
-    bool write_arb_req = 0;
-    NVUINTW(2) valid_mask = 0;
-    NVUINTW(2) select_mask = 0;
-    Arbiter<2> arb;
-
-    bool read_inFlight = 0;
-    bool arb_needs_update = 1;
-    
     #pragma hls_pipeline_init_interval 1
     #pragma pipeline_stall_mode flush
     while (1) {
       wait();
 
-      valid_mask = write_arb_req << 1 | read_arb_req;
-      if (arb_needs_update) {
-        select_mask = arb.pick(valid_mask);
-        if (select_mask != 0) arb_needs_update = 0;
-      }
-
-      if (!read_arb_req) {
-        if (if_axi_rd.ar.PopNB(axi_rd_req)) { 
-          read_arb_req = 1;
+      if (!active) {
+        if (if_axi_rd.ar.PopNB(axi_rd_req)) {
+          active = 1;
           NVUINTW(axi4_::ADDR_WIDTH) addr_temp_cast(static_cast<sc_uint<axi4_::ADDR_WIDTH> >(axi_rd_req.addr));
           NVUINTW(axi4_::ALEN_WIDTH) len_temp(static_cast< sc_uint<axi4_::ALEN_WIDTH> >(axi_rd_req.len));
           read_addr = addr_temp_cast;
           axiRdLen = len_temp;
-          axi_rd_resp.resp = axi4_::Enc::XRESP::OKAY;
-          axi_rd_resp.id = axi_rd_req.id;
+          tag.id = axi_rd_req.id;
+        }
+      }
+
+      if (active) {
+        tag.last = (axiRdLen == 0);
+        beat.rv.addr = nvhls::get_slc<rvAddrW>(read_addr, 0);
+        beat.last = tag.last;
+        // The tag goes first, so it is there when the response returns
+        rd_tag_in.Push(tag);
+        rd_beat.Push(beat);
+        CDCOUT(sc_time_stamp() << " " << name() << " RV read:"
+                      << " addr=" << hex << beat.rv.addr.to_int64()
+                      << endl, kDebugLevel);
+        if (axiRdLen == 0) {
+          active = 0;
+        } else {
+          axiRdLen--;
+          read_addr += bytesPerBeat;
         }
       }
+    }
+  }
 
-      if (!write_arb_req) {
+  // Returns the ready-valid read responses as R beats, in order
+  void axi_read_resp() {
+    if_axi_rd.r.Reset();
+    if_rv_rd.Reset();
+    rd_tag_out.ResetRead();
+
+    typename axi4_::ReadPayload axi_rd_resp;
+    ReadTag tag;
+    Read rv_rd;
+    bool have_tag = 0;
+
+    axi_rd_resp.resp = axi4_::Enc::XRESP::OKAY;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!have_tag) {
+        have_tag = rd_tag_out.PopNB(tag);
+      }
+
+      if (have_tag) {
+        if (if_rv_rd.PopNB(rv_rd)) {
+          axi_rd_resp.id = tag.id;
+          axi_rd_resp.data = rv_rd.data;
+          axi_rd_resp.last = tag.last;
+          if_axi_rd.r.Push(axi_rd_resp);
+          CDCOUT(sc_time_stamp() << " " << name() << " RV read response:"
+                        << axi_rd_resp
+                        << endl, kDebugLevel);
+          have_tag = 0;
+        }
+      }
+    }
+  }
+
+  // Splits each write into one ready-valid write per W beat
+  void axi_write() {
+    if_axi_wr.aw.Reset();
+    if_axi_wr.w.Reset();
+    wr_beat.ResetWrite();
+
+    typename axi4_::AddrPayload axi_wr_req_addr;
+    typename axi4_::WritePayload axi_wr_req_data;
+    Beat beat;
+    NVUINTW(rvAddrW) write_addr = 0;
+    bool active = 0;
+
+    beat.rv.rw = 1;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!active) {
         if (if_axi_wr.aw.PopNB(axi_wr_req_addr)) {
-          write_arb_req = 1;
+          active = 1;
           NVUINTW(rvAddrW) addr_temp_cast(static_cast< sc_uint<rvAddrW> >(axi_wr_req_addr.addr));
           write_addr = addr_temp_cast;
+          beat.id = axi_wr_req_addr.id;
         }
       }
 
-      if (select_mask == 1) {
-        if (!read_inFlight) {
-          rv_wr.rw = 0;
-          rv_wr.addr = nvhls::get_slc<rvAddrW>(read_addr,0);
-          if_rv_wr.Push(rv_wr);
-          CDCOUT(sc_time_stamp() << " " << name() << " RV read:"
-                        << " addr=" << hex << rv_wr.addr.to_int64()
-                        << endl, kDebugLevel);
-          read_inFlight = 1;
-        } else {
-          if (if_rv_rd.PopNB(rv_rd)) {
-            axi_rd_resp.data = rv_rd.data;
-            if (axiRdLen == 0) {
-              axi_rd_resp.last = 1;
-              read_arb_req = 0;
-              arb_needs_update = 1;
-            } else {
-              axi_rd_resp.last = 0;
-              axiRdLen--;
-              read_addr += bytesPerBeat;
-            }
-            if_axi_rd.r.Push(axi_rd_resp);
-            CDCOUT(sc_time_stamp() << " " << name() << " RV read response:"
-                          << axi_rd_resp
-                          << endl, kDebugLevel);
-            read_inFlight = 0;
-          }
-        }
-      } else if (select_mask == 2) {
+      if (active) {
         if (if_axi_wr.w.PopNB(axi_wr_req_data)) {
-          rv_wr.addr = write_addr;
-          rv_wr.rw = 1;
+          beat.rv.addr = write_addr;
           NVUINTW(axi4_::WSTRB_WIDTH) wstrb_temp_cast(static_cast<sc_uint<axi4_::WSTRB_WIDTH> >(axi_wr_req_data.wstrb));
-          rv_wr.wstrb = wstrb_temp_cast;
+          beat.rv.wstrb = wstrb_temp_cast;
           NVUINTW(axi4_::DATA_WIDTH) data_temp_cast(static_cast<typename axi4_::Data>(axi_wr_req_data.data));
-          rv_wr.data = data_temp_cast;
-          if_rv_wr.Push(rv_wr);
+          beat.rv.data = data_temp_cast;
+          beat.last = axi_wr_req_data.last;
+          wr_beat.Push(beat);
           CDCOUT(sc_time_stamp() << " " << name() << " RV write:"
-                        << " data=" << hex << rv_wr.data
-                        << " addr=" << hex << rv_wr.addr.to_uint64()
-                        << " strb=" << hex << rv_wr.wstrb.to_uint64()
+                        << " data=" << hex << beat.rv.data
+                        << " addr=" << hex << beat.rv.addr.to_uint64()
+                        << " strb=" << hex << beat.rv.wstrb.to_uint64()
                         << endl, kDebugLevel);
           if (axi_wr_req_data.last == 1) {
-            write_arb_req = 0;
-            arb_needs_update = 1;
-            if (axiCfg::useWriteResponses) {
-              axi_wr_resp.resp = axi4_::Enc::XRESP::OKAY;
-              axi_wr_resp.id = axi_wr_req_addr.id;
-              if_axi_wr.bwrite(axi_wr_resp);
-            }
+            active = 0;
           } else {
             write_addr += bytesPerBeat;
           }
@@ -211,6 +308,57 @@ class AxiSubordinateToReadyValid : public sc_module {
       }
     }
   }
+
+  // Merges the read and write beats onto the ready-valid interface
+  void rv_mux() {
+    rd_beat.ResetRead();
+    wr_beat.ResetRead();
+    if_rv_wr.Reset();
+    if_axi_wr.b.Reset();
+
+    Beat rd;
+    Beat wr;
+    typename axi4_::WRespPayload axi_wr_resp;
+    bool rd_held = 0;
+    bool wr_held = 0;
+    bool locked = 0;      // In the middle of a burst, with ordered
+    NVUINTW(2) select_mask = 0;
+    Arbiter<2> arb;
+
+    axi_wr_resp.resp = axi4_::Enc::XRESP::OKAY;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!rd_held) rd_held = rd_beat.PopNB(rd);
+      if (!wr_held) wr_held = wr_beat.PopNB(wr);
+
+      NVUINTW(2) valid_mask = static_cast<NVUINTW(2)>(wr_held) << 1 | static_cast<NVUINTW(2)>(rd_held);
+      if (!(ordered && locked)) {
+        select_mask = arb.pick(valid_mask);
+      } else {
+        select_mask = select_mask & valid_mask;
+      }
+
+      if (select_mask == 1) {
+        if (if_rv_wr.PushNB(rd.rv)) {
+          rd_held = 0;
+          locked = !rd.last;
+        }
+      } else if (select_mask == 2) {
+        if (if_rv_wr.PushNB(wr.rv)) {
+          wr_held = 0;
+          locked = !wr.last;
+          if (axiCfg::useWriteResponses && wr.last == 1) {
+            axi_wr_resp.id = wr.id;
+            if_axi_wr.bwrite(axi_wr_resp);
+          }
+        }
+      }
+    }
+  }
 };
 
 #endif
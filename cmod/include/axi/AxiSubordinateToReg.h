@@ -30,12 +30,20 @@
  * \ingroup AXI
  *
  * \tparam axiCfg                   A valid AXI config.
- * \tparam numReg                   The number of registers in the subordinate.  Each register has a width equivalent to the AXI data width.
+ * \tparam numReg                   The number of registers in the subordinate.  Each register is regWidth bits wide.
  * \tparam numAddrBitsToInspect     The number of address bits to inspect when determining which subordinate to direct traffic to.  If this is less than the full address width, the routing determination will be made based on the number of address LSBs specified.  (Default: axiCfg::addrWidth)
+ * \tparam regWidth                 The width of each register.  Must be a multiple of 8 that divides the AXI data width.  (Default: the AXI data width)
  *
  * \par Overview
  * AxiSubordinateToReg is an AXI subordinate that saves its state in a bank of registers.  The register state is accessible as an array of sc_out.
  *
+ * When regWidth is narrower than the AXI data width, each beat carries
+ * dataWidth/regWidth registers, placed on the byte lanes given by their
+ * addresses, and all of them are read or written in the same cycle.  An INCR
+ * burst then covers a whole table of registers at one beat per cycle.  In this
+ * case baseAddr must be aligned to the AXI data width and numReg must be a
+ * multiple of the number of registers per beat.
+ *
  * \par Usage Guidelines
  *
  * This module sets the stall mode to flush by default to mitigate possible RTL
@@ -51,7 +59,8 @@
  * \par
  *
  */
-template <typename axiCfg, int numReg, int numAddrBitsToInspect = axiCfg::addrWidth>
+template <typename axiCfg, int numReg, int numAddrBitsToInspect = axiCfg::addrWidth,
+          int regWidth = axi::axi4<axiCfg>::DATA_WIDTH>
 class AxiSubordinateToReg : public sc_module {
  public:
   static const int kDebugLevel = 5;
@@ -65,13 +74,21 @@ class AxiSubordinateToReg : public sc_module {
   typename axi4_::write::template subordinate<> if_axi_wr;
 
   static const int regAddrWidth = nvhls::log2_ceil<numReg>::val;
-  static const int bytesPerReg = axi4_::DATA_WIDTH >> 3;
-  static const int axiAddrBitsPerReg = nvhls::log2_ceil<bytesPerReg>::val;
+  static const int bytesPerReg = regWidth >> 3;
+  static const int regsPerBeat = axi4_::DATA_WIDTH / regWidth;
+  static const int regsPerBeatLog = nvhls::log2_ceil<regsPerBeat>::val;
+  static const int bytesPerBeat = axi4_::DATA_WIDTH >> 3;
+  static const int axiAddrBitsPerBeat = nvhls::log2_ceil<bytesPerBeat>::val;
+
+  static_assert(regWidth % 8 == 0, "Register width must be a multiple of 8");
+  static_assert(axi4_::DATA_WIDTH % regWidth == 0, "Register width must divide the AXI data width");
+  static_assert((1 << regsPerBeatLog) == regsPerBeat, "Registers per beat must be a power of 2");
+  static_assert(numReg % regsPerBeat == 0, "Number of registers must be a multiple of registers per beat");
 
   sc_in<NVUINTW(numAddrBitsToInspect)> baseAddr;
 
-  // Each reg is one AXI data word
-  sc_out<NVUINTW(axi4_::DATA_WIDTH)> regOut[numReg];
+  // Each reg is regWidth bits; regsPerBeat regs share one AXI data word
+  sc_out<NVUINTW(regWidth)> regOut[numReg];
 
  public:
   SC_CTOR(AxiSubordinateToReg)
@@ -90,7 +107,7 @@ class AxiSubordinateToReg : public sc_module {
     if_axi_rd.reset();
     if_axi_wr.reset();
 
-    NVUINTW(axi4_::DATA_WIDTH) reg[numReg];
+    NVUINTW(regWidth) reg[numReg];
     NVUINTW(numAddrBitsToInspect) maxValidAddr = baseAddr.read() + bytesPerReg*numReg - 1;
 
 #pragma hls_unroll yes
@@ -150,12 +167,17 @@ class AxiSubordinateToReg : public sc_module {
       if (select_mask == 1) {
         valid_rd_addr = (axiRdAddr >= baseAddr.read() && axiRdAddr <= maxValidAddr);
         NVHLS_ASSERT_MSG(valid_rd_addr, "Read address is out of bounds");
-        NVUINTW(regAddrWidth) regAddr = (axiRdAddr - baseAddr.read()) >> axiAddrBitsPerReg;
+        // First reg of the beat; the beat's regs are read in parallel
+        NVUINTW(regAddrWidth) regAddr = ((axiRdAddr - baseAddr.read()) >> axiAddrBitsPerBeat) << regsPerBeatLog;
         axi_rd_resp.id = axi_rd_req.id;
         if (valid_rd_addr) {
           axi_rd_resp.resp = axi4_::Enc::XRESP::OKAY;
-          NVUINTW(axi4_::DATA_WIDTH) read_data;
-          axi_rd_resp.data = reg[regAddr];
+          NVUINTW(axi4_::DATA_WIDTH) read_data = 0;
+#pragma hls_unroll yes
+          for (int j=0; j<regsPerBeat; j++) {
+            read_data = nvhls::set_slc(read_data, reg[regAddr + j], regWidth*j);
+          }
+          axi_rd_resp.data = read_data;
         }
         else {
           axi_rd_resp.resp = axi4_::Enc::XRESP::SLVERR;
@@ -167,7 +189,7 @@ class AxiSubordinateToReg : public sc_module {
         } else {
           axi_rd_resp.last = 0;
           axiRdLen--;
-          axiRdAddr += bytesPerReg;
+          axiRdAddr += bytesPerBeat;
         }
         if_axi_rd.rwrite(axi_rd_resp);
         CDCOUT(sc_time_stamp() << " " << name() << " Read from local reg:"
@@ -180,10 +202,14 @@ class AxiSubordinateToReg : public sc_module {
           valid_wr_addr = (axiWrAddr >= baseAddr.read() && axiWrAddr <= maxValidAddr);
           NVHLS_ASSERT_MSG(valid_wr_addr, "Write address is out of bounds");
           NVUINTW(axi4_::DATA_WIDTH) axiData(static_cast<typename axi4_::Data>(axi_wr_req_data.data));
-          NVUINTW(regAddrWidth) regAddr = (axiWrAddr - baseAddr.read()) >> axiAddrBitsPerReg;
+          NVUINTW(regAddrWidth) regAddr = ((axiWrAddr - baseAddr.read()) >> axiAddrBitsPerBeat) << regsPerBeatLog;
           if (axi4_::WSTRB_WIDTH > 0) {
             if (!axi_wr_req_data.wstrb.and_reduce()) { // Non-uniform write strobe - need to do read-modify-write
-              NVUINTW(axi4_::DATA_WIDTH) old_data = reg[regAddr];
+              NVUINTW(axi4_::DATA_WIDTH) old_data = 0;
+#pragma hls_unroll yes
+              for (int j=0; j<regsPerBeat; j++) {
+                old_data = nvhls::set_slc(old_data, reg[regAddr + j], regWidth*j);
+              }
 #pragma hls_unroll yes
               for (int i=0; i<axi4_::WSTRB_WIDTH; i++) {
                 if (axi_wr_req_data.wstrb[i] == 0) {
@@ -194,8 +220,8 @@ class AxiSubordinateToReg : public sc_module {
           }
 #pragma hls_unroll yes
           for (int i=0; i<numReg; i++) { // More verbose, but this is the preferred coding style for HLS
-            if (i == regAddr) {
-              reg[i] = axiData;
+            if ((i >> regsPerBeatLog) == (regAddr >> regsPerBeatLog)) {
+              reg[i] = nvhls::get_slc<regWidth>(axiData, regWidth*(i & (regsPerBeat-1)));
             }
           }
           CDCOUT(sc_time_stamp() << " " << name() << " Wrote to local reg:"
@@ -217,7 +243,7 @@ class AxiSubordinateToReg : public sc_module {
               if_axi_wr.bwrite(axi_wr_resp);
             }
           } else {
-            axiWrAddr += bytesPerReg;
+            axiWrAddr += bytesPerBeat;
           }
         }
       }
@@ -237,11 +263,19 @@ class AxiSubordinateToReg : public sc_module {
  * \tparam numControlReg            The number of control (local writable state) registers in the subordinate.  Each register has a width equivalent to the AXI data width.
  * \tparam numStatusReg             The number of status (external read-only state) registers in the subordinate.  Each register has a width equivalent to the AXI data width.
  * \tparam numAddrBitsToInspect     The number of address bits to inspect when determining which subordinate to direct traffic to.  If this is less than the full address width, the routing determination will be made based on the number of address LSBs specified.  (Default: axiCfg::addrWidth)
+ * \tparam useShadow                If true, AXI accesses go to a shadow bank of the control registers, which is copied to regOut on a write to the commit register.  (Default: false)
  *
  * \par Overview
  * AxiSubordinateToCSnReg is an AXI subordinate that saves its state in a bank of registers.  The register state is accessible as an array of sc_out.
  * Access to read-only status registers is provided as an array of sc_in. The status register address range immediately follows the control (read/write) register address range
  *
+ * With useShadow, software reads and writes a shadow copy of the control
+ * registers while regOut keeps its previous values.  A write of any data to
+ * the commit register, which immediately follows the status register address
+ * range, copies the whole shadow bank to regOut in one cycle, so the datapath
+ * never sees a partially updated configuration.  The commit register is
+ * write-only.
+ *
  * \par Usage Guidelines
  *
  * This module sets the stall mode to flush by default to mitigate possible RTL
@@ -257,7 +291,8 @@ class AxiSubordinateToReg : public sc_module {
  * \par
  *
  */
-template <typename axiCfg, int numControlReg, int numStatusReg, int numAddrBitsToInspect = axiCfg::addrWidth>
+template <typename axiCfg, int numControlReg, int numStatusReg, int numAddrBitsToInspect = axiCfg::addrWidth,
+          bool useShadow = false>
 class AxiSubordinateToCSReg : public sc_module {
  public:
   static const int kDebugLevel = 5;
@@ -299,13 +334,18 @@ class AxiSubordinateToCSReg : public sc_module {
     if_axi_rd.reset();
     if_axi_wr.reset();
 
+    // With useShadow, reg is the shadow bank and active drives regOut
     NVUINTW(axi4_::DATA_WIDTH) reg[numControlReg];
+    NVUINTW(axi4_::DATA_WIDTH) active[numControlReg];
     NVUINTW(numAddrBitsToInspect) maxValidRdAddr = baseAddr.read() + bytesPerReg*numReg - 1;
     NVUINTW(numAddrBitsToInspect) maxValidWrAddr = baseAddr.read() + bytesPerReg*numControlReg - 1;
+    NVUINTW(numAddrBitsToInspect) commitAddr = baseAddr.read() + bytesPerReg*numReg;
+    bool commit = 0;
 
 #pragma hls_unroll yes
     for (int i=0; i<numControlReg; i++) {
       reg[i] = 0;
+      active[i] = 0;
       regOut[i].write(reg[i]);
     }
 
@@ -400,11 +440,13 @@ class AxiSubordinateToCSReg : public sc_module {
         }
       } else if (select_mask == 2) {
         if (if_axi_wr.w.PopNB(axi_wr_req_data)) {
-          valid_wr_addr = (axiWrAddr >= baseAddr.read() && axiWrAddr <= maxValidWrAddr);
+          bool is_commit = useShadow && axiWrAddr == commitAddr;
+          valid_wr_addr = (axiWrAddr >= baseAddr.read() && axiWrAddr <= maxValidWrAddr) || is_commit;
           NVHLS_ASSERT_MSG(valid_wr_addr, "Write address is out of bounds");
+          commit = is_commit;
           NVUINTW(axi4_::DATA_WIDTH) axiData(static_cast<typename axi4_::Data>(axi_wr_req_data.data));
           NVUINTW(controlRegAddrWidth) regAddr = (axiWrAddr - baseAddr.read()) >> axiAddrBitsPerReg;
-          if (axi4_::WSTRB_WIDTH > 0) {
+          if (axi4_::WSTRB_WIDTH > 0 && !is_commit) {
             if (!axi_wr_req_data.wstrb.and_reduce()) { // Non-uniform write strobe - need to do read-modify-write
               NVUINTW(axi4_::DATA_WIDTH) old_data = reg[regAddr];
 #pragma hls_unroll yes
@@ -417,7 +459,7 @@ class AxiSubordinateToCSReg : public sc_module {
           }
 #pragma hls_unroll yes
           for (int i=0; i<numControlReg; i++) { // More verbose, but this is the preferred coding style for HLS
-            if (i == regAddr) {
+            if (i == regAddr && !is_commit) {
               reg[i] = axiData;
             }
           }
@@ -444,9 +486,24 @@ class AxiSubordinateToCSReg : public sc_module {
           }
         }
       }
+      if (useShadow) {
+        if (commit) {
 #pragma hls_unroll yes
-      for (int i=0; i<numControlReg; i++) {
-        regOut[i].write(reg[i]);
+          for (int i=0; i<numControlReg; i++) {
+            active[i] = reg[i];
+          }
+          commit = 0;
+          CDCOUT(sc_time_stamp() << " " << name() << " Committed shadow regs" << endl, kDebugLevel);
+        }
+#pragma hls_unroll yes
+        for (int i=0; i<numControlReg; i++) {
+          regOut[i].write(active[i]);
+        }
+      } else {
+#pragma hls_unroll yes
+        for (int i=0; i<numControlReg; i++) {
+          regOut[i].write(reg[i]);
+        }
       }
     }
   }
@@ -0,0 +1,816 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXI_WIDTH_CONVERTER_H__
+#define __AXI_WIDTH_CONVERTER_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <nvhls_message.h>
+#include <axi/axi4.h>
+#include <fifo.h>
+
+/**
+ * \brief Connects an AXI manager to an AXI subordinate with a different data width.
+ * \ingroup AXI
+ *
+ * \tparam CfgManager      A valid AXI config describing the manager port.
+ * \tparam CfgSubordinate  A valid AXI config describing the subordinate port.
+ * \tparam maxOutstanding  The number of outstanding read or write bursts that can be tracked with internal state (default: 4).
+ *
+ * \par Overview
+ * AxiWidthConverter packs or unpacks data beats between two AXI configs whose
+ * data widths differ by a power of 2, recalculating burst lengths, byte lanes
+ * and write strobes along the way. The direction follows from the configs:
+ * - Upsizing (narrow manager, wide subordinate): each narrow burst becomes one
+ *   wide burst covering the same bytes, and consecutive narrow beats are packed
+ *   into every lane of a wide beat. Only the first and last wide beats of a
+ *   burst can be partial; their unused lanes are masked with WSTRB, so the
+ *   subordinate config must use write strobes.
+ * - Downsizing (wide manager, narrow subordinate): each wide beat is split into
+ *   narrow beats. Wide bursts longer than CfgSubordinate::maxBurstSize narrow
+ *   beats are split into several narrow bursts, whose write responses are
+ *   merged into one.
+ * - Returned RRESP and BRESP values are the worst of the merged responses.
+ * - Manager addresses must be aligned to the narrow data width, and manager
+ *   beats must use the full manager data width. Only INCR bursts are supported.
+ * - Like AxiArbiter, the converter assumes that downstream responses are
+ *   returned in the order that requests are sent.
+ * - Apart from dataWidth, maxBurstSize, write strobes and beat size support,
+ *   the two AXI configs must be the same. Other AxPROT/AxCACHE-style fields are
+ *   not forwarded.
+ *
+ * \par Usage Guidelines
+ *
+ * This module sets the stall mode to flush by default to mitigate possible RTL
+ * bugs that can occur in the default stall mode. If you are confident that
+ * this class of bugs will not occur in your use case, you can change the stall
+ * mode via TCL directive:
+ *
+ * \code
+ * directive set /path/to/AxiWidthConverter/run_ar/while -PIPELINE_STALL_MODE stall
+ * \endcode
+ *
+ * This may reduce area/power.
+ * \par A Simple Example
+ * \code
+ *      // 64-bit manager onto a 512-bit fabric
+ *      AxiWidthConverter<axi::cfg::standard, wide_cfg> upsizer;
+ *      ...
+ *      upsizer.clk(clk);
+ *      upsizer.reset_bar(reset_bar);
+ *      upsizer.axiM_read(narrow_read);
+ *      upsizer.axiM_write(narrow_write);
+ *      upsizer.axiS_read(wide_read);
+ *      upsizer.axiS_write(wide_write);
+ * \endcode
+ * \par
+ *
+ */
+template <typename CfgManager, typename CfgSubordinate, int maxOutstanding = 4,
+          bool upsize = (static_cast<int>(CfgManager::dataWidth) <
+                         static_cast<int>(CfgSubordinate::dataWidth))>
+class AxiWidthConverter;
+
+namespace axi {
+namespace width_converter {
+
+/**
+ * \brief Constants and checks shared by both directions of AxiWidthConverter.
+ */
+template <typename CfgNarrow, typename CfgWide>
+struct Params {
+  static const int narrowWidth = CfgNarrow::dataWidth;
+  static const int wideWidth = CfgWide::dataWidth;
+  static const int ratio = wideWidth / narrowWidth;
+  static const int log2Ratio = nvhls::log2_ceil<ratio>::val;
+  static const int narrowBytes = narrowWidth >> 3;
+  static const int log2NarrowBytes = nvhls::log2_ceil<narrowBytes>::val;
+  static const int wideBytes = wideWidth >> 3;
+  static const int log2WideBytes = nvhls::log2_ceil<wideBytes>::val;
+
+  static_assert(wideWidth % narrowWidth == 0 && ratio == (1 << log2Ratio) && ratio > 1,
+                "Data widths must differ by a power of 2");
+  static_assert(static_cast<int>(CfgNarrow::addrWidth) == static_cast<int>(CfgWide::addrWidth),
+                "Address widths must match");
+  static_assert(static_cast<int>(CfgNarrow::idWidth) == static_cast<int>(CfgWide::idWidth),
+                "ID widths must match");
+  static_assert(static_cast<int>(CfgNarrow::useWriteResponses) ==
+                    static_cast<int>(CfgWide::useWriteResponses),
+                "Both configs must agree on write responses");
+
+  typedef NVUINTW(log2Ratio) Lane;
+};
+
+/**
+ * \brief Lane of the first beat and number of narrow beats (minus one) of a burst.
+ */
+template <int log2Ratio, int countWidth>
+struct BurstInfo : public nvhls_message {
+  NVUINTW(log2Ratio) lane;
+  NVUINTW(countWidth) len;
+  static const int width = log2Ratio + countWidth;
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m & lane;
+    m & len;
+  }
+};
+
+}  // namespace width_converter
+}  // namespace axi
+
+/**
+ * \brief Upsizing AxiWidthConverter: a narrow manager packed onto a wide subordinate.
+ * \ingroup AXI
+ */
+template <typename CfgManager, typename CfgSubordinate, int maxOutstanding>
+class AxiWidthConverter<CfgManager, CfgSubordinate, maxOutstanding, true>
+    : public sc_module {
+  SC_HAS_PROCESS(AxiWidthConverter);
+  typedef axi::axi4<CfgManager> axiM;
+  typedef axi::axi4<CfgSubordinate> axiS;
+  typedef axi::width_converter::Params<CfgManager, CfgSubordinate> P;
+  typedef typename P::Lane Lane;
+
+  static_assert(CfgSubordinate::useWriteStrobes,
+                "Upsizing needs write strobes on the wide port to write partial beats");
+
+ public:
+  static const int kDebugLevel = 5;
+  static const int countWidth = nvhls::index_width<CfgManager::maxBurstSize>::val;
+  typedef axi::width_converter::BurstInfo<P::log2Ratio, countWidth> BurstInfo;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axiM::read::template subordinate<> axiM_read;
+  typename axiM::write::template subordinate<> axiM_write;
+  typename axiS::read::template manager<> axiS_read;
+  typename axiS::write::template manager<> axiS_write;
+
+ private:
+  Connections::Combinational<BurstInfo> rd_info;
+  Connections::Combinational<BurstInfo> wr_info;
+  FIFO<BurstInfo, maxOutstanding> rd_q;
+  FIFO<BurstInfo, maxOutstanding> wr_q;
+
+ public:
+  AxiWidthConverter(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axiM_read("axiM_read"),
+        axiM_write("axiM_write"),
+        axiS_read("axiS_read"),
+        axiS_write("axiS_write"),
+        rd_info("rd_info"),
+        wr_info("wr_info") {
+    SC_THREAD(run_ar);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_r);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_aw);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_w);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_b);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ private:
+  static BurstInfo burst_info(typename axiM::AddrPayload& req) {
+    NVHLS_ASSERT_MSG((req.addr & (P::narrowBytes - 1)) == 0,
+                     "Manager address must be aligned to its data width");
+    if (axiM::ASIZE_WIDTH > 0) {
+      NVHLS_ASSERT_MSG(req.size.to_uint64() == P::log2NarrowBytes,
+                       "Narrow manager beats must use the full data width");
+    }
+    BurstInfo info;
+    info.lane = nvhls::get_slc<P::log2Ratio>(req.addr, P::log2NarrowBytes);
+    info.len = (axiM::ALEN_WIDTH > 0) ? req.len.to_uint64() : 0;
+    return info;
+  }
+
+  // The wide burst covering the same bytes as the narrow one
+  static typename axiS::AddrPayload wide_request(const typename axiM::AddrPayload& req,
+                                                 const BurstInfo& info) {
+    typename axiS::AddrPayload wide;
+    wide.id = req.id;
+    wide.addr = (req.addr >> P::log2WideBytes) << P::log2WideBytes;
+    NVUINTW(countWidth) len = (info.len + info.lane) >> P::log2Ratio;
+    NVHLS_ASSERT_MSG(len < CfgSubordinate::maxBurstSize,
+                     "Wide burst is longer than the subordinate maxBurstSize");
+    if (axiS::ALEN_WIDTH > 0) {
+      wide.len = len;
+    }
+    if (axiS::ASIZE_WIDTH > 0) {
+      wide.size = P::log2WideBytes;
+    }
+    if (axiS::BURST_WIDTH > 0) {
+      wide.burst = axiS::Enc::AXBURST::INCR;
+    }
+    return wide;
+  }
+
+  void run_ar() {
+    axiM_read.ar.Reset();
+    axiS_read.ar.Reset();
+    rd_info.ResetWrite();
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+      typename axiM::AddrPayload AR;
+      if (axiM_read.ar.PopNB(AR)) {
+        BurstInfo info = burst_info(AR);
+        axiS_read.ar.Push(wide_request(AR, info));
+        rd_info.Push(info);
+        CDCOUT(sc_time_stamp() << " " << name() << " Upsized read request:"
+                      << " request=[" << AR << "]"
+                      << endl, kDebugLevel);
+      }
+    }
+  }
+
+  void run_r() {
+    axiM_read.r.Reset();
+    axiS_read.r.Reset();
+    rd_info.ResetRead();
+    rd_q.reset();
+
+    BurstInfo info;
+    bool active = false;
+    bool have_beat = false;
+    typename axiS::ReadPayload R_wide;
+    Lane lane = 0;
+    NVUINTW(countWidth) count = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!rd_q.isFull()) {
+        BurstInfo in;
+        if (rd_info.PopNB(in)) {
+          rd_q.push(in);
+        }
+      }
+
+      if (!active && !rd_q.isEmpty()) {
+        info = rd_q.pop();
+        lane = info.lane;
+        count = 0;
+        active = true;
+      }
+
+      if (active && !have_beat) {
+        have_beat = axiS_read.r.PopNB(R_wide);
+      }
+
+      if (have_beat) {
+        bool last = (count == info.len);
+        typename axiM::ReadPayload R;
+        R.id = R_wide.id;
+        R.data = nvhls::get_slc<P::narrowWidth>(R_wide.data, lane * P::narrowWidth);
+        R.resp = R_wide.resp;
+        R.last = last;
+        if (axiM_read.r.PushNB(R)) {
+          if (last || lane == P::ratio - 1) {
+            have_beat = false;
+          }
+          if (last) {
+            active = false;
+          }
+          lane++;
+          count++;
+        }
+      }
+    }
+  }
+
+  void run_aw() {
+    axiM_write.aw.Reset();
+    axiS_write.aw.Reset();
+    wr_info.ResetWrite();
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+      typename axiM::AddrPayload AW;
+      if (axiM_write.aw.PopNB(AW)) {
+        BurstInfo info = burst_info(AW);
+        axiS_write.aw.Push(wide_request(AW, info));
+        wr_info.Push(info);
+        CDCOUT(sc_time_stamp() << " " << name() << " Upsized write request:"
+                      << " request=[" << AW << "]"
+                      << endl, kDebugLevel);
+      }
+    }
+  }
+
+  void run_w() {
+    axiM_write.w.Reset();
+    axiS_write.w.Reset();
+    wr_info.ResetRead();
+    wr_q.reset();
+
+    BurstInfo info;
+    bool active = false;
+    bool pending = false;
+    typename axiS::Data data = 0;
+    typename axiS::Wstrb strb = 0;
+    typename axiS::WritePayload W_wide;
+    Lane lane = 0;
+    NVUINTW(countWidth) count = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (pending) {
+        if (axiS_write.w.PushNB(W_wide)) {
+          pending = false;
+        }
+      }
+
+      if (!wr_q.isFull()) {
+        BurstInfo in;
+        if (wr_info.PopNB(in)) {
+          wr_q.push(in);
+        }
+      }
+
+      if (!active && !wr_q.isEmpty()) {
+        info = wr_q.pop();
+        lane = info.lane;
+        count = 0;
+        active = true;
+      }
+
+      if (active && !pending) {
+        typename axiM::WritePayload W;
+        if (axiM_write.w.PopNB(W)) {
+          bool last = (count == info.len);
+          data = nvhls::set_slc(data, W.data, lane * P::narrowWidth);
+          #pragma hls_unroll yes
+          for (int i = 0; i < P::narrowBytes; i++) {
+            bool s = (axiM::WSTRB_WIDTH == 0) || W.wstrb[i];
+            strb[lane * P::narrowBytes + i] = s;
+          }
+          if (last || lane == P::ratio - 1) {
+            W_wide.data = data;
+            W_wide.wstrb = strb;
+            W_wide.last = last;
+            data = 0;
+            strb = 0;
+            pending = true;
+          }
+          if (last) {
+            active = false;
+          }
+          lane++;
+          count++;
+        }
+      }
+    }
+  }
+
+  void run_b() {
+    axiM_write.b.Reset();
+    axiS_write.b.Reset();
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+      if (CfgManager::useWriteResponses) {
+        typename axiS::WRespPayload B_wide;
+        if (axiS_write.b.PopNB(B_wide)) {
+          typename axiM::WRespPayload B;
+          B.id = B_wide.id;
+          B.resp = B_wide.resp;
+          axiM_write.b.Push(B);
+        }
+      }
+    }
+  }
+};
+
+/**
+ * \brief Downsizing AxiWidthConverter: a wide manager split onto a narrow subordinate.
+ * \ingroup AXI
+ */
+template <typename CfgManager, typename CfgSubordinate, int maxOutstanding>
+class AxiWidthConverter<CfgManager, CfgSubordinate, maxOutstanding, false>
+    : public sc_module {
+  SC_HAS_PROCESS(AxiWidthConverter);
+  typedef axi::axi4<CfgManager> axiM;
+  typedef axi::axi4<CfgSubordinate> axiS;
+  typedef axi::width_converter::Params<CfgSubordinate, CfgManager> P;
+  typedef typename P::Lane Lane;
+
+  static const int maxNarrowBurst = CfgSubordinate::maxBurstSize;
+  static_assert(maxNarrowBurst == (1 << nvhls::log2_ceil<maxNarrowBurst>::val),
+                "Subordinate maxBurstSize must be a power of 2");
+
+ public:
+  static const int kDebugLevel = 5;
+  static const int countWidth = nvhls::index_width<CfgManager::maxBurstSize * P::ratio>::val;
+  typedef axi::width_converter::BurstInfo<P::log2Ratio, countWidth> BurstInfo;
+  typedef NVUINTW(countWidth) Count;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axiM::read::template subordinate<> axiM_read;
+  typename axiM::write::template subordinate<> axiM_write;
+  typename axiS::read::template manager<> axiS_read;
+  typename axiS::write::template manager<> axiS_write;
+
+ private:
+  Connections::Combinational<BurstInfo> rd_info;
+  Connections::Combinational<BurstInfo> wr_info;
+  Connections::Combinational<Count> wr_bursts;  // narrow bursts per wide burst, minus one
+  FIFO<BurstInfo, maxOutstanding> rd_q;
+  FIFO<BurstInfo, maxOutstanding> wr_q;
+  FIFO<Count, maxOutstanding> b_q;
+
+ public:
+  AxiWidthConverter(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axiM_read("axiM_read"),
+        axiM_write("axiM_write"),
+        axiS_read("axiS_read"),
+        axiS_write("axiS_write"),
+        rd_info("rd_info"),
+        wr_info("wr_info"),
+        wr_bursts("wr_bursts") {
+    SC_THREAD(run_ar);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_r);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_aw);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_w);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+
+    SC_THREAD(run_b);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ private:
+  static BurstInfo burst_info(typename axiM::AddrPayload& req) {
+    NVHLS_ASSERT_MSG((req.addr & (P::narrowBytes - 1)) == 0,
+                     "Manager address must be aligned to the subordinate data width");
+    if (axiM::ASIZE_WIDTH > 0) {
+      NVHLS_ASSERT_MSG(req.size.to_uint64() == P::log2WideBytes,
+                       "Wide manager beats must use the full data width");
+    }
+    BurstInfo info;
+    info.lane = nvhls::get_slc<P::log2Ratio>(req.addr, P::log2NarrowBytes);
+    Count wide_len = (axiM::ALEN_WIDTH > 0) ? req.len.to_uint64() : 0;
+    info.len = (wide_len << P::log2Ratio) + (P::ratio - 1) - info.lane;
+    return info;
+  }
+
+  // The next narrow burst of a split wide burst, of at most maxNarrowBurst beats
+  static typename axiS::AddrPayload narrow_request(const typename axiM::AddrPayload& req,
+                                                   const typename axiM::Addr& addr,
+                                                   const Count& len) {
+    typename axiS::AddrPayload narrow;
+    narrow.id = req.id;
+    narrow.addr = addr;
+    if (axiS::ALEN_WIDTH > 0) {
+      narrow.len = len;
+    }
+    if (axiS::ASIZE_WIDTH > 0) {
+      narrow.size = P::log2NarrowBytes;
+    }
+    if (axiS::BURST_WIDTH > 0) {
+      narrow.burst = axiS::Enc::AXBURST::INCR;
+    }
+    return narrow;
+  }
+
+  static Count narrow_len(const Count& remaining) {
+    return (remaining < maxNarrowBurst) ? remaining : Count(maxNarrowBurst - 1);
+  }
+
+  void run_ar() {
+    axiM_read.ar.Reset();
+    axiS_read.ar.Reset();
+    rd_info.ResetWrite();
+
+    bool active = false;
+    typename axiM::AddrPayload AR;
+    typename axiM::Addr addr = 0;
+    Count remaining = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!active) {
+        if (axiM_read.ar.PopNB(AR)) {
+          BurstInfo info = burst_info(AR);
+          rd_info.Push(info);
+          addr = AR.addr;
+          remaining = info.len;
+          active = true;
+          CDCOUT(sc_time_stamp() << " " << name() << " Downsized read request:"
+                        << " request=[" << AR << "]"
+                        << endl, kDebugLevel);
+        }
+      }
+
+      if (active) {
+        Count len = narrow_len(remaining);
+        if (axiS_read.ar.PushNB(narrow_request(AR, addr, len))) {
+          addr += (static_cast<typename axiM::Addr>(len) + 1) << P::log2NarrowBytes;
+          if (remaining == len) {
+            active = false;
+          } else {
+            remaining -= len + 1;
+          }
+        }
+      }
+    }
+  }
+
+  void run_r() {
+    axiM_read.r.Reset();
+    axiS_read.r.Reset();
+    rd_info.ResetRead();
+    rd_q.reset();
+
+    BurstInfo info;
+    bool active = false;
+    bool pending = false;
+    typename axiM::Data data = 0;
+    typename axiM::Resp resp = 0;
+    typename axiM::ReadPayload R_wide;
+    Lane lane = 0;
+    Count count = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (pending) {
+        if (axiM_read.r.PushNB(R_wide)) {
+          pending = false;
+        }
+      }
+
+      if (!rd_q.isFull()) {
+        BurstInfo in;
+        if (rd_info.PopNB(in)) {
+          rd_q.push(in);
+        }
+      }
+
+      if (!active && !rd_q.isEmpty()) {
+        info = rd_q.pop();
+        lane = info.lane;
+        count = 0;
+        active = true;
+      }
+
+      if (active && !pending) {
+        typename axiS::ReadPayload R;
+        if (axiS_read.r.PopNB(R)) {
+          bool last = (count == info.len);
+          data = nvhls::set_slc(data, R.data, lane * P::narrowWidth);
+          if (R.resp > resp) {
+            resp = R.resp;
+          }
+          if (last || lane == P::ratio - 1) {
+            R_wide.id = R.id;
+            R_wide.data = data;
+            R_wide.resp = resp;
+            R_wide.last = last;
+            data = 0;
+            resp = 0;
+            pending = true;
+          }
+          if (last) {
+            active = false;
+          }
+          lane++;
+          count++;
+        }
+      }
+    }
+  }
+
+  void run_aw() {
+    axiM_write.aw.Reset();
+    axiS_write.aw.Reset();
+    wr_info.ResetWrite();
+    wr_bursts.ResetWrite();
+
+    bool active = false;
+    typename axiM::AddrPayload AW;
+    typename axiM::Addr addr = 0;
+    Count remaining = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!active) {
+        if (axiM_write.aw.PopNB(AW)) {
+          BurstInfo info = burst_info(AW);
+          wr_info.Push(info);
+          if (CfgManager::useWriteResponses) {
+            wr_bursts.Push(info.len >> nvhls::log2_ceil<maxNarrowBurst>::val);
+          }
+          addr = AW.addr;
+          remaining = info.len;
+          active = true;
+          CDCOUT(sc_time_stamp() << " " << name() << " Downsized write request:"
+                        << " request=[" << AW << "]"
+                        << endl, kDebugLevel);
+        }
+      }
+
+      if (active) {
+        Count len = narrow_len(remaining);
+        if (axiS_write.aw.PushNB(narrow_request(AW, addr, len))) {
+          addr += (static_cast<typename axiM::Addr>(len) + 1) << P::log2NarrowBytes;
+          if (remaining == len) {
+            active = false;
+          } else {
+            remaining -= len + 1;
+          }
+        }
+      }
+    }
+  }
+
+  void run_w() {
+    axiM_write.w.Reset();
+    axiS_write.w.Reset();
+    wr_info.ResetRead();
+    wr_q.reset();
+
+    BurstInfo info;
+    bool active = false;
+    bool have_beat = false;
+    typename axiM::WritePayload W_wide;
+    Lane lane = 0;
+    Count count = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!wr_q.isFull()) {
+        BurstInfo in;
+        if (wr_info.PopNB(in)) {
+          wr_q.push(in);
+        }
+      }
+
+      if (!active && !wr_q.isEmpty()) {
+        info = wr_q.pop();
+        lane = info.lane;
+        count = 0;
+        active = true;
+      }
+
+      if (active && !have_beat) {
+        have_beat = axiM_write.w.PopNB(W_wide);
+      }
+
+      if (have_beat) {
+        bool last = (count == info.len);
+        typename axiS::WritePayload W;
+        W.data = nvhls::get_slc<P::narrowWidth>(W_wide.data, lane * P::narrowWidth);
+        #pragma hls_unroll yes
+        for (int i = 0; i < P::narrowBytes; i++) {
+          bool s = (axiM::WSTRB_WIDTH == 0) || W_wide.wstrb[lane * P::narrowBytes + i];
+          if (axiS::WSTRB_WIDTH > 0) {
+            W.wstrb[i] = s;
+          } else {
+            NVHLS_ASSERT_MSG(s, "Partial write strobes cannot be forwarded to a subordinate without write strobes");
+          }
+        }
+        W.last = last || ((count & (maxNarrowBurst - 1)) == maxNarrowBurst - 1);
+        if (axiS_write.w.PushNB(W)) {
+          if (last || lane == P::ratio - 1) {
+            have_beat = false;
+          }
+          if (last) {
+            active = false;
+          }
+          lane++;
+          count++;
+        }
+      }
+    }
+  }
+
+  void run_b() {
+    axiM_write.b.Reset();
+    axiS_write.b.Reset();
+    wr_bursts.ResetRead();
+    b_q.reset();
+
+    bool active = false;
+    bool pending = false;
+    Count bursts = 0;
+    Count count = 0;
+    typename axiM::Resp resp = 0;
+    typename axiM::WRespPayload B_wide;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (CfgManager::useWriteResponses) {
+        if (pending) {
+          if (axiM_write.b.PushNB(B_wide)) {
+            pending = false;
+          }
+        }
+
+        if (!b_q.isFull()) {
+          Count in;
+          if (wr_bursts.PopNB(in)) {
+            b_q.push(in);
+          }
+        }
+
+        if (!active && !b_q.isEmpty()) {
+          bursts = b_q.pop();
+          count = 0;
+          resp = 0;
+          active = true;
+        }
+
+        if (active && !pending) {
+          typename axiS::WRespPayload B;
+          if (axiS_write.b.PopNB(B)) {
+            if (B.resp > resp) {
+              resp = B.resp;
+            }
+            if (count == bursts) {
+              B_wide.id = B.id;
+              B_wide.resp = resp;
+              pending = true;
+              active = false;
+            }
+            count++;
+          }
+        }
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXIS_PACKET_FIFO_H__
+#define __AXIS_PACKET_FIFO_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <fifo.h>
+#include <axi/axis.h>
+
+/**
+ * \brief A FIFO for AXI-Stream packets, with store-and-forward or cut-through forwarding.
+ * \ingroup AXI
+ *
+ * \tparam Cfg              A valid AXI-Stream config.
+ * \tparam depth            The number of transfers the FIFO can hold.
+ * \tparam storeAndForward  If true, hold each packet until its TLAST transfer has arrived (default: true).
+ *
+ * \par Overview
+ * AxisPacketFifo buffers up to depth transfers and moves one transfer per
+ * cycle in and out.
+ * - In cut-through mode it is a plain FIFO: a transfer can leave as soon as
+ *   it is at the head.
+ * - In store-and-forward mode it counts packets whose TLAST transfer has been
+ *   received, and only sends from the head while that count is non-zero. The
+ *   output then never stalls in the middle of a packet because of the input.
+ *   Packets must be no longer than depth transfers.
+ * - Without TLAST every transfer is a packet of its own, so both modes behave
+ *   the same.
+ *
+ * \par Usage Guidelines
+ *
+ * This module sets the stall mode to flush by default to mitigate possible RTL
+ * bugs that can occur in the default stall mode. If you are confident that
+ * this class of bugs will not occur in your use case, you can change the stall
+ * mode via TCL directive:
+ *
+ * \code
+ * directive set /path/to/AxisPacketFifo/run/while -PIPELINE_STALL_MODE stall
+ * \endcode
+ *
+ * This may reduce area/power.
+ * \par A Simple Example
+ * \code
+ *      AxisPacketFifo<axi::cfg::stream::standard, 64> pkt_fifo;
+ *      ...
+ *      pkt_fifo.clk(clk);
+ *      pkt_fifo.reset_bar(reset_bar);
+ *      pkt_fifo.axisM(in_stream);
+ *      pkt_fifo.axisS(out_stream);
+ * \endcode
+ * \par
+ *
+ */
+template <typename Cfg, int depth, bool storeAndForward = true>
+class AxisPacketFifo : public sc_module {
+  SC_HAS_PROCESS(AxisPacketFifo);
+  typedef axi::axis<Cfg> axis_;
+
+  static_assert(depth > 0, "FIFO depth must be positive");
+
+ public:
+  static const int kDebugLevel = 5;
+  typedef NVUINTW(nvhls::index_width<depth + 1>::val) PacketCount;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axis_::template subordinate<> axisM;
+  typename axis_::template manager<> axisS;
+
+ private:
+  FIFO<typename axis_::Payload, depth> fifo;
+
+ public:
+  AxisPacketFifo(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axisM("axisM"),
+        axisS("axisS") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ protected:
+  static bool is_last(typename axis_::Payload& beat) {
+    return (axis_::LAST_WIDTH == 0) || (beat.last.to_uint64() == 1);
+  }
+
+  void run() {
+    axisM.reset();
+    axisS.reset();
+    fifo.reset();
+
+    // Packets in the FIFO whose TLAST transfer has arrived
+    PacketCount complete = 0;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      bool fifo_full = fifo.isFull();
+      PacketCount complete_local = complete;
+
+      NVHLS_ASSERT_MSG(!storeAndForward || !fifo_full || complete_local != 0,
+                       "Packet is longer than the store-and-forward FIFO");
+
+      if (!fifo.isEmpty() && (!storeAndForward || complete_local != 0)) {
+        typename axis_::Payload beat = fifo.peek();
+        if (axisS.nb_twrite(beat)) {
+          fifo.incrHead();
+          if (is_last(beat)) {
+            complete_local--;
+          }
+        }
+      }
+
+      if (!fifo_full) {
+        typename axis_::Payload beat;
+        if (axisM.nb_tread(beat)) {
+          fifo.push(beat);
+          if (is_last(beat)) {
+            complete_local++;
+          }
+        }
+      }
+
+      complete = complete_local;
+    }
+  }
+};
+
+#endif
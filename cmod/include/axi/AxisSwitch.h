@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXIS_SWITCH_H__
+#define __AXIS_SWITCH_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <nvhls_array.h>
+#include <arbitrated_crossbar.h>
+#include <axi/axis.h>
+
+/**
+ * \brief An AXI-Stream switch that routes packets by TDEST.
+ * \ingroup AXI
+ *
+ * \tparam Cfg          A valid AXI-Stream config.
+ * \tparam numInputs    The number of input streams.
+ * \tparam numOutputs   The number of output streams.
+ *
+ * \par Overview
+ * AxisSwitch forwards each packet from one of numInputs input streams to the
+ * output stream selected by its TDEST, which must be less than numOutputs.
+ * Routing is done by an ArbitratedCrossbar without input or output queues, so
+ * every input and output port moves one transfer per cycle.
+ * - Outputs arbitrate round-robin between inputs at packet boundaries. Once an
+ *   input wins an output, the output stays locked to it until the TLAST
+ *   transfer, so packets from different inputs are never interleaved.
+ * - TDEST must be constant within a packet. Without TLAST each transfer is
+ *   arbitrated on its own.
+ * - Each port has a one-transfer register, so a transfer takes two cycles from
+ *   input to output.
+ *
+ * \par Usage Guidelines
+ *
+ * This module sets the stall mode to flush by default to mitigate possible RTL
+ * bugs that can occur in the default stall mode. If you are confident that
+ * this class of bugs will not occur in your use case, you can change the stall
+ * mode via TCL directive:
+ *
+ * \code
+ * directive set /path/to/AxisSwitch/run/while -PIPELINE_STALL_MODE stall
+ * \endcode
+ *
+ * This may reduce area/power.
+ * \par A Simple Example
+ * \code
+ *      AxisSwitch<axi::cfg::stream::standard, 2, 4> axis_switch;
+ *      ...
+ *      axis_switch.clk(clk);
+ *      axis_switch.reset_bar(reset_bar);
+ *      for (int i = 0; i < 2; i++)
+ *        axis_switch.axis_m[i](in_stream[i].t);
+ *      for (int i = 0; i < 4; i++)
+ *        axis_switch.axis_s[i](out_stream[i].t);
+ * \endcode
+ * \par
+ *
+ */
+template <typename Cfg, int numInputs, int numOutputs>
+class AxisSwitch : public sc_module {
+  SC_HAS_PROCESS(AxisSwitch);
+  typedef axi::axis<Cfg> axis_;
+  typedef typename axis_::Payload Payload;
+  typedef ArbitratedCrossbar<Payload, numInputs, numOutputs, 0, 0> Crossbar;
+  typedef typename Crossbar::InputIdx InputIdx;
+  typedef typename Crossbar::OutputIdx OutputIdx;
+
+  static_assert(numOutputs == 1 || (1 << axis_::DEST_WIDTH) >= numOutputs,
+                "TDEST is too narrow to address every output");
+
+ public:
+  static const int kDebugLevel = 5;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typedef typename axis_::template subordinate<>::TPort axis_subordinate_t;
+  typedef typename axis_::template manager<>::TPort axis_manager_t;
+
+  // Like AxiArbiter, arrays of the bare ports rather than the wrapper classes
+  nvhls::nv_array<axis_subordinate_t, numInputs> axis_m;
+  nvhls::nv_array<axis_manager_t, numOutputs> axis_s;
+
+ private:
+  Crossbar xbar;
+
+ public:
+  AxisSwitch(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axis_m("axis_m"),
+        axis_s("axis_s") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ protected:
+  void run() {
+#pragma hls_unroll yes
+    for (int i = 0; i < numInputs; i++) {
+      axis_m[i].Reset();
+    }
+#pragma hls_unroll yes
+    for (int i = 0; i < numOutputs; i++) {
+      axis_s[i].Reset();
+    }
+    xbar.reset();
+
+    nvhls::nv_array<Payload, numInputs> in_reg;
+    bool in_valid[numInputs];
+    nvhls::nv_array<Payload, numOutputs> out_reg;
+    bool out_valid[numOutputs];
+    // An output locked to an input stays with it until TLAST
+    bool locked[numOutputs];
+    InputIdx owner[numOutputs];
+
+#pragma hls_unroll yes
+    for (int i = 0; i < numInputs; i++) {
+      in_valid[i] = false;
+    }
+#pragma hls_unroll yes
+    for (int i = 0; i < numOutputs; i++) {
+      out_valid[i] = false;
+      locked[i] = false;
+      owner[i] = 0;
+    }
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+#pragma hls_unroll yes
+      for (int i = 0; i < numOutputs; i++) {
+        if (out_valid[i]) {
+          out_valid[i] = !axis_s[i].PushNB(out_reg[i]);
+        }
+      }
+
+#pragma hls_unroll yes
+      for (int i = 0; i < numInputs; i++) {
+        if (!in_valid[i]) {
+          in_valid[i] = axis_m[i].PopNB(in_reg[i]);
+        }
+      }
+
+      // An input requests its output only if the output register is free and
+      // the output is not locked to another input
+      Payload data_in[numInputs];
+      OutputIdx dest_in[numInputs];
+      bool valid_in[numInputs];
+#pragma hls_unroll yes
+      for (int i = 0; i < numInputs; i++) {
+        data_in[i] = in_reg[i];
+        dest_in[i] = (numOutputs == 1) ? 0 : in_reg[i].dest.to_uint64();
+        NVHLS_ASSERT_MSG(!in_valid[i] || dest_in[i] < numOutputs, "TDEST is out of range");
+        valid_in[i] = in_valid[i] && !out_valid[dest_in[i]] &&
+                      (!locked[dest_in[i]] || owner[dest_in[i]] == i);
+      }
+
+      Payload data_out[numOutputs];
+      bool valid_out[numOutputs];
+      bool ready[numInputs];
+      InputIdx source[numOutputs];
+      xbar.run(data_in, dest_in, valid_in, data_out, valid_out, ready, source);
+
+#pragma hls_unroll yes
+      for (int i = 0; i < numOutputs; i++) {
+        if (valid_out[i]) {
+          out_reg[i] = data_out[i];
+          out_valid[i] = true;
+          locked[i] = (axis_::LAST_WIDTH > 0) && (data_out[i].last.to_uint64() == 0);
+          owner[i] = source[i];
+        }
+      }
+
+#pragma hls_unroll yes
+      for (int i = 0; i < numInputs; i++) {
+        if (ready[i]) {
+          in_valid[i] = false;
+        }
+      }
+    }
+  }
+};
+
+#endif
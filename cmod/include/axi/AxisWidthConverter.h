@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXIS_WIDTH_CONVERTER_H__
+#define __AXIS_WIDTH_CONVERTER_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <axi/axis.h>
+
+/**
+ * \brief Connects an AXI-Stream manager to an AXI-Stream subordinate with a different data width.
+ * \ingroup AXI
+ *
+ * \tparam CfgManager      A valid AXI-Stream config describing the input port.
+ * \tparam CfgSubordinate  A valid AXI-Stream config describing the output port.
+ *
+ * \par Overview
+ * AxisWidthConverter packs or unpacks transfers between two AXI-Stream configs
+ * whose data widths differ by a power of 2. The direction follows from the
+ * configs, and both directions move one narrow transfer per cycle:
+ * - Upsizing (narrow input, wide output): consecutive narrow transfers fill the
+ *   lanes of a wide transfer, lowest lane first. A transfer with TLAST closes
+ *   the wide transfer early, and its unused lanes are null bytes (TKEEP low).
+ *   Without TKEEP on the output, packets must fill whole wide transfers.
+ * - Downsizing (wide input, narrow output): each wide transfer is split into
+ *   narrow transfers, lowest lane first. Trailing lanes that only hold null
+ *   bytes are dropped, and TLAST goes on the last narrow transfer sent.
+ * - TID, TDEST and TUSER must have the same widths on both ports. They are
+ *   copied from the input transfer; an upsized transfer takes them from the
+ *   last narrow transfer packed into it.
+ *
+ * \par Usage Guidelines
+ *
+ * This module sets the stall mode to flush by default to mitigate possible RTL
+ * bugs that can occur in the default stall mode. If you are confident that
+ * this class of bugs will not occur in your use case, you can change the stall
+ * mode via TCL directive:
+ *
+ * \code
+ * directive set /path/to/AxisWidthConverter/run/while -PIPELINE_STALL_MODE stall
+ * \endcode
+ *
+ * This may reduce area/power.
+ * \par A Simple Example
+ * \code
+ *      // 64-bit stream onto a 256-bit datapath
+ *      AxisWidthConverter<axi::cfg::stream::standard, axi::cfg::stream::wide> upsizer;
+ *      ...
+ *      upsizer.clk(clk);
+ *      upsizer.reset_bar(reset_bar);
+ *      upsizer.axisM(narrow_stream);
+ *      upsizer.axisS(wide_stream);
+ * \endcode
+ * \par
+ *
+ */
+template <typename CfgManager, typename CfgSubordinate,
+          bool upsize = (static_cast<int>(CfgManager::dataWidth) <
+                         static_cast<int>(CfgSubordinate::dataWidth))>
+class AxisWidthConverter;
+
+namespace axi {
+namespace axis_width_converter {
+
+/**
+ * \brief Constants and checks shared by both directions of AxisWidthConverter.
+ */
+template <typename CfgNarrow, typename CfgWide>
+struct Params {
+  typedef axi::axis<CfgNarrow> narrow;
+  typedef axi::axis<CfgWide> wide;
+
+  static const int narrowWidth = CfgNarrow::dataWidth;
+  static const int wideWidth = CfgWide::dataWidth;
+  static const int ratio = wideWidth / narrowWidth;
+  static const int log2Ratio = nvhls::log2_ceil<ratio>::val;
+  static const int narrowBytes = narrowWidth >> 3;
+  static const int wideBytes = wideWidth >> 3;
+
+  static_assert(wideWidth % narrowWidth == 0 && ratio == (1 << log2Ratio) && ratio > 1,
+                "Data widths must differ by a power of 2");
+  static_assert(static_cast<int>(narrow::ID_WIDTH) == static_cast<int>(wide::ID_WIDTH),
+                "TID widths must match");
+  static_assert(static_cast<int>(narrow::DEST_WIDTH) == static_cast<int>(wide::DEST_WIDTH),
+                "TDEST widths must match");
+  static_assert(static_cast<int>(narrow::USER_WIDTH) == static_cast<int>(wide::USER_WIDTH),
+                "TUSER widths must match");
+  static_assert(static_cast<int>(narrow::LAST_WIDTH) == static_cast<int>(wide::LAST_WIDTH),
+                "Both configs must agree on TLAST");
+
+  typedef NVUINTW(log2Ratio) Lane;
+  typedef NVUINTW(wideBytes) WideKeep;
+  typedef NVUINTW(narrowBytes) NarrowKeep;
+};
+
+}  // namespace axis_width_converter
+}  // namespace axi
+
+/**
+ * \brief Upsizing AxisWidthConverter.
+ */
+template <typename CfgManager, typename CfgSubordinate>
+class AxisWidthConverter<CfgManager, CfgSubordinate, true> : public sc_module {
+  SC_HAS_PROCESS(AxisWidthConverter);
+  typedef axi::axis<CfgManager> axisM_;
+  typedef axi::axis<CfgSubordinate> axisS_;
+  typedef axi::axis_width_converter::Params<CfgManager, CfgSubordinate> P;
+  typedef typename P::Lane Lane;
+
+ public:
+  static const int kDebugLevel = 5;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axisM_::template subordinate<> axisM;
+  typename axisS_::template manager<> axisS;
+
+  AxisWidthConverter(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axisM("axisM"),
+        axisS("axisS") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ protected:
+  void run() {
+    axisM.reset();
+    axisS.reset();
+
+    Lane lane = 0;
+    typename axisS_::Data data = 0;
+    typename P::WideKeep keep = 0;
+    typename axisS_::Payload wide_beat;
+    bool pending = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!pending) {
+        typename axisM_::Payload beat;
+        if (axisM.nb_tread(beat)) {
+          bool last = (axisM_::LAST_WIDTH > 0) && (beat.last.to_uint64() == 1);
+          data = nvhls::set_slc(data, beat.data, lane * P::narrowWidth);
+          #pragma hls_unroll yes
+          for (int i = 0; i < P::narrowBytes; i++) {
+            keep[lane * P::narrowBytes + i] = (axisM_::KEEP_WIDTH == 0) || beat.keep[i];
+          }
+          if (last || lane == P::ratio - 1) {
+            NVHLS_ASSERT_MSG(axisS_::KEEP_WIDTH > 0 || lane == P::ratio - 1,
+                             "Packets must fill whole output transfers without TKEEP on the output");
+            wide_beat.data = data;
+            wide_beat.keep = keep;
+            wide_beat.last = beat.last;
+            wide_beat.id = beat.id;
+            wide_beat.dest = beat.dest;
+            wide_beat.user = beat.user;
+            data = 0;
+            keep = 0;
+            lane = 0;
+            pending = true;
+          } else {
+            lane++;
+          }
+        }
+      }
+
+      if (pending) {
+        pending = !axisS.nb_twrite(wide_beat);
+      }
+    }
+  }
+};
+
+/**
+ * \brief Downsizing AxisWidthConverter.
+ */
+template <typename CfgManager, typename CfgSubordinate>
+class AxisWidthConverter<CfgManager, CfgSubordinate, false> : public sc_module {
+  SC_HAS_PROCESS(AxisWidthConverter);
+  typedef axi::axis<CfgManager> axisM_;
+  typedef axi::axis<CfgSubordinate> axisS_;
+  typedef axi::axis_width_converter::Params<CfgSubordinate, CfgManager> P;
+  typedef typename P::Lane Lane;
+
+ public:
+  static const int kDebugLevel = 5;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axisM_::template subordinate<> axisM;
+  typename axisS_::template manager<> axisS;
+
+  AxisWidthConverter(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axisM("axisM"),
+        axisS("axisS") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ protected:
+  void run() {
+    axisM.reset();
+    axisS.reset();
+
+    Lane lane = 0;
+    typename axisM_::Payload wide_beat;
+    typename P::WideKeep keep = 0;
+    bool have_beat = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      if (!have_beat) {
+        have_beat = axisM.nb_tread(wide_beat);
+        lane = 0;
+        #pragma hls_unroll yes
+        for (int i = 0; i < P::wideBytes; i++) {
+          keep[i] = (axisM_::KEEP_WIDTH == 0) || wide_beat.keep[i];
+        }
+      }
+
+      if (have_beat) {
+        // Later lanes holding only null bytes are dropped
+        bool more = false;
+        #pragma hls_unroll yes
+        for (int i = 0; i < P::wideBytes; i++) {
+          if (i >= (lane + 1) * P::narrowBytes && keep[i]) {
+            more = true;
+          }
+        }
+        bool last = (axisM_::LAST_WIDTH > 0) && (wide_beat.last.to_uint64() == 1) && !more;
+
+        typename axisS_::Payload beat;
+        beat.data = nvhls::get_slc<P::narrowWidth>(wide_beat.data, lane * P::narrowWidth);
+        beat.keep = nvhls::get_slc<P::narrowBytes>(keep, lane * P::narrowBytes);
+        NVHLS_ASSERT_MSG(axisS_::KEEP_WIDTH > 0 ||
+                             nvhls::get_slc<P::narrowBytes>(keep, lane * P::narrowBytes).and_reduce(),
+                         "Null bytes cannot be forwarded to an output without TKEEP");
+        beat.last = last;
+        beat.id = wide_beat.id;
+        beat.dest = wide_beat.dest;
+        beat.user = wide_beat.user;
+        if (axisS.nb_twrite(beat)) {
+          if (more) {
+            lane++;
+          } else {
+            have_beat = false;
+          }
+        }
+      }
+    }
+  }
+};
+
+#endif
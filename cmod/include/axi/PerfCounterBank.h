@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __PERF_COUNTER_BANK_H__
+#define __PERF_COUNTER_BANK_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <nvhls_module.h>
+#include <axi/axi4.h>
+
+/**
+ * \brief A bank of event counters with snapshot, freeze, clear and an overflow interrupt, read over AXI-Lite.
+ * \ingroup AXI
+ *
+ * \tparam NumCounters  The number of counters, at most 32.
+ * \tparam Width        The width of each counter, at most 64 (default: 32).
+ * \tparam IncWidth     The width of each per-cycle increment (default: 1).
+ * \tparam liteCfg      The AXI config of the register port (default: axi::cfg::lite).
+ *
+ * \par Overview
+ * PerfCounterBank gives a block cheap event counters it can expose on
+ * silicon.  Each cycle, counter i adds the value of its event[i] input, an
+ * event flag with the default IncWidth of 1.
+ * - Controls: writing bit 0 of CTRL clears all counters and snapshots, bit
+ *   1 freezes the counters while it is set, and writing bit 2 copies every
+ *   counter into its snapshot in the same cycle, so that the snapshots can
+ *   be read as one consistent sample while the counters run on.  A write
+ *   takes effect before the events of that cycle are counted.
+ * - Overflow: a counter that wraps sets its bit in OVF_STATUS, which is
+ *   cleared by writing 1 to it.  The interrupt output is high while a
+ *   status bit is set whose OVF_ENABLE bit is set.
+ * - Registers: the liteCfg port maps one 32-bit word per register, from
+ *   address 0.  Counters wider than 32 bits take two words each, low word
+ *   first.  Other addresses return SLVERR.
+ *   | Word | Name | Access |
+ *   | ---- | ---- | ------ |
+ *   | 0 | CTRL | RW |
+ *   | 1 | INFO: NumCounters, Width << 16 | RO |
+ *   | 2 | OVF_STATUS | RW1C |
+ *   | 3 | OVF_ENABLE | RW |
+ *   | 8 + i * words | COUNTER[i] | RO |
+ *   | 8 + (NumCounters + i) * words | SNAPSHOT[i] | RO |
+ * - In C simulation every counted increment is also added to the
+ *   event_<i> match::Module stat, so the stats of a simulation and the
+ *   counters read from silicon line up.  Clearing the counters does not
+ *   clear the stats.
+ *
+ * \par A Simple Example
+ * \code
+ *      PerfCounterBank<4> counters;
+ *      sc_signal<NVUINTW(1)> miss;
+ *      ...
+ *      counters.clk(clk);
+ *      counters.rst(rst);
+ *      counters.event[0](miss);
+ *      ...
+ *      counters.interrupt(irq);
+ *      counters.if_rd(ctrl_rd);
+ *      counters.if_wr(ctrl_wr);
+ * \endcode
+ * \par
+ *
+ */
+template <int NumCounters, int Width = 32, int IncWidth = 1, typename liteCfg = axi::cfg::lite>
+class PerfCounterBank : public match::Module {
+ public:
+  static const int kDebugLevel = 5;
+  typedef typename axi::axi4<liteCfg> lite_;
+
+  static const int regWidth = lite_::DATA_WIDTH;
+  static const int wordsPerCounter = (Width > regWidth) ? 2 : 1;
+  static const int numRegs = 8 + 2 * NumCounters * wordsPerCounter;
+  static const int regIdxWidth = nvhls::index_width<numRegs>::val;
+
+  static_assert(NumCounters >= 1 && NumCounters <= 32, "NumCounters must be between 1 and 32");
+  static_assert(Width >= IncWidth && Width <= 64, "Width must be between IncWidth and 64");
+  static_assert(regWidth == 32, "The register port must be 32 bits wide");
+
+  enum {
+    kCtrl = 0,
+    kInfo,
+    kOvfStatus,
+    kOvfEnable,
+    kCounters = 8,
+    kSnapshots = 8 + NumCounters * wordsPerCounter,
+  };
+
+  enum {
+    kCtrlClear = 1,
+    kCtrlFreeze = 2,
+    kCtrlSnapshot = 4,
+  };
+
+  typedef NVUINTW(Width) Counter;
+  typedef NVUINTW(IncWidth) Inc;
+  typedef NVUINTW(regWidth) Reg;
+  typedef NVUINTW(NumCounters) Mask;
+
+  sc_in<Inc> event[NumCounters];
+  sc_out<bool> interrupt;
+
+  typename lite_::read::template subordinate<> if_rd;
+  typename lite_::write::template subordinate<> if_wr;
+
+ protected:
+  match::StatHandle event_stat;
+
+ public:
+  SC_HAS_PROCESS(PerfCounterBank);
+  PerfCounterBank(sc_module_name name_)
+      : match::Module(name_),
+        interrupt("interrupt"),
+        if_rd("if_rd"),
+        if_wr("if_wr") {
+    event_stat = this->RegisterStatIndexed("event", NumCounters);
+
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+ protected:
+  // Word w of counter c
+  static Reg word_of(Counter c, int w) {
+    if (wordsPerCounter == 1) {
+      return c;
+    }
+    return nvhls::get_slc<regWidth>(NVUINTW(64)(c), regWidth * w);
+  }
+
+  void run() {
+    if_rd.reset();
+    if_wr.reset();
+    interrupt.write(false);
+
+    Counter count[NumCounters];
+    Counter snapshot[NumCounters];
+    #pragma hls_unroll yes
+    for (int i = 0; i < NumCounters; i++) {
+      count[i] = 0;
+      snapshot[i] = 0;
+    }
+    Mask ovf_status = 0, ovf_enable = 0;
+    bool frozen = false;
+
+    typename lite_::AddrPayload ctrl_ar, ctrl_aw;
+    typename lite_::WritePayload ctrl_w;
+    typename lite_::ReadPayload ctrl_r;
+    typename lite_::WRespPayload ctrl_b;
+    bool ctrl_r_valid = false, ctrl_b_valid = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+
+      // Register writes
+      bool clear = false, take_snapshot = false;
+      if (ctrl_b_valid) {
+        ctrl_b_valid = !if_wr.nb_bwrite(ctrl_b);
+      }
+      if (!ctrl_b_valid && if_wr.nb_wread(ctrl_aw, ctrl_w)) {
+        NVUINTW(regIdxWidth) idx = nvhls::get_slc<regIdxWidth>(ctrl_aw.addr, 2);
+        bool writable = (ctrl_aw.addr >> 2) <= kOvfEnable && idx != kInfo;
+        if (writable && idx == kCtrl) {
+          clear = (ctrl_w.data & kCtrlClear) != 0;
+          frozen = (ctrl_w.data & kCtrlFreeze) != 0;
+          take_snapshot = (ctrl_w.data & kCtrlSnapshot) != 0;
+        } else if (writable && idx == kOvfStatus) {
+          ovf_status &= ~Mask(nvhls::get_slc<NumCounters>(ctrl_w.data, 0));
+        } else if (writable && idx == kOvfEnable) {
+          ovf_enable = nvhls::get_slc<NumCounters>(ctrl_w.data, 0);
+        }
+        CDCOUT(sc_time_stamp() << " " << name() << " Register write:"
+                      << " reg=" << idx
+                      << " data=" << hex << ctrl_w.data
+                      << endl, kDebugLevel);
+        ctrl_b.id = ctrl_aw.id;
+        ctrl_b.resp = writable ? lite_::Enc::XRESP::OKAY : lite_::Enc::XRESP::SLVERR;
+        ctrl_b_valid = !if_wr.nb_bwrite(ctrl_b);
+      }
+
+      // Counters
+      #pragma hls_unroll yes
+      for (int i = 0; i < NumCounters; i++) {
+        if (take_snapshot) {
+          snapshot[i] = count[i];
+        }
+        if (clear) {
+          count[i] = 0;
+          snapshot[i] = 0;
+        }
+        Inc inc = event[i].read();
+        if (!frozen && inc != 0) {
+          NVUINTW(Width + 1) sum = count[i];
+          sum += inc;
+          if (sum[Width] == 1) {
+            ovf_status[i] = 1;
+          }
+          count[i] = nvhls::get_slc<Width>(sum, 0);
+          this->IncrStatIndexed(event_stat, i, inc.to_uint64());
+        }
+      }
+      if (clear) {
+        ovf_status = 0;
+      }
+      interrupt.write((ovf_status & ovf_enable) != 0);
+
+      // Register reads
+      if (ctrl_r_valid) {
+        ctrl_r_valid = !if_rd.nb_rwrite(ctrl_r);
+      }
+      if (!ctrl_r_valid && if_rd.nb_aread(ctrl_ar)) {
+        NVUINTW(regIdxWidth) idx = nvhls::get_slc<regIdxWidth>(ctrl_ar.addr, 2);
+        bool in_range = (ctrl_ar.addr >> 2) < numRegs && (idx < 4 || idx >= kCounters);
+        Reg data = 0;
+        if (!in_range) {
+          data = 0;
+        } else if (idx >= kSnapshots) {
+          NVUINTW(regIdxWidth) k = idx - kSnapshots;
+          data = word_of(snapshot[k / wordsPerCounter], k % wordsPerCounter);
+        } else if (idx >= kCounters) {
+          NVUINTW(regIdxWidth) k = idx - kCounters;
+          data = word_of(count[k / wordsPerCounter], k % wordsPerCounter);
+        } else if (idx == kCtrl) {
+          data = frozen ? kCtrlFreeze : 0;
+        } else if (idx == kInfo) {
+          data = NumCounters | (Width << 16);
+        } else if (idx == kOvfStatus) {
+          data = ovf_status;
+        } else if (idx == kOvfEnable) {
+          data = ovf_enable;
+        }
+        ctrl_r.id = ctrl_ar.id;
+        ctrl_r.data = data;
+        ctrl_r.resp = in_range ? lite_::Enc::XRESP::OKAY : lite_::Enc::XRESP::SLVERR;
+        ctrl_r.last = 1;
+        ctrl_r_valid = !if_rd.nb_rwrite(ctrl_r);
+      }
+    }
+  }
+};
+
+#endif
@@ -29,6 +29,7 @@
 #include <nvhls_module.h>
 
 #include <UIntOrEmpty.h>
+#include <nvhls_packed_marshaller.h>
 
 #include <axi/axi4_encoding.h>
 #include <axi/axi4_configs.h>
@@ -75,6 +76,7 @@ class axi4 {
     ASIZE_WIDTH = (Cfg::useVariableBeatSize != 0 ? 3 : 0),
     LAST_WIDTH = (Cfg::useLast != 0 ? 1 : 0),
     CACHE_WIDTH = (Cfg::useCache != 0 ? Enc::ARCACHE::_WIDTH : 0),
+    QOS_WIDTH = (Cfg::useQoS != 0 ? Enc::AXQOS::_WIDTH : 0),
     BURST_WIDTH = ((Cfg::useBurst != 0 &&
                     (Cfg::useFixedBurst != 0 || Cfg::useWrapBurst != 0))
                        ? Enc::AXBURST::_WIDTH
@@ -100,6 +102,7 @@ class axi4 {
   typedef typename nvhls::UIntOrEmpty<LAST_WIDTH>::T Last;
   typedef typename nvhls::UIntOrEmpty<WSTRB_WIDTH>::T Wstrb;
   typedef typename nvhls::UIntOrEmpty<CACHE_WIDTH>::T Cache;
+  typedef typename nvhls::UIntOrEmpty<QOS_WIDTH>::T Qos;
   typedef typename nvhls::UIntOrEmpty<BURST_WIDTH>::T Burst;
   typedef NVUINTW(RESP_WIDTH) Resp;
 
@@ -118,6 +121,7 @@ class axi4 {
     BeatNum len;    // A*LEN
     BeatSize size;  // A*SIZE
     Cache cache;
+    Qos qos;
     AUser auser;
 
   AUTO_GEN_FIELD_METHODS(AddrPayload, ( \
@@ -127,9 +131,23 @@ class axi4 {
    , len \
    , size \
    , cache \
+   , qos \
    , auser \
   ) )
   //
+  // Same field order as AUTO_GEN_FIELD_METHODS; used by the C-sim packed marshaller
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
+    m& id;
+    m& addr;
+    m& burst;
+    m& len;
+    m& size;
+    m& cache;
+    m& qos;
+    m& auser;
+  }
 
 
    AddrPayload() {
@@ -144,6 +162,8 @@ class axi4 {
        burst = 0;
      if(CACHE_WIDTH > 0)
        cache = 0;
+     if(QOS_WIDTH > 0)
+       qos = 0;
      if(AUSER_WIDTH > 0)
        auser = 0;
     }
@@ -169,6 +189,16 @@ class axi4 {
    , ruser \
   ) )
   //
+  // Same field order as AUTO_GEN_FIELD_METHODS; used by the C-sim packed marshaller
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
+    m& id;
+    m& data;
+    m& resp;
+    m& last;
+    m& ruser;
+  }
 
 
    ReadPayload() {
@@ -198,6 +228,14 @@ class axi4 {
    , buser \
   ) )
   //
+  // Same field order as AUTO_GEN_FIELD_METHODS; used by the C-sim packed marshaller
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
+    m& id;
+    m& resp;
+    m& buser;
+  }
 
    WRespPayload() {
      if(ID_WIDTH > 0)
@@ -226,6 +264,15 @@ class axi4 {
    , wuser \
   ) )
   //
+  // Same field order as AUTO_GEN_FIELD_METHODS; used by the C-sim packed marshaller
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
+    m& data;
+    m& last;
+    m& wstrb;
+    m& wuser;
+  }
 
     WritePayload() {
      data = 0; // NVUINT, DATA_WIDTH always > 0 
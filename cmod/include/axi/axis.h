@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _AXI_AXIS_H_
+#define _AXI_AXIS_H_
+
+#include <systemc>
+#include <connections/connections.h>
+#include <connections/connections_utils.h>
+
+#include "auto_gen_fields.h"
+
+#include <nvhls_connections.h>
+#include <nvhls_assert.h>
+#include <nvhls_message.h>
+#include <nvhls_module.h>
+
+#include <UIntOrEmpty.h>
+#include <nvhls_packed_marshaller.h>
+
+#include <axi/axis_configs.h>
+
+namespace axi {
+
+/**
+ * \brief The base AXI-Stream class parameterized according a valid config.
+ * \ingroup AXI
+ *
+ * \tparam Cfg        A valid AXI-Stream config.
+ *
+ * \par Overview
+ * axis defines the AXI-Stream (AXIS) transfer and the Connections ports used
+ * to carry it, in the same way as axi4 does for the memory-mapped protocol.
+ * - Each TDATA, TKEEP, TLAST, TID, TDEST and TUSER signal is a UIntOrEmpty of
+ * an appropriate width, so unused signals are elided from the payload.
+ * - TKEEP has one bit per TDATA byte. A cleared bit marks a null byte, which
+ * carries no data and may be dropped by any component.
+ * - TSTRB (position bytes) is not supported.
+ * - A stream has a single channel, named t, with one transfer per Payload.
+ *
+ * \par A Simple Example
+ * \code
+ *      typedef axi::axis<axi::cfg::stream::standard> axis_;
+ *
+ *      typename axis_::template manager<> out("out");  // Sends transfers
+ *      typename axis_::template subordinate<> in("in"); // Receives transfers
+ *      typename axis_::template chan<> link("link");    // Connects the two
+ *      ...
+ *      typename axis_::Payload beat;
+ *      beat.data = 0x1234;
+ *      beat.last = 1;
+ *      out.t.Push(beat);
+ * \endcode
+ * \par
+ *
+ */
+template <typename Cfg>
+class axis {
+ public:
+  enum {
+    DATA_WIDTH = Cfg::dataWidth,
+    BYTES = DATA_WIDTH >> 3,
+    KEEP_WIDTH = (Cfg::useKeep != 0 ? BYTES : 0),
+    LAST_WIDTH = (Cfg::useLast != 0 ? 1 : 0),
+    ID_WIDTH = Cfg::idWidth,
+    DEST_WIDTH = Cfg::destWidth,
+    USER_WIDTH = Cfg::userWidth,
+  };
+
+  static_assert(DATA_WIDTH % 8 == 0, "AXI-Stream data width must be a multiple of 8");
+
+  typedef NVUINTW(DATA_WIDTH) Data;
+  typedef typename nvhls::UIntOrEmpty<KEEP_WIDTH>::T Keep;
+  typedef typename nvhls::UIntOrEmpty<LAST_WIDTH>::T Last;
+  typedef typename nvhls::UIntOrEmpty<ID_WIDTH>::T Id;
+  typedef typename nvhls::UIntOrEmpty<DEST_WIDTH>::T Dest;
+  typedef typename nvhls::UIntOrEmpty<USER_WIDTH>::T User;
+
+  /**
+   * \brief A struct composed of the signals of one AXI-Stream transfer.
+   */
+  struct Payload : public nvhls_message {
+    Data data;
+    Keep keep;
+    Last last;
+    Id id;
+    Dest dest;
+    User user;
+
+  AUTO_GEN_FIELD_METHODS(Payload, ( \
+     data \
+   , keep \
+   , last \
+   , id \
+   , dest \
+   , user \
+  ) )
+  //
+  // Same field order as AUTO_GEN_FIELD_METHODS; used by the C-sim packed marshaller
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
+    m& data;
+    m& keep;
+    m& last;
+    m& id;
+    m& dest;
+    m& user;
+  }
+
+    Payload() {
+      data = 0; // NVUINT, DATA_WIDTH always > 0
+      if(KEEP_WIDTH > 0)
+        keep = ~0;
+      if(LAST_WIDTH > 0)
+        last = 0;
+      if(ID_WIDTH > 0)
+        id = 0;
+      if(DEST_WIDTH > 0)
+        dest = 0;
+      if(USER_WIDTH > 0)
+        user = 0;
+    }
+  };
+
+  /**
+   * \brief The AXI-Stream channel, used for connecting a stream manager and subordinate.
+   */
+  template <Connections::connections_port_t PortType = AUTO_PORT>
+  class chan {
+   public:
+    typedef Connections::Combinational<Payload, PortType> TChan;
+
+    TChan t;  // manager to subordinate
+
+    chan(const char *name) : t(nvhls_concat(name, "_t")) {};
+  }; // chan
+
+  /**
+   * \brief The AXI-Stream manager port, which sends transfers.
+   */
+  template <Connections::connections_port_t PortType = AUTO_PORT>
+  class manager {
+   public:
+    typedef Connections::Out<Payload, PortType> TPort;
+
+    TPort t;
+
+    manager(const char *name) : t(nvhls_concat(name, "_t")) {}
+
+    void reset() { t.Reset(); }
+
+    void twrite(const Payload &beat) { t.Push(beat); }
+
+    bool nb_twrite(const Payload &beat) { return t.PushNB(beat); }
+
+    template <class C>
+    void operator()(C &c) {
+      t(c.t);
+    }
+  }; // manager
+
+  /**
+   * \brief The AXI-Stream subordinate port, which receives transfers.
+   */
+  template <Connections::connections_port_t PortType = AUTO_PORT>
+  class subordinate {
+   public:
+    typedef Connections::In<Payload, PortType> TPort;
+
+    TPort t;
+
+    subordinate(const char *name) : t(nvhls_concat(name, "_t")) {}
+
+    void reset() { t.Reset(); }
+
+    Payload tread() { return t.Pop(); }
+
+    bool nb_tread(Payload &beat) { return t.PopNB(beat); }
+
+    template <class C>
+    void operator()(C &c) {
+      t(c.t);
+    }
+  }; // subordinate
+}; // axis
+}; // axi
+
+#endif
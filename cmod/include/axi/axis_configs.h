@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __AXIS_CONFIG_H__
+#define __AXIS_CONFIG_H__
+
+namespace axi {
+namespace cfg {
+
+/**
+ * \brief Examples of valid AXI-Stream configs.
+ * \ingroup AXI
+ *
+ * \par  An AXI-Stream config consists of a struct with an enum defining the following constants:
+ * - dataWidth: The bitwidth of TDATA.  Must be a multiple of 8.
+ * - useKeep: Set to 1 if TKEEP is used, 0 otherwise.  Without TKEEP every byte
+ * of every transfer carries data.
+ * - useLast: Set to 1 if TLAST is used, 0 otherwise.
+ * - idWidth: The bitwidth of TID.
+ * - destWidth: The bitwidth of TDEST.
+ * - userWidth: The bitwidth of TUSER.
+ */
+namespace stream {
+
+/**
+ * \brief A standard AXI-Stream configuration with 64-bit data.
+ */
+struct standard {
+  enum {
+    dataWidth = 64,
+    useKeep = 1,
+    useLast = 1,
+    idWidth = 4,
+    destWidth = 4,
+    userWidth = 0,
+  };
+};
+/**
+ * \brief A 256-bit AXI-Stream configuration.
+ */
+struct wide {
+  enum {
+    dataWidth = 256,
+    useKeep = 1,
+    useLast = 1,
+    idWidth = 4,
+    destWidth = 4,
+    userWidth = 0,
+  };
+};
+/**
+ * \brief A minimal AXI-Stream configuration with 32-bit data and only TLAST.
+ */
+struct minimal {
+  enum {
+    dataWidth = 32,
+    useKeep = 0,
+    useLast = 1,
+    idWidth = 0,
+    destWidth = 0,
+    userWidth = 0,
+  };
+};
+}; // namespace stream
+}; // namespace cfg
+}; // namespace axi
+
+#endif
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXI_T_ADDR_TRACKER__
+#define __AXI_T_ADDR_TRACKER__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * \brief Hash functor for AXI address and tag types in unordered containers.
+ * \ingroup AXI
+ *
+ * Works with any type that provides to_uint64(), such as the NVUINTW address
+ * of an AXI config.
+ */
+struct AxiAddrHash {
+  template <typename T>
+  size_t operator()(const T& a) const {
+    return std::hash<uint64_t>()(a.to_uint64());
+  }
+};
+
+/**
+ * \brief A set of addresses with O(1) insert, erase, lookup and random selection.
+ * \ingroup AXI
+ *
+ * \tparam Addr                     The address type.
+ *
+ * \par Overview
+ * Elements are kept densely in a vector so that operator[] can pick one by
+ * index, and a hash map holds the position of each element. Erase moves the
+ * last element into the freed slot, so the order of elements is not stable.
+ */
+template <typename Addr>
+class AxiAddrSet {
+ public:
+  size_t size() const { return items.size(); }
+  bool empty() const { return items.empty(); }
+  const Addr& operator[](size_t i) const { return items[i]; }
+
+  bool count(const Addr& a) const { return pos.count(a) != 0; }
+
+  void insert(const Addr& a) {
+    if (pos.count(a)) return;
+    pos[a] = items.size();
+    items.push_back(a);
+  }
+
+  void erase(const Addr& a) {
+    typename std::unordered_map<Addr, size_t, AxiAddrHash>::iterator it = pos.find(a);
+    if (it == pos.end()) return;
+    size_t i = it->second;
+    pos.erase(it);
+    if (i != items.size() - 1) {
+      items[i] = items.back();
+      pos[items[i]] = i;
+    }
+    items.pop_back();
+  }
+
+  void clear() {
+    items.clear();
+    pos.clear();
+  }
+
+ private:
+  std::vector<Addr> items;
+  std::unordered_map<Addr, size_t, AxiAddrHash> pos;
+};
+
+/**
+ * \brief A timing wheel that releases keys a fixed number of ticks after they are scheduled.
+ * \ingroup AXI
+ *
+ * \tparam Key                      The key type (such as an AXI address).
+ *
+ * \par Overview
+ * The wheel has span+1 slots, one per tick, and delays must not exceed span.
+ * schedule() files a key in the slot of its due tick and tick() releases the
+ * keys of the current slot, so both cost O(1) per key regardless of how many
+ * keys are pending. Scheduling a key that is already pending restarts its
+ * delay, and cancel() drops it; the superseded slot entries are skipped when
+ * their tick comes around. A key scheduled with delay 0 is released by the
+ * next call to tick().
+ */
+template <typename Key>
+class AxiTimingWheel {
+ public:
+  explicit AxiTimingWheel(size_t span) : slots(span + 1), now(0) {}
+
+  size_t span() const { return slots.size() - 1; }
+  bool pending(const Key& k) const { return due.count(k) != 0; }
+
+  void schedule(const Key& k, size_t delay) {
+    uint64_t t = now + (delay < span() ? delay : span());
+    due[k] = t;
+    slots[t % slots.size()].push_back(std::make_pair(k, t));
+  }
+
+  void cancel(const Key& k) { due.erase(k); }
+
+  // Releases the keys that are due at the current tick into out, then advances the wheel
+  template <typename Out>
+  void tick(Out& out) {
+    std::vector<std::pair<Key, uint64_t> >& slot = slots[now % slots.size()];
+    for (size_t i = 0; i < slot.size(); i++) {
+      typename std::unordered_map<Key, uint64_t, AxiAddrHash>::iterator it = due.find(slot[i].first);
+      if (it != due.end() && it->second == slot[i].second) {
+        due.erase(it);
+        out.insert(slot[i].first);
+      }
+    }
+    slot.clear();
+    now++;
+  }
+
+ private:
+  std::vector<std::vector<std::pair<Key, uint64_t> > > slots;
+  std::unordered_map<Key, uint64_t, AxiAddrHash> due;
+  uint64_t now;
+};
+
+#endif
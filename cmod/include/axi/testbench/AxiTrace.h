@@ -0,0 +1,575 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXI_T_TRACE__
+#define __AXI_T_TRACE__
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+
+#include <axi/axi4.h>
+#include <axi/testbench/CSVFileReader.h>
+#include <nvhls_connections.h>
+#include <hls_globals.h>
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * \brief One fixed-width record of a binary AXI trace.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg                   A valid AXI config.
+ *
+ * \par Overview
+ * A binary AXI trace is a 32-byte file header followed by records of
+ * kRecordBytes bytes each. All fields are little-endian.
+ *
+ * Header: "AXITRACE", version, addrWidth, dataWidth, idWidth, kRecordBytes,
+ * one reserved word (each a uint32 after the 8-byte magic).
+ *
+ * Record:
+ * - bytes 0-3: delay in cycles from the previous request
+ * - byte 4: kind (AR, AW, W, R, B or Q)
+ * - byte 5: last, byte 6: resp, byte 7: reserved
+ * - bytes 8-11: id, bytes 12-15: len
+ * - bytes 16-23: addr
+ * - then DataBytes of data and StrbBytes of wstrb
+ *
+ * A Q record holds the interrupt count of a ManagerFromFile wait in len, its
+ * timeout in addr and whether it is posted in last.
+ *
+ * Transactions are stored in request order: each AR is followed by its R
+ * beats, each AW by its W beats and then its B. This is the order in which
+ * ManagerFromFile replays them and SubordinateFromFile preloads from them.
+ */
+template <typename axiCfg>
+struct AxiTraceRecord {
+  typedef axi::axi4<axiCfg> axi4_;
+  static const unsigned int StrbWidth = axi4_::DATA_WIDTH >> 3;
+  static const unsigned int DataBytes = ((axi4_::DATA_WIDTH + 63) / 64) * 8;
+  static const unsigned int StrbBytes = ((StrbWidth + 63) / 64) * 8;
+  static const unsigned int kHeaderBytes = 32;
+  static const unsigned int kRecordBytes = 24 + DataBytes + StrbBytes;
+  static const uint32_t kVersion = 1;
+  typedef NVUINTW(StrbWidth) Strb;
+
+  enum Kind { AR = 0, AW = 1, W = 2, R = 3, B = 4, Q = 5 };
+
+  uint32_t delay;
+  uint8_t kind;
+  uint8_t last;
+  uint8_t resp;
+  uint32_t id;
+  uint32_t len;
+  uint64_t addr;
+  typename axi4_::Data data;
+  Strb wstrb;
+
+  AxiTraceRecord()
+      : delay(0), kind(AR), last(0), resp(0), id(0), len(0), addr(0), data(0) {
+    wstrb = ~Strb(0);
+  }
+
+  static const char* Magic() { return "AXITRACE"; }
+
+  static void PackHeader(unsigned char* p) {
+    memset(p, 0, kHeaderBytes);
+    memcpy(p, Magic(), 8);
+    PutLE(p + 8, kVersion, 4);
+    PutLE(p + 12, axi4_::ADDR_WIDTH, 4);
+    PutLE(p + 16, axi4_::DATA_WIDTH, 4);
+    PutLE(p + 20, axi4_::ID_WIDTH, 4);
+    PutLE(p + 24, kRecordBytes, 4);
+  }
+
+  // True if the header matches this config
+  static bool CheckHeader(const unsigned char* p) {
+    return memcmp(p, Magic(), 8) == 0 && GetLE(p + 8, 4) == kVersion &&
+           GetLE(p + 12, 4) == axi4_::ADDR_WIDTH &&
+           GetLE(p + 16, 4) == axi4_::DATA_WIDTH &&
+           GetLE(p + 20, 4) == axi4_::ID_WIDTH &&
+           GetLE(p + 24, 4) == kRecordBytes;
+  }
+
+  void Pack(unsigned char* p) const {
+    PutLE(p, delay, 4);
+    p[4] = kind;
+    p[5] = last;
+    p[6] = resp;
+    p[7] = 0;
+    PutLE(p + 8, id, 4);
+    PutLE(p + 12, len, 4);
+    PutLE(p + 16, addr, 8);
+    PutWide(p + 24, data, DataBytes);
+    PutWide(p + 24 + DataBytes, wstrb, StrbBytes);
+  }
+
+  void Unpack(const unsigned char* p) {
+    delay = GetLE(p, 4);
+    kind = p[4];
+    last = p[5];
+    resp = p[6];
+    id = GetLE(p + 8, 4);
+    len = GetLE(p + 12, 4);
+    addr = GetLE(p + 16, 8);
+    data = GetWide<typename axi4_::Data>(p + 24, DataBytes);
+    wstrb = GetWide<Strb>(p + 24 + DataBytes, StrbBytes);
+  }
+
+  // Conversions to and from the channel payloads
+  void FromAddr(Kind k, typename axi4_::AddrPayload pld) {
+    kind = k;
+    id = Field(pld.id);
+    addr = pld.addr.to_uint64();
+    len = Field(pld.len);
+  }
+  typename axi4_::AddrPayload ToAddr() const {
+    typename axi4_::AddrPayload pld;
+    pld.id = id;
+    pld.addr = addr;
+    pld.len = len;
+    return pld;
+  }
+  void FromRead(typename axi4_::ReadPayload pld) {
+    kind = R;
+    id = Field(pld.id);
+    data = pld.data;
+    resp = pld.resp.to_uint64();
+    last = Field(pld.last);
+  }
+  void FromWrite(typename axi4_::WritePayload pld) {
+    kind = W;
+    data = pld.data;
+    last = Field(pld.last);
+    AssignStrb(wstrb, pld.wstrb);
+  }
+  typename axi4_::WritePayload ToWrite() const {
+    typename axi4_::WritePayload pld;
+    pld.data = data;
+    pld.last = last;
+    pld.wstrb = wstrb;
+    return pld;
+  }
+  void FromWResp(typename axi4_::WRespPayload pld) {
+    kind = B;
+    id = Field(pld.id);
+    resp = pld.resp.to_uint64();
+  }
+
+ protected:
+  template <typename T>
+  static uint64_t Field(T f) { return f.to_uint64(); }
+
+  template <typename T>
+  static void AssignStrb(Strb& dst, const T& src) { dst = src; }
+  static void AssignStrb(Strb& dst, const nvhls::EmptyField&) { dst = ~Strb(0); }
+
+  static void PutLE(unsigned char* p, uint64_t v, unsigned n) {
+    for (unsigned i = 0; i < n; i++, v >>= 8) p[i] = static_cast<unsigned char>(v);
+  }
+  static uint64_t GetLE(const unsigned char* p, unsigned n) {
+    uint64_t v = 0;
+    for (int i = n - 1; i >= 0; i--) v = (v << 8) | p[i];
+    return v;
+  }
+
+  template <typename T>
+  static void PutWide(unsigned char* p, T v, unsigned n) {
+    for (unsigned i = 0; i < n; i++) {
+      T byte = v & T(0xff);
+      p[i] = static_cast<unsigned char>(byte.to_uint());
+      v >>= 8;
+    }
+  }
+  template <typename T>
+  static T GetWide(const unsigned char* p, unsigned n) {
+    T v = 0;
+    for (int i = n - 1; i >= 0; i--) {
+      v <<= 8;
+      v |= T(p[i]);
+    }
+    return v;
+  }
+};
+
+/**
+ * \brief Writes a binary AXI trace.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg                   A valid AXI config.
+ */
+template <typename axiCfg>
+class AxiTraceWriter {
+ public:
+  typedef AxiTraceRecord<axiCfg> Record;
+
+  explicit AxiTraceWriter(const std::string& filename)
+      : file(fopen(filename.c_str(), "wb")), buf(Record::kRecordBytes) {
+    CMOD_ASSERT_MSG(file != NULL, "Cannot open AXI trace for writing");
+    if (file != NULL) {
+      unsigned char header[Record::kHeaderBytes];
+      Record::PackHeader(header);
+      fwrite(header, 1, sizeof(header), file);
+    }
+  }
+
+  ~AxiTraceWriter() {
+    if (file != NULL) fclose(file);
+  }
+
+  void write(const Record& rec) {
+    rec.Pack(&buf[0]);
+    fwrite(&buf[0], 1, buf.size(), file);
+  }
+
+  void flush() { fflush(file); }
+
+ private:
+  FILE* file;
+  std::vector<unsigned char> buf;
+
+  AxiTraceWriter(const AxiTraceWriter&);
+  AxiTraceWriter& operator=(const AxiTraceWriter&);
+};
+
+/**
+ * \brief Reads a binary AXI trace one record at a time.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg                   A valid AXI config.
+ *
+ * The file is opened on the first call to read(). The header must match the
+ * widths of axiCfg.
+ */
+template <typename axiCfg>
+class AxiTraceReader {
+ public:
+  typedef AxiTraceRecord<axiCfg> Record;
+
+  explicit AxiTraceReader(const std::string& filename)
+      : fileName(filename), file(NULL), done(false), buf(Record::kRecordBytes) {}
+
+  ~AxiTraceReader() {
+    if (file != NULL) fclose(file);
+  }
+
+  // True if filename starts with the binary trace magic
+  static bool IsTraceFile(const std::string& filename) {
+    FILE* f = fopen(filename.c_str(), "rb");
+    if (f == NULL) return false;
+    char magic[8];
+    bool is_trace = (fread(magic, 1, 8, f) == 8 && memcmp(magic, Record::Magic(), 8) == 0);
+    fclose(f);
+    return is_trace;
+  }
+
+  bool read(Record& rec) {
+    if (file == NULL) {
+      if (done) return false;
+      file = fopen(fileName.c_str(), "rb");
+      unsigned char header[Record::kHeaderBytes];
+      if (file == NULL || fread(header, 1, sizeof(header), file) != sizeof(header)) {
+        done = true;
+        return false;
+      }
+      CMOD_ASSERT_MSG(Record::CheckHeader(header), "AXI trace header does not match the AXI config");
+    }
+    if (done || fread(&buf[0], 1, buf.size(), file) != buf.size()) {
+      done = true;
+      return false;
+    }
+    rec.Unpack(&buf[0]);
+    return true;
+  }
+
+ private:
+  std::string fileName;
+  FILE* file;
+  bool done;
+  std::vector<unsigned char> buf;
+
+  AxiTraceReader(const AxiTraceReader&);
+  AxiTraceReader& operator=(const AxiTraceReader&);
+};
+
+/**
+ * \brief Converts a ManagerFromFile or SubordinateFromFile CSV to a binary AXI trace.
+ * \ingroup AXI
+ *
+ * Five-column rows (delay,R/W/Q,addr,data,burst_len) become AR/AW records
+ * followed by R/W beats. Two-column rows (addr,data) become an AR with a
+ * single R beat, which SubordinateFromFile uses to preload its memory.
+ * Returns false if the CSV cannot be read.
+ */
+template <typename axiCfg>
+bool ConvertAxiCSVToTrace(const std::string& csv_file, const std::string& trace_file) {
+  typedef AxiTraceRecord<axiCfg> Record;
+  typedef axi::axi4<axiCfg> axi4_;
+  FILE* probe = fopen(csv_file.c_str(), "r");
+  if (probe == NULL) return false;
+  fclose(probe);
+
+  CSVFileReader reader(csv_file);
+  AxiTraceWriter<axiCfg> writer(trace_file);
+  CSVRow row;
+  Record rec;
+  unsigned int beats_left = 0;
+  bool is_read = false;
+  while (reader.readRow(row)) {
+    if (row.size() == 2) {
+      rec = Record();
+      rec.kind = Record::AR;
+      rec.addr = row[0].to_hex<uint64_t>();
+      writer.write(rec);
+      rec.kind = Record::R;
+      rec.last = 1;
+      rec.data = row[1].to_hex<typename axi4_::Data>();
+      writer.write(rec);
+      continue;
+    }
+    CMOD_ASSERT_MSG(row.size() == 5, "Each request must have five elements");
+    if (beats_left == 0) {
+      rec = Record();
+      rec.delay = row[0].to_int();
+      if (row[1] == "Q") {
+        rec.kind = Record::Q;
+        rec.len = row[2].to_hex<uint32_t>();
+        rec.addr = row[3].to_hex<uint64_t>();
+        rec.last = (row[4].to_hex<uint32_t>() != 0);
+        writer.write(rec);
+        continue;
+      }
+      CMOD_ASSERT_MSG(row[1] == "R" || row[1] == "W", "Requests must be R or W or Q");
+      is_read = (row[1] == "R");
+      rec.kind = is_read ? Record::AR : Record::AW;
+      rec.addr = row[2].to_hex<uint64_t>();
+      rec.len = row[4].to_hex<uint32_t>();
+      beats_left = rec.len + 1;
+      writer.write(rec);
+    }
+    rec.kind = is_read ? Record::R : Record::W;
+    rec.delay = 0;
+    rec.data = row[3].to_hex<typename axi4_::Data>();
+    rec.last = (--beats_left == 0);
+    writer.write(rec);
+    if (!is_read && beats_left == 0) {
+      Record b;
+      b.kind = Record::B;
+      writer.write(b);
+    }
+  }
+  return true;
+}
+
+/**
+ * \brief Records the traffic on an AXI link into a binary AXI trace.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg                   A valid AXI config.
+ *
+ * \par Overview
+ * AxiTraceRecorder is inserted between a manager and a subordinate. Every
+ * channel is forwarded through a one-entry register, adding one cycle of
+ * latency in each direction. Each transaction is written once it completes,
+ * in the order its AR or AW was accepted, with the delay field set to the
+ * cycles since the previous request. The trace can be replayed with
+ * ManagerFromFile, or used to preload SubordinateFromFile.
+ *
+ * Read beats are matched to requests by id, write data to write requests in
+ * order, and write responses by id.
+ */
+template <typename axiCfg>
+class AxiTraceRecorder : public sc_module {
+ public:
+  typedef axi::axi4<axiCfg> axi4_;
+  typedef AxiTraceRecord<axiCfg> Record;
+
+  typename axi4_::read::template subordinate<> if_rd_m;   // towards the manager
+  typename axi4_::write::template subordinate<> if_wr_m;
+  typename axi4_::read::template manager<> if_rd_s;       // towards the subordinate
+  typename axi4_::write::template manager<> if_wr_s;
+
+  sc_in<bool> reset_bar;
+  sc_in<bool> clk;
+
+  SC_HAS_PROCESS(AxiTraceRecorder);
+
+  AxiTraceRecorder(sc_module_name name_, std::string filename = "trace.axi")
+      : sc_module(name_), if_rd_m("if_rd_m"), if_wr_m("if_wr_m"),
+        if_rd_s("if_rd_s"), if_wr_s("if_wr_s"), reset_bar("reset_bar"),
+        clk("clk"), writer(filename), cycle(0), last_req_cycle(0) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+  // Pushes the completed transactions recorded so far to the file
+  void flush() { writer.flush(); }
+
+  ~AxiTraceRecorder() {
+    // Transactions still in flight at the end of simulation are written as is
+    while (!txns.empty()) {
+      Emit(txns.front());
+      txns.pop_front();
+    }
+  }
+
+ protected:
+  struct Txn {
+    std::vector<Record> recs;
+    unsigned int beats_left;
+    bool done;
+  };
+
+  AxiTraceWriter<axiCfg> writer;
+  uint64_t cycle;
+  uint64_t last_req_cycle;
+  std::deque<Txn> txns;
+  std::map<uint32_t, std::deque<Txn*> > rd_by_id;
+  std::map<uint32_t, std::deque<Txn*> > wresp_by_id;
+  std::deque<Txn*> wdata_pending;
+  std::deque<Record> w_early;
+
+  void Emit(const Txn& txn) {
+    for (unsigned int i = 0; i < txn.recs.size(); i++) {
+      writer.write(txn.recs[i]);
+    }
+  }
+
+  void Retire() {
+    while (!txns.empty() && txns.front().done) {
+      Emit(txns.front());
+      txns.pop_front();
+    }
+  }
+
+  Txn* NewRequest(typename Record::Kind kind, const typename axi4_::AddrPayload& pld) {
+    Record rec;
+    rec.FromAddr(kind, pld);
+    rec.delay = static_cast<uint32_t>(cycle - last_req_cycle);
+    last_req_cycle = cycle;
+    txns.push_back(Txn());
+    Txn* txn = &txns.back();
+    txn->recs.push_back(rec);
+    txn->beats_left = rec.len + 1;
+    txn->done = false;
+    return txn;
+  }
+
+  void AddWriteBeat(Txn* txn, const Record& rec) {
+    txn->recs.push_back(rec);
+    txn->recs.back().last = (--txn->beats_left == 0);
+    if (txn->beats_left == 0) {
+      wdata_pending.pop_front();
+      if (axiCfg::useWriteResponses) {
+        wresp_by_id[txn->recs.front().id].push_back(txn);
+      } else {
+        txn->done = true;
+      }
+    }
+  }
+
+  void run() {
+    if_rd_m.reset();
+    if_wr_m.reset();
+    if_rd_s.reset();
+    if_wr_s.reset();
+
+    typename axi4_::AddrPayload ar_reg, aw_reg;
+    typename axi4_::ReadPayload r_reg;
+    typename axi4_::WritePayload w_reg;
+    typename axi4_::WRespPayload b_reg;
+    bool ar_valid = false, aw_valid = false, r_valid = false, w_valid = false,
+         b_valid = false;
+
+    while (1) {
+      wait();
+      cycle++;
+
+      if (!ar_valid && if_rd_m.ar.PopNB(ar_reg)) {
+        ar_valid = true;
+        Txn* txn = NewRequest(Record::AR, ar_reg);
+        rd_by_id[txn->recs.front().id].push_back(txn);
+      }
+      if (ar_valid && if_rd_s.ar.PushNB(ar_reg)) ar_valid = false;
+
+      if (!r_valid && if_rd_s.r.PopNB(r_reg)) {
+        r_valid = true;
+        Record rec;
+        rec.FromRead(r_reg);
+        std::deque<Txn*>& q = rd_by_id[rec.id];
+        CMOD_ASSERT_MSG(!q.empty(), "Read response without a matching read request");
+        if (!q.empty()) {
+          Txn* txn = q.front();
+          rec.last = (--txn->beats_left == 0);
+          txn->recs.push_back(rec);
+          if (rec.last) {
+            txn->done = true;
+            q.pop_front();
+          }
+        }
+      }
+      if (r_valid && if_rd_m.r.PushNB(r_reg)) r_valid = false;
+
+      if (!aw_valid && if_wr_m.aw.PopNB(aw_reg)) {
+        aw_valid = true;
+        Txn* txn = NewRequest(Record::AW, aw_reg);
+        wdata_pending.push_back(txn);
+        while (!w_early.empty() && !wdata_pending.empty() && wdata_pending.front() == txn) {
+          AddWriteBeat(txn, w_early.front());
+          w_early.pop_front();
+        }
+      }
+      if (aw_valid && if_wr_s.aw.PushNB(aw_reg)) aw_valid = false;
+
+      if (!w_valid && if_wr_m.w.PopNB(w_reg)) {
+        w_valid = true;
+        Record rec;
+        rec.FromWrite(w_reg);
+        if (wdata_pending.empty()) {
+          w_early.push_back(rec);
+        } else {
+          AddWriteBeat(wdata_pending.front(), rec);
+        }
+      }
+      if (w_valid && if_wr_s.w.PushNB(w_reg)) w_valid = false;
+
+      if (!b_valid && if_wr_s.b.PopNB(b_reg)) {
+        b_valid = true;
+        Record rec;
+        rec.FromWResp(b_reg);
+        std::deque<Txn*>& q = wresp_by_id[rec.id];
+        CMOD_ASSERT_MSG(!q.empty(), "Write response without a matching write request");
+        if (!q.empty()) {
+          q.front()->recs.push_back(rec);
+          q.front()->done = true;
+          q.pop_front();
+        }
+      }
+      if (b_valid && if_wr_m.b.PushNB(b_reg)) b_valid = false;
+
+      Retire();
+    }
+  }
+};
+
+#endif
@@ -18,40 +18,214 @@
 #define __CSV_FILE_READER__
 
 #include <string>
-#include <sstream>
 #include <vector>
-#include <math.h>
+#include <cstdio>
+#include <cstring>
 #include <boost/assert.hpp>
 
-#include <cstdlib>
-#include <iostream>
-#include <fstream>
-#include <algorithm>
-#include <boost/algorithm/string.hpp>
+/**
+ * \brief A zero-copy view of one field of a CSVRow.
+ *
+ * The view points into the reader's line buffer and stays valid until the next
+ * call to CSVFileReader::readRow(). Numeric conversions are done in place.
+ */
+class CSVField {
+  const char* ptr;
+  size_t len;
+
+  static int HexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+  }
+
+ public:
+  CSVField() : ptr(NULL), len(0) {}
+  CSVField(const char* p, size_t n) : ptr(p), len(n) {}
+
+  const char* data() const { return ptr; }
+  size_t size() const { return len; }
+  bool empty() const { return len == 0; }
+  std::string str() const { return std::string(ptr, len); }
+
+  bool operator==(const char* s) const {
+    return strlen(s) == len && memcmp(ptr, s, len) == 0;
+  }
+  bool operator!=(const char* s) const { return !(*this == s); }
+
+  // Decimal integer; parsing stops at the first non-digit
+  long long to_int() const {
+    size_t i = 0;
+    while (i < len && (ptr[i] == ' ' || ptr[i] == '\t')) i++;
+    bool neg = false;
+    if (i < len && (ptr[i] == '-' || ptr[i] == '+')) neg = (ptr[i++] == '-');
+    long long v = 0;
+    for (; i < len && ptr[i] >= '0' && ptr[i] <= '9'; i++) {
+      v = v * 10 + (ptr[i] - '0');
+    }
+    return neg ? -v : v;
+  }
+
+  // Hexadecimal with optional 0x prefix into any NVUINT, sc_uint or sc_biguint;
+  // parsing stops at the first non-hex character
+  template <typename T>
+  T to_hex() const {
+    T v = 0;
+    size_t i = 0;
+    while (i < len && (ptr[i] == ' ' || ptr[i] == '\t')) i++;
+    if (i + 1 < len && ptr[i] == '0' && (ptr[i + 1] == 'x' || ptr[i + 1] == 'X')) i += 2;
+    for (; i < len; i++) {
+      int d = HexDigit(ptr[i]);
+      if (d < 0) break;
+      v <<= 4;
+      v += d;
+    }
+    return v;
+  }
+};
+
+/**
+ * \brief One parsed line of a CSV file.
+ *
+ * Reusing a CSVRow across calls to CSVFileReader::readRow() keeps parsing free
+ * of allocations once the field vector has grown to the widest row.
+ */
+class CSVRow {
+  std::vector<CSVField> fields;
+  friend class CSVFileReader;
+
+ public:
+  size_t size() const { return fields.size(); }
+  const CSVField& operator[](size_t i) const { return fields[i]; }
+};
 
 /**
  * \brief A helper class to read CSV files.
  *
  * The constructor takes two arguments: a string containing the filename, and an optional string containing the delimiting character (default is ',').
+ *
+ * readRow() streams the file one line at a time through a fixed-size buffer, so
+ * memory use does not grow with the file. Blank lines are skipped. readCSV()
+ * returns the whole file as strings, as before.
  */
 class CSVFileReader {
+  static const size_t kBufferSize = 1 << 16;
+
   std::string fileName;
   std::string seperator;
+  bool is_sep[256];
+  FILE* file;
+  std::vector<char> buf;
+  size_t begin;
+  size_t end;
+  bool eof;
+
+  CSVFileReader(const CSVFileReader&);
+  CSVFileReader& operator=(const CSVFileReader&);
+
+  // Moves unread bytes to the front of the buffer and reads more
+  void Refill() {
+    if (begin > 0) {
+      memmove(&buf[0], &buf[begin], end - begin);
+      end -= begin;
+      begin = 0;
+    }
+    if (end == buf.size()) {
+      buf.resize(2 * buf.size());  // Line longer than the buffer
+    }
+    size_t n = fread(&buf[end], 1, buf.size() - end, file);
+    end += n;
+    if (n == 0) {
+      eof = true;
+    }
+  }
 
  public:
   CSVFileReader(std::string filename, std::string sep = ",")
-      : fileName(filename), seperator(sep) {}
+      : fileName(filename), seperator(sep), file(NULL), buf(kBufferSize),
+        begin(0), end(0), eof(false) {
+    for (int i = 0; i < 256; i++) {
+      is_sep[i] = false;
+    }
+    for (size_t i = 0; i < seperator.size(); i++) {
+      is_sep[static_cast<unsigned char>(seperator[i])] = true;
+    }
+  }
+
+  ~CSVFileReader() {
+    if (file != NULL) {
+      fclose(file);
+    }
+  }
+
+  // Restart from the beginning of the file
+  void rewind() {
+    if (file != NULL) {
+      fclose(file);
+      file = NULL;
+    }
+    begin = end = 0;
+    eof = false;
+  }
+
+  // Parses the next non-blank line into row; returns false at end of file
+  bool readRow(CSVRow& row) {
+    if (file == NULL) {
+      if (eof) return false;
+      file = fopen(fileName.c_str(), "r");
+      if (file == NULL) {
+        eof = true;
+        return false;
+      }
+    }
+    while (1) {
+      const char* nl = (begin < end) ? static_cast<const char*>(
+                           memchr(&buf[begin], '\n', end - begin)) : NULL;
+      size_t line_begin = begin;
+      size_t line_end;
+      if (nl != NULL) {
+        line_end = nl - &buf[0];
+        begin = line_end + 1;
+      } else if (!eof) {
+        Refill();
+        continue;
+      } else if (begin < end) {
+        line_end = end;
+        begin = end;
+      } else {
+        return false;
+      }
+      if (line_end > line_begin && buf[line_end - 1] == '\r') line_end--;
+      if (line_end == line_begin) continue;
+
+      row.fields.clear();
+      const char* p = &buf[line_begin];
+      const char* line_stop = &buf[0] + line_end;
+      const char* field = p;
+      for (; p < line_stop; p++) {
+        if (is_sep[static_cast<unsigned char>(*p)]) {
+          row.fields.push_back(CSVField(field, p - field));
+          field = p + 1;
+        }
+      }
+      row.fields.push_back(CSVField(field, line_stop - field));
+      return true;
+    }
+  }
 
   std::vector<std::vector<std::string> > readCSV() {
-    std::ifstream file(fileName.c_str());
+    rewind();
     std::vector<std::vector<std::string> > dataList;
-    std::string line = "";
-    while (getline(file, line)) {
-      std::vector<std::string> vec;
-      boost::algorithm::split(vec, line, boost::is_any_of(seperator));
+    CSVRow row;
+    while (readRow(row)) {
+      std::vector<std::string> vec(row.size());
+      for (size_t i = 0; i < row.size(); i++) {
+        vec[i] = row[i].str();
+      }
       dataList.push_back(vec);
     }
-    file.close();
+    rewind();
     return dataList;
   }
 };
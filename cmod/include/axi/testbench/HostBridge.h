@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXI_T_HOST_BRIDGE__
+#define __AXI_T_HOST_BRIDGE__
+
+#include <nvhls_int.h>
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+
+#include <axi/axi4.h>
+#include <axi/testbench/HostBridgeShm.h>
+#include <nvhls_connections.h>
+#include <hls_globals.h>
+
+#include <cstring>
+#include <deque>
+#include <string>
+
+/**
+ * \brief An AXI manager driven by software in another process over shared memory.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg                   A valid AXI config.
+ *
+ * \par Overview
+ * HostBridgeManager creates a HostBridgeShm region and turns the requests
+ * that a host process submits with HostBridgeClient into AXI transactions,
+ * so that real driver software can drive the model interactively, where
+ * ManagerFromFile replays a fixed trace:
+ * - Every cycle, up to batchSize published requests are taken from the
+ *   request ring and issued in order: a read becomes one AR, a write one AW
+ *   and its W beats, read straight out of the shared slot. A request covers
+ *   the beats from its aligned first beat to its last byte; write strobes
+ *   select its bytes, so unaligned writes need a config with write strobes.
+ *   A request may not need more beats than one burst allows.
+ * - Reads and writes stay outstanding while later requests are issued, up
+ *   to the number of ring slots. Separate threads collect R and B and post
+ *   each completion, with the request's tag, to the response ring.
+ * - Each rising edge of interrupt posts a kInterrupt response, with the
+ *   number of interrupts since reset as its tag. Bind interrupt to a
+ *   constant false signal when the design has none.
+ * - A stop request raises done once the requests before it completed.
+ *
+ * The model polls the rings with one atomic load per cycle while the host
+ * is idle, so the host should submit requests in batches for speed. The
+ * host may attach before or after the simulation starts, but after the
+ * bridge is constructed.
+ *
+ * \par A Simple Example
+ * \code
+ *      // Model
+ *      HostBridgeManager<axi::cfg::standard> host("host", "/matchlib_host");
+ *      host.clk(clk);
+ *      host.reset_bar(reset_bar);
+ *      host.if_rd(axi_read);
+ *      host.if_wr(axi_write);
+ *      host.interrupt(dut_irq);
+ *      host.done(done);
+ * \endcode
+ * The host process uses HostBridgeClient on the same name.
+ * \par
+ *
+ */
+template <typename axiCfg> class HostBridgeManager : public sc_module {
+ public:
+  static const int kDebugLevel = 1;
+  typedef axi::axi4<axiCfg> axi4_;
+
+  typename axi4_::read::template manager<> if_rd;
+  typename axi4_::write::template manager<> if_wr;
+
+  sc_in<bool> reset_bar;
+  sc_in<bool> clk;
+  sc_in<bool> interrupt;
+  sc_out<bool> done;
+
+  static const int bytesPerBeat = axi4_::DATA_WIDTH >> 3;
+  static const int maxBeats = axiCfg::useBurst ? axiCfg::maxBurstSize : 1;
+
+  unsigned long long num_reads;
+  unsigned long long num_writes;
+  unsigned long long num_interrupts;
+
+  SC_HAS_PROCESS(HostBridgeManager);
+
+  HostBridgeManager(sc_module_name name_, const std::string& shm_name,
+                    unsigned int num_slots = 64, unsigned int batchSize = 8)
+      : sc_module(name_), if_rd("if_rd"), if_wr("if_wr"), reset_bar("reset_bar"),
+        clk("clk"), interrupt("interrupt"), done("done"), num_reads(0), num_writes(0),
+        num_interrupts(0), batch_size(batchSize), interrupt_last(false),
+        pending_interrupts(0), stopping(false) {
+    CMOD_ASSERT_MSG(shm.Create(shm_name, num_slots),
+                    "Could not create the host bridge shared memory");
+    CDCOUT("Host bridge at " << shm_name << endl, kDebugLevel);
+    SC_THREAD(issue);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+    SC_THREAD(read_response);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+    SC_THREAD(write_response);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+    SC_METHOD(count_interrupts);
+    sensitive << clk.pos();
+    dont_initialize();
+  }
+
+ protected:
+  // A read or write that was issued and waits for its response
+  struct Inflight {
+    uint32_t tag;
+    uint32_t offset;  // Of the first byte in the first beat
+    uint32_t bytes;
+  };
+
+  HostBridgeShm shm;
+  unsigned int batch_size;
+  std::deque<Inflight> rd_inflight;
+  std::deque<Inflight> wr_inflight;
+  bool interrupt_last;
+  unsigned int pending_interrupts;
+  bool stopping;
+
+  unsigned int NumBeats(const HostBridgeMsg& req) const {
+    uint32_t offset = req.addr % bytesPerBeat;
+    return (offset + req.bytes + bytesPerBeat - 1) / bytesPerBeat;
+  }
+
+  typename axi4_::AddrPayload Addr(const HostBridgeMsg& req) const {
+    unsigned int beats = NumBeats(req);
+    CMOD_ASSERT_MSG(req.bytes != 0, "Host request with no bytes");
+    CMOD_ASSERT_MSG(beats <= static_cast<unsigned int>(maxBeats),
+                    "Host request needs more beats than the AXI config allows in a burst");
+    typename axi4_::AddrPayload addr_pld;
+    addr_pld.addr = static_cast<typename axi4_::Addr>(req.addr - req.addr % bytesPerBeat);
+    if (axiCfg::useBurst) addr_pld.len = beats - 1;
+    return addr_pld;
+  }
+
+  void IssueWrite(const HostBridgeMsg& req) {
+    typename axi4_::AddrPayload addr_pld = Addr(req);
+    unsigned int beats = NumBeats(req);
+    uint32_t offset = req.addr % bytesPerBeat;
+    if (!axiCfg::useWriteStrobes) {
+      CMOD_ASSERT_MSG(offset == 0 && req.bytes % bytesPerBeat == 0,
+                      "Partial-beat host writes need an AXI config with write strobes");
+    }
+    if_wr.aw.Push(addr_pld);
+    for (unsigned int beat = 0; beat < beats; beat++) {
+      typename axi4_::WritePayload wr_pld;
+      wr_pld.data = 0;
+      NVUINTW(bytesPerBeat) strobe = 0;
+      for (int b = 0; b < bytesPerBeat; b++) {
+        int byte = beat * bytesPerBeat + b - offset;
+        if (byte >= 0 && byte < static_cast<int>(req.bytes)) {
+          wr_pld.data = nvhls::set_slc(wr_pld.data, NVUINT8(req.data[byte]), 8 * b);
+          strobe[b] = 1;
+        }
+      }
+      if (axiCfg::useWriteStrobes) wr_pld.wstrb = strobe;
+      wr_pld.last = (beat == beats - 1);
+      if_wr.w.Push(wr_pld);
+    }
+    Inflight inflight = {req.tag, offset, req.bytes};
+    wr_inflight.push_back(inflight);
+    num_writes++;
+    CDCOUT(sc_time_stamp() << " " << name() << " Host write: addr=" << hex << req.addr
+                  << " bytes=" << dec << req.bytes << " tag=" << req.tag << endl,
+           kDebugLevel);
+  }
+
+  void IssueRead(const HostBridgeMsg& req) {
+    typename axi4_::AddrPayload addr_pld = Addr(req);
+    if_rd.ar.Push(addr_pld);
+    Inflight inflight = {req.tag, static_cast<uint32_t>(req.addr % bytesPerBeat), req.bytes};
+    rd_inflight.push_back(inflight);
+    num_reads++;
+    CDCOUT(sc_time_stamp() << " " << name() << " Host read: addr=" << hex << req.addr
+                  << " bytes=" << dec << req.bytes << " tag=" << req.tag << endl,
+           kDebugLevel);
+  }
+
+  // Waits for a free response slot
+  HostBridgeMsg* ReserveResponse() {
+    HostBridgeMsg* rsp;
+    while ((rsp = shm.Responses().Reserve()) == NULL) wait();
+    return rsp;
+  }
+
+  void issue() {
+    done = 0;
+    if_rd.reset();
+    if_wr.reset();
+    stopping = false;
+    rd_inflight.clear();
+    wr_inflight.clear();
+    unsigned int max_inflight = shm.NumSlots();
+    wait();
+
+    while (1) {
+      HostBridgeQueue& requests = shm.Requests();
+      uint32_t available = requests.Available();
+      if (stopping && rd_inflight.empty() && wr_inflight.empty()) {
+        done = 1;
+        stopping = false;
+      }
+      uint32_t n = 0;
+      while (n < available && n < batch_size && !stopping &&
+             rd_inflight.size() + wr_inflight.size() < max_inflight) {
+        const HostBridgeMsg& req = requests.Peek(n);
+        if (req.kind == HostBridgeMsg::kWrite) {
+          IssueWrite(req);
+        } else if (req.kind == HostBridgeMsg::kRead) {
+          IssueRead(req);
+        } else if (req.kind == HostBridgeMsg::kStop) {
+          stopping = true;
+        } else {
+          CMOD_ASSERT_MSG(0, "Unexpected host request kind");
+        }
+        n++;
+      }
+      if (n != 0) requests.Release(n);
+      wait();
+    }
+  }
+
+  void read_response() {
+    if_rd.r.Reset();
+    uint8_t buf[HostBridgeMsg::kMaxBytes];
+    wait();
+
+    while (1) {
+      typename axi4_::ReadPayload data_pld;
+      uint32_t status = 0;
+      int base = 0;
+      do {
+        data_pld = if_rd.r.Pop();
+        CMOD_ASSERT_MSG(!rd_inflight.empty(), "Read response without a host read");
+        const Inflight& inflight = rd_inflight.front();
+        for (int b = 0; b < bytesPerBeat; b++) {
+          int byte = base + b - inflight.offset;
+          if (byte >= 0 && byte < static_cast<int>(inflight.bytes)) {
+            buf[byte] = nvhls::get_slc<8>(data_pld.data, 8 * b).to_uint();
+          }
+        }
+        if (data_pld.resp.to_uint() > status) status = data_pld.resp.to_uint();
+        base += bytesPerBeat;
+      } while (!data_pld.last);
+      Inflight inflight = rd_inflight.front();
+      rd_inflight.pop_front();
+      HostBridgeMsg* rsp = ReserveResponse();
+      rsp->kind = HostBridgeMsg::kRead;
+      rsp->tag = inflight.tag;
+      rsp->bytes = inflight.bytes;
+      rsp->status = status;
+      memcpy(rsp->data, buf, inflight.bytes);
+      shm.Responses().Commit();
+    }
+  }
+
+  void write_response() {
+    if_wr.b.Reset();
+    wait();
+
+    while (1) {
+      typename axi4_::WRespPayload resp_pld = if_wr.b.Pop();
+      CMOD_ASSERT_MSG(!wr_inflight.empty(), "Write response without a host write");
+      Inflight inflight = wr_inflight.front();
+      wr_inflight.pop_front();
+      HostBridgeMsg* rsp = ReserveResponse();
+      rsp->kind = HostBridgeMsg::kWrite;
+      rsp->tag = inflight.tag;
+      rsp->bytes = inflight.bytes;
+      rsp->status = resp_pld.resp.to_uint();
+      shm.Responses().Commit();
+    }
+  }
+
+  // Posts one kInterrupt per rising edge, later if the response ring is full
+  void count_interrupts() {
+    if (!reset_bar.read()) {
+      interrupt_last = false;
+      pending_interrupts = 0;
+      num_interrupts = 0;
+      return;
+    }
+    bool level = interrupt.read();
+    if (level && !interrupt_last) pending_interrupts++;
+    interrupt_last = level;
+    bool posted = false;
+    while (pending_interrupts != 0) {
+      HostBridgeMsg* rsp = shm.Responses().Reserve();
+      if (rsp == NULL) break;
+      num_interrupts++;
+      pending_interrupts--;
+      rsp->kind = HostBridgeMsg::kInterrupt;
+      rsp->tag = num_interrupts;
+      rsp->bytes = 0;
+      rsp->status = 0;
+      posted = true;
+    }
+    if (posted) shm.Responses().Commit();
+  }
+};
+
+#endif
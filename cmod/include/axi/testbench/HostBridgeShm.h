@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXI_T_HOST_BRIDGE_SHM__
+#define __AXI_T_HOST_BRIDGE_SHM__
+
+// Shared by the model and the host process, so this header does not depend
+// on SystemC or MatchLib.
+#include <stdint.h>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2,
+              "The host bridge needs lock-free atomics in shared memory");
+
+/**
+ * \brief One request or response slot of the host bridge rings.
+ * \ingroup AXI
+ *
+ * \par Overview
+ * Requests from the host are reads, writes of up to kMaxBytes bytes at addr,
+ * or a stop. Every read and write gets one response with the same kind and
+ * tag, the AXI response code in status (the worst one over the beats of a
+ * burst) and, for reads, the data. A rising edge of the model's interrupt
+ * arrives as a response of kind kInterrupt, with the number of interrupts so
+ * far in tag.
+ */
+struct HostBridgeMsg {
+  enum { kMaxBytes = 256 };
+  enum Kind { kRead = 0, kWrite = 1, kInterrupt = 2, kStop = 3 };
+  uint32_t kind;
+  uint32_t tag;
+  uint64_t addr;
+  uint32_t bytes;
+  uint32_t status;
+  uint8_t data[kMaxBytes];
+};
+
+/**
+ * \brief Head and tail of a single-producer, single-consumer ring.
+ * \ingroup AXI
+ *
+ * The indices count slots since the ring was created and wrap at 2^32; the
+ * slot of index i is i % num_slots, with num_slots a power of two.
+ */
+struct HostBridgeRing {
+  alignas(64) std::atomic<uint32_t> tail;  // Written by the producer
+  alignas(64) std::atomic<uint32_t> head;  // Written by the consumer
+};
+
+/**
+ * \brief One direction of the host bridge, as seen by one of its two users.
+ * \ingroup AXI
+ *
+ * \par Overview
+ * HostBridgeQueue is a lock-free ring of HostBridgeMsg slots in shared
+ * memory. Slots are filled and read in place:
+ * - The producer gets the next free slot with Reserve(), fills it, and
+ *   publishes every slot reserved so far with one release store in Commit(),
+ *   so a batch of requests costs one synchronization.
+ * - The consumer sees Available() published slots, reads them with Peek(i)
+ *   and hands them back with Release(n).
+ *
+ * Each side caches the other side's index and reloads it only when the ring
+ * looks full or empty.
+ */
+class HostBridgeQueue {
+ public:
+  HostBridgeQueue() : ring_(NULL), slots_(NULL), mask_(0), local_(0), other_(0) {}
+
+  void Bind(HostBridgeRing* ring, HostBridgeMsg* slots, uint32_t num_slots, bool producer) {
+    ring_ = ring;
+    slots_ = slots;
+    mask_ = num_slots - 1;
+    if (producer) {
+      local_ = ring_->tail.load(std::memory_order_relaxed);
+      other_ = ring_->head.load(std::memory_order_acquire);
+    } else {
+      local_ = ring_->head.load(std::memory_order_relaxed);
+      other_ = ring_->tail.load(std::memory_order_acquire);
+    }
+  }
+
+  // Producer: the next free slot, or NULL when the ring is full
+  HostBridgeMsg* Reserve() {
+    if (local_ - other_ > mask_) {
+      other_ = ring_->head.load(std::memory_order_acquire);
+      if (local_ - other_ > mask_) return NULL;
+    }
+    return &slots_[local_++ & mask_];
+  }
+
+  // Producer: publishes the slots reserved so far
+  void Commit() { ring_->tail.store(local_, std::memory_order_release); }
+
+  // Consumer: number of published slots not yet released
+  uint32_t Available() {
+    if (other_ == local_) {
+      other_ = ring_->tail.load(std::memory_order_acquire);
+    }
+    return other_ - local_;
+  }
+
+  // Consumer: the i-th published slot, i < Available()
+  const HostBridgeMsg& Peek(uint32_t i = 0) const { return slots_[(local_ + i) & mask_]; }
+
+  // Consumer: hands the oldest n slots back to the producer
+  void Release(uint32_t n = 1) {
+    local_ += n;
+    ring_->head.store(local_, std::memory_order_release);
+  }
+
+ protected:
+  HostBridgeRing* ring_;
+  HostBridgeMsg* slots_;
+  uint32_t mask_;
+  uint32_t local_;  // Our index: tail for the producer, head for the consumer
+  uint32_t other_;  // Last seen index of the other side
+};
+
+/**
+ * \brief POSIX shared-memory region holding the two host bridge rings.
+ * \ingroup AXI
+ *
+ * \par Overview
+ * The model creates the region with Create(), named as for shm_open(), e.g.
+ * "/matchlib_host"; the host process maps it with Attach(). Requests() and
+ * Responses() are the request ring, produced by the host, and the response
+ * ring, produced by the model, each bound to the side's role. The creator
+ * unlinks the name when it is destroyed.
+ */
+class HostBridgeShm {
+ public:
+  enum { kMagic = 0x4d4c4842, kVersion = 1 };
+
+  struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t num_slots;
+    HostBridgeRing req;
+    HostBridgeRing rsp;
+  };
+
+  HostBridgeShm() : base_(NULL), size_(0), owner_(false) {}
+  ~HostBridgeShm() { Close(); }
+
+  // Model side: creates, or recreates, the region with num_slots per ring
+  bool Create(const std::string& name, uint32_t num_slots = 64) {
+    Close();
+    if (num_slots == 0 || (num_slots & (num_slots - 1)) != 0) return false;
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return false;
+    size_t size = Size(num_slots);
+    if (ftruncate(fd, size) != 0 || !Map(fd, size)) {
+      close(fd);
+      shm_unlink(name.c_str());
+      return false;
+    }
+    close(fd);
+    name_ = name;
+    owner_ = true;
+    Header* header = GetHeader();
+    header->num_slots = num_slots;
+    header->version = kVersion;
+    header->req.tail.store(0);
+    header->req.head.store(0);
+    header->rsp.tail.store(0);
+    header->rsp.head.store(0);
+    // Published last, so that Attach() never sees a half-initialized region
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = kMagic;
+    Bind(true);
+    return true;
+  }
+
+  // Host side: maps a region created by the model
+  bool Attach(const std::string& name) {
+    Close();
+    int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0) return false;
+    struct stat st;
+    bool ok = (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(Header) &&
+               Map(fd, st.st_size));
+    close(fd);
+    if (!ok) return false;
+    Header* header = GetHeader();
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header->magic != kMagic || header->version != kVersion ||
+        size_ < Size(header->num_slots)) {
+      Close();
+      return false;
+    }
+    name_ = name;
+    Bind(false);
+    return true;
+  }
+
+  void Close() {
+    if (base_ != NULL) {
+      munmap(base_, size_);
+      if (owner_) shm_unlink(name_.c_str());
+    }
+    base_ = NULL;
+    size_ = 0;
+    owner_ = false;
+  }
+
+  bool IsOpen() const { return base_ != NULL; }
+  uint32_t NumSlots() const { return base_ != NULL ? GetHeader()->num_slots : 0; }
+
+  HostBridgeQueue& Requests() { return requests_; }
+  HostBridgeQueue& Responses() { return responses_; }
+
+ protected:
+  static size_t Size(uint32_t num_slots) {
+    return sizeof(Header) + 2 * static_cast<size_t>(num_slots) * sizeof(HostBridgeMsg);
+  }
+
+  bool Map(int fd, size_t size) {
+    void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) return false;
+    base_ = base;
+    size_ = size;
+    return true;
+  }
+
+  Header* GetHeader() const { return static_cast<Header*>(base_); }
+
+  void Bind(bool model) {
+    Header* header = GetHeader();
+    HostBridgeMsg* slots = reinterpret_cast<HostBridgeMsg*>(header + 1);
+    requests_.Bind(&header->req, slots, header->num_slots, !model);
+    responses_.Bind(&header->rsp, slots + header->num_slots, header->num_slots, model);
+  }
+
+  void* base_;
+  size_t size_;
+  bool owner_;
+  std::string name_;
+  HostBridgeQueue requests_;
+  HostBridgeQueue responses_;
+};
+
+/**
+ * \brief Host-side API of the host bridge, for driver software.
+ * \ingroup AXI
+ *
+ * \par Overview
+ * Read(), Write() and Stop() fill the next request slot, and return false
+ * when the ring is full; nothing reaches the model until Submit() publishes
+ * the batch. Poll() returns the next response or interrupt, or NULL, and
+ * Done() releases it. Read data is copied out of the slot only by the caller.
+ *
+ * \par A Simple Example
+ * \code
+ *      HostBridgeClient host;
+ *      while (!host.Attach("/matchlib_host")) usleep(1000);
+ *      host.Write(0x1000, buf, 64, 1);
+ *      host.Read(0x1000, 64, 2);
+ *      host.Submit();
+ *      for (unsigned int done = 0; done < 2;) {
+ *        const HostBridgeMsg* rsp = host.Poll();
+ *        if (rsp == NULL) continue;
+ *        if (rsp->kind == HostBridgeMsg::kRead) memcpy(out, rsp->data, rsp->bytes);
+ *        if (rsp->kind != HostBridgeMsg::kInterrupt) done++;
+ *        host.Done();
+ *      }
+ *      host.Stop();
+ *      host.Submit();
+ * \endcode
+ * \par
+ *
+ */
+class HostBridgeClient {
+ public:
+  bool Attach(const std::string& name) { return shm_.Attach(name); }
+  bool IsAttached() const { return shm_.IsOpen(); }
+
+  bool Write(uint64_t addr, const void* data, uint32_t bytes, uint32_t tag) {
+    if (bytes > HostBridgeMsg::kMaxBytes) return false;
+    HostBridgeMsg* msg = Request(HostBridgeMsg::kWrite, addr, bytes, tag);
+    if (msg == NULL) return false;
+    memcpy(msg->data, data, bytes);
+    return true;
+  }
+
+  bool Read(uint64_t addr, uint32_t bytes, uint32_t tag) {
+    if (bytes > HostBridgeMsg::kMaxBytes) return false;
+    return Request(HostBridgeMsg::kRead, addr, bytes, tag) != NULL;
+  }
+
+  // Asks the model to raise done once the earlier requests completed
+  bool Stop() { return Request(HostBridgeMsg::kStop, 0, 0, 0) != NULL; }
+
+  void Submit() { shm_.Requests().Commit(); }
+
+  const HostBridgeMsg* Poll() {
+    HostBridgeQueue& rsp = shm_.Responses();
+    return rsp.Available() != 0 ? &rsp.Peek() : NULL;
+  }
+
+  void Done() { shm_.Responses().Release(); }
+
+ protected:
+  HostBridgeMsg* Request(uint32_t kind, uint64_t addr, uint32_t bytes, uint32_t tag) {
+    HostBridgeMsg* msg = shm_.Requests().Reserve();
+    if (msg == NULL) return NULL;
+    msg->kind = kind;
+    msg->tag = tag;
+    msg->addr = addr;
+    msg->bytes = bytes;
+    msg->status = 0;
+    return msg;
+  }
+
+  HostBridgeShm shm_;
+};
+
+#endif
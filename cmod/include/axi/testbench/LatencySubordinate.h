@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXI_T_LATENCY_SUBORDINATE__
+#define __AXI_T_LATENCY_SUBORDINATE__
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+
+#include <axi/axi4.h>
+#include <axi/testbench/AddrTracker.h>
+#include <nvhls_connections.h>
+#include <hls_globals.h>
+
+#include <deque>
+#include <queue>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <boost/assert.hpp>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+/**
+ * \brief An example config for the latency-modeling AXI subordinate.
+ *
+ * \par The following constants must be defined:
+ *
+ * - fixedLatency: The number of cycles added to every request after its bank access, before its first read beat or its write response.
+ * - randomLatency: The maximum of a uniformly distributed random number of cycles added to every request.
+ * - numBanks: The number of banks.
+ * - rowBytes: The number of bytes in one row of a bank.  Consecutive rows are interleaved across the banks.
+ * - rowHitLatency: The number of cycles a bank is busy for an access to its open row.
+ * - rowMissLatency: The number of cycles a bank is busy for an access to any other row, including closing the open row and opening the new one.
+ * - maxOutstanding: The maximum number of reads and writes that have been accepted but not yet fully responded to.
+ * - outOfOrder: If 1, responses with different IDs return as soon as they are ready, in any order.  If 0, reads (writes) respond in the order they were accepted.
+ * - seed: The random seed.
+ */
+struct latencySubordinateCfg {
+  enum {
+    fixedLatency = 10,
+    randomLatency = 4,
+    numBanks = 8,
+    rowBytes = 2048,
+    rowHitLatency = 4,
+    rowMissLatency = 20,
+    maxOutstanding = 16,
+    outOfOrder = 0,
+    seed = 0,
+  };
+};
+
+/**
+ * \brief An AXI subordinate memory with DRAM-like response timing for use in a testbench.
+ * \ingroup AXI
+ *
+ * \tparam axiCfg                   A valid AXI config.
+ * \tparam cfg                      A valid config for the subordinate (such as latencySubordinateCfg).
+ *
+ * \par Overview
+ * LatencySubordinate stores and returns data like Subordinate, and enforces the same assertions, but delays its responses the way a banked DRAM would:
+ * - Each request is one access to the bank and row of its start address.  The access starts once the bank is free, and keeps the bank busy for rowHitLatency cycles if the bank has that row open, or rowMissLatency cycles otherwise.  The accessed row is left open.
+ * - The response is ready fixedLatency cycles, plus a random number of cycles up to randomLatency, after the bank access ends.  Read beats then stream out one per cycle.
+ * - A read is accessed when its request is accepted, and a write when its last data beat is accepted.
+ * - At most maxOutstanding requests are in flight; further requests are back-pressured.
+ * - With outOfOrder set, a ready response is returned ahead of older responses with other IDs.  Responses with the same ID are always returned in order.
+ *
+ * Without write responses, a Manager must wait longer after a write than this model can back-pressure it (see the readDelay of managerCfg).
+ *
+ * The public counters numRowHits, numRowMisses, numReadBursts and readLatency (the total number of cycles from accepting a read request to sending its first beat) allow a testbench to report the memory behavior it observed.
+ *
+ * \par A Simple Example
+ * \code
+ *      LatencySubordinate<axi::cfg::standard, latencySubordinateCfg> subordinate;
+ * \endcode
+ * \par
+ *
+ */
+template <typename axiCfg, typename cfg>
+class LatencySubordinate : public sc_module {
+  BOOST_STATIC_ASSERT_MSG(cfg::numBanks > 0 && cfg::rowBytes > 0, "Must have at least one bank and one byte per row");
+  BOOST_STATIC_ASSERT_MSG(cfg::maxOutstanding > 0, "Must accept at least one outstanding request");
+ public:
+  static const int kDebugLevel = 1;
+  typedef axi::axi4<axiCfg> axi4_;
+
+  typename axi4_::read::template subordinate<> if_rd;
+  typename axi4_::write::template subordinate<> if_wr;
+
+  sc_in<bool> reset_bar;
+  sc_in<bool> clk;
+
+  static const int bytesPerBeat = axi4_::DATA_WIDTH >> 3;
+
+  typedef NVUINTW(bytesPerBeat) ByteMask;
+  typedef std::unordered_map<typename axi4_::Addr, typename axi4_::Data, AxiAddrHash> ShadowMem;
+  typedef std::unordered_map<typename axi4_::Addr, ByteMask, AxiAddrHash> ShadowMask;
+
+  ShadowMem localMem;           // Word address -> stored data; an entry means the word was written
+  ShadowMask localMem_wstrb;    // Word address -> bytes written with their strobe set
+
+  uint64_t numRowHits;
+  uint64_t numRowMisses;
+  uint64_t numReadBursts;
+  uint64_t readLatency;
+
+  SC_CTOR(LatencySubordinate)
+      : if_rd("if_rd"), if_wr("if_wr"), reset_bar("reset_bar"), clk("clk"),
+        numRowHits(0), numRowMisses(0), numReadBursts(0), readLatency(0) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+ protected:
+  struct ReadReq {
+    uint64_t accepted;
+    uint64_t due;
+    uint64_t id;
+    std::vector<typename axi4_::ReadPayload> beats;
+  };
+  struct WriteReq {
+    uint64_t due;
+    uint64_t id;
+    typename axi4_::WRespPayload resp;
+  };
+
+  std::vector<uint64_t> bankReady;
+  std::vector<int64_t> openRow;
+  uint64_t cycle;
+
+  // Accesses the bank of addr and returns the cycle at which the response is ready
+  template <typename Gen, typename Dist>
+  uint64_t access(uint64_t addr, Gen& gen, Dist& random_latency) {
+    unsigned int bank = (addr / cfg::rowBytes) % cfg::numBanks;
+    int64_t row = addr / (static_cast<uint64_t>(cfg::rowBytes) * cfg::numBanks);
+    uint64_t start = std::max(cycle, bankReady[bank]);
+    if (openRow[bank] == row) {
+      bankReady[bank] = start + cfg::rowHitLatency;
+      numRowHits++;
+    } else {
+      bankReady[bank] = start + cfg::rowMissLatency;
+      openRow[bank] = row;
+      numRowMisses++;
+    }
+    return bankReady[bank] + cfg::fixedLatency + random_latency(gen);
+  }
+
+  // Returns the index of the next response to send, or -1 if none is ready.  A response
+  // may pass an older one only out of order, and never one with the same ID.
+  template <typename Req>
+  int next_response(const std::deque<Req>& pending) {
+    std::vector<uint64_t> blocked;
+    for (unsigned int i = 0; i < pending.size(); i++) {
+      bool older_same_id = std::find(blocked.begin(), blocked.end(), pending[i].id) != blocked.end();
+      if (pending[i].due <= cycle && !older_same_id) return i;
+      if (!cfg::outOfOrder) return -1;
+      blocked.push_back(pending[i].id);
+    }
+    return -1;
+  }
+
+  void run() {
+    if_rd.reset();
+    if_wr.reset();
+
+    unsigned int seed = cfg::seed;
+#ifdef NVHLS_RAND_SEED
+    seed = (NVHLS_RAND_SEED);
+#endif
+    const char* env_rand_seed = std::getenv("NVHLS_RAND_SEED");
+    if (env_rand_seed != NULL) seed = atoi(env_rand_seed);
+    boost::random::mt19937 gen(seed);
+    boost::random::uniform_int_distribution<> random_latency(0, cfg::randomLatency);
+
+    bankReady.assign(cfg::numBanks, 0);
+    openRow.assign(cfg::numBanks, -1);
+    cycle = 0;
+
+    std::deque<ReadReq> rd_pending;
+    std::deque<WriteReq> wr_pending;
+    std::queue<typename axi4_::ReadPayload> rd_resp;  // Beats of the read burst being returned
+    std::queue<typename axi4_::AddrPayload> wr_addr;  // Write requests waiting for their data
+    unsigned int outstanding = 0;
+    typename axi4_::Addr wresp_addr;
+    bool first_beat = true;
+
+    while (1) {
+      wait();
+
+      // Return read data, one burst at a time
+      if (rd_resp.empty()) {
+        int i = next_response(rd_pending);
+        if (i >= 0) {
+          for (unsigned int j = 0; j < rd_pending[i].beats.size(); j++) {
+            rd_resp.push(rd_pending[i].beats[j]);
+          }
+          readLatency += cycle - rd_pending[i].accepted;
+          numReadBursts++;
+          rd_pending.erase(rd_pending.begin() + i);
+        }
+      }
+      if (!rd_resp.empty()) {
+        if (if_rd.nb_rwrite(rd_resp.front())) {
+          CDCOUT(sc_time_stamp() << " " << name() << " Returned read data:"
+                        << " data=[" << rd_resp.front() << "]"
+                        << endl, kDebugLevel);
+          if (rd_resp.front().last == 1) {
+            outstanding--;
+          }
+          rd_resp.pop();
+        }
+      }
+
+      // Return a write response
+      if (axiCfg::useWriteResponses) {
+        int i = next_response(wr_pending);
+        if (i >= 0 && if_wr.nb_bwrite(wr_pending[i].resp)) {
+          CDCOUT(sc_time_stamp() << " " << name() << " Sent write response: ["
+                                 << wr_pending[i].resp << "]"
+                                 << endl, kDebugLevel);
+          wr_pending.erase(wr_pending.begin() + i);
+          outstanding--;
+        }
+      }
+
+      // Accept a read request and read its data
+      typename axi4_::AddrPayload rd_addr_pld;
+      if (outstanding < cfg::maxOutstanding && if_rd.nb_aread(rd_addr_pld)) {
+        typename axi4_::Addr addr = rd_addr_pld.addr;
+        CMOD_ASSERT_MSG(addr % bytesPerBeat == 0, "Addresses must be word aligned");
+        CDCOUT(sc_time_stamp() << " " << name() << " Received read request: ["
+                      << rd_addr_pld << "]"
+                      << endl, kDebugLevel);
+        std::ostringstream msg;
+        msg << "\nError @" << sc_time_stamp() << " from " << name()
+            << ": Received a read request from an address that has not yet been written to"
+            << ", addr=" << hex << addr
+            << endl;
+        BOOST_ASSERT_MSG( localMem.count(addr), msg.str().c_str() );
+        ReadReq req;
+        req.accepted = cycle;
+        req.id = rd_addr_pld.id.to_uint64();
+        NVUINTW(axi4_::ALEN_WIDTH) len = (axiCfg::useBurst ? rd_addr_pld.len : NVUINTW(axi4_::ALEN_WIDTH)(0));
+        for (unsigned int i=0; i<(len+1); i++) {
+          typename axi4_::ReadPayload data_pld;
+          data_pld.data = 0;
+          typename ShadowMem::const_iterator mem_it = localMem.find(addr);
+          if (mem_it != localMem.end()) {
+            if (axiCfg::useWriteStrobes) {
+              ByteMask mask = localMem_wstrb[addr];
+              for (int k=0; k<axi4_::WSTRB_WIDTH; k++) {
+                if (mask[k] == 1) {
+                  data_pld.data = nvhls::set_slc(data_pld.data, nvhls::get_slc<8>(mem_it->second, 8*k), 8*k);
+                }
+              }
+            } else {
+              data_pld.data = mem_it->second;
+            }
+          }
+          data_pld.resp = axi4_::Enc::XRESP::OKAY;
+          data_pld.id = rd_addr_pld.id;
+          data_pld.last = (i == len);
+          req.beats.push_back(data_pld);
+          addr += bytesPerBeat;
+        }
+        req.due = access(rd_addr_pld.addr.to_uint64(), gen, random_latency);
+        rd_pending.push_back(req);
+        outstanding++;
+      }
+
+      // Accept a write request
+      typename axi4_::AddrPayload wr_addr_pld;
+      if (outstanding < cfg::maxOutstanding && if_wr.aw.PopNB(wr_addr_pld)) {
+        CMOD_ASSERT_MSG(wr_addr_pld.addr.to_uint64() % bytesPerBeat == 0, "Addresses must be word aligned");
+        CDCOUT(sc_time_stamp() << " " << name() << " Received write request: ["
+                      << wr_addr_pld << "]"
+                      << endl, kDebugLevel);
+        wr_addr.push(wr_addr_pld);
+        outstanding++;
+      }
+
+      // Accept write data for the oldest write request and store it
+      typename axi4_::WritePayload wr_data_pld;
+      if (!wr_addr.empty() && if_wr.w.PopNB(wr_data_pld)) {
+        if (first_beat) {
+          wresp_addr = wr_addr.front().addr;
+          first_beat = false;
+        }
+        CDCOUT(sc_time_stamp() << " " << name() << " Received write data:"
+                      << " data=[" << wr_data_pld << "]"
+                      << endl, kDebugLevel);
+        if (axiCfg::useWriteStrobes) {
+          std::ostringstream msg;
+          msg << "\nError @" << sc_time_stamp() << " from " << name()
+              << ": Wstrb cannot be all zeros" << endl;
+          BOOST_ASSERT_MSG( wr_data_pld.wstrb != 0, msg.str().c_str() );
+          typename axi4_::Data& shadow = localMem.insert(std::make_pair(wresp_addr, typename axi4_::Data(0))).first->second;
+          ByteMask& mask = localMem_wstrb.insert(std::make_pair(wresp_addr, ByteMask(0))).first->second;
+          for (int j=0; j<axi4_::WSTRB_WIDTH; j++) {
+            if (wr_data_pld.wstrb[j] == 1) {
+              shadow = nvhls::set_slc(shadow, nvhls::get_slc<8>(wr_data_pld.data, 8*j), 8*j);
+              mask[j] = 1;
+            }
+          }
+        } else {
+          localMem[wresp_addr] = wr_data_pld.data;
+        }
+        wresp_addr += bytesPerBeat;
+        if (wr_data_pld.last == 1) {
+          typename axi4_::AddrPayload wr_addr_pld_out = wr_addr.front();
+          wr_addr.pop();
+          first_beat = true;
+          uint64_t due = access(wr_addr_pld_out.addr.to_uint64(), gen, random_latency);
+          if (axiCfg::useWriteResponses) {
+            WriteReq req;
+            req.due = due;
+            req.id = wr_addr_pld_out.id.to_uint64();
+            req.resp.resp = axi4_::Enc::XRESP::OKAY;
+            req.resp.id = wr_addr_pld_out.id;
+            wr_pending.push_back(req);
+          } else {
+            outstanding--;
+          }
+        }
+      }
+
+      cycle++;
+    }
+  }
+};
+
+#endif
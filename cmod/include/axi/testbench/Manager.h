@@ -20,6 +20,8 @@
 #include <ac_reset_signal_is.h>
 
 #include <axi/axi4.h>
+#include <axi/testbench/AddrTracker.h>
+#include <axi/testbench/TrafficProfile.h>
 #include <nvhls_connections.h>
 #include <hls_globals.h>
 
@@ -27,7 +29,7 @@
 #include <string>
 #include <sstream>
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include <math.h>
 #include <boost/assert.hpp>
 
@@ -60,11 +62,12 @@ struct managerCfg {
 };
 
 /**
- * \brief An AXI manager that generates random traffic for use in a testbench.
+ * \brief An AXI manager that generates random or profiled traffic for use in a testbench.
  * \ingroup AXI
  *
  * \tparam axiCfg                   A valid AXI config.
  * \tparam cfg                      A valid config for the manager (such as managerCfg).
+ * \tparam profile                  A traffic profile (default: axi::traffic::random, the original random traffic).
  *
  * \par Overview
  * Manager is an AXI manager block for use in testbenches.  It generates read and write requests and checks the responses.  The block supports AXI configurations with and without burst mode, write strobes, and write responses.  The block enforces the following via assertion:
@@ -74,19 +77,37 @@ struct managerCfg {
  * - Responses should assert the AXI "OKAY" response code.
  * - The number of read (write) responses should not exceed the number of read (write) requests.
  *
- * In addition, the block asserts a done signal only when each request has received a corresponding response.  The Manager generates random requests according to the following algorithm:
- * - Writes are generated to an address randomly selected from the valid range.  20% of writes have burst length greater than one; these writes randomly select a burst length from the valid range.  20% of write data beats have nonuniform strobes; the strobe bits of these write data beats are randomly set.  Some data bits are generated via a hash of the address, while others are randomly generated.  The data associated with a given address is stored locally so reads to that address can be validated later.
+ * In addition, the block asserts a done signal only when each request has received a corresponding response.  The Manager generates requests according to a traffic profile (see axi::traffic::random for the constants it defines), using the following algorithm:
+ * - Write bursts start at an address chosen by the profile's pattern: random within the valid range, sequential, strided, or near the previous burst.  Burst lengths are either fixed by the profile or random; with the default profile, 20% of writes have a burst length greater than one, selected randomly from the valid range.  20% of write data beats have nonuniform strobes; the strobe bits of these write data beats are randomly set.  Some data bits are generated via a hash of the address, while others are randomly generated.  The data associated with a given address is stored locally so reads to that address can be validated later.
  * - Every AXI address that is written to (including multiple addresses for bursts) is added to the list of valid read addresses, which is initially empty.  If write responses are enabled, the addresses are added only when the write response is received; otherwise, they are added when the write is sent.
  * - If the readDelay is greater than zero, a delay elapses before addresses that have been written to are added to the list of valid read addresses.  If a write is issued to an address that has been previously written to, the address is removed from the list of valid read addresses and the readDelay timer for that address is reset.
  * - Writes that are issued to an address that has an outstanding read request in flight are discarded and not issued.  Reads that are issued to an address that has an outstanding write request in flight are not issued (unless write requests are not supported, in which case only a non-zero readDelay prevents this race).
- * - Reads are randomly selected from the list of valid read addresses, so that reads only issue to address that have already been written to.  This means that no reads issue until the first write response has returned.
- * - 50% of reads requests are initiated as bursts, with the burst length randomly selected from the valid range.  If a read burst would include one or more addresses as part of the burst that have not yet been written to, the read request is discarded and not issued.
+ * - With the RANDOM pattern, reads are randomly selected from the list of valid read addresses, so that reads only issue to address that have already been written to.  This means that no reads issue until the first write response has returned.  With the other patterns, reads replay the write bursts in the order they were issued, each waiting until all of its addresses are valid; once every write burst has been read back, reads fall back to random selection.
+ * - With random burst lengths, 50% of random read requests are initiated as bursts by default, with the burst length randomly selected from the valid range.  If a read burst would include one or more addresses as part of the burst that have not yet been written to, the read request is discarded and not issued.
+ * - Requests rotate through the profile's numIds AXI IDs, and a request waits while its ID already has maxOutstandingPerId requests outstanding.  Responses are checked in order per ID.  The AR and AW channels each issue at most injectPct requests per 100 cycles, and unless readPct is INDEPENDENT, a kind of request waits while it is more than mixSlack requests ahead of its share of the mix.
+ *
+ * The shadow memory is a hash map with one entry per data word, holding the merged write data and, for configs with write strobes, a mask of the bytes that have been written.  Valid read addresses are kept in an AxiAddrSet and the readDelay timers in an AxiTimingWheel, so the bookkeeping cost per beat does not grow with the number of addresses written.
+ *
+ * \par A Simple Example
+ * \code
+ *      // Stream 16-beat bursts over two IDs, half reads and half writes
+ *      Manager<axi::cfg::standard, managerCfg, axi::traffic::streaming> manager;
+ * \endcode
+ * \par
  *
  */
-template <typename axiCfg, typename cfg>
+template <typename axiCfg, typename cfg, typename profile = axi::traffic::random>
 class Manager : public sc_module {
   BOOST_STATIC_ASSERT_MSG(axiCfg::useWriteResponses || cfg::numReads == 0 || cfg::readDelay != 0,
                 "Must use a substantial read delay if reading without write responses");
+  BOOST_STATIC_ASSERT_MSG(profile::numIds >= 1 && profile::numIds <= (1 << axiCfg::idWidth),
+                "The traffic profile must use between one ID and every ID of the AXI config");
+  BOOST_STATIC_ASSERT_MSG(profile::burstLen >= 0 && profile::burstLen <= (axiCfg::useBurst ? axiCfg::maxBurstSize : 1),
+                "The traffic profile's burst length must fit the AXI config");
+  BOOST_STATIC_ASSERT_MSG(profile::injectPct > 0 && profile::injectPct <= 100,
+                "The injection rate must be between 1 and 100 requests per 100 cycles");
+  BOOST_STATIC_ASSERT_MSG(profile::readPct == axi::traffic::INDEPENDENT || (profile::readPct >= 0 && profile::readPct <= 100),
+                "The read share must be INDEPENDENT or a percentage");
  public:
   static const int kDebugLevel = 1;
   typedef axi::axi4<axiCfg> axi4_;
@@ -97,19 +118,30 @@ class Manager : public sc_module {
   sc_in<bool> reset_bar;
   sc_in<bool> clk;
 
-  std::map<typename axi4_::Addr, typename axi4_::Data> localMem;
-  std::map<typename axi4_::Addr, NVUINT8 > localMem_wstrb;
-  std::vector<typename axi4_::Addr> validReadAddresses;
-  std::vector<typename axi4_::Addr> validReadAddresses_q;
-  std::vector< long long > validReadAddresses_ctr;
-
   static const int bytesPerBeat = axi4_::DATA_WIDTH >> 3;
   static const bool wResp = axiCfg::useWriteResponses;
+  // Longest readDelay timer: the last beat of a maximum-length burst
+  static const int maxReadDelay = cfg::readDelay + 20 * (axiCfg::maxBurstSize - 1);
+  static const int pattern = profile::pattern;
+  static const unsigned int numIds = profile::numIds;
+  static const unsigned int maxOutstandingPerId = profile::maxOutstandingPerId;
+  // Requests that one kind may run ahead of its share of the read/write mix
+  static const unsigned int mixSlack = 16;
+
+  typedef NVUINTW(bytesPerBeat) ByteMask;
+  typedef std::unordered_map<typename axi4_::Addr, typename axi4_::Data, AxiAddrHash> ShadowMem;
+  typedef std::unordered_map<typename axi4_::Addr, ByteMask, AxiAddrHash> ShadowMask;
+
+  ShadowMem localMem;           // Word address -> last write data (strobed bytes merged)
+  ShadowMask localMem_wstrb;    // Word address -> bytes written with their strobe set
+  AxiAddrSet<typename axi4_::Addr> validReadAddresses;
+  AxiTimingWheel<typename axi4_::Addr> validReadAddresses_q;
 
   sc_out<bool> done;
 
   SC_CTOR(Manager)
-      : if_rd("if_rd"), if_wr("if_wr"), reset_bar("reset_bar"), clk("clk") {
+      : if_rd("if_rd"), if_wr("if_wr"), reset_bar("reset_bar"), clk("clk"),
+        validReadAddresses_q(maxReadDelay) {
 
     SC_THREAD(run);
     sensitive << clk.pos();
@@ -123,11 +155,20 @@ class Manager : public sc_module {
     // Workaround for useBurst=0, which sets ALEN field to 0 width
     static const int ALEN_W = axiCfg::useBurst != 0 ? axi4_::ALEN_WIDTH : 1; 
     static const int WSTRB_W = axiCfg::useWriteStrobes != 0 ? axi4_::WSTRB_WIDTH : 1; 
-    std::queue <typename axi4_::Addr> raddr_queue;
-    std::queue < NVUINTW(ALEN_W) > rlen_queue;
-    std::queue <typename axi4_::Addr> waddr_queue;
-    std::queue < NVUINTW(ALEN_W) > wlen_queue;
+    // Fixed burst length of the traffic profile, as an ALEN value
+    static const int fixedLen = (axiCfg::useBurst && profile::burstLen > 0) ? profile::burstLen - 1 : 0;
+    static const bool replayReads = pattern != axi::traffic::RANDOM;
+    typedef NVUINTW(ALEN_W) Len;
+    // In-flight beat addresses and burst lengths, per ID
+    std::vector< std::queue <typename axi4_::Addr> > raddr_queue(numIds);
+    std::vector< std::queue <Len> > rlen_queue(numIds);
+    std::vector< unsigned int > numReadsOfBurst(numIds, 0);
+    std::vector< std::queue <typename axi4_::Addr> > waddr_queue(numIds);
+    std::vector< std::queue <Len> > wlen_queue(numIds);
+    // Write bursts in issue order, for the patterns whose reads replay them
+    std::queue< std::pair<typename axi4_::Addr, Len> > replay_queue;
     typename axi4_::Data check_data;
+    ByteMask check_mask;
     NVUINT8 check_data_wstrb;
     NVUINT8 rcv_data_wstrb;
     typename axi4_::AddrPayload addr_pld;
@@ -145,14 +186,23 @@ class Manager : public sc_module {
     boost::random::uniform_int_distribution<> random_wstrb(1, pow(2,WSTRB_W)-1);
     boost::random::uniform_int_distribution<> random_burstlen(0, axiCfg::maxBurstSize-1);
     boost::random::uniform_int_distribution<> uniform_rand;
+    boost::random::uniform_int_distribution<int64_t> random_offset(-static_cast<int64_t>(profile::localityWindow),
+                                                                   profile::localityWindow);
 
     typename axi4_::Addr wr_addr = cfg::addrBoundLower;
+    typename axi4_::Addr wr_base = cfg::addrBoundLower; // Start of the current write burst
     typename axi4_::Data wr_data = 0xf00dcafe12345678;
     NVUINTW(WSTRB_W) wstrb = ~0;
-    NVUINTW(ALEN_W) wr_len = 0;
+    Len wr_len = fixedLen;
+    if (wr_addr + bytesPerBeat*wr_len > cfg::addrBoundUpper) wr_len = 0;
     typename axi4_::Addr rd_addr_next;
     typename axi4_::Addr rd_addr;
-    NVUINTW(ALEN_W) rd_len;
+    Len rd_len = 0;
+    unsigned int rd_id = 0;
+    unsigned int wr_id = 0;
+    // Issue credit of each request channel, in hundredths of a request
+    int ar_credit = 100;
+    int aw_credit = 100;
     typename axi4_::AddrPayload wr_addr_pld;
     typename axi4_::WritePayload wr_data_pld;
     typename axi4_::WRespPayload wr_resp_pld;
@@ -161,7 +211,6 @@ class Manager : public sc_module {
     unsigned int numWrites = 0;
     unsigned int numReads = 0;
     unsigned int numWritesOfBurst = 0;
-    unsigned int numReadsOfBurst = 0;
     unsigned int numWriteResponses = 0;
     unsigned int numReadResponses = 0;
     bool writeInProgress = false;
@@ -175,16 +224,46 @@ class Manager : public sc_module {
     while (1) {
       wait();
 
+      // Accrue issue credit at the profile's injection rate
+      if (ar_credit < 100) ar_credit += profile::injectPct;
+      if (aw_credit < 100) aw_credit += profile::injectPct;
+
+      bool rd_ready = validReadAddresses.size() > 0 && numReads < cfg::numReads && ar_credit >= 100 &&
+                      (maxOutstandingPerId == 0 || rlen_queue[rd_id].size() < maxOutstandingPerId);
+      bool wr_ready = !writeInProgress && numWrites < cfg::numWrites && aw_credit >= 100 &&
+                      (!wResp || maxOutstandingPerId == 0 || wlen_queue[wr_id].size() < maxOutstandingPerId);
+      // Hold the read/write mix: a kind of request waits while it is more than mixSlack
+      // requests ahead of its share, unless the other kind has finished
+      if (profile::readPct != axi::traffic::INDEPENDENT) {
+        unsigned int numIssued = numReads + numWrites + writeInProgress;
+        if (numWrites < cfg::numWrites && 100 * numReads > profile::readPct * numIssued + 100 * mixSlack)
+          rd_ready = false;
+        if (numReads < cfg::numReads &&
+            100 * (numWrites + writeInProgress) > (100 - profile::readPct) * numIssued + 100 * mixSlack)
+          wr_ready = false;
+      }
+
       // READ
-      if (validReadAddresses.size() > 0 && numReads < cfg::numReads) {
-        rd_addr_next = validReadAddresses[uniform_rand(gen) % validReadAddresses.size()];
+      if (rd_ready) {
+        bool replay = replayReads && !replay_queue.empty();
+        if (replay) {
+          rd_addr_next = replay_queue.front().first;
+          rd_len = replay_queue.front().second;
+        } else {
+          rd_addr_next = validReadAddresses[uniform_rand(gen) % validReadAddresses.size()];
+          if (axiCfg::useBurst) {
+            if (profile::burstLen > 0) {
+              rd_len = fixedLen;
+            } else if (uniform_rand(gen) % 100 < profile::readBurstPct) { // 50% of reads are bursts by default (less once valid addresses are disallowed)
+              rd_len = random_burstlen(gen);
+            } else {
+              rd_len = 0;
+            }
+          }
+        }
         addr_pld.addr = rd_addr_next;
+        addr_pld.id = rd_id;
         if (axiCfg::useBurst) {
-          if (uniform_rand(gen) % 2 == 0) { // 50% of reads are bursts (less once valid addresses are disallowed)
-            rd_len = random_burstlen(gen);
-          } else {
-            rd_len = 0;
-          }
           addr_pld.len = rd_len;
         }
         wr_conflict = false;
@@ -192,18 +271,23 @@ class Manager : public sc_module {
           if (!localMem.count(rd_addr_next+bytesPerBeat*i)) {
             wr_conflict = true; // Not actually a conflict, but the read should be cancelled nonetheless
           }
+          if (replay && !validReadAddresses.count(rd_addr_next+bytesPerBeat*i)) {
+            wr_conflict = true; // The replayed burst waits until all of its addresses are valid
+          }
         }
         std::ostringstream ms3;
         ms3 << "\nError @" << sc_time_stamp() << " from " << name()
             << ": Testharness attempted to read an address that it never wrote to"
             << ", read_addr=" << hex << rd_addr_next
             << endl;
-        BOOST_ASSERT_MSG( localMem.count(rd_addr_next), ms3.str().c_str() );
-        for (unsigned int j=0; j<waddr_queue.size(); j++) {
-          if ((rd_addr_next+bytesPerBeat*rd_len) >= waddr_queue.front() && rd_addr_next <= waddr_queue.front())
-                wr_conflict = true;
-          waddr_queue.push(waddr_queue.front());
-          waddr_queue.pop();
+        BOOST_ASSERT_MSG( replay || localMem.count(rd_addr_next), ms3.str().c_str() );
+        for (unsigned int id=0; id<numIds; id++) {
+          for (unsigned int j=0; j<waddr_queue[id].size(); j++) {
+            if ((rd_addr_next+bytesPerBeat*rd_len) >= waddr_queue[id].front() && rd_addr_next <= waddr_queue[id].front())
+                  wr_conflict = true;
+            waddr_queue[id].push(waddr_queue[id].front());
+            waddr_queue[id].pop();
+          }
         }
         if (!wr_conflict) {
           rd_addr_next = addr_pld.addr;
@@ -213,21 +297,34 @@ class Manager : public sc_module {
                           << endl, kDebugLevel);
             numReads++;
             for (unsigned int i=0; i<(rd_len+1); i++) {
-              raddr_queue.push(rd_addr_next);
+              raddr_queue[rd_id].push(rd_addr_next);
               rd_addr_next += bytesPerBeat;
             }
-            rlen_queue.push(rd_len);
+            rlen_queue[rd_id].push(rd_len);
+            if (replay) replay_queue.pop();
+            rd_id = (rd_id + 1) % numIds;
+            ar_credit -= 100;
           }
         }
       }
       if (if_rd.r.PopNB(data_pld)) {
-        rd_addr = raddr_queue.front();
+        unsigned int rid = static_cast<unsigned int>(data_pld.id.to_uint64());
+        std::ostringstream ms4;
+        ms4 << "\nError @" << sc_time_stamp() << " from " << name()
+            << ": Read response with no outstanding read on its ID"
+            << ", rid=" << dec << rid
+            << std::endl;
+        BOOST_ASSERT_MSG( rid < numIds && !raddr_queue[rid].empty(), ms4.str().c_str() );
+        rd_addr = raddr_queue[rid].front();
         if (axiCfg::useWriteStrobes) {
           bool checked_one = false;
+          typename ShadowMask::const_iterator mask_it = localMem_wstrb.find(rd_addr);
+          check_mask = (mask_it != localMem_wstrb.end()) ? mask_it->second : ByteMask(0);
+          check_data = localMem[rd_addr];
           for (int i=0; i<axi4_::WSTRB_WIDTH; i++) {
-            if (localMem_wstrb.count(rd_addr+i)) {
+            if (check_mask[i] == 1) {
               rcv_data_wstrb = nvhls::get_slc<8>(data_pld.data,8*i);
-              check_data_wstrb = localMem_wstrb[rd_addr+i];
+              check_data_wstrb = nvhls::get_slc<8>(check_data,8*i);
               std::ostringstream msg;
               msg << "\nError @" << sc_time_stamp() << " from " << name()
                   << ": Incorrect read data response"
@@ -265,11 +362,11 @@ class Manager : public sc_module {
         CDCOUT(sc_time_stamp() << " " << name() << " Received correct read response: ["
                       << data_pld << "]"
                       << endl, kDebugLevel);
-        raddr_queue.pop();
-        if (numReadsOfBurst++ == rlen_queue.front()) {
-          numReadsOfBurst = 0;
+        raddr_queue[rid].pop();
+        if (numReadsOfBurst[rid]++ == rlen_queue[rid].front()) {
+          numReadsOfBurst[rid] = 0;
           numReadResponses++;
-          rlen_queue.pop();
+          rlen_queue[rid].pop();
         }
       }
 
@@ -278,13 +375,16 @@ class Manager : public sc_module {
       wr_data_pld.data = wr_data;
       wr_data_pld.wstrb = wstrb;
       wr_addr_pld.len = wr_len;
-      if (!writeInProgress && numWrites < cfg::numWrites) {
+      wr_addr_pld.id = wr_id;
+      if (wr_ready) {
         rd_conflict = false;
-        for (unsigned int j=0; j<raddr_queue.size(); j++) {
-          if ((wr_addr+bytesPerBeat*wr_len) >= raddr_queue.front() && wr_addr <= raddr_queue.front())
-                rd_conflict = true;
-          raddr_queue.push(raddr_queue.front());
-          raddr_queue.pop();
+        for (unsigned int id=0; id<numIds; id++) {
+          for (unsigned int j=0; j<raddr_queue[id].size(); j++) {
+            if ((wr_addr+bytesPerBeat*wr_len) >= raddr_queue[id].front() && wr_addr <= raddr_queue[id].front())
+                  rd_conflict = true;
+            raddr_queue[id].push(raddr_queue[id].front());
+            raddr_queue[id].pop();
+          }
         }
         if (!rd_conflict) {
           if (if_wr.aw.PushNB(wr_addr_pld)) {
@@ -292,25 +392,28 @@ class Manager : public sc_module {
                           << wr_addr_pld << "]"
                           << endl, kDebugLevel);
             for (unsigned int i=0; i<(wr_len+1); i++) {
-              waddr_queue.push(wr_addr+bytesPerBeat*i);
+              waddr_queue[wr_id].push(wr_addr+bytesPerBeat*i);
               // If the address was already written to once, it needs to be removed from the list of valid addresses
               // because a read after this second write could return incorrect data
-              validReadAddresses.erase(std::remove(validReadAddresses.begin(), validReadAddresses.end(), waddr_queue.front()), validReadAddresses.end());
+              validReadAddresses.erase(wr_addr+bytesPerBeat*i);
               if (!wResp) {
-                ptrdiff_t pos = find(validReadAddresses_q.begin(), validReadAddresses_q.end(), waddr_queue.front()) - validReadAddresses_q.begin();
-                int size = validReadAddresses_q.size();
-                // If the address is already in the queue, just reset the counter
-                if (pos < size) {
-                  validReadAddresses_ctr[pos] = cfg::readDelay + 20*i;
-                } else {
-                  validReadAddresses_q.push_back(waddr_queue.front());
-                  validReadAddresses_ctr.push_back(cfg::readDelay + 20*i);
-                }
-                waddr_queue.pop();
+                // If the address is already waiting, this resets its timer
+                validReadAddresses_q.schedule(wr_addr+bytesPerBeat*i, cfg::readDelay + 20*i);
+                waddr_queue[wr_id].pop();
+              } else {
+                // Any timer left from an earlier write response is stale
+                validReadAddresses_q.cancel(wr_addr+bytesPerBeat*i);
               }
             }
-            wlen_queue.push(wr_len);
+            if (wResp) {
+              wlen_queue[wr_id].push(wr_len);
+            }
+            if (replayReads) {
+              replay_queue.push(std::make_pair(wr_addr, wr_len));
+            }
             writeInProgress = true;
+            wr_id = (wr_id + 1) % numIds;
+            aw_credit -= 100;
           }
         }
       }
@@ -329,23 +432,46 @@ class Manager : public sc_module {
                         << " beat=" << dec << numWritesOfBurst
                         << endl, kDebugLevel);
           if (axiCfg::useWriteStrobes) {
+            // Merge the strobed bytes into the shadow word; its entry also records the base address
+            typename axi4_::Data& shadow = localMem.insert(std::make_pair(wr_addr, typename axi4_::Data(0))).first->second;
+            ByteMask& mask = localMem_wstrb.insert(std::make_pair(wr_addr, ByteMask(0))).first->second;
             for (int i=0; i<axi4_::WSTRB_WIDTH; i++) {
               if (wr_data_pld.wstrb[i] == 1) {
-                localMem_wstrb[wr_addr+i] = nvhls::get_slc<8>(wr_data_pld.data, 8*i);
+                shadow = nvhls::set_slc(shadow, nvhls::get_slc<8>(wr_data_pld.data, 8*i), 8*i);
+                mask[i] = 1;
               }
             }
+          } else {
+            localMem[wr_addr] = wr_data_pld.data;
           }
-          localMem[wr_addr] = wr_data_pld.data; // Need to keep track of base addresses, even for wstrb case
           if (++numWritesOfBurst == (wr_len+1)) { // Whole burst is done
-            wr_addr = (random_addr(gen) >> axiAddrBitsPerWord) << axiAddrBitsPerWord; // Keep all requests word-aligned
+            uint64_t next_addr;
+            if (pattern == axi::traffic::SEQUENTIAL) {
+              next_addr = wr_addr.to_uint64() + bytesPerBeat;
+            } else if (pattern == axi::traffic::STRIDED) {
+              next_addr = wr_base.to_uint64() + profile::stride;
+            } else if (pattern == axi::traffic::LOCALITY && uniform_rand(gen) % 100 < profile::localityPct) {
+              next_addr = wr_base.to_uint64() + random_offset(gen);
+            } else {
+              next_addr = random_addr(gen);
+            }
+            if (next_addr < cfg::addrBoundLower || next_addr > cfg::addrBoundUpper) next_addr = cfg::addrBoundLower;
+            wr_addr = (next_addr >> axiAddrBitsPerWord) << axiAddrBitsPerWord; // Keep all requests word-aligned
             if (axiCfg::useBurst) {
-              if (uniform_rand(gen) % 5 == 0) { // 20% of writes are bursts
+              if (profile::burstLen > 0) {
+                wr_len = fixedLen;
+              } else if (uniform_rand(gen) % 100 < profile::writeBurstPct) { // 20% of writes are bursts by default
                 wr_len = random_burstlen(gen);
-                if (wr_addr + bytesPerBeat*wr_len > cfg::addrBoundUpper) wr_len = 0;
               } else {
                 wr_len = 0;
               }
+              // Address patterns wrap a burst that would pass the upper bound; random addresses shorten it
+              if (replayReads && wr_addr + bytesPerBeat*wr_len > cfg::addrBoundUpper) {
+                wr_addr = (static_cast<uint64_t>(cfg::addrBoundLower) >> axiAddrBitsPerWord) << axiAddrBitsPerWord;
+              }
+              if (wr_addr + bytesPerBeat*wr_len > cfg::addrBoundUpper) wr_len = 0;
             }
+            wr_base = wr_addr;
             writeInProgress = false;
             numWrites++;
             numWritesOfBurst = 0;
@@ -366,23 +492,30 @@ class Manager : public sc_module {
         }
       }
       if (if_wr.b.PopNB(wr_resp_pld)) {
+        unsigned int bid = static_cast<unsigned int>(wr_resp_pld.id.to_uint64());
+        std::ostringstream ms4;
+        ms4 << "\nError @" << sc_time_stamp() << " from " << name()
+            << ": Write response with no outstanding write on its ID"
+            << ", bid=" << dec << bid
+            << std::endl;
+        BOOST_ASSERT_MSG( bid < numIds && !wlen_queue[bid].empty(), ms4.str().c_str() );
         std::ostringstream msg;
         msg << "\nError @" << sc_time_stamp() << " from " << name()
             << ":  Write response protocol error"
             << ", bresp=" << wr_resp_pld.resp.to_uint64()
-            << ", addr=" << hex << waddr_queue.front()
+            << ", addr=" << hex << waddr_queue[bid].front()
             << std::endl;
         BOOST_ASSERT_MSG( (wr_resp_pld.resp == axi4_::Enc::XRESP::OKAY) |
                           (wr_resp_pld.resp == axi4_::Enc::XRESP::EXOKAY), msg.str().c_str() );
         CDCOUT(sc_time_stamp() << " " << name() << " Received write response"
                       << endl, kDebugLevel);
         numWriteResponses++;
-        for (unsigned int i=0; i<wlen_queue.front()+1; i++) {
-          validReadAddresses_q.push_back(waddr_queue.front());
-          validReadAddresses_ctr.push_back(cfg::readDelay + 20*i);
-          waddr_queue.pop();
+        for (unsigned int i=0; i<wlen_queue[bid].front()+1; i++) {
+          // The whole burst has landed once its response returns, so its beats are not staggered
+          validReadAddresses_q.schedule(waddr_queue[bid].front(), cfg::readDelay);
+          waddr_queue[bid].pop();
         }
-        wlen_queue.pop();
+        wlen_queue[bid].pop();
       }
       if (numWrites == cfg::numWrites &&
           numReads == cfg::numReads &&
@@ -405,19 +538,7 @@ class Manager : public sc_module {
 
       // If there are no write responses we still want to test reads.
       // Finesse this by enforcing a fixed delay after a write until reads can be issued to that address.
-      for (unsigned int i=0; i<validReadAddresses_q.size(); i++) {
-        if (validReadAddresses_ctr[i] >= 0) {
-          if (validReadAddresses_ctr[i] == 0) {
-            validReadAddresses.push_back(validReadAddresses_q[i]);
-          }
-          validReadAddresses_ctr[i]--;
-        }
-      }
-      //DCOUT("validReadAddresses: ");
-      //for (typename std::vector< sc_uint<axi4_::ADDR_WIDTH> >::const_iterator q = validReadAddresses.begin(); q != validReadAddresses.end(); ++q)
-      //      std::cout << *q << ' ';
-      //DCOUT(endl);
-      
+      validReadAddresses_q.tick(validReadAddresses);
     }
   }
 };
@@ -23,6 +23,7 @@
 
 #include <axi/axi4.h>
 #include <axi/testbench/CSVFileReader.h>
+#include <axi/testbench/AxiTrace.h>
 #include <nvhls_connections.h>
 #include <hls_globals.h>
 
@@ -41,13 +42,32 @@
  * \tparam enable_interrupts        Set true to enable support for interrupt instructions (default false)
  *
  * \par Overview
- * AxiManagerFromFile reads write and read requests from a CSV and issues them as an AXI manager.  Read responses are checked agains the expected values provided in the file.  If enable_interrupts is true, the file can also specify a wait-for-interrupt mode in which the interrupt input must go high before further instructions are processed. The format of the CSV is as follows:
+ * AxiManagerFromFile reads write and read requests from a CSV and issues them as an AXI manager.  The file is streamed: each request is parsed just before it is issued.  Read responses are checked agains the expected values provided in the file.  If enable_interrupts is true, the file can also specify a wait-for-interrupt mode in which the interrupt input must go high before further instructions are processed. The format of the CSV is as follows:
  * - Writes: delay_from_previous_request,W,address_in_hex,data_in_hex,burst_len
  * - Reads: delay_from_previous_request,R,address_in_hex,expected_response_data_in_hex,burst_len
- * - Interrupts: delay_from_previous_request,Q,arbitrary,arbitrary,arbitrary
+ * - Interrupts: delay_from_previous_request,Q,count_in_hex,timeout_in_hex,posted
+ *
+ *  An interrupt is a rising edge of the interrupt input, and is counted
+ *  whenever it arrives, also while requests are in flight. A Q waits for count
+ *  more interrupts than all earlier waits needed, so one wait coalesces the
+ *  interrupts of several requests. count=0 waits for the interrupt input to be
+ *  high, as a level, and takes all interrupts counted so far. When timeout is
+ *  not 0, the wait gives up after that many cycles, forgives the interrupts
+ *  that are still missing and counts one more interrupt_timeouts.
+ *
+ *  With posted not 0, the Q does not wait: the requests after it, which must
+ *  not depend on the interrupts, are issued while they arrive. Posted
+ *  interrupts add to the count of the next Q that waits, and are waited for
+ *  at the end of the file with the timeout of the last posted Q. For
+ *  example, "0,Q,4,0,1" ahead of a segment and "0,Q,0,0,0" after it
+ *  overlaps the segment with the completion of four earlier jobs.
  * 
  *  For reads, it's best to specify the full DATA_WIDTH of expected response data.
  *
+ *  The file may also be a binary AXI trace (see AxiTraceRecord), which is
+ *  detected from its header. Such traces are produced by ConvertAxiCSVToTrace()
+ *  or recorded from live traffic by AxiTraceRecorder.
+ *
  *  Use burst_len=0 for a single-beat transaction (no burst). For burst_len>0,
  *  use one line for each beat in the burst. All beats in a burst must have the same
  *  burst_len, be listed sequentially with appropriately incrementing addresses,
@@ -94,30 +114,61 @@ template <typename axiCfg, bool enable_interrupts = false> class ManagerFromFile
   int burst_inflight = 0;
   sc_out<bool> done;
 
+  // Interrupt waits of the queued Q requests
+  struct InterruptWait {
+    unsigned int count;
+    unsigned int timeout;
+    bool posted;
+  };
+  std::queue<InterruptWait> intr_q;
+  unsigned long long interrupts_received;
+  unsigned long long interrupts_needed;
+  unsigned int posted_timeout;
+  bool interrupt_last;
+  // Cycles spent waiting for interrupts, and waits that timed out
+  unsigned long long interrupt_wait_cycles;
+  unsigned int interrupt_timeouts;
+
+  CSVFileReader reader;
+  CSVRow row;
+  bool binary_trace;
+  AxiTraceReader<axiCfg> trace_reader;
+  AxiTraceRecord<axiCfg> trace_rec;
+
   SC_HAS_PROCESS(ManagerFromFile);
 
   ManagerFromFile(sc_module_name name_, std::string filename="requests.csv")
-      : sc_module(name_), if_rd("if_rd"), if_wr("if_wr"), reset_bar("reset_bar"), clk("clk") {
+      : sc_module(name_), if_rd("if_rd"), if_wr("if_wr"), reset_bar("reset_bar"), clk("clk"),
+        reader(filename), binary_trace(AxiTraceReader<axiCfg>::IsTraceFile(filename)),
+        trace_reader(filename), interrupts_received(0), interrupts_needed(0),
+        posted_timeout(0), interrupt_last(false), interrupt_wait_cycles(0),
+        interrupt_timeouts(0) {
 
     CDCOUT("Reading file: " << filename << endl, kDebugLevel);
-    CSVFileReader reader(filename);
-    std::vector< std::vector<std::string> > dataList = reader.readCSV();
-    for (unsigned int i=0; i < dataList.size(); i++) {
-      std::vector<std::string> vec = dataList[i];
-      CMOD_ASSERT_MSG(vec.size() == 5, "Each request must have five elements");
-      if (!burst_inflight) delay_q.push(atoi(vec[0].c_str()));
-      if (vec[1] == "R") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+    if (enable_interrupts) {
+      SC_METHOD(count_interrupts);
+      sensitive << clk.pos();
+      dont_initialize();
+    }
+  }
+
+ protected:
+  // Parses rows until one complete request (all beats of a burst) is queued.
+  // Returns false at the end of the file.
+  bool ReadRequest() {
+    if (binary_trace) return ReadTraceRequest();
+    while (reader.readRow(row)) {
+      CMOD_ASSERT_MSG(row.size() == 5, "Each request must have five elements");
+      if (!burst_inflight) delay_q.push(row[0].to_int());
+      if (row[1] == "R") {
         if (!burst_inflight) {
           req_q.push(0);
-          std::stringstream ss;
-          sc_uint<axi4_::ADDR_WIDTH> addr;
-          ss << hex << vec[2];
-          ss >> addr;
-          std::stringstream ss_len;
+          sc_uint<axi4_::ADDR_WIDTH> addr = row[2].to_hex<sc_uint<axi4_::ADDR_WIDTH> >();
           addr_pld.addr = static_cast<typename axi4_::Addr>(addr);
-          sc_uint<axi4_::ALEN_WIDTH> len;
-          ss_len << hex << vec[4];
-          ss_len >> len;
+          sc_uint<axi4_::ALEN_WIDTH> len = row[4].to_hex<sc_uint<axi4_::ALEN_WIDTH> >();
           if (len) CMOD_ASSERT_MSG(axiCfg::useBurst, "A burst transaction was requested but the AXI config does not support bursts");
           CMOD_ASSERT_MSG(axiCfg::maxBurstSize >= len, "A burst transaction was requested that is longer than the maximum allowed by the AXI config");
           addr_pld.len = 0;
@@ -127,23 +178,13 @@ template <typename axiCfg, bool enable_interrupts = false> class ManagerFromFile
         } else {
           burst_inflight--;
         }
-        std::stringstream ss_data;
-        sc_biguint<axi4_::DATA_WIDTH> data;
-        ss_data << hex << vec[3];
-        ss_data >> data;
-        rresp_q.push(TypeToNVUINT(data));
-      } else if (vec[1] == "W") {
+        rresp_q.push(row[3].to_hex<typename axi4_::Data>());
+      } else if (row[1] == "W") {
         if (!burst_inflight) {
           req_q.push(1);
-          std::stringstream ss;
-          sc_uint<axi4_::ADDR_WIDTH> addr;
-          ss << hex << vec[2];
-          ss >> addr;
-          std::stringstream ss_len;
+          sc_uint<axi4_::ADDR_WIDTH> addr = row[2].to_hex<sc_uint<axi4_::ADDR_WIDTH> >();
           addr_pld.addr = static_cast<typename axi4_::Addr>(addr);
-          sc_uint<axi4_::ALEN_WIDTH> len;
-          ss_len << hex << vec[4];
-          ss_len >> len;
+          sc_uint<axi4_::ALEN_WIDTH> len = row[4].to_hex<sc_uint<axi4_::ALEN_WIDTH> >();
           if (len) CMOD_ASSERT_MSG(axiCfg::useBurst, "A burst transaction was requested but the AXI config does not support bursts");
           CMOD_ASSERT_MSG(axiCfg::maxBurstSize >= len, "A burst transaction was requested that is longer than the maximum allowed by the AXI config");
           addr_pld.len = static_cast<typename axi4_::BeatNum>(len);
@@ -152,11 +193,7 @@ template <typename axiCfg, bool enable_interrupts = false> class ManagerFromFile
         } else {
           burst_inflight--;
         }
-        std::stringstream ss_data;
-        sc_biguint<axi4_::DATA_WIDTH> data;
-        ss_data << hex << vec[3];
-        ss_data >> data;
-        wr_data_pld.data = TypeToNVUINT(data);
+        wr_data_pld.data = row[3].to_hex<typename axi4_::Data>();
         wr_data_pld.wstrb = ~0;
         if (!burst_inflight) {
           wr_data_pld.last = 1;
@@ -164,20 +201,123 @@ template <typename axiCfg, bool enable_interrupts = false> class ManagerFromFile
           wr_data_pld.last = 0;
         }
         wdata_q.push(wr_data_pld);
-      } else if (vec[1] == "Q") {
+      } else if (row[1] == "Q") {
         CMOD_ASSERT_MSG(enable_interrupts, "Interrupt command read, but interrupts are not enabled");
         req_q.push(2);
+        InterruptWait intr;
+        intr.count = row[2].to_hex<unsigned int>();
+        intr.timeout = row[3].to_hex<unsigned int>();
+        intr.posted = (row[4].to_hex<unsigned int>() != 0);
+        intr_q.push(intr);
       } else {
         CMOD_ASSERT_MSG(1, "Requests must be R or W or Q");
       }
+      if (!burst_inflight) return true;
     }
+    return false;
+  }
 
-    SC_THREAD(run);
-    sensitive << clk.pos();
-    async_reset_signal_is(reset_bar, false);
+  // Binary trace equivalent of ReadRequest(); B records are skipped
+  bool ReadTraceRequest() {
+    typedef AxiTraceRecord<axiCfg> Record;
+    while (trace_reader.read(trace_rec)) {
+      if (trace_rec.kind == Record::AR || trace_rec.kind == Record::AW) {
+        CMOD_ASSERT_MSG(!burst_inflight, "A request started before the previous burst completed");
+        if (trace_rec.len) CMOD_ASSERT_MSG(axiCfg::useBurst, "A burst transaction was requested but the AXI config does not support bursts");
+        CMOD_ASSERT_MSG(axiCfg::maxBurstSize >= trace_rec.len, "A burst transaction was requested that is longer than the maximum allowed by the AXI config");
+        delay_q.push(trace_rec.delay);
+        if (trace_rec.kind == Record::AR) {
+          req_q.push(0);
+          raddr_q.push(trace_rec.ToAddr());
+        } else {
+          req_q.push(1);
+          waddr_q.push(trace_rec.ToAddr());
+        }
+        burst_inflight = trace_rec.len + 1;
+      } else if (trace_rec.kind == Record::R) {
+        rresp_q.push(trace_rec.data);
+        burst_inflight--;
+      } else if (trace_rec.kind == Record::W) {
+        wr_data_pld = trace_rec.ToWrite();
+        burst_inflight--;
+        wr_data_pld.last = (burst_inflight == 0);
+        wdata_q.push(wr_data_pld);
+      } else if (trace_rec.kind == Record::Q) {
+        CMOD_ASSERT_MSG(enable_interrupts, "Interrupt command read, but interrupts are not enabled");
+        delay_q.push(trace_rec.delay);
+        req_q.push(2);
+        InterruptWait intr;
+        intr.count = trace_rec.len;
+        intr.timeout = static_cast<unsigned int>(trace_rec.addr);
+        intr.posted = (trace_rec.last != 0);
+        intr_q.push(intr);
+      } else {
+        continue;
+      }
+      if (!burst_inflight) return true;
+    }
+    return false;
+  }
+
+  void count_interrupts() {
+    if (!reset_bar.read()) {
+      interrupts_received = 0;
+      interrupt_last = false;
+      return;
+    }
+    bool level = interrupt.read();
+    if (level && !interrupt_last) interrupts_received++;
+    interrupt_last = level;
+  }
+
+  // Waits until interrupts_needed interrupts were received, or for timeout
+  // cycles when timeout is not 0
+  void WaitForInterrupts(unsigned int timeout) {
+    unsigned int cycles = 0;
+    while (interrupts_received < interrupts_needed) {
+      if (timeout != 0 && cycles >= timeout) {
+        CDCOUT(sc_time_stamp() << " " << name() << " Interrupt wait timed out, "
+                      << interrupts_needed - interrupts_received << " missing"
+                      << endl, kDebugLevel);
+        interrupts_needed = interrupts_received;
+        interrupt_timeouts++;
+        break;
+      }
+      wait();
+      cycles++;
+    }
+    interrupt_wait_cycles += cycles;
+  }
+
+  void HandleInterrupt() {
+    InterruptWait intr = intr_q.front();
+    intr_q.pop();
+    if (intr.posted) {
+      interrupts_needed += (intr.count == 0) ? 1 : intr.count;
+      posted_timeout = intr.timeout;
+      CDCOUT(sc_time_stamp() << " " << name() << " Posted wait for interrupts, "
+                    << interrupts_needed << " needed" << endl, kDebugLevel);
+      return;
+    }
+    CDCOUT(sc_time_stamp() << " " << name() << " Beginning wait for interrupt"
+                  << endl, kDebugLevel);
+    if (intr.count == 0 && interrupts_received >= interrupts_needed) {
+      unsigned int cycles = 0;
+      while (interrupt.read() == 0 && (intr.timeout == 0 || cycles < intr.timeout)) {
+        wait();
+        cycles++;
+      }
+      interrupt_wait_cycles += cycles;
+      if (interrupt.read() == 0) interrupt_timeouts++;
+      interrupts_needed = interrupts_received;
+    } else {
+      interrupts_needed += intr.count;
+      WaitForInterrupts(intr.timeout);
+    }
+    CDCOUT(sc_time_stamp() << " " << name() << " Interrupt received"
+                  << endl, kDebugLevel);
   }
 
- protected:
   void run() {
 
     done = 0;
@@ -185,19 +325,18 @@ template <typename axiCfg, bool enable_interrupts = false> class ManagerFromFile
     if_rd.reset();
     if_wr.reset();
 
+    interrupts_needed = 0;
     wait(20);
 
-    while (!delay_q.empty()) {
+    // Requests are parsed from the file as they are issued, so memory use does
+    // not grow with the length of the trace.
+    while (ReadRequest() || !delay_q.empty()) {
       int delay = delay_q.front();
       if (delay > 0) wait(delay);
       delay_q.pop();
       if (req_q.front() == 2) {
         CMOD_ASSERT_MSG(enable_interrupts,"Interrupt command found, but interrupts are not enabled");
-        CDCOUT(sc_time_stamp() << " " << name() << " Beginning wait for interrupt"
-                      << endl, kDebugLevel);
-        while (interrupt.read() == 0) wait();
-        CDCOUT(sc_time_stamp() << " " << name() << " Interrupt received"
-                      << endl, kDebugLevel);
+        HandleInterrupt();
       } else if (req_q.front() == 1) {
         addr_pld = waddr_q.front();
         if_wr.aw.Push(addr_pld);
@@ -234,6 +373,8 @@ template <typename axiCfg, bool enable_interrupts = false> class ManagerFromFile
       }
       req_q.pop();
     }
+    // Posted interrupts that no later Q waited for
+    WaitForInterrupts(posted_timeout);
     done = 1;
   }
 };
@@ -21,11 +21,12 @@
 #include <ac_reset_signal_is.h>
 
 #include <axi/axi4.h>
+#include <axi/testbench/AddrTracker.h>
 #include <nvhls_connections.h>
 #include <hls_globals.h>
 
 #include <queue>
-#include <map>
+#include <unordered_map>
 #include <boost/assert.hpp>
 #include <algorithm>
 
@@ -40,6 +41,8 @@
  * - Read requests are only valid if the address has previously been written to.
  * - Write data beats must each assert at least one strobe bit.
  *
+ * The memory is a hash map with one entry per data word.  With write strobes, strobed bytes are merged into the word and a second map records which bytes have been written; bytes never written read back as zero.
+ *
  */
 template <typename axiCfg>
 class Subordinate : public sc_module {
@@ -59,12 +62,15 @@ class Subordinate : public sc_module {
   std::queue <typename axi4_::WritePayload> wr_data;
   std::queue <typename axi4_::WRespPayload> wr_resp;
 
-  std::map<typename axi4_::Addr, typename axi4_::Data> localMem;
-  std::map<typename axi4_::Addr, NVUINT8 > localMem_wstrb;
-  std::vector<typename axi4_::Addr> validReadAddresses;
-
   static const int bytesPerBeat = axi4_::DATA_WIDTH >> 3;
 
+  typedef NVUINTW(bytesPerBeat) ByteMask;
+  typedef std::unordered_map<typename axi4_::Addr, typename axi4_::Data, AxiAddrHash> ShadowMem;
+  typedef std::unordered_map<typename axi4_::Addr, ByteMask, AxiAddrHash> ShadowMask;
+
+  ShadowMem localMem;           // Word address -> stored data; an entry means the word was written
+  ShadowMask localMem_wstrb;    // Word address -> bytes written with their strobe set
+
   SC_CTOR(Subordinate)
       : if_rd("if_rd"), if_wr("if_wr"), reset_bar("reset_bar"), clk("clk") {
     SC_THREAD(run_rd);
@@ -98,22 +104,21 @@ class Subordinate : public sc_module {
               << ": Received a read request from an address that has not yet been written to"
               << ", addr=" << hex << addr
               << endl;
-          bool validAddr = false;
-          for (unsigned int j=0; j<validReadAddresses.size(); j++) {
-            if (validReadAddresses[j] == rd_addr_pld.addr) validAddr = true;
-          }
-          BOOST_ASSERT_MSG( validAddr, msg.str().c_str() );
+          BOOST_ASSERT_MSG( localMem.count(rd_addr_pld.addr), msg.str().c_str() );
           typename axi4_::ReadPayload data_pld;
-          if (axiCfg::useWriteStrobes) {
-            for (int k=0; k<axi4_::WSTRB_WIDTH; k++) {
-              if (localMem_wstrb.find(addr+k) != localMem_wstrb.end()) {
-                data_pld.data = nvhls::set_slc(data_pld.data, localMem_wstrb[addr+k], 8*k);
-              } else {
-                data_pld.data = nvhls::set_slc(data_pld.data, NVUINT8(0), 8*k);
+          data_pld.data = 0;
+          typename ShadowMem::const_iterator mem_it = localMem.find(addr);
+          if (mem_it != localMem.end()) {
+            if (axiCfg::useWriteStrobes) {
+              ByteMask mask = localMem_wstrb[addr];
+              for (int k=0; k<axi4_::WSTRB_WIDTH; k++) {
+                if (mask[k] == 1) {
+                  data_pld.data = nvhls::set_slc(data_pld.data, nvhls::get_slc<8>(mem_it->second, 8*k), 8*k);
+                }
               }
+            } else {
+              data_pld.data = mem_it->second;
             }
-          } else {
-            data_pld.data = localMem[addr];
           }
           data_pld.resp = axi4_::Enc::XRESP::OKAY;
           data_pld.id = rd_addr_pld.id;
@@ -207,15 +212,17 @@ class Subordinate : public sc_module {
           msg << "\nError @" << sc_time_stamp() << " from " << name()
               << ": Wstrb cannot be all zeros" << endl;
           BOOST_ASSERT_MSG( wr_data_pld_out.wstrb != 0, msg.str().c_str() );
+          typename axi4_::Data& shadow = localMem.insert(std::make_pair(wresp_addr, typename axi4_::Data(0))).first->second;
+          ByteMask& mask = localMem_wstrb.insert(std::make_pair(wresp_addr, ByteMask(0))).first->second;
           for (int j=0; j<axi4_::WSTRB_WIDTH; j++) {
             if (wr_data_pld_out.wstrb[j] == 1) {
-              localMem_wstrb[wresp_addr+j] = nvhls::get_slc<8>(wr_data_pld_out.data, 8*j);
+              shadow = nvhls::set_slc(shadow, nvhls::get_slc<8>(wr_data_pld_out.data, 8*j), 8*j);
+              mask[j] = 1;
             }
           }
         } else {
           localMem[wresp_addr] = wr_data_pld_out.data;
         }
-        validReadAddresses.push_back(wresp_addr);
         wresp_addr += bytesPerBeat;
         if (wr_data_pld_out.last == 1) {
           wr_addr.pop();
@@ -22,11 +22,14 @@
 
 #include <axi/axi4.h>
 #include <axi/testbench/CSVFileReader.h>
+#include <axi/testbench/AxiTrace.h>
+#include <axi/testbench/AddrTracker.h>
 #include <nvhls_connections.h>
 #include <hls_globals.h>
 
 #include <queue>
-#include <map>
+#include <unordered_map>
+#include <set>
 #include <boost/assert.hpp>
 #include <algorithm>
 #include <string>
@@ -44,6 +47,8 @@
  * 
  *  It's best to specify the full DATA_WIDTH of data.
  *
+ *  The file may also be a binary AXI trace (see AxiTraceRecord), in which case the memory is preloaded with the data returned by the reads in the trace.
+ *
  */
 template <typename axiCfg> class SubordinateFromFile : public sc_module {
  public:
@@ -62,42 +67,30 @@ template <typename axiCfg> class SubordinateFromFile : public sc_module {
   std::queue <typename axi4_::WritePayload> wr_data;
   std::queue <typename axi4_::WRespPayload> wr_resp;
 
-  std::map<typename axi4_::Addr, typename axi4_::Data> localMem;
-  std::map<typename axi4_::Addr, NVUINT8> localMem_wstrb;
-  std::vector<typename axi4_::Addr> validReadAddresses;
+  static const int bytesPerBeat = axi4_::DATA_WIDTH >> 3;
 
-  typename axi4_::WritePayload load_data_pld;
+  typedef NVUINTW(bytesPerBeat) ByteMask;
+  typedef std::unordered_map<typename axi4_::Addr, typename axi4_::Data, AxiAddrHash> ShadowMem;
+  typedef std::unordered_map<typename axi4_::Addr, ByteMask, AxiAddrHash> ShadowMask;
 
-  static const int bytesPerBeat = axi4_::DATA_WIDTH >> 3;
+  ShadowMem localMem;           // Word address -> stored data; an entry means the word was written
+  ShadowMask localMem_wstrb;    // Word address -> bytes written with their strobe set
 
   SC_HAS_PROCESS(SubordinateFromFile);
 
   SubordinateFromFile(sc_module_name name_, std::string filename="mem.csv")
       : sc_module(name_), if_rd("if_rd"), if_wr("if_wr"), reset_bar("reset_bar"), clk("clk") {
 
-    CSVFileReader reader(filename);
-    std::vector< std::vector<std::string> > dataList = reader.readCSV();
-    for (unsigned int i=0; i < dataList.size(); i++) {
-      std::vector<std::string> vec = dataList[i];
-      CMOD_ASSERT_MSG(vec.size() == 2, "Each request must have two elements");
-      std::stringstream ss;
-      sc_uint<axi4_::ADDR_WIDTH> addr_sc_uint;
-      ss << hex << vec[0];
-      ss >> addr_sc_uint;
-      std::stringstream ss_data;
-      sc_biguint<axi4_::DATA_WIDTH> data;
-      ss_data << hex << vec[1];
-      ss_data >> data;
-      load_data_pld.data = TypeToNVUINT(data);
-      typename axi4_::Addr addr = static_cast<typename axi4_::Addr>(addr_sc_uint);
-      if (axiCfg::useWriteStrobes) {
-        for (int j=0; j<axi4_::WSTRB_WIDTH; j++) {
-          localMem_wstrb[addr+j] = nvhls::get_slc<8>(load_data_pld.data, 8*j);
-        }
-      } else {
-        localMem[addr] = load_data_pld.data;
-      }  
-      validReadAddresses.push_back(addr);
+    if (AxiTraceReader<axiCfg>::IsTraceFile(filename)) {
+      LoadTrace(filename);
+    } else {
+      CSVFileReader reader(filename);
+      CSVRow row;
+      while (reader.readRow(row)) {
+        CMOD_ASSERT_MSG(row.size() == 2, "Each request must have two elements");
+        sc_uint<axi4_::ADDR_WIDTH> addr_sc_uint = row[0].to_hex<sc_uint<axi4_::ADDR_WIDTH> >();
+        Preload(static_cast<typename axi4_::Addr>(addr_sc_uint), row[1].to_hex<typename axi4_::Data>());
+      }
     }
 
     SC_THREAD(run_rd);
@@ -110,6 +103,33 @@ template <typename axiCfg> class SubordinateFromFile : public sc_module {
   }
 
 protected:
+  void Preload(typename axi4_::Addr addr, typename axi4_::Data data) {
+    localMem[addr] = data;
+    if (axiCfg::useWriteStrobes) {
+      localMem_wstrb[addr] = ~ByteMask(0);
+    }
+  }
+
+  // Preloads the data of every read in a binary AXI trace. Only the first
+  // read of each address is used, since later reads may follow writes.
+  void LoadTrace(const std::string& filename) {
+    typedef AxiTraceRecord<axiCfg> Record;
+    AxiTraceReader<axiCfg> trace_reader(filename);
+    Record rec;
+    std::set<uint64_t> loaded;
+    uint64_t addr = 0;
+    while (trace_reader.read(rec)) {
+      if (rec.kind == Record::AR) {
+        addr = rec.addr;
+      } else if (rec.kind == Record::R) {
+        if (loaded.insert(addr).second) {
+          Preload(static_cast<typename axi4_::Addr>(addr), rec.data);
+        }
+        addr += bytesPerBeat;
+      }
+    }
+  }
+
   void run_rd() {
     if_rd.reset();
     unsigned int rdBeatInFlight = 0;
@@ -130,22 +150,21 @@ protected:
               << ": Received a read request from an address that has not yet been written to"
               << ", addr=" << hex << addr
               << endl;
-          bool validAddr = false;
-          for (unsigned int j=0; j<validReadAddresses.size(); j++) {
-            if (validReadAddresses[j] == rd_addr_pld.addr) validAddr = true;
-          }
-          BOOST_ASSERT_MSG( validAddr, msg.str().c_str() );
+          BOOST_ASSERT_MSG( localMem.count(rd_addr_pld.addr), msg.str().c_str() );
           typename axi4_::ReadPayload data_pld;
-          if (axiCfg::useWriteStrobes) {
-            for (int k=0; k<axi4_::WSTRB_WIDTH; k++) {
-              if (localMem_wstrb.find(addr+k) != localMem_wstrb.end()) {
-                data_pld.data = nvhls::set_slc(data_pld.data, localMem_wstrb[addr+k], 8*k);
-              } else {
-                data_pld.data = nvhls::set_slc(data_pld.data, NVUINT8(0), 8*k);
+          data_pld.data = 0;
+          typename ShadowMem::const_iterator mem_it = localMem.find(addr);
+          if (mem_it != localMem.end()) {
+            if (axiCfg::useWriteStrobes) {
+              ByteMask mask = localMem_wstrb[addr];
+              for (int k=0; k<axi4_::WSTRB_WIDTH; k++) {
+                if (mask[k] == 1) {
+                  data_pld.data = nvhls::set_slc(data_pld.data, nvhls::get_slc<8>(mem_it->second, 8*k), 8*k);
+                }
               }
+            } else {
+              data_pld.data = mem_it->second;
             }
-          } else {
-            data_pld.data = localMem[addr];
           }
           data_pld.resp = axi4_::Enc::XRESP::OKAY;
           data_pld.id = rd_addr_pld.id;
@@ -234,15 +253,17 @@ protected:
           msg << "\nError @" << sc_time_stamp() << " from " << name()
               << ": Wstrb cannot be all zeros" << endl;
           BOOST_ASSERT_MSG( wr_data_pld.wstrb != 0, msg.str().c_str() );
+          typename axi4_::Data& shadow = localMem.insert(std::make_pair(wresp_addr, typename axi4_::Data(0))).first->second;
+          ByteMask& mask = localMem_wstrb.insert(std::make_pair(wresp_addr, ByteMask(0))).first->second;
           for (int j=0; j<axi4_::WSTRB_WIDTH; j++) {
             if (wr_data_pld.wstrb[j] == 1) {
-              localMem_wstrb[wresp_addr+j] = nvhls::get_slc<8>(wr_data_pld.data, 8*j);
+              shadow = nvhls::set_slc(shadow, nvhls::get_slc<8>(wr_data_pld.data, 8*j), 8*j);
+              mask[j] = 1;
             }
           }
         } else {
           localMem[wresp_addr] = wr_data_pld.data;
         }
-        validReadAddresses.push_back(wresp_addr);
         wresp_addr += bytesPerBeat;
         if (wr_data_pld.last == 1) {
           wr_addr.pop();
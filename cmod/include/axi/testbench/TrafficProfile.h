@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXI_T_TRAFFIC_PROFILE__
+#define __AXI_T_TRAFFIC_PROFILE__
+
+namespace axi {
+namespace traffic {
+
+/**
+ * \brief Address patterns that the testbench Manager can generate for its writes.
+ *
+ * - RANDOM: each write burst starts at a random address in the valid range.
+ * - SEQUENTIAL: each write burst starts right after the previous one.
+ * - STRIDED: each write burst starts stride bytes after the start of the previous one.
+ * - LOCALITY: a share of the write bursts (localityPct) start within localityWindow
+ *   bytes of the previous one, and the rest start at a random address.
+ *
+ * Sequential, strided and local addresses wrap to addrBoundLower when they
+ * would pass addrBoundUpper.
+ */
+enum Pattern { RANDOM = 0, SEQUENTIAL = 1, STRIDED = 2, LOCALITY = 3 };
+
+/** \brief The readPct value that issues reads and writes independently of each other. */
+static const int INDEPENDENT = -1;
+
+/**
+ * \brief The default traffic profile of the testbench Manager.
+ * \ingroup AXI
+ *
+ * \par The following constants must be defined by a traffic profile:
+ *
+ * - pattern: The Pattern of write addresses.
+ * - burstLen: The length of every burst in beats, or 0 for random lengths.
+ * - writeBurstPct: With random lengths, the percentage of writes that are bursts.
+ * - readBurstPct: With random lengths, the percentage of random reads that are bursts.
+ * - stride: For STRIDED, the distance in bytes between the starts of consecutive write bursts.
+ * - localityPct: For LOCALITY, the percentage of write bursts near the previous one.
+ * - localityWindow: For LOCALITY, the maximum distance in bytes from the previous write burst.
+ * - readPct: The percentage of issued requests that are reads, or INDEPENDENT to let reads and writes issue on their own.
+ * - injectPct: The target number of requests per 100 cycles on each of the AR and AW channels.
+ * - numIds: The number of AXI IDs that requests rotate through.
+ * - maxOutstandingPerId: The maximum number of outstanding requests per ID and channel, or 0 for no limit.
+ *
+ * This profile produces random addresses, with 20% of writes and 50% of
+ * reads as random-length bursts, all on ID 0, with no limit on the request
+ * rate or on outstanding requests.
+ */
+struct random {
+  enum {
+    pattern = RANDOM,
+    burstLen = 0,
+    writeBurstPct = 20,
+    readBurstPct = 50,
+    stride = 0,
+    localityPct = 0,
+    localityWindow = 0,
+    readPct = INDEPENDENT,
+    injectPct = 100,
+    numIds = 1,
+    maxOutstandingPerId = 0,
+  };
+};
+
+/**
+ * \brief Streaming traffic: back-to-back 16-beat write bursts, each read back in order.
+ * \ingroup AXI
+ */
+struct streaming {
+  enum {
+    pattern = SEQUENTIAL,
+    burstLen = 16,
+    writeBurstPct = 0,
+    readBurstPct = 0,
+    stride = 0,
+    localityPct = 0,
+    localityWindow = 0,
+    readPct = 50,
+    injectPct = 100,
+    numIds = 2,
+    maxOutstandingPerId = 4,
+  };
+};
+
+/**
+ * \brief Strided traffic: 4-beat write bursts 4KB apart, as when walking the columns of a matrix.
+ * \ingroup AXI
+ */
+struct strided {
+  enum {
+    pattern = STRIDED,
+    burstLen = 4,
+    writeBurstPct = 0,
+    readBurstPct = 0,
+    stride = 4096,
+    localityPct = 0,
+    localityWindow = 0,
+    readPct = 50,
+    injectPct = 100,
+    numIds = 4,
+    maxOutstandingPerId = 2,
+  };
+};
+
+/**
+ * \brief Pointer-chasing traffic: single-beat accesses, mostly near the previous one,
+ * with one outstanding request per ID at a quarter of the peak request rate.
+ * \ingroup AXI
+ */
+struct pointerChase {
+  enum {
+    pattern = LOCALITY,
+    burstLen = 1,
+    writeBurstPct = 0,
+    readBurstPct = 0,
+    stride = 0,
+    localityPct = 80,
+    localityWindow = 256,
+    readPct = 75,
+    injectPct = 25,
+    numIds = 4,
+    maxOutstandingPerId = 1,
+  };
+};
+
+}  // namespace traffic
+}  // namespace axi
+
+#endif
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef BANK_MAPPING_H
+#define BANK_MAPPING_H
+
+#include <nvhls_types.h>
+#include <nvhls_int.h>
+
+/**
+ * \brief Address to (bank, index within bank) mapping policies for banked memories
+ * \ingroup MemArray
+ *
+ * \par Overview
+ * A policy provides, for NumBanks banks and AddrWidth-bit addresses,
+ * \code
+ *    template <unsigned int NumBanks, unsigned int AddrWidth>
+ *    static NVUINTW(nvhls::index_width<NumBanks>::val) bank(NVUINTW(AddrWidth) addr);
+ *
+ *    template <unsigned int NumBanks, unsigned int AddrWidth>
+ *    static NVUINTW(AddrWidth) index(NVUINTW(AddrWidth) addr);
+ * \endcode
+ * and is taken as the BankMap template parameter of ScratchpadClass,
+ * Scratchpad, ArbitratedScratchpad and ArbitratedScratchpadDP. The index
+ * is the word index within the bank, as passed to mem_array_sep::read()
+ * and mem_array_sep::write().
+ * - BankMapLowBits: bank from the low address bits, i.e. addr % NumBanks
+ *   and index addr / NumBanks. This is the default and the only policy
+ *   that allows a NumBanks that is not a power of two; a prime NumBanks
+ *   then gives a prime-modulo mapping.
+ * - BankMapXorFold: bank is the XOR of all log2(NumBanks)-bit fields of the
+ *   address, index as BankMapLowBits.
+ * - BankMapPrimeDisplacement<Prime>: bank is (addr % NumBanks
+ *   + Prime * index) % NumBanks, index as BankMapLowBits.
+ * .
+ * A stride of NumBanks or more words (a power of two) sends every access to
+ * one bank under BankMapLowBits. BankMapXorFold spreads NumBanks accesses of
+ * any power-of-two stride across all banks. BankMapPrimeDisplacement does so
+ * up to a stride of NumBanks words and degrades gradually beyond it. The
+ * cost is an XOR tree, or an adder and a constant multiplier, on the bank
+ * select.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <bank_mapping.h>
+ *
+ *      ...
+ *      mem_array_sep<Data, 1024, 8> banks;
+ *      NVUINTW(10) addr;
+ *      ...
+ *      banks.write(BankMapXorFold::index<8, 10>(addr),
+ *                  BankMapXorFold::bank<8, 10>(addr), data);
+ *      ...
+ *      ArbitratedScratchpad<Data, 1024, 8, 8, 4, BankMapXorFold> scratchpad;
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+struct BankMapLowBits {
+  template <unsigned int NumBanks, unsigned int AddrWidth>
+  static NVUINTW(nvhls::index_width<NumBanks>::val) bank(NVUINTW(AddrWidth) addr) {
+    static const unsigned int kBankWidth = nvhls::index_width<NumBanks>::val;
+    if (NumBanks == 1) {
+      return 0;
+    } else if ((NumBanks & (NumBanks - 1)) == 0) {
+      return nvhls::get_slc<kBankWidth>(addr, 0);
+    } else {
+      return addr % NumBanks;
+    }
+  }
+
+  template <unsigned int NumBanks, unsigned int AddrWidth>
+  static NVUINTW(AddrWidth) index(NVUINTW(AddrWidth) addr) {
+    static const unsigned int kBankWidth = nvhls::index_width<NumBanks>::val;
+    if (NumBanks == 1) {
+      return addr;
+    } else if ((NumBanks & (NumBanks - 1)) == 0) {
+      return addr >> kBankWidth;
+    } else {
+      return addr / NumBanks;
+    }
+  }
+};
+
+struct BankMapXorFold {
+  template <unsigned int NumBanks, unsigned int AddrWidth>
+  static NVUINTW(nvhls::index_width<NumBanks>::val) bank(NVUINTW(AddrWidth) addr) {
+    static const unsigned int kBankWidth = nvhls::index_width<NumBanks>::val;
+    static const unsigned int kNumFields = (AddrWidth + kBankWidth - 1) / kBankWidth;
+    static_assert((NumBanks & (NumBanks - 1)) == 0, "BankMapXorFold needs a power of two NumBanks");
+    NVUINTW(kBankWidth) bank_sel = 0;
+    if (NumBanks > 1) {
+      NVUINTW(AddrWidth) rest = addr;
+      #pragma hls_unroll yes
+      for (unsigned int i = 0; i < kNumFields; i++) {
+        NVUINTW(kBankWidth) field = nvhls::get_slc<kBankWidth>(rest, 0);
+        bank_sel ^= field;
+        rest >>= kBankWidth;
+      }
+    }
+    return bank_sel;
+  }
+
+  template <unsigned int NumBanks, unsigned int AddrWidth>
+  static NVUINTW(AddrWidth) index(NVUINTW(AddrWidth) addr) {
+    return BankMapLowBits::index<NumBanks, AddrWidth>(addr);
+  }
+};
+
+template <unsigned int Prime = 7>
+struct BankMapPrimeDisplacement {
+  template <unsigned int NumBanks, unsigned int AddrWidth>
+  static NVUINTW(nvhls::index_width<NumBanks>::val) bank(NVUINTW(AddrWidth) addr) {
+    static const unsigned int kBankWidth = nvhls::index_width<NumBanks>::val;
+    static_assert((NumBanks & (NumBanks - 1)) == 0, "BankMapPrimeDisplacement needs a power of two NumBanks");
+    static_assert(Prime % 2 == 1, "Prime must be odd");
+    if (NumBanks == 1) {
+      return 0;
+    }
+    NVUINTW(kBankWidth) low = nvhls::get_slc<kBankWidth>(addr, 0);
+    NVUINTW(kBankWidth) row = nvhls::get_slc<kBankWidth>(index<NumBanks, AddrWidth>(addr), 0);
+    NVUINTW(kBankWidth) bank_sel = low + row * Prime;
+    return bank_sel;
+  }
+
+  template <unsigned int NumBanks, unsigned int AddrWidth>
+  static NVUINTW(AddrWidth) index(NVUINTW(AddrWidth) addr) {
+    return BankMapLowBits::index<NumBanks, AddrWidth>(addr);
+  }
+};
+
+#endif
@@ -23,7 +23,11 @@
  */
 
 #include <iostream>
+#include <nvhls_int.h>
 #include <nvhls_marshaller.h>
+#ifndef __SYNTHESIS__
+#include <algorithm>
+#endif
 
 using namespace std;
 
@@ -120,6 +124,693 @@ class Minmax<ArrT, ElemT, IdxT, is_max, 1> {
   static IdxT minmax(ArrT inputs, IdxT start, IdxT end) { return start; }
 };
 
+// Number of radix-Radix levels needed to reduce N candidates to one
+template <unsigned N, unsigned Radix>
+struct minmax_levels {
+  static const unsigned val = 1 + minmax_levels<(N + Radix - 1) / Radix, Radix>::val;
+};
+
+template <unsigned Radix>
+struct minmax_levels<1, Radix> {
+  static const unsigned val = 0;
+};
+
+// One tree level: each group of Radix candidates reduces to its best. Ties
+// keep the lower index, as in Minmax.
+template <typename ElemT, typename IdxT, bool is_max, unsigned Count,
+          unsigned Radix>
+class MinmaxLevel {
+ public:
+  static const unsigned OutCount = (Count + Radix - 1) / Radix;
+
+  static void reduce(const ElemT v[Count], const IdxT idx[Count],
+                     ElemT out_v[OutCount], IdxT out_idx[OutCount]) {
+#pragma hls_unroll yes
+    for (unsigned g = 0; g < OutCount; g++) {
+      ElemT best_v = v[g * Radix];
+      IdxT best_idx = idx[g * Radix];
+#pragma hls_unroll yes
+      for (unsigned r = 1; r < Radix; r++) {
+        unsigned j = g * Radix + r;
+        if (j < Count) {
+          bool better = is_max ? (v[j] > best_v) : (v[j] < best_v);
+          if (better) {
+            best_v = v[j];
+            best_idx = idx[j];
+          }
+        }
+      }
+      out_v[g] = best_v;
+      out_idx[g] = best_idx;
+    }
+  }
+};
+
+// Levels consecutive tree levels without registers
+template <typename ElemT, typename IdxT, bool is_max, unsigned Count,
+          unsigned Radix, unsigned Levels>
+class MinmaxLevels {
+  typedef MinmaxLevel<ElemT, IdxT, is_max, Count, Radix> First;
+  typedef MinmaxLevels<ElemT, IdxT, is_max, First::OutCount, Radix, Levels - 1> Rest;
+
+ public:
+  static const unsigned OutCount = Rest::OutCount;
+
+  static void reduce(const ElemT v[Count], const IdxT idx[Count],
+                     ElemT out_v[OutCount], IdxT out_idx[OutCount]) {
+    ElemT mid_v[First::OutCount];
+    IdxT mid_idx[First::OutCount];
+    First::reduce(v, idx, mid_v, mid_idx);
+    Rest::reduce(mid_v, mid_idx, out_v, out_idx);
+  }
+};
+
+template <typename ElemT, typename IdxT, bool is_max, unsigned Count,
+          unsigned Radix>
+class MinmaxLevels<ElemT, IdxT, is_max, Count, Radix, 0> {
+ public:
+  static const unsigned OutCount = Count;
+
+  static void reduce(const ElemT v[Count], const IdxT idx[Count],
+                     ElemT out_v[OutCount], IdxT out_idx[OutCount]) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < Count; i++) {
+      out_v[i] = v[i];
+      out_idx[i] = idx[i];
+    }
+  }
+};
+
+/**
+ * \brief Configurable-radix minmax tree over an array
+ * \ingroup comptrees
+ *
+ * \tparam ElemT  Element type
+ * \tparam IdxT   Type of the index
+ * \tparam is_max true if this is a max function, false for min
+ * \tparam N      Number of elements; need not be a power of Radix
+ * \tparam Radix  Candidates compared per tree node: 2, 4 or 8 (default: 2)
+ *
+ * \par Overview
+ * Returns the index (and value) of the largest or smallest of N elements,
+ * the lowest index on ties, with NumLevels = ceil(log_Radix(N)) levels of
+ * Radix-input comparison nodes. A larger radix trades fewer levels for
+ * wider nodes. MinmaxTreePipelined registers the same tree.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <comptrees.h>
+ *
+ *      ...
+ *      NVUINT8 scores[256];
+ *      NVUINT8 best;
+ *      NVUINT8 idx = MinmaxTree<NVUINT8, NVUINT8, true, 256, 4>::minmax(scores, best);
+ *      ...
+ * \endcode
+ */
+template <typename ElemT, typename IdxT, bool is_max, unsigned N,
+          unsigned Radix = 2>
+class MinmaxTree {
+ public:
+  static const unsigned NumLevels = minmax_levels<N, Radix>::val;
+
+  static IdxT minmax(const ElemT inputs[N], ElemT& value) {
+    IdxT idx[N];
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < N; i++) {
+      idx[i] = i;
+    }
+    ElemT out_v[1];
+    IdxT out_idx[1];
+    MinmaxLevels<ElemT, IdxT, is_max, N, Radix, NumLevels>::reduce(inputs, idx, out_v, out_idx);
+    value = out_v[0];
+    return out_idx[0];
+  }
+
+  static IdxT minmax(const ElemT inputs[N]) {
+    ElemT value;
+    return minmax(inputs, value);
+  }
+};
+
+// One pipeline stage: LevelsPerStage levels into registers, then the rest
+// of the tree. The last stage (or every level, with LevelsPerStage = 0) is
+// combinational to the outputs.
+template <typename ElemT, typename IdxT, bool is_max, unsigned Count,
+          unsigned Radix, unsigned LevelsPerStage, unsigned LevelsLeft,
+          bool Last = (LevelsPerStage == 0 || LevelsLeft <= LevelsPerStage)>
+class MinmaxPipeStage {
+  typedef MinmaxLevels<ElemT, IdxT, is_max, Count, Radix, LevelsPerStage> Segment;
+  typedef MinmaxPipeStage<ElemT, IdxT, is_max, Segment::OutCount, Radix,
+                          LevelsPerStage, LevelsLeft - LevelsPerStage> Next;
+
+  ElemT reg_v[Segment::OutCount];
+  IdxT reg_idx[Segment::OutCount];
+  bool reg_valid;
+  Next next;
+
+ public:
+  static const unsigned Latency = 1 + Next::Latency;
+
+  MinmaxPipeStage() { reset(); }
+
+  void reset() {
+    reg_valid = false;
+    next.reset();
+  }
+
+  void run(const ElemT v[Count], const IdxT idx[Count], bool valid,
+           ElemT& out_v, IdxT& out_idx, bool& out_valid) {
+    // The later stages consume this stage's registers before they update
+    next.run(reg_v, reg_idx, reg_valid, out_v, out_idx, out_valid);
+    Segment::reduce(v, idx, reg_v, reg_idx);
+    reg_valid = valid;
+  }
+};
+
+template <typename ElemT, typename IdxT, bool is_max, unsigned Count,
+          unsigned Radix, unsigned LevelsPerStage, unsigned LevelsLeft>
+class MinmaxPipeStage<ElemT, IdxT, is_max, Count, Radix, LevelsPerStage,
+                      LevelsLeft, true> {
+  typedef MinmaxLevels<ElemT, IdxT, is_max, Count, Radix, LevelsLeft> Segment;
+
+ public:
+  static const unsigned Latency = 0;
+
+  void reset() {}
+
+  void run(const ElemT v[Count], const IdxT idx[Count], bool valid,
+           ElemT& out_v, IdxT& out_idx, bool& out_valid) {
+    ElemT res_v[1];
+    IdxT res_idx[1];
+    Segment::reduce(v, idx, res_v, res_idx);
+    out_v = res_v[0];
+    out_idx = res_idx[0];
+    out_valid = valid;
+  }
+};
+
+/**
+ * \brief Pipelined configurable-radix minmax tree, and its cycle-accurate C++ model
+ * \ingroup comptrees
+ *
+ * \tparam ElemT           Element type
+ * \tparam IdxT            Type of the index
+ * \tparam is_max          true if this is a max function, false for min
+ * \tparam N               Number of elements
+ * \tparam Radix           Candidates compared per tree node (default: 2)
+ * \tparam LevelsPerStage  Tree levels between pipeline registers; 0 for none
+ *
+ * \par Overview
+ * The MinmaxTree of the same parameters, with a register stage after every
+ * LevelsPerStage levels. Call run() once per cycle (e.g. from a pipelined
+ * loop at II=1): the result for the inputs of one call comes out Latency
+ * calls later, with out_valid echoing valid. Latency is
+ * ceil(NumLevels / LevelsPerStage) - 1.
+ *
+ * \par A Simple Example
+ * \code
+ *      typedef MinmaxTreePipelined<NVUINT8, NVUINT8, true, 256, 4, 2> TopTree;
+ *      TopTree tree;   // 4 levels, 2 per stage: Latency 1
+ *      ...
+ *      tree.run(scores, scores_valid, best, best_idx, best_valid);
+ * \endcode
+ */
+template <typename ElemT, typename IdxT, bool is_max, unsigned N,
+          unsigned Radix = 2, unsigned LevelsPerStage = 0>
+class MinmaxTreePipelined {
+  typedef MinmaxPipeStage<ElemT, IdxT, is_max, N, Radix, LevelsPerStage,
+                          minmax_levels<N, Radix>::val> Stages;
+  Stages stages;
+
+ public:
+  static const unsigned NumLevels = minmax_levels<N, Radix>::val;
+  static const unsigned Latency = Stages::Latency;
+
+  MinmaxTreePipelined() { reset(); }
+
+  void reset() { stages.reset(); }
+
+  void run(const ElemT inputs[N], bool valid, ElemT& value, IdxT& idx,
+           bool& out_valid) {
+    IdxT in_idx[N];
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < N; i++) {
+      in_idx[i] = i;
+    }
+    stages.run(inputs, in_idx, valid, value, idx, out_valid);
+  }
+};
+
+/* Sorting networks and top-K selection.
+ *
+ * The networks work on NumSlots = a power of two slots of (key, index,
+ * present) triples. Inputs past N are absent and order after every present
+ * element; since they are constant, synthesis removes their comparators.
+ * Ties on the key go to the lower input index, so every network and the
+ * scalar simulation path produce the same, stable, order.
+ */
+
+// Sorting network algorithms
+struct SortBitonic {};
+struct SortOddEvenMerge {};
+
+template <typename ElemT, typename IdxT>
+struct sort_slot {
+  ElemT key;
+  IdxT idx;
+  bool present;
+};
+
+template <typename ElemT, typename IdxT, bool Descending>
+struct sort_compare {
+  typedef sort_slot<ElemT, IdxT> Slot;
+
+  // True if a comes first in the output
+  static bool before(const Slot& a, const Slot& b) {
+    bool key_first = Descending ? (a.key > b.key) : (a.key < b.key);
+    return a.present &&
+           (!b.present || key_first || (a.key == b.key && a.idx < b.idx));
+  }
+
+  // Compare-and-swap: puts the first of the two at a if up, at b otherwise
+  static void cas(Slot v[], unsigned a, unsigned b, bool up) {
+    bool swap = up ? before(v[b], v[a]) : before(v[a], v[b]);
+    if (swap) {
+      Slot tmp = v[a];
+      v[a] = v[b];
+      v[b] = tmp;
+    }
+  }
+
+#ifndef __SYNTHESIS__
+  // Scalar ordering of input indices, for the simulation path
+  struct by_key {
+    const ElemT* keys;
+    explicit by_key(const ElemT* k) : keys(k) {}
+    bool operator()(unsigned a, unsigned b) const {
+      bool key_first = Descending ? (keys[a] > keys[b]) : (keys[a] < keys[b]);
+      return key_first || (keys[a] == keys[b] && a < b);
+    }
+  };
+#endif
+};
+
+// Comparator stages [first, last) of a sorting network on P slots. Each
+// stage is one column of independent compare-and-swaps; the stage count is
+// a compile-time constant, so the loops fully unroll.
+template <typename Algorithm>
+struct sort_network_stages;
+
+template <>
+struct sort_network_stages<SortBitonic> {
+  template <typename Cmp, unsigned P>
+  static void run(typename Cmp::Slot v[P], unsigned first, unsigned last) {
+    unsigned s = 0;
+#pragma hls_unroll yes
+    for (unsigned k = 2; k <= P; k *= 2) {
+#pragma hls_unroll yes
+      for (unsigned j = k / 2; j >= 1; j /= 2) {
+        if (s >= first && s < last) {
+#pragma hls_unroll yes
+          for (unsigned i = 0; i < P; i++) {
+            unsigned l = i ^ j;
+            if (l > i) {
+              Cmp::cas(v, i, l, (i & k) == 0);
+            }
+          }
+        }
+        s++;
+      }
+    }
+  }
+};
+
+template <>
+struct sort_network_stages<SortOddEvenMerge> {
+  template <typename Cmp, unsigned P>
+  static void run(typename Cmp::Slot v[P], unsigned first, unsigned last) {
+    unsigned s = 0;
+#pragma hls_unroll yes
+    for (unsigned p = 1; p < P; p *= 2) {
+#pragma hls_unroll yes
+      for (unsigned k = p; k >= 1; k /= 2) {
+        if (s >= first && s < last) {
+#pragma hls_unroll yes
+          for (unsigned j = k % p; j + k < P; j += 2 * k) {
+#pragma hls_unroll yes
+            for (unsigned i = 0; i < k && i + j + k < P; i++) {
+              if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                Cmp::cas(v, i + j, i + j + k, true);
+              }
+            }
+          }
+        }
+        s++;
+      }
+    }
+  }
+};
+
+/**
+ * \brief Sorting network over an array, with index payload
+ * \ingroup comptrees
+ *
+ * \tparam ElemT       Key type
+ * \tparam IdxT        Type of the index
+ * \tparam N           Number of elements; need not be a power of two
+ * \tparam Descending  true to sort largest first (default: smallest first)
+ * \tparam Algorithm   SortBitonic (default) or SortOddEvenMerge
+ *
+ * \par Overview
+ * sort() writes the N keys in order to out and, in out_idx, the input index
+ * of each. Ties go to the lower index. Both algorithms take
+ * NumStages = L * (L + 1) / 2 comparator stages, L = log2(NumSlots); bitonic
+ * uses NumSlots / 2 comparators per stage, odd-even merge fewer but with
+ * less regular wiring.
+ *
+ * In synthesis sort() is the network; in C++ simulation it is a scalar
+ * std::sort with the same result. sort_network() always runs the network,
+ * and SortNetworkPipelined adds registers between stages.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <comptrees.h>
+ *
+ *      ...
+ *      NVUINT16 deadlines[6], sorted[6];
+ *      NVUINT3 order[6];
+ *      SortNetwork<NVUINT16, NVUINT3, 6>::sort(deadlines, sorted, order);
+ *      ...
+ * \endcode
+ */
+template <typename ElemT, typename IdxT, unsigned N, bool Descending = false,
+          typename Algorithm = SortBitonic>
+class SortNetwork {
+ public:
+  typedef ElemT Elem;
+  typedef IdxT Idx;
+  typedef sort_compare<ElemT, IdxT, Descending> Cmp;
+  typedef typename Cmp::Slot Slot;
+
+  static const unsigned NumInputs = N;
+  static const unsigned NumOutputs = N;
+  static const unsigned NumSlots = nvhls::next_pow2<N>::val;
+  static const unsigned NumStages = nvhls::log2_ceil<NumSlots>::val *
+                                    (nvhls::log2_ceil<NumSlots>::val + 1) / 2;
+
+  static void load(const ElemT in[N], Slot v[NumSlots]) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumSlots; i++) {
+      v[i].key = (i < N) ? in[i] : in[0];
+      v[i].idx = i;
+      v[i].present = (i < N);
+    }
+  }
+
+  static void stages(Slot v[NumSlots], unsigned first, unsigned last) {
+    sort_network_stages<Algorithm>::template run<Cmp, NumSlots>(v, first, last);
+  }
+
+  static void unload(const Slot v[NumSlots], ElemT out[N], IdxT out_idx[N]) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < N; i++) {
+      out[i] = v[i].key;
+      out_idx[i] = v[i].idx;
+    }
+  }
+
+  static void sort_network(const ElemT in[N], ElemT out[N], IdxT out_idx[N]) {
+    Slot v[NumSlots];
+    load(in, v);
+    stages(v, 0, NumStages);
+    unload(v, out, out_idx);
+  }
+
+#ifndef __SYNTHESIS__
+  static void sort_scalar(const ElemT in[N], ElemT out[N], IdxT out_idx[N]) {
+    unsigned order[N];
+    for (unsigned i = 0; i < N; i++) {
+      order[i] = i;
+    }
+    std::sort(order, order + N, typename Cmp::by_key(in));
+    for (unsigned i = 0; i < N; i++) {
+      out[i] = in[order[i]];
+      out_idx[i] = order[i];
+    }
+  }
+#endif
+
+  static void sort(const ElemT in[N], ElemT out[N], IdxT out_idx[N]) {
+#ifdef __SYNTHESIS__
+    sort_network(in, out, out_idx);
+#else
+    sort_scalar(in, out, out_idx);
+#endif
+  }
+};
+
+/**
+ * \brief Top-K selection network, with index payload
+ * \ingroup comptrees
+ *
+ * \tparam ElemT       Key type
+ * \tparam IdxT        Type of the index
+ * \tparam N           Number of elements
+ * \tparam K           Number of elements selected, 1 <= K <= N
+ * \tparam Descending  true to select the K largest (default: K smallest)
+ *
+ * \par Overview
+ * select() writes the K smallest (or largest) keys, in order, and their input
+ * indices; ties go to the lower index, as in SortNetwork. The inputs are
+ * split into groups of next_pow2(K), each group is sorted with a bitonic
+ * network, and pairs of groups are then merged with a half cleaner and a
+ * bitonic merge that keep only the first group's worth. This costs far fewer
+ * comparators than a full sort when K is much smaller than N.
+ *
+ * As with SortNetwork, select() is the network in synthesis and a scalar
+ * sort in C++ simulation; select_network() always runs the network.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <comptrees.h>
+ *
+ *      ...
+ *      NVUINT16 deadlines[32], earliest[4];
+ *      NVUINT5 requesters[4];
+ *      TopK<NVUINT16, NVUINT5, 32, 4>::select(deadlines, earliest, requesters);
+ *      ...
+ * \endcode
+ */
+template <typename ElemT, typename IdxT, unsigned N, unsigned K,
+          bool Descending = false>
+class TopK {
+ public:
+  typedef ElemT Elem;
+  typedef IdxT Idx;
+  typedef sort_compare<ElemT, IdxT, Descending> Cmp;
+  typedef typename Cmp::Slot Slot;
+
+  static const unsigned NumInputs = N;
+  static const unsigned NumOutputs = K;
+  static const unsigned GroupSize = nvhls::next_pow2<K>::val;
+  static const unsigned NumGroups =
+      nvhls::next_pow2<(N + GroupSize - 1) / GroupSize>::val;
+  static const unsigned NumSlots = GroupSize * NumGroups;
+  static const unsigned GroupLevels = nvhls::log2_ceil<GroupSize>::val;
+  static const unsigned MergeLevels = nvhls::log2_ceil<NumGroups>::val;
+  static const unsigned NumStages = GroupLevels * (GroupLevels + 1) / 2 +
+                                    MergeLevels * (1 + GroupLevels);
+
+  static void load(const ElemT in[N], Slot v[NumSlots]) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumSlots; i++) {
+      v[i].key = (i < N) ? in[i] : in[0];
+      v[i].idx = i;
+      v[i].present = (i < N);
+    }
+  }
+
+  static void stages(Slot v[NumSlots], unsigned first, unsigned last) {
+    unsigned s = 0;
+    // Sort every group ascending
+#pragma hls_unroll yes
+    for (unsigned k = 2; k <= GroupSize; k *= 2) {
+#pragma hls_unroll yes
+      for (unsigned j = k / 2; j >= 1; j /= 2) {
+        if (s >= first && s < last) {
+#pragma hls_unroll yes
+          for (unsigned i = 0; i < NumSlots; i++) {
+            unsigned l = i ^ j;
+            if (l > i) {
+              Cmp::cas(v, i, l, k == GroupSize || (i & k) == 0);
+            }
+          }
+        }
+        s++;
+      }
+    }
+    // Merge pairs of sorted groups, keeping the first GroupSize
+#pragma hls_unroll yes
+    for (unsigned stride = GroupSize; stride < NumSlots; stride *= 2) {
+      if (s >= first && s < last) {
+#pragma hls_unroll yes
+        for (unsigned a = 0; a < NumSlots; a += 2 * stride) {
+#pragma hls_unroll yes
+          for (unsigned i = 0; i < GroupSize; i++) {
+            Cmp::cas(v, a + i, a + stride + GroupSize - 1 - i, true);
+          }
+        }
+      }
+      s++;
+#pragma hls_unroll yes
+      for (unsigned j = GroupSize / 2; j >= 1; j /= 2) {
+        if (s >= first && s < last) {
+#pragma hls_unroll yes
+          for (unsigned a = 0; a < NumSlots; a += 2 * stride) {
+#pragma hls_unroll yes
+            for (unsigned i = a; i < a + GroupSize; i++) {
+              unsigned l = i ^ j;
+              if (l > i) {
+                Cmp::cas(v, i, l, true);
+              }
+            }
+          }
+        }
+        s++;
+      }
+    }
+  }
+
+  static void unload(const Slot v[NumSlots], ElemT out[K], IdxT out_idx[K]) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < K; i++) {
+      out[i] = v[i].key;
+      out_idx[i] = v[i].idx;
+    }
+  }
+
+  static void select_network(const ElemT in[N], ElemT out[K], IdxT out_idx[K]) {
+    Slot v[NumSlots];
+    load(in, v);
+    stages(v, 0, NumStages);
+    unload(v, out, out_idx);
+  }
+
+#ifndef __SYNTHESIS__
+  static void select_scalar(const ElemT in[N], ElemT out[K], IdxT out_idx[K]) {
+    unsigned order[N];
+    for (unsigned i = 0; i < N; i++) {
+      order[i] = i;
+    }
+    std::partial_sort(order, order + K, order + N, typename Cmp::by_key(in));
+    for (unsigned i = 0; i < K; i++) {
+      out[i] = in[order[i]];
+      out_idx[i] = order[i];
+    }
+  }
+#endif
+
+  static void select(const ElemT in[N], ElemT out[K], IdxT out_idx[K]) {
+#ifdef __SYNTHESIS__
+    select_network(in, out, out_idx);
+#else
+    select_scalar(in, out, out_idx);
+#endif
+  }
+};
+
+/**
+ * \brief Pipelined SortNetwork or TopK, and its cycle-accurate C++ model
+ * \ingroup comptrees
+ *
+ * \tparam Network       A SortNetwork or TopK instance
+ * \tparam StagesPerReg  Comparator stages between pipeline registers; 0 for none
+ *
+ * \par Overview
+ * Runs the network with a register after every StagesPerReg comparator
+ * stages. Call run() once per cycle (e.g. from a pipelined loop at II=1):
+ * the result for the inputs of one call comes out Latency calls later, with
+ * out_valid echoing valid. Latency is ceil(NumStages / StagesPerReg) - 1.
+ *
+ * \par A Simple Example
+ * \code
+ *      typedef SortNetwork<NVUINT16, NVUINT3, 8> Sorter;   // 6 stages
+ *      SortNetworkPipelined<Sorter, 2> sorter;             // Latency 2
+ *      ...
+ *      sorter.run(deadlines, req_valid, sorted, order, sorted_valid);
+ * \endcode
+ */
+template <typename Network, unsigned StagesPerReg = 0>
+class SortNetworkPipelined {
+  typedef typename Network::Elem ElemT;
+  typedef typename Network::Idx IdxT;
+  typedef typename Network::Slot Slot;
+  static const unsigned NumSlots = Network::NumSlots;
+  static const unsigned SegStages =
+      (StagesPerReg == 0 || StagesPerReg > Network::NumStages)
+          ? Network::NumStages
+          : StagesPerReg;
+
+ public:
+  static const unsigned NumStages = Network::NumStages;
+  static const unsigned Latency =
+      (SegStages == 0) ? 0 : (NumStages + SegStages - 1) / SegStages - 1;
+
+ private:
+  // One spare entry so that the arrays are never empty
+  Slot regs[Latency + 1][NumSlots];
+  bool reg_valid[Latency + 1];
+
+ public:
+  SortNetworkPipelined() { reset(); }
+
+  void reset() {
+#pragma hls_unroll yes
+    for (unsigned r = 0; r <= Latency; r++) {
+      reg_valid[r] = false;
+    }
+  }
+
+  void run(const ElemT in[Network::NumInputs], bool valid,
+           ElemT out[Network::NumOutputs], IdxT out_idx[Network::NumOutputs],
+           bool& out_valid) {
+    // Last segment, from the last register (or the inputs)
+    Slot v[NumSlots];
+    if (Latency == 0) {
+      Network::load(in, v);
+      out_valid = valid;
+    } else {
+#pragma hls_unroll yes
+      for (unsigned i = 0; i < NumSlots; i++) {
+        v[i] = regs[Latency == 0 ? 0 : Latency - 1][i];
+      }
+      out_valid = reg_valid[Latency == 0 ? 0 : Latency - 1];
+    }
+    Network::stages(v, Latency * SegStages, NumStages);
+    Network::unload(v, out, out_idx);
+
+    // Middle segments, consuming each register before it updates
+#pragma hls_unroll yes
+    for (unsigned n = 1; n < Latency; n++) {
+      unsigned r = Latency - n;
+#pragma hls_unroll yes
+      for (unsigned i = 0; i < NumSlots; i++) {
+        regs[r][i] = regs[r - 1][i];
+      }
+      Network::stages(regs[r], r * SegStages, (r + 1) * SegStages);
+      reg_valid[r] = reg_valid[r - 1];
+    }
+
+    // First segment
+    if (Latency > 0) {
+      Network::load(in, regs[0]);
+      Network::stages(regs[0], 0, SegStages);
+      reg_valid[0] = valid;
+    }
+  }
+};
+
 /* Compile time SC datatype concatenator tree.
  *
  * This class can be used to concatenate NumElements number of SC datatype
@@ -187,12 +878,67 @@ class Concat<BaseTemplate, ElemW, 1> {
  *     condition for MPL recursion.
  */
 
+#if !defined(__SYNTHESIS__) && defined(__GNUC__)
+// C++ simulation only: bitvector types whose bits fit a native word, which
+// PriEnc searches with count-trailing-zeros instead of bit by bit
+template <typename VecT>
+struct pri_enc_sim {
+  static const bool native = false;
+  static unsigned long long bits(const VecT& x) { return 0; }
+};
+
+template <int W>
+struct pri_enc_sim<sc_uint<W> > {
+  static const bool native = true;
+  static unsigned long long bits(const sc_uint<W>& x) { return x.to_uint64(); }
+};
+
+template <int W>
+struct pri_enc_sim<sc_int<W> > {
+  static const bool native = true;
+  static unsigned long long bits(const sc_int<W>& x) { return x.to_uint64(); }
+};
+
+#ifdef HLS_CATAPULT
+template <int W, bool S>
+struct pri_enc_sim<ac_int<W, S> > {
+  static const bool native = (W <= 64);
+  static unsigned long long bits(const ac_int<W, S>& x) { return x.to_uint64(); }
+};
+
+#ifdef NVHLS_FAST_SIM_INT
+template <int W, bool S>
+struct pri_enc_sim<nvhls::fast_int<W, S> > {
+  static const bool native = true;
+  static unsigned long long bits(const nvhls::fast_int<W, S>& x) { return x.to_uint64(); }
+};
+#endif
+#endif
+#endif
+
 // Base condition
 template <typename VecT, typename ValT, typename IdxT, unsigned Width>
 class PriEnc {
  public:
   // This is the pri_enc function to call:
   static IdxT val(VecT inputs, ValT comp_value) {
+#if !defined(__SYNTHESIS__) && defined(__GNUC__)
+    if (pri_enc_sim<VecT>::native && Width <= 64) {
+      unsigned long long v = pri_enc_sim<VecT>::bits(inputs);
+      if (comp_value == 0) {
+        v = ~v;
+      } else if (!(comp_value == 1)) {
+        v = 0;
+      }
+      if (Width < 64) {
+        v &= (1ULL << (Width % 64)) - 1;
+      }
+      if (v == 0) {
+        return -1;
+      }
+      return __builtin_ctzll(v);
+    }
+#endif
     // This call will expand into some compile-time TMP recursion:
     IdxT retval =
         PriEnc<VecT, ValT, IdxT, Width>::val(inputs, comp_value, 0, Width - 1);
@@ -233,4 +979,46 @@ class PriEnc<VecT, ValT, IdxT, 1> {
   }
 };
 
+/**
+ * \brief Priority encoders of several bitvectors at once
+ * \ingroup comptrees
+ *
+ * \tparam VecT   Bitvector type
+ * \tparam ValT   Value type
+ * \tparam IdxT   Type of the returned positions (should be size log2(Width)+1)
+ * \tparam Width  The size of the range to search in each bitvector
+ * \tparam Lanes  Number of bitvectors
+ *
+ * \par Overview
+ * outputs[l] is PriEnc<VecT, ValT, IdxT, Width>::val(inputs[l], comp_value),
+ * the position of the first comp_value from the LSB of inputs[l], or -1. The
+ * lanes are unrolled into parallel encoders in hardware, and bitvectors of up
+ * to 64 bits are searched with count-trailing-zeros in C++ simulation.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <comptrees.h>
+ *
+ *      ...
+ *      NVUINT8 valid[4];
+ *      NVINT4 first[4];
+ *      ...
+ *      PriEncLanes<NVUINT8, bool, NVINT4, 8, 4>::val(valid, true, first);
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename VecT, typename ValT, typename IdxT, unsigned Width, unsigned Lanes>
+class PriEncLanes {
+ public:
+  static void val(const VecT inputs[Lanes], ValT comp_value, IdxT outputs[Lanes]) {
+#pragma hls_unroll yes
+    for (unsigned lane = 0; lane < Lanes; lane++) {
+      outputs[lane] = PriEnc<VecT, ValT, IdxT, Width>::val(inputs[lane], comp_value);
+    }
+  }
+};
+
 #endif
@@ -18,6 +18,8 @@
 
 #include "nvhls_int.h"
 #include "nvhls_types.h"
+#include "nvhls_assert.h"
+#include "TypeToBits.h"
 #include <stdio.h>
 
 // this section probably deserves it's own h file
@@ -30,6 +32,243 @@ T zero_bits() {
     return t;
 }
 
+/**
+ * \brief Benes network of 2x2 switches for N = 2^k lanes
+ * \ingroup Crossbar
+ *
+ * \tparam N                    Number of lanes, a power of two (at least 2)
+ *
+ * \par Overview
+ * - 2*log2(N)-1 stages of N/2 switches, NumSwitches control bits in total:
+ *   the first stage, the upper and lower N/2 subnetworks, then the last
+ *   stage. A set bit crosses its switch.
+ * - route() is pure switch logic of depth 2*log2(N)-1 and N*log2(N) area,
+ *   against N^2 for a flat crossbar.
+ * - setup() computes the controls of any permutation with the looping
+ *   algorithm. It is meant to be run once for a static permutation (e.g. at
+ *   configuration time) and the result kept in registers.
+ *
+ * \par A Simple Example
+ * \code
+ *      unsigned perm[8];                // output j receives input perm[j]
+ *      bool ctrl[benes_network<8>::NumSwitches];
+ *      benes_network<8>::setup(perm, ctrl);
+ *      ...
+ *      benes_network<8>::route<DataType>(data_in, ctrl, data_out);
+ * \endcode
+ */
+template <unsigned N>
+struct benes_network {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "Benes network size must be a power of two");
+    typedef benes_network<N / 2> Sub;
+    static const unsigned NumStages = 2 * nvhls::log2_ceil<N>::val - 1;
+    static const unsigned NumSwitches = N + 2 * Sub::NumSwitches;
+
+    // Route through the switches starting at ctrl[Offset]
+    template <typename DataType, unsigned Offset, unsigned TotalSwitches>
+    static void route_at(const DataType in[N], const bool ctrl[TotalSwitches], DataType out[N]) {
+        DataType up_in[N / 2], lo_in[N / 2], up_out[N / 2], lo_out[N / 2];
+#pragma hls_unroll yes
+        for (unsigned s = 0; s < N / 2; s++) {
+            bool cross = ctrl[Offset + s];
+            up_in[s] = cross ? in[2 * s + 1] : in[2 * s];
+            lo_in[s] = cross ? in[2 * s] : in[2 * s + 1];
+        }
+        Sub::template route_at<DataType, Offset + N / 2, TotalSwitches>(up_in, ctrl, up_out);
+        Sub::template route_at<DataType, Offset + N / 2 + Sub::NumSwitches, TotalSwitches>(lo_in, ctrl, lo_out);
+#pragma hls_unroll yes
+        for (unsigned t = 0; t < N / 2; t++) {
+            bool cross = ctrl[Offset + N / 2 + 2 * Sub::NumSwitches + t];
+            out[2 * t] = cross ? lo_out[t] : up_out[t];
+            out[2 * t + 1] = cross ? up_out[t] : lo_out[t];
+        }
+    }
+
+    template <typename DataType>
+    static void route(const DataType in[N], const bool ctrl[NumSwitches], DataType out[N]) {
+        route_at<DataType, 0, NumSwitches>(in, ctrl, out);
+    }
+
+    // Controls for perm, written to ctrl[offset..offset+NumSwitches-1]
+    static void setup(const unsigned perm[N], bool ctrl[], unsigned offset = 0) {
+        int sub[N];  // subnetwork of each input: 0 upper, 1 lower
+        unsigned inv[N];
+        for (unsigned i = 0; i < N; i++) {
+            sub[i] = -1;
+        }
+        for (unsigned j = 0; j < N; j++) {
+            NVHLS_ASSERT_MSG(perm[j] < N, "Benes permutation entry out of range");
+            inv[perm[j]] = j;
+        }
+        // Looping algorithm: the two inputs of a first stage switch, and the
+        // two sources of a last stage switch, take different subnetworks
+        for (unsigned start = 0; start < N; start++) {
+            unsigned i = start;
+            while (sub[i] == -1) {
+                sub[i] = 0;
+                sub[i ^ 1] = 1;
+                i = perm[inv[i ^ 1] ^ 1];
+            }
+        }
+        unsigned up_perm[N / 2], lo_perm[N / 2];
+        for (unsigned s = 0; s < N / 2; s++) {
+            ctrl[offset + s] = (sub[2 * s] == 1);
+        }
+        for (unsigned t = 0; t < N / 2; t++) {
+            for (unsigned j = 2 * t; j < 2 * t + 2; j++) {
+                if (sub[perm[j]] == 0) {
+                    up_perm[t] = perm[j] / 2;
+                } else {
+                    lo_perm[t] = perm[j] / 2;
+                }
+            }
+            ctrl[offset + N / 2 + 2 * Sub::NumSwitches + t] = (sub[perm[2 * t]] == 1);
+        }
+        Sub::setup(up_perm, ctrl, offset + N / 2);
+        Sub::setup(lo_perm, ctrl, offset + N / 2 + Sub::NumSwitches);
+    }
+};
+
+template <>
+struct benes_network<2> {
+    static const unsigned NumStages = 1;
+    static const unsigned NumSwitches = 1;
+
+    template <typename DataType, unsigned Offset, unsigned TotalSwitches>
+    static void route_at(const DataType in[2], const bool ctrl[TotalSwitches], DataType out[2]) {
+        bool cross = ctrl[Offset];
+        out[0] = cross ? in[1] : in[0];
+        out[1] = cross ? in[0] : in[1];
+    }
+
+    template <typename DataType>
+    static void route(const DataType in[2], const bool ctrl[NumSwitches], DataType out[2]) {
+        route_at<DataType, 0, NumSwitches>(in, ctrl, out);
+    }
+
+    static void setup(const unsigned perm[2], bool ctrl[], unsigned offset = 0) {
+        ctrl[offset] = (perm[0] == 1);
+    }
+};
+
+/**
+ * \brief Crossbar topologies, selected by the Topology template parameter of crossbar()
+ * \ingroup Crossbar
+ *
+ * - CrossbarFlat: one flat N:1 mux per output lane (default).
+ * - CrossbarMuxTree: one binary tree of 2:1 muxes per output lane, level l
+ *   steered by bit l of source. Same function as the flat mux, but with its
+ *   log2(N) levels explicit so that HLS can register between them.
+ * - CrossbarBenes: a benes_network; needs NumInputLanes == NumOutputLanes, a
+ *   power of two, and valid sources that are all distinct. The routing is
+ *   computed from source on every call, so it suits static permutations;
+ *   for synthesis, run benes_network::setup() once and call route().
+ */
+struct CrossbarFlat {};
+struct CrossbarMuxTree {};
+struct CrossbarBenes {};
+
+// route(): routed[dst] and routed_valid[dst] from the selected input lane
+template <typename Topology>
+struct crossbar_route;
+
+template <>
+struct crossbar_route<CrossbarFlat> {
+    template <typename DataType, unsigned NumInputLanes, unsigned NumOutputLanes>
+    static void route(DataType data_in[NumInputLanes], bool valid_in[NumInputLanes],
+            NVUINTW(nvhls::index_width<NumInputLanes>::val) source[NumOutputLanes],
+            bool valid_source[NumOutputLanes],
+            DataType routed[NumOutputLanes], bool routed_valid[NumOutputLanes]) {
+        NVUINTW(nvhls::index_width<NumInputLanes>::val) source_tmp;
+#pragma hls_unroll yes
+        for (unsigned dst = 0; dst < NumOutputLanes; dst++) {
+            source_tmp = source[dst];
+            if (!valid_source[dst]) {
+                source_tmp = 0;
+            }
+            routed_valid[dst] = valid_in[source_tmp];
+            routed[dst] = data_in[source_tmp];
+        }
+    }
+};
+
+template <>
+struct crossbar_route<CrossbarMuxTree> {
+    template <typename DataType, unsigned NumInputLanes, unsigned NumOutputLanes>
+    static void route(DataType data_in[NumInputLanes], bool valid_in[NumInputLanes],
+            NVUINTW(nvhls::index_width<NumInputLanes>::val) source[NumOutputLanes],
+            bool valid_source[NumOutputLanes],
+            DataType routed[NumOutputLanes], bool routed_valid[NumOutputLanes]) {
+        static const unsigned Levels = nvhls::index_width<NumInputLanes>::val;
+        static const unsigned Leaves = 1 << Levels;
+#pragma hls_unroll yes
+        for (unsigned dst = 0; dst < NumOutputLanes; dst++) {
+            DataType level_data[Leaves];
+            bool level_valid[Leaves];
+#pragma hls_unroll yes
+            for (unsigned i = 0; i < Leaves; i++) {
+                level_data[i] = (i < NumInputLanes) ? data_in[i] : zero_bits<DataType>();
+                level_valid[i] = (i < NumInputLanes) && valid_in[i];
+            }
+            // Each level halves the candidates; node k only reads 2k and
+            // 2k+1, so the tree can be collapsed in place
+#pragma hls_unroll yes
+            for (unsigned l = 0; l < Levels; l++) {
+                bool sel = valid_source[dst] && (source[dst][l] == 1);
+#pragma hls_unroll yes
+                for (unsigned k = 0; k < (Leaves >> (l + 1)); k++) {
+                    level_data[k] = sel ? level_data[2 * k + 1] : level_data[2 * k];
+                    level_valid[k] = sel ? level_valid[2 * k + 1] : level_valid[2 * k];
+                }
+            }
+            routed[dst] = level_data[0];
+            routed_valid[dst] = level_valid[0];
+        }
+    }
+};
+
+template <>
+struct crossbar_route<CrossbarBenes> {
+    template <typename DataType, unsigned NumInputLanes, unsigned NumOutputLanes>
+    static void route(DataType data_in[NumInputLanes], bool valid_in[NumInputLanes],
+            NVUINTW(nvhls::index_width<NumInputLanes>::val) source[NumOutputLanes],
+            bool valid_source[NumOutputLanes],
+            DataType routed[NumOutputLanes], bool routed_valid[NumOutputLanes]) {
+        static_assert(NumInputLanes == NumOutputLanes, "Benes crossbar needs as many inputs as outputs");
+        typedef benes_network<NumInputLanes> Network;
+
+        // Complete the valid selections to a permutation with the unused inputs
+        unsigned perm[NumInputLanes];
+        bool used[NumInputLanes];
+        for (unsigned i = 0; i < NumInputLanes; i++) {
+            used[i] = false;
+        }
+        for (unsigned dst = 0; dst < NumOutputLanes; dst++) {
+            if (valid_source[dst]) {
+                unsigned src = source[dst].to_uint();
+                NVHLS_ASSERT_MSG(!used[src], "Benes crossbar sources must be a permutation");
+                used[src] = true;
+                perm[dst] = src;
+            }
+        }
+        unsigned next_unused = 0;
+        for (unsigned dst = 0; dst < NumOutputLanes; dst++) {
+            if (!valid_source[dst]) {
+                while (used[next_unused]) {
+                    next_unused++;
+                }
+                used[next_unused] = true;
+                perm[dst] = next_unused;
+            }
+        }
+
+        bool ctrl[Network::NumSwitches];
+        Network::setup(perm, ctrl);
+        Network::template route<DataType>(data_in, ctrl, routed);
+        Network::template route<bool>(valid_in, ctrl, routed_valid);
+    }
+};
+
 /**
  * \brief Main entry point for crossbar - most generic implementation. 
  * \ingroup Crossbar
@@ -37,6 +276,7 @@ T zero_bits() {
  * \tparam DataType             Datatype of input and output of each lane 
  * \tparam NumInputLanes        Number of input lanes
  * \tparam NumOutputLanes       Number of output lanes
+ * \tparam Topology             CrossbarFlat (default), CrossbarMuxTree or CrossbarBenes
  *
  * \param[in]   data_in         Array of data inputs for each lane, indexed by input lane id.
  * \param[in]   valid_in        Array of boolean valid bits, indexed by input lane id.. False means data can be ignored.
@@ -74,28 +314,23 @@ T zero_bits() {
  *
  */
 
-template <typename DataType, unsigned NumInputLanes, unsigned NumOutputLanes>
+template <typename DataType, unsigned NumInputLanes, unsigned NumOutputLanes,
+          typename Topology = CrossbarFlat>
 void crossbar(DataType data_in[NumInputLanes], bool valid_in[NumInputLanes],
         NVUINTW(nvhls::index_width<NumInputLanes >::val) source[NumOutputLanes],
         bool valid_source[NumOutputLanes],
         DataType data_out[NumOutputLanes],
         bool valid_out[NumOutputLanes]) {
 
-    NVUINTW(nvhls::index_width<NumInputLanes>::val) source_tmp;
-    bool valid_in_tmp;
-    DataType data_in_tmp;
+    DataType routed[NumOutputLanes];
+    bool routed_valid[NumOutputLanes];
+    crossbar_route<Topology>::template route<DataType, NumInputLanes, NumOutputLanes>(
+            data_in, valid_in, source, valid_source, routed, routed_valid);
 
 #pragma hls_unroll yes
     for (unsigned dst = 0; dst < NumOutputLanes; dst++) {
-        source_tmp = source[dst];
-        if (!valid_source[dst]) {
-            source_tmp = 0;
-        }
-        valid_in_tmp = valid_in[source_tmp];
-        data_in_tmp = data_in[source_tmp];
-
-        if (valid_source[dst] && valid_in_tmp) {
-            data_out[dst] = data_in_tmp;
+        if (valid_source[dst] && routed_valid[dst]) {
+            data_out[dst] = routed[dst];
             valid_out[dst] = true;
         } else {
             data_out[dst] = zero_bits<DataType>();
@@ -108,7 +343,8 @@ void crossbar(DataType data_in[NumInputLanes], bool valid_in[NumInputLanes],
  * \brief Simplified specialization with no `valid_source` parameter. All `source` selections are assumed to be valid.
  * \ingroup Crossbar
  */
-template <typename DataType, unsigned NumInputLanes, unsigned NumOutputLanes>
+template <typename DataType, unsigned NumInputLanes, unsigned NumOutputLanes,
+          typename Topology = CrossbarFlat>
 void crossbar(DataType data_in[NumInputLanes], bool valid_in[NumInputLanes],
         NVUINTW(nvhls::index_width<NumInputLanes>::val) source[NumOutputLanes],
         DataType data_out[NumOutputLanes],
@@ -118,7 +354,7 @@ void crossbar(DataType data_in[NumInputLanes], bool valid_in[NumInputLanes],
     for (unsigned i = 0; i < NumOutputLanes; ++i)
         valid_source[i] = true;
 
-    crossbar<DataType, NumInputLanes, NumOutputLanes>(
+    crossbar<DataType, NumInputLanes, NumOutputLanes, Topology>(
             data_in, valid_in, source, valid_source, data_out, valid_out);
 }
 
@@ -126,7 +362,8 @@ void crossbar(DataType data_in[NumInputLanes], bool valid_in[NumInputLanes],
  * \brief Simplified specialization with no valid parameter at all. Inputs are assumed to be valid. Validity of outputs is not reported.
  * \ingroup Crossbar
  */
-template <typename DataType, unsigned NumInputLanes, unsigned NumOutputLanes>
+template <typename DataType, unsigned NumInputLanes, unsigned NumOutputLanes,
+          typename Topology = CrossbarFlat>
 void crossbar(DataType data_in[NumInputLanes],
         NVUINTW(nvhls::index_width<NumInputLanes>::val) source[NumOutputLanes],
         DataType data_out[NumOutputLanes]) {
@@ -136,8 +373,151 @@ void crossbar(DataType data_in[NumInputLanes],
     for (unsigned int i = 0; i < NumInputLanes; ++i)
         valid_in[i] = true;
 
-    crossbar<DataType, NumInputLanes, NumOutputLanes>(data_in, valid_in, source,
+    crossbar<DataType, NumInputLanes, NumOutputLanes, Topology>(data_in, valid_in, source,
             data_out, valid_out);
 }
 
+/**
+ * \brief Variant with valid bitmasks instead of bool arrays. Bit i of valid_in is the valid of input lane i, bit j of valid_source and valid_out those of output lane j.
+ * \ingroup Crossbar
+ *
+ * Validity is combined with word-wide operations: valid_out is the selected
+ * valid_in bits AND valid_source, and only the data lanes need a loop.
+ */
+template <typename DataType, unsigned NumInputLanes, unsigned NumOutputLanes>
+void crossbar(DataType data_in[NumInputLanes], const NVUINTW(NumInputLanes) & valid_in,
+        NVUINTW(nvhls::index_width<NumInputLanes>::val) source[NumOutputLanes],
+        const NVUINTW(NumOutputLanes) & valid_source,
+        DataType data_out[NumOutputLanes],
+        NVUINTW(NumOutputLanes) & valid_out) {
+
+    NVUINTW(NumOutputLanes) selected_valid = 0;
+#pragma hls_unroll yes
+    for (unsigned dst = 0; dst < NumOutputLanes; dst++) {
+        selected_valid[dst] = valid_in[source[dst]];
+    }
+    valid_out = selected_valid & valid_source;
+
+#pragma hls_unroll yes
+    for (unsigned dst = 0; dst < NumOutputLanes; dst++) {
+        data_out[dst] = (valid_out[dst] == 1) ? data_in[source[dst]] : zero_bits<DataType>();
+    }
+}
+
+/**
+ * \brief Bitmask variant with no `valid_source` parameter. All `source` selections are assumed to be valid.
+ * \ingroup Crossbar
+ */
+template <typename DataType, unsigned NumInputLanes, unsigned NumOutputLanes>
+void crossbar(DataType data_in[NumInputLanes], const NVUINTW(NumInputLanes) & valid_in,
+        NVUINTW(nvhls::index_width<NumInputLanes>::val) source[NumOutputLanes],
+        DataType data_out[NumOutputLanes],
+        NVUINTW(NumOutputLanes) & valid_out) {
+
+    NVUINTW(NumOutputLanes) valid_source = ~static_cast<NVUINTW(NumOutputLanes)>(0);
+    crossbar<DataType, NumInputLanes, NumOutputLanes>(
+            data_in, valid_in, source, valid_source, data_out, valid_out);
+}
+
+/**
+ * \brief Crossbar driven by one-hot select masks, e.g. the results of Arbiter::pick()
+ * \ingroup Crossbar
+ *
+ * \tparam DataType             Datatype of input and output of each lane
+ * \tparam NumInputLanes        Number of input lanes
+ * \tparam NumOutputLanes       Number of output lanes
+ *
+ * \param[in]   data_in         Array of data inputs for each lane, indexed by input lane id.
+ * \param[in]   select          One-hot input lane mask for each output lane; zero selects nothing.
+ * \param[out]  data_out        Array of outputs, indexed by output lane id. Zero when nothing is selected.
+ * \param[out]  valid_out       Bit j set if output lane j selected an input lane.
+ *
+ * \par Overview
+ * Each output is an AND-OR mux over the input lanes, so there is no
+ * one_hot_to_bin conversion in front of the crossbar. At most one bit of
+ * each select mask may be set.
+ *
+ * \par A Simple Example
+ * \code
+ *      Arbiter<NUM_INPUTS>::Mask grant[NUM_OUTPUTS];
+ *      for (unsigned out = 0; out < NUM_OUTPUTS; out++)
+ *        grant[out] = arbiters[out].pick(requests[out]);
+ *      crossbar_onehot<Word_t, NUM_INPUTS, NUM_OUTPUTS>(data_in, grant, data_out, valid_out);
+ * \endcode
+ */
+template <typename DataType, unsigned NumInputLanes, unsigned NumOutputLanes>
+void crossbar_onehot(DataType data_in[NumInputLanes],
+        NVUINTW(NumInputLanes) select[NumOutputLanes],
+        DataType data_out[NumOutputLanes],
+        NVUINTW(NumOutputLanes) & valid_out) {
+
+    static const unsigned Width = Wrapped<DataType>::width;
+    NVUINTW(Width) bits_in[NumInputLanes];
+#pragma hls_unroll yes
+    for (unsigned src = 0; src < NumInputLanes; src++) {
+        bits_in[src] = TypeToNVUINT<DataType>(data_in[src]);
+    }
+
+    NVUINTW(NumOutputLanes) valid_local = 0;
+#pragma hls_unroll yes
+    for (unsigned dst = 0; dst < NumOutputLanes; dst++) {
+        NVUINTW(Width) bits_out = 0;
+#pragma hls_unroll yes
+        for (unsigned src = 0; src < NumInputLanes; src++) {
+            if (select[dst][src] == 1) {
+                bits_out |= bits_in[src];
+            }
+        }
+        data_out[dst] = NVUINTToType<DataType>(bits_out);
+        valid_local[dst] = (select[dst] != 0);
+    }
+    valid_out = valid_local;
+}
+
+/**
+ * \brief Crossbar driven by destination masks on the input side (multicast)
+ * \ingroup Crossbar
+ *
+ * \tparam DataType             Datatype of input and output of each lane
+ * \tparam NumInputLanes        Number of input lanes
+ * \tparam NumOutputLanes       Number of output lanes
+ *
+ * \param[in]   data_in         Array of data inputs for each lane, indexed by input lane id.
+ * \param[in]   dest            Output lane mask of each input lane; bit j set sends the input to output lane j.
+ * \param[out]  data_out        Array of outputs, indexed by output lane id. Zero when no input targets it.
+ * \param[out]  valid_out       Bit j set if some input lane targets output lane j.
+ *
+ * \par Overview
+ * One input can drive any number of outputs in the same call, so a broadcast
+ * needs one copy of the data instead of one per output. The masks are
+ * transposed into one-hot selects for crossbar_onehot(); the masks of
+ * different inputs must not overlap.
+ *
+ * \par A Simple Example
+ * \code
+ *      NVUINTW(NUM_OUTPUTS) dest[NUM_INPUTS];  // dest[0] = 0xf broadcasts input 0
+ *      crossbar_multicast<Word_t, NUM_INPUTS, NUM_OUTPUTS>(data_in, dest, data_out, valid_out);
+ * \endcode
+ */
+template <typename DataType, unsigned NumInputLanes, unsigned NumOutputLanes>
+void crossbar_multicast(DataType data_in[NumInputLanes],
+        NVUINTW(NumOutputLanes) dest[NumInputLanes],
+        DataType data_out[NumOutputLanes],
+        NVUINTW(NumOutputLanes) & valid_out) {
+
+    NVUINTW(NumInputLanes) select[NumOutputLanes];
+#pragma hls_unroll yes
+    for (unsigned dst = 0; dst < NumOutputLanes; dst++) {
+#pragma hls_unroll yes
+        for (unsigned src = 0; src < NumInputLanes; src++) {
+            select[dst][src] = dest[src][dst];
+        }
+#ifndef __SYNTHESIS__
+        NVHLS_ASSERT_MSG((select[dst] & (select[dst] - 1)) == 0,
+                         "Destination masks of several inputs overlap");
+#endif
+    }
+    crossbar_onehot<DataType, NumInputLanes, NumOutputLanes>(data_in, select, data_out, valid_out);
+}
+
 #endif  // CROSSBAR_H
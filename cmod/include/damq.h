@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DAMQ_H
+#define DAMQ_H
+
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <nvhls_marshaller.h>
+
+/**
+ * \brief Dynamically allocated multi-queue (shared buffer FIFO)
+ * \ingroup FIFO
+ *
+ * \tparam DataType         DataType of entry
+ * \tparam PoolSize         Number of entries in each pool
+ * \tparam NumQueues        Number of queues sharing a pool
+ * \tparam NumPools         Number of independent pools (default 1)
+ *
+ * \par Overview
+ * Each pool holds PoolSize entries that are handed out on demand to its
+ * NumQueues FIFO queues, instead of giving every queue a fixed partition.
+ * - Entries of a queue form a linked list through a next pointer per entry.
+ *   Every queue has a head, a tail and an entry count; free entries form a
+ *   second linked list per pool.
+ * - Bank b of the FIFO-style interface is queue b % NumQueues of pool
+ *   b / NumQueues, so a DAMQ can replace a FIFO<DataType, Len, NumPools *
+ *   NumQueues> whose banks are grouped by pool.
+ * - A push takes the head of the free list and a pop returns its entry to
+ *   the free list, so one push and one pop per pool and cycle keep a single
+ *   pointer chain. isFull() is true when the pool of the bank has no free
+ *   entry; reserving a minimum share per queue is left to the user (see
+ *   WHVCRouter).
+ * .
+ * reset() rebuilds the free list, which writes every next pointer.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <damq.h>
+ *
+ *      ...
+ *      // 4 input ports with 2 VCs each, 8 shared entries per port
+ *      DAMQ<DataType, 8, 2, 4> buffer;
+ *      buffer.reset();
+ *      ...
+ *      if (!buffer.isFull(port * 2 + vc)) {
+ *        buffer.push(data, port * 2 + vc);
+ *      }
+ *      ...
+ *      if (!buffer.isEmpty(port * 2 + vc)) {
+ *        data = buffer.pop(port * 2 + vc);
+ *      }
+ * \endcode
+ * \par
+ *
+ */
+template <typename DataType, unsigned int PoolSize, unsigned int NumQueues,
+          unsigned int NumPools = 1>
+class DAMQ {
+ public:
+  static const unsigned int NumBanks = NumPools * NumQueues;
+  static const int BankSelWidth =
+      (NumBanks == 1) ? 1 : nvhls::nbits<NumBanks - 1>::val;
+  static const int AddrWidth =
+      (PoolSize == 1) ? 1 : nvhls::nbits<PoolSize - 1>::val;
+  typedef NVUINTW(BankSelWidth) BankIdx;
+  typedef NVUINTW(AddrWidth) FifoIdx;
+  typedef NVUINTW(AddrWidth+1) FifoIdxPlusOne;
+  typedef NVUINTW(NumBanks) BankMask;
+
+  DataType body[NumPools][PoolSize];
+  FifoIdx next[NumPools][PoolSize];  // next entry of the same list
+  FifoIdx head[NumBanks];
+  FifoIdx tail[NumBanks];
+  FifoIdxPlusOne count[NumBanks];
+  FifoIdx free_head[NumPools];
+  FifoIdxPlusOne free_count[NumPools];
+
+  DAMQ() { reset(); }
+
+  // Function to push data to a queue
+  void push(DataType wr_data, BankIdx bidx = 0) {
+    NVHLS_ASSERT_MSG(!isFull(bidx), "Pushing data to full DAMQ pool");
+    unsigned int pool = bidx / NumQueues;
+    FifoIdx slot = free_head[pool];
+    free_head[pool] = next[pool][slot];
+    free_count[pool]--;
+    body[pool][slot] = wr_data;
+    if (count[bidx] != 0) {
+      next[pool][tail[bidx]] = slot;
+    } else {
+      head[bidx] = slot;
+    }
+    tail[bidx] = slot;
+    count[bidx]++;
+  }
+
+  // Function to pop data from a queue
+  DataType pop(BankIdx bidx = 0) {
+    NVHLS_ASSERT_MSG(!isEmpty(bidx), "Popping data from empty DAMQ queue");
+    DataType rd_data = peek(bidx);
+    incrHead(bidx);
+    return rd_data;
+  }
+
+  // Function to drop the head of a queue and free its entry
+  void incrHead(BankIdx bidx = 0) {
+    NVHLS_ASSERT_MSG(!isEmpty(bidx), "Incrementing Head of empty DAMQ queue");
+    unsigned int pool = bidx / NumQueues;
+    FifoIdx slot = head[bidx];
+    head[bidx] = next[pool][slot];
+    count[bidx]--;
+    next[pool][slot] = free_head[pool];
+    free_head[pool] = slot;
+    free_count[pool]++;
+  }
+
+  // Function to peek from a queue
+  DataType peek(BankIdx bidx = 0) {
+    NVHLS_ASSERT_MSG(!isEmpty(bidx), "Peeking data from empty DAMQ queue");
+    unsigned int pool = bidx / NumQueues;
+    return body[pool][head[bidx]];
+  }
+
+  // Checks if the queue is empty
+  bool isEmpty(BankIdx bidx = 0) { return count[bidx] == 0; }
+
+  // Checks if the pool of the queue has no free entry
+  bool isFull(BankIdx bidx = 0) { return free_count[bidx / NumQueues] == 0; }
+
+  // Returns number of entries held by the queue
+  FifoIdxPlusOne NumFilled(BankIdx bidx = 0) { return count[bidx]; }
+
+  // Returns number of free entries in the pool of the queue
+  FifoIdxPlusOne NumAvailable(BankIdx bidx = 0) {
+    return free_count[bidx / NumQueues];
+  }
+
+  // Bank-parallel operations, as in FIFO. Queues of the same pool are
+  // served in bank order.
+  void push_multi(const DataType wr_data[NumBanks], BankMask mask) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumBanks; i++) {
+      if (mask[i]) {
+        push(wr_data[i], i);
+      }
+    }
+  }
+
+  void pop_multi(BankMask mask, DataType rd_data[NumBanks]) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumBanks; i++) {
+      if (mask[i]) {
+        rd_data[i] = pop(i);
+      }
+    }
+  }
+
+  void peek_multi(BankMask mask, DataType rd_data[NumBanks]) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumBanks; i++) {
+      if (mask[i]) {
+        rd_data[i] = peek(i);
+      }
+    }
+  }
+
+  void incrHead_multi(BankMask mask) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumBanks; i++) {
+      if (mask[i]) {
+        incrHead(i);
+      }
+    }
+  }
+
+  // Bit i set if queue i is empty / its pool is full
+  BankMask isEmpty_multi() {
+    BankMask result = 0;
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumBanks; i++) {
+      result[i] = isEmpty(i);
+    }
+    return result;
+  }
+
+  BankMask isFull_multi() {
+    BankMask result = 0;
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumBanks; i++) {
+      result[i] = isFull(i);
+    }
+    return result;
+  }
+
+  // Empty all queues and chain every entry into the free list
+  void reset() {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumBanks; i++) {
+      head[i] = 0;
+      tail[i] = 0;
+      count[i] = 0;
+    }
+#pragma hls_unroll yes
+    for (unsigned p = 0; p < NumPools; p++) {
+#pragma hls_unroll yes
+      for (unsigned i = 0; i < PoolSize; i++) {
+        next[p][i] = (i + 1 == PoolSize) ? 0 : i + 1;
+      }
+      free_head[p] = 0;
+      free_count[p] = PoolSize;
+    }
+  }
+
+  template<unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    for (unsigned p = 0; p < NumPools; p++) {
+      for (unsigned i = 0; i < PoolSize; i++) {
+        m & body[p][i];
+        m & next[p][i];
+      }
+      m & free_head[p];
+      m & free_count[p];
+    }
+    for (unsigned i = 0; i < NumBanks; i++) {
+      m & head[i];
+      m & tail[i];
+      m & count[i];
+    }
+  }
+};
+
+#endif  // DAMQ_H
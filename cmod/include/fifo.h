@@ -19,6 +19,82 @@
 #include <nvhls_types.h>
 #include <mem_array.h>
 #include <nvhls_assert.h>
+
+/**
+ * \brief FIFO storage policies
+ * \ingroup FIFO
+ *
+ * Selects how the general FIFO maps its entries:
+ * - FifoStorageRegFile: a mem_array_sep, leaving the choice of register file
+ *   or flops to HLS (default).
+ * - FifoStorageFlop: a plain register array with no memory wrapper, for
+ *   shallow FIFOs that need every entry readable at once.
+ * - FifoStorageSram: a mem_array_sep intended to be mapped to a 1R1W SRAM
+ *   macro with a registered output, plus one prefetch register per bank that
+ *   holds the head entry. peek()/pop() read the prefetch register, and the
+ *   SRAM read that refills it is issued by the pop, so the read latency is
+ *   hidden and the FIFO still sustains one push and one pop per cycle. When
+ *   both happen in the same cycle, call pop() before push() so that the
+ *   refill never reads an entry written in the same cycle.
+ *
+ * The one-entry and zero-entry FIFOs are always plain registers and ignore
+ * the policy.
+ */
+struct FifoStorageRegFile {};
+struct FifoStorageFlop {};
+struct FifoStorageSram {};
+
+// Plain register storage with the mem_array_sep read/write interface
+template <typename T, int NumEntries, int NumBanks>
+class fifo_flop_array {
+ public:
+  static const unsigned int NumEntriesPerBank = NumEntries / NumBanks;
+  static const int width = NumEntries * Wrapped<T>::width;
+  typedef NVUINTW(nvhls::index_width<NumEntriesPerBank>::val) LocalIndex;
+  typedef NVUINTW(nvhls::index_width<NumBanks>::val) BankIndex;
+
+  T data[NumBanks][NumEntriesPerBank];
+
+  T read(LocalIndex idx, BankIndex bank_sel = 0) {
+    NVHLS_ASSERT_MSG(bank_sel < NumBanks, "bank index out of bounds");
+    NVHLS_ASSERT_MSG(idx < NumEntriesPerBank, "local index out of bounds");
+    return data[bank_sel][idx];
+  }
+
+  void write(LocalIndex idx, BankIndex bank_sel, T val) {
+    NVHLS_ASSERT_MSG(bank_sel < NumBanks, "bank index out of bounds");
+    NVHLS_ASSERT_MSG(idx < NumEntriesPerBank, "local index out of bounds");
+    data[bank_sel][idx] = val;
+  }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    for (unsigned i = 0; i < NumBanks; i++) {
+      for (unsigned j = 0; j < NumEntriesPerBank; j++) {
+        m & data[i][j];
+      }
+    }
+  }
+};
+
+template <typename Storage, typename T, int NumEntries, int NumBanks>
+struct fifo_storage_traits {
+  typedef mem_array_sep<T, NumEntries, NumBanks> Body;
+  static const bool prefetch = false;
+};
+
+template <typename T, int NumEntries, int NumBanks>
+struct fifo_storage_traits<FifoStorageFlop, T, NumEntries, NumBanks> {
+  typedef fifo_flop_array<T, NumEntries, NumBanks> Body;
+  static const bool prefetch = false;
+};
+
+template <typename T, int NumEntries, int NumBanks>
+struct fifo_storage_traits<FifoStorageSram, T, NumEntries, NumBanks> {
+  typedef mem_array_sep<T, NumEntries, NumBanks> Body;
+  static const bool prefetch = true;
+};
+
 /**
  * \brief Configurable FIFO class 
  * \ingroup FIFO
@@ -26,6 +102,8 @@
  * \tparam DataType         DataType of entry in FIFO 
  * \tparam FifoLen          Length of FIFO 
  * \tparam NumBanks         Number of FIFO banks 
+ * \tparam Storage          Storage policy: FifoStorageRegFile (default),
+ *                          FifoStorageFlop or FifoStorageSram
  *
  *
  * \par A Simple Example
@@ -55,13 +133,31 @@
  *      ...
  *      // IncrHead without reading data from FIFO
  *      fifo_inst.incrHead(bank_id);
+ *      ...
+ *      // Push to, or pop from, several banks in the same cycle
+ *      DataType bank_data[NumInputs];
+ *      FIFO<DataType, LenInputBuffer, NumInputs>::BankMask mask = ...;
+ *      fifo_inst.push_multi(bank_data, mask);
+ *      fifo_inst.pop_multi(mask, bank_data);
+ *      ...
+ *      // Burst access to one bank, with a lookahead and a watermark
+ *      DataType burst[4];
+ *      if (fifo_inst.NumFilled(bank_id) >= 4) {
+ *        next = fifo_inst.peek_at(3, bank_id);
+ *        fifo_inst.pop_n(burst, 4, bank_id);
+ *      }
+ *      bool throttle = fifo_inst.isAlmostFull(2, bank_id); // 2 or fewer free
+ *      ...
+ *      // Deep FIFO in an SRAM macro
+ *      FIFO<DataType, 1024, 1, FifoStorageSram> deep_fifo;
  *
  * \endcode
  * \par
  *
  */
 
-template <typename DataType, unsigned int FifoLen, unsigned int NumBanks = 1>
+template <typename DataType, unsigned int FifoLen, unsigned int NumBanks = 1,
+          typename Storage = FifoStorageRegFile>
 class FIFO {
 
  public:
@@ -72,13 +168,36 @@ class FIFO {
   typedef NVUINTW(BankSelWidth) BankIdx;
   typedef NVUINTW(AddrWidth) FifoIdx;
   typedef NVUINTW(AddrWidth+1) FifoIdxPlusOne;
+  typedef NVUINTW(NumBanks) BankMask;
+  typedef fifo_storage_traits<Storage, DataType, FifoLen * NumBanks, NumBanks> StorageTraits;
+  typedef typename StorageTraits::Body Body;
+  static const bool Prefetch = StorageTraits::prefetch;
 
   FifoIdx head[NumBanks];  // where to read from
   FifoIdx tail[NumBanks];  // where to write to
   // FifoLen is number of entries in each bank
-  mem_array_sep<DataType, FifoLen * NumBanks, NumBanks> fifo_body;
+  Body fifo_body;
   bool last_action_was_push[NumBanks];
-  static const int width =  mem_array_sep<DataType, FifoLen * NumBanks, NumBanks>::width + 2 * NumBanks * AddrWidth + NumBanks; 
+  DataType head_data[NumBanks];  // copy of the head entry, with Prefetch only
+  static const int width =  Body::width + 2 * NumBanks * AddrWidth + NumBanks +
+                            (Prefetch ? NumBanks * Wrapped<DataType>::width : 0);
+
+  // Head entry, from the prefetch register when there is one
+  DataType ReadHead(BankIdx bidx) {
+    if (Prefetch) {
+      return head_data[bidx];
+    }
+    FifoIdx head_local = head[bidx];
+    return fifo_body.read(head_local, bidx);
+  }
+
+  // After the head moved, load the new head entry into the prefetch register
+  void Refill(BankIdx bidx) {
+    if (Prefetch && !isEmpty(bidx)) {
+      FifoIdx head_local = head[bidx];
+      head_data[bidx] = fifo_body.read(head_local, bidx);
+    }
+  }
 
   // Function to do modulo increment of pointer
   FifoIdx ModIncr(FifoIdx curr_idx) {
@@ -99,9 +218,12 @@ class FIFO {
   }
 
   // Function to push data to FIFO
-  void push(DataType wr_data, BankIdx bidx = 0) {
+  void push(const DataType& wr_data, BankIdx bidx = 0) {
     NVHLS_ASSERT_MSG(!isFull(bidx), "Pushing data to full FIFO");
     FifoIdx tail_local = tail[bidx];
+    if (Prefetch && isEmpty(bidx)) {
+      head_data[bidx] = wr_data;
+    }
     fifo_body.write(tail_local, bidx, wr_data);
     tail[bidx] = ModIncr(tail_local);
     last_action_was_push[bidx] = true;
@@ -111,9 +233,10 @@ class FIFO {
   DataType pop(BankIdx bidx = 0) {
     NVHLS_ASSERT_MSG(!isEmpty(bidx), "Popping data from empty FIFO");
     FifoIdx head_local = head[bidx];
-    DataType rd_data = fifo_body.read(head_local, bidx);
+    DataType rd_data = ReadHead(bidx);
     head[bidx] = ModIncr(head_local);
     last_action_was_push[bidx] = false;
+    Refill(bidx);
     return rd_data;
   }
 
@@ -123,13 +246,13 @@ class FIFO {
     FifoIdx head_local = head[bidx];
     head[bidx] = ModIncr(head_local);
     last_action_was_push[bidx] = false;
+    Refill(bidx);
   }
 
   // Function to peek from FIFO
   DataType peek(BankIdx bidx = 0) {
     NVHLS_ASSERT_MSG(!isEmpty(bidx), "Peeking data from empty FIFO");
-    FifoIdx head_local = head[bidx];
-    return fifo_body.read(head_local, bidx);
+    return ReadHead(bidx);
   }
 
   // Checks if FIFO is empty
@@ -168,6 +291,128 @@ class FIFO {
       return (FifoLen - NumFilled(bidx));
   }
 
+  // Push wr_data[0..num-1] to one bank; num <= MaxN is checked at run time.
+  template <unsigned int MaxN>
+  void push_n(const DataType (&wr_data)[MaxN], unsigned int num, BankIdx bidx = 0) {
+    NVHLS_ASSERT_MSG(num <= MaxN && num <= NumAvailable(bidx), "Pushing too much data to FIFO");
+    FifoIdx tail_local = tail[bidx];
+    if (Prefetch && num != 0 && isEmpty(bidx)) {
+      head_data[bidx] = wr_data[0];
+    }
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < MaxN; i++) {
+      if (i < num) {
+        fifo_body.write(tail_local, bidx, wr_data[i]);
+        tail_local = ModIncr(tail_local);
+      }
+    }
+    tail[bidx] = tail_local;
+    if (num != 0) {
+      last_action_was_push[bidx] = true;
+    }
+  }
+
+  // Pop num <= MaxN entries of one bank into rd_data[0..num-1].
+  template <unsigned int MaxN>
+  void pop_n(DataType (&rd_data)[MaxN], unsigned int num, BankIdx bidx = 0) {
+    NVHLS_ASSERT_MSG(num <= MaxN && num <= NumFilled(bidx), "Popping too much data from FIFO");
+    FifoIdx head_local = head[bidx];
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < MaxN; i++) {
+      if (i < num) {
+        rd_data[i] = (Prefetch && i == 0) ? head_data[bidx]
+                                          : fifo_body.read(head_local, bidx);
+        head_local = ModIncr(head_local);
+      }
+    }
+    head[bidx] = head_local;
+    if (num != 0) {
+      last_action_was_push[bidx] = false;
+      Refill(bidx);
+    }
+  }
+
+  // Entry offset places behind the head, without popping (peek_at(0) == peek())
+  DataType peek_at(FifoIdx offset, BankIdx bidx = 0) {
+    NVHLS_ASSERT_MSG(offset < NumFilled(bidx), "Peeking beyond the FIFO contents");
+    if (Prefetch && offset == 0) {
+      return head_data[bidx];
+    }
+    FifoIdxPlusOne pos = head[bidx] + offset;
+    if (pos >= FifoLen) {
+      pos -= FifoLen;
+    }
+    FifoIdx pos_local = pos;
+    return fifo_body.read(pos_local, bidx);
+  }
+
+  // Watermarks: at most threshold free / filled entries left
+  bool isAlmostFull(FifoIdxPlusOne threshold, BankIdx bidx = 0) {
+    return NumAvailable(bidx) <= threshold;
+  }
+
+  bool isAlmostEmpty(FifoIdxPlusOne threshold, BankIdx bidx = 0) {
+    return NumFilled(bidx) <= threshold;
+  }
+
+  // Bank-parallel operations: bank i takes part if bit i of mask is set. The
+  // loops are unrolled with a constant bank per iteration, so every bank's
+  // head/tail pointers update in parallel instead of through a bank mux.
+  void push_multi(const DataType wr_data[NumBanks], BankMask mask) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumBanks; i++) {
+      if (mask[i]) {
+        push(wr_data[i], i);
+      }
+    }
+  }
+
+  void pop_multi(BankMask mask, DataType rd_data[NumBanks]) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumBanks; i++) {
+      if (mask[i]) {
+        rd_data[i] = pop(i);
+      }
+    }
+  }
+
+  void peek_multi(BankMask mask, DataType rd_data[NumBanks]) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumBanks; i++) {
+      if (mask[i]) {
+        rd_data[i] = peek(i);
+      }
+    }
+  }
+
+  void incrHead_multi(BankMask mask) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumBanks; i++) {
+      if (mask[i]) {
+        incrHead(i);
+      }
+    }
+  }
+
+  // Bit i set if bank i is empty / full
+  BankMask isEmpty_multi() {
+    BankMask result = 0;
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumBanks; i++) {
+      result[i] = isEmpty(i);
+    }
+    return result;
+  }
+
+  BankMask isFull_multi() {
+    BankMask result = 0;
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < NumBanks; i++) {
+      result[i] = isFull(i);
+    }
+    return result;
+  }
+
   // Reset head and tail pointers
   void reset() {
 #pragma hls_unroll yes
@@ -193,12 +438,17 @@ class FIFO {
     for (unsigned i = 0; i < NumBanks; i++) {
       m & last_action_was_push[i];
     }
+    if (Prefetch) {
+      for (unsigned i = 0; i < NumBanks; i++) {
+        m & head_data[i];
+      }
+    }
   }
 
 };  // end FIFO class
 
-template <typename DataType, unsigned int NumBanks>
-class FIFO<DataType, 0, NumBanks> {  // 0 entries, NumBanks
+template <typename DataType, unsigned int NumBanks, typename Storage>
+class FIFO<DataType, 0, NumBanks, Storage> {  // 0 entries, NumBanks
   // make sure no one is accessing a fifo with 0 entries ever
   // it will still be fine to create it
   static const int BankSelWidth =
@@ -207,9 +457,10 @@ class FIFO<DataType, 0, NumBanks> {  // 0 entries, NumBanks
  public:
   typedef NVUINTW(BankSelWidth) BankIdx;
   typedef NVUINTW(1) FifoIdx;
+  typedef NVUINTW(NumBanks) BankMask;
   FIFO() {}
 
-  void push(DataType wr_data, BankIdx bidx = 0) {NVHLS_ASSERT_MSG(0, "FIFO size is zero");}
+  void push(const DataType& wr_data, BankIdx bidx = 0) {NVHLS_ASSERT_MSG(0, "FIFO size is zero");}
 
   DataType pop(BankIdx bidx = 0) { NVHLS_ASSERT_MSG(0, "FIFO size is zero"); return DataType(); }
 
@@ -225,6 +476,18 @@ class FIFO<DataType, 0, NumBanks> {  // 0 entries, NumBanks
 
   FifoIdx NumAvailable(BankIdx bidx = 0) {NVHLS_ASSERT_MSG(0, "FIFO size is zero"); return 0; }
 
+  void push_multi(const DataType wr_data[NumBanks], BankMask mask) {NVHLS_ASSERT_MSG(0, "FIFO size is zero");}
+
+  void pop_multi(BankMask mask, DataType rd_data[NumBanks]) {NVHLS_ASSERT_MSG(0, "FIFO size is zero");}
+
+  void peek_multi(BankMask mask, DataType rd_data[NumBanks]) {NVHLS_ASSERT_MSG(0, "FIFO size is zero");}
+
+  void incrHead_multi(BankMask mask) {NVHLS_ASSERT_MSG(0, "FIFO size is zero");}
+
+  BankMask isEmpty_multi() {NVHLS_ASSERT_MSG(0, "FIFO size is zero"); return ~BankMask(0); }
+
+  BankMask isFull_multi() {NVHLS_ASSERT_MSG(0, "FIFO size is zero"); return ~BankMask(0); }
+
   void reset() {}
 };
 
@@ -235,18 +498,19 @@ class FIFO<DataType, 0, NumBanks> {  // 0 entries, NumBanks
  * \tparam DataType         DataType of entry in FIFO 
  *
  */
-template <typename DataType>
-class FIFO<DataType, 1, 1> {  
+template <typename DataType, typename Storage>
+class FIFO<DataType, 1, 1, Storage> {  
     DataType data;
     bool valid;
 
  public:
     static const int width =  Wrapped<DataType>::width + 1; 
     typedef NVUINTW(1) T;  //redundant
+    typedef NVUINTW(1) BankMask;
 
     FIFO() {reset();}
 
-    inline void push(DataType wr_data, T bidx = 0) 
+    inline void push(const DataType& wr_data, T bidx = 0) 
     {        
         NVHLS_ASSERT_MSG(!isFull(), "Pushing data to full FIFO");
         data = wr_data;
@@ -289,6 +553,54 @@ class FIFO<DataType, 1, 1> {
       return !valid;
     }
 
+    template <unsigned int MaxN>
+    inline void push_n(const DataType (&wr_data)[MaxN], unsigned int num, T bidx = 0)
+    {
+        NVHLS_ASSERT_MSG(num <= MaxN && num <= NumAvailable(), "Pushing too much data to FIFO");
+        if (num != 0) push(wr_data[0]);
+    }
+
+    template <unsigned int MaxN>
+    inline void pop_n(DataType (&rd_data)[MaxN], unsigned int num, T bidx = 0)
+    {
+        NVHLS_ASSERT_MSG(num <= MaxN && num <= NumFilled(), "Popping too much data from FIFO");
+        if (num != 0) rd_data[0] = pop();
+    }
+
+    inline DataType peek_at(T offset, T bidx = 0)
+    {
+        NVHLS_ASSERT_MSG(offset == 0, "Peeking beyond the FIFO contents");
+        return peek();
+    }
+
+    inline bool isAlmostFull(unsigned int threshold, T bidx = 0) { return NumAvailable() <= threshold; }
+
+    inline bool isAlmostEmpty(unsigned int threshold, T bidx = 0) { return NumFilled() <= threshold; }
+
+    inline void push_multi(const DataType wr_data[1], BankMask mask)
+    {
+        if (mask[0]) push(wr_data[0]);
+    }
+
+    inline void pop_multi(BankMask mask, DataType rd_data[1])
+    {
+        if (mask[0]) rd_data[0] = pop();
+    }
+
+    inline void peek_multi(BankMask mask, DataType rd_data[1])
+    {
+        if (mask[0]) rd_data[0] = peek();
+    }
+
+    inline void incrHead_multi(BankMask mask)
+    {
+        if (mask[0]) incrHead();
+    }
+
+    inline BankMask isEmpty_multi() { return !valid; }
+
+    inline BankMask isFull_multi() { return valid; }
+
     inline void reset() 
     {
         valid = false;
@@ -303,14 +615,19 @@ class FIFO<DataType, 1, 1> {
  * \brief Specialization for single entry and NumBanks for QoR optimization 
  * \ingroup FIFO
  *
+ * Each bank is a plain data register plus one bit of a packed occupancy
+ * vector, so there is no memory wrapper and isEmpty_multi()/isFull_multi()
+ * are just the occupancy vector.
+ *
  * \tparam DataType         DataType of entry in FIFO 
  * \tparam NumBanks         Number of FIFO banks 
  *
  */
-template <typename DataType, unsigned int NumBanks>
-class FIFO<DataType, 1, NumBanks> {  
-    DataType data[NumBanks];
-    bool     valid[NumBanks];
+template <typename DataType, unsigned int NumBanks, typename Storage>
+class FIFO<DataType, 1, NumBanks, Storage> {  
+    typedef NVUINTW(NumBanks) ValidMask;
+    DataType  data[NumBanks];
+    ValidMask valid;  // One occupancy bit per bank
     static const int width =  NumBanks * Wrapped<DataType>::width + NumBanks; 
 
  public:
@@ -318,15 +635,16 @@ class FIFO<DataType, 1, NumBanks> {
       (NumBanks == 1) ? 1 : nvhls::nbits<NumBanks - 1>::val;
     typedef NVUINTW(BankSelWidth) BankIdx;
     typedef NVUINTW(1) T;
+    typedef ValidMask BankMask;
 
     FIFO() {
       reset();
     }
 
-    inline void push(DataType wr_data, BankIdx bidx = 0) {        
+    inline void push(const DataType& wr_data, BankIdx bidx = 0) {        
       NVHLS_ASSERT_MSG(!isFull(bidx), "Pushing data to full FIFO");
       data[bidx]  = wr_data;
-      valid[bidx] = true;
+      valid[bidx] = 1;
     }
 
     inline DataType pop(BankIdx bidx = 0) {      
@@ -336,7 +654,7 @@ class FIFO<DataType, 1, NumBanks> {
 
     inline void incrHead(BankIdx bidx = 0) {
       NVHLS_ASSERT_MSG(!isEmpty(bidx), "Incrementing Head of empty FIFO");
-      valid[bidx] = false;
+      valid[bidx] = 0;
     }
 
     inline DataType peek(BankIdx bidx = 0) { 
@@ -352,24 +670,88 @@ class FIFO<DataType, 1, NumBanks> {
       return valid[bidx]; 
     }
 
-    inline T NumFilled(T bidx = 0) {
-        return valid; 
+    inline T NumFilled(BankIdx bidx = 0) {
+      return isFull(bidx);
     }
 
-    inline T NumAvailable(T bidx = 0) {
-      return !valid;
+    inline T NumAvailable(BankIdx bidx = 0) {
+      return isEmpty(bidx);
     }
 
-    inline void reset() {
+    template <unsigned int MaxN>
+    inline void push_n(const DataType (&wr_data)[MaxN], unsigned int num, BankIdx bidx = 0) {
+      NVHLS_ASSERT_MSG(num <= MaxN && num <= NumAvailable(bidx), "Pushing too much data to FIFO");
+      if (num != 0) push(wr_data[0], bidx);
+    }
+
+    template <unsigned int MaxN>
+    inline void pop_n(DataType (&rd_data)[MaxN], unsigned int num, BankIdx bidx = 0) {
+      NVHLS_ASSERT_MSG(num <= MaxN && num <= NumFilled(bidx), "Popping too much data from FIFO");
+      if (num != 0) rd_data[0] = pop(bidx);
+    }
+
+    inline DataType peek_at(T offset, BankIdx bidx = 0) {
+      NVHLS_ASSERT_MSG(offset == 0, "Peeking beyond the FIFO contents");
+      return peek(bidx);
+    }
+
+    inline bool isAlmostFull(unsigned int threshold, BankIdx bidx = 0) { return NumAvailable(bidx) <= threshold; }
+
+    inline bool isAlmostEmpty(unsigned int threshold, BankIdx bidx = 0) { return NumFilled(bidx) <= threshold; }
+
+    inline void push_multi(const DataType wr_data[NumBanks], BankMask mask) {
       #pragma hls_unroll yes
       for(unsigned i=0; i<NumBanks; i++) {
-        valid[i] = false;
+        if (mask[i]) {
+          push(wr_data[i], i);
+        }
       }
     }
+
+    inline void pop_multi(BankMask mask, DataType rd_data[NumBanks]) {
+      #pragma hls_unroll yes
+      for(unsigned i=0; i<NumBanks; i++) {
+        if (mask[i]) {
+          rd_data[i] = pop(i);
+        }
+      }
+    }
+
+    inline void peek_multi(BankMask mask, DataType rd_data[NumBanks]) {
+      #pragma hls_unroll yes
+      for(unsigned i=0; i<NumBanks; i++) {
+        if (mask[i]) {
+          rd_data[i] = peek(i);
+        }
+      }
+    }
+
+    inline void incrHead_multi(BankMask mask) {
+      #pragma hls_unroll yes
+      for(unsigned i=0; i<NumBanks; i++) {
+        if (mask[i]) {
+          incrHead(i);
+        }
+      }
+    }
+
+    inline BankMask isEmpty_multi() {
+      return ~valid;
+    }
+
+    inline BankMask isFull_multi() {
+      return valid;
+    }
+
+    inline void reset() {
+      valid = 0;
+    }
     template<unsigned int Size>
     void Marshall(Marshaller<Size>& m) {
       for (unsigned i = 0; i < NumBanks; i++) {
-        m & valid[i];
+        bool v = valid[i];
+        m & v;
+        valid[i] = v;
       }
       for (unsigned i = 0; i < NumBanks; i++) {
         m & data[i];
@@ -377,4 +759,85 @@ class FIFO<DataType, 1, NumBanks> {
     }
 };
 
+/**
+ * \brief FIFO with a zero-latency bypass path
+ * \ingroup FIFO
+ *
+ * \tparam DataType         DataType of entry in FIFO
+ * \tparam FifoLen          Length of FIFO, 0 for a plain wire
+ * \tparam NumBanks         Number of FIFO banks
+ * \tparam Storage          Storage policy, as in FIFO
+ *
+ * \par Overview
+ * A FIFO with every method of FIFO, plus transfer(), which pushes and pops
+ * one bank in the same call like the Connections BypassBuffered module does
+ * for ports:
+ * - The output is valid if the bank holds an entry or wr_valid is set. Its
+ *   data is the head entry, or wr_data when the bank is empty, so data
+ *   reaches the consumer in the call it arrives in instead of one later.
+ * - With rd_ready the output is consumed. Forwarded data is never written
+ *   to the storage, and a popped head frees its slot for wr_data.
+ * - wr_ready is set if the bank has room or its head is being consumed.
+ * Entries stay in order. Class-based pipelines can replace a FIFO between
+ * two stages with a BypassFIFO to save one cycle of latency per buffer.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <fifo.h>
+ *
+ *      ...
+ *      BypassFIFO<DataType, 2> buf;
+ *      ...
+ *      bool wr_ready;
+ *      DataType out;
+ *      bool out_valid = buf.transfer(in_valid, in, out_ready, out, wr_ready);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename DataType, unsigned int FifoLen, unsigned int NumBanks = 1,
+          typename Storage = FifoStorageRegFile>
+class BypassFIFO : public FIFO<DataType, FifoLen, NumBanks, Storage> {
+ public:
+  typedef FIFO<DataType, FifoLen, NumBanks, Storage> Base;
+
+  // Returns the output valid; rd_data holds the output and wr_ready
+  // whether wr_data was taken
+  bool transfer(bool wr_valid, const DataType& wr_data, bool rd_ready,
+                DataType& rd_data, bool& wr_ready, unsigned int bidx = 0) {
+    bool empty = Base::isEmpty(bidx);
+    bool rd_valid = !empty || wr_valid;
+    wr_ready = !Base::isFull(bidx) || (!empty && rd_ready);
+    if (!empty) {
+      rd_data = Base::peek(bidx);
+    } else {
+      rd_data = wr_data;
+    }
+    bool bypass = empty && wr_valid && rd_ready;
+    if (!empty && rd_ready) {
+      Base::incrHead(bidx);
+    }
+    if (wr_valid && wr_ready && !bypass) {
+      Base::push(wr_data, bidx);
+    }
+    return rd_valid;
+  }
+};
+
+/**
+ * \brief Specialization with no storage: transfer() is a wire
+ * \ingroup FIFO
+ */
+template <typename DataType, unsigned int NumBanks, typename Storage>
+class BypassFIFO<DataType, 0, NumBanks, Storage> : public FIFO<DataType, 0, NumBanks, Storage> {
+ public:
+  bool transfer(bool wr_valid, const DataType& wr_data, bool rd_ready,
+                DataType& rd_data, bool& wr_ready, unsigned int bidx = 0) {
+    rd_data = wr_data;
+    wr_ready = rd_ready;
+    return wr_valid;
+  }
+};
+
 #endif  // end #define FIFO_H macro
@@ -54,6 +54,7 @@
  * \def CDCOUT(x,y)
  * \ingroup DebugPrint
  * Debug print statements to print \a x if DEBUG_LEVEL set during compilation is greater than or equal to \a y. This is useful is we want to limit print statements during debugging. It is also enabled in SystemC/C++ simulation but disabled in HLS as they are non-synthesizable. 
+ * In simulation, \a x is also printed if the runtime debug level of the calling module is greater than or equal to \a y; these levels are set per module instance through the NVHLS_DEBUG environment variable (see match::DebugLevels). 
  * \par A Simple Example
  * \code
  *      #include <hls_globals.h>
@@ -69,9 +70,11 @@
    #define DCOUT(x) DISABLED_PRINT_STMT()
    #define CDCOUT(x,y) DISABLED_PRINT_STMT()
 #else
+   #include <nvhls_debug.h>
    #define DCOUT(x) cout << x
    #define CDCOUT(x,y) { \
       CTC_SKIP_CDCOUT \
-         if (DEBUG_LEVEL >= y) cout << x; \
+         if (DEBUG_LEVEL >= (y) || \
+             (match::DebugLevels::Active() && match::DebugLevels::Instance().Current() >= (y))) cout << x; \
       CTC_ENDSKIP_CDCOUT }
 #endif
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MATCHLIB_INSTANCES_H
+#define MATCHLIB_INSTANCES_H
+
+#include <nvhls_types.h>
+#include <fifo.h>
+#include <Arbiter.h>
+#include <mem_array.h>
+#include <axi/axi4.h>
+
+/**
+ * \brief Common template instances, compiled once by the cmod PCH build mode.
+ * \ingroup Build
+ *
+ * \par Overview
+ * MATCHLIB_INSTANCES(X) calls X once for each common instance of FIFO,
+ * Arbiter, mem_array_sep and the axi4 configs. With MATCHLIB_EXTERN_TEMPLATES
+ * defined, as in the PCH build mode, each instance is declared extern, so the
+ * designs do not instantiate and compile its members again.
+ * matchlib_instances.cpp holds the explicit instantiations, and pch_Makefile
+ * compiles it once per set of compile flags.
+ *
+ * Other instances are instantiated implicitly as usual. Adding an instance
+ * here only pays off when many designs use it.
+ *
+ */
+#define MATCHLIB_INSTANCES(X)                   \
+  X(FIFO<NVUINT8, 2>)                           \
+  X(FIFO<NVUINT8, 4>)                           \
+  X(FIFO<NVUINT8, 8>)                           \
+  X(FIFO<NVUINT16, 2>)                          \
+  X(FIFO<NVUINT16, 4>)                          \
+  X(FIFO<NVUINT16, 8>)                          \
+  X(FIFO<NVUINT32, 2>)                          \
+  X(FIFO<NVUINT32, 4>)                          \
+  X(FIFO<NVUINT32, 8>)                          \
+  X(FIFO<NVUINT64, 2>)                          \
+  X(FIFO<NVUINT64, 4>)                          \
+  X(FIFO<NVUINT64, 8>)                          \
+  X(Arbiter<2, Roundrobin>)                     \
+  X(Arbiter<4, Roundrobin>)                     \
+  X(Arbiter<8, Roundrobin>)                     \
+  X(Arbiter<16, Roundrobin>)                    \
+  X(Arbiter<4, RoundrobinPrefix>)               \
+  X(Arbiter<8, RoundrobinPrefix>)               \
+  X(Arbiter<16, RoundrobinPrefix>)              \
+  X(mem_array_sep<NVUINT32, 256, 1>)            \
+  X(mem_array_sep<NVUINT32, 1024, 4>)           \
+  X(mem_array_sep<NVUINT64, 1024, 1>)           \
+  X(mem_array_sep<NVUINT64, 1024, 8>)           \
+  X(axi::axi4<axi::cfg::standard>)              \
+  X(axi::axi4<axi::cfg::no_wresp>)              \
+  X(axi::axi4<axi::cfg::no_wstrb>)              \
+  X(axi::axi4<axi::cfg::lite>)
+
+#define MATCHLIB_EXTERN_INSTANCE(...) extern template class __VA_ARGS__;
+#define MATCHLIB_INSTANTIATE(...) template class __VA_ARGS__;
+
+#if defined(MATCHLIB_EXTERN_TEMPLATES) && !defined(__SYNTHESIS__)
+MATCHLIB_INSTANCES(MATCHLIB_EXTERN_INSTANCE)
+#endif
+
+#endif  // MATCHLIB_INSTANCES_H
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MATCHLIB_PCH_H
+#define MATCHLIB_PCH_H
+
+/**
+ * \brief Common headers precompiled by the cmod PCH build mode.
+ * \ingroup Build
+ *
+ * \par Overview
+ * With PCH=1 (see cmod/pch_Makefile), this header is precompiled once per set
+ * of compile flags and force-included in every C++ simulation, so SystemC,
+ * Connections and the boost preprocessor are parsed once rather than in every
+ * design. Only headers that do not depend on macros defined by the designs
+ * belong here. nvhls_verify.h in particular must stay out, since it re-includes
+ * itself for each NVHLS_VERIFY_BLOCKS entry of the design that includes it.
+ *
+ * The PCH build mode also defines MATCHLIB_EXTERN_TEMPLATES, which declares
+ * the common template instances of matchlib_instances.h as extern, so the
+ * designs link them from one precompiled object.
+ *
+ * \par A Simple Example
+ * \code
+ *      cd cmod/unittests/FifoTop
+ *      make PCH=1
+ *
+ *      # or for the whole regression
+ *      cd cmod
+ *      make -f regress_Makefile PCH=1
+ * \endcode
+ * \par
+ *
+ */
+
+#include <systemc.h>
+#ifndef __SYNTHESIS__
+#include <boost/preprocessor.hpp>
+#endif
+
+#include <hls_globals.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_message.h>
+#include <nvhls_connections.h>
+#include <matchlib_instances.h>
+
+#endif  // MATCHLIB_PCH_H
@@ -21,6 +21,40 @@
 #include <nvhls_array.h>
 #include <nvhls_marshaller.h>
 #include <TypeToBits.h>
+#include <nvhls_activity_stats.h>
+#ifndef __SYNTHESIS__
+#include <type_traits>
+#include <vector>
+#include <string>
+#include <mem_array_image.h>
+#endif
+
+/**
+ * \brief MEM_ARRAY_USE_SC_LV define: Keep sc_lv storage in C simulation.
+ * \ingroup MemArray
+ *
+ * In C simulation mem_array_sep and mem_array_opt store each entry as a packed
+ * NVUINTW word plus one valid bit per byte enable, which avoids the sc_lv
+ * slicing and Marshaller round trips of the synthesis view. Defining
+ * MEM_ARRAY_USE_SC_LV selects the sc_lv storage used for synthesis instead, for
+ * example to track X values inside partially initialized slices.
+ */
+#if !defined(__SYNTHESIS__) && !defined(MEM_ARRAY_USE_SC_LV)
+#define MEM_ARRAY_SIM_STORAGE
+#endif
+
+/**
+ * \brief MEM_ARRAY_SPARSE_MIN_BYTES define: Size above which C-simulation storage is sparse.
+ * \ingroup MemArray
+ *
+ * Memories whose contents take at least this many bytes allocate their
+ * C-simulation storage in 4KB pages on first write instead of up front.
+ * Set it to 0 to make every memory sparse. It has no effect on synthesis or
+ * when MEM_ARRAY_USE_SC_LV is defined.
+ */
+#ifndef MEM_ARRAY_SPARSE_MIN_BYTES
+#define MEM_ARRAY_SPARSE_MIN_BYTES (1 << 20)
+#endif
 
 // T: data type
 // N: number of lines
@@ -38,21 +72,450 @@ class mem_array {
   }
 };
 
-// T: data type
-// N: number of lines
-// A: associativity
+/**
+ * \brief Set-associative array with all-ways access
+ * \ingroup MemArray
+ *
+ * \tparam T                Datatype of an entry, for example a tag
+ * \tparam N                Number of entries
+ * \tparam A                Associativity (ways per set)
+ *
+ * \par Overview
+ * data[set][way] holds N/A sets of A ways. read_set() returns every way of a
+ * set at once and compare() their hit vector against a key, which PriEnc
+ * turns into the hit way. write_ways() writes the ways selected by a per-way
+ * enable mask in one access. The ways of a set are separate registers or
+ * banks, so all of them are accessed in the same cycle.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <mem_array.h>
+ *      #include <comptrees.h>
+ *        ...
+ *        mem_array_2d<Tag_t, NUM_LINES, NUM_WAYS> tags;
+ *
+ *        NVUINTW(NUM_WAYS) hits = tags.compare(set, tag) & valid[set];
+ *        WayIdx_t hit_way = PriEnc<NVUINTW(NUM_WAYS), bool, WayIdx_t, NUM_WAYS>::val(hits, 1);
+ *
+ *        tags.write(set, victim_way, tag);
+ * \endcode
+ * \par
+ *
+ */
 template <typename T, int N, int A>
 class mem_array_2d {
  public:
+  static const int NumSets = N / A;
+  typedef NVUINTW(nvhls::index_width<NumSets>::val) SetIndex;
+  typedef NVUINTW(nvhls::index_width<A>::val) WayIndex;
+  typedef NVUINTW(A) WayMask;
+
   T data[N / A][A];
+
+  T read(SetIndex set, WayIndex way) const {
+    NVHLS_ASSERT_MSG(set < NumSets, "set index out of bounds");
+    NVHLS_ASSERT_MSG(way < A, "way index out of bounds");
+    return data[set][way];
+  }
+
+  void write(SetIndex set, WayIndex way, const T& val) {
+    NVHLS_ASSERT_MSG(set < NumSets, "set index out of bounds");
+    NVHLS_ASSERT_MSG(way < A, "way index out of bounds");
+    data[set][way] = val;
+  }
+
+  // All ways of a set in parallel
+  void read_set(SetIndex set, T (&ways)[A]) const {
+    NVHLS_ASSERT_MSG(set < NumSets, "set index out of bounds");
+    #pragma hls_unroll yes
+    for (int w = 0; w < A; w++) {
+      ways[w] = data[set][w];
+    }
+  }
+
+  // Writes way w of a set to vals[w] where way_en[w] is set
+  void write_ways(SetIndex set, WayMask way_en, const T (&vals)[A]) {
+    NVHLS_ASSERT_MSG(set < NumSets, "set index out of bounds");
+    #pragma hls_unroll yes
+    for (int w = 0; w < A; w++) {
+      if (way_en[w] == 1) {
+        data[set][w] = vals[w];
+      }
+    }
+  }
+
+  // Writes val to the ways of a set where way_en is set
+  void write_ways(SetIndex set, WayMask way_en, const T& val) {
+    NVHLS_ASSERT_MSG(set < NumSets, "set index out of bounds");
+    #pragma hls_unroll yes
+    for (int w = 0; w < A; w++) {
+      if (way_en[w] == 1) {
+        data[set][w] = val;
+      }
+    }
+  }
+
+  // Bit w is set when way w of the set equals key
+  WayMask compare(SetIndex set, const T& key) const {
+    NVHLS_ASSERT_MSG(set < NumSets, "set index out of bounds");
+    WayMask hits = 0;
+    #pragma hls_unroll yes
+    for (int w = 0; w < A; w++) {
+      hits[w] = (data[set][w] == key);
+    }
+    return hits;
+  }
 };
 
+/**
+ * \brief Banked transpose buffer: write rows, read columns
+ * \ingroup MemArray
+ *
+ * \tparam T                Datatype of an element
+ * \tparam N                Number of elements
+ * \tparam A                Number of columns, and of banks
+ *
+ * \par Overview
+ * Holds a matrix of N/A rows of A elements in A banks, data[bank][row].
+ * Element (row, col) is stored in bank (row + col) % A, so the A elements of
+ * a row, and A consecutive rows of a column, fall in A different banks: a
+ * full row is written, and A elements of a column are read, with one access
+ * per bank, without bank conflicts. With A rows (N = A * A), a tile is
+ * transposed at one row per cycle.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <mem_array.h>
+ *        ...
+ *        mem_array_2d_transp<Elem_t, TILE * TILE, TILE> tile;
+ *
+ *        tile.write_row(r, row);        // one row per cycle
+ *        ...
+ *        tile.read_col(c, 0, col);      // one column per cycle
+ * \endcode
+ * \par
+ *
+ */
 template <typename T, int N, int A>
 class mem_array_2d_transp {
  public:
+  static const int NumRows = N / A;
+  static const int NumCols = A;
+  typedef NVUINTW(nvhls::index_width<NumRows>::val) RowIndex;
+  typedef NVUINTW(nvhls::index_width<A>::val) ColIndex;
+
   T data[A][N / A];
+
+  // Bank of element (row, col)
+  static unsigned bank(unsigned row, unsigned col) {
+    unsigned b = (row % A) + col;
+    return b >= static_cast<unsigned>(A) ? b - A : b;
+  }
+
+  T read(RowIndex row, ColIndex col) const {
+    NVHLS_ASSERT_MSG(row < NumRows, "row index out of bounds");
+    NVHLS_ASSERT_MSG(col < A, "column index out of bounds");
+    return data[bank(row, col)][row];
+  }
+
+  void write(RowIndex row, ColIndex col, const T& val) {
+    NVHLS_ASSERT_MSG(row < NumRows, "row index out of bounds");
+    NVHLS_ASSERT_MSG(col < A, "column index out of bounds");
+    data[bank(row, col)][row] = val;
+  }
+
+  // A full row, one element per bank
+  void write_row(RowIndex row, const T (&vals)[A]) {
+    NVHLS_ASSERT_MSG(row < NumRows, "row index out of bounds");
+    #pragma hls_unroll yes
+    for (int c = 0; c < A; c++) {
+      data[bank(row, c)][row] = vals[c];
+    }
+  }
+
+  void read_row(RowIndex row, T (&vals)[A]) const {
+    NVHLS_ASSERT_MSG(row < NumRows, "row index out of bounds");
+    #pragma hls_unroll yes
+    for (int c = 0; c < A; c++) {
+      vals[c] = data[bank(row, c)][row];
+    }
+  }
+
+  // vals[i] = element (row_base + i, col), one element per bank
+  void read_col(ColIndex col, RowIndex row_base, T (&vals)[A]) const {
+    NVHLS_ASSERT_MSG(col < A, "column index out of bounds");
+    NVHLS_ASSERT_MSG(row_base + A <= NumRows, "column read out of bounds");
+    #pragma hls_unroll yes
+    for (int i = 0; i < A; i++) {
+      vals[i] = data[bank(row_base + i, col)][row_base + i];
+    }
+  }
+
+  // Element (row_base + i, col) = vals[i], one element per bank
+  void write_col(ColIndex col, RowIndex row_base, const T (&vals)[A]) {
+    NVHLS_ASSERT_MSG(col < A, "column index out of bounds");
+    NVHLS_ASSERT_MSG(row_base + A <= NumRows, "column write out of bounds");
+    #pragma hls_unroll yes
+    for (int i = 0; i < A; i++) {
+      data[bank(row_base + i, col)][row_base + i] = vals[i];
+    }
+  }
+};
+
+#ifdef MEM_ARRAY_SIM_STORAGE
+namespace nvhls {
+
+// Conversion between T and its packed bit representation. Types that already
+// are a W-bit nvuint/nvint are copied directly; all other types go through the
+// Marshaller.
+template <typename T, unsigned int W,
+          bool IsWord = std::is_same<T, NVUINTW(W)>::value ||
+                        std::is_same<T, NVINTW(W)>::value>
+struct mem_array_word_cast {
+  static NVUINTW(W) to_word(const T& val) { return TypeToNVUINT<T>(val); }
+  static T from_word(const NVUINTW(W)& word) { return NVUINTToType<T>(word); }
+};
+
+template <typename T, unsigned int W>
+struct mem_array_word_cast<T, W, true> {
+  static NVUINTW(W) to_word(const T& val) { return val; }
+  static T from_word(const NVUINTW(W)& word) { return word; }
+};
+
+// Dense store: every entry is allocated up front.
+template <typename Word_t, typename Mask_t, unsigned int NumEntries>
+class mem_array_dense_store {
+ public:
+  Word_t data[NumEntries];
+  Mask_t valid[NumEntries];
+
+  mem_array_dense_store() {
+    for (unsigned i = 0; i < NumEntries; i++) {
+      data[i] = 0;
+      valid[i] = 0;
+    }
+  }
+
+  void clear(Mask_t all_valid) {
+    for (unsigned i = 0; i < NumEntries; i++) {
+      data[i] = 0;
+      valid[i] = all_valid;
+    }
+  }
+
+  Word_t get(unsigned entry) const { return data[entry]; }
+  Mask_t get_valid(unsigned entry) const { return valid[entry]; }
+  Word_t& ref(unsigned entry) { return data[entry]; }
+  Mask_t& ref_valid(unsigned entry) { return valid[entry]; }
+  unsigned num_allocated_entries() const { return NumEntries; }
+};
+
+// Paged store: pages covering 4KB of memory contents are allocated on first
+// write. Entries of pages that were never written read back as 0 with the
+// default valid bits (none before clear(), all after).
+template <typename Word_t, typename Mask_t, unsigned int NumEntries,
+          unsigned int EntriesPerPage>
+class mem_array_paged_store {
+ public:
+  static const unsigned int NumPages =
+      (NumEntries + EntriesPerPage - 1) / EntriesPerPage;
+
+  struct Page {
+    Word_t data[EntriesPerPage];
+    Mask_t valid[EntriesPerPage];
+  };
+
+  mem_array_paged_store() : pages(NumPages, static_cast<Page*>(NULL)), default_valid(0) {}
+
+  mem_array_paged_store(const mem_array_paged_store& other)
+      : pages(NumPages, static_cast<Page*>(NULL)) {
+    *this = other;
+  }
+
+  mem_array_paged_store& operator=(const mem_array_paged_store& other) {
+    if (this != &other) {
+      release();
+      default_valid = other.default_valid;
+      for (unsigned i = 0; i < NumPages; i++) {
+        if (other.pages[i] != NULL) {
+          pages[i] = new Page(*other.pages[i]);
+        }
+      }
+    }
+    return *this;
+  }
+
+  ~mem_array_paged_store() { release(); }
+
+  void clear(Mask_t all_valid) {
+    release();
+    default_valid = all_valid;
+  }
+
+  Word_t get(unsigned entry) const {
+    const Page* page = pages[entry / EntriesPerPage];
+    return (page != NULL) ? page->data[entry % EntriesPerPage] : Word_t(0);
+  }
+  Mask_t get_valid(unsigned entry) const {
+    const Page* page = pages[entry / EntriesPerPage];
+    return (page != NULL) ? page->valid[entry % EntriesPerPage] : default_valid;
+  }
+  Word_t& ref(unsigned entry) {
+    return touch(entry)->data[entry % EntriesPerPage];
+  }
+  Mask_t& ref_valid(unsigned entry) {
+    return touch(entry)->valid[entry % EntriesPerPage];
+  }
+  unsigned num_allocated_entries() const {
+    unsigned count = 0;
+    for (unsigned i = 0; i < NumPages; i++) {
+      if (pages[i] != NULL) {
+        count += EntriesPerPage;
+      }
+    }
+    return count;
+  }
+
+ protected:
+  std::vector<Page*> pages;
+  Mask_t default_valid;
+
+  Page* touch(unsigned entry) {
+    Page*& page = pages[entry / EntriesPerPage];
+    if (page == NULL) {
+      page = new Page;
+      for (unsigned i = 0; i < EntriesPerPage; i++) {
+        page->data[i] = 0;
+        page->valid[i] = default_valid;
+      }
+    }
+    return page;
+  }
+
+  void release() {
+    for (unsigned i = 0; i < NumPages; i++) {
+      delete pages[i];
+      pages[i] = NULL;
+    }
+  }
 };
 
+/**
+ * \brief C-simulation storage backend of mem_array_sep and mem_array_opt
+ * \ingroup MemArray
+ *
+ * \tparam T                       Datatype of an entry to be stored in memory
+ * \tparam NumEntriesPerBank       Number of entries per bank in memory
+ * \tparam NumBanks                Number of banks in memory
+ * \tparam NumByteEnables          Number of byte enables per entry
+ * \tparam Sparse                  Allocate storage in 4KB pages on first write
+ *                                 (default: memories of at least
+ *                                 MEM_ARRAY_SPARSE_MIN_BYTES)
+ *
+ * \par Overview
+ * - Each entry is kept as a packed NVUINTW word. Byte-enable masking is done
+ *   with bitwise operations on the whole word.
+ * - One valid bit per byte enable replaces the X values of sc_lv storage, so
+ *   reads of never-written slices still fail with "Read data is X".
+ * - Large memories use a paged store, so only the pages that were written
+ *   take up host memory.
+ * - Only used when MEM_ARRAY_SIM_STORAGE is defined, i.e. never in synthesis.
+ */
+template <typename T, int NumEntriesPerBank, int NumBanks, int NumByteEnables,
+          bool Sparse = (static_cast<unsigned long long>(NumEntriesPerBank) * NumBanks *
+                         Wrapped<T>::width >= 8ULL * MEM_ARRAY_SPARSE_MIN_BYTES)>
+class mem_array_sim_storage {
+ public:
+  static const unsigned int NumEntries = NumEntriesPerBank * NumBanks;
+  static const unsigned int WordWidth = Wrapped<T>::width;
+  static const unsigned int SliceWidth = WordWidth / NumByteEnables;
+  static const unsigned int EntriesPerPage =
+      (WordWidth >= 32768) ? 1 : 32768 / WordWidth;
+  typedef NVUINTW(WordWidth) Word_t;
+  typedef NVUINTW(SliceWidth) SliceWord_t;
+  typedef NVUINTW(NumByteEnables) WriteMask;
+  typedef mem_array_word_cast<T, WordWidth> Cast;
+  typedef typename std::conditional<
+      Sparse, mem_array_paged_store<Word_t, WriteMask, NumEntries, EntriesPerPage>,
+      mem_array_dense_store<Word_t, WriteMask, NumEntries> >::type Store;
+  static const int width = NumEntries * NumByteEnables * SliceWidth;
+
+  Store store;
+
+  void clear() { store.clear(~static_cast<WriteMask>(0)); }
+
+  // Bit mask covering every slice whose byte enable is set
+  static Word_t ExpandMask(WriteMask mask) {
+    Word_t bit_mask = 0;
+    if (NumByteEnables == 1) {
+      if (mask[0] == 1) {
+        bit_mask = ~bit_mask;
+      }
+      return bit_mask;
+    }
+    SliceWord_t slice_ones = ~static_cast<SliceWord_t>(0);
+    for (int i = 0; i < NumByteEnables; i++) {
+      if (mask[i] == 1) {
+        bit_mask = nvhls::set_slc(bit_mask, slice_ones, i * SliceWidth);
+      }
+    }
+    return bit_mask;
+  }
+
+  T read(unsigned entry, WriteMask read_mask) const {
+    CMOD_ASSERT_MSG((store.get_valid(entry) & read_mask) == read_mask, "Read data is X");
+    if (NumByteEnables == 1 && read_mask[0] == 1) {
+      return Cast::from_word(store.get(entry));
+    }
+    return Cast::from_word(store.get(entry) & ExpandMask(read_mask));
+  }
+
+  void write(unsigned entry, const T& val, WriteMask write_mask) {
+    Word_t write_data = Cast::to_word(val);
+    if (NumByteEnables == 1) {
+      if (write_mask[0] == 1) {
+        store.ref(entry) = write_data;
+        store.ref_valid(entry) = 1;
+      }
+      return;
+    }
+    Word_t bit_mask = ExpandMask(write_mask);
+    Word_t& data = store.ref(entry);
+    data = (data & ~bit_mask) | (write_data & bit_mask);
+    store.ref_valid(entry) |= write_mask;
+  }
+
+  // Raw word with never-written slices read as 0, for image dumps
+  Word_t peek(unsigned entry) const {
+    return store.get(entry) & ExpandMask(store.get_valid(entry));
+  }
+
+  // Overwrites a whole entry and marks it initialized, for image loads
+  void poke(unsigned entry, const Word_t& data) {
+    store.ref(entry) = data;
+    store.ref_valid(entry) = ~static_cast<WriteMask>(0);
+  }
+
+  // Marshalls slice by slice to match the layout of the sc_lv storage.
+  // Slices passed through the Marshaller are treated as initialized.
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    for (unsigned i = 0; i < NumEntries; i++) {
+      Word_t data = store.get(i);
+      for (int j = 0; j < NumByteEnables; j++) {
+        SliceWord_t slice = nvhls::get_slc<SliceWidth>(data, j * SliceWidth);
+        m& slice;
+        data = nvhls::set_slc(data, slice, j * SliceWidth);
+      }
+      store.ref(i) = data;
+      store.ref_valid(i) = ~static_cast<WriteMask>(0);
+    }
+  }
+};
+
+}  // namespace nvhls
+#endif
+
 /**
  * \brief Abstract Memory Class 
  * \ingroup MemArray
@@ -71,6 +534,14 @@ class mem_array_2d_transp {
  *        read_data = banks.read(bank_addr, bank_sel);
  *
  *        banks.write(bank_addr, bank_sel, write_data);
+ *
+ *        // Burst of len entries into/from an array of up to 16 entries
+ *        banks.read_burst(bank_addr, bank_sel, len, read_burst_data);
+ *        banks.write_burst(bank_addr, bank_sel, len, write_burst_data);
+ *
+ *        // C simulation only: preload or save the contents as a raw image
+ *        banks.load_image("init.bin");
+ *        banks.dump_image("final.bin");
  *        ...
  *      
  *
@@ -95,9 +566,39 @@ class mem_array_sep {
   typedef NVUINTW(nvhls::index_width<NumByteEnables>::val) ByteEnableIndex;
 
   typedef Slice_t BankType[NumEntriesPerBank*NumByteEnables];
+#ifdef MEM_ARRAY_SIM_STORAGE
+  nvhls::mem_array_sim_storage<T, NumEntriesPerBank, NumBanks, NumByteEnables> bank;
+#else
   nvhls::nv_array<BankType, NumBanks> bank;
+#endif
   static const int width =  NumEntries * WordWidth;
 
+#ifdef MEM_ARRAY_SIM_STORAGE
+  mem_array_sep() {}
+
+  void clear() { bank.clear(); }
+
+  T read(LocalIndex idx, BankIndex bank_sel=0, WriteMask read_mask=~static_cast<WriteMask>(0)) {
+    NVHLS_ASSERT_MSG(bank_sel<NumBanks, "bank index out of bounds");
+    NVHLS_ASSERT_MSG(idx<NumEntriesPerBank, "local index out of bounds");
+    activity_.Read(bank_sel);
+    return bank.read(bank_sel * NumEntriesPerBank + idx, read_mask);
+  }
+
+  void write(LocalIndex idx, BankIndex bank_sel, const T& val, WriteMask write_mask=~static_cast<WriteMask>(0), bool wce=1) {
+    if (wce) {
+      NVHLS_ASSERT_MSG(bank_sel<NumBanks, "bank index out of bounds");
+      NVHLS_ASSERT_MSG(idx<NumEntriesPerBank, "local index out of bounds");
+      activity_.Write(bank_sel);
+      bank.write(bank_sel * NumEntriesPerBank + idx, val, write_mask);
+    }
+  }
+
+  template<unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    bank.Marshall(m);
+  }
+#else
   mem_array_sep() {
     Slice_t value;
     for (unsigned i = 0; i < NumBanks; i++) {
@@ -134,10 +635,13 @@ class mem_array_sep {
 #endif
     }
     CMOD_ASSERT_MSG(read_data.xor_reduce()!=sc_logic('X'), "Read data is X");
+#ifndef __SYNTHESIS__
+    activity_.Read(bank_sel);
+#endif
     return BitsToType<T>(read_data);
   }
 
-  void write(LocalIndex idx, BankIndex bank_sel, T val, WriteMask write_mask=~static_cast<WriteMask>(0), bool wce=1) {
+  void write(LocalIndex idx, BankIndex bank_sel, const T& val, WriteMask write_mask=~static_cast<WriteMask>(0), bool wce=1) {
     Slice_t tmp[NumByteEnables];
     Data_t write_data = TypeToBits<T>(val);
     #pragma hls_unroll yes
@@ -145,6 +649,9 @@ class mem_array_sep {
       tmp[i] = write_data.range((i+1)*SliceWidth-1, i*SliceWidth);
     }
     if (wce) {
+#ifndef __SYNTHESIS__
+      activity_.Write(bank_sel);
+#endif
       #pragma hls_unroll yes
       for (int i = 0; i < NumByteEnables; i++) {
         if (write_mask[i] == 1) {
@@ -166,6 +673,124 @@ class mem_array_sep {
       }
     }
   }
+#endif
+
+  /**
+   * \brief Read len entries starting at idx, stride entries apart, into data.
+   *
+   * Bounds are checked once per burst. The loop is fully unrolled over
+   * MaxLen, so HLS sees a fixed-length access pattern that can be pipelined.
+   */
+  template <int MaxLen>
+  void read_burst(LocalIndex idx, BankIndex bank_sel,
+                  NVUINTW(nvhls::index_width<MaxLen+1>::val) len, T (&data)[MaxLen],
+                  LocalIndex stride=1, WriteMask read_mask=~static_cast<WriteMask>(0)) {
+    NVHLS_ASSERT_MSG(bank_sel<NumBanks, "bank index out of bounds");
+    NVHLS_ASSERT_MSG(len<=MaxLen, "burst length out of bounds");
+    NVHLS_ASSERT_MSG(len==0 || idx + (len-1)*stride < NumEntriesPerBank, "burst index out of bounds");
+#ifdef MEM_ARRAY_SIM_STORAGE
+    unsigned entry = bank_sel * NumEntriesPerBank + idx;
+    activity_.Read(bank_sel, len);
+    for (unsigned i = 0; i < len; i++, entry += stride) {
+      data[i] = bank.read(entry, read_mask);
+    }
+#else
+    #pragma hls_unroll yes
+    for (int i = 0; i < MaxLen; i++) {
+      if (i < len) {
+        data[i] = read(idx + i*stride, bank_sel, read_mask);
+      }
+    }
+#endif
+  }
+
+  /**
+   * \brief Write len entries from data starting at idx, stride entries apart.
+   */
+  template <int MaxLen>
+  void write_burst(LocalIndex idx, BankIndex bank_sel,
+                   NVUINTW(nvhls::index_width<MaxLen+1>::val) len, const T (&data)[MaxLen],
+                   LocalIndex stride=1, WriteMask write_mask=~static_cast<WriteMask>(0)) {
+    NVHLS_ASSERT_MSG(bank_sel<NumBanks, "bank index out of bounds");
+    NVHLS_ASSERT_MSG(len<=MaxLen, "burst length out of bounds");
+    NVHLS_ASSERT_MSG(len==0 || idx + (len-1)*stride < NumEntriesPerBank, "burst index out of bounds");
+#ifdef MEM_ARRAY_SIM_STORAGE
+    unsigned entry = bank_sel * NumEntriesPerBank + idx;
+    activity_.Write(bank_sel, len);
+    for (unsigned i = 0; i < len; i++, entry += stride) {
+      bank.write(entry, data[i], write_mask);
+    }
+#else
+    #pragma hls_unroll yes
+    for (int i = 0; i < MaxLen; i++) {
+      if (i < len) {
+        write(idx + i*stride, bank_sel, data[i], write_mask);
+      }
+    }
+#endif
+  }
+
+#ifndef __SYNTHESIS__
+  /**
+   * \brief Reads and writes per bank, counted once registered with
+   * match::Module::RegisterActivityStats() (C-sim only).
+   */
+  match::ActivityStats& Stats() { return activity_; }
+
+  /**
+   * \brief Raw entry bits, with never-written slices read as 0 (C-sim only).
+   */
+  NVUINTW(WordWidth) peek_word(unsigned idx, unsigned bank_sel) const {
+#ifdef MEM_ARRAY_SIM_STORAGE
+    return bank.peek(bank_sel * NumEntriesPerBank + idx);
+#else
+    Data_t data = TypeToBits<NVUINTW(WordWidth)>(0);
+    for (int i = 0; i < NumByteEnables; i++) {
+      const Slice_t& slice = bank[bank_sel][idx * NumByteEnables + i];
+      if (slice.xor_reduce() != sc_logic('X')) {
+        data.range((i+1)*SliceWidth-1, i*SliceWidth) = slice;
+      }
+    }
+    return BitsToType<NVUINTW(WordWidth)>(data);
+#endif
+  }
+
+  /**
+   * \brief Overwrite all slices of an entry with raw bits (C-sim only).
+   */
+  void poke_word(unsigned idx, unsigned bank_sel, const NVUINTW(WordWidth)& word) {
+#ifdef MEM_ARRAY_SIM_STORAGE
+    bank.poke(bank_sel * NumEntriesPerBank + idx, word);
+#else
+    Data_t data = TypeToBits<NVUINTW(WordWidth)>(word);
+    for (int i = 0; i < NumByteEnables; i++) {
+      bank[bank_sel][idx * NumByteEnables + i] = data.range((i+1)*SliceWidth-1, i*SliceWidth);
+    }
+#endif
+  }
+
+  /**
+   * \brief Fill the memory from a raw binary image (C-sim only).
+   *
+   * The file is memory-mapped and copied straight into the backing store. See
+   * nvhls::mem_array_image for the image layout; striped interleaves
+   * consecutive image entries across banks. Returns false if the file cannot
+   * be mapped.
+   */
+  bool load_image(const std::string& filename, bool striped=false) {
+    return nvhls::mem_array_image<WordWidth, NumEntriesPerBank, NumBanks>::Load(*this, filename, striped);
+  }
+
+  /**
+   * \brief Write the memory contents to a raw binary image (C-sim only).
+   */
+  bool dump_image(const std::string& filename, bool striped=false) const {
+    return nvhls::mem_array_image<WordWidth, NumEntriesPerBank, NumBanks>::Dump(*this, filename, striped);
+  }
+
+ private:
+  match::ActivityStats activity_;
+#endif
 };
 
 /**
@@ -211,10 +836,38 @@ class mem_array_opt {
   typedef NVUINTW(nvhls::index_width<NumByteEnables>::val) ByteEnableIndex;
 
   typedef Slice_t BankType[NumEntriesPerBank*NumByteEnables];
+#ifdef MEM_ARRAY_SIM_STORAGE
+  nvhls::mem_array_sim_storage<T, NumEntriesPerBank, NumBanks, NumByteEnables> bank;
+#else
   #pragma hls_block_size NumEntriesPerBank
   BankType bank[NumBanks];
+#endif
   static const int width =  NumEntries * WordWidth;
 
+#ifdef MEM_ARRAY_SIM_STORAGE
+  mem_array_opt() {}
+
+  void clear() { bank.clear(); }
+
+  T read(LocalIndex idx, BankIndex bank_sel=0, WriteMask read_mask=~static_cast<WriteMask>(0)) {
+    NVHLS_ASSERT_MSG(bank_sel<NumBanks, "bank index out of bounds");
+    NVHLS_ASSERT_MSG(idx<NumEntriesPerBank, "local index out of bounds");
+    return bank.read(bank_sel * NumEntriesPerBank + idx, read_mask);
+  }
+
+  void write(LocalIndex idx, BankIndex bank_sel, const T& val, WriteMask write_mask=~static_cast<WriteMask>(0), bool wce=1) {
+    if (wce) {
+      NVHLS_ASSERT_MSG(bank_sel<NumBanks, "bank index out of bounds");
+      NVHLS_ASSERT_MSG(idx<NumEntriesPerBank, "local index out of bounds");
+      bank.write(bank_sel * NumEntriesPerBank + idx, val, write_mask);
+    }
+  }
+
+  template<unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    bank.Marshall(m);
+  }
+#else
   mem_array_opt() {
     Slice_t value;
     for (unsigned i = 0; i < NumBanks; i++) {
@@ -260,7 +913,7 @@ class mem_array_opt {
     return BitsToType<T>(read_data);
   }
 
-  void write(LocalIndex idx, BankIndex bank_sel, T val, WriteMask write_mask=~static_cast<WriteMask>(0), bool wce=1) {
+  void write(LocalIndex idx, BankIndex bank_sel, const T& val, WriteMask write_mask=~static_cast<WriteMask>(0), bool wce=1) {
     Slice_t tmp[NumByteEnables];
     Data_t write_data = TypeToBits<T>(val);
     #pragma hls_unroll yes
@@ -289,7 +942,229 @@ class mem_array_opt {
       }
     }
   }
+#endif
+
+  /**
+   * \brief Read len entries starting at idx, stride entries apart, into data.
+   *
+   * Bounds are checked once per burst. The loop is fully unrolled over
+   * MaxLen, so HLS sees a fixed-length access pattern that can be pipelined.
+   */
+  template <int MaxLen>
+  void read_burst(LocalIndex idx, BankIndex bank_sel,
+                  NVUINTW(nvhls::index_width<MaxLen+1>::val) len, T (&data)[MaxLen],
+                  LocalIndex stride=1, WriteMask read_mask=~static_cast<WriteMask>(0)) {
+    NVHLS_ASSERT_MSG(bank_sel<NumBanks, "bank index out of bounds");
+    NVHLS_ASSERT_MSG(len<=MaxLen, "burst length out of bounds");
+    NVHLS_ASSERT_MSG(len==0 || idx + (len-1)*stride < NumEntriesPerBank, "burst index out of bounds");
+#ifdef MEM_ARRAY_SIM_STORAGE
+    unsigned entry = bank_sel * NumEntriesPerBank + idx;
+    for (unsigned i = 0; i < len; i++, entry += stride) {
+      data[i] = bank.read(entry, read_mask);
+    }
+#else
+    #pragma hls_unroll yes
+    for (int i = 0; i < MaxLen; i++) {
+      if (i < len) {
+        data[i] = read(idx + i*stride, bank_sel, read_mask);
+      }
+    }
+#endif
+  }
+
+  /**
+   * \brief Write len entries from data starting at idx, stride entries apart.
+   */
+  template <int MaxLen>
+  void write_burst(LocalIndex idx, BankIndex bank_sel,
+                   NVUINTW(nvhls::index_width<MaxLen+1>::val) len, const T (&data)[MaxLen],
+                   LocalIndex stride=1, WriteMask write_mask=~static_cast<WriteMask>(0)) {
+    NVHLS_ASSERT_MSG(bank_sel<NumBanks, "bank index out of bounds");
+    NVHLS_ASSERT_MSG(len<=MaxLen, "burst length out of bounds");
+    NVHLS_ASSERT_MSG(len==0 || idx + (len-1)*stride < NumEntriesPerBank, "burst index out of bounds");
+#ifdef MEM_ARRAY_SIM_STORAGE
+    unsigned entry = bank_sel * NumEntriesPerBank + idx;
+    for (unsigned i = 0; i < len; i++, entry += stride) {
+      bank.write(entry, data[i], write_mask);
+    }
+#else
+    #pragma hls_unroll yes
+    for (int i = 0; i < MaxLen; i++) {
+      if (i < len) {
+        write(idx + i*stride, bank_sel, data[i], write_mask);
+      }
+    }
+#endif
+  }
+
+#ifndef __SYNTHESIS__
+  /**
+   * \brief Raw entry bits, with never-written slices read as 0 (C-sim only).
+   */
+  NVUINTW(WordWidth) peek_word(unsigned idx, unsigned bank_sel) const {
+#ifdef MEM_ARRAY_SIM_STORAGE
+    return bank.peek(bank_sel * NumEntriesPerBank + idx);
+#else
+    Data_t data = TypeToBits<NVUINTW(WordWidth)>(0);
+    for (int i = 0; i < NumByteEnables; i++) {
+      const Slice_t& slice = bank[bank_sel][idx * NumByteEnables + i];
+      if (slice.xor_reduce() != sc_logic('X')) {
+        data.range((i+1)*SliceWidth-1, i*SliceWidth) = slice;
+      }
+    }
+    return BitsToType<NVUINTW(WordWidth)>(data);
+#endif
+  }
+
+  /**
+   * \brief Overwrite all slices of an entry with raw bits (C-sim only).
+   */
+  void poke_word(unsigned idx, unsigned bank_sel, const NVUINTW(WordWidth)& word) {
+#ifdef MEM_ARRAY_SIM_STORAGE
+    bank.poke(bank_sel * NumEntriesPerBank + idx, word);
+#else
+    Data_t data = TypeToBits<NVUINTW(WordWidth)>(word);
+    for (int i = 0; i < NumByteEnables; i++) {
+      bank[bank_sel][idx * NumByteEnables + i] = data.range((i+1)*SliceWidth-1, i*SliceWidth);
+    }
+#endif
+  }
+
+  /**
+   * \brief Fill the memory from a raw binary image (C-sim only).
+   *
+   * The file is memory-mapped and copied straight into the backing store. See
+   * nvhls::mem_array_image for the image layout; striped interleaves
+   * consecutive image entries across banks. Returns false if the file cannot
+   * be mapped.
+   */
+  bool load_image(const std::string& filename, bool striped=false) {
+    return nvhls::mem_array_image<WordWidth, NumEntriesPerBank, NumBanks>::Load(*this, filename, striped);
+  }
+
+  /**
+   * \brief Write the memory contents to a raw binary image (C-sim only).
+   */
+  bool dump_image(const std::string& filename, bool striped=false) const {
+    return nvhls::mem_array_image<WordWidth, NumEntriesPerBank, NumBanks>::Dump(*this, filename, striped);
+  }
+#endif
+};
+
+/**
+ * \brief Multi-ported memory of replicated banks and a live value table
+ * \ingroup MemArray
+ *
+ * \tparam T                Datatype of an entry to be stored in memory
+ * \tparam NumEntries       Number of entries in memory
+ * \tparam NumReadPorts     Reads per cycle
+ * \tparam NumWritePorts    Writes per cycle
+ *
+ * \par Overview
+ * Every read port and every write port can access any entry in every
+ * cycle, with no conflicts. The memory is built from
+ * NumWritePorts x NumReadPorts banks of a mem_array_opt, each of which
+ * takes one read and one write per cycle:
+ * - Write port w writes the NumReadPorts banks of its replica w.
+ * - Read port r reads its own bank of each replica, and the live value
+ *   table (LVT) picks the replica that was written last.
+ * - The LVT holds index_width<NumWritePorts> bits per entry, and is kept
+ *   in registers so that all ports access it in the same cycle.
+ * .
+ * The area is NumWritePorts x NumReadPorts copies of the data plus the LVT,
+ * so this suits small tables with many accesses per cycle. access() reads
+ * all ports before writing, so a read of an entry written in the same
+ * cycle returns the old value. When two write ports write one entry in the
+ * same cycle, the higher port wins.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <mem_array.h>
+ *        ...
+ *        // 64 entries, 4 reads and 2 writes per cycle
+ *        typedef mem_array_lvt<NVUINT16, 64, 4, 2> Table;
+ *        Table table;
+ *        Table::Index raddr[4], waddr[2];
+ *        NVUINT16 rdata[4], wdata[2];
+ *        bool wen[2];
+ *        ...
+ *        table.access(raddr, rdata, waddr, wdata, wen);
+ *        ...
+ *        NVUINT16 val = table.read(0, addr);
+ *        table.write(1, addr, val + 1);
+ * \endcode
+ * \par
+ *
+ */
+template <typename T, int NumEntries, int NumReadPorts, int NumWritePorts>
+class mem_array_lvt {
+ public:
+  static_assert(NumReadPorts >= 1 && NumWritePorts >= 1, "mem_array_lvt needs a read and a write port");
+  static const int NumBanks = NumReadPorts * NumWritePorts;
+  typedef NVUINTW(nvhls::index_width<NumEntries>::val) Index;
+  typedef NVUINTW(nvhls::index_width<NumReadPorts>::val) ReadPort;
+  typedef NVUINTW(nvhls::index_width<NumWritePorts>::val) WritePort;
+  typedef mem_array_opt<T, NumEntries, NumBanks> Banks;
+  typedef typename Banks::LocalIndex LocalIndex;
+  typedef typename Banks::BankIndex BankIndex;
+
+  Banks banks;
+  WritePort lvt[NumEntries];
+
+  static const int width = Banks::width + NumEntries * nvhls::index_width<NumWritePorts>::val;
+
+  mem_array_lvt() {
+    #pragma hls_unroll yes
+    for (int i = 0; i < NumEntries; i++) {
+      lvt[i] = 0;
+    }
+  }
+
+  // Bank of read port r in replica w
+  static BankIndex bank(unsigned w, unsigned r) {
+    return w * NumReadPorts + r;
+  }
+
+  T read(ReadPort port, Index idx) {
+    NVHLS_ASSERT_MSG(port < NumReadPorts, "read port out of bounds");
+    NVHLS_ASSERT_MSG(idx < NumEntries, "index out of bounds");
+    return banks.read(static_cast<LocalIndex>(idx),
+                      bank(lvt[idx].to_uint(), port.to_uint()));
+  }
+
+  void write(WritePort port, Index idx, const T& val) {
+    NVHLS_ASSERT_MSG(port < NumWritePorts, "write port out of bounds");
+    NVHLS_ASSERT_MSG(idx < NumEntries, "index out of bounds");
+    #pragma hls_unroll yes
+    for (int r = 0; r < NumReadPorts; r++) {
+      banks.write(static_cast<LocalIndex>(idx), bank(port.to_uint(), r), val);
+    }
+    lvt[idx] = port;
+  }
+
+  // All ports in one cycle: reads first, then writes in port order
+  void access(const Index raddr[NumReadPorts], T rdata[NumReadPorts],
+              const Index waddr[NumWritePorts], const T wdata[NumWritePorts],
+              const bool wen[NumWritePorts]) {
+    #pragma hls_unroll yes
+    for (int r = 0; r < NumReadPorts; r++) {
+      rdata[r] = read(r, raddr[r]);
+    }
+    #pragma hls_unroll yes
+    for (int w = 0; w < NumWritePorts; w++) {
+      if (wen[w]) {
+        write(w, waddr[w], wdata[w]);
+      }
+    }
+  }
 
+  template<unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m & banks;
+    for (int i = 0; i < NumEntries; i++) {
+      m & lvt[i];
+    }
+  }
 };
 
 #endif
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MEM_ARRAY_IMAGE_H
+#define MEM_ARRAY_IMAGE_H
+
+#ifndef __SYNTHESIS__
+
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <hls_globals.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nvhls {
+
+/**
+ * \brief Read-only memory mapping of a file.
+ * \ingroup MemArray
+ *
+ * Non-synthesizable. is_open() is false if the file could not be opened or
+ * mapped; an empty file maps to size() == 0.
+ */
+class mapped_file {
+ public:
+  explicit mapped_file(const std::string& filename)
+      : fd_(-1), data_(NULL), size_(0) {
+    fd_ = open(filename.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+      return;
+    }
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+      close();
+      return;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+      void* addr = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+      if (addr == MAP_FAILED) {
+        close();
+        return;
+      }
+      data_ = static_cast<const unsigned char*>(addr);
+#ifdef MADV_SEQUENTIAL
+      madvise(const_cast<unsigned char*>(data_), size_, MADV_SEQUENTIAL);
+#endif
+    }
+  }
+
+  ~mapped_file() { close(); }
+
+  bool is_open() const { return fd_ >= 0; }
+  const unsigned char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  int fd_;
+  const unsigned char* data_;
+  size_t size_;
+
+  void close() {
+    if (data_ != NULL) {
+      munmap(const_cast<unsigned char*>(data_), size_);
+      data_ = NULL;
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+    size_ = 0;
+  }
+
+  mapped_file(const mapped_file&);
+  mapped_file& operator=(const mapped_file&);
+};
+
+/**
+ * \brief Raw binary images of mem_array contents.
+ * \ingroup MemArray
+ *
+ * \tparam WordWidth          Width in bits of a memory entry
+ * \tparam NumEntriesPerBank  Number of entries per bank
+ * \tparam NumBanks           Number of banks
+ *
+ * \par Overview
+ * - An image is a sequence of entries, each stored little-endian in
+ *   (WordWidth+7)/8 bytes.
+ * - By default image entries fill bank 0 first, then bank 1, and so on. With
+ *   striped set, consecutive image entries go to consecutive banks
+ *   (entry k is bank k % NumBanks, index k / NumBanks).
+ * - Image entry k is placed at memory position k * stride. A stride above 1
+ *   is used by memories that are indexed by byte address.
+ * - Mem must provide poke_word(idx, bank, word) and peek_word(idx, bank).
+ */
+template <unsigned int WordWidth, int NumEntriesPerBank, int NumBanks>
+class mem_array_image {
+ public:
+  static const unsigned int BytesPerWord = (WordWidth + 7) / 8;
+  static const unsigned long long NumEntries =
+      static_cast<unsigned long long>(NumEntriesPerBank) * NumBanks;
+  typedef NVUINTW(WordWidth) Word_t;
+
+  static Word_t FromBytes(const unsigned char* bytes) {
+    Word_t word = 0;
+    for (int i = BytesPerWord - 1; i >= 0; i--) {
+      word = (word << 8) | Word_t(bytes[i]);
+    }
+    return word;
+  }
+
+  static void ToBytes(Word_t word, unsigned char* bytes) {
+    for (unsigned i = 0; i < BytesPerWord; i++) {
+      Word_t byte = word & Word_t(0xff);
+      bytes[i] = static_cast<unsigned char>(byte.to_uint());
+      word >>= 8;
+    }
+  }
+
+  static void Position(unsigned long long k, unsigned stride, bool striped,
+                       unsigned& idx, unsigned& bank) {
+    if (striped) {
+      bank = k % NumBanks;
+      idx = (k / NumBanks) * stride;
+    } else {
+      unsigned long long pos = k * stride;
+      bank = pos / NumEntriesPerBank;
+      idx = pos % NumEntriesPerBank;
+    }
+  }
+
+  static unsigned long long Capacity(unsigned stride) {
+    return (NumEntries + stride - 1) / stride;
+  }
+
+  template <typename Mem>
+  static bool Load(Mem& mem, const std::string& filename, bool striped,
+                   unsigned stride = 1) {
+    mapped_file file(filename);
+    if (!file.is_open()) {
+      DCOUT("Error: cannot map memory image " << filename << endl);
+      return false;
+    }
+    unsigned long long num_words = file.size() / BytesPerWord;
+    if (file.size() % BytesPerWord != 0) {
+      DCOUT("Warning: memory image " << filename
+            << " ends with a partial entry, which is ignored" << endl);
+    }
+    if (num_words > Capacity(stride)) {
+      DCOUT("Warning: memory image " << filename
+            << " is larger than the memory, extra entries are ignored" << endl);
+      num_words = Capacity(stride);
+    }
+    const unsigned char* bytes = file.data();
+    for (unsigned long long k = 0; k < num_words; k++, bytes += BytesPerWord) {
+      unsigned idx, bank;
+      Position(k, stride, striped, idx, bank);
+      mem.poke_word(idx, bank, FromBytes(bytes));
+    }
+    return true;
+  }
+
+  template <typename Mem>
+  static bool Dump(const Mem& mem, const std::string& filename, bool striped,
+                   unsigned stride = 1) {
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (file == NULL) {
+      DCOUT("Error: cannot open memory image " << filename << endl);
+      return false;
+    }
+    static const unsigned kBufferWords = 4096;
+    std::vector<unsigned char> buffer(kBufferWords * BytesPerWord);
+    unsigned long long num_words = Capacity(stride);
+    bool ok = true;
+    for (unsigned long long k = 0; k < num_words && ok; k += kBufferWords) {
+      unsigned count = (num_words - k < kBufferWords) ? num_words - k : kBufferWords;
+      for (unsigned j = 0; j < count; j++) {
+        unsigned idx, bank;
+        Position(k + j, stride, striped, idx, bank);
+        ToBytes(mem.peek_word(idx, bank), &buffer[j * BytesPerWord]);
+      }
+      ok = (fwrite(&buffer[0], BytesPerWord, count, file) == count);
+    }
+    fclose(file);
+    if (!ok) {
+      DCOUT("Error: failed writing memory image " << filename << endl);
+    }
+    return ok;
+  }
+};
+
+}  // namespace nvhls
+
+#endif  // __SYNTHESIS__
+
+#endif  // MEM_ARRAY_IMAGE_H
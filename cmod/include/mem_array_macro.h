@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MEM_ARRAY_MACRO_H
+#define MEM_ARRAY_MACRO_H
+
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <nvhls_marshaller.h>
+#include <mem_array.h>
+
+/**
+ * \brief Compile-time description of the legal macros of an SRAM compiler
+ * \ingroup MemArray
+ *
+ * \tparam MaxDepth         Most entries of a macro
+ * \tparam MaxWidth         Most bits per entry of a macro
+ * \tparam DepthStep        Depth granularity: macro depths are a multiple of it (default: 1)
+ * \tparam MaxMuxInputs     Most inputs of a read mux level that fits in a cycle, 0 for no limit (default: 0)
+ *
+ * \par Overview
+ * A macro may be any width up to MaxWidth and any multiple of DepthStep up
+ * to MaxDepth. mem_array_macro splits its logical memory into macros that
+ * fit in these limits. A project typically keeps a typedef per SRAM library:
+ *
+ * \code
+ *      typedef sram_macro_lib<4096, 144, 32, 4> Sram16ff;
+ * \endcode
+ * \par
+ *
+ */
+template <unsigned int MaxDepth_, unsigned int MaxWidth_, unsigned int DepthStep_ = 1,
+          unsigned int MaxMuxInputs_ = 0>
+struct sram_macro_lib {
+  static const unsigned int MaxDepth = MaxDepth_;
+  static const unsigned int MaxWidth = MaxWidth_;
+  static const unsigned int DepthStep = DepthStep_;
+  static const unsigned int MaxMuxInputs = MaxMuxInputs_;
+  static_assert(MaxDepth >= 1 && MaxWidth >= 1, "Macros must hold at least one bit");
+  static_assert(DepthStep >= 1 && MaxDepth % DepthStep == 0,
+                "MaxDepth must be a multiple of DepthStep");
+  static_assert(MaxMuxInputs != 1, "A read mux level needs at least 2 inputs");
+};
+
+namespace nvhls {
+
+// Levels of a tree of Fanin:1 muxes selecting among N inputs
+template <unsigned int N, unsigned int Fanin>
+struct mem_array_mux_levels {
+  enum { val = 1 + mem_array_mux_levels<(N + Fanin - 1) / Fanin, Fanin>::val };
+};
+
+template <unsigned int Fanin>
+struct mem_array_mux_levels<1, Fanin> {
+  enum { val = 0 };
+};
+
+}  // namespace nvhls
+
+/**
+ * \brief Banked memory built from the legal macros of an SRAM library
+ * \ingroup MemArray
+ *
+ * \tparam T                       Datatype of an entry to be stored in memory
+ * \tparam NumEntriesPerBank       Number of entries per bank in memory
+ * \tparam NumBanks                Number of banks in memory
+ * \tparam MacroLib                sram_macro_lib describing the legal macros
+ * \tparam NumByteEnables          Number of byte enables per entry (default: 1)
+ *
+ * \par Overview
+ * Same read(), write(), burst and clear() interface as mem_array_opt, with
+ * every logical bank split at compile time into DepthSplits x WidthSplits
+ * macros:
+ * - Depth: DepthSplits = ceil(NumEntriesPerBank / MaxDepth) macros of
+ *   MacroDepth entries, the balanced share rounded up to DepthStep. Entry
+ *   idx is in macro idx / MacroDepth, which is a bit slice when MacroDepth
+ *   is a power of two.
+ * - Width: WidthSplits macros of MacroWidth bits, written and read
+ *   together. With byte enables, a macro holds whole slices, so a byte
+ *   enable never spans two macros.
+ * .
+ * Each macro is a bank of a mem_array_opt, so HLS maps every macro to its
+ * own RAM. Reads select the data of one of DepthSplits macros, through
+ * MuxLevels levels of MaxMuxInputs:1 muxes. ReadLatency, one cycle plus one
+ * per mux level beyond the first, is the latency to schedule reads with so
+ * that every mux level fits in a cycle; read() itself returns the data
+ * right away, as mem_array_opt does. Entries beyond NumEntriesPerBank and
+ * bits beyond the entry width are padding of the last macros.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <mem_array_macro.h>
+ *        ...
+ *        // 8192 x 200-bit banks from macros of at most 4096 x 144 bits:
+ *        // 2 x 2 macros of 4096 x 100 bits per bank
+ *        typedef sram_macro_lib<4096, 144, 32, 4> Sram;
+ *        mem_array_macro <MemWord_t, 8192, NBANKS, Sram> banks;
+ *
+ *        read_data = banks.read(bank_addr, bank_sel);
+ *
+ *        banks.write(bank_addr, bank_sel, write_data);
+ *        ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename T, int NumEntriesPerBank, int NumBanks, typename MacroLib,
+          int NumByteEnables = 1>
+class mem_array_macro {
+ public:
+  static const unsigned int NumEntries = NumEntriesPerBank * NumBanks;
+  static const unsigned int WordWidth = Wrapped<T>::width;
+  static const unsigned int SliceWidth = WordWidth / NumByteEnables;
+  static_assert(WordWidth % NumByteEnables == 0,
+                "Entry width must be a multiple of the byte enables");
+  static_assert(NumByteEnables == 1 || SliceWidth <= MacroLib::MaxWidth,
+                "A byte-enable slice is wider than the widest macro");
+
+  // Depth split
+  static const unsigned int DepthSplits =
+      (NumEntriesPerBank + MacroLib::MaxDepth - 1) / MacroLib::MaxDepth;
+  static const unsigned int MacroDepth =
+      ((NumEntriesPerBank + DepthSplits - 1) / DepthSplits + MacroLib::DepthStep - 1) /
+      MacroLib::DepthStep * MacroLib::DepthStep;
+
+  // Width split, in whole slices with byte enables
+  static const unsigned int MaxMacroSlices =
+      (NumByteEnables == 1) ? 1 : MacroLib::MaxWidth / SliceWidth;
+  static const unsigned int WidthSplits =
+      (NumByteEnables == 1)
+          ? (WordWidth + MacroLib::MaxWidth - 1) / MacroLib::MaxWidth
+          : (NumByteEnables + MaxMacroSlices - 1) / MaxMacroSlices;
+  static const unsigned int MacroSlices =
+      (NumByteEnables == 1) ? 1 : (NumByteEnables + WidthSplits - 1) / WidthSplits;
+  static const unsigned int MacroWidth =
+      (NumByteEnables == 1) ? (WordWidth + WidthSplits - 1) / WidthSplits
+                            : MacroSlices * SliceWidth;
+  static const unsigned int PaddedWidth = WidthSplits * MacroWidth;
+
+  static const unsigned int MacrosPerBank = DepthSplits * WidthSplits;
+  static const unsigned int NumMacros = NumBanks * MacrosPerBank;
+
+  // Read mux over the depth macros
+  static const unsigned int MuxFanin =
+      (MacroLib::MaxMuxInputs == 0 || MacroLib::MaxMuxInputs > DepthSplits)
+          ? DepthSplits : MacroLib::MaxMuxInputs;
+  static const unsigned int MuxLevels =
+      nvhls::mem_array_mux_levels<DepthSplits, (MuxFanin < 2) ? 2 : MuxFanin>::val;
+  static const unsigned int ReadLatency = (MuxLevels > 1) ? MuxLevels : 1;
+
+  static_assert(MacroDepth <= MacroLib::MaxDepth && MacroWidth <= MacroLib::MaxWidth,
+                "Macro does not fit in the library limits");
+
+  typedef NVUINTW(nvhls::index_width<NumEntriesPerBank>::val) LocalIndex;
+  typedef NVUINTW(nvhls::index_width<NumBanks>::val) BankIndex;
+  typedef NVUINTW(NumByteEnables) WriteMask;
+  typedef NVUINTW(MacroWidth) MacroWord;
+  typedef NVUINTW(PaddedWidth) PaddedWord;
+  typedef NVUINTW(WidthSplits * MacroSlices) PaddedMask;
+  typedef mem_array_opt<MacroWord, MacroDepth, NumMacros, MacroSlices> Macros;
+  typedef typename Macros::LocalIndex MacroIndex;
+  typedef typename Macros::BankIndex MacroSel;
+  typedef typename Macros::WriteMask MacroMask;
+
+  Macros macros;
+
+  static const int width = Macros::width;
+
+  mem_array_macro() {}
+
+  void clear() { macros.clear(); }
+
+  T read(LocalIndex idx, BankIndex bank_sel=0, WriteMask read_mask=~static_cast<WriteMask>(0)) {
+    NVHLS_ASSERT_MSG(bank_sel<NumBanks, "bank index out of bounds");
+    NVHLS_ASSERT_MSG(idx<NumEntriesPerBank, "local index out of bounds");
+    MacroSel base = first_macro(idx, bank_sel);
+    MacroIndex macro_idx = idx % MacroDepth;
+    PaddedMask mask = pad_mask(read_mask);
+    PaddedWord data = 0;
+    #pragma hls_unroll yes
+    for (unsigned w = 0; w < WidthSplits; w++) {
+      MacroMask macro_mask = nvhls::get_slc<MacroSlices>(mask, w * MacroSlices);
+      if (macro_mask != 0) {
+        MacroWord macro_data = macros.read(macro_idx, base + w, macro_mask);
+        data = nvhls::set_slc(data, macro_data, w * MacroWidth);
+      }
+    }
+    return NVUINTToType<T>(nvhls::get_slc<WordWidth>(data, 0));
+  }
+
+  void write(LocalIndex idx, BankIndex bank_sel, const T& val, WriteMask write_mask=~static_cast<WriteMask>(0), bool wce=1) {
+    if (wce) {
+      NVHLS_ASSERT_MSG(bank_sel<NumBanks, "bank index out of bounds");
+      NVHLS_ASSERT_MSG(idx<NumEntriesPerBank, "local index out of bounds");
+      MacroSel base = first_macro(idx, bank_sel);
+      MacroIndex macro_idx = idx % MacroDepth;
+      PaddedMask mask = pad_mask(write_mask);
+      PaddedWord data = 0;
+      data = nvhls::set_slc(data, TypeToNVUINT<T>(val), 0);
+      #pragma hls_unroll yes
+      for (unsigned w = 0; w < WidthSplits; w++) {
+        MacroMask macro_mask = nvhls::get_slc<MacroSlices>(mask, w * MacroSlices);
+        if (macro_mask != 0) {
+          macros.write(macro_idx, base + w,
+                       nvhls::get_slc<MacroWidth>(data, w * MacroWidth), macro_mask);
+        }
+      }
+    }
+  }
+
+  /**
+   * \brief Read len entries starting at idx, stride entries apart, into data.
+   */
+  template <int MaxLen>
+  void read_burst(LocalIndex idx, BankIndex bank_sel,
+                  NVUINTW(nvhls::index_width<MaxLen+1>::val) len, T (&data)[MaxLen],
+                  LocalIndex stride=1, WriteMask read_mask=~static_cast<WriteMask>(0)) {
+    NVHLS_ASSERT_MSG(len<=MaxLen, "burst length out of bounds");
+    NVHLS_ASSERT_MSG(len==0 || idx + (len-1)*stride < NumEntriesPerBank, "burst index out of bounds");
+    #pragma hls_unroll yes
+    for (int i = 0; i < MaxLen; i++) {
+      if (i < len) {
+        data[i] = read(idx + i*stride, bank_sel, read_mask);
+      }
+    }
+  }
+
+  /**
+   * \brief Write len entries from data starting at idx, stride entries apart.
+   */
+  template <int MaxLen>
+  void write_burst(LocalIndex idx, BankIndex bank_sel,
+                   NVUINTW(nvhls::index_width<MaxLen+1>::val) len, const T (&data)[MaxLen],
+                   LocalIndex stride=1, WriteMask write_mask=~static_cast<WriteMask>(0)) {
+    NVHLS_ASSERT_MSG(len<=MaxLen, "burst length out of bounds");
+    NVHLS_ASSERT_MSG(len==0 || idx + (len-1)*stride < NumEntriesPerBank, "burst index out of bounds");
+    #pragma hls_unroll yes
+    for (int i = 0; i < MaxLen; i++) {
+      if (i < len) {
+        write(idx + i*stride, bank_sel, data[i], write_mask);
+      }
+    }
+  }
+
+  template<unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m & macros;
+  }
+
+ protected:
+  // Macro holding the low bits of entry idx of bank bank_sel
+  static MacroSel first_macro(LocalIndex idx, BankIndex bank_sel) {
+    MacroSel depth_sel = idx / MacroDepth;
+    return (bank_sel * DepthSplits + depth_sel) * WidthSplits;
+  }
+
+  // One mask bit per macro slice; the padding slices are never accessed
+  static PaddedMask pad_mask(WriteMask mask) {
+    PaddedMask padded = 0;
+    if (NumByteEnables == 1) {
+      if (mask[0] == 1) {
+        padded = ~padded;
+      }
+    } else {
+      padded = nvhls::set_slc(padded, mask, 0);
+    }
+    return padded;
+  }
+};
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MEM_ARRAY_PIPELINED_H
+#define MEM_ARRAY_PIPELINED_H
+
+#include <nvhls_types.h>
+#include <nvhls_int.h>
+#include <nvhls_assert.h>
+#include <mem_array.h>
+#include <fifo.h>
+
+/**
+ * \brief Banked memory with a multi-cycle, pipelined read
+ * \ingroup MemArray
+ *
+ * \tparam T                Datatype of an entry to be stored in memory
+ * \tparam NumEntries       Number of entries in memory
+ * \tparam NumBanks         Number of banks in memory
+ * \tparam ReadLatency      Cycles from a read to its response
+ * \tparam MaxOutstanding   Reads per bank in flight or waiting to be popped
+ * \tparam NumByteEnables   Number of byte enables per entry
+ *
+ * \par Overview
+ * Wraps mem_array_sep to model SRAM macros whose read data comes out
+ * ReadLatency cycles after the read. The class is advanced one cycle by
+ * tick(); within a cycle each bank takes at most one read and one write.
+ * - read() captures the entry as it is when the read is issued, and pushes
+ *   it down a ReadLatency-deep pipeline. Its response can be popped from
+ *   ReadLatency cycles later, in read order per bank.
+ * - Responses that are not popped wait in a per-bank queue. A bank takes a
+ *   read only while fewer than MaxOutstanding of its reads are in the
+ *   pipeline or the queue, so the queue never overflows.
+ * - write() goes straight to the array, so a read issued after a write in
+ *   a later cycle sees it.
+ * .
+ * With the default MaxOutstanding of ReadLatency + 1, a bank whose
+ * responses are popped as soon as they arrive takes one read per cycle
+ * whether read_ready() is checked before or after the pop.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <mem_array_pipelined.h>
+ *
+ *      ...
+ *      mem_array_pipelined<Data, 1024, 4, 2> banks;
+ *      ...
+ *      // Every cycle
+ *      if (banks.rsp_valid(bank)) {
+ *        data = banks.rsp_pop(bank);
+ *      }
+ *      if (banks.read_ready(bank)) {
+ *        banks.read(idx, bank);
+ *      }
+ *      banks.tick();
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename T, int NumEntries, int NumBanks, unsigned int ReadLatency,
+          unsigned int MaxOutstanding = ReadLatency + 1, int NumByteEnables = 1>
+class mem_array_pipelined {
+ public:
+  typedef mem_array_sep<T, NumEntries, NumBanks, NumByteEnables> Array;
+  typedef typename Array::LocalIndex LocalIndex;
+  typedef typename Array::BankIndex BankIndex;
+  typedef typename Array::WriteMask WriteMask;
+  typedef NVUINTW(nvhls::index_width<MaxOutstanding + 1>::val) Count;
+
+  static_assert(ReadLatency >= 1, "ReadLatency must be at least 1");
+  static_assert(MaxOutstanding >= 1, "MaxOutstanding must be at least 1");
+
+  Array array;
+
+ protected:
+  bool stage_valid[ReadLatency][NumBanks];
+  T stage_data[ReadLatency][NumBanks];
+  FIFO<T, MaxOutstanding, NumBanks> rsp_queue;
+  Count outstanding[NumBanks];
+
+ public:
+  mem_array_pipelined() { reset(); }
+
+  // Drops reads in flight; the array keeps its contents
+  void reset() {
+    #pragma hls_unroll yes
+    for (unsigned bank = 0; bank < NumBanks; bank++) {
+      #pragma hls_unroll yes
+      for (unsigned i = 0; i < ReadLatency; i++) {
+        stage_valid[i][bank] = false;
+      }
+      outstanding[bank] = 0;
+    }
+    rsp_queue.reset();
+  }
+
+  bool read_ready(BankIndex bank) {
+    return (outstanding[bank] != MaxOutstanding) && !stage_valid[0][bank];
+  }
+
+  void read(LocalIndex idx, BankIndex bank,
+            WriteMask read_mask = ~static_cast<WriteMask>(0)) {
+    NVHLS_ASSERT_MSG(read_ready(bank), "Read issued to a bank that is not ready");
+    stage_data[0][bank] = array.read(idx, bank, read_mask);
+    stage_valid[0][bank] = true;
+    outstanding[bank]++;
+  }
+
+  void write(LocalIndex idx, BankIndex bank, T val,
+             WriteMask write_mask = ~static_cast<WriteMask>(0)) {
+    array.write(idx, bank, val, write_mask);
+  }
+
+  bool rsp_valid(BankIndex bank) { return !rsp_queue.isEmpty(bank); }
+
+  T rsp_peek(BankIndex bank) { return rsp_queue.peek(bank); }
+
+  T rsp_pop(BankIndex bank) {
+    NVHLS_ASSERT_MSG(rsp_valid(bank), "No read response to pop");
+    outstanding[bank]--;
+    return rsp_queue.pop(bank);
+  }
+
+  // Reads in flight or waiting to be popped
+  Count NumOutstanding(BankIndex bank) { return outstanding[bank]; }
+
+  // Advances the read pipelines by one cycle
+  void tick() {
+    #pragma hls_unroll yes
+    for (unsigned bank = 0; bank < NumBanks; bank++) {
+      if (stage_valid[ReadLatency - 1][bank]) {
+        rsp_queue.push(stage_data[ReadLatency - 1][bank], bank);
+      }
+      #pragma hls_unroll yes
+      for (unsigned i = ReadLatency - 1; i > 0; i--) {
+        stage_valid[i][bank] = stage_valid[i - 1][bank];
+        stage_data[i][bank] = stage_data[i - 1][bank];
+      }
+      stage_valid[0][bank] = false;
+    }
+  }
+};
+
+#endif
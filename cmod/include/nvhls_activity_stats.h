@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_ACTIVITY_STATS_H
+#define NVHLS_ACTIVITY_STATS_H
+
+#include <systemc.h>
+#ifndef __SYNTHESIS__
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <TypeToBits.h>
+#endif
+
+namespace match {
+
+#ifndef __SYNTHESIS__
+
+/**
+ * \brief Switching-activity counters for energy-per-operation estimates.
+ * \ingroup nvhls_module
+ *
+ * \par Overview
+ * An ActivityStats counts the events an energy model is calibrated against:
+ * - Sample(msg): a message moved over a channel. The bits of TypeToBits(msg)
+ *   that differ from the previous sampled message (all zeros before the
+ *   first one) are counted as toggles, next to the messages and bits moved.
+ * - Read(bank) / Write(bank): accesses to a memory bank. mem_array_sep
+ *   counts them in its Stats().
+ * - Grant(choice, size): the elements granted by an arbiter pick. Arbiter and
+ *   MultiGrantArbiter count them in their Stats().
+ *
+ * Nothing is counted until the owning match::Module registers the counters
+ * with RegisterActivityStats(), so uninstrumented models pay one branch per
+ * event. Module::DumpStats() prints them as <name>_messages, <name>_bits,
+ * <name>_toggles, <name>_reads_<bank>, <name>_writes_<bank> and
+ * <name>_grants_<element>, leaving out the kinds that never occurred.
+ *
+ * \par A Simple Example
+ * \code
+ *      mem_array_sep<Word, 256, 4> banks;
+ *      Arbiter<4> arb;
+ *      match::ActivityStats in_activity;
+ *      ...
+ *      // In the match::Module constructor
+ *      RegisterActivityStats("banks", banks.Stats());
+ *      RegisterActivityStats("arb", arb.Stats());
+ *      RegisterActivityStats("in", in_activity);
+ *      ...
+ *      Req req = in.Pop();
+ *      in_activity.Sample(req);
+ * \endcode
+ * \par
+ *
+ */
+class ActivityStats {
+ public:
+  ActivityStats() : enabled_(false), messages_(0), bits_(0), toggles_(0) {}
+
+  void Enable() { enabled_ = true; }
+  bool IsEnabled() const { return enabled_; }
+
+  template <typename Message>
+  void Sample(const Message& msg) {
+    if (!enabled_) return;
+    sc_lv<Wrapped<Message>::width> bits = TypeToBits<Message>(msg);
+    if (last_.size() != static_cast<unsigned int>(Wrapped<Message>::width)) {
+      last_.assign(Wrapped<Message>::width, false);
+    }
+    for (unsigned int i = 0; i < last_.size(); i++) {
+      bool bit = (bits[i] == SC_LOGIC_1);
+      if (bit != last_[i]) {
+        toggles_++;
+        last_[i] = bit;
+      }
+    }
+    messages_++;
+    bits_ += last_.size();
+  }
+
+  void Read(unsigned int bank, unsigned int n = 1) {
+    if (enabled_) Add(reads_, bank, n);
+  }
+  void Write(unsigned int bank, unsigned int n = 1) {
+    if (enabled_) Add(writes_, bank, n);
+  }
+
+  template <typename Mask>
+  void Grant(const Mask& choice, unsigned int size) {
+    if (!enabled_) return;
+    for (unsigned int i = 0; i < size; i++) {
+      if (choice[i] == 1) Add(grants_, i, 1);
+    }
+  }
+
+  uint64 NumMessages() const { return messages_; }
+  uint64 NumBits() const { return bits_; }
+  uint64 NumToggles() const { return toggles_; }
+  const std::vector<uint64>& Reads() const { return reads_; }
+  const std::vector<uint64>& Writes() const { return writes_; }
+  const std::vector<uint64>& Grants() const { return grants_; }
+
+  void Clear() {
+    messages_ = bits_ = toggles_ = 0;
+    last_.clear();
+    reads_.clear();
+    writes_.clear();
+    grants_.clear();
+  }
+
+  // Appends (name, value) pairs for each counter
+  void GetCounters(const std::string& prefix,
+                   std::vector<std::pair<std::string, uint64> >& out) const {
+    if (messages_ != 0) {
+      out.push_back(std::make_pair(prefix + "_messages", messages_));
+      out.push_back(std::make_pair(prefix + "_bits", bits_));
+      out.push_back(std::make_pair(prefix + "_toggles", toggles_));
+    }
+    GetIndexed(prefix + "_reads_", reads_, out);
+    GetIndexed(prefix + "_writes_", writes_, out);
+    GetIndexed(prefix + "_grants_", grants_, out);
+  }
+
+ private:
+  static void Add(std::vector<uint64>& counts, unsigned int idx, unsigned int n) {
+    if (idx >= counts.size()) {
+      counts.resize(idx + 1, 0);
+    }
+    counts[idx] += n;
+  }
+
+  static void GetIndexed(const std::string& prefix, const std::vector<uint64>& counts,
+                         std::vector<std::pair<std::string, uint64> >& out) {
+    for (unsigned int i = 0; i < counts.size(); i++) {
+      std::stringstream name;
+      name << prefix << i;
+      out.push_back(std::make_pair(name.str(), counts[i]));
+    }
+  }
+
+  bool enabled_;
+  uint64 messages_;
+  uint64 bits_;
+  uint64 toggles_;
+  std::vector<bool> last_;
+  std::vector<uint64> reads_;
+  std::vector<uint64> writes_;
+  std::vector<uint64> grants_;
+};
+
+#else
+
+// Synthesis view: no counters
+class ActivityStats {
+ public:
+  template <typename Message>
+  void Sample(const Message& msg) {}
+  void Read(unsigned int bank, unsigned int n = 1) {}
+  void Write(unsigned int bank, unsigned int n = 1) {}
+  template <typename Mask>
+  void Grant(const Mask& choice, unsigned int size) {}
+};
+
+#endif  // __SYNTHESIS__
+
+}  // namespace match
+
+#endif  // NVHLS_ACTIVITY_STATS_H
@@ -22,7 +22,31 @@
 #include <connections/annotate.h>
 
 namespace nvhls {
-  void annotate_design(const sc_object &root, std::string base_name = "", std::string input_dir_path = "", std::string output_dir_path = "") {
+  /**
+   * \brief Annotates the latency and capacity of the channels below root.
+   * \ingroup nvhls_module
+   *
+   * \par Overview
+   * Forwards to Connections::annotate_design: channels listed in
+   * base_name.input.json (in input_dir_path) take the latency and capacity
+   * given there, and every channel is written to base_name.output.json (in
+   * output_dir_path). bin/perf_annotate.py fills the input file from the HLS
+   * reports of the blocks that drive the channels, and reports the port
+   * utilization and stalls of the annotated run from its match::StatsJSON dump.
+   *
+   * \par A Simple Example
+   * \code
+   *      #include <nvhls_annotate.h>
+   *      ...
+   *      testbench tb("tb");
+   *      nvhls::annotate_design(tb);
+   *      sc_start();
+   *      match::StatsJSON::Dump(tb.dut, "stats.json");
+   * \endcode
+   * \par
+   *
+   */
+  inline void annotate_design(const sc_object &root, std::string base_name = "", std::string input_dir_path = "", std::string output_dir_path = "") {
     Connections::annotate_design(root, base_name, input_dir_path, output_dir_path);
   }
 }
@@ -20,6 +20,9 @@
 #include <cstddef>
 #include <ac_assert.h>
 #include <list>
+#include <new>
+#include <string>
+#include <type_traits>
 #include "systemc.h"
 
 namespace nvhls {
@@ -41,7 +44,7 @@ struct nv_array_pow2
 };
 
 
-static const char* make_permanent(const char* nm) {
+inline const char* make_permanent(const char* nm) {
 #ifdef __SYNTHESIS__
   return nm;
 #else
@@ -53,10 +56,81 @@ static const char* make_permanent(const char* nm) {
 
 // nv_array_bank_array_no_assert_base is the base class for banked arrays,
 // and typically is not directly used in user models.
+//
+// HLS needs the array as a binary tree of separate variables. C simulation
+// instead keeps the elements in one flat block, so that indexing is a single
+// offset rather than log2(C) levels of recursion, and element names are
+// generated directly rather than kept in the make_permanent list. Define
+// NVHLS_ARRAY_TREE_SIM to simulate the tree as well, e.g. to get its
+// hierarchical element names.
+
+#if !defined(__SYNTHESIS__) && !defined(NVHLS_ARRAY_TREE_SIM)
+#define NVHLS_ARRAY_FLAT_SIM
+#endif
 
 template <typename B, size_t C>
 class nv_array_bank_array_no_assert_base;
 
+#ifdef NVHLS_ARRAY_FLAT_SIM
+
+template <typename B, size_t C>
+class nv_array_bank_array_no_assert_base
+{
+  typename std::aligned_storage<sizeof(B), alignof(B)>::type store[C];
+
+  B &elem(size_t idx) { return *reinterpret_cast<B*>(&store[idx]); }
+  const B &elem(size_t idx) const { return *reinterpret_cast<const B*>(&store[idx]); }
+
+public:
+
+  nv_array_bank_array_no_assert_base() {
+    for (size_t i = 0; i < C; i++) {
+      new (&store[i]) B();
+    }
+  }
+
+  nv_array_bank_array_no_assert_base(const char* prefix) {
+    for (size_t i = 0; i < C; i++) {
+      // sc_gen_unique_name reuses its buffer, which B's constructor may call
+      // again, so the name is copied for as long as B is being constructed.
+      std::string nm(sc_gen_unique_name(prefix));
+      new (&store[i]) B(nm.c_str());
+    }
+  }
+
+  nv_array_bank_array_no_assert_base(const nv_array_bank_array_no_assert_base& other) {
+    for (size_t i = 0; i < C; i++) {
+      new (&store[i]) B(other.elem(i));
+    }
+  }
+
+  nv_array_bank_array_no_assert_base& operator=(const nv_array_bank_array_no_assert_base& other) {
+    for (size_t i = 0; i < C; i++) {
+      elem(i) = other.elem(i);
+    }
+    return *this;
+  }
+
+  ~nv_array_bank_array_no_assert_base() {
+    for (size_t i = C; i > 0; i--) {
+      elem(i - 1).~B();
+    }
+  }
+
+  // As in the tree, a single element array ignores the index
+  B &operator[](size_t idx) {
+    assert(C == 1 || idx < C);
+    return elem(C == 1 ? 0 : idx);
+  }
+
+  const B &operator[](size_t idx) const {
+    assert(C == 1 || idx < C);
+    return elem(C == 1 ? 0 : idx);
+  }
+};
+
+#else
+
 template <typename B>
 class nv_array_bank_array_no_assert_base<B, 1>
 {
@@ -105,6 +179,8 @@ public:
   }
 };
 
+#endif  // NVHLS_ARRAY_FLAT_SIM
+
 
 
 /**
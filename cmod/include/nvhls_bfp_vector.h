@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_BFP_VECTOR_H
+#define NVHLS_BFP_VECTOR_H
+
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_message.h>
+#include <nvhls_vector.h>
+
+namespace nvhls {
+
+/**
+ * \brief Block floating point vector: one shared exponent per block
+ * \ingroup nvhls_vector
+ *
+ * \tparam MantW      Mantissa magnitude width
+ * \tparam ExpW       Shared exponent width (signed)
+ * \tparam BlockSize  Elements per block
+ *
+ * \par Overview
+ * Element i has the value (sign[i] ? -1 : 1) * mant[i] * 2^exp. Mantissas are
+ * sign-magnitude, so the multipliers of dp() and vector_mac() are unsigned
+ * MantW x MantW, and a block of BlockSize elements costs
+ * BlockSize * (MantW + 1) + ExpW bits instead of BlockSize full words.
+ * - quantize() converts an integer vector (scaled by 2^in_exp), choosing the
+ *   smallest exponent at which the largest magnitude fits MantW bits and
+ *   truncating the others toward zero.
+ * - normalize() shifts every mantissa left, with nvhls::normalize, until the
+ *   largest uses all MantW bits.
+ * Zero elements always have sign false. Exponents are not saturated: an
+ * operation whose exponent leaves the ExpW range wraps.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_bfp_vector.h>
+ *
+ *      ...
+ *      nv_scvector<NVINT16, 16> act;
+ *      nv_bfp_vector<8, 8, 16> a, w;
+ *      a.quantize(act);
+ *      a.normalize();
+ *      ...
+ *      nv_bfp_vector<8, 8, 16>::DotType dot;
+ *      nv_bfp_vector<8, 8, 16>::ProdExp dot_exp;
+ *      nvhls::dp(a, w, dot, dot_exp);     // a . w = dot * 2^dot_exp
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <unsigned int MantW, unsigned int ExpW, unsigned int BlockSize>
+class nv_bfp_vector : public nvhls_message {
+ public:
+  typedef NVUINTW(MantW) Mant;
+  typedef NVINTW(ExpW) Exp;
+  // Exponent and exact signed product of two elements
+  typedef NVINTW(ExpW + 1) ProdExp;
+  typedef NVINTW(2 * MantW + 1) Prod;
+  // Exact sum of BlockSize products
+  typedef typename AdderTree<Prod, BlockSize>::OutType DotType;
+
+  static const unsigned int mant_width = MantW;
+  static const unsigned int exp_width = ExpW;
+  static const unsigned int length = BlockSize;
+  static const unsigned int width = BlockSize * (MantW + 1) + ExpW;
+
+  Mant mant[BlockSize];
+  bool sign[BlockSize];
+  Exp exp;
+
+  nv_bfp_vector() {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < BlockSize; i++) {
+      mant[i] = 0;
+      sign[i] = false;
+    }
+    exp = 0;
+  }
+
+  // Element i as a signed integer, to be scaled by 2^exp
+  NVINTW(MantW + 1) signed_mant(unsigned int i) const {
+    NVINTW(MantW + 1) m = mant[i];
+    if (sign[i]) {
+      m = -m;
+    }
+    return m;
+  }
+
+  // Sets the block from magnitudes mag[i] * 2^e: the shared exponent is the
+  // smallest at which the largest magnitude fits MantW bits
+  template <unsigned int MagW, typename ExpType>
+  void set_block(const NVUINTW(MagW) mag[BlockSize], const bool neg[BlockSize],
+                 const ExpType& e) {
+    NVUINTW(MagW) all = 0;
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < BlockSize; i++) {
+      all |= mag[i];
+    }
+    unsigned int bits = (all == 0) ? 0 : MagW - lzd(all);
+    unsigned int shift = (bits > MantW) ? bits - MantW : 0;
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < BlockSize; i++) {
+      mant[i] = right_shift(mag[i], shift);
+      sign[i] = neg[i] && (mant[i] != 0);
+    }
+    exp = e + shift;
+  }
+
+  // Quantizes in[i] * 2^in_exp for an integer vector
+  template <typename InType>
+  void quantize(const nv_scvector<InType, BlockSize>& in, const Exp& in_exp = 0) {
+    const unsigned int InW = Wrapped<InType>::width;
+    NVUINTW(InW) mag[BlockSize];
+    bool neg[BlockSize];
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < BlockSize; i++) {
+      NVINTW(InW + 1) x = in[i];
+      neg[i] = (x < 0);
+      if (neg[i]) {
+        x = -x;
+      }
+      mag[i] = x;
+    }
+    set_block<InW>(mag, neg, in_exp);
+  }
+
+  // Shifts the block left so that the largest mantissa has its MSB set, or
+  // the exponent reaches its minimum
+  void normalize() {
+    Mant all = 0;
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < BlockSize; i++) {
+      all |= mant[i];
+    }
+    if (all == 0) {
+      return;
+    }
+    Exp new_exp = exp;
+    nvhls::normalize(all, new_exp);
+    NVINTW(ExpW + 1) diff = exp;
+    diff -= new_exp;
+    unsigned int shift = diff.to_uint();
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < BlockSize; i++) {
+      mant[i] = left_shift(mant[i], shift);
+    }
+    exp = new_exp;
+  }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m& exp;
+#pragma hls_unroll yes
+    for (unsigned int i = 0; i < BlockSize; i++) {
+      m& mant[i];
+      m& sign[i];
+    }
+  }
+};
+
+template <unsigned int MantW, unsigned int ExpW, unsigned int BlockSize>
+inline bool operator==(const nv_bfp_vector<MantW, ExpW, BlockSize>& lhs,
+                       const nv_bfp_vector<MantW, ExpW, BlockSize>& rhs) {
+  bool is_equal = (lhs.exp == rhs.exp);
+#pragma hls_unroll yes
+  for (unsigned i = 0; i < BlockSize; i++)
+    is_equal &= (lhs.mant[i] == rhs.mant[i]) && (lhs.sign[i] == rhs.sign[i]);
+  return is_equal;
+}
+
+template <unsigned int MantW, unsigned int ExpW, unsigned int BlockSize>
+inline std::ostream& operator<<(std::ostream& os,
+                                const nv_bfp_vector<MantW, ExpW, BlockSize>& vec) {
+  for (unsigned i = 0; i < BlockSize; i++) {
+    os << vec.signed_mant(i) << " ";
+  }
+  os << "* 2^" << vec.exp;
+  return os;
+}
+
+/**
+ * \brief Block floating point dot product
+ * \ingroup nvhls_vector
+ *
+ * \par Overview
+ * Writes the exact dot product of two blocks as out * 2^out_exp. The blocks
+ * share their exponents, so no alignment is needed: the MantW x MantW
+ * products are summed by an AdderTree and out_exp = in1.exp + in2.exp.
+ *
+ * \par A Simple Example
+ * \code
+ *      nv_bfp_vector<8, 8, 16> a, w;
+ *      nv_bfp_vector<8, 8, 16>::DotType dot;
+ *      nv_bfp_vector<8, 8, 16>::ProdExp dot_exp;
+ *      nvhls::dp(a, w, dot, dot_exp);
+ * \endcode
+ * \par
+ *
+ */
+template <unsigned int MantW, unsigned int ExpW, unsigned int BlockSize>
+void dp(const nv_bfp_vector<MantW, ExpW, BlockSize>& in1,
+        const nv_bfp_vector<MantW, ExpW, BlockSize>& in2,
+        typename nv_bfp_vector<MantW, ExpW, BlockSize>::DotType& out,
+        typename nv_bfp_vector<MantW, ExpW, BlockSize>::ProdExp& out_exp) {
+  typedef nv_bfp_vector<MantW, ExpW, BlockSize> Vec;
+  typename Vec::Prod prods[BlockSize];
+#pragma hls_unroll yes
+  for (unsigned i = 0; i < BlockSize; i++) {
+    NVUINTW(2 * MantW) mag = in1.mant[i] * in2.mant[i];
+    prods[i] = mag;
+    if (in1.sign[i] != in2.sign[i]) {
+      prods[i] = -prods[i];
+    }
+  }
+  out = AdderTree<typename Vec::Prod, BlockSize>::sum(prods);
+  out_exp = in1.exp;
+  out_exp += in2.exp;
+}
+
+/**
+ * \brief Block floating point multiply and add
+ * \ingroup nvhls_vector
+ *
+ * \par Overview
+ * out[i] = in1[i] * in2[i] + in3[i]. The exact products, at exponent
+ * in1.exp + in2.exp, and in3 are aligned to the larger of the two exponents
+ * with nvhls::right_shift (truncating toward zero), added, and the sums are
+ * requantized to one shared output exponent. The error per element is under
+ * two units at the aligned exponent plus one unit at out.exp.
+ *
+ * \par A Simple Example
+ * \code
+ *      nv_bfp_vector<8, 8, 16> a, w, acc;
+ *      nvhls::vector_mac(a, w, acc, acc);
+ * \endcode
+ * \par
+ *
+ */
+template <unsigned int MantW, unsigned int ExpW, unsigned int BlockSize>
+void vector_mac(const nv_bfp_vector<MantW, ExpW, BlockSize>& in1,
+                const nv_bfp_vector<MantW, ExpW, BlockSize>& in2,
+                const nv_bfp_vector<MantW, ExpW, BlockSize>& in3,
+                nv_bfp_vector<MantW, ExpW, BlockSize>& out) {
+  typedef nv_bfp_vector<MantW, ExpW, BlockSize> Vec;
+  // Magnitudes of the products, and of the sums
+  const unsigned int ProdW = 2 * MantW;
+  const unsigned int SumW = ProdW + 1;
+  typedef NVINTW(ExpW + 2) AlignExp;
+
+  AlignExp prod_exp = in1.exp;
+  prod_exp += in2.exp;
+  AlignExp add_exp = in3.exp;
+  AlignExp max_exp = (prod_exp > add_exp) ? prod_exp : add_exp;
+  AlignExp prod_diff = max_exp - prod_exp;
+  AlignExp add_diff = max_exp - add_exp;
+  unsigned int prod_shift = prod_diff.to_uint();
+  unsigned int add_shift = add_diff.to_uint();
+  if (prod_shift > ProdW) {
+    prod_shift = ProdW;
+  }
+  if (add_shift > MantW) {
+    add_shift = MantW;
+  }
+
+  NVUINTW(SumW) mag[BlockSize];
+  bool neg[BlockSize];
+#pragma hls_unroll yes
+  for (unsigned i = 0; i < BlockSize; i++) {
+    NVUINTW(ProdW) p = in1.mant[i] * in2.mant[i];
+    p = right_shift(p, prod_shift);
+    typename Vec::Mant c = right_shift(in3.mant[i], add_shift);
+    NVINTW(SumW + 1) sum = p;
+    if (in1.sign[i] != in2.sign[i]) {
+      sum = -sum;
+    }
+    if (in3.sign[i]) {
+      sum -= c;
+    } else {
+      sum += c;
+    }
+    neg[i] = (sum < 0);
+    if (neg[i]) {
+      sum = -sum;
+    }
+    mag[i] = sum;
+  }
+  out.template set_block<SumW>(mag, neg, max_exp);
+}
+
+}  // namespace nvhls
+
+#endif  // NVHLS_BFP_VECTOR_H
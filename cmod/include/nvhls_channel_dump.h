@@ -0,0 +1,431 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_CHANNEL_DUMP_H
+#define NVHLS_CHANNEL_DUMP_H
+
+#ifndef __SYNTHESIS__
+
+#include <systemc.h>
+#include <hls_globals.h>
+#include <nvhls_trace_sink.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+namespace match {
+
+/**
+ * \brief Selective waveform dump of Connections channels.
+ * \ingroup nvhls_module
+ *
+ * \par Overview
+ * ChannelDump is a simulation-only module that writes the vld, rdy and dat
+ * signals of selected Connections channels to a VCD file, instead of every
+ * signal of the design. Channels are found at start of simulation like
+ * Watchdog finds them, as "<chan>_vld" and "<chan>_rdy" signal pairs, and the
+ * "<chan>_dat" signal next to them.
+ * - A channel is dumped if a glob pattern matches its name or the name of a
+ *   port bound to it, so "tb.dut.*" selects every channel of tb.dut. '*'
+ *   matches any string, including dots, and '?' any character. Patterns are
+ *   given with Select(), or as a comma-separated list in NVHLS_CHANNEL_DUMP,
+ *   which is added to them.
+ * - Signals are sampled on each clock edge and written only when they change,
+ *   and dat only while vld is high, so idle cycles cost nothing in the file.
+ * - A Marshall port dat is dumped as a bit vector. Other message types are
+ *   dumped as string variables, in the format of their operator<<.
+ * - Lines are formatted into chunks that a background thread writes out, so
+ *   the SystemC kernel does not wait on the file system.
+ * - TLM channels (SIM_MODE=2) have no vld/rdy signals and are not dumped.
+ *
+ * \par A Simple Example
+ * \code
+ *      SC_MODULE(testbench) {
+ *        sc_clock clk;
+ *        match::ChannelDump dump;
+ *        ...
+ *        SC_CTOR(testbench) : clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true), dump("dump", "arb.vcd") {
+ *          dump.clk(clk);
+ *          dump.Select("tb.soc.arbiter.*");
+ *          ...
+ *        }
+ *      };
+ * \endcode
+ * \par
+ *
+ */
+class ChannelDump : public sc_module {
+  SC_HAS_PROCESS(ChannelDump);
+
+ public:
+  sc_in_clk clk;
+
+  explicit ChannelDump(sc_module_name name, const std::string& filename = "channels.vcd")
+      : sc_module(name), clk("clk"), filename_(filename), file_(NULL), ring_(NULL), stop_(false),
+        started_(false), last_ticks_(0), last_stamp_(0), dumped_cycles_(0) {
+    const char* env = std::getenv("NVHLS_CHANNEL_DUMP");
+    if (env != NULL) {
+      std::stringstream ss(env);
+      std::string pattern;
+      while (std::getline(ss, pattern, ',')) {
+        if (!pattern.empty()) patterns_.push_back(pattern);
+      }
+    }
+
+    SC_METHOD(Tick);
+    sensitive << clk.pos();
+    dont_initialize();
+  }
+
+  ~ChannelDump() { Close(); }
+
+  // Adds a pattern; only effective before the start of simulation
+  void Select(const std::string& pattern) { patterns_.push_back(pattern); }
+
+  unsigned int NumChannels() const { return chans_.size(); }
+  // Cycles in which at least one dumped signal changed
+  uint64 DumpedCycles() const { return dumped_cycles_; }
+
+  // Writes out everything sampled so far and closes the file
+  void Close() {
+    if (file_ == NULL) {
+      return;
+    }
+    // The last values hold until the last clock edge
+    if (last_ticks_ > last_stamp_) buf_ += "#" + ToString(last_ticks_) + "\n";
+    Ship();
+    stop_.store(true);
+    writer_.join();
+    fclose(file_);
+    file_ = NULL;
+    delete ring_;
+    ring_ = NULL;
+  }
+
+  // '*' matches any string and '?' any one character
+  static bool GlobMatch(const char* pattern, const char* text) {
+    const char* star = NULL;
+    const char* resume = NULL;
+    while (*text) {
+      if (*pattern == '?' || *pattern == *text) {
+        pattern++;
+        text++;
+      } else if (*pattern == '*') {
+        star = pattern++;
+        resume = text;
+      } else if (star != NULL) {
+        pattern = star + 1;
+        text = ++resume;
+      } else {
+        return false;
+      }
+    }
+    while (*pattern == '*') pattern++;
+    return *pattern == 0;
+  }
+
+ protected:
+  struct Channel {
+    std::string name;
+    sc_signal_in_if<bool>* vld;
+    sc_signal_in_if<bool>* rdy;
+    sc_object* dat;
+    bool dat_bits;
+    unsigned int dat_width;
+    std::string id;
+    bool last_vld;
+    bool last_rdy;
+    std::string last_dat;
+
+    bool operator<(const Channel& other) const { return name < other.name; }
+  };
+
+  static const size_t kChunkBytes = 1 << 16;
+
+  std::string filename_;
+  std::vector<std::string> patterns_;
+  std::vector<Channel> chans_;
+  FILE* file_;
+  TraceRing* ring_;
+  std::atomic<bool> stop_;
+  std::thread writer_;
+  std::string buf_;
+  bool started_;
+  uint64 last_ticks_;
+  uint64 last_stamp_;
+  uint64 dumped_cycles_;
+
+  template <typename T>
+  static std::string ToString(const T& v) {
+    std::ostringstream os;
+    os << v;
+    return os.str();
+  }
+
+  static bool EndsWith(const std::string& s, const std::string& suffix) {
+    return s.size() > suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+  }
+
+  // "tb.a.out_vld" or "tb.a.out.vld" -> "tb.a.out"
+  static std::string Stem(const std::string& vld_name) {
+    return vld_name.substr(0, vld_name.size() - 4);
+  }
+
+  // VCD identifiers are strings of the printable characters '!' to '~'
+  static std::string VcdId(unsigned int n) {
+    std::string id;
+    do {
+      id += static_cast<char>('!' + n % 94);
+      n /= 94;
+    } while (n != 0);
+    return id;
+  }
+
+  static std::string DatValue(const sc_object* dat) {
+    std::ostringstream os;
+    dat->print(os);
+    return os.str();
+  }
+
+  static bool IsBits(const std::string& value) {
+    return !value.empty() && value.find_first_not_of("01XZxz") == std::string::npos;
+  }
+
+  static std::string DatLine(const Channel& c, std::string value) {
+    if (c.dat_bits) {
+      return "b" + value + " " + c.id + "2\n";
+    }
+    std::replace(value.begin(), value.end(), ' ', '_');
+    std::replace(value.begin(), value.end(), '\n', '_');
+    return "s" + value + " " + c.id + "2\n";
+  }
+
+  bool Selected(const std::string& chan, const std::vector<std::string>& ports) const {
+    for (unsigned int p = 0; p < patterns_.size(); p++) {
+      if (GlobMatch(patterns_[p].c_str(), chan.c_str())) return true;
+      for (unsigned int i = 0; i < ports.size(); i++) {
+        if (GlobMatch(patterns_[p].c_str(), ports[i].c_str())) return true;
+      }
+    }
+    return false;
+  }
+
+  void Collect(const std::vector<sc_object*>& objs, std::vector<sc_object*>& signals,
+               std::vector<sc_port_base*>& ports) {
+    for (unsigned int i = 0; i < objs.size(); i++) {
+      std::string name = objs[i]->name();
+      if (EndsWith(name, "_vld") || EndsWith(name, ".vld")) {
+        if (dynamic_cast<sc_signal_in_if<bool>*>(objs[i]) != NULL) {
+          signals.push_back(objs[i]);
+        } else if (sc_port_base* port = dynamic_cast<sc_port_base*>(objs[i])) {
+          ports.push_back(port);
+        }
+      }
+      Collect(objs[i]->get_child_objects(), signals, ports);
+    }
+  }
+
+  void start_of_simulation() {
+    if (patterns_.empty()) {
+      return;
+    }
+    std::vector<sc_object*> signals;
+    std::vector<sc_port_base*> ports;
+    Collect(sc_get_top_level_objects(), signals, ports);
+
+    for (unsigned int i = 0; i < signals.size(); i++) {
+      std::string vld_name = signals[i]->name();
+      std::string sep = vld_name.substr(vld_name.size() - 4, 1);
+      std::string rdy_name = vld_name.substr(0, vld_name.size() - 3) + "rdy";
+      sc_signal_in_if<bool>* rdy = dynamic_cast<sc_signal_in_if<bool>*>(sc_find_object(rdy_name.c_str()));
+      if (rdy == NULL) continue;
+      Channel c;
+      c.name = Stem(vld_name);
+      std::vector<std::string> bound;
+      sc_interface* itf = dynamic_cast<sc_interface*>(signals[i]);
+      for (unsigned int p = 0; p < ports.size(); p++) {
+        if (ports[p]->get_interface() == itf) bound.push_back(Stem(ports[p]->name()));
+      }
+      if (!Selected(c.name, bound)) continue;
+      c.vld = dynamic_cast<sc_signal_in_if<bool>*>(signals[i]);
+      c.rdy = rdy;
+      c.dat = sc_find_object((c.name + sep + "dat").c_str());
+      std::string value = c.dat ? DatValue(c.dat) : std::string();
+      // sc_signal<sc_lv<W> > prints as W bit characters
+      c.dat_bits = c.dat != NULL && IsBits(value) &&
+                   std::string(typeid(*c.dat).name()).find("sc_lv") != std::string::npos;
+      c.dat_width = c.dat_bits ? value.size() : 1;
+      c.last_vld = c.last_rdy = false;
+      chans_.push_back(c);
+    }
+    if (chans_.empty()) {
+      std::cerr << "Warning: " << name() << " found no signal-level channels to dump" << std::endl;
+      return;
+    }
+    std::sort(chans_.begin(), chans_.end());
+    file_ = fopen(filename_.c_str(), "w");
+    if (file_ == NULL) {
+      std::cerr << "Error: " << name() << " cannot open " << filename_ << std::endl;
+      chans_.clear();
+      return;
+    }
+    WriteHeader();
+    ring_ = new TraceRing(kChunkBytes * 16);
+    stop_.store(false);
+    writer_ = std::thread(&ChannelDump::Drain, this);
+  }
+
+  void end_of_simulation() { Close(); }
+
+  void WriteHeader() {
+    static const char* units[] = {"fs", "ps", "ns", "us", "ms", "s"};
+    uint64 tick = static_cast<uint64>(sc_get_time_resolution().to_seconds() * 1e15 + 0.5);
+    unsigned int unit = 0;
+    while (unit < 5 && tick % 1000 == 0) {
+      tick /= 1000;
+      unit++;
+    }
+    buf_ += "$version matchlib ChannelDump $end\n";
+    buf_ += "$timescale " + ToString(tick) + " " + units[unit] + " $end\n";
+    // One scope per level of the channel names, which are sorted
+    std::vector<std::string> open;
+    for (unsigned int i = 0; i < chans_.size(); i++) {
+      Channel& c = chans_[i];
+      c.id = VcdId(i);
+      std::vector<std::string> path;
+      std::stringstream ss(c.name);
+      std::string part;
+      while (std::getline(ss, part, '.')) path.push_back(part);
+      unsigned int common = 0;
+      while (common < open.size() && common < path.size() && open[common] == path[common]) common++;
+      for (unsigned int l = open.size(); l > common; l--) buf_ += "$upscope $end\n";
+      open.resize(common);
+      for (unsigned int l = common; l < path.size(); l++) {
+        buf_ += "$scope module " + path[l] + " $end\n";
+        open.push_back(path[l]);
+      }
+      // Identifiers of the three signals of a channel share the channel id
+      buf_ += "$var wire 1 " + c.id + "0 vld $end\n";
+      buf_ += "$var wire 1 " + c.id + "1 rdy $end\n";
+      if (c.dat != NULL) {
+        buf_ += c.dat_bits ? "$var wire " + ToString(c.dat_width) + " " + c.id + "2 dat $end\n"
+                           : "$var string 1 " + c.id + "2 dat $end\n";
+      }
+    }
+    for (unsigned int l = open.size(); l > 0; l--) buf_ += "$upscope $end\n";
+    buf_ += "$enddefinitions $end\n#0\n$dumpvars\n";
+    for (unsigned int i = 0; i < chans_.size(); i++) {
+      buf_ += "0" + chans_[i].id + "0\n0" + chans_[i].id + "1\n";
+    }
+    buf_ += "$end\n";
+    fwrite(buf_.data(), 1, buf_.size(), file_);
+    buf_.clear();
+  }
+
+  // The values seen at an edge were held since the previous edge
+  void Tick() {
+    if (file_ == NULL) {
+      return;
+    }
+    uint64 now = sc_time_stamp().value();
+    uint64 ticks = last_ticks_;
+    last_ticks_ = now;
+    if (!started_) {
+      started_ = true;
+      return;
+    }
+    bool stamped = false;
+    for (unsigned int i = 0; i < chans_.size(); i++) {
+      Channel& c = chans_[i];
+      bool vld = c.vld->read();
+      bool rdy = c.rdy->read();
+      std::string lines;
+      if (vld != c.last_vld) {
+        lines += (vld ? "1" : "0") + c.id + "0\n";
+        c.last_vld = vld;
+      }
+      if (rdy != c.last_rdy) {
+        lines += (rdy ? "1" : "0") + c.id + "1\n";
+        c.last_rdy = rdy;
+      }
+      if (vld && c.dat != NULL) {
+        std::string value = DatValue(c.dat);
+        if (value != c.last_dat) {
+          lines += DatLine(c, value);
+          c.last_dat = value;
+        }
+      }
+      if (lines.empty()) continue;
+      if (!stamped) {
+        buf_ += "#" + ToString(ticks) + "\n";
+        last_stamp_ = ticks;
+        stamped = true;
+      }
+      buf_ += lines;
+    }
+    if (stamped) dumped_cycles_++;
+    if (buf_.size() >= kChunkBytes) Ship();
+  }
+
+  void Ship() {
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(buf_.data());
+    size_t left = buf_.size();
+    while (left != 0) {
+      size_t n = std::min(left, ring_->Capacity());
+      while (!ring_->TryPush(data, n)) {
+        std::this_thread::yield();
+      }
+      data += n;
+      left -= n;
+    }
+    buf_.clear();
+  }
+
+  // Writer thread
+  void Drain() {
+    std::vector<unsigned char> buf(kChunkBytes);
+    while (true) {
+      bool stopping = stop_.load();
+      size_t n = ring_->Pop(&buf[0], buf.size());
+      if (n != 0) {
+        fwrite(&buf[0], 1, n, file_);
+      } else if (stopping) {
+        break;
+      } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
+    }
+    fflush(file_);
+  }
+
+ private:
+  ChannelDump(const ChannelDump&);
+  ChannelDump& operator=(const ChannelDump&);
+};
+
+}  // namespace match
+
+#endif  // __SYNTHESIS__
+
+#endif  // NVHLS_CHANNEL_DUMP_H
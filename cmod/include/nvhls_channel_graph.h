@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_CHANNEL_GRAPH_H
+#define NVHLS_CHANNEL_GRAPH_H
+
+#ifndef __SYNTHESIS__
+
+#include <systemc.h>
+
+#include <string>
+#include <vector>
+
+namespace match {
+
+/**
+ * \brief The signal-level Connections channels of an elaborated design.
+ * \ingroup nvhls_module
+ *
+ * \par Overview
+ * FindChannels() returns every channel of the design as the bool signal pair
+ * "<chan>_vld" and "<chan>_rdy" (or "<chan>.vld" and "<chan>.rdy"), with the
+ * innermost sc_out and sc_in ports bound to its vld signal, which are the
+ * ports of the processes that push to and pop from the channel, and the
+ * modules that own them. An end with no bound port, e.g. a channel the
+ * testbench drives directly, is "?".
+ * - The port bindings are only complete at the end of elaboration, so call it
+ *   from start_of_simulation() or later.
+ * - TLM channels (SIM_MODE=2) have no vld/rdy signals and are not found.
+ *
+ * \par A Simple Example
+ * \code
+ *      void start_of_simulation() {
+ *        std::vector<match::ChannelEnds> chans;
+ *        match::FindChannels(chans);
+ *        for (unsigned int i = 0; i < chans.size(); i++)
+ *          std::cout << chans[i].producer << " -> " << chans[i].consumer << std::endl;
+ *      }
+ * \endcode
+ * \par
+ *
+ */
+struct ChannelEnds {
+  std::string name;           // "tb.chan"
+  std::string producer;       // "tb.a"
+  std::string consumer;       // "tb.b"
+  std::string producer_port;  // "tb.a.out"
+  std::string consumer_port;  // "tb.b.in"
+  sc_signal_in_if<bool>* vld;
+  sc_signal_in_if<bool>* rdy;
+};
+
+namespace channel_graph {
+
+inline bool EndsWith(const std::string& s, const std::string& suffix) {
+  return s.size() > suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// "tb.a.out_vld" or "tb.a.out.vld" -> "tb.a.out"
+inline std::string Stem(const std::string& vld_name) {
+  return vld_name.substr(0, vld_name.size() - 4);
+}
+
+inline std::string Owner(const std::string& port) {
+  size_t dot = port.rfind('.');
+  return dot == std::string::npos ? port : port.substr(0, dot);
+}
+
+inline unsigned int Depth(const std::string& name) {
+  unsigned int depth = 0;
+  for (unsigned int i = 0; i < name.size(); i++) depth += (name[i] == '.');
+  return depth;
+}
+
+inline void Collect(const std::vector<sc_object*>& objs, std::vector<sc_object*>& signals,
+                    std::vector<sc_port_base*>& ports) {
+  for (unsigned int i = 0; i < objs.size(); i++) {
+    std::string name = objs[i]->name();
+    if (EndsWith(name, "_vld") || EndsWith(name, ".vld")) {
+      if (dynamic_cast<sc_signal_in_if<bool>*>(objs[i]) != NULL) {
+        signals.push_back(objs[i]);
+      } else if (sc_port_base* port = dynamic_cast<sc_port_base*>(objs[i])) {
+        ports.push_back(port);
+      }
+    }
+    Collect(objs[i]->get_child_objects(), signals, ports);
+  }
+}
+
+}  // namespace channel_graph
+
+inline void FindChannels(std::vector<ChannelEnds>& chans) {
+  using namespace channel_graph;
+  std::vector<sc_object*> signals;
+  std::vector<sc_port_base*> ports;
+  Collect(sc_get_top_level_objects(), signals, ports);
+
+  for (unsigned int i = 0; i < signals.size(); i++) {
+    std::string vld_name = signals[i]->name();
+    std::string rdy_name = vld_name.substr(0, vld_name.size() - 3) + "rdy";
+    sc_signal_in_if<bool>* rdy = dynamic_cast<sc_signal_in_if<bool>*>(sc_find_object(rdy_name.c_str()));
+    if (rdy == NULL) continue;
+    ChannelEnds c;
+    c.name = Stem(vld_name);
+    c.vld = dynamic_cast<sc_signal_in_if<bool>*>(signals[i]);
+    c.rdy = rdy;
+    // The innermost ports bound to the channel are the ones a process drives
+    sc_interface* itf = dynamic_cast<sc_interface*>(signals[i]);
+    for (unsigned int p = 0; p < ports.size(); p++) {
+      if (ports[p]->get_interface() != itf) continue;
+      std::string port = Stem(ports[p]->name());
+      std::string& end = (std::string(ports[p]->kind()) == "sc_out") ? c.producer_port : c.consumer_port;
+      if (end.empty() || Depth(port) > Depth(end)) end = port;
+    }
+    c.producer = c.producer_port.empty() ? "?" : Owner(c.producer_port);
+    c.consumer = c.consumer_port.empty() ? "?" : Owner(c.consumer_port);
+    chans.push_back(c);
+  }
+}
+
+}  // namespace match
+
+#endif  // __SYNTHESIS__
+
+#endif  // NVHLS_CHANNEL_GRAPH_H
@@ -32,5 +32,6 @@
 
 #include <nvhls_connections_buffered_ports.h>
 #include <nvhls_connections_network.h>
+#include <nvhls_connections_vector.h>
 
 #endif // ifndef NVHLS_CONNECTIONS_H_
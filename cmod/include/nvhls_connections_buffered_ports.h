@@ -33,11 +33,15 @@ namespace Connections {
 template <typename Message, int BufferSize = 1, connections_port_t port_marshall_type = AUTO_PORT>
 class InBuffered : public InBlocking<Message, port_marshall_type> {
   FIFO<Message, BufferSize> fifo;
+  match::PortStats stats_;
 
  public:
-   InBuffered() : InBlocking<Message, port_marshall_type>(), fifo() {}
+   InBuffered() : InBlocking<Message, port_marshall_type>(), fifo(), stats_(BufferSize) {}
 
-  explicit InBuffered(const char* name) : InBlocking<Message, port_marshall_type>(name), fifo() {}
+  explicit InBuffered(const char* name) : InBlocking<Message, port_marshall_type>(name), fifo(), stats_(BufferSize, name) {}
+
+  // Transfer statistics; counted once registered with match::Module::RegisterPortStats()
+  match::PortStats& Stats() { return stats_; }
 
   void Reset() {
     InBlocking<Message,port_marshall_type>::Reset();
@@ -54,24 +58,36 @@ class InBuffered : public InBlocking<Message, port_marshall_type> {
   Message Peek() { return fifo.peek(); }
 
   void TransferNB() {
-
-    if (!fifo.isFull()) {
+    bool full = fifo.isFull();
+    bool transferred = false;
+    if (!full) {
       Message dat;
       if (this->PopNB(dat)) {
         fifo.push(dat);
+        transferred = true;
       }
     }
+#ifndef __SYNTHESIS__
+    if (stats_.IsEnabled()) {
+      stats_.Sample(fifo.NumFilled().to_uint(), transferred, full);
+      if (transferred) stats_.Arrive();
+    }
+#endif
   }
 };
 
 template <typename Message, int BufferSize = 1, connections_port_t port_marshall_type = AUTO_PORT>
 class OutBuffered : public OutBlocking<Message, port_marshall_type> {
   FIFO<Message, BufferSize> fifo;
+  match::PortStats stats_;
   typedef NVUINTW(nvhls::index_width<BufferSize+1>::val) AddressPlusOne;
  public:
-  OutBuffered() : OutBlocking<Message, port_marshall_type>(), fifo() {}
+  OutBuffered() : OutBlocking<Message, port_marshall_type>(), fifo(), stats_(BufferSize) {}
+
+  explicit OutBuffered(const char* name) : OutBlocking<Message, port_marshall_type>(name), fifo(), stats_(BufferSize, name) {}
 
-  explicit OutBuffered(const char* name) : OutBlocking<Message, port_marshall_type>(name), fifo() {}
+  // Transfer statistics; counted once registered with match::Module::RegisterPortStats()
+  match::PortStats& Stats() { return stats_; }
 
   void Reset() {
     OutBlocking<Message,port_marshall_type>::Reset();
@@ -88,16 +104,119 @@ class OutBuffered : public OutBlocking<Message, port_marshall_type> {
   void Push(const Message& dat) { fifo.push(dat); }
 
   void TransferNB() {
-    if (!fifo.isEmpty()) {
+    bool offered = !fifo.isEmpty();
+    bool transferred = false;
+    if (offered) {
       Message dat = fifo.peek();
       if (this->PushNB(dat)) {
         fifo.pop();
+        transferred = true;
       }
     }
+#ifndef __SYNTHESIS__
+    if (stats_.IsEnabled()) {
+      stats_.Sample(fifo.NumFilled().to_uint(), transferred, offered && !transferred);
+      if (transferred) stats_.Depart();
+    }
+#endif
   }
 };
 
 
+//------------------------------------------------------------------------
+// CreditedIn / CreditedOut
+//------------------------------------------------------------------------
+
+// Credit-based flow control for any channel. CreditedOut starts with Credits
+// credits and spends one per message; CreditedIn buffers up to Credits
+// messages and returns one credit on its credit port per message the module
+// consumes. The sender never has more messages in flight than the receiver
+// has free entries, so the data channel is always accepted and a pipelined
+// link (e.g. PipelineN) runs at line rate once Credits covers the round trip
+// of the data and credit channels.
+//
+// Both sides call TransferNB() once per cycle. Bind the data port as usual and
+// the credit ports to a Connections channel of bool between the two.
+template <typename Message, int Credits, connections_port_t port_marshall_type = AUTO_PORT>
+class CreditedIn : public InBuffered<Message, Credits, port_marshall_type> {
+  typedef InBuffered<Message, Credits, port_marshall_type> Base;
+  typedef NVUINTW(nvhls::index_width<Credits+1>::val) CreditCount;
+  CreditCount owed;
+
+ public:
+  Out<bool, port_marshall_type> credit;
+
+  CreditedIn() : Base(), owed(0), credit() {}
+
+  explicit CreditedIn(const char* name)
+      : Base(name), owed(0), credit(CONNECTIONS_CONCAT(name, "credit")) {}
+
+  void Reset() {
+    Base::Reset();
+    credit.Reset();
+    owed = 0;
+  }
+
+  Message Pop() {
+    owed++;
+    return Base::Pop();
+  }
+
+  void IncrHead() {
+    owed++;
+    Base::IncrHead();
+  }
+
+  void TransferNB() {
+    Base::TransferNB();
+    if (owed != 0 && credit.PushNB(true)) {
+      owed--;
+    }
+  }
+};
+
+template <typename Message, int Credits, connections_port_t port_marshall_type = AUTO_PORT>
+class CreditedOut : public OutBlocking<Message, port_marshall_type> {
+  typedef OutBlocking<Message, port_marshall_type> Base;
+  typedef NVUINTW(nvhls::index_width<Credits+1>::val) CreditCount;
+  CreditCount credits;
+
+ public:
+  In<bool, port_marshall_type> credit;
+
+  CreditedOut() : Base(), credits(Credits), credit() {}
+
+  explicit CreditedOut(const char* name)
+      : Base(name), credits(Credits), credit(CONNECTIONS_CONCAT(name, "credit")) {}
+
+  void Reset() {
+    Base::Reset();
+    credit.Reset();
+    credits = Credits;
+  }
+
+  // Full: no credit left
+  bool Full() { return credits == 0; }
+
+  CreditCount NumCredits() { return credits; }
+
+  bool PushNB(const Message& dat) {
+    if (credits != 0 && Base::PushNB(dat)) {
+      credits--;
+      return true;
+    }
+    return false;
+  }
+
+  // Collect a returned credit; call before PushNB() in the same cycle.
+  void TransferNB() {
+    bool c;
+    if (credit.PopNB(c)) {
+      credits++;
+    }
+  }
+};
+
 //------------------------------------------------------------------------
 // Helper class for Bypass and Pipeline
 //------------------------------------------------------------------------
@@ -452,6 +571,163 @@ class Pipeline<Message, TLM_PORT> : public Pipeline<Message, DIRECT_PORT>
  Pipeline(sc_module_name name) : Pipeline<Message, DIRECT_PORT>(name) {}
 };
 
+//------------------------------------------------------------------------
+// PipelineN
+//------------------------------------------------------------------------
+
+// Depth chained Pipeline stages in one module: the same registers and the
+// same cycle behavior as Depth Pipelines bound back to back, with one
+// sequential process instead of one module per stage.
+template <typename Message, unsigned int Depth, connections_port_t port_marshall_type = AUTO_PORT>
+class PipelineN : public sc_module {
+  SC_HAS_PROCESS(PipelineN);
+
+ public:
+  static const int kDebugLevel = 3;
+  // Interface
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  In<Message, port_marshall_type> enq;
+  Out<Message, port_marshall_type> deq;
+
+  PipelineN()
+      : sc_module(sc_module_name(sc_gen_unique_name("byp"))),
+        clk("clk"),
+        rst("rst") {
+    Init();
+  }
+
+  PipelineN(sc_module_name name) : sc_module(name), clk("clk"), rst("rst") {
+    Init();
+  }
+
+ protected:
+  typedef NVUINTW(Depth) FullBits;
+
+  // Internal state: stage i is full[i], Depth-1 is the output stage
+  sc_signal<FullBits> full;
+  StateSignal<Message, port_marshall_type> state[Depth];
+
+  // Helper functions
+  void Init() {
+#ifdef CONNECTIONS_SIM_ONLY
+    enq.disable_spawn();
+    deq.disable_spawn();
+#endif
+
+    SC_METHOD(EnqRdy);
+    sensitive << full << deq.rdy;
+
+    SC_METHOD(DeqVld);
+    sensitive << full;
+
+    SC_METHOD(DeqMsg);
+    sensitive << state[Depth - 1].dat;
+
+    SC_THREAD(Seq);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  // Combinational logic
+
+  // Enqueue ready if some stage from the input onward is empty, or if the
+  // outgoing channel is ready: the ready chain of the chained Pipelines.
+  void EnqRdy() {
+    FullBits f = full.read();
+    bool rdy = deq.rdy.read();
+#pragma hls_unroll yes
+    for (int i = Depth - 1; i >= 0; i--) {
+      rdy = !f[i] || rdy;
+    }
+    enq.rdy.write(rdy);
+  }
+
+  // Dequeue valid if the output stage is set.
+  void DeqVld() {
+    FullBits f = full.read();
+    deq.vld.write(f[Depth - 1]);
+  }
+
+  // Dequeue Msg is from the output stage.
+  void DeqMsg() { deq.dat.write(state[Depth - 1].dat.read()); }
+
+  // Sequential logic
+  void Seq() {
+    // Reset state
+    full.write(0);
+#pragma hls_unroll yes
+    for (unsigned int i = 0; i < Depth; ++i)
+      state[i].reset_state();
+
+    wait();
+
+    while (1) {
+      FullBits f = full.read();
+      FullBits f_next = f;
+      // Walk from the output stage back; rdy is the ready seen by stage i.
+      bool rdy = deq.rdy.read();
+#pragma hls_unroll yes
+      for (int i = Depth - 1; i >= 0; i--) {
+        bool vld_in = (i == 0) ? enq.vld.read() : static_cast<bool>(f[i - 1]);
+        if (vld_in && (!f[i] || rdy)) {
+          f_next[i] = 1;
+          if (i == 0) {
+            state[i].dat.write(enq.dat.read());
+          } else {
+            state[i].dat.write(state[i - 1].dat.read());
+          }
+        } else if (f[i] && rdy) {
+          f_next[i] = 0;
+        }
+        rdy = !f[i] || rdy;
+      }
+      full.write(f_next);
+      wait();
+    }
+  }
+
+#ifndef __SYNTHESIS__
+ public:
+  void line_trace() {
+    if (rst.read()) {
+      unsigned int width = (Message().length() / 4);
+      // Enqueue port
+      if (enq.vld.read() && enq.rdy.read()) {
+        CDCOUT(std::hex << std::setw(width) << enq.dat.read(), kDebugLevel);
+      } else {
+        CDCOUT(std::setw(width + 1) << " ", kDebugLevel);
+      }
+
+      CDCOUT(" ( ", kDebugLevel);
+      FullBits f = full.read();
+      for (unsigned int i = 0; i < Depth; i++) {
+        CDCOUT((f[i] ? 1 : 0), kDebugLevel);
+      }
+      CDCOUT(" ) ", kDebugLevel);
+
+      // Dequeue port
+      if (deq.vld.read() && deq.rdy.read()) {
+        CDCOUT(std::hex << std::setw(width) << deq.dat.read(), kDebugLevel);
+      } else {
+        CDCOUT(std::setw(width + 1) << " ", kDebugLevel);
+      }
+      CDCOUT(" | ", kDebugLevel);
+    }
+  }
+#endif
+};
+
+// Because of ports not existing in TLM_PORT and the code depending on it,
+// we remap to DIRECT_PORT here.
+template <typename Message, unsigned int Depth>
+class PipelineN<Message, Depth, TLM_PORT> : public PipelineN<Message, Depth, DIRECT_PORT>
+{
+ public:
+ PipelineN() : PipelineN<Message, Depth, DIRECT_PORT>() {}
+ PipelineN(sc_module_name name) : PipelineN<Message, Depth, DIRECT_PORT>(name) {}
+};
+
  
 //
 // NEW FEATURE: Buffered Bypass Channel.
@@ -459,6 +735,100 @@ class Pipeline<Message, TLM_PORT> : public Pipeline<Message, DIRECT_PORT>
 // W.r.t the Bypass it takes one more template parameter.
 // TODO: It may also work with depth = 1, but it hasn't been tested.
 
+//------------------------------------------------------------------------
+// Helper class for the TLM_PORT views of BypassBuffered and Buffer
+//------------------------------------------------------------------------
+
+// In TLM_PORT mode (CONNECTIONS_FAST_SIM) the enq/deq ports have no
+// vld/rdy/dat signals, so the channel is modeled with one clocked thread over
+// a local FIFO, using PopNB()/PushNB() once per cycle:
+// - enq is ready when the FIFO was not full at the start of the cycle
+// - deq is offered the oldest entry; with IsBypass, a message arriving at an
+//   empty FIFO is offered in the same cycle
+// NumCycles(), NumEnqueued() and NumDequeued() count since reset, for
+// throughput estimates.
+template <typename Message, unsigned int NumEntries, bool IsBypass>
+class BufferedChannelTLM : public sc_module {
+  SC_HAS_PROCESS(BufferedChannelTLM);
+
+ public:
+  static const int kDebugLevel = 3;
+  // Interface
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  In<Message, TLM_PORT> enq;
+  Out<Message, TLM_PORT> deq;
+
+  BufferedChannelTLM(sc_module_name name)
+      : sc_module(name), clk("clk"), rst("rst"), cycles(0), num_enq(0), num_deq(0),
+        stats_(NumEntries) {
+    stats_.SetName(this->name());
+    SC_THREAD(Seq);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  uint64 NumCycles() const { return cycles; }
+  uint64 NumEnqueued() const { return num_enq; }
+  uint64 NumDequeued() const { return num_deq; }
+  match::PortStats& Stats() { return stats_; }
+
+  void line_trace() {
+    if (rst.read()) {
+      CDCOUT(" ( " << fifo.NumFilled() << " ) | ", kDebugLevel);
+    }
+  }
+
+ protected:
+  FIFO<Message, NumEntries> fifo;
+  uint64 cycles;
+  uint64 num_enq;
+  uint64 num_deq;
+  match::PortStats stats_;
+
+  void Seq() {
+    enq.Reset();
+    deq.Reset();
+    fifo.reset();
+    cycles = num_enq = num_deq = 0;
+
+    wait();
+
+    while (1) {
+      cycles++;
+      bool was_full = fifo.isFull();
+      bool was_empty = fifo.isEmpty();
+      Message msg;
+      unsigned int filled = fifo.NumFilled().to_uint();
+      bool got = !was_full && enq.PopNB(msg);
+      if (got) {
+        num_enq++;
+      }
+      if (stats_.IsEnabled()) {
+        // The TLM port does not show a waiting producer: count every full cycle
+        stats_.Sample(filled, got, was_full);
+      }
+
+      if (!was_empty) {
+        if (deq.PushNB(fifo.peek())) {
+          fifo.incrHead();
+          num_deq++;
+        }
+      } else if (IsBypass && got) {
+        if (deq.PushNB(msg)) {
+          got = false;
+          num_deq++;
+        }
+      }
+
+      if (got) {
+        fifo.push(msg);
+      }
+      wait();
+    }
+  }
+};
+
 //------------------------------------------------------------------------
 // BypassBuffered
 //------------------------------------------------------------------------
@@ -478,14 +848,18 @@ class BypassBuffered : public sc_module {
   BypassBuffered()
       : sc_module(sc_module_name(sc_gen_unique_name("byp"))),
         clk("clk"),
-        rst("rst") {
+        rst("rst"),
+        stats_(NumEntries) {
     Init();
   }
 
-  BypassBuffered(sc_module_name name) : sc_module(name), clk("clk"), rst("rst") {
+  BypassBuffered(sc_module_name name) : sc_module(name), clk("clk"), rst("rst"), stats_(NumEntries) {
     Init();
   }
 
+  // Occupancy of the entries and enq stalls on a full buffer; see match::PortStats
+  match::PortStats& Stats() { return stats_; }
+
  protected:
   typedef bool Bit;
   static const int AddrWidth = nvhls::nbits<NumEntries - 1>::val;
@@ -501,9 +875,11 @@ class BypassBuffered : public sc_module {
   sc_signal<BuffIdx> head;
   sc_signal<BuffIdx> tail;
   StateSignal<Message, port_marshall_type> buffer[NumEntries];
+  match::PortStats stats_;
 
   // Helper functions
   void Init() {
+    stats_.SetName(this->name());
 #ifdef CONNECTIONS_SIM_ONLY
     enq.disable_spawn();
     deq.disable_spawn();
@@ -636,6 +1012,13 @@ class BypassBuffered : public sc_module {
     wait();
 
     while (1) {
+#ifndef __SYNTHESIS__
+      if (stats_.IsEnabled()) {
+        unsigned int filled = full.read() ? NumEntries
+            : (head.read().to_uint() + NumEntries - tail.read().to_uint()) % NumEntries;
+        stats_.Sample(filled, enq.vld.read() && !full.read(), enq.vld.read() && full.read());
+      }
+#endif
 
       // Head update
       head.write(head_next);
@@ -684,14 +1067,16 @@ class BypassBuffered : public sc_module {
 #endif
 };
 
-// Because of ports not existing in TLM_PORT and the code depending on it,
-// we remap to DIRECT_PORT here.
+// TLM_PORT has no vld/rdy/dat signals: use the FIFO-backed thread model.
 template <typename Message, unsigned int NumEntries>
-class BypassBuffered<Message, NumEntries, TLM_PORT> : public BypassBuffered<Message, NumEntries, DIRECT_PORT>
+class BypassBuffered<Message, NumEntries, TLM_PORT>
+    : public BufferedChannelTLM<Message, NumEntries, true>
 {
  public:
- BypassBuffered() : BypassBuffered<Message, NumEntries, DIRECT_PORT>() {}
- BypassBuffered(sc_module_name name) : BypassBuffered<Message, NumEntries, DIRECT_PORT>(name) {}
+ BypassBuffered()
+     : BufferedChannelTLM<Message, NumEntries, true>(sc_gen_unique_name("byp")) {}
+ BypassBuffered(sc_module_name name)
+     : BufferedChannelTLM<Message, NumEntries, true>(name) {}
 };
 
  
@@ -714,14 +1099,18 @@ class Buffer : public sc_module {
   Buffer()
       : sc_module(sc_module_name(sc_gen_unique_name("buffer"))),
         clk("clk"),
-        rst("rst") {
+        rst("rst"),
+        stats_(NumEntries) {
     Init();
   }
 
-  Buffer(sc_module_name name) : sc_module(name), clk("clk"), rst("rst") {
+  Buffer(sc_module_name name) : sc_module(name), clk("clk"), rst("rst"), stats_(NumEntries) {
     Init();
   }
 
+  // Occupancy of the entries and enq stalls on a full buffer; see match::PortStats
+  match::PortStats& Stats() { return stats_; }
+
  protected:
   typedef bool Bit;
   static const int AddrWidth = nvhls::index_width<NumEntries>::val;
@@ -737,9 +1126,11 @@ class Buffer : public sc_module {
   sc_signal<BuffIdx> head;
   sc_signal<BuffIdx> tail;
   StateSignal<Message, port_marshall_type> buffer[NumEntries];
+  match::PortStats stats_;
 
   // Helper functions
   void Init() {
+    stats_.SetName(this->name());
 #ifdef CONNECTIONS_SIM_ONLY
     enq.disable_spawn();
     deq.disable_spawn();
@@ -865,6 +1256,14 @@ class Buffer : public sc_module {
     wait();
 
     while (1) {
+#ifndef __SYNTHESIS__
+      if (stats_.IsEnabled()) {
+        unsigned int filled = full.read() ? NumEntries
+            : (head.read().to_uint() + NumEntries - tail.read().to_uint()) % NumEntries;
+        stats_.Sample(filled, enq.vld.read() && !full.read(), enq.vld.read() && full.read());
+      }
+#endif
+
       // Head update
       head.write(head_next);
 
@@ -909,14 +1308,16 @@ class Buffer : public sc_module {
 #endif
 };
 
-// Because of ports not existing in TLM_PORT and the code depending on it,
-// we remap to DIRECT_PORT here.
+// TLM_PORT has no vld/rdy/dat signals: use the FIFO-backed thread model.
 template <typename Message, unsigned int NumEntries>
-class Buffer<Message, NumEntries, TLM_PORT> : public Buffer<Message, NumEntries, DIRECT_PORT>
+class Buffer<Message, NumEntries, TLM_PORT>
+    : public BufferedChannelTLM<Message, NumEntries, false>
 {
  public:
- Buffer() : Buffer<Message, NumEntries, DIRECT_PORT>() {}
- Buffer(sc_module_name name) : Buffer<Message, NumEntries, DIRECT_PORT>(name) {}
+ Buffer()
+     : BufferedChannelTLM<Message, NumEntries, false>(sc_gen_unique_name("buffer")) {}
+ Buffer(sc_module_name name)
+     : BufferedChannelTLM<Message, NumEntries, false>(name) {}
 };
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -1135,6 +1536,22 @@ class ChannelBinder {
     in(deq);
   }
 
+ // PipelineN (any depth) binding w/ clk and rst arguments.
+ ChannelBinder(InBlocking<Message>& in,
+	       OutBlocking<Message>& out,
+	       PipelineN<Message, NumEntries>& chan,
+	       sc_in_clk& clk, sc_in<bool>& rst)
+   : enq(sc_gen_unique_name("bind_enq")),
+    deq(sc_gen_unique_name("bind_deq")) {
+
+    out(enq);
+    chan.clk(clk);
+    chan.rst(rst);
+    chan.enq(enq);
+    chan.deq(deq);
+    in(deq);
+  }
+
  // Buffer binding w/ clk and rst arguments.
  ChannelBinder(InBlocking<Message>& in,
 	       OutBlocking<Message>& out,
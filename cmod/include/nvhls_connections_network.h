@@ -254,9 +254,18 @@ class OutNetwork : public sc_module {
 //------------------------------------------------------------------------
 // NOTE: Currently, the PacketIdWidth, DestWidthPerHop, MaxHops parameters
 // are assumed to be the same for a packet and a credit_packet
+//
+// Credits for dequeued messages are returned in one credit packet per
+// CreditBatch messages. Fewer are returned as soon as no message is waiting
+// at enq, so the sender never waits on credits held back here. With the
+// default CreditBatch of 1 a credit packet leaves on every dequeue. The
+// sender needs at least CreditBatch credits, plus the credit round trip for
+// full throughput, and CreditWidth must hold the larger of init_credits and
+// CreditBatch.
 
 template <typename Message, unsigned int DestWidthPerHop, unsigned int MaxHops,
-          unsigned int PacketIdWidth, unsigned int CreditWidth>
+          unsigned int PacketIdWidth, unsigned int CreditWidth,
+          unsigned int CreditBatch = 1>
 class InNetworkCredit : public sc_module {
   SC_HAS_PROCESS(InNetworkCredit);
 
@@ -270,6 +279,8 @@ class InNetworkCredit : public sc_module {
   typedef Packet<CreditWidth, DestWidthPerHop, MaxHops, PacketIdWidth>
       CreditPacket_t;
   typedef sc_lv<CreditWidth> Credit_t;
+  static_assert(CreditBatch >= 1 && (CreditWidth >= 32 || CreditBatch < (1u << CreditWidth)),
+                "CreditWidth cannot hold CreditBatch");
 
   // Interface
   sc_in_clk clk;
@@ -343,7 +354,7 @@ class InNetworkCredit : public sc_module {
               << credits;
 
     SC_METHOD(AssignCreditVal);
-    sensitive << deq._VLDNAME_ << deq._RDYNAME_ << credits;
+    sensitive << deq._VLDNAME_ << deq._RDYNAME_ << enq._VLDNAME_ << credits;
 
     SC_THREAD(UpdateCredit);
     sensitive << clk.pos();
@@ -398,7 +409,10 @@ class InNetworkCredit : public sc_module {
 
   void AssignCreditVal() {
     bool do_deq = deq._VLDNAME_.read() && deq._RDYNAME_.read();
-    if (do_deq || (credits.read() != 0)) {
+    unsigned int pending = credits.read().to_uint() + (do_deq ? 1 : 0);
+    // hold credits back while a batch builds up behind waiting messages
+    bool flush = (pending >= CreditBatch) || !enq._VLDNAME_.read();
+    if ((pending != 0) && flush) {
       credit_enq._VLDNAME_.write(1);
     } else {
       credit_enq._VLDNAME_.write(0);
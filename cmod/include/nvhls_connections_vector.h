@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//========================================================================
+// nvhls_connections_vector.h
+//========================================================================
+
+#ifndef NVHLS_CONNECTIONS_VECTOR_H_
+#define NVHLS_CONNECTIONS_VECTOR_H_
+
+#include <systemc.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_array.h>
+#include <nvhls_message.h>
+#include <nvhls_marshaller.h>
+
+// Marshaller traits of nv_array: element 0 at the least significant bits
+template <typename Type, unsigned int VectorLength>
+class Wrapped<nvhls::nv_array<Type, VectorLength> > {
+ public:
+  nvhls::nv_array<Type, VectorLength> val;
+  Wrapped() {}
+  Wrapped(const nvhls::nv_array<Type, VectorLength>& v) : val(v) {}
+  static const unsigned int width = VectorLength * Wrapped<Type>::width;
+  static const bool is_signed = false;
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+#pragma hls_unroll yes
+    for (unsigned int i = 0; i < VectorLength; i++) {
+      m& val[i];
+    }
+  }
+};
+
+namespace Connections {
+
+//------------------------------------------------------------------------
+// VectorMessage
+//------------------------------------------------------------------------
+
+// Up to N messages moved by one handshake: data[i] is valid when bit i of
+// valid is set, and the other lanes are don't-care. valid occupies the
+// least significant bits, followed by data[0] to data[N-1].
+template <typename Message, unsigned int N>
+class VectorMessage : public nvhls_message {
+  static_assert(N > 0, "A vector must have at least one lane");
+
+ public:
+  typedef NVUINTW(N) Mask;
+  typedef nvhls::nv_array<Message, N> Data;
+
+  Mask valid;
+  Data data;
+  static const unsigned int width = N + Wrapped<Data>::width;
+
+  VectorMessage() : valid(0) {}
+
+  VectorMessage(const Message d[N], const Mask& v) : valid(v) {
+#pragma hls_unroll yes
+    for (unsigned int i = 0; i < N; i++) {
+      data[i] = d[i];
+    }
+  }
+
+  void Get(Message d[N]) const {
+#pragma hls_unroll yes
+    for (unsigned int i = 0; i < N; i++) {
+      d[i] = data[i];
+    }
+  }
+
+  // Number of valid lanes
+  unsigned int Count() const { return nvhls::count_ones<N>(valid); }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m& valid;
+    m& data;
+  }
+};
+
+//------------------------------------------------------------------------
+// VectorIn / VectorOut / VectorCombinational
+//------------------------------------------------------------------------
+
+// Ports and channel of a VectorMessage. In place of N lanes of In/Out, each
+// with its own handshake, signals and simulation processes, one handshake
+// moves any subset of N messages over a single wide interface. The plain
+// Push()/Pop() of the VectorMessage remain available; the overloads below
+// take the lanes as an array and the valid mask separately. Pop() of an
+// empty vector returns a zero mask.
+template <typename Message, unsigned int N, connections_port_t port_marshall_type = AUTO_PORT>
+class VectorOut : public Out<VectorMessage<Message, N>, port_marshall_type> {
+  typedef Out<VectorMessage<Message, N>, port_marshall_type> Base;
+
+ public:
+  typedef VectorMessage<Message, N> Vector;
+  typedef typename Vector::Mask Mask;
+
+  VectorOut() : Base() {}
+
+  explicit VectorOut(const char* name) : Base(name) {}
+
+  using Base::Push;
+  using Base::PushNB;
+
+  // Sends data[i] for each bit i set in valid
+  void Push(const Message data[N], const Mask& valid) { Base::Push(Vector(data, valid)); }
+
+  bool PushNB(const Message data[N], const Mask& valid) {
+    return Base::PushNB(Vector(data, valid));
+  }
+};
+
+template <typename Message, unsigned int N, connections_port_t port_marshall_type = AUTO_PORT>
+class VectorIn : public In<VectorMessage<Message, N>, port_marshall_type> {
+  typedef In<VectorMessage<Message, N>, port_marshall_type> Base;
+
+ public:
+  typedef VectorMessage<Message, N> Vector;
+  typedef typename Vector::Mask Mask;
+
+  VectorIn() : Base() {}
+
+  explicit VectorIn(const char* name) : Base(name) {}
+
+  using Base::Pop;
+  using Base::PopNB;
+
+  // Receives the lanes into data and returns their valid mask
+  Mask Pop(Message data[N]) {
+    Vector v = Base::Pop();
+    v.Get(data);
+    return v.valid;
+  }
+
+  bool PopNB(Message data[N], Mask& valid) {
+    Vector v;
+    bool popped = Base::PopNB(v);
+    v.Get(data);
+    valid = popped ? v.valid : Mask(0);
+    return popped;
+  }
+};
+
+template <typename Message, unsigned int N, connections_port_t port_marshall_type = AUTO_PORT>
+class VectorCombinational : public Combinational<VectorMessage<Message, N>, port_marshall_type> {
+  typedef Combinational<VectorMessage<Message, N>, port_marshall_type> Base;
+
+ public:
+  VectorCombinational() : Base() {}
+
+  explicit VectorCombinational(const char* name) : Base(name) {}
+};
+
+}  // namespace Connections
+
+#endif  // NVHLS_CONNECTIONS_VECTOR_H_
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_DEBUG_H
+#define NVHLS_DEBUG_H
+
+#ifndef __SYNTHESIS__
+
+#include <systemc.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace match {
+
+/**
+ * \brief Runtime debug levels of CDCOUT, per module instance.
+ * \ingroup DebugPrint
+ *
+ * \par Overview
+ * CDCOUT(x, y) prints when y is at most the compile-time DEBUG_LEVEL, or at
+ * most the runtime level of the module whose process executes it. Runtime
+ * levels are set by rules matching a glob ('*' and '?') against the
+ * hierarchical module name; the last matching rule wins, and modules with no
+ * matching rule have level 0.
+ * - NVHLS_DEBUG holds comma separated "glob=level" rules. A plain "level" is
+ *   short for "*=level".
+ * - NVHLS_DEBUG_FILE names a file of "glob level" lines, read before
+ *   NVHLS_DEBUG. Lines starting with '#' are comments.
+ * - SetLevel() adds a rule from the model.
+ *
+ * Levels are resolved and cached once per process, so an enabled CDCOUT costs
+ * a cache lookup. Without any rule a CDCOUT above DEBUG_LEVEL costs a single
+ * branch on Active() and never builds its message.
+ *
+ * \par A Simple Example
+ * \code
+ *      // Trace one arbiter at level 3, everything else at the compile-time level
+ *      NVHLS_DEBUG='tb.dut.arbiter*=3' ./sim_sc
+ *
+ *      // or in sc_main
+ *      match::DebugLevels::Instance().SetLevel("tb.dut.arbiter*", 3);
+ * \endcode
+ * \par
+ *
+ */
+class DebugLevels {
+ public:
+  static DebugLevels& Instance() {
+    static DebugLevels levels;
+    return levels;
+  }
+
+  // True once any rule is set; read by CDCOUT before anything else.
+  static bool Active() {
+    (void)&State<0>::loader;  // odr-use, so that the rules are read before sc_main
+    return State<0>::active;
+  }
+
+  void SetLevel(const std::string& glob, int level) {
+    Rule rule;
+    rule.glob = glob;
+    rule.level = level;
+    rules_.push_back(rule);
+    cache_.clear();
+    last_proc_ = NULL;
+    State<0>::active = true;
+  }
+
+  void Clear() {
+    rules_.clear();
+    cache_.clear();
+    last_proc_ = NULL;
+    State<0>::active = false;
+  }
+
+  // Level of the module with hierarchical name nm.
+  int LevelOf(const char* nm) const {
+    int level = 0;
+    for (unsigned i = 0; i < rules_.size(); i++) {
+      if (GlobMatch(rules_[i].glob.c_str(), nm)) {
+        level = rules_[i].level;
+      }
+    }
+    return level;
+  }
+
+  // Level of the module of the running process, or of the top (empty name)
+  // outside simulation.
+  int Current() {
+    sc_process_handle h;
+    if (sc_is_running()) {
+      h = sc_get_current_process_handle();
+    }
+    const sc_object* proc = h.valid() ? h.get_process_object() : NULL;
+    if (proc == last_proc_ && proc != NULL) {
+      return last_level_;
+    }
+    int level;
+    if (proc == NULL) {
+      level = LevelOf("");
+    } else {
+      std::unordered_map<const sc_object*, int>::const_iterator it = cache_.find(proc);
+      if (it != cache_.end()) {
+        level = it->second;
+      } else {
+        const sc_object* parent = h.get_parent_object();
+        level = LevelOf(parent ? parent->name() : "");
+        cache_[proc] = level;
+      }
+    }
+    last_proc_ = proc;
+    last_level_ = level;
+    return level;
+  }
+
+  static bool GlobMatch(const char* glob, const char* s) {
+    const char* star = NULL;
+    const char* retry = NULL;
+    while (*s) {
+      if (*glob == '*') {
+        star = glob++;
+        retry = s;
+      } else if (*glob == '?' || *glob == *s) {
+        glob++;
+        s++;
+      } else if (star) {
+        glob = star + 1;
+        s = ++retry;
+      } else {
+        return false;
+      }
+    }
+    while (*glob == '*') {
+      glob++;
+    }
+    return *glob == 0;
+  }
+
+ private:
+  struct Rule {
+    std::string glob;
+    int level;
+  };
+
+  struct Loader {
+    Loader() { Instance(); }
+  };
+
+  // Static members defined in this header, with no initialization order
+  // dependency for active.
+  template <int N>
+  struct State {
+    static bool active;
+    static Loader loader;
+  };
+
+  std::vector<Rule> rules_;
+  std::unordered_map<const sc_object*, int> cache_;
+  const sc_object* last_proc_;
+  int last_level_;
+
+  DebugLevels() : last_proc_(NULL), last_level_(0) {
+    const char* file = std::getenv("NVHLS_DEBUG_FILE");
+    if (file != NULL) {
+      std::ifstream in(file);
+      if (!in) {
+        std::cerr << "Warning: cannot open NVHLS_DEBUG_FILE " << file << std::endl;
+      }
+      std::string line;
+      while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string glob;
+        int level;
+        if ((fields >> glob) && glob[0] != '#' && (fields >> level)) {
+          SetLevel(glob, level);
+        }
+      }
+    }
+    const char* env = std::getenv("NVHLS_DEBUG");
+    if (env != NULL) {
+      std::istringstream rules(env);
+      std::string rule;
+      while (std::getline(rules, rule, ',')) {
+        size_t eq = rule.rfind('=');
+        std::string glob = (eq == std::string::npos) ? "*" : rule.substr(0, eq);
+        std::string level = (eq == std::string::npos) ? rule : rule.substr(eq + 1);
+        if (!glob.empty() && !level.empty()) {
+          SetLevel(glob, std::atoi(level.c_str()));
+        }
+      }
+    }
+  }
+
+  DebugLevels(const DebugLevels&);
+  DebugLevels& operator=(const DebugLevels&);
+};
+
+template <int N>
+bool DebugLevels::State<N>::active = false;
+
+template <int N>
+DebugLevels::Loader DebugLevels::State<N>::loader;
+
+}  // namespace match
+
+#endif  // __SYNTHESIS__
+
+#endif  // NVHLS_DEBUG_H
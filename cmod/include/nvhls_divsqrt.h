@@ -0,0 +1,539 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_DIVSQRT_H
+#define NVHLS_DIVSQRT_H
+
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <type_traits>
+
+/* Division, reciprocal and inverse square root as digit or Newton-Raphson
+ * steps, for II=1 pipelines.
+ *
+ * Every unit is a class of static functions: load() takes the inputs into a
+ * State, steps(s, first, last) runs steps [first, last), and unload() forms
+ * the outputs. compute() runs all steps at once; ArithPipelined registers
+ * the State between groups of steps. Both run the same code, so the
+ * pipelined result is the combinational one, bit for bit.
+ */
+
+namespace nvhls {
+
+/**
+ * \brief Radix-4 integer divider, with quotient and remainder
+ * \ingroup DivSqrt
+ *
+ * \tparam W        Width of dividend, divisor, quotient and remainder
+ * \tparam Signed   Signed operands, with the quotient rounded toward zero (default: false)
+ *
+ * \par Overview
+ * Each of the NumSteps = ceil(W/2) steps retires two quotient bits: it
+ * shifts two dividend bits into the partial remainder and compares it with
+ * the divisor times 1, 2 and 3 in parallel, so no step has to correct the
+ * one before it, as a non-restoring or SRT step would. The results are
+ * those of the C operators / and %, and also defined where those are not:
+ * - Division by zero gives a quotient of all ones and the dividend as
+ *   remainder.
+ * - With Signed, the most negative value divided by -1 gives itself, with
+ *   remainder 0.
+ * .
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_divsqrt.h>
+ *
+ *      ...
+ *      typedef nvhls::Divider<24> Div;
+ *      Div::In in;
+ *      Div::Out out;
+ *      in.n = sum;
+ *      in.d = count;
+ *      Div::compute(in, out);     // out.q = sum / count, out.r = sum % count
+ *      ...
+ *      // 12 steps, 3 per stage: Latency 3
+ *      nvhls::ArithPipelined<Div, 3> div;
+ *      div.run(in, in_valid, out, out_valid);
+ * \endcode
+ * \par
+ *
+ */
+template <unsigned int W, bool Signed = false>
+class Divider {
+ public:
+  typedef typename std::conditional<Signed, typename nvhls_t<W>::nvint_t,
+                                    typename nvhls_t<W>::nvuint_t>::type Data;
+  typedef typename nvhls_t<W>::nvuint_t Mag;
+  static const unsigned int NumSteps = (W + 1) / 2;
+  static const unsigned int NumBits = 2 * NumSteps;
+
+  struct In {
+    Data n;
+    Data d;
+  };
+  struct Out {
+    Data q;
+    Data r;
+  };
+  struct State {
+    // Dividend bits still to go, MSB first, and the quotient bits so far
+    typename nvhls_t<NumBits>::nvuint_t num;
+    Mag den;
+    typename nvhls_t<W + 2>::nvuint_t rem;
+    bool neg_q;
+    bool neg_r;
+  };
+
+  static void load(const In& in, State& s) {
+    bool neg_n = Signed && (in.n < 0);
+    bool neg_d = Signed && (in.d < 0);
+    Mag n = in.n;
+    Mag d = in.d;
+    if (neg_n) {
+      n = -in.n;
+    }
+    if (neg_d) {
+      d = -in.d;
+    }
+    s.num = n;
+    s.den = d;
+    s.rem = 0;
+    s.neg_q = (neg_n != neg_d) && (in.d != 0);
+    s.neg_r = neg_n;
+  }
+
+  static void steps(State& s, unsigned int first, unsigned int last) {
+#pragma hls_unroll yes
+    for (unsigned int k = 0; k < NumSteps; k++) {
+      if (k >= first && k < last) {
+        typedef typename nvhls_t<W + 2>::nvuint_t Rem;
+        Rem r = s.rem;
+        r = (r << 2) | Rem(get_slc<2>(s.num, NumBits - 2));
+        s.num = s.num << 2;
+        Rem d1 = s.den;
+        Rem d2 = d1 << 1;
+        Rem d3 = d1 + d2;
+        typename nvhls_t<2>::nvuint_t digit = 0;
+        if (r >= d3) {
+          digit = 3;
+          r = r - d3;
+        } else if (r >= d2) {
+          digit = 2;
+          r = r - d2;
+        } else if (r >= d1) {
+          digit = 1;
+          r = r - d1;
+        }
+        s.num = set_slc(s.num, digit, 0);
+        s.rem = r;
+      }
+    }
+  }
+
+  static void unload(const State& s, Out& out) {
+    Mag q = s.num;
+    Mag r = s.rem;
+    out.q = q;
+    out.r = r;
+    if (s.neg_q) {
+      out.q = -out.q;
+    }
+    if (s.neg_r) {
+      out.r = -out.r;
+    }
+  }
+
+  static void compute(const In& in, Out& out) {
+    State s;
+    load(in, s);
+    steps(s, 0, NumSteps);
+    unload(s, out);
+  }
+};
+
+// Smallest number of Newton-Raphson steps that take Seed bits to Bits bits
+template <unsigned int Bits, unsigned int Seed>
+struct nr_iterations {
+  static const unsigned int val =
+      (Seed >= Bits) ? 0 : 1 + nr_iterations<Bits, (Seed >= Bits ? Bits : 2 * Seed)>::val;
+};
+template <unsigned int Bits>
+struct nr_iterations<Bits, Bits> {
+  static const unsigned int val = 0;
+};
+
+// Compile-time seeds. The lookup tables are filled from these constant
+// expressions, so synthesis sees a table of constants.
+constexpr unsigned long long nr_isqrt(unsigned long long n, unsigned long long lo,
+                                      unsigned long long hi) {
+  return (lo >= hi) ? lo
+                    : ((((lo + hi + 1) / 2) * ((lo + hi + 1) / 2) <= n)
+                           ? nr_isqrt(n, (lo + hi + 1) / 2, hi)
+                           : nr_isqrt(n, lo, (lo + hi + 1) / 2 - 1));
+}
+
+template <typename Seed, unsigned int N>
+struct nr_seed_table {
+  template <typename T>
+  static void fill(T table[]) {
+    table[N - 1] = Seed::template entry<N - 1>::val;
+    nr_seed_table<Seed, N - 1>::fill(table);
+  }
+};
+template <typename Seed>
+struct nr_seed_table<Seed, 0> {
+  template <typename T>
+  static void fill(T table[]) {}
+};
+
+// Rounds a result y in (0.5, 1], with F fraction bits, to a W-bit mantissa
+// with its leading one at bit W-1, and lowers exp by one if y rounds to 1
+template <unsigned int W, unsigned int F, typename Y, typename Mant, typename Exp>
+inline void nr_round(const Y& y, Mant& mant, Exp& exp) {
+  typedef typename nvhls_t<W + 1>::nvuint_t Rounded;
+  Rounded r = (y + (Y(1) << (F - W - 1))) >> (F - W);
+  if (r[W] == 1) {
+    mant = r >> 1;
+    exp = exp - 1;
+  } else {
+    mant = r;
+  }
+}
+
+/**
+ * \brief Newton-Raphson reciprocal with a lookup-table seed
+ * \ingroup DivSqrt
+ *
+ * \tparam W            Width of the input and of the result mantissa
+ * \tparam LutBits      Mantissa bits that index the seed table (default: 6)
+ * \tparam Iterations   Newton-Raphson steps (default: enough for W bits)
+ *
+ * \par Overview
+ * Returns 1/x as a W-bit mantissa with its leading one at bit W-1 and an
+ * exponent: 1/x = mant * 2^-exp, to within about one unit of mant.
+ * - The first step normalizes x with nvhls::lzd to a in [1, 2) and looks up
+ *   a seed of LutBits+1 bits; each next step y = y * (2 - a * y) doubles the
+ *   correct bits. The steps keep W+3 fraction bits.
+ * - x = 0 gives mant of all ones and exp 0.
+ * .
+ * NumSteps is 1 + Iterations; see ArithPipelined.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_divsqrt.h>
+ *
+ *      ...
+ *      typedef nvhls::Reciprocal<16> Recip;
+ *      Recip::In in;
+ *      Recip::Out out;
+ *      in.x = count;
+ *      Recip::compute(in, out);   // 1/count = out.mant * 2^-out.exp
+ * \endcode
+ * \par
+ *
+ */
+template <unsigned int W, unsigned int LutBits = 6,
+          unsigned int Iterations = nr_iterations<W + 1, LutBits + 1>::val>
+class Reciprocal {
+ public:
+  static_assert(LutBits >= 1 && LutBits < W, "LutBits must be below W");
+  static const unsigned int F = W + 3;
+  static const unsigned int SeedBits = LutBits + 4;
+  static const unsigned int NumSteps = 1 + Iterations;
+  static const unsigned int ExpWidth = nbits<2 * W>::val;
+  typedef typename nvhls_t<W>::nvuint_t Mant;
+  typedef typename nvhls_t<ExpWidth>::nvuint_t Exp;
+  typedef typename nvhls_t<F + 1>::nvuint_t Fixed;
+
+  struct In {
+    Mant x;
+  };
+  struct Out {
+    Mant mant;
+    Exp exp;
+  };
+  struct State {
+    Mant a;    // W-1 fraction bits once normalized
+    Fixed y;   // F fraction bits
+    Exp exp;
+    bool zero;
+  };
+
+  // Seed for a in [1 + i/2^LutBits, 1 + (i+1)/2^LutBits): 1 over the midpoint
+  struct Seed {
+    template <unsigned int I>
+    struct entry {
+      static const unsigned long long den = (1ULL << (LutBits + 1)) + 2 * I + 1;
+      static const unsigned long long val =
+          (((1ULL << (LutBits + 1 + SeedBits)) + den / 2) / den) << (F - SeedBits);
+    };
+  };
+
+  static void load(const In& in, State& s) {
+    s.a = in.x;
+    s.y = 0;
+    s.exp = 0;
+    s.zero = (in.x == 0);
+  }
+
+  static void steps(State& s, unsigned int first, unsigned int last) {
+    if (first == 0 && last > 0) {
+      unsigned int lz = s.zero ? 0 : lzd(s.a);
+      s.a = s.a << lz;
+      s.exp = 2 * W - 1 - lz;
+      Fixed table[1 << LutBits];
+      nr_seed_table<Seed, (1 << LutBits)>::fill(table);
+      s.y = table[get_slc<LutBits>(s.a, W - 1 - LutBits).to_uint()];
+    }
+#pragma hls_unroll yes
+    for (unsigned int k = 1; k < NumSteps; k++) {
+      if (k >= first && k < last) {
+        typename nvhls_t<F + 2>::nvuint_t t = (s.a * s.y) >> (W - 1);
+        typename nvhls_t<F + 2>::nvuint_t e = (typename nvhls_t<F + 2>::nvuint_t(1) << (F + 1)) - t;
+        s.y = (s.y * e) >> F;
+      }
+    }
+  }
+
+  static void unload(const State& s, Out& out) {
+    out.exp = s.exp;
+    nr_round<W, F>(s.y, out.mant, out.exp);
+    if (s.zero) {
+      out.mant = ~Mant(0);
+      out.exp = 0;
+    }
+  }
+
+  static void compute(const In& in, Out& out) {
+    State s;
+    load(in, s);
+    steps(s, 0, NumSteps);
+    unload(s, out);
+  }
+};
+
+/**
+ * \brief Newton-Raphson inverse square root with a lookup-table seed
+ * \ingroup DivSqrt
+ *
+ * \tparam W            Width of the input and of the result mantissa
+ * \tparam LutBits      Mantissa bits that index the seed table (default: 6)
+ * \tparam Iterations   Newton-Raphson steps (default: enough for W bits)
+ *
+ * \par Overview
+ * Returns 1/sqrt(x) in the format of Reciprocal: 1/sqrt(x) = mant * 2^-exp,
+ * to within about one unit of mant.
+ * - The first step normalizes x to a * 2^e with e even and a in [1, 4),
+ *   and looks up a seed by a, with one table per half of the range; each
+ *   next step y = y * (3 - a * y^2) / 2 doubles the correct bits.
+ * - x = 0 gives mant of all ones and exp 0.
+ * .
+ * NumSteps is 1 + Iterations; see ArithPipelined.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_divsqrt.h>
+ *
+ *      ...
+ *      // 1/sqrt of the variance in a normalization layer
+ *      nvhls::ArithPipelined<nvhls::InvSqrt<24>, 1> rsqrt;
+ *      nvhls::InvSqrt<24>::In in;
+ *      nvhls::InvSqrt<24>::Out out;
+ *      in.x = variance;
+ *      rsqrt.run(in, in_valid, out, out_valid);
+ * \endcode
+ * \par
+ *
+ */
+template <unsigned int W, unsigned int LutBits = 6,
+          unsigned int Iterations = nr_iterations<W + 1, LutBits + 1>::val>
+class InvSqrt {
+ public:
+  static_assert(LutBits >= 1 && LutBits < W, "LutBits must be below W");
+  static const unsigned int F = W + 3;
+  static const unsigned int SeedBits = LutBits + 4;
+  static const unsigned int NumSteps = 1 + Iterations;
+  static const unsigned int ExpWidth = nbits<2 * W>::val;
+  typedef typename nvhls_t<W>::nvuint_t Mant;
+  typedef typename nvhls_t<ExpWidth>::nvuint_t Exp;
+  typedef typename nvhls_t<F + 1>::nvuint_t Fixed;
+
+  struct In {
+    Mant x;
+  };
+  struct Out {
+    Mant mant;
+    Exp exp;
+  };
+  struct State {
+    typename nvhls_t<W + 1>::nvuint_t a;   // W-1 fraction bits once normalized
+    Fixed y;                                // F fraction bits
+    Exp exp;
+    bool zero;
+  };
+
+  // Seed for entry I = odd * 2^LutBits + i: 1/sqrt of the midpoint of
+  // [1 + i/2^LutBits, 1 + (i+1)/2^LutBits), doubled if odd
+  struct Seed {
+    template <unsigned int I>
+    struct entry {
+      static const unsigned long long odd = I >> LutBits;
+      static const unsigned long long i = I & ((1ULL << LutBits) - 1);
+      static const unsigned long long den =
+          ((1ULL << (LutBits + 1)) + 2 * i + 1) * (1 + odd);
+      static const unsigned long long num = 1ULL << (2 * SeedBits + LutBits + 1);
+      static const unsigned long long val =
+          nr_isqrt(num / den, 0, 1ULL << SeedBits) << (F - SeedBits);
+    };
+  };
+
+  static void load(const In& in, State& s) {
+    s.a = in.x;
+    s.y = 0;
+    s.exp = 0;
+    s.zero = (in.x == 0);
+  }
+
+  static void steps(State& s, unsigned int first, unsigned int last) {
+    if (first == 0 && last > 0) {
+      Mant x = s.a;
+      unsigned int lz = s.zero ? 0 : lzd(x);
+      x = x << lz;
+      // x = a * 2^e, e = W-1-lz; an odd e moves a factor of 2 into a
+      bool odd = ((W - 1 - lz) & 1) == 1;
+      s.a = x;
+      if (odd) {
+        s.a = s.a << 1;
+      }
+      s.exp = W + (W - 1 - lz) / 2;
+      Fixed table[2 << LutBits];
+      nr_seed_table<Seed, (2 << LutBits)>::fill(table);
+      unsigned int idx = get_slc<LutBits>(x, W - 1 - LutBits).to_uint() + (odd ? (1 << LutBits) : 0);
+      s.y = table[idx];
+    }
+#pragma hls_unroll yes
+    for (unsigned int k = 1; k < NumSteps; k++) {
+      if (k >= first && k < last) {
+        typedef typename nvhls_t<F + 3>::nvuint_t Wide;
+        Fixed y2 = (s.y * s.y) >> F;
+        Wide t = (s.a * y2) >> (W - 1);
+        Wide e = (Wide(3) << F) - t;
+        s.y = (s.y * e) >> (F + 1);
+      }
+    }
+  }
+
+  static void unload(const State& s, Out& out) {
+    out.exp = s.exp;
+    nr_round<W, F>(s.y, out.mant, out.exp);
+    if (s.zero) {
+      out.mant = ~Mant(0);
+      out.exp = 0;
+    }
+  }
+
+  static void compute(const In& in, Out& out) {
+    State s;
+    load(in, s);
+    steps(s, 0, NumSteps);
+    unload(s, out);
+  }
+};
+
+/**
+ * \brief Pipelined Divider, Reciprocal or InvSqrt, and its cycle-accurate C++ model
+ * \ingroup DivSqrt
+ *
+ * \tparam Unit          A Divider, Reciprocal or InvSqrt instance
+ * \tparam StepsPerReg   Steps between pipeline registers; 0 for none
+ *
+ * \par Overview
+ * Runs the steps of Unit with a register after every StepsPerReg steps.
+ * Call run() once per cycle (e.g. from a pipelined loop at II=1): the
+ * result for the inputs of one call comes out Latency calls later, with
+ * out_valid echoing valid. Latency is ceil(NumSteps / StepsPerReg) - 1.
+ *
+ * \par A Simple Example
+ * \code
+ *      typedef nvhls::Divider<16> Div;      // 8 steps
+ *      nvhls::ArithPipelined<Div, 2> div;   // Latency 3
+ *      ...
+ *      div.run(in, in_valid, out, out_valid);
+ * \endcode
+ */
+template <typename Unit, unsigned int StepsPerReg = 0>
+class ArithPipelined {
+  typedef typename Unit::State State;
+  static const unsigned int SegSteps =
+      (StepsPerReg == 0 || StepsPerReg > Unit::NumSteps) ? Unit::NumSteps
+                                                         : StepsPerReg;
+
+ public:
+  typedef typename Unit::In In;
+  typedef typename Unit::Out Out;
+  static const unsigned int NumSteps = Unit::NumSteps;
+  static const unsigned int Latency =
+      (SegSteps == 0) ? 0 : (NumSteps + SegSteps - 1) / SegSteps - 1;
+
+ private:
+  // One spare entry so that the arrays are never empty
+  State regs[Latency + 1];
+  bool reg_valid[Latency + 1];
+
+ public:
+  ArithPipelined() { reset(); }
+
+  void reset() {
+#pragma hls_unroll yes
+    for (unsigned int r = 0; r <= Latency; r++) {
+      reg_valid[r] = false;
+    }
+  }
+
+  void run(const In& in, bool valid, Out& out, bool& out_valid) {
+    // Last segment, from the last register (or the inputs)
+    State s;
+    if (Latency == 0) {
+      Unit::load(in, s);
+      out_valid = valid;
+    } else {
+      s = regs[Latency == 0 ? 0 : Latency - 1];
+      out_valid = reg_valid[Latency == 0 ? 0 : Latency - 1];
+    }
+    Unit::steps(s, Latency * SegSteps, NumSteps);
+    Unit::unload(s, out);
+
+    // Middle segments, consuming each register before it updates
+#pragma hls_unroll yes
+    for (unsigned int n = 1; n < Latency; n++) {
+      unsigned int r = Latency - n;
+      regs[r] = regs[r - 1];
+      Unit::steps(regs[r], r * SegSteps, (r + 1) * SegSteps);
+      reg_valid[r] = reg_valid[r - 1];
+    }
+
+    // First segment
+    if (Latency > 0) {
+      Unit::load(in, regs[0]);
+      Unit::steps(regs[0], 0, SegSteps);
+      reg_valid[0] = valid;
+    }
+  }
+};
+
+}  // namespace nvhls
+
+#endif  // NVHLS_DIVSQRT_H
@@ -0,0 +1,525 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_FAST_INT_H
+#define NVHLS_FAST_INT_H
+
+#if defined(HLS_CATAPULT) && !defined(__SYNTHESIS__)
+
+#include <systemc.h>
+#include <ac_int.h>
+#include <nvhls_marshaller.h>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace nvhls {
+
+template <int W, bool S>
+class fast_int;
+
+/**
+ * \brief Type of a W-bit result: fast_int up to 64 bits, ac_int above.
+ * \ingroup nvhls_int
+ */
+template <int W, bool S, bool Native = (W <= 64)>
+struct fast_int_t {
+  typedef fast_int<W, S> type;
+};
+
+template <int W, bool S>
+struct fast_int_t<W, S, false> {
+  typedef ac_int<W, S> type;
+};
+
+// Width and signedness that ac_int gives the C integer types
+template <typename T>
+struct fast_int_c_type {
+  enum {
+    width = std::is_same<T, bool>::value ? 1 : 8 * sizeof(T),
+    sign = std::is_signed<T>::value
+  };
+  typedef fast_int<width, sign> type;
+};
+
+// Result types of the binary operators, with the widths ac_int uses
+template <int W1, bool S1, int W2, bool S2>
+struct fast_int_rt {
+  enum {
+    logic_w = (W1 + (S2 && !S1)) > (W2 + (S1 && !S2)) ? (W1 + (S2 && !S1)) : (W2 + (S1 && !S2)),
+    logic_s = S1 || S2,
+    plus_w = logic_w + 1,
+    plus_s = S1 || S2,
+    minus_w = logic_w + 1,
+    minus_s = true,
+    mult_w = W1 + W2,
+    mult_s = S1 || S2,
+    div_w = W1 + S2,
+    div_s = S1 || S2,
+    mod_w = W1 < (W2 + (!S2 && S1)) ? W1 : (W2 + (!S2 && S1)),
+    mod_s = S1
+  };
+  typedef typename fast_int_t<plus_w, plus_s>::type plus;
+  typedef typename fast_int_t<minus_w, minus_s>::type minus;
+  typedef typename fast_int_t<mult_w, mult_s>::type mult;
+  typedef typename fast_int_t<div_w, div_s>::type div;
+  typedef typename fast_int_t<mod_w, mod_s>::type mod;
+  typedef typename fast_int_t<logic_w, logic_s>::type logic;
+};
+
+/**
+ * \brief A native 64-bit implementation of ac_int<W, S> for C simulation.
+ * \ingroup nvhls_int
+ *
+ * \tparam W         Bitwidth, from 1 to 64
+ * \tparam S         Signedness
+ *
+ * \par Overview
+ * fast_int holds its value in a uint64_t, masked to W bits when unsigned and
+ * sign-extended when signed, and follows the ac_int semantics bit for bit:
+ * - Results of + - * / % & | ^ and of unary - and ~ have the widths and
+ *   signedness of the ac_int results. Results wider than 64 bits are ac_int.
+ * - Shifts keep the type of the left operand, and a negative signed amount
+ *   shifts the other way.
+ * - Comparisons compare the values, across signedness and widths.
+ * - Operands of C integer types are treated as ac_int of their width, and
+ *   mixing with ac_int computes in ac_int.
+ * - slc(), set_slc(), operator[], the reductions, leading_sign(), the to_*()
+ *   conversions, Marshall() and sc_trace() work as for ac_int.
+ *
+ * With NVHLS_FAST_SIM_INT defined (and HLS_CATAPULT), nvhls_t maps the
+ * widths up to 64, and so NVUINTW and NVINTW, to fast_int in C simulation.
+ * Synthesis always sees ac_int. Code that names ac_int types directly keeps
+ * ac_int, and converts to and from fast_int implicitly; only an explicit
+ * cast of a fast_int to ac_int is ambiguous, and takes to_ac() instead.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_fast_int.h>
+ *
+ *      ...
+ *      nvhls::fast_int<8, false> a = 200, b = 100;
+ *      nvhls::fast_int<9, false> sum = a + b;   // 300, as with ac_int<8, false>
+ *      nvhls::fast_int<8, false> wrap = a + b;  // 44
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <int W, bool S>
+class fast_int {
+  static_assert(W >= 1 && W <= 64, "fast_int holds 1 to 64 bits");
+
+ public:
+  static const int width = W;
+  static const bool sign = S;
+  typedef ac_int<W, S> ac_type;
+  // C type the value converts to implicitly, as ac_int does
+  typedef typename std::conditional<
+      S, typename std::conditional<(W <= 32), int, Slong>::type,
+      typename std::conditional<(W <= 32), unsigned, Ulong>::type>::type native_type;
+
+  // Normalizes a 64-bit two's complement value to W bits
+  static sc_dt::uint64 Norm(sc_dt::uint64 x) {
+    if (W == 64) {
+      return x;
+    }
+    if (S) {
+      return static_cast<sc_dt::uint64>(static_cast<sc_dt::int64>(x << (64 - W)) >> (64 - W));
+    }
+    return x & ((1ULL << (W % 64)) - 1);
+  }
+
+  static fast_int FromRaw(sc_dt::uint64 x) {
+    fast_int r;
+    r.v = Norm(x);
+    return r;
+  }
+
+  // Two's complement bits of the value, sign-extended when signed
+  sc_dt::uint64 raw() const { return v; }
+  const sc_dt::uint64& raw_ref() const { return v; }
+
+  // Constructors
+  fast_int() : v(0) {}
+
+  template <typename T>
+  fast_int(T x, typename std::enable_if<std::is_integral<T>::value>::type* = 0)
+      : v(Norm(static_cast<sc_dt::uint64>(x))) {}
+
+  fast_int(double x) : v(fast_int(ac_type(x)).v) {}
+
+  template <int W2, bool S2>
+  fast_int(const fast_int<W2, S2>& x) : v(Norm(x.raw())) {}
+
+  template <int W2, bool S2>
+  fast_int(const ac_int<W2, S2>& x) {
+    ac_type t = x;
+    v = Norm(S ? static_cast<sc_dt::uint64>(t.to_int64()) : t.to_uint64());
+  }
+
+  fast_int(const sc_uint_base& x) : v(Norm(x.to_uint64())) {}
+  fast_int(const sc_int_base& x) : v(Norm(static_cast<sc_dt::uint64>(x.to_int64()))) {}
+  fast_int(const sc_unsigned& x) : v(Norm(x.to_uint64())) {}
+  fast_int(const sc_signed& x) : v(Norm(static_cast<sc_dt::uint64>(x.to_int64()))) {}
+
+  // Conversions
+  operator native_type() const { return static_cast<native_type>(v); }
+  template <int W2, bool S2>
+  operator ac_int<W2, S2>() const {
+    return ac_int<W2, S2>(to_ac());
+  }
+  ac_type to_ac() const {
+    return S ? ac_type(static_cast<Slong>(v)) : ac_type(static_cast<Ulong>(v));
+  }
+  int to_int() const { return static_cast<int>(v); }
+  unsigned to_uint() const { return static_cast<unsigned>(v); }
+  long to_long() const { return static_cast<long>(v); }
+  unsigned long to_ulong() const { return static_cast<unsigned long>(v); }
+  Slong to_int64() const { return static_cast<Slong>(v); }
+  Ulong to_uint64() const { return static_cast<Ulong>(v); }
+  double to_double() const {
+    return S ? static_cast<double>(static_cast<Slong>(v)) : static_cast<double>(v);
+  }
+  std::string to_string(ac_base_mode mode, bool sign_mag = false) const {
+    return to_ac().to_string(mode, sign_mag);
+  }
+  int length() const { return W; }
+
+  // Bit access
+  class bitref {
+   public:
+    bitref(fast_int& x, int i) : x(x), i(i) {}
+    operator bool() const { return (x.v >> i) & 1; }
+    bitref& operator=(const bitref& b) { return *this = static_cast<bool>(b); }
+    // An integer writes its LSB, like ac_int
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, bitref&>::type operator=(T b) {
+      x.set_bit(i, b & 1);
+      return *this;
+    }
+    template <int W2, bool S2>
+    bitref& operator=(const fast_int<W2, S2>& b) {
+      x.set_bit(i, b.raw() & 1);
+      return *this;
+    }
+    bool operator!() const { return !static_cast<bool>(*this); }
+
+   private:
+    fast_int& x;
+    int i;
+  };
+
+  bitref operator[](int i) { return bitref(*this, i); }
+  bool operator[](int i) const { return (v >> i) & 1; }
+
+  void set_bit(int i, bool b) {
+    sc_dt::uint64 bit = 1ULL << i;
+    v = Norm(b ? (v | bit) : (v & ~bit));
+  }
+
+  template <int WS>
+  fast_int<WS, S> slc(int lsb) const {
+    sc_dt::uint64 x = (lsb >= 64) ? (S && static_cast<Slong>(v) < 0 ? ~0ULL : 0)
+                                  : (S ? static_cast<sc_dt::uint64>(static_cast<Slong>(v) >> lsb) : v >> lsb);
+    return fast_int<WS, S>::FromRaw(x);
+  }
+
+  template <int W2, bool S2>
+  fast_int& set_slc(int lsb, const fast_int<W2, S2>& slc) {
+    sc_dt::uint64 mask = (W2 == 64) ? ~0ULL : ((1ULL << (W2 % 64)) - 1);
+    v = Norm((v & ~(mask << lsb)) | ((slc.raw() & mask) << lsb));
+    return *this;
+  }
+
+  template <int W2, bool S2>
+  fast_int& set_slc(int lsb, const ac_int<W2, S2>& slc) {
+    static const int WL = (W2 < 64) ? W2 : 64;
+    return set_slc(lsb, fast_int<WL, false>(slc));
+  }
+
+  // Reductions
+  bool and_reduce() const { return fast_int<W, false>(*this).raw() == fast_int<W, false>(-1).raw(); }
+  bool or_reduce() const { return v != 0; }
+  bool xor_reduce() const { return __builtin_parityll(fast_int<W, false>(*this).raw()); }
+  bool nand_reduce() const { return !and_reduce(); }
+  bool nor_reduce() const { return !or_reduce(); }
+  bool xnor_reduce() const { return !xor_reduce(); }
+  int leading_sign() const { return to_ac().leading_sign(); }
+  int leading_sign(bool& all_sign) const { return to_ac().leading_sign(all_sign); }
+
+  // Unary operators
+  fast_int operator+() const { return *this; }
+  typename fast_int_t<W + 1, true>::type operator-() const {
+    return Negate(std::integral_constant<bool, (W + 1 <= 64)>());
+  }
+  typename fast_int_t<W + !S, true>::type operator~() const {
+    return Complement(std::integral_constant<bool, (W + !S <= 64)>());
+  }
+  bool operator!() const { return v == 0; }
+
+  fast_int& operator++() {
+    v = Norm(v + 1);
+    return *this;
+  }
+  fast_int& operator--() {
+    v = Norm(v - 1);
+    return *this;
+  }
+  const fast_int operator++(int) {
+    fast_int t = *this;
+    ++*this;
+    return t;
+  }
+  const fast_int operator--(int) {
+    fast_int t = *this;
+    --*this;
+    return t;
+  }
+
+  // Compound assignments, truncating the result back to W bits
+  template <typename T> fast_int& operator+=(const T& b) { return *this = *this + b; }
+  template <typename T> fast_int& operator-=(const T& b) { return *this = *this - b; }
+  template <typename T> fast_int& operator*=(const T& b) { return *this = *this * b; }
+  template <typename T> fast_int& operator/=(const T& b) { return *this = *this / b; }
+  template <typename T> fast_int& operator%=(const T& b) { return *this = *this % b; }
+  template <typename T> fast_int& operator&=(const T& b) { return *this = *this & b; }
+  template <typename T> fast_int& operator|=(const T& b) { return *this = *this | b; }
+  template <typename T> fast_int& operator^=(const T& b) { return *this = *this ^ b; }
+  template <typename T> fast_int& operator<<=(const T& b) { return *this = *this << b; }
+  template <typename T> fast_int& operator>>=(const T& b) { return *this = *this >> b; }
+
+  // Shifts by a signed amount, as ac_int does; n is clamped to +-1024
+  fast_int Shl(Slong n) const {
+    if (n < 0) {
+      return Shr(-n);
+    }
+    return FromRaw(n >= 64 ? 0 : v << n);
+  }
+  fast_int Shr(Slong n) const {
+    if (n < 0) {
+      return Shl(-n);
+    }
+    if (n >= 64) {
+      return FromRaw(S && static_cast<Slong>(v) < 0 ? ~0ULL : 0);
+    }
+    return FromRaw(S ? static_cast<sc_dt::uint64>(static_cast<Slong>(v) >> n) : v >> n);
+  }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    ac_type t = to_ac();
+    m& t;
+    *this = t;
+  }
+
+ private:
+  sc_dt::uint64 v;
+
+  typename fast_int_t<W + 1, true>::type Negate(std::true_type) const {
+    return fast_int_t<W + 1, true>::type::FromRaw(0 - v);
+  }
+  typename fast_int_t<W + 1, true>::type Negate(std::false_type) const { return -to_ac(); }
+  typename fast_int_t<W + !S, true>::type Complement(std::true_type) const {
+    return fast_int_t<W + !S, true>::type::FromRaw(~v);
+  }
+  typename fast_int_t<W + !S, true>::type Complement(std::false_type) const { return ~to_ac(); }
+};
+
+// Shift amounts, clamped so that they fit the shift helpers
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value, Slong>::type fast_int_shift(T n) {
+  if (std::is_signed<T>::value) {
+    Slong s = static_cast<Slong>(n);
+    return s > 1024 ? 1024 : (s < -1024 ? -1024 : s);
+  }
+  Ulong u = static_cast<Ulong>(n);
+  return u > 1024 ? 1024 : static_cast<Slong>(u);
+}
+
+template <int W2, bool S2>
+inline Slong fast_int_shift(const fast_int<W2, S2>& n) {
+  return S2 ? fast_int_shift(n.to_int64()) : fast_int_shift(n.to_uint64());
+}
+
+template <int W2, bool S2>
+inline Slong fast_int_shift(const ac_int<W2, S2>& n) {
+  return fast_int_shift(fast_int<(W2 < 64 ? W2 : 64), S2>(n));
+}
+
+template <int W, bool S, typename T>
+inline fast_int<W, S> operator<<(const fast_int<W, S>& a, const T& n) {
+  return a.Shl(fast_int_shift(n));
+}
+
+template <int W, bool S, typename T>
+inline fast_int<W, S> operator>>(const fast_int<W, S>& a, const T& n) {
+  return a.Shr(fast_int_shift(n));
+}
+
+// Ring operators; the 64-bit result is exact whenever the result type fits
+// in 64 bits, and ac_int computes the wider ones.
+#define NVHLS_FAST_INT_RING_OP(OP, NAME, RT)                                                 \
+  template <typename R, int W1, bool S1, int W2, bool S2>                                    \
+  inline R fast_int_##NAME(const fast_int<W1, S1>& a, const fast_int<W2, S2>& b, std::true_type) { \
+    return R::FromRaw(a.raw() OP b.raw());                                                   \
+  }                                                                                          \
+  template <typename R, int W1, bool S1, int W2, bool S2>                                    \
+  inline R fast_int_##NAME(const fast_int<W1, S1>& a, const fast_int<W2, S2>& b, std::false_type) { \
+    return a.to_ac() OP b.to_ac();                                                           \
+  }                                                                                          \
+  template <int W1, bool S1, int W2, bool S2>                                                \
+  inline typename fast_int_rt<W1, S1, W2, S2>::RT operator OP(const fast_int<W1, S1>& a,     \
+                                                              const fast_int<W2, S2>& b) {   \
+    typedef fast_int_rt<W1, S1, W2, S2> rt;                                                  \
+    return fast_int_##NAME<typename rt::RT>(a, b, std::integral_constant<bool, (rt::RT##_w <= 64)>()); \
+  }
+
+NVHLS_FAST_INT_RING_OP(+, add, plus)
+NVHLS_FAST_INT_RING_OP(-, sub, minus)
+NVHLS_FAST_INT_RING_OP(*, mul, mult)
+NVHLS_FAST_INT_RING_OP(&, and, logic)
+NVHLS_FAST_INT_RING_OP(|, or, logic)
+NVHLS_FAST_INT_RING_OP(^, xor, logic)
+#undef NVHLS_FAST_INT_RING_OP
+
+// Division and modulo need the values, in uint64 or in int64 when either
+// operand is signed. Operands that do not fit, and division by zero, are
+// left to ac_int.
+#define NVHLS_FAST_INT_DIV_OP(OP, RT)                                                        \
+  template <int W1, bool S1, int W2, bool S2>                                                \
+  inline typename fast_int_rt<W1, S1, W2, S2>::RT operator OP(const fast_int<W1, S1>& a,     \
+                                                              const fast_int<W2, S2>& b) {   \
+    typedef typename fast_int_rt<W1, S1, W2, S2>::RT R;                                      \
+    static const bool native = (fast_int_rt<W1, S1, W2, S2>::RT##_w <= 64) &&                \
+                               ((!S1 && !S2) || ((S1 || W1 < 64) && (S2 || W2 < 64)));       \
+    if (!native || b.raw() == 0) {                                                           \
+      return R(a.to_ac() OP b.to_ac());                                                      \
+    }                                                                                        \
+    if (S1 || S2) {                                                                          \
+      return R(a.to_int64() OP b.to_int64());                                                \
+    }                                                                                        \
+    return R(a.to_uint64() OP b.to_uint64());                                                \
+  }
+
+NVHLS_FAST_INT_DIV_OP(/, div)
+NVHLS_FAST_INT_DIV_OP(%, mod)
+#undef NVHLS_FAST_INT_DIV_OP
+
+// Comparisons of the values
+template <int W1, bool S1, int W2, bool S2>
+inline bool operator==(const fast_int<W1, S1>& a, const fast_int<W2, S2>& b) {
+  if (S1 != S2 && static_cast<Slong>(S1 ? a.raw() : b.raw()) < 0) {
+    return false;
+  }
+  return a.raw() == b.raw();
+}
+
+template <int W1, bool S1, int W2, bool S2>
+inline bool operator<(const fast_int<W1, S1>& a, const fast_int<W2, S2>& b) {
+  Slong sa = static_cast<Slong>(a.raw()), sb = static_cast<Slong>(b.raw());
+  if (S1 && S2) {
+    return sa < sb;
+  }
+  if (S1 && sa < 0) {
+    return true;
+  }
+  if (S2 && sb < 0) {
+    return false;
+  }
+  return a.raw() < b.raw();
+}
+
+template <int W1, bool S1, int W2, bool S2>
+inline bool operator!=(const fast_int<W1, S1>& a, const fast_int<W2, S2>& b) { return !(a == b); }
+template <int W1, bool S1, int W2, bool S2>
+inline bool operator>(const fast_int<W1, S1>& a, const fast_int<W2, S2>& b) { return b < a; }
+template <int W1, bool S1, int W2, bool S2>
+inline bool operator<=(const fast_int<W1, S1>& a, const fast_int<W2, S2>& b) { return !(b < a); }
+template <int W1, bool S1, int W2, bool S2>
+inline bool operator>=(const fast_int<W1, S1>& a, const fast_int<W2, S2>& b) { return !(a < b); }
+
+// Mixed operands: C integers act as fast_int of their width, and ac_int
+// operands make the operation an ac_int one.
+#define NVHLS_FAST_INT_MIXED_OP(OP)                                                          \
+  template <int W, bool S, typename T,                                                       \
+            typename = typename std::enable_if<std::is_integral<T>::value>::type>            \
+  inline auto operator OP(const fast_int<W, S>& a, T b)                                      \
+      -> decltype(a OP typename fast_int_c_type<T>::type(b)) {                               \
+    return a OP typename fast_int_c_type<T>::type(b);                                        \
+  }                                                                                          \
+  template <int W, bool S, typename T,                                                       \
+            typename = typename std::enable_if<std::is_integral<T>::value>::type>            \
+  inline auto operator OP(T a, const fast_int<W, S>& b)                                      \
+      -> decltype(typename fast_int_c_type<T>::type(a) OP b) {                               \
+    return typename fast_int_c_type<T>::type(a) OP b;                                        \
+  }                                                                                          \
+  template <int W, bool S, int W2, bool S2>                                                  \
+  inline auto operator OP(const fast_int<W, S>& a, const ac_int<W2, S2>& b)                  \
+      -> decltype(a.to_ac() OP b) {                                                          \
+    return a.to_ac() OP b;                                                                   \
+  }                                                                                          \
+  template <int W, bool S, int W2, bool S2>                                                  \
+  inline auto operator OP(const ac_int<W2, S2>& a, const fast_int<W, S>& b)                  \
+      -> decltype(a OP b.to_ac()) {                                                          \
+    return a OP b.to_ac();                                                                   \
+  }
+
+NVHLS_FAST_INT_MIXED_OP(+)
+NVHLS_FAST_INT_MIXED_OP(-)
+NVHLS_FAST_INT_MIXED_OP(*)
+NVHLS_FAST_INT_MIXED_OP(/)
+NVHLS_FAST_INT_MIXED_OP(%)
+NVHLS_FAST_INT_MIXED_OP(&)
+NVHLS_FAST_INT_MIXED_OP(|)
+NVHLS_FAST_INT_MIXED_OP(^)
+NVHLS_FAST_INT_MIXED_OP(==)
+NVHLS_FAST_INT_MIXED_OP(!=)
+NVHLS_FAST_INT_MIXED_OP(<)
+NVHLS_FAST_INT_MIXED_OP(>)
+NVHLS_FAST_INT_MIXED_OP(<=)
+NVHLS_FAST_INT_MIXED_OP(>=)
+#undef NVHLS_FAST_INT_MIXED_OP
+
+template <int W, bool S>
+inline std::ostream& operator<<(std::ostream& os, const fast_int<W, S>& x) {
+  return os << x.to_ac();
+}
+
+template <int W, bool S>
+inline void sc_trace(sc_trace_file* tf, const fast_int<W, S>& x, const std::string& name) {
+  sc_core::sc_trace(tf, x.raw_ref(), name, W);
+}
+
+}  // namespace nvhls
+
+// Marshaller traits, with the signedness of the ac_int it stands for
+template <int W, bool S>
+class Wrapped<nvhls::fast_int<W, S> > {
+ public:
+  nvhls::fast_int<W, S> val;
+  Wrapped() {}
+  Wrapped(const nvhls::fast_int<W, S>& v) : val(v) {}
+  static const unsigned int width = W;
+  static const bool is_signed = S;
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    val.Marshall(m);
+  }
+};
+
+#endif
+#endif  // NVHLS_FAST_INT_H
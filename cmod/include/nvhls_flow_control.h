@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_FLOW_CONTROL_H
+#define NVHLS_FLOW_CONTROL_H
+
+#include <systemc.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#ifndef __SYNTHESIS__
+#include <string>
+#include <utility>
+#include <vector>
+#endif
+
+namespace match {
+
+#ifndef __SYNTHESIS__
+
+/**
+ * \brief Simulation counters of a CreditCounter or TokenBucket.
+ * \ingroup FlowControl
+ *
+ * \par Overview
+ * Counting starts once the owning match::Module registers the counters with
+ * RegisterFlowStats(), and Module::DumpStats() prints them as
+ * <name>_consumed, <name>_returned (credits returned or tokens added),
+ * <name>_denied (requests refused for lack of credits or tokens) and
+ * <name>_dropped (tokens lost to a full bucket).
+ *
+ */
+class FlowStats {
+ public:
+  FlowStats() : enabled_(false), consumed_(0), returned_(0), denied_(0), dropped_(0) {}
+
+  void Enable() { enabled_ = true; }
+  bool IsEnabled() const { return enabled_; }
+
+  void Consumed(unsigned int n) {
+    if (enabled_) consumed_ += n;
+  }
+  void Returned(unsigned int n) {
+    if (enabled_) returned_ += n;
+  }
+  void Denied() {
+    if (enabled_) denied_++;
+  }
+  void Dropped(unsigned int n) {
+    if (enabled_) dropped_ += n;
+  }
+
+  uint64 NumConsumed() const { return consumed_; }
+  uint64 NumReturned() const { return returned_; }
+  uint64 NumDenied() const { return denied_; }
+  uint64 NumDropped() const { return dropped_; }
+
+  void Clear() { consumed_ = returned_ = denied_ = dropped_ = 0; }
+
+  // Appends (name, value) pairs for each counter
+  void GetCounters(const std::string& prefix,
+                   std::vector<std::pair<std::string, uint64> >& out) const {
+    out.push_back(std::make_pair(prefix + "_consumed", consumed_));
+    out.push_back(std::make_pair(prefix + "_returned", returned_));
+    out.push_back(std::make_pair(prefix + "_denied", denied_));
+    out.push_back(std::make_pair(prefix + "_dropped", dropped_));
+  }
+
+ private:
+  bool enabled_;
+  uint64 consumed_;
+  uint64 returned_;
+  uint64 denied_;
+  uint64 dropped_;
+};
+
+#else
+
+// Synthesis view: no counters
+class FlowStats {
+ public:
+  void Consumed(unsigned int n) {}
+  void Returned(unsigned int n) {}
+  void Denied() {}
+  void Dropped(unsigned int n) {}
+};
+
+#endif  // __SYNTHESIS__
+
+}  // namespace match
+
+/**
+ * \brief Credit counter of a credit-based flow-controlled link
+ * \ingroup FlowControl
+ *
+ * \tparam Max              Credits of the link, i.e. the entries of the receiving buffer
+ * \tparam Init             Credits after reset (default: Max)
+ *
+ * \par Overview
+ * The sender of a link consumes a credit per message and the receiver
+ * returns it once the message has left its buffer. The count stays within
+ * 0..Max: consuming more credits than are available, or returning more than
+ * were consumed, is an assertion failure. reset() restores Init, which
+ * a receiver that hands out its credits explicitly sets to 0.
+ * - update() applies the credits consumed and returned in the same cycle as
+ *   one add, so a link keeps one message per cycle with a single credit
+ *   left.
+ * - try_consume() consumes only when enough credits are available and
+ *   counts the requests it refuses in Stats().
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_flow_control.h>
+ *      ...
+ *      CreditCounter<kBufferSize> credits;
+ *      ...
+ *      credits.reset();
+ *      #pragma hls_pipeline_init_interval 1
+ *      while (1) {
+ *        wait();
+ *        CreditCounter<kBufferSize>::Count_t returned = 0;
+ *        in_credit.PopNB(returned);
+ *        bool send = credits.has() && out.PushNB(msg);
+ *        credits.update(send, returned);
+ *      }
+ * \endcode
+ * \par
+ *
+ */
+template <unsigned int Max, unsigned int Init = Max>
+class CreditCounter {
+ public:
+  static_assert(Max >= 1 && Init <= Max, "CreditCounter needs 1 <= Max and Init <= Max");
+  typedef NVUINTW(nvhls::index_width<Max + 1>::val) Count_t;
+
+  CreditCounter() { reset(); }
+
+  void reset() { count = Init; }
+
+  Count_t value() const { return count; }
+  bool has(Count_t n = 1) const { return count >= n; }
+  bool empty() const { return count == 0; }
+  bool full() const { return count == Max; }
+
+  void consume(Count_t n = 1) { update(n, 0); }
+  void release(Count_t n = 1) { update(0, n); }
+
+  bool try_consume(Count_t n = 1) {
+    if (!has(n)) {
+      stats_.Denied();
+      return false;
+    }
+    consume(n);
+    return true;
+  }
+
+  // Credits consumed and returned in the same cycle
+  void update(Count_t consumed, Count_t returned) {
+    NVHLS_ASSERT_MSG(consumed <= count + returned, "CreditCounter underflow");
+    NVHLS_ASSERT_MSG(count + returned - consumed <= Max, "CreditCounter overflow");
+    count = count + returned - consumed;
+    if (consumed != 0) stats_.Consumed(consumed.to_uint());
+    if (returned != 0) stats_.Returned(returned.to_uint());
+  }
+
+  match::FlowStats& Stats() { return stats_; }
+
+ protected:
+  Count_t count;
+  match::FlowStats stats_;
+};
+
+/**
+ * \brief Token-bucket rate limiter
+ * \ingroup FlowControl
+ *
+ * \tparam Rate             Tokens added every Period cycles
+ * \tparam Burst            Bucket size: the most tokens held, and the longest burst
+ * \tparam Period           Cycles between refills (default: 1)
+ * \tparam Init             Tokens after reset (default: Burst)
+ *
+ * \par Overview
+ * tick() is called once per cycle and adds Rate tokens every Period calls,
+ * up to Burst; tokens beyond Burst are dropped. Each message consumes
+ * tokens, so the long-term rate is at most Rate/Period tokens per cycle,
+ * with bursts of up to Burst. Like CreditCounter, reset() fills the bucket
+ * to Init (default: Burst), and consuming more tokens than are held is an
+ * assertion failure; try_consume() refuses instead.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_flow_control.h>
+ *      ...
+ *      // 3 flits every 8 cycles, bursts of up to 4
+ *      TokenBucket<3, 4, 8> limiter;
+ *      ...
+ *      while (1) {
+ *        wait();
+ *        limiter.tick();
+ *        if (limiter.has() && in.PopNB(flit)) {
+ *          limiter.consume();
+ *          out.Push(flit);
+ *        }
+ *      }
+ * \endcode
+ * \par
+ *
+ */
+template <unsigned int Rate, unsigned int Burst, unsigned int Period = 1,
+          unsigned int Init = Burst>
+class TokenBucket {
+ public:
+  static_assert(Rate >= 1 && Rate <= Burst && Period >= 1 && Init <= Burst,
+                "TokenBucket needs 1 <= Rate <= Burst, Period >= 1 and Init <= Burst");
+  typedef NVUINTW(nvhls::index_width<Burst + 1>::val) Count_t;
+  typedef NVUINTW(nvhls::index_width<Period>::val) Phase_t;
+
+  TokenBucket() { reset(); }
+
+  void reset() {
+    tokens = Init;
+    phase = 0;
+  }
+
+  Count_t value() const { return tokens; }
+  bool has(Count_t n = 1) const { return tokens >= n; }
+
+  void consume(Count_t n = 1) {
+    NVHLS_ASSERT_MSG(n <= tokens, "TokenBucket underflow");
+    tokens = tokens - n;
+    if (n != 0) stats_.Consumed(n.to_uint());
+  }
+
+  bool try_consume(Count_t n = 1) {
+    if (!has(n)) {
+      stats_.Denied();
+      return false;
+    }
+    consume(n);
+    return true;
+  }
+
+  // One cycle: adds Rate tokens at the end of each Period
+  void tick() {
+    if (phase == Period - 1) {
+      phase = 0;
+      NVUINTW(nvhls::index_width<Burst + Rate + 1>::val) next = tokens + Rate;
+      if (next > Burst) {
+        stats_.Dropped(next.to_uint() - Burst);
+        next = Burst;
+      }
+      stats_.Returned(next.to_uint() - tokens.to_uint());
+      tokens = next;
+    } else {
+      phase = phase + 1;
+    }
+  }
+
+  match::FlowStats& Stats() { return stats_; }
+
+ protected:
+  Count_t tokens;
+  Phase_t phase;
+  match::FlowStats stats_;
+};
+
+#endif  // NVHLS_FLOW_CONTROL_H
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_HISTOGRAM_STATS_H
+#define NVHLS_HISTOGRAM_STATS_H
+
+#include <systemc.h>
+#ifndef __SYNTHESIS__
+#include <string>
+#include <utility>
+#include <vector>
+#include <nvhls_assert.h>
+#endif
+
+namespace match {
+
+#ifndef __SYNTHESIS__
+
+/**
+ * \brief Histogram of sampled values, e.g. latencies, with percentiles.
+ * \ingroup nvhls_module
+ *
+ * \par Overview
+ * A HistogramStats counts Sample(value) calls in num_buckets buckets:
+ * - kLog2 (default): bucket 0 holds 0 and bucket i holds [2^(i-1), 2^i).
+ * - kLinear: bucket i holds [i*bucket_width, (i+1)*bucket_width).
+ * The last bucket also holds everything above it. Count, sum, minimum and
+ * maximum are kept exactly; Percentile(p) is the highest value of the bucket
+ * holding the p-th percentile, clamped to the minimum and maximum, so it is
+ * exact for kLinear with a bucket_width of 1 and within a factor of two for
+ * kLog2.
+ *
+ * Nothing is counted until the owning match::Module registers the histogram
+ * with RegisterHistogramStats(). Module::DumpStats() prints <name>_count and
+ * <name>_sum, which are summed into the totals, followed by <name>_min,
+ * <name>_p50, <name>_p90, <name>_p99 and <name>_max of the module alone.
+ * StatsJSON exports the buckets.
+ *
+ * \par A Simple Example
+ * \code
+ *      match::HistogramStats latency;  // 32 log2 buckets
+ *      match::HistogramStats depth;
+ *      ...
+ *      Dut(sc_module_name nm)
+ *          : match::Module(nm), depth(16, match::HistogramStats::kLinear) {
+ *        RegisterHistogramStats("latency", latency);
+ *        RegisterHistogramStats("depth", depth);
+ *      }
+ *      ...
+ *      latency.Sample(now - req.issue_cycle);
+ * \endcode
+ * \par
+ *
+ */
+class HistogramStats {
+ public:
+  enum Scale { kLinear, kLog2 };
+
+  explicit HistogramStats(unsigned int num_buckets = 32, Scale scale = kLog2,
+                          uint64 bucket_width = 1)
+      : enabled_(false), scale_(scale), bucket_width_(bucket_width),
+        buckets_(num_buckets, 0), count_(0), sum_(0), min_(0), max_(0) {
+    NVHLS_ASSERT_MSG(num_buckets > 0, "HistogramStats needs at least one bucket");
+    NVHLS_ASSERT_MSG(bucket_width > 0, "HistogramStats bucket_width must be non-zero");
+  }
+
+  void Enable() { enabled_ = true; }
+  bool IsEnabled() const { return enabled_; }
+
+  void Sample(uint64 value, uint64 n = 1) {
+    if (!enabled_ || n == 0) return;
+    buckets_[Bucket(value)] += n;
+    if (count_ == 0 || value < min_) min_ = value;
+    if (count_ == 0 || value > max_) max_ = value;
+    count_ += n;
+    sum_ += value * n;
+  }
+
+  Scale GetScale() const { return scale_; }
+  uint64 BucketWidth() const { return bucket_width_; }
+  unsigned int NumBuckets() const { return buckets_.size(); }
+  const std::vector<uint64>& Buckets() const { return buckets_; }
+  uint64 Count() const { return count_; }
+  uint64 Sum() const { return sum_; }
+  uint64 Min() const { return min_; }
+  uint64 Max() const { return max_; }
+  double Mean() const { return count_ == 0 ? 0.0 : static_cast<double>(sum_) / count_; }
+
+  // Lowest value counted in bucket idx
+  uint64 BucketLow(unsigned int idx) const {
+    if (scale_ == kLinear) return idx * bucket_width_;
+    return idx == 0 ? 0 : (static_cast<uint64>(1) << (idx - 1));
+  }
+
+  // Value at or below which p percent of the samples fall; 0 without samples
+  uint64 Percentile(double p) const {
+    if (count_ == 0) return 0;
+    uint64 rank = static_cast<uint64>(p / 100.0 * count_ + 0.5);
+    if (rank == 0) rank = 1;
+    if (rank > count_) rank = count_;
+    uint64 seen = 0;
+    unsigned int idx = 0;
+    for (; idx < buckets_.size() - 1; idx++) {
+      seen += buckets_[idx];
+      if (seen >= rank) break;
+    }
+    if (idx == buckets_.size() - 1) return max_;
+    uint64 high = BucketLow(idx + 1) - 1;
+    if (high < min_) return min_;
+    return high < max_ ? high : max_;
+  }
+
+  void Clear() {
+    buckets_.assign(buckets_.size(), 0);
+    count_ = sum_ = min_ = max_ = 0;
+  }
+
+  // Appends (name, value) pairs for the counters that add up across modules
+  void GetCounters(const std::string& prefix,
+                   std::vector<std::pair<std::string, uint64> >& out) const {
+    if (count_ == 0) return;
+    out.push_back(std::make_pair(prefix + "_count", count_));
+    out.push_back(std::make_pair(prefix + "_sum", sum_));
+  }
+
+  // Appends the minimum, percentiles and maximum, which do not add up
+  void GetPercentiles(const std::string& prefix,
+                      std::vector<std::pair<std::string, uint64> >& out) const {
+    if (count_ == 0) return;
+    out.push_back(std::make_pair(prefix + "_min", min_));
+    out.push_back(std::make_pair(prefix + "_p50", Percentile(50)));
+    out.push_back(std::make_pair(prefix + "_p90", Percentile(90)));
+    out.push_back(std::make_pair(prefix + "_p99", Percentile(99)));
+    out.push_back(std::make_pair(prefix + "_max", max_));
+  }
+
+ private:
+  unsigned int Bucket(uint64 value) const {
+    unsigned int idx;
+    if (scale_ == kLinear) {
+      uint64 q = value / bucket_width_;
+      idx = q < buckets_.size() ? static_cast<unsigned int>(q) : buckets_.size();
+    } else {
+      idx = 0;
+      while (value != 0) {
+        value >>= 1;
+        idx++;
+      }
+    }
+    return idx < buckets_.size() ? idx : buckets_.size() - 1;
+  }
+
+  bool enabled_;
+  Scale scale_;
+  uint64 bucket_width_;
+  std::vector<uint64> buckets_;
+  uint64 count_;
+  uint64 sum_;
+  uint64 min_;
+  uint64 max_;
+};
+
+#else
+
+// Synthesis view: no counters
+class HistogramStats {
+ public:
+  enum Scale { kLinear, kLog2 };
+  explicit HistogramStats(unsigned int num_buckets = 32, Scale scale = kLog2,
+                          uint64 bucket_width = 1) {}
+  void Sample(uint64 value, uint64 n = 1) {}
+};
+
+#endif  // __SYNTHESIS__
+
+}  // namespace match
+
+#endif  // NVHLS_HISTOGRAM_STATS_H
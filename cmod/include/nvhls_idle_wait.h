@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_IDLE_WAIT_H
+#define NVHLS_IDLE_WAIT_H
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#if !defined(__SYNTHESIS__) && defined(CONNECTIONS_ACCURATE_SIM)
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#endif
+
+namespace match {
+
+#if !defined(__SYNTHESIS__) && defined(CONNECTIONS_ACCURATE_SIM)
+
+/**
+ * \brief Sleeps an idle SC_THREAD until one of its channels has work.
+ * \ingroup nvhls_module
+ *
+ * \par Overview
+ * Most threads poll their inputs with PopNB() in every cycle, and wake up on
+ * every clock edge even when all of them are empty. An IdleWait lists the
+ * ports a thread loop depends on, and Sleep(), called right after the wait()
+ * that ends an iteration, suspends the thread while each watched In port is
+ * empty and each watched Out port is full. It wakes on the first change of a
+ * vld or rdy signal of those channels, and returns on the next clock edge,
+ * which is the edge the polling loop would first have done work on. Cycles
+ * are unchanged, only the iterations that do nothing are skipped.
+ * - Sleep() returns the number of clock edges it skipped, for loops that count
+ *   cycles. ThreadStats already counts them, under its "wait" cause.
+ * - Only watch the ports the loop is waiting for: a loop that also advances
+ *   on its own, a timer or a pending internal state for example, must not
+ *   call Sleep() while that state is pending.
+ * - With synchronous reset a sleeping thread does not see reset; Watch() the
+ *   reset signal to wake on it.
+ * - Sleep() does nothing in synthesis, in SIM_MODE 0 and 2, and when
+ *   NVHLS_IDLE_WAIT=0 is set in the environment, which gives the polling
+ *   behavior back for comparison.
+ *
+ * \par A Simple Example
+ * \code
+ *      match::IdleWait idle;   // member
+ *      ...
+ *      // In the constructor
+ *      idle.SetClock(clk);
+ *      idle.Watch(in);
+ *      ...
+ *      while (1) {
+ *        if (in.PopNB(msg)) {
+ *          out.Push(f(msg));
+ *        }
+ *        wait();
+ *        idle.Sleep();
+ *      }
+ * \endcode
+ * \par
+ *
+ */
+class IdleWait {
+ public:
+  IdleWait() : clk_(NULL), period_(SC_ZERO_TIME), skipped_(0), enabled_(true), ready_(false) {
+    const char* env = std::getenv("NVHLS_IDLE_WAIT");
+    if (env != NULL && std::strcmp(env, "0") == 0) enabled_ = false;
+  }
+
+  // The clock of the thread; without it Sleep() does nothing
+  void SetClock(const sc_in_clk& clk) { clk_ = &clk; }
+
+  template <typename Message>
+  void Watch(Connections::In<Message, TLM_PORT>& in) {}
+  template <typename Message>
+  void Watch(Connections::Out<Message, TLM_PORT>& out) {}
+
+  template <typename Message, connections_port_t port_marshall_type>
+  void Watch(Connections::In<Message, port_marshall_type>& in) {
+    watched_.push_back(new InPort<Connections::In<Message, port_marshall_type> >(in));
+  }
+
+  template <typename Message, connections_port_t port_marshall_type>
+  void Watch(Connections::Out<Message, port_marshall_type>& out) {
+    watched_.push_back(new OutPort<Connections::Out<Message, port_marshall_type> >(out));
+  }
+
+  // A signal that only wakes the thread, such as a synchronous reset
+  void Watch(sc_in<bool>& signal) { signals_.push_back(&signal); }
+
+  ~IdleWait() {
+    for (unsigned int i = 0; i < watched_.size(); i++) delete watched_[i];
+  }
+
+  // Call right after wait(); returns the clock edges skipped
+  unsigned int Sleep() {
+    if (!ready_) Prepare();
+    if (events_.size() == 0) return 0;
+    for (unsigned int i = 0; i < watched_.size(); i++) {
+      if (watched_[i]->Active()) return 0;
+    }
+    sc_time start = sc_time_stamp();
+    wait(events_);
+    wait();
+    unsigned int skipped = static_cast<unsigned int>((sc_time_stamp() - start) / period_ + 0.5) - 1;
+    skipped_ += skipped;
+    return skipped;
+  }
+
+  uint64 SkippedCycles() const { return skipped_; }
+
+ private:
+  struct Port {
+    virtual ~Port() {}
+    virtual bool Active() = 0;
+    virtual const sc_event& Changed() = 0;
+  };
+
+  template <typename P>
+  struct InPort : public Port {
+    P& p;
+    explicit InPort(P& p_) : p(p_) {}
+    bool Active() { return !p.Empty(); }
+    const sc_event& Changed() { return p.vld->value_changed_event(); }
+  };
+
+  template <typename P>
+  struct OutPort : public Port {
+    P& p;
+    explicit OutPort(P& p_) : p(p_) {}
+    bool Active() { return !p.Full(); }
+    const sc_event& Changed() { return p.rdy->value_changed_event(); }
+  };
+
+  const sc_in_clk* clk_;
+  sc_time period_;
+  uint64 skipped_;
+  bool enabled_;
+  bool ready_;
+  std::vector<Port*> watched_;
+  std::vector<sc_in<bool>*> signals_;
+  sc_event_or_list events_;
+
+  // Ports are bound by the first call
+  void Prepare() {
+    ready_ = true;
+    const sc_clock* clock = clk_ ? dynamic_cast<const sc_clock*>(clk_->get_interface()) : NULL;
+    if (!enabled_ || clock == NULL || watched_.empty()) return;
+    period_ = clock->period();
+    for (unsigned int i = 0; i < watched_.size(); i++) events_ |= watched_[i]->Changed();
+    for (unsigned int i = 0; i < signals_.size(); i++) events_ |= (*signals_[i])->value_changed_event();
+  }
+
+  IdleWait(const IdleWait&);
+  IdleWait& operator=(const IdleWait&);
+};
+
+#else
+
+// Synthesis and untimed views: a thread polls as written
+class IdleWait {
+ public:
+  IdleWait() {}
+  void SetClock(const sc_in_clk& clk) {}
+  template <typename Port>
+  void Watch(Port& port) {}
+  unsigned int Sleep() { return 0; }
+  uint64 SkippedCycles() const { return 0; }
+};
+
+#endif
+
+}  // namespace match
+
+#endif  // NVHLS_IDLE_WAIT_H
@@ -60,6 +60,9 @@
 #ifdef HLS_CATAPULT
 #include <ac_sc.h>
 #include <ac_int.h>
+#ifdef NVHLS_FAST_SIM_INT
+#include <nvhls_fast_int.h>
+#endif
 #endif
 
 namespace nvhls {
@@ -93,6 +96,15 @@ struct s_N<0> {
   };
 };
 
+#ifndef __SYNTHESIS__
+// In C simulation the same values come from constexpr functions, which cost
+// no template instantiations.
+constexpr int nbits_value(unsigned X) { return X ? 1 + nbits_value(X >> 1) : 0; }
+constexpr int log2_ceil_value(unsigned X) {
+  return X == (1u << (nbits_value(X) - 1)) ? nbits_value(X) - 1 : nbits_value(X);
+}
+#endif
+
 // compiler time constant for log2 like functions
 /**
  * \brief Compute number of bits to represent a constant
@@ -116,7 +128,11 @@ struct s_N<0> {
 
 template <unsigned X>
 struct nbits {
+#ifdef __SYNTHESIS__
   enum { val = s_N<16>::s_X<X>::nbits };
+#else
+  enum { val = nbits_value(X) };
+#endif
 };
 /**
  * \brief Compute Floor of log2 of a constant
@@ -140,7 +156,11 @@ struct nbits {
 
 template <unsigned X>
 struct log2_floor {
+#ifdef __SYNTHESIS__
   enum { val = nbits<X>::val - 1 };
+#else
+  enum { val = nbits_value(X) - 1 };
+#endif
 };
 
 /**
@@ -172,7 +192,11 @@ struct log2_floor<0> {};
 
 template <unsigned X>
 struct log2_ceil {
+#ifdef __SYNTHESIS__
   enum { lf = log2_floor<X>::val, val = (X == (1 << lf) ? lf : lf + 1) };
+#else
+  enum { lf = nbits_value(X) - 1, val = log2_ceil_value(X) };
+#endif
 };
 
 /**
@@ -283,7 +307,12 @@ struct next_pow2 {
 
 template <unsigned X>
 struct index_width {
+#ifdef __SYNTHESIS__
   enum { val = (X==1)? 1 : log2_ceil<X>::val };
+#else
+  static_assert(X != 0, "index_width of 0 is not defined");
+  enum { val = (X==1)? 1 : log2_ceil_value(X) };
+#endif
 };
 
 // Definition of vendor agnostic data types. We can add more data types to
@@ -299,6 +328,7 @@ struct index_width {
  * - Contains nvuint_t and nvint_t typedefs that conditionally map to ac_int or sc_int types based on CFLAG
  * - Specifying CFLAG HLS_CATAPULT typedefs ac_int to nvint, otherwise typedefs sc_int to nvint 
  * - nvint also supports conditional typedef of sc_int and sc_bigint depending on bitwidth 
+ * - With HLS_CATAPULT and NVHLS_FAST_SIM_INT, C simulation maps widths up to 64 to nvhls::fast_int, an ac_int-exact native implementation
  * - Simple macros to declare integers are defined in nvhls_types.h 
  *
  * \par A Simple Example
@@ -325,7 +355,22 @@ struct index_width {
  *
  */
 
-#ifdef HLS_CATAPULT
+#if defined(HLS_CATAPULT) && defined(NVHLS_FAST_SIM_INT) && !defined(__SYNTHESIS__)
+template <unsigned int N, bool B = (N <= 64)>
+struct nvhls_t;
+
+template <unsigned int N>
+struct nvhls_t<N, true> {
+  typedef fast_int<N, true> nvint_t;
+  typedef fast_int<N, false> nvuint_t;
+};
+
+template <unsigned int N>
+struct nvhls_t<N, false> {
+  typedef ac_int<N, true> nvint_t;
+  typedef ac_int<N, false> nvuint_t;
+};
+#elif defined(HLS_CATAPULT)
 template <unsigned int N>
 struct nvhls_t {
   typedef ac_int<N, true> nvint_t;
@@ -348,6 +393,50 @@ struct nvhls_t<N, false> {
 };
 #endif
 
+#if defined(HLS_CATAPULT) && !defined(__SYNTHESIS__)
+// C++ simulation only: slices as shifts and masks of native words. Types of
+// up to 64 bits work on their value as a uint64, which the compiler reduces to
+// a shift and a mask when the offset is a constant; wider types take one
+// shift and keep 64 bits. The bits match slc()/set_slc(), including the sign
+// extension of a signed type above its MSB.
+inline unsigned long long slc_sim_mask(unsigned int w) {
+  return (w >= 64) ? ~0ULL : ((1ULL << w) - 1);
+}
+
+template <typename type, bool Native = (Wrapped<type>::width <= 64)>
+struct slc_sim {
+  // Bits [i+63, i] of X
+  static unsigned long long bits(const type& X, unsigned int i) {
+    if (Wrapped<type>::is_signed) {
+      long long v = X.to_int64();
+      return static_cast<unsigned long long>((i >= 64) ? (v >> 63) : (v >> i));
+    }
+    return (i >= 64) ? 0 : (X.to_uint64() >> i);
+  }
+  // X with bits [i+W2-1, i] replaced by Y
+  template <typename type2>
+  static type set(const type& X, const type2& Y, unsigned int i) {
+    unsigned long long m = slc_sim_mask(Wrapped<type2>::width) << i;
+    unsigned long long v = (X.to_uint64() & ~m) | ((slc_sim<type2>::bits(Y, 0) << i) & m);
+    return Wrapped<type>::is_signed ? type(static_cast<long long>(v)) : type(v);
+  }
+};
+
+template <typename type>
+struct slc_sim<type, false> {
+  static unsigned long long bits(const type& X, unsigned int i) {
+    type shifted = X >> i;
+    return shifted.to_uint64();
+  }
+  template <typename type2>
+  static type set(const type& X, const type2& Y, unsigned int i) {
+    type X_temp = X;
+    X_temp.set_slc(i, Y);
+    return X_temp;
+  }
+};
+#endif
+
 /**
  * \brief Function that replaces slice of bits. 
  * \ingroup nvhls_int
@@ -365,6 +454,8 @@ struct nvhls_t<N, false> {
  * - Function that replaces slice of bits [i,i+W2-1] in X with Y.
  * - type1 and type2 can be: nvint or nvuint type.
  * - W2 is width of Y.
+ * - In C++ simulation, X of up to 64 bits is updated with a native shift and
+ *   mask.
  *
  * \par A Simple Example
  * \code
@@ -384,12 +475,17 @@ struct nvhls_t<N, false> {
  */
 
 template <typename type1, typename type2>
-type1 set_slc(type1 X, type2 Y, const unsigned int i) {
-  type1 X_temp = X;
+inline type1 set_slc(type1 X, type2 Y, const unsigned int i) {
 #ifdef HLS_CATAPULT
+#ifndef __SYNTHESIS__
+  return slc_sim<type1>::set(X, Y, i);
+#else
+  type1 X_temp = X;
   X_temp.set_slc(i, Y);
   return X_temp;
+#endif
 #else
+  type1 X_temp = X;
   const unsigned int W2 = Wrapped<type2>::width;
   X_temp.range(i + W2 - 1, i) = Y;
   return X_temp;
@@ -413,6 +509,8 @@ type1 set_slc(type1 X, type2 Y, const unsigned int i) {
  * - W should be a constant.
  * - type can be: nvint or nvuint type.
  * - Stratus does not work with typename nvhls_t<W>::nvuint_t as return type. Modifying it to scuint<W>. This will be a problem if W>64.
+ * - In C++ simulation, slices of up to 64 bits are a native shift and mask,
+ *   after at most one shift of a wider X.
  *
  * \par A Simple Example
  * \code
@@ -434,12 +532,18 @@ template <unsigned int W, typename type>
 #ifdef HLS_STRATUS
 sc_biguint<W> get_slc(type X, const unsigned int i){
 #else
-typename nvhls_t<W>::nvuint_t get_slc(type X, const unsigned int i) {
+inline typename nvhls_t<W>::nvuint_t get_slc(type X, const unsigned int i) {
 #endif
     // Assuming i>=0,
     type X_temp = X;
 typename nvhls_t<W>::nvuint_t Z;
 #ifdef HLS_CATAPULT
+#ifndef __SYNTHESIS__
+if (W <= 64) {
+  Z = slc_sim<type>::bits(X, i);
+  return Z;
+}
+#endif
 Z = X_temp.template slc<W>(i);
 return Z;
 #else
@@ -465,6 +569,7 @@ return Z;
  * - i >= j.
  * - type can be: nvint or nvuint type.
  * - SystemC supports this with range function. ac_int does not have equivalent functionality. 
+ * - In C++ simulation, slices of up to 64 bits skip the full-width mask.
  *
  * \par A Simple Example
  * \code
@@ -484,12 +589,19 @@ return Z;
  */
 
 template <typename type>
-type get_slc(type X, const unsigned int i, const unsigned int j) {
+inline type get_slc(type X, const unsigned int i, const unsigned int j) {
   // Assuming i>=0,j>=0, i>=j
   type X_temp = X;
   type Z;
 #ifdef HLS_CATAPULT
   const unsigned int W = type::width;
+#ifndef __SYNTHESIS__
+  if (W <= 64 || i - j + 1 < 64) {
+    unsigned long long v = slc_sim<type>::bits(X, j) & slc_sim_mask(i - j + 1);
+    Z = Wrapped<type>::is_signed ? type(static_cast<long long>(v)) : type(v);
+    return Z;
+  }
+#endif
   Z = (X_temp >> j) & ((((ac_int<W + 1>)1) << (i - j + 1)) - 1);
 #else
   Z = X_temp.range(i, j);
@@ -539,6 +651,8 @@ type get_slc(type X, const unsigned int i, const unsigned int j) {
  * \par Overview
  * - Function that returns position of leading one. 
  * - type can be: nvint or nvuint type.
+ * - In C++ simulation (with GCC or Clang) the position comes from
+ *   __builtin_clzll on 64-bit limbs instead of the bit-level tree.
  *
  * \par A Simple Example
  * \code
@@ -557,8 +671,39 @@ type get_slc(type X, const unsigned int i, const unsigned int j) {
  *
  */
 
+#if !defined(__SYNTHESIS__) && defined(__GNUC__)
+// C++ simulation only: position of the leading one from the compiler's
+// count-leading-zeros builtin, one 64-bit limb at a time. Matches the
+// synthesizable tree below, including 0 for X == 0.
+template <unsigned int W1, bool Wide = (W1 > 64)>
+struct leading_ones_sim {
+  static unsigned int pos(const typename nvhls_t<W1>::nvuint_t& X) {
+    unsigned long long v = X.to_uint64();
+    return (v == 0) ? 0 : 63 - __builtin_clzll(v);
+  }
+};
+
+template <unsigned int W1>
+struct leading_ones_sim<W1, true> {
+  static unsigned int pos(const typename nvhls_t<W1>::nvuint_t& X) {
+    for (int l = (W1 - 1) / 64; l >= 0; l--) {
+      typename nvhls_t<W1>::nvuint_t limb = X >> (64 * l);
+      unsigned long long v = limb.to_uint64();
+      if (v != 0) {
+        return 64 * l + 63 - __builtin_clzll(v);
+      }
+    }
+    return 0;
+  }
+};
+#endif
+
 template <unsigned int W1, typename type1, typename type2>
 inline type2 leading_ones(type1 X) {
+#if !defined(__SYNTHESIS__) && defined(__GNUC__)
+  typename nvhls_t<W1>::nvuint_t X_sim = X;
+  return leading_ones_sim<W1>::pos(X_sim);
+#else
   const unsigned int W2 = log2_ceil<W1>::val;
   enum { P2 = next_pow2<(W1 + 1) / 2>::val };
 
@@ -582,6 +727,7 @@ inline type2 leading_ones(type1 X) {
     idx = idxl;
   }
   return idx;
+#endif
 }
 /**************************************************************************
  *  End                                                                   *
@@ -651,6 +797,58 @@ unsigned int lzd(type1 X) {
 #endif
 }
 
+/**
+ * \brief Population count
+ * \ingroup nvhls_int
+ *
+ * \tparam W1                    Width of type1
+ * \tparam type1                 InputDatatype
+ *
+ * \param[in]    X              Variable whose set bits are counted
+ * \param[out]  ReturnType      Number of set bits in the W1 LSBs of X
+
+
+ * \par Overview
+ * - Function that returns the number of ones in X, as an adder tree of its
+ *   bits in hardware.
+ * - In C++ simulation (with GCC or Clang) the count comes from
+ *   __builtin_popcountll on 64-bit limbs.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_int.h>
+ *      #include <nvhls_types.h>
+ *
+ *      ...
+ *      NVUINT8 X = 5;
+ *      unsigned int ones = nvhls::count_ones<8>(X);   // 2
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+
+template <unsigned int W1, typename type1>
+inline unsigned int count_ones(type1 X) {
+  typename nvhls_t<W1>::nvuint_t X_temp = X;
+#if !defined(__SYNTHESIS__) && defined(__GNUC__)
+  unsigned int n = 0;
+  for (unsigned int l = 0; l < (W1 + 63) / 64; l++) {
+    typename nvhls_t<W1>::nvuint_t limb = X_temp >> (64 * l);
+    n += __builtin_popcountll(limb.to_uint64());
+  }
+  return n;
+#else
+  typename nvhls_t<log2_ceil<W1 + 1>::val>::nvuint_t n = 0;
+#pragma hls_unroll yes
+  for (unsigned int i = 0; i < W1; i++) {
+    n += X_temp[i];
+  }
+  return n;
+#endif
+}
+
 /**
  * \brief Minimum Value of a type 
  * \ingroup nvhls_int
@@ -907,6 +1105,253 @@ bool normalize(type1& X, type2& Y) {
   return b;
 #endif
 }
+
+/**
+ * \brief Rounding modes of round_sat and the saturating helpers
+ * \ingroup nvhls_int
+ *
+ * \par Overview
+ * - ROUND_TRN: truncate, toward minus infinity (a plain right shift)
+ * - ROUND_TRN_ZERO: truncate toward zero
+ * - ROUND_RND: to nearest, halves toward plus infinity
+ * - ROUND_RND_CONV: to nearest, halves to even
+ * .
+ */
+enum round_mode { ROUND_TRN, ROUND_TRN_ZERO, ROUND_RND, ROUND_RND_CONV };
+
+/**
+ * \brief Saturates a value to the range of a type
+ * \ingroup nvhls_int
+ *
+ * \tparam OutType            Output datatype
+ * \tparam InType             Input datatype
+ *
+ * \param[in]  X              Input variable
+ * \param[out] ReturnVal      X clamped to [-2^(W-1), 2^(W-1)-1] for a signed
+ *                            OutType of width W and to [0, 2^W-1] otherwise
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_int.h>
+ *
+ *      ...
+ *      NVINT12 X = 300;
+ *      NVINT8 Y = nvhls::saturate<NVINT8>(X);    // 127
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename OutType, typename InType>
+OutType saturate(const InType& X) {
+  const unsigned int InW = Wrapped<InType>::width;
+  const unsigned int OutW = Wrapped<OutType>::width;
+  const bool out_signed = Wrapped<OutType>::is_signed;
+  typedef typename nvhls_t<(InW > OutW ? InW : OutW) + 2>::nvint_t wide_type;
+  wide_type x = X;
+  wide_type hi = (wide_type(1) << (out_signed ? OutW - 1 : OutW)) - 1;
+  wide_type lo = out_signed ? wide_type(-hi - 1) : wide_type(0);
+  if (x > hi) {
+    x = hi;
+  } else if (x < lo) {
+    x = lo;
+  }
+  OutType out = x;
+  return out;
+}
+
+/**
+ * \brief Drops fraction bits with a rounding mode, then saturates
+ * \ingroup nvhls_int
+ *
+ * \tparam OutType            Output datatype
+ * \tparam Shift              Number of fraction bits to drop
+ * \tparam Mode               Rounding mode (default: ROUND_TRN)
+ * \tparam InType             Input datatype
+ *
+ * \param[in]  X              Input variable
+ * \param[out] ReturnVal      X / 2^Shift rounded and saturated to OutType
+ *
+ * \par Overview
+ * - The rounding increment is computed in a wider type, so rounding the
+ *   largest input up cannot wrap.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_int.h>
+ *
+ *      ...
+ *      NVINT16 acc = -0x0280;     // -2.5 with 8 fraction bits
+ *      NVINT8 Y = nvhls::round_sat<NVINT8, 8, nvhls::ROUND_RND_CONV>(acc);  // -2
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename OutType, unsigned int Shift, round_mode Mode = ROUND_TRN,
+          typename InType>
+OutType round_sat(const InType& X) {
+  const unsigned int W = Wrapped<InType>::width;
+  typedef typename nvhls_t<W + 2>::nvint_t wide_type;
+  wide_type x = X;
+  wide_type q = x >> Shift;
+  if (Shift > 0 && Mode != ROUND_TRN) {
+    typedef typename nvhls_t<(Shift > 0 ? Shift : 1)>::nvuint_t frac_type;
+    frac_type frac = get_slc<(Shift > 0 ? Shift : 1)>(x, 0);
+    frac_type half = frac_type(1) << (Shift > 0 ? Shift - 1 : 0);
+    bool up = false;
+    if (Mode == ROUND_TRN_ZERO) {
+      up = (x < 0) && (frac != 0);
+    } else if (Mode == ROUND_RND) {
+      up = (frac >= half);
+    } else if (Mode == ROUND_RND_CONV) {
+      up = (frac > half) || ((frac == half) && (q[0] == 1));
+    }
+    if (up) {
+      q = q + 1;
+    }
+  }
+  return saturate<OutType>(q);
+}
+
+/**
+ * \brief Saturating addition
+ * \ingroup nvhls_int
+ *
+ * \tparam OutType            Output datatype
+ *
+ * \param[in]  A, B           Inputs, of any nvint or nvuint types
+ * \param[out] ReturnVal      A + B saturated to OutType
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_int.h>
+ *
+ *      ...
+ *      NVINT8 X = 100, Y = 100;
+ *      NVINT8 Z = nvhls::sat_add<NVINT8>(X, Y);   // 127
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename OutType, typename InType1, typename InType2>
+OutType sat_add(const InType1& A, const InType2& B) {
+  const unsigned int W1 = Wrapped<InType1>::width;
+  const unsigned int W2 = Wrapped<InType2>::width;
+  typedef typename nvhls_t<(W1 > W2 ? W1 : W2) + 2>::nvint_t wide_type;
+  wide_type sum = wide_type(A) + wide_type(B);
+  return saturate<OutType>(sum);
+}
+
+/**
+ * \brief Saturating subtraction
+ * \ingroup nvhls_int
+ *
+ * \tparam OutType            Output datatype
+ *
+ * \param[in]  A, B           Inputs, of any nvint or nvuint types
+ * \param[out] ReturnVal      A - B saturated to OutType
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_int.h>
+ *
+ *      ...
+ *      NVUINT8 X = 3, Y = 5;
+ *      NVUINT8 Z = nvhls::sat_sub<NVUINT8>(X, Y);   // 0
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename OutType, typename InType1, typename InType2>
+OutType sat_sub(const InType1& A, const InType2& B) {
+  const unsigned int W1 = Wrapped<InType1>::width;
+  const unsigned int W2 = Wrapped<InType2>::width;
+  typedef typename nvhls_t<(W1 > W2 ? W1 : W2) + 2>::nvint_t wide_type;
+  wide_type diff = wide_type(A) - wide_type(B);
+  return saturate<OutType>(diff);
+}
+
+/**
+ * \brief Multiplication with rounding and saturation
+ * \ingroup nvhls_int
+ *
+ * \tparam OutType            Output datatype
+ * \tparam Shift              Fraction bits dropped from the exact product (default: 0)
+ * \tparam Mode               Rounding mode (default: ROUND_TRN)
+ *
+ * \param[in]  A, B           Inputs, of any nvint or nvuint types
+ * \param[out] ReturnVal      round_sat<OutType, Shift, Mode>(A * B)
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_int.h>
+ *
+ *      ...
+ *      NVINT8 X = 96, Y = 80;       // 0.75 and 0.625 with 7 fraction bits
+ *      NVINT8 Z = nvhls::sat_mul<NVINT8, 7, nvhls::ROUND_RND>(X, Y);  // 60
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename OutType, unsigned int Shift = 0, round_mode Mode = ROUND_TRN,
+          typename InType1, typename InType2>
+OutType sat_mul(const InType1& A, const InType2& B) {
+  const unsigned int W1 = Wrapped<InType1>::width;
+  const unsigned int W2 = Wrapped<InType2>::width;
+  typedef typename nvhls_t<W1 + W2 + 1>::nvint_t wide_type;
+  wide_type prod = wide_type(A) * wide_type(B);
+  return round_sat<OutType, Shift, Mode>(prod);
+}
+
+/**
+ * \brief Fused multiply-accumulate with a single rounding
+ * \ingroup nvhls_int
+ *
+ * \tparam OutType            Output datatype
+ * \tparam Shift              Fraction bits of A * B beyond those of C and the output (default: 0)
+ * \tparam Mode               Rounding mode (default: ROUND_TRN)
+ *
+ * \param[in]  A, B           Multiplicands, of any nvint or nvuint types
+ * \param[in]  C              Accumulator input, scaled as the output
+ * \param[out] ReturnVal      round_sat<OutType, Shift, Mode>(A * B + C * 2^Shift)
+ *
+ * \par Overview
+ * - The product and the sum are exact; only the result is rounded and
+ *   saturated. An accumulator that saturates can be narrower than one that
+ *   has to hold every partial sum.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_int.h>
+ *
+ *      ...
+ *      NVINT8 X, Y;          // 7 fraction bits
+ *      NVINT16 acc;          // 7 fraction bits
+ *      acc = nvhls::fused_mac<NVINT16, 7, nvhls::ROUND_RND_CONV>(X, Y, acc);
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename OutType, unsigned int Shift = 0, round_mode Mode = ROUND_TRN,
+          typename InType1, typename InType2, typename InType3>
+OutType fused_mac(const InType1& A, const InType2& B, const InType3& C) {
+  const unsigned int WP = Wrapped<InType1>::width + Wrapped<InType2>::width;
+  const unsigned int WC = Wrapped<InType3>::width + Shift;
+  typedef typename nvhls_t<(WP > WC ? WP : WC) + 2>::nvint_t wide_type;
+  wide_type sum = wide_type(A) * wide_type(B) + (wide_type(C) << Shift);
+  return round_sat<OutType, Shift, Mode>(sum);
+}
 }
 ;
 
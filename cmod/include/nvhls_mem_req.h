@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_MEM_REQ_H
+#define NVHLS_MEM_REQ_H
+
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_message.h>
+
+namespace nvhls {
+
+/**
+ * \brief Vector memory request shared by the MatchLib memories
+ * \ingroup MemReq
+ *
+ * \tparam T                Word type
+ * \tparam AddrWidth        Width of a word address
+ * \tparam N                Number of lanes
+ *
+ * \par Overview
+ * A load or store of up to N words, one word address per valid lane. The
+ * memories take it next to their own request types, and the conversions
+ * between them only move fields, so swapping one memory for another costs
+ * neither a cycle nor a buffer:
+ * - ScratchpadClass::load_store() and ArbitratedScratchpad::load_store()
+ *   take mem_req_t and mem_rsp_t directly, and to_cli_req() / to_mem_rsp()
+ *   of their Types headers convert explicitly.
+ * - to_ports() and from_ports() map onto the address, valid and data arrays
+ *   of ArbitratedScratchpadDP::run().
+ * - axi::MemReqAdapter (axi/AxiMemReq.h) turns AXI beats into requests and
+ *   responses back into AXI beats.
+ * AddrWidth need not match the memory; addresses are resized on conversion.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_mem_req.h>
+ *      ...
+ *      typedef nvhls::mem_req_t<Word_t, 16, 4> Req_t;
+ *      Req_t req;
+ *      req.is_store = 0;
+ *      #pragma hls_unroll yes
+ *      for (unsigned i = 0; i < 4; i++) req.set(i, base + i);
+ *      nvhls::mem_rsp_t<Word_t, 4> rsp;
+ *      scratchpad.load_store(req, rsp);   // a ScratchpadClass or ArbitratedScratchpad
+ * \endcode
+ * \par
+ *
+ */
+template <typename T, unsigned int AddrWidth, unsigned int N>
+class mem_req_t : public nvhls_message {
+ public:
+  static const unsigned int type_width = Wrapped<T>::width;
+  static const unsigned int width = 1 + N + N * (AddrWidth + type_width);
+  typedef NVUINTW(AddrWidth) Addr;
+  typedef NVUINTW(N) LaneMask;
+
+  NVUINT1 is_store;
+  LaneMask valids;
+  Addr addr[N];
+  T data[N];
+
+  mem_req_t() : is_store(0), valids(0) {}
+
+  void set(unsigned int lane, Addr a) {
+    valids[lane] = 1;
+    addr[lane] = a;
+  }
+
+  void set(unsigned int lane, Addr a, const T& d) {
+    set(lane, a);
+    data[lane] = d;
+  }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m& is_store;
+    m& valids;
+    #pragma hls_unroll yes
+    for (unsigned int i = 0; i < N; i++) m& addr[i];
+    #pragma hls_unroll yes
+    for (unsigned int i = 0; i < N; i++) m& data[i];
+  }
+};
+
+/**
+ * \brief Response of a mem_req_t load: the words of the valid lanes
+ * \ingroup MemReq
+ */
+template <typename T, unsigned int N>
+class mem_rsp_t : public nvhls_message {
+ public:
+  static const unsigned int type_width = Wrapped<T>::width;
+  static const unsigned int width = N + N * type_width;
+  typedef NVUINTW(N) LaneMask;
+
+  LaneMask valids;
+  T data[N];
+
+  mem_rsp_t() : valids(0) {}
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m& valids;
+    #pragma hls_unroll yes
+    for (unsigned int i = 0; i < N; i++) m& data[i];
+  }
+};
+
+/**
+ * \brief Lanes of a request as per-port arrays, e.g. the read or write ports of ArbitratedScratchpadDP
+ * \ingroup MemReq
+ */
+template <typename T, unsigned int AddrWidth, unsigned int N, typename Address>
+void to_ports(const mem_req_t<T, AddrWidth, N>& req, Address (&addr)[N], bool (&valid)[N],
+              T (&data)[N]) {
+  #pragma hls_unroll yes
+  for (unsigned int i = 0; i < N; i++) {
+    addr[i] = req.addr[i];
+    valid[i] = (req.valids[i] == 1);
+    data[i] = req.data[i];
+  }
+}
+
+/**
+ * \brief Per-port read data and valids as a response
+ * \ingroup MemReq
+ */
+template <typename T, unsigned int N>
+mem_rsp_t<T, N> from_ports(const T (&data)[N], const bool (&valid)[N]) {
+  mem_rsp_t<T, N> rsp;
+  #pragma hls_unroll yes
+  for (unsigned int i = 0; i < N; i++) {
+    rsp.valids[i] = valid[i];
+    rsp.data[i] = data[i];
+  }
+  return rsp;
+}
+
+}  // namespace nvhls
+
+#endif  // NVHLS_MEM_REQ_H
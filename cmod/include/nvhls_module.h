@@ -41,6 +41,13 @@
 #endif // defined(ENABLE_SYNC_RESET)
 
 #include <nvhls_trace.h>
+#include <nvhls_trace_sink.h>
+#include <nvhls_port_stats.h>
+#include <nvhls_thread_stats.h>
+#include <nvhls_activity_stats.h>
+#include <nvhls_histogram_stats.h>
+#include <nvhls_profiler.h>
+#include <nvhls_flow_control.h>
 #include <nvhls_marshaller.h>
 #include <nvhls_message.h>
 
@@ -60,6 +67,20 @@
 #endif
 
 namespace match {
+
+class StatsJSON;
+class StatSampler;
+
+/**
+ * \brief Handle to a stat registered with Module::RegisterStat().
+ * \ingroup nvhls_module
+ */
+struct StatHandle {
+  unsigned int index;
+  StatHandle() : index(0) {}
+  explicit StatHandle(unsigned int i) : index(i) {}
+};
+
 /**
  * \brief Matchlib Module class: a wrapper of sc_module with tracing and stats support. 
  * \ingroup nvhls_module
@@ -105,6 +126,10 @@ namespace match {
  */
 
 class Module : public sc_module, public nvhls_message {
+  friend class StatsJSON;
+  friend class StatSampler;
+  friend class ThroughputAnalyzer;
+
  public:
   // Interface in/out
   sc_in_clk clk;
@@ -115,20 +140,12 @@ class Module : public sc_module, public nvhls_message {
 
   Module() : sc_module(sc_gen_unique_name("module")), clk("clk"), rst("rst") {
 #ifndef __SYNTHESIS__
-    module_indicator = new sc_attr_base("match_module");
-    this->add_attribute(*module_indicator);
+    Init();
 #endif
   }
   Module(sc_module_name nm) : sc_module(nm), clk("clk"), rst("rst") {
 #ifndef __SYNTHESIS__
-    module_indicator = new sc_attr_base("match_module");
-    this->add_attribute(*module_indicator);
-#endif
-  }
-
-  ~Module() {
-#ifndef __SYNTHESIS__
-    delete module_indicator;
+    Init();
 #endif
   }
 
@@ -137,6 +154,50 @@ class Module : public sc_module, public nvhls_message {
 #ifndef __SYNTHESIS__
   /* A map to store simulation stats. Not instantiated for synthesis. */
   std::map<std::string, uint64> stats_;
+  /* Registered buffered-port counters, printed with stats_. */
+  std::vector<std::pair<std::string, PortStats*> > port_stats_;
+  /* Registered pipelined-thread counters, printed with stats_. */
+  std::vector<std::pair<std::string, ThreadStats*> > thread_stats_;
+  /* Registered credit-counter and token-bucket counters, printed with stats_. */
+  std::vector<std::pair<std::string, FlowStats*> > flow_stats_;
+  /* Registered switching-activity counters, printed with stats_. */
+  std::vector<std::pair<std::string, ActivityStats*> > activity_stats_;
+  /* Registered histograms, printed with stats_. */
+  std::vector<std::pair<std::string, HistogramStats*> > histogram_stats_;
+  /* Pre-registered stats, indexed by StatHandle and printed with stats_. */
+  std::vector<std::string> stat_names_;
+  std::vector<uint64> stat_values_;
+  std::vector<bool> stat_used_;
+  unsigned int num_stats_used_;
+  /* Occurrences of each RecordEvent() name. */
+  std::map<std::string, uint64> events_;
+  /* Cached hierarchical name used by T(). */
+  std::string trace_prefix_;
+  bool trace_prefix_valid_;
+  /* Id of this module in the BinaryTraceSink, -1 until first used. */
+  int trace_module_id_;
+  /* Track of this module in the Timeline, -1 until first used. */
+  int timeline_track_;
+
+  /* Attributes are not owned by the objects they are added to, so all Modules
+   * share one indicator rather than allocating one each. */
+  static sc_attr_base& ModuleIndicator() {
+    static sc_attr_base indicator("match_module");
+    return indicator;
+  }
+
+  void Init() {
+    num_stats_used_ = 0;
+    trace_prefix_valid_ = false;
+    trace_module_id_ = -1;
+    timeline_track_ = -1;
+    module_indicator = &ModuleIndicator();
+    this->add_attribute(*module_indicator);
+#ifdef NVHLS_PROFILE
+    // Starts the clock of the elaboration time in the profile report
+    Profiler::Instance();
+#endif
+  }
 #endif
   Tracer tracer_;
   Flusher EndT;  // Note: this variable is excused from following naming
@@ -197,49 +258,201 @@ class Module : public sc_module, public nvhls_message {
 #endif
   }
 
+  /* Register a stat once, e.g. in the constructor, so that IncrStat() on the
+   * returned handle is a single array add. Stats registered under the same
+   * name as string-keyed stats are printed as one sum. */
+  StatHandle RegisterStat(const std::string& name) {
+#ifndef __SYNTHESIS__
+    stat_names_.push_back(name);
+    stat_values_.push_back(0);
+    stat_used_.push_back(false);
+    return StatHandle(stat_names_.size() - 1);
+#else
+    return StatHandle();
+#endif
+  }
+
+  /* Register name_0 ... name_<num-1>; use with IncrStatIndexed(handle, idx). */
+  StatHandle RegisterStatIndexed(const std::string& name, unsigned int num) {
+#ifndef __SYNTHESIS__
+    StatHandle base(stat_names_.size());
+    stat_names_.reserve(stat_names_.size() + num);
+    stat_values_.reserve(stat_values_.size() + num);
+    stat_used_.reserve(stat_used_.size() + num);
+    std::string final_name = name + "_";
+    for (unsigned int i = 0; i < num; i++) {
+      final_name.resize(name.size() + 1);
+      final_name += std::to_string(i);
+      RegisterStat(final_name);
+    }
+    return base;
+#else
+    return StatHandle();
+#endif
+  }
+
+  void IncrStat(StatHandle stat, unsigned int num = 1) {
+#ifndef __SYNTHESIS__
+    stat_values_[stat.index] += num;
+    if (!stat_used_[stat.index]) {
+      stat_used_[stat.index] = true;
+      num_stats_used_++;
+    }
+#endif
+  }
+
+  void IncrStatIndexed(StatHandle base, unsigned int idx, unsigned int num = 1) {
+#ifndef __SYNTHESIS__
+    IncrStat(StatHandle(base.index + idx), num);
+#endif
+  }
+
+  /* Start counting on a buffered port, e.g. RegisterPortStats("in", in.Stats()). */
+  void RegisterPortStats(const std::string& name, PortStats& stats) {
+#ifndef __SYNTHESIS__
+    stats.Enable();
+    stats.SetName(std::string(this->name()) + "." + name);
+    stats.SetTimelineTrack(
+        Timeline::Instance().RegisterTrack(std::string(this->name()) + "." + name));
+    port_stats_.push_back(std::make_pair(name, &stats));
+#endif
+  }
+
+  /* Start counting a thread loop, e.g. RegisterThreadStats("run", run_stats);
+   * the cycles between iterations are taken from clk. */
+  void RegisterThreadStats(const std::string& name, ThreadStats& stats) {
+#ifndef __SYNTHESIS__
+    stats.Enable(&clk);
+    thread_stats_.push_back(std::make_pair(name, &stats));
+#endif
+  }
+
+  /* Start counting a CreditCounter or TokenBucket, e.g.
+   * RegisterFlowStats("credits", credits.Stats()). */
+  void RegisterFlowStats(const std::string& name, FlowStats& stats) {
+#ifndef __SYNTHESIS__
+    stats.Enable();
+    flow_stats_.push_back(std::make_pair(name, &stats));
+#endif
+  }
+
+  /* Start counting switching activity, e.g.
+   * RegisterActivityStats("banks", banks.Stats()). */
+  void RegisterActivityStats(const std::string& name, ActivityStats& stats) {
+#ifndef __SYNTHESIS__
+    stats.Enable();
+    activity_stats_.push_back(std::make_pair(name, &stats));
+#endif
+  }
+
+  /* Start counting samples, e.g. RegisterHistogramStats("latency", latency). */
+  void RegisterHistogramStats(const std::string& name, HistogramStats& stats) {
+#ifndef __SYNTHESIS__
+    stats.Enable();
+    histogram_stats_.push_back(std::make_pair(name, &stats));
+#endif
+  }
+
+#if defined(NVHLS_PROFILE) && !defined(__SYNTHESIS__)
+  /* Waits of match::Module processes end their profiled activation. */
+  using sc_module::wait;
+  void wait() {
+    Profiler::Instance().Suspend();
+    sc_module::wait();
+    Profiler::Instance().Resume();
+  }
+  void wait(int n) {
+    Profiler::Instance().Suspend();
+    sc_module::wait(n);
+    Profiler::Instance().Resume();
+  }
+#endif
+
   Tracer& T(int l = 0) {
 #ifdef NOPRINT
     l = 10;
 #endif
 #ifndef __SYNTHESIS__
     tracer_.SetCurrentLevel(l);
-    tracer_ << sc_time_stamp() << ": ";
-    if (get_parent() != NULL) {
-      if (get_parent()->get_parent() != NULL) {
-        if (get_parent()->get_parent()->get_parent() != NULL) {
-          if (get_parent()->get_parent()->get_parent()->get_parent() != NULL) {
-            if (get_parent()->get_parent()->get_parent()->get_parent()->get_parent() != NULL) {
-              if (strncmp(get_parent()->get_parent()->get_parent()->get_parent()->get_parent()->basename(), "", 1)) {
-                tracer_ << get_parent()->get_parent()->get_parent()->get_parent()->get_parent()->basename() << ".";
-              }
-            }
-
-            if (strncmp(get_parent()->get_parent()->get_parent()->get_parent()->basename(), "", 1)) {
-              tracer_ << get_parent()->get_parent()->get_parent()->get_parent()->basename() << ".";
-            }
-          }
-
-          if (strncmp(get_parent()->get_parent()->get_parent()->basename(), "", 1)) {
-            tracer_ << get_parent()->get_parent()->get_parent()->basename() << ".";
-          }
-        }
+    // Filtered-out lines skip all formatting.
+    if (!tracer_.IsEnabled()) {
+      return tracer_;
+    }
+    tracer_ << sc_time_stamp() << ": " << TracePrefix();
+#endif
+    return tracer_;
+  }
 
-        if (strncmp(get_parent()->get_parent()->basename(), "", 1)) {
-          tracer_ << get_parent()->get_parent()->basename() << ".";
+#ifndef __SYNTHESIS__
+  /* "<ancestors>.<basename>: ", with up to five ancestors. The hierarchy does
+   * not change once a module is constructed, so it is resolved only once. */
+  const std::string& TracePrefix() {
+    if (!trace_prefix_valid_) {
+      std::vector<const char*> names;
+      sc_object* parent = get_parent();
+      while (parent != NULL && names.size() < 5) {
+        names.push_back(parent->basename());
+        parent = parent->get_parent();
+      }
+      trace_prefix_.clear();
+      for (int i = names.size() - 1; i >= 0; i--) {
+        if (strncmp(names[i], "", 1)) {
+          trace_prefix_ += names[i];
+          trace_prefix_ += ".";
         }
       }
-
-      if (strncmp(get_parent()->basename(), "", 1)) {
-        tracer_ << get_parent()->basename() << ".";
+      if (strncmp(basename(), "", 1)) {
+        trace_prefix_ += basename();
+        trace_prefix_ += ": ";
       }
+      trace_prefix_valid_ = true;
     }
-    if (strncmp(basename(), "", 1)) {
-      tracer_ << basename() << ": ";
+    return trace_prefix_;
+  }
+#endif
+  
+  /* Declare a binary trace point, e.g. in the constructor; the text is
+   * printed by DecodeBinaryTrace() in place of a T() message. */
+  unsigned int RegisterTraceEvent(const std::string& text) {
+#ifndef __SYNTHESIS__
+    return BinaryTraceSink::Instance().RegisterEvent(text);
+#else
+    return 0;
+#endif
+  }
+
+  /* Record msg to the BinaryTraceSink; a no-op unless the sink is open. */
+  template <typename Message>
+  void TraceBinary(unsigned int event, const Message& msg) {
+#ifndef __SYNTHESIS__
+    BinaryTraceSink& sink = BinaryTraceSink::Instance();
+    if (!sink.IsOpen()) {
+      return;
     }
+    TracePayload<Message> payload(msg);
+    sink.Record(TraceModuleId(), event, payload.bytes,
+                TracePayload<Message>::kBytes);
 #endif
-    return tracer_;
   }
-  
+
+  void TraceBinary(unsigned int event) {
+#ifndef __SYNTHESIS__
+    BinaryTraceSink& sink = BinaryTraceSink::Instance();
+    if (sink.IsOpen()) {
+      sink.Record(TraceModuleId(), event, NULL, 0);
+    }
+#endif
+  }
+
+#ifndef __SYNTHESIS__
+  unsigned int TraceModuleId() {
+    if (trace_module_id_ < 0) {
+      trace_module_id_ = BinaryTraceSink::Instance().RegisterModule(name());
+    }
+    return trace_module_id_;
+  }
+#endif
+
   Tracer& ASSERT(bool cond) {
 #ifndef __SYNTHESIS__
     if (!cond) {
@@ -271,23 +484,108 @@ class Module : public sc_module, public nvhls_message {
   }
 
  protected:
+  /* Counted as a stat; with the Timeline enabled also an instant event with
+   * param as its argument. */
   void RecordEvent(const std::string& name, uint64 param = 0) {
-// Param is ignored fore now.
 #ifndef __SYNTHESIS__
     IncrStat(name);
+    events_[name]++;
+    if (Timeline::Instance().IsEnabled()) {
+      Timeline::Instance().Instant(TimelineTrack(), name, param);
+    }
+#endif
+  }
+
+  /* Span on this module's Timeline track, e.g. around a multi-cycle operation. */
+  void TimelineBegin(const std::string& name) {
+#ifndef __SYNTHESIS__
+    if (Timeline::Instance().IsEnabled()) {
+      Timeline::Instance().Begin(TimelineTrack(), name);
+    }
 #endif
   }
 
+  void TimelineEnd(const std::string& name) {
+#ifndef __SYNTHESIS__
+    if (Timeline::Instance().IsEnabled()) {
+      Timeline::Instance().End(TimelineTrack(), name);
+    }
+#endif
+  }
+
+#ifndef __SYNTHESIS__
+  unsigned int TimelineTrack() {
+    if (timeline_track_ < 0) {
+      timeline_track_ = Timeline::Instance().RegisterTrack(name());
+    }
+    return timeline_track_;
+  }
+#endif
+
+#ifndef __SYNTHESIS__
+  /* String-keyed and handle stats, summed by name. */
+  void CollectStats(std::map<std::string, uint64>& all_stats) {
+    all_stats = stats_;
+    for (unsigned int i = 0; i < stat_names_.size(); i++) {
+      if (stat_used_[i])
+        all_stats[stat_names_[i]] += stat_values_[i];
+    }
+  }
+
+  /* Counters of the registered port, thread, flow, activity and histogram
+   * stats, in registration order. */
+  void CollectCounters(std::vector<std::pair<std::string, uint64> >& counters) {
+    for (unsigned int i = 0; i < port_stats_.size(); i++) {
+      port_stats_[i].second->GetCounters(port_stats_[i].first, counters);
+    }
+    for (unsigned int i = 0; i < thread_stats_.size(); i++) {
+      thread_stats_[i].second->GetCounters(thread_stats_[i].first, counters);
+    }
+    for (unsigned int i = 0; i < flow_stats_.size(); i++) {
+      flow_stats_[i].second->GetCounters(flow_stats_[i].first, counters);
+    }
+    for (unsigned int i = 0; i < activity_stats_.size(); i++) {
+      activity_stats_[i].second->GetCounters(activity_stats_[i].first, counters);
+    }
+    for (unsigned int i = 0; i < histogram_stats_.size(); i++) {
+      histogram_stats_[i].second->GetCounters(histogram_stats_[i].first, counters);
+    }
+  }
+#endif
+
   void PrintStats(std::ostream& ofile, unsigned int lvl, Module* aggregator) {
 #ifndef __SYNTHESIS__
-      for (std::map<std::string, uint64>::iterator it = stats_.begin();
-           it != stats_.end(); it++) {
+      std::map<std::string, uint64> merged;
+      const std::map<std::string, uint64>* all_stats = &stats_;
+      if (num_stats_used_ != 0) {
+        CollectStats(merged);
+        all_stats = &merged;
+      }
+      for (std::map<std::string, uint64>::const_iterator it = all_stats->begin();
+           it != all_stats->end(); it++) {
         Indent(ofile, lvl);
         ofile << it->first << ": " << it->second << std::endl;
         // Add stat into subtotal if necessary.
         if (aggregator)
           aggregator->IncrStat(it->first, it->second);
       }
+      std::vector<std::pair<std::string, uint64> > counters;
+      CollectCounters(counters);
+      for (unsigned int i = 0; i < counters.size(); i++) {
+        Indent(ofile, lvl);
+        ofile << counters[i].first << ": " << counters[i].second << std::endl;
+        if (aggregator)
+          aggregator->IncrStat(counters[i].first, counters[i].second);
+      }
+      // Percentiles of this module alone, not summed into the totals
+      counters.clear();
+      for (unsigned int i = 0; i < histogram_stats_.size(); i++) {
+        histogram_stats_[i].second->GetPercentiles(histogram_stats_[i].first, counters);
+      }
+      for (unsigned int i = 0; i < counters.size(); i++) {
+        Indent(ofile, lvl);
+        ofile << counters[i].first << ": " << counters[i].second << std::endl;
+      }
 #endif
   }
   void Indent(std::ostream& ofile, unsigned int lvl) {
@@ -301,7 +599,9 @@ class Module : public sc_module, public nvhls_message {
  public:
   bool HasStats() {
 #ifndef __SYNTHESIS__
-    return (stats_.size() != 0);
+    return (stats_.size() != 0 || port_stats_.size() != 0 || thread_stats_.size() != 0 ||
+            flow_stats_.size() != 0 || activity_stats_.size() != 0 ||
+            histogram_stats_.size() != 0 || num_stats_used_ != 0);
 #else
     return false;
 #endif
@@ -351,6 +651,20 @@ class Module : public sc_module, public nvhls_message {
         PrintStats(ofile, lvl + 2, aggregator);
       }
     }
+#endif
+  }
+  /* Achieved II against target and the top stall causes of every thread
+   * registered with RegisterThreadStats() in this module and below. */
+  void PrintThreadReport(std::ostream& ofile, unsigned int top = 3) {
+#ifndef __SYNTHESIS__
+    for (unsigned int i = 0; i < thread_stats_.size(); i++) {
+      thread_stats_[i].second->PrintReport(std::string(name()) + "." + thread_stats_[i].first,
+                                           ofile, top);
+    }
+    std::vector<Module*> children = GetChildren();
+    for (unsigned int x = 0; x < children.size(); x++) {
+      children[x]->PrintThreadReport(ofile, top);
+    }
 #endif
   }
   static const unsigned int width = 0;
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_PACKED_MARSHALLER_H_
+#define NVHLS_PACKED_MARSHALLER_H_
+
+#include <systemc.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_marshaller.h>
+#include <UIntOrEmpty.h>
+
+/**
+ * \def NVHLS_PACKED_MESSAGE
+ * \ingroup Marshaller
+ * Marks a message type as having a packed-word bit layout. The type must also
+ * provide a MarshallFields() visitor that lists its fields in the same order
+ * as Marshall(). In C simulation TypeToBits() and friends then pack the fields
+ * into 64-bit limbs with shifts and masks instead of walking an sc_lv.
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_packed_marshaller.h>
+ *
+ *      class MyMessage : public nvhls_message {
+ *       public:
+ *        NVUINT8 a;
+ *        NVUINT40 b;
+ *        static const unsigned int width = 48;
+ *
+ *        NVHLS_PACKED_MESSAGE;
+ *        template <typename M>
+ *        void MarshallFields(M& m) {
+ *          m& a;
+ *          m& b;
+ *        }
+ *        template <unsigned int Size>
+ *        void Marshall(Marshaller<Size>& m) {
+ *          MarshallFields(m);
+ *        }
+ *      };
+ *
+ * \endcode
+ */
+#define NVHLS_PACKED_MESSAGE typedef void nvhls_packed_message_t
+
+namespace nvhls {
+
+/**
+ * \brief Compile-time trait: true if T was declared with NVHLS_PACKED_MESSAGE.
+ * \ingroup Marshaller
+ */
+template <typename T>
+struct is_packed_message {
+  template <typename U>
+  static char test(typename U::nvhls_packed_message_t*);
+  template <typename U>
+  static long test(...);
+  static const bool value = (sizeof(test<T>(0)) == sizeof(char));
+};
+
+#ifndef __SYNTHESIS__
+
+/**
+ * \brief Marshaller that packs fields into 64-bit limbs.
+ * \ingroup Marshaller
+ *
+ * \tparam Size     Total width in bits of the marshalled type
+ *
+ * \par Overview
+ * - Follows the bit layout of Marshaller: the first field visited occupies the
+ *   least significant bits.
+ * - Integer fields are moved with shifts and masks on their native
+ *   representation. Fields of a type that is not a packed message fall back to
+ *   the Marshaller, so packed and unpacked messages can be nested freely.
+ * - Non-synthesizable; the synthesis view always uses Marshaller.
+ */
+template <unsigned int Size>
+class PackedMarshaller {
+ public:
+  static const unsigned int NumLimbs = (Size == 0) ? 1 : (Size + 63) / 64;
+  uint64 limbs[NumLimbs];
+  unsigned int cur_idx;
+  bool is_unmarshalling;
+
+  PackedMarshaller() : cur_idx(0), is_unmarshalling(false) {
+    for (unsigned i = 0; i < NumLimbs; i++) {
+      limbs[i] = 0;
+    }
+  }
+
+  explicit PackedMarshaller(const uint64* src)
+      : cur_idx(0), is_unmarshalling(true) {
+    for (unsigned i = 0; i < NumLimbs; i++) {
+      limbs[i] = src[i];
+    }
+  }
+
+  static uint64 LowMask(unsigned int w) {
+    return (w >= 64) ? ~static_cast<uint64>(0)
+                     : ((static_cast<uint64>(1) << w) - 1);
+  }
+
+  // Appends the w (<= 64) low bits of v
+  void PutBits(uint64 v, unsigned int w) {
+    unsigned int limb = cur_idx >> 6;
+    unsigned int off = cur_idx & 63;
+    v &= LowMask(w);
+    limbs[limb] |= v << off;
+    if (off + w > 64) {
+      limbs[limb + 1] |= v >> (64 - off);
+    }
+    cur_idx += w;
+  }
+
+  // Consumes the next w (<= 64) bits
+  uint64 GetBits(unsigned int w) {
+    unsigned int limb = cur_idx >> 6;
+    unsigned int off = cur_idx & 63;
+    uint64 v = limbs[limb] >> off;
+    if (off + w > 64) {
+      v |= limbs[limb + 1] << (64 - off);
+    }
+    cur_idx += w;
+    return v & LowMask(w);
+  }
+
+  PackedMarshaller& operator&(bool& rhs) {
+    if (is_unmarshalling) {
+      rhs = (GetBits(1) != 0);
+    } else {
+      PutBits(rhs ? 1 : 0, 1);
+    }
+    return *this;
+  }
+
+  PackedMarshaller& operator&(EmptyField& rhs) { return *this; }
+
+#ifdef HLS_CATAPULT
+  template <int W, bool S>
+  PackedMarshaller& operator&(ac_int<W, S>& rhs) {
+    static const int NumChunks = (W + 63) / 64;
+    if (is_unmarshalling) {
+      uint64 chunk[NumChunks];
+      for (int c = 0; c < NumChunks; c++) {
+        chunk[c] = GetBits((c == NumChunks - 1) ? W - 64 * c : 64);
+      }
+      ac_int<W, false> u = 0;
+      for (int c = NumChunks - 1; c >= 0; c--) {
+        u = (u << 64) | ac_int<64, false>(chunk[c]);
+      }
+      rhs = u;
+    } else {
+      ac_int<W, false> u = rhs;
+      for (int c = 0; c < NumChunks; c++) {
+        PutBits(u.to_uint64(), (c == NumChunks - 1) ? W - 64 * c : 64);
+        u >>= 64;
+      }
+    }
+    return *this;
+  }
+
+#if defined(NVHLS_FAST_SIM_INT) && !defined(__SYNTHESIS__)
+  template <int W, bool S>
+  PackedMarshaller& operator&(nvhls::fast_int<W, S>& rhs) {
+    if (is_unmarshalling) {
+      rhs = nvhls::fast_int<W, S>::FromRaw(GetBits(W));
+    } else {
+      PutBits(rhs.raw(), W);
+    }
+    return *this;
+  }
+#endif
+#endif
+
+  template <int W>
+  PackedMarshaller& operator&(sc_uint<W>& rhs) {
+    if (is_unmarshalling) {
+      rhs = GetBits(W);
+    } else {
+      PutBits(rhs.to_uint64(), W);
+    }
+    return *this;
+  }
+
+  template <int W>
+  PackedMarshaller& operator&(sc_int<W>& rhs) {
+    if (is_unmarshalling) {
+      rhs = static_cast<int64>(GetBits(W));
+    } else {
+      PutBits(static_cast<uint64>(rhs.to_int64()), W);
+    }
+    return *this;
+  }
+
+  template <int W>
+  PackedMarshaller& operator&(sc_biguint<W>& rhs) {
+    for (int lo = 0; lo < W; lo += 64) {
+      int hi = (lo + 64 > W) ? W - 1 : lo + 63;
+      if (is_unmarshalling) {
+        rhs.range(hi, lo) = GetBits(hi - lo + 1);
+      } else {
+        PutBits(rhs.range(hi, lo).to_uint64(), hi - lo + 1);
+      }
+    }
+    return *this;
+  }
+
+  template <int W>
+  PackedMarshaller& operator&(sc_bigint<W>& rhs) {
+    for (int lo = 0; lo < W; lo += 64) {
+      int hi = (lo + 64 > W) ? W - 1 : lo + 63;
+      if (is_unmarshalling) {
+        rhs.range(hi, lo) = GetBits(hi - lo + 1);
+      } else {
+        PutBits(rhs.range(hi, lo).to_uint64(), hi - lo + 1);
+      }
+    }
+    return *this;
+  }
+
+  template <typename T>
+  PackedMarshaller& operator&(T& rhs) {
+    AddField(rhs, tag<is_packed_message<T>::value>());
+    return *this;
+  }
+
+ protected:
+  template <bool B>
+  struct tag {};
+
+  // Nested packed message: visit its fields directly
+  template <typename T>
+  void AddField(T& rhs, tag<true>) {
+    rhs.MarshallFields(*this);
+  }
+
+  // Any other type: go through the Marshaller once and copy the bits
+  template <typename T>
+  void AddField(T& rhs, tag<false>) {
+    static const unsigned int W = Wrapped<T>::width;
+    if (is_unmarshalling) {
+      sc_lv<W> bits;
+      for (unsigned int lo = 0; lo < W; lo += 64) {
+        unsigned int hi = (lo + 64 > W) ? W - 1 : lo + 63;
+        bits.range(hi, lo) = GetBits(hi - lo + 1);
+      }
+      Marshaller<W> m(bits);
+      Wrapped<T> result;
+      result.Marshall(m);
+      rhs = result.val;
+    } else {
+      Marshaller<W> m;
+      Wrapped<T> wm(rhs);
+      wm.Marshall(m);
+      sc_lv<W> bits = m.GetResult();
+      for (unsigned int lo = 0; lo < W; lo += 64) {
+        unsigned int hi = (lo + 64 > W) ? W - 1 : lo + 63;
+        PutBits(bits.range(hi, lo).to_uint64(), hi - lo + 1);
+      }
+    }
+  }
+};
+
+/**
+ * \brief Conversions between a packed message and its bit representation.
+ * \ingroup Marshaller
+ *
+ * Used by TypeToBits(), BitsToType(), TypeToNVUINT() and NVUINTToType() when
+ * is_packed_message<T> holds. The result is bit-identical to the Marshaller.
+ */
+template <typename T, bool IsPacked = is_packed_message<T>::value>
+struct packed_bits {
+  static const unsigned int W = Wrapped<T>::width;
+  typedef PackedMarshaller<W> Packer;
+
+  static sc_lv<W> ToBits(T in) {
+    Packer p;
+    in.MarshallFields(p);
+    sc_lv<W> bits;
+    for (unsigned int i = 0; i < Packer::NumLimbs; i++) {
+      unsigned int lo = 64 * i;
+      unsigned int hi = (lo + 64 > W) ? W - 1 : lo + 63;
+      bits.range(hi, lo) = p.limbs[i];
+    }
+    return bits;
+  }
+
+  static T FromBits(const sc_lv<W>& bits) {
+    uint64 limbs[Packer::NumLimbs];
+    for (unsigned int i = 0; i < Packer::NumLimbs; i++) {
+      unsigned int lo = 64 * i;
+      unsigned int hi = (lo + 64 > W) ? W - 1 : lo + 63;
+      limbs[i] = bits.range(hi, lo).to_uint64();
+    }
+    Packer p(limbs);
+    T result;
+    result.MarshallFields(p);
+    return result;
+  }
+
+  static NVUINTW(W) ToNVUINT(T in) {
+    Packer p;
+    in.MarshallFields(p);
+    NVUINTW(W) result = static_cast<NVUINTW(W)>(p.limbs[Packer::NumLimbs - 1]);
+    for (int i = Packer::NumLimbs - 2; i >= 0; i--) {
+      result = (result << 64) | static_cast<NVUINTW(W)>(p.limbs[i]);
+    }
+    return result;
+  }
+
+  static T FromNVUINT(NVUINTW(W) in) {
+    Packer p;
+    p.is_unmarshalling = true;
+    if (Packer::NumLimbs == 1) {
+      p.limbs[0] = in.to_uint64();
+    } else {
+      for (unsigned int i = 0; i < Packer::NumLimbs; i++) {
+        p.limbs[i] = (in >> (64 * i)).to_uint64();
+      }
+    }
+    T result;
+    result.MarshallFields(p);
+    return result;
+  }
+};
+
+// Never called: keeps the packed branches in TypeToBits.h compilable for
+// types that did not opt in.
+template <typename T>
+struct packed_bits<T, false> {
+  static const unsigned int W = Wrapped<T>::width;
+  static sc_lv<W> ToBits(T in) { return sc_lv<W>(); }
+  static T FromBits(const sc_lv<W>& bits) { return T(); }
+  static NVUINTW(W) ToNVUINT(T in) { return 0; }
+  static T FromNVUINT(NVUINTW(W) in) { return T(); }
+};
+
+#endif  // __SYNTHESIS__
+
+}  // namespace nvhls
+
+#endif  // NVHLS_PACKED_MARSHALLER_H_
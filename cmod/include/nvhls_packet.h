@@ -25,6 +25,7 @@
 #include <nvhls_types.h>
 #include <nvhls_marshaller.h>
 #include <nvhls_message.h>
+#include <nvhls_packed_marshaller.h>
 
 //------------------------------------------------------------------------
 // Packet
@@ -109,12 +110,18 @@ class Packet : public nvhls_message {
   NVUINTW(dest_width) dest;
   NVUINTW(packet_id_width) packet_id;
 
-  template <unsigned int Size>
-  void Marshall(Marshaller<Size>& m) {
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
     m& data;
     m& dest;
     m& packet_id;
   }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    MarshallFields(m);
+  }
 };
 
 //-----------------------------------------------------------------------
@@ -155,11 +162,17 @@ class Packet<DataWidth, DestWidthPerHop, MaxHops, 0> : public nvhls_message {
   NVUINTW(data_width) data;
   NVUINTW(dest_width) dest;
 
-  template <unsigned int Size>
-  void Marshall(Marshaller<Size>& m) {
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
     m& data;
     m& dest;
   }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    MarshallFields(m);
+  }
 };
 
 //------------------------------------------------------------------------
@@ -221,9 +234,15 @@ class FlitId2bit : public nvhls_message {
     return *this;
   }
 
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
+    m& data;
+  }
+
   template <unsigned int Size>
   void Marshall(Marshaller<Size>& m) {
-    m& data;
+    MarshallFields(m);
   }
 
   // Getter and setter providing raw access to the underlying data type
@@ -248,6 +267,67 @@ T& operator<<(T& os, const FlitId2bit& id) {
   return os;
 }
 #endif
+
+/**
+ * \brief FlitID with a packed flag, for links with flit_packer.
+ * \ingroup nvhls_packet
+ *
+ * \par Overview
+ * - The FlitId2bit encoding in the 2 LSBs, plus a packed flag in bit 2.
+ * - A packed flit carries two flits of a packet in the halves of its data:
+ *   it is a header if the first one is, and a tail if the second one is.
+ * - set() clears the packed flag, so code written for FlitId2bit keeps
+ *   working unchanged.
+ */
+class FlitIdPacked : public nvhls_message {
+ public:
+  enum { width = 3 };
+
+  typedef FlitId2bit::Encoding Encoding;
+
+  bool isHeader() const { return (data[0] == 1); }
+  bool isBody() const { return ((data & 3) == FlitId2bit::BODY); }
+  bool isTail() const { return (data[1] == 1); }
+  bool isSingle() const { return ((data & 3) == FlitId2bit::SNGL); }
+  bool isPacked() const { return (data[2] == 1); }
+
+  void set(const Encoding& enc) { data = enc; }
+  void setPacked(bool packed) { data[2] = packed; }
+  void reset() { set(FlitId2bit::BODY); }
+
+  bool operator==(const FlitIdPacked& other) const {
+    return (data == other.data);
+  }
+  FlitIdPacked& operator=(const FlitIdPacked& other) {
+    data = other.data;
+    return *this;
+  }
+
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
+    m& data;
+  }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    MarshallFields(m);
+  }
+
+  // Getter and setter providing raw access to the underlying data type
+  void set_raw(const NVUINTC(width) a) { data = a; }
+  NVUINTC(width) get_raw() { return data; }
+
+  NVUINTC(width) data;
+};
+
+#ifndef __SYNTHESIS__
+template<class T>
+T& operator<<(T& os, const FlitIdPacked& id) {
+  os << id.data;
+  return os;
+}
+#endif
 /**
  * \brief Parameterized implementation of a network flit. 
  * \ingroup nvhls_packet
@@ -320,13 +400,19 @@ class Flit<DataWidth, DestWidthPerHop, MaxHops, PacketIdWidth, FlitId,
   NVUINTW(packet_id_width) packet_id;
   FlitId flit_id;
 
-  template <unsigned int Size>
-  void Marshall(Marshaller<Size>& m) {
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
     m& data;
     m& dest;
     m& packet_id;
     m& flit_id;
   }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    MarshallFields(m);
+  }
 };
 
 template <int DataWidth, int DestWidthPerHop, int MaxHops, int PacketIdWidth,
@@ -402,12 +488,18 @@ class Flit<DataWidth, 0, 0, PacketIdWidth, FlitId, WormHole> : public nvhls_mess
     return packet_id;
   }
 
-  template <unsigned int Size>
-  void Marshall(Marshaller<Size>& m) {
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
     m& data;
     m& packet_id;
     m& flit_id;
   }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    MarshallFields(m);
+  }
 };
 
 template <int DataWidth, int PacketIdWidth, class FlitId>
@@ -469,11 +561,17 @@ class Flit<DataWidth, 0, 0, 0, FlitId, WormHole> : public nvhls_message {
     return 0;
   }
 
-  template <unsigned int Size>
-  void Marshall(Marshaller<Size>& m) {
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
     m& data;
     m& flit_id;
   }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    MarshallFields(m);
+  }
 };
 
 template <int DataWidth, class FlitId>
@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_PORT_STATS_H
+#define NVHLS_PORT_STATS_H
+
+#include <systemc.h>
+#ifndef __SYNTHESIS__
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nvhls_timeline.h>
+#endif
+
+namespace match {
+
+#ifndef __SYNTHESIS__
+
+/**
+ * \brief Transfer, stall, occupancy and latency counters of a buffered port.
+ * \ingroup nvhls_module
+ *
+ * \par Overview
+ * Every buffered Connections port (InBuffered, OutBuffered,
+ * CombinationalBufferedPorts) owns a PortStats. It counts nothing until the
+ * owning match::Module registers it with RegisterPortStats(); after that each
+ * TransferNB() call is sampled as one cycle:
+ * - transfers: messages moved between the channel and the buffer
+ * - stall_cycles: for inputs, cycles the buffer was full; for outputs, cycles
+ *   a message was offered but not accepted (valid without ready)
+ * - occupancy_N: cycles the buffer held N messages
+ * - latency_sum / latency_count: cycles from an input port to a paired
+ *   output port (see PairWith())
+ *
+ * Counters are plain integers, and are printed by Module::DumpStats() next to
+ * the string-keyed stats, as <port name>_<counter>.
+ *
+ * \par A Simple Example
+ * \code
+ *      Connections::InBuffered<Data, 4> data_in;
+ *      Connections::OutBuffered<Data, 2> data_out;
+ *      ...
+ *      // In the match::Module constructor
+ *      RegisterPortStats("data_in", data_in.Stats());
+ *      RegisterPortStats("data_out", data_out.Stats());
+ *      data_in.Stats().PairWith(data_out.Stats());
+ * \endcode
+ */
+class PortStats {
+ public:
+  /* name is relative to the module under construction, if any. */
+  explicit PortStats(unsigned int capacity = 0, const char* name = NULL);
+  ~PortStats();
+
+  void Enable() {
+    if (enabled_) return;
+    enabled_ = true;
+    occupancy_.assign(capacity_ + 1, 0);
+  }
+  bool IsEnabled() const { return enabled_; }
+
+  void SetName(const std::string& name) { name_ = name; }
+  const std::string& Name() const { return name_; }
+  unsigned int Capacity() const { return capacity_; }
+
+  /* Measure latency from messages entering this port to messages leaving
+   * downstream, assuming they leave in the order they entered. */
+  void PairWith(PortStats& downstream) { downstream_ = &downstream; }
+
+  /* Also emit transfers and stall spans on a Timeline track. */
+  void SetTimelineTrack(unsigned int track) { track_ = track; }
+
+  // One call per TransferNB()
+  void Sample(unsigned int occupancy, bool transferred, bool stalled) {
+    cycles_++;
+    if (transferred) transfers_++;
+    if (stalled) stall_cycles_++;
+    if (occupancy < occupancy_.size()) occupancy_[occupancy]++;
+    if (track_ >= 0 && Timeline::Instance().IsEnabled()) {
+      Timeline& timeline = Timeline::Instance();
+      if (transferred) timeline.Instant(track_, "transfer");
+      if (stalled != in_stall_) {
+        if (stalled) {
+          timeline.Begin(track_, "stall");
+        } else {
+          timeline.End(track_, "stall");
+        }
+        in_stall_ = stalled;
+      }
+    }
+  }
+
+  // A message entered an input port
+  void Arrive() {
+    if (downstream_ != NULL && downstream_->enabled_) {
+      downstream_->in_flight_.push_back(downstream_->cycles_);
+    }
+  }
+
+  // A message left an output port
+  void Depart() {
+    if (!in_flight_.empty()) {
+      latency_sum_ += cycles_ - in_flight_.front();
+      latency_count_++;
+      in_flight_.pop_front();
+    }
+  }
+
+  void Clear() {
+    cycles_ = transfers_ = stall_cycles_ = latency_sum_ = latency_count_ = 0;
+    occupancy_.assign(occupancy_.size(), 0);
+    in_flight_.clear();
+  }
+
+  uint64 Cycles() const { return cycles_; }
+  uint64 Transfers() const { return transfers_; }
+  uint64 StallCycles() const { return stall_cycles_; }
+  uint64 LatencySum() const { return latency_sum_; }
+  uint64 LatencyCount() const { return latency_count_; }
+  const std::vector<uint64>& Occupancy() const { return occupancy_; }
+
+  // Appends (name, value) pairs for each counter
+  void GetCounters(const std::string& prefix,
+                   std::vector<std::pair<std::string, uint64> >& out) const {
+    out.push_back(std::make_pair(prefix + "_cycles", cycles_));
+    out.push_back(std::make_pair(prefix + "_transfers", transfers_));
+    out.push_back(std::make_pair(prefix + "_stall_cycles", stall_cycles_));
+    for (unsigned int i = 0; i < occupancy_.size(); i++) {
+      std::stringstream name;
+      name << prefix << "_occupancy_" << i;
+      out.push_back(std::make_pair(name.str(), occupancy_[i]));
+    }
+    if (latency_count_ != 0) {
+      out.push_back(std::make_pair(prefix + "_latency_sum", latency_sum_));
+      out.push_back(std::make_pair(prefix + "_latency_count", latency_count_));
+    }
+  }
+
+ private:
+  bool enabled_;
+  unsigned int capacity_;
+  std::string name_;
+  PortStats* downstream_;
+  uint64 cycles_;
+  uint64 transfers_;
+  uint64 stall_cycles_;
+  uint64 latency_sum_;
+  uint64 latency_count_;
+  std::vector<uint64> occupancy_;
+  std::deque<uint64> in_flight_;
+  int track_;
+  bool in_stall_;
+};
+
+/**
+ * \brief Buffer depth profiling of every buffered port.
+ * \ingroup nvhls_module
+ *
+ * \par Overview
+ * With the NVHLS_DEPTH_PROFILE environment variable set to a file name (or
+ * after Enable() during elaboration), every PortStats constructed from then
+ * on counts from the start, registered or not: the buffered ports (InBuffered,
+ * OutBuffered, CombinationalBufferedPorts) and the Buffer and BypassBuffered
+ * channels. At exit, or on Dump(), each instance is written as
+ * \code
+ *   "tb.dut.in": { "latency": 0, "capacity": 4, "depth": 4,
+ *                  "recommended_depth": 8, "cycles": 1000, "full_cycles": 37,
+ *                  "max_occupancy": 4, "percentile_occupancy": 3, ... }
+ * \endcode
+ * - full_cycles are the sampled cycles the buffer was full, the stalls of the
+ *   producer that the depth causes.
+ * - percentile_occupancy is the occupancy that covers NVHLS_DEPTH_PERCENTILE
+ *   percent (default 99) of the cycles.
+ * - recommended_depth is max_occupancy (at least 1) when the buffer never
+ *   filled, since any depth from there on replays the same run, and twice
+ *   the depth when it did fill, as a larger depth may remove those stalls.
+ * - latency and capacity follow the annotate_design input format, capacity
+ *   being the entries to add (recommended_depth - depth, at least 0).
+ *   bin/perf_annotate.py depths moves them onto the channels of a
+ *   BASE.output.json whose src_name or dest_name is the instance.
+ */
+class DepthProfile {
+ public:
+  static DepthProfile& Instance() {
+    static DepthProfile profile;
+    return profile;
+  }
+
+  bool IsEnabled() const { return enabled_; }
+
+  void Enable(const std::string& filename = "") {
+    enabled_ = true;
+    if (!filename.empty()) filename_ = filename;
+  }
+
+  void Add(PortStats* stats) { live_.push_back(stats); }
+
+  // Keeps the counters of a PortStats that goes away before the dump
+  void Remove(PortStats* stats) {
+    for (unsigned int i = 0; i < live_.size(); i++) {
+      if (live_[i] == stats) {
+        done_.push_back(Snapshot(*stats));
+        live_.erase(live_.begin() + i);
+        return;
+      }
+    }
+  }
+
+  void Write(std::ostream& os) const {
+    std::vector<Record> records = done_;
+    for (unsigned int i = 0; i < live_.size(); i++) {
+      records.push_back(Snapshot(*live_[i]));
+    }
+    os << "{\n";
+    for (unsigned int i = 0; i < records.size(); i++) {
+      WriteRecord(os, records[i]);
+      os << (i + 1 < records.size() ? "," : "") << "\n";
+    }
+    os << "}" << std::endl;
+  }
+
+  bool Dump(const std::string& filename) const {
+    std::ofstream ofile(filename.c_str());
+    if (!ofile) {
+      std::cerr << "Error: cannot open depth profile " << filename << std::endl;
+      return false;
+    }
+    Write(ofile);
+    return ofile.good();
+  }
+
+  ~DepthProfile() {
+    if (enabled_ && !filename_.empty()) Dump(filename_);
+  }
+
+ private:
+  struct Record {
+    std::string name;
+    unsigned int capacity;
+    uint64 cycles;
+    uint64 transfers;
+    uint64 stall_cycles;
+    std::vector<uint64> occupancy;
+  };
+
+  bool enabled_;
+  std::string filename_;
+  double percentile_;
+  std::vector<PortStats*> live_;
+  std::vector<Record> done_;
+
+  DepthProfile() : enabled_(false), percentile_(99.0) {
+    const char* file = std::getenv("NVHLS_DEPTH_PROFILE");
+    if (file != NULL && *file != '\0') Enable(file);
+    const char* pct = std::getenv("NVHLS_DEPTH_PERCENTILE");
+    if (pct != NULL) percentile_ = std::atof(pct);
+  }
+
+  static Record Snapshot(const PortStats& stats) {
+    Record r;
+    r.name = stats.Name();
+    r.capacity = stats.Capacity();
+    r.cycles = stats.Cycles();
+    r.transfers = stats.Transfers();
+    r.stall_cycles = stats.StallCycles();
+    r.occupancy = stats.Occupancy();
+    return r;
+  }
+
+  void WriteRecord(std::ostream& os, const Record& r) const {
+    uint64 samples = 0;
+    unsigned int max_occ = 0;
+    for (unsigned int i = 0; i < r.occupancy.size(); i++) {
+      samples += r.occupancy[i];
+      if (r.occupancy[i] != 0) max_occ = i;
+    }
+    unsigned int pct_occ = 0;
+    uint64 covered = 0;
+    for (unsigned int i = 0; i < r.occupancy.size(); i++) {
+      covered += r.occupancy[i];
+      pct_occ = i;
+      if (samples == 0 || 100.0 * covered >= percentile_ * samples) break;
+    }
+    uint64 full = (r.capacity < r.occupancy.size()) ? r.occupancy[r.capacity] : 0;
+    unsigned int recommended = (full != 0) ? 2 * r.capacity : (max_occ > 0 ? max_occ : 1);
+    unsigned int extra = (recommended > r.capacity) ? recommended - r.capacity : 0;
+    os << "  \"" << r.name << "\": {\"latency\": 0, \"capacity\": " << extra
+       << ", \"depth\": " << r.capacity << ", \"recommended_depth\": " << recommended
+       << ", \"cycles\": " << r.cycles << ", \"transfers\": " << r.transfers
+       << ", \"stall_cycles\": " << r.stall_cycles << ", \"full_cycles\": " << full
+       << ", \"max_occupancy\": " << max_occ << ", \"percentile\": " << percentile_
+       << ", \"percentile_occupancy\": " << pct_occ << "}";
+  }
+};
+
+inline PortStats::PortStats(unsigned int capacity, const char* name)
+    : enabled_(false), capacity_(capacity), downstream_(NULL), cycles_(0),
+      transfers_(0), stall_cycles_(0), latency_sum_(0), latency_count_(0),
+      track_(-1), in_stall_(false) {
+  if (name != NULL) {
+    sc_object* parent = sc_get_current_object();
+    name_ = parent ? std::string(parent->name()) + "." + name : std::string(name);
+  }
+  if (DepthProfile::Instance().IsEnabled()) {
+    Enable();
+    DepthProfile::Instance().Add(this);
+  }
+}
+
+inline PortStats::~PortStats() { DepthProfile::Instance().Remove(this); }
+
+#else
+
+// Synthesis view: no counters
+class PortStats {
+ public:
+  explicit PortStats(unsigned int capacity = 0, const char* name = NULL) {}
+  void PairWith(PortStats& downstream) {}
+  void SetName(const char* name) {}
+};
+
+#endif  // __SYNTHESIS__
+
+}  // namespace match
+
+#endif  // NVHLS_PORT_STATS_H
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_PROFILER_H
+#define NVHLS_PROFILER_H
+
+#ifndef __SYNTHESIS__
+
+#include <systemc.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * \brief NVHLS_PROFILE define: Profile the host time of match::Module processes.
+ * \ingroup nvhls_module
+ *
+ * Defining NVHLS_PROFILE makes every wait() and wait(n) called from a
+ * match::Module process report to match::Profiler, which then prints the host
+ * time and activations of every process and module at the end of the
+ * simulation. Without it, the wait() calls are those of sc_module.
+ */
+
+namespace match {
+
+/**
+ * \brief Host CPU time and activation counts of SystemC processes.
+ * \ingroup nvhls_module
+ *
+ * \par Overview
+ * The profiler reads the CPU cycle counter (rdtsc, or a steady clock on
+ * other hosts) each time a process resumes or suspends, and charges the
+ * cycles in between to the process that was running:
+ * - With NVHLS_PROFILE defined, match::Module::wait() suspends and resumes
+ *   the calling process around the wait, so match::Module threads need no
+ *   changes.
+ * - A ProfileScope at the top of an SC_METHOD, or of a thread loop outside
+ *   of a match::Module, marks the rest of the block as an activation.
+ * - Cycles between a suspend and the next resume are the kernel's and those
+ *   of unprofiled processes, and are reported as "other". A process that
+ *   blocks in a Connections Push() or Pop(), whose waits are not profiled, is
+ *   charged until the next profiled process resumes, and counts one more
+ *   activation when it suspends again.
+ *
+ * Report() prints the processes sorted by host time, with their activations
+ * and time per activation, followed by the totals of their parent modules
+ * and the elaboration time, from the first match::Module constructed to the
+ * first process activation.
+ * When anything was profiled and Report() was never called, the report is
+ * printed to std::cout as the program exits.
+ *
+ * \par A Simple Example
+ * \code
+ *      // Build with USER_FLAGS += -DNVHLS_PROFILE
+ *      void Dut::Update() {   // SC_METHOD
+ *        match::ProfileScope profile;
+ *        ...
+ *      }
+ *      ...
+ *      sc_start();
+ *      match::Profiler::Instance().Report(std::cout);
+ * \endcode
+ * \par
+ *
+ */
+class Profiler {
+ public:
+  struct Process {
+    std::string name;
+    std::string module;
+    uint64 cycles;
+    uint64 activations;
+    Process() : cycles(0), activations(0) {}
+  };
+
+  static Profiler& Instance() {
+    static Profiler profiler;
+    return profiler;
+  }
+
+  static uint64 Now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
+
+  /* The calling process starts running. */
+  void Resume() {
+    Process* proc = Current();
+    Start();
+    Charge();
+    running_ = proc;
+    if (proc != NULL) proc->activations++;
+  }
+
+  /* The calling process stops running, e.g. right before a wait(). */
+  void Suspend() {
+    Process* proc = Current();
+    // Resumed without passing through Resume(), e.g. at its first activation
+    if (proc != NULL && running_ != proc) proc->activations++;
+    Start();
+    Charge();
+    running_ = NULL;
+  }
+
+  /* Seconds per counter cycle, measured against the steady clock. */
+  double SecondsPerCycle() const {
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start_time_).count();
+    uint64 cycles = Now() - start_cycles_;
+    return cycles == 0 ? 0.0 : seconds / cycles;
+  }
+
+  const std::map<const sc_object*, Process>& Processes() const { return processes_; }
+  uint64 OtherCycles() const { return other_; }
+  /* Cycles from the first match::Module constructed to the first process
+   * activation, i.e. elaboration and initialization. */
+  uint64 ElaborationCycles() const { return elab_cycles_; }
+
+  void Report(std::ostream& ofile) {
+    reported_ = true;
+    Charge();
+    double scale = SecondsPerCycle() * 1e3;
+    std::vector<const Process*> procs;
+    std::map<std::string, Process> modules;
+    uint64 total = other_;
+    for (std::map<const sc_object*, Process>::const_iterator it = processes_.begin();
+         it != processes_.end(); it++) {
+      procs.push_back(&it->second);
+      Process& module = modules[it->second.module];
+      module.name = it->second.module;
+      module.cycles += it->second.cycles;
+      module.activations += it->second.activations;
+      total += it->second.cycles;
+    }
+    std::sort(procs.begin(), procs.end(), ByCycles);
+    ofile << "Host time per process:" << std::endl;
+    for (unsigned int i = 0; i < procs.size(); i++) {
+      Print(ofile, *procs[i], total, scale);
+    }
+    Process other;
+    other.name = "other";
+    other.cycles = other_;
+    Print(ofile, other, total, scale);
+
+    procs.clear();
+    for (std::map<std::string, Process>::const_iterator it = modules.begin();
+         it != modules.end(); it++) {
+      procs.push_back(&it->second);
+    }
+    std::sort(procs.begin(), procs.end(), ByCycles);
+    ofile << "Host time per module:" << std::endl;
+    for (unsigned int i = 0; i < procs.size(); i++) {
+      Print(ofile, *procs[i], total, scale);
+    }
+    ofile << "Elaboration: " << std::fixed << std::setprecision(3)
+          << elab_cycles_ * scale << " ms" << std::endl;
+  }
+
+  void Clear() {
+    processes_.clear();
+    running_ = NULL;
+    other_ = 0;
+    last_ = Now();
+  }
+
+ protected:
+  Profiler()
+      : running_(NULL), other_(0), reported_(false), started_(false), elab_cycles_(0),
+        start_time_(std::chrono::steady_clock::now()) {
+    start_cycles_ = last_ = Now();
+  }
+
+  /* The first process event ends the elaboration, which is not charged. */
+  void Start() {
+    if (!started_) {
+      started_ = true;
+      last_ = Now();
+      elab_cycles_ = last_ - start_cycles_;
+    }
+  }
+
+  ~Profiler() {
+    if (!reported_ && !processes_.empty()) {
+      Report(std::cout);
+    }
+  }
+
+  /* Record of the calling process, or NULL outside of a process. */
+  Process* Current() {
+    sc_object* obj = sc_core::sc_get_current_process_b();
+    if (obj == NULL) return NULL;
+    std::map<const sc_object*, Process>::iterator it = processes_.find(obj);
+    if (it == processes_.end()) {
+      Process& proc = processes_[obj];
+      proc.name = obj->name();
+      sc_object* parent = obj->get_parent_object();
+      proc.module = parent != NULL ? parent->name() : "";
+      return &proc;
+    }
+    return &it->second;
+  }
+
+  /* Adds the cycles since the last event to the running process. */
+  void Charge() {
+    uint64 now = Now();
+    if (running_ != NULL) {
+      running_->cycles += now - last_;
+    } else {
+      other_ += now - last_;
+    }
+    last_ = now;
+  }
+
+  static bool ByCycles(const Process* a, const Process* b) {
+    return a->cycles > b->cycles;
+  }
+
+  static void Print(std::ostream& ofile, const Process& proc, uint64 total,
+                    double scale) {
+    double ms = proc.cycles * scale;
+    ofile << "  " << proc.name << ": " << std::fixed << std::setprecision(3) << ms
+          << " ms (" << std::setprecision(1)
+          << (total == 0 ? 0.0 : 100.0 * proc.cycles / total) << "%)";
+    if (proc.activations != 0) {
+      ofile << ", " << proc.activations << " activations, " << std::setprecision(3)
+            << ms * 1e3 / proc.activations << " us/activation";
+    }
+    ofile << std::endl;
+  }
+
+  std::map<const sc_object*, Process> processes_;
+  Process* running_;
+  uint64 last_;
+  uint64 other_;
+  bool reported_;
+  bool started_;
+  uint64 elab_cycles_;
+  uint64 start_cycles_;
+  std::chrono::steady_clock::time_point start_time_;
+};
+
+/**
+ * \brief Profiles the enclosing scope as one activation of the calling process.
+ * \ingroup nvhls_module
+ */
+class ProfileScope {
+ public:
+  ProfileScope() { Profiler::Instance().Resume(); }
+  ~ProfileScope() { Profiler::Instance().Suspend(); }
+};
+
+}  // namespace match
+
+#endif  // __SYNTHESIS__
+
+#endif  // NVHLS_PROFILER_H
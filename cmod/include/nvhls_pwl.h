@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_PWL_H
+#define NVHLS_PWL_H
+
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <type_traits>
+
+/* Piecewise-linear approximation of a function, with its tables of knots
+ * computed at compile time.
+ *
+ * The functions are structs with a constexpr eval(double); PwlExp,
+ * PwlSigmoid, PwlTanh and PwlLog are provided, on the constexpr pwl_exp and
+ * pwl_log below. PwlApprox has the load/steps/unload interface of the units
+ * in nvhls_divsqrt.h, so nvhls::ArithPipelined can register its lookup.
+ */
+
+namespace nvhls {
+
+// C++11 constexpr exp and natural log, for the knot values
+constexpr double pwl_sq(double x) { return x * x; }
+constexpr double pwl_abs(double x) { return x < 0 ? -x : x; }
+constexpr double pwl_max(double a, double b) { return a > b ? a : b; }
+
+constexpr double pwl_exp_series(double x, double term, unsigned int n) {
+  return (n > 30) ? 0.0 : term + pwl_exp_series(x, term * x / n, n + 1);
+}
+
+constexpr double pwl_exp(double x) {
+  return (x < -745.0)
+             ? 0.0
+             : (x > 460.0) ? 1e200
+                           : (x < -0.5) ? 1.0 / pwl_exp(-x)
+                                        : (x > 0.5) ? pwl_sq(pwl_exp(x / 2))
+                                                    : pwl_exp_series(x, 1.0, 1);
+}
+
+// 2 * atanh(z) = ln((1 + z) / (1 - z))
+constexpr double pwl_atanh_series(double z2, double zn, unsigned int n) {
+  return (n > 61) ? 0.0 : zn / n + pwl_atanh_series(z2, zn * z2, n + 2);
+}
+
+constexpr double pwl_log_reduced(double x) {
+  return (x >= 2.0) ? 0.6931471805599453 + pwl_log_reduced(x / 2)
+                    : (x < 1.0) ? pwl_log_reduced(2 * x) - 0.6931471805599453
+                                : 2 * pwl_atanh_series(pwl_sq((x - 1) / (x + 1)),
+                                                       (x - 1) / (x + 1), 1);
+}
+
+// Very negative at 0, which the tables saturate
+constexpr double pwl_log(double x) { return (x <= 0.0) ? -1e200 : pwl_log_reduced(x); }
+
+struct PwlExp {
+  static constexpr double eval(double x) { return pwl_exp(x); }
+};
+
+struct PwlSigmoid {
+  static constexpr double eval(double x) { return 1.0 / (1.0 + pwl_exp(-x)); }
+};
+
+struct PwlTanh {
+  static constexpr double eval(double x) { return 2.0 / (1.0 + pwl_exp(-2 * x)) - 1.0; }
+};
+
+struct PwlLog {
+  static constexpr double eval(double x) { return pwl_log(x); }
+};
+
+/**
+ * \brief Uniform segments for PwlApprox: the top SegBits input bits pick the segment
+ * \ingroup PwlApprox
+ */
+template <unsigned int SegBits>
+struct PwlUniform {
+  template <unsigned int W>
+  struct Map {
+    static_assert(SegBits >= 1 && SegBits <= W, "SegBits must be within the input width");
+    static const unsigned int NumSegments = 1 << SegBits;
+    // Fraction bits of the position within a segment
+    static const unsigned int TBits = W - SegBits;
+    static const bool NeedsUnsigned = false;
+
+    static constexpr unsigned long long start(unsigned long long seg) {
+      return seg << TBits;
+    }
+    static constexpr unsigned long long width(unsigned long long seg) {
+      return 1ULL << TBits;
+    }
+
+    template <typename U, typename Seg, typename T>
+    static void locate(const U& u, Seg& seg, T& t) {
+      seg = get_slc<SegBits>(u, TBits);
+      t = get_slc<(TBits > 0 ? TBits : 1)>(u, 0);
+      if (TBits == 0) {
+        t = 0;
+      }
+    }
+  };
+};
+
+/**
+ * \brief Segments for PwlApprox that halve in width toward zero: 2^SubBits per octave
+ * \ingroup PwlApprox
+ *
+ * \par Overview
+ * nvhls::lzd finds the octave of the (unsigned) input, and the SubBits bits
+ * after its leading one the segment within the octave. Inputs below
+ * 2^(SubBits+1) each have their own segment. This suits functions such as
+ * log that bend most near zero.
+ */
+template <unsigned int SubBits>
+struct PwlOctave {
+  template <unsigned int W>
+  struct Map {
+    static_assert(SubBits >= 1 && SubBits + 1 < W, "SubBits must be below the input width");
+    static const unsigned int NumSegments = (W - SubBits + 1) << SubBits;
+    static const unsigned int TBits = W - 1 - SubBits;
+    static const bool NeedsUnsigned = true;
+
+    // Octave o >= 2 spans [2^p, 2^(p+1)) with p = o + SubBits - 1
+    static constexpr unsigned long long start(unsigned long long seg) {
+      return ((seg >> SubBits) <= 1)
+                 ? seg
+                 : (1ULL << ((seg >> SubBits) + SubBits - 1)) +
+                       ((seg & ((1ULL << SubBits) - 1)) << ((seg >> SubBits) - 1));
+    }
+    static constexpr unsigned long long width(unsigned long long seg) {
+      return ((seg >> SubBits) <= 1) ? 1 : 1ULL << ((seg >> SubBits) - 1);
+    }
+
+    template <typename U, typename Seg, typename T>
+    static void locate(const U& u, Seg& seg, T& t) {
+      unsigned int lz = lzd(u);
+      U a = u << lz;
+      if ((u >> SubBits) <= 1) {
+        seg = u;
+      } else {
+        seg = get_slc<SubBits>(a, W - 1 - SubBits);
+        seg = seg | (Seg(W - lz - SubBits) << SubBits);
+      }
+      // Zero for the inputs below 2^(SubBits+1)
+      t = get_slc<TBits>(a, 0);
+      if ((u >> SubBits) <= 1) {
+        t = 0;
+      }
+    }
+  };
+};
+
+/**
+ * \brief Piecewise-linear function approximation with compile-time tables
+ * \ingroup PwlApprox
+ *
+ * \tparam Func      Function to approximate: a struct with static constexpr double eval(double)
+ * \tparam InW       Input width
+ * \tparam InFrac    Input fraction bits
+ * \tparam OutW      Output width (signed)
+ * \tparam OutFrac   Output fraction bits
+ * \tparam Segments  PwlUniform or PwlOctave (default: 64 uniform segments)
+ * \tparam Signed    Signed input (default: true); PwlOctave needs unsigned inputs
+ *
+ * \par Overview
+ * Segments picks the segment of the input and its position t in [0, 1)
+ * within it; the result is y0 + (y1 - y0) * t, one multiply and one add,
+ * where y0 and y1 are the values of Func at the ends of the segment,
+ * rounded to OutFrac bits and saturated to OutW. The tables of y0 and
+ * y1 - y0 are generated at compile time from Func::eval, so the hardware
+ * holds only constants.
+ * - For a function with a bounded second derivative f'' the error is at
+ *   most h^2 / 8 * max|f''| over a segment of width h, plus one unit of the
+ *   output from rounding. error_bound() estimates it from the distance to
+ *   the chord at eighths of each segment.
+ * - NumSteps is 2, the lookup and the interpolation; see
+ *   nvhls::ArithPipelined in nvhls_divsqrt.h.
+ * .
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_pwl.h>
+ *
+ *      ...
+ *      // Sigmoid of a Q4.12 input, 64 segments, Q1.14 output
+ *      typedef nvhls::PwlApprox<nvhls::PwlSigmoid, 16, 12, 16, 14> Sigmoid;
+ *      Sigmoid::In in;
+ *      Sigmoid::Out out;
+ *      in.x = x;
+ *      Sigmoid::compute(in, out);
+ *      ...
+ *      // log of a Q8.8 input, 8 segments per octave
+ *      typedef nvhls::PwlApprox<nvhls::PwlLog, 16, 8, 16, 11,
+ *                               nvhls::PwlOctave<3>, false> Log;
+ * \endcode
+ * \par
+ *
+ */
+template <typename Func, unsigned int InW, unsigned int InFrac, unsigned int OutW,
+          unsigned int OutFrac, typename Segments = PwlUniform<6>, bool Signed = true>
+class PwlApprox {
+ public:
+  typedef typename Segments::template Map<InW> Map;
+  static const unsigned int NumSegments = Map::NumSegments;
+  static const unsigned int TBits = Map::TBits;
+  static const unsigned int NumSteps = 2;
+  static_assert(!Signed || !Map::NeedsUnsigned, "PwlOctave needs unsigned inputs");
+  static_assert(OutW <= 63, "Output wider than the table entries");
+
+  typedef typename std::conditional<Signed, typename nvhls_t<InW>::nvint_t,
+                                    typename nvhls_t<InW>::nvuint_t>::type Data;
+  typedef typename nvhls_t<InW>::nvuint_t Unsigned;
+  typedef typename nvhls_t<OutW>::nvint_t Result;
+  typedef typename nvhls_t<OutW + 1>::nvint_t Delta;
+  typedef typename nvhls_t<index_width<NumSegments>::val>::nvuint_t Seg;
+  typedef typename nvhls_t<(TBits > 0 ? TBits : 1)>::nvuint_t Pos;
+
+  struct In {
+    Data x;
+  };
+  struct Out {
+    Result y;
+  };
+  struct State {
+    Unsigned u;   // input offset to unsigned
+    Result y0;
+    Delta dy;
+    Pos t;
+    Result y;
+  };
+
+  // Input and output scaling, and knot values rounded and saturated
+  static constexpr double scale(int bits) {
+    return (bits == 0) ? 1.0 : (bits > 0) ? 2.0 * scale(bits - 1) : 0.5 * scale(bits + 1);
+  }
+  static constexpr double input(unsigned long long u) {
+    return ((double)u - (Signed ? scale(InW - 1) : 0.0)) / scale(InFrac);
+  }
+  static constexpr long long clamp(double v) {
+    return (v >= scale(OutW - 1) - 1) ? (long long)(scale(OutW - 1) - 1)
+           : (v <= -scale(OutW - 1))  ? -(long long)scale(OutW - 1)
+           : (v >= 0)                 ? (long long)(v + 0.5)
+                                      : -(long long)(0.5 - v);
+  }
+  static constexpr long long knot(unsigned long long u) {
+    return clamp(Func::eval(input(u)) * scale(OutFrac));
+  }
+
+  template <unsigned int I>
+  struct entry {
+    static constexpr long long y0 = knot(Map::start(I));
+    static constexpr long long dy = knot(Map::start(I) + Map::width(I)) - y0;
+  };
+
+  // Fills [Lo, Lo+N), halving so that the recursion stays shallow
+  template <unsigned int Lo, unsigned int N, bool One = (N == 1)>
+  struct fill_tables {
+    static void fill(Result y0[], Delta dy[]) {
+      fill_tables<Lo, N / 2>::fill(y0, dy);
+      fill_tables<Lo + N / 2, N - N / 2>::fill(y0, dy);
+    }
+  };
+  template <unsigned int Lo, unsigned int N>
+  struct fill_tables<Lo, N, true> {
+    static void fill(Result y0[], Delta dy[]) {
+      y0[Lo] = entry<Lo>::y0;
+      dy[Lo] = entry<Lo>::dy;
+    }
+  };
+
+  // Largest distance of Func from the chord at eighths of a segment, in
+  // output units. Segments of one input have only the rounding, and
+  // segments whose ends saturate are left out.
+  static constexpr double chord_error(unsigned long long seg, unsigned int k) {
+    return (k == 0)
+               ? 0.0
+               : pwl_max(chord_error(seg, k - 1),
+                         pwl_abs(Func::eval(input(Map::start(seg)) +
+                                            (input(Map::start(seg) + Map::width(seg)) -
+                                             input(Map::start(seg))) * k / 8) -
+                                 Func::eval(input(Map::start(seg))) -
+                                 (Func::eval(input(Map::start(seg) + Map::width(seg))) -
+                                  Func::eval(input(Map::start(seg)))) * k / 8) *
+                             scale(OutFrac));
+  }
+  static constexpr bool saturates(unsigned long long u) {
+    return knot(u) == clamp(scale(OutW)) || knot(u) == clamp(-scale(OutW));
+  }
+  static constexpr double segment_error(unsigned long long seg) {
+    return (Map::width(seg) == 1 || saturates(Map::start(seg)) ||
+            saturates(Map::start(seg) + Map::width(seg)))
+               ? 0.0
+               : chord_error(seg, 7);
+  }
+  static constexpr double max_error(unsigned long long lo, unsigned long long n) {
+    return (n == 1) ? segment_error(lo)
+                    : pwl_max(max_error(lo, n / 2), max_error(lo + n / 2, n - n / 2));
+  }
+  // The peak of a smooth distance lies within 1/16 of a segment of a
+  // sample, which it exceeds by at most about 1/64; one unit is rounding
+  static double error_bound() {
+    return (max_error(0, NumSegments) * 65 / 64 + 1) / scale(OutFrac);
+  }
+
+  static void load(const In& in, State& s) {
+    s.u = in.x;
+    if (Signed) {
+      s.u = s.u ^ (Unsigned(1) << (InW - 1));
+    }
+  }
+
+  static void steps(State& s, unsigned int first, unsigned int last) {
+    if (first == 0 && last > 0) {
+      Result y0[NumSegments];
+      Delta dy[NumSegments];
+      fill_tables<0, NumSegments>::fill(y0, dy);
+      Seg seg;
+      Map::locate(s.u, seg, s.t);
+      s.y0 = y0[seg.to_uint()];
+      s.dy = dy[seg.to_uint()];
+    }
+    if (first <= 1 && last > 1) {
+      typedef typename nvhls_t<OutW + 1 + TBits + 1>::nvint_t Product;
+      Product p = s.dy * s.t;
+      if (TBits > 0) {
+        p = (p + (Product(1) << (TBits > 0 ? TBits - 1 : 0))) >> TBits;
+      }
+      s.y = s.y0 + p;
+    }
+  }
+
+  static void unload(const State& s, Out& out) { out.y = s.y; }
+
+  static void compute(const In& in, Out& out) {
+    State s;
+    load(in, s);
+    steps(s, 0, NumSteps);
+    unload(s, out);
+  }
+};
+
+}  // namespace nvhls
+
+#endif  // NVHLS_PWL_H
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_SAMPLING_H
+#define NVHLS_SAMPLING_H
+
+#ifndef __SYNTHESIS__
+
+#include <systemc.h>
+#include <nvhls_assert.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace nvhls {
+
+/**
+ * \brief Sampled simulation: functional fast-forward with detailed windows
+ * \ingroup Sampling
+ *
+ * \par Overview
+ * In functional mode, blocks that support it skip their contention
+ * modeling: ScratchpadClass::load_store_partial() and
+ * ArbitratedScratchpad::load_store() serve every valid lane in the same
+ * call, as a plain memory would. SamplingController alternates between a
+ * functional fast-forward and detailed windows, and scales the registered
+ * counters measured in the windows to the whole run.
+ *
+ * Functional() is a single flag read, so blocks can check it every call.
+ * Models with their own functional variants can follow the mode with
+ * OnModeChange().
+ *
+ * \par A Simple Example
+ * \code
+ *      // In sc_main: 90k functional cycles, then 1k warmup and 9k measured detailed cycles
+ *      nvhls::SamplingController sampling("sampling", 90000, 1000, 9000);
+ *      sampling.clk(clk);
+ *      nvhls::Sampling::Instance().RegisterCounter("tb.dut.requests", dut.requests);
+ *      sc_start(...);
+ *      nvhls::Sampling::Instance().Report(std::cout);
+ * \endcode
+ * \par
+ *
+ */
+class Sampling {
+ public:
+  enum Mode { DETAILED, FUNCTIONAL };
+
+  static Sampling& Instance() {
+    static Sampling sampling;
+    return sampling;
+  }
+
+  static bool Functional() { return State<0>::functional; }
+
+  void SetMode(Mode mode) {
+    if ((mode == FUNCTIONAL) == State<0>::functional) {
+      return;
+    }
+    State<0>::functional = (mode == FUNCTIONAL);
+    for (unsigned i = 0; i < listeners.size(); i++) {
+      listeners[i](mode);
+    }
+  }
+
+  void OnModeChange(std::function<void(Mode)> listener) { listeners.push_back(listener); }
+
+  /** \brief Registers a counter whose windowed increments are extrapolated */
+  template <typename T>
+  void RegisterCounter(const std::string& name, const T& counter) {
+    const T* ptr = &counter;
+    RegisterCounter(name, std::function<double()>([ptr]() { return static_cast<double>(*ptr); }));
+  }
+
+  void RegisterCounter(const std::string& name, std::function<double()> read) {
+    Counter c;
+    c.name = name;
+    c.read = read;
+    c.start = 0;
+    c.measured = 0;
+    counters.push_back(c);
+  }
+
+  // Called by SamplingController at the edges of the measured windows
+  void BeginWindow() {
+    for (unsigned i = 0; i < counters.size(); i++) {
+      counters[i].start = counters[i].read();
+    }
+  }
+
+  void EndWindow(uint64 cycles) {
+    for (unsigned i = 0; i < counters.size(); i++) {
+      counters[i].measured += counters[i].read() - counters[i].start;
+    }
+    measured_cycles += cycles;
+    windows++;
+  }
+
+  void SetTotalCycles(uint64 cycles) { total_cycles = cycles; }
+
+  uint64 MeasuredCycles() const { return measured_cycles; }
+  uint64 TotalCycles() const { return total_cycles; }
+  unsigned Windows() const { return windows; }
+
+  /** \brief Increments of the counter in the measured windows */
+  double Measured(const std::string& name) const { return Find(name).measured; }
+
+  /** \brief The counter over the whole run, scaled from the measured windows */
+  double Estimate(const std::string& name) const {
+    return measured_cycles == 0 ? 0.0 : Find(name).measured * double(total_cycles) / measured_cycles;
+  }
+
+  void Report(std::ostream& os) const {
+    os << "Sampled " << measured_cycles << " of " << total_cycles << " cycles in " << windows << " windows"
+       << std::endl;
+    for (unsigned i = 0; i < counters.size(); i++) {
+      os << "  " << counters[i].name << ": measured " << counters[i].measured << ", estimate "
+         << Estimate(counters[i].name) << std::endl;
+    }
+  }
+
+ private:
+  struct Counter {
+    std::string name;
+    std::function<double()> read;
+    double start;
+    double measured;
+  };
+
+  template <int N>
+  struct State {
+    static bool functional;
+  };
+
+  std::vector<Counter> counters;
+  std::vector<std::function<void(Mode)> > listeners;
+  uint64 measured_cycles;
+  uint64 total_cycles;
+  unsigned windows;
+
+  Sampling() : measured_cycles(0), total_cycles(0), windows(0) {}
+  Sampling(const Sampling&);
+  Sampling& operator=(const Sampling&);
+
+  const Counter& Find(const std::string& name) const {
+    for (unsigned i = 0; i < counters.size(); i++) {
+      if (counters[i].name == name) {
+        return counters[i];
+      }
+    }
+    NVHLS_ASSERT_MSG(false, "Sampling counter is not registered");
+    return counters[0];
+  }
+};
+
+template <int N>
+bool Sampling::State<N>::functional = false;
+
+/**
+ * \brief Switches nvhls::Sampling between fast-forward and detailed windows
+ * \ingroup Sampling
+ *
+ * Each period is fast_forward functional cycles, then warmup detailed cycles
+ * that refill the queues, then window detailed cycles whose counter
+ * increments are measured. With a zero fast_forward the whole run is
+ * detailed. NVHLS_SAMPLING set to
+ * "fast_forward,warmup,window" overrides the constructor values.
+ */
+class SamplingController : public sc_module {
+  SC_HAS_PROCESS(SamplingController);
+
+ public:
+  sc_in_clk clk;
+
+  SamplingController(sc_module_name name, uint64 fast_forward_, uint64 warmup_, uint64 window_)
+      : sc_module(name), clk("clk"), fast_forward(fast_forward_), warmup(warmup_), window(window_), cycle(0),
+        in_window(false), window_begin(0) {
+    const char* env = std::getenv("NVHLS_SAMPLING");
+    unsigned long long ff, wu, wi;
+    if (env != NULL && std::sscanf(env, "%llu,%llu,%llu", &ff, &wu, &wi) == 3) {
+      fast_forward = ff;
+      warmup = wu;
+      window = wi;
+    }
+    NVHLS_ASSERT_MSG(window > 0, "Sampling window must not be empty");
+    SC_METHOD(tick);
+    sensitive << clk.pos();
+    dont_initialize();
+  }
+
+ /**
+   * \brief Closes the measured window in progress
+   *
+   * Call it before reading the estimates when sc_start() returns. A window
+   * that goes on afterwards is measured as a new one.
+   */
+  void Flush() {
+    Sampling& s = Sampling::Instance();
+    if (in_window && cycle > window_begin) {
+      s.EndWindow(cycle - window_begin);
+      in_window = ((cycle % Period()) != 0);
+      window_begin = cycle;
+      if (in_window) {
+        s.BeginWindow();
+      }
+    }
+  }
+
+ protected:
+  uint64 fast_forward;
+  uint64 warmup;
+  uint64 window;
+  uint64 cycle;
+  bool in_window;
+  uint64 window_begin;
+
+  uint64 Period() const { return fast_forward + warmup + window; }
+
+  void start_of_simulation() { Sampling::Instance().SetMode(fast_forward > 0 ? Sampling::FUNCTIONAL : Sampling::DETAILED); }
+
+  // At the start of each cycle, selects the mode of the cycle
+  void tick() {
+    Sampling& s = Sampling::Instance();
+    uint64 phase = cycle % Period();
+    if (in_window && phase == 0) {
+      s.EndWindow(cycle - window_begin);
+      in_window = false;
+    }
+    if (phase == 0 && fast_forward > 0) {
+      s.SetMode(Sampling::FUNCTIONAL);
+    } else if (phase == fast_forward) {
+      s.SetMode(Sampling::DETAILED);
+    }
+    if (phase == fast_forward + warmup) {
+      s.BeginWindow();
+      in_window = true;
+      window_begin = cycle;
+    }
+    cycle++;
+    s.SetTotalCycles(cycle);
+  }
+
+  void end_of_simulation() { Flush(); }
+};
+
+}  // namespace nvhls
+
+#endif  // __SYNTHESIS__
+
+#endif  // NVHLS_SAMPLING_H
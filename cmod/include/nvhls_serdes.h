@@ -28,7 +28,10 @@
 #include <nvhls_packet.h>
 #include <nvhls_connections.h>
 #include <hls_globals.h>
+#include <nvhls_idle_wait.h>
 #include <fifo.h>
+#include <damq.h>
+#include <TypeToBits.h>
 //------------------------------------------------------------------------
 // serializer for store-forward router
 //------------------------------------------------------------------------
@@ -42,9 +45,17 @@
  * \tparam packet_t       PacketType 
  * \tparam flit_t         FlitType 
  * \tparam Rtype          RouterType 
+ * \tparam VariableLength Stop at the last flit with nonzero data (default false)
  *
  * \par Overview
  * Converts a Packet into sequence of Flits.
+ *
+ * \par Variable-length packets
+ * With VariableLength set, the serializer drops the trailing flits whose
+ * data is all zero and marks the last flit it sends as TAIL (SNGL if it is
+ * the only one), so a short message in a wide packet takes as many flits as
+ * its payload. No length field is needed: the TAIL flit ends the packet, and
+ * every deserializer zero-fills the flits that were not sent.
  * 
  * \par A Simple Example
  * \code
@@ -67,7 +78,8 @@
  *
  */
 
-template <typename packet_t, typename flit_t, RouterType Rtype = StoreForward>
+template <typename packet_t, typename flit_t, RouterType Rtype = StoreForward,
+          bool VariableLength = false>
 class serializer : public sc_module {
  public:
   sc_in_clk clk;
@@ -77,9 +89,25 @@ class serializer : public sc_module {
   Connections::Out<flit_t> out_flit;
   static const int header_data_width = flit_t::data_width - packet_t::dest_width;
   static const int num_flits = (((packet_t::data_width-header_data_width) % flit_t::data_width) == 0) ? ((packet_t::data_width-header_data_width) / flit_t::data_width) : ((packet_t::data_width-header_data_width) / flit_t::data_width+1) ;
+  static const int log_num_flits = nvhls::index_width<num_flits+1>::val;
   enum { width = 0 };
   void Process();
 
+  // Number of flits up to the last one with nonzero data, at least 1
+  static NVUINTW(log_num_flits) used_flits(const NVUINTW(packet_t::data_width)& data) {
+    NVUINTW(log_num_flits) n = 1;
+#pragma hls_unroll yes
+    for (int i = 1; i < num_flits; i++) {
+      if ((data >> (i * flit_t::data_width)) != 0) {
+        n = i + 1;
+      }
+    }
+    return n;
+  }
+
+  // Skips the cycles without a packet in simulation
+  match::IdleWait idle;
+
   SC_HAS_PROCESS(serializer);
   serializer(sc_module_name name)
       : sc_module(name),
@@ -90,11 +118,14 @@ class serializer : public sc_module {
     SC_THREAD(Process);
     sensitive << clk.pos();
     NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    idle.SetClock(clk);
+    idle.Watch(in_packet);
   };
 };
 
-template <typename packet_t, typename flit_t, RouterType Rtype>
-void serializer<packet_t, flit_t, Rtype>::Process() {
+template <typename packet_t, typename flit_t, RouterType Rtype,
+          bool VariableLength>
+void serializer<packet_t, flit_t, Rtype, VariableLength>::Process() {
   in_packet.Reset();
   out_flit.Reset();
   wait();
@@ -109,12 +140,19 @@ void serializer<packet_t, flit_t, Rtype>::Process() {
       flit_reg.dest = packet_reg.dest;
       flit_reg.packet_id = packet_reg.packet_id;
       data = packet_reg.data;
+      NVUINTW(log_num_flits) last = num_flits;
+      if (VariableLength) {
+        last = used_flits(data);
+      }
       for (int i = 0; i < num_flits; i++) {
-        if (num_flits == 1) {
+        if (i >= last) {
+          break;
+        }
+        if (last == 1) {
           flit_reg.flit_id.set(FlitId2bit::SNGL);
         } else if (i == 0) {
           flit_reg.flit_id.set(FlitId2bit::HEAD);
-        } else if (i == num_flits - 1) {
+        } else if (i == last - 1) {
           flit_reg.flit_id.set(FlitId2bit::TAIL);
         } else {
           flit_reg.flit_id.set(FlitId2bit::BODY);
@@ -125,6 +163,7 @@ void serializer<packet_t, flit_t, Rtype>::Process() {
       }
     }
     wait();
+    idle.Sleep();
   }
 }
 
@@ -138,6 +177,11 @@ void serializer<packet_t, flit_t, Rtype>::Process() {
  * \brief serializer for WormHole router 
  * \ingroup SerDes
  *
+ * \par Overview
+ * The header flit carries the route and the LSBs of the packet data. With
+ * VariableLength set, the packet ends at the last flit with nonzero data;
+ * a packet whose data fits in the header flit is sent as a single SNGL flit.
+ *
  * \par A Simple Example
  * \code
  *      #include <nvhls_serdes.h>
@@ -160,11 +204,12 @@ void serializer<packet_t, flit_t, Rtype>::Process() {
  */
 
 template <int PacketDataWidth, int DestWidthPerHop, int MaxHops,
-          int PacketIdWidth, int FlitDataWidth, class FlitId>
+          int PacketIdWidth, int FlitDataWidth, class FlitId,
+          bool VariableLength>
 class serializer<
     Packet<PacketDataWidth, DestWidthPerHop, MaxHops, PacketIdWidth>,
-    Flit<FlitDataWidth, 0, 0, PacketIdWidth, FlitId, WormHole>, WormHole>
-    : public sc_module {
+    Flit<FlitDataWidth, 0, 0, PacketIdWidth, FlitId, WormHole>, WormHole,
+    VariableLength> : public sc_module {
   typedef Packet<PacketDataWidth, DestWidthPerHop, MaxHops, PacketIdWidth>
       packet_t;
   typedef Flit<FlitDataWidth, 0, 0, PacketIdWidth, FlitId, WormHole> flit_t;
@@ -181,10 +226,24 @@ class serializer<
   Connections::Out<flit_t> out_flit;
   enum { width = 0 };
 
+  // Number of data flits after the header flit up to the last one with
+  // nonzero data
+  static NVUINTW(log_num_flits) used_flits(const NVUINTW(packet_t::data_width)& data) {
+    NVUINTW(log_num_flits) n = 0;
+#pragma hls_unroll yes
+    for (int i = 0; i < num_flits; i++) {
+      if ((data >> (i * flit_t::data_width + header_data_width)) != 0) {
+        n = i + 1;
+      }
+    }
+    return n;
+  }
+
   void Process() {
     in_packet.Reset();
     out_flit.Reset();
     NVUINTW(log_num_flits) num = 0;
+    NVUINTW(log_num_flits) last = num_flits;
     packet_t packet_reg;
     wait();
     while (1) {
@@ -195,12 +254,20 @@ class serializer<
         flit_reg.data = packet_reg.dest;
         NVUINTW(header_data_width) header_data = nvhls::get_slc<header_data_width>(packet_reg.data, 0);
         flit_reg.data = nvhls::set_slc(flit_reg.data, header_data, packet_t::dest_width);
-        flit_reg.flit_id.set(
-            FlitId2bit::HEAD);  // Destination is sent in first flit
-        num++;
+        last = num_flits;
+        if (VariableLength) {
+          last = used_flits(packet_reg.data);
+        }
+        if (last == 0) {
+          flit_reg.flit_id.set(FlitId2bit::SNGL);
+        } else {
+          flit_reg.flit_id.set(
+              FlitId2bit::HEAD);  // Destination is sent in first flit
+          num++;
+        }
       } else {
         flit_reg.packet_id = packet_reg.packet_id;
-        if (num == num_flits) {
+        if (num == last) {
           flit_reg.flit_id.set(FlitId2bit::TAIL);
           int num_minus_one = num - 1;
           flit_reg.data = nvhls::get_slc(
@@ -240,14 +307,17 @@ class serializer<
  * \brief serializer for WormHole router without packet-id in flits 
  * \ingroup SerDes
  *
+ * \par Overview
+ * The route takes a flit of its own. With VariableLength set, the packet
+ * ends at the last flit with nonzero data, after at least one data flit.
  *
  */
 
 template <int PacketDataWidth, int DestWidthPerHop, int MaxHops,
-          int FlitDataWidth, class FlitId>
+          int FlitDataWidth, class FlitId, bool VariableLength>
 class serializer<Packet<PacketDataWidth, DestWidthPerHop, MaxHops, 0>,
-                 Flit<FlitDataWidth, 0, 0, 0, FlitId, WormHole>, WormHole>
-    : public sc_module {
+                 Flit<FlitDataWidth, 0, 0, 0, FlitId, WormHole>, WormHole,
+                 VariableLength> : public sc_module {
   typedef Packet<PacketDataWidth, DestWidthPerHop, MaxHops, 0> packet_t;
   typedef Flit<FlitDataWidth, 0, 0, 0, FlitId, WormHole> flit_t;
 
@@ -257,10 +327,23 @@ class serializer<Packet<PacketDataWidth, DestWidthPerHop, MaxHops, 0>,
 
   // num_flits indicates number of data flits. route flits are not counted
   static const int num_flits = ((packet_t::data_width % flit_t::data_width) == 0) ? (packet_t::data_width / flit_t::data_width) : (packet_t::data_width / flit_t::data_width+1) ;
+  static const int log_num_flits = nvhls::index_width<num_flits+1>::val;
   Connections::In<packet_t> in_packet;
   Connections::Out<flit_t> out_flit;
   enum { width = 0 };
 
+  // Number of data flits up to the last one with nonzero data, at least 1
+  static NVUINTW(log_num_flits) used_flits(const NVUINTW(packet_t::data_width)& data) {
+    NVUINTW(log_num_flits) n = 1;
+#pragma hls_unroll yes
+    for (int i = 1; i < num_flits; i++) {
+      if ((data >> (i * flit_t::data_width)) != 0) {
+        n = i + 1;
+      }
+    }
+    return n;
+  }
+
   void Process() {
     in_packet.Reset();
     out_flit.Reset();
@@ -274,18 +357,24 @@ class serializer<Packet<PacketDataWidth, DestWidthPerHop, MaxHops, 0>,
         flit_reg.flit_id.set(
             FlitId2bit::HEAD);  // Destination is sent in first flit
         out_flit.Push(flit_reg);
+        NVUINTW(log_num_flits) last = num_flits;
+        if (VariableLength) {
+          last = used_flits(packet_reg.data);
+        }
 #pragma hls_unroll yes
         for (int i = 0; i < num_flits; i++) {
           // Single packet flit is not possible. We have atleast 1 route flit
           // and 1 data flit. Flit_id cannot be 3
-          if (i == num_flits - 1) {
-            flit_reg.flit_id.set(FlitId2bit::TAIL);
-          } else {
-            flit_reg.flit_id.set(FlitId2bit::BODY);
+          if (i < last) {
+            if (i == last - 1) {
+              flit_reg.flit_id.set(FlitId2bit::TAIL);
+            } else {
+              flit_reg.flit_id.set(FlitId2bit::BODY);
+            }
+            flit_reg.data = nvhls::get_slc<flit_t::data_width>(
+                packet_reg.data, i * flit_t::data_width);
+            out_flit.Push(flit_reg);
           }
-          flit_reg.data = nvhls::get_slc<flit_t::data_width>(
-              packet_reg.data, i * flit_t::data_width);
-          out_flit.Push(flit_reg);
         }
       }
       wait();
@@ -371,6 +460,9 @@ class deserializer : public sc_module {
                                    // every packet
   void Process();
 
+  // Skips the cycles without a flit in simulation
+  match::IdleWait idle;
+
   SC_HAS_PROCESS(deserializer);
   deserializer(sc_module_name name)
       : sc_module(name),
@@ -381,6 +473,8 @@ class deserializer : public sc_module {
     SC_THREAD(Process);
     sensitive << clk.pos();
     NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    idle.SetClock(clk);
+    idle.Watch(in_flit);
   };
 };
 
@@ -409,6 +503,8 @@ void deserializer<packet_t, flit_t, buffersize, Rtype>::Process() {
         packet_pos = fifo.pop();
         buffer[packet_pos].packet_id = flit_reg.packet_id;
         buffer[packet_pos].dest = flit_reg.dest;
+        // zero-fill flits a variable-length packet does not send
+        buffer[packet_pos].data = 0;
         buffer[packet_pos].data =
             nvhls::set_slc(buffer[packet_pos].data, flit_reg.data, 0);
         num_flits_received[packet_pos] = 1;
@@ -442,6 +538,172 @@ void deserializer<packet_t, flit_t, buffersize, Rtype>::Process() {
       }
     }
     wait();
+    idle.Sleep();
+  }
+};
+
+//------------------------------------------------------------------------
+// pooled_deserializer for store-forward router
+//------------------------------------------------------------------------
+/**
+ * \brief Deserializer for store-forward router with a shared flit pool
+ * \ingroup SerDes
+ *
+ * \tparam packet_t       PacketType
+ * \tparam flit_t         FlitType
+ * \tparam NumSlots       Number of flits the pool holds
+ *
+ * \par Overview
+ * Reassembles packets whose flits interleave by packet_id, like
+ * deserializer<packet_t, flit_t, buffersize>, but buffers flits instead of
+ * whole packets: a DAMQ of NumSlots flits keeps one linked list per
+ * packet_id, so the pool is shared by however many packets are in flight.
+ * - Packets are assembled one at a time, in the order their headers
+ *   arrived, and leave through out_packet in that order.
+ * - Cut-through: flits of the packet being assembled skip the pool when
+ *   none of its flits are waiting there, so its packet leaves in the cycle
+ *   its tail arrives, as with the per-packet buffers. Other flits wait in
+ *   the pool and are drained one per cycle once their packet is next.
+ * - Packet ids must be unique among the packets in flight.
+ * .
+ * As the per-packet buffers must hold the packets in flight, the pool must
+ * hold the flits in flight: with the pool full and the next flit not of
+ * the packet being assembled, no flit can move, which asserts.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_serdes.h>
+ *
+ *      ...
+ *      pooled_deserializer<packet_t, flit_t, 16> deserializer_inst;
+ *      Connections::In<flit_t>      in_flit;
+ *      Connections::Out<packet_t>   out_packet;
+ *
+ *      ...
+ *          deserializer_inst.clk(clk);
+ *          deserializer_inst.rst(rst);
+ *          deserializer_inst.in_flit(in_flit);
+ *          deserializer_inst.out_packet(out_packet);
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename packet_t, typename flit_t, int NumSlots>
+class pooled_deserializer : public sc_module {
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::Out<packet_t> out_packet;
+  Connections::In<flit_t> in_flit;
+  enum { width = 0, num_ids = 1 << packet_t::packet_id_width };
+  static_assert(packet_t::packet_id_width > 0,
+                "pooled_deserializer needs a packet_id");
+  typedef NVUINTW(packet_t::packet_id_width) PacketId;
+
+  static const int num_flits = packet_t::data_width / flit_t::data_width;
+  static const int log_num_flits = nvhls::index_width<num_flits + 1>::val;
+
+  // Flits by packet_id, and the ids in header arrival order
+  DAMQ<flit_t, NumSlots, num_ids> pool;
+  FIFO<PacketId, num_ids> order;
+
+  void Process() {
+    out_packet.Reset();
+    in_flit.Reset();
+    pool.reset();
+    order.reset();
+    flit_t in_reg;
+    bool in_valid = false;
+    bool active = false;
+    PacketId cur = 0;
+    packet_t packet;
+    NVUINTW(log_num_flits) received = 0;
+    packet_t out_reg;
+    bool out_valid = false;
+    wait();
+
+    #pragma hls_pipeline_init_interval 1
+    while (1) {
+      if (!in_valid) {
+        in_valid = in_flit.PopNB(in_reg);
+      }
+
+      // Start on the oldest packet; a header that arrives while idle is
+      // taken directly
+      if (!active) {
+        if (!order.isEmpty()) {
+          cur = order.pop();
+          active = true;
+        } else if (in_valid && in_reg.flit_id.isHeader()) {
+          cur = in_reg.packet_id;
+          active = true;
+        }
+      }
+
+      // Add a flit to the packet: from the pool, or cut through
+      if (active && !out_valid) {
+        flit_t flit;
+        bool absorb = false;
+        if (!pool.isEmpty(cur)) {
+          flit = pool.pop(cur);
+          absorb = true;
+        } else if (in_valid && in_reg.packet_id == cur) {
+          flit = in_reg;
+          absorb = true;
+          in_valid = false;
+        }
+        if (absorb) {
+          if (flit.flit_id.isHeader()) {
+            packet.packet_id = flit.packet_id;
+            packet.dest = flit.dest;
+            packet.data = 0;
+            packet.data = nvhls::set_slc(packet.data, flit.data, 0);
+            received = 1;
+          } else {
+            packet.data = nvhls::set_slc(packet.data, flit.data,
+                                         received * flit_t::data_width);
+            received++;
+          }
+          if (flit.flit_id.isTail()) {
+            out_reg = packet;
+            out_valid = true;
+            active = false;
+          }
+        }
+      }
+
+      // Any other flit waits in the pool
+      if (in_valid && !pool.isFull()) {
+        if (in_reg.flit_id.isHeader()) {
+          NVHLS_ASSERT_MSG(!order.isFull(), "More packets in flight than packet ids");
+          order.push(in_reg.packet_id);
+        }
+        pool.push(in_reg, in_reg.packet_id);
+        in_valid = false;
+      }
+      NVHLS_ASSERT_MSG(!(in_valid && active && !out_valid && pool.isEmpty(cur)),
+                       "Flit pool full: NumSlots too small for the flits in flight");
+
+      if (out_valid && out_packet.PushNB(out_reg)) {
+        out_valid = false;
+      }
+      wait();
+    }
+  }
+
+  SC_HAS_PROCESS(pooled_deserializer);
+  pooled_deserializer(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        out_packet("out_packet"),
+        in_flit("in_flit") {
+    SC_THREAD(Process);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
   }
 };
 
@@ -536,6 +798,8 @@ class deserializer<
           packet_pos = fifo.pop();
           buffer[packet_pos].packet_id = flit_reg.packet_id;
           buffer[packet_pos].dest = flit_reg.data;
+          // zero-fill flits a variable-length packet does not send
+          buffer[packet_pos].data = 0;
           num_flits_received[packet_pos] = 0;
         } else {
 // Search for buffer storing the packet and insert flit in appropriate position.
@@ -687,4 +951,743 @@ void deserializer<
   }
 }
 
+//------------------------------------------------------------------------
+// flit_packer / flit_unpacker
+//------------------------------------------------------------------------
+/**
+ * \brief Link-level compression: packs two half-empty flits into one
+ * \ingroup SerDes
+ *
+ * \tparam flit_t         FlitType, with FlitIdPacked as its FlitId
+ * \tparam RouteWidth     Route bits that routers rewrite at the LSBs of a
+ *                        header flit (default 0)
+ *
+ * \par Overview
+ * Sits between a serializer and the router. Two consecutive flits of a
+ * packet whose upper data halves are zero go out as one flit: the data of
+ * the first in the lower half, the data of the second in the upper half,
+ * and the packed flag of FlitIdPacked set. The packed flit is a header if
+ * the first flit is and a tail if the second one is, so routers handle it
+ * like any other flit and each packed flit saves a flit of link bandwidth.
+ * - A header flit is only packed if its route (RouteWidth bits) lies in the
+ *   lower half, as a source router rewrites the route in place.
+ * - A flit that could pack is held for up to one cycle for its successor;
+ *   other flits pass through unchanged.
+ * .
+ * flit_unpacker restores the original flits ahead of the deserializer.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_serdes.h>
+ *
+ *      ...
+ *      typedef Flit<64, 0, 0, 8, FlitIdPacked, WormHole> flit_t;
+ *      serializer<packet_t, flit_t, WormHole> serializer_inst;
+ *      flit_packer<flit_t, packet_t::dest_width> packer_inst;
+ *      ...
+ *      flit_unpacker<flit_t> unpacker_inst;
+ *      deserializer<packet_t, flit_t, 0, WormHole> deserializer_inst;
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename flit_t, int RouteWidth = 0>
+class flit_packer : public sc_module {
+ public:
+  enum { width = 0, half_width = flit_t::data_width / 2 };
+  static_assert(flit_t::data_width % 2 == 0, "Flit data width must be even");
+  static_assert(flit_t::flit_id_width == FlitIdPacked::width,
+                "flit_packer needs FlitIdPacked flits");
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::In<flit_t> in_flit;
+  Connections::Out<flit_t> out_flit;
+
+  static bool small(const flit_t& flit) {
+    return (flit.data >> half_width) == 0;
+  }
+
+  // Can take the successor flit into its upper half
+  static bool pairable(const flit_t& flit) {
+    return small(flit) && !flit.flit_id.isTail() &&
+           (!flit.flit_id.isHeader() || RouteWidth <= half_width);
+  }
+
+  void Process() {
+    in_flit.Reset();
+    out_flit.Reset();
+    flit_t first, second;
+    bool first_valid = false;
+    bool second_valid = false;
+    bool waited = false;
+    wait();
+
+    #pragma hls_pipeline_init_interval 1
+    while (1) {
+      if (!first_valid) {
+        first_valid = in_flit.PopNB(first);
+        waited = false;
+      } else if (!second_valid && pairable(first)) {
+        second_valid = in_flit.PopNB(second);
+      }
+
+      if (first_valid) {
+        flit_t flit_reg = first;
+        bool packed = false;
+        bool send = true;
+        if (second_valid && small(second)) {
+          flit_reg.data = first.data | (second.data << half_width);
+          NVUINTW(2) enc = 0;
+          enc[0] = first.flit_id.isHeader();
+          enc[1] = second.flit_id.isTail();
+          flit_reg.flit_id.set(static_cast<FlitId2bit::Encoding>(enc.to_uint()));
+          flit_reg.flit_id.setPacked(true);
+          packed = true;
+        } else if (!second_valid && pairable(first) && !waited) {
+          // give the successor a cycle to arrive
+          send = false;
+          waited = true;
+        }
+        if (send && out_flit.PushNB(flit_reg)) {
+          if (packed) {
+            first_valid = false;
+            second_valid = false;
+          } else {
+            first = second;
+            first_valid = second_valid;
+            second_valid = false;
+            waited = false;
+          }
+        }
+      }
+      wait();
+    }
+  }
+
+  SC_HAS_PROCESS(flit_packer);
+  flit_packer(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        in_flit("in_flit"),
+        out_flit("out_flit") {
+    SC_THREAD(Process);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+/**
+ * \brief Restores the flits that flit_packer packed
+ * \ingroup SerDes
+ *
+ * \tparam flit_t         FlitType, with FlitIdPacked as its FlitId
+ *
+ * \par Overview
+ * Splits each packed flit into its two flits over two cycles and passes
+ * other flits through unchanged.
+ */
+template <typename flit_t>
+class flit_unpacker : public sc_module {
+ public:
+  enum { width = 0, half_width = flit_t::data_width / 2 };
+  static_assert(flit_t::flit_id_width == FlitIdPacked::width,
+                "flit_unpacker needs FlitIdPacked flits");
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::In<flit_t> in_flit;
+  Connections::Out<flit_t> out_flit;
+
+  void Process() {
+    in_flit.Reset();
+    out_flit.Reset();
+    flit_t in_reg;
+    bool in_valid = false;
+    bool upper = false;
+    wait();
+
+    #pragma hls_pipeline_init_interval 1
+    while (1) {
+      if (!in_valid) {
+        in_valid = in_flit.PopNB(in_reg);
+        upper = false;
+      }
+      if (in_valid) {
+        flit_t flit_reg = in_reg;
+        if (in_reg.flit_id.isPacked()) {
+          if (!upper) {
+            flit_reg.data = nvhls::get_slc<half_width>(in_reg.data, 0);
+            if (in_reg.flit_id.isHeader()) {
+              flit_reg.flit_id.set(FlitId2bit::HEAD);
+            } else {
+              flit_reg.flit_id.set(FlitId2bit::BODY);
+            }
+          } else {
+            flit_reg.data = nvhls::get_slc<half_width>(in_reg.data, half_width);
+            if (in_reg.flit_id.isTail()) {
+              flit_reg.flit_id.set(FlitId2bit::TAIL);
+            } else {
+              flit_reg.flit_id.set(FlitId2bit::BODY);
+            }
+          }
+          if (out_flit.PushNB(flit_reg)) {
+            in_valid = !upper;
+            upper = !upper;
+          }
+        } else if (out_flit.PushNB(flit_reg)) {
+          in_valid = false;
+        }
+      }
+      wait();
+    }
+  }
+
+  SC_HAS_PROCESS(flit_unpacker);
+  flit_unpacker(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        in_flit("in_flit"),
+        out_flit("out_flit") {
+    SC_THREAD(Process);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+//------------------------------------------------------------------------
+// FlitBundle
+//------------------------------------------------------------------------
+/**
+ * \brief Up to Lanes consecutive flits of one packet, moved in one cycle
+ * \ingroup SerDes
+ *
+ * \tparam flit_t         FlitType
+ * \tparam Lanes          Maximum number of flits
+ *
+ * \par Overview
+ * flit[0] ... flit[count - 1] hold flits in packet order; the other lanes
+ * are don't-care. A bundle never holds flits of two packets.
+ */
+template <typename flit_t, int Lanes>
+class FlitBundle : public nvhls_message {
+ public:
+  enum {
+    num_lanes = Lanes,
+    count_width = nvhls::index_width<Lanes + 1>::val,
+    width = flit_t::width * Lanes + count_width
+  };
+
+  flit_t flit[Lanes];
+  NVUINTW(count_width) count;
+
+  FlitBundle() { count = 0; }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+#pragma hls_unroll yes
+    for (int i = 0; i < Lanes; i++) {
+      m& flit[i];
+    }
+    m& count;
+  }
+};
+
+//------------------------------------------------------------------------
+// wide_serializer for WormHole router
+//------------------------------------------------------------------------
+/**
+ * \brief serializer for WormHole router that emits up to Lanes flits per cycle
+ * \ingroup SerDes
+ *
+ * \tparam packet_t       PacketType
+ * \tparam flit_t         FlitType
+ * \tparam Lanes          Flits per cycle
+ * \tparam VariableLength Stop at the last flit with nonzero data (default false)
+ *
+ * \par Overview
+ * Produces the same flits, with the same HEAD/BODY/TAIL/SNGL marking, as
+ * serializer<packet_t, flit_t, WormHole, VariableLength>, but pushes them
+ * Lanes at a time as a FlitBundle for links that are wider than a flit. The
+ * last bundle of a packet holds the remaining flits, so a packet takes
+ * ceil(flits / Lanes) cycles. Only Packet and Flit types with a packet_id
+ * are supported.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_serdes.h>
+ *
+ *      ...
+ *      wide_serializer<packet_t, flit_t, 4> serializer_inst;
+ *      Connections::In<packet_t>    in_packet;
+ *      Connections::Out<FlitBundle<flit_t, 4> > out_flits;
+ *
+ *      ...
+ *          serializer_inst.clk(clk);
+ *          serializer_inst.rst(rst);
+ *          serializer_inst.in_packet(in_packet);
+ *          serializer_inst.out_flits(out_flits);
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename packet_t, typename flit_t, int Lanes,
+          bool VariableLength = false>
+class wide_serializer : public sc_module {
+  static_assert(Lanes < 0,
+                "wide_serializer supports WormHole Packet and Flit with packet_id");
+};
+
+template <int PacketDataWidth, int DestWidthPerHop, int MaxHops,
+          int PacketIdWidth, int FlitDataWidth, class FlitId, int Lanes,
+          bool VariableLength>
+class wide_serializer<
+    Packet<PacketDataWidth, DestWidthPerHop, MaxHops, PacketIdWidth>,
+    Flit<FlitDataWidth, 0, 0, PacketIdWidth, FlitId, WormHole>, Lanes,
+    VariableLength> : public sc_module {
+  typedef Packet<PacketDataWidth, DestWidthPerHop, MaxHops, PacketIdWidth>
+      packet_t;
+  typedef Flit<FlitDataWidth, 0, 0, PacketIdWidth, FlitId, WormHole> flit_t;
+  typedef serializer<packet_t, flit_t, WormHole, VariableLength> narrow_t;
+
+ public:
+  typedef FlitBundle<flit_t, Lanes> bundle_t;
+  static_assert(Lanes >= 1, "wide_serializer needs at least one lane");
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  static const int header_data_width = narrow_t::header_data_width;
+  // num_flits indicates number of data flits. route flits are not counted
+  static const int num_flits = narrow_t::num_flits;
+  static const int log_num_flits = narrow_t::log_num_flits;
+  Connections::In<packet_t> in_packet;
+  Connections::Out<bundle_t> out_flits;
+  enum { width = 0 };
+
+  // Flit i of a packet with last data flit last; flit 0 is the header
+  static flit_t make_flit(const packet_t& packet, int i,
+                          NVUINTW(log_num_flits) last) {
+    flit_t flit;
+    flit.packet_id = packet.packet_id;
+    if (i == 0) {
+      flit.data = packet.dest;
+      NVUINTW(header_data_width) header_data = nvhls::get_slc<header_data_width>(packet.data, 0);
+      flit.data = nvhls::set_slc(flit.data, header_data, packet_t::dest_width);
+      if (last == 0) {
+        flit.flit_id.set(FlitId2bit::SNGL);
+      } else {
+        flit.flit_id.set(FlitId2bit::HEAD);
+      }
+    } else {
+      NVUINTW(packet_t::data_width + flit_t::data_width) padded = packet.data;
+      padded = padded >> ((i - 1) * flit_t::data_width + header_data_width);
+      flit.data = nvhls::get_slc<flit_t::data_width>(padded, 0);
+      if (i == last) {
+        flit.flit_id.set(FlitId2bit::TAIL);
+      } else {
+        flit.flit_id.set(FlitId2bit::BODY);
+      }
+    }
+    return flit;
+  }
+
+  void Process() {
+    in_packet.Reset();
+    out_flits.Reset();
+    NVUINTW(log_num_flits) num = 0;
+    NVUINTW(log_num_flits) last = num_flits;
+    packet_t packet_reg;
+    wait();
+    while (1) {
+      if (num == 0) {
+        packet_reg = in_packet.Pop();
+        last = num_flits;
+        if (VariableLength) {
+          last = narrow_t::used_flits(packet_reg.data);
+        }
+      }
+      bundle_t bundle;
+#pragma hls_unroll yes
+      for (int k = 0; k < Lanes; k++) {
+        int i = num + k;
+        if (i <= last) {
+          bundle.flit[k] = make_flit(packet_reg, i, last);
+          bundle.count = k + 1;
+        }
+      }
+      if (num + Lanes > last) {
+        num = 0;
+      } else {
+        num += Lanes;
+      }
+      out_flits.Push(bundle);
+      wait();
+    }
+  }
+
+  SC_HAS_PROCESS(wide_serializer);
+  wide_serializer(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        in_packet("in_packet"),
+        out_flits("out_flits") {
+    SC_THREAD(Process);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+//------------------------------------------------------------------------
+// wide_deserializer for WormHole router
+//------------------------------------------------------------------------
+/**
+ * \brief Deserializer for Wormhole router that takes up to Lanes flits per cycle
+ * \ingroup SerDes
+ *
+ * \tparam packet_t       PacketType
+ * \tparam flit_t         FlitType
+ * \tparam Lanes          Flits per cycle
+ *
+ * \par Overview
+ * Counterpart of wide_serializer: accepts one FlitBundle per cycle and
+ * assembles packets as deserializer<packet_t, flit_t, 0, WormHole> does, one
+ * packet at a time. Flits that a variable-length packet does not send read
+ * back as zeros.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_serdes.h>
+ *
+ *      ...
+ *      wide_deserializer<packet_t, flit_t, 4> deserializer_inst;
+ *      Connections::In<FlitBundle<flit_t, 4> > in_flits;
+ *      Connections::Out<packet_t>   out_packet;
+ *
+ *      ...
+ *          deserializer_inst.clk(clk);
+ *          deserializer_inst.rst(rst);
+ *          deserializer_inst.in_flits(in_flits);
+ *          deserializer_inst.out_packet(out_packet);
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename packet_t, typename flit_t, int Lanes>
+class wide_deserializer : public sc_module {
+  static_assert(Lanes < 0,
+                "wide_deserializer supports WormHole Packet and Flit with packet_id");
+};
+
+template <int PacketDataWidth, int DestWidthPerHop, int MaxHops,
+          int PacketIdWidth, int FlitDataWidth, class FlitId, int Lanes>
+class wide_deserializer<
+    Packet<PacketDataWidth, DestWidthPerHop, MaxHops, PacketIdWidth>,
+    Flit<FlitDataWidth, 0, 0, PacketIdWidth, FlitId, WormHole>, Lanes>
+    : public sc_module {
+  typedef Packet<PacketDataWidth, DestWidthPerHop, MaxHops, PacketIdWidth> packet_t;
+  typedef Flit<FlitDataWidth, 0, 0, PacketIdWidth, FlitId, WormHole> flit_t;
+
+ public:
+  typedef FlitBundle<flit_t, Lanes> bundle_t;
+  static_assert(Lanes >= 1, "wide_deserializer needs at least one lane");
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::Out<packet_t> out_packet;
+  Connections::In<bundle_t> in_flits;
+  enum { width = 0 };
+  // Buffer to store packets.
+  packet_t buffer;
+  static const int header_data_width = flit_t::data_width - packet_t::dest_width;
+  // num_flits indicates number of data flits. route flits are not counted.
+  static const int num_flits = (((packet_t::data_width-header_data_width) % flit_t::data_width) == 0) ? ((packet_t::data_width-header_data_width) / flit_t::data_width) : ((packet_t::data_width-header_data_width) / flit_t::data_width+1) ;
+  static const int log_num_flits = nvhls::index_width<num_flits+1>::val;
+  NVUINTW(log_num_flits) num_flits_received;  // Stores the number of flits received for every packet
+
+  void Process() {
+    out_packet.Reset();
+    in_flits.Reset();
+    num_flits_received = 0;
+    buffer.data = 0;
+    wait();
+
+    while (1) {
+      bundle_t bundle;
+      if (in_flits.PopNB(bundle)) {
+        bool done = false;
+#pragma hls_unroll yes
+        for (int k = 0; k < Lanes; k++) {
+          if (k < bundle.count) {
+            flit_t& flit_reg = bundle.flit[k];
+            if (flit_reg.flit_id.isHeader()) {
+              buffer.packet_id = flit_reg.packet_id;
+              buffer.dest = static_cast<NVUINTW(packet_t::dest_width)> (flit_reg.data);
+              buffer.data = nvhls::get_slc<header_data_width>(flit_reg.data, packet_t::dest_width);
+              num_flits_received = 0;
+            } else {
+              buffer.data |= (static_cast<NVUINTW(PacketDataWidth)>(flit_reg.data) << num_flits_received * flit_t::data_width + header_data_width);
+              num_flits_received++;
+            }
+            if (flit_reg.flit_id.isTail()) {
+              done = true;
+            }
+          }
+        }
+        // Last flit or Single-flit packet. Write data out.
+        if (done) {
+          out_packet.Push(buffer);
+          num_flits_received = 0;
+          buffer.data = 0;
+        }
+      }
+      wait();
+    }
+  }
+
+  SC_HAS_PROCESS(wide_deserializer);
+  wide_deserializer(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        out_packet("out_packet"),
+        in_flits("in_flits") {
+    SC_THREAD(Process);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+//------------------------------------------------------------------------
+// Funnel and Unfunnel
+//------------------------------------------------------------------------
+/**
+ * \brief K beats of a narrow message, moved in one cycle
+ * \ingroup SerDes
+ *
+ * \tparam Beat_t         Narrow message type
+ * \tparam K              Number of beats
+ */
+template <typename Beat_t, int K>
+class BeatBundle : public nvhls_message {
+ public:
+  enum { num_beats = K, width = Wrapped<Beat_t>::width * K };
+
+  Beat_t beat[K];
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+#pragma hls_unroll yes
+    for (int i = 0; i < K; i++) {
+      m& beat[i];
+    }
+  }
+};
+
+// The message on a funnel link: a narrow message, or K of them per cycle
+template <typename NarrowMsg, int K>
+struct funnel_link {
+  typedef BeatBundle<NarrowMsg, K> type;
+};
+
+template <typename NarrowMsg>
+struct funnel_link<NarrowMsg, 1> {
+  typedef NarrowMsg type;
+};
+
+/**
+ * \brief Splits any message into beats of a narrower message
+ * \ingroup SerDes
+ *
+ * \tparam WideMsg        Input message type
+ * \tparam NarrowMsg      Beat message type
+ * \tparam K              Beats per cycle (default 1)
+ *
+ * \par Overview
+ * Funnel takes the bits of a WideMsg (TypeToBits order) and sends them, least
+ * significant first, as ceil(width of WideMsg / width of NarrowMsg) beats,
+ * zero-padding the last one. With K > 1 the beats travel K at a time as a
+ * BeatBundle, the last bundle zero-padded as well. The next message is taken
+ * in the cycle its predecessor's last transfer is sent, so the link is busy
+ * every cycle while messages are waiting. Neither side needs a header:
+ * Unfunnel with the same parameters knows the number of transfers of a
+ * message, and a Connections link loses nothing.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_serdes.h>
+ *
+ *      ...
+ *      Funnel<Request_t, NVUINTW(32)> funnel;
+ *      Unfunnel<NVUINTW(32), Request_t> unfunnel;
+ *      Connections::Combinational<NVUINTW(32)> link;
+ *
+ *      ...
+ *          funnel.clk(clk);
+ *          funnel.rst(rst);
+ *          funnel.in(requests);
+ *          funnel.out(link);
+ *          unfunnel.clk(clk);
+ *          unfunnel.rst(rst);
+ *          unfunnel.in(link);
+ *          unfunnel.out(remote_requests);
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <typename WideMsg, typename NarrowMsg, int K = 1>
+class Funnel : public sc_module {
+  SC_HAS_PROCESS(Funnel);
+
+ public:
+  static const int wide_width = Wrapped<WideMsg>::width;
+  static const int narrow_width = Wrapped<NarrowMsg>::width;
+  static const int num_beats = (wide_width + narrow_width - 1) / narrow_width;
+  static const int num_transfers = (num_beats + K - 1) / K;
+  static const int transfer_width = narrow_width * K;
+  static_assert(K >= 1, "Funnel needs at least one beat per cycle");
+
+  typedef typename funnel_link<NarrowMsg, K>::type Link_t;
+  typedef NVUINTW(num_transfers * transfer_width) Padded;
+  typedef NVUINTW(transfer_width) TransferBits;
+  typedef NVUINTW(nvhls::index_width<num_transfers + 1>::val) Count;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<WideMsg> in;
+  Connections::Out<Link_t> out;
+
+  Funnel(sc_module_name name) : sc_module(name), clk("clk"), rst("rst"), in("in"), out("out") {
+    SC_THREAD(Process);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+ protected:
+  void Process() {
+    in.Reset();
+    out.Reset();
+    Padded bits = 0;
+    Count count = 0;
+    bool busy = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+      if (!busy) {
+        WideMsg msg;
+        if (in.PopNB(msg)) {
+          bits = TypeToNVUINT(msg);
+          count = 0;
+          busy = true;
+        }
+      }
+      if (busy) {
+        TransferBits transfer = nvhls::get_slc<transfer_width>(bits, 0);
+        if (out.PushNB(NVUINTToType<Link_t>(transfer))) {
+          // Shift the next transfer down rather than muxing it out
+          bits = bits >> transfer_width;
+          if (count == num_transfers - 1) {
+            busy = false;
+          } else {
+            count++;
+          }
+        }
+      }
+    }
+  }
+};
+
+/**
+ * \brief Reassembles a message from the beats of a Funnel
+ * \ingroup SerDes
+ *
+ * \tparam NarrowMsg      Beat message type
+ * \tparam WideMsg        Output message type
+ * \tparam K              Beats per cycle (default 1)
+ *
+ * \par Overview
+ * Counterpart of Funnel<WideMsg, NarrowMsg, K>: takes one transfer per cycle
+ * and sends the message in the cycle of its last transfer, so that it
+ * sustains the rate of the link. The padding bits are dropped.
+ *
+ * \par A Simple Example
+ * See Funnel.
+ * \par
+ *
+ */
+template <typename NarrowMsg, typename WideMsg, int K = 1>
+class Unfunnel : public sc_module {
+  SC_HAS_PROCESS(Unfunnel);
+  typedef Funnel<WideMsg, NarrowMsg, K> funnel_t;
+
+ public:
+  static const int wide_width = funnel_t::wide_width;
+  static const int num_transfers = funnel_t::num_transfers;
+  static const int transfer_width = funnel_t::transfer_width;
+
+  typedef typename funnel_t::Link_t Link_t;
+  typedef typename funnel_t::Padded Padded;
+  typedef typename funnel_t::TransferBits TransferBits;
+  typedef typename funnel_t::Count Count;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<Link_t> in;
+  Connections::Out<WideMsg> out;
+
+  Unfunnel(sc_module_name name) : sc_module(name), clk("clk"), rst("rst"), in("in"), out("out") {
+    SC_THREAD(Process);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+ protected:
+  void Process() {
+    in.Reset();
+    out.Reset();
+    Padded bits = 0;
+    Count count = 0;
+    WideMsg msg;
+    bool held = false;
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while (1) {
+      wait();
+      Link_t link;
+      if (!held && in.PopNB(link)) {
+        // Transfers enter at the top, so the first ends up least significant
+        TransferBits transfer = TypeToNVUINT(link);
+        bits = bits >> transfer_width;
+        bits = nvhls::set_slc(bits, transfer, (num_transfers - 1) * transfer_width);
+        if (count == num_transfers - 1) {
+          msg = NVUINTToType<WideMsg>(nvhls::get_slc<wide_width>(bits, 0));
+          count = 0;
+          held = true;
+        } else {
+          count++;
+        }
+      }
+      if (held) {
+        held = !out.PushNB(msg);
+      }
+    }
+  }
+};
+
 #endif /*NVHLS_SERDES_H*/
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_STAT_SAMPLER_H
+#define NVHLS_STAT_SAMPLER_H
+
+#include <nvhls_module.h>
+
+#ifndef __SYNTHESIS__
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace match {
+
+/**
+ * \brief Time series of match::Module stats, sampled every period cycles.
+ * \ingroup nvhls_module
+ *
+ * \par Overview
+ * A StatSampler wakes up every period rising edges of clk and records, for
+ * each stat selected with Add(), how much it grew since the previous sample.
+ * Any name printed by Module::DumpStats() for the module can be selected:
+ * IncrStat() and handle stats, RecordEvent() names, and the counters of
+ * registered ports, threads, flow control, activity and histograms, such as
+ * in_transfers or latency_count. A stat that does not exist yet reads as 0.
+ *
+ * The last depth samples are kept in a ring buffer, oldest first, so long
+ * runs keep their most recent phase behavior; NumDropped() counts the older
+ * samples that were overwritten. Between samples the sampler costs nothing;
+ * each sample collects the module stats once.
+ *
+ * WriteCSV() exports one row per sample, with the cycle at the end of the
+ * interval followed by the increments of the selected stats.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_stat_sampler.h>
+ *      ...
+ *      match::StatSampler sampler;
+ *      ...
+ *      Dut(sc_module_name nm)
+ *          : match::Module(nm), sampler("sampler", *this, 1000) {
+ *        sampler.clk(clk);
+ *        RegisterPortStats("in", in.Stats());
+ *        sampler.Add("in_transfers");
+ *        sampler.Add("requests");
+ *      }
+ *      ...
+ *      sc_start();
+ *      dut.sampler.Dump("dut_samples.csv");
+ * \endcode
+ * \par
+ *
+ */
+class StatSampler : public sc_module {
+ public:
+  sc_in_clk clk;
+
+  SC_HAS_PROCESS(StatSampler);
+  StatSampler(sc_module_name nm, Module& module, unsigned int period,
+              unsigned int depth = 1024)
+      : sc_module(nm), clk("clk"), module_(module), period_(period), depth_(depth),
+        cycle_(0), next_(0), num_samples_(0), num_dropped_(0) {
+    NVHLS_ASSERT_MSG(period > 0, "StatSampler period must be non-zero");
+    NVHLS_ASSERT_MSG(depth > 0, "StatSampler depth must be non-zero");
+    SC_THREAD(Run);
+    sensitive << clk.pos();
+  }
+
+  /* Select a stat by its DumpStats() name, before the first sample. */
+  void Add(const std::string& stat) {
+    NVHLS_ASSERT_MSG(num_samples_ == 0 && num_dropped_ == 0,
+                     "StatSampler stats must be added before the first sample");
+    names_.push_back(stat);
+    last_.push_back(0);
+    samples_.assign(depth_ * (names_.size() + 1), 0);
+  }
+
+  unsigned int Period() const { return period_; }
+  unsigned int Depth() const { return depth_; }
+  const std::vector<std::string>& Names() const { return names_; }
+  unsigned int NumSamples() const { return num_samples_; }
+  uint64 NumDropped() const { return num_dropped_; }
+
+  /* Cycle at the end of retained sample idx, 0 being the oldest. */
+  uint64 Cycle(unsigned int idx) const { return Row(idx)[0]; }
+  /* Increment of stat number stat_idx over retained sample idx. */
+  uint64 Value(unsigned int idx, unsigned int stat_idx) const {
+    return Row(idx)[stat_idx + 1];
+  }
+
+  void WriteCSV(std::ostream& ofile) const {
+    ofile << "cycle";
+    for (unsigned int s = 0; s < names_.size(); s++) {
+      ofile << "," << names_[s];
+    }
+    ofile << std::endl;
+    for (unsigned int i = 0; i < num_samples_; i++) {
+      const uint64* row = Row(i);
+      ofile << row[0];
+      for (unsigned int s = 0; s < names_.size(); s++) {
+        ofile << "," << row[s + 1];
+      }
+      ofile << std::endl;
+    }
+  }
+
+  bool Dump(const std::string& filename) const {
+    std::ofstream ofile(filename.c_str());
+    if (!ofile) {
+      DCOUT("Error: cannot open sample file " << filename << endl);
+      return false;
+    }
+    WriteCSV(ofile);
+    return ofile.good();
+  }
+
+  void Clear() {
+    next_ = num_samples_ = 0;
+    num_dropped_ = 0;
+  }
+
+ protected:
+  void Run() {
+    while (1) {
+      wait(period_);
+      cycle_ += period_;
+      Sample();
+    }
+  }
+
+  void Sample() {
+    if (names_.empty()) return;
+    std::map<std::string, uint64> stats;
+    module_.CollectStats(stats);
+    std::vector<std::pair<std::string, uint64> > counters;
+    module_.CollectCounters(counters);
+    for (unsigned int i = 0; i < counters.size(); i++) {
+      stats[counters[i].first] += counters[i].second;
+    }
+
+    uint64* row = &samples_[next_ * (names_.size() + 1)];
+    row[0] = cycle_;
+    for (unsigned int s = 0; s < names_.size(); s++) {
+      std::map<std::string, uint64>::const_iterator it = stats.find(names_[s]);
+      uint64 value = (it == stats.end()) ? 0 : it->second;
+      row[s + 1] = value - last_[s];
+      last_[s] = value;
+    }
+    next_ = (next_ + 1) % depth_;
+    if (num_samples_ < depth_) {
+      num_samples_++;
+    } else {
+      num_dropped_++;
+    }
+  }
+
+  const uint64* Row(unsigned int idx) const {
+    NVHLS_ASSERT_MSG(idx < num_samples_, "StatSampler sample out of range");
+    unsigned int oldest = (num_samples_ < depth_) ? 0 : next_;
+    return &samples_[((oldest + idx) % depth_) * (names_.size() + 1)];
+  }
+
+  Module& module_;
+  unsigned int period_;
+  unsigned int depth_;
+  std::vector<std::string> names_;
+  std::vector<uint64> last_;
+  // depth_ rows of the end cycle followed by one increment per stat
+  std::vector<uint64> samples_;
+  uint64 cycle_;
+  unsigned int next_;
+  unsigned int num_samples_;
+  uint64 num_dropped_;
+};
+
+}  // namespace match
+
+#endif  // __SYNTHESIS__
+
+#endif  // NVHLS_STAT_SAMPLER_H
@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_STATS_JSON_H
+#define NVHLS_STATS_JSON_H
+
+#include <nvhls_module.h>
+
+#ifndef __SYNTHESIS__
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace match {
+
+/**
+ * \brief JSON export of match::Module stats.
+ * \ingroup nvhls_module
+ *
+ * \par Overview
+ * Walks the match::Module hierarchy below a top module and writes one object
+ * per module:
+ * \code
+ *   {
+ *     "name": "tb.dut",
+ *     "stats": { "requests": 5, ... },
+ *     "events": { "flush": 2, ... },
+ *     "ports": {
+ *       "in": { "cycles": 3, "transfers": 2, "stall_cycles": 1,
+ *               "occupancy": [0, 1, 2], "latency_sum": 0, "latency_count": 0 }
+ *     },
+ *     "threads": {
+ *       "run": { "target_ii": 1, "cycles": 10, "productive": 8,
+ *                "blocked": { "wait": 0, "no_req": 2 } }
+ *     },
+ *     "flow": {
+ *       "credits": { "consumed": 6, "returned": 4, "denied": 1, "dropped": 0 }
+ *     },
+ *     "activity": {
+ *       "banks": { "messages": 0, "bits": 0, "toggles": 0,
+ *                  "reads": [4, 2], "writes": [3, 3], "grants": [] }
+ *     },
+ *     "histograms": {
+ *       "latency": { "scale": "log2", "bucket_width": 1, "count": 3, "sum": 9,
+ *                    "min": 1, "max": 6, "buckets": [0, 1, 1, 1, 0, ...] }
+ *     },
+ *     "children": [ ... ]
+ *   }
+ * \endcode
+ * - stats holds everything DumpStats() prints from IncrStat(), handle stats
+ *   and RecordEvent(); events counts RecordEvent() calls alone.
+ * - ports holds the buffered-port counters registered with
+ *   RegisterPortStats().
+ * - threads holds the thread-loop counters registered with
+ *   RegisterThreadStats(), with the cycles of every cause.
+ * - flow holds the CreditCounter and TokenBucket counters registered with
+ *   RegisterFlowStats().
+ * - activity holds the switching-activity counters registered with
+ *   RegisterActivityStats(), with one reads, writes and grants entry per
+ *   bank or element up to the highest one used.
+ * - histograms holds the histograms registered with RegisterHistogramStats(),
+ *   with every bucket; the last bucket also counts the values above it.
+ * - Modules without stats are still listed so that the tree mirrors the
+ *   design; children of plain sc_modules are not visited, as in DumpStats().
+ *
+ * The document is wrapped as {"sim_time_ps": ..., "top": {...}}.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_stats_json.h>
+ *      ...
+ *      sc_start();
+ *      match::StatsJSON::Dump(dut, "stats.json");
+ * \endcode
+ */
+class StatsJSON {
+ public:
+  template <typename Writer>
+  static void Write(Module& top, Writer& writer) {
+    writer.StartObject();
+    writer.Key("sim_time_ps");
+    writer.Uint64(static_cast<uint64>(sc_time_stamp().to_seconds() * 1e12 + 0.5));
+    writer.Key("top");
+    WriteModule(top, writer);
+    writer.EndObject();
+  }
+
+  static std::string ToString(Module& top, bool pretty = true) {
+    rapidjson::StringBuffer buffer;
+    if (pretty) {
+      rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+      Write(top, writer);
+    } else {
+      rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+      Write(top, writer);
+    }
+    return std::string(buffer.GetString(), buffer.GetSize());
+  }
+
+  static void Dump(Module& top, std::ostream& ofile, bool pretty = true) {
+    ofile << ToString(top, pretty) << std::endl;
+  }
+
+  static bool Dump(Module& top, const std::string& filename, bool pretty = true) {
+    std::ofstream ofile(filename.c_str());
+    if (!ofile) {
+      DCOUT("Error: cannot open stats file " << filename << endl);
+      return false;
+    }
+    Dump(top, ofile, pretty);
+    return ofile.good();
+  }
+
+ protected:
+  template <typename Writer>
+  static void WriteCounters(const std::map<std::string, uint64>& counters,
+                            Writer& writer) {
+    writer.StartObject();
+    for (std::map<std::string, uint64>::const_iterator it = counters.begin();
+         it != counters.end(); it++) {
+      writer.Key(it->first.c_str(), it->first.size());
+      writer.Uint64(it->second);
+    }
+    writer.EndObject();
+  }
+
+  template <typename Writer>
+  static void WritePort(const PortStats& stats, Writer& writer) {
+    writer.StartObject();
+    writer.Key("cycles");
+    writer.Uint64(stats.Cycles());
+    writer.Key("transfers");
+    writer.Uint64(stats.Transfers());
+    writer.Key("stall_cycles");
+    writer.Uint64(stats.StallCycles());
+    writer.Key("occupancy");
+    writer.StartArray();
+    for (unsigned int i = 0; i < stats.Occupancy().size(); i++) {
+      writer.Uint64(stats.Occupancy()[i]);
+    }
+    writer.EndArray();
+    writer.Key("latency_sum");
+    writer.Uint64(stats.LatencySum());
+    writer.Key("latency_count");
+    writer.Uint64(stats.LatencyCount());
+    writer.EndObject();
+  }
+
+  template <typename Writer>
+  static void WriteThread(const ThreadStats& stats, Writer& writer) {
+    writer.StartObject();
+    writer.Key("target_ii");
+    writer.Uint(stats.TargetII());
+    writer.Key("cycles");
+    writer.Uint64(stats.Cycles());
+    writer.Key("productive");
+    writer.Uint64(stats.ProductiveIterations());
+    writer.Key("blocked");
+    writer.StartObject();
+    for (unsigned int i = 0; i < stats.NumCauses(); i++) {
+      writer.Key(stats.CauseName(i).c_str(), stats.CauseName(i).size());
+      writer.Uint64(stats.CauseCycles(i));
+    }
+    writer.EndObject();
+    writer.EndObject();
+  }
+
+  template <typename Writer>
+  static void WriteFlow(const FlowStats& stats, Writer& writer) {
+    writer.StartObject();
+    writer.Key("consumed");
+    writer.Uint64(stats.NumConsumed());
+    writer.Key("returned");
+    writer.Uint64(stats.NumReturned());
+    writer.Key("denied");
+    writer.Uint64(stats.NumDenied());
+    writer.Key("dropped");
+    writer.Uint64(stats.NumDropped());
+    writer.EndObject();
+  }
+
+  template <typename Writer>
+  static void WriteArray(const std::vector<uint64>& counts, Writer& writer) {
+    writer.StartArray();
+    for (unsigned int i = 0; i < counts.size(); i++) {
+      writer.Uint64(counts[i]);
+    }
+    writer.EndArray();
+  }
+
+  template <typename Writer>
+  static void WriteActivity(const ActivityStats& stats, Writer& writer) {
+    writer.StartObject();
+    writer.Key("messages");
+    writer.Uint64(stats.NumMessages());
+    writer.Key("bits");
+    writer.Uint64(stats.NumBits());
+    writer.Key("toggles");
+    writer.Uint64(stats.NumToggles());
+    writer.Key("reads");
+    WriteArray(stats.Reads(), writer);
+    writer.Key("writes");
+    WriteArray(stats.Writes(), writer);
+    writer.Key("grants");
+    WriteArray(stats.Grants(), writer);
+    writer.EndObject();
+  }
+
+  template <typename Writer>
+  static void WriteHistogram(const HistogramStats& stats, Writer& writer) {
+    writer.StartObject();
+    writer.Key("scale");
+    writer.String(stats.GetScale() == HistogramStats::kLog2 ? "log2" : "linear");
+    writer.Key("bucket_width");
+    writer.Uint64(stats.BucketWidth());
+    writer.Key("count");
+    writer.Uint64(stats.Count());
+    writer.Key("sum");
+    writer.Uint64(stats.Sum());
+    writer.Key("min");
+    writer.Uint64(stats.Min());
+    writer.Key("max");
+    writer.Uint64(stats.Max());
+    writer.Key("buckets");
+    WriteArray(stats.Buckets(), writer);
+    writer.EndObject();
+  }
+
+  template <typename Writer>
+  static void WriteModule(Module& module, Writer& writer) {
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(module.name());
+
+    std::map<std::string, uint64> stats;
+    module.CollectStats(stats);
+    writer.Key("stats");
+    WriteCounters(stats, writer);
+
+    writer.Key("events");
+    WriteCounters(module.events_, writer);
+
+    writer.Key("ports");
+    writer.StartObject();
+    for (unsigned int i = 0; i < module.port_stats_.size(); i++) {
+      const std::string& port = module.port_stats_[i].first;
+      writer.Key(port.c_str(), port.size());
+      WritePort(*module.port_stats_[i].second, writer);
+    }
+    writer.EndObject();
+
+    writer.Key("threads");
+    writer.StartObject();
+    for (unsigned int i = 0; i < module.thread_stats_.size(); i++) {
+      const std::string& thread = module.thread_stats_[i].first;
+      writer.Key(thread.c_str(), thread.size());
+      WriteThread(*module.thread_stats_[i].second, writer);
+    }
+    writer.EndObject();
+
+    writer.Key("flow");
+    writer.StartObject();
+    for (unsigned int i = 0; i < module.flow_stats_.size(); i++) {
+      const std::string& flow = module.flow_stats_[i].first;
+      writer.Key(flow.c_str(), flow.size());
+      WriteFlow(*module.flow_stats_[i].second, writer);
+    }
+    writer.EndObject();
+
+    writer.Key("activity");
+    writer.StartObject();
+    for (unsigned int i = 0; i < module.activity_stats_.size(); i++) {
+      const std::string& activity = module.activity_stats_[i].first;
+      writer.Key(activity.c_str(), activity.size());
+      WriteActivity(*module.activity_stats_[i].second, writer);
+    }
+    writer.EndObject();
+
+    writer.Key("histograms");
+    writer.StartObject();
+    for (unsigned int i = 0; i < module.histogram_stats_.size(); i++) {
+      const std::string& histogram = module.histogram_stats_[i].first;
+      writer.Key(histogram.c_str(), histogram.size());
+      WriteHistogram(*module.histogram_stats_[i].second, writer);
+    }
+    writer.EndObject();
+
+    writer.Key("children");
+    writer.StartArray();
+    std::vector<Module*> children = module.GetChildren();
+    for (unsigned int i = 0; i < children.size(); i++) {
+      WriteModule(*children[i], writer);
+    }
+    writer.EndArray();
+    writer.EndObject();
+  }
+};
+
+}  // namespace match
+
+#endif  // __SYNTHESIS__
+
+#endif  // NVHLS_STATS_JSON_H
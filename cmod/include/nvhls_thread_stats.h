@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_THREAD_STATS_H
+#define NVHLS_THREAD_STATS_H
+
+#include <systemc.h>
+#ifndef __SYNTHESIS__
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#endif
+
+namespace match {
+
+#ifndef __SYNTHESIS__
+
+/**
+ * \brief Achieved-throughput and stall attribution counters of a pipelined thread.
+ * \ingroup nvhls_module
+ *
+ * \par Overview
+ * A ThreadStats belongs to the main loop of an SC_THREAD, and compares the
+ * iterations that did useful work with the initiation interval the loop
+ * targets with hls_pipeline_init_interval. Each loop iteration calls one of
+ * - Productive(): the iteration did its work.
+ * - Blocked(cause): the iteration did nothing because of cause, for example
+ *   an empty input or a full output. Causes are added with AddCause(), which
+ *   returns the handle to pass, or by name.
+ * Once the owning match::Module registers it with RegisterThreadStats(), the
+ * cycles between two calls are counted from the module clock: the cycles
+ * beyond one spent inside blocking Push()/Pop() calls or extra wait()s are
+ * attributed to the "wait" cause. Without a clock each call is one cycle.
+ *
+ * The counters are printed by Module::DumpStats() as <thread>_cycles,
+ * <thread>_productive and <thread>_blocked_<cause>, and
+ * Module::PrintThreadReport() prints the achieved II against the target and
+ * the top stall causes of every registered thread below a module.
+ *
+ * \par A Simple Example
+ * \code
+ *      match::ThreadStats run_stats;   // member, target II 1
+ *      unsigned int no_req, resp_full;
+ *      ...
+ *      // In the match::Module constructor
+ *      RegisterThreadStats("run", run_stats);
+ *      no_req = run_stats.AddCause("no_req");
+ *      resp_full = run_stats.AddCause("resp_full");
+ *      ...
+ *      #pragma hls_pipeline_init_interval 1
+ *      while (1) {
+ *        wait();
+ *        if (!resp.Full()) {
+ *          if (req.PopNB(msg)) { ...; run_stats.Productive(); }
+ *          else run_stats.Blocked(no_req);
+ *        } else {
+ *          run_stats.Blocked(resp_full);
+ *        }
+ *      }
+ * \endcode
+ * \par
+ *
+ */
+class ThreadStats {
+ public:
+  explicit ThreadStats(unsigned int target_ii = 1)
+      : enabled_(false), target_ii_(target_ii), clk_(NULL), period_(SC_ZERO_TIME),
+        cycles_(0), productive_(0), started_(false) {
+    AddCause("wait");
+  }
+
+  void Enable(const sc_in_clk* clk = NULL) {
+    enabled_ = true;
+    clk_ = clk;
+  }
+  bool IsEnabled() const { return enabled_; }
+
+  unsigned int AddCause(const std::string& name) {
+    for (unsigned int i = 0; i < cause_names_.size(); i++) {
+      if (cause_names_[i] == name) return i;
+    }
+    cause_names_.push_back(name);
+    cause_cycles_.push_back(0);
+    return cause_names_.size() - 1;
+  }
+
+  void Productive() {
+    if (!enabled_) return;
+    Advance();
+    productive_++;
+  }
+
+  void Blocked(unsigned int cause) {
+    if (!enabled_) return;
+    Advance();
+    cause_cycles_[cause]++;
+  }
+
+  // Slower: looks the cause up by name, adding it on first use
+  void Blocked(const char* cause) { Blocked(AddCause(cause)); }
+
+  void Clear() {
+    cycles_ = productive_ = 0;
+    cause_cycles_.assign(cause_cycles_.size(), 0);
+    started_ = false;
+  }
+
+  unsigned int TargetII() const { return target_ii_; }
+  uint64 Cycles() const { return cycles_; }
+  uint64 ProductiveIterations() const { return productive_; }
+  unsigned int NumCauses() const { return cause_names_.size(); }
+  const std::string& CauseName(unsigned int cause) const { return cause_names_[cause]; }
+  uint64 CauseCycles(unsigned int cause) const { return cause_cycles_[cause]; }
+
+  // Cycles per productive iteration; 0 before the first one
+  double AchievedII() const {
+    return productive_ ? static_cast<double>(cycles_) / productive_ : 0.0;
+  }
+
+  // Appends (name, value) pairs for each counter
+  void GetCounters(const std::string& prefix,
+                   std::vector<std::pair<std::string, uint64> >& out) const {
+    out.push_back(std::make_pair(prefix + "_cycles", cycles_));
+    out.push_back(std::make_pair(prefix + "_productive", productive_));
+    for (unsigned int i = 0; i < cause_names_.size(); i++) {
+      if (cause_cycles_[i] != 0) {
+        out.push_back(std::make_pair(prefix + "_blocked_" + cause_names_[i], cause_cycles_[i]));
+      }
+    }
+  }
+
+  void PrintReport(const std::string& name, std::ostream& os, unsigned int top = 3) const {
+    std::ios_base::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    double achieved = AchievedII();
+    os << name << ": target II " << target_ii_ << ", achieved II ";
+    if (productive_ == 0) {
+      os << "-";
+    } else {
+      os << std::fixed << std::setprecision(3) << achieved;
+    }
+    os << " (" << std::fixed << std::setprecision(1)
+       << (achieved > 0 ? 100.0 * target_ii_ / achieved : 0.0) << "% of target), " << cycles_
+       << " cycles, " << productive_ << " productive" << std::endl;
+    // Most cycles first, ties in the order the causes were added
+    std::vector<std::pair<int64, unsigned int> > causes;
+    for (unsigned int i = 0; i < cause_names_.size(); i++) {
+      if (cause_cycles_[i] != 0) {
+        causes.push_back(std::make_pair(-static_cast<int64>(cause_cycles_[i]), i));
+      }
+    }
+    std::sort(causes.begin(), causes.end());
+    for (unsigned int i = 0; i < causes.size() && i < top; i++) {
+      uint64 cause_cycles = -causes[i].first;
+      os << "    " << cause_names_[causes[i].second] << ": " << cause_cycles << " cycles ("
+         << std::fixed << std::setprecision(1) << 100.0 * cause_cycles / cycles_ << "%)"
+         << std::endl;
+    }
+    os.flags(flags);
+    os.precision(precision);
+  }
+
+ private:
+  bool enabled_;
+  unsigned int target_ii_;
+  const sc_in_clk* clk_;
+  sc_time period_;
+  uint64 cycles_;
+  uint64 productive_;
+  std::vector<std::string> cause_names_;
+  std::vector<uint64> cause_cycles_;
+  bool started_;
+  sc_time last_;
+
+  // One cycle for this call, plus the cycles since the previous call beyond one
+  void Advance() {
+    if (clk_ != NULL && period_ == SC_ZERO_TIME) {
+      const sc_clock* clock = dynamic_cast<const sc_clock*>(clk_->get_interface());
+      if (clock != NULL) period_ = clock->period();
+    }
+    sc_time now = sc_time_stamp();
+    if (started_ && period_ != SC_ZERO_TIME && now > last_) {
+      uint64 gap = static_cast<uint64>((now - last_) / period_ + 0.5);
+      if (gap > 1) {
+        cause_cycles_[0] += gap - 1;
+        cycles_ += gap - 1;
+      }
+    }
+    started_ = true;
+    last_ = now;
+    cycles_++;
+  }
+};
+
+#else
+
+// Synthesis view: no counters
+class ThreadStats {
+ public:
+  explicit ThreadStats(unsigned int target_ii = 1) {}
+  unsigned int AddCause(const char* name) { return 0; }
+  void Productive() {}
+  void Blocked(unsigned int cause) {}
+  void Blocked(const char* cause) {}
+};
+
+#endif  // __SYNTHESIS__
+
+}  // namespace match
+
+#endif  // NVHLS_THREAD_STATS_H
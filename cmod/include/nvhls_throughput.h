@@ -0,0 +1,493 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_THROUGHPUT_H
+#define NVHLS_THROUGHPUT_H
+
+#ifndef __SYNTHESIS__
+
+#include <systemc.h>
+#include <nvhls_assert.h>
+#include <nvhls_channel_graph.h>
+#include <nvhls_module.h>
+#include <rapidjson/document.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace match {
+
+/**
+ * \brief Static steady-state throughput bound of the Connections channel graph.
+ * \ingroup nvhls_module
+ *
+ * \par Overview
+ * ThroughputAnalyzer is a simulation-only module that, at start of
+ * simulation, finds the channels of the elaborated design with
+ * match::FindChannels() and bounds the rate at which their blocks can
+ * exchange messages, before any cycle is simulated:
+ * - Each block, the module owning the ports of a channel, fires at most once
+ *   per II cycles. Its II is the one given to SetBlockII(), or else the
+ *   largest target II of the ThreadStats registered by a match::Module, or
+ *   else 1.
+ * - Each channel delivers a message latency cycles after it is pushed and
+ *   holds up to capacity messages the consumer has not popped. Both are read
+ *   from an annotate_design JSON file (BASE.input.json or BASE.output.json),
+ *   matched by src_name, dest_name or channel name, or given to SetChannel().
+ *   A channel with neither is Combinational: latency 0 and capacity 0.
+ * - The channels and blocks form a marked graph: a self loop of II cycles and
+ *   one token per block, a forward edge of latency + 1 cycles per channel,
+ *   and a backward edge of capacity + 1 tokens, the free slots. A loop of
+ *   forward edges, i.e. feedback, is assumed to hold one message.
+ * - The bound of each connected channel graph is the inverse of its maximum
+ *   cycle ratio, cycles over tokens, and that cycle is the bottleneck: a
+ *   block, a channel too shallow for its latency, a feedback loop, or
+ *   reconvergent paths of unequal latency.
+ * - A channel is undersized when its capacity cannot cover its latency at the
+ *   rate of the slowest block of its graph.
+ *
+ * Report() describes each graph and is printed to std::cout at start of
+ * simulation; Analyze() recomputes it, e.g. after SetChannel().
+ *
+ * \par A Simple Example
+ * \code
+ *      SC_MODULE(testbench) {
+ *        match::ThroughputAnalyzer throughput;
+ *        ...
+ *        SC_CTOR(testbench) : throughput("throughput", "design.output.json") {
+ *          throughput.SetBlockII("tb.dut.stage1", 2);
+ *          ...
+ *        }
+ *      };
+ *      ...
+ *      sc_start(SC_ZERO_TIME);
+ *      std::cout << tb.throughput.Throughput() << std::endl;
+ * \endcode
+ * \par
+ *
+ */
+class ThroughputAnalyzer : public sc_module {
+ public:
+  struct Channel : public ChannelEnds {
+    unsigned int latency;
+    unsigned int capacity;
+    bool annotated;
+    // Capacity that covers the latency at the rate of the graph's slowest block
+    unsigned int needed;
+  };
+
+  struct Graph {
+    std::vector<std::string> blocks;
+    // Messages per cycle, and the bound of its slowest block alone
+    double throughput;
+    double block_bound;
+    std::string bottleneck;
+    std::string cycle;
+    std::vector<unsigned int> undersized;  // Indices into Channels()
+  };
+
+  explicit ThroughputAnalyzer(sc_module_name name, const std::string& annotations = "")
+      : sc_module(name), quiet_(false) {
+    if (!annotations.empty()) ReadAnnotations(annotations);
+  }
+
+  void SetBlockII(const std::string& block, unsigned int ii) {
+    NVHLS_ASSERT_MSG(ii > 0, "Block II must be positive");
+    block_ii_[block] = ii;
+  }
+
+  void SetChannel(const std::string& chan, unsigned int latency, unsigned int capacity) {
+    Annotation& a = chan_overrides_[chan];
+    a.name = chan;
+    a.latency = latency;
+    a.capacity = capacity;
+  }
+
+  // Channel entries of an annotate_design JSON file: the objects with a latency
+  void ReadAnnotations(const std::string& filename) {
+    std::ifstream ifile(filename.c_str());
+    NVHLS_ASSERT_MSG(ifile.good(), "Cannot open channel annotations");
+    std::stringstream text;
+    text << ifile.rdbuf();
+    rapidjson::Document doc;
+    doc.Parse(text.str().c_str());
+    NVHLS_ASSERT_MSG(!doc.HasParseError() && doc.IsObject(), "Malformed channel annotations");
+    ReadEntries(doc, "");
+  }
+
+  void SetQuiet(bool quiet) { quiet_ = quiet; }
+
+  void Analyze() {
+    chans_.clear();
+    graphs_.clear();
+    std::vector<ChannelEnds> ends;
+    FindChannels(ends);
+    std::map<std::string, unsigned int> nodes;
+    for (unsigned int i = 0; i < ends.size(); i++) {
+      Channel c;
+      static_cast<ChannelEnds&>(c) = ends[i];
+      Annotate(c);
+      chans_.push_back(c);
+      if (c.producer != "?") nodes[c.producer] = 0;
+      if (c.consumer != "?") nodes[c.consumer] = 0;
+    }
+    // Numbered in name order
+    unsigned int num = 0;
+    for (std::map<std::string, unsigned int>::iterator it = nodes.begin(); it != nodes.end(); ++it) {
+      it->second = num++;
+    }
+    names_.assign(nodes.size(), "");
+    ii_.assign(nodes.size(), 1);
+    declared_.assign(nodes.size(), false);
+    for (std::map<std::string, unsigned int>::const_iterator it = nodes.begin(); it != nodes.end(); ++it) {
+      names_[it->second] = it->first;
+      declared_[it->second] = BlockII(it->first, ii_[it->second]);
+    }
+
+    // Components joined by channels
+    std::vector<unsigned int> comp(nodes.size());
+    for (unsigned int n = 0; n < comp.size(); n++) comp[n] = n;
+    for (unsigned int i = 0; i < chans_.size(); i++) {
+      if (chans_[i].producer == "?" || chans_[i].consumer == "?") continue;
+      unsigned int a = Find(comp, nodes[chans_[i].producer]);
+      unsigned int b = Find(comp, nodes[chans_[i].consumer]);
+      comp[a] = b;
+    }
+
+    std::map<unsigned int, std::vector<unsigned int> > members;
+    for (unsigned int n = 0; n < comp.size(); n++) members[Find(comp, n)].push_back(n);
+    for (std::map<unsigned int, std::vector<unsigned int> >::const_iterator it = members.begin();
+         it != members.end(); ++it) {
+      AnalyzeGraph(it->second, nodes);
+    }
+
+    std::ostringstream os;
+    WriteReport(os);
+    report_ = os.str();
+  }
+
+  unsigned int NumBlocks() const { return names_.size(); }
+  unsigned int NumChannels() const { return chans_.size(); }
+  const std::vector<Channel>& Channels() const { return chans_; }
+  const std::vector<Graph>& Graphs() const { return graphs_; }
+  const std::string& Report() const { return report_; }
+
+  // Index into Channels(), or -1
+  int FindChannel(const std::string& chan) const {
+    for (unsigned int i = 0; i < chans_.size(); i++) {
+      if (chans_[i].name == chan) return i;
+    }
+    return -1;
+  }
+
+  // Index into Graphs() of the graph holding block, or -1
+  int FindGraph(const std::string& block) const {
+    for (unsigned int g = 0; g < graphs_.size(); g++) {
+      for (unsigned int b = 0; b < graphs_[g].blocks.size(); b++) {
+        if (graphs_[g].blocks[b] == block) return g;
+      }
+    }
+    return -1;
+  }
+
+  // The bound of the slowest graph, 1 without any
+  double Throughput() const {
+    double result = 1.0;
+    for (unsigned int g = 0; g < graphs_.size(); g++) {
+      if (graphs_[g].throughput < result) result = graphs_[g].throughput;
+    }
+    return result;
+  }
+
+ protected:
+  struct Annotation {
+    std::string name;
+    std::string src_name;
+    std::string dest_name;
+    unsigned int latency;
+    unsigned int capacity;
+  };
+
+  // A marked graph edge; chan is -1 for a block self loop
+  struct Edge {
+    unsigned int from;
+    unsigned int to;
+    unsigned int delay;
+    unsigned int tokens;
+    int chan;
+    bool credit;
+  };
+
+  bool quiet_;
+  std::map<std::string, unsigned int> block_ii_;
+  std::map<std::string, Annotation> chan_overrides_;
+  std::vector<Annotation> annotations_;
+  std::vector<Channel> chans_;
+  std::vector<std::string> names_;
+  std::vector<unsigned int> ii_;
+  std::vector<bool> declared_;
+  std::vector<Graph> graphs_;
+  std::string report_;
+
+  void start_of_simulation() {
+    Analyze();
+    if (!quiet_) std::cout << report_;
+  }
+
+  template <typename Value>
+  void ReadEntries(const Value& node, const std::string& key) {
+    if (!node.IsObject()) return;
+    if (node.HasMember("latency")) {
+      Annotation a;
+      a.name = key;
+      a.latency = node["latency"].GetUint();
+      a.capacity = node.HasMember("capacity") ? node["capacity"].GetUint() : 0;
+      if (node.HasMember("src_name")) a.src_name = node["src_name"].GetString();
+      if (node.HasMember("dest_name")) a.dest_name = node["dest_name"].GetString();
+      annotations_.push_back(a);
+      return;
+    }
+    for (typename Value::ConstMemberIterator it = node.MemberBegin(); it != node.MemberEnd(); ++it) {
+      ReadEntries(it->value, it->name.GetString());
+    }
+  }
+
+  static bool NameMatches(const std::string& chan, const std::string& key) {
+    return !key.empty() && (chan == key || channel_graph::EndsWith(chan, "." + key));
+  }
+
+  void Annotate(Channel& c) const {
+    c.latency = c.capacity = c.needed = 0;
+    c.annotated = false;
+    std::map<std::string, Annotation>::const_iterator it = chan_overrides_.find(c.name);
+    const Annotation* found = (it != chan_overrides_.end()) ? &it->second : NULL;
+    for (unsigned int i = 0; found == NULL && i < annotations_.size(); i++) {
+      const Annotation& a = annotations_[i];
+      if ((!a.src_name.empty() && a.src_name == c.producer_port) ||
+          (!a.dest_name.empty() && a.dest_name == c.consumer_port) || NameMatches(c.name, a.name)) {
+        found = &a;
+      }
+    }
+    if (found != NULL) {
+      c.latency = found->latency;
+      c.capacity = found->capacity;
+      c.annotated = true;
+    }
+  }
+
+  // Whether the block's II was declared, rather than assumed
+  bool BlockII(const std::string& block, unsigned int& ii) const {
+    std::map<std::string, unsigned int>::const_iterator it = block_ii_.find(block);
+    if (it != block_ii_.end()) {
+      ii = it->second;
+      return true;
+    }
+    Module* module = dynamic_cast<Module*>(sc_find_object(block.c_str()));
+    if (module == NULL || module->thread_stats_.empty()) return false;
+    ii = 1;
+    for (unsigned int i = 0; i < module->thread_stats_.size(); i++) {
+      ii = std::max(ii, module->thread_stats_[i].second->TargetII());
+    }
+    return true;
+  }
+
+  static unsigned int Find(std::vector<unsigned int>& comp, unsigned int n) {
+    while (comp[n] != n) n = comp[n] = comp[comp[n]];
+    return n;
+  }
+
+  // Gives one token to the forward edges closing a loop of forward edges
+  void MarkFeedback(unsigned int node, std::vector<Edge>& edges, std::vector<int>& state) const {
+    state[node] = 1;
+    for (unsigned int e = 0; e < edges.size(); e++) {
+      if (edges[e].chan < 0 || edges[e].credit || edges[e].from != node) continue;
+      if (state[edges[e].to] == 1) {
+        edges[e].tokens = 1;
+      } else if (state[edges[e].to] == 0) {
+        MarkFeedback(edges[e].to, edges, state);
+      }
+    }
+    state[node] = 2;
+  }
+
+  // Bellman-Ford on delay - ratio * tokens: whether a cycle has a larger
+  // ratio, and that cycle as edge indices
+  static bool LargerCycle(unsigned int num_nodes, const std::vector<Edge>& edges, double ratio,
+                          std::vector<unsigned int>& cycle) {
+    std::vector<double> dist(num_nodes, 0.0);
+    std::vector<int> pred(num_nodes, -1);
+    int last = -1;
+    for (unsigned int pass = 0; pass <= num_nodes; pass++) {
+      last = -1;
+      for (unsigned int e = 0; e < edges.size(); e++) {
+        double d = dist[edges[e].from] + edges[e].delay - ratio * edges[e].tokens;
+        if (d > dist[edges[e].to] + 1e-9) {
+          dist[edges[e].to] = d;
+          pred[edges[e].to] = e;
+          last = edges[e].to;
+        }
+      }
+      if (last < 0) return false;
+    }
+    // Still relaxing after num_nodes passes: walk back into the cycle
+    unsigned int node = last;
+    for (unsigned int i = 0; i < num_nodes; i++) node = edges[pred[node]].from;
+    cycle.clear();
+    unsigned int n = node;
+    do {
+      cycle.insert(cycle.begin(), pred[n]);
+      n = edges[pred[n]].from;
+    } while (n != node);
+    return true;
+  }
+
+  void AnalyzeGraph(const std::vector<unsigned int>& members, std::map<std::string, unsigned int>& nodes) {
+    std::map<unsigned int, unsigned int> local;
+    Graph graph;
+    unsigned int max_ii = 1;
+    for (unsigned int i = 0; i < members.size(); i++) {
+      local[members[i]] = i;
+      graph.blocks.push_back(names_[members[i]]);
+      max_ii = std::max(max_ii, ii_[members[i]]);
+    }
+    graph.block_bound = 1.0 / max_ii;
+
+    std::vector<Edge> edges;
+    for (unsigned int i = 0; i < members.size(); i++) {
+      Edge e = {i, i, ii_[members[i]], 1, -1, false};
+      edges.push_back(e);
+    }
+    for (unsigned int c = 0; c < chans_.size(); c++) {
+      const Channel& chan = chans_[c];
+      bool has_producer = chan.producer != "?" && local.count(nodes[chan.producer]);
+      bool has_consumer = chan.consumer != "?" && local.count(nodes[chan.consumer]);
+      if (!has_producer && !has_consumer) continue;
+      // Enough slots for latency + 1 cycles of messages at the block bound
+      unsigned int slots = static_cast<unsigned int>(std::ceil((chan.latency + 1) * graph.block_bound - 1e-9));
+      chans_[c].needed = slots > 0 ? slots - 1 : 0;
+      if (chans_[c].needed > chan.capacity) graph.undersized.push_back(c);
+      if (!has_producer || !has_consumer) continue;
+      unsigned int p = local[nodes[chan.producer]];
+      unsigned int q = local[nodes[chan.consumer]];
+      Edge forward = {p, q, chan.latency + 1, 0, static_cast<int>(c), false};
+      Edge credit = {q, p, 0, chan.capacity + 1, static_cast<int>(c), true};
+      edges.push_back(forward);
+      edges.push_back(credit);
+    }
+    std::vector<int> state(members.size(), 0);
+    for (unsigned int i = 0; i < members.size(); i++) {
+      if (state[i] == 0) MarkFeedback(i, edges, state);
+    }
+
+    // Every cycle holds a token, so no ratio exceeds the sum of the delays
+    double lo = 1.0, hi = 1.0;
+    for (unsigned int e = 0; e < edges.size(); e++) hi += edges[e].delay;
+    std::vector<unsigned int> cycle, found;
+    for (unsigned int iter = 0; iter < 64 && hi - lo > 1e-9 * hi; iter++) {
+      double mid = 0.5 * (lo + hi);
+      if (LargerCycle(members.size(), edges, mid, found)) {
+        lo = mid;
+      } else {
+        hi = mid;
+      }
+    }
+    // The critical cycle has a ratio of at least lo, and its exact ratio is the bound
+    if (!LargerCycle(members.size(), edges, lo - 1e-6, cycle)) cycle.assign(1, 0);
+    unsigned int delay = 0, tokens = 0;
+    for (unsigned int i = 0; i < cycle.size(); i++) {
+      delay += edges[cycle[i]].delay;
+      tokens += edges[cycle[i]].tokens;
+    }
+    graph.throughput = std::min(1.0, static_cast<double>(tokens) / std::max(delay, 1u));
+    Describe(graph, edges, cycle, members);
+    graphs_.push_back(graph);
+  }
+
+  void Describe(Graph& graph, const std::vector<Edge>& edges, const std::vector<unsigned int>& cycle,
+                const std::vector<unsigned int>& members) const {
+    std::ostringstream path;
+    bool forward_only = true, one_channel = true;
+    for (unsigned int i = 0; i < cycle.size(); i++) {
+      const Edge& e = edges[cycle[i]];
+      if (i == 0) path << names_[members[e.from]];
+      path << " -> " << names_[members[e.to]];
+      if (e.chan >= 0) path << " (" << chans_[e.chan].name << (e.credit ? " slots)" : ")");
+      forward_only &= (e.chan >= 0 && !e.credit);
+      one_channel &= (e.chan >= 0 && e.chan == edges[cycle[0]].chan);
+    }
+    graph.cycle = path.str();
+
+    std::ostringstream os;
+    const Edge& first = edges[cycle[0]];
+    if (cycle.size() == 1 && first.chan < 0) {
+      os << "block " << names_[members[first.from]] << " (II " << ii_[members[first.from]] << ")";
+    } else if (one_channel) {
+      const Channel& c = chans_[first.chan];
+      os << "channel " << c.name << " (latency " << c.latency << ", capacity " << c.capacity << ")";
+    } else if (forward_only) {
+      os << "feedback loop, assuming it holds 1 message";
+    } else {
+      // Slots on the shorter path absorb the difference
+      os << "reconvergent paths of unequal latency, short of slots in";
+      for (unsigned int i = 0; i < cycle.size(); i++) {
+        if (edges[cycle[i]].credit) os << " " << chans_[edges[cycle[i]].chan].name;
+      }
+    }
+    graph.bottleneck = os.str();
+  }
+
+  void WriteReport(std::ostream& os) const {
+    os << name() << ": steady-state throughput of " << graphs_.size() << " channel graphs, "
+       << names_.size() << " blocks, " << chans_.size() << " channels" << std::endl;
+    for (unsigned int g = 0; g < graphs_.size(); g++) {
+      const Graph& graph = graphs_[g];
+      os << "  ";
+      for (unsigned int b = 0; b < graph.blocks.size(); b++) os << (b ? " " : "") << graph.blocks[b];
+      os << ": " << std::fixed << std::setprecision(3) << graph.throughput << " messages/cycle"
+         << std::endl;
+      os << "    limited by " << graph.bottleneck << std::endl;
+      os << "    critical cycle: " << graph.cycle << std::endl;
+      for (unsigned int u = 0; u < graph.undersized.size(); u++) {
+        const Channel& c = chans_[graph.undersized[u]];
+        os << "    undersized: " << c.name << " (latency " << c.latency << ", capacity " << c.capacity
+           << ") needs capacity " << c.needed << " for " << graph.block_bound << " messages/cycle"
+           << std::endl;
+      }
+    }
+    std::ostringstream assumed;
+    for (unsigned int n = 0; n < names_.size(); n++) {
+      if (!declared_[n]) assumed << " " << names_[n];
+    }
+    if (!assumed.str().empty()) os << "  blocks without a declared II, assumed 1:" << assumed.str() << std::endl;
+    std::ostringstream plain;
+    for (unsigned int c = 0; c < chans_.size(); c++) {
+      if (!chans_[c].annotated) plain << " " << chans_[c].name;
+    }
+    if (!plain.str().empty()) os << "  channels without annotations, assumed combinational:" << plain.str() << std::endl;
+  }
+};
+
+}  // namespace match
+
+#endif  // __SYNTHESIS__
+
+#endif  // NVHLS_THROUGHPUT_H
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_TIMELINE_H
+#define NVHLS_TIMELINE_H
+
+#ifndef __SYNTHESIS__
+
+#include <systemc.h>
+#include <hls_globals.h>
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace match {
+
+/**
+ * \brief Cycle-level event timeline with Chrome trace export.
+ * \ingroup Tracer
+ *
+ * \par Overview
+ * Collects begin/end spans, complete spans and instant events on named tracks
+ * and writes them in the Chrome Trace Event JSON format, which can be opened
+ * in chrome://tracing or ui.perfetto.dev.
+ * - Every match::Module has a track named after the module. RecordEvent(name,
+ *   param) adds an instant event with param as its argument, and
+ *   TimelineBegin()/TimelineEnd() mark spans.
+ * - Buffered ports registered with Module::RegisterPortStats() get a track
+ *   "<module>.<port>" with an instant "transfer" per message and a "stall"
+ *   span for each run of stalled cycles.
+ * - Nothing is recorded until Enable() is called. Events are kept in memory
+ *   until WriteChromeTrace().
+ *
+ * \par A Simple Example
+ * \code
+ *      match::Timeline::Instance().Enable();
+ *      sc_start(10, SC_US);
+ *      match::Timeline::Instance().WriteChromeTrace("timeline.json");
+ * \endcode
+ */
+class Timeline {
+ public:
+  static Timeline& Instance() {
+    static Timeline timeline;
+    return timeline;
+  }
+
+  void Enable(bool enable = true) { enabled_ = enable; }
+  bool IsEnabled() const { return enabled_; }
+
+  unsigned int RegisterTrack(const std::string& name) {
+    tracks_.push_back(name);
+    return tracks_.size() - 1;
+  }
+
+  void Begin(unsigned int track, const std::string& name) {
+    Add(track, name, 'B', 0, false);
+  }
+  void End(unsigned int track, const std::string& name) {
+    Add(track, name, 'E', 0, false);
+  }
+  void Instant(unsigned int track, const std::string& name) {
+    Add(track, name, 'i', 0, false);
+  }
+  void Instant(unsigned int track, const std::string& name, uint64 arg) {
+    Add(track, name, 'i', arg, true);
+  }
+  // A span that started at start and ends now
+  void Complete(unsigned int track, const std::string& name, const sc_time& start) {
+    if (!enabled_) {
+      return;
+    }
+    Event e = MakeEvent(track, name, 'X', 0, false);
+    e.ticks = start.value();
+    e.dur_ticks = sc_time_stamp().value() - start.value();
+    events_.push_back(e);
+  }
+
+  size_t NumEvents() const { return events_.size(); }
+  void Clear() { events_.clear(); }
+
+  template <typename Writer>
+  void Write(Writer& writer) const {
+    double tick_us = sc_get_time_resolution().to_seconds() * 1e6;
+    writer.StartObject();
+    writer.Key("displayTimeUnit");
+    writer.String("ns");
+    writer.Key("traceEvents");
+    writer.StartArray();
+    for (unsigned int i = 0; i < tracks_.size(); i++) {
+      writer.StartObject();
+      writer.Key("name");
+      writer.String("thread_name");
+      writer.Key("ph");
+      writer.String("M");
+      writer.Key("pid");
+      writer.Uint(0);
+      writer.Key("tid");
+      writer.Uint(i);
+      writer.Key("args");
+      writer.StartObject();
+      writer.Key("name");
+      writer.String(tracks_[i].c_str(), tracks_[i].size());
+      writer.EndObject();
+      writer.EndObject();
+    }
+    for (unsigned int i = 0; i < events_.size(); i++) {
+      const Event& e = events_[i];
+      const std::string& name = names_[e.name];
+      char ph[2] = {e.phase, 0};
+      writer.StartObject();
+      writer.Key("name");
+      writer.String(name.c_str(), name.size());
+      writer.Key("ph");
+      writer.String(ph);
+      writer.Key("ts");
+      writer.Double(e.ticks * tick_us);
+      if (e.phase == 'X') {
+        writer.Key("dur");
+        writer.Double(e.dur_ticks * tick_us);
+      }
+      if (e.phase == 'i') {
+        writer.Key("s");
+        writer.String("t");
+      }
+      writer.Key("pid");
+      writer.Uint(0);
+      writer.Key("tid");
+      writer.Uint(e.track);
+      if (e.has_arg) {
+        writer.Key("args");
+        writer.StartObject();
+        writer.Key("param");
+        writer.Uint64(e.arg);
+        writer.EndObject();
+      }
+      writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+  }
+
+  std::string ToString() const {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    Write(writer);
+    return std::string(buffer.GetString(), buffer.GetSize());
+  }
+
+  bool WriteChromeTrace(const std::string& filename) const {
+    std::ofstream ofile(filename.c_str());
+    if (!ofile) {
+      DCOUT("Error: cannot open timeline file " << filename << endl);
+      return false;
+    }
+    ofile << ToString() << std::endl;
+    return ofile.good();
+  }
+
+ protected:
+  struct Event {
+    uint64 ticks;
+    uint64 dur_ticks;
+    uint64 arg;
+    unsigned int track;
+    unsigned int name;
+    char phase;
+    bool has_arg;
+  };
+
+  Timeline() : enabled_(false) {}
+
+  unsigned int NameId(const std::string& name) {
+    std::map<std::string, unsigned int>::iterator it = name_ids_.find(name);
+    if (it != name_ids_.end()) {
+      return it->second;
+    }
+    names_.push_back(name);
+    name_ids_[name] = names_.size() - 1;
+    return names_.size() - 1;
+  }
+
+  Event MakeEvent(unsigned int track, const std::string& name, char phase,
+                  uint64 arg, bool has_arg) {
+    Event e;
+    e.ticks = sc_time_stamp().value();
+    e.dur_ticks = 0;
+    e.arg = arg;
+    e.track = track;
+    e.name = NameId(name);
+    e.phase = phase;
+    e.has_arg = has_arg;
+    return e;
+  }
+
+  void Add(unsigned int track, const std::string& name, char phase,
+           uint64 arg, bool has_arg) {
+    if (enabled_) {
+      events_.push_back(MakeEvent(track, name, phase, arg, has_arg));
+    }
+  }
+
+  bool enabled_;
+  std::vector<std::string> tracks_;
+  std::vector<std::string> names_;
+  std::map<std::string, unsigned int> name_ids_;
+  std::vector<Event> events_;
+
+ private:
+  Timeline(const Timeline&);
+  Timeline& operator=(const Timeline&);
+};
+
+}  // namespace match
+
+#endif  // __SYNTHESIS__
+
+#endif  // NVHLS_TIMELINE_H
@@ -134,7 +134,7 @@ class Tracer {
   }
 #ifndef __SYNTHESIS__
   template <typename T_MSG>
-  Tracer& operator<<(T_MSG t) {
+  Tracer& operator<<(const T_MSG& t) {
     if (cur_level_ <= trace_level_) {
       (*ostr_) << t;
     }
@@ -189,6 +189,14 @@ class Tracer {
   void SetCurrentLevel(int l) {
 #ifndef __SYNTHESIS__
     cur_level_ = l;
+#endif
+  }
+  // True if messages at the current level are printed.
+  bool IsEnabled() {
+#ifndef __SYNTHESIS__
+    return cur_level_ <= trace_level_;
+#else
+    return false;
 #endif
   }
   void SetFatal() {
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_TRACE_SINK_H
+#define NVHLS_TRACE_SINK_H
+
+#ifndef __SYNTHESIS__
+
+#include <systemc.h>
+#include <TypeToBits.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace match {
+
+/**
+ * \brief Lock-free single-producer, single-consumer byte ring.
+ * \ingroup Tracer
+ *
+ * Capacity is rounded up to a power of two. TryPush() is all-or-nothing, so
+ * a record is never split between a push and a failed push.
+ */
+class TraceRing {
+ public:
+  explicit TraceRing(size_t capacity) : head_(0), tail_(0) {
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+    buf_.resize(size);
+    mask_ = size - 1;
+  }
+
+  size_t Capacity() const { return buf_.size(); }
+
+  // Producer side.
+  bool TryPush(const unsigned char* data, size_t n) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    if (buf_.size() - (head - tail) < n) {
+      return false;
+    }
+    size_t off = head & mask_;
+    size_t first = (n < buf_.size() - off) ? n : buf_.size() - off;
+    memcpy(&buf_[off], data, first);
+    memcpy(&buf_[0], data + first, n - first);
+    head_.store(head + n, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side: copies out up to max bytes, returns the number copied.
+  size_t Pop(unsigned char* out, size_t max) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t n = head - tail;
+    if (n > max) n = max;
+    size_t off = tail & mask_;
+    size_t first = (n < buf_.size() - off) ? n : buf_.size() - off;
+    memcpy(out, &buf_[off], first);
+    memcpy(out + first, &buf_[0], n - first);
+    tail_.store(tail + n, std::memory_order_release);
+    return n;
+  }
+
+ private:
+  std::vector<unsigned char> buf_;
+  size_t mask_;
+  std::atomic<size_t> head_;
+  std::atomic<size_t> tail_;
+
+  TraceRing(const TraceRing&);
+  TraceRing& operator=(const TraceRing&);
+};
+
+/**
+ * \brief Record layout of binary trace files.
+ * \ingroup Tracer
+ *
+ * A file starts with a 24-byte header: "NVTRACE1", a u32 version, a u32
+ * record header size and a u64 SystemC time resolution in femtoseconds. It is
+ * followed by records, each a TraceRecordHeader and size payload bytes, in
+ * host byte order. Module and event name records define the ids used by
+ * later event records.
+ */
+struct TraceRecordHeader {
+  enum Kind { kEvent = 0, kModuleName = 1, kEventName = 2 };
+  uint64 ticks;      // sc_time_stamp().value()
+  unsigned int id;   // module id, or the defined id for name records
+  unsigned int event;
+  unsigned short kind;
+  unsigned short reserved;
+  unsigned int size;  // payload bytes
+};
+
+/**
+ * \brief Asynchronous binary trace sink.
+ * \ingroup Tracer
+ *
+ * \par Overview
+ * A cheaper alternative to text tracing for hot trace points. Records
+ * (timestamp, module id, event id, payload bits) are copied into a TraceRing
+ * by the simulation thread and written to disk by a background thread, so the
+ * SystemC kernel never waits on I/O unless the ring is full.
+ * DecodeBinaryTrace() turns a file back into text lines in the format of
+ * Module::T().
+ *
+ * The sink is a process-wide singleton. Records are dropped until Open() is
+ * called; names registered before Open() are written when it is.
+ *
+ * \par A Simple Example
+ * \code
+ *      // In a match::Module
+ *      unsigned int ev_pop = RegisterTraceEvent("popped");
+ *      ...
+ *      TraceBinary(ev_pop, msg);
+ *
+ *      // In sc_main
+ *      match::BinaryTraceSink::Instance().Open("trace.bin");
+ *      sc_start();
+ *      match::BinaryTraceSink::Instance().Close();
+ *      match::DecodeBinaryTrace("trace.bin", std::cout);
+ * \endcode
+ */
+class BinaryTraceSink {
+ public:
+  static const char* Magic() { return "NVTRACE1"; }
+  static const unsigned int kVersion = 1;
+  static const unsigned int kFileHeaderBytes = 24;
+
+  static BinaryTraceSink& Instance() {
+    static BinaryTraceSink sink;
+    return sink;
+  }
+
+  ~BinaryTraceSink() { Close(); }
+
+  bool Open(const std::string& filename, size_t ring_bytes = 1 << 24) {
+    Close();
+    file_ = fopen(filename.c_str(), "wb");
+    if (file_ == NULL) {
+      DCOUT("Error: cannot open trace file " << filename << endl);
+      return false;
+    }
+    unsigned char header[kFileHeaderBytes];
+    memcpy(header, Magic(), 8);
+    unsigned int version = kVersion;
+    unsigned int rec_bytes = sizeof(TraceRecordHeader);
+    uint64 tick_fs =
+        static_cast<uint64>(sc_get_time_resolution().to_seconds() * 1e15 + 0.5);
+    memcpy(header + 8, &version, 4);
+    memcpy(header + 12, &rec_bytes, 4);
+    memcpy(header + 16, &tick_fs, 8);
+    fwrite(header, 1, kFileHeaderBytes, file_);
+
+    ring_ = new TraceRing(ring_bytes);
+    stop_.store(false);
+    stalls_ = 0;
+    open_ = true;
+    for (unsigned int i = 0; i < modules_.size(); i++) {
+      PushName(TraceRecordHeader::kModuleName, i, modules_[i]);
+    }
+    for (unsigned int i = 0; i < events_.size(); i++) {
+      PushName(TraceRecordHeader::kEventName, i, events_[i]);
+    }
+    writer_ = std::thread(&BinaryTraceSink::Drain, this);
+    return true;
+  }
+
+  // Writes out everything recorded so far and closes the file.
+  void Close() {
+    if (!open_) {
+      return;
+    }
+    open_ = false;
+    stop_.store(true);
+    writer_.join();
+    fclose(file_);
+    file_ = NULL;
+    delete ring_;
+    ring_ = NULL;
+  }
+
+  bool IsOpen() const { return open_; }
+
+  // Number of records that had to wait for the writer to free ring space.
+  uint64 Stalls() const { return stalls_; }
+
+  unsigned int RegisterModule(const std::string& name) {
+    modules_.push_back(name);
+    if (open_) {
+      PushName(TraceRecordHeader::kModuleName, modules_.size() - 1, name);
+    }
+    return modules_.size() - 1;
+  }
+
+  unsigned int RegisterEvent(const std::string& text) {
+    events_.push_back(text);
+    if (open_) {
+      PushName(TraceRecordHeader::kEventName, events_.size() - 1, text);
+    }
+    return events_.size() - 1;
+  }
+
+  void Record(unsigned int module, unsigned int event, const void* payload,
+              unsigned int size) {
+    if (!open_) {
+      return;
+    }
+    TraceRecordHeader h;
+    h.ticks = sc_time_stamp().value();
+    h.id = module;
+    h.event = event;
+    h.kind = TraceRecordHeader::kEvent;
+    h.reserved = 0;
+    h.size = size;
+    Push(h, payload);
+  }
+
+ protected:
+  BinaryTraceSink()
+      : file_(NULL), ring_(NULL), open_(false), stop_(false), stalls_(0) {}
+
+  void PushName(unsigned short kind, unsigned int id, const std::string& name) {
+    TraceRecordHeader h;
+    h.ticks = 0;
+    h.id = id;
+    h.event = 0;
+    h.kind = kind;
+    h.reserved = 0;
+    h.size = name.size();
+    Push(h, name.data());
+  }
+
+  void Push(const TraceRecordHeader& h, const void* payload) {
+    size_t n = sizeof(h) + h.size;
+    NVHLS_ASSERT_MSG(n <= ring_->Capacity(), "Trace record larger than the trace ring");
+    unsigned char stack_buf[256];
+    std::vector<unsigned char> heap_buf;
+    unsigned char* buf = stack_buf;
+    if (n > sizeof(stack_buf)) {
+      heap_buf.resize(n);
+      buf = &heap_buf[0];
+    }
+    memcpy(buf, &h, sizeof(h));
+    if (h.size != 0) {
+      memcpy(buf + sizeof(h), payload, h.size);
+    }
+    if (!ring_->TryPush(buf, n)) {
+      stalls_++;
+      while (!ring_->TryPush(buf, n)) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  // Writer thread
+  void Drain() {
+    std::vector<unsigned char> buf(1 << 16);
+    while (true) {
+      bool stopping = stop_.load();
+      size_t n = ring_->Pop(&buf[0], buf.size());
+      if (n != 0) {
+        fwrite(&buf[0], 1, n, file_);
+      } else if (stopping) {
+        break;
+      } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
+    }
+    fflush(file_);
+  }
+
+  FILE* file_;
+  TraceRing* ring_;
+  bool open_;
+  std::atomic<bool> stop_;
+  std::thread writer_;
+  uint64 stalls_;
+  std::vector<std::string> modules_;
+  std::vector<std::string> events_;
+
+ private:
+  BinaryTraceSink(const BinaryTraceSink&);
+  BinaryTraceSink& operator=(const BinaryTraceSink&);
+};
+
+/**
+ * \brief Payload bits of a binary trace record.
+ * \ingroup Tracer
+ *
+ * Bytes are least significant first, in the bit layout of TypeToBits().
+ */
+template <typename Message>
+struct TracePayload {
+  static const unsigned int W = Wrapped<Message>::width;
+  static const unsigned int kBytes = (W + 7) / 8;
+  unsigned char bytes[kBytes == 0 ? 1 : kBytes];
+
+  explicit TracePayload(const Message& msg) {
+    sc_lv<W> bits = TypeToBits<Message>(msg);
+    for (unsigned int i = 0; i < kBytes; i++) {
+      unsigned int lo = 8 * i;
+      unsigned int hi = (lo + 7 < W) ? lo + 7 : W - 1;
+      bytes[i] = static_cast<unsigned char>(bits.range(hi, lo).to_uint());
+    }
+  }
+};
+
+/**
+ * \brief Convert a binary trace file back to text (C-sim only).
+ * \ingroup Tracer
+ *
+ * Each event becomes "<time>: <module>: <event> 0x<payload>", with the payload
+ * printed most significant byte first and omitted when empty.
+ */
+inline bool DecodeBinaryTrace(const std::string& filename, std::ostream& out) {
+  FILE* file = fopen(filename.c_str(), "rb");
+  if (file == NULL) {
+    DCOUT("Error: cannot open trace file " << filename << endl);
+    return false;
+  }
+  unsigned char header[BinaryTraceSink::kFileHeaderBytes];
+  unsigned int rec_bytes = 0;
+  uint64 tick_fs = 0;
+  if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+      memcmp(header, BinaryTraceSink::Magic(), 8) != 0) {
+    DCOUT("Error: " << filename << " is not a binary trace file" << endl);
+    fclose(file);
+    return false;
+  }
+  memcpy(&rec_bytes, header + 12, 4);
+  memcpy(&tick_fs, header + 16, 8);
+  if (rec_bytes != sizeof(TraceRecordHeader)) {
+    DCOUT("Error: " << filename << " has an unsupported record layout" << endl);
+    fclose(file);
+    return false;
+  }
+
+  std::vector<std::string> modules;
+  std::vector<std::string> events;
+  std::vector<unsigned char> payload;
+  TraceRecordHeader h;
+  bool ok = true;
+  while (fread(&h, sizeof(h), 1, file) == 1) {
+    payload.resize(h.size);
+    if (h.size != 0 && fread(&payload[0], 1, h.size, file) != h.size) {
+      ok = false;
+      break;
+    }
+    if (h.kind != TraceRecordHeader::kEvent) {
+      std::vector<std::string>& names =
+          (h.kind == TraceRecordHeader::kModuleName) ? modules : events;
+      if (names.size() <= h.id) names.resize(h.id + 1);
+      names[h.id].assign(payload.begin(), payload.end());
+      continue;
+    }
+    out << sc_time(static_cast<double>(h.ticks) * tick_fs, SC_FS) << ": ";
+    out << (h.id < modules.size() ? modules[h.id] : std::string("?")) << ": ";
+    out << (h.event < events.size() ? events[h.event] : std::string("?"));
+    if (h.size != 0) {
+      std::ios_base::fmtflags flags = out.flags();
+      out << " 0x" << std::hex << std::setfill('0');
+      for (int i = h.size - 1; i >= 0; i--) {
+        out << std::setw(2) << static_cast<unsigned int>(payload[i]);
+      }
+      out.flags(flags);
+      out << std::setfill(' ');
+    }
+    out << std::endl;
+  }
+  fclose(file);
+  if (!ok) {
+    DCOUT("Warning: " << filename << " ends with a truncated record" << endl);
+  }
+  return ok;
+}
+
+}  // namespace match
+
+#endif  // __SYNTHESIS__
+
+#endif  // NVHLS_TRACE_SINK_H
@@ -24,6 +24,7 @@
 #include <ccs_p2p.h>
 #include <nvhls_assert.h>
 #include <nvhls_message.h>
+#include <comptrees.h>
 
 namespace nvhls {
 
@@ -174,6 +175,190 @@ inline std::ostream& operator<<(std::ostream& os,
   return os;
 }
 
+#ifndef __SYNTHESIS__
+// C++ simulation fast path for the vector functions below.
+//
+// When every scalar type is an sc_int, sc_uint or ac_int of at most 64 bits,
+// the vectors are copied into arrays of native words and computed with plain
+// loops the host compiler can vectorize. The results are bit-exact: add, sub
+// and mul are exact modulo 2^N, so computing modulo 2^32 (outputs of up to 32
+// bits) or 2^64 and truncating to OutType gives what the element-wise
+// templates give. Other types take the element-wise path.
+template <typename T>
+struct vector_sim_int {
+  static const bool native = false;
+  static const unsigned int width = 0;
+};
+
+template <int W>
+struct vector_sim_int<sc_int<W> > {
+  static const bool native = (W <= 64);
+  static const unsigned int width = W;
+  static unsigned long long bits(const sc_int<W>& x) { return x.to_int64(); }
+  static sc_int<W> make(unsigned long long v) { return sc_int<W>(v); }
+};
+
+template <int W>
+struct vector_sim_int<sc_uint<W> > {
+  static const bool native = (W <= 64);
+  static const unsigned int width = W;
+  static unsigned long long bits(const sc_uint<W>& x) { return x.to_uint64(); }
+  static sc_uint<W> make(unsigned long long v) { return sc_uint<W>(v); }
+};
+
+#ifdef HLS_CATAPULT
+template <int W, bool S>
+struct vector_sim_int<ac_int<W, S> > {
+  static const bool native = (W <= 64);
+  static const unsigned int width = W;
+  static unsigned long long bits(const ac_int<W, S>& x) {
+    return S ? (unsigned long long)x.to_int64() : x.to_uint64();
+  }
+  static ac_int<W, S> make(unsigned long long v) { return ac_int<W, S>(v); }
+};
+
+#ifdef NVHLS_FAST_SIM_INT
+template <int W, bool S>
+struct vector_sim_int<nvhls::fast_int<W, S> > {
+  static const bool native = true;
+  static const unsigned int width = W;
+  static unsigned long long bits(const nvhls::fast_int<W, S>& x) { return x.raw(); }
+  static nvhls::fast_int<W, S> make(unsigned long long v) {
+    return nvhls::fast_int<W, S>::FromRaw(v);
+  }
+};
+#endif
+#endif
+
+template <bool Narrow>
+struct vector_sim_word {
+  typedef unsigned long long type;
+};
+
+template <>
+struct vector_sim_word<true> {
+  typedef unsigned int type;
+};
+
+// Each function returns false if the caller must take the element-wise path
+template <typename InType1, typename InType2, typename InType3,
+          typename OutType,
+          bool Native = (vector_sim_int<InType1>::native &&
+                         vector_sim_int<InType2>::native &&
+                         vector_sim_int<InType3>::native &&
+                         vector_sim_int<OutType>::native)>
+struct vector_sim {
+  template <unsigned int N>
+  static bool mul(const InType1 a[N], const InType2 b[N], OutType out[N]) { return false; }
+  template <unsigned int N>
+  static bool add(const InType1 a[N], const InType2 b[N], OutType out[N]) { return false; }
+  template <unsigned int N>
+  static bool sub(const InType1 a[N], const InType2 b[N], OutType out[N]) { return false; }
+  template <unsigned int N>
+  static bool mac(const InType1 a[N], const InType2 b[N], const InType3 c[N],
+                  OutType out[N]) { return false; }
+  template <unsigned int N>
+  static bool sum(const InType1 a[N], OutType& out) { return false; }
+  template <unsigned int N>
+  static bool dot(const InType1 a[N], const InType2 b[N], const InType3& acc,
+                  OutType& out) { return false; }
+};
+
+template <typename InType1, typename InType2, typename InType3,
+          typename OutType>
+struct vector_sim<InType1, InType2, InType3, OutType, true> {
+  typedef typename vector_sim_word<(vector_sim_int<OutType>::width <= 32)>::type word;
+
+  template <typename T>
+  static word bits(const T& x) { return static_cast<word>(vector_sim_int<T>::bits(x)); }
+
+  template <unsigned int N>
+  static bool mul(const InType1 a[N], const InType2 b[N], OutType out[N]) {
+    word wa[N], wb[N], wo[N];
+    for (unsigned i = 0; i < N; i++) {
+      wa[i] = bits(a[i]);
+      wb[i] = bits(b[i]);
+    }
+    for (unsigned i = 0; i < N; i++)
+      wo[i] = wa[i] * wb[i];
+    for (unsigned i = 0; i < N; i++)
+      out[i] = vector_sim_int<OutType>::make(wo[i]);
+    return true;
+  }
+
+  template <unsigned int N>
+  static bool add(const InType1 a[N], const InType2 b[N], OutType out[N]) {
+    word wa[N], wb[N], wo[N];
+    for (unsigned i = 0; i < N; i++) {
+      wa[i] = bits(a[i]);
+      wb[i] = bits(b[i]);
+    }
+    for (unsigned i = 0; i < N; i++)
+      wo[i] = wa[i] + wb[i];
+    for (unsigned i = 0; i < N; i++)
+      out[i] = vector_sim_int<OutType>::make(wo[i]);
+    return true;
+  }
+
+  template <unsigned int N>
+  static bool sub(const InType1 a[N], const InType2 b[N], OutType out[N]) {
+    word wa[N], wb[N], wo[N];
+    for (unsigned i = 0; i < N; i++) {
+      wa[i] = bits(a[i]);
+      wb[i] = bits(b[i]);
+    }
+    for (unsigned i = 0; i < N; i++)
+      wo[i] = wa[i] - wb[i];
+    for (unsigned i = 0; i < N; i++)
+      out[i] = vector_sim_int<OutType>::make(wo[i]);
+    return true;
+  }
+
+  template <unsigned int N>
+  static bool mac(const InType1 a[N], const InType2 b[N], const InType3 c[N],
+                  OutType out[N]) {
+    word wa[N], wb[N], wc[N], wo[N];
+    for (unsigned i = 0; i < N; i++) {
+      wa[i] = bits(a[i]);
+      wb[i] = bits(b[i]);
+      wc[i] = bits(c[i]);
+    }
+    for (unsigned i = 0; i < N; i++)
+      wo[i] = wa[i] * wb[i] + wc[i];
+    for (unsigned i = 0; i < N; i++)
+      out[i] = vector_sim_int<OutType>::make(wo[i]);
+    return true;
+  }
+
+  template <unsigned int N>
+  static bool sum(const InType1 a[N], OutType& out) {
+    word wa[N];
+    for (unsigned i = 0; i < N; i++)
+      wa[i] = bits(a[i]);
+    word s = 0;
+    for (unsigned i = 0; i < N; i++)
+      s += wa[i];
+    out = vector_sim_int<OutType>::make(s);
+    return true;
+  }
+
+  template <unsigned int N>
+  static bool dot(const InType1 a[N], const InType2 b[N], const InType3& acc,
+                  OutType& out) {
+    word wa[N], wb[N];
+    for (unsigned i = 0; i < N; i++) {
+      wa[i] = bits(a[i]);
+      wb[i] = bits(b[i]);
+    }
+    word s = bits(acc);
+    for (unsigned i = 0; i < N; i++)
+      s += wa[i] * wb[i];
+    out = vector_sim_int<OutType>::make(s);
+    return true;
+  }
+};
+#endif  // __SYNTHESIS__
+
 /**
  * \brief Function implementing vector multiplication 
  * \ingroup nvhls_vector
@@ -207,9 +392,14 @@ inline std::ostream& operator<<(std::ostream& os,
 
 template <typename InType1, typename InType2, typename OutType,
           unsigned int VectorLength, bool Unroll>
-void vector_mul(nv_scvector<InType1, VectorLength> in1,
-                nv_scvector<InType2, VectorLength> in2,
+void vector_mul(const nv_scvector<InType1, VectorLength>& in1,
+                const nv_scvector<InType2, VectorLength>& in2,
                 nv_scvector<OutType, VectorLength>& out) {
+#ifndef __SYNTHESIS__
+  if (vector_sim<InType1, InType2, InType1, OutType>::template mul<VectorLength>(
+          in1.data, in2.data, out.data))
+    return;
+#endif
 
   if (Unroll == true) {
 #pragma hls_unroll yes
@@ -255,9 +445,14 @@ void vector_mul(nv_scvector<InType1, VectorLength> in1,
 
 template <typename InType1, typename InType2, typename OutType,
           unsigned int VectorLength, bool Unroll>
-void vector_add(nv_scvector<InType1, VectorLength> in1,
-                nv_scvector<InType2, VectorLength> in2,
+void vector_add(const nv_scvector<InType1, VectorLength>& in1,
+                const nv_scvector<InType2, VectorLength>& in2,
                 nv_scvector<OutType, VectorLength>& out) {
+#ifndef __SYNTHESIS__
+  if (vector_sim<InType1, InType2, InType1, OutType>::template add<VectorLength>(
+          in1.data, in2.data, out.data))
+    return;
+#endif
   if (Unroll == true) {
 #pragma hls_unroll yes
     for (unsigned i = 0; i < VectorLength; i++)
@@ -301,9 +496,14 @@ void vector_add(nv_scvector<InType1, VectorLength> in1,
  */
 template <typename InType1, typename InType2, typename OutType,
           unsigned int VectorLength, bool Unroll>
-void vector_sub(nv_scvector<InType1, VectorLength> in1,
-                nv_scvector<InType2, VectorLength> in2,
+void vector_sub(const nv_scvector<InType1, VectorLength>& in1,
+                const nv_scvector<InType2, VectorLength>& in2,
                 nv_scvector<OutType, VectorLength>& out) {
+#ifndef __SYNTHESIS__
+  if (vector_sim<InType1, InType2, InType1, OutType>::template sub<VectorLength>(
+          in1.data, in2.data, out.data))
+    return;
+#endif
   if (Unroll == true) {
 #pragma hls_unroll yes
     for (unsigned i = 0; i < VectorLength; i++)
@@ -347,7 +547,12 @@ void vector_sub(nv_scvector<InType1, VectorLength> in1,
 
 template <typename InType, typename OutType, unsigned int VectorLength,
           bool UseReduceTree>
-void reduction(nv_scvector<InType, VectorLength> in, OutType& out) {
+void reduction(const nv_scvector<InType, VectorLength>& in, OutType& out) {
+#ifndef __SYNTHESIS__
+  if (vector_sim<InType, InType, InType, OutType>::template sum<VectorLength>(
+          in.data, out))
+    return;
+#endif
   OutType sum = 0;
 
   if (VectorLength > 1) {
@@ -403,8 +608,13 @@ void reduction(nv_scvector<InType, VectorLength> in, OutType& out) {
 
 template <typename InType1, typename InType2, typename OutType,
           unsigned int VectorLength, bool UseReduceTree>
-void dp(nv_scvector<InType1, VectorLength> in1,
-        nv_scvector<InType2, VectorLength> in2, OutType& out) {
+void dp(const nv_scvector<InType1, VectorLength>& in1,
+        const nv_scvector<InType2, VectorLength>& in2, OutType& out) {
+#ifndef __SYNTHESIS__
+  if (vector_sim<InType1, InType2, OutType, OutType>::template dot<VectorLength>(
+          in1.data, in2.data, OutType(0), out))
+    return;
+#endif
   OutType sum = 0;
   if (VectorLength > 1) {
     if (UseReduceTree == true) {
@@ -424,6 +634,391 @@ void dp(nv_scvector<InType1, VectorLength> in1,
   out = sum;
 }
 
+// Integer type of one adder tree level
+template <unsigned int W, bool Signed>
+struct adder_tree_int {
+  typedef typename nvhls_t<W>::nvint_t type;
+};
+
+template <unsigned int W>
+struct adder_tree_int<W, false> {
+  typedef typename nvhls_t<W>::nvuint_t type;
+};
+
+// Operands left after one level: 3:2 compressors while more than two remain
+// in carry-save mode, otherwise pairwise adders
+template <unsigned int Count, bool CarrySave>
+struct adder_tree_next {
+  static const unsigned int val = (CarrySave && Count > 2)
+                                      ? 2 * (Count / 3) + Count % 3
+                                      : (Count + 1) / 2;
+};
+
+template <unsigned int Count, bool CarrySave>
+struct adder_tree_depth {
+  static const unsigned int val =
+      1 + adder_tree_depth<adder_tree_next<Count, CarrySave>::val, CarrySave>::val;
+};
+
+template <bool CarrySave>
+struct adder_tree_depth<1, CarrySave> {
+  static const unsigned int val = 0;
+};
+
+// One level of pairwise adders. In carry-save mode all levels work modulo
+// the final width W; otherwise each level is one bit wider than the last.
+template <unsigned int Count, unsigned int W, bool Signed, bool CarrySave,
+          bool Compress = (CarrySave && Count > 2)>
+class AdderTreeLevel {
+ public:
+  static const unsigned int OutCount = (Count + 1) / 2;
+  static const unsigned int OutW = CarrySave ? W : W + 1;
+  typedef typename adder_tree_int<W, Signed>::type In;
+  typedef typename adder_tree_int<OutW, Signed>::type Out;
+
+  static void reduce(const In v[Count], Out out[OutCount]) {
+#pragma hls_unroll yes
+    for (unsigned g = 0; g < OutCount; g++) {
+      Out sum = v[2 * g];
+      if (2 * g + 1 < Count) {
+        sum += Out(v[2 * g + 1]);
+      }
+      out[g] = sum;
+    }
+  }
+};
+
+// One level of 3:2 compressors: every three operands become a sum and a
+// carry word, with no carry propagation
+template <unsigned int Count, unsigned int W, bool Signed, bool CarrySave>
+class AdderTreeLevel<Count, W, Signed, CarrySave, true> {
+  static const unsigned int Groups = Count / 3;
+
+ public:
+  static const unsigned int OutCount = 2 * Groups + Count % 3;
+  static const unsigned int OutW = W;
+  typedef typename adder_tree_int<W, Signed>::type In;
+  typedef In Out;
+
+  static void reduce(const In v[Count], Out out[OutCount]) {
+#pragma hls_unroll yes
+    for (unsigned g = 0; g < Groups; g++) {
+      In a = v[3 * g], b = v[3 * g + 1], c = v[3 * g + 2];
+      out[2 * g] = a ^ b ^ c;
+      out[2 * g + 1] = ((a & b) | (a & c) | (b & c)) << 1;
+    }
+#pragma hls_unroll yes
+    for (unsigned r = 0; r < Count % 3; r++) {
+      out[2 * Groups + r] = v[3 * Groups + r];
+    }
+  }
+};
+
+// Levels consecutive adder tree levels without registers
+template <unsigned int Count, unsigned int W, bool Signed, bool CarrySave,
+          unsigned int Levels>
+class AdderTreeLevels {
+  typedef AdderTreeLevel<Count, W, Signed, CarrySave> First;
+  typedef AdderTreeLevels<First::OutCount, First::OutW, Signed, CarrySave,
+                          Levels - 1> Rest;
+
+ public:
+  static const unsigned int OutCount = Rest::OutCount;
+  static const unsigned int OutW = Rest::OutW;
+  typedef typename First::In In;
+  typedef typename Rest::Out Out;
+
+  static void reduce(const In v[Count], Out out[OutCount]) {
+    typename First::Out mid[First::OutCount];
+    First::reduce(v, mid);
+    Rest::reduce(mid, out);
+  }
+};
+
+template <unsigned int Count, unsigned int W, bool Signed, bool CarrySave>
+class AdderTreeLevels<Count, W, Signed, CarrySave, 0> {
+ public:
+  static const unsigned int OutCount = Count;
+  static const unsigned int OutW = W;
+  typedef typename adder_tree_int<W, Signed>::type In;
+  typedef In Out;
+
+  static void reduce(const In v[Count], Out out[OutCount]) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < Count; i++) {
+      out[i] = v[i];
+    }
+  }
+};
+
+// Common parameters of AdderTree and AdderTreePipelined. Carry-save trees
+// run unsigned modulo 2^OutW, which is exact because the sum fits.
+template <typename InType, unsigned int N, bool CarrySave>
+struct adder_tree_params {
+  static const bool is_signed = Wrapped<InType>::is_signed;
+  static const unsigned int InW = Wrapped<InType>::width;
+  static const unsigned int OutW = InW + log2_ceil<N>::val;
+  static const unsigned int TreeW = CarrySave ? OutW : InW;
+  static const bool TreeSigned = CarrySave ? false : is_signed;
+  static const unsigned int NumLevels = adder_tree_depth<N, CarrySave>::val;
+  typedef typename adder_tree_int<OutW, is_signed>::type OutType;
+  typedef typename adder_tree_int<TreeW, TreeSigned>::type TreeIn;
+
+  static void load(const InType in[N], TreeIn v[N]) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < N; i++) {
+      // Sign-extend before reinterpreting as unsigned in carry-save mode
+      OutType x = in[i];
+      v[i] = x;
+    }
+  }
+};
+
+/**
+ * \brief Balanced adder tree with a compile-time output width
+ * \ingroup nvhls_vector
+ *
+ * \tparam InType     Input scalar type: an nvhls integer type
+ * \tparam N          Number of inputs
+ * \tparam CarrySave  Reduce with 3:2 compressors and one final adder (default: false)
+ *
+ * \par Overview
+ * sum() adds N values with an explicit tree of log2(N) levels rather than a
+ * chain. OutType has InType's signedness and InW + ceil(log2(N)) bits, enough
+ * for any sum of N inputs. Without CarrySave each level is one bit wider than
+ * the last; with it, the operands are sign-extended to OutType's width and
+ * reduced by 3:2 compressors, leaving a single carry-propagate adder.
+ * AdderTreePipelined registers the same tree.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_vector.h>
+ *
+ *      ...
+ *      typedef nvhls::product_type<NVINT8, NVINT8>::type Prod;   // NVINT16
+ *      Prod prods[64];
+ *      ...
+ *      typedef nvhls::AdderTree<Prod, 64, true> Tree;             // 22 bits
+ *      Tree::OutType sum = Tree::sum(prods);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename InType, unsigned int N, bool CarrySave = false>
+class AdderTree {
+  typedef adder_tree_params<InType, N, CarrySave> Params;
+  typedef AdderTreeLevels<N, Params::TreeW, Params::TreeSigned, CarrySave,
+                          Params::NumLevels> Tree;
+
+ public:
+  typedef typename Params::OutType OutType;
+  static const unsigned int OutW = Params::OutW;
+  static const unsigned int NumLevels = Params::NumLevels;
+
+  static OutType sum(const InType in[N]) {
+    typename Params::TreeIn v[N];
+    Params::load(in, v);
+    typename Tree::Out out[1];
+    Tree::reduce(v, out);
+    OutType result = out[0];
+    return result;
+  }
+};
+
+// One pipeline stage: LevelsPerStage levels into registers, then the rest of
+// the tree. The last stage (or every level, with LevelsPerStage = 0) is
+// combinational to the output.
+template <unsigned int Count, unsigned int W, bool Signed, bool CarrySave,
+          unsigned int LevelsPerStage, unsigned int LevelsLeft,
+          bool Last = (LevelsPerStage == 0 || LevelsLeft <= LevelsPerStage)>
+class AdderTreePipeStage {
+  typedef AdderTreeLevels<Count, W, Signed, CarrySave, LevelsPerStage> Segment;
+  typedef AdderTreePipeStage<Segment::OutCount, Segment::OutW, Signed,
+                             CarrySave, LevelsPerStage,
+                             LevelsLeft - LevelsPerStage> Next;
+
+  typename Segment::Out reg[Segment::OutCount];
+  bool reg_valid;
+  Next next;
+
+ public:
+  typedef typename Segment::In In;
+  typedef typename Next::Out Out;
+  static const unsigned int Latency = 1 + Next::Latency;
+
+  AdderTreePipeStage() { reset(); }
+
+  void reset() {
+    reg_valid = false;
+    next.reset();
+  }
+
+  void run(const In v[Count], bool valid, Out& out, bool& out_valid) {
+    // The later stages consume this stage's registers before they update
+    next.run(reg, reg_valid, out, out_valid);
+    Segment::reduce(v, reg);
+    reg_valid = valid;
+  }
+};
+
+template <unsigned int Count, unsigned int W, bool Signed, bool CarrySave,
+          unsigned int LevelsPerStage, unsigned int LevelsLeft>
+class AdderTreePipeStage<Count, W, Signed, CarrySave, LevelsPerStage,
+                         LevelsLeft, true> {
+  typedef AdderTreeLevels<Count, W, Signed, CarrySave, LevelsLeft> Segment;
+
+ public:
+  typedef typename Segment::In In;
+  typedef typename Segment::Out Out;
+  static const unsigned int Latency = 0;
+
+  void reset() {}
+
+  void run(const In v[Count], bool valid, Out& out, bool& out_valid) {
+    Out res[1];
+    Segment::reduce(v, res);
+    out = res[0];
+    out_valid = valid;
+  }
+};
+
+/**
+ * \brief Pipelined AdderTree, and its cycle-accurate C++ model
+ * \ingroup nvhls_vector
+ *
+ * \tparam InType          Input scalar type: an nvhls integer type
+ * \tparam N               Number of inputs
+ * \tparam CarrySave       Reduce with 3:2 compressors (default: false)
+ * \tparam LevelsPerStage  Tree levels between pipeline registers; 0 for none
+ *
+ * \par Overview
+ * The AdderTree of the same parameters, with a register stage after every
+ * LevelsPerStage levels. Call run() once per cycle (e.g. from a pipelined
+ * loop at II=1): the sum of one call's inputs comes out Latency calls later,
+ * with out_valid echoing valid. Latency is
+ * ceil(NumLevels / LevelsPerStage) - 1.
+ *
+ * \par A Simple Example
+ * \code
+ *      nvhls::AdderTreePipelined<NVINT16, 64, true, 3> tree;   // 11 levels, Latency 3
+ *      ...
+ *      tree.run(prods, prods_valid, sum, sum_valid);
+ * \endcode
+ * \par
+ *
+ */
+template <typename InType, unsigned int N, bool CarrySave = false,
+          unsigned int LevelsPerStage = 0>
+class AdderTreePipelined {
+  typedef adder_tree_params<InType, N, CarrySave> Params;
+  typedef AdderTreePipeStage<N, Params::TreeW, Params::TreeSigned, CarrySave,
+                             LevelsPerStage, Params::NumLevels> Stages;
+  Stages stages;
+
+ public:
+  typedef typename Params::OutType OutType;
+  static const unsigned int OutW = Params::OutW;
+  static const unsigned int NumLevels = Params::NumLevels;
+  static const unsigned int Latency = Stages::Latency;
+
+  AdderTreePipelined() { reset(); }
+
+  void reset() { stages.reset(); }
+
+  void run(const InType in[N], bool valid, OutType& out, bool& out_valid) {
+    typename Params::TreeIn v[N];
+    Params::load(in, v);
+    typename Stages::Out res;
+    stages.run(v, valid, res, out_valid);
+    out = res;
+  }
+};
+
+// Exact product type of InType1 * InType2
+template <typename InType1, typename InType2>
+struct product_type {
+  typedef typename adder_tree_int<
+      Wrapped<InType1>::width + Wrapped<InType2>::width,
+      Wrapped<InType1>::is_signed || Wrapped<InType2>::is_signed>::type type;
+};
+
+/**
+ * \brief Vector reduction with an explicit AdderTree
+ * \ingroup nvhls_vector
+ *
+ * \tparam InType           Input Scalar Type
+ * \tparam OutType          Output Scalar Type
+ * \tparam VectorLength     Length of vector
+ * \tparam CarrySave        Use 3:2 compressors (default: false)
+ *
+ * \par Overview
+ * Same result as reduction, computed by AdderTree<InType, VectorLength,
+ * CarrySave> at full precision and then assigned to OutType. Use
+ * AdderTree<...>::OutType as OutType to keep every bit.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_vector.h>
+ *
+ *      ...
+ *      nv_scvector<NVUINT8, 64> v1;
+ *      NVUINT14 out;
+ *      ...
+ *      nvhls::reduction_tree<NVUINT8, NVUINT14, 64, false>(v1, out);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename InType, typename OutType, unsigned int VectorLength,
+          bool CarrySave>
+void reduction_tree(const nv_scvector<InType, VectorLength>& in, OutType& out) {
+  out = AdderTree<InType, VectorLength, CarrySave>::sum(in.data);
+}
+
+/**
+ * \brief Vector dot-product with an explicit AdderTree
+ * \ingroup nvhls_vector
+ *
+ * \tparam InType1          Input1 Scalar Type
+ * \tparam InType2          Input2 Scalar Type
+ * \tparam OutType          Output Scalar Type
+ * \tparam VectorLength     Length of vector
+ * \tparam CarrySave        Use 3:2 compressors (default: false)
+ *
+ * \par Overview
+ * Same result as dp: the exact products (product_type) are summed by an
+ * AdderTree and the full-precision sum is assigned to OutType. For a
+ * pipelined dot product, feed the products to an AdderTreePipelined.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_vector.h>
+ *
+ *      ...
+ *      nv_scvector<NVINT8, 64> v1, v2;
+ *      NVINT22 out;
+ *      ...
+ *      nvhls::dp_tree<NVINT8, NVINT8, NVINT22, 64, true>(v1, v2, out);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename InType1, typename InType2, typename OutType,
+          unsigned int VectorLength, bool CarrySave>
+void dp_tree(const nv_scvector<InType1, VectorLength>& in1,
+             const nv_scvector<InType2, VectorLength>& in2, OutType& out) {
+  typedef typename product_type<InType1, InType2>::type Prod;
+  Prod prods[VectorLength];
+#pragma hls_unroll yes
+  for (unsigned i = 0; i < VectorLength; i++) {
+    prods[i] = Prod(in1[i]) * Prod(in2[i]);
+  }
+  out = AdderTree<Prod, VectorLength, CarrySave>::sum(prods);
+}
+
 /**
  * \brief Function implementing vector multiply and add 
  * \ingroup nvhls_vector
@@ -459,10 +1054,15 @@ void dp(nv_scvector<InType1, VectorLength> in1,
 
 template <typename InType1, typename InType2, typename InType3, typename OutType,
           unsigned int VectorLength, bool Unroll>
-void vector_mac(nv_scvector<InType1, VectorLength> in1,
-                nv_scvector<InType2, VectorLength> in2,
-                nv_scvector<InType3, VectorLength> in3,
+void vector_mac(const nv_scvector<InType1, VectorLength>& in1,
+                const nv_scvector<InType2, VectorLength>& in2,
+                const nv_scvector<InType3, VectorLength>& in3,
                 nv_scvector<OutType, VectorLength>& out) {
+#ifndef __SYNTHESIS__
+  if (vector_sim<InType1, InType2, InType3, OutType>::template mac<VectorLength>(
+          in1.data, in2.data, in3.data, out.data))
+    return;
+#endif
 
   if (Unroll == true) {
 #pragma hls_unroll yes
@@ -474,6 +1074,56 @@ void vector_mac(nv_scvector<InType1, VectorLength> in1,
   }
 }
 
+/**
+ * \brief Function implementing in-place vector multiply and accumulate
+ * \ingroup nvhls_vector
+ *
+ * \tparam InType1          Input1 Scalar Type
+ * \tparam InType2          Input2 Scalar Type
+ * \tparam OutType          Accumulator Scalar Type
+ * \tparam VectorLength     Length of vector
+ * \tparam Unroll           Template parameter to control unrolling
+ *
+ * \par Overview
+ * Same as vector_mac with in3 and out being the same vector: acc[i] +=
+ * in1[i] * in2[i], without a temporary copy of the accumulator.
+
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_vector.h>
+ *
+ *      ...
+ *      nv_scvector<NVUINT2, 8> v1, v2;
+ *      nv_scvector<NVUINT8, 8> acc;
+ *      ...
+ *      nvhls::vector_mac_inplace<NVUINT2, NVUINT2, NVUINT8, 8, true>(v1, v2, acc);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+
+template <typename InType1, typename InType2, typename OutType,
+          unsigned int VectorLength, bool Unroll>
+void vector_mac_inplace(const nv_scvector<InType1, VectorLength>& in1,
+                        const nv_scvector<InType2, VectorLength>& in2,
+                        nv_scvector<OutType, VectorLength>& acc) {
+#ifndef __SYNTHESIS__
+  if (vector_sim<InType1, InType2, OutType, OutType>::template mac<VectorLength>(
+          in1.data, in2.data, acc.data, acc.data))
+    return;
+#endif
+
+  if (Unroll == true) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < VectorLength; i++)
+      acc[i] += in1[i] * in2[i];
+  } else {
+    for (unsigned i = 0; i < VectorLength; i++)
+      acc[i] += in1[i] * in2[i];
+  }
+}
+
 
 // Function implementing vector dot product followed by accumulate Template
 // parameters: InType1, InType2,InType3 OutType are the data types for
@@ -485,8 +1135,14 @@ void vector_mac(nv_scvector<InType1, VectorLength> in1,
 // InType1*InType2 operations should be defined by the user
 template <typename InType1, typename InType2, typename InType3,
           typename OutType, unsigned int VectorLength, bool UseReduceTree>
-void dpacc(nv_scvector<InType1, VectorLength> in1,
-           nv_scvector<InType2, VectorLength> in2, InType3 in3, OutType& out) {
+void dpacc(const nv_scvector<InType1, VectorLength>& in1,
+           const nv_scvector<InType2, VectorLength>& in2, const InType3& in3,
+           OutType& out) {
+#ifndef __SYNTHESIS__
+  if (vector_sim<InType1, InType2, OutType, OutType>::template dot<VectorLength>(
+          in1.data, in2.data, OutType(in3), out))
+    return;
+#endif
   OutType sum = in3;
   if (UseReduceTree == true) {
 #pragma hls_unroll yes
@@ -500,6 +1156,591 @@ void dpacc(nv_scvector<InType1, VectorLength> in1,
   }
   out = sum;
 }
+
+// Function implementing in-place dot product and accumulate: same as dpacc
+// with in3 and out being the same scalar, acc += dp(in1, in2).
+template <typename InType1, typename InType2, typename OutType,
+          unsigned int VectorLength, bool UseReduceTree>
+void dpacc_inplace(const nv_scvector<InType1, VectorLength>& in1,
+                   const nv_scvector<InType2, VectorLength>& in2, OutType& acc) {
+#ifndef __SYNTHESIS__
+  if (vector_sim<InType1, InType2, OutType, OutType>::template dot<VectorLength>(
+          in1.data, in2.data, acc, acc))
+    return;
+#endif
+  OutType sum = acc;
+  if (UseReduceTree == true) {
+#pragma hls_unroll yes
+#pragma cluster addtree
+#pragma cluster_type both
+    for (unsigned i = 0; i < VectorLength; i++)
+      sum += in1[i] * in2[i];
+  } else {
+    for (unsigned i = 0; i < VectorLength; i++)
+      sum += in1[i] * in2[i];
+  }
+  acc = sum;
+}
+
+/**
+ * \brief Function implementing saturating vector addition
+ * \ingroup nvhls_vector
+ *
+ * \tparam InType1          Input1 Scalar Type
+ * \tparam InType2          Input2 Scalar Type
+ * \tparam OutType          Output Scalar Type
+ * \tparam VectorLength     Length of vector
+ * \tparam Unroll           Template parameter to control unrolling
+ *
+ * \par Overview
+ * Same as vector_add, with each sum saturated to OutType (nvhls::sat_add)
+ * instead of wrapping.
+
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_vector.h>
+ *
+ *      ...
+ *      nv_scvector<NVINT8, 8> v1, v2, out;
+ *      ...
+ *      nvhls::vector_sat_add<NVINT8, NVINT8, NVINT8, 8, true>(v1, v2, out);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename InType1, typename InType2, typename OutType,
+          unsigned int VectorLength, bool Unroll>
+void vector_sat_add(const nv_scvector<InType1, VectorLength>& in1,
+                    const nv_scvector<InType2, VectorLength>& in2,
+                    nv_scvector<OutType, VectorLength>& out) {
+  if (Unroll == true) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < VectorLength; i++)
+      out[i] = sat_add<OutType>(in1[i], in2[i]);
+  } else {
+    for (unsigned i = 0; i < VectorLength; i++)
+      out[i] = sat_add<OutType>(in1[i], in2[i]);
+  }
+}
+
+/**
+ * \brief Function implementing saturating vector subtraction
+ * \ingroup nvhls_vector
+ *
+ * \tparam InType1          Input1 Scalar Type
+ * \tparam InType2          Input2 Scalar Type
+ * \tparam OutType          Output Scalar Type
+ * \tparam VectorLength     Length of vector
+ * \tparam Unroll           Template parameter to control unrolling
+ *
+ * \par Overview
+ * Same as vector_sub, with each difference saturated to OutType
+ * (nvhls::sat_sub) instead of wrapping.
+
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_vector.h>
+ *
+ *      ...
+ *      nv_scvector<NVUINT8, 8> v1, v2, out;
+ *      ...
+ *      nvhls::vector_sat_sub<NVUINT8, NVUINT8, NVUINT8, 8, true>(v1, v2, out);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename InType1, typename InType2, typename OutType,
+          unsigned int VectorLength, bool Unroll>
+void vector_sat_sub(const nv_scvector<InType1, VectorLength>& in1,
+                    const nv_scvector<InType2, VectorLength>& in2,
+                    nv_scvector<OutType, VectorLength>& out) {
+  if (Unroll == true) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < VectorLength; i++)
+      out[i] = sat_sub<OutType>(in1[i], in2[i]);
+  } else {
+    for (unsigned i = 0; i < VectorLength; i++)
+      out[i] = sat_sub<OutType>(in1[i], in2[i]);
+  }
+}
+
+/**
+ * \brief Function implementing vector multiplication with rounding and saturation
+ * \ingroup nvhls_vector
+ *
+ * \tparam InType1          Input1 Scalar Type
+ * \tparam InType2          Input2 Scalar Type
+ * \tparam OutType          Output Scalar Type
+ * \tparam VectorLength     Length of vector
+ * \tparam Unroll           Template parameter to control unrolling
+ * \tparam Shift            Fraction bits dropped from each product (default: 0)
+ * \tparam Mode             Rounding mode (default: nvhls::ROUND_TRN)
+ *
+ * \par Overview
+ * Same as vector_mul, with each exact product rounded and saturated to
+ * OutType (nvhls::sat_mul).
+
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_vector.h>
+ *
+ *      ...
+ *      nv_scvector<NVINT8, 8> v1, v2, out;    // 7 fraction bits
+ *      ...
+ *      nvhls::vector_sat_mul<NVINT8, NVINT8, NVINT8, 8, true, 7,
+ *                            nvhls::ROUND_RND>(v1, v2, out);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename InType1, typename InType2, typename OutType,
+          unsigned int VectorLength, bool Unroll, unsigned int Shift = 0,
+          round_mode Mode = ROUND_TRN>
+void vector_sat_mul(const nv_scvector<InType1, VectorLength>& in1,
+                    const nv_scvector<InType2, VectorLength>& in2,
+                    nv_scvector<OutType, VectorLength>& out) {
+  if (Unroll == true) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < VectorLength; i++)
+      out[i] = sat_mul<OutType, Shift, Mode>(in1[i], in2[i]);
+  } else {
+    for (unsigned i = 0; i < VectorLength; i++)
+      out[i] = sat_mul<OutType, Shift, Mode>(in1[i], in2[i]);
+  }
+}
+
+/**
+ * \brief Function implementing fused vector multiply and add with a single rounding
+ * \ingroup nvhls_vector
+ *
+ * \tparam InType1          Input1 Scalar Type
+ * \tparam InType2          Input2 Scalar Type
+ * \tparam InType3          Input3 Scalar Type, scaled as the output
+ * \tparam OutType          Output Scalar Type
+ * \tparam VectorLength     Length of vector
+ * \tparam Unroll           Template parameter to control unrolling
+ * \tparam Shift            Fraction bits of the products beyond those of in3 (default: 0)
+ * \tparam Mode             Rounding mode (default: nvhls::ROUND_TRN)
+ *
+ * \par Overview
+ * Same as vector_mac, with in1[i] * in2[i] + in3[i] computed exactly and
+ * then rounded and saturated to OutType once (nvhls::fused_mac). in3 and
+ * out can be the same vector.
+
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_vector.h>
+ *
+ *      ...
+ *      nv_scvector<NVINT8, 8> v1, v2;         // 7 fraction bits
+ *      nv_scvector<NVINT16, 8> acc;           // 7 fraction bits
+ *      ...
+ *      nvhls::vector_fused_mac<NVINT8, NVINT8, NVINT16, NVINT16, 8, true, 7,
+ *                              nvhls::ROUND_RND_CONV>(v1, v2, acc, acc);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename InType1, typename InType2, typename InType3, typename OutType,
+          unsigned int VectorLength, bool Unroll, unsigned int Shift = 0,
+          round_mode Mode = ROUND_TRN>
+void vector_fused_mac(const nv_scvector<InType1, VectorLength>& in1,
+                      const nv_scvector<InType2, VectorLength>& in2,
+                      const nv_scvector<InType3, VectorLength>& in3,
+                      nv_scvector<OutType, VectorLength>& out) {
+  if (Unroll == true) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < VectorLength; i++)
+      out[i] = fused_mac<OutType, Shift, Mode>(in1[i], in2[i], in3[i]);
+  } else {
+    for (unsigned i = 0; i < VectorLength; i++)
+      out[i] = fused_mac<OutType, Shift, Mode>(in1[i], in2[i], in3[i]);
+  }
+}
+
+/**
+ * \brief Function implementing dot product and accumulate with a single rounding
+ * \ingroup nvhls_vector
+ *
+ * \tparam InType1          Input1 Scalar Type
+ * \tparam InType2          Input2 Scalar Type
+ * \tparam InType3          Accumulator input Type, scaled as the output
+ * \tparam OutType          Output Scalar Type
+ * \tparam VectorLength     Length of vector
+ * \tparam Shift            Fraction bits of the products beyond those of in3 (default: 0)
+ * \tparam Mode             Rounding mode (default: nvhls::ROUND_TRN)
+ *
+ * \par Overview
+ * Same as dpacc, with the products and their sum kept exact and the result
+ * rounded and saturated to OutType once. OutType only needs the range of
+ * the result, not that of the exact sum.
+
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_vector.h>
+ *
+ *      ...
+ *      nv_scvector<NVINT8, 64> v1, v2;        // 7 fraction bits
+ *      NVINT16 acc;                           // 7 fraction bits
+ *      ...
+ *      nvhls::dpacc_fused<NVINT8, NVINT8, NVINT16, NVINT16, 64, 7,
+ *                         nvhls::ROUND_RND>(v1, v2, acc, acc);
+ *      ...
+ * \endcode
+ * \par
+ *
+ */
+template <typename InType1, typename InType2, typename InType3, typename OutType,
+          unsigned int VectorLength, unsigned int Shift = 0,
+          round_mode Mode = ROUND_TRN>
+void dpacc_fused(const nv_scvector<InType1, VectorLength>& in1,
+                 const nv_scvector<InType2, VectorLength>& in2,
+                 const InType3& in3, OutType& out) {
+  typedef typename product_type<InType1, InType2>::type Prod;
+  const unsigned int WS = Wrapped<Prod>::width + nbits<VectorLength>::val;
+  const unsigned int WC = Wrapped<InType3>::width + Shift;
+  typedef typename nvhls_t<(WS > WC ? WS : WC) + 1>::nvint_t Sum;
+  Sum sum = Sum(in3) << Shift;
+#pragma hls_unroll yes
+#pragma cluster addtree
+#pragma cluster_type both
+  for (unsigned i = 0; i < VectorLength; i++)
+    sum += Prod(in1[i]) * Prod(in2[i]);
+  out = round_sat<OutType, Shift, Mode>(sum);
+}
+
+/**
+ * \brief Bitmap-compressed vector
+ * \ingroup nvhls_vector
+ *
+ * \tparam Type             ScalarType
+ * \tparam VectorLength     Length of the dense vector
+ *
+ * \par Overview
+ * Bit i of mask is set when element i of the dense vector is nonzero, and
+ * values holds the nonzero elements in order, from values[0]; the rest of
+ * values is zero. compress() and expand() convert from and to the dense
+ * vector.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_vector.h>
+ *
+ *      ...
+ *      nv_scvector<NVINT8, 16> dense;
+ *      nvhls::SparseVector<NVINT8, 16> sparse;
+ *      sparse.compress(dense);
+ *      unsigned int nonzeros = sparse.nnz();
+ * \endcode
+ * \par
+ *
+ */
+template <typename Type, unsigned int VectorLength>
+class SparseVector : public nvhls_message {
+ public:
+  typedef NVUINTW(VectorLength) Mask;
+  static const unsigned int width = VectorLength + nv_scvector<Type, VectorLength>::width;
+
+  Mask mask;
+  nv_scvector<Type, VectorLength> values;
+
+  SparseVector() : mask(0) {
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < VectorLength; i++)
+      values[i] = 0;
+  }
+
+  void compress(const nv_scvector<Type, VectorLength>& dense) {
+    mask = 0;
+    unsigned n = 0;
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < VectorLength; i++)
+      values[i] = 0;
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < VectorLength; i++) {
+      if (dense[i] != 0) {
+        mask |= Mask(1) << i;
+        values[n++] = dense[i];
+      }
+    }
+  }
+
+  void expand(nv_scvector<Type, VectorLength>& dense) const {
+    unsigned n = 0;
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < VectorLength; i++) {
+      dense[i] = 0;
+      if (mask[i] == 1) {
+        dense[i] = values[n++];
+      }
+    }
+  }
+
+  unsigned int nnz() const { return count_ones<VectorLength>(mask); }
+
+  // Position in values of element i, which must be nonzero
+  unsigned int rank(unsigned int i) const {
+    return count_ones<VectorLength>(mask & ((Mask(1) << i) - 1));
+  }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m& mask;
+    m& values;
+  }
+};
+
+/**
+ * \brief Zero-skipping dot product and accumulate, and its cycle-accurate C++ model
+ * \ingroup nvhls_vector
+ *
+ * \tparam InType1          Input1 Scalar Type
+ * \tparam InType2          Input2 Scalar Type
+ * \tparam OutType          Output Scalar Type
+ * \tparam VectorLength     Length of the dense vectors
+ * \tparam K                Products per cycle (default: 1)
+ *
+ * \par Overview
+ * Computes the dpacc of two SparseVector operands with K multipliers
+ * instead of VectorLength. start() takes the operands and the accumulator
+ * input; then each call of run(), once per cycle, picks the next K positions
+ * where both operands are nonzero with a PriEnc over the AND of their masks,
+ * looks up the two values by the rank of the position in each mask, and
+ * adds their products. run() returns true, with the result in out, in the
+ * cycle that takes the last pair, or in the first cycle when there is none:
+ * a dot product takes max(1, ceil(pairs / K)) cycles.
+ *
+ * In C++ simulation the model counts its dot products, busy cycles and
+ * products. DenseProductsPerCycle() is the effective throughput, the
+ * products per cycle a dense dp would need to keep up, next to the K
+ * multipliers used.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_vector.h>
+ *
+ *      ...
+ *      nvhls::SparseVector<NVINT8, 64> act, wgt;
+ *      nvhls::SparseDotProduct<NVINT8, NVINT8, NVINT22, 64, 4> sdp;
+ *      NVINT22 acc, out;
+ *      ...
+ *      sdp.start(act, wgt, acc);
+ *      while (!sdp.run(out)) {
+ *        wait();
+ *      }
+ * \endcode
+ * \par
+ *
+ */
+template <typename InType1, typename InType2, typename OutType,
+          unsigned int VectorLength, unsigned int K = 1>
+class SparseDotProduct {
+ public:
+  typedef SparseVector<InType1, VectorLength> Sparse1;
+  typedef SparseVector<InType2, VectorLength> Sparse2;
+  typedef NVUINTW(VectorLength) Mask;
+  typedef NVINTW(index_width<VectorLength>::val + 1) PriIdx;
+  static_assert(K >= 1 && K <= VectorLength, "K must be between 1 and VectorLength");
+
+  SparseDotProduct() { reset(); }
+
+  void reset() {
+    pending = 0;
+    busy_ = false;
+    sum = 0;
+#ifndef __SYNTHESIS__
+    operations = cycles = products = 0;
+#endif
+  }
+
+  bool busy() const { return busy_; }
+
+  // Starts acc + in1 . in2; the previous dot product must be done
+  void start(const Sparse1& in1, const Sparse2& in2, const OutType& acc) {
+    NVHLS_ASSERT_MSG(!busy_, "SparseDotProduct started while busy");
+    a = in1;
+    b = in2;
+    pending = in1.mask & in2.mask;
+    sum = acc;
+    busy_ = true;
+#ifndef __SYNTHESIS__
+    operations++;
+#endif
+  }
+
+  // One cycle of K products; true when out holds the result
+  bool run(OutType& out) {
+    if (!busy_) return false;
+#pragma hls_unroll yes
+    for (unsigned k = 0; k < K; k++) {
+      if (pending != 0) {
+        unsigned int pos = PriEnc<Mask, bool, PriIdx, VectorLength>::val(pending, 1).to_int();
+        pending &= ~(Mask(1) << pos);
+        sum += a.values[a.rank(pos)] * b.values[b.rank(pos)];
+#ifndef __SYNTHESIS__
+        products++;
+#endif
+      }
+    }
+#ifndef __SYNTHESIS__
+    cycles++;
+#endif
+    if (pending == 0) {
+      out = sum;
+      busy_ = false;
+      return true;
+    }
+    return false;
+  }
+
+#ifndef __SYNTHESIS__
+  uint64 Operations() const { return operations; }
+  uint64 Cycles() const { return cycles; }
+  uint64 Products() const { return products; }
+  double DenseProductsPerCycle() const {
+    return cycles == 0 ? 0.0 : double(operations) * VectorLength / cycles;
+  }
+#endif
+
+ private:
+  Sparse1 a;
+  Sparse2 b;
+  Mask pending;
+  OutType sum;
+  bool busy_;
+#ifndef __SYNTHESIS__
+  uint64 operations;
+  uint64 cycles;
+  uint64 products;
+#endif
+};
+
+/**
+ * \brief Zero-skipping vector multiply and add, and its cycle-accurate C++ model
+ * \ingroup nvhls_vector
+ *
+ * \tparam InType1          Input1 Scalar Type, sparse
+ * \tparam InType2          Input2 Scalar Type
+ * \tparam InType3          Input3 Scalar Type
+ * \tparam OutType          Output Scalar Type
+ * \tparam VectorLength     Length of vector
+ * \tparam K                Products per cycle (default: 1)
+ *
+ * \par Overview
+ * The vector_mac of a SparseVector in1 with dense in2 and in3, with K
+ * multipliers: out[i] = in3[i] where in1[i] is zero, and the nonzero values
+ * of in1 are taken in order, K per cycle, each at the position of the next
+ * set bit of its mask. As for SparseDotProduct, run() is called once per
+ * cycle after start() and returns true with the result, after max(1,
+ * ceil(nnz / K)) cycles, and the C++ model counts its throughput.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <nvhls_vector.h>
+ *
+ *      ...
+ *      nvhls::SparseVector<NVINT8, 16> act;
+ *      nv_scvector<NVINT8, 16> scale;
+ *      nv_scvector<NVINT16, 16> acc;
+ *      nvhls::SparseVectorMac<NVINT8, NVINT8, NVINT16, NVINT16, 16, 2> smac;
+ *      ...
+ *      smac.start(act, scale, acc);
+ *      while (!smac.run(acc)) {
+ *        wait();
+ *      }
+ * \endcode
+ * \par
+ *
+ */
+template <typename InType1, typename InType2, typename InType3, typename OutType,
+          unsigned int VectorLength, unsigned int K = 1>
+class SparseVectorMac {
+ public:
+  typedef SparseVector<InType1, VectorLength> Sparse1;
+  typedef NVUINTW(VectorLength) Mask;
+  typedef NVINTW(index_width<VectorLength>::val + 1) PriIdx;
+  static_assert(K >= 1 && K <= VectorLength, "K must be between 1 and VectorLength");
+
+  SparseVectorMac() { reset(); }
+
+  void reset() {
+    pending = 0;
+    next = 0;
+    busy_ = false;
+#ifndef __SYNTHESIS__
+    operations = cycles = products = 0;
+#endif
+  }
+
+  bool busy() const { return busy_; }
+
+  void start(const Sparse1& in1, const nv_scvector<InType2, VectorLength>& in2,
+             const nv_scvector<InType3, VectorLength>& in3) {
+    NVHLS_ASSERT_MSG(!busy_, "SparseVectorMac started while busy");
+    a = in1;
+    b = in2;
+#pragma hls_unroll yes
+    for (unsigned i = 0; i < VectorLength; i++)
+      acc[i] = in3[i];
+    pending = in1.mask;
+    next = 0;
+    busy_ = true;
+#ifndef __SYNTHESIS__
+    operations++;
+#endif
+  }
+
+  bool run(nv_scvector<OutType, VectorLength>& out) {
+    if (!busy_) return false;
+#pragma hls_unroll yes
+    for (unsigned k = 0; k < K; k++) {
+      if (pending != 0) {
+        unsigned int pos = PriEnc<Mask, bool, PriIdx, VectorLength>::val(pending, 1).to_int();
+        pending &= ~(Mask(1) << pos);
+        acc[pos] = a.values[next] * b[pos] + acc[pos];
+        next++;
+#ifndef __SYNTHESIS__
+        products++;
+#endif
+      }
+    }
+#ifndef __SYNTHESIS__
+    cycles++;
+#endif
+    if (pending == 0) {
+      out = acc;
+      busy_ = false;
+      return true;
+    }
+    return false;
+  }
+
+#ifndef __SYNTHESIS__
+  uint64 Operations() const { return operations; }
+  uint64 Cycles() const { return cycles; }
+  uint64 Products() const { return products; }
+  double DenseProductsPerCycle() const {
+    return cycles == 0 ? 0.0 : double(operations) * VectorLength / cycles;
+  }
+#endif
+
+ private:
+  Sparse1 a;
+  nv_scvector<InType2, VectorLength> b;
+  nv_scvector<OutType, VectorLength> acc;
+  Mask pending;
+  NVUINTW(index_width<VectorLength + 1>::val) next;
+  bool busy_;
+#ifndef __SYNTHESIS__
+  uint64 operations;
+  uint64 cycles;
+  uint64 products;
+#endif
+};
 };
 
 #endif
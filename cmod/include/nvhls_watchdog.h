@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVHLS_WATCHDOG_H
+#define NVHLS_WATCHDOG_H
+
+#ifndef __SYNTHESIS__
+
+#include <systemc.h>
+#include <hls_globals.h>
+#include <nvhls_channel_graph.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace match {
+
+/**
+ * \brief Deadlock watchdog for the Connections channels of a simulation.
+ * \ingroup nvhls_module
+ *
+ * \par Overview
+ * Watchdog is a simulation-only module that samples the vld/rdy signals of
+ * every signal-level Connections channel on each clock edge. The channels are
+ * found at start of simulation with match::FindChannels(), as the bool signal
+ * pairs "<chan>_vld" and "<chan>_rdy" of the design, and the ports bound to
+ * them give the producer and consumer module of each channel.
+ * - A channel is blocked while vld is held without rdy, the producer waiting
+ *   for the consumer, and starved while rdy is held without vld, the consumer
+ *   waiting for the producer.
+ * - When a channel has been blocked for threshold cycles, the watchdog reports
+ *   the wait-for graph: every channel blocked or starved for at least
+ *   threshold cycles, as an edge from the waiting module to the module it
+ *   waits for, and the cycles of that graph, which are the deadlocks. Then it
+ *   stops the simulation, unless SetStopOnFire(false) was called.
+ * - The threshold is the constructor argument, or NVHLS_WATCHDOG=<cycles> from
+ *   the environment, which takes precedence (default 10000). With
+ *   NVHLS_WATCHDOG_DOT=<file>, the graph is also written in Graphviz format.
+ * - TLM channels (SIM_MODE=2) have no vld/rdy signals and are not watched.
+ *
+ * \par A Simple Example
+ * \code
+ *      SC_MODULE(testbench) {
+ *        sc_clock clk;
+ *        match::Watchdog watchdog;
+ *        ...
+ *        SC_CTOR(testbench) : clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true), watchdog("watchdog", 1000) {
+ *          watchdog.clk(clk);
+ *          ...
+ *        }
+ *      };
+ * \endcode
+ * \par
+ *
+ */
+class Watchdog : public sc_module {
+  SC_HAS_PROCESS(Watchdog);
+
+ public:
+  sc_in_clk clk;
+
+  explicit Watchdog(sc_module_name name, unsigned int threshold = 0)
+      : sc_module(name), clk("clk"), threshold_(threshold ? threshold : 10000),
+        stop_(true), fired_(false), cycles_(0) {
+    const char* env = std::getenv("NVHLS_WATCHDOG");
+    if (env != NULL && std::atoi(env) > 0) threshold_ = std::atoi(env);
+    const char* dot = std::getenv("NVHLS_WATCHDOG_DOT");
+    if (dot != NULL) dot_file_ = dot;
+
+    SC_METHOD(Tick);
+    sensitive << clk.pos();
+    dont_initialize();
+  }
+
+  void SetStopOnFire(bool stop) { stop_ = stop; }
+  unsigned int Threshold() const { return threshold_; }
+  unsigned int NumChannels() const { return chans_.size(); }
+  bool Fired() const { return fired_; }
+  // The report of the first firing
+  const std::string& Report() const { return report_; }
+
+  void WriteDot(std::ostream& os) const {
+    os << "digraph waitfor {" << std::endl;
+    for (unsigned int i = 0; i < chans_.size(); i++) {
+      const Channel& c = chans_[i];
+      if (c.blocked >= threshold_) {
+        os << "  \"" << c.producer << "\" -> \"" << c.consumer << "\" [label=\"" << c.name
+           << " blocked " << c.blocked << "\"];" << std::endl;
+      } else if (c.starved >= threshold_) {
+        os << "  \"" << c.consumer << "\" -> \"" << c.producer << "\" [label=\"" << c.name
+           << " starved " << c.starved << "\", style=dashed];" << std::endl;
+      }
+    }
+    os << "}" << std::endl;
+  }
+
+ protected:
+  struct Channel : public ChannelEnds {
+    unsigned int blocked;
+    unsigned int starved;
+  };
+
+  unsigned int threshold_;
+  bool stop_;
+  bool fired_;
+  uint64 cycles_;
+  std::string dot_file_;
+  std::string report_;
+  std::vector<Channel> chans_;
+
+  void start_of_simulation() {
+    std::vector<ChannelEnds> chans;
+    FindChannels(chans);
+    for (unsigned int i = 0; i < chans.size(); i++) {
+      Channel c;
+      static_cast<ChannelEnds&>(c) = chans[i];
+      c.blocked = c.starved = 0;
+      chans_.push_back(c);
+    }
+    if (chans_.empty()) {
+      std::cerr << "Warning: " << name() << " found no signal-level channels to watch" << std::endl;
+    }
+  }
+
+  void Tick() {
+    cycles_++;
+    bool fire = false;
+    for (unsigned int i = 0; i < chans_.size(); i++) {
+      Channel& c = chans_[i];
+      bool vld = c.vld->read();
+      bool rdy = c.rdy->read();
+      c.blocked = (vld && !rdy) ? c.blocked + 1 : 0;
+      c.starved = (!vld && rdy) ? c.starved + 1 : 0;
+      fire |= (c.blocked == threshold_);
+    }
+    if (fire && !fired_) Fire();
+  }
+
+  bool FindCycle(const std::map<std::string, std::set<std::string> >& edges, const std::string& node,
+                 std::vector<std::string>& path, std::set<std::string>& done) const {
+    for (unsigned int i = 0; i < path.size(); i++) {
+      if (path[i] == node) {
+        path.erase(path.begin(), path.begin() + i);
+        path.push_back(node);
+        return true;
+      }
+    }
+    if (done.count(node)) return false;
+    path.push_back(node);
+    std::map<std::string, std::set<std::string> >::const_iterator it = edges.find(node);
+    if (it != edges.end()) {
+      for (std::set<std::string>::const_iterator n = it->second.begin(); n != it->second.end(); ++n) {
+        if (FindCycle(edges, *n, path, done)) return true;
+      }
+    }
+    path.pop_back();
+    done.insert(node);
+    return false;
+  }
+
+  void Fire() {
+    fired_ = true;
+    std::map<std::string, std::set<std::string> > edges;
+    std::ostringstream os;
+    os << name() << ": no progress for " << threshold_ << " cycles at " << sc_time_stamp() << " (cycle "
+       << cycles_ << ")" << std::endl;
+    os << "  wait-for graph (waiting module -> module it waits for):" << std::endl;
+    for (unsigned int i = 0; i < chans_.size(); i++) {
+      const Channel& c = chans_[i];
+      if (c.blocked >= threshold_) {
+        os << "    " << c.producer << " -> " << c.consumer << "  (" << c.name << " blocked "
+           << c.blocked << " cycles)" << std::endl;
+        edges[c.producer].insert(c.consumer);
+      } else if (c.starved >= threshold_) {
+        os << "    " << c.consumer << " -> " << c.producer << "  (" << c.name << " starved "
+           << c.starved << " cycles)" << std::endl;
+        edges[c.consumer].insert(c.producer);
+      }
+    }
+    std::set<std::string> done;
+    for (std::map<std::string, std::set<std::string> >::const_iterator it = edges.begin(); it != edges.end(); ++it) {
+      std::vector<std::string> path;
+      if (!done.count(it->first) && FindCycle(edges, it->first, path, done)) {
+        os << "  deadlock cycle:";
+        for (unsigned int i = 0; i < path.size(); i++) os << (i ? " -> " : " ") << path[i];
+        os << std::endl;
+        // Report each module in at most one cycle
+        done.insert(path.begin(), path.end());
+      }
+    }
+    report_ = os.str();
+    std::cerr << report_;
+    if (!dot_file_.empty()) {
+      std::ofstream dot(dot_file_.c_str());
+      WriteDot(dot);
+    }
+    if (stop_) sc_stop();
+  }
+};
+
+}  // namespace match
+
+#endif  // __SYNTHESIS__
+
+#endif  // NVHLS_WATCHDOG_H
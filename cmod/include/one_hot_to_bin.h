@@ -47,6 +47,22 @@ template <unsigned OneHotLen, unsigned BinLen>
 void one_hot_to_bin(const NVUINTW(OneHotLen) & one_hot_in,
                     NVUINTW(BinLen) & bin_out) {
 
+#if !defined(__SYNTHESIS__) && defined(__GNUC__)
+  // C++ simulation only: OR of the indices of the set bits, one
+  // count-trailing-zeros per set bit, as the mask-and-reduce logic below
+  // computes for any input
+  if (OneHotLen <= 64) {
+    unsigned long long v = one_hot_in.to_uint64();
+    unsigned long long idx = 0;
+    while (v != 0) {
+      idx |= __builtin_ctzll(v);
+      v &= v - 1;
+    }
+    bin_out = idx;
+    return;
+  }
+#endif
+
 #pragma hls_unroll yes
   for (unsigned bin = 0; bin < BinLen; bin++) {
 
@@ -72,4 +88,70 @@ void one_hot_to_bin(const NVUINTW(OneHotLen) & one_hot_in,
   }
 }
 
+/**
+ * \brief One hot to binary conversion of several lanes at once
+ * \ingroup one_hot_to_bin
+ *
+ * \tparam Lanes            Number of one-hot inputs
+ * \tparam OneHotLen        Width of one-hot representation
+ * \tparam BinLen           Width of binary output
+ *
+ * \param[in]   one_hot_in     One hot inputs
+ * \param[out]  bin_out        Binary outputs
+ *
+ * \par Overview
+ * Converts each lane as one_hot_to_bin() does. In hardware the index masks are
+ * built once and shared by all lanes, and each output bit is the OR-reduction
+ * tree of its masked input, so the lanes encode in parallel with log depth. In
+ * C++ simulation each lane takes the count-trailing-zeros path.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <one_hot_to_bin.h>
+ *
+ *      ...
+ *      NVUINT8 grants[4];
+ *      NVUINT3 sources[4];
+ *      ...
+ *      one_hot_to_bin_lanes<4, 8, 3>(grants, sources);
+ *      ...
+ *
+ * \endcode
+ * \par
+ *
+ */
+template <unsigned Lanes, unsigned OneHotLen, unsigned BinLen>
+void one_hot_to_bin_lanes(const NVUINTW(OneHotLen) one_hot_in[Lanes],
+                          NVUINTW(BinLen) bin_out[Lanes]) {
+#if !defined(__SYNTHESIS__) && defined(__GNUC__)
+  if (OneHotLen <= 64) {
+    for (unsigned lane = 0; lane < Lanes; lane++) {
+      one_hot_to_bin<OneHotLen, BinLen>(one_hot_in[lane], bin_out[lane]);
+    }
+    return;
+  }
+#endif
+
+  // Bit b of mask[bin] is bit bin of the index b, the same for every lane
+  NVUINTW(OneHotLen) mask[BinLen];
+#pragma hls_unroll yes
+  for (unsigned bin = 0; bin < BinLen; bin++) {
+#pragma hls_unroll yes
+    for (unsigned bit = 0; bit < OneHotLen; bit++) {
+      mask[bin][bit] = (bit >> bin) & 1;
+    }
+  }
+
+#pragma hls_unroll yes
+  for (unsigned lane = 0; lane < Lanes; lane++) {
+    NVUINTW(BinLen) bin_tmp = 0;
+#pragma hls_unroll yes
+    for (unsigned bin = 0; bin < BinLen; bin++) {
+      NVUINTW(OneHotLen) masked = one_hot_in[lane] & mask[bin];
+      bin_tmp[bin] = masked.or_reduce();
+    }
+    bin_out[lane] = bin_tmp;
+  }
+}
+
 #endif
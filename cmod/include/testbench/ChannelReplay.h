@@ -0,0 +1,500 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __CHANNEL_REPLAY_H__
+#define __CHANNEL_REPLAY_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_assert.h>
+#include <TypeToBits.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace nvhls {
+
+/**
+ * \brief Binary trace of the transfers on one Connections channel
+ * \ingroup ChannelReplay
+ *
+ * \tparam Message  The message type
+ *
+ * \par Overview
+ * A channel trace is a 16-byte header ("NVCHANTR", a u32 version and the u32
+ * message width in bits) followed by one record per transfer. A record is the
+ * cycle delta from the previous transfer as an LEB128 varint, then the
+ * message bits in the layout of TypeToBits(), least significant byte first.
+ * Cycles count from reset, in the convention of Source and Sink: a message
+ * pushed in cycle N of a thread is recorded as cycle N.
+ */
+template <typename Message>
+struct ChannelTrace {
+  static const unsigned int W = Wrapped<Message>::width;
+  static const unsigned int kBytes = (W + 7) / 8;
+  static const unsigned int kHeaderBytes = 16;
+  static const unsigned int kVersion = 1;
+  typedef sc_lv<W> MsgBits;
+
+  static const char* Magic() { return "NVCHANTR"; }
+
+  static void PackHeader(unsigned char* p) {
+    memcpy(p, Magic(), 8);
+    PutLE(p + 8, kVersion);
+    PutLE(p + 12, W);
+  }
+
+  // True if the header matches this message type
+  static bool CheckHeader(const unsigned char* p) {
+    return memcmp(p, Magic(), 8) == 0 && GetLE(p + 8) == kVersion && GetLE(p + 12) == W;
+  }
+
+  static void PackBits(const MsgBits& bits, unsigned char* p) {
+    for (unsigned int i = 0; i < kBytes; i++) {
+      unsigned int lo = 8 * i;
+      unsigned int hi = (lo + 7 < W) ? lo + 7 : W - 1;
+      p[i] = static_cast<unsigned char>(bits.range(hi, lo).to_uint());
+    }
+  }
+
+  static MsgBits UnpackBits(const unsigned char* p) {
+    MsgBits bits;
+    for (unsigned int i = 0; i < kBytes; i++) {
+      unsigned int lo = 8 * i;
+      unsigned int hi = (lo + 7 < W) ? lo + 7 : W - 1;
+      bits.range(hi, lo) = static_cast<unsigned int>(p[i]);
+    }
+    return bits;
+  }
+
+ protected:
+  static void PutLE(unsigned char* p, unsigned int v) {
+    for (unsigned int i = 0; i < 4; i++, v >>= 8) p[i] = static_cast<unsigned char>(v);
+  }
+  static unsigned int GetLE(const unsigned char* p) {
+    unsigned int v = 0;
+    for (int i = 3; i >= 0; i--) v = (v << 8) | p[i];
+    return v;
+  }
+};
+
+/**
+ * \brief Writes a channel trace
+ * \ingroup ChannelReplay
+ *
+ * \tparam Message  The message type
+ */
+template <typename Message>
+class ChannelTraceWriter {
+ public:
+  typedef ChannelTrace<Message> Trace;
+
+  explicit ChannelTraceWriter(const std::string& filename)
+      : file(fopen(filename.c_str(), "wb")), last_cycle(0), buf(10 + Trace::kBytes) {
+    NVHLS_ASSERT_MSG(file != NULL, "Cannot open channel trace for writing");
+    if (file != NULL) {
+      unsigned char header[Trace::kHeaderBytes];
+      Trace::PackHeader(header);
+      fwrite(header, 1, sizeof(header), file);
+    }
+  }
+
+  ~ChannelTraceWriter() {
+    if (file != NULL) fclose(file);
+  }
+
+  // Cycles must not decrease from one call to the next
+  void write(uint64 cycle, const typename Trace::MsgBits& bits) {
+    NVHLS_ASSERT_MSG(cycle >= last_cycle, "Channel trace cycles must not decrease");
+    uint64 delta = cycle - last_cycle;
+    last_cycle = cycle;
+    unsigned int n = 0;
+    do {
+      unsigned char byte = delta & 0x7f;
+      delta >>= 7;
+      buf[n++] = byte | (delta != 0 ? 0x80 : 0);
+    } while (delta != 0);
+    Trace::PackBits(bits, &buf[n]);
+    fwrite(&buf[0], 1, n + Trace::kBytes, file);
+  }
+
+  void flush() { fflush(file); }
+
+ private:
+  FILE* file;
+  uint64 last_cycle;
+  std::vector<unsigned char> buf;
+
+  ChannelTraceWriter(const ChannelTraceWriter&);
+  ChannelTraceWriter& operator=(const ChannelTraceWriter&);
+};
+
+/**
+ * \brief Reads a channel trace one transfer at a time
+ * \ingroup ChannelReplay
+ *
+ * \tparam Message  The message type
+ *
+ * The file is opened on the first call to read(), and again after rewind().
+ * The header must match the width of Message.
+ */
+template <typename Message>
+class ChannelTraceReader {
+ public:
+  typedef ChannelTrace<Message> Trace;
+
+  explicit ChannelTraceReader(const std::string& filename)
+      : fileName(filename), file(NULL), done(false), cycle(0), buf(Trace::kBytes) {}
+
+  ~ChannelTraceReader() {
+    if (file != NULL) fclose(file);
+  }
+
+  // Starts again from the first transfer
+  void rewind() {
+    if (file != NULL) fclose(file);
+    file = NULL;
+    done = false;
+    cycle = 0;
+  }
+
+  bool read(uint64& rec_cycle, Message& msg) {
+    if (file == NULL) {
+      if (done) return false;
+      file = fopen(fileName.c_str(), "rb");
+      unsigned char header[Trace::kHeaderBytes];
+      if (file == NULL || fread(header, 1, sizeof(header), file) != sizeof(header)) {
+        done = true;
+        return false;
+      }
+      NVHLS_ASSERT_MSG(Trace::CheckHeader(header), "Channel trace header does not match the message type");
+    }
+    if (done) return false;
+    uint64 delta = 0;
+    unsigned int shift = 0;
+    int c;
+    do {
+      c = fgetc(file);
+      if (c == EOF) {
+        done = true;
+        return false;
+      }
+      delta |= static_cast<uint64>(c & 0x7f) << shift;
+      shift += 7;
+    } while (c & 0x80);
+    if (fread(&buf[0], 1, buf.size(), file) != buf.size()) {
+      done = true;
+      return false;
+    }
+    cycle += delta;
+    rec_cycle = cycle;
+    msg = BitsToType<Message>(Trace::UnpackBits(&buf[0]));
+    return true;
+  }
+
+ private:
+  std::string fileName;
+  FILE* file;
+  bool done;
+  uint64 cycle;
+  std::vector<unsigned char> buf;
+
+  ChannelTraceReader(const ChannelTraceReader&);
+  ChannelTraceReader& operator=(const ChannelTraceReader&);
+};
+
+/**
+ * \brief Records the transfers on a Connections channel into a channel trace
+ * \ingroup ChannelReplay
+ *
+ * \tparam Message             The message type
+ * \tparam port_marshall_type  The Connections port type
+ *
+ * \par Overview
+ * ChannelRecorder is a combinational pass-through: valid, ready and data are
+ * wired straight from enq to deq, so inserting it into a channel changes no
+ * timing. On each rising clock edge it samples the wires, and writes every
+ * transfer with its cycle since reset. Together with ReplaySource and
+ * ReplaySink, a block recorded inside a full system can then be simulated on
+ * its own: record each of its channels once, and replay them around the
+ * block as often as needed.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <testbench/ChannelReplay.h>
+ *
+ *      // In the full system
+ *      nvhls::ChannelRecorder<Req_t> rec("rec", "arb_in0.trace");
+ *      rec.clk(clk);
+ *      rec.rst(rst);
+ *      rec.enq(to_rec);
+ *      rec.deq(to_arbiter);
+ *
+ *      // Around the isolated block
+ *      nvhls::ReplaySource<Req_t> src("src", "arb_in0.trace");
+ *      src.out(to_arbiter);
+ *      ...
+ *      // once src.Done()
+ *      cout << src.late << " messages accepted later than recorded" << endl;
+ * \endcode
+ * \par
+ *
+ */
+template <typename Message, connections_port_t port_marshall_type = AUTO_PORT>
+class ChannelRecorder : public sc_module {
+  SC_HAS_PROCESS(ChannelRecorder);
+
+ public:
+  typedef ChannelTrace<Message> Trace;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<Message, port_marshall_type> enq;
+  Connections::Out<Message, port_marshall_type> deq;
+
+  // Transfers recorded since reset
+  uint64 recorded;
+
+  ChannelRecorder(sc_module_name name, const std::string& filename)
+      : sc_module(name), clk("clk"), rst("rst"), enq("enq"), deq("deq"), recorded(0), writer(filename),
+        cycle(0), running(false) {
+#ifdef CONNECTIONS_SIM_ONLY
+    enq.disable_spawn();
+    deq.disable_spawn();
+#endif
+
+    SC_METHOD(EnqRdy);
+    sensitive << deq.rdy;
+
+    SC_METHOD(DeqVld);
+    sensitive << enq.vld;
+
+    SC_METHOD(DeqMsg);
+    sensitive << enq.dat;
+
+    SC_METHOD(Sample);
+    sensitive << clk.pos();
+    dont_initialize();
+  }
+
+  // Pushes the transfers recorded so far to the file
+  void flush() { writer.flush(); }
+
+ protected:
+  ChannelTraceWriter<Message> writer;
+  uint64 cycle;
+  bool running;
+
+  void EnqRdy() { enq.rdy.write(deq.rdy.read()); }
+  void DeqVld() { deq.vld.write(enq.vld.read()); }
+  void DeqMsg() { deq.dat.write(enq.dat.read()); }
+
+  static typename Trace::MsgBits ToBits(const Message& m) { return TypeToBits<Message>(m); }
+  template <int N>
+  static typename Trace::MsgBits ToBits(const sc_lv<N>& bits) { return bits; }
+
+  // A transfer seen at the edge that ends cycle N was offered in cycle N
+  void Sample() {
+    if (!rst.read()) {
+      cycle = 0;
+      recorded = 0;
+      running = false;
+      return;
+    }
+    if (!running) {
+      running = true;
+      return;
+    }
+    if (enq.vld.read() && deq.rdy.read()) {
+      writer.write(cycle, ToBits(enq.dat.read()));
+      recorded++;
+    }
+    cycle++;
+  }
+};
+
+// Because of ports not existing in TLM_PORT, we remap to DIRECT_PORT here,
+// as axi::reg_slice::Wire does.
+template <typename Message>
+class ChannelRecorder<Message, TLM_PORT> : public ChannelRecorder<Message, DIRECT_PORT> {
+ public:
+  ChannelRecorder(sc_module_name name, const std::string& filename)
+      : ChannelRecorder<Message, DIRECT_PORT>(name, filename) {}
+};
+
+/**
+ * \brief Re-drives a recorded channel into the block under test
+ * \ingroup ChannelReplay
+ *
+ * \tparam Message  The message type
+ *
+ * \par Overview
+ * Offers each message of a channel trace from its recorded cycle until the
+ * block accepts it. If the block accepts every message in its recorded
+ * cycle, its inputs are exactly those of the recording. Messages accepted
+ * later are counted in late, and the largest slip is kept in max_slip. The
+ * trace is read again from the start at every reset.
+ */
+template <typename Message>
+class ReplaySource : public sc_module {
+  SC_HAS_PROCESS(ReplaySource);
+
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::Out<Message> out;
+
+  // Statistics since reset
+  uint64 sent;
+  uint64 late;
+  uint64 max_slip;
+
+  ReplaySource(sc_module_name name, const std::string& filename)
+      : sc_module(name), clk("clk"), rst("rst"), out("out"), sent(0), late(0), max_slip(0), reader(filename),
+        pending(false), exhausted(false) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  // True once every recorded message has been accepted
+  bool Done() const { return exhausted && !pending; }
+
+ protected:
+  ChannelTraceReader<Message> reader;
+  bool pending;
+  bool exhausted;
+  uint64 rec_cycle;
+  Message msg;
+  uint64 cycle;
+
+  void run() {
+    out.Reset();
+    reader.rewind();
+    sent = late = max_slip = cycle = 0;
+    pending = exhausted = false;
+    wait();
+    while (1) {
+      if (!pending && !exhausted) {
+        pending = reader.read(rec_cycle, msg);
+        exhausted = !pending;
+      }
+      if (pending && cycle >= rec_cycle && out.PushNB(msg)) {
+        uint64 slip = cycle - rec_cycle;
+        if (slip != 0) {
+          late++;
+          if (slip > max_slip) max_slip = slip;
+        }
+        sent++;
+        pending = false;
+      }
+      wait();
+      cycle++;
+    }
+  }
+};
+
+/**
+ * \brief Drains a recorded channel out of the block under test
+ * \ingroup ChannelReplay
+ *
+ * \tparam Message  The message type
+ *
+ * \par Overview
+ * Holds ready low until the recorded cycle of the next transfer and then
+ * pops, which reproduces the backpressure the block saw in the recording.
+ * Each message is checked against the trace: mismatches counts messages
+ * that differ, extra counts messages beyond the end of the trace, and late
+ * and max_slip count transfers after their recorded cycle. The trace is read
+ * again from the start at every reset.
+ */
+template <typename Message>
+class ReplaySink : public sc_module {
+  SC_HAS_PROCESS(ReplaySink);
+
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<Message> in;
+
+  // Statistics since reset
+  uint64 received;
+  uint64 mismatches;
+  uint64 extra;
+  uint64 late;
+  uint64 max_slip;
+
+  ReplaySink(sc_module_name name, const std::string& filename)
+      : sc_module(name), clk("clk"), rst("rst"), in("in"), received(0), mismatches(0), extra(0), late(0),
+        max_slip(0), reader(filename), pending(false), exhausted(false) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  // True once every recorded message has been received
+  bool Done() const { return exhausted && !pending; }
+
+  // True if every recorded message was received, unchanged and on time
+  bool Exact() const { return Done() && mismatches == 0 && extra == 0 && late == 0; }
+
+ protected:
+  ChannelTraceReader<Message> reader;
+  bool pending;
+  bool exhausted;
+  uint64 rec_cycle;
+  Message expected;
+  uint64 cycle;
+
+  void run() {
+    in.Reset();
+    reader.rewind();
+    received = mismatches = extra = late = max_slip = cycle = 0;
+    pending = exhausted = false;
+    wait();
+    while (1) {
+      if (!pending && !exhausted) {
+        pending = reader.read(rec_cycle, expected);
+        exhausted = !pending;
+      }
+      Message m;
+      if ((exhausted || cycle >= rec_cycle) && in.PopNB(m)) {
+        received++;
+        if (exhausted) {
+          extra++;
+        } else {
+          if (TypeToBits<Message>(m) != TypeToBits<Message>(expected)) {
+            mismatches++;
+          }
+          uint64 slip = cycle - rec_cycle;
+          if (slip != 0) {
+            late++;
+            if (slip > max_slip) max_slip = slip;
+          }
+          pending = false;
+        }
+      }
+      wait();
+      cycle++;
+    }
+  }
+};
+
+}  // namespace nvhls
+
+#endif  // __CHANNEL_REPLAY_H__
@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __CONSTRAINED_RANDOM_H__
+#define __CONSTRAINED_RANDOM_H__
+
+#include <systemc.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <nvhls_packed_marshaller.h>
+#include <TypeToBits.h>
+#include <UIntOrEmpty.h>
+#include <testbench/nvhls_rand.h>
+
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace nvhls {
+
+/**
+ * \brief Constrained-random generator for message types
+ * \ingroup ConstrainedRandom
+ *
+ * \tparam Payload      The message type to generate.
+ *
+ * \par Overview
+ *      ConstrainedRandom generates messages field by field, visiting the fields of packed messages (see
+ *      NVHLS_PACKED_MESSAGE) with their MarshallFields() visitor, so any packed message can be constrained without
+ *      code specific to its type.  Fields are named with member pointers, and a nested message is visited field by
+ *      field.  A field that is not constrained is uniformly random, as is any field whose type is not a packed message
+ *      or an integer, which is generated as a whole.
+ *
+ *      Each field accepts these constraints, applied in this order:
+ *      - repeat(): with the given percent probability, the field keeps its previous value.  This gives back-to-back
+ *        messages to the same destination, address or ID.
+ *      - sequence(): the field steps through a list of values, or an arithmetic sequence, wrapping at the end.
+ *      - range(), value() and uniform(): the field takes a value from one of its weighted ranges, picking the range
+ *        with probability proportional to its weight and the value uniformly within it.  uniform() adds the full
+ *        range of the field.
+ *
+ *      Values are 64-bit, so fields wider than 64 bits take the constrained value in their low bits.  A value that does
+ *      not fit in its field is an error.  Each generator draws from its own nvhls::Rng stream.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <testbench/ConstrainedRandom.h>
+ *
+ *      typedef axi::axi4<axi::cfg::standard>::AddrPayload Addr_t;
+ *      nvhls::ConstrainedRandom<Addr_t> gen("top.source");
+ *      gen.value(&Addr_t::addr, 0x1000, 9)     // hot address 90% of the time
+ *         .uniform(&Addr_t::addr, 1)
+ *         .value(&Addr_t::len, 255)            // maximum-length bursts
+ *         .range(&Addr_t::id, 0, 3)
+ *         .repeat(&Addr_t::id, 75);            // mostly back-to-back on one ID
+ *      ...
+ *      Addr_t request = gen.next();
+ * \endcode
+ * \par
+ *
+ */
+template <typename Payload>
+class ConstrainedRandom {
+ public:
+  explicit ConstrainedRandom(const char* stream = "") : rng(stream) {}
+  ConstrainedRandom(uint64 seed, const char* stream) : rng(seed, stream) {}
+
+  /** \brief Adds the range [lo, hi] to the field, with the given relative weight. */
+  template <typename F>
+  ConstrainedRandom& range(F Payload::*field, uint64 lo, uint64 hi, unsigned int weight = 1) {
+    NVHLS_ASSERT_MSG(lo <= hi, "Constraint range is empty");
+    AddRange(FieldOf(field), lo, hi, false, weight);
+    return *this;
+  }
+
+  /** \brief Adds the single value v to the field, with the given relative weight. */
+  template <typename F>
+  ConstrainedRandom& value(F Payload::*field, uint64 v, unsigned int weight = 1) {
+    return range(field, v, v, weight);
+  }
+
+  /** \brief Adds the full range of the field, with the given relative weight. */
+  template <typename F>
+  ConstrainedRandom& uniform(F Payload::*field, unsigned int weight = 1) {
+    AddRange(FieldOf(field), 0, 0, true, weight);
+    return *this;
+  }
+
+  /** \brief Steps the field through values, wrapping at the end. */
+  template <typename F>
+  ConstrainedRandom& sequence(F Payload::*field, const std::vector<uint64>& values) {
+    NVHLS_ASSERT_MSG(!values.empty(), "Constraint sequence is empty");
+    Field& f = FieldOf(field);
+    f.seq = values;
+    f.seq_idx = 0;
+    return *this;
+  }
+
+  /** \brief Steps the field through start, start + stride, ... for count values, wrapping at the end. */
+  template <typename F>
+  ConstrainedRandom& sequence(F Payload::*field, uint64 start, uint64 stride, unsigned int count) {
+    std::vector<uint64> values;
+    for (unsigned int i = 0; i < count; i++) {
+      values.push_back(start + stride * i);
+    }
+    return sequence(field, values);
+  }
+
+  /** \brief Keeps the previous value of the field with probability pct percent. */
+  template <typename F>
+  ConstrainedRandom& repeat(F Payload::*field, unsigned int pct) {
+    NVHLS_ASSERT_MSG(pct <= 100, "Repeat probability is a percentage");
+    FieldOf(field).repeat_pct = pct;
+    return *this;
+  }
+
+  /** \brief Removes every constraint of the field. */
+  template <typename F>
+  ConstrainedRandom& clear(F Payload::*field) {
+    Payload probe;
+    fields.erase(Key(&probe, &(probe.*field)));
+    return *this;
+  }
+
+  /** \brief Returns the next message. */
+  Payload next() {
+    Payload result;
+    Visitor v(*this, reinterpret_cast<const char*>(&result));
+    v & result;
+    return result;
+  }
+
+ protected:
+  struct Range {
+    uint64 lo;
+    uint64 hi;
+    bool full;
+    unsigned int weight;
+  };
+
+  struct Field {
+    std::vector<Range> ranges;
+    unsigned int total_weight;
+    std::vector<uint64> seq;
+    unsigned int seq_idx;
+    unsigned int repeat_pct;
+    bool has_last;
+    uint64 last;
+
+    Field() : total_weight(0), seq_idx(0), repeat_pct(0), has_last(false), last(0) {}
+  };
+
+  // A field is identified by its byte offset and size within the message
+  typedef std::pair<std::size_t, std::size_t> FieldKey;
+  typedef std::map<FieldKey, Field> FieldMap;
+
+  Rng rng;
+  FieldMap fields;
+
+  template <typename F>
+  static FieldKey Key(const Payload* base, const F* field) {
+    return FieldKey(reinterpret_cast<const char*>(field) - reinterpret_cast<const char*>(base), sizeof(F));
+  }
+
+  template <typename F>
+  Field& FieldOf(F Payload::*field) {
+    static_assert(is_packed_message<Payload>::value,
+                  "Fields can only be constrained in messages declared with NVHLS_PACKED_MESSAGE");
+    static_assert(!is_packed_message<F>::value, "Constrain the fields of a nested message instead of the message itself");
+    Payload probe;
+    return fields[Key(&probe, &(probe.*field))];
+  }
+
+  void AddRange(Field& f, uint64 lo, uint64 hi, bool full, unsigned int weight) {
+    NVHLS_ASSERT_MSG(weight > 0, "Constraint weight must be positive");
+    Range r = {lo, hi, full, weight};
+    f.ranges.push_back(r);
+    f.total_weight += weight;
+  }
+
+  uint64 Bits(unsigned int w) { return rng.next() & PackedMarshaller<64>::LowMask(w); }
+
+  // Returns the constrained value of a field of w bits
+  uint64 Draw(Field& f, unsigned int w) {
+    uint64 v;
+    if (f.has_last && f.repeat_pct > 0 && rng.below(100) < f.repeat_pct) {
+      v = f.last;
+    } else if (!f.seq.empty()) {
+      v = f.seq[f.seq_idx];
+      f.seq_idx = (f.seq_idx + 1) % f.seq.size();
+    } else if (f.total_weight > 0) {
+      uint64 pick = rng.below(f.total_weight);
+      unsigned int i = 0;
+      while (pick >= f.ranges[i].weight) {
+        pick -= f.ranges[i].weight;
+        i++;
+      }
+      const Range& r = f.ranges[i];
+      if (r.full) {
+        v = Bits(w);
+      } else if (r.hi - r.lo == ~static_cast<uint64>(0)) {
+        v = rng.next();
+      } else {
+        v = r.lo + rng.below(r.hi - r.lo + 1);
+      }
+    } else {
+      v = Bits(w);
+    }
+    NVHLS_ASSERT_MSG(w >= 64 || (v >> w) == 0, "Constrained value does not fit in its field");
+    f.last = v;
+    f.has_last = true;
+    return v;
+  }
+
+  // Visits the fields of the message being generated, like PackedMarshaller
+  class Visitor {
+   public:
+    Visitor(ConstrainedRandom& gen, const char* base) : gen(gen), base(base) {}
+
+    Visitor& operator&(bool& rhs) {
+      Field* f = Find(&rhs);
+      rhs = ((f ? gen.Draw(*f, 1) : gen.Bits(1)) != 0);
+      return *this;
+    }
+
+    Visitor& operator&(EmptyField& rhs) { return *this; }
+
+#ifdef HLS_CATAPULT
+    template <int W, bool S>
+    Visitor& operator&(ac_int<W, S>& rhs) {
+      Field* f = Find(&rhs);
+      if (f) {
+        rhs = ac_int<W, false>(gen.Draw(*f, W));
+      } else {
+        rhs = gen.rng.template get_rand<W>();
+      }
+      return *this;
+    }
+
+#if defined(NVHLS_FAST_SIM_INT) && !defined(__SYNTHESIS__)
+    template <int W, bool S>
+    Visitor& operator&(nvhls::fast_int<W, S>& rhs) {
+      Field* f = Find(&rhs);
+      rhs = nvhls::fast_int<W, S>::FromRaw(f ? gen.Draw(*f, W) : gen.Bits(W));
+      return *this;
+    }
+#endif
+#endif
+
+    template <int W>
+    Visitor& operator&(sc_uint<W>& rhs) {
+      Field* f = Find(&rhs);
+      rhs = f ? gen.Draw(*f, W) : gen.Bits(W);
+      return *this;
+    }
+
+    template <int W>
+    Visitor& operator&(sc_int<W>& rhs) {
+      Field* f = Find(&rhs);
+      rhs = static_cast<int64>(f ? gen.Draw(*f, W) : gen.Bits(W));
+      return *this;
+    }
+
+    template <int W>
+    Visitor& operator&(sc_biguint<W>& rhs) {
+      BigField(rhs, W);
+      return *this;
+    }
+
+    template <int W>
+    Visitor& operator&(sc_bigint<W>& rhs) {
+      BigField(rhs, W);
+      return *this;
+    }
+
+    template <typename T>
+    Visitor& operator&(T& rhs) {
+      AddField(rhs, tag<is_packed_message<T>::value>());
+      return *this;
+    }
+
+   protected:
+    ConstrainedRandom& gen;
+    const char* base;
+
+    template <bool B>
+    struct tag {};
+
+    template <typename T>
+    Field* Find(const T* field) {
+      if (gen.fields.empty()) {
+        return NULL;
+      }
+      typename FieldMap::iterator it =
+          gen.fields.find(FieldKey(reinterpret_cast<const char*>(field) - base, sizeof(T)));
+      return (it == gen.fields.end()) ? NULL : &it->second;
+    }
+
+    template <typename T>
+    void BigField(T& rhs, int w) {
+      Field* f = Find(&rhs);
+      if (f) {
+        rhs = gen.Draw(*f, w);
+        return;
+      }
+      for (int lo = 0; lo < w; lo += 64) {
+        int hi = (lo + 64 > w) ? w - 1 : lo + 63;
+        rhs.range(hi, lo) = gen.Bits(hi - lo + 1);
+      }
+    }
+
+    // Nested packed message: visit its fields
+    template <typename T>
+    void AddField(T& rhs, tag<true>) {
+      rhs.MarshallFields(*this);
+    }
+
+    // Any other type is generated as a whole
+    template <typename T>
+    void AddField(T& rhs, tag<false>) {
+      static const unsigned int W = Wrapped<T>::width;
+      Field* f = Find(&rhs);
+      if (f) {
+        rhs = NVUINTToType<T>(static_cast<NVUINTW(W)>(gen.Draw(*f, W)));
+      } else {
+        rhs = gen.rng.template gen_random_payload<T>();
+      }
+    }
+  };
+};
+
+}  // namespace nvhls
+
+#endif  // __CONSTRAINED_RANDOM_H__
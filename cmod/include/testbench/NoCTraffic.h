@@ -0,0 +1,586 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __NOC_TRAFFIC_H__
+#define __NOC_TRAFFIC_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <hls_globals.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+/**
+ * \brief Destination patterns of the synthetic NoC traffic generator
+ * \ingroup NoCTraffic
+ *
+ * Endpoint n sits at (x, y) = (n % MeshX, n / MeshX) of a MeshX x MeshY grid
+ * of N endpoints.
+ * - UniformRandom: any endpoint, including the source
+ * - Transpose: (y, x); coordinates wrap when the grid is not square
+ * - BitComplement: N - 1 - n, the bitwise complement when N is a power of 2
+ * - Hotspot: the hotspot endpoint with probability hotspot_fraction,
+ *   otherwise uniform random
+ * - Tornado: (x + ceil(MeshX / 2) - 1, y + ceil(MeshY / 2) - 1), wrapped
+ */
+enum NoCTrafficPattern {
+  UniformRandom,
+  Transpose,
+  BitComplement,
+  Hotspot,
+  Tornado
+};
+
+inline const char* NoCTrafficPatternName(NoCTrafficPattern pattern) {
+  switch (pattern) {
+    case UniformRandom:
+      return "uniform";
+    case Transpose:
+      return "transpose";
+    case BitComplement:
+      return "bitcomplement";
+    case Hotspot:
+      return "hotspot";
+    case Tornado:
+      return "tornado";
+  }
+  return "unknown";
+}
+
+/**
+ * \brief Settings of one NoC benchmark run
+ * \ingroup NoCTraffic
+ *
+ * \par Overview
+ * - injection_rate is in packets per cycle per endpoint.
+ * - burst_length of 0 or 1 injects as a Bernoulli process. A larger value
+ *   switches to an on/off process: an endpoint that is on injects every cycle
+ *   and turns off with probability 1 / burst_length, and turns back on at the
+ *   rate that keeps the long-run average at injection_rate.
+ * - Each rate point runs warmup_cycles, then measure_cycles in which created
+ *   packets are marked, then up to drain_cycles for the marked packets to
+ *   arrive. Traffic keeps flowing while draining. A point whose marked
+ *   packets do not all arrive is reported as saturated.
+ */
+struct NoCTrafficConfig {
+  NoCTrafficPattern pattern;
+  double injection_rate;
+  unsigned burst_length;
+  int hotspot;
+  double hotspot_fraction;
+  unsigned warmup_cycles;
+  unsigned measure_cycles;
+  unsigned drain_cycles;
+
+  NoCTrafficConfig()
+      : pattern(UniformRandom), injection_rate(0.1), burst_length(1),
+        hotspot(0), hotspot_fraction(0.2), warmup_cycles(1000),
+        measure_cycles(5000), drain_cycles(20000) {}
+
+  static double uniform() { return rand() / (RAND_MAX + 1.0); }
+
+  int destination(int src, int mesh_x, int mesh_y) const {
+    int num_nodes = mesh_x * mesh_y;
+    int x = src % mesh_x;
+    int y = src / mesh_x;
+    switch (pattern) {
+      case Transpose:
+        return (x % mesh_y) * mesh_x + (y % mesh_x);
+      case BitComplement:
+        return num_nodes - 1 - src;
+      case Hotspot:
+        if (uniform() < hotspot_fraction) {
+          return hotspot;
+        }
+        return rand() % num_nodes;
+      case Tornado:
+        return ((y + (mesh_y + 1) / 2 - 1) % mesh_y) * mesh_x +
+               ((x + (mesh_x + 1) / 2 - 1) % mesh_x);
+      default:
+        return rand() % num_nodes;
+    }
+  }
+};
+
+/**
+ * \brief Results of one rate point of a NoC benchmark sweep
+ * \ingroup NoCTraffic
+ *
+ * Rates are in packets per cycle per endpoint and latencies in cycles.
+ * latency runs from the cycle a packet is created, so it includes the time
+ * spent in the source queue; network_latency runs from the cycle the NoC
+ * accepted it.
+ */
+struct NoCBenchResult {
+  NoCTrafficPattern pattern;
+  double injection_rate;
+  double offered;
+  double accepted;
+  uint64 packets;
+  double latency_mean;
+  uint64 latency_p50;
+  uint64 latency_p90;
+  uint64 latency_p99;
+  uint64 latency_max;
+  double network_latency_mean;
+  bool saturated;
+};
+
+/**
+ * \brief Shared bookkeeping of the NoC traffic endpoints
+ * \ingroup NoCTraffic
+ *
+ * \par Overview
+ * Endpoints stamp each packet with the cycle it was created and the cycle
+ * the NoC accepted it, and mark the packets created in the measurement
+ * window. The stamps travel in the LSBs of the packet data rather than in
+ * packet_id: packet_id is only a few bits wide and selects the VC, which a
+ * torus rewrites on the way.
+ * \code
+ *      <marked(1b)> <injected cycle(32b)> <created cycle(32b)>
+ * \endcode
+ */
+class NoCTrafficStats {
+ public:
+  enum Phase { Idle, Warmup, Measure, Drain };
+  enum { created_bit = 0, injected_bit = 32, marked_bit = 64, stamp_width = 65 };
+
+  NoCTrafficStats(const sc_time& period_, int num_nodes_)
+      : period(period_), num_nodes(num_nodes_), phase(Idle) {
+    Clear();
+  }
+
+  uint64 Now() const {
+    return static_cast<uint64>(sc_time_stamp() / period + 0.5);
+  }
+
+  void Clear() {
+    start = static_cast<unsigned int>(Now());
+    marked = outstanding = accepted = 0;
+    latency.clear();
+    network_latency_sum = 0;
+  }
+
+  template <typename Packet_t>
+  void Created(Packet_t& packet) {
+    bool mark = (phase == Measure);
+    NVUINTW(32) now = Now();
+    packet.data = nvhls::set_slc(packet.data, now, created_bit);
+    packet.data = nvhls::set_slc(packet.data, NVUINTW(1)(mark), marked_bit);
+    if (mark) {
+      marked++;
+      outstanding++;
+    }
+  }
+
+  template <typename Packet_t>
+  void Injected(Packet_t& packet) {
+    NVUINTW(32) now = Now();
+    packet.data = nvhls::set_slc(packet.data, now, injected_bit);
+  }
+
+  template <typename Packet_t>
+  void Received(const Packet_t& packet) {
+    if (phase == Measure) {
+      accepted++;
+    }
+    // stamps wrap at 2^32 cycles
+    unsigned int now = static_cast<unsigned int>(Now());
+    unsigned int t_created = nvhls::get_slc<32>(packet.data, created_bit).to_uint();
+    unsigned int t_injected = nvhls::get_slc<32>(packet.data, injected_bit).to_uint();
+    // ignore packets left over from before the last reset
+    if (nvhls::get_slc<1>(packet.data, marked_bit) == 1 && outstanding > 0 &&
+        t_created >= start) {
+      latency.push_back(now - t_created);
+      network_latency_sum += now - t_injected;
+      outstanding--;
+    }
+  }
+
+  // Summary of the current rate point
+  NoCBenchResult Result(const NoCTrafficConfig& config) {
+    NoCBenchResult r;
+    double node_cycles = static_cast<double>(num_nodes) * config.measure_cycles;
+    r.pattern = config.pattern;
+    r.injection_rate = config.injection_rate;
+    r.offered = marked / node_cycles;
+    r.accepted = accepted / node_cycles;
+    r.packets = latency.size();
+    r.saturated = (outstanding != 0);
+    std::sort(latency.begin(), latency.end());
+    uint64 sum = 0;
+    for (unsigned i = 0; i < latency.size(); i++) {
+      sum += latency[i];
+    }
+    r.latency_mean = latency.empty() ? 0.0 : static_cast<double>(sum) / latency.size();
+    r.network_latency_mean = latency.empty() ? 0.0
+        : static_cast<double>(network_latency_sum) / latency.size();
+    r.latency_p50 = Percentile(0.50);
+    r.latency_p90 = Percentile(0.90);
+    r.latency_p99 = Percentile(0.99);
+    r.latency_max = latency.empty() ? 0 : latency.back();
+    return r;
+  }
+
+  const sc_time period;
+  const int num_nodes;
+  Phase phase;
+  unsigned int start;
+  uint64 marked;
+  uint64 outstanding;
+  uint64 accepted;
+  uint64 network_latency_sum;
+  std::vector<uint64> latency;
+
+ protected:
+  // nearest rank of a sorted sample
+  uint64 Percentile(double p) const {
+    if (latency.empty()) {
+      return 0;
+    }
+    size_t rank = static_cast<size_t>(p * latency.size() + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > latency.size()) rank = latency.size();
+    return latency[rank - 1];
+  }
+};
+
+/**
+ * \brief Synthetic traffic endpoint of a WHVCNoC
+ * \ingroup NoCTraffic
+ *
+ * \tparam NoC_t  A WHVCNoC, MeshNoC or TorusNoC
+ *
+ * \par Overview
+ * Creates packets with the pattern and injection process of the
+ * NoCTrafficConfig into an unbounded source queue, pushes the head of the
+ * queue into the NoC whenever it accepts one, and records the latency of the
+ * marked packets it receives in NoCTrafficStats. Each packet goes out on a
+ * random VC. All state is cleared on reset.
+ */
+template <typename NoC_t>
+class NoCTrafficEndpoint : public sc_module {
+ public:
+  typedef typename NoC_t::Packet_t Packet_t;
+  static_assert(Packet_t::data_width >= NoCTrafficStats::stamp_width,
+                "Packets must hold the timestamps");
+
+  Connections::Out<Packet_t> out;
+  Connections::In<Packet_t> in;
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+
+  const int id;
+  const NoCTrafficConfig& config;
+  NoCTrafficStats& stats;
+
+  SC_HAS_PROCESS(NoCTrafficEndpoint);
+  NoCTrafficEndpoint(sc_module_name name_, int id_,
+                     const NoCTrafficConfig& config_, NoCTrafficStats& stats_)
+      : sc_module(name_), out("out"), in("in"), clk("clk"), rst("rst"),
+        id(id_), config(config_), stats(stats_) {
+    SC_THREAD(send);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(receive);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+ protected:
+  std::deque<Packet_t> source_queue;
+  bool on;
+
+  bool fire() {
+    double rate = config.injection_rate;
+    if (config.burst_length <= 1) {
+      return NoCTrafficConfig::uniform() < rate;
+    }
+    if (on) {
+      on = (NoCTrafficConfig::uniform() >= 1.0 / config.burst_length);
+    } else if (rate < 1.0) {
+      on = (NoCTrafficConfig::uniform() <
+            rate / (config.burst_length * (1.0 - rate)));
+    } else {
+      on = true;
+    }
+    return on;
+  }
+
+  Packet_t generate() {
+    int dst = config.destination(id, NoC_t::mesh_x, NoC_t::mesh_y);
+    Packet_t packet;
+    packet.data = 0;
+    packet.dest = ((dst / NoC_t::mesh_x) << NoC_t::x_width) | (dst % NoC_t::mesh_x);
+    packet.packet_id = rand() % NoC_t::num_vchannels;
+    stats.Created(packet);
+    return packet;
+  }
+
+  void send() {
+    out.Reset();
+    source_queue.clear();
+    on = false;
+    wait();
+    while (1) {
+      if (stats.phase != NoCTrafficStats::Idle && fire()) {
+        source_queue.push_back(generate());
+      }
+      if (!source_queue.empty()) {
+        stats.Injected(source_queue.front());
+        if (out.PushNB(source_queue.front())) {
+          source_queue.pop_front();
+        }
+      }
+      wait();
+    }
+  }
+
+  void receive() {
+    in.Reset();
+    while (1) {
+      wait();
+      Packet_t packet;
+      if (in.PopNB(packet)) {
+        stats.Received(packet);
+      }
+    }
+  }
+};
+
+/**
+ * \brief Latency/throughput benchmark harness of a WHVCNoC
+ * \ingroup NoCTraffic
+ *
+ * \tparam NoC_t  A WHVCNoC, MeshNoC or TorusNoC
+ *
+ * \par Overview
+ * Top-level testbench module that instantiates the NoC, its clock and reset,
+ * and a NoCTrafficEndpoint per endpoint. Once sc_start() is called it sweeps
+ * the injection rates in rates: for each rate it resets the NoC, runs the
+ * warmup, measurement and drain phases of config and appends a
+ * NoCBenchResult to results. With stop_at_saturation set (the default) the
+ * sweep ends after the first saturated point. The simulation stops once the
+ * sweep is done; results can then be printed or written as CSV or JSON.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <WHVCNoC.h>
+ *      #include <testbench/NoCTraffic.h>
+ *
+ *      int sc_main(int argc, char *argv[]) {
+ *        NoCBenchmark<MeshNoC<4, 4, 2, 4, 64, 128, 8> > bench("bench");
+ *        bench.config.pattern = Transpose;
+ *        bench.config.measure_cycles = 2000;
+ *        for (int i = 1; i <= 10; i++) {
+ *          bench.rates.push_back(0.02 * i);
+ *        }
+ *        sc_start();
+ *        bench.Print(cout);
+ *        bench.WriteCSV("transpose.csv");
+ *        bench.WriteJSON("transpose.json");
+ *        return 0;
+ *      }
+ * \endcode
+ * \par
+ *
+ */
+template <typename NoC_t>
+class NoCBenchmark : public sc_module {
+ public:
+  typedef typename NoC_t::Packet_t Packet_t;
+  typedef NoCTrafficEndpoint<NoC_t> Endpoint_t;
+  typedef Connections::Combinational<Packet_t> PacketChan;
+  enum { num_nodes = NoC_t::num_nodes };
+
+  sc_clock clk;
+  sc_signal<bool> rst;
+  NoC_t noc;
+
+  NoCTrafficConfig config;
+  std::vector<double> rates;
+  bool stop_at_saturation;
+  std::vector<NoCBenchResult> results;
+
+  SC_HAS_PROCESS(NoCBenchmark);
+  NoCBenchmark(sc_module_name name_)
+      : sc_module(name_),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        rst("rst"),
+        noc("noc"),
+        stop_at_saturation(true),
+        stats(sc_time(1.0, SC_NS), num_nodes) {
+    Connections::set_sim_clk(&clk);
+
+    noc.clk(clk);
+    noc.rst(rst);
+    for (int n = 0; n < num_nodes; n++) {
+      std::ostringstream name;
+      name << "endpoint_" << n;
+      Endpoint_t* endpoint =
+          new Endpoint_t(name.str().c_str(), n, config, stats);
+      PacketChan* in_chan = new PacketChan();
+      PacketChan* out_chan = new PacketChan();
+
+      endpoint->clk(clk);
+      endpoint->rst(rst);
+      endpoint->out(*in_chan);
+      noc.in_packet[n](*in_chan);
+      noc.out_packet[n](*out_chan);
+      endpoint->in(*out_chan);
+    }
+
+    SC_THREAD(run);
+    sensitive << clk.posedge_event();
+  }
+
+  void Print(std::ostream& os) const {
+    os << "pattern,injection_rate,offered,accepted,packets,latency_mean,"
+       << "latency_p50,latency_p90,latency_p99,latency_max,"
+       << "network_latency_mean,saturated" << std::endl;
+    for (unsigned i = 0; i < results.size(); i++) {
+      const NoCBenchResult& r = results[i];
+      os << NoCTrafficPatternName(r.pattern) << "," << r.injection_rate << ","
+         << r.offered << "," << r.accepted << "," << r.packets << ","
+         << r.latency_mean << "," << r.latency_p50 << "," << r.latency_p90
+         << "," << r.latency_p99 << "," << r.latency_max << ","
+         << r.network_latency_mean << "," << (r.saturated ? 1 : 0)
+         << std::endl;
+    }
+  }
+
+  bool WriteCSV(const std::string& filename) const {
+    std::ofstream ofile(filename.c_str());
+    if (!ofile) {
+      DCOUT("Error: cannot open benchmark file " << filename << endl);
+      return false;
+    }
+    Print(ofile);
+    return ofile.good();
+  }
+
+  std::string ToJSON() const {
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("noc");
+    writer.String(noc.name());
+    writer.Key("mesh_x");
+    writer.Uint(NoC_t::mesh_x);
+    writer.Key("mesh_y");
+    writer.Uint(NoC_t::mesh_y);
+    writer.Key("burst_length");
+    writer.Uint(config.burst_length);
+    writer.Key("warmup_cycles");
+    writer.Uint(config.warmup_cycles);
+    writer.Key("measure_cycles");
+    writer.Uint(config.measure_cycles);
+    writer.Key("results");
+    writer.StartArray();
+    for (unsigned i = 0; i < results.size(); i++) {
+      const NoCBenchResult& r = results[i];
+      writer.StartObject();
+      writer.Key("pattern");
+      writer.String(NoCTrafficPatternName(r.pattern));
+      writer.Key("injection_rate");
+      writer.Double(r.injection_rate);
+      writer.Key("offered");
+      writer.Double(r.offered);
+      writer.Key("accepted");
+      writer.Double(r.accepted);
+      writer.Key("packets");
+      writer.Uint64(r.packets);
+      writer.Key("latency_mean");
+      writer.Double(r.latency_mean);
+      writer.Key("latency_p50");
+      writer.Uint64(r.latency_p50);
+      writer.Key("latency_p90");
+      writer.Uint64(r.latency_p90);
+      writer.Key("latency_p99");
+      writer.Uint64(r.latency_p99);
+      writer.Key("latency_max");
+      writer.Uint64(r.latency_max);
+      writer.Key("network_latency_mean");
+      writer.Double(r.network_latency_mean);
+      writer.Key("saturated");
+      writer.Bool(r.saturated);
+      writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    return std::string(buffer.GetString(), buffer.GetSize());
+  }
+
+  bool WriteJSON(const std::string& filename) const {
+    std::ofstream ofile(filename.c_str());
+    if (!ofile) {
+      DCOUT("Error: cannot open benchmark file " << filename << endl);
+      return false;
+    }
+    ofile << ToJSON() << std::endl;
+    return ofile.good();
+  }
+
+ protected:
+  NoCTrafficStats stats;
+
+  void run() {
+    for (unsigned i = 0; i < rates.size(); i++) {
+      config.injection_rate = rates[i];
+      stats.phase = NoCTrafficStats::Idle;
+      stats.Clear();
+      rst = 0;
+      wait(2);
+      rst = 1;
+      wait();
+      stats.phase = NoCTrafficStats::Warmup;
+      for (unsigned c = 0; c < config.warmup_cycles; c++) {
+        wait();
+      }
+      stats.phase = NoCTrafficStats::Measure;
+      for (unsigned c = 0; c < config.measure_cycles; c++) {
+        wait();
+      }
+      stats.phase = NoCTrafficStats::Drain;
+      for (unsigned c = 0; c < config.drain_cycles && stats.outstanding != 0; c++) {
+        wait();
+      }
+      results.push_back(stats.Result(config));
+      const NoCBenchResult& r = results.back();
+      DCOUT(sc_time_stamp() << " " << NoCTrafficPatternName(r.pattern)
+            << " rate " << r.injection_rate << ": accepted " << r.accepted
+            << ", mean latency " << r.latency_mean << ", p99 "
+            << r.latency_p99 << (r.saturated ? " (saturated)" : "") << endl);
+      if (r.saturated && stop_at_saturation) {
+        break;
+      }
+    }
+    stats.phase = NoCTrafficStats::Idle;
+    sc_stop();
+  }
+};
+
+#endif  // __NOC_TRAFFIC_H__
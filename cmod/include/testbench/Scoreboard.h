@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __SCOREBOARD_H__
+#define __SCOREBOARD_H__
+
+#include <systemc.h>
+#include <nvhls_assert.h>
+#include <TypeToBits.h>
+
+#include <deque>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+namespace nvhls {
+
+/**
+ * \brief Latency statistics of one Scoreboard stream, in cycles
+ * \ingroup Scoreboard
+ */
+struct ScoreboardStats {
+  uint64 matched;
+  uint64 latency_sum;
+  uint64 latency_min;
+  uint64 latency_max;
+
+  ScoreboardStats() : matched(0), latency_sum(0), latency_min(0), latency_max(0) {}
+
+  void Add(uint64 latency) {
+    if (matched == 0 || latency < latency_min) latency_min = latency;
+    if (latency > latency_max) latency_max = latency;
+    latency_sum += latency;
+    matched++;
+  }
+
+  double Mean() const { return matched == 0 ? 0.0 : static_cast<double>(latency_sum) / matched; }
+};
+
+/**
+ * \brief Scoreboard that matches messages by key
+ * \ingroup Scoreboard
+ *
+ * \tparam Message  The message type
+ * \tparam Key      The stream key, such as source, packet_id or AXI ID packed
+ *                  into an integer (default: uint64)
+ * \tparam Hash     Hash of Key (default: std::hash<Key>)
+ *
+ * \par Overview
+ * Expected messages are queued per key, so that messages of one key must
+ * arrive in order while different keys may arrive in any order, as they do
+ * out of a crossbar or a NoC. Check() compares a received message against the
+ * oldest expected message of its key, bit for bit, and records the latency in
+ * cycles in the statistics of the key.
+ * - Streams are held in a hash map, and every operation is O(1) amortized.
+ * - Expected messages are freed once matched, and the age order behind the
+ *   oldest outstanding message is all that is kept besides the statistics.
+ *   max_outstanding, if non-zero, bounds the number of outstanding messages
+ *   and is an error when exceeded.
+ * - starvation_cycles, if non-zero, is the longest a message may stay
+ *   outstanding. Expect(), Check() and Poll() report the oldest outstanding
+ *   message once it has waited longer, which catches a stream that a
+ *   round-robin arbiter never serves.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <testbench/Scoreboard.h>
+ *
+ *      nvhls::Scoreboard<Flit_t> scoreboard;
+ *      scoreboard.starvation_cycles = 1000;
+ *      ...
+ *      // in the source of port src
+ *      scoreboard.Expect((dest << 8) | src, flit, cycle);
+ *      ...
+ *      // in the sink of port dest
+ *      scoreboard.Check((dest << 8) | flit.src, flit, cycle);
+ *      ...
+ *      scoreboard.Print(cout);
+ *      NVHLS_ASSERT_MSG(scoreboard.empty(), "Messages were lost");
+ * \endcode
+ * \par
+ *
+ */
+template <typename Message, typename Key = uint64, typename Hash = std::hash<Key> >
+class Scoreboard {
+ public:
+  // An expected message, with its cycle and the sequence number of Expect()
+  struct Pending {
+    Message message;
+    uint64 cycle;
+    uint64 seq;
+  };
+  struct Stream {
+    std::deque<Pending> pending;
+    ScoreboardStats stats;
+  };
+  typedef std::unordered_map<Key, Stream, Hash> StreamMap;
+
+  uint64 max_outstanding;
+  uint64 starvation_cycles;
+
+  Scoreboard() : max_outstanding(0), starvation_cycles(0), outstanding(0), next_seq(0) {}
+
+  /** \brief Adds a message expected on stream key, sent in the given cycle. */
+  void Expect(const Key& key, const Message& m, uint64 cycle) {
+    Pending p = {m, cycle, next_seq};
+    streams[key].pending.push_back(p);
+    age.push_back(Entry(key, cycle, next_seq));
+    next_seq++;
+    outstanding++;
+    NVHLS_ASSERT_MSG(max_outstanding == 0 || outstanding <= max_outstanding,
+                     "Scoreboard exceeded its outstanding messages");
+    Poll(cycle);
+  }
+
+  /**
+   * \brief Checks a message received on stream key in the given cycle, and
+   * returns its latency.
+   */
+  uint64 Check(const Key& key, const Message& m, uint64 cycle) {
+    typename StreamMap::iterator it = streams.find(key);
+    if (it == streams.end() || it->second.pending.empty()) {
+      std::cout << "Scoreboard: stream " << key << " received an unexpected message" << std::endl;
+      NVHLS_ASSERT_MSG(false, "Received a message that was never expected");
+    }
+    Stream& s = it->second;
+    if (TypeToBits<Message>(m) != TypeToBits<Message>(s.pending.front().message)) {
+      std::cout << "Scoreboard: stream " << key << " received a mismatching message" << std::endl;
+      NVHLS_ASSERT_MSG(false, "Received message does not match the expected message");
+    }
+    uint64 latency = cycle - s.pending.front().cycle;
+    s.stats.Add(latency);
+    total.Add(latency);
+    s.pending.pop_front();
+    outstanding--;
+    Poll(cycle);
+    return latency;
+  }
+
+  /** \brief Reports the oldest outstanding message if it is starved in the given cycle. */
+  void Poll(uint64 cycle) {
+    // Drop matched entries: a stream matches in order, so an entry is
+    // outstanding exactly when it is still the front of its stream
+    while (!age.empty()) {
+      const Stream& s = streams.find(age.front().key)->second;
+      if (!s.pending.empty() && s.pending.front().seq == age.front().seq) {
+        break;
+      }
+      age.pop_front();
+    }
+    if (starvation_cycles != 0 && !age.empty() && cycle - age.front().cycle > starvation_cycles) {
+      std::cout << "Scoreboard: stream " << age.front().key << " starved, a message expected in cycle "
+                << age.front().cycle << " is still outstanding in cycle " << cycle << std::endl;
+      NVHLS_ASSERT_MSG(false, "Scoreboard stream starved");
+    }
+  }
+
+  bool empty() const { return outstanding == 0; }
+  uint64 Outstanding() const { return outstanding; }
+
+  /** \brief Statistics over all streams. */
+  const ScoreboardStats& Total() const { return total; }
+  const StreamMap& Streams() const { return streams; }
+
+  /** \brief Prints the latency statistics of every stream. */
+  void Print(std::ostream& os) const {
+    os << "stream,matched,outstanding,latency_mean,latency_min,latency_max" << std::endl;
+    for (typename StreamMap::const_iterator it = streams.begin(); it != streams.end(); ++it) {
+      const ScoreboardStats& st = it->second.stats;
+      os << it->first << "," << st.matched << "," << it->second.pending.size() << "," << st.Mean() << ","
+         << st.latency_min << "," << st.latency_max << std::endl;
+    }
+    os << "total," << total.matched << "," << outstanding << "," << total.Mean() << "," << total.latency_min
+       << "," << total.latency_max << std::endl;
+  }
+
+ protected:
+  struct Entry {
+    Key key;
+    uint64 cycle;
+    uint64 seq;
+    Entry(const Key& key_, uint64 cycle_, uint64 seq_) : key(key_), cycle(cycle_), seq(seq_) {}
+  };
+
+  StreamMap streams;
+  // Outstanding and matched entries in the order of Expect()
+  std::deque<Entry> age;
+  ScoreboardStats total;
+  uint64 outstanding;
+  uint64 next_seq;
+};
+
+}  // namespace nvhls
+
+#endif  // __SCOREBOARD_H__
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __SOURCE_SINK_H__
+#define __SOURCE_SINK_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_assert.h>
+#include <TypeToBits.h>
+#include <testbench/Pacer.h>
+#include <testbench/nvhls_rand.h>
+
+#include <deque>
+#include <utility>
+
+namespace nvhls {
+
+/**
+ * \brief Expected messages between a Source and a Sink
+ * \ingroup SourceSink
+ *
+ * \par Overview
+ * A Source pushes each message into the GoldenQueue in the cycle the channel
+ * accepts it, and a Sink checks each message it receives against the oldest
+ * entry, which gives the end-to-end latency in cycles. For a block that
+ * transforms its messages, leave the Source without a GoldenQueue and push
+ * the expected outputs from the testbench instead.
+ */
+template <typename Message>
+class GoldenQueue {
+ public:
+  void Push(const Message& m, uint64 cycle) { queue.push_back(std::make_pair(m, cycle)); }
+
+  // Checks m against the oldest expected message, and returns the cycles
+  // since it was pushed
+  uint64 Check(const Message& m, uint64 cycle) {
+    NVHLS_ASSERT_MSG(!queue.empty(), "Received a message that was never sent");
+    NVHLS_ASSERT_MSG(TypeToBits<Message>(m) == TypeToBits<Message>(queue.front().first),
+                     "Received message does not match the expected message");
+    uint64 latency = cycle - queue.front().second;
+    queue.pop_front();
+    return latency;
+  }
+
+  bool empty() const { return queue.empty(); }
+  size_t size() const { return queue.size(); }
+  void clear() { queue.clear(); }
+
+ protected:
+  std::deque<std::pair<Message, uint64> > queue;
+};
+
+/**
+ * \brief Rate-controlled testbench source
+ * \ingroup SourceSink
+ *
+ * \tparam Message  The message type
+ *
+ * \par Overview
+ * Sends the messages given to Add(), followed by random_count random
+ * messages from its own nvhls::Rng stream, named after the module.
+ * - injection_rate is the probability of creating a message in a cycle.
+ * - burst_length of 0 or 1 creates messages as a Bernoulli process. A larger
+ *   value switches to an on/off process with the same long-run rate, like
+ *   NoCTrafficConfig: the source creates a message every cycle while on, and
+ *   turns off with probability 1 / burst_length.
+ * Created messages wait in an unbounded queue until the channel accepts them,
+ * so a stalled channel does not lower the offered rate. Accepted messages go
+ * into the GoldenQueue, if one is given. Source and Sink count cycles from
+ * reset, so they must share the clock and the reset.
+ */
+template <typename Message>
+class Source : public sc_module {
+  SC_HAS_PROCESS(Source);
+
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::Out<Message> out;
+
+  double injection_rate;
+  unsigned burst_length;
+  uint64 random_count;
+
+  // Statistics since reset
+  uint64 sent;
+  uint64 first_cycle;
+  uint64 last_cycle;
+
+  Source(sc_module_name name, GoldenQueue<Message>* golden_ = NULL)
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        out("out"),
+        injection_rate(1.0),
+        burst_length(1),
+        random_count(0),
+        sent(0),
+        first_cycle(0),
+        last_cycle(0),
+        golden(golden_),
+        rng(this->name()) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void Add(const Message& m) { messages.push_back(m); }
+
+  // True once every message has been created and accepted
+  bool Done() const { return messages.empty() && generated == random_count && queue.empty(); }
+
+  // Accepted messages per cycle, from the first to the last one accepted
+  double Throughput() const { return sent == 0 ? 0.0 : static_cast<double>(sent) / (last_cycle - first_cycle + 1); }
+
+ protected:
+  GoldenQueue<Message>* golden;
+  Rng rng;
+  std::deque<Message> messages;
+  std::deque<Message> queue;
+  uint64 generated;
+  uint64 cycle;
+  bool on;
+
+  double uniform() { return (rng.next() >> 11) * (1.0 / 9007199254740992.0); }
+
+  bool fire() {
+    if (burst_length <= 1) {
+      return uniform() < injection_rate;
+    }
+    if (on) {
+      on = (uniform() >= 1.0 / burst_length);
+    } else if (injection_rate < 1.0) {
+      on = (uniform() < injection_rate / (burst_length * (1.0 - injection_rate)));
+    } else {
+      on = true;
+    }
+    return on;
+  }
+
+  void run() {
+    out.Reset();
+    queue.clear();
+    generated = sent = first_cycle = last_cycle = cycle = 0;
+    on = false;
+    wait();
+    while (1) {
+      if ((!messages.empty() || generated < random_count) && fire()) {
+        if (!messages.empty()) {
+          queue.push_back(messages.front());
+          messages.pop_front();
+        } else {
+          queue.push_back(rng.gen_random_payload<Message>());
+          generated++;
+        }
+      }
+      if (!queue.empty() && out.PushNB(queue.front())) {
+        if (golden != NULL) {
+          golden->Push(queue.front(), cycle);
+        }
+        if (sent == 0) {
+          first_cycle = cycle;
+        }
+        last_cycle = cycle;
+        sent++;
+        queue.pop_front();
+      }
+      wait();
+      cycle++;
+    }
+  }
+};
+
+/**
+ * \brief Backpressuring testbench sink
+ * \ingroup SourceSink
+ *
+ * \tparam Message  The message type
+ *
+ * \par Overview
+ * Pops a message in every cycle its Pacer does not stall, and checks it
+ * against the GoldenQueue, if one is given. It records the number of
+ * messages, the achieved throughput and the mean and maximum end-to-end
+ * latency in cycles. The default Pacer never stalls.
+ *
+ * \par A Simple Example
+ * \code
+ *      #include <testbench/SourceSink.h>
+ *
+ *      nvhls::GoldenQueue<Word_t> golden;
+ *      nvhls::Source<Word_t> src("src", &golden);
+ *      nvhls::Sink<Word_t> sink("sink", &golden, Pacer(0.2, 0.5));
+ *      ...
+ *      src.out(dut_in);
+ *      sink.in(dut_out);
+ *      src.injection_rate = 0.8;
+ *      src.burst_length = 16;
+ *      src.random_count = 1000;
+ *      ...
+ *      // once src.Done() and golden.empty()
+ *      cout << sink.Throughput() << " " << sink.MeanLatency() << endl;
+ * \endcode
+ * \par
+ *
+ */
+template <typename Message>
+class Sink : public sc_module {
+  SC_HAS_PROCESS(Sink);
+
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<Message> in;
+
+  // Statistics since reset
+  uint64 received;
+  uint64 first_cycle;
+  uint64 last_cycle;
+  uint64 latency_sum;
+  uint64 latency_max;
+
+  Sink(sc_module_name name, GoldenQueue<Message>* golden_ = NULL, const Pacer& pacer_ = Pacer(0, 0))
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        in("in"),
+        received(0),
+        first_cycle(0),
+        last_cycle(0),
+        latency_sum(0),
+        latency_max(0),
+        golden(golden_),
+        pacer(pacer_) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  // Received messages per cycle, from the first to the last one received
+  double Throughput() const {
+    return received == 0 ? 0.0 : static_cast<double>(received) / (last_cycle - first_cycle + 1);
+  }
+
+  double MeanLatency() const { return received == 0 ? 0.0 : static_cast<double>(latency_sum) / received; }
+
+ protected:
+  GoldenQueue<Message>* golden;
+  Pacer pacer;
+  uint64 cycle;
+
+  void run() {
+    in.Reset();
+    received = first_cycle = last_cycle = latency_sum = latency_max = cycle = 0;
+    wait();
+    while (1) {
+      Message m;
+      if (!pacer.tic() && in.PopNB(m)) {
+        if (golden != NULL) {
+          uint64 latency = golden->Check(m, cycle);
+          latency_sum += latency;
+          if (latency > latency_max) {
+            latency_max = latency;
+          }
+        }
+        if (received == 0) {
+          first_cycle = cycle;
+        }
+        last_cycle = cycle;
+        received++;
+      }
+      wait();
+      cycle++;
+    }
+  }
+};
+
+}  // namespace nvhls
+
+#endif  // __SOURCE_SINK_H__
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NVHLS_CHECKPOINT_H
+#define NVHLS_CHECKPOINT_H
+
+#include <systemc.h>
+#include <nvhls_assert.h>
+#include <TypeToBits.h>
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace nvhls {
+
+/**
+ * \brief Checkpoint and restore of registered simulation state
+ * \ingroup Checkpoint
+ *
+ * \par Overview
+ * Modules register the objects that hold their state, and Save() writes all
+ * of them to a binary snapshot that Restore() loads back, e.g. into a new run
+ * that forks an experiment from a warmed-up point instead of simulating the
+ * warmup again.
+ * - Any type with a Marshall() method and a width can be registered, which
+ *   includes FIFO, mem_array_sep, ReorderBuf, the Arbiters, packed messages
+ *   and the nvhls integer types. Its bits, including X bits, are saved as
+ *   TypeToBits() produces them.
+ * - RegisterRaw() takes save and restore callbacks for other state.
+ * - Entries are matched by name, so a snapshot can be restored into a model
+ *   built again with the same names. Entries present on only one side are
+ *   reported and skipped; a size mismatch fails the restore.
+ *
+ * Only registered state is saved. Save at a cycle boundary where the
+ * Connections channels are empty, or keep in-flight data in registered
+ * FIFOs, and keep process state in module members rather than locals of an
+ * SC_THREAD. Restore before the restored modules next run, e.g. at the end
+ * of reset. SavedTime() is the simulated time of the snapshot; SystemC time
+ * itself cannot be restored.
+ *
+ * A snapshot is the 8-byte magic "NVCKPT01", a u32 version, a u32 entry
+ * count and a u64 time in SystemC resolution units, followed by the entries:
+ * a u32 name length, the name, a u64 payload length and the payload, all in
+ * host byte order.
+ *
+ * \par A Simple Example
+ * \code
+ *      // In the module constructor
+ *      NVHLS_CHECKPOINT(fifo);
+ *      NVHLS_CHECKPOINT(arbiter);
+ *
+ *      // In the warmup run
+ *      nvhls::Checkpoint::Instance().Save("warm.ckpt");
+ *
+ *      // In each experiment, once reset is done
+ *      nvhls::Checkpoint::Instance().Restore("warm.ckpt");
+ * \endcode
+ * \par
+ *
+ */
+class Checkpoint {
+ public:
+  typedef std::vector<unsigned char> Bytes;
+  static const unsigned int kVersion = 1;
+
+  static Checkpoint& Instance() {
+    static Checkpoint checkpoint;
+    return checkpoint;
+  }
+
+  /** \brief Registers an object whose Marshall() covers its state */
+  template <typename T>
+  void Register(const std::string& name, T& state) {
+    T* ptr = &state;
+    RegisterRaw(name, [ptr](Bytes& out) { ToBytes(TypeToBits<T>(*ptr), out); },
+                [ptr](const Bytes& in) {
+                  sc_lv<Wrapped<T>::width> bits;
+                  if (!FromBytes(in, bits)) {
+                    return false;
+                  }
+                  *ptr = BitsToType<T>(bits);
+                  return true;
+                });
+  }
+
+  /** \brief Registers field of owner as "<owner name>.<field>" */
+  template <typename T>
+  void Register(const sc_object* owner, const char* field, T& state) {
+    Register(std::string(owner->name()) + "." + field, state);
+  }
+
+  /** \brief Registers state saved by a callback; restore returns false on a bad payload */
+  void RegisterRaw(const std::string& name, std::function<void(Bytes&)> save,
+                   std::function<bool(const Bytes&)> restore) {
+    NVHLS_ASSERT_MSG(entries.find(name) == entries.end(), "Checkpoint entry registered twice");
+    Entry& e = entries[name];
+    e.save = save;
+    e.restore = restore;
+  }
+
+  void Unregister(const std::string& name) { entries.erase(name); }
+  void Clear() { entries.clear(); }
+  size_t Size() const { return entries.size(); }
+  uint64 SavedTime() const { return saved_time; }
+
+  bool Save(const std::string& filename) const {
+    FILE* f = fopen(filename.c_str(), "wb");
+    if (f == NULL) {
+      std::fprintf(stderr, "Error: cannot write checkpoint %s\n", filename.c_str());
+      return false;
+    }
+    bool ok = Write(f, "NVCKPT01", 8);
+    unsigned int version = kVersion;
+    unsigned int count = entries.size();
+    uint64 now = sc_time_stamp().value();
+    ok = ok && Write(f, &version, 4) && Write(f, &count, 4) && Write(f, &now, 8);
+    Bytes payload;
+    for (std::map<std::string, Entry>::const_iterator it = entries.begin(); ok && it != entries.end(); ++it) {
+      payload.clear();
+      it->second.save(payload);
+      unsigned int name_len = it->first.size();
+      uint64 len = payload.size();
+      ok = Write(f, &name_len, 4) && Write(f, it->first.data(), name_len) && Write(f, &len, 8) &&
+           Write(f, payload.data(), payload.size());
+    }
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) {
+      std::fprintf(stderr, "Error: writing checkpoint %s failed\n", filename.c_str());
+    }
+    return ok;
+  }
+
+  bool Restore(const std::string& filename) {
+    FILE* f = fopen(filename.c_str(), "rb");
+    if (f == NULL) {
+      std::fprintf(stderr, "Error: cannot read checkpoint %s\n", filename.c_str());
+      return false;
+    }
+    char magic[8];
+    unsigned int version = 0;
+    unsigned int count = 0;
+    uint64 time = 0;
+    bool ok = Read(f, magic, 8) && memcmp(magic, "NVCKPT01", 8) == 0 && Read(f, &version, 4) &&
+              version == kVersion && Read(f, &count, 4) && Read(f, &time, 8);
+    std::map<std::string, bool> restored;
+    Bytes payload;
+    for (unsigned int i = 0; ok && i < count; i++) {
+      unsigned int name_len = 0;
+      uint64 len = 0;
+      std::string name;
+      ok = Read(f, &name_len, 4);
+      if (ok) {
+        name.resize(name_len);
+        ok = Read(f, &name[0], name_len) && Read(f, &len, 8);
+      }
+      if (ok) {
+        payload.resize(len);
+        ok = Read(f, payload.data(), len);
+      }
+      if (!ok) {
+        break;
+      }
+      std::map<std::string, Entry>::iterator it = entries.find(name);
+      if (it == entries.end()) {
+        std::fprintf(stderr, "Warning: checkpoint entry %s is not registered\n", name.c_str());
+      } else if (!it->second.restore(payload)) {
+        std::fprintf(stderr, "Error: checkpoint entry %s does not match its registered size\n", name.c_str());
+        fclose(f);
+        return false;
+      } else {
+        restored[name] = true;
+      }
+    }
+    fclose(f);
+    if (!ok) {
+      std::fprintf(stderr, "Error: checkpoint %s is truncated or not a checkpoint\n", filename.c_str());
+      return false;
+    }
+    for (std::map<std::string, Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+      if (restored.find(it->first) == restored.end()) {
+        std::fprintf(stderr, "Warning: %s is not in checkpoint %s\n", it->first.c_str(), filename.c_str());
+      }
+    }
+    saved_time = time;
+    return true;
+  }
+
+  // Data and control words of each 32 bits, so that X and Z bits survive
+  template <int W>
+  static void ToBytes(const sc_lv<W>& bits, Bytes& out) {
+    int words = (W + 31) / 32;
+    out.resize(8 * words);
+    for (int i = 0; i < words; i++) {
+      sc_digit d[2] = {bits.get_word(i), bits.get_cword(i)};
+      memcpy(&out[8 * i], d, 8);
+    }
+  }
+
+  template <int W>
+  static bool FromBytes(const Bytes& in, sc_lv<W>& bits) {
+    int words = (W + 31) / 32;
+    if (in.size() != static_cast<size_t>(8 * words)) {
+      return false;
+    }
+    for (int i = 0; i < words; i++) {
+      sc_digit d[2];
+      memcpy(d, &in[8 * i], 8);
+      bits.set_word(i, d[0]);
+      bits.set_cword(i, d[1]);
+    }
+    return true;
+  }
+
+ private:
+  struct Entry {
+    std::function<void(Bytes&)> save;
+    std::function<bool(const Bytes&)> restore;
+  };
+  std::map<std::string, Entry> entries;
+  uint64 saved_time;
+
+  Checkpoint() : saved_time(0) {}
+  Checkpoint(const Checkpoint&);
+  Checkpoint& operator=(const Checkpoint&);
+
+  static bool Write(FILE* f, const void* data, size_t n) { return n == 0 || fwrite(data, 1, n, f) == n; }
+  static bool Read(FILE* f, void* data, size_t n) { return n == 0 || fread(data, 1, n, f) == n; }
+};
+
+}  // namespace nvhls
+
+/**
+ * \brief Registers a member of the current module with nvhls::Checkpoint
+ * \ingroup Checkpoint
+ */
+#define NVHLS_CHECKPOINT(member) nvhls::Checkpoint::Instance().Register(this, #member, member)
+
+#endif  // NVHLS_CHECKPOINT_H
@@ -0,0 +1,502 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NVHLS_PARTITION_H
+#define NVHLS_PARTITION_H
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_assert.h>
+#include <TypeToBits.h>
+
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <new>
+#include <thread>
+
+namespace nvhls {
+
+/**
+ * \brief Shared state of one partition link
+ * \ingroup Partition
+ *
+ * The two ends publish their progress as the simulated time of their last
+ * completed cycle plus one, so 0 means none. Records are written to the data
+ * and credit rings behind the state, each stamped with its send time.
+ */
+struct PartitionLinkState {
+  std::atomic<uint64_t> sender_progress;
+  std::atomic<uint64_t> receiver_progress;
+  std::atomic<uint64_t> data_head;
+  std::atomic<uint64_t> data_tail;
+  std::atomic<uint64_t> credit_head;
+  std::atomic<uint64_t> credit_tail;
+};
+
+/**
+ * \brief Partitioned simulation: runs parts of a model in parallel processes
+ * \ingroup Partition
+ *
+ * \par Overview
+ * A model split into partitions that only talk through PartitionSender /
+ * PartitionReceiver pairs can simulate each partition in its own process.
+ * Launch() must be the first call of sc_main. It forks one process per extra
+ * partition, and returns the partition of the calling process. Each process
+ * then elaborates only the modules of the partitions it Owns(), and runs
+ * sc_start() with the same duration. Finish() ends the child processes and
+ * returns the combined status in partition 0.
+ *
+ * The ends of a link synchronize conservatively: a cycle at time t only needs
+ * the peer to have finished time t - lookahead, where the lookahead is the
+ * latency of the link. The results are the same whether the partitions run in
+ * one process or many. Setting NVHLS_PARTITIONS=1 keeps every partition in
+ * one process, e.g. for debugging.
+ *
+ * The reference SystemC kernel has one simulation context per process, so
+ * partitions are processes that share their link state through an anonymous
+ * shared mapping, rather than threads.
+ *
+ * \par A Simple Example
+ * \code
+ *      int sc_main(int argc, char *argv[]) {
+ *        nvhls::Partitions& parts = nvhls::Partitions::Instance();
+ *        parts.Launch(kNumTiles);
+ *        ...
+ *        for (unsigned p = 0; p < kNumTiles; p++) {
+ *          if (parts.Owns(p)) {
+ *            tiles[p] = new Tile(...);  // including its link ends
+ *          }
+ *        }
+ *        sc_start(...);
+ *        return parts.Finish(status);
+ *      }
+ * \endcode
+ * \par
+ *
+ */
+class Partitions {
+ public:
+  static const unsigned kMaxPartitions = 256;
+
+  static Partitions& Instance() {
+    static Partitions parts;
+    return parts;
+  }
+
+  /**
+   * \brief Forks the processes of count partitions
+   *
+   * Returns the partition of the calling process. Links use ids below
+   * max_links, and each has link_bytes of ring storage.
+   */
+  unsigned Launch(unsigned count, unsigned max_links = 256, size_t link_bytes = 1 << 16) {
+    NVHLS_ASSERT_MSG(shared_ == NULL, "Partitions launched twice, or after a link was created");
+    NVHLS_ASSERT_MSG(count > 0 && count <= kMaxPartitions, "Unsupported partition count");
+    const char* env = std::getenv("NVHLS_PARTITIONS");
+    forked_ = (count > 1) && !(env != NULL && std::atoi(env) == 1);
+    count_ = count;
+    Allocate(max_links, link_bytes);
+    parent_ = getpid();
+    shared_->pids[0] = parent_;
+    if (forked_) {
+      std::fflush(stdout);
+      std::fflush(stderr);
+      for (unsigned p = 1; p < count; p++) {
+        pid_t pid = fork();
+        NVHLS_ASSERT_MSG(pid >= 0, "Partition fork failed");
+        if (pid == 0) {
+          self_ = p;
+          break;
+        }
+        shared_->pids[p] = pid;
+      }
+      std::atexit(MarkFinished);
+    }
+    return self_;
+  }
+
+  unsigned Count() const { return count_; }
+  unsigned Self() const { return self_; }
+  bool Forked() const { return forked_; }
+
+  /** \brief True if this process simulates partition p */
+  bool Owns(unsigned p) const { return !forked_ || p == self_; }
+
+  /**
+   * \brief Ends the partition
+   *
+   * A child process exits with status. Partition 0 waits for the children,
+   * and returns status, or 1 if any child failed.
+   */
+  int Finish(int status) {
+    if (!forked_) {
+      return status;
+    }
+    MarkFinished();
+    if (self_ != 0) {
+      std::fflush(stdout);
+      std::exit(status);
+    }
+    for (unsigned p = 1; p < count_; p++) {
+      if (!reaped_[p]) {
+        int st = 0;
+        waitpid(shared_->pids[p], &st, 0);
+        Reaped(p, st);
+      }
+    }
+    return child_failed_ ? 1 : status;
+  }
+
+  PartitionLinkState& Link(unsigned id) {
+    if (shared_ == NULL) {
+      Allocate(256, 1 << 16);
+    }
+    NVHLS_ASSERT_MSG(id < shared_->max_links, "Partition link id out of range");
+    return *reinterpret_cast<PartitionLinkState*>(LinkBase(id));
+  }
+
+  unsigned char* LinkData(unsigned id) { return LinkBase(id) + kStateBytes; }
+  size_t LinkBytes() const { return shared_->link_bytes; }
+
+  /**
+   * \brief Waits until progress reaches until, or the peer partition stops
+   *
+   * Returns false if the peer stopped first.
+   */
+  bool WaitFor(const std::atomic<uint64_t>& progress, uint64_t until, unsigned peer) {
+    if (progress.load(std::memory_order_acquire) >= until) {
+      return true;
+    }
+    NVHLS_ASSERT_MSG(!Owns(peer), "Partition link lookahead is shorter than a clock period");
+    for (unsigned spin = 1;; spin++) {
+      if (progress.load(std::memory_order_acquire) >= until) {
+        return true;
+      }
+      if (shared_->finished[peer].load(std::memory_order_acquire)) {
+        return progress.load(std::memory_order_acquire) >= until;
+      }
+      if ((spin & 0xffff) == 0) {
+        CheckAlive();
+      }
+      std::this_thread::yield();
+    }
+  }
+
+ private:
+  struct Shared {
+    std::atomic<unsigned> finished[kMaxPartitions];
+    pid_t pids[kMaxPartitions];
+    unsigned max_links;
+    size_t link_bytes;
+  };
+  static const size_t kStateBytes = (sizeof(PartitionLinkState) + 63) & ~size_t(63);
+
+  Shared* shared_;
+  unsigned count_;
+  unsigned self_;
+  bool forked_;
+  pid_t parent_;
+  bool reaped_[kMaxPartitions];
+  bool child_failed_;
+
+  Partitions() : shared_(NULL), count_(1), self_(0), forked_(false), parent_(0), child_failed_(false) {
+    for (unsigned p = 0; p < kMaxPartitions; p++) reaped_[p] = false;
+  }
+  Partitions(const Partitions&);
+  Partitions& operator=(const Partitions&);
+
+  unsigned char* LinkBase(unsigned id) {
+    size_t header = (sizeof(Shared) + 63) & ~size_t(63);
+    return reinterpret_cast<unsigned char*>(shared_) + header + id * (kStateBytes + shared_->link_bytes);
+  }
+
+  void Allocate(unsigned max_links, size_t link_bytes) {
+    link_bytes = (link_bytes + 63) & ~size_t(63);
+    size_t header = (sizeof(Shared) + 63) & ~size_t(63);
+    size_t bytes = header + max_links * (kStateBytes + link_bytes);
+    // Anonymous shared memory is zero filled, and stays shared across fork()
+    void* mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    NVHLS_ASSERT_MSG(mem != MAP_FAILED, "Cannot map partition link memory");
+    shared_ = new (mem) Shared;
+    for (unsigned p = 0; p < kMaxPartitions; p++) shared_->finished[p].store(0);
+    shared_->max_links = max_links;
+    shared_->link_bytes = link_bytes;
+    for (unsigned id = 0; id < max_links; id++) {
+      new (LinkBase(id)) PartitionLinkState();
+      PartitionLinkState& link = *reinterpret_cast<PartitionLinkState*>(LinkBase(id));
+      link.sender_progress.store(0);
+      link.receiver_progress.store(0);
+      link.data_head.store(0);
+      link.data_tail.store(0);
+      link.credit_head.store(0);
+      link.credit_tail.store(0);
+    }
+  }
+
+  static void MarkFinished() {
+    Partitions& parts = Instance();
+    parts.shared_->finished[parts.self_].store(1, std::memory_order_release);
+  }
+
+  void Reaped(unsigned p, int st) {
+    reaped_[p] = true;
+    shared_->finished[p].store(1, std::memory_order_release);
+    if (!WIFEXITED(st) || WEXITSTATUS(st) != 0) {
+      std::fprintf(stderr, "Error: partition %u failed\n", p);
+      child_failed_ = true;
+    }
+  }
+
+  // Partition 0 reaps children that died without finishing, so that their
+  // peers stop waiting; children exit if partition 0 is gone.
+  void CheckAlive() {
+    if (self_ == 0) {
+      for (unsigned p = 1; p < count_; p++) {
+        int st = 0;
+        if (!reaped_[p] && waitpid(shared_->pids[p], &st, WNOHANG) == shared_->pids[p]) {
+          Reaped(p, st);
+        }
+      }
+    } else if (getppid() != parent_) {
+      std::fprintf(stderr, "Error: partition %u lost partition 0\n", self_);
+      std::_Exit(1);
+    }
+  }
+};
+
+/**
+ * \brief Layout of the records of a partition link
+ * \ingroup Partition
+ */
+template <typename Message, unsigned int Capacity>
+struct PartitionLinkLayout {
+  static const unsigned int kWidth = Wrapped<Message>::width;
+  static const unsigned int kWords = (kWidth + 63) / 64;
+  // A data record is its stamp followed by the message bits
+  static const size_t kDataRecord = 8 * (1 + kWords);
+  static const size_t kBytes = Capacity * (kDataRecord + 8);
+
+  static uint64_t* Data(unsigned char* base, uint64_t i) {
+    return reinterpret_cast<uint64_t*>(base + (i % Capacity) * kDataRecord);
+  }
+  static uint64_t* Credit(unsigned char* base, uint64_t i) {
+    return reinterpret_cast<uint64_t*>(base + Capacity * kDataRecord + (i % Capacity) * 8);
+  }
+
+  static void ToWords(const Message& m, uint64_t* words) {
+    NVUINTW(kWidth) bits = TypeToNVUINT(m);
+    for (unsigned int i = 0; i < kWords; i++) {
+      words[i] = bits.to_uint64();
+      if (i + 1 < kWords) {
+        bits = bits >> 64;
+      }
+    }
+  }
+
+  static Message FromWords(const uint64_t* words) {
+    NVUINTW(kWidth) bits = static_cast<NVUINTW(kWidth)>(words[kWords - 1]);
+    for (int i = kWords - 2; i >= 0; i--) {
+      bits = (bits << 64) | static_cast<NVUINTW(kWidth)>(words[i]);
+    }
+    return NVUINTToType<Message>(bits);
+  }
+};
+
+// Time in simulation resolution units of the latency of a link
+inline uint64_t partition_lookahead(sc_in_clk& clk, unsigned int latency) {
+  sc_clock* c = dynamic_cast<sc_clock*>(clk.get_interface());
+  NVHLS_ASSERT_MSG(c != NULL, "Partition link clocks must be bound to an sc_clock");
+  return latency * c->period().value();
+}
+
+/**
+ * \brief The sending end of a link between partitions
+ * \ingroup Partition
+ *
+ * \tparam Message   The message type.
+ * \tparam Latency   Cycles from a message leaving the sender to it reaching the receiver, at least 1. This is the
+ *                   lookahead of the link.
+ * \tparam Capacity  Messages in flight, bounded by credits (default: enough for full throughput).
+ *
+ * \par Overview
+ * Pops messages from enq while it holds credits, and forwards them to the
+ * PartitionReceiver with the same link id, which may be in another partition.
+ * Both ends must be clocked by sc_clocks of the same period.
+ *
+ * \par A Simple Example
+ * \code
+ *      // In partition 0
+ *      nvhls::PartitionSender<Flit_t, 2> to_tile1("to_tile1", 7, 1);  // link 7, receiver in partition 1
+ *      // In partition 1
+ *      nvhls::PartitionReceiver<Flit_t, 2> from_tile0("from_tile0", 7, 0);  // link 7, sender in partition 0
+ * \endcode
+ * \par
+ *
+ */
+template <typename Message, unsigned int Latency = 1, unsigned int Capacity = 2 * Latency + 2>
+class PartitionSender : public sc_module {
+  SC_HAS_PROCESS(PartitionSender);
+  typedef PartitionLinkLayout<Message, Capacity> Layout;
+
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<Message> enq;
+
+  PartitionSender(sc_module_name name, unsigned int link_id, unsigned int receiver_partition)
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        enq("enq"),
+        link(Partitions::Instance().Link(link_id)),
+        data(Partitions::Instance().LinkData(link_id)),
+        peer(receiver_partition),
+        credits(Capacity),
+        lookahead(0) {
+    static_assert(Latency > 0, "Partition links need a latency of at least one cycle");
+    NVHLS_ASSERT_MSG(Layout::kBytes <= Partitions::Instance().LinkBytes(), "Partition link records do not fit");
+    SC_THREAD(run);
+    sensitive << clk.pos();
+  }
+
+ protected:
+  PartitionLinkState& link;
+  unsigned char* data;
+  unsigned int peer;
+  unsigned int credits;
+  uint64_t lookahead;
+
+  void start_of_simulation() { lookahead = partition_lookahead(clk, Latency); }
+
+  // Not reset by rst, so that the link keeps making progress in reset
+  void run() {
+    enq.Reset();
+    wait();
+    // The peer has the same clock, so it has no edge before our first one
+    uint64_t first = sc_time_stamp().value();
+    while (1) {
+      uint64_t now = sc_time_stamp().value();
+      if (now >= first + lookahead) {
+        uint64_t visible = now - lookahead;
+        Partitions::Instance().WaitFor(link.receiver_progress, visible + 1, peer);
+        uint64_t tail = link.credit_tail.load(std::memory_order_relaxed);
+        uint64_t head = link.credit_head.load(std::memory_order_acquire);
+        while (tail != head && *Layout::Credit(data, tail) <= visible) {
+          tail++;
+          credits++;
+        }
+        link.credit_tail.store(tail, std::memory_order_release);
+      }
+      Message m;
+      if (rst.read() && credits > 0 && enq.PopNB(m)) {
+        uint64_t head = link.data_head.load(std::memory_order_relaxed);
+        uint64_t* rec = Layout::Data(data, head);
+        rec[0] = now;
+        Layout::ToWords(m, rec + 1);
+        link.data_head.store(head + 1, std::memory_order_release);
+        credits--;
+      }
+      link.sender_progress.store(now + 1, std::memory_order_release);
+
+      wait();
+    }
+  }
+};
+
+/**
+ * \brief The receiving end of a link between partitions
+ * \ingroup Partition
+ *
+ * Pushes the messages of the PartitionSender with the same link id to deq,
+ * Latency cycles after they were sent, and returns a credit for each. The
+ * template parameters must match those of the sender.
+ */
+template <typename Message, unsigned int Latency = 1, unsigned int Capacity = 2 * Latency + 2>
+class PartitionReceiver : public sc_module {
+  SC_HAS_PROCESS(PartitionReceiver);
+  typedef PartitionLinkLayout<Message, Capacity> Layout;
+
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::Out<Message> deq;
+
+  PartitionReceiver(sc_module_name name, unsigned int link_id, unsigned int sender_partition)
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        deq("deq"),
+        link(Partitions::Instance().Link(link_id)),
+        data(Partitions::Instance().LinkData(link_id)),
+        peer(sender_partition),
+        lookahead(0) {
+    static_assert(Latency > 0, "Partition links need a latency of at least one cycle");
+    NVHLS_ASSERT_MSG(Layout::kBytes <= Partitions::Instance().LinkBytes(), "Partition link records do not fit");
+    SC_THREAD(run);
+    sensitive << clk.pos();
+  }
+
+ protected:
+  PartitionLinkState& link;
+  unsigned char* data;
+  unsigned int peer;
+  uint64_t lookahead;
+  std::deque<Message> ready;
+
+  void start_of_simulation() { lookahead = partition_lookahead(clk, Latency); }
+
+  // Not reset by rst, so that the link keeps making progress in reset
+  void run() {
+    deq.Reset();
+    wait();
+    // The peer has the same clock, so it has no edge before our first one
+    uint64_t first = sc_time_stamp().value();
+    while (1) {
+      uint64_t now = sc_time_stamp().value();
+      if (now >= first + lookahead) {
+        uint64_t visible = now - lookahead;
+        Partitions::Instance().WaitFor(link.sender_progress, visible + 1, peer);
+        uint64_t tail = link.data_tail.load(std::memory_order_relaxed);
+        uint64_t head = link.data_head.load(std::memory_order_acquire);
+        while (tail != head && Layout::Data(data, tail)[0] <= visible) {
+          ready.push_back(Layout::FromWords(Layout::Data(data, tail) + 1));
+          tail++;
+        }
+        link.data_tail.store(tail, std::memory_order_release);
+      }
+      if (rst.read() && !ready.empty() && deq.PushNB(ready.front())) {
+        ready.pop_front();
+        uint64_t head = link.credit_head.load(std::memory_order_relaxed);
+        *Layout::Credit(data, head) = now;
+        link.credit_head.store(head + 1, std::memory_order_release);
+      }
+      link.receiver_progress.store(now + 1, std::memory_order_release);
+
+      wait();
+    }
+  }
+};
+
+}  // namespace nvhls
+
+#endif  // NVHLS_PARTITION_H
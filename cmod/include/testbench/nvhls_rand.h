@@ -20,8 +20,145 @@
 #include <nvhls_int.h>
 #include <nvhls_types.h>
 #include <TypeToBits.h>
+#include <testbench/nvhls_sim_stats.h>
+
+#include <stdint.h>
+#include <cstdlib>
 
 namespace nvhls {
+/**
+ * \brief Get random seed
+ * \ingroup set_random_seed
+ *
+ * \par Overview
+ *      Returns the random seed selected by the prioritization of set_random_seed(), without seeding anything.
+ *
+ */
+inline unsigned int get_random_seed() {
+  unsigned int seed = 0;
+#ifdef NVHLS_RAND_SEED
+  seed = (NVHLS_RAND_SEED);
+#endif
+  const char* env_rand_seed = std::getenv("NVHLS_RAND_SEED");
+  if (env_rand_seed != NULL) seed = atoi(env_rand_seed);
+  return seed;
+}
+
+/**
+ * \brief Fast random number generator with named streams
+ * \ingroup Rng
+ *
+ * \par Overview
+ *      A xoshiro256** generator, which produces 64 random bits per call.  Each generator is seeded with splitmix64 from
+ *      a seed and a stream name, so generators with different names produce independent sequences.  A module that owns
+ *      an Rng named after its hierarchical name draws the same values for a given seed no matter what the rest of the
+ *      testbench does, and generators can be used from parallel threads as long as each thread owns its own.
+ *
+ *      Constructing an Rng with only a stream name uses the seed from get_random_seed().  The functions get_rand() and
+ *      gen_random_payload() draw from a global generator, global_rng(), which set_random_seed() reseeds.
+ *
+ * \par A Simple Example
+ * \code
+ *   #include <nvhls_rand.h>
+ *
+ *   SC_MODULE(source) {
+ *     nvhls::Rng rng;
+ *     SC_CTOR(source) : rng(name()) { ... }
+ *     void run() {
+ *       ...
+ *       NVUINTW(40) value = rng.get_rand<40>();
+ *       payload_t data = rng.gen_random_payload<payload_t>();
+ *       unsigned int bank = rng.below(numBanks);
+ *     }
+ *   };
+ * \endcode
+ * \par
+ *
+ */
+class Rng {
+ public:
+  Rng() { seed(0); }
+  explicit Rng(const char* stream) { seed(get_random_seed(), stream); }
+  Rng(uint64_t s, const char* stream) { seed(s, stream); }
+
+  /** \brief Restarts the stream of the given name from seed s. */
+  void seed(uint64_t s, const char* stream = "") {
+    // FNV-1a hash of the stream name
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (const char* c = stream; *c != '\0'; c++) {
+      h = (h ^ static_cast<unsigned char>(*c)) * 0x100000001b3ULL;
+    }
+    uint64_t x = s ^ h;
+    for (int i = 0; i < 4; i++) {
+      // splitmix64
+      x += 0x9e3779b97f4a7c15ULL;
+      uint64_t z = x;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      state[i] = z ^ (z >> 31);
+    }
+  }
+
+  /** \brief Returns 64 random bits. */
+  uint64_t next() {
+    uint64_t result = rotl(state[1] * 5, 7) * 9;
+    uint64_t t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+    return result;
+  }
+
+  /** \brief Returns a uniformly distributed value in [0, bound), for bound > 0. */
+  uint64_t below(uint64_t bound) {
+    // Reject the top partial range so every value is equally likely
+    uint64_t threshold = (0 - bound) % bound;
+    uint64_t r;
+    do {
+      r = next();
+    } while (r < threshold);
+    return r % bound;
+  }
+
+  /** \brief Returns a random value of the given width, filled 64 bits at a time. */
+  template <int bitwidth>
+  NVUINTW(bitwidth) get_rand() {
+    NVUINTW(bitwidth) random = static_cast<NVUINTW(bitwidth)>(next());
+    for (int i = 1; i < (bitwidth + 63) / 64; i++) {
+      random = (random << 64) | static_cast<NVUINTW(bitwidth)>(next());
+    }
+    return random;
+  }
+
+  /**
+   * \brief Returns a random payload of any type.
+   *
+   * Packed messages (see NVHLS_PACKED_MESSAGE) are filled straight from the generated words; other types are
+   * unmarshalled from them.
+   */
+  template <typename Payload>
+  Payload gen_random_payload() {
+    return NVUINTToType<Payload>(get_rand<Wrapped<Payload>::width>());
+  }
+
+ private:
+  uint64_t state[4];
+
+  static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+/**
+ * \brief The global random number generator, used by get_rand() and gen_random_payload().
+ * \ingroup Rng
+ */
+inline Rng& global_rng() {
+  static Rng rng;
+  return rng;
+}
+
 /**
  * \brief Set random seed 
  * \ingroup set_random_seed
@@ -32,6 +169,9 @@ namespace nvhls {
  *        -# The setting of the NVHLS_RAND_SEED CFLAG at compile time (or via #define in a source file)
  *        -# A random seed of 0 (deterministic)
  *
+ *      The seed is passed to srand() and to global_rng().  When called in sc_main, it also enables the simulation
+ *      statistics report of enable_sim_stats().
+ *
  *      WARNING: The user-defined random seed may be overriden in cosimulation, causing SCVerify to always simulate with an
  *      effective seed of 0.  To work around this, call set_random_seed() inside an SC_THREAD instead of in sc_main.
  *
@@ -58,13 +198,10 @@ namespace nvhls {
  */
 
 inline int set_random_seed() {
-  unsigned int seed = 0;
-#ifdef NVHLS_RAND_SEED
-  seed = (NVHLS_RAND_SEED);
-#endif
-  const char* env_rand_seed = std::getenv("NVHLS_RAND_SEED");
-  if (env_rand_seed != NULL) seed = atoi(env_rand_seed);
+  unsigned int seed = get_random_seed();
   srand(seed);
+  enable_sim_stats();
+  global_rng().seed(seed);
   cout << "================================" << endl;
   cout << dec << "SETTING RANDOM SEED = " << seed << endl;
   cout << "================================" << endl;
@@ -76,7 +213,7 @@ inline int set_random_seed() {
  * \ingroup gen_random_payload
  * 
  * \par Overview
- *      Function to generate a random payload for desired type.
+ *      Function to generate a random payload for desired type, drawn from global_rng().
  *
  * \par A Simple Example
  * \code
@@ -91,22 +228,14 @@ inline int set_random_seed() {
  */
 template < typename Payload>
 Payload gen_random_payload() {
-  Payload payload;
-  NVUINTW(Payload::width) random = rand();
-  int num = Payload::width/32 + 1;
-  for (int i = 0; i < num; i++) {
-    random = (random << 32) + rand();
-  }
-  sc_lv<Payload::width> payload_lv = TypeToBits<NVUINTW(Payload::width) > (random);
-  payload = BitsToType<Payload> (payload_lv);
-  return payload;
+  return global_rng().gen_random_payload<Payload>();
 }
 /**
  * \brief Generate Random integer value of desired width
  * \ingroup get_rand
  * 
  * \par Overview
- *      Function to generate a random value of desired width
+ *      Function to generate a random value of desired width, drawn from global_rng().
  *
  * \par A Simple Example
  * \code
@@ -121,12 +250,7 @@ Payload gen_random_payload() {
  */
 template < int bitwidth>
 NVUINTW(bitwidth) get_rand() {
-  NVUINTW(bitwidth) random = rand();
-  int num = bitwidth/32 + 1;
-  for (int i = 0; i < num; i++) {
-    random = (random << 32) + rand();
-  }
-  return random;
+  return global_rng().get_rand<bitwidth>();
 }
 
 }
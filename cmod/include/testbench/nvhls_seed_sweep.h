@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NVHLS_SEED_SWEEP_H
+#define NVHLS_SEED_SWEEP_H
+
+#include <systemc.h>
+#include <nvhls_assert.h>
+#include <testbench/nvhls_rand.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nvhls {
+
+/**
+ * \brief Runs a testbench once per random seed, in parallel forked workers
+ * \ingroup SeedSweep
+ *
+ * \par Overview
+ * Launch() must be the first call of sc_main. Without the NVHLS_SEEDS
+ * environment variable it only returns true, and the testbench runs once as
+ * usual. With it, the process becomes the parent of a seed sweep:
+ * - NVHLS_SEEDS=N sweeps N seeds starting at get_random_seed(), and
+ *   NVHLS_SEEDS=first-last the seeds first to last.
+ * - For every seed the parent forks a worker, at most NVHLS_SEED_JOBS
+ *   (default: the number of cores) at a time. The worker sets
+ *   NVHLS_RAND_SEED, so set_random_seed() and the axi::Manager seed pick it
+ *   up, and returns true from Launch() to elaborate and simulate the
+ *   testbench. Forked workers share the pages of the binary, and a worker
+ *   never inherits an elaborated design.
+ * - Worker output goes to NVHLS_SEED_LOG_DIR/seed_<seed>.log (default
+ *   sim_seeds/, which sim_clean removes); the logs of passing seeds are
+ *   deleted unless NVHLS_SEED_KEEP_LOGS is set.
+ * - A worker passes when it exits with status 0. Record(name, value) in a
+ *   worker adds a value, e.g. a latency or a coverage count, to the report.
+ *   The simulated time of every worker that exits normally is recorded as
+ *   sim_time_ns, and the host time of every worker as wall_s.
+ *
+ * Once all seeds ran, Launch() prints the report and returns false in the
+ * parent, which should return Status(): 0 when every seed passed. The
+ * report has the form
+ * \code
+ *      NVHLS_SEED_SWEEP seeds=<n> passed=<n> failed=<n> jobs=<n> wall_s=<s>
+ *      NVHLS_SEED_SWEEP_FAILED seed=<seed> status=<status> log=<file>
+ *      NVHLS_SEED_SWEEP_STAT name=<name> count=<n> min=<v> mean=<v> max=<v>
+ * \endcode
+ * with status the exit code of the worker, or 128 plus the signal that
+ * killed it.
+ *
+ * \par A Simple Example
+ * \code
+ *      int sc_main(int argc, char *argv[]) {
+ *        nvhls::SeedSweep& sweep = nvhls::SeedSweep::Instance();
+ *        if (!sweep.Launch()) return sweep.Status();
+ *        nvhls::set_random_seed();
+ *        testbench tb("tb");
+ *        sc_start();
+ *        sweep.Record("max_latency", tb.max_latency);
+ *        ...
+ *      }
+ * \endcode
+ * Run as NVHLS_SEEDS=0-999 ./sim_test.
+ * \par
+ *
+ */
+class SeedSweep {
+ public:
+  static const unsigned kMaxValues = 16;
+  static const unsigned kNameBytes = 32;
+
+  struct Result {
+    unsigned seed;
+    int status;  // Exit code, or 128 + signal
+    std::vector<std::pair<std::string, double> > values;
+  };
+
+  struct Summary {
+    unsigned count;
+    double min;
+    double max;
+    double sum;
+    Summary() : count(0), min(0), max(0), sum(0) {}
+    double Mean() const { return count == 0 ? 0.0 : sum / count; }
+  };
+
+  static SeedSweep& Instance() {
+    static SeedSweep sweep;
+    return sweep;
+  }
+
+  /**
+   * \brief Starts the sweep selected by NVHLS_SEEDS
+   *
+   * Returns true in a worker, or when there is no sweep, and false in the
+   * parent once every worker finished.
+   */
+  bool Launch() {
+    NVHLS_ASSERT_MSG(!launched_, "SeedSweep launched twice");
+    launched_ = true;
+    const char* env = std::getenv("NVHLS_SEEDS");
+    if (env == NULL) return true;
+    ParseSeeds(env);
+    jobs_ = std::thread::hardware_concurrency();
+    const char* env_jobs = std::getenv("NVHLS_SEED_JOBS");
+    if (env_jobs != NULL) jobs_ = std::atoi(env_jobs);
+    if (jobs_ == 0) jobs_ = 1;
+    if (jobs_ > seeds_.size()) jobs_ = seeds_.size();
+    const char* env_dir = std::getenv("NVHLS_SEED_LOG_DIR");
+    log_dir_ = (env_dir != NULL) ? env_dir : "sim_seeds";
+    keep_logs_ = (std::getenv("NVHLS_SEED_KEEP_LOGS") != NULL);
+    mkdir(log_dir_.c_str(), 0755);
+    // Anonymous shared memory stays shared across fork(), one slot per job
+    void* mem = mmap(NULL, jobs_ * sizeof(Slot), PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    NVHLS_ASSERT_MSG(mem != MAP_FAILED, "Cannot map seed sweep memory");
+    slots_ = static_cast<Slot*>(mem);
+    return RunParent();
+  }
+
+  bool Sweeping() const { return slots_ != NULL; }
+  bool IsWorker() const { return slot_ != NULL; }
+
+  /** \brief Adds value to the report of the sweep; a no-op outside a worker */
+  void Record(const char* name, double value) {
+    if (slot_ == NULL) return;
+    for (unsigned i = 0; i < slot_->num_values; i++) {
+      if (std::strncmp(slot_->names[i], name, kNameBytes - 1) == 0) {
+        slot_->values[i] = value;
+        return;
+      }
+    }
+    NVHLS_ASSERT_MSG(slot_->num_values < kMaxValues, "Too many SeedSweep values");
+    unsigned i = slot_->num_values++;
+    std::strncpy(slot_->names[i], name, kNameBytes - 1);
+    slot_->names[i][kNameBytes - 1] = '\0';
+    slot_->values[i] = value;
+  }
+
+  /** \brief 0 when every seed passed */
+  int Status() const { return failed_.empty() ? 0 : 1; }
+  const std::vector<Result>& Results() const { return results_; }
+  const std::vector<unsigned>& FailedSeeds() const { return failed_; }
+  const std::map<std::string, Summary>& Summaries() const { return summaries_; }
+
+  void Report(std::ostream& ofile) const {
+    ofile << "NVHLS_SEED_SWEEP seeds=" << results_.size()
+          << " passed=" << results_.size() - failed_.size() << " failed=" << failed_.size()
+          << " jobs=" << jobs_ << " wall_s=" << wall_s_ << std::endl;
+    for (unsigned i = 0; i < results_.size(); i++) {
+      if (results_[i].status != 0) {
+        ofile << "NVHLS_SEED_SWEEP_FAILED seed=" << results_[i].seed
+              << " status=" << results_[i].status << " log=" << LogFile(results_[i].seed)
+              << std::endl;
+      }
+    }
+    for (std::map<std::string, Summary>::const_iterator it = summaries_.begin();
+         it != summaries_.end(); it++) {
+      ofile << "NVHLS_SEED_SWEEP_STAT name=" << it->first << " count=" << it->second.count
+            << " min=" << it->second.min << " mean=" << it->second.Mean()
+            << " max=" << it->second.max << std::endl;
+    }
+  }
+
+ private:
+  struct Slot {
+    unsigned num_values;
+    char names[kMaxValues][kNameBytes];
+    double values[kMaxValues];
+  };
+
+  struct Worker {
+    pid_t pid;
+    unsigned seed;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  bool launched_;
+  std::vector<unsigned> seeds_;
+  unsigned jobs_;
+  std::string log_dir_;
+  bool keep_logs_;
+  Slot* slots_;
+  Slot* slot_;  // Of this worker
+  double wall_s_;
+  std::vector<Result> results_;
+  std::vector<unsigned> failed_;
+  std::map<std::string, Summary> summaries_;
+
+  SeedSweep()
+      : launched_(false), jobs_(0), keep_logs_(false), slots_(NULL), slot_(NULL), wall_s_(0) {}
+  SeedSweep(const SeedSweep&);
+  SeedSweep& operator=(const SeedSweep&);
+
+  void ParseSeeds(const char* env) {
+    unsigned first = 0, last = 0;
+    if (std::sscanf(env, "%u-%u", &first, &last) == 2) {
+      NVHLS_ASSERT_MSG(first <= last, "NVHLS_SEEDS range is empty");
+    } else {
+      unsigned count = std::atoi(env);
+      NVHLS_ASSERT_MSG(count > 0, "NVHLS_SEEDS must be a count or a first-last range");
+      first = get_random_seed();
+      last = first + count - 1;
+    }
+    for (unsigned seed = first;; seed++) {
+      seeds_.push_back(seed);
+      if (seed == last) break;
+    }
+  }
+
+  std::string LogFile(unsigned seed) const {
+    std::stringstream file;
+    file << log_dir_ << "/seed_" << seed << ".log";
+    return file.str();
+  }
+
+  // Forks the workers and collects their results; returns true in a worker
+  bool RunParent() {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<Worker> workers(jobs_);
+    for (unsigned j = 0; j < jobs_; j++) workers[j].pid = 0;
+    unsigned next = 0, active = 0;
+    while (next < seeds_.size() || active != 0) {
+      for (unsigned j = 0; j < jobs_ && next < seeds_.size(); j++) {
+        if (workers[j].pid != 0) continue;
+        if (StartWorker(j, seeds_[next], workers[j])) return true;
+        next++;
+        active++;
+      }
+      int st = 0;
+      pid_t pid = waitpid(-1, &st, 0);
+      NVHLS_ASSERT_MSG(pid > 0, "Lost a seed sweep worker");
+      for (unsigned j = 0; j < jobs_; j++) {
+        if (workers[j].pid == pid) {
+          Finished(j, workers[j], st);
+          workers[j].pid = 0;
+          active--;
+        }
+      }
+    }
+    wall_s_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::sort(results_.begin(), results_.end(), BySeed);
+    std::sort(failed_.begin(), failed_.end());
+    Report(std::cout);
+    return false;
+  }
+
+  // Returns true in the new worker
+  bool StartWorker(unsigned j, unsigned seed, Worker& worker) {
+    slots_[j].num_values = 0;
+    std::fflush(stdout);
+    std::fflush(stderr);
+    pid_t pid = fork();
+    NVHLS_ASSERT_MSG(pid >= 0, "Seed sweep fork failed");
+    if (pid == 0) {
+      slot_ = &slots_[j];
+      std::stringstream value;
+      value << seed;
+      setenv("NVHLS_RAND_SEED", value.str().c_str(), 1);
+      int fd = open(LogFile(seed).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd >= 0) {
+        dup2(fd, 1);
+        dup2(fd, 2);
+        close(fd);
+      }
+      std::atexit(RecordSimTime);
+      return true;
+    }
+    worker.pid = pid;
+    worker.seed = seed;
+    worker.start = std::chrono::steady_clock::now();
+    return false;
+  }
+
+  void Finished(unsigned j, const Worker& worker, int st) {
+    Result result;
+    result.seed = worker.seed;
+    result.status = WIFEXITED(st) ? WEXITSTATUS(st) : 128 + (WIFSIGNALED(st) ? WTERMSIG(st) : 0);
+    const Slot& slot = slots_[j];
+    for (unsigned i = 0; i < slot.num_values && i < kMaxValues; i++) {
+      result.values.push_back(std::make_pair(std::string(slot.names[i]), slot.values[i]));
+    }
+    result.values.push_back(std::make_pair(std::string("wall_s"),
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - worker.start).count()));
+    for (unsigned i = 0; i < result.values.size(); i++) {
+      Summary& summary = summaries_[result.values[i].first];
+      double value = result.values[i].second;
+      if (summary.count == 0 || value < summary.min) summary.min = value;
+      if (summary.count == 0 || value > summary.max) summary.max = value;
+      summary.sum += value;
+      summary.count++;
+    }
+    if (result.status != 0) {
+      failed_.push_back(result.seed);
+    } else if (!keep_logs_) {
+      unlink(LogFile(result.seed).c_str());
+    }
+    results_.push_back(result);
+  }
+
+  static bool BySeed(const Result& a, const Result& b) { return a.seed < b.seed; }
+
+  static void RecordSimTime() {
+    Instance().Record("sim_time_ns", sc_time_stamp().to_seconds() * 1e9);
+    std::fflush(stdout);
+  }
+};
+
+}  // namespace nvhls
+
+#endif  // NVHLS_SEED_SWEEP_H
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NVHLS_SIM_STATS_H
+#define NVHLS_SIM_STATS_H
+
+#include <systemc.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace nvhls {
+
+/**
+ * \brief Finds the period of the fastest sc_clock when simulation starts
+ * \ingroup sim_stats
+ */
+class sim_stats_clock : public sc_module {
+ public:
+  sim_stats_clock(sc_module_name name) : sc_module(name) {}
+
+  static sc_time& period() {
+    static sc_time p = SC_ZERO_TIME;
+    return p;
+  }
+
+ protected:
+  void start_of_simulation() { find(sc_get_top_level_objects()); }
+
+  static void find(const std::vector<sc_object*>& objects) {
+    for (unsigned i = 0; i < objects.size(); i++) {
+      const sc_clock* clk = dynamic_cast<const sc_clock*>(objects[i]);
+      if (clk != NULL && (period() == SC_ZERO_TIME || clk->period() < period())) {
+        period() = clk->period();
+      }
+      find(objects[i]->get_child_objects());
+    }
+  }
+};
+
+/**
+ * \brief Prints the simulated time and cycles of the run
+ * \ingroup sim_stats
+ *
+ * The line has the form
+ * \code
+ *      NVHLS_SIM_STATS sim_time_ns=<time> clock_period_ns=<period> cycles=<cycles>
+ * \endcode
+ * where cycles counts periods of the fastest clock, and is 0 if none was found.
+ */
+inline void report_sim_stats() {
+  double time_ns = sc_time_stamp().to_seconds() * 1e9;
+  double period_ns = sim_stats_clock::period().to_seconds() * 1e9;
+  unsigned long long cycles = (period_ns > 0) ? static_cast<unsigned long long>(time_ns / period_ns + 0.5) : 0;
+  std::printf("NVHLS_SIM_STATS sim_time_ns=%.3f clock_period_ns=%.3f cycles=%llu\n", time_ns, period_ns, cycles);
+  std::fflush(stdout);
+}
+
+/**
+ * \brief Reports the simulated time and cycles at exit
+ * \ingroup sim_stats
+ *
+ * \par Overview
+ *      When the NVHLS_SIM_STATS environment variable is set, registers report_sim_stats() to run when the simulation
+ *      exits, which is how bin/regress_timing.py measures cycles per second.  It must be called during elaboration, and
+ *      set_random_seed() calls it, so every testbench that sets its seed in sc_main reports without changes.  Later
+ *      calls do nothing.
+ *
+ */
+inline void enable_sim_stats() {
+  static bool enabled = false;
+  if (enabled || std::getenv("NVHLS_SIM_STATS") == NULL || sc_get_status() != SC_ELABORATION) {
+    return;
+  }
+  enabled = true;
+  new sim_stats_clock("nvhls_sim_stats_clock");
+  std::atexit(report_sim_stats);
+}
+
+}  // namespace nvhls
+
+#endif  // NVHLS_SIM_STATS_H
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_assert.h>
+#include <AddressGenerator.h>
+#include <Scratchpad.h>
+#include <testbench/nvhls_rand.h>
+#include <deque>
+#include <vector>
+
+typedef NVUINTW(32) Word_t;
+static const unsigned int kAddrWidth = 12;
+static const unsigned int kLanes = 3;
+static const unsigned int kDims = 4;
+typedef AddressGenerator<Word_t, kAddrWidth, kLanes, kDims, 8> Agu;
+typedef Agu::Descriptor Desc;
+typedef Agu::Req Req;
+static const unsigned int kAddrMask = (1u << kAddrWidth) - 1;
+static const int kNumDescs = 200;
+
+// A lane: valid and, when valid, its address
+struct Lane {
+  bool valid;
+  unsigned int addr;
+};
+
+bool InWindow(unsigned int i, unsigned int pad, unsigned int size) {
+  return i >= pad && i < pad + size;
+}
+
+// The loop nest of desc, kLanes iterations of dimension 0 per request
+void Reference(const Desc& desc, std::deque<std::vector<Lane> >& reqs) {
+  unsigned int count[kDims], i[kDims];
+  for (unsigned int d = 0; d < kDims; d++) count[d] = desc.count[d];
+  for (i[3] = 0; i[3] < count[3]; i[3]++) {
+    for (i[2] = 0; i[2] < count[2]; i[2]++) {
+      for (i[1] = 0; i[1] < count[1]; i[1]++) {
+        for (unsigned int row = 0; row < count[0]; row += kLanes) {
+          std::vector<Lane> lanes(kLanes);
+          for (unsigned int j = 0; j < kLanes; j++) {
+            i[0] = row + j;
+            lanes[j].valid = i[0] < count[0];
+            lanes[j].addr = desc.base;
+            for (unsigned int d = 0; d < kDims; d++) {
+              lanes[j].valid = lanes[j].valid && InWindow(i[d], desc.pad[d], desc.size[d]);
+              lanes[j].addr += i[d] * desc.stride[d];
+            }
+            lanes[j].addr &= kAddrMask;
+          }
+          reqs.push_back(lanes);
+        }
+      }
+    }
+  }
+}
+
+Desc RandomDesc() {
+  Desc desc;
+  desc.is_store = rand() % 2;
+  desc.base = rand() & kAddrMask;
+  for (unsigned int d = 0; d < kDims; d++) {
+    // Mostly short loops, a few empty ones, unused outer dimensions
+    desc.count[d] = (d >= 2 && rand() % 2) ? 1 : rand() % 7;
+    desc.stride[d] = (rand() % 4 == 0) ? (kAddrMask + 1 - rand() % 8) & kAddrMask : rand() % 64;
+    desc.pad[d] = rand() % 2;
+    desc.size[d] = rand() % 6;
+  }
+  return desc;
+}
+
+SC_MODULE(testbench) {
+  sc_clock clk;
+  sc_signal<bool> rst;
+
+  Agu agu;
+  Connections::Combinational<Desc> desc;
+  Connections::Combinational<Req> req;
+
+  std::deque<std::vector<Lane> > expected;
+  std::deque<bool> expected_store;
+  unsigned int num_reqs;
+  bool sent;
+
+  SC_CTOR(testbench)
+      : clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true),
+        rst("rst"),
+        agu("agu"),
+        desc("desc"),
+        req("req"),
+        num_reqs(0),
+        sent(false) {
+    Connections::set_sim_clk(&clk);
+    agu.clk(clk);
+    agu.rst(rst);
+    agu.desc_in(desc);
+    agu.req_out(req);
+
+    SC_THREAD(reset);
+    sensitive << clk.posedge_event();
+    SC_THREAD(source);
+    sensitive << clk.posedge_event();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(sink);
+    sensitive << clk.posedge_event();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void reset() {
+    rst = 0;
+    wait(2);
+    rst = 1;
+  }
+
+  void Send(const Desc& d) {
+    std::deque<std::vector<Lane> > reqs;
+    Reference(d, reqs);
+    for (unsigned int r = 0; r < reqs.size(); r++) {
+      expected.push_back(reqs[r]);
+      expected_store.push_back(d.is_store == 1);
+    }
+    desc.Push(d);
+  }
+
+  void source() {
+    desc.ResetWrite();
+    wait();
+    // A padded 2D tile first, to check the rate
+    Desc tile;
+    tile.is_store = 0;
+    tile.base = (0x100 - 65) & kAddrMask;
+    for (unsigned int d = 0; d < kDims; d++) {
+      tile.count[d] = 1;
+      tile.stride[d] = 0;
+      tile.pad[d] = 0;
+      tile.size[d] = 1;
+    }
+    tile.count[0] = 10;
+    tile.stride[0] = 1;
+    tile.pad[0] = 1;
+    tile.size[0] = 8;
+    tile.count[1] = 10;
+    tile.stride[1] = 64;
+    tile.pad[1] = 1;
+    tile.size[1] = 8;
+    Send(tile);
+    for (int i = 0; i < kNumDescs; i++) {
+      Send(RandomDesc());
+    }
+    sent = true;
+    while (!expected.empty()) wait();
+    wait(5);
+    sc_stop();
+  }
+
+  void sink() {
+    req.ResetRead();
+    wait();
+    sc_time first, last;
+    const unsigned int tile_reqs = 10 * 4;
+    while (1) {
+      Req r = req.Pop();
+      if (num_reqs == 0) first = sc_time_stamp();
+      if (num_reqs == tile_reqs - 1) last = sc_time_stamp();
+      NVHLS_ASSERT_MSG(!expected.empty(), "Unexpected request");
+      std::vector<Lane> lanes = expected.front();
+      expected.pop_front();
+      NVHLS_ASSERT_MSG((r.is_store == 1) == expected_store.front(), "Wrong request type");
+      expected_store.pop_front();
+      for (unsigned int j = 0; j < kLanes; j++) {
+        NVHLS_ASSERT_MSG((r.valids[j] == 1) == lanes[j].valid, "Wrong lane valid");
+        NVHLS_ASSERT_MSG(!lanes[j].valid || r.addr[j] == lanes[j].addr, "Wrong lane address");
+      }
+      if (num_reqs == 4) {
+        // The first request of the first unpadded row, as a ScratchpadClass request
+        cli_req_t<Word_t, kAddrWidth, kLanes> cli;
+        to_cli_req(r, cli);
+        NVHLS_ASSERT_MSG(cli.opcode == LOAD, "Wrong cli_req_t opcode");
+        NVHLS_ASSERT_MSG(!cli.valids[0].to_bool() && cli.valids[1].to_bool() && cli.addr[1] == 0x100,
+                         "Wrong cli_req_t lanes");
+      }
+      num_reqs++;
+      if (num_reqs == tile_reqs) {
+        NVHLS_ASSERT_MSG(last - first == sc_time(tile_reqs - 1, SC_NS), "Tile not issued at full rate");
+      }
+    }
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_start();
+  NVHLS_ASSERT_MSG(tb.sent && tb.expected.empty(), "Requests missing");
+  DCOUT("Checked " << tb.num_reqs << " requests" << endl);
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
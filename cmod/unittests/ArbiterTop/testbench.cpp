@@ -47,7 +47,8 @@ void rotate_right(mask_t& mask)
 
 mask_t reference_arbiter(const mask_t& valid)
 {
-    if (ARBITER_TYPE == Roundrobin) {
+    if (ARBITER_TYPE == Roundrobin || ARBITER_TYPE == RoundrobinPrefix ||
+        ARBITER_TYPE == WeightedRoundrobin) {
       static mask_t iter = 1;
       if (valid == 0)
           return 0;
@@ -71,10 +72,108 @@ mask_t reference_arbiter(const mask_t& valid)
               return iter;
       } while (i<=NUM_INPUTS);
     }
+    if (ARBITER_TYPE == Matrix) {
+      // order[0] has the highest priority; the winner moves to the back
+      static int order[NUM_INPUTS];
+      static bool init = false;
+      if (!init) {
+          for (int i=0; i<NUM_INPUTS; i++)
+              order[i] = NUM_INPUTS-1-i;
+          init = true;
+      }
+      if (valid == 0)
+          return 0;
+
+      for (int i=0; i<NUM_INPUTS; i++) {
+          int winner = order[i];
+          if (valid[winner]) {
+              for (int j=i; j<NUM_INPUTS-1; j++)
+                  order[j] = order[j+1];
+              order[NUM_INPUTS-1] = winner;
+              mask_t result = 0;
+              result[winner] = 1;
+              return result;
+          }
+      }
+    }
     assert(0); // should never get here, valid!=0 but nothing was sellected
     return 0;
 }
 
+// Weighted roundrobin with random weights: an element that stays valid keeps
+// the grant for weight picks in a row, otherwise roundrobin order applies
+void test_weighted()
+{
+    Arbiter<NUM_INPUTS, WeightedRoundrobin> arbiter;
+    unsigned weight[NUM_INPUTS];
+    for (int i=0; i<NUM_INPUTS; i++) {
+        weight[i] = rand()%4;
+        arbiter.set_weight(i, weight[i]);
+    }
+
+    mask_t iter = 1, last = 0;
+    unsigned left = 0;
+    for (int k = 0; k< NUM_ITERS; k++) {
+        mask_t valid = semi_random(k);
+        mask_t ref = 0;
+        if (valid != 0) {
+            if ((valid & last) != 0 && left != 0) {
+                --left;
+                ref = last;
+            } else {
+                do {
+                    rotate_right(iter);
+                } while ((iter & valid) == 0);
+                ref = iter;
+                last = iter;
+                for (int i=0; i<NUM_INPUTS; i++)
+                    if (iter[i])
+                        left = (weight[i] == 0) ? 0 : weight[i] - 1;
+            }
+        }
+        assert(arbiter.pick(valid) == ref);
+    }
+}
+
+// Up to two grants per pick, continuing roundrobin after the last grant
+void test_multi_grant()
+{
+    static const unsigned int NumGrants = 2;
+    typedef MultiGrantArbiter<NUM_INPUTS, NumGrants> multi_t;
+    multi_t arbiter, arbiter_idx;
+
+    mask_t iter = 1;
+    for (int k = 0; k< NUM_ITERS; k++) {
+        mask_t valid = semi_random(k);
+        mask_t ref = 0, last = iter;
+        multi_t::Index ref_idx[NumGrants];
+        unsigned num = 0;
+        for (int i = 0; i< NUM_INPUTS && num < NumGrants; i++) {
+            rotate_right(iter);
+            if ((iter & valid) != 0) {
+                ref |= iter;
+                last = iter;
+                for (int j=0; j<NUM_INPUTS; j++)
+                    if (iter[j])
+                        ref_idx[num] = j;
+                ++num;
+            }
+        }
+        // the next pick starts after the last grant
+        iter = last;
+        assert(arbiter.pick(valid) == ref);
+
+        multi_t::Index idx[NumGrants];
+        bool idx_valid[NumGrants];
+        assert(arbiter_idx.pick(valid, idx, idx_valid) == ref);
+        for (unsigned n = 0; n < NumGrants; ++n) {
+            assert(idx_valid[n] == (n < num));
+            if (n < num)
+                assert(idx[n] == ref_idx[n]);
+        }
+    }
+}
+
 CCS_MAIN(int argc, char *argv[]) { 
     nvhls::set_random_seed();
     mask_t valid,select,ref;
@@ -85,6 +184,8 @@ CCS_MAIN(int argc, char *argv[]) {
         CCS_DESIGN(ArbiterTop)(valid, select);
         assert(ref == select);
     }
+    test_weighted();
+    test_multi_grant();
 
     DCOUT("CMODEL PASS" << endl);
     CCS_RETURN(0) ;
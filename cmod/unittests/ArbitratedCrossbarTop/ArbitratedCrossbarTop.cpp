@@ -22,8 +22,22 @@ void ArbitratedCrossbarTop(DataInArray data_in, OutputIdxArray dest_in,
            ValidInArray valid_in, DataOutArray data_out,
            ValidOutArray valid_out, ReadyArray ready) {
   // Instantiate DUT and reset it
+#ifdef VOQ_ITERATIONS
+  // LEN_INPUT_BUFFER is the length of each virtual output queue
+  static VOQCrossbar<Word_t, NUM_INPUTS, NUM_OUTPUTS,
+                     LEN_INPUT_BUFFER, LEN_OUTPUT_BUFFER, VOQ_ITERATIONS> dut;
+#elif defined(HIER_GROUP)
+  // Groups of HIER_GROUP inputs and outputs, 2-entry intermediate buffers
+  static HierarchicalCrossbar<Word_t, NUM_INPUTS, NUM_OUTPUTS, HIER_GROUP, HIER_GROUP,
+                              LEN_INPUT_BUFFER, 2, LEN_OUTPUT_BUFFER> dut;
+#elif defined(MULTICAST)
+  static MulticastCrossbar<Word_t, NUM_INPUTS, NUM_OUTPUTS,
+                           LEN_INPUT_BUFFER, LEN_OUTPUT_BUFFER> dut;
+#else
   static ArbitratedCrossbar<Word_t, NUM_INPUTS, NUM_OUTPUTS,
-                              LEN_INPUT_BUFFER, LEN_OUTPUT_BUFFER> dut;
+                              LEN_INPUT_BUFFER, LEN_OUTPUT_BUFFER,
+                              Roundrobin, PIPELINED, SHARED_POOL_SIZE> dut;
+#endif
   Word_t data_in_local[NUM_INPUTS];
   OutputIdx dest_in_local[NUM_INPUTS];
   bool valid_in_local[NUM_INPUTS];
@@ -39,7 +53,7 @@ void ArbitratedCrossbarTop(DataInArray data_in, OutputIdxArray dest_in,
     valid_in_local[i] = valid_in[i];
   }
   dut.run(data_in_local,dest_in_local,valid_in_local,data_out_local,valid_out_local,ready_local);
-  if (LEN_OUTPUT_BUFFER > 0) {
+  if (LEN_OUTPUT_BUFFER > 0 || SHARED_POOL_SIZE > 0) {
     dut.pop_all_lanes(valid_out_local);
   }
   #pragma hls_unroll yes
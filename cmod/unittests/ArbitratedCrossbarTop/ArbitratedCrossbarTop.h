@@ -37,10 +37,25 @@ typedef NVUINT16 Word_t;
 #define LEN_OUTPUT_BUFFER 2
 #endif
 
+#ifndef PIPELINED
+#define PIPELINED false
+#endif
+
+// Entries of the output buffer pool shared by all outputs, 0 for private
+// output FIFOs
+#ifndef SHARED_POOL_SIZE
+#define SHARED_POOL_SIZE 0
+#endif
+
 typedef Word_t DataInArray[NUM_INPUTS];
 typedef Word_t DataOutArray[NUM_OUTPUTS];
 static const int log2_outputs = nvhls::index_width<NUM_OUTPUTS>::val;
+#ifdef MULTICAST
+// A mask of destination outputs
+typedef NVUINTW(NUM_OUTPUTS) OutputIdx;
+#else
 typedef NVUINTW(log2_outputs) OutputIdx;
+#endif
 typedef OutputIdx OutputIdxArray[NUM_INPUTS];
 typedef bool ReadyArray[NUM_INPUTS];
 typedef bool ValidInArray[NUM_INPUTS];
@@ -25,9 +25,63 @@ const int g_test_len = 100;
 const int TB_FIFO_LEN = g_test_len + 50;
 static const int kDebugLevel = 1;
 
+// A burst to one output of a crossbar with a shared output buffer pool:
+// the hot output takes its reservation plus every unreserved entry, and the
+// other outputs still get their reserved entries.
+void TestSharedOutputPool() {
+  const unsigned kReserved = 1, kPoolSize = 8;
+  const unsigned kHotEntries = kPoolSize - 3 * kReserved;
+  typedef ArbitratedCrossbar<Word_t, 4, 4, 0, kReserved, Roundrobin, false,
+                             kPoolSize> Xbar;
+  static Xbar xbar;
+  Word_t data_in[4], data_out[4];
+  Xbar::OutputIdx dest_in[4];
+  bool valid_in[4], valid_out[4], ready[4];
+
+  unsigned accepted = 0;
+  for (unsigned cycle = 0; cycle < 2 * kPoolSize; cycle++) {
+    for (unsigned in = 0; in < 4; in++) {
+      data_in[in] = cycle * 4 + in;
+      dest_in[in] = 0;
+      valid_in[in] = true;
+    }
+    xbar.run(data_in, dest_in, valid_in, data_out, valid_out, ready);
+    for (unsigned in = 0; in < 4; in++) {
+      accepted += ready[in];
+    }
+  }
+  NVHLS_ASSERT_MSG(accepted == kHotEntries, "Hot output did not absorb the shared pool");
+  NVHLS_ASSERT_MSG(xbar.isOutputFull(0), "Hot output not full");
+
+  // The other outputs take their reservation only
+  for (unsigned cycle = 0; cycle < 2; cycle++) {
+    for (unsigned in = 0; in < 4; in++) {
+      dest_in[in] = in;
+      valid_in[in] = (in != 0);
+    }
+    xbar.run(data_in, dest_in, valid_in, data_out, valid_out, ready);
+    for (unsigned in = 1; in < 4; in++) {
+      NVHLS_ASSERT_MSG(ready[in] == (cycle == 0), "Reserved entry not available");
+    }
+  }
+
+  // The hot output drains in order
+  Word_t last = 0;
+  for (unsigned i = 0; i < kHotEntries; i++) {
+    NVHLS_ASSERT_MSG(!xbar.isOutputEmpty(0), "Hot output drained early");
+    Word_t data = xbar.pop(0);
+    NVHLS_ASSERT_MSG(i == 0 || data > last, "Hot output out of order");
+    last = data;
+  }
+  NVHLS_ASSERT_MSG(xbar.isOutputEmpty(0), "Hot output not drained");
+  NVHLS_ASSERT_MSG(!xbar.isOutputFull(1), "Shared entries not released");
+  cout << "Shared output pool: " << kHotEntries << " entries absorbed by the hot output" << endl;
+}
+
 CCS_MAIN(int argc, char *argv[]) {
 
     nvhls::set_random_seed();
+    TestSharedOutputPool();
 
     // FIFOs used for storing expected values and then checking
     FIFO< Word_t, TB_FIFO_LEN > tb_fifos[NUM_OUTPUTS][NUM_INPUTS];
@@ -61,7 +115,11 @@ CCS_MAIN(int argc, char *argv[]) {
 
       // Send deterministic data to random destination
       for (unsigned in = 0; in < NUM_INPUTS; in++) {
+#ifdef MULTICAST
+        int dest = rand() % (1 << NUM_OUTPUTS);
+#else
         int dest = rand()%NUM_OUTPUTS;
+#endif
         dest_in[in] = dest;
         data_in[in] = in;
         CDCOUT("data_in[" << dest_in[in] << "][" << in << "] = " << data_in[in] << "\t valid: " << valid_in[in] << endl, kDebugLevel);
@@ -76,7 +134,14 @@ CCS_MAIN(int argc, char *argv[]) {
         CDCOUT("ready[" << in << "] = " << ready[in] << "; ", kDebugLevel);
         if (ready[in]) {
 	        CDCOUT("Pushing " << data_in[in] << " into tb_fifos[" << dest_in[in] << "][" << in << "]" << endl, kDebugLevel);
+#ifdef MULTICAST
+          for (unsigned out = 0; out < NUM_OUTPUTS; out++) {
+            if (dest_in[in][out] == 1)
+              tb_fifos[out][in].push(data_in[in]);
+          }
+#else
           tb_fifos[dest_in[in]][in].push(data_in[in]);
+#endif
         }
       }
 
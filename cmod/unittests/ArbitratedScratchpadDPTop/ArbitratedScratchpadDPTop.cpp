@@ -19,14 +19,15 @@
 
 void ArbitratedScratchpadDPTop(Address read_address[NUM_READ_PORTS], bool read_req_valid[NUM_READ_PORTS],
                     Address write_address[NUM_WRITE_PORTS], bool write_req_valid[NUM_WRITE_PORTS],
-                    DATA_TYPE write_data[NUM_WRITE_PORTS], 
+                    DATA_TYPE write_data[NUM_WRITE_PORTS], WriteMask write_mask[NUM_WRITE_PORTS],
                     bool read_ack[NUM_READ_PORTS], bool write_ack[NUM_WRITE_PORTS], 
                     DATA_TYPE port_read_out[NUM_READ_PORTS], bool port_read_out_valid[NUM_READ_PORTS]) {
-    typedef ArbitratedScratchpadDP<NUM_BANKS, NUM_READ_PORTS, NUM_WRITE_PORTS, NUM_ENTRIES_PER_BANK, DATA_TYPE> scratchpad_t;
+    typedef ArbitratedScratchpadDP<NUM_BANKS, NUM_READ_PORTS, NUM_WRITE_PORTS, NUM_ENTRIES_PER_BANK, DATA_TYPE,
+                                   true, false, BankMapLowBits, NUM_BYTE_ENABLES, WRITE_COMBINE> scratchpad_t;
     static scratchpad_t scratchpad_inst;
     bool read_ready[NUM_READ_PORTS];
     scratchpad_inst.run(read_address, read_req_valid,
-                        write_address, write_req_valid, write_data,
+                        write_address, write_req_valid, write_data, write_mask,
                         read_ack, write_ack, read_ready,
                         port_read_out, port_read_out_valid);
  
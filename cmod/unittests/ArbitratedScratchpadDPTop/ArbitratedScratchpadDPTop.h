@@ -41,16 +41,25 @@
 #define DATA_TYPE NVUINT32
 #endif
 
+#ifndef NUM_BYTE_ENABLES
+#define NUM_BYTE_ENABLES 1
+#endif
+
+#ifndef WRITE_COMBINE
+#define WRITE_COMBINE false
+#endif
+
 const unsigned int kNumBanks = NUM_BANKS;
 const unsigned int kNumReadPorts = NUM_READ_PORTS;
 const unsigned int kNumWritePorts = NUM_WRITE_PORTS;
 const unsigned int kEntriesPerBank = NUM_ENTRIES_PER_BANK;
 const unsigned int kAddressSize = nvhls::index_width<NUM_BANKS * NUM_ENTRIES_PER_BANK>::val;
 typedef NVUINTW(kAddressSize) Address;
+typedef NVUINTW(NUM_BYTE_ENABLES) WriteMask;
 
 void ArbitratedScratchpadDPTop(Address read_address[NUM_READ_PORTS], bool read_req_valid[NUM_READ_PORTS],
                     Address write_address[NUM_WRITE_PORTS], bool write_req_valid[NUM_WRITE_PORTS],
-                    DATA_TYPE write_data[NUM_WRITE_PORTS], 
+                    DATA_TYPE write_data[NUM_WRITE_PORTS], WriteMask write_mask[NUM_WRITE_PORTS],
                     bool read_ack[NUM_READ_PORTS], bool write_ack[NUM_WRITE_PORTS], 
 		    DATA_TYPE port_read_out[NUM_READ_PORTS], bool port_read_out_valid[NUM_READ_PORTS]);
 
@@ -56,6 +56,22 @@ bool check_response(DATA_TYPE port_read_out[kNumReadPorts], bool port_read_out_v
 
 static const int kDebugLevel = 1;
 
+#ifndef NUM_MIXED_ITERS
+#define NUM_MIXED_ITERS 10000
+#endif
+
+// Slices of data selected by mask, over base
+DATA_TYPE merge_slices(DATA_TYPE base, DATA_TYPE data, WriteMask mask) {
+  const unsigned kSliceWidth = DATA_TYPE::width / NUM_BYTE_ENABLES;
+  DATA_TYPE merged = base;
+  for (unsigned i = 0; i < NUM_BYTE_ENABLES; i++) {
+    if (mask[i]) {
+      merged = nvhls::set_slc(merged, nvhls::get_slc<kSliceWidth>(data, i * kSliceWidth), i * kSliceWidth);
+    }
+  }
+  return merged;
+}
+
 CCS_MAIN (int argc, char *argv[]) {
 
   nvhls::set_random_seed();
@@ -65,6 +81,7 @@ CCS_MAIN (int argc, char *argv[]) {
   Address write_address[kNumWritePorts];
   bool write_req_valid[kNumWritePorts];
   DATA_TYPE write_data[kNumWritePorts]; 
+  WriteMask write_mask[kNumWritePorts];
   bool read_ack[kNumReadPorts];
   bool write_ack[kNumWritePorts];
   DATA_TYPE port_read_out[kNumReadPorts];
@@ -78,6 +95,7 @@ CCS_MAIN (int argc, char *argv[]) {
     write_address[k] = 0; 
     write_req_valid[k] = false;
     write_data[k] = 0; 
+    write_mask[k] = ~static_cast<WriteMask>(0);
   }
   for (unsigned i = 0; i < kNumBanks*kEntriesPerBank/kNumWritePorts; i++) {
     for (unsigned k = 0; k < kNumWritePorts; k++) {
@@ -89,7 +107,7 @@ CCS_MAIN (int argc, char *argv[]) {
     complete = false;
     while (!complete) {
       CCS_DESIGN(ArbitratedScratchpadDPTop)(read_address, read_req_valid,
-                        write_address, write_req_valid, write_data, 
+                        write_address, write_req_valid, write_data, write_mask,
                         read_ack, write_ack, 
                         port_read_out, port_read_out_valid);
       complete = true;
@@ -152,6 +170,37 @@ CCS_MAIN (int argc, char *argv[]) {
     }
   }
 
+  // Partial writes and reads, to few addresses so that writes combine and
+  // reads hit the write-combining buffers. A read sees the writes acked
+  // before it and, with store forwarding, in the same cycle.
+  for (unsigned i = 0; i < NUM_MIXED_ITERS; i++) {
+    for (unsigned k = 0; k < kNumWritePorts; k++) {
+      write_address[k] = rand() % (2 * kNumBanks);
+      write_req_valid[k] = rand() % 2;
+      write_data[k] = get_rand_data();
+      write_mask[k] = rand();
+    }
+    for (unsigned k = 0; k < kNumReadPorts; k++) {
+      read_address[k] = rand() % (2 * kNumBanks);
+      read_req_valid[k] = rand() % 2;
+    }
+    CCS_DESIGN(ArbitratedScratchpadDPTop)(read_address, read_req_valid,
+                      write_address, write_req_valid, write_data, write_mask,
+                      read_ack, write_ack, 
+                      port_read_out, port_read_out_valid);
+    for (unsigned k = 0; k < kNumWritePorts; k++) {
+      if (write_ack[k]) {
+        ref_mem[write_address[k]] = merge_slices(ref_mem[write_address[k]], write_data[k], write_mask[k]);
+      }
+    }
+    for (unsigned k = 0; k < kNumReadPorts; k++) {
+      if (read_ack[k]) {
+        assert(port_read_out_valid[k]);
+        assert(port_read_out[k] == ref_mem[read_address[k]]);
+      }
+    }
+  }
+
   CCS_RETURN(0);
 
 }
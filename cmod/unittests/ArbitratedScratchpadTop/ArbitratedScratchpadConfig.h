@@ -20,6 +20,7 @@
 #include "nvhls_int.h"
 #include "nvhls_types.h"
 #include "ArbitratedScratchpad/ArbitratedScratchpadTypes.h"
+#include "bank_mapping.h"
 
 #ifndef DATA_TYPE
 #define DATA_TYPE NVUINT32
@@ -41,6 +42,18 @@
 #define LEN_INPUT_BUFFER 0
 #endif
 
+#ifndef BANK_MAP
+#define BANK_MAP BankMapLowBits
+#endif
+
+#ifndef COALESCE_READS
+#define COALESCE_READS false
+#endif
+
+#ifndef ATOMICS
+#define ATOMICS false
+#endif
+
 const unsigned NumBanks            = NUM_BANKS;
 const unsigned ScratchpadCapacity  = NUM_BANKS * NUM_BANK_ENTRIES;
 const unsigned ScratchpadAddrWidth = nvhls::nbits<ScratchpadCapacity - 1>::val;
@@ -49,9 +62,14 @@ const unsigned InputQueueLength    = LEN_INPUT_BUFFER;
 const unsigned RefMemSizeInBytes   = 16 * 1024 * 1024;
 
 typedef DATA_TYPE DataType;
+typedef BANK_MAP BankMap;
 
 // client request and response types with TB parameters
+#if ATOMICS
+typedef cli_atomic_req_t<DataType, ScratchpadAddrWidth, NumInputs> tb_cli_req_t;
+#else
 typedef cli_req_t<DataType, ScratchpadAddrWidth, NumInputs> tb_cli_req_t;
+#endif
 typedef cli_rsp_t<DataType, NumInputs> tb_cli_rsp_t;
 
 #endif  // end ARBITRATED_SCRATCHPAD_TOP_CONFIG_H
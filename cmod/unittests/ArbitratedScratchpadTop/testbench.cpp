@@ -34,6 +34,13 @@
 #define NUM_ITERS 10000
 #endif
 
+#if ATOMICS
+#include <algorithm>
+#include <deque>
+#include <utility>
+#include <vector>
+#endif
+
 typedef NVUINTC(ScratchpadAddrWidth) LoadAddrType;
 const int LoadAddrFifoLen = NUM_ITERS*2;
 FIFO<LoadAddrType, LoadAddrFifoLen> load_addr_fifo[NumBanks][NumInputs];
@@ -195,7 +202,7 @@ CCS_MAIN(int argc, char *argv[]) {
 
             // Push the load address into a FIFO since the load request could be
             // serviced out of order in the event of a bank conflict.
-            int bank_idx = curr_cli_req.addr[j] % NumBanks;
+            int bank_idx = BankMap::bank<NumBanks, ScratchpadAddrWidth>(curr_cli_req.addr[j]);
             load_addr_fifo[bank_idx][j].push(curr_cli_req.addr[j]);
           }
         }
@@ -276,9 +283,13 @@ CCS_MAIN(int argc, char *argv[]) {
     curr_cli_req.type.val = CLITYPE_T::LOAD;
 
     requested = false;
+    // With read coalescing, broadcast one address to half of the inputs
+    // every other iteration
+    bool broadcast = COALESCE_READS && (rand()%2 == 0);
+    unsigned broadcast_addr = rand()%ScratchpadCapacity;
     for(unsigned i=0; i<NumInputs; i++) {
       curr_cli_req.data[i] = rand();
-      curr_cli_req.addr[i] = rand()%ScratchpadCapacity;
+      curr_cli_req.addr[i] = (broadcast && rand()%2) ? broadcast_addr : rand()%ScratchpadCapacity;
       bool valid = rand()%2;
       curr_cli_req.valids[i] = valid;
       requested = requested || valid; // Track whether at least one request was valid
@@ -293,7 +304,7 @@ CCS_MAIN(int argc, char *argv[]) {
         // Push the load address into a FIFO since the load request could be
         // serviced out of order in the event of a bank conflict.
         if(curr_cli_req.valids[i]) {
-          int bank_idx = curr_cli_req.addr[i] % NumBanks;
+          int bank_idx = BankMap::bank<NumBanks, ScratchpadAddrWidth>(curr_cli_req.addr[i]);
           load_addr_fifo[bank_idx][i].push(curr_cli_req.addr[i]);
           CDCOUT("Pushing addr"          << curr_cli_req.addr[i]
                    << " into load_addr_fifo[" << bank_idx << "][" << i << "]" << endl, kDebugLevel);
@@ -303,6 +314,159 @@ CCS_MAIN(int argc, char *argv[]) {
     assert(!requested || served); // At least one request should have been served or nothing was requested
     refmem.check_response(curr_cli_rsp);
   }
+#if ATOMICS
+  // ----------------------------------------
+  // Atomics on one address at a time, so that the responses of each input
+  // come back in request order. Idle cycles let the queued requests of a
+  // phase complete before the next one starts.
+  // ----------------------------------------
+  for (unsigned i=0; i<NumInputs; i++) {
+    curr_cli_req.cmp[i] = 0;
+    curr_cli_req.valids[i] = false;
+  }
+  for (int it=0; it<NUM_ITERS/100; it++) {
+    CCS_DESIGN(ArbitratedScratchpadTop)(curr_cli_req, curr_cli_rsp, ready);
+    refmem.check_response(curr_cli_rsp);
+  }
+  unsigned hot = rand()%ScratchpadCapacity;
+  const unsigned init = 1000;
+  curr_cli_req.op.val = CLIATOMIC_T::NONE;
+  curr_cli_req.type.val = CLITYPE_T::STORE;
+  for (unsigned i=0; i<NumInputs; i++) {
+    curr_cli_req.valids[i] = (i == 0);
+    curr_cli_req.addr[i] = hot;
+    curr_cli_req.data[i] = init;
+  }
+  for (int it=0; it<NUM_ITERS/100; it++) {
+    CCS_DESIGN(ArbitratedScratchpadTop)(curr_cli_req, curr_cli_rsp, ready);
+    if (ready[0]) {
+      curr_cli_req.valids[0] = false;
+    }
+  }
+  assert(!curr_cli_req.valids[0]);
+
+  // Fetch-and-add from every input: sorted by old value, the old values
+  // must chain up by the operands, without a gap or a repeat
+  curr_cli_req.op.val = CLIATOMIC_T::ADD;
+  std::deque<unsigned> pending[NumInputs];
+  std::vector<std::pair<unsigned, unsigned> > adds;
+  unsigned sent = 0;
+  for (int it=0; it<NUM_ITERS/10 + NUM_ITERS/100; it++) {
+    bool issue = (it < NUM_ITERS/10);
+    for (unsigned i=0; i<NumInputs; i++) {
+      curr_cli_req.valids[i] = issue && (rand()%2 == 0);
+      curr_cli_req.data[i] = 1 + rand()%255;
+    }
+    CCS_DESIGN(ArbitratedScratchpadTop)(curr_cli_req, curr_cli_rsp, ready);
+    for (unsigned i=0; i<NumInputs; i++) {
+      if (curr_cli_req.valids[i] && ready[i]) {
+        pending[i].push_back(curr_cli_req.data[i].to_uint());
+        sent++;
+      }
+      if (curr_cli_rsp.valids[i]) {
+        assert(!pending[i].empty());
+        adds.push_back(std::make_pair(curr_cli_rsp.data[i].to_uint(), pending[i].front()));
+        pending[i].pop_front();
+      }
+    }
+  }
+  assert(adds.size() == sent);
+  std::sort(adds.begin(), adds.end());
+  unsigned expected = init;
+  for (unsigned k=0; k<adds.size(); k++) {
+    assert(adds[k].first == expected);
+    expected += adds[k].second;
+  }
+  CDCOUT(sent << " fetch-and-adds, final value " << expected << endl, kDebugLevel);
+
+  // Max, then min from every input
+  unsigned ops[2] = {CLIATOMIC_T::MAX, CLIATOMIC_T::MIN};
+  for (unsigned o=0; o<2; o++) {
+    curr_cli_req.op.val = ops[o];
+    for (int it=0; it<NUM_ITERS/50; it++) {
+      bool issue = (it < NUM_ITERS/100);
+      for (unsigned i=0; i<NumInputs; i++) {
+        curr_cli_req.valids[i] = issue && (rand()%2 == 0);
+        curr_cli_req.data[i] = rand()%(2*expected);
+      }
+      CCS_DESIGN(ArbitratedScratchpadTop)(curr_cli_req, curr_cli_rsp, ready);
+      for (unsigned i=0; i<NumInputs; i++) {
+        if (curr_cli_req.valids[i] && ready[i]) {
+          unsigned data = curr_cli_req.data[i].to_uint();
+          expected = (ops[o] == CLIATOMIC_T::MAX) ? std::max(expected, data) : std::min(expected, data);
+        }
+      }
+    }
+  }
+
+  // Compare-and-swap increments: every input retries with the old value it
+  // got back, and the value ends up counting the successful swaps
+  curr_cli_req.op.val = CLIATOMIC_T::CAS;
+  unsigned hot_start = 0;
+  bool waiting[NumInputs];
+  unsigned guess[NumInputs];
+  unsigned successes = 0;
+  for (unsigned i=0; i<NumInputs; i++) {
+    waiting[i] = false;
+    guess[i] = 0;
+    curr_cli_req.valids[i] = false;
+  }
+  for (int it=0; it<NUM_ITERS/10 + NUM_ITERS/100; it++) {
+    bool issue = (it < NUM_ITERS/10);
+    for (unsigned i=0; i<NumInputs; i++) {
+      if (!curr_cli_req.valids[i] && !waiting[i] && issue) {
+        curr_cli_req.valids[i] = true;
+        curr_cli_req.cmp[i] = guess[i];
+        curr_cli_req.data[i] = guess[i] + 1;
+      }
+    }
+    CCS_DESIGN(ArbitratedScratchpadTop)(curr_cli_req, curr_cli_rsp, ready);
+    for (unsigned i=0; i<NumInputs; i++) {
+      if (curr_cli_req.valids[i] && ready[i]) {
+        curr_cli_req.valids[i] = false;
+        waiting[i] = true;
+      }
+      if (curr_cli_rsp.valids[i]) {
+        assert(waiting[i]);
+        waiting[i] = false;
+        unsigned old = curr_cli_rsp.data[i].to_uint();
+        if (old == guess[i]) {
+          successes++;
+          guess[i] = old + 1;
+        } else {
+          guess[i] = old;
+        }
+        if (hot_start == 0 && successes == 1) {
+          hot_start = old;
+        }
+      }
+    }
+  }
+  assert(successes > 0);
+  assert(hot_start == expected);
+  expected += successes;
+
+  // Read the address back
+  curr_cli_req.op.val = CLIATOMIC_T::NONE;
+  curr_cli_req.type.val = CLITYPE_T::LOAD;
+  for (unsigned i=0; i<NumInputs; i++) {
+    curr_cli_req.valids[i] = (i == 0);
+    curr_cli_req.addr[i] = hot;
+  }
+  bool loaded = false;
+  for (int it=0; it<NUM_ITERS/100 && !loaded; it++) {
+    CCS_DESIGN(ArbitratedScratchpadTop)(curr_cli_req, curr_cli_rsp, ready);
+    if (ready[0]) {
+      curr_cli_req.valids[0] = false;
+    }
+    if (curr_cli_rsp.valids[0]) {
+      assert(curr_cli_rsp.data[0] == expected);
+      loaded = true;
+    }
+  }
+  assert(loaded);
+  CDCOUT(successes << " compare-and-swaps, final value " << expected << endl, kDebugLevel);
+#endif
   DCOUT("CMODEL PASS" << endl);
   CCS_RETURN(0);
 }
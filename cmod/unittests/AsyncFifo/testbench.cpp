@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <testbench/nvhls_rand.h>
+#include <testbench/SourceSink.h>
+#include <AsyncFifo.h>
+
+#ifndef NUM_MESSAGES
+#define NUM_MESSAGES 2000
+#endif
+
+typedef NVUINTW(32) Word_t;
+
+// One Source -> AsyncChannel -> Sink lane from the enq to the deq clock
+SC_MODULE(Lane) {
+  sc_in_clk enq_clk;
+  sc_in<bool> enq_rst;
+  sc_in_clk deq_clk;
+  sc_in<bool> deq_rst;
+
+  nvhls::GoldenQueue<Word_t> golden;
+  nvhls::Source<Word_t> src;
+  AsyncChannel<Word_t, 8> cdc;
+  nvhls::Sink<Word_t> sink;
+
+  Lane(sc_module_name name, double rate, const Pacer& pacer)
+      : sc_module(name),
+        enq_clk("enq_clk"),
+        enq_rst("enq_rst"),
+        deq_clk("deq_clk"),
+        deq_rst("deq_rst"),
+        src("src", &golden),
+        cdc("cdc"),
+        sink("sink", &golden, pacer) {
+    src.clk(enq_clk);
+    src.rst(enq_rst);
+    cdc.enq_clk(enq_clk);
+    cdc.enq_rst(enq_rst);
+    cdc.deq_clk(deq_clk);
+    cdc.deq_rst(deq_rst);
+    sink.clk(deq_clk);
+    sink.rst(deq_rst);
+
+    src.out(cdc.in);
+    sink.in(cdc.out);
+
+    src.injection_rate = rate;
+    src.random_count = NUM_MESSAGES;
+  }
+
+  bool Done() const { return src.Done() && golden.empty(); }
+
+  // Latencies mix the cycles of two clocks, so only order and count are checked
+  void Report() {
+    NVHLS_ASSERT_MSG(sink.received == NUM_MESSAGES, "Sink did not receive every message");
+    DCOUT(name() << ": " << sink.received << " messages, source " << src.Throughput() << " sink "
+                 << sink.Throughput() << " per cycle" << endl);
+  }
+};
+
+SC_MODULE(testbench) {
+  sc_clock fast_clk;
+  sc_clock slow_clk;
+  sc_signal<bool> fast_rst;
+  sc_signal<bool> slow_rst;
+
+  Lane fast_to_slow;
+  Lane slow_to_fast;
+  Lane stalled;
+
+  SC_CTOR(testbench)
+      : fast_clk("fast_clk", 0.5, SC_NS, 0.5, 0, SC_NS, true),
+        slow_clk("slow_clk", 1.3, SC_NS, 0.5, 0.2, SC_NS, true),
+        fast_rst("fast_rst"),
+        slow_rst("slow_rst"),
+        fast_to_slow("fast_to_slow", 1.0, Pacer(0, 0)),
+        slow_to_fast("slow_to_fast", 1.0, Pacer(0, 0)),
+        stalled("stalled", 1.0, Pacer(0.3, 0.7)) {
+    Connections::set_sim_clk(&fast_clk);
+    fast_to_slow.enq_clk(fast_clk);
+    fast_to_slow.enq_rst(fast_rst);
+    fast_to_slow.deq_clk(slow_clk);
+    fast_to_slow.deq_rst(slow_rst);
+    slow_to_fast.enq_clk(slow_clk);
+    slow_to_fast.enq_rst(slow_rst);
+    slow_to_fast.deq_clk(fast_clk);
+    slow_to_fast.deq_rst(fast_rst);
+    stalled.enq_clk(fast_clk);
+    stalled.enq_rst(fast_rst);
+    stalled.deq_clk(slow_clk);
+    stalled.deq_rst(slow_rst);
+
+    SC_THREAD(run);
+    sensitive << slow_clk.posedge_event();
+  }
+
+  void run() {
+    fast_rst = 0;
+    slow_rst = 0;
+    wait(10);
+    fast_rst = 1;
+    wait(3);
+    slow_rst = 1;
+    unsigned int cycles = 0;
+    while (!(fast_to_slow.Done() && slow_to_fast.Done() && stalled.Done())) {
+      wait();
+      NVHLS_ASSERT_MSG(++cycles < 100 * NUM_MESSAGES, "Timed out");
+    }
+    wait(5);
+    fast_to_slow.Report();
+    slow_to_fast.Report();
+    stalled.Report();
+    // The slower side of an unstalled lane streams at its own clock
+    NVHLS_ASSERT_MSG(fast_to_slow.sink.Throughput() > 0.9, "Fast-to-slow lane does not stream");
+    NVHLS_ASSERT_MSG(slow_to_fast.src.Throughput() > 0.9, "Slow-to-fast lane does not stream");
+    DCOUT("CMODEL PASS" << endl);
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_start();
+  return 0;
+}
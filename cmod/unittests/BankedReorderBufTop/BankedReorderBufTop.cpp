@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hls_globals.h>
+#include <nvhls_assert.h>
+#include "BankedReorderBufTop.h"
+
+void BankedReorderBufTop( const OpType& op,
+                          const DataType in_data[ROB_K],
+                          const Rob::Id in_id[ROB_K],
+                          const Rob::LaneMask& in_mask,
+                          const Rob::Count& in_count,
+                          Rob::Id& out_id,
+                          Rob::Count& out_count,
+                          DataType out_data[ROB_K],
+                          bool& out_resp)
+{
+    static Rob rob;
+    out_id = 0; out_count = 0; out_resp = false;
+    #pragma hls_unroll yes
+    for (int i=0; i<ROB_K; ++i) out_data[i] = 0;
+    switch (op)
+    {
+        case canAccept:     out_resp  =  rob.canAcceptRequest();                       break;
+        case addRequest:    out_id    =  rob.addRequest();                             break;
+        case top:           out_count =  rob.topResponsesReady();                      break;
+        case addResponses:               rob.addResponses(in_id, in_data, in_mask);    break;
+        case popResponses:               rob.popResponses(out_data, in_count);         break;
+        case reset:                      rob.reset();                                  break;
+        case isEmpty:       out_resp  =  rob.isEmpty();                                break;
+        default:
+            NVHLS_ASSERT_MSG(0, "op not supported"); //never get here
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BANKEDREORDERBUF_TOP_H
+#define BANKEDREORDERBUF_TOP_H
+
+#include <ReorderBuf.h>
+#include <hls_globals.h>
+#include <nvhls_assert.h>
+
+#ifndef ROB_DATA
+#define ROB_DATA NVUINTC(16)
+#endif
+
+#ifndef ROB_DEPTH
+#define ROB_DEPTH 8
+#endif
+
+#ifndef ROB_INFLIGHT
+#define ROB_INFLIGHT 6
+#endif
+
+#ifndef ROB_K
+#define ROB_K 4
+#endif
+
+
+enum RobOp {
+    canAccept=0,
+    addRequest,
+    top,
+    addResponses,
+    popResponses,
+    reset,
+    isEmpty,
+    MAXOP
+};
+
+typedef ROB_DATA DataType;
+typedef BankedReorderBuf<DataType, ROB_DEPTH, ROB_INFLIGHT, ROB_K> Rob;
+typedef NVUINTC(nvhls::nbits<MAXOP -1 >::val) OpType;
+
+void BankedReorderBufTop( const OpType& op,
+                          const DataType in_data[ROB_K],
+                          const Rob::Id in_id[ROB_K],
+                          const Rob::LaneMask& in_mask,
+                          const Rob::Count& in_count,
+                          Rob::Id& out_id,
+                          Rob::Count& out_count,
+                          DataType out_data[ROB_K],
+                          bool& out_resp);
+
+#endif
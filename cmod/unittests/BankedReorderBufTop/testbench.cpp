@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BankedReorderBufTop.h"
+#include <match_scverify.h>
+#include <testbench/nvhls_rand.h>
+
+#include <deque>
+
+#ifndef NUM_ITER
+#define NUM_ITER 10000
+#endif
+
+
+// Reference: requests in arrival order, drained from the front once their
+// responses have arrived
+template <typename Data, unsigned int Depth, unsigned int InFlight,
+          unsigned int K>
+class BankedRobRef
+{
+    public:
+
+    BankedRobRef() { reset(); };
+    typedef Rob::Id Id;
+
+    private:
+
+    struct Entry {
+        int id;
+        bool valid;
+        Data data;
+    };
+
+    typedef std::deque<Entry> Storage;
+    Storage storage;
+
+    unsigned int inflight;
+
+    public:
+
+    bool canAcceptRequest() const
+    {
+        return ((inflight < InFlight) && (storage.size()<Depth));
+    }
+
+    void addRequest(const Id& dut_id)
+    {
+        assert(canAcceptRequest());
+
+        for (typename Storage::iterator it=storage.begin(); it!=storage.end(); ++it)
+        {
+            assert ((*it).id != static_cast<int>(dut_id));
+        }
+
+        Entry entry;
+
+        entry.id = dut_id;
+        entry.valid = false;
+
+        storage.push_back(entry);
+        ++inflight;
+    }
+
+    unsigned int topResponsesReady() const
+    {
+        unsigned int ready = 0;
+        for (typename Storage::const_iterator it=storage.begin();
+             it!=storage.end() && ready<K && (*it).valid; ++it)
+        {
+            ++ready;
+        }
+        return ready;
+    }
+
+    void addResponse(const Id& id, const Data& data)
+    {
+        bool found = false;
+        for (typename Storage::iterator it=storage.begin(); it!=storage.end(); ++it)
+        {
+            if ((*it).id == static_cast<int>(id))
+            {
+                assert(!found); //should find only once
+                found = true;
+
+                assert((*it).valid == false);
+                (*it).valid = true;
+                (*it).id = -1;
+
+                (*it).data = data;
+            }
+        }
+        assert(found);
+        --inflight;
+    }
+
+    Data popResponse()
+    {
+        assert(!storage.empty() && storage.front().valid);
+        Data data = storage.front().data;
+        storage.pop_front();
+        return data;
+    }
+
+    void reset()
+    {
+        inflight = 0;
+        storage.clear();
+    }
+
+    bool isEmpty() const
+    {
+        return storage.empty();
+    }
+
+    // Ids of responses still outstanding
+    std::deque<Id> pendingResponseIds() const
+    {
+        std::deque<Id> pending;
+
+        for (typename Storage::const_iterator it=storage.begin(); it!=storage.end(); ++it)
+        {
+            if ((*it).valid == false) pending.push_back((*it).id);
+        }
+        return pending;
+    }
+};
+
+
+typedef BankedRobRef<ROB_DATA, ROB_DEPTH, ROB_INFLIGHT, ROB_K> Ref;
+
+OpType semi_rand_op(Ref& ref)
+{
+    OpType op;
+
+    do {
+        op = rand()%MAXOP;
+    } while (
+                ((op == addRequest) && (!ref.canAcceptRequest())) ||
+                ((op == addResponses) && (ref.pendingResponseIds().empty())) ||
+                ((op == popResponses) && (ref.topResponsesReady() == 0))
+            );
+    return op;
+}
+
+CCS_MAIN(int argc, char *argv[]) {
+
+    nvhls::set_random_seed();
+
+    Ref ref;
+
+    for (int i=0; i< NUM_ITER; ++i)
+    {
+        OpType op = semi_rand_op(ref);
+        ROB_DATA in_data[ROB_K], out_data[ROB_K];
+        Ref::Id in_id[ROB_K], out_id;
+        Rob::LaneMask in_mask = 0;
+        Rob::Count in_count = 0, out_count;
+        bool out_resp;
+
+        // Each lane carries a distinct pending response with probability 1/2
+        std::deque<Ref::Id> pending = ref.pendingResponseIds();
+        for (int k=0; k<ROB_K; ++k)
+        {
+            in_data[k] = rand();
+            in_id[k] = 0;
+            if (!pending.empty() && (rand()%2 == 0))
+            {
+                int rnd_idx = rand()%pending.size();
+                in_id[k] = pending[rnd_idx];
+                in_mask[k] = 1;
+                pending.erase(pending.begin() + rnd_idx);
+            }
+        }
+        if (op == popResponses) in_count = 1 + rand()%ref.topResponsesReady();
+
+        CCS_DESIGN(BankedReorderBufTop)(op, in_data, in_id, in_mask, in_count, out_id, out_count, out_data, out_resp);
+
+#ifdef DEBUGMODE
+        cout << "\top = " << op
+                << "\tin_mask = " << in_mask
+                << "\tin_count = " << in_count
+                << "\tout_id = " << out_id
+                << "\tout_count = " << out_count
+                << "\tout_resp = " << out_resp
+                << endl;
+#endif
+
+        switch (op)
+        {
+            case canAccept:
+                            assert(out_resp == ref.canAcceptRequest());
+                            break;
+
+            case addRequest:
+                            ref.addRequest(out_id);
+                            break;
+
+            case top:
+                            assert(out_count == ref.topResponsesReady());
+                            break;
+
+            case addResponses:
+                            for (int k=0; k<ROB_K; ++k)
+                            {
+                                if (in_mask[k]) ref.addResponse(in_id[k], in_data[k]);
+                            }
+                            break;
+
+            case popResponses:
+                            for (unsigned int k=0; k<in_count; ++k)
+                            {
+                                assert(out_data[k] == ref.popResponse());
+                            }
+                            break;
+
+            case reset:
+                            ref.reset();
+                            break;
+
+            case isEmpty:
+                            assert(out_resp == ref.isEmpty());
+                            break;
+
+            default:
+            assert(0);
+        }
+    }
+
+    DCOUT("CMODEL PASS" << endl);
+    CCS_RETURN(0) ;
+}
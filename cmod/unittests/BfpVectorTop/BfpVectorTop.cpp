@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "BfpVectorTop.h"
+
+void BfpVectorTop(const Bfp& a, const Bfp& b, const Bfp& c, Bfp& mac_out,
+                  Bfp::DotType& dot, Bfp::ProdExp& dot_exp) {
+  nvhls::dp(a, b, dot, dot_exp);
+  nvhls::vector_mac(a, b, c, mac_out);
+}
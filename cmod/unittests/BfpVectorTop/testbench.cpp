@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <algorithm>
+#include <cmath>
+#include <match_scverify.h>
+#include <testbench/nvhls_rand.h>
+
+#include "BfpVectorTop.h"
+
+#ifndef NUM_ITERS
+#define NUM_ITERS 1000
+#endif
+
+typedef nvhls::nv_scvector<NVINT16, BLOCK_SIZE> IntVector;
+
+double value(const Bfp& v, unsigned i) {
+  return std::ldexp(static_cast<double>(v.signed_mant(i).to_int()), v.exp.to_int());
+}
+
+// Random block with a random magnitude range and scale
+Bfp random_block(IntVector& x, int& x_exp) {
+  int range = rand() % 16;
+  for (unsigned i = 0; i < BLOCK_SIZE; i++) {
+    x[i] = (rand() % 65536 - 32768) >> range;
+  }
+  x_exp = rand() % 41 - 20;
+  Bfp v;
+  v.quantize(x, x_exp);
+
+  // Truncation toward zero, below one unit of the shared exponent
+  unsigned all = 0;
+  for (unsigned i = 0; i < BLOCK_SIZE; i++) {
+    double exact = std::ldexp(static_cast<double>(x[i].to_int()), x_exp);
+    assert(std::fabs(exact - value(v, i)) < std::ldexp(1.0, v.exp.to_int()));
+    assert(std::fabs(value(v, i)) <= std::fabs(exact));
+    all |= v.mant[i].to_uint();
+  }
+  if (v.exp != x_exp) {
+    assert(all >> (MANT_WIDTH - 1));
+  }
+
+  if (rand() & 1) {
+    Bfp n = v;
+    n.normalize();
+    for (unsigned i = 0; i < BLOCK_SIZE; i++) {
+      assert(value(n, i) == value(v, i));
+    }
+    unsigned n_all = 0;
+    for (unsigned i = 0; i < BLOCK_SIZE; i++) {
+      n_all |= n.mant[i].to_uint();
+    }
+    assert(all == 0 || (n_all >> (MANT_WIDTH - 1)));
+    v = n;
+  }
+  return v;
+}
+
+CCS_MAIN(int argc, char *argv[])
+{
+  nvhls::set_random_seed();
+
+  for (int iter = 0; iter < NUM_ITERS; ++iter)
+  {
+    IntVector xa, xb, xc;
+    int ea, eb, ec;
+    Bfp a = random_block(xa, ea);
+    Bfp b = random_block(xb, eb);
+    Bfp c = random_block(xc, ec);
+
+    Bfp mac;
+    Bfp::DotType dot;
+    Bfp::ProdExp dot_exp;
+    CCS_DESIGN(BfpVectorTop)(a, b, c, mac, dot, dot_exp);
+
+    // The dot product is exact
+    long long dot_ref = 0;
+    for (unsigned i = 0; i < BLOCK_SIZE; i++) {
+      dot_ref += static_cast<long long>(a.signed_mant(i).to_int()) *
+                 b.signed_mant(i).to_int();
+    }
+    assert(dot.to_int64() == dot_ref);
+    assert(dot_exp.to_int() == a.exp.to_int() + b.exp.to_int());
+
+    // Multiply-add: two truncations at the aligned exponent, one at the output
+    int aligned = std::max(a.exp.to_int() + b.exp.to_int(), c.exp.to_int());
+    double tolerance = 2 * std::ldexp(1.0, aligned) + std::ldexp(1.0, mac.exp.to_int());
+    for (unsigned i = 0; i < BLOCK_SIZE; i++) {
+      double exact = value(a, i) * value(b, i) + value(c, i);
+      assert(std::fabs(exact - value(mac, i)) < tolerance);
+      assert(mac.sign[i] == false || mac.mant[i] != 0);
+    }
+  }
+
+  DCOUT("CMODEL PASS" << endl);
+  CCS_RETURN(0) ;
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <hls_globals.h>
+#include <CAM.h>
+#include <cstdlib>
+#include <list>
+#include <map>
+
+static const int kEntries = 8;
+
+typedef NVUINTW(16) Val_t;
+typedef NVUINTW(20) ShortKey_t;  // Hash map in C simulation
+typedef NVUINTW(72) WideKey_t;   // Comparator array
+
+// True LRU cache of kEntries keys, most recently used first
+template <typename KeyT>
+class RefCache {
+ public:
+  bool lookup(const KeyT& key, Val_t& val) {
+    typename std::list<Entry>::iterator it = find(key);
+    if (it == entries.end()) return false;
+    val = it->val;
+    entries.splice(entries.begin(), entries, it);
+    return true;
+  }
+
+  void insert(const KeyT& key, const Val_t& val) {
+    typename std::list<Entry>::iterator it = find(key);
+    if (it != entries.end()) {
+      entries.erase(it);
+    } else if (entries.size() == kEntries) {
+      entries.pop_back();
+    }
+    Entry e = {key, val};
+    entries.push_front(e);
+  }
+
+  bool remove(const KeyT& key) {
+    typename std::list<Entry>::iterator it = find(key);
+    if (it == entries.end()) return false;
+    entries.erase(it);
+    return true;
+  }
+
+  unsigned size() const { return entries.size(); }
+
+ private:
+  struct Entry {
+    KeyT key;
+    Val_t val;
+  };
+  std::list<Entry> entries;
+
+  typename std::list<Entry>::iterator find(const KeyT& key) {
+    for (typename std::list<Entry>::iterator it = entries.begin(); it != entries.end(); ++it) {
+      if (it->key == key) return it;
+    }
+    return entries.end();
+  }
+};
+
+template <typename KeyT>
+KeyT RandKey() {
+  // Few distinct keys, so that lookups hit and inserts evict
+  KeyT key = rand() % 12;
+  key[KeyT::width - 1] = rand() % 2;
+  return key;
+}
+
+template <typename KeyT>
+void TestBinary() {
+  CAM<KeyT, Val_t, kEntries> cam;
+  RefCache<KeyT> ref;
+  for (int iter = 0; iter < 5000; iter++) {
+    KeyT key = RandKey<KeyT>();
+    int op = rand() % 8;
+    if (op < 4) {
+      Val_t val, ref_val;
+      bool hit = cam.lookup(key, val);
+      NVHLS_ASSERT_MSG(hit == ref.lookup(key, ref_val), "lookup hit mismatch");
+      NVHLS_ASSERT_MSG(!hit || val == ref_val, "lookup value mismatch");
+    } else if (op < 7) {
+      Val_t val = rand() % 65536;
+      typename CAM<KeyT, Val_t, kEntries>::Index idx = cam.insert(key, val);
+      ref.insert(key, val);
+      NVHLS_ASSERT_MSG(cam.key_at(idx) == key && cam.value_at(idx) == val, "insert entry mismatch");
+    } else {
+      NVHLS_ASSERT_MSG(cam.remove(key) == ref.remove(key), "remove mismatch");
+    }
+    NVHLS_ASSERT_MSG(cam.is_full() == (ref.size() == kEntries), "is_full mismatch");
+  }
+}
+
+void TestTernary() {
+  typedef NVUINTW(32) Addr_t;
+  typedef CAM<Addr_t, Val_t, kEntries, true> Routes;
+  Routes routes;
+  Addr_t prefix[kEntries];
+  Addr_t care[kEntries];
+  bool valid[kEntries];
+  for (int i = 0; i < kEntries; i++) {
+    valid[i] = false;
+  }
+
+  for (int iter = 0; iter < 2000; iter++) {
+    if (rand() % 4 == 0) {
+      // Longer prefixes in lower entries win
+      int i = rand() % kEntries;
+      int len = 32 - 4 * i;
+      care[i] = len == 32 ? Addr_t(~Addr_t(0)) : Addr_t(~((Addr_t(1) << (32 - len)) - 1));
+      prefix[i] = Addr_t(rand()) & care[i];
+      valid[i] = true;
+      routes.write(i, prefix[i], care[i], i);
+    }
+    Addr_t addr = iter % 2 ? Addr_t(rand()) : Addr_t(prefix[rand() % kEntries] | Addr_t(rand() % 256));
+    int first = -1;
+    for (int i = 0; i < kEntries && first < 0; i++) {
+      if (valid[i] && ((addr ^ prefix[i]) & care[i]) == 0) first = i;
+    }
+    Routes::Index idx;
+    bool hit = routes.find(addr, idx);
+    NVHLS_ASSERT_MSG(hit == (first >= 0), "ternary hit mismatch");
+    NVHLS_ASSERT_MSG(!hit || idx == first, "ternary priority mismatch");
+  }
+}
+
+int sc_main(int argc, char *argv[]) {
+  srand(1);
+  TestBinary<ShortKey_t>();
+  TestBinary<WideKey_t>();
+  TestTernary();
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
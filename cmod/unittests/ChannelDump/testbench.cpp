@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_channel_dump.h>
+#include <testbench/nvhls_rand.h>
+#include <testbench/Pacer.h>
+#include <testbench/SourceSink.h>
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef NUM_MESSAGES
+#define NUM_MESSAGES 1000
+#endif
+
+typedef NVUINTW(32) Word_t;
+
+// One Source -> Buffer -> Sink lane
+SC_MODULE(Lane) {
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  nvhls::GoldenQueue<Word_t> golden;
+  nvhls::Source<Word_t> src;
+  Connections::Buffer<Word_t, 2> buffer;
+  nvhls::Sink<Word_t> sink;
+
+  Connections::Combinational<Word_t> enq_chan;
+  Connections::Combinational<Word_t> deq_chan;
+
+  SC_CTOR(Lane)
+      : clk("clk"), rst("rst"), src("src", &golden), buffer("buffer"), sink("sink", &golden, Pacer(0.2, 0.5)),
+        enq_chan("enq_chan"), deq_chan("deq_chan") {
+    src.clk(clk);
+    src.rst(rst);
+    buffer.clk(clk);
+    buffer.rst(rst);
+    sink.clk(clk);
+    sink.rst(rst);
+
+    src.out(enq_chan);
+    buffer.enq(enq_chan);
+    buffer.deq(deq_chan);
+    sink.in(deq_chan);
+
+    // Mostly idle, so that most cycles have nothing to dump
+    src.injection_rate = 0.2;
+    src.burst_length = 8;
+    src.random_count = NUM_MESSAGES;
+  }
+
+  bool Done() const { return src.Done() && golden.empty(); }
+};
+
+SC_MODULE(testbench) {
+  sc_clock clk;
+  sc_signal<bool> rst;
+
+  Lane a;
+  Lane b;
+  match::ChannelDump dump;
+  unsigned int cycles;
+
+  SC_CTOR(testbench)
+      : clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true), rst("rst"), a("a"), b("b"), dump("dump", "lane_a.vcd"),
+        cycles(0) {
+    Connections::set_sim_clk(&clk);
+    a.clk(clk);
+    a.rst(rst);
+    b.clk(clk);
+    b.rst(rst);
+    dump.clk(clk);
+    dump.Select("tb.a.*");
+
+    SC_THREAD(run);
+    sensitive << clk.posedge_event();
+  }
+
+  void run() {
+    rst = 0;
+    wait(10);
+    rst = 1;
+    while (!(a.Done() && b.Done())) {
+      wait();
+      NVHLS_ASSERT_MSG(++cycles < 100 * NUM_MESSAGES, "Timed out");
+    }
+    wait(5);
+    sc_stop();
+  }
+};
+
+// Transfers per channel in a VCD of ChannelDump: the cycles with vld and
+// rdy both high, counted between consecutive timestamps
+std::map<std::string, unsigned long> CountTransfers(const std::string& filename, uint64 period) {
+  std::ifstream vcd(filename.c_str());
+  std::vector<std::string> scope;
+  std::map<std::string, std::string> chan_of;  // id -> channel
+  std::map<std::string, bool> vld, rdy;
+  std::map<std::string, unsigned long> transfers;
+  std::string line;
+  uint64 time = 0;
+  bool defs = true;
+  while (std::getline(vcd, line)) {
+    std::istringstream ss(line);
+    std::string tok;
+    ss >> tok;
+    if (defs) {
+      if (tok == "$scope") {
+        std::string kind, name;
+        ss >> kind >> name;
+        scope.push_back(name);
+      } else if (tok == "$upscope") {
+        scope.pop_back();
+      } else if (tok == "$var") {
+        std::string type, width, id, name;
+        ss >> type >> width >> id >> name;
+        std::string chan;
+        for (unsigned int i = 0; i < scope.size(); i++) chan += (i ? "." : "") + scope[i];
+        chan_of[id] = chan + "." + name;
+      } else if (tok == "$enddefinitions") {
+        defs = false;
+      }
+      continue;
+    }
+    if (tok.empty() || tok[0] == '$' || tok[0] == 'b' || tok[0] == 's') {
+      continue;
+    }
+    if (tok[0] == '#') {
+      uint64 next = std::strtoull(tok.c_str() + 1, NULL, 10);
+      for (std::map<std::string, bool>::iterator it = vld.begin(); it != vld.end(); ++it) {
+        if (it->second && rdy[it->first]) transfers[it->first] += (next - time) / period;
+      }
+      time = next;
+      continue;
+    }
+    std::string var = chan_of[tok.substr(1)];
+    bool value = (tok[0] == '1');
+    std::string chan = var.substr(0, var.size() - 4);
+    if (var.compare(var.size() - 4, 4, ".vld") == 0) {
+      vld[chan] = value;
+      rdy[chan];
+    } else if (var.compare(var.size() - 4, 4, ".rdy") == 0) {
+      rdy[chan] = value;
+      vld[chan];
+    }
+  }
+  return transfers;
+}
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_start();
+
+  uint64 period = sc_time(1, SC_NS).value();
+  std::map<std::string, unsigned long> transfers = CountTransfers("lane_a.vcd", period);
+  for (std::map<std::string, unsigned long>::iterator it = transfers.begin(); it != transfers.end(); ++it) {
+    DCOUT(it->first << ": " << it->second << " transfers" << endl);
+    NVHLS_ASSERT_MSG(it->first.compare(0, 5, "tb.a.") == 0, "Dumped a channel that was not selected");
+  }
+  NVHLS_ASSERT_MSG(tb.dump.NumChannels() >= 2, "Lane a channels were not found");
+  NVHLS_ASSERT_MSG(transfers["tb.a.enq_chan"] == NUM_MESSAGES, "Wrong transfer count on tb.a.enq_chan");
+  NVHLS_ASSERT_MSG(transfers["tb.a.deq_chan"] == NUM_MESSAGES, "Wrong transfer count on tb.a.deq_chan");
+  DCOUT(tb.dump.DumpedCycles() << " of " << tb.cycles << " cycles dumped" << endl);
+  NVHLS_ASSERT_MSG(tb.dump.DumpedCycles() < tb.cycles, "Idle cycles were dumped");
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
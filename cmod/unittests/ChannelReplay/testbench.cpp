@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <testbench/nvhls_rand.h>
+#include <testbench/Pacer.h>
+#include <testbench/SourceSink.h>
+#include <testbench/ChannelReplay.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifndef NUM_MESSAGES
+#define NUM_MESSAGES 1000
+#endif
+
+typedef NVUINTW(32) Word_t;
+
+// Holds each message for (message & 3) cycles and sends 3 * message + 1
+SC_MODULE(Stage) {
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<Word_t> in;
+  Connections::Out<Word_t> out;
+
+  SC_CTOR(Stage) : clk("clk"), rst("rst"), in("in"), out("out") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void run() {
+    in.Reset();
+    out.Reset();
+    bool full = false;
+    unsigned int delay = 0;
+    Word_t data = 0;
+    wait();
+    while (1) {
+      if (!full) {
+        full = in.PopNB(data);
+        delay = data.to_uint() & 3;
+      } else if (delay != 0) {
+        delay--;
+      } else if (out.PushNB(Word_t(data * 3 + 1))) {
+        full = false;
+      }
+      wait();
+    }
+  }
+};
+
+static std::vector<char> ReadFile(const std::string& filename) {
+  std::ifstream f(filename.c_str(), std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+SC_MODULE(testbench) {
+  sc_clock clk;
+  sc_signal<bool> rst_sys;
+  sc_signal<bool> rst_replay;
+
+  // The full system: Source -> Stage -> stalling Sink, recorded around the Stage
+  nvhls::Source<Word_t> src;
+  nvhls::ChannelRecorder<Word_t> rec_in;
+  Stage stage;
+  nvhls::ChannelRecorder<Word_t> rec_out;
+  nvhls::Sink<Word_t> sink;
+
+  // A second Stage on its own, replayed from the recording and recorded again
+  nvhls::ReplaySource<Word_t> replay_src;
+  nvhls::ChannelRecorder<Word_t> rerec_in;
+  Stage replay_stage;
+  nvhls::ChannelRecorder<Word_t> rerec_out;
+  nvhls::ReplaySink<Word_t> replay_sink;
+
+  Connections::Combinational<Word_t> sys_chan[4];
+  Connections::Combinational<Word_t> replay_chan[4];
+
+  SC_CTOR(testbench)
+      : clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true),
+        rst_sys("rst_sys"),
+        rst_replay("rst_replay"),
+        src("src"),
+        rec_in("rec_in", "stage_in.trace"),
+        stage("stage"),
+        rec_out("rec_out", "stage_out.trace"),
+        sink("sink", NULL, Pacer(0.3, 0.6)),
+        replay_src("replay_src", "stage_in.trace"),
+        rerec_in("rerec_in", "replay_in.trace"),
+        replay_stage("replay_stage"),
+        rerec_out("rerec_out", "replay_out.trace"),
+        replay_sink("replay_sink", "stage_out.trace") {
+    Connections::set_sim_clk(&clk);
+
+    src.clk(clk);
+    src.rst(rst_sys);
+    rec_in.clk(clk);
+    rec_in.rst(rst_sys);
+    stage.clk(clk);
+    stage.rst(rst_sys);
+    rec_out.clk(clk);
+    rec_out.rst(rst_sys);
+    sink.clk(clk);
+    sink.rst(rst_sys);
+    src.out(sys_chan[0]);
+    rec_in.enq(sys_chan[0]);
+    rec_in.deq(sys_chan[1]);
+    stage.in(sys_chan[1]);
+    stage.out(sys_chan[2]);
+    rec_out.enq(sys_chan[2]);
+    rec_out.deq(sys_chan[3]);
+    sink.in(sys_chan[3]);
+    src.injection_rate = 0.7;
+    src.burst_length = 4;
+    src.random_count = NUM_MESSAGES;
+
+    replay_src.clk(clk);
+    replay_src.rst(rst_replay);
+    rerec_in.clk(clk);
+    rerec_in.rst(rst_replay);
+    replay_stage.clk(clk);
+    replay_stage.rst(rst_replay);
+    rerec_out.clk(clk);
+    rerec_out.rst(rst_replay);
+    replay_sink.clk(clk);
+    replay_sink.rst(rst_replay);
+    replay_src.out(replay_chan[0]);
+    rerec_in.enq(replay_chan[0]);
+    rerec_in.deq(replay_chan[1]);
+    replay_stage.in(replay_chan[1]);
+    replay_stage.out(replay_chan[2]);
+    rerec_out.enq(replay_chan[2]);
+    rerec_out.deq(replay_chan[3]);
+    replay_sink.in(replay_chan[3]);
+
+    SC_THREAD(run);
+    sensitive << clk.posedge_event();
+  }
+
+  void run() {
+    rst_sys = 0;
+    rst_replay = 0;
+    wait(10);
+    rst_sys = 1;
+    unsigned int cycles = 0;
+    while (!(src.Done() && sink.received == NUM_MESSAGES)) {
+      wait();
+      NVHLS_ASSERT_MSG(++cycles < 100 * NUM_MESSAGES, "Recording timed out");
+    }
+    wait(5);
+    rec_in.flush();
+    rec_out.flush();
+    NVHLS_ASSERT_MSG(rec_in.recorded == NUM_MESSAGES, "Stage input was not fully recorded");
+    NVHLS_ASSERT_MSG(rec_out.recorded == NUM_MESSAGES, "Stage output was not fully recorded");
+    DCOUT("Recorded " << NUM_MESSAGES << " messages in " << cycles << " cycles" << endl);
+
+    rst_replay = 1;
+    cycles = 0;
+    while (!(replay_src.Done() && replay_sink.Done())) {
+      wait();
+      NVHLS_ASSERT_MSG(++cycles < 100 * NUM_MESSAGES, "Replay timed out");
+    }
+    wait(20);
+    rerec_in.flush();
+    rerec_out.flush();
+    DCOUT("Replayed in " << cycles << " cycles: " << replay_src.late << " inputs and " << replay_sink.late
+                         << " outputs late, " << replay_sink.mismatches << " mismatches, " << replay_sink.extra
+                         << " extra" << endl);
+    NVHLS_ASSERT_MSG(replay_src.late == 0, "Replayed inputs were accepted late");
+    NVHLS_ASSERT_MSG(replay_sink.Exact(), "Replayed outputs differ from the recording");
+    // Cycle-exact: recording the replay gives back the same traces
+    NVHLS_ASSERT_MSG(ReadFile("replay_in.trace") == ReadFile("stage_in.trace"), "Replayed inputs differ");
+    NVHLS_ASSERT_MSG(ReadFile("replay_out.trace") == ReadFile("stage_out.trace"), "Replayed outputs differ");
+    DCOUT("CMODEL PASS" << endl);
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_start();
+  return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <Arbiter.h>
+#include <ReorderBuf.h>
+#include <fifo.h>
+#include <mem_array.h>
+#include <testbench/nvhls_rand.h>
+#include <testbench/nvhls_checkpoint.h>
+
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+#ifndef NUM_STEPS
+#define NUM_STEPS 20000
+#endif
+
+typedef NVUINTW(16) Word_t;
+
+// A block of matchlib state, stepped with random operations. Every step
+// returns a value that depends on the state, so two blocks with the same
+// state produce the same trace.
+class Block {
+ public:
+  FIFO<Word_t, 8> fifo;
+  Arbiter<8> arbiter;
+  Arbiter<8, WeightedRoundrobin> weighted;
+  Arbiter<8, Matrix> matrix;
+  ReorderBuf<Word_t, 8, 8> rob;
+  mem_array_sep<Word_t, 64, 2> mem;
+  std::deque<ReorderBuf<Word_t, 8, 8>::Id> rob_ids;  // ids waiting for a response, test-side
+
+  Block() {
+    for (unsigned i = 0; i < 8; i++) {
+      weighted.set_weight(i, i % 3);
+    }
+  }
+
+  void Register(const std::string& prefix) {
+    nvhls::Checkpoint& ckpt = nvhls::Checkpoint::Instance();
+    ckpt.Register(prefix + ".fifo", fifo);
+    ckpt.Register(prefix + ".arbiter", arbiter);
+    ckpt.Register(prefix + ".weighted", weighted);
+    ckpt.Register(prefix + ".matrix", matrix);
+    ckpt.Register(prefix + ".rob", rob);
+    ckpt.Register(prefix + ".mem", mem);
+  }
+
+  unsigned Step(nvhls::Rng& rng) {
+    unsigned out = 0;
+    Word_t w = rng.get_rand<16>();
+    if (rng.below(2) && !fifo.isFull()) {
+      fifo.push(w);
+    } else if (!fifo.isEmpty()) {
+      out ^= fifo.pop().to_uint();
+    }
+    NVUINTW(8) valid = rng.get_rand<8>();
+    out = (out << 3) ^ arbiter.pick(valid).to_uint();
+    out = (out << 3) ^ weighted.pick(valid).to_uint();
+    out = (out << 3) ^ matrix.pick(valid).to_uint();
+    unsigned op = rng.below(3);
+    if (op == 0 && rob.canAcceptRequest()) {
+      rob_ids.push_back(rob.addRequest());
+    } else if (op == 1 && !rob_ids.empty()) {
+      unsigned pick = rng.below(rob_ids.size());
+      rob.addResponse(rob_ids[pick], w);
+      rob_ids.erase(rob_ids.begin() + pick);
+    } else if (rob.topResponseReady()) {
+      out ^= rob.popResponse().to_uint();
+    }
+    unsigned addr = rng.below(64);
+    if (rng.below(2)) {
+      mem.write(addr / 2, addr % 2, w);
+    } else {
+      out ^= mem.read(addr / 2, addr % 2).to_uint() << 7;
+    }
+    return out;
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::Checkpoint& ckpt = nvhls::Checkpoint::Instance();
+  const char* file = "checkpoint_test.ckpt";
+
+  // Warm up, checkpoint, and record the trace that follows
+  Block* warm = new Block;
+  for (unsigned i = 0; i < 64; i++) {
+    warm->mem.write(i / 2, i % 2, i);  // no X reads
+  }
+  warm->Register("tb.block");
+  nvhls::Rng rng("checkpoint");
+  for (unsigned i = 0; i < NUM_STEPS; i++) {
+    warm->Step(rng);
+  }
+  NVHLS_ASSERT_MSG(ckpt.Save(file), "Save failed");
+  std::deque<ReorderBuf<Word_t, 8, 8>::Id> rob_ids = warm->rob_ids;
+  nvhls::Rng rng_after = rng;
+  std::vector<unsigned> golden;
+  for (unsigned i = 0; i < NUM_STEPS; i++) {
+    golden.push_back(warm->Step(rng));
+  }
+  ckpt.Clear();
+  delete warm;
+
+  // A fresh block restored from the checkpoint replays the same trace
+  Block restored;
+  restored.Register("tb.block");
+  NVHLS_ASSERT_MSG(ckpt.Restore(file), "Restore failed");
+  restored.rob_ids = rob_ids;
+  for (unsigned i = 0; i < NUM_STEPS; i++) {
+    NVHLS_ASSERT_MSG(restored.Step(rng_after) == golden[i], "Restored block diverged");
+  }
+
+  // Size mismatches fail, unknown entries are skipped
+  ckpt.Clear();
+  FIFO<Word_t, 4> small;
+  ckpt.Register("tb.block.fifo", small);
+  NVHLS_ASSERT_MSG(!ckpt.Restore(file), "Restore accepted a resized entry");
+  ckpt.Clear();
+  Word_t other = 0;
+  ckpt.Register("tb.other", other);
+  NVHLS_ASSERT_MSG(ckpt.Restore(file), "Restore failed on unregistered entries");
+  NVHLS_ASSERT_MSG(!ckpt.Restore("checkpoint_missing.ckpt"), "Restore accepted a missing file");
+  std::remove(file);
+
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
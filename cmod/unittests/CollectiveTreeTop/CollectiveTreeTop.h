@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __COLLECTIVETREETOP_H__
+#define __COLLECTIVETREETOP_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <CollectiveTree.h>
+
+// Default: 16 tiles under a tree of radix 4. sim_test2 uses 8 tiles under a
+// binary tree.
+#ifndef TREE_RADIX
+#define TREE_RADIX 4
+#endif
+#ifndef TREE_LEVELS
+#define TREE_LEVELS 2
+#endif
+
+SC_MODULE(CollectiveTreeTop) {
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  typedef NVINTW(32) Data_t;
+  typedef CollectiveTree<Data_t, TREE_RADIX, TREE_LEVELS> Tree_t;
+  typedef Tree_t::Msg_t Msg_t;
+  enum { kNumTiles = Tree_t::num_tiles };
+
+  Tree_t tree;
+
+  Connections::In<Msg_t> in[kNumTiles];
+  Connections::Out<Msg_t> out[kNumTiles];
+
+  SC_HAS_PROCESS(CollectiveTreeTop);
+  CollectiveTreeTop(sc_module_name name)
+      : sc_module(name), clk("clk"), rst("rst"), tree("tree") {
+    tree.clk(clk);
+    tree.rst(rst);
+    for (int i = 0; i < kNumTiles; i++) {
+      tree.in[i](in[i]);
+      tree.out[i](out[i]);
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CollectiveTreeTop.h"
+#include <systemc.h>
+#include <mc_scverify.h>
+#include <testbench/nvhls_rand.h>
+#include <nvhls_connections.h>
+
+#define NVHLS_VERIFY_BLOCKS (CollectiveTreeTop)
+#include <nvhls_verify.h>
+
+#include <sstream>
+#include <vector>
+
+using namespace ::std;
+typedef CollectiveTreeTop::Msg_t Msg_t;
+typedef CollectiveTreeTop::Data_t Data_t;
+static const int kNumTiles = CollectiveTreeTop::kNumTiles;
+static const int kNumLevels = CollectiveTreeTop::Tree_t::levels;
+static const int kNumCollectives = 64;
+
+static const int kDebugLevel = 1;
+
+// Ops and operands of every collective, and the tiles that joined so far
+class Reference {
+ public:
+  Reference() : received(0) {
+    for (int k = 0; k < kNumCollectives; k++) {
+      op.push_back(rand() % 5);
+      int src = rand() % kNumTiles;
+      vector<Data_t> values;
+      for (int t = 0; t < kNumTiles; t++) {
+        Data_t value = rand() - RAND_MAX / 2;
+        if (op[k] == Msg_t::kBroadcast && t != src) {
+          value = 0;
+        }
+        values.push_back(value);
+      }
+      operand.push_back(values);
+      joined.push_back(0);
+    }
+  }
+
+  Data_t expected(int k) const {
+    Data_t result = operand[k][0];
+    for (int t = 1; t < kNumTiles; t++) {
+      result = Msg_t::Combine(op[k], result, operand[k][t]);
+    }
+    return op[k] == Msg_t::kBarrier ? Data_t(0) : result;
+  }
+
+  void result_received(int tile, int k, const Msg_t& msg) {
+    CDCOUT(sc_time_stamp() << " tile " << tile << " collective " << k << " op "
+           << msg.op << " result: " << msg.data << endl, kDebugLevel);
+    NVHLS_ASSERT_MSG(joined[k] == kNumTiles, "Result before all tiles joined");
+    NVHLS_ASSERT_MSG(msg.op == op[k], "Op changed");
+    if (op[k] != Msg_t::kBarrier) {
+      NVHLS_ASSERT_MSG(msg.data == expected(k), "Result mismatch");
+    }
+    received++;
+  }
+
+  bool done() const { return received == kNumCollectives * kNumTiles; }
+
+  vector<unsigned> op;
+  vector<vector<Data_t> > operand;
+  vector<int> joined;
+  int received;
+};
+
+SC_MODULE(Tile) {
+  Connections::Out<Msg_t> out;
+  Connections::In<Msg_t> in;
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+  const int id;
+  Reference& ref;
+
+  // Joins the collectives in order, at a random pace
+  void send() {
+    out.Reset();
+    wait();
+    for (int k = 0; k < kNumCollectives; k++) {
+      wait(rand() % 4);
+      out.Push(Msg_t(ref.operand[k][id], ref.op[k]));
+      ref.joined[k]++;
+    }
+    while (1) {
+      wait();
+    }
+  }
+
+  void receive() {
+    in.Reset();
+    int k = 0;
+    while (1) {
+      wait();
+      Msg_t msg;
+      // stall now and then to build up backpressure
+      if ((rand() % 3 != 0) && in.PopNB(msg)) {
+        ref.result_received(id, k++, msg);
+      }
+    }
+  }
+
+  SC_HAS_PROCESS(Tile);
+  Tile(sc_module_name name_, int id_, Reference& ref_)
+      : sc_module(name_), out("out"), in("in"), clk("clk"), rst("rst"),
+        id(id_), ref(ref_) {
+    SC_THREAD(send);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(receive);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+// Tile 0 joins a barrier after all other tiles and times its release
+SC_MODULE(BarrierProbe) {
+  Connections::Out<Msg_t> out[kNumTiles];
+  Connections::In<Msg_t> in[kNumTiles];
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+  int latency;
+
+  void run() {
+    for (int t = 0; t < kNumTiles; t++) {
+      out[t].Reset();
+      in[t].Reset();
+    }
+    latency = -1;
+    wait();
+    for (int t = 1; t < kNumTiles; t++) {
+      out[t].Push(Msg_t(0, Msg_t::kBarrier));
+    }
+    wait(10);
+    out[0].Push(Msg_t(0, Msg_t::kBarrier));
+    int cycles = 0;
+    Msg_t msg;
+    while (!in[0].PopNB(msg)) {
+      wait();
+      cycles++;
+    }
+    for (int t = 1; t < kNumTiles; t++) {
+      msg = in[t].Pop();
+      NVHLS_ASSERT_MSG(msg.op == Msg_t::kBarrier, "Not a barrier release");
+    }
+    latency = cycles;
+    while (1) {
+      wait();
+    }
+  }
+
+  SC_HAS_PROCESS(BarrierProbe);
+  BarrierProbe(sc_module_name name_) : sc_module(name_), clk("clk"), rst("rst") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+SC_MODULE(testbench) {
+  NVHLS_DESIGN(CollectiveTreeTop) dut;
+  CollectiveTreeTop::Tree_t probe_tree;
+  BarrierProbe probe;
+
+  typedef Connections::Combinational<Msg_t> MsgChan;
+
+  sc_clock clk;
+  sc_signal<bool> rst;
+  Reference ref;
+  MsgChan probe_in[kNumTiles];
+  MsgChan probe_out[kNumTiles];
+
+  SC_CTOR(testbench)
+      : dut("dut"),
+        probe_tree("probe_tree"),
+        probe("probe"),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        rst("rst") {
+    Connections::set_sim_clk(&clk);
+
+    dut.clk(clk);
+    dut.rst(rst);
+    probe_tree.clk(clk);
+    probe_tree.rst(rst);
+    probe.clk(clk);
+    probe.rst(rst);
+
+    for (int i = 0; i < kNumTiles; ++i) {
+      ostringstream name;
+      name << "tile_" << i;
+      Tile* tile = new Tile(name.str().c_str(), i, ref);
+      MsgChan* in_chan = new MsgChan();
+      MsgChan* out_chan = new MsgChan();
+
+      tile->clk(clk);
+      tile->rst(rst);
+      tile->out(*in_chan);
+      dut.in[i](*in_chan);
+      dut.out[i](*out_chan);
+      tile->in(*out_chan);
+
+      probe.out[i](probe_in[i]);
+      probe_tree.in[i](probe_in[i]);
+      probe_tree.out[i](probe_out[i]);
+      probe.in[i](probe_out[i]);
+    }
+
+    SC_THREAD(run);
+  }
+
+  void run() {
+    rst = 0;
+    cout << "@" << sc_time_stamp() << " Asserting Reset " << endl;
+    wait(2, SC_NS);
+    cout << "@" << sc_time_stamp() << " Deasserting Reset " << endl;
+    rst = 1;
+    wait(5000, SC_NS);
+    cout << "@" << sc_time_stamp() << " Stop " << endl;
+    cout << "received " << ref.received << " results, barrier latency "
+         << probe.latency << " cycles" << endl;
+    NVHLS_ASSERT_MSG(ref.done(), "Not all collectives completed");
+    // A level up and a level down per cycle, the turn at the root and the
+    // tile handshakes
+    NVHLS_ASSERT_MSG(probe.latency >= 0 && probe.latency <= 2 * kNumLevels + 4,
+                     "Barrier release too slow");
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char* argv[]) {
+  nvhls::set_random_seed();
+  testbench my_testbench("my_testbench");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    cout << "Simulation FAILED\n";
+  else
+    cout << "Simulation PASSED\n";
+  return rc;
+};
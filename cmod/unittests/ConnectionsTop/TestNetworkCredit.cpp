@@ -25,6 +25,11 @@
 #include "TestSource.h"
 #include "TestSink.h"
 
+// Credits returned per credit packet by InNetworkCredit
+#ifndef CREDIT_BATCH
+#define CREDIT_BATCH 1
+#endif
+
 //------------------------------------------------------------------------
 // TestHarness
 //------------------------------------------------------------------------
@@ -48,7 +53,7 @@ class TestHarness: public sc_module {
   const static unsigned int CreditWidth = 3;
 
   Connections::OutNetworkCredit<T,DestWidthPerHop,MaxHops,PacketIdWidth,CreditWidth> enq_net;
-  Connections::InNetworkCredit<T,DestWidthPerHop,MaxHops,PacketIdWidth,CreditWidth> deq_net;
+  Connections::InNetworkCredit<T,DestWidthPerHop,MaxHops,PacketIdWidth,CreditWidth,CREDIT_BATCH> deq_net;
 
   Connections::Combinational<T> enq_chan;
   Connections::Combinational<T> deq_chan;
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//========================================================================
+// TestVector.cpp
+//========================================================================
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_int.h>
+#include <nvhls_assert.h>
+#include <TypeToBits.h>
+#include <cstdlib>
+
+static const unsigned int kNumMsgs = 500;
+static const unsigned int kLanes = 4;
+typedef NVUINT12 Data;
+typedef Connections::VectorMessage<Data, kLanes> Vector;
+
+//------------------------------------------------------------------------
+// Producer: sends 0, 1, 2, ... in random subsets of the lanes
+//------------------------------------------------------------------------
+
+class Producer : public sc_module {
+  SC_HAS_PROCESS(Producer);
+
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::VectorOut<Data, kLanes> out;
+  unsigned int handshakes;
+
+  Producer(sc_module_name name)
+      : sc_module(name), clk("clk"), rst("rst"), out("out"), handshakes(0) {
+    SC_THREAD(Run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void Run() {
+    out.Reset();
+    unsigned int next = 0;
+    wait();
+    while (next < kNumMsgs) {
+      Data data[kLanes];
+      Vector::Mask valid = rand() % (1 << kLanes);
+      for (unsigned int i = 0; i < kLanes; i++) {
+        data[i] = 0xfff;
+        if (valid[i] == 1) {
+          if (next < kNumMsgs) {
+            data[i] = next++;
+          } else {
+            valid[i] = 0;
+          }
+        }
+      }
+      // A blocking vector, then non-blocking retries
+      if (handshakes % 2 == 0) {
+        out.Push(data, valid);
+      } else {
+        while (!out.PushNB(data, valid)) {
+          wait();
+        }
+      }
+      handshakes++;
+      wait();
+    }
+  }
+};
+
+//------------------------------------------------------------------------
+// Consumer: checks that the valid lanes arrive in order
+//------------------------------------------------------------------------
+
+class Consumer : public sc_module {
+  SC_HAS_PROCESS(Consumer);
+
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::VectorIn<Data, kLanes> in;
+  unsigned int received;
+  unsigned int handshakes;
+
+  Consumer(sc_module_name name)
+      : sc_module(name), clk("clk"), rst("rst"), in("in"), received(0), handshakes(0) {
+    SC_THREAD(Run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void Run() {
+    in.Reset();
+    wait();
+    while (1) {
+      Data data[kLanes];
+      Vector::Mask valid;
+      bool popped;
+      if (rand() % 2) {
+        valid = in.Pop(data);
+        popped = true;
+      } else {
+        popped = in.PopNB(data, valid);
+      }
+      if (popped) {
+        handshakes++;
+        for (unsigned int i = 0; i < kLanes; i++) {
+          if (valid[i] == 1) {
+            NVHLS_ASSERT_MSG(data[i] == received, "Message out of order");
+            received++;
+          }
+        }
+        if (received == kNumMsgs) {
+          sc_stop();
+        }
+      } else {
+        NVHLS_ASSERT_MSG(valid == 0, "Empty pop must return no lanes");
+      }
+      wait();
+    }
+  }
+};
+
+class TestHarness : public sc_module {
+  SC_HAS_PROCESS(TestHarness);
+
+ public:
+  sc_clock clk;
+  sc_signal<bool> rst;
+  Producer producer;
+  Consumer consumer;
+  Connections::VectorCombinational<Data, kLanes> chan;
+
+  TestHarness(sc_module_name name)
+      : sc_module(name),
+        clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true),
+        rst("rst"),
+        producer("producer"),
+        consumer("consumer"),
+        chan("chan") {
+    producer.clk(clk);
+    producer.rst(rst);
+    consumer.clk(clk);
+    consumer.rst(rst);
+    producer.out(chan);
+    consumer.in(chan);
+
+    SC_THREAD(reset);
+  }
+
+  void reset() {
+    rst.write(false);
+    wait(10, SC_NS);
+    rst.write(true);
+  }
+};
+
+// Bit layout: the mask at the LSBs, then the lanes in index order
+void TestMarshall() {
+  static_assert(Wrapped<nvhls::nv_array<Data, 3> >::width == 36, "nv_array width");
+  static_assert(Vector::width == kLanes + kLanes * 12, "VectorMessage width");
+  for (int iter = 0; iter < 100; iter++) {
+    Data data[kLanes];
+    for (unsigned int i = 0; i < kLanes; i++) {
+      data[i] = rand();
+    }
+    Vector v(data, rand() % (1 << kLanes));
+    sc_lv<Vector::width> bits = TypeToBits<Vector>(v);
+    NVHLS_ASSERT_MSG(bits.range(kLanes - 1, 0).to_uint() == v.valid.to_uint(), "Mask bits");
+    for (unsigned int i = 0; i < kLanes; i++) {
+      NVHLS_ASSERT_MSG(bits.range(kLanes + 12 * i + 11, kLanes + 12 * i).to_uint() ==
+                           data[i].to_uint(), "Lane bits");
+    }
+    Vector back = BitsToType<Vector>(bits);
+    NVHLS_ASSERT_MSG(back.valid == v.valid && back.Count() == v.Count(), "Mask round trip");
+    for (unsigned int i = 0; i < kLanes; i++) {
+      NVHLS_ASSERT_MSG(back.data[i] == data[i], "Lane round trip");
+    }
+  }
+}
+
+int sc_main(int argc, char* argv[]) {
+  srand(1);
+  TestMarshall();
+
+  TestHarness test("test");
+  sc_start();
+
+  std::cout << "Received " << test.consumer.received << " messages in "
+            << test.consumer.handshakes << " handshakes" << std::endl;
+  NVHLS_ASSERT_MSG(test.consumer.received == kNumMsgs, "Messages lost");
+  NVHLS_ASSERT_MSG(test.consumer.handshakes == test.producer.handshakes, "Handshakes lost");
+  // Random masks average kLanes / 2 messages per handshake
+  NVHLS_ASSERT_MSG(test.consumer.handshakes * 2 < kNumMsgs, "Too few messages per handshake");
+  std::cout << "CMODEL PASS" << std::endl;
+  return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <axi/axi4.h>
+#include <testbench/nvhls_rand.h>
+#include <testbench/ConstrainedRandom.h>
+
+#include <set>
+#include <vector>
+
+#ifndef NUM_ITERS
+#define NUM_ITERS 10000
+#endif
+
+typedef axi::axi4<axi::cfg::standard> axi_;
+typedef axi_::AddrPayload Addr_t;
+typedef axi_::WritePayload Write_t;
+
+// Hot address, maximum-length bursts and back-to-back IDs
+void CheckAddr() {
+  nvhls::ConstrainedRandom<Addr_t> gen("CheckAddr");
+  gen.value(&Addr_t::addr, 0x1000, 9)
+     .uniform(&Addr_t::addr, 1)
+     .value(&Addr_t::len, 255)
+     .range(&Addr_t::id, 2, 5)
+     .repeat(&Addr_t::id, 75);
+
+  int hot = 0, repeats = 0;
+  std::set<unsigned long long> addrs;
+  unsigned int last_id = 0;
+  for (int i = 0; i < NUM_ITERS; i++) {
+    Addr_t a = gen.next();
+    unsigned int id = a.id.to_uint64();
+    NVHLS_ASSERT_MSG(a.len == 255, "len constraint violated");
+    NVHLS_ASSERT_MSG(id >= 2 && id <= 5, "id constraint violated");
+    if (a.addr == 0x1000) hot++;
+    if (i > 0 && id == last_id) repeats++;
+    last_id = id;
+    addrs.insert(a.addr.to_uint64());
+  }
+  // 90% hot; ids repeat 75% of the time plus a quarter of the fresh draws
+  NVHLS_ASSERT_MSG(hot > NUM_ITERS * 85 / 100 && hot < NUM_ITERS * 95 / 100, "hot address weight off");
+  NVHLS_ASSERT_MSG(repeats > NUM_ITERS * 76 / 100 && repeats < NUM_ITERS * 86 / 100, "id repeat rate off");
+  NVHLS_ASSERT_MSG(addrs.size() > 100, "uniform addresses do not vary");
+  DCOUT("CheckAddr: " << hot << " hot, " << repeats << " repeated ids: PASS" << endl);
+}
+
+// Sequences, and unconstrained fields after clear()
+void CheckWrite() {
+  nvhls::ConstrainedRandom<Write_t> gen(1, "CheckWrite");
+  gen.sequence(&Write_t::data, 0x100, 8, 16).value(&Write_t::wstrb, 0xff);
+
+  std::vector<sc_dt::uint64> strbs;
+  strbs.push_back(0x0f);
+  strbs.push_back(0xf0);
+  for (int i = 0; i < NUM_ITERS; i++) {
+    Write_t w = gen.next();
+    NVHLS_ASSERT_MSG(w.data == 0x100 + 8 * (i % 16), "data sequence violated");
+    NVHLS_ASSERT_MSG(w.wstrb == 0xff, "wstrb constraint violated");
+  }
+
+  gen.clear(&Write_t::data).sequence(&Write_t::wstrb, strbs);
+  std::set<unsigned long long> data;
+  for (int i = 0; i < NUM_ITERS; i++) {
+    Write_t w = gen.next();
+    NVHLS_ASSERT_MSG(w.wstrb == strbs[i % 2], "wstrb sequence violated");
+    data.insert(w.data.to_uint64());
+  }
+  NVHLS_ASSERT_MSG(data.size() > NUM_ITERS / 2, "unconstrained data does not vary");
+  DCOUT("CheckWrite: PASS" << endl);
+}
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+
+  CheckAddr();
+  CheckWrite();
+
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
@@ -34,8 +34,34 @@ void CrossbarTop(
 #endif
     )
 {
-
+#if defined(XBAR_VALID_MASK) && !defined(NO_XBAR_VALID_IN_OUT)
+    // Same function through the bitmask overloads
+    NVUINTC(NUM_INPUTS) valid_in_mask = 0;
+    NVUINTC(NUM_OUTPUTS) valid_out_mask = 0;
+    #pragma hls_unroll yes
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        valid_in_mask[i] = valid_in[i];
+    }
+#ifndef NO_XBAR_VALID_SOURCE
+    NVUINTC(NUM_OUTPUTS) valid_source_mask = 0;
+    #pragma hls_unroll yes
+    for (int i = 0; i < NUM_OUTPUTS; i++) {
+        valid_source_mask[i] = valid_source[i];
+    }
+    crossbar<DATA_TYPE, NUM_INPUTS, NUM_OUTPUTS>(
+        data_in, valid_in_mask, source, valid_source_mask, data_out, valid_out_mask);
+#else
     crossbar<DATA_TYPE, NUM_INPUTS, NUM_OUTPUTS>(
+        data_in, valid_in_mask, source, data_out, valid_out_mask);
+#endif
+    #pragma hls_unroll yes
+    for (int i = 0; i < NUM_OUTPUTS; i++) {
+        valid_out[i] = valid_out_mask[i];
+    }
+    return;
+#endif
+
+    crossbar<DATA_TYPE, NUM_INPUTS, NUM_OUTPUTS, XBAR_TOPOLOGY>(
         data_in,
 #ifndef NO_XBAR_VALID_IN_OUT
         valid_in,
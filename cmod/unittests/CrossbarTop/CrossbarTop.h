@@ -33,6 +33,10 @@
 #define DATA_TYPE NVINT32
 #endif
 
+#ifndef XBAR_TOPOLOGY
+#define XBAR_TOPOLOGY CrossbarFlat
+#endif
+
 void CrossbarTop(
     DATA_TYPE data_in[NUM_INPUTS], 
 #ifndef NO_XBAR_VALID_IN_OUT
@@ -23,6 +23,69 @@
 #define NUM_ITERS 1000
 #endif
 
+// crossbar_onehot() against the binary-index crossbar
+void test_onehot() {
+  typedef DATA_TYPE Word_t;
+  typedef NVUINTC(nvhls::nbits<NUM_INPUTS - 1>::val) Src_t;
+
+  Word_t data_in[NUM_INPUTS];
+  NVUINTC(NUM_INPUTS) select[NUM_OUTPUTS];
+  Word_t data_out[NUM_OUTPUTS];
+  NVUINTC(NUM_OUTPUTS) valid_out;
+
+  for (int test = 0; test < NUM_ITERS; test++) {
+    Src_t src_in[NUM_OUTPUTS];
+    bool valid_src[NUM_OUTPUTS];
+    for (unsigned in = 0; in < NUM_INPUTS; in++) {
+      data_in[in] = rand();
+    }
+    for (unsigned out = 0; out < NUM_OUTPUTS; out++) {
+      src_in[out] = rand() % NUM_INPUTS;
+      valid_src[out] = rand() % 2;
+      select[out] = 0;
+      if (valid_src[out]) {
+        select[out][src_in[out]] = 1;
+      }
+    }
+    crossbar_onehot<Word_t, NUM_INPUTS, NUM_OUTPUTS>(data_in, select, data_out, valid_out);
+    for (unsigned out = 0; out < NUM_OUTPUTS; out++) {
+      assert(valid_out[out] == valid_src[out]);
+      assert(data_out[out] == (valid_src[out] ? data_in[src_in[out]] : Word_t(0)));
+    }
+  }
+}
+
+// crossbar_multicast() with the destination masks of random source selections
+void test_multicast() {
+  typedef DATA_TYPE Word_t;
+
+  Word_t data_in[NUM_INPUTS];
+  NVUINTC(NUM_OUTPUTS) dest[NUM_INPUTS];
+  Word_t data_out[NUM_OUTPUTS];
+  NVUINTC(NUM_OUTPUTS) valid_out;
+
+  for (int test = 0; test < NUM_ITERS; test++) {
+    unsigned src_in[NUM_OUTPUTS];
+    bool valid_src[NUM_OUTPUTS];
+    for (unsigned in = 0; in < NUM_INPUTS; in++) {
+      data_in[in] = rand();
+      dest[in] = 0;
+    }
+    for (unsigned out = 0; out < NUM_OUTPUTS; out++) {
+      src_in[out] = rand() % NUM_INPUTS;
+      valid_src[out] = rand() % 2;
+      if (valid_src[out]) {
+        dest[src_in[out]][out] = 1;
+      }
+    }
+    crossbar_multicast<Word_t, NUM_INPUTS, NUM_OUTPUTS>(data_in, dest, data_out, valid_out);
+    for (unsigned out = 0; out < NUM_OUTPUTS; out++) {
+      assert(valid_out[out] == valid_src[out]);
+      assert(data_out[out] == (valid_src[out] ? data_in[src_in[out]] : Word_t(0)));
+    }
+  }
+}
+
 CCS_MAIN(int argc, char *argv[]) {
 
   nvhls::set_random_seed();
@@ -46,12 +109,30 @@ CCS_MAIN(int argc, char *argv[]) {
       valid_in[in] = rand() % 2;
     }
 
+#ifdef XBAR_PERMUTATION
+    // Benes topology: valid sources must be distinct
+    unsigned perm[NUM_OUTPUTS];
+    for (unsigned out = 0; out < NUM_OUTPUTS; out++) {
+      perm[out] = out;
+    }
+    for (unsigned out = NUM_OUTPUTS - 1; out > 0; out--) {
+      unsigned other = rand() % (out + 1);
+      unsigned tmp = perm[out];
+      perm[out] = perm[other];
+      perm[other] = tmp;
+    }
+    for (unsigned out = 0; out < NUM_OUTPUTS; out++) {
+      src_in[out] = perm[out];
+      valid_src[out] = rand() % 2;
+    }
+#else
     for (unsigned out = 0; out < NUM_OUTPUTS; out++) {
       // src_in[out] = NUM_OUTPUTS - 1 - out;
       // src_in[out] = (src_in[out] + test) % NUM_INPUTS;
       src_in[out] = rand() % NUM_INPUTS;
       valid_src[out] = rand() % 2;
     }
+#endif
 
     CCS_DESIGN(CrossbarTop)(
         data_in,
@@ -121,6 +202,9 @@ CCS_MAIN(int argc, char *argv[]) {
 
   }
 
+  test_onehot();
+  test_multicast();
+
   DCOUT("CMODEL PASS" << endl);
   CCS_RETURN(0);
 }
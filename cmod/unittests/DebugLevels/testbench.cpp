@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <hls_globals.h>
+#include <nvhls_assert.h>
+
+// Counts the CDCOUT statements of each level that its process executes
+SC_MODULE(Chatty) {
+  sc_in_clk clk;
+  unsigned printed[4];
+
+  SC_CTOR(Chatty) : clk("clk") {
+    for (unsigned i = 0; i < 4; i++) printed[i] = 0;
+    SC_THREAD(run);
+    sensitive << clk.pos();
+  }
+
+  void run() {
+    for (unsigned i = 0; i < 10; i++) {
+      wait();
+      CDCOUT((printed[1]++, ""), 1);
+      CDCOUT((printed[2]++, ""), 2);
+      CDCOUT((printed[3]++, ""), 3);
+    }
+  }
+};
+
+SC_MODULE(Top) {
+  sc_clock clk;
+  Chatty arbiter0;
+  Chatty arbiter1;
+  Chatty other;
+
+  SC_CTOR(Top) : clk("clk", 1, SC_NS), arbiter0("arbiter0"), arbiter1("arbiter1"), other("other") {
+    arbiter0.clk(clk);
+    arbiter1.clk(clk);
+    other.clk(clk);
+  }
+};
+
+// Each level prints in every cycle if enabled at compile time or for the module
+static void check(const Chatty& m, unsigned runtime) {
+  for (unsigned y = 1; y < 4; y++) {
+    unsigned expected = (DEBUG_LEVEL >= y || runtime >= y) ? 10 : 0;
+    if (m.printed[y] != expected) {
+      DCOUT(m.name() << " level " << y << ": " << m.printed[y] << " prints, expected " << expected << endl);
+      NVHLS_ASSERT_MSG(false, "Module printed at the wrong levels");
+    }
+  }
+}
+
+int sc_main(int argc, char *argv[]) {
+  match::DebugLevels& levels = match::DebugLevels::Instance();
+  NVHLS_ASSERT_MSG(levels.GlobMatch("top.arbiter*", "top.arbiter0"), "Glob does not match");
+  NVHLS_ASSERT_MSG(levels.GlobMatch("*.arb?ter1", "top.arbiter1"), "Glob does not match");
+  NVHLS_ASSERT_MSG(levels.GlobMatch("*", ""), "Glob does not match");
+  NVHLS_ASSERT_MSG(!levels.GlobMatch("top.arbiter*", "top.other"), "Glob matches");
+  NVHLS_ASSERT_MSG(!levels.GlobMatch("top.a*x", "top.arbiter0"), "Glob matches");
+
+  // Later rules override earlier ones
+  levels.Clear();
+  levels.SetLevel("top.arbiter*", 3);
+  levels.SetLevel("*.arbiter1", 1);
+  NVHLS_ASSERT_MSG(match::DebugLevels::Active(), "Rules not active");
+  NVHLS_ASSERT_MSG(levels.LevelOf("top.arbiter0") == 3, "Wrong level");
+  NVHLS_ASSERT_MSG(levels.LevelOf("top.arbiter1") == 1, "Wrong level");
+  NVHLS_ASSERT_MSG(levels.LevelOf("top.other") == 0, "Wrong level");
+
+  Top top("top");
+  sc_start(20, SC_NS);
+
+  check(top.arbiter0, 3);
+  check(top.arbiter1, 1);
+  check(top.other, 0);
+
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <hls_globals.h>
+#include <nvhls_divsqrt.h>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+
+#ifndef DS_WIDTH
+#define DS_WIDTH 16
+#endif
+#ifndef DS_LUT_BITS
+#define DS_LUT_BITS 6
+#endif
+
+static const unsigned int kWidth = DS_WIDTH;
+static const unsigned int kLutBits = DS_LUT_BITS;
+static const unsigned long long kMask = (~0ULL) >> (64 - kWidth);
+static const int kRandom = 200000;
+
+// Random operand, with small values as likely as large ones
+unsigned long long RandomOperand() {
+  unsigned long long x = ((unsigned long long)rand() << 32) ^ rand();
+  return (x >> (rand() % kWidth)) & kMask;
+}
+
+long long SignExtend(unsigned long long x) {
+  return (long long)(x << (64 - kWidth)) >> (64 - kWidth);
+}
+
+// Feeds the inputs of Check through Pipe with bubbles and compares each
+// output with the combinational one from Latency valid cycles before
+template <typename Pipe>
+class PipeCheck {
+  typedef typename Pipe::In In;
+  typedef typename Pipe::Out Out;
+  Pipe pipe;
+  std::deque<Out> expected;
+  std::deque<int> cycles;
+  int cycle;
+
+ public:
+  PipeCheck() : cycle(0) {}
+
+  template <typename Same>
+  void run(const In& in, bool valid, const Out& ref, Same same) {
+    Out out;
+    bool out_valid;
+    pipe.run(in, valid, out, out_valid);
+    if (valid) {
+      expected.push_back(ref);
+      cycles.push_back(cycle);
+    }
+    if (out_valid) {
+      NVHLS_ASSERT_MSG(!expected.empty(), "Output without an input");
+      NVHLS_ASSERT_MSG(cycle - cycles.front() == (int)Pipe::Latency, "Wrong latency");
+      NVHLS_ASSERT_MSG(same(out, expected.front()), "Pipelined result differs");
+      expected.pop_front();
+      cycles.pop_front();
+    }
+    cycle++;
+  }
+
+  void drain() {
+    In in;
+    Out out;
+    for (unsigned int i = 0; i < Pipe::Latency; i++) {
+      run(in, false, out, [](const Out&, const Out&) { return true; });
+    }
+    NVHLS_ASSERT_MSG(expected.empty(), "Not all inputs came out");
+  }
+};
+
+template <bool Signed>
+void TestDivider() {
+  typedef nvhls::Divider<kWidth, Signed> Div;
+  typedef typename Div::Out Out;
+  PipeCheck<nvhls::ArithPipelined<Div, 3> > pipe;
+  auto same = [](const Out& a, const Out& b) { return a.q == b.q && a.r == b.r; };
+  for (int i = 0; i < kRandom; i++) {
+    unsigned long long n = RandomOperand();
+    unsigned long long d = (i % 16 == 0) ? 0 : RandomOperand();
+    if (i < 4) {
+      // Extremes: the most negative value over -1, all ones over 1
+      n = Signed ? (1ULL << (kWidth - 1)) : kMask;
+      d = Signed ? kMask : 1;
+    }
+    typename Div::In in;
+    in.n = n;
+    in.d = d;
+    Out out;
+    Div::compute(in, out);
+    unsigned long long q = out.q.to_uint64() & kMask;
+    unsigned long long r = out.r.to_uint64() & kMask;
+    unsigned long long q_ref, r_ref;
+    if (d == 0) {
+      q_ref = kMask;
+      r_ref = n;
+    } else if (Signed && n == (1ULL << (kWidth - 1)) && d == kMask) {
+      q_ref = n;
+      r_ref = 0;
+    } else if (Signed) {
+      q_ref = (unsigned long long)(SignExtend(n) / SignExtend(d)) & kMask;
+      r_ref = (unsigned long long)(SignExtend(n) % SignExtend(d)) & kMask;
+    } else {
+      q_ref = n / d;
+      r_ref = n % d;
+    }
+    NVHLS_ASSERT_MSG(q == q_ref, "Wrong quotient");
+    NVHLS_ASSERT_MSG(r == r_ref, "Wrong remainder");
+    pipe.run(in, rand() % 4 != 0, out, same);
+  }
+  pipe.drain();
+}
+
+// Reciprocal or InvSqrt: within one unit of the mantissa, exhaustively up
+// to 16 bits
+template <typename Unit, bool Sqrt>
+void TestNewtonRaphson() {
+  typedef typename Unit::Out Out;
+  PipeCheck<nvhls::ArithPipelined<Unit, 1> > pipe;
+  auto same = [](const Out& a, const Out& b) {
+    return a.mant == b.mant && a.exp == b.exp;
+  };
+  int count = (kWidth <= 16) ? (1 << kWidth) : kRandom;
+  for (int i = 0; i < count; i++) {
+    unsigned long long x = (kWidth <= 16) ? i : RandomOperand();
+    typename Unit::In in;
+    in.x = x;
+    Out out;
+    Unit::compute(in, out);
+    unsigned long long mant = out.mant.to_uint64();
+    int exp = out.exp.to_uint();
+    if (x == 0) {
+      NVHLS_ASSERT_MSG(mant == kMask && exp == 0, "Wrong result for zero");
+    } else {
+      NVHLS_ASSERT_MSG((mant >> (kWidth - 1)) == 1, "Mantissa not normalized");
+      double ref = Sqrt ? 1.0 / std::sqrt((double)x) : 1.0 / (double)x;
+      double err = std::fabs(std::ldexp((double)mant, -exp) - ref);
+      NVHLS_ASSERT_MSG(err < std::ldexp(1.0, -exp), "Result more than one unit off");
+    }
+    pipe.run(in, rand() % 4 != 0, out, same);
+  }
+  pipe.drain();
+}
+
+int sc_main(int argc, char *argv[]) {
+  srand(1);
+  TestDivider<false>();
+  TestDivider<true>();
+  TestNewtonRaphson<nvhls::Reciprocal<kWidth, kLutBits>, false>();
+  TestNewtonRaphson<nvhls::InvSqrt<kWidth, kLutBits>, true>();
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
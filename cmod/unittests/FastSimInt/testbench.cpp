@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_message.h>
+#include <TypeToBits.h>
+#include <fifo.h>
+#include <testbench/nvhls_rand.h>
+
+#ifndef NUM_ITERS
+#define NUM_ITERS 2000
+#endif
+
+// nvhls_t must map to fast_int up to 64 bits and to ac_int above
+static_assert(std::is_same<NVUINTW(12), nvhls::fast_int<12, false> >::value, "NVUINTW is not fast_int");
+static_assert(std::is_same<NVINTW(64), nvhls::fast_int<64, true> >::value, "NVINTW is not fast_int");
+static_assert(std::is_same<NVUINTW(65), ac_int<65, false> >::value, "wide NVUINTW is not ac_int");
+
+// Compares a fast_int result with the ac_int reference, type and value
+template <typename F, typename A>
+void Same(const F& f, const A& a, const char* op) {
+  static_assert(F::width == A::width && F::sign == A::sign, "result type differs from ac_int");
+  A fa = f;
+  if (fa != a) {
+    DCOUT(op << ": " << f << " vs " << a << endl);
+    NVHLS_ASSERT_MSG(false, "fast_int result differs from ac_int");
+  }
+}
+
+template <int W1, bool S1, int W2, bool S2>
+void CheckOps() {
+  for (int i = 0; i < NUM_ITERS; i++) {
+    unsigned long long r1 = nvhls::global_rng().next();
+    unsigned long long r2 = nvhls::global_rng().next();
+    if (i % 8 == 0) r2 = i % 3;
+    nvhls::fast_int<W1, S1> a = r1;
+    nvhls::fast_int<W2, S2> b = r2;
+    ac_int<W1, S1> ra = r1;
+    ac_int<W2, S2> rb = r2;
+    Same(a, ra, "ctor");
+
+    Same(a + b, ra + rb, "+");
+    Same(a - b, ra - rb, "-");
+    Same(a * b, ra * rb, "*");
+    if (rb != 0) {
+      Same(a / b, ra / rb, "/");
+      Same(a % b, ra % rb, "%");
+    }
+    Same(a & b, ra & rb, "&");
+    Same(a | b, ra | rb, "|");
+    Same(a ^ b, ra ^ rb, "^");
+    Same(-a, -ra, "unary -");
+    Same(~a, ~ra, "~");
+
+    int sh = static_cast<int>(r2 % 80) - 10;
+    Same(a << sh, ra << sh, "<<");
+    Same(a >> sh, ra >> sh, ">>");
+    NVHLS_ASSERT_MSG((a == b) == (ra == rb) && (a < b) == (ra < rb) && (a >= b) == (ra >= rb),
+                     "comparison differs from ac_int");
+
+    int n = static_cast<int>(r2);
+    Same(a + n, ra + n, "+ int");
+    Same(n * a, n * ra, "int *");
+    Same(a - rb, ra - rb, "- ac_int");
+
+    Same(a.template slc<5>(2), ra.template slc<5>(2), "slc");
+    int lsb = static_cast<int>(r2 % (W1 > 4 ? W1 - 4 : 1));
+    a.set_slc(lsb, nvhls::fast_int<4, false>(r1));
+    ra.set_slc(lsb, ac_int<4, false>(r1));
+    Same(a, ra, "set_slc");
+    a[lsb] = !a[lsb];
+    ra[lsb] = !ra[lsb];
+    Same(a, ra, "operator[]");
+    a += b;
+    ra += rb;
+    Same(a, ra, "+=");
+  }
+}
+
+class Message : public nvhls_message {
+ public:
+  NVUINT5 a;
+  NVINT20 b;
+  NVUINTW(70) c;
+  static const unsigned int width = 5 + 20 + 70;
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m& a;
+    m& b;
+    m& c;
+  }
+};
+
+class RefMessage : public nvhls_message {
+ public:
+  ac_int<5, false> a;
+  ac_int<20, true> b;
+  ac_int<70, false> c;
+  static const unsigned int width = 5 + 20 + 70;
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m& a;
+    m& b;
+    m& c;
+  }
+};
+
+// Marshalled fast_int fields give the bits of the ac_int fields
+void CheckMarshall() {
+  for (int i = 0; i < NUM_ITERS; i++) {
+    RefMessage ref = nvhls::gen_random_payload<RefMessage>();
+    Message msg;
+    msg.a = ref.a;
+    msg.b = ref.b;
+    msg.c = ref.c;
+    sc_lv<Message::width> bits = TypeToBits<Message>(msg);
+    NVHLS_ASSERT_MSG(bits == TypeToBits<RefMessage>(ref), "TypeToBits differs from ac_int");
+    Message back = BitsToType<Message>(bits);
+    NVHLS_ASSERT_MSG(back.a == ref.a && back.b == ref.b && back.c == ref.c, "BitsToType differs from ac_int");
+  }
+}
+
+// Library components take fast_int through NVUINTW
+void CheckFifo() {
+  FIFO<NVUINTW(12), 4> fifo;
+  fifo.reset();
+  for (int i = 0; i < NUM_ITERS; i++) {
+    NVUINTW(12) data = nvhls::get_rand<12>();
+    fifo.push(data);
+    NVHLS_ASSERT_MSG(fifo.pop() == data, "FIFO returned wrong data");
+  }
+}
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+
+  CheckOps<5, false, 7, true>();
+  CheckOps<16, true, 16, false>();
+  CheckOps<32, false, 33, true>();
+  CheckOps<40, true, 24, true>();
+  CheckOps<63, false, 1, false>();
+  CheckOps<64, true, 64, false>();
+  CheckOps<64, false, 32, true>();
+  CheckMarshall();
+  CheckFifo();
+
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
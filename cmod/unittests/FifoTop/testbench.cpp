@@ -15,6 +15,7 @@
  */
 #include <stdio.h>
 #include "FifoTop.h"
+#include <damq.h>
 #include <match_scverify.h>
 #include <testbench/nvhls_rand.h>
 
@@ -38,6 +39,240 @@ OpType semi_rand_op(int size)
     return op;
 }
 
+// Bank-parallel operations against a per-bank reference
+void test_multi()
+{
+    Fifo_ fifo;
+    std::deque<MemWord_t> ref_q[NUM_BANKS];
+    MemWord_t data[NUM_BANKS], out[NUM_BANKS];
+
+    for (int i=0; i< NUM_ITER; ++i)
+    {
+        Fifo_::BankMask mask = 0;
+        bool do_push = rand()%2;
+        for (int j=0; j< NUM_BANKS; ++j)
+        {
+            bool ok = do_push ? (ref_q[j].size() < FIFO_LENGTH) : !ref_q[j].empty();
+            mask[j] = ok && (rand()%2);
+            data[j] = rand();
+        }
+        if (do_push)
+        {
+            fifo.push_multi(data, mask);
+            for (int j=0; j< NUM_BANKS; ++j)
+                if (mask[j]) ref_q[j].push_back(data[j]);
+        }
+        else
+        {
+            fifo.peek_multi(mask, out);
+            for (int j=0; j< NUM_BANKS; ++j)
+                if (mask[j]) assert(out[j] == ref_q[j].front());
+            fifo.pop_multi(mask, out);
+            for (int j=0; j< NUM_BANKS; ++j)
+            {
+                if (mask[j])
+                {
+                    assert(out[j] == ref_q[j].front());
+                    ref_q[j].pop_front();
+                }
+            }
+        }
+        Fifo_::BankMask empty = fifo.isEmpty_multi();
+        Fifo_::BankMask full = fifo.isFull_multi();
+        for (int j=0; j< NUM_BANKS; ++j)
+        {
+            assert(empty[j] == ref_q[j].empty());
+            assert(full[j] == (ref_q[j].size() == FIFO_LENGTH));
+        }
+    }
+}
+
+// Burst push/pop, lookahead and watermarks on one bank
+template <typename Fifo>
+void test_bulk()
+{
+    static const unsigned int MaxBurst = FIFO_LENGTH;
+    Fifo fifo;
+    std::deque<MemWord_t> ref_q;
+    MemWord_t burst[MaxBurst];
+    BankIdx bank = NUM_BANKS - 1;
+
+    for (int i=0; i< NUM_ITER; ++i)
+    {
+        unsigned num;
+        if (rand()%2)
+        {
+            num = rand() % (FIFO_LENGTH - ref_q.size() + 1);
+            for (unsigned j=0; j< num; ++j)
+            {
+                burst[j] = rand();
+                ref_q.push_back(burst[j]);
+            }
+            fifo.push_n(burst, num, bank);
+        }
+        else
+        {
+            num = rand() % (ref_q.size() + 1);
+            fifo.pop_n(burst, num, bank);
+            for (unsigned j=0; j< num; ++j)
+            {
+                assert(burst[j] == ref_q.front());
+                ref_q.pop_front();
+            }
+        }
+        assert(fifo.NumFilled(bank) == ref_q.size());
+        for (unsigned j=0; j< ref_q.size(); ++j)
+            assert(fifo.peek_at(j, bank) == ref_q[j]);
+        assert(fifo.isAlmostFull(1, bank) == (FIFO_LENGTH - ref_q.size() <= 1));
+        assert(fifo.isAlmostEmpty(1, bank) == (ref_q.size() <= 1));
+        assert(fifo.isEmpty(0) || NUM_BANKS == 1);
+    }
+}
+
+// Single-entry operations on every bank, for the non-default storage policies
+template <typename Fifo>
+void test_storage()
+{
+    Fifo fifo;
+    std::deque<MemWord_t> ref_q[NUM_BANKS];
+
+    for (int i=0; i< NUM_ITER; ++i)
+    {
+        unsigned int bank = rand() % NUM_BANKS;
+        switch (rand() % 4)
+        {
+            case 0:
+                // pop before push in the same cycle
+                if (!ref_q[bank].empty())
+                {
+                    assert(fifo.pop(bank) == ref_q[bank].front());
+                    ref_q[bank].pop_front();
+                }
+                // fall through
+            case 1:
+                if (ref_q[bank].size() < FIFO_LENGTH)
+                {
+                    MemWord_t data = rand();
+                    fifo.push(data, bank);
+                    ref_q[bank].push_back(data);
+                }
+                break;
+            case 2:
+                if (!ref_q[bank].empty())
+                {
+                    fifo.incrHead(bank);
+                    ref_q[bank].pop_front();
+                }
+                break;
+            default:
+                if (!ref_q[bank].empty())
+                {
+                    assert(fifo.pop(bank) == ref_q[bank].front());
+                    ref_q[bank].pop_front();
+                }
+                break;
+        }
+        assert(fifo.isEmpty(bank) == ref_q[bank].empty());
+        assert(fifo.isFull(bank) == (ref_q[bank].size() == FIFO_LENGTH));
+        if (!ref_q[bank].empty())
+            assert(fifo.peek(bank) == ref_q[bank].front());
+    }
+}
+
+// Shared pools: NUM_BANKS queues in 2 pools of FIFO_LENGTH * NUM_BANKS / 2
+// entries each, any of which a single queue may take
+void test_damq()
+{
+    static const unsigned int NumQueues = (NUM_BANKS + 1) / 2;
+    static const unsigned int PoolSize = FIFO_LENGTH * NumQueues;
+    typedef DAMQ<MemWord_t, PoolSize, NumQueues, 2> Damq;
+    Damq damq;
+    std::deque<MemWord_t> ref_q[2 * NumQueues];
+    MemWord_t data[2 * NumQueues], out[2 * NumQueues];
+
+    for (int i=0; i< NUM_ITER; ++i)
+    {
+        unsigned int used[2] = {0, 0};
+        for (unsigned j=0; j< 2 * NumQueues; ++j)
+            used[j / NumQueues] += ref_q[j].size();
+
+        Damq::BankMask mask = 0;
+        bool do_push = rand()%2;
+        for (unsigned j=0; j< 2 * NumQueues; ++j)
+        {
+            // one queue per pool, so that a push never overflows its pool
+            bool ok = do_push ? (used[j / NumQueues] < PoolSize) : !ref_q[j].empty();
+            mask[j] = ok && (rand() % NumQueues == 0);
+            data[j] = rand();
+            if (mask[j] && do_push)
+                used[j / NumQueues] = PoolSize;
+        }
+        if (do_push)
+        {
+            damq.push_multi(data, mask);
+            for (unsigned j=0; j< 2 * NumQueues; ++j)
+                if (mask[j]) ref_q[j].push_back(data[j]);
+        }
+        else
+        {
+            damq.peek_multi(mask, out);
+            for (unsigned j=0; j< 2 * NumQueues; ++j)
+                if (mask[j]) assert(out[j] == ref_q[j].front());
+            damq.incrHead_multi(mask);
+            for (unsigned j=0; j< 2 * NumQueues; ++j)
+                if (mask[j]) ref_q[j].pop_front();
+        }
+        if (rand() % 1000 == 0)
+        {
+            damq.reset();
+            for (unsigned j=0; j< 2 * NumQueues; ++j)
+                ref_q[j].clear();
+        }
+
+        used[0] = used[1] = 0;
+        for (unsigned j=0; j< 2 * NumQueues; ++j)
+            used[j / NumQueues] += ref_q[j].size();
+        for (unsigned j=0; j< 2 * NumQueues; ++j)
+        {
+            assert(damq.isEmpty(j) == ref_q[j].empty());
+            assert(damq.NumFilled(j) == ref_q[j].size());
+            assert(damq.isFull(j) == (used[j / NumQueues] == PoolSize));
+            if (!ref_q[j].empty())
+                assert(damq.peek(j) == ref_q[j].front());
+        }
+    }
+}
+
+// transfer() of a BypassFIFO against a reference queue with a bypass path
+template <typename Fifo, unsigned int Len, unsigned int Banks>
+void test_bypass()
+{
+    Fifo fifo;
+    std::deque<MemWord_t> ref_q[Banks];
+
+    for (int i=0; i< NUM_ITER; ++i)
+    {
+        unsigned int bank = rand() % Banks;
+        bool wr_valid = rand() % 2;
+        bool rd_ready = rand() % 2;
+        MemWord_t data = rand();
+        MemWord_t out;
+        bool wr_ready;
+        bool rd_valid = fifo.transfer(wr_valid, data, rd_ready, out, wr_ready, bank);
+
+        bool empty = ref_q[bank].empty();
+        assert(rd_valid == (!empty || wr_valid));
+        assert(wr_ready == (ref_q[bank].size() < Len || (!empty && rd_ready) || (Len == 0 && rd_ready)));
+        if (rd_valid)
+            assert(out == (empty ? data : ref_q[bank].front()));
+        if (wr_valid && wr_ready)
+            ref_q[bank].push_back(data);
+        if (rd_valid && rd_ready)
+            ref_q[bank].pop_front();
+        assert(ref_q[bank].size() <= Len);
+    }
+}
+
 CCS_MAIN(int argc, char *argv[]) {
 
     nvhls::set_random_seed();
@@ -118,6 +353,17 @@ CCS_MAIN(int argc, char *argv[]) {
         }
     }
 
+    test_multi();
+    test_bulk<Fifo_>();
+    test_bulk<FIFO<MemWord_t, FIFO_LENGTH, NUM_BANKS, FifoStorageFlop> >();
+    test_bulk<FIFO<MemWord_t, FIFO_LENGTH, NUM_BANKS, FifoStorageSram> >();
+    test_storage<FIFO<MemWord_t, FIFO_LENGTH, NUM_BANKS, FifoStorageFlop> >();
+    test_storage<FIFO<MemWord_t, FIFO_LENGTH, NUM_BANKS, FifoStorageSram> >();
+    test_damq();
+    test_bypass<BypassFIFO<MemWord_t, FIFO_LENGTH, NUM_BANKS>, FIFO_LENGTH, NUM_BANKS>();
+    test_bypass<BypassFIFO<MemWord_t, 1, 1>, 1, 1>();
+    test_bypass<BypassFIFO<MemWord_t, 0, 1>, 0, 1>();
+
     DCOUT("CMODEL PASS" << endl);
     CCS_RETURN(0) ;
 }
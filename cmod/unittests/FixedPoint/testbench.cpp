@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <nvhls_vector.h>
+#include <cstdlib>
+
+using namespace nvhls;
+
+static const int kVectorLength = 8;
+static const int kRandom = 20000;
+
+template <typename T>
+long long Value(const T& x) {
+  return Wrapped<T>::is_signed ? x.to_int64() : (long long)x.to_uint64();
+}
+
+template <typename T>
+long long Clamp(long long v) {
+  const int W = Wrapped<T>::width;
+  long long hi = Wrapped<T>::is_signed ? (1LL << (W - 1)) - 1 : (1LL << W) - 1;
+  long long lo = Wrapped<T>::is_signed ? -(1LL << (W - 1)) : 0;
+  return v > hi ? hi : (v < lo ? lo : v);
+}
+
+// v / 2^shift in the given rounding mode
+long long Round(long long v, unsigned int shift, round_mode mode) {
+  if (shift == 0) {
+    return v;
+  }
+  long long q = v >> shift;
+  long long frac = v - q * (1LL << shift);
+  long long half = 1LL << (shift - 1);
+  switch (mode) {
+    case ROUND_TRN_ZERO:
+      return (v < 0 && frac != 0) ? q + 1 : q;
+    case ROUND_RND:
+      return (frac >= half) ? q + 1 : q;
+    case ROUND_RND_CONV:
+      return (frac > half || (frac == half && (q & 1))) ? q + 1 : q;
+    default:
+      return q;
+  }
+}
+
+template <typename OutType, unsigned int Shift, round_mode Mode>
+void TestRoundSat() {
+  for (long long v = -2048; v < 2048; v++) {
+    NVINT12 x = v;
+    OutType out = round_sat<OutType, Shift, Mode>(x);
+    NVHLS_ASSERT_MSG(Value(out) == Clamp<OutType>(Round(v, Shift, Mode)),
+                     "round_sat mismatch");
+  }
+}
+
+// Every pair of inputs, and every accumulator input for fused_mac
+template <typename InType1, typename InType2, typename OutType>
+void TestScalar() {
+  const int W1 = Wrapped<InType1>::width;
+  const int W2 = Wrapped<InType2>::width;
+  for (int a = 0; a < (1 << W1); a++) {
+    for (int b = 0; b < (1 << W2); b++) {
+      InType1 x = a;
+      InType2 y = b;
+      long long xv = Value(x);
+      long long yv = Value(y);
+      NVHLS_ASSERT_MSG(Value(sat_add<OutType>(x, y)) == Clamp<OutType>(xv + yv),
+                       "sat_add mismatch");
+      NVHLS_ASSERT_MSG(Value(sat_sub<OutType>(x, y)) == Clamp<OutType>(xv - yv),
+                       "sat_sub mismatch");
+      NVHLS_ASSERT_MSG(Value(sat_mul<OutType>(x, y)) == Clamp<OutType>(xv * yv),
+                       "sat_mul mismatch");
+      NVHLS_ASSERT_MSG(Value(sat_mul<OutType, 3, ROUND_RND_CONV>(x, y)) ==
+                           Clamp<OutType>(Round(xv * yv, 3, ROUND_RND_CONV)),
+                       "sat_mul rounding mismatch");
+      for (int c = -8; c < 8; c++) {
+        NVINT4 z = c;
+        NVHLS_ASSERT_MSG(Value(fused_mac<OutType, 2, ROUND_RND>(x, y, z)) ==
+                             Clamp<OutType>(Round(xv * yv + c * 4, 2, ROUND_RND)),
+                         "fused_mac mismatch");
+      }
+    }
+  }
+}
+
+// The vector functions against the scalar ones, and dpacc_fused into a
+// narrow accumulator against the exact dot product
+void TestVector() {
+  typedef nv_scvector<NVINT8, kVectorLength> Vec;
+  typedef nv_scvector<NVINT16, kVectorLength> AccVec;
+  for (int i = 0; i < kRandom; i++) {
+    Vec v1, v2, out;
+    AccVec acc, acc_out;
+    for (int k = 0; k < kVectorLength; k++) {
+      v1[k] = rand() % 256 - 128;
+      v2[k] = rand() % 256 - 128;
+      acc[k] = rand() % 65536 - 32768;
+    }
+    vector_sat_add<NVINT8, NVINT8, NVINT8, kVectorLength, true>(v1, v2, out);
+    for (int k = 0; k < kVectorLength; k++) {
+      NVHLS_ASSERT_MSG(out[k] == sat_add<NVINT8>(v1[k], v2[k]), "vector_sat_add mismatch");
+    }
+    vector_sat_sub<NVINT8, NVINT8, NVINT8, kVectorLength, false>(v1, v2, out);
+    for (int k = 0; k < kVectorLength; k++) {
+      NVHLS_ASSERT_MSG(out[k] == sat_sub<NVINT8>(v1[k], v2[k]), "vector_sat_sub mismatch");
+    }
+    vector_sat_mul<NVINT8, NVINT8, NVINT8, kVectorLength, true, 7, ROUND_RND>(v1, v2, out);
+    for (int k = 0; k < kVectorLength; k++) {
+      NVHLS_ASSERT_MSG(out[k] == (sat_mul<NVINT8, 7, ROUND_RND>(v1[k], v2[k])),
+                       "vector_sat_mul mismatch");
+    }
+    vector_fused_mac<NVINT8, NVINT8, NVINT16, NVINT16, kVectorLength, true, 7,
+                     ROUND_RND_CONV>(v1, v2, acc, acc_out);
+    for (int k = 0; k < kVectorLength; k++) {
+      NVHLS_ASSERT_MSG(acc_out[k] == (fused_mac<NVINT16, 7, ROUND_RND_CONV>(v1[k], v2[k], acc[k])),
+                       "vector_fused_mac mismatch");
+    }
+
+    NVINT16 dot_in = acc[0];
+    NVINT16 dot;
+    dpacc_fused<NVINT8, NVINT8, NVINT16, NVINT16, kVectorLength, 4, ROUND_RND>(v1, v2, dot_in, dot);
+    long long exact = Value(dot_in) * 16;
+    for (int k = 0; k < kVectorLength; k++) {
+      exact += Value(v1[k]) * Value(v2[k]);
+    }
+    NVHLS_ASSERT_MSG(Value(dot) == Clamp<NVINT16>(Round(exact, 4, ROUND_RND)),
+                     "dpacc_fused mismatch");
+  }
+}
+
+int sc_main(int argc, char *argv[]) {
+  srand(1);
+  TestRoundSat<NVINT6, 0, ROUND_TRN>();
+  TestRoundSat<NVINT6, 3, ROUND_TRN>();
+  TestRoundSat<NVINT6, 3, ROUND_TRN_ZERO>();
+  TestRoundSat<NVINT6, 3, ROUND_RND>();
+  TestRoundSat<NVINT6, 3, ROUND_RND_CONV>();
+  TestRoundSat<NVUINT5, 2, ROUND_RND>();
+  TestRoundSat<NVINT12, 4, ROUND_RND_CONV>();
+  TestScalar<NVINT5, NVINT5, NVINT5>();
+  TestScalar<NVUINT5, NVINT4, NVINT6>();
+  TestScalar<NVUINT5, NVUINT5, NVUINT5>();
+  TestScalar<NVINT6, NVUINT3, NVUINT4>();
+  TestVector();
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
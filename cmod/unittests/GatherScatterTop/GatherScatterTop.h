@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __GATHERSCATTERTOP_H__
+#define __GATHERSCATTERTOP_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <GatherScatter.h>
+
+// Four lanes over four banks, with room for GS_IN_FLIGHT gathers
+#ifndef GS_IN_FLIGHT
+#define GS_IN_FLIGHT 8
+#endif
+
+SC_MODULE(GatherScatterTop) {
+ public:
+  enum {
+    kNumEntries = 256,
+    kNumLanes = 4,
+    kNumBanks = 4,
+    kInputQueueLen = 2,
+    kInFlight = GS_IN_FLIGHT,
+  };
+
+  typedef GatherScatter<NVUINT32, kNumEntries, kNumLanes, kNumBanks,
+                        kInputQueueLen, kInFlight> Engine_t;
+  typedef Engine_t::req_t req_t;
+  typedef Engine_t::rsp_t rsp_t;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::In<req_t> req_in;
+  Connections::Out<rsp_t> rsp_out;
+
+  Engine_t engine;
+
+  SC_HAS_PROCESS(GatherScatterTop);
+  GatherScatterTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        req_in("req_in"),
+        rsp_out("rsp_out"),
+        engine("engine") {
+    engine.clk(clk);
+    engine.rst(rst);
+    engine.req_in(req_in);
+    engine.rsp_out(rsp_out);
+  }
+};
+
+#endif
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GatherScatterTop.h"
+#include <systemc.h>
+#include <mc_scverify.h>
+#include <testbench/nvhls_rand.h>
+#include <nvhls_connections.h>
+
+#define NVHLS_VERIFY_BLOCKS (GatherScatterTop)
+#include <nvhls_verify.h>
+
+#include <deque>
+
+using namespace ::std;
+typedef GatherScatterTop::req_t req_t;
+typedef GatherScatterTop::rsp_t rsp_t;
+static const int kNumEntries = GatherScatterTop::kNumEntries;
+static const int kNumLanes = GatherScatterTop::kNumLanes;
+static const int kNumVectors = 1000;
+
+static const int kDebugLevel = 1;
+
+// Issues a scatter of the whole memory and then random gathers and
+// scatters. Scatters keep every address in the lane of its low bits, so
+// the scatters of an address land in order.
+SC_MODULE(Source) {
+  Connections::Out<req_t> out;
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+  deque<rsp_t>& expected;
+  unsigned sent;
+
+  void run() {
+    out.Reset();
+    NVUINT32 ref[kNumEntries];
+    wait();
+    for (int base = 0; base < kNumEntries; base += kNumLanes) {
+      req_t vec;
+      vec.type.val = CLITYPE_T::STORE;
+      for (int l = 0; l < kNumLanes; l++) {
+        vec.valids[l] = true;
+        vec.addr[l] = base + l;
+        vec.data[l] = ref[base + l] = rand();
+      }
+      out.Push(vec);
+    }
+    for (unsigned i = 0; i < kNumVectors; i++) {
+      req_t vec;
+      bool gather = (rand() % 3 != 0);
+      vec.type.val = gather ? CLITYPE_T::LOAD : CLITYPE_T::STORE;
+      rsp_t rsp;
+      for (int l = 0; l < kNumLanes; l++) {
+        vec.valids[l] = (rand() % 4 != 0);
+        // Gathers often hit one bank to force conflicts
+        int addr = (rand() % 2) ? (rand() % kNumEntries)
+                                : (rand() % (kNumEntries / kNumLanes)) * kNumLanes;
+        if (!gather) {
+          addr = (addr & ~(kNumLanes - 1)) | l;
+        }
+        vec.addr[l] = addr;
+        vec.data[l] = rand();
+        rsp.valids[l] = vec.valids[l];
+        rsp.data[l] = ref[addr];
+        if (!gather && vec.valids[l]) {
+          ref[addr] = vec.data[l];
+        }
+      }
+      if (gather) {
+        expected.push_back(rsp);
+        sent++;
+      }
+      out.Push(vec);
+      wait(rand() % 2);
+    }
+    while (1) {
+      wait();
+    }
+  }
+
+  SC_HAS_PROCESS(Source);
+  Source(sc_module_name name_, deque<rsp_t>& expected_)
+      : sc_module(name_), out("out"), clk("clk"), rst("rst"),
+        expected(expected_), sent(0) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+// Checks the gathered vectors in order, stalling now and then
+SC_MODULE(Sink) {
+  Connections::In<rsp_t> in;
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+  deque<rsp_t>& expected;
+  unsigned received;
+
+  void run() {
+    in.Reset();
+    while (1) {
+      wait();
+      rsp_t rsp;
+      if ((rand() % 4 != 0) && in.PopNB(rsp)) {
+        NVHLS_ASSERT_MSG(!expected.empty(), "Unexpected gather response");
+        rsp_t ref = expected.front();
+        expected.pop_front();
+        for (int l = 0; l < kNumLanes; l++) {
+          CDCOUT(sc_time_stamp() << " lane " << l << " valid=" << rsp.valids[l]
+                 << " data=" << rsp.data[l] << endl, kDebugLevel);
+          NVHLS_ASSERT_MSG(rsp.valids[l] == ref.valids[l], "Wrong lane valids");
+          if (ref.valids[l]) {
+            NVHLS_ASSERT_MSG(rsp.data[l] == ref.data[l], "Wrong gathered data");
+          }
+        }
+        received++;
+      }
+    }
+  }
+
+  SC_HAS_PROCESS(Sink);
+  Sink(sc_module_name name_, deque<rsp_t>& expected_)
+      : sc_module(name_), in("in"), clk("clk"), rst("rst"),
+        expected(expected_), received(0) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+SC_MODULE(testbench) {
+  NVHLS_DESIGN(GatherScatterTop) dut;
+  deque<rsp_t> expected;
+  Source source;
+  Sink sink;
+
+  sc_clock clk;
+  sc_signal<bool> rst;
+  Connections::Combinational<req_t> req;
+  Connections::Combinational<rsp_t> rsp;
+
+  SC_CTOR(testbench)
+      : dut("dut"),
+        source("source", expected),
+        sink("sink", expected),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        rst("rst") {
+    Connections::set_sim_clk(&clk);
+
+    dut.clk(clk);
+    dut.rst(rst);
+    source.clk(clk);
+    source.rst(rst);
+    sink.clk(clk);
+    sink.rst(rst);
+
+    source.out(req);
+    dut.req_in(req);
+    dut.rsp_out(rsp);
+    sink.in(rsp);
+
+    SC_THREAD(run);
+  }
+
+  void run() {
+    rst = 0;
+    cout << "@" << sc_time_stamp() << " Asserting Reset " << endl;
+    wait(2, SC_NS);
+    cout << "@" << sc_time_stamp() << " Deasserting Reset " << endl;
+    rst = 1;
+    wait(20000, SC_NS);
+    cout << "@" << sc_time_stamp() << " Stop " << endl;
+    cout << "sent " << source.sent << " gathers, received " << sink.received
+         << endl;
+    NVHLS_ASSERT_MSG(source.sent > 0 && sink.received == source.sent,
+                     "Not all gathers were answered");
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char* argv[]) {
+  nvhls::set_random_seed();
+  testbench my_testbench("my_testbench");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    cout << "Simulation FAILED\n";
+  else
+    cout << "Simulation PASSED\n";
+  return rc;
+};
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __HASHTABLETOP_H__
+#define __HASHTABLETOP_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <HashTable.h>
+
+// 32-bit keys and 16-bit values in HT_NUM_HASHES banks of 64 entries
+#ifndef HT_NUM_HASHES
+#define HT_NUM_HASHES 4
+#endif
+
+#ifndef HT_STASH_ENTRIES
+#define HT_STASH_ENTRIES 4
+#endif
+
+SC_MODULE(HashTableTop) {
+ public:
+  typedef HashTable<32, 16, 64, HT_NUM_HASHES, HT_STASH_ENTRIES> Table_t;
+  typedef Table_t::Request Request;
+  typedef Table_t::Response Response;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Connections::In<Request> req_in;
+  Connections::Out<Response> rsp_out;
+
+  Table_t table;
+
+  SC_HAS_PROCESS(HashTableTop);
+  HashTableTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        req_in("req_in"),
+        rsp_out("rsp_out"),
+        table("table") {
+    table.clk(clk);
+    table.rst(rst);
+    table.req_in(req_in);
+    table.rsp_out(rsp_out);
+  }
+};
+
+#endif
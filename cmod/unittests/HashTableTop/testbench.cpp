@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HashTableTop.h"
+#include <systemc.h>
+#include <mc_scverify.h>
+#include <testbench/nvhls_rand.h>
+#include <nvhls_connections.h>
+
+#include <deque>
+#include <map>
+
+using namespace ::std;
+typedef HashTableTop::Table_t Table_t;
+typedef HashTableTop::Request Request;
+typedef HashTableTop::Response Response;
+static const int kNumRequests = 20000;
+
+// Fills the table with consecutive keys, past its capacity, then sends
+// random lookups, inserts and erases over a few more keys than fit
+SC_MODULE(Source) {
+  Connections::Out<Request> out;
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+  deque<Request>& sent_reqs;
+  unsigned sent;
+
+  void send(unsigned op, unsigned key) {
+    Request req;
+    req.op = op;
+    req.key = key;
+    req.val = rand() & 0xffff;
+    sent_reqs.push_back(req);
+    out.Push(req);
+    sent++;
+  }
+
+  void run() {
+    out.Reset();
+    wait();
+    for (int key = 0; key < Table_t::kCapacity + 40; key++) {
+      send(Table_t::kInsert, key);
+    }
+    while (sent < kNumRequests) {
+      unsigned key = rand() % (Table_t::kCapacity + 20);
+      int p = rand() % 8;
+      send(p < 3 ? Table_t::kLookup : (p < 6 ? Table_t::kInsert : Table_t::kErase), key);
+      if (rand() % 4 == 0) {
+        wait();
+      }
+    }
+  }
+
+  SC_HAS_PROCESS(Source);
+  Source(sc_module_name name_, deque<Request>& sent_reqs_)
+      : sc_module(name_), out("out"), clk("clk"), rst("rst"),
+        sent_reqs(sent_reqs_), sent(0) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+// Checks every response against a map of the keys stored, stalling now
+// and then
+SC_MODULE(Sink) {
+  Connections::In<Response> in;
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+  deque<Request>& sent_reqs;
+  map<unsigned, unsigned> ref;
+  unsigned received;
+  unsigned failures;
+
+  void run() {
+    in.Reset();
+    while (1) {
+      wait();
+      Response rsp;
+      if ((rand() % 8 != 0) && in.PopNB(rsp)) {
+        NVHLS_ASSERT_MSG(!sent_reqs.empty(), "Unexpected response");
+        Request req = sent_reqs.front();
+        sent_reqs.pop_front();
+        unsigned key = req.key.to_uint();
+        bool present = (ref.count(key) != 0);
+        NVHLS_ASSERT_MSG(rsp.hit == present, "Wrong hit");
+        if (req.op == Table_t::kLookup && present) {
+          NVHLS_ASSERT_MSG(rsp.val == ref[key], "Wrong value");
+        } else if (req.op == Table_t::kInsert) {
+          if (rsp.stored) {
+            ref[key] = req.val.to_uint();
+          } else {
+            NVHLS_ASSERT_MSG(!present, "Value of a stored key not updated");
+            // Cuckoo hashing with two hash functions fills about half the table
+            NVHLS_ASSERT_MSG(ref.size() >= Table_t::kCapacity / 3, "Insert failed in a table mostly empty");
+            failures++;
+          }
+        } else if (req.op == Table_t::kErase) {
+          ref.erase(key);
+        }
+        received++;
+      }
+    }
+  }
+
+  SC_HAS_PROCESS(Sink);
+  Sink(sc_module_name name_, deque<Request>& sent_reqs_)
+      : sc_module(name_), in("in"), clk("clk"), rst("rst"),
+        sent_reqs(sent_reqs_), received(0), failures(0) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+SC_MODULE(testbench) {
+  CCS_DESIGN(HashTableTop) dut;
+  deque<Request> sent_reqs;
+  Source source;
+  Sink sink;
+
+  sc_clock clk;
+  sc_signal<bool> rst;
+  Connections::Combinational<Request> req;
+  Connections::Combinational<Response> rsp;
+
+  SC_CTOR(testbench)
+      : dut("dut"),
+        source("source", sent_reqs),
+        sink("sink", sent_reqs),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        rst("rst") {
+    Connections::set_sim_clk(&clk);
+
+    dut.clk(clk);
+    dut.rst(rst);
+    source.clk(clk);
+    source.rst(rst);
+    sink.clk(clk);
+    sink.rst(rst);
+
+    source.out(req);
+    dut.req_in(req);
+    dut.rsp_out(rsp);
+    sink.in(rsp);
+
+    SC_THREAD(run);
+  }
+
+  void run() {
+    rst = 0;
+    cout << "@" << sc_time_stamp() << " Asserting Reset " << endl;
+    wait(2, SC_NS);
+    cout << "@" << sc_time_stamp() << " Deasserting Reset " << endl;
+    rst = 1;
+    wait(60000, SC_NS);
+    cout << "@" << sc_time_stamp() << " Stop " << endl;
+    cout << "sent " << source.sent << " requests, received " << sink.received
+         << ", " << sink.failures << " inserts failed, " << sink.ref.size()
+         << " of " << Table_t::kCapacity << " entries used" << endl;
+    NVHLS_ASSERT_MSG(source.sent == kNumRequests && sink.received == source.sent,
+                     "Not all requests were answered");
+    dut.table.DumpStats(std::cout, 0, NULL);
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char* argv[]) {
+  nvhls::set_random_seed();
+  testbench my_testbench("my_testbench");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    cout << "Simulation FAILED\n";
+  else
+    cout << "Simulation PASSED\n";
+  return rc;
+};
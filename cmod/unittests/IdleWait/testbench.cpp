@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_idle_wait.h>
+
+#include <utility>
+#include <vector>
+
+#ifndef NUM_MESSAGES
+#define NUM_MESSAGES 500
+#endif
+
+typedef NVUINTW(16) Word_t;
+
+// Sends the same sparse, bursty stream on both outputs
+SC_MODULE(Producer) {
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::Out<Word_t> out[2];
+
+  SC_CTOR(Producer) : clk("clk"), rst("rst") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void run() {
+    out[0].Reset();
+    out[1].Reset();
+    wait();
+    unsigned int cycle = 0;
+    unsigned int i = 0;
+    bool pending[2] = {false, false};
+    Word_t data = 0;
+    while (1) {
+      // Bursts of three messages, then a gap that grows up to 60 cycles
+      if (!pending[0] && !pending[1] && i < NUM_MESSAGES && cycle % (20 + (i % 41)) < 3) {
+        data = i++;
+        pending[0] = pending[1] = true;
+      }
+      for (unsigned int k = 0; k < 2; k++) {
+        if (pending[k] && out[k].PushNB(data)) {
+          pending[k] = false;
+        }
+      }
+      wait();
+      cycle++;
+    }
+  }
+};
+
+// Pops with a one-cycle think time after every message, and logs the cycle
+// of each pop. With sleep set, it skips its idle cycles with an IdleWait.
+SC_MODULE(Consumer) {
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<Word_t> in;
+
+  bool sleep;
+  match::IdleWait idle;
+  std::vector<std::pair<unsigned int, sc_time> > pops;
+
+  SC_CTOR(Consumer) : clk("clk"), rst("rst"), in("in"), sleep(false) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    idle.SetClock(clk);
+    idle.Watch(in);
+  }
+
+  void run() {
+    in.Reset();
+    pops.clear();
+    unsigned int cycle = 0;
+    wait();
+    while (1) {
+      Word_t msg;
+      if (in.PopNB(msg)) {
+        NVHLS_ASSERT_MSG(msg.to_uint() == pops.size(), "Messages out of order");
+        pops.push_back(std::make_pair(cycle, sc_time_stamp()));
+        wait();
+        cycle++;
+      }
+      wait();
+      cycle++;
+      if (sleep) {
+        cycle += idle.Sleep();
+      }
+    }
+  }
+};
+
+SC_MODULE(testbench) {
+  sc_clock clk;
+  sc_signal<bool> rst;
+
+  Producer producer;
+  Consumer polling;
+  Consumer sleeping;
+  Connections::Combinational<Word_t> chan[2];
+
+  SC_CTOR(testbench)
+      : clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true), rst("rst"), producer("producer"), polling("polling"),
+        sleeping("sleeping") {
+    Connections::set_sim_clk(&clk);
+    producer.clk(clk);
+    producer.rst(rst);
+    polling.clk(clk);
+    polling.rst(rst);
+    sleeping.clk(clk);
+    sleeping.rst(rst);
+    producer.out[0](chan[0]);
+    producer.out[1](chan[1]);
+    polling.in(chan[0]);
+    sleeping.in(chan[1]);
+    sleeping.sleep = true;
+
+    SC_THREAD(run);
+    sensitive << clk.posedge_event();
+  }
+
+  void run() {
+    rst = 0;
+    wait(10);
+    rst = 1;
+    unsigned int cycles = 0;
+    while (sleeping.pops.size() < NUM_MESSAGES || polling.pops.size() < NUM_MESSAGES) {
+      wait();
+      NVHLS_ASSERT_MSG(++cycles < 100 * NUM_MESSAGES, "Timed out");
+    }
+    wait(5);
+    // Same pops in the same cycles, and the same cycle counts
+    for (unsigned int i = 0; i < NUM_MESSAGES; i++) {
+      NVHLS_ASSERT_MSG(sleeping.pops[i].second == polling.pops[i].second,
+                       "Sleeping consumer popped in another cycle");
+      NVHLS_ASSERT_MSG(sleeping.pops[i].first == polling.pops[i].first, "Skipped cycles were miscounted");
+    }
+    DCOUT(sleeping.idle.SkippedCycles() << " of " << cycles << " cycles skipped" << endl);
+#ifdef CONNECTIONS_ACCURATE_SIM
+    NVHLS_ASSERT_MSG(sleeping.idle.SkippedCycles() > cycles / 2, "Idle cycles were not skipped");
+#endif
+    DCOUT("CMODEL PASS" << endl);
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  testbench tb("tb");
+  sc_start();
+  return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <hls_globals.h>
+#include <mem_array.h>
+#include <cstdlib>
+#include <set>
+
+static const int kEntries = 32;
+static const int kReads = 4;
+static const int kWrites = 3;
+
+typedef NVUINTW(16) Data_t;
+typedef mem_array_lvt<Data_t, kEntries, kReads, kWrites> Table;
+
+void TestAccess() {
+  Table table;
+  Data_t ref[kEntries];
+  for (int i = 0; i < kEntries; i++) {
+    ref[i] = i;
+    table.write(i % kWrites, i, ref[i]);
+  }
+
+  for (int iter = 0; iter < 2000; iter++) {
+    Table::Index raddr[kReads], waddr[kWrites];
+    Data_t rdata[kReads], wdata[kWrites];
+    bool wen[kWrites];
+    std::set<unsigned> rbanks;
+    for (int r = 0; r < kReads; r++) {
+      // Few distinct addresses so that ports collide often
+      raddr[r] = rand() % (iter % 2 ? 4 : kEntries);
+    }
+    for (int w = 0; w < kWrites; w++) {
+      waddr[w] = rand() % (iter % 2 ? 4 : kEntries);
+      wdata[w] = rand() % 65536;
+      wen[w] = rand() % 4 != 0;
+    }
+    table.access(raddr, rdata, waddr, wdata, wen);
+
+    // Reads see the values before the writes of the same cycle
+    for (int r = 0; r < kReads; r++) {
+      NVHLS_ASSERT_MSG(rdata[r] == ref[raddr[r]], "read mismatch");
+      rbanks.insert(Table::bank(table.lvt[raddr[r]].to_uint(), r));
+    }
+    // The highest write port to an entry wins
+    for (int w = 0; w < kWrites; w++) {
+      if (wen[w]) {
+        ref[waddr[w]] = wdata[w];
+      }
+    }
+    NVHLS_ASSERT_MSG(rbanks.size() == kReads, "two reads share a bank");
+  }
+
+  for (int i = 0; i < kEntries; i++) {
+    for (int r = 0; r < kReads; r++) {
+      NVHLS_ASSERT_MSG(table.read(r, i) == ref[i], "final read mismatch");
+    }
+  }
+}
+
+int sc_main(int argc, char *argv[]) {
+  srand(1);
+  TestAccess();
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
@@ -16,6 +16,7 @@
 #include <nvhls_int.h>
 #include <nvhls_types.h>
 #include <mem_array.h>
+#include <mem_array_macro.h>
 #include <hls_globals.h>
 #include "MemArrayOpt.h"
 #include "mem_config.h"
@@ -26,7 +27,12 @@
 // addr is the memory address
 void MemArrayOpt(MemWord_t write_data, MemWord_t & read_data, NVUINT1 mem_op, MemAddr_t addr) {
   static const int kDebugLevel = 1;
+#ifdef MACRO_MAX_DEPTH
+  static mem_array_macro <MemWord_t, NUM_ENTRIES, NBANKS,
+                          sram_macro_lib<MACRO_MAX_DEPTH, MACRO_MAX_WIDTH> > banks;
+#else
   static mem_array_opt <MemWord_t, NUM_ENTRIES, NBANKS> banks;
+#endif
   BankSel_t bank_sel;
   BankAddr_t bank_addr;
   if (NBANKS>1) {
@@ -29,6 +29,14 @@
 #define NUM_ENTRIES 1024
 #endif
 
+// Build the memory from SRAM macros of at most MACRO_MAX_DEPTH entries of
+// MACRO_MAX_WIDTH bits (mem_array_macro) instead of one mem_array_opt
+#ifdef MACRO_MAX_DEPTH
+#ifndef MACRO_MAX_WIDTH
+#define MACRO_MAX_WIDTH WORDSIZE
+#endif
+#endif
+
 enum MemOp_t {
 READ,
 WRITE
@@ -17,6 +17,7 @@
 #include <match_scverify.h>
 #include <testbench/nvhls_rand.h>
 
+#include <mem_array_macro.h>
 #include "MemArrayOpt.h"
 #include "mem_config.h"
 
@@ -25,6 +26,9 @@
 #endif
 
 MemWord_t wideRand ();
+void TestBurst ();
+void TestImage ();
+void TestMacro ();
 
 CCS_MAIN(int argc, char *argv[]) {
 
@@ -69,6 +73,10 @@ CCS_MAIN(int argc, char *argv[]) {
     CDCOUT("Memory Op: Read, Address: "<< addr.to_uint64() << " Data: "<< read_data.to_uint64() << " " << ref[addr] << endl, kDebugLevel);
     assert(ref[addr]==read_data);
   }
+
+  TestBurst();
+  TestImage();
+  TestMacro();
   CCS_RETURN(0) ;
 
 }
@@ -86,3 +94,97 @@ MemWord_t wideRand () {
   }
   return retval;
 }
+
+// Strided burst writes followed by burst reads of a random length
+void TestBurst () {
+  static const int kMaxBurst = 16;
+  static const int kStride = 3;
+  static mem_array_opt <MemWord_t, NUM_ENTRIES_PER_BANK, NBANKS> banks;
+  MemWord_t write_data[kMaxBurst];
+  MemWord_t read_data[kMaxBurst];
+
+  for (int i = 0; i < NUM_ITER; i++) {
+    unsigned len = 1 + rand() % kMaxBurst;
+    BankSel_t bank_sel = (NBANKS > 1) ? rand() % NBANKS : 0;
+    BankAddr_t start = rand() % (NUM_ENTRIES_PER_BANK - (len - 1) * kStride);
+    for (unsigned j = 0; j < len; j++) {
+      write_data[j] = wideRand();
+    }
+    banks.write_burst(start, bank_sel, len, write_data, kStride);
+    banks.read_burst(start, bank_sel, len, read_data, kStride);
+    for (unsigned j = 0; j < len; j++) {
+      assert(read_data[j] == write_data[j]);
+      assert(banks.read(start + j * kStride, bank_sel) == write_data[j]);
+    }
+  }
+}
+
+void TestImage () {
+  typedef mem_array_opt <MemWord_t, NUM_ENTRIES_PER_BANK, NBANKS> Mem;
+  static Mem banks;
+  static Mem loaded;
+  for (int striped = 0; striped < 2; striped++) {
+    for (unsigned i = 0; i < NBANKS; i++) {
+      for (unsigned j = 0; j < NUM_ENTRIES_PER_BANK; j++) {
+        banks.write(j, i, wideRand());
+      }
+    }
+    assert(banks.dump_image("mem_image.bin", striped));
+    loaded.clear();
+    assert(loaded.load_image("mem_image.bin", striped));
+    for (unsigned i = 0; i < NBANKS; i++) {
+      for (unsigned j = 0; j < NUM_ENTRIES_PER_BANK; j++) {
+        assert(loaded.read(j, i) == banks.read(j, i));
+      }
+    }
+  }
+  remove("mem_image.bin");
+}
+
+// Memories split into macros of at most 64 x 24 bits, in multiples of 8
+// entries, against a reference copy
+void TestMacro () {
+  typedef sram_macro_lib<64, 24, 8, 4> Lib;
+  typedef NVUINTC(64) Word_t;
+  static const int kEntries = 100;
+  static const int kBanks = 2;
+  typedef mem_array_macro<Word_t, kEntries, kBanks, Lib> Mem;
+  typedef mem_array_macro<Word_t, kEntries, kBanks, Lib, 8> MemBE;
+  // 2 x 56 entries deep, 3 x 22 bits wide, or 3 macros of 3 byte slices
+  static_assert(Mem::DepthSplits == 2 && Mem::MacroDepth == 56, "wrong depth split");
+  static_assert(Mem::WidthSplits == 3 && Mem::MacroWidth == 22, "wrong width split");
+  static_assert(MemBE::WidthSplits == 3 && MemBE::MacroWidth == 24, "wrong slice split");
+  static_assert(mem_array_macro<Word_t, 1024, 1, Lib>::MuxLevels == 2 &&
+                mem_array_macro<Word_t, 1024, 1, Lib>::ReadLatency == 2, "wrong read mux");
+
+  static Mem mem;
+  static MemBE mem_be;
+  Word_t ref[kBanks][kEntries];
+  Word_t ref_be[kBanks][kEntries];
+  for (unsigned i = 0; i < kBanks; i++) {
+    for (unsigned j = 0; j < kEntries; j++) {
+      ref[i][j] = wideRand();
+      ref_be[i][j] = wideRand();
+      mem.write(j, i, ref[i][j]);
+      mem_be.write(j, i, ref_be[i][j]);
+    }
+  }
+  for (int i = 0; i < NUM_ITER; i++) {
+    unsigned bank = rand() % kBanks;
+    unsigned idx = rand() % kEntries;
+    Word_t data = wideRand();
+    MemBE::WriteMask mask = rand();
+    mem.write(idx, bank, data);
+    ref[bank][idx] = data;
+    mem_be.write(idx, bank, data, mask);
+    for (unsigned b = 0; b < 8; b++) {
+      if (mask[b] == 1) {
+        ref_be[bank][idx] = nvhls::set_slc(ref_be[bank][idx], nvhls::get_slc<8>(data, b * 8), b * 8);
+      }
+    }
+    bank = rand() % kBanks;
+    idx = rand() % kEntries;
+    assert(mem.read(idx, bank) == ref[bank][idx]);
+    assert(mem_be.read(idx, bank) == ref_be[bank][idx]);
+  }
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <hls_globals.h>
+#include <Scratchpad.h>
+#include <nvhls_mem_req.h>
+#include <axi/AxiMemReq.h>
+#include <cstdlib>
+
+typedef NVUINTW(32) Word_t;
+static const int kLanes = 2;  // words of a 64-bit AXI beat
+static const int kWords = 256;
+typedef ScratchpadClass<Word_t, kLanes, kWords> Mem;
+
+// 64-bit AXI with narrow beats and write strobes
+struct narrow_cfg {
+  enum {
+    dataWidth = 64,
+    useVariableBeatSize = 1,
+    useMisalignedAddresses = 0,
+    useLast = 1,
+    useWriteStrobes = 1,
+    useBurst = 1, useFixedBurst = 0, useWrapBurst = 0, maxBurstSize = 256,
+    useQoS = 0, useLock = 0, useProt = 0, useCache = 0, useRegion = 0,
+    aUserWidth = 0, wUserWidth = 0, bUserWidth = 0, rUserWidth = 0,
+    addrWidth = 32,
+    idWidth = 4,
+    useWriteResponses = 1,
+  };
+};
+// Requests carry wider addresses than the scratchpad, resized on conversion
+typedef axi::MemReqAdapter<narrow_cfg, Word_t, 12> Adapter;
+typedef Adapter::axi4_ axi4_;
+
+// Words of the beat beat of a burst starting at word start, as a lane mask
+unsigned BeatLanes(unsigned start, bool narrow, unsigned beat, unsigned& row) {
+  if (narrow) {
+    unsigned word = start + beat;
+    row = word / kLanes;
+    return 1u << (word % kLanes);
+  }
+  row = start / kLanes + beat;
+  return (1u << kLanes) - 1;
+}
+
+void TestAxi() {
+  Mem mem;
+  Word_t ref[kWords];
+  for (int i = 0; i < kWords; i += kLanes) {
+    Adapter::mem_req_t req;
+    Adapter::mem_rsp_t rsp;
+    req.is_store = 1;
+    for (int j = 0; j < kLanes; j++) {
+      req.set(j, i + j, ref[i + j] = i + j);
+    }
+    mem.load_store(req, rsp);
+  }
+
+  for (int iter = 0; iter < 500; iter++) {
+    bool narrow = rand() % 2;
+    unsigned len = rand() % 4;
+    unsigned start = (rand() % (kWords - 2 * kLanes * 4));
+    if (!narrow) start &= ~(kLanes - 1);
+
+    typename axi4_::AddrPayload ax;
+    ax.id = rand() % 16;
+    ax.addr = start * 4;
+    ax.len = len;
+    ax.size = narrow ? 2 : 3;
+
+    if (rand() % 2) {
+      for (unsigned beat = 0; beat <= len; beat++) {
+        typename axi4_::WritePayload w;
+        Word_t words[kLanes];
+        unsigned strb = 0;
+        for (int i = 0; i < kLanes; i++) {
+          words[i] = rand();
+          w.data = nvhls::set_slc(w.data, words[i], i * 32);
+          if (rand() % 4) strb |= 0xf << (4 * i);
+        }
+        w.wstrb = strb;
+        w.last = (beat == len);
+        Adapter::mem_rsp_t rsp;
+        mem.load_store(Adapter::write_req(ax, w, beat), rsp);
+        unsigned row;
+        unsigned lanes = BeatLanes(start, narrow, beat, row);
+        for (int i = 0; i < kLanes; i++) {
+          if ((lanes >> i) & (strb >> (4 * i)) & 1) ref[row * kLanes + i] = words[i];
+        }
+      }
+      typename axi4_::WRespPayload b = Adapter::write_rsp(ax);
+      NVHLS_ASSERT_MSG(b.id == ax.id, "write response id mismatch");
+    } else {
+      for (unsigned beat = 0; beat <= len; beat++) {
+        Adapter::mem_rsp_t rsp;
+        mem.load_store(Adapter::read_req(ax, beat), rsp);
+        typename axi4_::ReadPayload r = Adapter::read_rsp(ax, rsp, beat == len);
+        NVHLS_ASSERT_MSG(r.id == ax.id && r.last == (beat == len), "read response mismatch");
+        unsigned row;
+        unsigned lanes = BeatLanes(start, narrow, beat, row);
+        for (int i = 0; i < kLanes; i++) {
+          Word_t word = nvhls::get_slc<32>(r.data, i * 32);
+          NVHLS_ASSERT_MSG(rsp.valids[i] == ((lanes >> i) & 1), "read lanes mismatch");
+          NVHLS_ASSERT_MSG(((lanes >> i) & 1) == 0 || word == ref[row * kLanes + i],
+                           "read data mismatch");
+        }
+      }
+    }
+  }
+}
+
+void TestConversions() {
+  for (int iter = 0; iter < 100; iter++) {
+    nvhls::mem_req_t<Word_t, 10, kLanes> req;
+    req.is_store = rand() % 2;
+    for (int i = 0; i < kLanes; i++) {
+      if (rand() % 2) req.set(i, rand() % 1024, rand());
+    }
+
+    // A cli_req_t round trip keeps every field
+    Mem::req_t cli_req;
+    nvhls::mem_req_t<Word_t, 10, kLanes> back;
+    to_cli_req(req, cli_req);
+    to_mem_req(cli_req, back);
+    NVHLS_ASSERT_MSG(back.is_store == req.is_store && back.valids == req.valids,
+                     "cli_req_t round trip mismatch");
+
+    // ArbitratedScratchpadDP style port arrays
+    NVUINTW(10) addr[kLanes];
+    bool valid[kLanes];
+    Word_t data[kLanes];
+    nvhls::to_ports(req, addr, valid, data);
+    nvhls::mem_rsp_t<Word_t, kLanes> rsp = nvhls::from_ports(data, valid);
+    for (int i = 0; i < kLanes; i++) {
+      NVHLS_ASSERT_MSG(back.addr[i] == req.addr[i] && back.data[i] == req.data[i],
+                       "cli_req_t round trip mismatch");
+      NVHLS_ASSERT_MSG(addr[i] == req.addr[i] && valid[i] == (req.valids[i] == 1),
+                       "to_ports mismatch");
+      NVHLS_ASSERT_MSG(rsp.valids[i] == req.valids[i] && rsp.data[i] == req.data[i],
+                       "from_ports mismatch");
+    }
+  }
+}
+
+int sc_main(int argc, char *argv[]) {
+  srand(1);
+  TestConversions();
+  TestAxi();
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINMAX_TOP_H
+#define MINMAX_TOP_H
+
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <hls_globals.h>
+#include <comptrees.h>
+
+#ifndef NUM_ELEMS
+#define NUM_ELEMS 100
+#endif
+
+#ifndef RADIX
+#define RADIX 4
+#endif
+
+#ifndef LEVELS_PER_STAGE
+#define LEVELS_PER_STAGE 1
+#endif
+
+typedef NVUINTC(8) Elem;
+typedef NVUINTC(nvhls::index_width<NUM_ELEMS>::val) Idx;
+
+typedef MinmaxTreePipelined<Elem, Idx, true, NUM_ELEMS, RADIX, LEVELS_PER_STAGE> MaxTree;
+
+void MinmaxTop(const Elem in[NUM_ELEMS], bool in_valid, Elem& out,
+               Idx& out_idx, bool& out_valid);
+
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <deque>
+#include <match_scverify.h>
+#include <testbench/nvhls_rand.h>
+
+#include "MinmaxTop.h"
+
+#ifndef NUM_ITERS
+#define NUM_ITERS 1000
+#endif
+
+struct Result {
+  Elem value;
+  Idx idx;
+  bool valid;
+};
+
+// Ties go to the lowest index
+Result reference_max(const Elem in[NUM_ELEMS], bool valid) {
+  Result res;
+  res.value = in[0];
+  res.idx = 0;
+  res.valid = valid;
+  for (unsigned i = 1; i < NUM_ELEMS; i++) {
+    if (in[i] > res.value) {
+      res.value = in[i];
+      res.idx = i;
+    }
+  }
+  return res;
+}
+
+CCS_MAIN(int argc, char *argv[])
+{
+  nvhls::set_random_seed();
+
+  std::deque<Result> expected;
+  for (unsigned i = 0; i < MaxTree::Latency; i++) {
+    Result none;
+    none.valid = false;
+    expected.push_back(none);
+  }
+
+  for (int iter = 0; iter < NUM_ITERS; ++iter)
+  {
+    Elem in[NUM_ELEMS];
+    // Narrow ranges every other iteration to exercise ties
+    unsigned range = (rand() & 0x1) ? 256 : 4;
+    for (unsigned i = 0; i < NUM_ELEMS; i++) {
+      in[i] = rand() % range;
+    }
+    bool in_valid = rand() & 0x1;
+
+    Result ref = reference_max(in, in_valid);
+    expected.push_back(ref);
+
+    // Combinational trees, binary and configured radix
+    Elem value;
+    Idx idx = MinmaxTree<Elem, Idx, true, NUM_ELEMS, RADIX>::minmax(in, value);
+    assert(idx == ref.idx && value == ref.value);
+    idx = MinmaxTree<Elem, Idx, true, NUM_ELEMS>::minmax(in, value);
+    assert(idx == ref.idx && value == ref.value);
+
+    Elem out;
+    Idx out_idx;
+    bool out_valid;
+    CCS_DESIGN(MinmaxTop)(in, in_valid, out, out_idx, out_valid);
+
+    Result exp = expected.front();
+    expected.pop_front();
+    assert(out_valid == exp.valid);
+    if (exp.valid) {
+      assert(out == exp.value && out_idx == exp.idx);
+    }
+  }
+
+  DCOUT("Latency " << MaxTree::Latency << " over " << MaxTree::NumLevels
+        << " levels" << endl);
+  DCOUT("CMODEL PASS" << endl);
+  CCS_RETURN(0) ;
+}
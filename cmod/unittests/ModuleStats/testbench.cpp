@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_module.h>
+#include <nvhls_assert.h>
+#include <nvhls_stats_json.h>
+#include <nvhls_stat_sampler.h>
+#include <mem_array.h>
+#include <Arbiter.h>
+#include <rapidjson/document.h>
+#include <sstream>
+#include <string>
+
+// Module that exposes its stats for testing
+class StatsModule : public match::Module {
+ public:
+  match::PortStats in_stats;
+  match::PortStats out_stats;
+  match::ThreadStats run_stats;
+  unsigned int no_req;
+  match::StatHandle hits;
+  match::StatHandle requests;
+  match::StatHandle bank_hits;
+  mem_array_sep<NVUINT8, 8, 2> banks;
+  Arbiter<4> arb;
+  match::ActivityStats in_activity;
+  match::HistogramStats latency;
+  match::HistogramStats depth;
+
+  StatsModule(sc_module_name nm)
+      : match::Module(nm), in_stats(2), out_stats(1),
+        depth(4, match::HistogramStats::kLinear, 2) {
+    hits = RegisterStat("hits");
+    requests = RegisterStat("requests");
+    bank_hits = RegisterStatIndexed("bank_hits", 4);
+    RegisterPortStats("in", in_stats);
+    RegisterPortStats("out", out_stats);
+    in_stats.PairWith(out_stats);
+    RegisterThreadStats("run", run_stats);
+    no_req = run_stats.AddCause("no_req");
+    RegisterActivityStats("banks", banks.Stats());
+    RegisterActivityStats("arb", arb.Stats());
+    RegisterActivityStats("in_bits", in_activity);
+    RegisterHistogramStats("latency", latency);
+    RegisterHistogramStats("depth", depth);
+  }
+
+  void Count(const std::string& name, unsigned int num) { IncrStat(name, num); }
+  void Hit(unsigned int bank) {
+    IncrStat(hits);
+    IncrStat(requests);
+    IncrStatIndexed(bank_hits, bank);
+  }
+  void Flush() { RecordEvent("flush"); }
+};
+
+// Counts one beat per cycle for 25 cycles, then three, sampled every 10
+class Ticker : public match::Module {
+ public:
+  match::HistogramStats lat;
+  match::StatSampler sampler;
+  unsigned int edges;
+
+  SC_HAS_PROCESS(Ticker);
+  Ticker(sc_module_name nm) : match::Module(nm), sampler("sampler", *this, 10, 4), edges(0) {
+    sampler.clk(clk);
+    RegisterHistogramStats("lat", lat);
+    sampler.Add("beats");
+    sampler.Add("lat_count");
+    sampler.Add("missing");
+    SC_THREAD(Run);
+    sensitive << clk.pos();
+  }
+
+  void Run() {
+    while (1) {
+      wait();
+      IncrStat("beats", edges < 25 ? 1 : 3);
+      lat.Sample(edges % 4);
+      edges++;
+    }
+  }
+};
+
+bool Contains(const std::string& text, const std::string& line) {
+  return text.find(line + "\n") != std::string::npos;
+}
+
+int sc_main(int argc, char *argv[]) {
+  StatsModule dut("dut");
+  match::Timeline::Instance().Enable();
+
+  dut.Count("requests", 3);
+  dut.Count("requests", 2);
+  dut.Hit(1);
+  dut.Hit(3);
+  dut.Flush();
+  dut.Hit(3);
+  dut.Flush();
+
+  // Two messages arrive on consecutive cycles and fill the input buffer. The
+  // first leaves through the output port in the third cycle, after one
+  // stalled cycle, three output cycles after it arrived.
+  dut.in_stats.Sample(1, true, false);
+  dut.in_stats.Arrive();
+  dut.out_stats.Sample(0, false, false);
+  dut.in_stats.Sample(2, true, false);
+  dut.in_stats.Arrive();
+  dut.out_stats.Sample(1, false, true);
+  dut.in_stats.Sample(2, false, true);
+  dut.out_stats.Sample(1, true, false);
+  dut.out_stats.Depart();
+
+  // Three productive iterations out of five: II 5/3 against a target of 1
+  dut.run_stats.Productive();
+  dut.run_stats.Blocked(dut.no_req);
+  dut.run_stats.Productive();
+  dut.run_stats.Blocked("out_full");
+  dut.run_stats.Productive();
+
+  // 0x00 -> 0x0f -> 0xf0 -> 0xf0: 4 + 8 + 0 toggles over 24 bits
+  dut.in_activity.Sample(NVUINT8(0x0f));
+  dut.in_activity.Sample(NVUINT8(0xf0));
+  dut.in_activity.Sample(NVUINT8(0xf0));
+  dut.banks.write(0, 1, 5);
+  dut.banks.write(1, 1, 6);
+  dut.banks.write(2, 0, 7);
+  dut.banks.write(3, 0, 8, 1, false);  // disabled writes do not count
+  dut.banks.read(0, 1);
+  dut.banks.read(2, 0);
+  // Roundrobin over elements 1 and 2, then element 3 alone
+  dut.arb.pick(6);
+  dut.arb.pick(6);
+  dut.arb.pick(6);
+  dut.arb.pick(8);
+  dut.arb.pick(0);
+
+  // log2 buckets {0}, {1}, [2, 4), [4, 8), ... [64, 128)
+  dut.latency.Sample(0);
+  dut.latency.Sample(1);
+  dut.latency.Sample(2);
+  dut.latency.Sample(3);
+  dut.latency.Sample(6);
+  dut.latency.Sample(100);
+  // Linear buckets [0, 2), [2, 4), [4, 6) and [6, inf)
+  dut.depth.Sample(1, 2);
+  dut.depth.Sample(4);
+  dut.depth.Sample(9);
+
+  std::stringstream ss;
+  dut.DumpStats(ss, 0, NULL);
+  std::string text = ss.str();
+  DCOUT(text);
+
+  NVHLS_ASSERT_MSG(Contains(text, "  requests: 8"), "IncrStat total wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  hits: 3"), "handle stat wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  bank_hits_1: 1"), "indexed handle stat wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  bank_hits_3: 2"), "indexed handle stat wrong");
+  NVHLS_ASSERT_MSG(text.find("bank_hits_0") == std::string::npos,
+                   "unused handle stat printed");
+  NVHLS_ASSERT_MSG(Contains(text, "  in_cycles: 3"), "in_cycles wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  in_transfers: 2"), "in_transfers wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  in_stall_cycles: 1"), "in_stall_cycles wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  in_occupancy_2: 2"), "in_occupancy wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  out_stall_cycles: 1"), "out_stall_cycles wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  out_latency_sum: 3"), "out_latency_sum wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  out_latency_count: 1"), "out_latency_count wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  run_cycles: 5"), "run_cycles wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  run_productive: 3"), "run_productive wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  run_blocked_no_req: 1"), "run_blocked_no_req wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  run_blocked_out_full: 1"), "run_blocked_out_full wrong");
+  NVHLS_ASSERT_MSG(text.find("run_blocked_wait") == std::string::npos,
+                   "unused stall cause printed");
+  NVHLS_ASSERT_MSG(Contains(text, "  in_bits_messages: 3"), "in_bits_messages wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  in_bits_bits: 24"), "in_bits_bits wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  in_bits_toggles: 12"), "in_bits_toggles wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  banks_reads_0: 1"), "banks_reads wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  banks_reads_1: 1"), "banks_reads wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  banks_writes_1: 2"), "banks_writes wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  banks_writes_0: 1"), "banks_writes wrong");
+  NVHLS_ASSERT_MSG(text.find("banks_toggles") == std::string::npos,
+                   "unused activity counter printed");
+  NVHLS_ASSERT_MSG(Contains(text, "  arb_grants_1: 1"), "arb_grants wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  arb_grants_2: 2"), "arb_grants wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  arb_grants_3: 1"), "arb_grants wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  latency_count: 6"), "latency_count wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  latency_sum: 112"), "latency_sum wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  latency_min: 0"), "latency_min wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  latency_p50: 3"), "latency_p50 wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  latency_p90: 7"), "latency_p90 wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  latency_p99: 100"), "latency_p99 wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  latency_max: 100"), "latency_max wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  depth_count: 4"), "depth_count wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  depth_p50: 1"), "depth_p50 wrong");
+  NVHLS_ASSERT_MSG(Contains(text, "  depth_p90: 9"), "overflow bucket percentile wrong");
+
+  std::stringstream report;
+  dut.PrintThreadReport(report);
+  DCOUT(report.str());
+  NVHLS_ASSERT_MSG(report.str().find("dut.run: target II 1, achieved II 1.667 (60.0% of target)") == 0,
+                   "thread report wrong");
+  NVHLS_ASSERT_MSG(Contains(report.str(), "    no_req: 1 cycles (20.0%)"), "stall cause missing");
+
+  rapidjson::Document doc;
+  doc.Parse(match::StatsJSON::ToString(dut).c_str());
+  NVHLS_ASSERT_MSG(!doc.HasParseError(), "invalid stats JSON");
+  const rapidjson::Value& top = doc["top"];
+  NVHLS_ASSERT_MSG(std::string(top["name"].GetString()) == "dut", "JSON name wrong");
+  NVHLS_ASSERT_MSG(top["stats"]["requests"].GetUint64() == 8, "JSON stat wrong");
+  NVHLS_ASSERT_MSG(top["stats"]["flush"].GetUint64() == 1, "JSON event stat wrong");
+  NVHLS_ASSERT_MSG(top["events"]["flush"].GetUint64() == 1, "JSON event wrong");
+  NVHLS_ASSERT_MSG(top["ports"]["in"]["transfers"].GetUint64() == 2, "JSON port wrong");
+  NVHLS_ASSERT_MSG(top["ports"]["in"]["occupancy"][2].GetUint64() == 2,
+                   "JSON occupancy wrong");
+  NVHLS_ASSERT_MSG(top["ports"]["out"]["latency_sum"].GetUint64() == 3,
+                   "JSON latency wrong");
+  NVHLS_ASSERT_MSG(top["threads"]["run"]["productive"].GetUint64() == 3, "JSON thread wrong");
+  NVHLS_ASSERT_MSG(top["threads"]["run"]["blocked"]["out_full"].GetUint64() == 1,
+                   "JSON stall cause wrong");
+  NVHLS_ASSERT_MSG(top["activity"]["in_bits"]["toggles"].GetUint64() == 12,
+                   "JSON toggles wrong");
+  NVHLS_ASSERT_MSG(top["activity"]["banks"]["writes"].Size() == 2 &&
+                   top["activity"]["banks"]["writes"][1].GetUint64() == 2,
+                   "JSON bank writes wrong");
+  NVHLS_ASSERT_MSG(top["activity"]["arb"]["grants"][2].GetUint64() == 2,
+                   "JSON grants wrong");
+  const rapidjson::Value& depth = top["histograms"]["depth"];
+  NVHLS_ASSERT_MSG(std::string(depth["scale"].GetString()) == "linear", "JSON scale wrong");
+  NVHLS_ASSERT_MSG(depth["buckets"].Size() == 4 && depth["buckets"][0].GetUint64() == 2 &&
+                   depth["buckets"][3].GetUint64() == 1,
+                   "JSON buckets wrong");
+  NVHLS_ASSERT_MSG(top["histograms"]["latency"]["sum"].GetUint64() == 112,
+                   "JSON histogram sum wrong");
+  NVHLS_ASSERT_MSG(top["children"].Size() == 0, "JSON children wrong");
+
+  // flush, three transfers, and one stall span on each port
+  match::Timeline& timeline = match::Timeline::Instance();
+  NVHLS_ASSERT_MSG(timeline.NumEvents() == 7, "wrong number of timeline events");
+  rapidjson::Document trace;
+  trace.Parse(timeline.ToString().c_str());
+  NVHLS_ASSERT_MSG(!trace.HasParseError(), "invalid timeline JSON");
+  NVHLS_ASSERT_MSG(trace["traceEvents"].Size() == 7 + 3, "wrong timeline tracks");
+
+  // Samples end at cycles 10 ... 60; the ring keeps the last four
+  sc_clock clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true);
+  sc_signal<bool> rst("rst");
+  Ticker ticker("ticker");
+  dut.clk(clk);
+  dut.rst(rst);
+  ticker.clk(clk);
+  ticker.rst(rst);
+  sc_start(64, SC_NS);
+  match::StatSampler& sampler = ticker.sampler;
+  std::stringstream csv;
+  sampler.WriteCSV(csv);
+  DCOUT(csv.str());
+  NVHLS_ASSERT_MSG(sampler.NumSamples() == 4, "wrong number of samples");
+  NVHLS_ASSERT_MSG(sampler.NumDropped() == 2, "wrong number of dropped samples");
+  NVHLS_ASSERT_MSG(sampler.Cycle(0) == 30 && sampler.Cycle(3) == 60, "wrong sample cycles");
+  for (unsigned int i = 1; i < 4; i++) {
+    NVHLS_ASSERT_MSG(sampler.Value(i, 0) == 30, "wrong stat increment");
+  }
+  for (unsigned int i = 0; i < 4; i++) {
+    NVHLS_ASSERT_MSG(sampler.Value(i, 1) == 10, "wrong histogram count increment");
+    NVHLS_ASSERT_MSG(sampler.Value(i, 2) == 0, "missing stat sampled");
+  }
+  NVHLS_ASSERT_MSG(csv.str().find("cycle,beats,lat_count,missing\n30,") == 0,
+                   "wrong CSV header");
+
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
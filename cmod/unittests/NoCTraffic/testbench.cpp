@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <systemc.h>
+#include <testbench/nvhls_rand.h>
+#include <testbench/NoCTraffic.h>
+#include <nvhls_connections.h>
+#include <WHVCNoC.h>
+
+#include <fstream>
+#include <string>
+
+#ifndef TRAFFIC_PATTERN
+#define TRAFFIC_PATTERN UniformRandom
+#endif
+
+#ifndef BURST_LENGTH
+#define BURST_LENGTH 1
+#endif
+
+using namespace ::std;
+
+#ifdef NOC_TORUS
+typedef TorusNoC<4, 4, 4, 4, 64, 128, 8> NoC_t;
+#else
+typedef MeshNoC<4, 4, 2, 4, 64, 128, 8> NoC_t;
+#endif
+
+// The patterns on a 4x4 grid, with endpoint n at (n % 4, n / 4)
+void test_patterns() {
+  NoCTrafficConfig config;
+  config.pattern = Transpose;
+  NVHLS_ASSERT_MSG(config.destination(1 * 4 + 2, 4, 4) == 2 * 4 + 1,
+                   "Transpose of (2, 1) should be (1, 2)");
+  NVHLS_ASSERT_MSG(config.destination(5, 4, 4) == 5,
+                   "Transpose of a diagonal node should be itself");
+  config.pattern = BitComplement;
+  NVHLS_ASSERT_MSG(config.destination(3, 4, 4) == 12,
+                   "Bit complement of 0011 should be 1100");
+  config.pattern = Tornado;
+  NVHLS_ASSERT_MSG(config.destination(0, 4, 4) == 1 * 4 + 1,
+                   "Tornado of (0, 0) should be (1, 1)");
+  NVHLS_ASSERT_MSG(config.destination(3 * 4 + 3, 4, 4) == 0 * 4 + 0,
+                   "Tornado of (3, 3) should wrap to (0, 0)");
+  config.pattern = Hotspot;
+  config.hotspot = 6;
+  config.hotspot_fraction = 1.0;
+  NVHLS_ASSERT_MSG(config.destination(0, 4, 4) == 6,
+                   "Hotspot traffic should go to the hotspot");
+  config.pattern = UniformRandom;
+  for (int i = 0; i < 100; i++) {
+    int dst = config.destination(i % 16, 4, 4);
+    NVHLS_ASSERT_MSG(dst >= 0 && dst < 16, "Destination out of range");
+  }
+}
+
+void check_results(const NoCBenchmark<NoC_t>& bench) {
+  const vector<NoCBenchResult>& results = bench.results;
+  NVHLS_ASSERT_MSG(results.size() >= 2, "Sweep ended too early");
+  for (unsigned i = 0; i < results.size(); i++) {
+    const NoCBenchResult& r = results[i];
+    NVHLS_ASSERT_MSG(r.latency_p50 <= r.latency_p90 &&
+                     r.latency_p90 <= r.latency_p99 &&
+                     r.latency_p99 <= r.latency_max,
+                     "Latency percentiles out of order");
+    NVHLS_ASSERT_MSG(r.latency_mean >= r.network_latency_mean,
+                     "Latency should include the source queue");
+  }
+  // Low load: everything offered is accepted, at close to zero-load latency
+  const NoCBenchResult& low = results[0];
+  NVHLS_ASSERT_MSG(!low.saturated, "Lowest rate should not saturate");
+  NVHLS_ASSERT_MSG(low.packets > 0, "No packets measured");
+  NVHLS_ASSERT_MSG(low.offered > 0.6 * low.injection_rate &&
+                   low.offered < 1.4 * low.injection_rate,
+                   "Offered load should follow the injection rate");
+  NVHLS_ASSERT_MSG(low.accepted > 0.85 * low.offered &&
+                   low.accepted < 1.15 * low.offered,
+                   "Accepted throughput should match the offered load");
+  // a packet takes at least 3 flits
+  NVHLS_ASSERT_MSG(low.latency_p50 >= 3, "Latency too low");
+  // High load: ejection takes at most one flit per cycle
+  const NoCBenchResult& high = results.back();
+  NVHLS_ASSERT_MSG(high.saturated || high.accepted < 0.9 * high.injection_rate,
+                   "Highest rate should saturate the NoC");
+}
+
+void check_csv(const string& filename, unsigned rows) {
+  ifstream ifile(filename.c_str());
+  string line;
+  unsigned lines = 0;
+  while (getline(ifile, line)) {
+    lines++;
+  }
+  NVHLS_ASSERT_MSG(lines == rows + 1, "CSV should hold a header and one row per rate");
+}
+
+int sc_main(int argc, char* argv[]) {
+  nvhls::set_random_seed();
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  test_patterns();
+
+  NoCBenchmark<NoC_t> bench("bench");
+  bench.config.pattern = TRAFFIC_PATTERN;
+  bench.config.burst_length = BURST_LENGTH;
+  bench.config.hotspot = 5;
+  bench.config.warmup_cycles = 500;
+  bench.config.measure_cycles = 2000;
+  bench.config.drain_cycles = 2000;
+  bench.rates.push_back(0.01);
+  bench.rates.push_back(0.03);
+  bench.rates.push_back(0.6);
+  sc_start();
+
+  bench.Print(cout);
+  NVHLS_ASSERT_MSG(bench.WriteCSV("noc_traffic.csv"), "Cannot write CSV");
+  NVHLS_ASSERT_MSG(bench.WriteJSON("noc_traffic.json"), "Cannot write JSON");
+  check_results(bench);
+  check_csv("noc_traffic.csv", bench.results.size());
+
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    cout << "Simulation FAILED\n";
+  else
+    cout << "Simulation PASSED\n";
+  return rc;
+};
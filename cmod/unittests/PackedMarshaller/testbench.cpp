@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_packet.h>
+#include <axi/axi4.h>
+#include <TypeToBits.h>
+#include <testbench/nvhls_rand.h>
+
+#ifndef NUM_ITERS
+#define NUM_ITERS 1000
+#endif
+
+// Message that nests a packed and an unpacked field
+class Nested : public nvhls_message {
+ public:
+  class Unpacked : public nvhls_message {
+   public:
+    NVUINT7 a;
+    bool b;
+    static const unsigned int width = 8;
+    template <unsigned int Size>
+    void Marshall(Marshaller<Size>& m) {
+      m& a;
+      m& b;
+    }
+  };
+  typedef Packet<70, 3, 2, 5> Inner;
+
+  Inner inner;
+  Unpacked unpacked;
+  NVUINT3 tail;
+  static const unsigned int width = Inner::width + Unpacked::width + 3;
+
+  NVHLS_PACKED_MESSAGE;
+  template <typename M>
+  void MarshallFields(M& m) {
+    m& inner;
+    m& unpacked;
+    m& tail;
+  }
+
+  template <unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    MarshallFields(m);
+  }
+};
+
+// Reference bits produced by the sc_lv Marshaller
+template <typename T>
+sc_lv<Wrapped<T>::width> ReferenceBits(T in) {
+  Marshaller<Wrapped<T>::width> marshaller;
+  Wrapped<T> wm(in);
+  wm.Marshall(marshaller);
+  return marshaller.GetResult();
+}
+
+template <typename T>
+T ReferenceType(sc_lv<Wrapped<T>::width> bits) {
+  Marshaller<Wrapped<T>::width> marshaller(bits);
+  Wrapped<T> result;
+  result.Marshall(marshaller);
+  return result.val;
+}
+
+template <typename T>
+void CheckType(const char* name) {
+  static const unsigned int W = Wrapped<T>::width;
+  NVHLS_ASSERT_MSG(nvhls::is_packed_message<T>::value, "type is not packed");
+  for (int i = 0; i < NUM_ITERS; i++) {
+    sc_lv<W> bits = TypeToBits<NVUINTW(W)>(nvhls::get_rand<W>());
+    T ref = ReferenceType<T>(bits);
+
+    sc_lv<W> packed_bits = TypeToBits<T>(ref);
+    if (packed_bits != ReferenceBits<T>(ref)) {
+      DCOUT(name << ": TypeToBits mismatch " << packed_bits << " vs " << ReferenceBits<T>(ref) << endl);
+      NVHLS_ASSERT_MSG(false, "TypeToBits mismatch");
+    }
+    T unpacked = BitsToType<T>(bits);
+    NVHLS_ASSERT_MSG(ReferenceBits<T>(unpacked) == bits, "BitsToType mismatch");
+
+    NVUINTW(W) word = TypeToNVUINT<T>(ref);
+    NVHLS_ASSERT_MSG(TypeToBits<NVUINTW(W)>(word) == bits, "TypeToNVUINT mismatch");
+    T from_word = NVUINTToType<T>(word);
+    NVHLS_ASSERT_MSG(ReferenceBits<T>(from_word) == bits, "NVUINTToType mismatch");
+  }
+  DCOUT(name << " (" << W << " bits): PASS" << endl);
+}
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+
+  typedef axi::axi4<axi::cfg::standard> axi_;
+  typedef axi::axi4<axi::cfg::lite> axi_lite_;
+
+  CheckType<Packet<32, 4, 1, 0> >("Packet<32,4,1,0>");
+  CheckType<Packet<128, 5, 3, 6> >("Packet<128,5,3,6>");
+  CheckType<Flit<64, 4, 2, 3, FlitId2bit, StoreForward> >("Flit StoreForward");
+  CheckType<Flit<130, 0, 0, 4, FlitId2bit, WormHole> >("Flit WormHole");
+  CheckType<axi_::AddrPayload>("axi4<standard>::AddrPayload");
+  CheckType<axi_::ReadPayload>("axi4<standard>::ReadPayload");
+  CheckType<axi_::WritePayload>("axi4<standard>::WritePayload");
+  CheckType<axi_::WRespPayload>("axi4<standard>::WRespPayload");
+  CheckType<axi_lite_::AddrPayload>("axi4<lite>::AddrPayload");
+  CheckType<axi_lite_::WritePayload>("axi4<lite>::WritePayload");
+  CheckType<Nested>("Nested");
+
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __PACKETREORDERTOP_H__
+#define __PACKETREORDERTOP_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_array.h>
+#include <WHVCNoC.h>
+#include <PacketReorder.h>
+
+// A 2x2 mesh with two VCs, with a PacketSequencer and a PacketReorder at
+// every node. The packets of one source take either VC, so they overtake
+// each other in the NoC. Credits are returned by the testbench.
+#ifndef REORDER_WINDOW
+#define REORDER_WINDOW 4
+#endif
+
+SC_MODULE(PacketReorderTop) {
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  enum {
+    kMeshX = 2,
+    kMeshY = 2,
+    kNumVChannels = 2,
+    kLogNumVChannels = 1,
+    kBufferSize = 4,
+    kFlitDataWidth = 64,
+    kPacketDataWidth = 128,
+    kPacketIdWidth = 8,
+    kWindow = REORDER_WINDOW,
+  };
+
+  typedef MeshNoC<kMeshX, kMeshY, kNumVChannels, kBufferSize, kFlitDataWidth,
+                  kPacketDataWidth, kPacketIdWidth, true> NoC_t;
+  typedef NoC_t::Packet_t Packet_t;
+  enum { kNumNodes = NoC_t::num_nodes };
+  // On a 2x2 mesh the code of node n is n
+  typedef PacketSequencer<Packet_t, kNumNodes, kWindow, kLogNumVChannels> Sequencer_t;
+  typedef PacketReorder<Packet_t, kNumNodes, kWindow, kLogNumVChannels> Reorder_t;
+  typedef Sequencer_t::Node Node;
+
+  NoC_t noc;
+  nvhls::nv_array<Sequencer_t, kNumNodes> sequencer;
+  nvhls::nv_array<Reorder_t, kNumNodes> reorder;
+
+  Connections::In<Packet_t> in_packet[kNumNodes];
+  Connections::Out<Packet_t> out_packet[kNumNodes];
+  Connections::In<Node> credit_in[kNumNodes];
+  Connections::Out<Node> credit_out[kNumNodes];
+
+  Connections::Combinational<Packet_t> noc_in[kNumNodes];
+  Connections::Combinational<Packet_t> noc_out[kNumNodes];
+  sc_signal<Node> node[kNumNodes];
+
+  SC_HAS_PROCESS(PacketReorderTop);
+  PacketReorderTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        noc("noc"),
+        sequencer("sequencer"),
+        reorder("reorder") {
+    noc.clk(clk);
+    noc.rst(rst);
+    for (int i = 0; i < kNumNodes; i++) {
+      node[i].write(i);
+      sequencer[i].clk(clk);
+      sequencer[i].rst(rst);
+      sequencer[i].node(node[i]);
+      sequencer[i].in_packet(in_packet[i]);
+      sequencer[i].out_packet(noc_in[i]);
+      sequencer[i].credit_in(credit_in[i]);
+      noc.in_packet[i](noc_in[i]);
+      noc.out_packet[i](noc_out[i]);
+      reorder[i].clk(clk);
+      reorder[i].rst(rst);
+      reorder[i].in_packet(noc_out[i]);
+      reorder[i].out_packet(out_packet[i]);
+      reorder[i].credit_out(credit_out[i]);
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PacketReorderTop.h"
+#include <systemc.h>
+#include <mc_scverify.h>
+#include <testbench/nvhls_rand.h>
+#include <nvhls_connections.h>
+
+#define NVHLS_VERIFY_BLOCKS (PacketReorderTop)
+#include <nvhls_verify.h>
+
+#include <deque>
+#include <sstream>
+
+using namespace ::std;
+typedef PacketReorderTop::Packet_t Packet_t;
+typedef PacketReorderTop::Node Node;
+typedef PacketReorderTop::Sequencer_t::Format Format;
+static const int kNumNodes = PacketReorderTop::kNumNodes;
+static const int kNumVChannels = PacketReorderTop::kNumVChannels;
+static const int kWindow = PacketReorderTop::kWindow;
+static const int kNumPackets = 64;
+
+static const int kDebugLevel = 1;
+
+// Every packet carries its source, destination and sequence number per
+// source and destination, followed by random data of none or one word.
+static const int kSrcBit = 0;
+static const int kDstBit = 8;
+static const int kSeqBit = 16;
+static const int kRandBit = 32;
+
+class Reference {
+ public:
+  Reference() : sent(0), received(0) {}
+
+  void packet_sent(int src, int dst, const Packet_t& packet) {
+    expected[src][dst].push_back(packet.data);
+    sent++;
+  }
+
+  void packet_received(int dst, const Packet_t& packet) {
+    CDCOUT(sc_time_stamp() << " node " << dst << " received: " << hex
+           << packet.data << dec << endl, kDebugLevel);
+    int src = nvhls::get_slc<8>(packet.data, kSrcBit).to_uint();
+    int seq = nvhls::get_slc<16>(packet.data, kSeqBit).to_uint();
+    NVHLS_ASSERT_MSG(nvhls::get_slc<8>(packet.data, kDstBit) == dst,
+                     "Packet delivered to the wrong endpoint");
+    NVHLS_ASSERT_MSG(Format::src(packet.packet_id) == src, "Wrong source in packet_id");
+    NVHLS_ASSERT_MSG(Format::seq(packet.packet_id) == seq % kWindow,
+                     "Wrong sequence number in packet_id");
+    // whatever the VC, the packets of a source arrive in order
+    NVHLS_ASSERT_MSG(!expected[src][dst].empty(), "Unknown packet");
+    NVHLS_ASSERT_MSG(expected[src][dst].front() == packet.data,
+                     "Packet out of order");
+    expected[src][dst].pop_front();
+    received++;
+  }
+
+  bool done() const { return received == sent; }
+
+  deque<NVUINTC(Packet_t::data_width)> expected[kNumNodes][kNumNodes];
+  unsigned sent, received;
+};
+
+SC_MODULE(Endpoint) {
+  Connections::Out<Packet_t> out;
+  Connections::In<Packet_t> in;
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+  const int id;
+  Reference& ref;
+
+  void send() {
+    out.Reset();
+    unsigned seq[kNumNodes] = {0};
+    wait();
+    for (unsigned i = 0; i < kNumPackets; i++) {
+      int dst = rand() % kNumNodes;
+      Packet_t packet;
+      packet.data = 0;
+      packet.data = nvhls::set_slc(packet.data, NVUINTC(8)(id), kSrcBit);
+      packet.data = nvhls::set_slc(packet.data, NVUINTC(8)(dst), kDstBit);
+      packet.data = nvhls::set_slc(packet.data, NVUINTC(16)(seq[dst]++), kSeqBit);
+      if (rand() % 2) {
+        packet.data = nvhls::set_slc(packet.data, NVUINTC(32)(rand()), kRandBit);
+      }
+      packet.dest = dst;
+      // the VC is chosen per packet
+      packet.packet_id = rand() % kNumVChannels;
+      ref.packet_sent(id, dst, packet);
+      out.Push(packet);
+      wait(rand() % 3);
+    }
+    while (1) {
+      wait();
+    }
+  }
+
+  void receive() {
+    in.Reset();
+    while (1) {
+      wait();
+      Packet_t packet;
+      // stall now and then to build up backpressure
+      if ((rand() % 3 != 0) && in.PopNB(packet)) {
+        ref.packet_received(id, packet);
+      }
+    }
+  }
+
+  SC_HAS_PROCESS(Endpoint);
+  Endpoint(sc_module_name name_, int id_, Reference& ref_)
+      : sc_module(name_), out("out"), in("in"), clk("clk"), rst("rst"),
+        id(id_), ref(ref_) {
+    SC_THREAD(send);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(receive);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+// Returns the credits of every destination to their sources, after a
+// random delay
+SC_MODULE(CreditReturn) {
+  Connections::In<Node> in[kNumNodes];
+  Connections::Out<Node> out[kNumNodes];
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+
+  void run() {
+    deque<Node> pending[kNumNodes];
+    for (int i = 0; i < kNumNodes; i++) {
+      in[i].Reset();
+      out[i].Reset();
+    }
+    while (1) {
+      wait();
+      for (int dst = 0; dst < kNumNodes; dst++) {
+        Node src;
+        if (in[dst].PopNB(src)) {
+          pending[src.to_uint()].push_back(dst);
+        }
+      }
+      for (int src = 0; src < kNumNodes; src++) {
+        if (!pending[src].empty() && (rand() % 4 == 0) &&
+            out[src].PushNB(pending[src].front())) {
+          pending[src].pop_front();
+        }
+      }
+    }
+  }
+
+  SC_CTOR(CreditReturn) : clk("clk"), rst("rst") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+SC_MODULE(testbench) {
+  NVHLS_DESIGN(PacketReorderTop) dut;
+  CreditReturn credit_return;
+
+  typedef Connections::Combinational<Packet_t> PacketChan;
+  typedef Connections::Combinational<Node> CreditChan;
+
+  sc_clock clk;
+  sc_signal<bool> rst;
+  Reference ref;
+  CreditChan credit_in[kNumNodes];
+  CreditChan credit_out[kNumNodes];
+
+  SC_CTOR(testbench)
+      : dut("dut"),
+        credit_return("credit_return"),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        rst("rst") {
+    Connections::set_sim_clk(&clk);
+
+    dut.clk(clk);
+    dut.rst(rst);
+    credit_return.clk(clk);
+    credit_return.rst(rst);
+
+    for (int i = 0; i < kNumNodes; ++i) {
+      ostringstream name;
+      name << "endpoint_" << i;
+      Endpoint* endpoint = new Endpoint(name.str().c_str(), i, ref);
+      PacketChan* in_chan = new PacketChan();
+      PacketChan* out_chan = new PacketChan();
+
+      endpoint->clk(clk);
+      endpoint->rst(rst);
+      endpoint->out(*in_chan);
+      dut.in_packet[i](*in_chan);
+      dut.out_packet[i](*out_chan);
+      endpoint->in(*out_chan);
+
+      dut.credit_out[i](credit_out[i]);
+      credit_return.in[i](credit_out[i]);
+      credit_return.out[i](credit_in[i]);
+      dut.credit_in[i](credit_in[i]);
+    }
+
+    SC_THREAD(run);
+  }
+
+  void run() {
+    rst = 0;
+    cout << "@" << sc_time_stamp() << " Asserting Reset " << endl;
+    wait(2, SC_NS);
+    cout << "@" << sc_time_stamp() << " Deasserting Reset " << endl;
+    rst = 1;
+    wait(20000, SC_NS);
+    cout << "@" << sc_time_stamp() << " Stop " << endl;
+    cout << "sent " << ref.sent << " packets, received " << ref.received
+         << endl;
+    NVHLS_ASSERT_MSG(ref.sent > 0 && ref.done(), "Not all packets were delivered");
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char* argv[]) {
+  nvhls::set_random_seed();
+  testbench my_testbench("my_testbench");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    cout << "Simulation FAILED\n";
+  else
+    cout << "Simulation PASSED\n";
+  return rc;
+};
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <ParallelAccumulator.h>
+#include <hls_globals.h>
+#include "ParallelAccumulatorTop.h"
+
+void ParallelAccumulatorTop(const Acc::Bin bin[NumLanes],
+                            const BinType inc[NumLanes],
+                            const bool valid[NumLanes],
+                            bool ready[NumLanes],
+                            const bool& read,
+                            const bool& clear,
+                            const Acc::Bin& read_bin,
+                            BinType& read_data) {
+  static Acc acc;
+  read_data = 0;
+  if (read || clear) {
+    #pragma hls_unroll yes
+    for (unsigned i = 0; i < NumLanes; i++) {
+      ready[i] = false;
+    }
+    if (read) {
+      read_data = acc.read(read_bin);
+    }
+    if (clear) {
+      acc.clear(read_bin);
+    }
+  } else {
+    acc.update(bin, inc, valid, ready);
+  }
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARALLELACCUMULATOR_TOP_H
+#define PARALLELACCUMULATOR_TOP_H
+
+#include <ParallelAccumulator.h>
+#include <hls_globals.h>
+
+#ifndef ACC_BINS
+#define ACC_BINS 64
+#endif
+
+#ifndef ACC_LANES
+#define ACC_LANES 4
+#endif
+
+#ifndef ACC_COPIES
+#define ACC_COPIES 2
+#endif
+
+const unsigned NumBins = ACC_BINS;
+const unsigned NumLanes = ACC_LANES;
+
+typedef NVUINTC(16) BinType;
+typedef ParallelAccumulator<BinType, NumBins, NumLanes, ACC_COPIES> Acc;
+
+// Updates the bins, or with read or clear set reads and clears one bin
+void ParallelAccumulatorTop(const Acc::Bin bin[NumLanes],
+                            const BinType inc[NumLanes],
+                            const bool valid[NumLanes],
+                            bool ready[NumLanes],
+                            const bool& read,
+                            const bool& clear,
+                            const Acc::Bin& read_bin,
+                            BinType& read_data);
+
+#endif
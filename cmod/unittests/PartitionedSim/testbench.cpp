@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_module.h>
+#include <testbench/nvhls_rand.h>
+#include <testbench/nvhls_partition.h>
+
+#include <vector>
+
+#ifndef NUM_PARTITIONS
+#define NUM_PARTITIONS 4
+#endif
+
+#ifndef NUM_MESSAGES
+#define NUM_MESSAGES 5000
+#endif
+
+static const unsigned int kLatency = 2;
+
+typedef NVUINTW(32) Word_t;
+
+// One tile of a ring: sends numbered words to the next tile and checks the
+// words of the previous one, each side stalling at random.
+SC_MODULE(Tile) {
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  unsigned int id;
+  unsigned int prev;
+  unsigned int sent;
+  unsigned int received;
+  bool error;
+
+  nvhls::PartitionSender<Word_t, kLatency> to_next;
+  nvhls::PartitionReceiver<Word_t, kLatency> from_prev;
+  Connections::Combinational<Word_t> out_chan;
+  Connections::Combinational<Word_t> in_chan;
+  Connections::Out<Word_t> out;
+  Connections::In<Word_t> in;
+  nvhls::Rng rng;
+
+  SC_HAS_PROCESS(Tile);
+  Tile(sc_module_name name, unsigned int id_, unsigned int count)
+      : sc_module(name),
+        clk("clk"),
+        rst("rst"),
+        id(id_),
+        prev((id_ + count - 1) % count),
+        sent(0),
+        received(0),
+        error(false),
+        // Link i runs from tile i to tile i + 1
+        to_next("to_next", id_, (id_ + 1) % count),
+        from_prev("from_prev", prev, prev),
+        out("out"),
+        in("in"),
+        rng(this->name()) {
+    to_next.clk(clk);
+    to_next.rst(rst);
+    from_prev.clk(clk);
+    from_prev.rst(rst);
+    out(out_chan);
+    to_next.enq(out_chan);
+    from_prev.deq(in_chan);
+    in(in_chan);
+
+    SC_THREAD(send);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+
+    SC_THREAD(receive);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void send() {
+    out.Reset();
+    wait();
+    while (1) {
+      wait();
+      if (sent < NUM_MESSAGES && rng.below(4) != 0 && out.PushNB((id << 24) | sent)) {
+        sent++;
+      }
+    }
+  }
+
+  void receive() {
+    in.Reset();
+    wait();
+    while (1) {
+      wait();
+      Word_t w;
+      if (rng.below(4) != 0 && in.PopNB(w)) {
+        if (w != ((prev << 24) | received)) {
+          DCOUT(name() << ": received " << w << ", expected word " << received << " of tile " << prev << endl);
+          error = true;
+        }
+        received++;
+      }
+    }
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::Partitions& parts = nvhls::Partitions::Instance();
+  parts.Launch(NUM_PARTITIONS);
+  nvhls::set_random_seed();
+
+  sc_clock clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true);
+  sc_signal<bool> rst("rst");
+  Connections::set_sim_clk(&clk);
+
+  // Each partition is one tile
+  std::vector<Tile*> tiles;
+  for (unsigned int p = 0; p < NUM_PARTITIONS; p++) {
+    if (parts.Owns(p)) {
+      tiles.push_back(new Tile(sc_gen_unique_name("tile"), p, NUM_PARTITIONS));
+      tiles.back()->clk(clk);
+      tiles.back()->rst(rst);
+    }
+  }
+
+  rst = 0;
+  sc_start(10, SC_NS);
+  rst = 1;
+  // Both sides stall a quarter of the cycles
+  sc_start(2 * NUM_MESSAGES + 100, SC_NS);
+
+  int status = 0;
+  for (unsigned int i = 0; i < tiles.size(); i++) {
+    Tile& tile = *tiles[i];
+    DCOUT(tile.name() << " in partition " << parts.Self() << ": sent " << tile.sent << " received "
+                      << tile.received << endl);
+    if (tile.error || tile.sent != NUM_MESSAGES || tile.received != NUM_MESSAGES) {
+      status = 1;
+    }
+  }
+  status = parts.Finish(status);
+  if (status == 0) {
+    DCOUT("CMODEL PASS" << endl);
+  }
+  return status;
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <PingPongBuffer.h>
+#include <testbench/nvhls_rand.h>
+
+#ifndef NUM_TILES
+#define NUM_TILES 20
+#endif
+
+typedef NVUINTW(16) Elem_t;
+
+// A DMA producer and a compute consumer around one buffer, both one row per
+// cycle; the consumer stalls randomly when stall_prob is set
+template <int NumBuffers>
+SC_MODULE(Lane) {
+  typedef PingPongBuffer<Elem_t, 64, 4, NumBuffers> Buffer_t;
+  static const int kRows = Buffer_t::EntriesPerBank;
+
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  Buffer_t buffer;
+  Connections::Combinational<typename Buffer_t::WriteReq> wr_req;
+  Connections::Combinational<typename Buffer_t::ReadReq> rd_req;
+  Connections::Combinational<typename Buffer_t::ReadRsp> rd_rsp;
+
+  int stall_prob;
+  unsigned int rows_checked;
+  sc_time done_time;
+
+  SC_HAS_PROCESS(Lane);
+  Lane(sc_module_name name, int stall_prob_)
+      : sc_module(name), clk("clk"), rst("rst"), buffer("buffer"), stall_prob(stall_prob_),
+        rows_checked(0) {
+    buffer.clk(clk);
+    buffer.rst(rst);
+    buffer.wr_req(wr_req);
+    buffer.rd_req(rd_req);
+    buffer.rd_rsp(rd_rsp);
+
+    SC_THREAD(produce);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(request);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(check);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  static Elem_t Value(int tile, int row, int bank) { return tile * 1000 + row * 4 + bank; }
+
+  void produce() {
+    wr_req.ResetWrite();
+    wait();
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+      for (int row = 0; row < kRows; row++) {
+        typename Buffer_t::WriteReq w;
+        w.addr = row;
+        // Bank 2 of the second row is written twice, the first time masked out
+        w.bank_en = (row == 1) ? ~typename Buffer_t::BankMask(4) : ~typename Buffer_t::BankMask(0);
+        for (int b = 0; b < 4; b++) {
+          w.data[b] = Value(tile, row, b);
+        }
+        w.last = false;
+        wr_req.Push(w);
+        if (row == 1) {
+          w.bank_en = 4;
+          wr_req.Push(w);
+        }
+      }
+      // Commit only, no bank enabled
+      typename Buffer_t::WriteReq w;
+      w.addr = 0;
+      w.bank_en = 0;
+      w.last = true;
+      wr_req.Push(w);
+    }
+  }
+
+  void request() {
+    rd_req.ResetWrite();
+    wait();
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+      for (int row = 0; row < kRows; row++) {
+        typename Buffer_t::ReadReq r;
+        r.addr = row;
+        r.last = (row == kRows - 1);
+        rd_req.Push(r);
+      }
+    }
+  }
+
+  void check() {
+    rd_rsp.ResetRead();
+    wait();
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+      for (int row = 0; row < kRows; row++) {
+        while (stall_prob && (rand() % 100) < stall_prob) {
+          wait();
+        }
+        typename Buffer_t::ReadRsp rsp = rd_rsp.Pop();
+        for (int b = 0; b < 4; b++) {
+          NVHLS_ASSERT_MSG(rsp.data[b] == Value(tile, row, b), "Read data mismatch");
+        }
+        NVHLS_ASSERT_MSG(rsp.last == (row == kRows - 1), "Read last mismatch");
+        rows_checked++;
+      }
+    }
+    done_time = sc_time_stamp();
+  }
+
+  bool Done() const { return rows_checked == NUM_TILES * kRows; }
+};
+
+SC_MODULE(testbench) {
+  sc_clock clk;
+  sc_signal<bool> rst;
+
+  Lane<2> ping_pong;
+  Lane<3> triple;
+  Lane<2> stalled;
+
+  SC_CTOR(testbench)
+      : clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true),
+        rst("rst"),
+        ping_pong("ping_pong", 0),
+        triple("triple", 0),
+        stalled("stalled", 30) {
+    Connections::set_sim_clk(&clk);
+    ping_pong.clk(clk);
+    ping_pong.rst(rst);
+    triple.clk(clk);
+    triple.rst(rst);
+    stalled.clk(clk);
+    stalled.rst(rst);
+
+    SC_THREAD(run);
+    sensitive << clk.posedge_event();
+  }
+
+  void run() {
+    rst = 0;
+    wait(10);
+    rst = 1;
+    sc_time start = sc_time_stamp();
+    unsigned int cycles = 0;
+    while (!(ping_pong.Done() && triple.Done() && stalled.Done())) {
+      wait();
+      NVHLS_ASSERT_MSG(++cycles < 100 * NUM_TILES * 16, "Timed out");
+    }
+
+    // Writes of a tile take two more cycles than its reads (the second write
+    // of row 1 and the commit); as loads overlap reads, the run takes about
+    // one tile of writes per tile, plus the first load
+    double rows = NUM_TILES * Lane<2>::kRows;
+    double ping_pong_cycles = (ping_pong.done_time - start) / clk.period();
+    double triple_cycles = (triple.done_time - start) / clk.period();
+    DCOUT("ping-pong " << ping_pong_cycles << " cycles, triple " << triple_cycles << " cycles, stalled "
+                       << (stalled.done_time - start) / clk.period() << " cycles for " << rows
+                       << " rows per lane" << endl);
+    NVHLS_ASSERT_MSG(ping_pong_cycles < rows * 1.4, "Ping-pong buffer does not overlap load and read");
+    NVHLS_ASSERT_MSG(triple_cycles <= ping_pong_cycles + 2, "Triple buffering is slower than double");
+
+    match::PortStats& stats = stalled.buffer.Stats();
+    NVHLS_ASSERT_MSG(stats.Transfers() == NUM_TILES, "Wrong number of commits");
+    NVHLS_ASSERT_MSG(stats.StallCycles() > 0, "Stalled consumer never filled both buffers");
+    DCOUT("CMODEL PASS" << endl);
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_start();
+  return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_module.h>
+#include <nvhls_assert.h>
+#include <nvhls_profiler.h>
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#ifndef NUM_CYCLES
+#define NUM_CYCLES 200
+#endif
+
+// Two threads and a method, one of which does much more work per cycle
+class Dut : public match::Module {
+ public:
+  volatile unsigned int sink;
+  unsigned int method_calls;
+
+  SC_HAS_PROCESS(Dut);
+  Dut(sc_module_name nm) : match::Module(nm), sink(0), method_calls(0) {
+    SC_THREAD(Busy);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(Idle);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_METHOD(Update);
+    sensitive << clk.pos();
+    dont_initialize();
+  }
+
+  void Busy() {
+    wait();
+    while (1) {
+      for (unsigned int i = 0; i < 20000; i++) {
+        sink = sink + i;
+      }
+      wait();
+    }
+  }
+
+  void Idle() {
+    wait();
+    while (1) {
+      wait(2);
+    }
+  }
+
+  void Update() {
+    match::ProfileScope profile;
+    method_calls++;
+  }
+};
+
+SC_MODULE(testbench) {
+  sc_clock clk;
+  sc_signal<bool> rst;
+  Dut dut;
+
+  SC_CTOR(testbench) : clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true), rst("rst"), dut("dut") {
+    dut.clk(clk);
+    dut.rst(rst);
+    SC_THREAD(run);
+    sensitive << clk.posedge_event();
+  }
+
+  void run() {
+    rst = 0;
+    wait(2);
+    rst = 1;
+    wait(NUM_CYCLES);
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  testbench tb("tb");
+  sc_start();
+
+  match::Profiler& profiler = match::Profiler::Instance();
+  std::map<std::string, match::Profiler::Process> procs;
+  for (std::map<const sc_object*, match::Profiler::Process>::const_iterator it =
+           profiler.Processes().begin();
+       it != profiler.Processes().end(); it++) {
+    procs[it->second.name] = it->second;
+  }
+  NVHLS_ASSERT_MSG(procs.size() == 3, "testbench process was profiled");
+  const match::Profiler::Process& busy = procs["tb.dut.Busy"];
+  const match::Profiler::Process& idle = procs["tb.dut.Idle"];
+  const match::Profiler::Process& update = procs["tb.dut.Update"];
+  NVHLS_ASSERT_MSG(busy.module == "tb.dut", "wrong module");
+  // The initialization run and every clock edge up to sc_stop(), give or
+  // take the last edge; Idle only wakes on every edge while in reset
+  NVHLS_ASSERT_MSG(busy.activations >= NUM_CYCLES + 1 && busy.activations <= NUM_CYCLES + 3,
+                   "wrong thread activations");
+  NVHLS_ASSERT_MSG(idle.activations <= NUM_CYCLES / 2 + 5, "wrong wait(n) activations");
+  NVHLS_ASSERT_MSG(update.activations == tb.dut.method_calls, "wrong method activations");
+  NVHLS_ASSERT_MSG(busy.cycles > 10 * idle.cycles, "busy thread not charged");
+  NVHLS_ASSERT_MSG(busy.cycles > 10 * update.cycles, "busy thread not charged");
+
+  std::stringstream report;
+  profiler.Report(report);
+  DCOUT(report.str());
+  std::string text = report.str();
+  NVHLS_ASSERT_MSG(text.find("Host time per process:\n  tb.dut.Busy: ") == 0,
+                   "busiest process not reported first");
+  NVHLS_ASSERT_MSG(text.find("Host time per module:\n  tb.dut: ") != std::string::npos,
+                   "module total missing");
+  NVHLS_ASSERT_MSG(profiler.ElaborationCycles() > 0, "elaboration not timed");
+  NVHLS_ASSERT_MSG(text.find("\nElaboration: ") != std::string::npos, "elaboration missing");
+
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <hls_globals.h>
+#include <nvhls_pwl.h>
+#include <nvhls_divsqrt.h>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+
+#ifndef PWL_SEG_BITS
+#define PWL_SEG_BITS 6
+#endif
+#ifndef PWL_SUB_BITS
+#define PWL_SUB_BITS 3
+#endif
+
+typedef nvhls::PwlUniform<PWL_SEG_BITS> Uniform;
+typedef nvhls::PwlOctave<PWL_SUB_BITS> Octave;
+
+double RefSigmoid(double x) { return 1.0 / (1.0 + std::exp(-x)); }
+double RefTanh(double x) { return std::tanh(x); }
+double RefExp(double x) { return std::exp(x); }
+double RefLog(double x) { return std::log(x); }
+
+// Checks every input against Ref to within error_bound(), and that the
+// unit behind a pipeline register gives the same results one cycle later
+template <typename Approx, unsigned int InW, unsigned int InFrac, unsigned int OutFrac,
+          bool Signed>
+void TestApprox(double (*ref)(double), bool skip_zero) {
+  typedef nvhls::ArithPipelined<Approx, 1> Pipe;
+  NVHLS_ASSERT_MSG(Pipe::Latency == 1, "Wrong pipeline latency");
+  Pipe pipe;
+  std::deque<long long> expected;
+  double bound = Approx::error_bound();
+  for (unsigned long long u = 0; u < (1ULL << InW) + 1; u++) {
+    bool valid = (u < (1ULL << InW)) && (rand() % 4 != 0);
+    typename Approx::In in;
+    in.x = u;
+    typename Approx::Out out;
+    Approx::compute(in, out);
+    if (u < (1ULL << InW) && !(skip_zero && u == 0)) {
+      long long raw = u;
+      if (Signed && (u >> (InW - 1)) == 1) {
+        raw -= 1LL << InW;
+      }
+      double x = std::ldexp((double)raw, -(int)InFrac);
+      double y = std::ldexp((double)out.y.to_int64(), -(int)OutFrac);
+      NVHLS_ASSERT_MSG(std::fabs(y - ref(x)) <= bound, "Error above the bound");
+    }
+    typename Approx::Out pout;
+    bool pvalid;
+    pipe.run(in, valid, pout, pvalid);
+    if (pvalid) {
+      NVHLS_ASSERT_MSG(!expected.empty(), "Output without an input");
+      NVHLS_ASSERT_MSG(pout.y.to_int64() == expected.front(), "Pipelined result differs");
+      expected.pop_front();
+    }
+    if (valid) {
+      expected.push_back(out.y.to_int64());
+    }
+  }
+  NVHLS_ASSERT_MSG(expected.empty(), "Not all inputs came out");
+}
+
+int sc_main(int argc, char *argv[]) {
+  srand(1);
+  // Q4.12 inputs, Q1.14 outputs
+  TestApprox<nvhls::PwlApprox<nvhls::PwlSigmoid, 16, 12, 16, 14, Uniform>, 16, 12, 14, true>(
+      RefSigmoid, false);
+  TestApprox<nvhls::PwlApprox<nvhls::PwlTanh, 16, 12, 16, 14, Uniform>, 16, 12, 14, true>(
+      RefTanh, false);
+  // Q3.9 inputs, so that e^x stays below the Q8.8 output range
+  TestApprox<nvhls::PwlApprox<nvhls::PwlExp, 12, 9, 16, 8, Uniform>, 12, 9, 8, true>(
+      RefExp, false);
+  // Unsigned Q8.8 inputs; log(0) saturates
+  typedef nvhls::PwlApprox<nvhls::PwlLog, 16, 8, 16, 11, Octave, false> Log;
+  TestApprox<Log, 16, 8, 11, false>(RefLog, true);
+  Log::In in;
+  Log::Out out;
+  in.x = 0;
+  Log::compute(in, out);
+  NVHLS_ASSERT_MSG(out.y.to_int64() == -(1LL << 15), "log(0) does not saturate");
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
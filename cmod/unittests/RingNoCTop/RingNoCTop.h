@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __RINGNOCTOP_H__
+#define __RINGNOCTOP_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <RingNoC.h>
+
+// Default: unidirectional ring of 8 stops. Define RING_BIDIRECTIONAL for a
+// second ring running the other way.
+#ifndef NUM_STOPS
+#define NUM_STOPS 8
+#endif
+#ifdef RING_BIDIRECTIONAL
+#define BIDIRECTIONAL true
+#else
+#define BIDIRECTIONAL false
+#endif
+
+SC_MODULE(RingNoCTop) {
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  enum {
+    kNumStops = NUM_STOPS,
+    kBufferSize = 4,
+    kFlitDataWidth = 64,
+    kPacketDataWidth = 128,
+    kPacketIdWidth = 8
+  };
+
+  typedef RingNoC<kNumStops, kBufferSize, kFlitDataWidth, kPacketDataWidth,
+                  kPacketIdWidth, BIDIRECTIONAL> NoC_t;
+  typedef NoC_t::Packet_t Packet_t;
+
+  NoC_t noc;
+
+  Connections::In<Packet_t> in_packet[kNumStops];
+  Connections::Out<Packet_t> out_packet[kNumStops];
+
+  SC_HAS_PROCESS(RingNoCTop);
+  RingNoCTop(sc_module_name name)
+      : sc_module(name), clk("clk"), rst("rst"), noc("noc") {
+    noc.clk(clk);
+    noc.rst(rst);
+    for (int i = 0; i < kNumStops; i++) {
+      noc.in_packet[i](in_packet[i]);
+      noc.out_packet[i](out_packet[i]);
+    }
+  }
+};
+
+#endif
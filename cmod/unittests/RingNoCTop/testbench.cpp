@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RingNoCTop.h"
+#include <systemc.h>
+#include <mc_scverify.h>
+#include <testbench/nvhls_rand.h>
+#include <nvhls_connections.h>
+
+#define NVHLS_VERIFY_BLOCKS (RingNoCTop)
+#include <nvhls_verify.h>
+
+#include <deque>
+#include <map>
+#include <sstream>
+
+using namespace ::std;
+typedef RingNoCTop::Packet_t Packet_t;
+typedef RingNoCTop::NoC_t NoC_t;
+static const int kNumNodes = RingNoCTop::kNumStops;
+static const int kNumPackets = 32;
+
+static const int kDebugLevel = 1;
+
+// Every packet carries its source, destination, the packet_id it was sent
+// with and a per-source sequence number, followed by random data of none,
+// one or two words. The fields alone fit in the header flit.
+static const int kSrcBit = 0;
+static const int kDstBit = 8;
+static const int kIdBit = 16;
+static const int kSeqBit = 24;
+static const int kRandBit = 40;
+static const int kRand2Bit = 96;
+
+class Reference {
+ public:
+  Reference() : sent(0), received(0) {}
+
+  static int stream(const Packet_t& packet) {
+    return nvhls::get_slc<16>(packet.data, kSrcBit).to_uint();
+  }
+
+  void packet_sent(const Packet_t& packet) {
+    expected[stream(packet)].push_back(packet.data);
+    sent++;
+  }
+
+  void packet_received(int dst, const Packet_t& packet) {
+    CDCOUT(sc_time_stamp() << " node " << dst << " received: " << hex
+           << packet.data << dec << endl, kDebugLevel);
+    int s = stream(packet);
+    NVHLS_ASSERT_MSG(nvhls::get_slc<8>(packet.data, kDstBit) == dst,
+                     "Packet delivered to the wrong endpoint");
+    NVHLS_ASSERT_MSG(packet.dest == dst, "Destination stop changed");
+    // packets of one source and destination take one way, and arrive in order
+    NVHLS_ASSERT_MSG(!expected[s].empty(), "Unknown packet");
+    NVHLS_ASSERT_MSG(expected[s].front() == packet.data, "Packet mismatch");
+    expected[s].pop_front();
+    received++;
+  }
+
+  bool done() const { return received == sent; }
+
+  map<int, deque<NVUINTC(Packet_t::data_width)> > expected;
+  unsigned sent, received;
+};
+
+SC_MODULE(Endpoint) {
+  Connections::Out<Packet_t> out;
+  Connections::In<Packet_t> in;
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+  const int id;
+  Reference& ref;
+
+  void send() {
+    out.Reset();
+    wait();
+    for (unsigned seq = 0; seq < kNumPackets; seq++) {
+      int dst = rand() % kNumNodes;
+      NVUINTC(8) packet_id = rand() % 256;
+      Packet_t packet;
+      packet.data = 0;
+      packet.data = nvhls::set_slc(packet.data, NVUINTC(8)(id), kSrcBit);
+      packet.data = nvhls::set_slc(packet.data, NVUINTC(8)(dst), kDstBit);
+      packet.data = nvhls::set_slc(packet.data, packet_id, kIdBit);
+      packet.data = nvhls::set_slc(packet.data, NVUINTC(16)(seq), kSeqBit);
+      int words = rand() % 3;
+      if (words > 0) {
+        packet.data = nvhls::set_slc(packet.data, NVUINTC(32)(rand()), kRandBit);
+      }
+      if (words > 1) {
+        packet.data = nvhls::set_slc(packet.data, NVUINTC(32)(rand()), kRand2Bit);
+      }
+      packet.dest = dst;
+      packet.packet_id = packet_id;
+      ref.packet_sent(packet);
+      out.Push(packet);
+      wait(rand() % 4);
+    }
+    while (1) {
+      wait();
+    }
+  }
+
+  void receive() {
+    in.Reset();
+    while (1) {
+      wait();
+      Packet_t packet;
+      // stall now and then to build up backpressure
+      if ((rand() % 3 != 0) && in.PopNB(packet)) {
+        ref.packet_received(id, packet);
+      }
+    }
+  }
+
+  SC_HAS_PROCESS(Endpoint);
+  Endpoint(sc_module_name name_, int id_, Reference& ref_)
+      : sc_module(name_), out("out"), in("in"), clk("clk"), rst("rst"),
+        id(id_), ref(ref_) {
+    SC_THREAD(send);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(receive);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+SC_MODULE(testbench) {
+  NVHLS_DESIGN(RingNoCTop) noc;
+
+  typedef Connections::Combinational<Packet_t> PacketChan;
+
+  sc_clock clk;
+  sc_signal<bool> rst;
+  Reference ref;
+
+  SC_CTOR(testbench)
+      : noc("noc"),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        rst("rst") {
+    Connections::set_sim_clk(&clk);
+
+    noc.clk(clk);
+    noc.rst(rst);
+
+    for (int i = 0; i < kNumNodes; ++i) {
+      ostringstream name;
+      name << "endpoint_" << i;
+      Endpoint* endpoint = new Endpoint(name.str().c_str(), i, ref);
+      PacketChan* in_chan = new PacketChan();
+      PacketChan* out_chan = new PacketChan();
+
+      endpoint->clk(clk);
+      endpoint->rst(rst);
+      endpoint->out(*in_chan);
+      noc.in_packet[i](*in_chan);
+      noc.out_packet[i](*out_chan);
+      endpoint->in(*out_chan);
+    }
+
+    SC_THREAD(run);
+  }
+
+  void run() {
+    rst = 0;
+    cout << "@" << sc_time_stamp() << " Asserting Reset " << endl;
+    wait(2, SC_NS);
+    cout << "@" << sc_time_stamp() << " Deasserting Reset " << endl;
+    rst = 1;
+    wait(20000, SC_NS);
+    cout << "@" << sc_time_stamp() << " Stop " << endl;
+    cout << "sent " << ref.sent << " packets, received " << ref.received
+         << endl;
+    NVHLS_ASSERT_MSG(ref.sent > 0 && ref.done(), "Not all packets were delivered");
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char* argv[]) {
+  nvhls::set_random_seed();
+  testbench my_testbench("my_testbench");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    cout << "Simulation FAILED\n";
+  else
+    cout << "Simulation PASSED\n";
+  return rc;
+};
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <Scratchpad.h>
+#include <nvhls_sampling.h>
+#include <testbench/nvhls_rand.h>
+
+#include <vector>
+
+#ifndef NUM_CYCLES
+#define NUM_CYCLES 100000
+#endif
+
+// Fast-forward, warmup and measured cycles of each sampling period
+static const uint64 kFastForward = 9000;
+static const uint64 kWarmup = 100;
+static const uint64 kWindow = 900;
+
+static const int kLanes = 4;
+static const int kWords = 64;
+typedef NVUINTW(16) Word_t;
+typedef ScratchpadClass<Word_t, kLanes, kWords> Scratchpad_t;
+
+// Drives random requests with bank conflicts through load_store_partial(),
+// checking loads against a reference memory
+SC_MODULE(Driver) {
+  sc_in_clk clk;
+
+  Scratchpad_t scratchpad;
+  std::vector<Word_t> ref;
+  unsigned long requests;
+  unsigned long functional_calls;
+  unsigned long functional_requests;
+  bool error;
+  nvhls::Rng rng;
+
+  SC_CTOR(Driver)
+      : clk("clk"), ref(kWords, 0), requests(0), functional_calls(0), functional_requests(0), error(false),
+        rng("sampling") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+  }
+
+  void run() {
+    Scratchpad_t::req_t req;
+    Scratchpad_t::lane_mask_t pending = 0;
+    for (int i = 0; i < kWords; i++) {
+      scratchpad.banks.write(i % kLanes, i / kLanes, 0);  // no X reads
+    }
+    while (1) {
+      wait();
+      if (pending == 0) {
+        req.opcode = rng.below(2) ? LOAD : STORE;
+        for (int i = 0; i < kLanes; i++) {
+          req.valids[i] = 1;
+          req.addr[i] = rng.below(kWords / 2);  // sometimes the same address
+          req.data[i] = rng.get_rand<16>();
+        }
+        pending = ~static_cast<Scratchpad_t::lane_mask_t>(0);
+        requests++;
+        if (nvhls::Sampling::Functional()) functional_requests++;
+      }
+      if (nvhls::Sampling::Functional()) functional_calls++;
+      Scratchpad_t::rsp_t rsp;
+      Scratchpad_t::lane_mask_t served = scratchpad.load_store_partial(req, pending, rsp);
+      for (int i = 0; i < kLanes; i++) {
+        if (!served[i]) continue;
+        if (req.opcode == STORE) {
+          ref[req.addr[i]] = req.data[i];
+        } else if (rsp.valids[i] != 1 || rsp.data[i] != ref[req.addr[i]]) {
+          error = true;
+        }
+      }
+      pending &= ~served;
+    }
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  sc_clock clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true);
+  Driver driver("driver");
+  driver.clk(clk);
+
+  nvhls::SamplingController controller("controller", kFastForward, kWarmup, kWindow);
+  controller.clk(clk);
+  nvhls::Sampling& sampling = nvhls::Sampling::Instance();
+  sampling.RegisterCounter("driver.requests", driver.requests);
+  sampling.RegisterCounter("driver.conflict_cycles", driver.scratchpad.stat_conflict_cycles);
+
+  sc_start(NUM_CYCLES, SC_NS);
+  controller.Flush();
+  sampling.Report(std::cout);
+
+  NVHLS_ASSERT_MSG(!driver.error, "Load returned the wrong data");
+  // Fast-forwarded requests take one call each, with no stats
+  NVHLS_ASSERT_MSG(driver.functional_calls == driver.functional_requests, "Functional mode stalled a request");
+  NVHLS_ASSERT_MSG(driver.scratchpad.stat_cycles < NUM_CYCLES - driver.functional_calls + 1,
+                   "Functional calls were counted in stats");
+
+  uint64 periods = NUM_CYCLES / (kFastForward + kWarmup + kWindow);
+  NVHLS_ASSERT_MSG(sampling.Windows() == periods, "Wrong number of windows");
+  NVHLS_ASSERT_MSG(sampling.MeasuredCycles() == periods * kWindow, "Wrong number of measured cycles");
+  NVHLS_ASSERT_MSG(sampling.TotalCycles() >= NUM_CYCLES && sampling.TotalCycles() <= NUM_CYCLES + 1, "Wrong number of cycles");
+  // Conflicts hold a detailed request for more than one cycle
+  double rate = sampling.Measured("driver.requests") / sampling.MeasuredCycles();
+  NVHLS_ASSERT_MSG(rate > 0.1 && rate < 0.9, "Detailed request rate out of range");
+  NVHLS_ASSERT_MSG(sampling.Estimate("driver.requests") < driver.requests, "Estimate counts functional requests");
+
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <testbench/nvhls_rand.h>
+#include <testbench/Scoreboard.h>
+
+#include <deque>
+#include <vector>
+
+#ifndef NUM_MESSAGES
+#define NUM_MESSAGES 1000000
+#endif
+
+#ifndef NUM_STREAMS
+#define NUM_STREAMS 64
+#endif
+
+typedef NVUINTW(32) Word_t;
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  nvhls::Rng rng("scoreboard");
+
+  nvhls::Scoreboard<Word_t> scoreboard;
+  scoreboard.starvation_cycles = 10000;
+  scoreboard.max_outstanding = 1000;
+
+  // Reference: what each stream still owes
+  std::vector<std::deque<Word_t> > owed(NUM_STREAMS);
+  std::vector<std::deque<uint64> > sent(NUM_STREAMS);
+  std::vector<uint64> latency_max(NUM_STREAMS, 0);
+
+  // One message in and one out per cycle, delivered from a random stream
+  uint64 cycle = 0;
+  for (int i = 0; i < NUM_MESSAGES + NUM_STREAMS; i++, cycle++) {
+    if (i < NUM_MESSAGES) {
+      unsigned int key = rng.below(NUM_STREAMS);
+      Word_t m = rng.get_rand<32>();
+      scoreboard.Expect(key, m, cycle);
+      owed[key].push_back(m);
+      sent[key].push_back(cycle);
+    }
+    if (i >= NUM_STREAMS && !scoreboard.empty()) {
+      unsigned int key = rng.below(NUM_STREAMS);
+      while (owed[key].empty()) {
+        key = (key + 1) % NUM_STREAMS;
+      }
+      uint64 latency = scoreboard.Check(key, owed[key].front(), cycle);
+      NVHLS_ASSERT_MSG(latency == cycle - sent[key].front(), "Latency mismatch");
+      if (latency > latency_max[key]) latency_max[key] = latency;
+      owed[key].pop_front();
+      sent[key].pop_front();
+    }
+  }
+  while (!scoreboard.empty()) {
+    for (unsigned int key = 0; key < NUM_STREAMS; key++) {
+      if (!owed[key].empty()) {
+        scoreboard.Check(key, owed[key].front(), cycle);
+        owed[key].pop_front();
+      }
+    }
+    cycle++;
+  }
+
+  NVHLS_ASSERT_MSG(scoreboard.Total().matched == NUM_MESSAGES, "Scoreboard lost messages");
+  uint64 matched = 0;
+  for (unsigned int key = 0; key < NUM_STREAMS; key++) {
+    const nvhls::ScoreboardStats& st = scoreboard.Streams().find(key)->second.stats;
+    NVHLS_ASSERT_MSG(latency_max[key] <= st.latency_max, "Stream latency max mismatch");
+    matched += st.matched;
+  }
+  NVHLS_ASSERT_MSG(matched == NUM_MESSAGES, "Stream statistics do not add up");
+  DCOUT(NUM_MESSAGES << " messages on " << NUM_STREAMS << " streams, mean latency " << scoreboard.Total().Mean()
+                     << ", max " << scoreboard.Total().latency_max << endl);
+
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
@@ -28,6 +28,13 @@
 #ifndef SCRATCHPAD_CAPACITY
   #define SCRATCHPAD_CAPACITY SCRATCHPAD_BANKS * 256
 #endif
+#ifndef SCRATCHPAD_QUEUE_CONFLICTS
+  #define SCRATCHPAD_QUEUE_CONFLICTS 0
+#endif
+// A non-zero read latency selects PipelinedScratchpad
+#ifndef SCRATCHPAD_READ_LATENCY
+  #define SCRATCHPAD_READ_LATENCY 0
+#endif
 #define SCRATCHPAD_ADDR_WIDTH nvhls::nbits<SCRATCHPAD_CAPACITY-1>::val
 
 
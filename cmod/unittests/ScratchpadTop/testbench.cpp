@@ -182,6 +182,40 @@ void TbIO::source() {
     // Push the requested load addresses into a fifo here for checking in the sink function:
     fifo.push_back(curr_cli_req);
   }
+
+#if SCRATCHPAD_QUEUE_CONFLICTS
+  /*
+    Random, mostly conflicting stores and loads. Wait for the loads above to
+    be checked first, since the stores update the memory model right away.
+  */
+  while (!fifo.empty()) wait();
+
+  DCOUT("@" << sc_time_stamp() << ":  Conflicting stores and loads" << endl);
+  curr_cli_req.opcode = STORE;
+  for (int i=0; i<SCRATCHPAD_CAPACITY/SCRATCHPAD_BANKS; i++) {
+    wait();
+    for (int j=0; j<SCRATCHPAD_BANKS; j++) {
+      curr_cli_req.addr[j] = rand() % SCRATCHPAD_CAPACITY;
+      curr_cli_req.data[j] = rand();
+    }
+    cli_req.Push(curr_cli_req);
+    refmem.exec_store(curr_cli_req);
+  }
+
+  curr_cli_req.opcode = LOAD;
+  for (int i=0; i<SCRATCHPAD_CAPACITY/SCRATCHPAD_BANKS; i++) {
+    wait();
+    for (int j=0; j<SCRATCHPAD_BANKS; j++) {
+      curr_cli_req.data[j] = 0xdeadbeef;
+      // Strided by the number of banks: every lane hits bank 0
+      curr_cli_req.addr[j] = (i % 2) ? (rand() % SCRATCHPAD_CAPACITY)
+                                     : (SCRATCHPAD_BANKS * ((i + j) % (SCRATCHPAD_CAPACITY/SCRATCHPAD_BANKS)));
+    }
+    cli_req.Push(curr_cli_req);
+    fifo.push_back(curr_cli_req);
+  }
+  while (!fifo.empty()) wait();
+#endif
   
 
   // Wait for any transactions in the DUT to clear out
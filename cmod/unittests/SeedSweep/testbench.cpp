@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_assert.h>
+#include <testbench/nvhls_rand.h>
+#include <testbench/nvhls_seed_sweep.h>
+
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <unistd.h>
+
+#ifndef NUM_CYCLES
+#define NUM_CYCLES 50
+#endif
+
+// Draws one random value per cycle from the global generator
+SC_MODULE(testbench) {
+  sc_clock clk;
+  unsigned int draws;
+  unsigned int first;
+
+  SC_CTOR(testbench) : clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true), draws(0), first(0) {
+    SC_THREAD(run);
+    sensitive << clk.posedge_event();
+  }
+
+  void run() {
+    while (1) {
+      wait();
+      unsigned int value = nvhls::get_rand<16>().to_uint();
+      if (draws == 0) first = value;
+      draws++;
+    }
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  // Sweeps twelve seeds itself, one of which fails, unless run with a sweep
+  // of your own
+  bool self_test = (std::getenv("NVHLS_SEEDS") == NULL);
+  if (self_test) {
+    setenv("NVHLS_SEEDS", "3-14", 1);
+    setenv("NVHLS_SEED_JOBS", "4", 1);
+  }
+  nvhls::SeedSweep& sweep = nvhls::SeedSweep::Instance();
+  if (!sweep.Launch()) {
+    if (!self_test) return sweep.Status();
+    NVHLS_ASSERT_MSG(sweep.Results().size() == 12, "wrong number of seeds");
+    NVHLS_ASSERT_MSG(sweep.FailedSeeds().size() == 1 && sweep.FailedSeeds()[0] == 9,
+                     "seed 9 did not fail alone");
+    for (unsigned int i = 0; i < sweep.Results().size(); i++) {
+      const nvhls::SeedSweep::Result& result = sweep.Results()[i];
+      NVHLS_ASSERT_MSG(result.seed == 3 + i, "results not sorted by seed");
+      std::map<std::string, double> values(result.values.begin(), result.values.end());
+      // Each worker drew from a generator seeded with its own seed
+      nvhls::Rng rng(result.seed, "");
+      NVHLS_ASSERT_MSG(values["first"] == rng.get_rand<16>().to_uint(), "worker seed wrong");
+      NVHLS_ASSERT_MSG(values["draws"] >= NUM_CYCLES && values["draws"] <= NUM_CYCLES + 1,
+                       "wrong number of draws");
+      NVHLS_ASSERT_MSG(values["sim_time_ns"] > NUM_CYCLES - 0.5 &&
+                       values["sim_time_ns"] < NUM_CYCLES + 0.5,
+                       "sim time not recorded");
+    }
+    const nvhls::SeedSweep::Summary& first = sweep.Summaries().find("first")->second;
+    NVHLS_ASSERT_MSG(first.count == 12 && first.min < first.max, "seeds drew the same values");
+    NVHLS_ASSERT_MSG(sweep.Summaries().find("wall_s")->second.count == 12, "wall time missing");
+    NVHLS_ASSERT_MSG(access("sim_seeds/seed_9.log", F_OK) == 0, "failing log removed");
+    NVHLS_ASSERT_MSG(access("sim_seeds/seed_3.log", F_OK) != 0, "passing log kept");
+    NVHLS_ASSERT_MSG(sweep.Status() == 1, "failure not reported");
+    DCOUT("CMODEL PASS" << endl);
+    return 0;
+  }
+
+  unsigned int seed = nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_start(NUM_CYCLES, SC_NS);
+  sweep.Record("first", tb.first);
+  sweep.Record("draws", tb.draws);
+  return (self_test && seed == 9) ? 1 : 0;
+}
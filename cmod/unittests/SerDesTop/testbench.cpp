@@ -0,0 +1,633 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <systemc.h>
+#include <testbench/nvhls_rand.h>
+#include <nvhls_connections.h>
+#include <nvhls_serdes.h>
+
+#include <deque>
+#include <vector>
+
+// Lanes of the wide serializer; define VARIABLE_LENGTH to drop trailing
+// all-zero flits
+#ifndef WIDE_LANES
+#define WIDE_LANES 2
+#endif
+#ifdef VARIABLE_LENGTH
+static const bool kVariableLength = true;
+#else
+static const bool kVariableLength = false;
+#endif
+
+using namespace ::std;
+
+static const int kLanes = WIDE_LANES;
+static const int kNumPackets = 200;
+static const int kDebugLevel = 1;
+
+// 12-bit route, a 20-bit header payload and four 32-bit data flits
+typedef Packet<128, 3, 4, 4> Packet_t;
+typedef Flit<32, 0, 0, 4, FlitId2bit, WormHole> Flit_t;
+typedef FlitBundle<Flit_t, kLanes> Bundle_t;
+
+// Store-forward packets of four flits, interleaved by packet_id into the
+// pooled deserializer. At most kInFlight packets, and so all their flits,
+// are in flight.
+typedef Packet<64, 4, 1, 3> SFPacket_t;
+typedef Flit<16, 4, 1, 3, FlitId2bit> SFFlit_t;
+static const int kNumIds = 8;
+static const int kInFlight = 4;
+static const int kPoolSlots = 16;
+
+// The same packets over a packed link: sparse packets keep each flit's data
+// in its lower half, dense ones fill it
+typedef Flit<32, 0, 0, 4, FlitIdPacked, WormHole> PFlit_t;
+
+// The same packets through Funnel/Unfunnel, as six 24-bit beats, one or
+// kLanes per cycle
+typedef NVUINTW(24) Beat_t;
+typedef Funnel<Packet_t, Beat_t> Funnel_t;
+typedef Funnel<Packet_t, Beat_t, kLanes> KFunnel_t;
+
+SC_MODULE(testbench) {
+  sc_clock clk;
+  sc_signal<bool> rst;
+
+  serializer<Packet_t, Flit_t, WormHole, kVariableLength> ser;
+  deserializer<Packet_t, Flit_t, 0, WormHole> deser;
+  wide_serializer<Packet_t, Flit_t, kLanes, kVariableLength> wser;
+  wide_deserializer<Packet_t, Flit_t, kLanes> wdeser;
+  pooled_deserializer<SFPacket_t, SFFlit_t, kPoolSlots> pdeser;
+  serializer<Packet_t, PFlit_t, WormHole> pser;
+  flit_packer<PFlit_t, Packet_t::dest_width> packer;
+  flit_unpacker<PFlit_t> unpacker;
+  deserializer<Packet_t, PFlit_t, 0, WormHole> updeser;
+  Funnel_t fun;
+  Unfunnel<Beat_t, Packet_t> unfun;
+  KFunnel_t kfun;
+  Unfunnel<Beat_t, Packet_t, kLanes> kunfun;
+
+  Connections::Combinational<Packet_t> ser_in, wser_in;
+  Connections::Combinational<Flit_t> ser_out, deser_in;
+  Connections::Combinational<Bundle_t> wser_out, wdeser_in;
+  Connections::Combinational<Packet_t> deser_out, wdeser_out;
+
+  Connections::Out<Packet_t> to_ser, to_wser;
+  Connections::In<Flit_t> from_ser;
+  Connections::Out<Flit_t> to_deser;
+  Connections::In<Bundle_t> from_wser;
+  Connections::Out<Bundle_t> to_wdeser;
+  Connections::In<Packet_t> from_deser, from_wdeser;
+
+  Connections::Combinational<SFFlit_t> pdeser_in;
+  Connections::Combinational<SFPacket_t> pdeser_out;
+  Connections::Out<SFFlit_t> to_pdeser;
+  Connections::In<SFPacket_t> from_pdeser;
+
+  Connections::Combinational<Packet_t> pser_in, updeser_out;
+  Connections::Combinational<PFlit_t> pser_out, link_in, link_out, updeser_in;
+  Connections::Out<Packet_t> to_pser;
+  Connections::In<PFlit_t> from_packer;
+  Connections::Out<PFlit_t> to_unpacker;
+  Connections::In<Packet_t> from_updeser;
+
+  Connections::Combinational<Packet_t> fun_in, fun_out, kfun_in, kfun_out;
+  Connections::Combinational<Funnel_t::Link_t> fun_link;
+  Connections::Combinational<KFunnel_t::Link_t> kfun_link;
+  Connections::Out<Packet_t> to_fun, to_kfun;
+  Connections::In<Packet_t> from_unfun, from_kunfun;
+
+  vector<Packet_t> packets;
+  deque<Packet_t> expected, wide_expected;
+  vector<Flit_t> flits, wide_flits;
+  unsigned received, wide_received;
+  unsigned narrow_cycles, wide_cycles;
+  SFPacket_t in_flight[kNumIds];
+  bool id_busy[kNumIds];
+  unsigned pooled_received;
+  vector<Packet_t> link_packets;
+  deque<Packet_t> link_expected;
+  unsigned link_flits, packed_flits, link_received;
+  deque<Packet_t> fun_expected, kfun_expected;
+  unsigned fun_received, kfun_received;
+  unsigned fun_cycles, kfun_cycles;
+
+  SC_CTOR(testbench)
+      : clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        rst("rst"),
+        ser("ser"),
+        deser("deser"),
+        wser("wser"),
+        wdeser("wdeser"),
+        pdeser("pdeser"),
+        pser("pser"),
+        packer("packer"),
+        unpacker("unpacker"),
+        updeser("updeser"),
+        fun("fun"),
+        unfun("unfun"),
+        kfun("kfun"),
+        kunfun("kunfun"),
+        received(0),
+        wide_received(0),
+        narrow_cycles(0),
+        wide_cycles(0),
+        pooled_received(0),
+        link_flits(0),
+        packed_flits(0),
+        link_received(0),
+        fun_received(0),
+        kfun_received(0),
+        fun_cycles(0),
+        kfun_cycles(0) {
+    Connections::set_sim_clk(&clk);
+
+    ser.clk(clk);
+    ser.rst(rst);
+    deser.clk(clk);
+    deser.rst(rst);
+    wser.clk(clk);
+    wser.rst(rst);
+    wdeser.clk(clk);
+    wdeser.rst(rst);
+
+    to_ser(ser_in);
+    ser.in_packet(ser_in);
+    ser.out_flit(ser_out);
+    from_ser(ser_out);
+    to_deser(deser_in);
+    deser.in_flit(deser_in);
+    deser.out_packet(deser_out);
+    from_deser(deser_out);
+
+    to_wser(wser_in);
+    wser.in_packet(wser_in);
+    wser.out_flits(wser_out);
+    from_wser(wser_out);
+    to_wdeser(wdeser_in);
+    wdeser.in_flits(wdeser_in);
+    wdeser.out_packet(wdeser_out);
+    from_wdeser(wdeser_out);
+
+    pdeser.clk(clk);
+    pdeser.rst(rst);
+    to_pdeser(pdeser_in);
+    pdeser.in_flit(pdeser_in);
+    pdeser.out_packet(pdeser_out);
+    from_pdeser(pdeser_out);
+    for (int i = 0; i < kNumIds; i++) {
+      id_busy[i] = false;
+    }
+
+    pser.clk(clk);
+    pser.rst(rst);
+    packer.clk(clk);
+    packer.rst(rst);
+    unpacker.clk(clk);
+    unpacker.rst(rst);
+    updeser.clk(clk);
+    updeser.rst(rst);
+    to_pser(pser_in);
+    pser.in_packet(pser_in);
+    pser.out_flit(pser_out);
+    packer.in_flit(pser_out);
+    packer.out_flit(link_in);
+    from_packer(link_in);
+    to_unpacker(link_out);
+    unpacker.in_flit(link_out);
+    unpacker.out_flit(updeser_in);
+    updeser.in_flit(updeser_in);
+    updeser.out_packet(updeser_out);
+    from_updeser(updeser_out);
+
+    fun.clk(clk);
+    fun.rst(rst);
+    unfun.clk(clk);
+    unfun.rst(rst);
+    kfun.clk(clk);
+    kfun.rst(rst);
+    kunfun.clk(clk);
+    kunfun.rst(rst);
+    to_fun(fun_in);
+    fun.in(fun_in);
+    fun.out(fun_link);
+    unfun.in(fun_link);
+    unfun.out(fun_out);
+    from_unfun(fun_out);
+    to_kfun(kfun_in);
+    kfun.in(kfun_in);
+    kfun.out(kfun_link);
+    kunfun.in(kfun_link);
+    kunfun.out(kfun_out);
+    from_kunfun(kfun_out);
+
+    generate();
+    SC_THREAD(source);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(wide_source);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(tap);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(wide_tap);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(sink);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(wide_sink);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(interleaved_source);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(pooled_sink);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(link_source);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(link);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(link_sink);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(funnel_source);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(funnel_sink);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(run);
+  }
+
+  // Packets of every length: the payload ends in the header flit or in
+  // one of the data flits
+  void generate() {
+    for (int n = 0; n < kNumPackets; n++) {
+      Packet_t packet;
+      packet.dest = rand() % 4096;
+      packet.packet_id = n % 16;
+      int words = rand() % 5;
+      packet.data = 0;
+      packet.data = nvhls::set_slc(packet.data, NVUINTC(16)(rand()), 0);
+      for (int w = 0; w < words; w++) {
+        packet.data = nvhls::set_slc(packet.data, NVUINTC(32)(rand() | 1), 20 + w * 24);
+      }
+      packets.push_back(packet);
+      expected.push_back(packet);
+      wide_expected.push_back(packet);
+
+      Packet_t link_packet = packet;
+      if (n % 2 == 0) {
+        // 4 bits in the header flit's lower half, 16 in each data flit's
+        link_packet.data = rand() % 16;
+        for (int f = 0; f < 4; f++) {
+          link_packet.data = nvhls::set_slc(link_packet.data, NVUINTC(12)(rand()), 20 + f * 32);
+        }
+      } else {
+        for (int w = 0; w < 4; w++) {
+          link_packet.data = nvhls::set_slc(link_packet.data, NVUINTC(32)(rand()), w * 32);
+        }
+      }
+      link_packets.push_back(link_packet);
+      link_expected.push_back(link_packet);
+      fun_expected.push_back(link_packet);
+      kfun_expected.push_back(link_packet);
+    }
+  }
+
+  // Both serializers get the same packets, each as fast as it takes them
+  void source() {
+    to_ser.Reset();
+    wait();
+    for (unsigned n = 0; n < packets.size(); n++) {
+      to_ser.Push(packets[n]);
+    }
+    while (1) {
+      wait();
+    }
+  }
+
+  void wide_source() {
+    to_wser.Reset();
+    wait();
+    for (unsigned n = 0; n < packets.size(); n++) {
+      to_wser.Push(packets[n]);
+    }
+    while (1) {
+      wait();
+    }
+  }
+
+  void tap() {
+    from_ser.Reset();
+    to_deser.Reset();
+    while (1) {
+      wait();
+      Flit_t flit;
+      if (from_ser.PopNB(flit)) {
+        flits.push_back(flit);
+        to_deser.Push(flit);
+      }
+    }
+  }
+
+  void wide_tap() {
+    from_wser.Reset();
+    to_wdeser.Reset();
+    while (1) {
+      wait();
+      Bundle_t bundle;
+      if (from_wser.PopNB(bundle)) {
+        NVHLS_ASSERT_MSG(bundle.count > 0 && bundle.count <= kLanes,
+                         "Bad flit count in bundle");
+        for (unsigned k = 0; k < bundle.count; k++) {
+          bool tail = bundle.flit[k].flit_id.isTail();
+          NVHLS_ASSERT_MSG(!tail || k == bundle.count - 1,
+                           "Bundle holds flits of two packets");
+          NVHLS_ASSERT_MSG(tail || bundle.count == kLanes,
+                           "Only the last bundle of a packet may be short");
+          wide_flits.push_back(bundle.flit[k]);
+        }
+        to_wdeser.Push(bundle);
+      }
+    }
+  }
+
+  void check(const Packet_t& packet, deque<Packet_t>& ref, const char* which) {
+    CDCOUT(sc_time_stamp() << " " << which << " received " << hex
+           << packet.data << dec << endl, kDebugLevel);
+    NVHLS_ASSERT_MSG(!ref.empty(), "Unexpected packet");
+    NVHLS_ASSERT_MSG(ref.front().data == packet.data, "Data mismatch");
+    NVHLS_ASSERT_MSG(ref.front().dest == packet.dest, "Dest mismatch");
+    NVHLS_ASSERT_MSG(ref.front().packet_id == packet.packet_id,
+                     "packet_id mismatch");
+    ref.pop_front();
+  }
+
+  void sink() {
+    from_deser.Reset();
+    while (1) {
+      wait();
+      Packet_t packet;
+      if (from_deser.PopNB(packet)) {
+        check(packet, expected, "deserializer");
+        if (++received == kNumPackets) {
+          narrow_cycles = sc_time_stamp() / clk.period();
+        }
+      }
+    }
+  }
+
+  void wide_sink() {
+    from_wdeser.Reset();
+    while (1) {
+      wait();
+      Packet_t packet;
+      if (from_wdeser.PopNB(packet)) {
+        check(packet, wide_expected, "wide_deserializer");
+        if (++wide_received == kNumPackets) {
+          wide_cycles = sc_time_stamp() / clk.period();
+        }
+      }
+    }
+  }
+
+  // Each cycle maybe start a packet on a free id, then send the next flit
+  // of a random packet in progress
+  void interleaved_source() {
+    to_pdeser.Reset();
+    int pos[kNumIds];
+    for (int i = 0; i < kNumIds; i++) {
+      pos[i] = -1;
+    }
+    int started = 0;
+    wait();
+    while (1) {
+      vector<int> free_ids, sending;
+      int busy = 0;
+      for (int i = 0; i < kNumIds; i++) {
+        if (id_busy[i]) {
+          busy++;
+        } else {
+          free_ids.push_back(i);
+        }
+      }
+      if (started < kNumPackets && busy < kInFlight && rand() % 2 == 0) {
+        int id = free_ids[rand() % free_ids.size()];
+        in_flight[id].dest = rand() % 16;
+        in_flight[id].packet_id = id;
+        in_flight[id].data = (NVUINTC(64)(rand()) << 32) | NVUINTC(64)(rand());
+        id_busy[id] = true;
+        pos[id] = 0;
+        started++;
+      }
+      for (int i = 0; i < kNumIds; i++) {
+        if (pos[i] >= 0) {
+          sending.push_back(i);
+        }
+      }
+      if (!sending.empty()) {
+        int id = sending[rand() % sending.size()];
+        SFFlit_t flit;
+        flit.dest = in_flight[id].dest;
+        flit.packet_id = id;
+        flit.data = nvhls::get_slc<16>(in_flight[id].data, pos[id] * 16);
+        if (pos[id] == 0) {
+          flit.flit_id.set(FlitId2bit::HEAD);
+        } else if (pos[id] == 3) {
+          flit.flit_id.set(FlitId2bit::TAIL);
+        } else {
+          flit.flit_id.set(FlitId2bit::BODY);
+        }
+        to_pdeser.Push(flit);
+        pos[id] = (pos[id] == 3) ? -1 : pos[id] + 1;
+      }
+      wait();
+    }
+  }
+
+  void pooled_sink() {
+    from_pdeser.Reset();
+    while (1) {
+      wait();
+      SFPacket_t packet;
+      if ((rand() % 4 != 0) && from_pdeser.PopNB(packet)) {
+        int id = packet.packet_id.to_uint();
+        CDCOUT(sc_time_stamp() << " pooled_deserializer received id " << id
+               << " " << hex << packet.data << dec << endl, kDebugLevel);
+        NVHLS_ASSERT_MSG(id_busy[id], "Packet on an idle packet_id");
+        NVHLS_ASSERT_MSG(packet.data == in_flight[id].data, "Data mismatch");
+        NVHLS_ASSERT_MSG(packet.dest == in_flight[id].dest, "Dest mismatch");
+        id_busy[id] = false;
+        pooled_received++;
+      }
+    }
+  }
+
+  void link_source() {
+    to_pser.Reset();
+    wait();
+    for (unsigned n = 0; n < link_packets.size(); n++) {
+      to_pser.Push(link_packets[n]);
+    }
+    while (1) {
+      wait();
+    }
+  }
+
+  // The link between flit_packer and flit_unpacker, stalling now and then
+  void link() {
+    from_packer.Reset();
+    to_unpacker.Reset();
+    while (1) {
+      wait();
+      PFlit_t flit;
+      if ((rand() % 4 != 0) && from_packer.PopNB(flit)) {
+        link_flits++;
+        if (flit.flit_id.isPacked()) {
+          packed_flits++;
+        }
+        to_unpacker.Push(flit);
+      }
+    }
+  }
+
+  void link_sink() {
+    from_updeser.Reset();
+    while (1) {
+      wait();
+      Packet_t packet;
+      if (from_updeser.PopNB(packet)) {
+        NVHLS_ASSERT_MSG(!link_expected.empty(), "Unexpected packet");
+        NVHLS_ASSERT_MSG(link_expected.front().data == packet.data &&
+                         link_expected.front().dest == packet.dest &&
+                         link_expected.front().packet_id == packet.packet_id,
+                         "Packet mismatch after the packed link");
+        link_expected.pop_front();
+        link_received++;
+      }
+    }
+  }
+
+  // Dense and sparse packets back to back into both funnels
+  void funnel_source() {
+    to_fun.Reset();
+    to_kfun.Reset();
+    wait();
+    unsigned n = 0, k = 0;
+    while (1) {
+      if (n < link_packets.size() && to_fun.PushNB(link_packets[n])) n++;
+      if (k < link_packets.size() && to_kfun.PushNB(link_packets[k])) k++;
+      wait();
+    }
+  }
+
+  void funnel_sink() {
+    from_unfun.Reset();
+    from_kunfun.Reset();
+    while (1) {
+      wait();
+      Packet_t packet;
+      if (from_unfun.PopNB(packet)) {
+        check(packet, fun_expected, "Unfunnel");
+        if (++fun_received == kNumPackets) {
+          fun_cycles = sc_time_stamp() / clk.period();
+        }
+      }
+      if (from_kunfun.PopNB(packet)) {
+        check(packet, kfun_expected, "K-beat Unfunnel");
+        if (++kfun_received == kNumPackets) {
+          kfun_cycles = sc_time_stamp() / clk.period();
+        }
+      }
+    }
+  }
+
+  void run() {
+    rst = 0;
+    cout << "@" << sc_time_stamp() << " Asserting Reset " << endl;
+    wait(2, SC_NS);
+    cout << "@" << sc_time_stamp() << " Deasserting Reset " << endl;
+    rst = 1;
+    wait(10000, SC_NS);
+    cout << "@" << sc_time_stamp() << " Stop " << endl;
+    cout << "serializer: " << flits.size() << " flits, done at cycle "
+         << narrow_cycles << endl;
+    cout << "wide_serializer (" << kLanes << " lanes): " << wide_flits.size()
+         << " flits, done at cycle " << wide_cycles << endl;
+    NVHLS_ASSERT_MSG(received == kNumPackets && wide_received == kNumPackets,
+                     "Not all packets were delivered");
+    NVHLS_ASSERT_MSG(pooled_received == kNumPackets,
+                     "Not all interleaved packets were delivered");
+    cout << "packed link: " << link_flits << " flits for " << kNumPackets * 5
+         << ", " << packed_flits << " packed" << endl;
+    NVHLS_ASSERT_MSG(link_received == kNumPackets,
+                     "Not all packets crossed the packed link");
+    // each packed flit saves one; sparse packets can save two of five
+    NVHLS_ASSERT_MSG(packed_flits > 0, "Sparse flits were not packed");
+    NVHLS_ASSERT_MSG(link_flits == kNumPackets * 5 - packed_flits,
+                     "Packed flits should each replace two flits");
+    cout << "funnel: " << Funnel_t::num_transfers << " beats, done at cycle " << fun_cycles
+         << ", " << kLanes << " beats per cycle: " << KFunnel_t::num_transfers
+         << " transfers, done at cycle " << kfun_cycles << endl;
+    NVHLS_ASSERT_MSG(fun_received == kNumPackets && kfun_received == kNumPackets,
+                     "Not all packets crossed the funnels");
+    // One transfer per cycle, apart from reset and pipeline fill
+    NVHLS_ASSERT_MSG(fun_cycles <= kNumPackets * Funnel_t::num_transfers + 10,
+                     "Funnel does not sustain one beat per cycle");
+    NVHLS_ASSERT_MSG(kfun_cycles <= kNumPackets * KFunnel_t::num_transfers + 10,
+                     "K-beat Funnel does not sustain one transfer per cycle");
+    // same flits, in the same order
+    NVHLS_ASSERT_MSG(flits.size() == wide_flits.size(), "Flit count mismatch");
+    for (unsigned i = 0; i < flits.size(); i++) {
+      NVHLS_ASSERT_MSG(flits[i].data == wide_flits[i].data &&
+                       flits[i].packet_id == wide_flits[i].packet_id &&
+                       flits[i].flit_id == wide_flits[i].flit_id,
+                       "wide_serializer flit differs from serializer");
+    }
+    if (!kVariableLength) {
+      NVHLS_ASSERT_MSG(flits.size() == kNumPackets * 5,
+                       "Fixed-length packets take five flits");
+    } else {
+      NVHLS_ASSERT_MSG(flits.size() < kNumPackets * 5,
+                       "Short packets should take fewer flits");
+    }
+    if (kLanes > 1) {
+      NVHLS_ASSERT_MSG(wide_cycles < narrow_cycles,
+                       "wide_serializer should finish first");
+    }
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char* argv[]) {
+  nvhls::set_random_seed();
+  testbench my_testbench("my_testbench");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    cout << "Simulation FAILED\n";
+  else
+    cout << "Simulation PASSED\n";
+  return rc;
+};
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SORT_NETWORK_TOP_H
+#define SORT_NETWORK_TOP_H
+
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <hls_globals.h>
+#include <comptrees.h>
+
+#ifndef NUM_ELEMS
+#define NUM_ELEMS 6
+#endif
+
+// Select the TOP_K smallest instead of sorting all elements
+#ifndef TOP_K
+#define TOP_K 0
+#endif
+
+#ifndef SORT_ALGORITHM
+#define SORT_ALGORITHM SortBitonic
+#endif
+
+#ifndef STAGES_PER_REG
+#define STAGES_PER_REG 2
+#endif
+
+typedef NVUINTC(8) Key;
+typedef NVUINTC(nvhls::index_width<NUM_ELEMS>::val) Idx;
+
+typedef SortNetwork<Key, Idx, NUM_ELEMS, false, SORT_ALGORITHM> Sorter;
+typedef TopK<Key, Idx, NUM_ELEMS, (TOP_K == 0 ? 1 : TOP_K)> Selector;
+
+#if TOP_K == 0
+typedef Sorter Network;
+#else
+typedef Selector Network;
+#endif
+
+typedef SortNetworkPipelined<Network, STAGES_PER_REG> PipelinedNetwork;
+
+void SortNetworkTop(const Key in[NUM_ELEMS], bool in_valid,
+                    Key out[Network::NumOutputs],
+                    Idx out_idx[Network::NumOutputs], bool& out_valid);
+
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include <match_scverify.h>
+#include <testbench/nvhls_rand.h>
+
+#include "SortNetworkTop.h"
+
+#ifndef NUM_ITERS
+#define NUM_ITERS 1000
+#endif
+
+static const unsigned NumOut = Network::NumOutputs;
+
+struct Result {
+  Key keys[NUM_ELEMS];
+  unsigned idx[NUM_ELEMS];
+  bool valid;
+};
+
+// Stable sort of the input indices by key
+Result reference_sort(const Key in[NUM_ELEMS], bool valid) {
+  std::vector<std::pair<unsigned, unsigned> > keyed;
+  for (unsigned i = 0; i < NUM_ELEMS; i++) {
+    keyed.push_back(std::make_pair(in[i].to_uint(), i));
+  }
+  std::sort(keyed.begin(), keyed.end());
+  Result res;
+  for (unsigned i = 0; i < NUM_ELEMS; i++) {
+    res.keys[i] = in[i];
+    res.idx[i] = keyed[i].second;
+  }
+  res.valid = valid;
+  return res;
+}
+
+void check(const Result& ref, const Key out[], const Idx out_idx[],
+           unsigned count) {
+  for (unsigned i = 0; i < count; i++) {
+    assert(out_idx[i] == ref.idx[i]);
+    assert(out[i] == ref.keys[ref.idx[i]]);
+  }
+}
+
+CCS_MAIN(int argc, char *argv[])
+{
+  nvhls::set_random_seed();
+  DCOUT("Network: " << NUM_ELEMS << " inputs, " << NumOut << " outputs, "
+        << Network::NumStages << " stages, latency "
+        << PipelinedNetwork::Latency << endl);
+
+  std::deque<Result> expected;
+  for (unsigned i = 0; i < PipelinedNetwork::Latency; i++) {
+    Result none;
+    none.valid = false;
+    expected.push_back(none);
+  }
+
+  for (int iter = 0; iter < NUM_ITERS; ++iter)
+  {
+    Key in[NUM_ELEMS];
+    // Narrow ranges every other iteration to exercise ties
+    unsigned range = (rand() & 0x1) ? 256 : 3;
+    for (unsigned i = 0; i < NUM_ELEMS; i++) {
+      in[i] = rand() % range;
+    }
+    bool in_valid = rand() & 0x1;
+    Result ref = reference_sort(in, in_valid);
+    expected.push_back(ref);
+
+    // Combinational networks and the scalar simulation paths
+    Key sorted[NUM_ELEMS];
+    Idx sorted_idx[NUM_ELEMS];
+    SortNetwork<Key, Idx, NUM_ELEMS, false, SortBitonic>::sort_network(in, sorted, sorted_idx);
+    check(ref, sorted, sorted_idx, NUM_ELEMS);
+    SortNetwork<Key, Idx, NUM_ELEMS, false, SortOddEvenMerge>::sort_network(in, sorted, sorted_idx);
+    check(ref, sorted, sorted_idx, NUM_ELEMS);
+    Sorter::sort(in, sorted, sorted_idx);
+    check(ref, sorted, sorted_idx, NUM_ELEMS);
+    Selector::select_network(in, sorted, sorted_idx);
+    check(ref, sorted, sorted_idx, Selector::NumOutputs);
+    Selector::select(in, sorted, sorted_idx);
+    check(ref, sorted, sorted_idx, Selector::NumOutputs);
+
+    // Largest first: the reverse of the ascending order, up to ties
+    SortNetwork<Key, Idx, NUM_ELEMS, true>::sort_network(in, sorted, sorted_idx);
+    for (unsigned i = 0; i < NUM_ELEMS; i++) {
+      assert(sorted[i] == in[ref.idx[NUM_ELEMS - 1 - i]]);
+    }
+
+    Key out[NumOut];
+    Idx out_idx[NumOut];
+    bool out_valid;
+    CCS_DESIGN(SortNetworkTop)(in, in_valid, out, out_idx, out_valid);
+
+    Result exp = expected.front();
+    expected.pop_front();
+    assert(out_valid == exp.valid);
+    if (exp.valid) {
+      check(exp, out, out_idx, NumOut);
+    }
+  }
+
+  DCOUT("CMODEL PASS" << endl);
+  CCS_RETURN(0) ;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __STREAMCODECTOP_H__
+#define __STREAMCODECTOP_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <StreamCodec.h>
+
+// Default: zero-value compression. sim_test2 uses zero run-length coding and
+// sim_test3 base-delta coding.
+#define CODEC_ZERO_VALUE 0
+#define CODEC_RUN_LENGTH 1
+#define CODEC_BASE_DELTA 2
+#ifndef STREAM_CODEC
+#define STREAM_CODEC CODEC_ZERO_VALUE
+#endif
+
+SC_MODULE(StreamCodecTop) {
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  enum { kWordWidth = 32, kBeatWidth = 64, kBlockWords = 64 };
+#if STREAM_CODEC == CODEC_RUN_LENGTH
+  typedef RunLengthCodec<kWordWidth, 4> Codec_t;
+#elif STREAM_CODEC == CODEC_BASE_DELTA
+  typedef BaseDeltaCodec<kWordWidth, 8> Codec_t;
+#else
+  typedef ZeroValueCodec<kWordWidth> Codec_t;
+#endif
+  typedef Codec_t::Word Word_t;
+  typedef CodecBeat<kBeatWidth> Beat_t;
+
+  StreamEncoder<Codec_t, kBeatWidth, kBlockWords> encoder;
+  StreamDecoder<Codec_t, kBeatWidth, kBlockWords> decoder;
+
+  Connections::In<Word_t> words_in;
+  Connections::Out<Beat_t> beats_out;
+  Connections::In<Beat_t> beats_in;
+  Connections::Out<Word_t> words_out;
+
+  SC_HAS_PROCESS(StreamCodecTop);
+  StreamCodecTop(sc_module_name name)
+      : sc_module(name), clk("clk"), rst("rst"), encoder("encoder"), decoder("decoder") {
+    encoder.clk(clk);
+    encoder.rst(rst);
+    encoder.in(words_in);
+    encoder.out(beats_out);
+    decoder.clk(clk);
+    decoder.rst(rst);
+    decoder.in(beats_in);
+    decoder.out(words_out);
+  }
+};
+
+#endif
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "StreamCodecTop.h"
+#include <systemc.h>
+#include <mc_scverify.h>
+#include <testbench/nvhls_rand.h>
+#include <nvhls_connections.h>
+
+#define NVHLS_VERIFY_BLOCKS (StreamCodecTop)
+#include <nvhls_verify.h>
+
+#include <vector>
+
+using namespace ::std;
+typedef StreamCodecTop::Word_t Word_t;
+typedef StreamCodecTop::Beat_t Beat_t;
+static const int kBlockWords = StreamCodecTop::kBlockWords;
+static const int kWordWidth = StreamCodecTop::kWordWidth;
+static const int kBeatWidth = StreamCodecTop::kBeatWidth;
+static const int kNumBlocks = 60;
+
+static const int kDebugLevel = 1;
+
+// Kinds of blocks: zero runs between a few nonzero words, small deltas
+// around a random base, and random words
+enum { kSparse, kSmooth, kRandom, kNumKinds };
+
+// The blocks sent, and the compressed beats of each kind of block
+class Reference {
+ public:
+  Reference() : blocks_received(0) {
+    for (int b = 0; b < kNumBlocks; b++) {
+      int kind = b % kNumKinds;
+      kinds.push_back(kind);
+      Word_t base = rand();
+      int zeros = rand() % 16;
+      for (int i = 0; i < kBlockWords; i++) {
+        Word_t word;
+        if (kind == kSparse) {
+          if (zeros > 0) {
+            word = 0;
+            zeros--;
+          } else {
+            word = rand();
+            zeros = rand() % 16;
+          }
+        } else if (kind == kSmooth) {
+          word = base + Word_t(rand() % 201 - 100);
+        } else {
+          word = rand();
+        }
+        words.push_back(word);
+      }
+    }
+    for (int k = 0; k < kNumKinds; k++) {
+      beats[k] = 0;
+    }
+  }
+
+  // Compressed over uncompressed size of a kind of block
+  double ratio(int kind) const {
+    int blocks = 0;
+    for (int b = 0; b < kNumBlocks; b++) {
+      blocks += (kinds[b] == kind);
+    }
+    return double(beats[kind] * kBeatWidth) / (blocks * kBlockWords * kWordWidth);
+  }
+
+  vector<int> kinds;
+  vector<Word_t> words;
+  int beats[kNumKinds];
+  int blocks_received;
+};
+
+SC_MODULE(Source) {
+  Connections::Out<Word_t> out;
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+  Reference& ref;
+
+  // One word per cycle
+  void run() {
+    out.Reset();
+    wait();
+    for (unsigned i = 0; i < ref.words.size(); i++) {
+      out.Push(ref.words[i]);
+    }
+    while (1) {
+      wait();
+    }
+  }
+
+  SC_HAS_PROCESS(Source);
+  Source(sc_module_name name_, Reference& ref_)
+      : sc_module(name_), out("out"), clk("clk"), rst("rst"), ref(ref_) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+// Counts the beats of each block on their way from the encoder to the decoder
+SC_MODULE(Link) {
+  Connections::In<Beat_t> in;
+  Connections::Out<Beat_t> out;
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+  Reference& ref;
+
+  void run() {
+    in.Reset();
+    out.Reset();
+    int block = 0;
+    int beats = 0;
+    wait();
+    while (1) {
+      Beat_t beat = in.Pop();
+      beats++;
+      if (beat.last) {
+        NVHLS_ASSERT_MSG(block < kNumBlocks, "Too many blocks");
+        CDCOUT(sc_time_stamp() << " block " << block << " kind " << ref.kinds[block]
+               << ": " << beats << " beats" << endl, kDebugLevel);
+        ref.beats[ref.kinds[block]] += beats;
+        block++;
+        beats = 0;
+      }
+      out.Push(beat);
+    }
+  }
+
+  SC_HAS_PROCESS(Link);
+  Link(sc_module_name name_, Reference& ref_)
+      : sc_module(name_), in("in"), out("out"), clk("clk"), rst("rst"), ref(ref_) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+SC_MODULE(Sink) {
+  Connections::In<Word_t> in;
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+  Reference& ref;
+  int first_cycle;
+  int last_cycle;
+
+  void run() {
+    in.Reset();
+    first_cycle = last_cycle = -1;
+    int cycle = 0;
+    unsigned n = 0;
+    while (1) {
+      wait();
+      cycle++;
+      Word_t word;
+      if (in.PopNB(word)) {
+        NVHLS_ASSERT_MSG(n < ref.words.size(), "Too many words");
+        NVHLS_ASSERT_MSG(word == ref.words[n], "Word mismatch");
+        if (n == 0) first_cycle = cycle;
+        last_cycle = cycle;
+        n++;
+        if (n % kBlockWords == 0) ref.blocks_received++;
+      }
+    }
+  }
+
+  SC_HAS_PROCESS(Sink);
+  Sink(sc_module_name name_, Reference& ref_)
+      : sc_module(name_), in("in"), clk("clk"), rst("rst"), ref(ref_) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+SC_MODULE(testbench) {
+  NVHLS_DESIGN(StreamCodecTop) dut;
+
+  sc_clock clk;
+  sc_signal<bool> rst;
+  Reference ref;
+  Source source;
+  Link link;
+  Sink sink;
+  Connections::Combinational<Word_t> words_in;
+  Connections::Combinational<Beat_t> beats_out;
+  Connections::Combinational<Beat_t> beats_in;
+  Connections::Combinational<Word_t> words_out;
+
+  SC_CTOR(testbench)
+      : dut("dut"),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        rst("rst"),
+        source("source", ref),
+        link("link", ref),
+        sink("sink", ref) {
+    Connections::set_sim_clk(&clk);
+
+    dut.clk(clk);
+    dut.rst(rst);
+    source.clk(clk);
+    source.rst(rst);
+    link.clk(clk);
+    link.rst(rst);
+    sink.clk(clk);
+    sink.rst(rst);
+
+    source.out(words_in);
+    dut.words_in(words_in);
+    dut.beats_out(beats_out);
+    link.in(beats_out);
+    link.out(beats_in);
+    dut.beats_in(beats_in);
+    dut.words_out(words_out);
+    sink.in(words_out);
+
+    SC_THREAD(run);
+  }
+
+  void run() {
+    rst = 0;
+    cout << "@" << sc_time_stamp() << " Asserting Reset " << endl;
+    wait(2, SC_NS);
+    cout << "@" << sc_time_stamp() << " Deasserting Reset " << endl;
+    rst = 1;
+    wait(kNumBlocks * kBlockWords * 2, SC_NS);
+    cout << "@" << sc_time_stamp() << " Stop " << endl;
+    int cycles = sink.last_cycle - sink.first_cycle + 1;
+    cout << "compressed/uncompressed: sparse " << ref.ratio(kSparse) << ", smooth "
+         << ref.ratio(kSmooth) << ", random " << ref.ratio(kRandom) << endl;
+    cout << kNumBlocks * kBlockWords << " words in " << cycles << " cycles" << endl;
+    NVHLS_ASSERT_MSG(ref.blocks_received == kNumBlocks, "Not all blocks received");
+    // One word per cycle, and a cycle to flush the last beat of a block
+    NVHLS_ASSERT_MSG(cycles <= kNumBlocks * (kBlockWords + 2), "Codec too slow");
+#if STREAM_CODEC == CODEC_BASE_DELTA
+    NVHLS_ASSERT_MSG(ref.ratio(kSmooth) < 0.5, "Small deltas not compressed");
+#else
+    NVHLS_ASSERT_MSG(ref.ratio(kSparse) < 0.5, "Zero runs not compressed");
+#endif
+    // A flag bit per word at most, or a run length per nonzero word
+    NVHLS_ASSERT_MSG(ref.ratio(kRandom) < 1.0 + 4.0 / kWordWidth + 0.05,
+                     "Random words expanded too much");
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char* argv[]) {
+  nvhls::set_random_seed();
+  testbench my_testbench("my_testbench");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    cout << "Simulation FAILED\n";
+  else
+    cout << "Simulation PASSED\n";
+  return rc;
+};
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_int.h>
+#include <nvhls_types.h>
+#include <nvhls_assert.h>
+#include <hls_globals.h>
+#include <nvhls_sampling.h>
+#include <SystolicArray.h>
+#include <cstdlib>
+#include <deque>
+
+#ifndef SA_ROWS
+#define SA_ROWS 8
+#endif
+#ifndef SA_COLS
+#define SA_COLS 4
+#endif
+
+static const int kRows = SA_ROWS;
+static const int kCols = SA_COLS;
+static const int kCycles = 20000;
+
+typedef SystolicArray<kRows, kCols, NVINT8, NVINT32> Array;
+
+struct Expected {
+  int cycle;
+  int out[kCols];
+};
+
+// Reference of both weight copies, and the copy new inputs use
+int weights[2][kRows][kCols];
+int active = 0;
+
+// Loads copy b of the reference, one row per cycle as in hardware
+void LoadWeights(Array& array, int b) {
+  for (int m = 0; m < kRows; m++) {
+    Array::WeightRow row;
+    for (int n = 0; n < kCols; n++) {
+      weights[b][m][n] = rand() % 256 - 128;
+      row[n] = weights[b][m][n];
+    }
+    array.load_weights(m, row);
+  }
+}
+
+// Streams inputs with bubbles and swaps the weights while inputs are in
+// flight. In detailed mode every output leaves Latency cycles after its
+// input; in functional mode in the same call.
+void TestStream(Array& array, bool functional) {
+  std::deque<Expected> expected;
+  bool load = false;
+  bool swap = false;
+  int swaps = 0;
+
+  for (int cycle = 0; cycle < kCycles + Array::Latency; cycle++) {
+    if (load && array.can_load()) {
+      LoadWeights(array, 1 - active);
+      load = false;
+      swap = true;
+    }
+    if (swap && rand() % 4 == 0) {
+      array.swap_weights();
+      active = 1 - active;
+      swap = false;
+      swaps++;
+    }
+    if (!load && !swap && rand() % 40 == 0) {
+      load = true;
+    }
+
+    bool in_valid = (cycle < kCycles) && (rand() % 4 != 0);
+    Array::InVec in;
+    Expected e;
+    e.cycle = cycle;
+    for (int m = 0; m < kRows; m++) {
+      in[m] = rand() % 256 - 128;
+    }
+    for (int n = 0; n < kCols; n++) {
+      e.out[n] = 0;
+      for (int m = 0; m < kRows; m++) {
+        e.out[n] += in[m].to_int() * weights[active][m][n];
+      }
+    }
+    if (in_valid) {
+      expected.push_back(e);
+    }
+
+    Array::OutVec out;
+    if (array.run(in_valid, in, out)) {
+      NVHLS_ASSERT_MSG(!expected.empty(), "Output without an input");
+      Expected ref = expected.front();
+      expected.pop_front();
+      int latency = functional ? 0 : Array::Latency;
+      NVHLS_ASSERT_MSG(cycle - ref.cycle == latency, "Wrong latency");
+      for (int n = 0; n < kCols; n++) {
+        NVHLS_ASSERT_MSG(out[n] == ref.out[n], "Wrong output");
+      }
+    }
+  }
+  NVHLS_ASSERT_MSG(expected.empty(), "Not all inputs came out");
+  NVHLS_ASSERT_MSG(array.is_empty(), "Array not empty after the drain");
+  NVHLS_ASSERT_MSG(swaps > 0, "Weights were never swapped");
+}
+
+int sc_main(int argc, char *argv[]) {
+  srand(1);
+  Array array;
+  LoadWeights(array, 1);
+  array.swap_weights();
+  active = 1;
+  TestStream(array, false);
+  nvhls::Sampling::Instance().SetMode(nvhls::Sampling::FUNCTIONAL);
+  TestStream(array, true);
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
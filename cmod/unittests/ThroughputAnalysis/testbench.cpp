@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_module.h>
+#include <nvhls_throughput.h>
+#include <cmath>
+#include <fstream>
+#include <string>
+
+typedef NVUINTW(8) Word_t;
+
+// Pushes one message, then pops one, with a declared II
+class Relay : public match::Module {
+ public:
+  Connections::In<Word_t> in;
+  Connections::Out<Word_t> out;
+  match::ThreadStats run_stats;
+
+  SC_HAS_PROCESS(Relay);
+  Relay(sc_module_name nm, unsigned int ii)
+      : match::Module(nm), in("in"), out("out"), run_stats(ii) {
+    RegisterThreadStats("run", run_stats);
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void run() {
+    in.Reset();
+    out.Reset();
+    wait();
+    while (1) {
+      out.Push(in.Pop());
+    }
+  }
+};
+
+SC_MODULE(Source) {
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::Out<Word_t> out;
+
+  SC_CTOR(Source) : clk("clk"), rst("rst"), out("out") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void run() {
+    out.Reset();
+    wait();
+    Word_t i = 0;
+    while (1) {
+      out.Push(i++);
+    }
+  }
+};
+
+SC_MODULE(Sink) {
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::In<Word_t> in;
+
+  SC_CTOR(Sink) : clk("clk"), rst("rst"), in("in") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void run() {
+    in.Reset();
+    wait();
+    while (1) {
+      in.Pop();
+    }
+  }
+};
+
+// Waits for the response to each request
+SC_MODULE(Requester) {
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::Out<Word_t> out;
+  Connections::In<Word_t> in;
+
+  SC_CTOR(Requester) : clk("clk"), rst("rst"), out("out"), in("in") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void run() {
+    out.Reset();
+    in.Reset();
+    wait();
+    Word_t i = 0;
+    while (1) {
+      out.Push(i++);
+      in.Pop();
+    }
+  }
+};
+
+SC_MODULE(testbench) {
+  sc_clock clk;
+  sc_signal<bool> rst;
+
+  // src -> stage (II 2) -> sink, and a request/response loop
+  Source src;
+  Relay stage;
+  Sink sink;
+  Requester ping;
+  Relay pong;
+  Connections::Combinational<Word_t> a;
+  Connections::Combinational<Word_t> b;
+  Connections::Combinational<Word_t> req;
+  Connections::Combinational<Word_t> rsp;
+  match::ThroughputAnalyzer throughput;
+
+  SC_CTOR(testbench)
+      : clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true),
+        rst("rst"),
+        src("src"),
+        stage("stage", 2),
+        sink("sink"),
+        ping("ping"),
+        pong("pong", 1),
+        a("a"),
+        b("b"),
+        req("req"),
+        rsp("rsp"),
+        throughput("throughput", "throughput.input.json") {
+    Connections::set_sim_clk(&clk);
+    src.clk(clk);
+    src.rst(rst);
+    stage.clk(clk);
+    stage.rst(rst);
+    sink.clk(clk);
+    sink.rst(rst);
+    ping.clk(clk);
+    ping.rst(rst);
+    pong.clk(clk);
+    pong.rst(rst);
+
+    src.out(a);
+    stage.in(a);
+    stage.out(b);
+    sink.in(b);
+    ping.out(req);
+    pong.in(req);
+    pong.out(rsp);
+    ping.in(rsp);
+
+    SC_THREAD(run);
+    sensitive << clk.posedge_event();
+  }
+
+  void run() {
+    rst = 0;
+    wait(2);
+    rst = 1;
+    wait(20);
+    sc_stop();
+  }
+};
+
+bool Contains(const std::string& text, const std::string& part) {
+  return text.find(part) != std::string::npos;
+}
+
+int sc_main(int argc, char *argv[]) {
+  // As annotate_design writes it: b is deeper in latency than in capacity
+  std::ofstream json("throughput.input.json");
+  json << "{ \"tb\": { \"b\": { \"latency\": 4, \"capacity\": 1,"
+       << " \"src_name\": \"tb.stage.out\", \"dest_name\": \"tb.sink.in\" } } }" << std::endl;
+  json.close();
+
+  testbench tb("tb");
+  tb.throughput.SetBlockII("tb.sink", 1);
+  sc_start(SC_ZERO_TIME);
+
+  match::ThroughputAnalyzer& t = tb.throughput;
+  const std::string& report = t.Report();
+  NVHLS_ASSERT_MSG(t.NumChannels() == 4, "Analyzer missed channels");
+  NVHLS_ASSERT_MSG(t.NumBlocks() == 5, "Analyzer missed blocks");
+  NVHLS_ASSERT_MSG(t.Graphs().size() == 2, "Expected two channel graphs");
+  int b = t.FindChannel("tb.b");
+  NVHLS_ASSERT_MSG(b >= 0 && t.Channels()[b].annotated, "Annotation of b not read");
+  NVHLS_ASSERT_MSG(t.Channels()[b].latency == 4 && t.Channels()[b].capacity == 1, "Wrong annotation of b");
+
+  // b holds 2 of the 5 cycles its messages take: 0.4, below the II 2 of stage
+  const match::ThroughputAnalyzer::Graph& pipe = t.Graphs()[t.FindGraph("tb.stage")];
+  NVHLS_ASSERT_MSG(std::fabs(pipe.throughput - 0.4) < 1e-6, "Wrong pipeline throughput");
+  NVHLS_ASSERT_MSG(std::fabs(pipe.block_bound - 0.5) < 1e-6, "Wrong pipeline block bound");
+  NVHLS_ASSERT_MSG(pipe.bottleneck == "channel tb.b (latency 4, capacity 1)", "Wrong pipeline bottleneck");
+  NVHLS_ASSERT_MSG(pipe.undersized.size() == 1 && pipe.undersized[0] == static_cast<unsigned int>(b),
+                   "b not reported undersized");
+  NVHLS_ASSERT_MSG(t.Channels()[b].needed == 2, "Wrong capacity needed by b");
+  NVHLS_ASSERT_MSG(Contains(report, "undersized: tb.b (latency 4, capacity 1) needs capacity 2"),
+                   "Undersized channel missing from the report");
+
+  // One request at a time over two hops, slower than its blocks
+  const match::ThroughputAnalyzer::Graph& loop = t.Graphs()[t.FindGraph("tb.ping")];
+  NVHLS_ASSERT_MSG(std::fabs(loop.throughput - 0.5) < 1e-6, "Wrong loop throughput");
+  NVHLS_ASSERT_MSG(std::fabs(loop.block_bound - 1.0) < 1e-6, "Wrong loop block bound");
+  NVHLS_ASSERT_MSG(Contains(loop.bottleneck, "feedback loop"), "Wrong loop bottleneck");
+  NVHLS_ASSERT_MSG(std::fabs(t.Throughput() - 0.4) < 1e-6, "Wrong design throughput");
+  NVHLS_ASSERT_MSG(Contains(report, "assumed 1: tb.ping tb.src\n"), "Undeclared II missing");
+
+  // With one more slot, stage is the bottleneck
+  t.SetChannel("tb.b", 4, 2);
+  t.Analyze();
+  const match::ThroughputAnalyzer::Graph& deeper = t.Graphs()[t.FindGraph("tb.stage")];
+  NVHLS_ASSERT_MSG(std::fabs(deeper.throughput - 0.5) < 1e-6, "Wrong throughput with a deeper b");
+  NVHLS_ASSERT_MSG(deeper.bottleneck == "block tb.stage (II 2)", "Wrong bottleneck with a deeper b");
+  NVHLS_ASSERT_MSG(deeper.undersized.empty(), "Deeper b still undersized");
+  NVHLS_ASSERT_MSG(std::fabs(t.Throughput() - 0.5) < 1e-6, "Wrong design throughput with a deeper b");
+  DCOUT(t.Report());
+
+  sc_start();
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
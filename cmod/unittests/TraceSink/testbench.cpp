@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_module.h>
+#include <nvhls_assert.h>
+#include <nvhls_int.h>
+#include <sstream>
+#include <string>
+
+class TraceModule : public match::Module {
+ public:
+  unsigned int ev_push;
+  unsigned int ev_flush;
+
+  TraceModule(sc_module_name nm) : match::Module(nm) {
+    ev_push = RegisterTraceEvent("push");
+    ev_flush = RegisterTraceEvent("flush");
+  }
+
+  void Push(NVUINT12 data) { TraceBinary(ev_push, data); }
+  void Flush() { TraceBinary(ev_flush); }
+};
+
+int sc_main(int argc, char *argv[]) {
+  TraceModule dut("dut");
+  match::BinaryTraceSink& sink = match::BinaryTraceSink::Instance();
+
+  // Not recorded: the sink is closed
+  dut.Push(1);
+
+  // A small ring makes the producer wait for the writer thread
+  static const unsigned int kNumPush = 2000;
+  NVHLS_ASSERT_MSG(sink.Open("trace.bin", 256), "cannot open trace");
+  for (unsigned int i = 0; i < kNumPush; i++) {
+    dut.Push(i & 0xfff);
+  }
+  dut.Flush();
+  sink.Close();
+
+  std::stringstream ss;
+  NVHLS_ASSERT_MSG(match::DecodeBinaryTrace("trace.bin", ss), "decode failed");
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(ss, line)) {
+    lines.push_back(line);
+  }
+  DCOUT(lines[0] << endl << lines[kNumPush] << endl);
+  DCOUT("Ring stalls: " << sink.Stalls() << endl);
+
+  NVHLS_ASSERT_MSG(lines.size() == kNumPush + 1, "wrong number of records");
+  NVHLS_ASSERT_MSG(lines[0].find(": dut: push 0x0000") != std::string::npos,
+                   "first record wrong");
+  NVHLS_ASSERT_MSG(lines[0x1bc].find(": dut: push 0x01bc") != std::string::npos,
+                   "payload wrong");
+  NVHLS_ASSERT_MSG(lines[kNumPush].find(": dut: flush") != std::string::npos,
+                   "last record wrong");
+
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
@@ -30,6 +30,18 @@ void VectorUnit( const OpType& op,
         case DP:        nvhls::dp<InScalarType, InScalarType, OutScalarType, VECTOR_LENGTH, true>(in1, in2, out[0]); break;
         case MAC:       nvhls::vector_mac<InScalarType, InScalarType, InScalarType, OutScalarType, VECTOR_LENGTH, true>(in1, in2, in3, out); break;
         case DPACC:     nvhls::dpacc<InScalarType, InScalarType, InScalarType, OutScalarType, VECTOR_LENGTH, true>(in1, in2, in3[0], out[0]); break;
+        case MACInplace:
+#pragma hls_unroll yes
+                        for (unsigned i = 0; i < VECTOR_LENGTH; i++) {
+                          out[i] = in3[i];
+                        }
+                        nvhls::vector_mac_inplace<InScalarType, InScalarType, OutScalarType, VECTOR_LENGTH, true>(in1, in2, out); break;
+        case DPACCInplace:
+                        out[0] = in3[0];
+                        nvhls::dpacc_inplace<InScalarType, InScalarType, OutScalarType, VECTOR_LENGTH, true>(in1, in2, out[0]); break;
+        case ReductionTree: nvhls::reduction_tree<InScalarType, OutScalarType, VECTOR_LENGTH, false>(in1, out[0]); break;
+        case DPTree:    nvhls::dp_tree<InScalarType, InScalarType, OutScalarType, VECTOR_LENGTH, false>(in1, in2, out[0]); break;
+        case DPTreeCarrySave: nvhls::dp_tree<InScalarType, InScalarType, OutScalarType, VECTOR_LENGTH, true>(in1, in2, out[0]); break;
         default:
             NVHLS_ASSERT_MSG(0, "op not supported");
     }
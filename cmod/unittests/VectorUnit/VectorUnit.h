@@ -24,8 +24,16 @@
 #define VECTOR_LENGTH 8
 #endif
 
-typedef NVUINT8 InScalarType;
-typedef NVUINT32 OutScalarType;
+#ifndef IN_SCALAR_TYPE
+#define IN_SCALAR_TYPE NVUINT8
+#endif
+
+#ifndef OUT_SCALAR_TYPE
+#define OUT_SCALAR_TYPE NVUINT32
+#endif
+
+typedef IN_SCALAR_TYPE InScalarType;
+typedef OUT_SCALAR_TYPE OutScalarType;
 typedef nvhls::nv_scvector<InScalarType, VECTOR_LENGTH> InVectorType;
 typedef nvhls::nv_scvector<OutScalarType, VECTOR_LENGTH> OutVectorType;
 
@@ -37,6 +45,11 @@ enum VectorOp {
     DP,
     MAC,
     DPACC,
+    MACInplace,
+    DPACCInplace,
+    ReductionTree,
+    DPTree,
+    DPTreeCarrySave,
     MAXOP
 };
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <stdio.h>
+#include <deque>
 #include "VectorUnit.h"
 #include <match_scverify.h>
 
@@ -29,6 +30,101 @@ void get_rand_vector(VectorType& data) {
 }
 
 
+// Pipelined adder trees against the combinational tree, delayed by Latency
+template <bool CarrySave, unsigned LevelsPerStage>
+void test_pipelined_tree() {
+  typedef nvhls::AdderTree<InScalarType, VECTOR_LENGTH, CarrySave> Tree;
+  typedef nvhls::AdderTreePipelined<InScalarType, VECTOR_LENGTH, CarrySave,
+                                    LevelsPerStage> PipelinedTree;
+  PipelinedTree tree;
+  std::deque<typename Tree::OutType> expected;
+  std::deque<bool> expected_valid;
+  for (unsigned i = 0; i < PipelinedTree::Latency; i++) {
+    expected.push_back(0);
+    expected_valid.push_back(false);
+  }
+  for (int i = 0; i < 100; i++) {
+    InVectorType in;
+    get_rand_vector(in);
+    bool valid = rand() & 1;
+    // Full-precision reference
+    typename Tree::OutType ref = 0;
+    for (int j = 0; j < VECTOR_LENGTH; j++) {
+      ref += in[j];
+    }
+    assert(Tree::sum(in.data) == ref);
+    expected.push_back(ref);
+    expected_valid.push_back(valid);
+
+    typename PipelinedTree::OutType out;
+    bool out_valid;
+    tree.run(in.data, valid, out, out_valid);
+    assert(out_valid == expected_valid.front());
+    if (out_valid) {
+      assert(out == expected.front());
+    }
+    expected.pop_front();
+    expected_valid.pop_front();
+  }
+}
+
+// Zero-skipping kernels against the dense dot product and MAC, on operands
+// with about 75% zeros, and their cycle counts
+template <unsigned K>
+void test_sparse_kernels() {
+  typedef nvhls::SparseVector<InScalarType, VECTOR_LENGTH> Sparse;
+  nvhls::SparseDotProduct<InScalarType, InScalarType, OutScalarType, VECTOR_LENGTH, K> sdp;
+  nvhls::SparseVectorMac<InScalarType, InScalarType, OutScalarType, OutScalarType,
+                         VECTOR_LENGTH, K> smac;
+  for (int i = 0; i < 1000; i++) {
+    InVectorType in1, in2, dense;
+    OutVectorType in3, out, out_ref;
+    get_rand_vector(in1);
+    get_rand_vector(in2);
+    get_rand_vector(in3);
+    for (int j = 0; j < VECTOR_LENGTH; j++) {
+      if (rand() % 4 != 0) in1[j] = 0;
+      if (rand() % 2 != 0) in2[j] = 0;
+    }
+    Sparse s1, s2;
+    s1.compress(in1);
+    s2.compress(in2);
+    s1.expand(dense);
+    assert(dense == in1);
+
+    unsigned pairs = 0, nnz = 0;
+    out_ref[0] = in3[0];
+    for (int j = 0; j < VECTOR_LENGTH; j++) {
+      out_ref[0] += in1[j] * in2[j];
+      pairs += (in1[j] != 0 && in2[j] != 0);
+      nnz += (in1[j] != 0);
+    }
+    assert(s1.nnz() == nnz);
+    sdp.start(s1, s2, in3[0]);
+    unsigned cycles = 1;
+    while (!sdp.run(out[0])) {
+      cycles++;
+    }
+    assert(out[0] == out_ref[0]);
+    assert(cycles == (pairs == 0 ? 1 : (pairs + K - 1) / K));
+
+    for (int j = 0; j < VECTOR_LENGTH; j++) {
+      out_ref[j] = in1[j] * in2[j] + in3[j];
+    }
+    smac.start(s1, in2, in3);
+    cycles = 1;
+    while (!smac.run(out)) {
+      cycles++;
+    }
+    assert(out == out_ref);
+    assert(cycles == (nnz == 0 ? 1 : (nnz + K - 1) / K));
+  }
+  DCOUT("K=" << K << ": sparse dp " << sdp.DenseProductsPerCycle()
+        << ", sparse mac " << smac.DenseProductsPerCycle()
+        << " dense products per cycle" << endl);
+  assert(sdp.DenseProductsPerCycle() > K);
+}
+
 CCS_MAIN(int argc, char *argv[]) {
     InVectorType in1, in2, in3;
     OpType op;
@@ -57,24 +153,33 @@ CCS_MAIN(int argc, char *argv[]) {
                      } 
                      assert(out == out_ref);
                      break;
-          case Reduction:  out_ref[0] = 0;
+          case Reduction:
+          case ReductionTree:
+                     out_ref[0] = 0;
                      for (int i = 0; i < VECTOR_LENGTH; i++) {
                         out_ref[0] += in1[i];
                      } 
                      assert(out[0] == out_ref[0]);
                      break;
-          case DP:  out_ref[0] = 0;
+          case DP:
+          case DPTree:
+          case DPTreeCarrySave:
+                     out_ref[0] = 0;
                      for (int i = 0; i < VECTOR_LENGTH; i++) {
                         out_ref[0] += in1[i]*in2[i];
                      } 
                      assert(out[0] == out_ref[0]);
                      break;
-          case MAC:  for (int i = 0; i < VECTOR_LENGTH; i++) {
+          case MAC:
+          case MACInplace:
+                     for (int i = 0; i < VECTOR_LENGTH; i++) {
                         out_ref[i] = in1[i] * in2[i] + in3[i];
                      } 
                      assert(out == out_ref);
                      break;
-          case DPACC:  out_ref[0] = in3[0];
+          case DPACC:
+          case DPACCInplace:
+                     out_ref[0] = in3[0];
                      for (int i = 0; i < VECTOR_LENGTH; i++) {
                         out_ref[0] += in1[i]*in2[i];
                      } 
@@ -85,6 +190,11 @@ CCS_MAIN(int argc, char *argv[]) {
         }; 
     }
 
+    test_pipelined_tree<false, 1>();
+    test_pipelined_tree<true, 2>();
+    test_sparse_kernels<1>();
+    test_sparse_kernels<2>();
+
     DCOUT("CMODEL PASS" << endl);
     CCS_RETURN(0) ;
 }
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __WHVCNOCTOP_H__
+#define __WHVCNOCTOP_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <WHVCNoC.h>
+#include <WHVCTopology.h>
+
+// Default: 4x4 mesh. Define NOC_TORUS for a torus, NOC_VARIABLE_LENGTH to
+// send packets in as few flits as their data needs, and NOC_EXPRESS to the
+// span of express links on a mesh. NOC_FAT_TREE builds a 4-ary 3-tree and
+// NOC_FLAT_BFLY a 4x4 flattened butterfly with 2 endpoints per router
+// instead.
+#ifndef MESH_X
+#define MESH_X 4
+#endif
+#ifndef MESH_Y
+#define MESH_Y 4
+#endif
+#ifndef NUM_VCHANNELS
+#define NUM_VCHANNELS 2
+#endif
+#ifndef NOC_EXPRESS
+#define NOC_EXPRESS 0
+#endif
+#ifdef NOC_VARIABLE_LENGTH
+#define VARIABLE_LENGTH true
+#else
+#define VARIABLE_LENGTH false
+#endif
+
+SC_MODULE(WHVCNoCTop) {
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  enum {
+    kMeshX = MESH_X,
+    kMeshY = MESH_Y,
+    kNumVChannels = NUM_VCHANNELS,
+    kBufferSize = 4,
+    kFlitDataWidth = 64,
+    kPacketDataWidth = 128,
+    kPacketIdWidth = 8
+  };
+
+#if defined(NOC_FAT_TREE)
+  typedef FatTreeNoC<4, 3, kNumVChannels, kBufferSize, kFlitDataWidth,
+                     kPacketDataWidth, kPacketIdWidth, VARIABLE_LENGTH> NoC_t;
+#elif defined(NOC_FLAT_BFLY)
+  typedef FlattenedButterflyNoC<4, 4, 2, kNumVChannels, kBufferSize, kFlitDataWidth,
+                                kPacketDataWidth, kPacketIdWidth, VARIABLE_LENGTH> NoC_t;
+#elif defined(NOC_TORUS)
+  typedef TorusNoC<kMeshX, kMeshY, kNumVChannels, kBufferSize, kFlitDataWidth,
+                   kPacketDataWidth, kPacketIdWidth, VARIABLE_LENGTH, NOC_EXPRESS> NoC_t;
+#else
+  typedef MeshNoC<kMeshX, kMeshY, kNumVChannels, kBufferSize, kFlitDataWidth,
+                  kPacketDataWidth, kPacketIdWidth, VARIABLE_LENGTH> NoC_t;
+#endif
+  typedef NoC_t::Packet_t Packet_t;
+  enum { kNumNodes = NoC_t::num_nodes };
+
+  NoC_t noc;
+
+  Connections::In<Packet_t> in_packet[kNumNodes];
+  Connections::Out<Packet_t> out_packet[kNumNodes];
+
+  SC_HAS_PROCESS(WHVCNoCTop);
+  WHVCNoCTop(sc_module_name name)
+      : sc_module(name), clk("clk"), rst("rst"), noc("noc") {
+    noc.clk(clk);
+    noc.rst(rst);
+    for (int i = 0; i < kNumNodes; i++) {
+      noc.in_packet[i](in_packet[i]);
+      noc.out_packet[i](out_packet[i]);
+    }
+  }
+};
+
+#endif
@@ -22,28 +22,61 @@
 #include <nvhls_packet.h>
 #include <WHVCRouter.h>
 
+// Lookahead route decode and empty-buffer bypass (see WHVCSourceRouter)
+#ifndef ROUTER_LOOKAHEAD
+#define ROUTER_LOOKAHEAD false
+#endif
+#ifndef ROUTER_BYPASS
+#define ROUTER_BYPASS false
+#endif
+// Input buffer shared by the VCs of each port, 0 for one FIFO per VC
+#ifndef ROUTER_SHARED_POOL
+#define ROUTER_SHARED_POOL 0
+#endif
+// Credits returned per credit message
+#ifndef ROUTER_CREDIT_BATCH
+#define ROUTER_CREDIT_BATCH 1
+#endif
+// Register stages of the router pipeline
+#ifndef ROUTER_PIPELINE_DEPTH
+#define ROUTER_PIPELINE_DEPTH 1
+#endif
+// VCs of the high-priority traffic class, 0 for one class
+#ifndef ROUTER_HIGH_VCS
+#define ROUTER_HIGH_VCS 0
+#endif
+// Virtual channels per port; the VC travels in the LSBs of packet_id
+#ifndef ROUTER_VCHANNELS
+#define ROUTER_VCHANNELS 1
+#endif
+
 SC_MODULE(WHVCRouterTop) {
  public:
   sc_in_clk clk;
   sc_in<bool> rst;
 
   enum { 
-    kNumVChannels = 1,
+    kNumVChannels = ROUTER_VCHANNELS,
     kBufferSize = 8,
     kFlitDataWidth = 64,
     kFlitIDWidth = 2,
     kNumLPorts = 1,
     kNumRPorts = 4,
     kNumMaxHops = 16,
+    kCreditBatch = ROUTER_CREDIT_BATCH,
     kLogBufferSize = nvhls::index_width<kBufferSize+1>::val,
     kNumPorts = kNumLPorts + kNumRPorts,
-    kNumCredits = (kNumLPorts + kNumRPorts)*kNumVChannels
+    kNumCredits = (kNumLPorts + kNumRPorts)*kNumVChannels,
+    kPacketIdWidth = (kNumVChannels > 1) ? nvhls::log2_ceil<kNumVChannels>::val : 0
   };
   typedef NVUINTC(kLogBufferSize) Credit_t;
-  typedef NVUINTC(1) Credit_ret_t;
+  typedef NVUINTC(nvhls::index_width<kCreditBatch + 1>::val) Credit_ret_t;
 
-  typedef Flit<64, 0, 0, 0, FlitId2bit, WormHole> Flit_t;
-  WHVCSourceRouter<kNumLPorts, kNumRPorts, kNumVChannels, kBufferSize, Flit_t, kNumMaxHops> router;
+  typedef Flit<64, 0, 0, kPacketIdWidth, FlitId2bit, WormHole> Flit_t;
+  WHVCSourceRouter<kNumLPorts, kNumRPorts, kNumVChannels, kBufferSize, Flit_t,
+                   kNumMaxHops, ROUTER_LOOKAHEAD, ROUTER_BYPASS,
+                   ROUTER_SHARED_POOL, kCreditBatch, ROUTER_PIPELINE_DEPTH,
+                   WHVCVCPriority<ROUTER_HIGH_VCS> > router;
 
   Connections::In<Flit_t> in_port[kNumPorts];
   Connections::Out<Flit_t> out_port[kNumPorts];
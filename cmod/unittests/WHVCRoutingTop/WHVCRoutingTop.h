@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __WHVCROUTINGTOP_H__
+#define __WHVCROUTINGTOP_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_packet.h>
+#include <WHVCRouter.h>
+
+// Default: XY routing. Define ROUTING_YX for YX routing, ROUTING_TABLE for
+// table routing, ROUTING_ADAPTIVE for minimal adaptive routing or
+// ROUTING_MULTICAST for tree multicast routing.
+#ifndef NUM_VCHANNELS
+#define NUM_VCHANNELS 1
+#endif
+
+SC_MODULE(WHVCRoutingTop) {
+ public:
+  sc_in_clk clk;
+  sc_in<bool> rst;
+
+  enum {
+    kNumVChannels = NUM_VCHANNELS,
+    kPacketIdWidth = (kNumVChannels > 1) ? nvhls::index_width<kNumVChannels>::val : 0,
+    kBufferSize = 4,
+    kNumLPorts = 1,
+    kNumRPorts = 4,
+    kMeshX = 3,
+    kMeshY = 3,
+    kNumDests = 8,
+    kLogBufferSize = nvhls::index_width<kBufferSize+1>::val,
+    kNumPorts = kNumLPorts + kNumRPorts,
+    kNumCredits = kNumPorts * kNumVChannels
+  };
+  typedef NVUINTC(kLogBufferSize) Credit_t;
+  typedef NVUINTC(1) Credit_ret_t;
+
+  typedef Flit<64, 0, 0, kPacketIdWidth, FlitId2bit, WormHole> Flit_t;
+#ifdef ROUTING_TABLE
+  typedef WHVCTableRouter<kNumLPorts, kNumRPorts, kNumVChannels, kBufferSize,
+                          Flit_t, kNumDests> Router_t;
+  typedef Router_t::Update_t Update_t;
+  Connections::In<Update_t> route_update;
+#else
+#ifdef ROUTING_ADAPTIVE
+  static const bool kYFirst = false;
+  typedef WHVCAdaptiveRouter<kNumLPorts, kNumVChannels, kBufferSize, Flit_t,
+                             kMeshX, kMeshY> Router_t;
+#else
+#ifdef ROUTING_MULTICAST
+  static const bool kYFirst = false;
+  typedef WHVCMulticastRouter<kNumLPorts, kNumVChannels, kBufferSize, Flit_t,
+                              kMeshX, kMeshY> Router_t;
+#else
+#ifdef ROUTING_YX
+  static const bool kYFirst = true;
+#else
+  static const bool kYFirst = false;
+#endif
+  typedef WHVCDimOrderRouter<kNumLPorts, kNumVChannels, kBufferSize, Flit_t,
+                             kMeshX, kMeshY, kYFirst> Router_t;
+#endif
+#endif
+  sc_in<NVUINTC(Router_t::Routing_t::x_width)> router_x;
+  sc_in<NVUINTC(Router_t::Routing_t::y_width)> router_y;
+#endif
+  Router_t router;
+
+  Connections::In<Flit_t> in_port[kNumPorts];
+  Connections::Out<Flit_t> out_port[kNumPorts];
+  Connections::In<Credit_ret_t> in_credit[kNumCredits];
+  Connections::Out<Credit_ret_t> out_credit[kNumCredits];
+
+  SC_HAS_PROCESS(WHVCRoutingTop);
+  WHVCRoutingTop(sc_module_name name)
+      : sc_module(name), clk("clk"), rst("rst"), router("router") {
+    router.clk(clk);
+    router.rst(rst);
+#ifdef ROUTING_TABLE
+    router.route_update(route_update);
+#else
+    router.router_x(router_x);
+    router.router_y(router_y);
+#endif
+
+    for (int i = 0; i < kNumPorts; i++) {
+      router.in_port[i](in_port[i]);
+      router.out_port[i](out_port[i]);
+      for (int j = 0; j < kNumVChannels; j++) {
+        router.in_credit[i * kNumVChannels + j](
+            in_credit[i * kNumVChannels + j]);
+        router.out_credit[i * kNumVChannels + j](
+            out_credit[i * kNumVChannels + j]);
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,459 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WHVCRoutingTop.h"
+#include <systemc.h>
+#include <mc_scverify.h>
+#include <testbench/nvhls_rand.h>
+#include <nvhls_connections.h>
+
+#define NVHLS_VERIFY_BLOCKS (WHVCRoutingTop)
+#include <nvhls_verify.h>
+
+#include <deque>
+#include <map>
+#include <sstream>
+#include <vector>
+
+using namespace ::std;
+typedef WHVCRoutingTop::Flit_t Flit_t;
+typedef WHVCRoutingTop::Credit_ret_t Credit_ret_t;
+typedef WHVCRoutingTop::Router_t Router_t;
+static const int kNumVChannels = WHVCRoutingTop::kNumVChannels;
+static const int kBufferSize = WHVCRoutingTop::kBufferSize;
+static const int kNumLPorts = WHVCRoutingTop::kNumLPorts;
+static const int kNumPorts = WHVCRoutingTop::kNumPorts;
+static const int kNumPackets = 64;
+
+static const int kDebugLevel = 1;
+
+// The router under test sits at (kRouterX, kRouterY) of the mesh
+static const int kRouterX = 1;
+static const int kRouterY = 1;
+
+// Every flit carries its source port, the VC it was sent on and a
+// per-source sequence number, so that the sink can identify it.
+static const int kSrcBit = 32;
+static const int kVcBit = 40;
+static const int kSeqBit = 44;
+
+#ifdef ROUTING_TABLE
+// Table programmed by the testbench: dest id i leaves through port
+// i % kNumPorts
+static int table_port(int dest_id) { return dest_id % kNumPorts; }
+#endif
+
+// Pick a random destination: returns the route bits of the header flit and
+// sets allowed to the bitmap of output ports the router may use and
+// escape to the port of the escape (XY) route. Multicast routes go to all
+// the allowed ports, and branch holds the route bits each of them sends on.
+static unsigned random_route(unsigned& allowed, int& escape,
+                             vector<unsigned>& branch) {
+#ifdef ROUTING_TABLE
+  int dest_id = rand() % WHVCRoutingTop::kNumDests;
+  escape = table_port(dest_id);
+  allowed = 1 << escape;
+  return dest_id;
+#else
+  typedef Router_t::Routing_t Routing_t;
+#ifdef ROUTING_MULTICAST
+  // a unicast now and then, otherwise any set of routers
+  const int num_nodes = WHVCRoutingTop::kMeshX * WHVCRoutingTop::kMeshY;
+  unsigned nodes = (rand() % 4 == 0) ? (1 << (rand() % num_nodes))
+                                     : (rand() % ((1 << num_nodes) - 1)) + 1;
+  branch.assign(kNumPorts, 0);
+  for (int n = 0; n < num_nodes; n++) {
+    if ((nodes >> n) & 1) {
+      int nx = n % WHVCRoutingTop::kMeshX;
+      int ny = n / WHVCRoutingTop::kMeshX;
+      int port = 0;
+      if (nx != kRouterX) {
+        port = (nx > kRouterX) ? Routing_t::port_east : Routing_t::port_west;
+      } else if (ny != kRouterY) {
+        port = (ny > kRouterY) ? Routing_t::port_north : Routing_t::port_south;
+      }
+      branch[port] |= 1 << n;
+    }
+  }
+  allowed = 0;
+  for (int port = 0; port < kNumPorts; port++) {
+    if (branch[port] != 0) {
+      allowed |= 1 << port;
+      branch[port] = (branch[port] << kNumLPorts) | 1;
+    }
+  }
+  escape = -1;
+  return (nodes << kNumLPorts) | 1;
+#endif
+  int dx = rand() % WHVCRoutingTop::kMeshX;
+  int dy = rand() % WHVCRoutingTop::kMeshY;
+  bool x_done = (dx == kRouterX);
+  bool y_done = (dy == kRouterY);
+  int x_port = (dx > kRouterX) ? Routing_t::port_east : Routing_t::port_west;
+  int y_port = (dy > kRouterY) ? Routing_t::port_north : Routing_t::port_south;
+  if (x_done && y_done) {
+    escape = 0;
+  } else if (!x_done && (!WHVCRoutingTop::kYFirst || y_done)) {
+    escape = x_port;
+  } else {
+    escape = y_port;
+  }
+  allowed = 1 << escape;
+#ifdef ROUTING_ADAPTIVE
+  if (!x_done) allowed |= 1 << x_port;
+  if (!y_done) allowed |= 1 << y_port;
+#endif
+  return (dy << (kNumLPorts + Routing_t::x_width)) | (dx << kNumLPorts) | 1;
+#endif
+}
+
+class Reference {
+ public:
+  struct Packet {
+    vector<Flit_t> flits;
+    unsigned allowed;
+    int escape;
+    vector<unsigned> branch;
+    vector<unsigned> next;
+    unsigned served;
+    unsigned copies;
+  };
+
+  Reference()
+      : current(kNumPorts, vector<long>(kNumVChannels, -1)),
+        last_seq(kNumPorts), sent(0), received(0) {}
+
+  static long key(const Flit_t& flit) {
+    return nvhls::get_slc<32>(flit.data, kSrcBit).to_uint64();
+  }
+
+  void packet_sent(const vector<Flit_t>& flits, unsigned allowed, int escape,
+                   const vector<unsigned>& branch) {
+    Packet& p = packets[key(flits[0])];
+    p.flits = flits;
+    p.allowed = allowed;
+    p.escape = escape;
+    p.branch = branch;
+    p.next.assign(kNumPorts, 0);
+    p.served = 0;
+    // a multicast reaches every allowed port, a unicast one of them
+    p.copies = 1;
+    if (!branch.empty()) {
+      p.copies = 0;
+      for (int port = 0; port < kNumPorts; port++) {
+        p.copies += (allowed >> port) & 1;
+      }
+    }
+    sent += p.copies * flits.size();
+  }
+
+  void flit_received(int dst, const Flit_t& flit) {
+    int out_vc = (kNumVChannels > 1) ? flit.get_packet_id().to_uint() : 0;
+    CDCOUT(sc_time_stamp() << " port " << dst << " vc " << out_vc
+           << " received: " << flit << endl, kDebugLevel);
+    if (flit.flit_id.isHeader()) {
+      NVHLS_ASSERT_MSG(current[dst][out_vc] == -1, "Packets interleaved on an output VC");
+      NVHLS_ASSERT_MSG(packets.count(key(flit)) == 1, "Unknown packet");
+      Packet& p = packets[key(flit)];
+      NVHLS_ASSERT_MSG((p.allowed >> dst) & 1, "Packet on a non-minimal port");
+      NVHLS_ASSERT_MSG(((p.served >> dst) & 1) == 0, "Packet forked twice to a port");
+      p.served |= 1 << dst;
+      if (dst >= kNumLPorts && out_vc == 0 && p.branch.empty()) {
+        NVHLS_ASSERT_MSG(dst == p.escape, "Escape VC off the escape route");
+      }
+      // packets of one source and input VC reach an output in order
+      int stream = nvhls::get_slc<12>(flit.data, kSrcBit).to_uint();
+      unsigned seq = nvhls::get_slc<20>(flit.data, kSeqBit).to_uint();
+      NVHLS_ASSERT_MSG(last_seq[dst].count(stream) == 0 || last_seq[dst][stream] < seq,
+                       "Packets reordered");
+      last_seq[dst][stream] = seq;
+      current[dst][out_vc] = key(flit);
+    }
+    NVHLS_ASSERT_MSG(current[dst][out_vc] != -1, "Body flit without header");
+    Packet& p = packets[current[dst][out_vc]];
+    NVHLS_ASSERT_MSG(p.next[dst] < p.flits.size(), "Too many flits in packet");
+    Flit_t ref = p.flits[p.next[dst]++];
+    if (ref.flit_id.isHeader() && !p.branch.empty()) {
+      ref.data = nvhls::set_slc(ref.data, NVUINTC(16)(p.branch[dst]), 0);
+    }
+    NVHLS_ASSERT_MSG(ref.flit_id == flit.flit_id && ref.data == flit.data,
+                     "Flit mismatch");
+    if (flit.flit_id.isTail()) {
+      if (--p.copies == 0) {
+        packets.erase(current[dst][out_vc]);
+      }
+      current[dst][out_vc] = -1;
+    }
+    received++;
+  }
+
+  bool done() const { return received == sent && packets.empty(); }
+
+  map<long, Packet> packets;
+  vector<vector<long> > current;
+  vector<map<int, unsigned> > last_seq;
+  unsigned sent, received;
+};
+
+SC_MODULE(Source) {
+  Connections::Out<Flit_t> out;
+  Connections::In<Credit_ret_t> credit[kNumVChannels];
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+  const int id;
+  Reference& ref;
+  int credits[kNumVChannels];
+
+  void read_credits() {
+    for (int vc = 0; vc < kNumVChannels; vc++) {
+      Credit_ret_t c;
+      if (credit[vc].PopNB(c)) {
+        credits[vc]++;
+      }
+    }
+  }
+
+  void run() {
+    out.Reset();
+    for (int vc = 0; vc < kNumVChannels; vc++) {
+      credit[vc].Reset();
+      credits[vc] = kBufferSize;
+    }
+    unsigned seq = 0;
+    // wait for the routing table to be programmed
+    for (int i = 0; i < 2 * WHVCRoutingTop::kNumDests + 4; i++) {
+      wait();
+    }
+    for (int p = 0; p < kNumPackets; p++) {
+      unsigned allowed;
+      int escape;
+      vector<unsigned> branch;
+      unsigned route = random_route(allowed, escape, branch);
+      int vc = rand() % kNumVChannels;
+      int num_flits = (rand() % 4) + 1;
+      vector<Flit_t> flits(num_flits);
+      for (int f = 0; f < num_flits; f++) {
+        Flit_t& flit = flits[f];
+        flit.data = 0;
+        flit.data = nvhls::set_slc(flit.data, NVUINTC(8)(id), kSrcBit);
+        flit.data = nvhls::set_slc(flit.data, NVUINTC(4)(vc), kVcBit);
+        flit.data = nvhls::set_slc(flit.data, NVUINTC(20)(seq++), kSeqBit);
+        if (kNumVChannels > 1) {
+          flit.packet_id = vc;
+        }
+        if (num_flits == 1) {
+          flit.flit_id.set(FlitId2bit::SNGL);
+        } else if (f == 0) {
+          flit.flit_id.set(FlitId2bit::HEAD);
+        } else if (f == num_flits - 1) {
+          flit.flit_id.set(FlitId2bit::TAIL);
+        } else {
+          flit.flit_id.set(FlitId2bit::BODY);
+        }
+        if (flit.flit_id.isHeader()) {
+          flit.data = nvhls::set_slc(flit.data, NVUINTC(16)(route), 0);
+        }
+      }
+      ref.packet_sent(flits, allowed, escape, branch);
+      for (int f = 0; f < num_flits; f++) {
+        bool pushed = false;
+        while (!pushed) {
+          read_credits();
+          if (credits[vc] > 0 && (rand() % 4 != 0)) {
+            out.Push(flits[f]);
+            credits[vc]--;
+            pushed = true;
+          }
+          wait();
+        }
+      }
+    }
+    while (1) {
+      read_credits();
+      wait();
+    }
+  }
+
+  SC_HAS_PROCESS(Source);
+  Source(sc_module_name name_, int id_, Reference& ref_)
+      : sc_module(name_), out("out"), clk("clk"), rst("rst"), id(id_),
+        ref(ref_) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+SC_MODULE(Dest) {
+  Connections::In<Flit_t> in;
+  Connections::Out<Credit_ret_t> credit[kNumVChannels];
+  sc_in<bool> clk;
+  sc_in<bool> rst;
+  const int id;
+  Reference& ref;
+
+  void run() {
+    in.Reset();
+    int pending[kNumVChannels];
+    for (int vc = 0; vc < kNumVChannels; vc++) {
+      credit[vc].Reset();
+      pending[vc] = 0;
+    }
+    while (1) {
+      wait();
+      Flit_t flit;
+      // stall now and then to build up backpressure
+      if ((rand() % 3 != 0) && in.PopNB(flit)) {
+        ref.flit_received(id, flit);
+        pending[(kNumVChannels > 1) ? flit.get_packet_id().to_uint() : 0]++;
+      }
+      for (int vc = 0; vc < kNumVChannels; vc++) {
+        if (pending[vc] > 0) {
+          Credit_ret_t c = 1;
+          if (credit[vc].PushNB(c)) {
+            pending[vc]--;
+          }
+        }
+      }
+    }
+  }
+
+  SC_HAS_PROCESS(Dest);
+  Dest(sc_module_name name_, int id_, Reference& ref_)
+      : sc_module(name_), in("in"), clk("clk"), rst("rst"), id(id_),
+        ref(ref_) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+};
+
+SC_MODULE(testbench) {
+  NVHLS_DESIGN(WHVCRoutingTop) router;
+
+  typedef Connections::Combinational<Credit_ret_t> CreditChan;
+  typedef Connections::Combinational<Flit_t> DataChan;
+
+  sc_clock clk;
+  sc_signal<bool> rst;
+  Reference ref;
+#ifdef ROUTING_TABLE
+  Connections::Combinational<WHVCRoutingTop::Update_t> route_update;
+#else
+  sc_signal<NVUINTC(Router_t::Routing_t::x_width)> router_x;
+  sc_signal<NVUINTC(Router_t::Routing_t::y_width)> router_y;
+#endif
+
+  SC_CTOR(testbench)
+      : router("router"),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        rst("rst") {
+    Connections::set_sim_clk(&clk);
+
+    router.clk(clk);
+    router.rst(rst);
+#ifdef ROUTING_TABLE
+    router.route_update(route_update);
+#else
+    router.router_x(router_x);
+    router.router_y(router_y);
+#endif
+
+    for (int i = 0; i < kNumPorts; ++i) {
+      ostringstream dname, sname;
+      dname << "dest_on_port_" << i;
+      sname << "source_on_port_" << i;
+      Dest* dest = new Dest(dname.str().c_str(), i, ref);
+      Source* source = new Source(sname.str().c_str(), i, ref);
+      DataChan* out_chan = new DataChan();
+      DataChan* in_chan = new DataChan();
+
+      dest->clk(clk);
+      dest->rst(rst);
+      dest->in(*out_chan);
+      router.out_port[i](*out_chan);
+
+      source->clk(clk);
+      source->rst(rst);
+      source->out(*in_chan);
+      router.in_port[i](*in_chan);
+
+      for (int vc = 0; vc < kNumVChannels; ++vc) {
+        CreditChan* in_credit_chan = new CreditChan();
+        CreditChan* out_credit_chan = new CreditChan();
+        dest->credit[vc](*in_credit_chan);
+        router.in_credit[i * kNumVChannels + vc](*in_credit_chan);
+        source->credit[vc](*out_credit_chan);
+        router.out_credit[i * kNumVChannels + vc](*out_credit_chan);
+      }
+    }
+
+    SC_THREAD(run);
+#ifdef ROUTING_TABLE
+    SC_THREAD(program_table);
+    sensitive << clk.posedge_event();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+#endif
+  }
+
+#ifdef ROUTING_TABLE
+  void program_table() {
+    route_update.ResetWrite();
+    wait();
+    for (int i = 0; i < WHVCRoutingTop::kNumDests; i++) {
+      WHVCRoutingTop::Update_t upd;
+      upd.dest_id = i;
+      upd.ports = 0;
+      upd.ports[table_port(i)] = 1;
+      route_update.Push(upd);
+    }
+    while (1) {
+      wait();
+    }
+  }
+#endif
+
+  void run() {
+#ifndef ROUTING_TABLE
+    router_x = kRouterX;
+    router_y = kRouterY;
+#endif
+    rst = 0;
+    cout << "@" << sc_time_stamp() << " Asserting Reset " << endl;
+    wait(2, SC_NS);
+    cout << "@" << sc_time_stamp() << " Deasserting Reset " << endl;
+    rst = 1;
+    wait(10000, SC_NS);
+    cout << "@" << sc_time_stamp() << " Stop " << endl;
+    cout << "sent " << ref.sent << " flits, received " << ref.received
+         << endl;
+    NVHLS_ASSERT_MSG(ref.sent > 0 && ref.done(), "Not all flits were delivered");
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char* argv[]) {
+  nvhls::set_random_seed();
+  testbench my_testbench("my_testbench");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    cout << "Simulation FAILED\n";
+  else
+    cout << "Simulation PASSED\n";
+  return rc;
+};
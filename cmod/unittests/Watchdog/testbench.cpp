@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <nvhls_watchdog.h>
+#include <string>
+
+typedef NVUINTW(8) Word_t;
+
+// Pushes before it pops: two of them facing each other wait on each other
+SC_MODULE(PushFirst) {
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::Out<Word_t> out;
+  Connections::In<Word_t> in;
+
+  SC_CTOR(PushFirst) : clk("clk"), rst("rst"), out("out"), in("in") {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void run() {
+    out.Reset();
+    in.Reset();
+    wait();
+    while (1) {
+      out.Push(1);
+      in.Pop();
+    }
+  }
+};
+
+// A stream that keeps flowing
+SC_MODULE(Lane) {
+  sc_in_clk clk;
+  sc_in<bool> rst;
+  Connections::Combinational<Word_t> chan;
+
+  SC_CTOR(Lane) : clk("clk"), rst("rst"), chan("chan") {
+    SC_THREAD(source);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+    SC_THREAD(sink);
+    sensitive << clk.pos();
+    NVHLS_NEG_RESET_SIGNAL_IS(rst);
+  }
+
+  void source() {
+    chan.ResetWrite();
+    wait();
+    Word_t i = 0;
+    while (1) {
+      chan.Push(i++);
+      wait();
+    }
+  }
+
+  void sink() {
+    chan.ResetRead();
+    wait();
+    while (1) {
+      chan.Pop();
+      wait();
+    }
+  }
+};
+
+SC_MODULE(testbench) {
+  sc_clock clk;
+  sc_signal<bool> rst;
+
+  PushFirst a;
+  PushFirst b;
+  Lane lane;
+  Connections::Combinational<Word_t> ab;
+  Connections::Combinational<Word_t> ba;
+  match::Watchdog watchdog;
+
+  SC_CTOR(testbench)
+      : clk("clk", 1, SC_NS, 0.5, 0, SC_NS, true),
+        rst("rst"),
+        a("a"),
+        b("b"),
+        lane("lane"),
+        ab("ab"),
+        ba("ba"),
+        watchdog("watchdog", 100) {
+    Connections::set_sim_clk(&clk);
+    a.clk(clk);
+    a.rst(rst);
+    b.clk(clk);
+    b.rst(rst);
+    lane.clk(clk);
+    lane.rst(rst);
+    watchdog.clk(clk);
+
+    a.out(ab);
+    b.in(ab);
+    b.out(ba);
+    a.in(ba);
+
+    SC_THREAD(run);
+    sensitive << clk.posedge_event();
+  }
+
+  void run() {
+    rst = 0;
+    wait(10);
+    rst = 1;
+    wait(10000);
+    NVHLS_ASSERT_MSG(false, "Watchdog did not stop the deadlocked simulation");
+  }
+};
+
+bool Contains(const std::string& text, const std::string& part) {
+  return text.find(part) != std::string::npos;
+}
+
+int sc_main(int argc, char *argv[]) {
+  testbench tb("tb");
+  sc_start();
+
+  const std::string& report = tb.watchdog.Report();
+  NVHLS_ASSERT_MSG(tb.watchdog.Fired(), "Watchdog did not fire");
+  NVHLS_ASSERT_MSG(tb.watchdog.NumChannels() >= 3, "Watchdog missed channels");
+  NVHLS_ASSERT_MSG(sc_time_stamp() < sc_time(10 + 2 * tb.watchdog.Threshold(), SC_NS),
+                   "Watchdog fired late");
+  NVHLS_ASSERT_MSG(Contains(report, "tb.a -> tb.b"), "Blocked edge a -> b missing");
+  NVHLS_ASSERT_MSG(Contains(report, "tb.b -> tb.a"), "Blocked edge b -> a missing");
+  NVHLS_ASSERT_MSG(Contains(report, "deadlock cycle:"), "Deadlock cycle missing");
+  NVHLS_ASSERT_MSG(!Contains(report, "tb.lane"), "Flowing channel reported");
+  DCOUT("CMODEL PASS" << endl);
+  return 0;
+}
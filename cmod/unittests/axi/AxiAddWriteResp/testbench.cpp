@@ -45,25 +45,42 @@ SC_MODULE(testbench) {
   Manager<cfgNoWresp, Mcfg> manager;
   AxiAddWriteResponse<cfgNoWresp, cfgWithWresp> addWResp;
 
+  // The same traffic through a shim that bounds posted writes and orders reads behind them
+  Subordinate<cfgWithWresp> subordinate_posted;
+  Manager<cfgNoWresp, Mcfg> manager_posted;
+  AxiAddWriteResponse<cfgNoWresp, cfgWithWresp, 8> addWResp_posted;
+
   sc_clock clk;
   sc_signal<bool> reset_bar;
   sc_signal<bool> done;
+  sc_signal<bool> done_posted;
 
   typename axi::axi4<cfgNoWresp>::read::template chan<> axi_read_m;
   typename axi::axi4<cfgNoWresp>::write::template chan<> axi_write_m;
   typename axi::axi4<cfgWithWresp>::read::template chan<> axi_read_s;
   typename axi::axi4<cfgWithWresp>::write::template chan<> axi_write_s;
+  typename axi::axi4<cfgNoWresp>::read::template chan<> axi_read_m_posted;
+  typename axi::axi4<cfgNoWresp>::write::template chan<> axi_write_m_posted;
+  typename axi::axi4<cfgWithWresp>::read::template chan<> axi_read_s_posted;
+  typename axi::axi4<cfgWithWresp>::write::template chan<> axi_write_s_posted;
 
   SC_CTOR(testbench)
       : subordinate("subordinate"),
         manager("manager"),
         addWResp("addWResp"),
+        subordinate_posted("subordinate_posted"),
+        manager_posted("manager_posted"),
+        addWResp_posted("addWResp_posted"),
         clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
         reset_bar("reset_bar"),
         axi_read_m("axi_read_m"),
         axi_write_m("axi_write_m"),
         axi_read_s("axi_read_s"),
-        axi_write_s("axi_write_s") {
+        axi_write_s("axi_write_s"),
+        axi_read_m_posted("axi_read_m_posted"),
+        axi_write_m_posted("axi_write_m_posted"),
+        axi_read_s_posted("axi_read_s_posted"),
+        axi_write_s_posted("axi_write_s_posted") {
 
     Connections::set_sim_clk(&clk);
 
@@ -86,6 +103,26 @@ SC_MODULE(testbench) {
     subordinate.if_wr(axi_write_s);
 
     manager.done(done);
+
+    subordinate_posted.clk(clk);
+    manager_posted.clk(clk);
+    addWResp_posted.clk(clk);
+
+    subordinate_posted.reset_bar(reset_bar);
+    manager_posted.reset_bar(reset_bar);
+    addWResp_posted.rst(reset_bar);
+
+    manager_posted.if_rd(axi_read_m_posted);
+    addWResp_posted.axiM_read(axi_read_m_posted);
+    addWResp_posted.axiS_read(axi_read_s_posted);
+    subordinate_posted.if_rd(axi_read_s_posted);
+
+    manager_posted.if_wr(axi_write_m_posted);
+    addWResp_posted.axiM_write(axi_write_m_posted);
+    addWResp_posted.axiS_write(axi_write_s_posted);
+    subordinate_posted.if_wr(axi_write_s_posted);
+
+    manager_posted.done(done_posted);
     SC_THREAD(run);
   }
 
@@ -98,7 +135,7 @@ SC_MODULE(testbench) {
 
     while (1) {
       wait(1, SC_NS);
-      if (done) {
+      if (done && done_posted) {
         sc_stop();
       }
     }
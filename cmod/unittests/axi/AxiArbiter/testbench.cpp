@@ -24,6 +24,10 @@
 #include <axi/AxiArbiter.h>
 #include <testbench/nvhls_rand.h>
 
+#ifndef AXI_ARBITER_REMAP_IDS
+#define AXI_ARBITER_REMAP_IDS false
+#endif
+
 SC_MODULE(testbench) {
 
   enum {
@@ -76,7 +80,11 @@ SC_MODULE(testbench) {
     };
   };
 
-  Subordinate<axi::cfg::standard> subordinate;
+  typedef AxiArbiter<axi::cfg::standard, numManagers, maxInFlight, Roundrobin,
+                     AXI_ARBITER_REMAP_IDS> arbiter_t;
+  typedef typename arbiter_t::subordinateCfg subordinateCfg;
+
+  Subordinate<subordinateCfg> subordinate;
   Manager<axi::cfg::standard, manager0Cfg> manager0;
   Manager<axi::cfg::standard, manager1Cfg> manager1;
   Manager<axi::cfg::standard, manager2Cfg> manager2;
@@ -86,14 +94,14 @@ SC_MODULE(testbench) {
   sc_signal<bool> reset_bar;
   nvhls::nv_array<sc_signal<bool>, numManagers> done;
 
-  AxiArbiter<axi::cfg::standard, numManagers, maxInFlight> axi_arbiter;
+  arbiter_t axi_arbiter;
 
   nvhls::nv_array<typename axi::axi4<axi::cfg::standard>::read::template chan<>, numManagers>
       axi_read_m;
   nvhls::nv_array<typename axi::axi4<axi::cfg::standard>::write::template chan<>, numManagers>
       axi_write_m;
-  typename axi::axi4<axi::cfg::standard>::read::template chan<> axi_read_s;
-  typename axi::axi4<axi::cfg::standard>::write::template chan<> axi_write_s;
+  typename axi::axi4<subordinateCfg>::read::template chan<> axi_read_s;
+  typename axi::axi4<subordinateCfg>::write::template chan<> axi_write_s;
 
   SC_CTOR(testbench)
       : subordinate("subordinate"),
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AXI_BURST_SHAPER_TOP_H
+#define AXI_BURST_SHAPER_TOP_H
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <axi/axi4_configs.h>
+
+#include <axi/AxiBurstShaper.h>
+#include <axi/AxiSubordinateToMem.h>
+
+#ifndef AXI_BURST_SHAPER_MAX_BEATS
+#define AXI_BURST_SHAPER_MAX_BEATS 16
+#endif
+
+#ifndef AXI_BURST_SHAPER_TIMEOUT
+#define AXI_BURST_SHAPER_TIMEOUT 4
+#endif
+
+// A burst shaper in front of a memory
+class AxiBurstShaperTop : public sc_module {
+ public:
+  typedef typename axi::axi4<axi::cfg::standard> axi_;
+  static const int kMemBytes = 16 * 1024;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axi_::read::template subordinate<> axi_read;
+  typename axi_::write::template subordinate<> axi_write;
+
+  AxiBurstShaper<axi::cfg::standard, AXI_BURST_SHAPER_MAX_BEATS,
+                 AXI_BURST_SHAPER_TIMEOUT> shaper;
+  AxiSubordinateToMem<axi::cfg::standard, kMemBytes> mem;
+
+  typename axi_::read::template chan<> mem_read;
+  typename axi_::write::template chan<> mem_write;
+
+  SC_HAS_PROCESS(AxiBurstShaperTop);
+
+  AxiBurstShaperTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axi_read("axi_read"),
+        axi_write("axi_write"),
+        shaper("shaper"),
+        mem("mem"),
+        mem_read("mem_read"),
+        mem_write("mem_write")
+  {
+    shaper.clk(clk);
+    shaper.reset_bar(reset_bar);
+    mem.clk(clk);
+    mem.reset_bar(reset_bar);
+
+    shaper.axiM_read(axi_read);
+    shaper.axiM_write(axi_write);
+    shaper.axiS_read(mem_read);
+    shaper.axiS_write(mem_write);
+    mem.if_rd(mem_read);
+    mem.if_wr(mem_write);
+  }
+};
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AXI_CACHE_TOP_H
+#define AXI_CACHE_TOP_H
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <axi/axi4_configs.h>
+
+#include <axi/AxiCache.h>
+#include <axi/AxiSubordinateToMem.h>
+
+#ifndef AXI_CACHE_WAYS
+#define AXI_CACHE_WAYS 2
+#endif
+
+#ifndef AXI_CACHE_REPLACEMENT
+#define AXI_CACHE_REPLACEMENT CacheLRU
+#endif
+
+#ifndef AXI_CACHE_WRITE_BACK
+#define AXI_CACHE_WRITE_BACK 1
+#endif
+
+// A small AxiCache in front of an AxiSubordinateToMem
+class AxiCacheTop : public sc_module {
+ public:
+  typedef typename axi::axi4<axi::cfg::standard> axi_;
+  static const int kMemBytes = 8 * 256;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axi_::read::template subordinate<> axi_read;
+  typename axi_::write::template subordinate<> axi_write;
+
+  AxiCache<axi::cfg::standard, 16, AXI_CACHE_WAYS, 4, AXI_CACHE_REPLACEMENT,
+           AXI_CACHE_WRITE_BACK> cache;
+  AxiSubordinateToMem<axi::cfg::standard, kMemBytes> mem;
+
+  typename axi_::read::template chan<> mem_read;
+  typename axi_::write::template chan<> mem_write;
+
+  SC_HAS_PROCESS(AxiCacheTop);
+
+  AxiCacheTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axi_read("axi_read"),
+        axi_write("axi_write"),
+        cache("cache"),
+        mem("mem"),
+        mem_read("mem_read"),
+        mem_write("mem_write")
+  {
+    cache.clk(clk);
+    cache.rst(reset_bar);
+    mem.clk(clk);
+    mem.reset_bar(reset_bar);
+
+    cache.if_rd(axi_read);
+    cache.if_wr(axi_write);
+    cache.if_mem_rd(mem_read);
+    cache.if_mem_wr(mem_write);
+    mem.if_rd(mem_read);
+    mem.if_wr(mem_write);
+  }
+};
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AXI_DMA_TOP_H
+#define AXI_DMA_TOP_H
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <axi/axi4_configs.h>
+
+#include <axi/AxiDma.h>
+#include <axi/AxiSubordinateToMem.h>
+
+#ifndef AXI_DMA_MAX_OUTSTANDING
+#define AXI_DMA_MAX_OUTSTANDING 4
+#endif
+
+#ifndef AXI_DMA_ROB_DEPTH
+#define AXI_DMA_ROB_DEPTH 16
+#endif
+
+// An AxiDma reading from an AxiSubordinateToMem; axi_write preloads the memory
+class AxiDmaTop : public sc_module {
+ public:
+  typedef typename axi::axi4<axi::cfg::standard> axi_;
+  typedef AxiDma<axi::cfg::standard, AXI_DMA_MAX_OUTSTANDING, AXI_DMA_ROB_DEPTH> Dma;
+  static const int kMemBytes = 16 * 1024;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  Connections::In<Dma::Descriptor> desc_in;
+  Connections::Out<Dma::StreamBeat> stream_out;
+  typename axi_::write::template subordinate<> axi_write;
+
+  Dma dma;
+  AxiSubordinateToMem<axi::cfg::standard, kMemBytes> mem;
+
+  typename axi_::read::template chan<> mem_read;
+
+  SC_HAS_PROCESS(AxiDmaTop);
+
+  AxiDmaTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        desc_in("desc_in"),
+        stream_out("stream_out"),
+        axi_write("axi_write"),
+        dma("dma"),
+        mem("mem"),
+        mem_read("mem_read")
+  {
+    dma.clk(clk);
+    dma.reset_bar(reset_bar);
+    mem.clk(clk);
+    mem.reset_bar(reset_bar);
+
+    dma.desc_in(desc_in);
+    dma.stream_out(stream_out);
+    dma.if_rd(mem_read);
+    mem.if_rd(mem_read);
+    mem.if_wr(axi_write);
+  }
+};
+
+#endif
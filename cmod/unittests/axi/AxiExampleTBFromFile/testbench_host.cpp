@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+
+#include <axi/axi4.h>
+#include <mc_scverify.h>
+#include <axi/testbench/HostBridge.h>
+#include <axi/testbench/SubordinateFromFile.h>
+#include <testbench/nvhls_rand.h>
+
+#include <sstream>
+#include <unistd.h>
+
+// Host software driving a subordinate through a HostBridgeManager. The
+// driver runs in a testbench thread, so that the test is deterministic, but
+// talks to the bridge through the shared-memory rings only, as an external
+// process would.
+
+SC_MODULE(testbench) {
+  typedef axi::cfg::standard axiCfg;
+
+  SubordinateFromFile<axiCfg> subordinate;
+  HostBridgeManager<axiCfg> host;
+
+  sc_clock clk;
+  sc_signal<bool> reset_bar;
+  sc_signal<bool> irq;
+  sc_signal<bool> done;
+
+  typename axi::axi4<axiCfg>::read::template chan<> axi_read;
+  typename axi::axi4<axiCfg>::write::template chan<> axi_write;
+
+  HostBridgeClient client;
+  unsigned int interrupts;
+
+  static std::string ShmName() {
+    std::stringstream name;
+    name << "/matchlib_host_tb_" << getpid();
+    return name.str();
+  }
+
+  SC_CTOR(testbench)
+      : subordinate("subordinate", "mem.csv"),
+        host("host", ShmName(), 16, 4),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        reset_bar("reset_bar"),
+        axi_read("axi_read"),
+        axi_write("axi_write"),
+        interrupts(0) {
+
+    Connections::set_sim_clk(&clk);
+
+    subordinate.clk(clk);
+    host.clk(clk);
+
+    subordinate.reset_bar(reset_bar);
+    host.reset_bar(reset_bar);
+
+    host.if_rd(axi_read);
+    subordinate.if_rd(axi_read);
+
+    host.if_wr(axi_write);
+    subordinate.if_wr(axi_write);
+
+    host.interrupt(irq);
+    host.done(done);
+
+    SC_THREAD(run);
+    SC_THREAD(driver);
+    sensitive << clk.posedge_event();
+  }
+
+  static uint8_t Pattern(unsigned int i) { return static_cast<uint8_t>(i * 7 + 3); }
+
+  // Waits for n read or write responses; reads are tagged with the index of
+  // their first byte in Pattern()
+  void Complete(unsigned int n) {
+    while (n != 0) {
+      const HostBridgeMsg* rsp = client.Poll();
+      if (rsp == NULL) {
+        wait();
+        continue;
+      }
+      CMOD_ASSERT_MSG(rsp->status == 0, "Host request failed");
+      if (rsp->kind == HostBridgeMsg::kInterrupt) {
+        interrupts++;
+        CMOD_ASSERT_MSG(rsp->tag == interrupts, "Interrupt count mismatch");
+      } else {
+        if (rsp->kind == HostBridgeMsg::kRead) {
+          for (unsigned int i = 0; i < rsp->bytes; i++) {
+            CMOD_ASSERT_MSG(rsp->data[i] == Pattern(rsp->tag + i),
+                            "Host read data mismatch");
+          }
+        }
+        n--;
+      }
+      client.Done();
+    }
+  }
+
+  void driver() {
+    CMOD_ASSERT_MSG(client.Attach(ShmName()), "Could not attach to the host bridge");
+    uint8_t buf[2 * HostBridgeMsg::kMaxBytes];
+    irq = 0;
+    wait(30);
+
+    // Preloaded little-endian word
+    client.Read(0x20000, 8, 0);
+    client.Submit();
+    const HostBridgeMsg* rsp;
+    while ((rsp = client.Poll()) == NULL) wait();
+    static const uint8_t expected[8] = {0x88, 0x88, 0xCC, 0xCC, 0x00, 0x00, 0xFF, 0xFF};
+    CMOD_ASSERT_MSG(rsp->kind == HostBridgeMsg::kRead && rsp->bytes == 8 &&
+                    memcmp(rsp->data, expected, 8) == 0,
+                    "Preloaded read mismatch");
+    client.Done();
+
+    // One batch of an unaligned 100-byte write and four 64-byte bursts, with
+    // the byte offset of each request as its tag; then read them all back
+    for (unsigned int i = 0; i < sizeof(buf); i++) buf[i] = Pattern(i);
+    CMOD_ASSERT_MSG(client.Write(0x1003, buf, 100, 0), "Request ring full");
+    for (unsigned int i = 0; i < 4; i++) {
+      CMOD_ASSERT_MSG(client.Write(0x2000 + 64 * i, buf + 100 + 64 * i, 64, 100 + 64 * i),
+                      "Request ring full");
+    }
+    client.Submit();
+    Complete(5);
+    CMOD_ASSERT_MSG(client.Read(0x1003, 100, 0), "Request ring full");
+    for (unsigned int i = 0; i < 4; i++) {
+      CMOD_ASSERT_MSG(client.Read(0x2000 + 64 * i, 64, 100 + 64 * i), "Request ring full");
+    }
+    client.Read(0x1010, 5, 13);
+    client.Submit();
+    Complete(6);
+    CMOD_ASSERT_MSG(host.num_writes == 5 && host.num_reads == 7, "Wrong request counts");
+
+    // Two interrupts from the device while the host waits
+    for (unsigned int i = 0; i < 2; i++) {
+      irq = 1;
+      wait(2);
+      irq = 0;
+      wait(3);
+    }
+    while (interrupts < 2) {
+      if ((rsp = client.Poll()) == NULL) {
+        wait();
+        continue;
+      }
+      CMOD_ASSERT_MSG(rsp->kind == HostBridgeMsg::kInterrupt, "Expected an interrupt");
+      interrupts++;
+      CMOD_ASSERT_MSG(rsp->tag == interrupts, "Interrupt count mismatch");
+      client.Done();
+    }
+
+    client.Stop();
+    client.Submit();
+  }
+
+  void run() {
+    reset_bar = 1;
+    wait(2, SC_NS);
+    reset_bar = 0;
+    wait(2, SC_NS);
+    reset_bar = 1;
+
+    while (1) {
+      wait(1, SC_NS);
+      if (done) {
+        CMOD_ASSERT_MSG(interrupts == 2 && host.num_interrupts == 2, "Interrupts lost");
+        sc_stop();
+      }
+    }
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    DCOUT("TESTBENCH FAIL" << endl);
+  else
+    DCOUT("TESTBENCH PASS" << endl);
+  return rc;
+};
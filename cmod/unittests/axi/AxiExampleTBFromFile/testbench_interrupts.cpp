@@ -25,6 +25,19 @@
 
 // A simple AXI testbench example.  A Manager and Subordinate are wired together
 // directly with no DUT in between.
+//
+// The interrupt goes high once and stays high. With COALESCE, it instead
+// pulses every kInterruptPeriod cycles, and the requests coalesce and post
+// their interrupt waits, one of which times out.
+
+#ifdef COALESCE
+static const char* kRequests = "requests_q_coalesce.csv";
+static const int kInterruptPeriod = 50;
+static const unsigned int kTimeouts = 1;
+#else
+static const char* kRequests = "requests_q.csv";
+static const unsigned int kTimeouts = 0;
+#endif
 
 SC_MODULE(testbench) {
 
@@ -42,7 +55,7 @@ SC_MODULE(testbench) {
 
   SC_CTOR(testbench)
       : subordinate("subordinate", "mem.csv"),
-        manager("manager", "requests_q.csv"),
+        manager("manager", kRequests),
         clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
         reset_bar("reset_bar"),
         axi_read("axi_read"),
@@ -75,9 +88,16 @@ SC_MODULE(testbench) {
     wait(2, SC_NS);
     reset_bar = 1;
 
+#ifdef COALESCE
+    int cycle = 0;
+#endif
     while (1) {
       wait(1, SC_NS);
+#ifdef COALESCE
+      interrupt.write(++cycle % kInterruptPeriod == 0);
+#else
       interrupt.write(1);
+#endif
       if (done) {
         sc_stop();
       }
@@ -90,6 +110,10 @@ int sc_main(int argc, char *argv[]) {
   testbench tb("tb");
   sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
   sc_start();
+  CMOD_ASSERT_MSG(tb.manager.interrupt_timeouts == kTimeouts,
+                  "Wrong number of interrupt wait timeouts");
+  DCOUT("Interrupts received: " << tb.manager.interrupts_received
+        << ", cycles waited: " << tb.manager.interrupt_wait_cycles << endl);
   bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
   if (rc)
     DCOUT("TESTBENCH FAIL" << endl);
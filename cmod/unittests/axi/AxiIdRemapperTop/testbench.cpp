@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+
+#include <axi/axi4.h>
+#include <mc_scverify.h>
+#include <axi/testbench/Manager.h>
+#include <axi/testbench/Subordinate.h>
+#include <axi/AxiIdRemapper.h>
+#include <testbench/nvhls_rand.h>
+
+// An AXI config with idWidth bits of ID
+template <int idBits>
+struct IdCfg : public axi::cfg::standard {
+  enum { idWidth = idBits };
+};
+
+// Random traffic rotating through numIds IDs
+template <int ids>
+struct IdTraffic : public axi::traffic::random {
+  enum { numIds = ids };
+};
+
+SC_MODULE(testbench) {
+
+  // 64 of 256 manager IDs on 4 subordinate IDs: each new ID takes a free slot
+  typedef IdCfg<8> cfgWide;
+  typedef IdCfg<2> cfgNarrow;
+  // 2 manager IDs on 2 slots: several requests in flight on each slot
+  typedef IdCfg<1> cfgPair;
+
+  struct Mcfg {
+    enum {
+      numWrites = 500,
+      numReads = 500,
+      readDelay = 5000,
+      addrBoundLower = 0,
+      addrBoundUpper = 0x7FFFFFFF,
+      seed = 0,
+      useFile = false,
+    };
+  };
+
+  Manager<cfgWide, Mcfg, IdTraffic<64> > manager;
+  AxiIdRemapper<cfgWide, cfgNarrow, 4> remapper;
+  Subordinate<cfgNarrow> subordinate;
+
+  Manager<cfgPair, Mcfg, IdTraffic<2> > manager_pair;
+  AxiIdRemapper<cfgPair, cfgPair, 2, 3> remapper_pair;
+  Subordinate<cfgPair> subordinate_pair;
+
+  sc_clock clk;
+  sc_signal<bool> reset_bar;
+  sc_signal<bool> done;
+  sc_signal<bool> done_pair;
+
+  typename axi::axi4<cfgWide>::read::template chan<> axi_read_m;
+  typename axi::axi4<cfgWide>::write::template chan<> axi_write_m;
+  typename axi::axi4<cfgNarrow>::read::template chan<> axi_read_s;
+  typename axi::axi4<cfgNarrow>::write::template chan<> axi_write_s;
+  typename axi::axi4<cfgPair>::read::template chan<> axi_read_m_pair;
+  typename axi::axi4<cfgPair>::write::template chan<> axi_write_m_pair;
+  typename axi::axi4<cfgPair>::read::template chan<> axi_read_s_pair;
+  typename axi::axi4<cfgPair>::write::template chan<> axi_write_s_pair;
+
+  SC_CTOR(testbench)
+      : manager("manager"),
+        remapper("remapper"),
+        subordinate("subordinate"),
+        manager_pair("manager_pair"),
+        remapper_pair("remapper_pair"),
+        subordinate_pair("subordinate_pair"),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        reset_bar("reset_bar"),
+        axi_read_m("axi_read_m"),
+        axi_write_m("axi_write_m"),
+        axi_read_s("axi_read_s"),
+        axi_write_s("axi_write_s"),
+        axi_read_m_pair("axi_read_m_pair"),
+        axi_write_m_pair("axi_write_m_pair"),
+        axi_read_s_pair("axi_read_s_pair"),
+        axi_write_s_pair("axi_write_s_pair") {
+
+    Connections::set_sim_clk(&clk);
+
+    manager.clk(clk);
+    remapper.clk(clk);
+    subordinate.clk(clk);
+
+    manager.reset_bar(reset_bar);
+    remapper.rst(reset_bar);
+    subordinate.reset_bar(reset_bar);
+
+    manager.if_rd(axi_read_m);
+    remapper.axiM_read(axi_read_m);
+    remapper.axiS_read(axi_read_s);
+    subordinate.if_rd(axi_read_s);
+
+    manager.if_wr(axi_write_m);
+    remapper.axiM_write(axi_write_m);
+    remapper.axiS_write(axi_write_s);
+    subordinate.if_wr(axi_write_s);
+
+    manager.done(done);
+
+    manager_pair.clk(clk);
+    remapper_pair.clk(clk);
+    subordinate_pair.clk(clk);
+
+    manager_pair.reset_bar(reset_bar);
+    remapper_pair.rst(reset_bar);
+    subordinate_pair.reset_bar(reset_bar);
+
+    manager_pair.if_rd(axi_read_m_pair);
+    remapper_pair.axiM_read(axi_read_m_pair);
+    remapper_pair.axiS_read(axi_read_s_pair);
+    subordinate_pair.if_rd(axi_read_s_pair);
+
+    manager_pair.if_wr(axi_write_m_pair);
+    remapper_pair.axiM_write(axi_write_m_pair);
+    remapper_pair.axiS_write(axi_write_s_pair);
+    subordinate_pair.if_wr(axi_write_s_pair);
+
+    manager_pair.done(done_pair);
+    SC_THREAD(run);
+  }
+
+  void run() {
+    reset_bar = 1;
+    wait(2, SC_NS);
+    reset_bar = 0;
+    wait(2, SC_NS);
+    reset_bar = 1;
+
+    while (1) {
+      wait(1, SC_NS);
+      if (done && done_pair) {
+        sc_stop();
+      }
+    }
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    DCOUT("TESTBENCH FAIL" << endl);
+  else
+    DCOUT("TESTBENCH PASS" << endl);
+  return rc;
+};
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+
+#include <axi/axi4.h>
+#include <mc_scverify.h>
+#include <axi/testbench/Manager.h>
+#include <axi/testbench/LatencySubordinate.h>
+#include <testbench/nvhls_rand.h>
+
+#ifndef TRAFFIC_PROFILE
+#define TRAFFIC_PROFILE axi::traffic::streaming
+#endif
+
+#ifndef LATENCY_OUT_OF_ORDER
+#define LATENCY_OUT_OF_ORDER 0
+#endif
+
+// A Manager drives a LatencySubordinate directly, and the testbench checks
+// the timing the subordinate reports once all requests have completed.
+
+SC_MODULE(testbench) {
+  typedef axi::cfg::standard axiCfg;
+
+  struct tbManagerCfg {
+    enum {
+      numWrites = 400,
+      numReads = 400,
+      readDelay = 0,
+      addrBoundLower = 0,
+      addrBoundUpper = 0x7FFF,
+      seed = 0,
+    };
+  };
+
+  struct tbLatencyCfg {
+    enum {
+      fixedLatency = 10,
+      randomLatency = 6,
+      numBanks = 4,
+      rowBytes = 1024,
+      rowHitLatency = 4,
+      rowMissLatency = 20,
+      maxOutstanding = 8,
+      outOfOrder = LATENCY_OUT_OF_ORDER,
+      seed = 0,
+    };
+  };
+
+  LatencySubordinate<axiCfg, tbLatencyCfg> subordinate;
+  Manager<axiCfg, tbManagerCfg, TRAFFIC_PROFILE> manager;
+
+  sc_clock clk;
+  sc_signal<bool> reset_bar;
+
+  sc_signal<bool> done;
+
+  typename axi::axi4<axiCfg>::read::template chan<> axi_read;
+  typename axi::axi4<axiCfg>::write::template chan<> axi_write;
+
+  SC_CTOR(testbench)
+      : subordinate("subordinate"),
+        manager("manager"),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        reset_bar("reset_bar"),
+        axi_read("axi_read"),
+        axi_write("axi_write") {
+
+    Connections::set_sim_clk(&clk);
+
+    subordinate.clk(clk);
+    manager.clk(clk);
+
+    subordinate.reset_bar(reset_bar);
+    manager.reset_bar(reset_bar);
+
+    manager.if_rd(axi_read);
+    subordinate.if_rd(axi_read);
+
+    manager.if_wr(axi_write);
+    subordinate.if_wr(axi_write);
+
+    manager.done(done);
+
+    SC_THREAD(run);
+  }
+
+  void check() {
+    uint64_t accesses = subordinate.numRowHits + subordinate.numRowMisses;
+    DCOUT(sc_time_stamp() << " Row hits: " << subordinate.numRowHits
+          << ", row misses: " << subordinate.numRowMisses
+          << ", mean read latency: " << (subordinate.numReadBursts ? subordinate.readLatency / subordinate.numReadBursts : 0)
+          << " cycles" << endl);
+    if (subordinate.numReadBursts != tbManagerCfg::numReads) {
+      SC_REPORT_ERROR("testbench", "The subordinate did not return every read burst");
+    }
+    if (accesses != tbManagerCfg::numReads + tbManagerCfg::numWrites) {
+      SC_REPORT_ERROR("testbench", "Every request must make exactly one bank access");
+    }
+    // Every read pays at least the fixed latency and a row hit
+    if (subordinate.readLatency < subordinate.numReadBursts * (tbLatencyCfg::fixedLatency + tbLatencyCfg::rowHitLatency)) {
+      SC_REPORT_ERROR("testbench", "Reads returned faster than the configured latency");
+    }
+  }
+
+  void run() {
+    reset_bar = 1;
+    wait(2, SC_NS);
+    reset_bar = 0;
+    wait(2, SC_NS);
+    reset_bar = 1;
+
+    while (1) {
+      wait(1, SC_NS);
+      if (done) {
+        check();
+        sc_stop();
+      }
+    }
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    DCOUT("TESTBENCH FAIL" << endl);
+  else
+    DCOUT("TESTBENCH PASS" << endl);
+  return rc;
+};
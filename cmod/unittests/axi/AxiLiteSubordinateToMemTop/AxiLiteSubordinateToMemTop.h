@@ -32,7 +32,7 @@ class AxiLiteSubordinateToMemTop : public sc_module {
   typename axi_::read::template subordinate<> axi_read;
   typename axi_::write::template subordinate<> axi_write;
 
-  AxiLiteSubordinateToMem<2 * 1024> subordinate;
+  AxiLiteSubordinateToMem<2 * 1024, 4> subordinate;
 
   SC_HAS_PROCESS(AxiLiteSubordinateToMemTop);
 
@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <tlm_utils/tlm_quantumkeeper.h>
+
+#include <cstring>
+#include <vector>
+#include <nvhls_connections.h>
+#include <testbench/nvhls_rand.h>
+#include <axi/axi4.h>
+#include <axi/AxiLt.h>
+#include <axi/AxiManagerGate.h>
+#include <axi/AxiSubordinateToMem.h>
+
+typedef axi::cfg::standard Cfg;
+typedef axi::axi4<Cfg> axi_;
+
+static const int kBytesPerBeat = Cfg::dataWidth >> 3;
+static const int kRegionBytes = 0x1000;
+static const int kSliceBytes = kRegionBytes / 2;
+static const int kNumRegs = 8;
+static const uint64 kRegBase = 2 * kRegionBytes;
+static const int kTransactions = 400;
+static const int kGateBytes = 0x400;
+static const int kGateBursts = 200;
+
+// Small private generator, so runs that must match draw the same sequence
+struct Lcg {
+  unsigned int state;
+  explicit Lcg(unsigned int seed) : state(seed) {}
+  unsigned int operator()() {
+    state = state * 1103515245u + 12345u;
+    return state >> 8;
+  }
+};
+
+// Random LT reads and writes in its own half of the LT and the pin memory,
+// checked against a local copy. Manager 0 also checks the registers, byte
+// enables, a decode miss and DMI.
+SC_MODULE(LtManager) {
+  tlm_utils::simple_initiator_socket<LtManager> init;
+
+  int index;
+  bool done;
+  Lcg rnd;
+  std::vector<unsigned char> model;  // both slices
+  tlm_utils::tlm_quantumkeeper qk;
+
+  SC_HAS_PROCESS(LtManager);
+
+  LtManager(sc_module_name name, int index_)
+      : sc_module(name),
+        init("init"),
+        index(index_),
+        done(false),
+        rnd(17 + index_),
+        model(2 * kSliceBytes, 0) {
+    tlm::tlm_global_quantum::instance().set(sc_time(100, SC_NS));
+    SC_THREAD(run);
+  }
+
+  uint64 Base(int region) { return region * kRegionBytes + index * kSliceBytes; }
+
+  tlm::tlm_response_status Transport(tlm::tlm_command cmd, uint64 addr,
+                                     unsigned char* p, unsigned int len,
+                                     unsigned char* be = 0, unsigned int be_len = 0) {
+    tlm::tlm_generic_payload trans;
+    sc_time delay = qk.get_local_time();
+    trans.set_command(cmd);
+    trans.set_address(addr);
+    trans.set_data_ptr(p);
+    trans.set_data_length(len);
+    trans.set_streaming_width(len);
+    trans.set_byte_enable_ptr(be);
+    trans.set_byte_enable_length(be_len);
+    trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+    init->b_transport(trans, delay);
+    qk.set(delay);
+    if (qk.need_sync())
+      qk.sync();
+    return trans.get_response_status();
+  }
+
+  void Check(bool ok, const char* what) {
+    if (!ok) {
+      SC_REPORT_ERROR(name(), what);
+    }
+  }
+
+  void Directed() {
+    // Registers, then a byte-enabled write to byte 2 of register 3
+    unsigned char regs[kNumRegs * kBytesPerBeat];
+    unsigned char back[kNumRegs * kBytesPerBeat];
+    for (int i = 0; i < kNumRegs * kBytesPerBeat; i++)
+      regs[i] = static_cast<unsigned char>(i / kBytesPerBeat + 1);
+    Check(Transport(tlm::TLM_WRITE_COMMAND, kRegBase, regs, sizeof(regs)) == tlm::TLM_OK_RESPONSE,
+          "Register write failed");
+    unsigned char byte = 0xaa;
+    unsigned char be[kBytesPerBeat] = {0};
+    be[2] = tlm::TLM_BYTE_ENABLED;
+    unsigned char word[kBytesPerBeat] = {0};
+    word[2] = byte;
+    Check(Transport(tlm::TLM_WRITE_COMMAND, kRegBase + 3 * kBytesPerBeat, word,
+                    kBytesPerBeat, be, kBytesPerBeat) == tlm::TLM_OK_RESPONSE,
+          "Register byte write failed");
+    regs[3 * kBytesPerBeat + 2] = byte;
+    Check(Transport(tlm::TLM_READ_COMMAND, kRegBase, back, sizeof(back)) == tlm::TLM_OK_RESPONSE,
+          "Register read failed");
+    Check(memcmp(regs, back, sizeof(regs)) == 0, "Register read back mismatch");
+    Check(Transport(tlm::TLM_READ_COMMAND, kRegBase + kNumRegs * kBytesPerBeat, back,
+                    kBytesPerBeat) == tlm::TLM_ADDRESS_ERROR_RESPONSE,
+          "Read past the registers did not fail");
+
+    // Every other byte of the first beat of the LT memory
+    for (int i = 0; i < kBytesPerBeat; i++) {
+      word[i] = static_cast<unsigned char>(0x50 + i);
+      be[i] = (i % 2 == 0) ? tlm::TLM_BYTE_ENABLED : tlm::TLM_BYTE_DISABLED;
+      if (i % 2 == 0)
+        model[i] = word[i];
+    }
+    Check(Transport(tlm::TLM_WRITE_COMMAND, Base(0), word, kBytesPerBeat, be,
+                    kBytesPerBeat) == tlm::TLM_OK_RESPONSE,
+          "Byte-enabled write failed");
+
+    // Decode miss
+    Check(Transport(tlm::TLM_READ_COMMAND, 3 * kRegionBytes, word, kBytesPerBeat) ==
+              tlm::TLM_ADDRESS_ERROR_RESPONSE,
+          "Unmapped read did not fail");
+  }
+
+  void CheckDmi() {
+    tlm::tlm_generic_payload trans;
+    tlm::tlm_dmi dmi;
+    trans.set_address(Base(0));
+    trans.set_read();
+    Check(init->get_direct_mem_ptr(trans, dmi), "DMI refused by the LT memory");
+    Check(dmi.get_start_address() == 0 && dmi.get_end_address() == kRegionBytes - 1,
+          "DMI region is not the LT memory");
+    Check(memcmp(dmi.get_dmi_ptr() + Base(0), &model[0], kSliceBytes) == 0,
+          "DMI contents mismatch");
+    trans.set_address(Base(1));
+    Check(!init->get_direct_mem_ptr(trans, dmi), "DMI granted through the pin bridge");
+  }
+
+  void run() {
+    wait(10, SC_NS);  // Let the pin models come out of reset
+    qk.reset();
+
+    // The pin memory starts undefined
+    std::vector<unsigned char> buf(kSliceBytes, 0);
+    Check(Transport(tlm::TLM_WRITE_COMMAND, Base(1), &buf[0], kSliceBytes) == tlm::TLM_OK_RESPONSE,
+          "Clearing the pin memory failed");
+    if (index == 0)
+      Directed();
+
+    for (int t = 0; t < kTransactions; t++) {
+      int region = rnd() % 2;
+      unsigned int beats = 1 + rnd() % 8;
+      unsigned int offset = (rnd() % (kSliceBytes / kBytesPerBeat - beats + 1)) * kBytesPerBeat;
+      unsigned int len = beats * kBytesPerBeat;
+      unsigned char* m = &model[region * kSliceBytes + offset];
+      buf.resize(len);
+      if (rnd() % 2) {
+        for (unsigned int i = 0; i < len; i++)
+          buf[i] = static_cast<unsigned char>(rnd());
+        Check(Transport(tlm::TLM_WRITE_COMMAND, Base(region) + offset, &buf[0], len) ==
+                  tlm::TLM_OK_RESPONSE,
+              "Write failed");
+        memcpy(m, &buf[0], len);
+      } else {
+        Check(Transport(tlm::TLM_READ_COMMAND, Base(region) + offset, &buf[0], len) ==
+                  tlm::TLM_OK_RESPONSE,
+              "Read failed");
+        Check(memcmp(m, &buf[0], len) == 0, "Read data mismatch");
+      }
+    }
+
+    if (index == 0)
+      CheckDmi();
+    qk.sync();
+    done = true;
+  }
+};
+
+// Bursts through AxiManagerGate request channels: write, check the response,
+// read a random burst back and check it against a local copy
+SC_MODULE(GateDriver) {
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+  Connections::Out<WrRequest<Cfg> > wrRequestOut;
+  Connections::In<WrResp<Cfg> > wrRespIn;
+  Connections::Out<RdRequest<Cfg> > rdRequestOut;
+  Connections::In<RdResp<Cfg> > rdRespIn;
+
+  bool done;
+  Lcg rnd;
+  std::vector<axi_::Data> model;
+
+  SC_CTOR(GateDriver)
+      : clk("clk"),
+        reset_bar("reset_bar"),
+        wrRequestOut("wrRequestOut"),
+        wrRespIn("wrRespIn"),
+        rdRequestOut("rdRequestOut"),
+        rdRespIn("rdRespIn"),
+        done(false),
+        rnd(5),
+        model(kGateBytes / kBytesPerBeat, 0) {
+    SC_THREAD(run);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+  void run() {
+    wrRequestOut.Reset();
+    wrRespIn.Reset();
+    rdRequestOut.Reset();
+    rdRespIn.Reset();
+    wait(20);  // Let the reorder buffers of AxiManagerGate reset
+
+    for (int t = 0; t < kGateBursts; t++) {
+      unsigned int len = rnd() % 8;
+      unsigned int word = rnd() % (kGateBytes / kBytesPerBeat - len);
+      WrRequest<Cfg> wr;
+      wr.addr = word * kBytesPerBeat;
+      wr.len = len;
+      for (unsigned int b = 0; b <= len; b++) {
+        axi_::Data data = rnd();
+        data = (data << 32) | rnd();
+        wr.data = data;
+        wr.last = (b == len);
+        model[word + b] = data;
+        wrRequestOut.Push(wr);
+      }
+      WrResp<Cfg> wr_resp = wrRespIn.Pop();
+      if (wr_resp.resp != axi_::Enc::XRESP::OKAY) {
+        SC_REPORT_ERROR(name(), "Write response is not OKAY");
+      }
+
+      len = rnd() % 8;
+      word = rnd() % (kGateBytes / kBytesPerBeat - len);
+      RdRequest<Cfg> rd;
+      rd.addr = word * kBytesPerBeat;
+      rd.len = len;
+      rdRequestOut.Push(rd);
+      for (unsigned int b = 0; b <= len; b++) {
+        RdResp<Cfg> rd_resp = rdRespIn.Pop();
+        if (rd_resp.data != model[word + b] || rd_resp.last != (b == len)) {
+          SC_REPORT_ERROR(name(), "Read response does not match");
+        }
+      }
+    }
+    done = true;
+    while (1) wait();
+  }
+};
+
+SC_MODULE(testbench) {
+  sc_clock clk;
+  sc_signal<bool> reset_bar;
+
+  // LT managers -> arbiter -> splitter -> {LT memory, bridge to a pin memory, LT registers}
+  LtManager manager0;
+  LtManager manager1;
+  AxiArbiterLt<Cfg, 2, 4> arbiter;
+  AxiSplitterLt<Cfg, 3, 16, false, true> splitter;
+  AxiSubordinateToMemLt<Cfg, kRegionBytes> lt_mem;
+  LtToAxi<Cfg> to_pin;
+  AxiSubordinateToMem<Cfg, kRegionBytes> pin_mem;
+  AxiSubordinateToRegLt<Cfg, kNumRegs, 16> lt_regs;
+  sc_signal<NVUINTW(16)> addrBound[3][2];
+  sc_signal<NVUINTW(16)> regBase;
+  sc_signal<NVUINTW(Cfg::dataWidth)> regOut[kNumRegs];
+  axi_::read::template chan<> pin_mem_rd;
+  axi_::write::template chan<> pin_mem_wr;
+
+  // The same bursts through a pin AxiManagerGate bridged to an LT memory and
+  // through AxiManagerGateLt
+  GateDriver driver_pin;
+  GateDriver driver_lt;
+  AxiManagerGate<Cfg> gate_pin;
+  AxiToLt<Cfg> to_lt;
+  AxiSubordinateToMemLt<Cfg, kGateBytes> gate_pin_mem;
+  AxiManagerGateLt<Cfg> gate_lt;
+  AxiSubordinateToMemLt<Cfg, kGateBytes> gate_lt_mem;
+  axi_::read::template chan<> gate_rd;
+  axi_::write::template chan<> gate_wr;
+  Connections::Combinational<WrRequest<Cfg> > wrRequest[2];
+  Connections::Combinational<WrResp<Cfg> > wrResp[2];
+  Connections::Combinational<RdRequest<Cfg> > rdRequest[2];
+  Connections::Combinational<RdResp<Cfg> > rdResp[2];
+
+  SC_CTOR(testbench)
+      : clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        reset_bar("reset_bar"),
+        manager0("manager0", 0),
+        manager1("manager1", 1),
+        arbiter("arbiter"),
+        splitter("splitter"),
+        lt_mem("lt_mem"),
+        to_pin("to_pin"),
+        pin_mem("pin_mem"),
+        lt_regs("lt_regs"),
+        pin_mem_rd("pin_mem_rd"),
+        pin_mem_wr("pin_mem_wr"),
+        driver_pin("driver_pin"),
+        driver_lt("driver_lt"),
+        gate_pin("gate_pin"),
+        to_lt("to_lt"),
+        gate_pin_mem("gate_pin_mem"),
+        gate_lt("gate_lt"),
+        gate_lt_mem("gate_lt_mem"),
+        gate_rd("gate_rd"),
+        gate_wr("gate_wr") {
+    manager0.init(arbiter.tgt[0]);
+    manager1.init(arbiter.tgt[1]);
+    arbiter.init(splitter.tgt);
+    splitter.init[0](lt_mem.tgt);
+    splitter.init[1](to_pin.tgt);
+    splitter.init[2](lt_regs.tgt);
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 2; j++)
+        splitter.addrBound[i][j](addrBound[i][j]);
+    }
+    addrBound[0][0] = 0;
+    addrBound[0][1] = kRegionBytes - 1;
+    addrBound[1][0] = kRegionBytes;
+    addrBound[1][1] = 2 * kRegionBytes - 1;
+    addrBound[2][0] = kRegBase;
+    addrBound[2][1] = kRegBase + kNumRegs * kBytesPerBeat - 1;
+
+    to_pin.clk(clk);
+    to_pin.reset_bar(reset_bar);
+    to_pin.if_rd(pin_mem_rd);
+    to_pin.if_wr(pin_mem_wr);
+    pin_mem.clk(clk);
+    pin_mem.reset_bar(reset_bar);
+    pin_mem.if_rd(pin_mem_rd);
+    pin_mem.if_wr(pin_mem_wr);
+
+    regBase = 0;
+    lt_regs.baseAddr(regBase);
+    for (int i = 0; i < kNumRegs; i++)
+      lt_regs.regOut[i](regOut[i]);
+
+    driver_pin.clk(clk);
+    driver_pin.reset_bar(reset_bar);
+    driver_pin.wrRequestOut(wrRequest[0]);
+    driver_pin.wrRespIn(wrResp[0]);
+    driver_pin.rdRequestOut(rdRequest[0]);
+    driver_pin.rdRespIn(rdResp[0]);
+    gate_pin.clk(clk);
+    gate_pin.reset_bar(reset_bar);
+    gate_pin.wrRequestIn(wrRequest[0]);
+    gate_pin.wrRespOut(wrResp[0]);
+    gate_pin.rdRequestIn(rdRequest[0]);
+    gate_pin.rdRespOut(rdResp[0]);
+    gate_pin.if_rd(gate_rd);
+    gate_pin.if_wr(gate_wr);
+    to_lt.clk(clk);
+    to_lt.reset_bar(reset_bar);
+    to_lt.if_rd(gate_rd);
+    to_lt.if_wr(gate_wr);
+    to_lt.init(gate_pin_mem.tgt);
+
+    driver_lt.clk(clk);
+    driver_lt.reset_bar(reset_bar);
+    driver_lt.wrRequestOut(wrRequest[1]);
+    driver_lt.wrRespIn(wrResp[1]);
+    driver_lt.rdRequestOut(rdRequest[1]);
+    driver_lt.rdRespIn(rdResp[1]);
+    gate_lt.clk(clk);
+    gate_lt.reset_bar(reset_bar);
+    gate_lt.wrRequestIn(wrRequest[1]);
+    gate_lt.wrRespOut(wrResp[1]);
+    gate_lt.rdRequestIn(rdRequest[1]);
+    gate_lt.rdRespOut(rdResp[1]);
+    gate_lt.init(gate_lt_mem.tgt);
+
+    SC_THREAD(run);
+  }
+
+  void run() {
+    reset_bar = 1;
+    wait(2, SC_NS);
+    reset_bar = 0;
+    wait(2, SC_NS);
+    reset_bar = 1;
+
+    while (!(manager0.done && manager1.done && driver_pin.done && driver_lt.done))
+      wait(10, SC_NS);
+
+    for (int r = 0; r < kNumRegs; r++) {
+      NVUINTW(Cfg::dataWidth) expected = 0;
+      for (int b = 0; b < kBytesPerBeat; b++)
+        expected = nvhls::set_slc(expected, NVUINTW(8)(r + 1), 8 * b);
+      if (r == 3)
+        expected = nvhls::set_slc(expected, NVUINTW(8)(0xaa), 16);
+      if (regOut[r].read() != expected) {
+        SC_REPORT_ERROR(name(), "Register output mismatch");
+      }
+    }
+    if (memcmp(gate_pin_mem.data(), gate_lt_mem.data(), kGateBytes) != 0) {
+      SC_REPORT_ERROR(name(), "Pin and LT AxiManagerGate memories differ");
+    }
+    DCOUT(sc_time_stamp() << " LT managers and gate drivers done" << endl);
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    DCOUT("TESTBENCH FAIL" << endl);
+  else
+    DCOUT("TESTBENCH PASS" << endl);
+  return rc;
+};
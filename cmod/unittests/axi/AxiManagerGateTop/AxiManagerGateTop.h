@@ -20,10 +20,28 @@
 #include <axi/AxiManagerGate.h>
 #include <axi/axi4_configs.h>
 
+#ifndef AXI_MANAGER_GATE_IN_ORDER
+#define AXI_MANAGER_GATE_IN_ORDER false
+#endif
+
+#ifndef AXI_MANAGER_GATE_MAX_IN_FLIGHT
+#define AXI_MANAGER_GATE_MAX_IN_FLIGHT 4
+#endif
+
+#ifndef AXI_MANAGER_GATE_ROB_DEPTH
+#define AXI_MANAGER_GATE_ROB_DEPTH 8
+#endif
+
+#ifndef AXI_MANAGER_GATE_REQ_FIFO_DEPTH
+#define AXI_MANAGER_GATE_REQ_FIFO_DEPTH 4
+#endif
+
 SC_MODULE(AxiManagerGateTop) {
 
  private:
-  AxiManagerGate<axi::cfg::standard> gate;
+  AxiManagerGate<axi::cfg::standard, AXI_MANAGER_GATE_ROB_DEPTH, AXI_MANAGER_GATE_MAX_IN_FLIGHT,
+                 AXI_MANAGER_GATE_REQ_FIFO_DEPTH, AXI_MANAGER_GATE_REQ_FIFO_DEPTH,
+                 AXI_MANAGER_GATE_IN_ORDER> gate;
 
  public:
   typedef axi::axi4<axi::cfg::standard> axi4_;
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AXI_MERGE_SORT_TOP_H
+#define AXI_MERGE_SORT_TOP_H
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <axi/axi4_configs.h>
+
+#include <axi/AxiMergeSort.h>
+
+#ifndef AXI_MERGE_SORT_RUN_LEN
+#define AXI_MERGE_SORT_RUN_LEN 16
+#endif
+
+#ifndef AXI_MERGE_SORT_WAYS
+#define AXI_MERGE_SORT_WAYS 4
+#endif
+
+#ifndef AXI_MERGE_SORT_STAGES_PER_REG
+#define AXI_MERGE_SORT_STAGES_PER_REG 0
+#endif
+
+SC_MODULE(AxiMergeSortTop) {
+ public:
+  typedef axi::axi4<axi::cfg::standard> axi4_;
+  typedef AxiMergeSort<axi::cfg::standard, 32, AXI_MERGE_SORT_RUN_LEN, AXI_MERGE_SORT_WAYS,
+                       AXI_MERGE_SORT_STAGES_PER_REG> Sorter;
+
+ private:
+  Sorter sorter;
+
+ public:
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  Connections::In<Sorter::Command> cmd_in;
+  Connections::Out<Sorter::Count> done;
+  typename axi4_::read::template manager<> if_rd;
+  typename axi4_::write::template manager<> if_wr;
+
+  SC_CTOR(AxiMergeSortTop)
+      : sorter("sorter"),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        cmd_in("cmd_in"),
+        done("done"),
+        if_rd("if_rd"),
+        if_wr("if_wr") {
+    sorter.clk(clk);
+    sorter.reset_bar(reset_bar);
+
+    sorter.cmd_in(cmd_in);
+    sorter.done(done);
+    sorter.if_rd(if_rd);
+    sorter.if_wr(if_wr);
+  }
+};
+
+#endif
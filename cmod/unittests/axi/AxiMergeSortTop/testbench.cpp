@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+
+#include <algorithm>
+#include <vector>
+#include <mc_scverify.h>
+#include <nvhls_connections.h>
+#include <testbench/nvhls_rand.h>
+#include <axi/testbench/Subordinate.h>
+#include "AxiMergeSortTop.h"
+
+SC_MODULE(testbench) {
+  typedef AxiMergeSortTop::axi4_ axi4_;
+  typedef AxiMergeSortTop::Sorter Sorter;
+  static const int kRunLen = AXI_MERGE_SORT_RUN_LEN;
+  static const int kWays = AXI_MERGE_SORT_WAYS;
+
+  CCS_DESIGN(AxiMergeSortTop) dut;
+  Subordinate<axi::cfg::standard> mem;
+
+  sc_clock clk;
+  sc_signal<bool> reset_bar;
+
+  Connections::Combinational<Sorter::Command> cmd_chan;
+  Connections::Combinational<Sorter::Count> done_chan;
+  axi4_::read::template chan<> axi_read;
+  axi4_::write::template chan<> axi_write;
+
+  Connections::Out<Sorter::Command> cmd_out;
+  Connections::In<Sorter::Count> done_in;
+
+  SC_CTOR(testbench)
+      : dut("dut"),
+        mem("mem"),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        reset_bar("reset_bar"),
+        axi_read("axi_read"),
+        axi_write("axi_write"),
+        cmd_out("cmd_out"),
+        done_in("done_in") {
+    dut.clk(clk);
+    dut.reset_bar(reset_bar);
+    mem.clk(clk);
+    mem.reset_bar(reset_bar);
+
+    dut.cmd_in(cmd_chan);
+    cmd_out(cmd_chan);
+    dut.done(done_chan);
+    done_in(done_chan);
+    dut.if_rd(axi_read);
+    mem.if_rd(axi_read);
+    dut.if_wr(axi_write);
+    mem.if_wr(axi_write);
+
+    SC_THREAD(run);
+    SC_THREAD(source);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+  // Sorts count keys below max_key, from src to dst, and checks the result
+  void sort_test(unsigned count, unsigned max_key, axi4_::Addr src, axi4_::Addr dst,
+                 axi4_::Addr tmp) {
+    std::vector<unsigned> keys;
+    for (unsigned i = 0; i < count; i++) {
+      unsigned key = rand() % max_key;
+      keys.push_back(key);
+      // Preload the memory through its backdoor; the upper bits must be ignored
+      axi4_::Addr addr = src + i * Sorter::bytesPerWord;
+      axi4_::Data data = (static_cast<axi4_::Data>(rand()) << 32) | key;
+      mem.localMem[addr] = data;
+      mem.localMem_wstrb[addr] = ~0;
+    }
+    std::sort(keys.begin(), keys.end());
+
+    Sorter::Command cmd;
+    cmd.src = src;
+    cmd.dst = dst;
+    cmd.tmp = tmp;
+    cmd.count = count;
+    sc_time start = sc_time_stamp();
+    cmd_out.Push(cmd);
+    Sorter::Count sorted = done_in.Pop();
+    NVHLS_ASSERT_MSG(sorted == count, "Wrong count on done");
+    for (unsigned i = 0; i < count; i++) {
+      axi4_::Addr addr = dst + i * Sorter::bytesPerWord;
+      NVHLS_ASSERT_MSG(mem.localMem.count(addr) != 0, "Sorted key was not written");
+      unsigned key = nvhls::get_slc<32>(mem.localMem[addr], 0).to_uint();
+      if (key != keys[i]) {
+        SC_REPORT_ERROR("testbench", "Keys are not sorted");
+        return;
+      }
+    }
+    DCOUT(sc_time_stamp() << " sorted " << count << " keys in "
+          << (sc_time_stamp() - start) << endl);
+  }
+
+  void source() {
+    cmd_out.Reset();
+    done_in.Reset();
+    wait();
+
+    // Around the block and merge group sizes, then longer lists; the
+    // small key ranges give many duplicates
+    unsigned counts[] = {1, 2, kRunLen - 1, kRunLen, kRunLen + 1, kWays * kRunLen,
+                         kWays * kRunLen + 3, kWays * kWays * kRunLen + 1, 1000, 2000};
+    for (unsigned n = 0; n < sizeof(counts) / sizeof(counts[0]); n++) {
+      unsigned max_key = (n % 3 == 0) ? 4 : 0x7fffffff;
+      // Buffers that start just before a 4KB boundary
+      sort_test(counts[n], max_key, 0x10000 - 8 * n, 0x40000 + 8 * n, 0x80000 - 40);
+    }
+    for (unsigned n = 0; n < 10; n++) {
+      sort_test(1 + rand() % 3000, 1 + rand() % 1000, 0x1000 * (rand() % 4),
+                0x40000 + 8 * (rand() % 64), 0x80000 + 8 * (rand() % 64));
+    }
+    sc_stop();
+  }
+
+  void run() {
+    reset_bar = 1;
+    wait(2, SC_NS);
+    reset_bar = 0;
+    wait(2, SC_NS);
+    reset_bar = 1;
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    DCOUT("TESTBENCH FAIL" << endl);
+  else
+    DCOUT("TESTBENCH PASS" << endl);
+  return rc;
+};
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AXINOCTOP_H__
+#define __AXINOCTOP_H__
+
+#include <systemc.h>
+#include <nvhls_connections.h>
+#include <axi/axi4.h>
+#include <axi/AxiNoCInterface.h>
+#include <WHVCNoC.h>
+
+// Two AXI managers at nodes 0 and 1 and two subordinates at nodes 2 and 3
+// of a 2x2 mesh. Each manager's 64KB window is split between the two
+// subordinates.
+SC_MODULE(AxiNoCTop) {
+ public:
+  enum {
+    numManagers = 2,
+    numSubordinates = 2,
+    numRegions = 4,
+    maxWrites = 4,
+  };
+
+  struct axiCfg {
+    enum {
+      dataWidth = 32,
+      useVariableBeatSize = 0,
+      useMisalignedAddresses = 0,
+      useLast = 1,
+      useWriteStrobes = 1,
+      useBurst = 1, useFixedBurst = 0, useWrapBurst = 0, maxBurstSize = 4,
+      useQoS = 0, useLock = 0, useProt = 0, useCache = 0, useRegion = 0,
+      aUserWidth = 0, wUserWidth = 0, bUserWidth = 0, rUserWidth = 0,
+      addrWidth = 32,
+      idWidth = 4,
+      useWriteResponses = 1,
+    };
+  };
+  typedef axi::axi4<axiCfg> axi_;
+
+  // Two VCs for requests and responses, variable-length packets
+  typedef MeshNoC<2, 2, 2, 4, 64, 256, 1, true> NoC_t;
+  typedef NoC_t::Packet_t Packet_t;
+  typedef AxiNoCManagerNI<axiCfg, Packet_t, numRegions, maxWrites> ManagerNI_t;
+  typedef AxiNoCSubordinateNI<axiCfg, Packet_t, maxWrites> SubordinateNI_t;
+  typedef ManagerNI_t::Node Node;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typedef typename axi_::read::template subordinate<>::ARPort axi_rd_subordinate_ar;
+  typedef typename axi_::read::template subordinate<>::RPort axi_rd_subordinate_r;
+  typedef typename axi_::write::template subordinate<>::AWPort axi_wr_subordinate_aw;
+  typedef typename axi_::write::template subordinate<>::WPort axi_wr_subordinate_w;
+  typedef typename axi_::write::template subordinate<>::BPort axi_wr_subordinate_b;
+
+  typedef typename axi_::read::template manager<>::ARPort axi_rd_manager_ar;
+  typedef typename axi_::read::template manager<>::RPort axi_rd_manager_r;
+  typedef typename axi_::write::template manager<>::AWPort axi_wr_manager_aw;
+  typedef typename axi_::write::template manager<>::WPort axi_wr_manager_w;
+  typedef typename axi_::write::template manager<>::BPort axi_wr_manager_b;
+
+  axi_rd_subordinate_ar axi_rd_m_ar[numManagers];
+  axi_rd_subordinate_r axi_rd_m_r[numManagers];
+  axi_wr_subordinate_aw axi_wr_m_aw[numManagers];
+  axi_wr_subordinate_w axi_wr_m_w[numManagers];
+  axi_wr_subordinate_b axi_wr_m_b[numManagers];
+
+  axi_rd_manager_ar axi_rd_s_ar[numSubordinates];
+  axi_rd_manager_r axi_rd_s_r[numSubordinates];
+  axi_wr_manager_aw axi_wr_s_aw[numSubordinates];
+  axi_wr_manager_w axi_wr_s_w[numSubordinates];
+  axi_wr_manager_b axi_wr_s_b[numSubordinates];
+
+  NoC_t noc;
+  nvhls::nv_array<ManagerNI_t, numManagers> manager_ni;
+  nvhls::nv_array<SubordinateNI_t, numSubordinates> subordinate_ni;
+
+  Connections::Combinational<Packet_t> noc_in[NoC_t::num_nodes];
+  Connections::Combinational<Packet_t> noc_out[NoC_t::num_nodes];
+
+  sc_signal<Node> node[numManagers];
+  sc_signal<NVUINTW(axiCfg::addrWidth)> addrBound[numRegions][2];
+  sc_signal<Node> regionNode[numRegions];
+
+  SC_HAS_PROCESS(AxiNoCTop);
+
+  AxiNoCTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        noc("noc"),
+        manager_ni("manager_ni"),
+        subordinate_ni("subordinate_ni") {
+    noc.clk(clk);
+    noc.rst(reset_bar);
+    for (int n = 0; n < NoC_t::num_nodes; n++) {
+      noc.in_packet[n](noc_in[n]);
+      noc.out_packet[n](noc_out[n]);
+    }
+
+    // Alternate 32KB regions between the subordinates
+    NVUINTW(axiCfg::addrWidth) addrBound_val[numRegions][2] = {
+        {0x00000, 0x07FFF}, {0x08000, 0x0FFFF}, {0x10000, 0x17FFF}, {0x18000, 0x1FFFF}};
+    for (int i = 0; i < numRegions; i++) {
+      for (int j = 0; j < 2; j++) {
+        addrBound[i][j].write(addrBound_val[i][j]);
+      }
+      // MeshNoC node n = y * 2 + x is addressed as (y << 1) | x, that is n
+      regionNode[i].write(numManagers + i % numSubordinates);
+    }
+
+    for (int i = 0; i < numManagers; i++) {
+      manager_ni[i].clk(clk);
+      manager_ni[i].reset_bar(reset_bar);
+      manager_ni[i].axi_read.ar(axi_rd_m_ar[i]);
+      manager_ni[i].axi_read.r(axi_rd_m_r[i]);
+      manager_ni[i].axi_write.aw(axi_wr_m_aw[i]);
+      manager_ni[i].axi_write.w(axi_wr_m_w[i]);
+      manager_ni[i].axi_write.b(axi_wr_m_b[i]);
+      manager_ni[i].out_packet(noc_in[i]);
+      manager_ni[i].in_packet(noc_out[i]);
+      manager_ni[i].node(node[i]);
+      node[i].write(i);
+      for (int j = 0; j < numRegions; j++) {
+        manager_ni[i].addrBound[j][0](addrBound[j][0]);
+        manager_ni[i].addrBound[j][1](addrBound[j][1]);
+        manager_ni[i].regionNode[j](regionNode[j]);
+      }
+    }
+
+    for (int i = 0; i < numSubordinates; i++) {
+      subordinate_ni[i].clk(clk);
+      subordinate_ni[i].reset_bar(reset_bar);
+      subordinate_ni[i].axi_read.ar(axi_rd_s_ar[i]);
+      subordinate_ni[i].axi_read.r(axi_rd_s_r[i]);
+      subordinate_ni[i].axi_write.aw(axi_wr_s_aw[i]);
+      subordinate_ni[i].axi_write.w(axi_wr_s_w[i]);
+      subordinate_ni[i].axi_write.b(axi_wr_s_b[i]);
+      subordinate_ni[i].out_packet(noc_in[numManagers + i]);
+      subordinate_ni[i].in_packet(noc_out[numManagers + i]);
+    }
+  }
+};
+
+#endif
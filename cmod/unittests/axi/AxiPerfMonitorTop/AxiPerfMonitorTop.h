@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AXI_PERF_MONITOR_TOP_H
+#define AXI_PERF_MONITOR_TOP_H
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <axi/axi4_configs.h>
+
+#include <axi/AxiPerfMonitor.h>
+#include <axi/AxiSubordinateToMem.h>
+
+#ifndef AXI_PERF_MONITOR_BINS
+#define AXI_PERF_MONITOR_BINS 16
+#endif
+
+// A performance monitor in front of a memory
+class AxiPerfMonitorTop : public sc_module {
+ public:
+  typedef typename axi::axi4<axi::cfg::standard> axi_;
+  typedef typename axi::axi4<axi::cfg::lite> lite_;
+  typedef AxiPerfMonitor<axi::cfg::standard, AXI_PERF_MONITOR_BINS> Monitor;
+  static const int kMemBytes = 16 * 1024;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axi_::read::template subordinate<> axi_read;
+  typename axi_::write::template subordinate<> axi_write;
+  typename lite_::read::template subordinate<> axi_ctrl_read;
+  typename lite_::write::template subordinate<> axi_ctrl_write;
+
+  Monitor monitor;
+  AxiSubordinateToMem<axi::cfg::standard, kMemBytes> mem;
+
+  typename axi_::read::template chan<> mem_read;
+  typename axi_::write::template chan<> mem_write;
+
+  SC_HAS_PROCESS(AxiPerfMonitorTop);
+
+  AxiPerfMonitorTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axi_read("axi_read"),
+        axi_write("axi_write"),
+        axi_ctrl_read("axi_ctrl_read"),
+        axi_ctrl_write("axi_ctrl_write"),
+        monitor("monitor"),
+        mem("mem"),
+        mem_read("mem_read"),
+        mem_write("mem_write")
+  {
+    monitor.clk(clk);
+    monitor.rst(reset_bar);
+    mem.clk(clk);
+    mem.reset_bar(reset_bar);
+
+    monitor.axiM_read(axi_read);
+    monitor.axiM_write(axi_write);
+    monitor.axiS_read(mem_read);
+    monitor.axiS_write(mem_write);
+    monitor.if_ctrl_rd(axi_ctrl_read);
+    monitor.if_ctrl_wr(axi_ctrl_write);
+    mem.if_rd(mem_read);
+    mem.if_wr(mem_write);
+  }
+};
+
+#endif
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+
+#include <axi/axi4.h>
+#include <mc_scverify.h>
+#include <axi/testbench/Manager.h>
+#include <testbench/nvhls_rand.h>
+#include "AxiPerfMonitorTop.h"
+
+SC_MODULE(testbench) {
+  typedef AxiPerfMonitorTop::axi_ axi_;
+  typedef AxiPerfMonitorTop::lite_ lite_;
+  typedef AxiPerfMonitorTop::Monitor Monitor;
+  static const int kNumBins = AXI_PERF_MONITOR_BINS;
+
+  struct managerCfg {
+    enum {
+      numWrites = 300,
+      numReads = 300,
+      readDelay = 0,
+      addrBoundLower = 0,
+      addrBoundUpper = AxiPerfMonitorTop::kMemBytes - 1,
+      seed = 0,
+      useFile = false,
+    };
+  };
+
+  CCS_DESIGN(AxiPerfMonitorTop) dut;
+  Manager<axi::cfg::standard, managerCfg> manager;
+
+  sc_clock clk;
+  sc_signal<bool> reset_bar;
+  sc_signal<bool> manager_reset_bar;
+  sc_signal<bool> done;
+
+  typename axi_::read::template chan<> axi_read;
+  typename axi_::write::template chan<> axi_write;
+  typename lite_::read::template chan<> axi_ctrl_read;
+  typename lite_::write::template chan<> axi_ctrl_write;
+
+  // Drives the register port
+  typename lite_::read::template manager<> ctrl_rd;
+  typename lite_::write::template manager<> ctrl_wr;
+
+  SC_CTOR(testbench)
+      : dut("dut"),
+        manager("manager"),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        reset_bar("reset_bar"),
+        manager_reset_bar("manager_reset_bar"),
+        axi_read("axi_read"),
+        axi_write("axi_write"),
+        axi_ctrl_read("axi_ctrl_read"),
+        axi_ctrl_write("axi_ctrl_write"),
+        ctrl_rd("ctrl_rd"),
+        ctrl_wr("ctrl_wr") {
+    Connections::set_sim_clk(&clk);
+
+    dut.clk(clk);
+    dut.reset_bar(reset_bar);
+    manager.clk(clk);
+    manager.reset_bar(manager_reset_bar);
+
+    manager.if_rd(axi_read);
+    manager.if_wr(axi_write);
+    manager.done(done);
+    dut.axi_read(axi_read);
+    dut.axi_write(axi_write);
+
+    ctrl_rd(axi_ctrl_read);
+    ctrl_wr(axi_ctrl_write);
+    dut.axi_ctrl_read(axi_ctrl_read);
+    dut.axi_ctrl_write(axi_ctrl_write);
+
+    SC_THREAD(run);
+    SC_THREAD(check_monitor);
+    sensitive << clk.posedge_event();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+  uint64 read_reg(int reg) {
+    typename lite_::AddrPayload ar;
+    ar.addr = reg * (lite_::DATA_WIDTH >> 3);
+    ctrl_rd.ar.Push(ar);
+    typename lite_::ReadPayload r = ctrl_rd.r.Pop();
+    if (r.resp != lite_::Enc::XRESP::OKAY) {
+      SC_REPORT_ERROR("testbench", "Monitor register read failed");
+    }
+    return r.data;
+  }
+
+  void write_reg(int reg, uint64 data) {
+    typename lite_::AddrPayload aw;
+    aw.addr = reg * (lite_::DATA_WIDTH >> 3);
+    ctrl_wr.aw.Push(aw);
+    typename lite_::WritePayload w;
+    w.data = data;
+    w.wstrb = ~0;
+    ctrl_wr.w.Push(w);
+    ctrl_wr.b.Pop();
+  }
+
+  // Set the bin width, run the manager, then check that the counters and
+  // histograms agree with each other
+  void check_monitor() {
+    ctrl_rd.reset();
+    ctrl_wr.reset();
+    manager_reset_bar.write(0);
+    wait();
+
+    while (read_reg(Monitor::kCtrl) != 0) {
+      wait();
+    }
+    if (read_reg(Monitor::kNumBins) != kNumBins) {
+      SC_REPORT_ERROR("testbench", "Wrong number of histogram bins");
+    }
+    write_reg(Monitor::kBinShift, 1);
+    manager_reset_bar.write(1);
+
+    while (!done.read()) {
+      wait();
+    }
+    wait(10);
+
+    uint64 rd_count = read_reg(Monitor::kRdLatCount);
+    uint64 wr_count = read_reg(Monitor::kWrLatCount);
+    uint64 rd_hist = 0, wr_hist = 0;
+    for (int i = 0; i < kNumBins; i++) {
+      rd_hist += read_reg(Monitor::kHist + i);
+      wr_hist += read_reg(Monitor::kHist + kNumBins + i);
+    }
+    DCOUT(sc_time_stamp() << " monitor: " << rd_count << " reads, "
+          << read_reg(Monitor::kRdBeats) << " read beats, average latency "
+          << read_reg(Monitor::kRdLatSum) / (rd_count ? rd_count : 1) << "; "
+          << wr_count << " writes, " << read_reg(Monitor::kWrBeats)
+          << " write beats, average latency "
+          << read_reg(Monitor::kWrLatSum) / (wr_count ? wr_count : 1) << endl);
+    if (wr_count != managerCfg::numWrites || rd_count == 0) {
+      SC_REPORT_ERROR("testbench", "Monitor missed transactions");
+    }
+    if (rd_hist != rd_count || wr_hist != wr_count) {
+      SC_REPORT_ERROR("testbench", "Histogram does not match the latency count");
+    }
+    if (read_reg(Monitor::kRdLatMax) * rd_count < read_reg(Monitor::kRdLatSum)) {
+      SC_REPORT_ERROR("testbench", "Maximum read latency is below the average");
+    }
+
+    write_reg(Monitor::kCtrl, 1);
+    while (read_reg(Monitor::kCtrl) != 0) {
+      wait();
+    }
+    if (read_reg(Monitor::kRdLatCount) != 0 || read_reg(Monitor::kHist) != 0) {
+      SC_REPORT_ERROR("testbench", "Statistics were not cleared");
+    }
+    sc_stop();
+  }
+
+  void run() {
+    reset_bar = 1;
+    wait(2, SC_NS);
+    reset_bar = 0;
+    wait(2, SC_NS);
+    reset_bar = 1;
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    DCOUT("TESTBENCH FAIL" << endl);
+  else
+    DCOUT("TESTBENCH PASS" << endl);
+  return rc;
+};
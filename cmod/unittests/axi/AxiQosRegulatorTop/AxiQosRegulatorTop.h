@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AXI_QOS_REGULATOR_TOP_H
+#define AXI_QOS_REGULATOR_TOP_H
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <axi/axi4_configs.h>
+
+#include <axi/AxiArbiter.h>
+#include <axi/AxiQosRegulator.h>
+#include <axi/AxiSubordinateToMem.h>
+#include <axi/AxiSubordinateToReg.h>
+
+struct qos_cfg {
+  enum {
+    dataWidth = 64,
+    useVariableBeatSize = 0,
+    useMisalignedAddresses = 0,
+    useLast = 1,
+    useWriteStrobes = 1,
+    useBurst = 1, useFixedBurst = 0, useWrapBurst = 0, maxBurstSize = 256,
+    useQoS = 1, useLock = 0, useProt = 0, useCache = 0, useRegion = 0,
+    aUserWidth = 0, wUserWidth = 0, bUserWidth = 0, rUserWidth = 0,
+    addrWidth = 32,
+    idWidth = 4,
+    useWriteResponses = 1,
+  };
+};
+
+// Two managers share a memory through a QoS-priority AxiArbiter, each behind
+// an AxiQosRegulator.  Registers 4*i to 4*i+3 of the AXI-Lite configuration
+// port are the rate, bucket, max_outstanding and qos of regulator i.
+class AxiQosRegulatorTop : public sc_module {
+ public:
+  typedef typename axi::axi4<qos_cfg> axi_;
+  typedef typename axi::axi4<axi::cfg::lite> lite_;
+  enum { numManagers = 2, numCfgReg = 4 * numManagers, numAddrBitsToInspect = 16 };
+  static const int kMemBytes = 16 * 1024;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename lite_::read::template subordinate<> axi_ctrl_read;
+  typename lite_::write::template subordinate<> axi_ctrl_write;
+
+  typename axi_::read::template subordinate<> axi_read_0;
+  typename axi_::write::template subordinate<> axi_write_0;
+  typename axi_::read::template subordinate<> axi_read_1;
+  typename axi_::write::template subordinate<> axi_write_1;
+
+  AxiSubordinateToReg<axi::cfg::lite, numCfgReg, numAddrBitsToInspect> cfg_regs;
+  AxiQosRegulator<qos_cfg> regulator_0;
+  AxiQosRegulator<qos_cfg> regulator_1;
+  AxiArbiter<qos_cfg, numManagers, 8, Roundrobin, false, true> arbiter;
+  AxiSubordinateToMem<qos_cfg, kMemBytes> mem;
+
+  typename axi_::read::template chan<> arb_read_0;
+  typename axi_::write::template chan<> arb_write_0;
+  typename axi_::read::template chan<> arb_read_1;
+  typename axi_::write::template chan<> arb_write_1;
+  typename axi_::read::template chan<> mem_read;
+  typename axi_::write::template chan<> mem_write;
+
+  sc_signal<NVUINTW(numAddrBitsToInspect)> ctrlBaseAddr;
+  sc_signal<NVUINTW(lite_::DATA_WIDTH)> cfg[numCfgReg];
+
+  SC_HAS_PROCESS(AxiQosRegulatorTop);
+
+  AxiQosRegulatorTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axi_ctrl_read("axi_ctrl_read"),
+        axi_ctrl_write("axi_ctrl_write"),
+        axi_read_0("axi_read_0"),
+        axi_write_0("axi_write_0"),
+        axi_read_1("axi_read_1"),
+        axi_write_1("axi_write_1"),
+        cfg_regs("cfg_regs"),
+        regulator_0("regulator_0"),
+        regulator_1("regulator_1"),
+        arbiter("arbiter"),
+        mem("mem"),
+        arb_read_0("arb_read_0"),
+        arb_write_0("arb_write_0"),
+        arb_read_1("arb_read_1"),
+        arb_write_1("arb_write_1"),
+        mem_read("mem_read"),
+        mem_write("mem_write")
+  {
+    cfg_regs.clk(clk);
+    cfg_regs.reset_bar(reset_bar);
+    regulator_0.clk(clk);
+    regulator_0.reset_bar(reset_bar);
+    regulator_1.clk(clk);
+    regulator_1.reset_bar(reset_bar);
+    arbiter.clk(clk);
+    arbiter.reset_bar(reset_bar);
+    mem.clk(clk);
+    mem.reset_bar(reset_bar);
+
+    cfg_regs.if_axi_rd(axi_ctrl_read);
+    cfg_regs.if_axi_wr(axi_ctrl_write);
+    cfg_regs.baseAddr(ctrlBaseAddr);
+    ctrlBaseAddr.write(0);
+
+#pragma hls_unroll yes
+    for (int i = 0; i < numCfgReg; i++) {
+      cfg_regs.regOut[i](cfg[i]);
+    }
+    regulator_0.rate(cfg[0]);
+    regulator_0.bucket(cfg[1]);
+    regulator_0.max_outstanding(cfg[2]);
+    regulator_0.qos(cfg[3]);
+    regulator_1.rate(cfg[4]);
+    regulator_1.bucket(cfg[5]);
+    regulator_1.max_outstanding(cfg[6]);
+    regulator_1.qos(cfg[7]);
+
+    regulator_0.axiM_read(axi_read_0);
+    regulator_0.axiM_write(axi_write_0);
+    regulator_0.axiS_read(arb_read_0);
+    regulator_0.axiS_write(arb_write_0);
+    regulator_1.axiM_read(axi_read_1);
+    regulator_1.axiM_write(axi_write_1);
+    regulator_1.axiS_read(arb_read_1);
+    regulator_1.axiS_write(arb_write_1);
+
+    arbiter.axi_rd_m_ar[0](arb_read_0.ar);
+    arbiter.axi_rd_m_r[0](arb_read_0.r);
+    arbiter.axi_wr_m_aw[0](arb_write_0.aw);
+    arbiter.axi_wr_m_w[0](arb_write_0.w);
+    arbiter.axi_wr_m_b[0](arb_write_0.b);
+    arbiter.axi_rd_m_ar[1](arb_read_1.ar);
+    arbiter.axi_rd_m_r[1](arb_read_1.r);
+    arbiter.axi_wr_m_aw[1](arb_write_1.aw);
+    arbiter.axi_wr_m_w[1](arb_write_1.w);
+    arbiter.axi_wr_m_b[1](arb_write_1.b);
+    arbiter.axi_rd_s(mem_read);
+    arbiter.axi_wr_s(mem_write);
+
+    mem.if_rd(mem_read);
+    mem.if_wr(mem_write);
+  }
+};
+
+#endif
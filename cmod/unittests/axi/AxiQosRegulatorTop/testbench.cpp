@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+
+#include <axi/axi4.h>
+#include <mc_scverify.h>
+#include <axi/testbench/Manager.h>
+#include <testbench/nvhls_rand.h>
+#include "AxiQosRegulatorTop.h"
+
+#ifndef QOS_RATE
+#define QOS_RATE 64
+#endif
+
+#ifndef QOS_MAX_OUTSTANDING
+#define QOS_MAX_OUTSTANDING 4
+#endif
+
+SC_MODULE(testbench) {
+  typedef AxiQosRegulatorTop::axi_ axi_;
+  typedef AxiQosRegulatorTop::lite_ lite_;
+  enum { numCfgReg = AxiQosRegulatorTop::numCfgReg };
+  static const int kHalfMem = AxiQosRegulatorTop::kMemBytes / 2;
+
+  // Each manager works in its own half of the memory
+  struct managerCfg0 {
+    enum {
+      numWrites = 200,
+      numReads = 200,
+      readDelay = 0,
+      addrBoundLower = 0,
+      addrBoundUpper = kHalfMem - 1,
+      seed = 0,
+      useFile = false,
+    };
+  };
+  struct managerCfg1 {
+    enum {
+      numWrites = 200,
+      numReads = 200,
+      readDelay = 0,
+      addrBoundLower = kHalfMem,
+      addrBoundUpper = 2 * kHalfMem - 1,
+      seed = 1,
+      useFile = false,
+    };
+  };
+
+  CCS_DESIGN(AxiQosRegulatorTop) dut;
+  Manager<qos_cfg, managerCfg0> manager_0;
+  Manager<qos_cfg, managerCfg1> manager_1;
+
+  sc_clock clk;
+  sc_signal<bool> reset_bar;
+  sc_signal<bool> manager_reset_bar;
+  sc_signal<bool> done_0;
+  sc_signal<bool> done_1;
+
+  typename lite_::read::template chan<> axi_ctrl_read;
+  typename lite_::write::template chan<> axi_ctrl_write;
+  typename axi_::read::template chan<> axi_read_0;
+  typename axi_::write::template chan<> axi_write_0;
+  typename axi_::read::template chan<> axi_read_1;
+  typename axi_::write::template chan<> axi_write_1;
+
+  // Drives the configuration port
+  typename lite_::read::template manager<> ctrl_rd;
+  typename lite_::write::template manager<> ctrl_wr;
+
+  SC_CTOR(testbench)
+      : dut("dut"),
+        manager_0("manager_0"),
+        manager_1("manager_1"),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        reset_bar("reset_bar"),
+        manager_reset_bar("manager_reset_bar"),
+        axi_ctrl_read("axi_ctrl_read"),
+        axi_ctrl_write("axi_ctrl_write"),
+        axi_read_0("axi_read_0"),
+        axi_write_0("axi_write_0"),
+        axi_read_1("axi_read_1"),
+        axi_write_1("axi_write_1"),
+        ctrl_rd("ctrl_rd"),
+        ctrl_wr("ctrl_wr") {
+    Connections::set_sim_clk(&clk);
+
+    dut.clk(clk);
+    dut.reset_bar(reset_bar);
+    manager_0.clk(clk);
+    manager_0.reset_bar(manager_reset_bar);
+    manager_1.clk(clk);
+    manager_1.reset_bar(manager_reset_bar);
+
+    ctrl_rd(axi_ctrl_read);
+    ctrl_wr(axi_ctrl_write);
+    dut.axi_ctrl_read(axi_ctrl_read);
+    dut.axi_ctrl_write(axi_ctrl_write);
+
+    manager_0.if_rd(axi_read_0);
+    manager_0.if_wr(axi_write_0);
+    manager_0.done(done_0);
+    dut.axi_read_0(axi_read_0);
+    dut.axi_write_0(axi_write_0);
+
+    manager_1.if_rd(axi_read_1);
+    manager_1.if_wr(axi_write_1);
+    manager_1.done(done_1);
+    dut.axi_read_1(axi_read_1);
+    dut.axi_write_1(axi_write_1);
+
+    SC_THREAD(run);
+    SC_THREAD(program_regulators);
+    sensitive << clk.posedge_event();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+  // Manager 0 is shaped and gets the lowest AxQOS; manager 1 is only given
+  // the highest AxQOS
+  static NVUINTW(lite_::DATA_WIDTH) setting(int reg) {
+    static const uint64 settings[numCfgReg] = {QOS_RATE, 16, QOS_MAX_OUTSTANDING, 0x10,
+                                               0, 0, 0, 0x1f};
+    return settings[reg];
+  }
+
+  // Program the regulators, then release the managers from reset
+  void program_regulators() {
+    ctrl_rd.reset();
+    ctrl_wr.reset();
+    manager_reset_bar.write(0);
+    wait();
+
+    for (int i = 0; i < numCfgReg; i++) {
+      typename lite_::AddrPayload aw;
+      aw.addr = i * (lite_::DATA_WIDTH >> 3);
+      ctrl_wr.aw.Push(aw);
+      typename lite_::WritePayload w;
+      w.data = setting(i);
+      w.wstrb = ~0;
+      ctrl_wr.w.Push(w);
+      ctrl_wr.b.Pop();
+    }
+
+    for (int i = 0; i < numCfgReg; i++) {
+      typename lite_::AddrPayload ar;
+      ar.addr = i * (lite_::DATA_WIDTH >> 3);
+      ctrl_rd.ar.Push(ar);
+      typename lite_::ReadPayload r = ctrl_rd.r.Pop();
+      if (r.data != setting(i)) {
+        SC_REPORT_ERROR("testbench", "Regulator register was not programmed");
+      }
+    }
+    manager_reset_bar.write(1);
+
+    while (1) {
+      wait();
+    }
+  }
+
+  void run() {
+    reset_bar = 1;
+    wait(2, SC_NS);
+    reset_bar = 0;
+    wait(2, SC_NS);
+    reset_bar = 1;
+
+    bool reported_0 = false, reported_1 = false;
+    while (1) {
+      wait(1, SC_NS);
+      if (done_0 && !reported_0) {
+        DCOUT(sc_time_stamp() << " regulated manager done" << endl);
+        reported_0 = true;
+      }
+      if (done_1 && !reported_1) {
+        DCOUT(sc_time_stamp() << " high-priority manager done" << endl);
+        reported_1 = true;
+      }
+      if (done_0 && done_1) {
+        sc_stop();
+      }
+    }
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  // Suppress mysterious time-zero X warnings in SCVerify
+  sc_report_handler::set_actions(SC_ID_LOGIC_X_TO_BOOL_,SC_DO_NOTHING);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    DCOUT("TESTBENCH FAIL" << endl);
+  else
+    DCOUT("TESTBENCH PASS" << endl);
+  return rc;
+};
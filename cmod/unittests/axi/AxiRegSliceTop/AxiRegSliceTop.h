@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AXI_REG_SLICE_TOP_H
+#define AXI_REG_SLICE_TOP_H
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <axi/axi4_configs.h>
+
+#include <axi/AxiRegSlice.h>
+#include <axi/AxiSubordinateToMem.h>
+
+#ifndef AXI_REG_SLICE_CHANNELS
+#define AXI_REG_SLICE_CHANNELS axi::reg_slice::ALL
+#endif
+
+#ifndef AXI_REG_SLICE_MODE
+#define AXI_REG_SLICE_MODE axi::reg_slice::FULL
+#endif
+
+// A register slice in front of a memory
+class AxiRegSliceTop : public sc_module {
+ public:
+  typedef typename axi::axi4<axi::cfg::standard> axi_;
+  static const int kMemBytes = 16 * 1024;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axi_::read::template subordinate<> axi_read;
+  typename axi_::write::template subordinate<> axi_write;
+
+  AxiRegSlice<axi::cfg::standard, AXI_REG_SLICE_CHANNELS, AXI_REG_SLICE_MODE> slice;
+  AxiSubordinateToMem<axi::cfg::standard, kMemBytes> mem;
+
+  typename axi_::read::template chan<> mem_read;
+  typename axi_::write::template chan<> mem_write;
+
+  SC_HAS_PROCESS(AxiRegSliceTop);
+
+  AxiRegSliceTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axi_read("axi_read"),
+        axi_write("axi_write"),
+        slice("slice"),
+        mem("mem"),
+        mem_read("mem_read"),
+        mem_write("mem_write")
+  {
+    slice.clk(clk);
+    slice.reset_bar(reset_bar);
+    mem.clk(clk);
+    mem.reset_bar(reset_bar);
+
+    slice.axiM_read(axi_read);
+    slice.axiM_write(axi_write);
+    slice.axiS_read(mem_read);
+    slice.axiS_write(mem_write);
+    mem.if_rd(mem_read);
+    mem.if_wr(mem_write);
+  }
+};
+
+#endif
@@ -25,6 +25,10 @@
 #include <axi/AxiArbiter.h>
 #include <testbench/nvhls_rand.h>
 
+#ifndef AXI_SPLITTER_MAX_READS
+#define AXI_SPLITTER_MAX_READS 1
+#endif
+
 SC_MODULE(testbench) {
  public:
   enum { numSubordinates = 2, numAddrBitsToInspect = 20 };
@@ -70,7 +74,8 @@ SC_MODULE(testbench) {
   typename axi::axi4<axi::cfg::standard>::read::template chan<> axi_read_tb_int;
   typename axi::axi4<axi::cfg::standard>::write::template chan<> axi_write_tb_int;
 
-  AxiSplitter<axi::cfg::standard, numSubordinates, numAddrBitsToInspect> axi_splitter;
+  AxiSplitter<axi::cfg::standard, numSubordinates, numAddrBitsToInspect, false,
+              false, AXI_SPLITTER_MAX_READS> axi_splitter;
 
   nvhls::nv_array<typename axi::axi4<axi::cfg::standard>::read::template chan<>, numSubordinates>
       axi_read_s;
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AXI_SPLITTER_RANGE_TABLE_TOP_H
+#define AXI_SPLITTER_RANGE_TABLE_TOP_H
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+
+#include <axi/axi4.h>
+#include <axi/AxiSplitter.h>
+#include <axi/AxiSubordinateToReg.h>
+
+// An AxiSplitter whose address ranges are registers of an AxiSubordinateToReg.
+// Register 2*i holds the base and register 2*i+1 the limit of subordinate i.
+class AxiSplitterRangeTableTop : public sc_module {
+ public:
+  typedef axi::axi4<axi::cfg::standard> axi_;
+  enum { numSubordinates = 3, numAddrBitsToInspect = 20, numRangeReg = 2 * numSubordinates };
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  // Range table programming port
+  typename axi_::read::template subordinate<> axi_ctrl_read;
+  typename axi_::write::template subordinate<> axi_ctrl_write;
+
+  typename axi_::read::template subordinate<> axi_read;
+  typename axi_::write::template subordinate<> axi_write;
+
+  nvhls::nv_array<typename axi_::read::template manager<>::ARPort, numSubordinates> axi_rd_s_ar;
+  nvhls::nv_array<typename axi_::read::template manager<>::RPort, numSubordinates> axi_rd_s_r;
+  nvhls::nv_array<typename axi_::write::template manager<>::AWPort, numSubordinates> axi_wr_s_aw;
+  nvhls::nv_array<typename axi_::write::template manager<>::WPort, numSubordinates> axi_wr_s_w;
+  nvhls::nv_array<typename axi_::write::template manager<>::BPort, numSubordinates> axi_wr_s_b;
+
+  AxiSubordinateToReg<axi::cfg::standard, numRangeReg, numAddrBitsToInspect> range_regs;
+  AxiSplitter<axi::cfg::standard, numSubordinates, numAddrBitsToInspect, false,
+              false, 2, 4, axi_::DATA_WIDTH> splitter;
+
+  sc_signal<NVUINTW(numAddrBitsToInspect)> ctrlBaseAddr;
+  sc_signal<NVUINTW(axi_::DATA_WIDTH)> addrBound[numRangeReg];
+
+  SC_HAS_PROCESS(AxiSplitterRangeTableTop);
+
+  AxiSplitterRangeTableTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axi_ctrl_read("axi_ctrl_read"),
+        axi_ctrl_write("axi_ctrl_write"),
+        axi_read("axi_read"),
+        axi_write("axi_write"),
+        axi_rd_s_ar("axi_rd_s_ar"),
+        axi_rd_s_r("axi_rd_s_r"),
+        axi_wr_s_aw("axi_wr_s_aw"),
+        axi_wr_s_w("axi_wr_s_w"),
+        axi_wr_s_b("axi_wr_s_b"),
+        range_regs("range_regs"),
+        splitter("splitter")
+  {
+    range_regs.clk(clk);
+    range_regs.reset_bar(reset_bar);
+    splitter.clk(clk);
+    splitter.reset_bar(reset_bar);
+
+    range_regs.if_axi_rd(axi_ctrl_read);
+    range_regs.if_axi_wr(axi_ctrl_write);
+    range_regs.baseAddr(ctrlBaseAddr);
+    ctrlBaseAddr.write(0);
+
+    splitter.axi_rd_m(axi_read);
+    splitter.axi_wr_m(axi_write);
+
+#pragma hls_unroll yes
+    for (int i = 0; i < numSubordinates; i++) {
+      splitter.axi_rd_s_ar[i](axi_rd_s_ar[i]);
+      splitter.axi_rd_s_r[i](axi_rd_s_r[i]);
+      splitter.axi_wr_s_aw[i](axi_wr_s_aw[i]);
+      splitter.axi_wr_s_w[i](axi_wr_s_w[i]);
+      splitter.axi_wr_s_b[i](axi_wr_s_b[i]);
+    }
+
+#pragma hls_unroll yes
+    for (int i = 0; i < numRangeReg; i++) {
+      range_regs.regOut[i](addrBound[i]);
+      splitter.addrBound[i / 2][i % 2](addrBound[i]);
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AXI_SUBORDINATE_TO_BANKED_MEM_TOP_H
+#define AXI_SUBORDINATE_TO_BANKED_MEM_TOP_H
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <axi/axi4_configs.h>
+
+#include <axi/AxiSubordinateToBankedMem.h>
+
+#ifndef BANKED_MEM_BANK_WIDTH
+#define BANKED_MEM_BANK_WIDTH 128
+#endif
+
+// 512-bit AXI port with narrow transfers and write strobes
+struct wide_cfg {
+  enum {
+    dataWidth = 512,
+    useVariableBeatSize = 1,
+    useMisalignedAddresses = 1,
+    useLast = 1,
+    useWriteStrobes = 1,
+    useBurst = 1, useFixedBurst = 0, useWrapBurst = 0, maxBurstSize = 16,
+    useQoS = 0, useLock = 0, useProt = 0, useCache = 0, useRegion = 0,
+    aUserWidth = 0, wUserWidth = 0, bUserWidth = 0, rUserWidth = 0,
+    addrWidth = 32,
+    idWidth = 4,
+    useWriteResponses = 1,
+  };
+};
+
+class AxiSubordinateToBankedMemTop : public sc_module {
+ public:
+  static const int kDebugLevel = 4;
+  static const int kMemBytes = 16 * 1024;
+  typedef typename axi::axi4<wide_cfg> axi_;
+  typedef AxiSubordinateToBankedMem<wide_cfg, kMemBytes, BANKED_MEM_BANK_WIDTH> Mem;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axi_::read::template subordinate<> axi_read;
+  typename axi_::write::template subordinate<> axi_write;
+
+  Mem subordinate;
+
+  SC_HAS_PROCESS(AxiSubordinateToBankedMemTop);
+
+  AxiSubordinateToBankedMemTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axi_read("axi_read"),
+        axi_write("axi_write"),
+        subordinate("subordinate")
+  {
+    subordinate.clk(clk);
+    subordinate.reset_bar(reset_bar);
+
+    subordinate.if_rd(axi_read);
+    subordinate.if_wr(axi_write);
+  }
+};
+
+#endif
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+
+#include <vector>
+#include <mc_scverify.h>
+#include <testbench/nvhls_rand.h>
+#include "AxiSubordinateToBankedMemTop.h"
+
+SC_MODULE(testbench) {
+  typedef AxiSubordinateToBankedMemTop::axi_ axi_;
+  typedef AxiSubordinateToBankedMemTop::Mem Mem;
+  static const int kMemBytes = AxiSubordinateToBankedMemTop::kMemBytes;
+  static const int kNumBursts = 400;
+
+  CCS_DESIGN(AxiSubordinateToBankedMemTop) dut;
+
+  sc_clock clk;
+  sc_signal<bool> reset_bar;
+
+  axi_::read::template chan<> axi_read;
+  axi_::write::template chan<> axi_write;
+
+  axi_::read::template manager<> mem_rd;
+  axi_::write::template manager<> mem_wr;
+
+  std::vector<unsigned char> model;
+
+  SC_CTOR(testbench)
+      : dut("dut"),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        reset_bar("reset_bar"),
+        axi_read("axi_read"),
+        axi_write("axi_write"),
+        mem_rd("mem_rd"),
+        mem_wr("mem_wr"),
+        model(kMemBytes, 0) {
+    dut.clk(clk);
+    dut.reset_bar(reset_bar);
+
+    dut.axi_read(axi_read);
+    mem_rd(axi_read);
+    dut.axi_write(axi_write);
+    mem_wr(axi_write);
+
+    SC_THREAD(run);
+    SC_THREAD(source);
+    sensitive << clk.pos();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+  // Random INCR burst of 2^size-byte beats that stays inside the memory
+  static axi_::AddrPayload random_burst(int id) {
+    axi_::AddrPayload pld;
+    int size = rand() % (Mem::log2BytesPerWord + 1);
+    int len = rand() % wide_cfg::maxBurstSize;
+    int span = (len + 1) << size;
+    pld.id = id;
+    pld.size = size;
+    pld.len = len;
+    pld.addr = rand() % (kMemBytes - span);
+    return pld;
+  }
+
+  // First and one-past-last byte lane of beat i
+  static void beat_lanes(const axi_::AddrPayload& pld, int i, unsigned& addr,
+                         int& lo, int& hi) {
+    int bytes = 1 << pld.size.to_uint();
+    unsigned start = pld.addr.to_uint();
+    unsigned aligned = start & ~(bytes - 1);
+    addr = (i == 0) ? start : aligned + i * bytes;
+    lo = addr % Mem::bytesPerWord;
+    hi = ((addr & ~(bytes - 1)) % Mem::bytesPerWord) + bytes;
+  }
+
+  void source() {
+    mem_rd.reset();
+    mem_wr.reset();
+    wait();
+
+    unsigned read_beats = 0;
+    for (int n = 0; n < kNumBursts; n++) {
+      axi_::AddrPayload aw = random_burst(n % 16);
+      mem_wr.aw.Push(aw);
+      for (int i = 0; i <= aw.len; i++) {
+        unsigned addr;
+        int lo, hi;
+        beat_lanes(aw, i, addr, lo, hi);
+        axi_::WritePayload w;
+        w.data = 0;
+        w.wstrb = 0;
+        for (int j = 0; j < Mem::bytesPerWord; j++) {
+          unsigned char byte = rand() & 0xff;
+          bool strb = (rand() % 4 != 0);
+          w.data = nvhls::set_slc(w.data, NVUINTW(8)(byte), 8 * j);
+          w.wstrb[j] = strb;
+          if (strb && j >= lo && j < hi) {
+            model[addr - addr % Mem::bytesPerWord + j] = byte;
+          }
+        }
+        w.last = (i == aw.len);
+        mem_wr.w.Push(w);
+      }
+      mem_wr.b.Pop();
+
+      axi_::AddrPayload ar = random_burst(n % 16);
+      mem_rd.ar.Push(ar);
+      for (int i = 0; i <= ar.len; i++) {
+        unsigned addr;
+        int lo, hi;
+        beat_lanes(ar, i, addr, lo, hi);
+        axi_::ReadPayload r = mem_rd.r.Pop();
+        for (int j = lo; j < hi; j++) {
+          unsigned char byte = nvhls::get_slc<8>(r.data, 8 * j).to_uint();
+          if (byte != model[addr - addr % Mem::bytesPerWord + j]) {
+            SC_REPORT_ERROR("testbench", "Read data does not match memory");
+          }
+        }
+        if (r.last != (i == ar.len)) {
+          SC_REPORT_ERROR("testbench", "Read last flag is wrong");
+        }
+        read_beats++;
+      }
+    }
+    DCOUT(sc_time_stamp() << " read " << read_beats << " beats" << endl);
+    sc_stop();
+  }
+
+  void run() {
+    reset_bar = 1;
+    wait(2, SC_NS);
+    reset_bar = 0;
+    wait(2, SC_NS);
+    reset_bar = 1;
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  nvhls::set_random_seed();
+  testbench tb("tb");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    DCOUT("TESTBENCH FAIL" << endl);
+  else
+    DCOUT("TESTBENCH PASS" << endl);
+  return rc;
+};
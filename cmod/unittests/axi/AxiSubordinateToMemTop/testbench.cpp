@@ -22,6 +22,10 @@
 #include <testbench/nvhls_rand.h>
 #include "AxiSubordinateToMemTop.h"
 
+#ifndef TRAFFIC_PROFILE
+#define TRAFFIC_PROFILE axi::traffic::random
+#endif
+
 SC_MODULE(testbench) {
   typedef typename axi::axi4<axi::cfg::no_wstrb> axi_;
 
@@ -37,7 +41,7 @@ SC_MODULE(testbench) {
   };
 
   CCS_DESIGN(AxiSubordinateToMemTop) subordinate;
-  Manager<axi::cfg::no_wstrb, memManagerCfg> manager;
+  Manager<axi::cfg::no_wstrb, memManagerCfg, TRAFFIC_PROFILE> manager;
 
   sc_clock clk;
   sc_signal<bool> reset_bar;
@@ -80,6 +84,8 @@ SC_MODULE(testbench) {
     while (1) {
       wait(1, SC_NS);
       if (done) {
+        DCOUT(sc_time_stamp() << " All " << memManagerCfg::numWrites << " writes and "
+              << memManagerCfg::numReads << " reads completed" << endl);
         sc_stop();
       }
     }
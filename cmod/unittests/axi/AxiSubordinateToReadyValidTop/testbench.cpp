@@ -32,8 +32,7 @@ SC_MODULE(testbench) {
     enum {
       numWrites = 100,
       numReads = 100,
-      readDelay = 200,  // Subordinate arbitrates reads and writes, so there's no
-                        // guarantee that reads won't race ahead
+      readDelay = 0,  // Write responses wait until the writes reach the RV interface
       addrBoundLower = 0x0,
       addrBoundUpper = (1 << 20) - 1,
       seed = 0,
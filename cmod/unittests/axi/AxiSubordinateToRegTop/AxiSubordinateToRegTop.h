@@ -22,12 +22,30 @@
 #include <axi/axi4.h>
 #include <axi/AxiSubordinateToReg.h>
 
+// Register width of AxiSubordinateToReg; narrower registers share a beat
+#ifndef REG_WIDTH
+#define REG_WIDTH 64
+#endif
+
+// Shadow bank of AxiSubordinateToCSReg, see sim_shadowreg
+#ifdef SHADOW_REG
+#define USE_SHADOW_REG true
+#else
+#define USE_SHADOW_REG false
+#endif
+
 class AxiSubordinateToRegTop : public sc_module {
  public:
   static const int kDebugLevel = 4;
 
   typedef axi::axi4<axi::cfg::standard> axi_;
-  enum { numControlReg = 128, numStatusReg = 16, baseAddress = 0x100, numAddrBitsToInspect = 16 };
+#ifdef STATUS_REG
+  enum { regWidth = axi_::DATA_WIDTH };
+#else
+  enum { regWidth = REG_WIDTH };
+#endif
+  enum { numControlReg = 128 * axi_::DATA_WIDTH / regWidth, numStatusReg = 16, baseAddress = 0x100, numAddrBitsToInspect = 16 };
+  typedef NVUINTW(regWidth) Reg;
 
   sc_in<bool> clk;
   sc_in<bool> reset_bar;
@@ -36,13 +54,13 @@ class AxiSubordinateToRegTop : public sc_module {
   typename axi_::write::template subordinate<> axi_write;
 
 #ifdef STATUS_REG
-  AxiSubordinateToCSReg<axi::cfg::standard, numControlReg, numStatusReg, numAddrBitsToInspect> subordinate;
+  AxiSubordinateToCSReg<axi::cfg::standard, numControlReg, numStatusReg, numAddrBitsToInspect, USE_SHADOW_REG> subordinate;
 #else
-  AxiSubordinateToReg<axi::cfg::standard, numControlReg, numAddrBitsToInspect> subordinate;
+  AxiSubordinateToReg<axi::cfg::standard, numControlReg, numAddrBitsToInspect, regWidth> subordinate;
 #endif
 
   sc_signal<NVUINTW(numAddrBitsToInspect)> baseAddr;
-  sc_out<NVUINTW(axi_::DATA_WIDTH)> regOut[numControlReg];
+  sc_out<Reg> regOut[numControlReg];
 #ifdef STATUS_REG
   sc_in<NVUINTW(axi_::DATA_WIDTH)> regIn[numStatusReg];
 #endif
@@ -54,7 +54,7 @@ SC_MODULE(testbench) {
   typename axi_::read::template chan<> axi_read;
   typename axi_::write::template chan<> axi_write;
 
-  sc_signal<NVUINTW(axi::axi4<axi::cfg::standard>::DATA_WIDTH)> regOut[numControlReg];
+  sc_signal<AxiSubordinateToRegTop::Reg> regOut[numControlReg];
 #ifdef STATUS_REG
   sc_signal<NVUINTW(axi::axi4<axi::cfg::standard>::DATA_WIDTH)> regIn[numStatusReg];
 #endif
@@ -105,6 +105,14 @@ SC_MODULE(testbench) {
     while (1) {
       wait(1, SC_NS);
       if (done) {
+#ifdef SHADOW_REG
+        // The random traffic never writes the commit register
+        for (int i = 0; i < numControlReg; i++) {
+          if (regOut[i].read() != 0) {
+            SC_REPORT_ERROR("testbench", "Shadow register reached regOut without a commit");
+          }
+        }
+#endif
         sc_stop();
       }
     }
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AXI_WIDTH_CONVERTER_TOP_H
+#define AXI_WIDTH_CONVERTER_TOP_H
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <axi/axi4_configs.h>
+
+#include <axi/AxiWidthConverter.h>
+#include <axi/AxiSubordinateToBankedMem.h>
+
+#ifndef AXI_WIDTH_CONVERTER_WIDE_WIDTH
+#define AXI_WIDTH_CONVERTER_WIDE_WIDTH 512
+#endif
+
+struct wide_cfg {
+  enum {
+    dataWidth = AXI_WIDTH_CONVERTER_WIDE_WIDTH,
+    useVariableBeatSize = 0,
+    useMisalignedAddresses = 0,
+    useLast = 1,
+    useWriteStrobes = 1,
+    useBurst = 1, useFixedBurst = 0, useWrapBurst = 0, maxBurstSize = 256,
+    useQoS = 0, useLock = 0, useProt = 0, useCache = 0, useRegion = 0,
+    aUserWidth = 0, wUserWidth = 0, bUserWidth = 0, rUserWidth = 0,
+    addrWidth = 32,
+    idWidth = 4,
+    useWriteResponses = 1,
+  };
+};
+
+// A 64-bit manager upsized onto a wide link, then downsized back onto a
+// 64-bit memory
+class AxiWidthConverterTop : public sc_module {
+ public:
+  typedef typename axi::axi4<axi::cfg::standard> axi_;
+  typedef typename axi::axi4<wide_cfg> wide_;
+  static const int kMemBytes = 16 * 1024;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axi_::read::template subordinate<> axi_read;
+  typename axi_::write::template subordinate<> axi_write;
+
+  AxiWidthConverter<axi::cfg::standard, wide_cfg> upsizer;
+  AxiWidthConverter<wide_cfg, axi::cfg::standard> downsizer;
+  AxiSubordinateToBankedMem<axi::cfg::standard, kMemBytes, 32> mem;
+
+  typename wide_::read::template chan<> wide_read;
+  typename wide_::write::template chan<> wide_write;
+  typename axi_::read::template chan<> mem_read;
+  typename axi_::write::template chan<> mem_write;
+
+  SC_HAS_PROCESS(AxiWidthConverterTop);
+
+  AxiWidthConverterTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axi_read("axi_read"),
+        axi_write("axi_write"),
+        upsizer("upsizer"),
+        downsizer("downsizer"),
+        mem("mem"),
+        wide_read("wide_read"),
+        wide_write("wide_write"),
+        mem_read("mem_read"),
+        mem_write("mem_write")
+  {
+    upsizer.clk(clk);
+    upsizer.reset_bar(reset_bar);
+    downsizer.clk(clk);
+    downsizer.reset_bar(reset_bar);
+    mem.clk(clk);
+    mem.reset_bar(reset_bar);
+
+    upsizer.axiM_read(axi_read);
+    upsizer.axiM_write(axi_write);
+    upsizer.axiS_read(wide_read);
+    upsizer.axiS_write(wide_write);
+    downsizer.axiM_read(wide_read);
+    downsizer.axiM_write(wide_write);
+    downsizer.axiS_read(mem_read);
+    downsizer.axiS_write(mem_write);
+    mem.if_rd(mem_read);
+    mem.if_wr(mem_write);
+  }
+};
+
+#endif
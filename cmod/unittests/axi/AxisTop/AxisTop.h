@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AXIS_TOP_H
+#define AXIS_TOP_H
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <axi/axi4_configs.h>
+#include <axi/axis_configs.h>
+
+#include <axi/AxiSubordinateToAxis.h>
+#include <axi/AxisWidthConverter.h>
+#include <axi/AxisPacketFifo.h>
+
+#ifndef AXIS_STORE_AND_FORWARD
+#define AXIS_STORE_AND_FORWARD true
+#endif
+
+// AXI writes are turned into stream packets, upsized onto a wide datapath,
+// buffered in a packet FIFO, downsized again and returned through AXI reads
+class AxisTop : public sc_module {
+ public:
+  typedef typename axi::axi4<axi::cfg::standard> axi_;
+  typedef typename axi::axis<axi::cfg::stream::standard> narrow_;
+  typedef typename axi::axis<axi::cfg::stream::wide> wide_;
+  static const int kFifoDepth = 8;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  typename axi_::read::template subordinate<> axi_read;
+  typename axi_::write::template subordinate<> axi_write;
+
+  AxiSubordinateToAxis<axi::cfg::standard, axi::cfg::stream::standard> bridge;
+  AxisWidthConverter<axi::cfg::stream::standard, axi::cfg::stream::wide> upsizer;
+  AxisPacketFifo<axi::cfg::stream::wide, kFifoDepth, AXIS_STORE_AND_FORWARD> fifo;
+  AxisWidthConverter<axi::cfg::stream::wide, axi::cfg::stream::standard> downsizer;
+
+  typename narrow_::template chan<> narrow_out;
+  typename wide_::template chan<> wide_in;
+  typename wide_::template chan<> wide_out;
+  typename narrow_::template chan<> narrow_in;
+
+  SC_HAS_PROCESS(AxisTop);
+
+  AxisTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        axi_read("axi_read"),
+        axi_write("axi_write"),
+        bridge("bridge"),
+        upsizer("upsizer"),
+        fifo("fifo"),
+        downsizer("downsizer"),
+        narrow_out("narrow_out"),
+        wide_in("wide_in"),
+        wide_out("wide_out"),
+        narrow_in("narrow_in")
+  {
+    bridge.clk(clk);
+    bridge.reset_bar(reset_bar);
+    upsizer.clk(clk);
+    upsizer.reset_bar(reset_bar);
+    fifo.clk(clk);
+    fifo.reset_bar(reset_bar);
+    downsizer.clk(clk);
+    downsizer.reset_bar(reset_bar);
+
+    bridge.if_axi_rd(axi_read);
+    bridge.if_axi_wr(axi_write);
+
+    bridge.axis_out(narrow_out);
+    upsizer.axisM(narrow_out);
+    upsizer.axisS(wide_in);
+    fifo.axisM(wide_in);
+    fifo.axisS(wide_out);
+    downsizer.axisM(wide_out);
+    downsizer.axisS(narrow_in);
+    bridge.axis_in(narrow_in);
+  }
+};
+
+#endif
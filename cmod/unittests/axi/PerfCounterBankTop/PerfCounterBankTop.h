@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PERF_COUNTER_BANK_TOP_H
+#define PERF_COUNTER_BANK_TOP_H
+
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+#include <axi/axi4_configs.h>
+
+#include <axi/PerfCounterBank.h>
+
+#ifndef PERF_COUNTER_WIDTH
+#define PERF_COUNTER_WIDTH 8
+#endif
+
+// Four counters of two-bit increments, narrow enough by default to overflow
+class PerfCounterBankTop : public sc_module {
+ public:
+  typedef typename axi::axi4<axi::cfg::lite> lite_;
+  typedef PerfCounterBank<4, PERF_COUNTER_WIDTH, 2> Bank;
+  static const int kNumCounters = 4;
+
+  sc_in<bool> clk;
+  sc_in<bool> reset_bar;
+
+  sc_in<Bank::Inc> event[kNumCounters];
+  sc_out<bool> interrupt;
+
+  typename lite_::read::template subordinate<> axi_ctrl_read;
+  typename lite_::write::template subordinate<> axi_ctrl_write;
+
+  Bank bank;
+
+  SC_HAS_PROCESS(PerfCounterBankTop);
+
+  PerfCounterBankTop(sc_module_name name)
+      : sc_module(name),
+        clk("clk"),
+        reset_bar("reset_bar"),
+        interrupt("interrupt"),
+        axi_ctrl_read("axi_ctrl_read"),
+        axi_ctrl_write("axi_ctrl_write"),
+        bank("bank")
+  {
+    bank.clk(clk);
+    bank.rst(reset_bar);
+    for (int i = 0; i < kNumCounters; i++) {
+      bank.event[i](event[i]);
+    }
+    bank.interrupt(interrupt);
+    bank.if_rd(axi_ctrl_read);
+    bank.if_wr(axi_ctrl_write);
+  }
+};
+
+#endif
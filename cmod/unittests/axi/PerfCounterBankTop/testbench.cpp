@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License")
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <systemc.h>
+#include <ac_reset_signal_is.h>
+
+#include <axi/axi4.h>
+#include <mc_scverify.h>
+#include <map>
+#include <string>
+#include "PerfCounterBankTop.h"
+
+SC_MODULE(testbench) {
+  typedef PerfCounterBankTop::lite_ lite_;
+  typedef PerfCounterBankTop::Bank Bank;
+  static const int kNumCounters = PerfCounterBankTop::kNumCounters;
+  static const int kWidth = PERF_COUNTER_WIDTH;
+
+  CCS_DESIGN(PerfCounterBankTop) dut;
+
+  sc_clock clk;
+  sc_signal<bool> reset_bar;
+  sc_signal<Bank::Inc> event[kNumCounters];
+  sc_signal<bool> interrupt;
+
+  typename lite_::read::template chan<> axi_ctrl_read;
+  typename lite_::write::template chan<> axi_ctrl_write;
+
+  // Drives the register port
+  typename lite_::read::template manager<> ctrl_rd;
+  typename lite_::write::template manager<> ctrl_wr;
+
+  SC_CTOR(testbench)
+      : dut("dut"),
+        clk("clk", 1.0, SC_NS, 0.5, 0, SC_NS, true),
+        reset_bar("reset_bar"),
+        interrupt("interrupt"),
+        axi_ctrl_read("axi_ctrl_read"),
+        axi_ctrl_write("axi_ctrl_write"),
+        ctrl_rd("ctrl_rd"),
+        ctrl_wr("ctrl_wr") {
+    Connections::set_sim_clk(&clk);
+
+    dut.clk(clk);
+    dut.reset_bar(reset_bar);
+    for (int i = 0; i < kNumCounters; i++) {
+      dut.event[i](event[i]);
+    }
+    dut.interrupt(interrupt);
+
+    ctrl_rd(axi_ctrl_read);
+    ctrl_wr(axi_ctrl_write);
+    dut.axi_ctrl_read(axi_ctrl_read);
+    dut.axi_ctrl_write(axi_ctrl_write);
+
+    SC_THREAD(run);
+    SC_THREAD(check_counters);
+    sensitive << clk.posedge_event();
+    async_reset_signal_is(reset_bar, false);
+  }
+
+  uint64 read_reg(int reg) {
+    typename lite_::AddrPayload ar;
+    ar.addr = reg * (lite_::DATA_WIDTH >> 3);
+    ctrl_rd.ar.Push(ar);
+    typename lite_::ReadPayload r = ctrl_rd.r.Pop();
+    if (r.resp != lite_::Enc::XRESP::OKAY) {
+      SC_REPORT_ERROR("testbench", "Counter register read failed");
+    }
+    return r.data;
+  }
+
+  void write_reg(int reg, uint64 data) {
+    typename lite_::AddrPayload aw;
+    aw.addr = reg * (lite_::DATA_WIDTH >> 3);
+    ctrl_wr.aw.Push(aw);
+    typename lite_::WritePayload w;
+    w.data = data;
+    w.wstrb = ~0;
+    ctrl_wr.w.Push(w);
+    ctrl_wr.b.Pop();
+  }
+
+  uint64 read_counter(int base, int i) {
+    uint64 value = 0;
+    for (int w = 0; w < Bank::wordsPerCounter; w++) {
+      value |= read_reg(base + i * Bank::wordsPerCounter + w) << (32 * w);
+    }
+    return value;
+  }
+
+  static uint64 wrap(uint64 value) { return value & ((1ULL << kWidth) - 1); }
+
+  // Counter 0 counts every cycle, 1 by 3 every cycle, 2 never, 3 every other cycle
+  void drive(int cycles) {
+    for (int c = 0; c < cycles; c++) {
+      Bank::Inc inc[kNumCounters] = {1, 3, 0, Bank::Inc(c & 1)};
+      for (int i = 0; i < kNumCounters; i++) {
+        event[i].write(inc[i]);
+      }
+      wait();
+    }
+    for (int i = 0; i < kNumCounters; i++) {
+      event[i].write(0);
+    }
+    wait(2);
+  }
+
+  void check(int base, const uint64* expected, const char* what) {
+    for (int i = 0; i < kNumCounters; i++) {
+      uint64 value = read_counter(base, i);
+      if (value != wrap(expected[i])) {
+        DCOUT(what << " " << i << ": " << value << " != " << wrap(expected[i]) << endl);
+        SC_REPORT_ERROR("testbench", "Wrong counter value");
+      }
+    }
+  }
+
+  void check_counters() {
+    ctrl_rd.reset();
+    ctrl_wr.reset();
+    for (int i = 0; i < kNumCounters; i++) {
+      event[i].write(0);
+    }
+    wait();
+
+    if (read_reg(Bank::kInfo) != (kNumCounters | (kWidth << 16))) {
+      SC_REPORT_ERROR("testbench", "Wrong INFO register");
+    }
+    write_reg(Bank::kOvfEnable, 2);
+
+    // Counts from a clear
+    drive(100);
+    uint64 first[kNumCounters] = {100, 300, 0, 50};
+    check(Bank::kCounters, first, "counter");
+    bool wraps = (300ULL >> kWidth) != 0;
+    if (read_reg(Bank::kOvfStatus) != (wraps ? 2u : 0u) || interrupt.read() != wraps) {
+      SC_REPORT_ERROR("testbench", "Wrong overflow status");
+    }
+    write_reg(Bank::kOvfStatus, 2);
+    wait(2);
+    if (read_reg(Bank::kOvfStatus) != 0 || interrupt.read()) {
+      SC_REPORT_ERROR("testbench", "Overflow status not cleared");
+    }
+
+    // Snapshots hold still while the counters run on
+    write_reg(Bank::kCtrl, Bank::kCtrlSnapshot);
+    drive(10);
+    uint64 second[kNumCounters] = {110, 330, 0, 55};
+    check(Bank::kSnapshots, first, "snapshot");
+    check(Bank::kCounters, second, "counter");
+
+    // Frozen counters miss events
+    write_reg(Bank::kCtrl, Bank::kCtrlFreeze);
+    drive(10);
+    if (read_reg(Bank::kCtrl) != Bank::kCtrlFreeze) {
+      SC_REPORT_ERROR("testbench", "Freeze not readable");
+    }
+    check(Bank::kCounters, second, "frozen counter");
+
+    // The stats mirror every counted event and survive a clear
+    std::map<std::string, uint64> stats;
+    dut.bank.CollectStats(stats);
+    for (int i = 0; i < kNumCounters; i++) {
+      if (stats["event_" + std::to_string(i)] != second[i]) {
+        SC_REPORT_ERROR("testbench", "Stats do not match the counters");
+      }
+    }
+
+    write_reg(Bank::kCtrl, Bank::kCtrlClear);
+    wait(2);
+    uint64 zero[kNumCounters] = {0, 0, 0, 0};
+    check(Bank::kCounters, zero, "cleared counter");
+    check(Bank::kSnapshots, zero, "cleared snapshot");
+    sc_stop();
+  }
+
+  void run() {
+    reset_bar = 1;
+    wait(2, SC_NS);
+    reset_bar = 0;
+    wait(2, SC_NS);
+    reset_bar = 1;
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  testbench tb("tb");
+  sc_report_handler::set_actions(SC_ERROR, SC_DISPLAY);
+  sc_start();
+  bool rc = (sc_report_handler::get_count(SC_ERROR) > 0);
+  if (rc)
+    DCOUT("TESTBENCH FAIL" << endl);
+  else
+    DCOUT("TESTBENCH PASS" << endl);
+  return rc;
+};